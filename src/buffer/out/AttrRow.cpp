@@ -9,10 +9,55 @@
 // Arguments:
 // - cchRowWidth - the length of the default text attribute
 // - attr - the default text attribute
+// - table - the table the attributes are interned in, usually the one
+//           of the text buffer. A new one is created if none is given.
 // Return Value:
 // - constructed object
-ATTR_ROW::ATTR_ROW(const uint16_t width, const TextAttribute attr) :
-    _data(width, attr) {}
+ATTR_ROW::ATTR_ROW(const uint16_t width, const TextAttribute attr, std::shared_ptr<TextAttributeTable> table, std::pmr::memory_resource* resource) :
+    _table{ table ? std::move(table) : std::make_shared<TextAttributeTable>() },
+    _data{ rle_vector::allocator_type{ resource } }
+{
+    // There are no attributes to take along yet, so if the table
+    // is full, the row can simply start out in its successor.
+    auto id = _table->TryIntern(attr);
+    while (!id)
+    {
+        _table = _table->GetSuccessor();
+        id = _table->TryIntern(attr);
+    }
+    _data = rle_vector(width, *id);
+}
+
+// Routine Description:
+// - Returns the ID for an attribute in the table of this row.
+// - If the table is full, the row first moves over to its successor, taking
+//   along the attributes it's still using. Those are at most one per column,
+//   which always leaves room for the new one.
+// Arguments:
+// - attr - the attribute to intern
+// Return Value:
+// - the ID of the attribute in _table
+// Note:
+// - will throw on allocation failure
+TextAttributeTable::id_type ATTR_ROW::_Intern(const TextAttribute& attr)
+{
+    for (;;)
+    {
+        if (const auto id = _table->TryIntern(attr))
+        {
+            return *id;
+        }
+
+        auto successor = _table->GetSuccessor();
+        auto runs = _data.runs();
+        for (auto& run : runs)
+        {
+            run.value = successor->TryIntern(_table->At(run.value)).value();
+        }
+        _data = rle_vector{ std::move(runs) };
+        _table = std::move(successor);
+    }
+}
 
 // Routine Description:
 // - Sets all properties of the ATTR_ROW to default values
@@ -20,7 +65,7 @@ ATTR_ROW::ATTR_ROW(const uint16_t width, const TextAttribute attr) :
 // - attr - The default text attributes to use on text in this row.
 void ATTR_ROW::Reset(const TextAttribute attr)
 {
-    _data.replace(0, _data.size(), attr);
+    _data.replace(0, _data.size(), _Intern(attr));
 }
 
 // Routine Description:
@@ -47,7 +92,7 @@ void ATTR_ROW::Resize(const uint16_t newWidth)
 // - will throw on error
 TextAttribute ATTR_ROW::GetAttrByColumn(const uint16_t column) const
 {
-    return _data.at(column);
+    return _table->At(_data.at(column));
 }
 
 // Routine Description:
@@ -59,9 +104,10 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
     std::vector<uint16_t> ids;
     for (const auto& run : _data.runs())
     {
-        if (run.value.IsHyperlink())
+        const auto& attr = _table->At(run.value);
+        if (attr.IsHyperlink())
         {
-            ids.emplace_back(run.value.GetHyperlinkId());
+            ids.emplace_back(attr.GetHyperlinkId());
         }
     }
     return ids;
@@ -76,7 +122,7 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
 // - <none>
 bool ATTR_ROW::SetAttrToEnd(const uint16_t beginIndex, const TextAttribute attr)
 {
-    _data.replace(gsl::narrow<uint16_t>(beginIndex), _data.size(), attr);
+    _data.replace(gsl::narrow<uint16_t>(beginIndex), _data.size(), _Intern(attr));
     return true;
 }
 
@@ -90,7 +136,11 @@ bool ATTR_ROW::SetAttrToEnd(const uint16_t beginIndex, const TextAttribute attr)
 // - <none>
 void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith)
 {
-    _data.replace_values(toBeReplacedAttr, replaceWith);
+    // If the attribute was never interned, this row can't be using it.
+    if (const auto toBeReplaced = _table->Find(toBeReplacedAttr))
+    {
+        _data.replace_values(*toBeReplaced, _Intern(replaceWith));
+    }
 }
 
 // Routine Description:
@@ -105,30 +155,68 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
 // - <none>
 void ATTR_ROW::Replace(const uint16_t beginIndex, const uint16_t endIndex, const TextAttribute& newAttr)
 {
-    _data.replace(beginIndex, endIndex, newAttr);
+    _data.replace(beginIndex, endIndex, _Intern(newAttr));
+}
+
+// Routine Description:
+// - Replaces the attributes starting at beginIndex with the given ones, one per column.
+// - This builds the runs for all of them in a single pass, instead of
+//   splicing in one run at a time like the other overload does.
+// Arguments:
+// - beginIndex - The first column to replace.
+// - newAttrs - The new attribute of each column.
+// Return Value:
+// - <none>
+void ATTR_ROW::Replace(const uint16_t beginIndex, const gsl::span<const TextAttribute> newAttrs)
+{
+    boost::container::small_vector<TextAttributeTable::id_type, 256> ids;
+    ids.reserve(newAttrs.size());
+
+    // If the table fills up halfway through, the row moves to its successor
+    // and the IDs we've collected so far are no longer valid. Start over then.
+    for (;;)
+    {
+        const auto table = _table.get();
+        ids.clear();
+        for (const auto& attr : newAttrs)
+        {
+            ids.push_back(_Intern(attr));
+        }
+        if (_table.get() == table)
+        {
+            break;
+        }
+    }
+
+    _data.replace(beginIndex, { ids.data(), ids.size() });
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::begin() const noexcept
 {
-    return _data.begin();
+    return { _data.begin(), _table.get() };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::end() const noexcept
 {
-    return _data.end();
+    return { _data.end(), _table.get() };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::cbegin() const noexcept
 {
-    return _data.cbegin();
+    return { _data.cbegin(), _table.get() };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::cend() const noexcept
 {
-    return _data.cend();
+    return { _data.cend(), _table.get() };
 }
 
 bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept
 {
-    return a._data == b._data;
+    // Rows only compare by their IDs if they're interned in the same table.
+    if (a._table == b._table)
+    {
+        return a._data == b._data;
+    }
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
 }
@@ -22,15 +22,136 @@ Revision History:
 
 #include "til/rle.h"
 #include "TextAttribute.hpp"
+#include "TextAttributeTable.hpp"
 
 class ATTR_ROW final
 {
-    using rle_vector = til::small_rle<TextAttribute, uint16_t, 1>;
+    // The runs only store the IDs of their attributes in _table.
+    using rle_vector = til::pmr::small_rle<TextAttributeTable::id_type, uint16_t, 1>;
 
 public:
-    using const_iterator = rle_vector::const_iterator;
-
-    ATTR_ROW(uint16_t width, TextAttribute attr);
+    // Iterates over the attribute of each column, resolving the IDs stored in the row.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TextAttribute;
+        using pointer = const TextAttribute*;
+        using reference = const TextAttribute&;
+        using difference_type = rle_vector::const_iterator::difference_type;
+
+        const_iterator(rle_vector::const_iterator it, const TextAttributeTable* table) noexcept :
+            _it{ it },
+            _table{ table }
+        {
+        }
+
+        [[nodiscard]] reference operator*() const noexcept
+        {
+            return _table->At(*_it);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept
+        {
+            return &operator*();
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_it;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        const_iterator& operator--() noexcept
+        {
+            --_it;
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        const_iterator& operator+=(const difference_type offset) noexcept
+        {
+            _it += offset;
+            return *this;
+        }
+
+        const_iterator& operator-=(const difference_type offset) noexcept
+        {
+            _it -= offset;
+            return *this;
+        }
+
+        [[nodiscard]] const_iterator operator+(const difference_type offset) const noexcept
+        {
+            auto tmp = *this;
+            return tmp += offset;
+        }
+
+        [[nodiscard]] const_iterator operator-(const difference_type offset) const noexcept
+        {
+            auto tmp = *this;
+            return tmp -= offset;
+        }
+
+        [[nodiscard]] difference_type operator-(const const_iterator& right) const noexcept
+        {
+            return _it - right._it;
+        }
+
+        [[nodiscard]] reference operator[](const difference_type offset) const noexcept
+        {
+            return *operator+(offset);
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator& right) const noexcept
+        {
+            return _it == right._it;
+        }
+
+        [[nodiscard]] bool operator!=(const const_iterator& right) const noexcept
+        {
+            return _it != right._it;
+        }
+
+        [[nodiscard]] bool operator<(const const_iterator& right) const noexcept
+        {
+            return _it < right._it;
+        }
+
+        [[nodiscard]] bool operator>(const const_iterator& right) const noexcept
+        {
+            return _it > right._it;
+        }
+
+        [[nodiscard]] bool operator<=(const const_iterator& right) const noexcept
+        {
+            return _it <= right._it;
+        }
+
+        [[nodiscard]] bool operator>=(const const_iterator& right) const noexcept
+        {
+            return _it >= right._it;
+        }
+
+    private:
+        rle_vector::const_iterator _it;
+        const TextAttributeTable* _table;
+    };
+
+    ATTR_ROW(uint16_t width, TextAttribute attr, std::shared_ptr<TextAttributeTable> table = nullptr, std::pmr::memory_resource* resource = til::pmr::get_default_resource());
 
     ~ATTR_ROW() = default;
 
@@ -47,6 +168,7 @@ public:
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith);
     void Resize(uint16_t newWidth);
     void Replace(uint16_t beginIndex, uint16_t endIndex, const TextAttribute& newAttr);
+    void Replace(uint16_t beginIndex, gsl::span<const TextAttribute> newAttrs);
 
     const_iterator begin() const noexcept;
     const_iterator end() const noexcept;
@@ -56,10 +178,13 @@ public:
 
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class ROW;
+    friend class ScrollbackArchive;
 
 private:
     void Reset(const TextAttribute attr);
+    TextAttributeTable::id_type _Intern(const TextAttribute& attr);
 
+    std::shared_ptr<TextAttributeTable> _table;
     rle_vector _data;
 
 #ifdef UNIT_TESTING
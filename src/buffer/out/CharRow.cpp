@@ -17,8 +17,10 @@
 // Note: will through if unable to allocate char/attribute buffers
 #pragma warning(push)
 #pragma warning(disable : 26447) // small_vector's constructor says it can throw but it should not given how we use it.  This suppresses this error for the AuditMode build.
-CharRow::CharRow(size_t rowWidth, ROW* const pParent) noexcept :
-    _data(rowWidth, value_type()),
+CharRow::CharRow(size_t rowWidth, ROW* const pParent, std::pmr::memory_resource* const resource) noexcept :
+    _chars(rowWidth, UNICODE_SPACE, CellVector<wchar_t>::allocator_type{ resource }),
+    _dbcsAttrs(rowWidth, DbcsAttribute{}, CellVector<DbcsAttribute>::allocator_type{ resource }),
+    _width{ rowWidth },
     _pParent{ FAIL_FAST_IF_NULL(pParent) }
 {
 }
@@ -32,7 +34,7 @@ CharRow::CharRow(size_t rowWidth, ROW* const pParent) noexcept :
 // - the size of the row
 size_t CharRow::size() const noexcept
 {
-    return _data.size();
+    return _width;
 }
 
 // Routine Description:
@@ -43,10 +45,11 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset() noexcept
 {
-    for (auto& cell : _data)
-    {
-        cell.Reset();
-    }
+    // A blank row is simply a compacted row without any stored cells.
+    // The capacity is retained, so expanding it again won't allocate.
+    _chars.clear();
+    _dbcsAttrs.clear();
+    _glyphs.clear();
 }
 
 // Routine Description:
@@ -59,32 +62,89 @@ void CharRow::Reset() noexcept
 {
     try
     {
-        const value_type insertVals;
-        _data.resize(newSize, insertVals);
+        _Expand();
+        _chars.resize(newSize, UNICODE_SPACE);
+        _dbcsAttrs.resize(newSize, DbcsAttribute{});
+        _width = newSize;
+
+        // drop the glyphs of the cells that were cut off
+        _CompactGlyphs();
     }
     CATCH_RETURN();
 
     return S_OK;
 }
 
-typename CharRow::iterator CharRow::begin() noexcept
+// Routine Description:
+// - Trims the trailing blank cells off of the row and releases any storage
+//   that's no longer needed. Used for rows that have scrolled out of the
+//   mutable viewport, so that their memory use is proportional to their
+//   content rather than to the width of the buffer.
+// - The row still reports its full width and reads past the stored cells
+//   return blanks. The first mutating access re-expands the row.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK on success, otherwise relevant error code
+[[nodiscard]] HRESULT CharRow::Compact() noexcept
 {
-    return _data.begin();
+    try
+    {
+        const auto right = MeasureRight();
+        _chars.resize(right);
+        _dbcsAttrs.resize(right);
+        _chars.shrink_to_fit();
+        _dbcsAttrs.shrink_to_fit();
+        _CompactGlyphs();
+        _glyphs.shrink_to_fit();
+    }
+    CATCH_RETURN();
+
+    return S_OK;
 }
 
-typename CharRow::const_iterator CharRow::cbegin() const noexcept
+// Routine Description:
+// - checks if the row is currently stored in its compacted form
+// Arguments:
+// - <none>
+// Return Value:
+// - true if trailing blank cells of the row aren't backed by storage
+bool CharRow::IsCompact() const noexcept
 {
-    return _data.cbegin();
+    return _chars.size() != _width;
 }
 
-typename CharRow::iterator CharRow::end() noexcept
+// Routine Description:
+// - grows a compacted row back to its full width, filling it with blanks
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+// Note: will throw if unable to allocate the char/attribute buffers
+void CharRow::_Expand()
 {
-    return _data.end();
+    if (IsCompact())
+    {
+        _chars.resize(_width, UNICODE_SPACE);
+        _dbcsAttrs.resize(_width, DbcsAttribute{});
+    }
 }
 
-typename CharRow::const_iterator CharRow::cend() const noexcept
+// Routine Description:
+// - checks if the cell at the given column contains a space glyph
+// Arguments:
+// - column - the column to check. Must be in bounds.
+// Return Value:
+// - true if the cell contains a space glyph, false otherwise
+bool CharRow::_IsSpaceAt(const size_t column) const noexcept
 {
-    return _data.cend();
+    if (column >= _chars.size())
+    {
+        // cells past the end of a compacted row are blank
+        return true;
+    }
+#pragma warning(suppress : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Checked above.
+    return _chars[column] == UNICODE_SPACE && !_dbcsAttrs[column].IsGlyphStored();
 }
 
 // Routine Description:
@@ -95,12 +155,13 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const noexcept
 {
-    const_iterator it = _data.cbegin();
-    while (it != _data.cend() && it->IsSpace())
+    size_t column = 0;
+    while (column < _chars.size() && _IsSpaceAt(column))
     {
-        ++it;
+        ++column;
     }
-    return it - _data.cbegin();
+    // Everything after the stored cells is blank.
+    return column == _chars.size() ? _width : column;
 }
 
 // Routine Description:
@@ -109,19 +170,21 @@ size_t CharRow::MeasureLeft() const noexcept
 // - <none>
 // Return Value:
 // - The calculated right boundary of the internal string.
-size_t CharRow::MeasureRight() const
+size_t CharRow::MeasureRight() const noexcept
 {
-    const_reverse_iterator it = _data.crbegin();
-    while (it != _data.crend() && it->IsSpace())
+    size_t column = _chars.size();
+    while (column > 0 && _IsSpaceAt(column - 1))
     {
-        ++it;
+        --column;
     }
-    return _data.crend() - it;
+    return column;
 }
 
 void CharRow::ClearCell(const size_t column)
 {
-    _data.at(column).Reset();
+    _Expand();
+    _chars.at(column) = UNICODE_SPACE;
+    _dbcsAttrs.at(column).Reset();
 }
 
 // Routine Description:
@@ -132,14 +195,7 @@ void CharRow::ClearCell(const size_t column)
 // - True if there is valid text in this row. False otherwise.
 bool CharRow::ContainsText() const noexcept
 {
-    for (const value_type& cell : _data)
-    {
-        if (!cell.IsSpace())
-        {
-            return true;
-        }
-    }
-    return false;
+    return MeasureRight() != 0;
 }
 
 // Routine Description:
@@ -151,7 +207,12 @@ bool CharRow::ContainsText() const noexcept
 // Note: will throw exception if column is out of bounds
 const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 {
-    return _data.at(column).DbcsAttr();
+    static const DbcsAttribute blank{};
+    if (column < _width && column >= _dbcsAttrs.size())
+    {
+        return blank;
+    }
+    return _dbcsAttrs.at(column);
 }
 
 // Routine Description:
@@ -163,7 +224,8 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
-    return _data.at(column).DbcsAttr();
+    _Expand();
+    return _dbcsAttrs.at(column);
 }
 
 // Routine Description:
@@ -175,7 +237,100 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
-    _data.at(column).EraseChars();
+    _Expand();
+    _chars.at(column) = UNICODE_SPACE;
+    _dbcsAttrs.at(column).SetGlyphStored(false);
+}
+
+// Routine Description:
+// - overwrites the cells starting at column with the given characters, one per cell
+// Arguments:
+// - column - column index to start writing at
+// - chars - the text to write. Each character must be narrow and fit into a single cell.
+// Return Value:
+// - <none>
+// Note: will throw exception if the text doesn't fit into the row
+void CharRow::WriteNarrowGlyphs(const size_t column, const std::wstring_view chars)
+{
+    THROW_HR_IF(E_INVALIDARG, column > _width || chars.size() > _width - column);
+
+    _Expand();
+    std::copy(chars.begin(), chars.end(), _chars.begin() + column);
+    std::fill_n(_dbcsAttrs.begin() + column, chars.size(), DbcsAttribute{});
+}
+
+// Routine Description:
+// - overwrites count cells starting at column with the same character
+// Arguments:
+// - column - column index to start writing at
+// - count - the number of cells to write
+// - wch - the character to write. It must be narrow and fit into a single cell.
+// Return Value:
+// - <none>
+// Note: will throw exception if the cells don't fit into the row
+void CharRow::FillNarrowGlyph(const size_t column, const size_t count, const wchar_t wch)
+{
+    THROW_HR_IF(E_INVALIDARG, column > _width || count > _width - column);
+
+    _Expand();
+    std::fill_n(_chars.begin() + column, count, wch);
+    std::fill_n(_dbcsAttrs.begin() + column, count, DbcsAttribute{});
+}
+
+// Routine Description:
+// - Returns the run of narrow glyphs starting at column, which can be copied
+//   elsewhere with WriteNarrowGlyphs. The run ends at the first cell that holds
+//   anything but a printable ASCII character, or after maxLength cells.
+// Arguments:
+// - column - column index to start the run at
+// - maxLength - the maximum number of cells to return
+// Return Value:
+// - the characters of the run. Empty if the run is out of bounds or the cell
+//   at column doesn't hold a narrow printable character.
+std::wstring_view CharRow::GetNarrowRun(const size_t column, const size_t maxLength) const noexcept
+{
+    // The cells of a compacted row past _chars.size() are blanks, but they
+    // aren't stored and so they can't be returned as part of the run.
+    if (column >= _chars.size())
+    {
+        return {};
+    }
+
+    const auto end = column + std::min(maxLength, _chars.size() - column);
+    auto i = column;
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Bounded by _chars.size() above.
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+    while (i < end && _chars[i] >= UNICODE_SPACE && _chars[i] <= L'~' && _dbcsAttrs[i].IsSingle() && !_dbcsAttrs[i].IsGlyphStored())
+    {
+        ++i;
+    }
+    return { _chars.data() + column, i - column };
+#pragma warning(pop)
+}
+
+// Routine Description:
+// - Copies the text of the row into dest, one wchar_t per cell, for fast scans
+//   over the text. Both halves of a wide glyph hold its character.
+// Arguments:
+// - dest - the buffer to copy the text into. At most size() cells are copied.
+// - storedPlaceholder - written in place of any glyph that lives in the
+//   glyph slots of the row, as those don't fit into a single wchar_t
+// Return Value:
+// - <none>
+void CharRow::CopyCellChars(const gsl::span<wchar_t> dest, const wchar_t storedPlaceholder) const noexcept
+{
+    const auto count = std::min(_width, gsl::narrow_cast<size_t>(dest.size()));
+    const auto stored = std::min(count, _chars.size());
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Bounded by stored above.
+    for (size_t i = 0; i < stored; ++i)
+    {
+        dest[i] = _dbcsAttrs[i].IsGlyphStored() ? storedPlaceholder : _chars[i];
+    }
+#pragma warning(pop)
+    // the blank cells of a compacted row aren't stored
+    std::fill(dest.begin() + gsl::narrow_cast<ptrdiff_t>(stored), dest.begin() + gsl::narrow_cast<ptrdiff_t>(count), UNICODE_SPACE);
 }
 
 // Routine Description:
@@ -187,7 +342,7 @@ void CharRow::ClearGlyph(const size_t column)
 // - Note: will throw exception if column is out of bounds
 const CharRow::reference CharRow::GlyphAt(const size_t column) const
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _width);
     return { const_cast<CharRow&>(*this), column };
 }
 
@@ -200,16 +355,29 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 // - Note: will throw exception if column is out of bounds
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _width);
+    _Expand();
     return { *this, column };
 }
 
 std::wstring CharRow::GetText() const
 {
+    // If every cell holds exactly one narrow character, which is by far the
+    // most common case, the text is simply a copy of the character array.
+    const auto allSimple = std::all_of(_dbcsAttrs.begin(), _dbcsAttrs.end(), [](const DbcsAttribute& attr) noexcept {
+        return attr.IsSingle() && !attr.IsGlyphStored();
+    });
+    if (allSimple)
+    {
+        std::wstring wstr{ _chars.begin(), _chars.end() };
+        wstr.resize(_width, UNICODE_SPACE);
+        return wstr;
+    }
+
     std::wstring wstr;
-    wstr.reserve(_data.size());
+    wstr.reserve(_width);
 
-    for (size_t i = 0; i < _data.size(); ++i)
+    for (size_t i = 0; i < _chars.size(); ++i)
     {
         const auto glyph = GlyphAt(i);
         if (!DbcsAttrAt(i).IsTrailing())
@@ -220,6 +388,8 @@ std::wstring CharRow::GetText() const
             }
         }
     }
+    // pad out the blank cells that a compacted row doesn't store
+    wstr.append(_width - _chars.size(), UNICODE_SPACE);
     return wstr;
 }
 
@@ -228,19 +398,53 @@ std::wstring CharRow::GetText() const
 // - used for double click selection and uia word navigation
 // Arguments:
 // - column: column to get text data for
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - delimiters: the table of the delimiters defined as a part of the DelimiterClass::DelimiterChar
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const
+const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const DelimiterTable& delimiters) const
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _width);
+
+    return delimiters.ClassOf(*GlyphAt(column).begin());
+}
 
-    const auto glyph = *GlyphAt(column).begin();
-    if (glyph <= UNICODE_SPACE)
+// Routine Description:
+// - Builds the lookup table for the given word delimiters
+// Arguments:
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+DelimiterTable::DelimiterTable(const std::wstring_view wordDelimiters) :
+    _wordDelimiters{ wordDelimiters }
+{
+    for (const auto wch : wordDelimiters)
+    {
+        _isDelimiter.set(wch);
+    }
+}
+
+// Routine Description:
+// - checks whether the table was built for the given word delimiters
+// Arguments:
+// - wordDelimiters: the delimiters to compare against
+// Return Value:
+// - true if the table classifies characters according to wordDelimiters
+bool DelimiterTable::IsFor(const std::wstring_view wordDelimiters) const noexcept
+{
+    return _wordDelimiters == wordDelimiters;
+}
+
+// Routine Description:
+// - get the delimiter class of a character
+// Arguments:
+// - wch: the character, usually the first one of a glyph
+// Return Value:
+// - the delimiter class for the given char
+DelimiterClass DelimiterTable::ClassOf(const wchar_t wch) const noexcept
+{
+    if (wch <= UNICODE_SPACE)
     {
         return DelimiterClass::ControlChar;
     }
-    else if (wordDelimiters.find(glyph) != std::wstring_view::npos)
+    else if (_isDelimiter.test(wch))
     {
         return DelimiterClass::DelimiterChar;
     }
@@ -250,25 +454,75 @@ const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::w
     }
 }
 
-UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
+// Routine Description:
+// - returns the glyph of a cell that doesn't fit into a single wchar_t
+// Arguments:
+// - column - the column of the cell. Its glyph must be stored.
+// Return Value:
+// - the glyph of the cell
+// Note: will throw exception if column is out of bounds
+const std::wstring& CharRow::_StoredGlyphAt(const size_t column) const
 {
-    return _pParent->GetUnicodeStorage();
+    return _glyphs.at(_chars.at(column));
 }
 
-const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
+// Routine Description:
+// - stores a glyph that doesn't fit into a single wchar_t for a cell and
+//   marks the cell as stored
+// Arguments:
+// - column - the column of the cell
+// - chars - the glyph to store
+// Return Value:
+// - <none>
+// Note: will throw exception if column is out of bounds or on allocation failure
+void CharRow::_StoreGlyph(const size_t column, const std::wstring_view chars)
 {
-    return _pParent->GetUnicodeStorage();
+    _Expand();
+
+    // The flag may have been copied over from another row together with the
+    // rest of the DbcsAttribute, so the slot in _chars can't be reused.
+    // The cell is overwritten either way and gives up its old slot.
+    auto& dbcsAttr = _dbcsAttrs.at(column);
+    dbcsAttr.SetGlyphStored(false);
+
+    // There can't be more live glyphs than cells, so once we're out of
+    // slots, some of them belong to glyphs that have been overwritten.
+    if (_glyphs.size() >= _width)
+    {
+        _CompactGlyphs();
+    }
+
+    _glyphs.emplace_back(chars);
+    _chars.at(column) = gsl::narrow_cast<wchar_t>(_glyphs.size() - 1);
+    dbcsAttr.SetGlyphStored(true);
 }
 
 // Routine Description:
-// - calculates the key used by the given column of the char row to store glyph data in UnicodeStorage
+// - releases the slots of overwritten glyphs and renumbers the stored cells
 // Arguments:
-// - column - the column to generate the key for
+// - <none>
 // Return Value:
-// - the COORD key for data access from UnicodeStorage for the column
-COORD CharRow::GetStorageKey(const size_t column) const noexcept
+// - <none>
+// Note: will throw on allocation failure
+void CharRow::_CompactGlyphs()
 {
-    return { gsl::narrow<SHORT>(column), _pParent->GetId() };
+    if (_glyphs.empty())
+    {
+        return;
+    }
+
+    std::vector<std::wstring> glyphs;
+    const auto stored = std::min(_chars.size(), _dbcsAttrs.size());
+    for (size_t i = 0; i < stored; ++i)
+    {
+        if (til::at(_dbcsAttrs, i).IsGlyphStored())
+        {
+            auto& slot = til::at(_chars, i);
+            glyphs.emplace_back(std::move(_glyphs.at(slot)));
+            slot = gsl::narrow_cast<wchar_t>(glyphs.size() - 1);
+        }
+    }
+    _glyphs = std::move(glyphs);
 }
 
 // Routine Description:
@@ -20,10 +20,11 @@ Revision History:
 
 #pragma once
 
+#include <bitset>
+
 #include "DbcsAttribute.hpp"
 #include "CharRowCellReference.hpp"
-#include "CharRowCell.hpp"
-#include "UnicodeStorage.hpp"
+#include "unicode.hpp"
 
 class ROW;
 
@@ -34,6 +35,23 @@ enum class DelimiterClass
     RegularChar
 };
 
+// Looks up the delimiter class of a character without searching the
+// word delimiters for it. There's a bit for every UTF-16 code unit,
+// so that building it is the only thing that depends on the delimiters.
+class DelimiterTable
+{
+public:
+    DelimiterTable() = default;
+    explicit DelimiterTable(const std::wstring_view wordDelimiters);
+
+    bool IsFor(const std::wstring_view wordDelimiters) const noexcept;
+    DelimiterClass ClassOf(const wchar_t wch) const noexcept;
+
+private:
+    std::wstring _wordDelimiters;
+    std::bitset<0x10000> _isDelimiter;
+};
+
 // the characters of one row of screen buffer
 // we keep the following values so that we don't write
 // more pixels to the screen than we have to:
@@ -48,42 +66,31 @@ class CharRow final
 {
 public:
     using glyph_type = typename wchar_t;
-    using value_type = typename CharRowCell;
-    using iterator = typename boost::container::small_vector_base<value_type>::iterator;
-    using const_iterator = typename boost::container::small_vector_base<value_type>::const_iterator;
-    using const_reverse_iterator = typename boost::container::small_vector_base<value_type>::const_reverse_iterator;
     using reference = typename CharRowCellReference;
 
-    CharRow(size_t rowWidth, ROW* const pParent) noexcept;
+    CharRow(size_t rowWidth, ROW* const pParent, std::pmr::memory_resource* const resource = til::pmr::get_default_resource()) noexcept;
 
     size_t size() const noexcept;
     [[nodiscard]] HRESULT Resize(const size_t newSize) noexcept;
+    [[nodiscard]] HRESULT Compact() noexcept;
+    bool IsCompact() const noexcept;
     size_t MeasureLeft() const noexcept;
-    size_t MeasureRight() const;
+    size_t MeasureRight() const noexcept;
     bool ContainsText() const noexcept;
     const DbcsAttribute& DbcsAttrAt(const size_t column) const;
     DbcsAttribute& DbcsAttrAt(const size_t column);
     void ClearGlyph(const size_t column);
+    void WriteNarrowGlyphs(const size_t column, const std::wstring_view chars);
+    void FillNarrowGlyph(const size_t column, const size_t count, const wchar_t wch);
+    std::wstring_view GetNarrowRun(const size_t column, const size_t maxLength) const noexcept;
+    void CopyCellChars(const gsl::span<wchar_t> dest, const wchar_t storedPlaceholder) const noexcept;
 
-    const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+    const DelimiterClass DelimiterClassAt(const size_t column, const DelimiterTable& delimiters) const;
 
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
     reference GlyphAt(const size_t column);
 
-    // iterators
-    iterator begin() noexcept;
-    const_iterator cbegin() const noexcept;
-    const_iterator begin() const noexcept { return cbegin(); }
-
-    iterator end() noexcept;
-    const_iterator cend() const noexcept;
-    const_iterator end() const noexcept { return cend(); }
-
-    UnicodeStorage& GetUnicodeStorage() noexcept;
-    const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    COORD GetStorageKey(const size_t column) const noexcept;
-
     void UpdateParent(ROW* const pParent);
 
     friend CharRowCellReference;
@@ -94,22 +101,56 @@ private:
     void ClearCell(const size_t column);
     std::wstring GetText() const;
 
+    bool _IsSpaceAt(const size_t column) const noexcept;
+    void _Expand();
+
+    const std::wstring& _StoredGlyphAt(const size_t column) const;
+    void _StoreGlyph(const size_t column, const std::wstring_view chars);
+    void _CompactGlyphs();
+
 protected:
-    // storage for glyph data and dbcs attributes
-    boost::container::small_vector<value_type, 120> _data;
+    // Storage for glyph data and dbcs attributes. These are kept in separate,
+    // parallel arrays so that whole-row scans over the text (measuring,
+    // extracting, searching) run over contiguous wchar_t data.
+    // If a cell's DbcsAttribute says its glyph is stored, the glyph doesn't
+    // fit into a single wchar_t and the value in _chars is the index of its
+    // slot in _glyphs instead.
+    // A compacted row only stores the cells up to its last non-space glyph;
+    // every cell past the end of the arrays (up to _width) is a blank space.
+    // Mutating accessors re-expand the arrays to the full width on demand.
+    // The cells beyond InlineCells are allocated from the resource of the
+    // TextBuffer the row is in, see TextBuffer::GetRowResource.
+    static constexpr size_t InlineCells = 120;
+    template<typename T>
+    using CellVector = boost::container::small_vector<T, InlineCells, std::pmr::polymorphic_allocator<T>>;
+    CellVector<wchar_t> _chars;
+    CellVector<DbcsAttribute> _dbcsAttrs;
+
+    // The glyphs of the stored cells. Most of them are surrogate pairs or short
+    // combining sequences, which fit into the small string buffer of a
+    // wstring without allocating. Slots of overwritten glyphs are only
+    // reclaimed once the row runs out of them, see _CompactGlyphs.
+    std::vector<std::wstring> _glyphs;
+
+    // the width of the row, in cells
+    size_t _width;
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
+
+#ifdef UNIT_TESTING
+    friend class CharRowTests;
+    friend class TextBufferTests;
+#endif
 };
 
 template<typename InputIt1, typename InputIt2>
-void OverwriteColumns(InputIt1 startChars, InputIt1 endChars, InputIt2 startAttrs, CharRow::iterator outIt)
+void OverwriteColumns(InputIt1 startChars, InputIt1 endChars, InputIt2 startAttrs, CharRow& charRow)
 {
-    std::transform(startChars,
-                   endChars,
-                   startAttrs,
-                   outIt,
-                   [](const wchar_t wch, const DbcsAttribute attr) {
-                       return CharRow::value_type{ wch, attr };
-                   });
+    for (size_t column = 0; startChars != endChars; ++startChars, ++startAttrs, ++column)
+    {
+        const wchar_t wch = *startChars;
+        charRow.GlyphAt(column) = std::wstring_view{ &wch, 1 };
+        charRow.DbcsAttrAt(column) = *startAttrs;
+    }
 }
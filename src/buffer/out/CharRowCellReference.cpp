@@ -2,11 +2,10 @@
 // Licensed under the MIT license.
 
 #include "precomp.h"
-#include "UnicodeStorage.hpp"
 #include "CharRow.hpp"
 
 // Routine Description:
-// - assignment operator. will store extended glyph data in a separate storage location
+// - assignment operator. will store extended glyph data in the glyph slots of the char row
 // Arguments:
 // - chars - the glyph data to store
 void CharRowCellReference::operator=(const std::wstring_view chars)
@@ -14,15 +13,12 @@ void CharRowCellReference::operator=(const std::wstring_view chars)
     THROW_HR_IF(E_INVALIDARG, chars.empty());
     if (chars.size() == 1)
     {
-        _cellData().Char() = chars.front();
-        _cellData().DbcsAttr().SetGlyphStored(false);
+        _char() = chars.front();
+        _dbcsAttr().SetGlyphStored(false);
     }
     else
     {
-        auto& storage = _parent.GetUnicodeStorage();
-        const auto key = _parent.GetStorageKey(_index);
-        storage.StoreGlyph(key, { chars.cbegin(), chars.cend() });
-        _cellData().DbcsAttr().SetGlyphStored(true);
+        _parent._StoreGlyph(_index, chars);
     }
 }
 
@@ -36,21 +32,45 @@ CharRowCellReference::operator std::wstring_view() const
 }
 
 // Routine Description:
-// - The CharRowCell this object "references"
+// - The character of the cell this object "references". For stored glyphs this is the index of their slot.
 // Return Value:
-// - ref to the CharRowCell
-CharRowCell& CharRowCellReference::_cellData()
+// - ref to the character
+wchar_t& CharRowCellReference::_char()
 {
-    return _parent._data.at(_index);
+    return _parent._chars.at(_index);
 }
 
 // Routine Description:
-// - The CharRowCell this object "references"
+// - The character of the cell this object "references". For stored glyphs this is the index of their slot.
 // Return Value:
-// - ref to the CharRowCell
-const CharRowCell& CharRowCellReference::_cellData() const
+// - ref to the character
+const wchar_t& CharRowCellReference::_char() const
 {
-    return _parent._data.at(_index);
+    static constexpr wchar_t blank{ UNICODE_SPACE };
+    if (_index < _parent._width && _index >= _parent._chars.size())
+    {
+        // the cell lies past the end of a compacted row
+        return blank;
+    }
+    return _parent._chars.at(_index);
+}
+
+// Routine Description:
+// - The DbcsAttribute of the cell this object "references"
+// Return Value:
+// - ref to the DbcsAttribute
+DbcsAttribute& CharRowCellReference::_dbcsAttr()
+{
+    return _parent._dbcsAttrs.at(_index);
+}
+
+// Routine Description:
+// - The DbcsAttribute of the cell this object "references"
+// Return Value:
+// - ref to the DbcsAttribute
+const DbcsAttribute& CharRowCellReference::_dbcsAttr() const
+{
+    return std::as_const(_parent).DbcsAttrAt(_index);
 }
 
 // Routine Description:
@@ -59,15 +79,13 @@ const CharRowCell& CharRowCellReference::_cellData() const
 // - the glyph data
 std::wstring_view CharRowCellReference::_glyphData() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        const auto& text = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
-
-        return { text.data(), text.size() };
+        return _parent._StoredGlyphAt(_index);
     }
     else
     {
-        return { &_cellData().Char(), 1 };
+        return { &_char(), 1 };
     }
 }
 
@@ -77,13 +95,13 @@ std::wstring_view CharRowCellReference::_glyphData() const
 // - iterator of the glyph data
 CharRowCellReference::const_iterator CharRowCellReference::begin() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        return _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index)).data();
+        return _parent._StoredGlyphAt(_index).data();
     }
     else
     {
-        return &_cellData().Char();
+        return &_char();
     }
 }
 
@@ -96,21 +114,21 @@ CharRowCellReference::const_iterator CharRowCellReference::begin() const
 // TODO GH 2672: eliminate using pointers raw as begin/end markers in this class
 CharRowCellReference::const_iterator CharRowCellReference::end() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        const auto& chars = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
+        const auto& chars = _parent._StoredGlyphAt(_index);
         return chars.data() + chars.size();
     }
     else
     {
-        return &_cellData().Char() + 1;
+        return &_char() + 1;
     }
 }
 #pragma warning(pop)
 
 bool operator==(const CharRowCellReference& ref, const std::vector<wchar_t>& glyph)
 {
-    const DbcsAttribute& dbcsAttr = ref._cellData().DbcsAttr();
+    const DbcsAttribute& dbcsAttr = ref._dbcsAttr();
     if (glyph.size() == 1 && dbcsAttr.IsGlyphStored())
     {
         return false;
@@ -121,12 +139,12 @@ bool operator==(const CharRowCellReference& ref, const std::vector<wchar_t>& gly
     }
     else if (glyph.size() == 1 && !dbcsAttr.IsGlyphStored())
     {
-        return ref._cellData().Char() == glyph.front();
+        return ref._char() == glyph.front();
     }
     else
     {
-        const auto& chars = ref._parent.GetUnicodeStorage().GetText(ref._parent.GetStorageKey(ref._index));
-        return chars == glyph;
+        const auto& chars = ref._parent._StoredGlyphAt(ref._index);
+        return std::equal(chars.begin(), chars.end(), glyph.begin(), glyph.end());
     }
 }
 
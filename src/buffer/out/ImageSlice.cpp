@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ImageSlice.hpp"
+
+// Routine Description:
+// - Constructs an empty slice.
+// Arguments:
+// - cellSize - the number of pixels each cell is stored in
+ImageSlice::ImageSlice(const til::size cellSize) noexcept :
+    _cellSize{ cellSize },
+    _cellWidth{ gsl::narrow_cast<size_t>(cellSize.width()) },
+    _cellHeight{ gsl::narrow_cast<size_t>(cellSize.height()) }
+{
+    _NewRevision();
+}
+
+til::size ImageSlice::CellSize() const noexcept
+{
+    return _cellSize;
+}
+
+// Routine Description:
+// - Returns the first column the pixels cover.
+size_t ImageSlice::ColumnBegin() const noexcept
+{
+    return _columnBegin;
+}
+
+// Routine Description:
+// - Returns the column right after the last one the pixels cover.
+size_t ImageSlice::ColumnEnd() const noexcept
+{
+    return _columnEnd;
+}
+
+// Routine Description:
+// - Returns the width of a row of pixels, which is also their stride.
+size_t ImageSlice::PixelWidth() const noexcept
+{
+    return (_columnEnd - _columnBegin) * _cellWidth;
+}
+
+// Routine Description:
+// - Returns the pixels, as CellSize().height() rows of PixelWidth() each.
+//   They're premultiplied, and the transparent ones are all zero.
+gsl::span<const RGBQUAD> ImageSlice::Pixels() const noexcept
+{
+    return { _pixels.data(), _pixels.size() };
+}
+
+uint64_t ImageSlice::Revision() const noexcept
+{
+    return _revision;
+}
+
+// Routine Description:
+// - Draws the given pixels over the cells starting at the given column.
+//   The transparent ones leave what's already there, so that images with a
+//   transparent background can be layered on top of each other.
+// Arguments:
+// - pixels - CellSize().height() rows of pixelWidth pixels each. A pixel is
+//   drawn if its alpha is non-zero, and considered to be opaque.
+// - pixelWidth - the width of a row of pixels, which must be whole cells
+// - column - the column the pixels start at
+// Return Value:
+// - <none>
+void ImageSlice::CopyCells(const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth, const size_t column)
+{
+    THROW_HR_IF(E_INVALIDARG, pixelWidth % _cellWidth != 0 || pixels.size() != pixelWidth * _cellHeight);
+    if (pixelWidth == 0)
+    {
+        return;
+    }
+
+    const auto columnEnd = column + pixelWidth / _cellWidth;
+    if (_columnBegin == _columnEnd)
+    {
+        _Resize(column, columnEnd);
+    }
+    else if (column < _columnBegin || columnEnd > _columnEnd)
+    {
+        _Resize(std::min(column, _columnBegin), std::max(columnEnd, _columnEnd));
+    }
+
+    const auto stride = PixelWidth();
+    const auto offset = (column - _columnBegin) * _cellWidth;
+    for (size_t y = 0; y < _cellHeight; ++y)
+    {
+        const auto source = pixels.subspan(y * pixelWidth, pixelWidth);
+        auto target = _pixels.begin() + y * stride + offset;
+        for (const auto& pixel : source)
+        {
+            if (pixel.rgbReserved != 0)
+            {
+                *target = { pixel.rgbBlue, pixel.rgbGreen, pixel.rgbRed, 0xff };
+            }
+            ++target;
+        }
+    }
+
+    _NewRevision();
+}
+
+// Routine Description:
+// - Erases the pixels of the given columns, which is what happens when
+//   text is written over an image.
+// Arguments:
+// - begin - the first column to erase
+// - end - the column right after the last one to erase
+// Return Value:
+// - true if nothing is left of the slice, which can be dropped then
+bool ImageSlice::EraseCells(const size_t begin, const size_t end)
+{
+    const auto eraseBegin = std::max(begin, _columnBegin);
+    const auto eraseEnd = std::min(end, _columnEnd);
+    if (eraseBegin < eraseEnd)
+    {
+        const auto stride = PixelWidth();
+        const auto offset = (eraseBegin - _columnBegin) * _cellWidth;
+        const auto count = (eraseEnd - eraseBegin) * _cellWidth;
+        for (size_t y = 0; y < _cellHeight; ++y)
+        {
+            std::fill_n(_pixels.begin() + y * stride + offset, count, RGBQUAD{});
+        }
+
+        // The transparent columns at the edges are cut off, so that a slice
+        // whose cells are overwritten one at a time is gone in the end, too.
+        auto columnBegin = _columnBegin;
+        auto columnEnd = _columnEnd;
+        while (columnBegin < columnEnd && _IsColumnTransparent(columnBegin))
+        {
+            ++columnBegin;
+        }
+        while (columnEnd > columnBegin && _IsColumnTransparent(columnEnd - 1))
+        {
+            --columnEnd;
+        }
+        if (columnBegin != _columnBegin || columnEnd != _columnEnd)
+        {
+            _Resize(columnBegin, columnEnd);
+        }
+
+        _NewRevision();
+    }
+    return _columnBegin == _columnEnd;
+}
+
+bool ImageSlice::_IsColumnTransparent(const size_t column) const noexcept
+{
+    const auto stride = PixelWidth();
+    const auto offset = (column - _columnBegin) * _cellWidth;
+    for (size_t y = 0; y < _cellHeight; ++y)
+    {
+        const auto begin = _pixels.begin() + y * stride + offset;
+        if (std::any_of(begin, begin + _cellWidth, [](const RGBQUAD& pixel) noexcept { return pixel.rgbReserved != 0; }))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Routine Description:
+// - Moves the pixels into a buffer covering the given columns. The pixels
+//   of the columns that are in both are kept, the new ones are transparent.
+void ImageSlice::_Resize(const size_t columnBegin, const size_t columnEnd)
+{
+    std::vector<RGBQUAD> pixels;
+    const auto stride = (columnEnd - columnBegin) * _cellWidth;
+    const auto copyBegin = std::max(columnBegin, _columnBegin);
+    const auto copyEnd = std::min(columnEnd, _columnEnd);
+    if (stride != 0)
+    {
+        pixels.resize(stride * _cellHeight);
+        if (copyBegin < copyEnd)
+        {
+            const auto oldStride = PixelWidth();
+            const auto count = (copyEnd - copyBegin) * _cellWidth;
+            const auto source = (copyBegin - _columnBegin) * _cellWidth;
+            const auto target = (copyBegin - columnBegin) * _cellWidth;
+            for (size_t y = 0; y < _cellHeight; ++y)
+            {
+                std::copy_n(_pixels.begin() + y * oldStride + source, count, pixels.begin() + y * stride + target);
+            }
+        }
+    }
+
+    _pixels = std::move(pixels);
+    _columnBegin = columnBegin;
+    _columnEnd = columnEnd;
+}
+
+void ImageSlice::_NewRevision() noexcept
+{
+    static std::atomic<uint64_t> revisions{ 0 };
+    _revision = ++revisions;
+}
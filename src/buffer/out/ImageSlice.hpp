@@ -0,0 +1,51 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ImageSlice.hpp
+
+Abstract:
+- The part of an inline image (like a sixel image) that covers a single row
+  of the buffer. It's owned by the ROW, which is why an image moves along
+  with its rows when the buffer circles or scrolls, and why it's gone once
+  its rows are recycled.
+- The pixels are stored in a fixed number of pixels per cell, which the
+  renderers scale to the actual size of their cells.
+- Every change gives the slice a new revision, which is unique in the
+  process. Renderers can use it as the key of whatever they made of the
+  pixels, like a texture, so they only need to upload it once.
+--*/
+
+#pragma once
+
+class ImageSlice final
+{
+public:
+    explicit ImageSlice(const til::size cellSize) noexcept;
+
+    til::size CellSize() const noexcept;
+    size_t ColumnBegin() const noexcept;
+    size_t ColumnEnd() const noexcept;
+    size_t PixelWidth() const noexcept;
+    gsl::span<const RGBQUAD> Pixels() const noexcept;
+    uint64_t Revision() const noexcept;
+
+    void CopyCells(const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth, const size_t column);
+    bool EraseCells(const size_t begin, const size_t end);
+
+private:
+    bool _IsColumnTransparent(const size_t column) const noexcept;
+    void _Resize(const size_t columnBegin, const size_t columnEnd);
+    void _NewRevision() noexcept;
+
+    til::size _cellSize;
+    size_t _cellWidth;
+    size_t _cellHeight;
+    // The columns the pixels cover, which are the only ones that are stored.
+    size_t _columnBegin = 0;
+    size_t _columnEnd = 0;
+    // _cellHeight rows of PixelWidth() premultiplied BGRA pixels each.
+    std::vector<RGBQUAD> _pixels;
+    uint64_t _revision = 0;
+};
@@ -9,6 +9,7 @@
 #include "../../types/inc/Utf16Parser.hpp"
 #include "../../types/inc/GlyphWidth.hpp"
 #include "../../inc/conattrs.hpp"
+#include "../../inc/unicode.hpp"
 
 static constexpr TextAttribute InvalidTextAttribute{ INVALID_COLOR, INVALID_COLOR };
 
@@ -389,7 +390,10 @@ OutputCellView OutputCellIterator::s_GenerateView(const std::wstring_view view,
 //   variables (so OutputCellView doesn't need an empty default constructor)
 // - This will infer the width of the glyph and apply the appropriate attributes to the view.
 // Arguments:
-// - view - View representing characters corresponding to a single glyph
+// - The view is cut at the end of the first grapheme cluster, which makes
+//   combining marks, emoji ZWJ sequences and flags share the cell of their base.
+// Arguments:
+// - view - View representing characters starting with a single glyph
 // - attr - Color attributes to apply to the text
 // - behavior - Behavior of the given text attribute (used when writing)
 // Return Value:
@@ -398,7 +402,15 @@ OutputCellView OutputCellIterator::s_GenerateView(const std::wstring_view view,
                                                   const TextAttribute attr,
                                                   const TextAttributeBehavior behavior)
 {
-    const auto glyph = Utf16Parser::ParseNext(view);
+    auto glyph = GetNextGlyphCluster(view);
+
+    // Broken surrogates take up a cell of their own and are replaced,
+    // so that the iterator still moves past them one by one.
+    if (glyph.empty() || (glyph.size() == 1 && (Utf16Parser::IsLeadingSurrogate(glyph.front()) || Utf16Parser::IsTrailingSurrogate(glyph.front()))))
+    {
+        glyph = { &UNICODE_REPLACEMENT, 1 };
+    }
+
     DbcsAttribute dbcsAttr;
     if (IsGlyphFullWidth(glyph))
     {
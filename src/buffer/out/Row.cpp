@@ -19,8 +19,10 @@
 ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
     _id{ rowId },
     _rowWidth{ rowWidth },
-    _charRow{ rowWidth, this },
-    _attrRow{ rowWidth, fillAttribute },
+    _generation{ 0 },
+    _charRow{ rowWidth, this, pParent ? pParent->GetRowResource() : til::pmr::get_default_resource() },
+    _attrRow{ rowWidth, fillAttribute, pParent ? pParent->GetAttributeTable() : nullptr, pParent ? pParent->GetRowResource() : til::pmr::get_default_resource() },
+    _pendingFill{},
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
@@ -36,6 +38,8 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
 // - <none>
 bool ROW::Reset(const TextAttribute Attr)
 {
+    _pendingFill.reset();
+    _imageSlice.reset();
     _lineRendition = LineRendition::SingleWidth;
     _wrapForced = false;
     _doubleBytePadded = false;
@@ -52,6 +56,169 @@ bool ROW::Reset(const TextAttribute Attr)
     return true;
 }
 
+// Routine Description:
+// - Marks the row as blank, like Reset does, without touching its contents yet.
+//   They're cleared in one go once the row is accessed for the first time.
+//   This keeps the rotation of a full buffer as cheap as the output on an
+//   empty one, no matter how many rows are pushed through it.
+// Arguments:
+// - attr - The attribute the row is going to be filled with
+// Return Value:
+// - <none>
+void ROW::Recycle(const TextAttribute& attr) noexcept
+{
+    _pendingFill = attr;
+    _imageSlice.reset();
+    _lineRendition = LineRendition::SingleWidth;
+    _wrapForced = false;
+    _doubleBytePadded = false;
+}
+
+// Routine Description:
+// - Clears the contents of a recycled row.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ROW::_ResetPending() const noexcept
+{
+    const auto attr = *_pendingFill;
+    _pendingFill.reset();
+    _charRow.Reset();
+    try
+    {
+        _attrRow.Reset(attr);
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Hashes everything about the row that ends up on the screen: the text,
+//   the attributes and the line rendition. Rows that look the same hash the
+//   same, no matter how they happen to be stored (e.g. compacted or not).
+// Arguments:
+// - <none>
+// Return Value:
+// - The hash of the row
+size_t ROW::GetHash() const noexcept
+{
+    _ApplyPendingReset();
+
+    size_t hash = std::hash<size_t>{}(_rowWidth);
+    const auto combine = [&](const size_t value) noexcept {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    // The blank cells at the end of the row are left out, as a compacted row doesn't store them.
+    const auto columns = _charRow.MeasureRight();
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Bounded by MeasureRight above.
+    for (size_t i = 0; i < columns; ++i)
+    {
+        const auto& dbcsAttr = _charRow._dbcsAttrs[i];
+        if (dbcsAttr.IsGlyphStored())
+        {
+            combine(std::hash<std::wstring_view>{}(til::at(_charRow._glyphs, _charRow._chars[i])));
+        }
+        else
+        {
+            combine(_charRow._chars[i]);
+        }
+        combine(dbcsAttr.IsLeading() ? 1 : dbcsAttr.IsTrailing() ? 2 : 0);
+    }
+#pragma warning(pop)
+
+    // The runs of a row are hashed by their attributes rather than their IDs,
+    // since the same ID can stand for different attributes in different tables.
+    for (const auto& run : _attrRow._data.runs())
+    {
+        combine(std::hash<TextAttribute>{}(_attrRow._table->At(run.value)));
+        combine(run.length);
+    }
+
+    combine(static_cast<size_t>(_lineRendition));
+    combine(_wrapForced);
+    if (_imageSlice)
+    {
+        combine(gsl::narrow_cast<size_t>(_imageSlice->Revision()));
+    }
+    return hash;
+}
+
+// Routine Description:
+// - Adds the bytes this row holds on to to the given totals. The storage
+//   that's part of the ROW itself is counted as text, the rest only if it
+//   outgrew that storage and had to be allocated.
+// - A recycled row is counted as it's stored, not as it's going to be.
+// Arguments:
+// - usage - the totals to add to
+// Return Value:
+// - <none>
+void ROW::AddMemoryUsage(BufferMemoryUsage& usage) const noexcept
+{
+    usage.text += sizeof(ROW);
+    if (_charRow._chars.capacity() > CharRow::InlineCells)
+    {
+        usage.text += _charRow._chars.capacity() * sizeof(wchar_t);
+    }
+    if (_charRow._dbcsAttrs.capacity() > CharRow::InlineCells)
+    {
+        usage.text += _charRow._dbcsAttrs.capacity() * sizeof(DbcsAttribute);
+    }
+
+    // Short glyphs fit into the small string buffer of their wstring.
+    static const auto smallGlyphCapacity = std::wstring{}.capacity();
+    usage.glyphs += _charRow._glyphs.capacity() * sizeof(std::wstring);
+    for (const auto& glyph : _charRow._glyphs)
+    {
+        if (glyph.capacity() > smallGlyphCapacity)
+        {
+            usage.glyphs += (glyph.capacity() + 1) * sizeof(wchar_t);
+        }
+    }
+
+    const auto& runs = _attrRow._data.runs();
+    if (runs.capacity() > 1)
+    {
+        usage.attributes += runs.capacity() * sizeof(runs[0]);
+    }
+
+    if (_imageSlice)
+    {
+        usage.images += sizeof(ImageSlice) + _imageSlice->Pixels().size_bytes();
+    }
+}
+
+// Routine Description:
+// - Draws a row of image cells over the row, starting at the given column.
+//   See ImageSlice::CopyCells.
+// Arguments:
+// - cellSize - the number of pixels per cell the image is stored in. A slice of
+//   a different size that's already on the row is replaced.
+// - pixels - cellSize.height() rows of pixelWidth pixels each
+// - pixelWidth - the width of a row of pixels, which must be whole cells
+// - column - the column the pixels start at
+// Return Value:
+// - <none>
+void ROW::CopyImageCells(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth, const size_t column)
+{
+    if (!_imageSlice || _imageSlice->CellSize() != cellSize)
+    {
+        _imageSlice = std::make_unique<ImageSlice>(cellSize);
+    }
+    _imageSlice->CopyCells(pixels, pixelWidth, column);
+}
+
+// Routine Description:
+// - Erases the image in the given columns, because text was written into them.
+void ROW::_EraseImageCells(const size_t begin, const size_t end)
+{
+    if (_imageSlice && _imageSlice->EraseCells(begin, end))
+    {
+        _imageSlice.reset();
+    }
+}
+
 // Routine Description:
 // - resizes ROW to new width
 // Arguments:
@@ -60,10 +227,13 @@ bool ROW::Reset(const TextAttribute Attr)
 // - S_OK if successful, otherwise relevant error
 [[nodiscard]] HRESULT ROW::Resize(const unsigned short width)
 {
+    _ApplyPendingReset();
     RETURN_IF_FAILED(_charRow.Resize(width));
     try
     {
         _attrRow.Resize(width);
+        // The part of an image that's right of the new width is cut off.
+        _EraseImageCells(width, SIZE_MAX);
     }
     CATCH_RETURN();
 
@@ -80,20 +250,11 @@ bool ROW::Reset(const TextAttribute Attr)
 // - <none>
 void ROW::ClearColumn(const size_t column)
 {
+    _ApplyPendingReset();
     THROW_HR_IF(E_INVALIDARG, column >= _charRow.size());
     _charRow.ClearCell(column);
 }
 
-UnicodeStorage& ROW::GetUnicodeStorage() noexcept
-{
-    return _pParent->GetUnicodeStorage();
-}
-
-const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
-{
-    return _pParent->GetUnicodeStorage();
-}
-
 // Routine Description:
 // - writes cell data to the row
 // Arguments:
@@ -105,15 +266,20 @@ const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
 // - iterator to first cell that was not written to this row.
 OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap, std::optional<size_t> limitRight)
 {
+    _ApplyPendingReset();
     THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
     THROW_HR_IF(E_INVALIDARG, limitRight.value_or(0) >= _charRow.size());
 
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
 
+    // The colors of all cells are collected and committed into the attr row at once.
+    // Cells that keep the current color get the color of the cell before them.
     auto currentColor = it->TextAttr();
-    uint16_t colorUses = 0;
-    uint16_t colorStarts = gsl::narrow_cast<uint16_t>(index);
+    bool anyColor = false;
+    bool anyText = false;
+    boost::container::small_vector<TextAttribute, 256> colors;
+    const uint16_t colorStarts = gsl::narrow_cast<uint16_t>(index);
     uint16_t currentIndex = colorStarts;
 
     while (it && currentIndex <= finalColumnInRow)
@@ -121,27 +287,16 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
         // Fill the color if the behavior isn't set to keeping the current color.
         if (it->TextAttrBehavior() != TextAttributeBehavior::Current)
         {
-            // If the color of this cell is the same as the run we're currently on,
-            // just increment the counter.
-            if (currentColor == it->TextAttr())
-            {
-                ++colorUses;
-            }
-            else
-            {
-                // Otherwise, commit this color into the run and save off the new one.
-                // Now commit the new color runs into the attr row.
-                _attrRow.Replace(colorStarts, currentIndex, currentColor);
-                currentColor = it->TextAttr();
-                colorUses = 1;
-                colorStarts = currentIndex;
-            }
+            currentColor = it->TextAttr();
+            anyColor = true;
         }
+        colors.push_back(currentColor);
 
         // Fill the text if the behavior isn't set to saying there's only a color stored in this iterator.
         if (it->TextAttrBehavior() != TextAttributeBehavior::StoredOnly)
         {
             const bool fillingLastColumn = currentIndex == finalColumnInRow;
+            anyText = true;
 
             // TODO: MSFT: 19452170 - We need to ensure when writing any trailing byte that the one to the left
             // is a matching leading byte. Likewise, if we're writing a leading byte, we need to make sure we still have space in this loop
@@ -188,11 +343,439 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
         ++currentIndex;
     }
 
-    // Now commit the final color into the attr row
-    if (colorUses)
+    // Now commit the colors into the attr row
+    if (anyColor)
     {
-        _attrRow.Replace(colorStarts, currentIndex, currentColor);
+        _attrRow.Replace(colorStarts, { colors.data(), colors.size() });
+    }
+    if (anyText)
+    {
+        _EraseImageCells(colorStarts, currentIndex);
     }
 
     return it;
 }
+
+// Routine Description:
+// - Writes a run of text with a single attribute into the row, starting at the given column.
+// - Only printable ASCII is written, since it is always narrow and never needs
+//   a glyph slot. We stop at the first character that isn't,
+//   or at the end of the row, whichever comes first.
+// Arguments:
+// - chars - the text to write
+// - index - the column to start writing at
+// - attr - the attributes to apply to the written cells
+// - wrap - change the wrap flag if we filled the last column of the row
+// Return Value:
+// - the number of characters written, which is also the number of cells written
+size_t ROW::WriteRun(const std::wstring_view chars, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap)
+{
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto count = _NarrowRunLength(chars.substr(0, _charRow.size() - index));
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    _charRow.WriteNarrowGlyphs(index, chars.substr(0, count));
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(index + count), attr);
+    _EraseImageCells(index, index + count);
+
+    if (wrap.has_value() && index + count == _charRow.size())
+    {
+        SetWrapForced(*wrap);
+    }
+
+    return count;
+}
+
+// Routine Description:
+// - Fills cells of the row with a single narrow character, starting at the
+//   given column, and leaves their attributes alone. This is what WriteCells
+//   does with an OutputCellIterator that repeats a character, without going
+//   through the iterator for every cell.
+// Arguments:
+// - wch - the character to fill with. It must be narrow and not a surrogate.
+// - index - the column to start filling at
+// - count - the number of cells to fill. It's cut off at the end of the row.
+// - wrap - change the wrap flag if we filled the last column of the row
+// Return Value:
+// - the number of cells filled
+size_t ROW::FillText(const wchar_t wch, const size_t index, const size_t count, const std::optional<bool> wrap)
+{
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto filled = std::min(count, _charRow.size() - index);
+    if (filled == 0)
+    {
+        return 0;
+    }
+
+    _charRow.FillNarrowGlyph(index, filled, wch);
+    _EraseImageCells(index, index + filled);
+
+    if (wrap.has_value() && index + filled == _charRow.size())
+    {
+        SetWrapForced(*wrap);
+    }
+
+    return filled;
+}
+
+// Routine Description:
+// - Applies a single attribute to cells of the row, starting at the given
+//   column, and leaves their text alone.
+// Arguments:
+// - attr - the attributes to apply
+// - index - the column to start at
+// - count - the number of cells to change. It's cut off at the end of the row.
+// Return Value:
+// - the number of cells changed
+size_t ROW::FillAttributes(const TextAttribute& attr, const size_t index, const size_t count)
+{
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto filled = std::min(count, _charRow.size() - index);
+    if (filled != 0)
+    {
+        _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(index + filled), attr);
+    }
+    return filled;
+}
+
+// Routine Description:
+// - Finds the cells that WriteRun would actually change, because they hold
+//   other text, other attributes or a part of an image. The cells around
+//   them don't need to be redrawn, which matters for progress bars and the
+//   like, which keep rewriting a line of which only a few cells change.
+// Arguments:
+// - chars - the text to write
+// - index - the column to start writing at
+// - attr - the attributes to apply to the written cells
+// Return Value:
+// - the first column that would change and the one past the last one.
+//   They're the same if nothing would change.
+std::pair<size_t, size_t> ROW::FindChangedCells(const std::wstring_view chars, const size_t index, const TextAttribute& attr) const
+{
+    const auto& charRow = GetCharRow();
+    const auto& attrRow = GetAttrRow();
+    THROW_HR_IF(E_INVALIDARG, index >= charRow.size());
+
+    const auto count = _NarrowRunLength(chars.substr(0, charRow.size() - index));
+    if (_imageSlice)
+    {
+        // Erasing the cells of an image isn't worth checking cell by cell.
+        return { index, index + count };
+    }
+
+    // Only the cells in the narrow run that's there already can be unchanged.
+    const auto existing = charRow.GetNarrowRun(index, count);
+    using difference_type = ATTR_ROW::const_iterator::difference_type;
+
+    size_t begin = 0;
+    auto it = attrRow.begin() + gsl::narrow_cast<difference_type>(index);
+    while (begin < existing.size() && til::at(existing, begin) == til::at(chars, begin) && *it == attr)
+    {
+        ++begin;
+        ++it;
+    }
+
+    auto end = count;
+    it = attrRow.begin() + gsl::narrow_cast<difference_type>(index + end);
+    while (end > begin && end <= existing.size())
+    {
+        --it;
+        if (til::at(existing, end - 1) != til::at(chars, end - 1) || *it != attr)
+        {
+            break;
+        }
+        --end;
+    }
+
+    return { index + begin, index + end };
+}
+
+// Routine Description:
+// - Returns the length of the run of printable ASCII that chars starts with.
+//   That's the part of it that WriteRun writes.
+// Arguments:
+// - chars - the text to write, cut off at the end of the row
+// Return Value:
+// - the length of the run
+size_t ROW::_NarrowRunLength(const std::wstring_view chars) noexcept
+{
+    const auto runEnd = std::find_if(chars.begin(), chars.end(), [](const wchar_t wch) noexcept {
+        return wch < UNICODE_SPACE || wch > L'~';
+    });
+    return gsl::narrow_cast<size_t>(runEnd - chars.begin());
+}
+
+// Routine Description:
+// - Writes legacy CHAR_INFO cells into the row, starting at the given column.
+// - This follows WriteCells for an OutputCellIterator over the same cells, padding
+//   out lead and trail bytes that would be cut in half by the edges of the row,
+//   but reads the cells directly instead of through a view per cell.
+// Arguments:
+// - charInfos - the cells to write
+// - index - the column to start writing at
+// Return Value:
+// - the number of cells of charInfos that were written. This is less than their
+//   size if they didn't fit into the rest of the row.
+size_t ROW::WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index)
+{
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    // The colors of all cells are collected and committed into the attr row at once.
+    boost::container::small_vector<TextAttribute, 256> colors;
+    size_t read = 0;
+    size_t column = index;
+
+    while (read < gsl::narrow_cast<size_t>(charInfos.size()) && column < _charRow.size())
+    {
+        const auto& charInfo = til::at(charInfos, read);
+        colors.emplace_back(charInfo.Attributes);
+
+        DbcsAttribute dbcsAttr;
+        if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            dbcsAttr.SetTrailing();
+        }
+        if (column == 0 && dbcsAttr.IsTrailing())
+        {
+            // A trailing byte can't start a row. Pad it out and try the cell again in the next column.
+            _charRow.ClearCell(column);
+        }
+        else if (column == _charRow.size() - 1 && dbcsAttr.IsLeading())
+        {
+            // A leading byte can't end a row either. The cell stays unwritten.
+            _charRow.ClearCell(column);
+            SetDoubleBytePadded(true);
+        }
+        else
+        {
+            _charRow.DbcsAttrAt(column) = dbcsAttr;
+            _charRow.GlyphAt(column) = std::wstring_view{ &charInfo.Char.UnicodeChar, 1 };
+            ++read;
+        }
+
+        ++column;
+    }
+
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), { colors.data(), colors.size() });
+    _EraseImageCells(index, column);
+
+    return read;
+}
+
+// Routine Description:
+// - Reads the cells of the given segment of the row into plain arrays, so that
+//   they can be looped over without building an OutputCellView for each one
+//   of them, like a TextBufferCellIterator would.
+// Arguments:
+// - begin - the first column to read
+// - end - the column after the last one to read. Clamped to the row's width.
+// - cells - receives the cells. Its previous contents are discarded.
+// Return Value:
+// - <none>
+void ROW::ReadCells(const size_t begin, const size_t end, RowCells& cells) const
+{
+    _ApplyPendingReset();
+    cells.clear();
+
+    const auto to = std::min(end, _charRow.size());
+    if (begin >= to)
+    {
+        return;
+    }
+
+    const auto count = to - begin;
+    cells.glyphs.reserve(count);
+    cells.dbcsAttrs.reserve(count);
+
+    // The cells past the end of a compacted row are blank.
+    static constexpr wchar_t blank{ UNICODE_SPACE };
+    const auto stored = std::clamp(_charRow._chars.size(), begin, to);
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Bounded by stored above.
+    for (auto column = begin; column < stored; ++column)
+    {
+        const auto& dbcsAttr = _charRow._dbcsAttrs[column];
+        if (dbcsAttr.IsGlyphStored())
+        {
+            cells.glyphs.emplace_back(til::at(_charRow._glyphs, _charRow._chars[column]));
+        }
+        else
+        {
+            cells.glyphs.emplace_back(&_charRow._chars[column], 1);
+        }
+        cells.dbcsAttrs.emplace_back(dbcsAttr);
+    }
+#pragma warning(pop)
+    cells.glyphs.insert(cells.glyphs.end(), to - stored, std::wstring_view{ &blank, 1 });
+    cells.dbcsAttrs.insert(cells.dbcsAttrs.end(), to - stored, DbcsAttribute{});
+
+    size_t runStart = 0;
+    for (const auto& run : _attrRow._data.runs())
+    {
+        const size_t runEnd = runStart + run.length;
+        const auto from = std::max(runStart, begin);
+        const auto until = std::min(runEnd, to);
+        if (from < until)
+        {
+            cells.attrs.push_back({ _attrRow._table->At(run.value), until - from });
+        }
+        if (runEnd >= to)
+        {
+            break;
+        }
+        runStart = runEnd;
+    }
+}
+
+// Routine Description:
+// - Copies the glyphs and double byte attributes of a segment of another row
+//   into this one. Runs of narrow printable characters are copied in bulk.
+// - This doesn't touch the attributes, which are interned in the table shared
+//   by all rows of the buffer. Different rows of a buffer can thus be
+//   copied into concurrently, see TextBuffer::_ReflowInParallel.
+// Arguments:
+// - source - the row to copy the cells from
+// - sourceColumn - the first column of source to copy
+// - length - the number of cells to copy
+// - column - the column of this row to copy the first cell to
+// Return Value:
+// - <none>
+void ROW::CopyTextFrom(const ROW& source, const size_t sourceColumn, const size_t length, const size_t column)
+{
+    const auto& from = source.GetCharRow();
+    auto& to = GetCharRow();
+    THROW_HR_IF(E_INVALIDARG, sourceColumn > from.size() || length > from.size() - sourceColumn);
+    THROW_HR_IF(E_INVALIDARG, column > to.size() || length > to.size() - column);
+
+    for (size_t i = 0; i < length;)
+    {
+        const auto run = from.GetNarrowRun(sourceColumn + i, length - i);
+        if (!run.empty())
+        {
+            to.WriteNarrowGlyphs(column + i, run);
+            i += run.size();
+            continue;
+        }
+
+        to.GlyphAt(column + i) = std::wstring_view{ from.GlyphAt(sourceColumn + i) };
+        to.DbcsAttrAt(column + i) = from.DbcsAttrAt(sourceColumn + i);
+        ++i;
+    }
+}
+
+// Routine Description:
+// - Copies the attributes of a segment of another row into this one. Like
+//   inserting the cells one by one with TextBuffer::InsertCharacter would,
+//   the attribute of the last cell is extended to the end of the row.
+// Arguments:
+// - source - the row to copy the attributes from
+// - sourceColumn - the first column of source to copy
+// - length - the number of cells to copy
+// - column - the column of this row to copy the first attribute to
+// Return Value:
+// - <none>
+void ROW::CopyAttrsFrom(const ROW& source, const size_t sourceColumn, const size_t length, const size_t column)
+{
+    source._ApplyPendingReset();
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, column > _charRow.size() || length > _charRow.size() - column);
+
+    const auto sourceEnd = sourceColumn + length;
+    size_t runStart = 0;
+    for (const auto& run : source._attrRow._data.runs())
+    {
+        const size_t runEnd = runStart + run.length;
+        const auto from = std::max(runStart, sourceColumn);
+        const auto until = std::min(runEnd, sourceEnd);
+        if (from < until)
+        {
+            _attrRow.SetAttrToEnd(gsl::narrow<uint16_t>(column + from - sourceColumn), source._attrRow._table->At(run.value));
+        }
+        if (runEnd >= sourceEnd)
+        {
+            break;
+        }
+        runStart = runEnd;
+    }
+}
+
+// Routine Description:
+// - Reads the cells of the row, starting at the given column, as legacy CHAR_INFOs.
+// - The characters are read straight out of the char row and the colors are
+//   converted once per run of attributes, rather than once per cell.
+// Arguments:
+// - index - the column to start reading at
+// - charInfos - the cells to read into, up to the end of the row
+// Return Value:
+// - the number of cells read
+size_t ROW::ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const
+{
+    _ApplyPendingReset();
+    THROW_HR_IF(E_INVALIDARG, index > _charRow.size());
+
+    const auto count = std::min(gsl::narrow_cast<size_t>(charInfos.size()), _charRow.size() - index);
+    const auto end = index + count;
+
+    // The cells past the end of a compacted row are blank.
+    const auto stored = std::clamp(_charRow._chars.size(), index, end);
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator. Bounded by count above.
+    for (size_t column = index; column < stored; ++column)
+    {
+        auto& charInfo = charInfos[column - index];
+        const auto& dbcsAttr = _charRow._dbcsAttrs[column];
+        if (dbcsAttr.IsGlyphStored())
+        {
+            charInfo.Char.UnicodeChar = Utf16ToUcs2(til::at(_charRow._glyphs, _charRow._chars[column]));
+        }
+        else
+        {
+            charInfo.Char.UnicodeChar = _charRow._chars[column];
+        }
+        charInfo.Attributes = dbcsAttr.GeneratePublicApiAttributeFormat();
+    }
+    for (size_t column = stored; column < end; ++column)
+    {
+        auto& charInfo = charInfos[column - index];
+        charInfo.Char.UnicodeChar = UNICODE_SPACE;
+        charInfo.Attributes = 0;
+    }
+
+    size_t runStart = 0;
+    for (const auto& run : _attrRow._data.runs())
+    {
+        const size_t runEnd = runStart + run.length;
+        const auto from = std::max(runStart, index);
+        const auto to = std::min(runEnd, end);
+        if (from < to)
+        {
+            const auto legacyAttributes = _attrRow._table->At(run.value).GetLegacyAttributes();
+            for (auto column = from; column < to; ++column)
+            {
+                charInfos[column - index].Attributes |= legacyAttributes;
+            }
+        }
+        if (runEnd >= end)
+        {
+            break;
+        }
+        runStart = runEnd;
+    }
+#pragma warning(pop)
+
+    return count;
+}
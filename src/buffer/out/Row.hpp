@@ -25,10 +25,60 @@ Revision History:
 #include "OutputCell.hpp"
 #include "OutputCellIterator.hpp"
 #include "CharRow.hpp"
-#include "UnicodeStorage.hpp"
+#include "ImageSlice.hpp"
 
 class TextBuffer;
 
+// The bytes the rows of a buffer hold on to, by what they're used for.
+// See ROW::AddMemoryUsage and TextBuffer::GetMemoryUsage.
+struct BufferMemoryUsage
+{
+    size_t text = 0; // the cells, including the rows themselves
+    size_t glyphs = 0; // the glyphs that don't fit into a single wchar_t
+    size_t attributes = 0; // the runs of attributes, and the table they're interned in
+    size_t hyperlinks = 0;
+    size_t images = 0;
+
+    size_t Total() const noexcept
+    {
+        return text + glyphs + attributes + hyperlinks + images;
+    }
+};
+
+// The cells of a segment of a row as plain arrays, filled in one go by
+// ROW::ReadCells. The glyphs point into the row and are only valid until it's
+// modified, which is why this is meant to be reused from one row to the next.
+struct RowCells
+{
+    struct AttrRun
+    {
+        TextAttribute attr;
+        size_t length; // in cells
+    };
+
+    // The text and the DbcsAttribute of each cell. Both halves of a wide
+    // glyph hold its entire text, like the OutputCellView of each half does.
+    std::vector<std::wstring_view> glyphs;
+    std::vector<DbcsAttribute> dbcsAttrs;
+    // The attributes of the cells, as runs that cover all of them.
+    std::vector<AttrRun> attrs;
+
+    size_t size() const noexcept { return glyphs.size(); }
+
+    // The number of columns the cell at index takes up, see OutputCellView::Columns.
+    size_t ColumnsAt(const size_t index) const noexcept
+    {
+        return til::at(dbcsAttrs, index).IsLeading() ? 2 : 1;
+    }
+
+    void clear() noexcept
+    {
+        glyphs.clear();
+        dbcsAttrs.clear();
+        attrs.clear();
+    }
+};
+
 class ROW final
 {
 public:
@@ -42,11 +92,27 @@ public:
     void SetDoubleBytePadded(const bool doubleBytePadded) noexcept { _doubleBytePadded = doubleBytePadded; }
     bool WasDoubleBytePadded() const noexcept { return _doubleBytePadded; }
 
-    const CharRow& GetCharRow() const noexcept { return _charRow; }
-    CharRow& GetCharRow() noexcept { return _charRow; }
-
-    const ATTR_ROW& GetAttrRow() const noexcept { return _attrRow; }
-    ATTR_ROW& GetAttrRow() noexcept { return _attrRow; }
+    const CharRow& GetCharRow() const noexcept
+    {
+        _ApplyPendingReset();
+        return _charRow;
+    }
+    CharRow& GetCharRow() noexcept
+    {
+        _ApplyPendingReset();
+        return _charRow;
+    }
+
+    const ATTR_ROW& GetAttrRow() const noexcept
+    {
+        _ApplyPendingReset();
+        return _attrRow;
+    }
+    ATTR_ROW& GetAttrRow() noexcept
+    {
+        _ApplyPendingReset();
+        return _attrRow;
+    }
 
     LineRendition GetLineRendition() const noexcept { return _lineRendition; }
     void SetLineRendition(const LineRendition lineRendition) noexcept { _lineRendition = lineRendition; }
@@ -54,16 +120,33 @@ public:
     SHORT GetId() const noexcept { return _id; }
     void SetId(const SHORT id) noexcept { _id = id; }
 
+    uint64_t GetGeneration() const noexcept { return _generation; }
+    void SetGeneration(const uint64_t generation) noexcept { _generation = generation; }
+
     bool Reset(const TextAttribute Attr);
+    void Recycle(const TextAttribute& attr) noexcept;
+    bool IsRecycled() const noexcept { return _pendingFill.has_value(); }
     [[nodiscard]] HRESULT Resize(const unsigned short width);
 
+    const ImageSlice* GetImageSlice() const noexcept { return _imageSlice.get(); }
+    void CopyImageCells(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth, const size_t column);
+
     void ClearColumn(const size_t column);
-    std::wstring GetText() const { return _charRow.GetText(); }
+    std::wstring GetText() const { return GetCharRow().GetText(); }
+    size_t GetHash() const noexcept;
+    void AddMemoryUsage(BufferMemoryUsage& usage) const noexcept;
 
-    UnicodeStorage& GetUnicodeStorage() noexcept;
-    const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    size_t WriteRun(const std::wstring_view chars, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap = std::nullopt);
+    size_t FillText(const wchar_t wch, const size_t index, const size_t count, const std::optional<bool> wrap = std::nullopt);
+    size_t FillAttributes(const TextAttribute& attr, const size_t index, const size_t count);
+    std::pair<size_t, size_t> FindChangedCells(const std::wstring_view chars, const size_t index, const TextAttribute& attr) const;
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index);
+    size_t ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const;
+    void ReadCells(const size_t begin, const size_t end, RowCells& cells) const;
+    void CopyTextFrom(const ROW& source, const size_t sourceColumn, const size_t length, const size_t column);
+    void CopyAttrsFrom(const ROW& source, const size_t sourceColumn, const size_t length, const size_t column);
 
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
@@ -71,11 +154,30 @@ public:
 #endif
 
 private:
-    CharRow _charRow;
-    ATTR_ROW _attrRow;
+    void _ApplyPendingReset() const noexcept
+    {
+        if (_pendingFill.has_value())
+        {
+            _ResetPending();
+        }
+    }
+    void _ResetPending() const noexcept;
+    static size_t _NarrowRunLength(const std::wstring_view chars) noexcept;
+    void _EraseImageCells(const size_t begin, const size_t end);
+
+    // The contents of a recycled row are only cleared once they're accessed,
+    // so they're mutable to allow for that to happen through a const ROW.
+    mutable CharRow _charRow;
+    mutable ATTR_ROW _attrRow;
+    // The attributes a recycled row is going to be cleared with
+    mutable std::optional<TextAttribute> _pendingFill;
+    // The part of an inline image that's on this row, if any
+    std::unique_ptr<ImageSlice> _imageSlice;
     LineRendition _lineRendition;
     SHORT _id;
     unsigned short _rowWidth;
+    // Stamped by the parent TextBuffer whenever the row might have been modified
+    uint64_t _generation;
     // Occurs when the user runs out of text in a given row and we're forced to wrap the cursor to the next line
     bool _wrapForced;
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
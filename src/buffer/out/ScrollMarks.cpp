@@ -0,0 +1,263 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ScrollMarks.hpp"
+
+// Routine Description:
+// - Records a mark. A mark of the same kind that's already at the given
+//   position is replaced, since shells redraw their prompt every now and then.
+// Arguments:
+// - position - where the mark is, relative to the top of the buffer
+// - kind - what the mark marks
+// - exitCode - the exit code of the command, if this marks where it finished
+// Return Value:
+// - <none>
+void ScrollMarks::Add(const COORD position, const MarkKind kind, const std::optional<unsigned int> exitCode)
+{
+    auto& marks = til::at(_marks, static_cast<size_t>(kind));
+    const Entry entry{ _origin + position.Y, position.X, exitCode };
+
+    // Marks are almost always added below all the others, which is what
+    // makes this an append most of the time.
+    const auto it = std::lower_bound(marks.begin(), marks.end(), entry, _IsBefore);
+    if (it != marks.end() && it->row == entry.row && it->column == entry.column)
+    {
+        *it = entry;
+    }
+    else
+    {
+        marks.insert(it, entry);
+    }
+}
+
+// Routine Description:
+// - Drops the marks of the given number of rows at the top of the buffer,
+//   which is called when those left the buffer. The other marks keep
+//   their absolute position, so that they don't need to be moved.
+// Arguments:
+// - count - the number of rows that left the buffer
+// Return Value:
+// - <none>
+void ScrollMarks::DiscardRows(const size_t count)
+{
+    _origin += gsl::narrow_cast<int64_t>(count);
+    for (auto& marks : _marks)
+    {
+        while (!marks.empty() && marks.front().row < _origin)
+        {
+            marks.pop_front();
+        }
+    }
+}
+
+// Routine Description:
+// - Drops the marks that are outside of a buffer of the given height.
+// Arguments:
+// - height - the number of rows the buffer is left with
+// Return Value:
+// - <none>
+void ScrollMarks::Truncate(const size_t height)
+{
+    const auto end = _origin + gsl::narrow_cast<int64_t>(height);
+    for (auto& marks : _marks)
+    {
+        while (!marks.empty() && marks.back().row >= end)
+        {
+            marks.pop_back();
+        }
+    }
+}
+
+// Routine Description:
+// - Moves the marks along with the rows that TextBuffer::ScrollRows moves.
+//   The rows that are scrolled over are about to be erased by the caller,
+//   so their marks are dropped instead of being rotated into the gap.
+// - Only the marks within the scrolled region are touched, so scrolling
+//   a small region doesn't cost more the longer the history gets.
+// Arguments:
+// - firstRow - the first row that's moved
+// - size - the number of rows that are moved
+// - delta - how far they're moved, negative is upwards
+// Return Value:
+// - <none>
+void ScrollMarks::MoveRows(const SHORT firstRow, const SHORT size, const SHORT delta)
+{
+    const auto begin = _origin + firstRow;
+    const auto end = begin + size;
+    const auto targetBegin = begin + delta;
+    const auto targetEnd = end + delta;
+    const auto regionBegin = std::min(begin, targetBegin);
+    const auto regionEnd = std::max(end, targetEnd);
+
+    for (auto& marks : _marks)
+    {
+        const auto byRow = [](const Entry& entry, const int64_t value) noexcept {
+            return entry.row < value;
+        };
+        const auto first = std::lower_bound(marks.begin(), marks.end(), regionBegin, byRow) - marks.begin();
+        const auto last = std::lower_bound(marks.begin(), marks.end(), regionEnd, byRow) - marks.begin();
+
+        auto out = first;
+        for (auto i = first; i < last; ++i)
+        {
+            auto entry = marks.begin()[i];
+            if (entry.row >= begin && entry.row < end)
+            {
+                entry.row += delta;
+            }
+            else if (entry.row >= targetBegin && entry.row < targetEnd)
+            {
+                continue;
+            }
+            marks.begin()[out++] = entry;
+        }
+
+        // Everything that's left stays within the region, so sorting
+        // just the region keeps all of them sorted.
+        std::stable_sort(marks.begin() + first, marks.begin() + out, _IsBefore);
+        marks.erase(marks.begin() + out, marks.begin() + last);
+    }
+}
+
+// Routine Description:
+// - Drops all the marks.
+void ScrollMarks::Clear() noexcept
+{
+    for (auto& marks : _marks)
+    {
+        marks.clear();
+    }
+}
+
+// Routine Description:
+// - Returns the number of rows that left the top of the buffer since it was
+//   created. Adding it to an offset into the buffer makes it absolute.
+int64_t ScrollMarks::GetOrigin() const noexcept
+{
+    return _origin;
+}
+
+// Routine Description:
+// - Returns the number of marks of all kinds.
+size_t ScrollMarks::size() const noexcept
+{
+    size_t count = 0;
+    for (const auto& marks : _marks)
+    {
+        count += marks.size();
+    }
+    return count;
+}
+
+// Routine Description:
+// - Returns all the marks sorted by their position, for instance to show
+//   them next to the scrollbar.
+// Arguments:
+// - <none>
+// Return Value:
+// - The marks, from the top of the buffer to its bottom.
+std::vector<ScrollMark> ScrollMarks::GetAll() const
+{
+    std::vector<ScrollMark> all;
+    all.reserve(size());
+    for (size_t kind = 0; kind < KindCount; ++kind)
+    {
+        for (const auto& entry : til::at(_marks, kind))
+        {
+            all.emplace_back(_ToMark(entry, static_cast<MarkKind>(kind)));
+        }
+    }
+    std::stable_sort(all.begin(), all.end(), [](const ScrollMark& a, const ScrollMark& b) noexcept {
+        return a.position.Y < b.position.Y || (a.position.Y == b.position.Y && a.position.X < b.position.X);
+    });
+    return all;
+}
+
+// Routine Description:
+// - Finds the closest mark of the given kind above the given row.
+// Arguments:
+// - kind - the kind of mark to look for
+// - row - the row to start looking from, relative to the top of the buffer
+// Return Value:
+// - The mark, or nullopt if there's none above the row.
+std::optional<ScrollMark> ScrollMarks::Previous(const MarkKind kind, const SHORT row) const
+{
+    const auto& marks = til::at(_marks, static_cast<size_t>(kind));
+    const auto it = std::lower_bound(marks.begin(), marks.end(), _origin + row, [](const Entry& entry, const int64_t value) noexcept {
+        return entry.row < value;
+    });
+    if (it == marks.begin())
+    {
+        return std::nullopt;
+    }
+    return _ToMark(*std::prev(it), kind);
+}
+
+// Routine Description:
+// - Finds the closest mark of the given kind below the given row.
+// Arguments:
+// - kind - the kind of mark to look for
+// - row - the row to start looking from, relative to the top of the buffer
+// Return Value:
+// - The mark, or nullopt if there's none below the row.
+std::optional<ScrollMark> ScrollMarks::Next(const MarkKind kind, const SHORT row) const
+{
+    const auto& marks = til::at(_marks, static_cast<size_t>(kind));
+    const auto it = std::upper_bound(marks.begin(), marks.end(), _origin + row, [](const int64_t value, const Entry& entry) noexcept {
+        return value < entry.row;
+    });
+    if (it == marks.end())
+    {
+        return std::nullopt;
+    }
+    return _ToMark(*it, kind);
+}
+
+// Routine Description:
+// - Finds the output of the last command that started to print at or above
+//   the given row. It ends where the command finished, or where the next
+//   prompt starts if the shell didn't mark that.
+// Arguments:
+// - row - the row to start looking from, relative to the top of the buffer
+// - unfinishedEnd - where the output ends if the command is still running
+// Return Value:
+// - The start of the output and the position right after its end,
+//   or nullopt if no command is marked at or above the row.
+std::optional<std::pair<COORD, COORD>> ScrollMarks::GetCommandOutput(const SHORT row, const COORD unfinishedEnd) const
+{
+    const auto& outputs = til::at(_marks, static_cast<size_t>(MarkKind::Output));
+    const auto it = std::upper_bound(outputs.begin(), outputs.end(), _origin + row, [](const int64_t value, const Entry& entry) noexcept {
+        return value < entry.row;
+    });
+    if (it == outputs.begin())
+    {
+        return std::nullopt;
+    }
+    const auto& output = *std::prev(it);
+
+    const Entry* end = nullptr;
+    for (const auto kind : { MarkKind::CommandFinished, MarkKind::Prompt })
+    {
+        const auto& marks = til::at(_marks, static_cast<size_t>(kind));
+        const auto next = std::upper_bound(marks.begin(), marks.end(), output, _IsBefore);
+        if (next != marks.end() && (!end || _IsBefore(*next, *end)))
+        {
+            end = &*next;
+        }
+    }
+
+    const auto start = _ToMark(output, MarkKind::Output).position;
+    return std::pair{ start, end ? _ToMark(*end, MarkKind::Output).position : unfinishedEnd };
+}
+
+bool ScrollMarks::_IsBefore(const Entry& a, const Entry& b) noexcept
+{
+    return a.row < b.row || (a.row == b.row && a.column < b.column);
+}
+
+ScrollMark ScrollMarks::_ToMark(const Entry& entry, const MarkKind kind) const noexcept
+{
+    return { COORD{ entry.column, gsl::narrow_cast<SHORT>(entry.row - _origin) }, kind, entry.exitCode };
+}
@@ -0,0 +1,74 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ScrollMarks.hpp
+
+Abstract:
+- The marks shells leave in the buffer with the FinalTerm sequences (OSC 133)
+  around their prompts, the commands typed into them and their output.
+- The marks of each kind are kept sorted by their position, which is counted
+  from the first row the buffer ever had. Circling the buffer thus only drops
+  the marks of the row that left it, and finding the prompt above or below a
+  row is a binary search, no matter how long the history is.
+--*/
+
+#pragma once
+
+#include <deque>
+
+enum class MarkKind : uint8_t
+{
+    Prompt = 0, // OSC 133;A - the prompt starts
+    Command = 1, // OSC 133;B - the prompt ends and the command starts
+    Output = 2, // OSC 133;C - the command was run and its output starts
+    CommandFinished = 3, // OSC 133;D - the command finished
+};
+
+struct ScrollMark
+{
+    COORD position; // relative to the top of the buffer
+    MarkKind kind;
+    std::optional<unsigned int> exitCode; // only ever set for CommandFinished
+};
+
+class ScrollMarks final
+{
+public:
+    void Add(const COORD position, const MarkKind kind, const std::optional<unsigned int> exitCode = std::nullopt);
+    void DiscardRows(const size_t count);
+    void Truncate(const size_t height);
+    void MoveRows(const SHORT firstRow, const SHORT size, const SHORT delta);
+    void Clear() noexcept;
+
+    int64_t GetOrigin() const noexcept;
+    size_t size() const noexcept;
+    std::vector<ScrollMark> GetAll() const;
+
+    std::optional<ScrollMark> Previous(const MarkKind kind, const SHORT row) const;
+    std::optional<ScrollMark> Next(const MarkKind kind, const SHORT row) const;
+    std::optional<std::pair<COORD, COORD>> GetCommandOutput(const SHORT row, const COORD unfinishedEnd) const;
+
+private:
+    struct Entry
+    {
+        int64_t row; // counted from the first row the buffer ever had
+        SHORT column;
+        std::optional<unsigned int> exitCode;
+    };
+
+    static constexpr size_t KindCount = 4;
+
+    static bool _IsBefore(const Entry& a, const Entry& b) noexcept;
+    ScrollMark _ToMark(const Entry& entry, const MarkKind kind) const noexcept;
+
+    // The marks of each MarkKind, sorted by their position.
+    std::array<std::deque<Entry>, KindCount> _marks;
+    // The number of rows that left the top of the buffer since it was created.
+    int64_t _origin = 0;
+
+#ifdef UNIT_TESTING
+    friend class ScrollMarksTests;
+#endif
+};
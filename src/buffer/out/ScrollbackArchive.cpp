@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ScrollbackArchive.hpp"
+#include "Row.hpp"
+
+// Routine Description:
+// - constructor. Creates the temporary file backing the archive. The file is
+//   deleted by the system as soon as the archive is destroyed.
+// Arguments:
+// - <none>
+// Return Value:
+// - instantiated object
+// Note: will throw if the backing file can't be created
+ScrollbackArchive::ScrollbackArchive() :
+    _mappedSize{ 0 },
+    _fileSize{ 0 }
+{
+    wchar_t directory[MAX_PATH + 1];
+    THROW_LAST_ERROR_IF(GetTempPathW(ARRAYSIZE(directory), directory) == 0);
+
+    wchar_t path[MAX_PATH + 1];
+    THROW_LAST_ERROR_IF(GetTempFileNameW(directory, L"wts", 0, path) == 0);
+
+    _file.reset(CreateFileW(path,
+                            GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_DELETE,
+                            nullptr,
+                            CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                            nullptr));
+    THROW_LAST_ERROR_IF(!_file);
+}
+
+// Routine Description:
+// - Serializes the given row and appends it to the end of the archive.
+//   Only the text up to the last non-space character is stored, together
+//   with the attribute runs of the row.
+// Arguments:
+// - row - the row to archive
+// Return Value:
+// - <none>
+// Note: will throw if the row couldn't be written to the backing file
+void ScrollbackArchive::Append(const ROW& row)
+{
+    auto text = row.GetText();
+    text.erase(text.find_last_not_of(UNICODE_SPACE) + 1);
+
+    const auto& attrRow = row.GetAttrRow();
+    const auto& runs = attrRow._data.runs();
+
+    RecordHeader header{};
+    header.textLength = gsl::narrow<uint32_t>(text.size());
+    header.runCount = gsl::narrow<uint16_t>(runs.size());
+    header.flags = row.WasWrapForced() ? WrapForcedFlag : 0;
+
+    std::vector<std::byte> record(sizeof(header) + text.size() * sizeof(wchar_t) + runs.size() * sizeof(RecordRun));
+    auto out = record.data();
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    memcpy(out, text.data(), text.size() * sizeof(wchar_t));
+    out += text.size() * sizeof(wchar_t);
+    for (const auto& run : runs)
+    {
+        RecordRun serialized{ attrRow._table->At(run.value), run.length };
+        // Hyperlinks are pruned from the buffer once they've left it,
+        // so the archive couldn't resolve their IDs anyways.
+        serialized.attr.SetHyperlinkId(0);
+        memcpy(out, &serialized, sizeof(serialized));
+        out += sizeof(serialized);
+    }
+
+    LARGE_INTEGER position{};
+    position.QuadPart = gsl::narrow<LONGLONG>(_fileSize);
+    THROW_IF_WIN32_BOOL_FALSE(SetFilePointerEx(_file.get(), position, nullptr, FILE_BEGIN));
+
+    DWORD written = 0;
+    THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), record.data(), gsl::narrow<DWORD>(record.size()), &written, nullptr));
+    THROW_HR_IF(E_UNEXPECTED, written != record.size());
+
+    _offsets.emplace_back(_fileSize);
+    _fileSize += record.size();
+}
+
+// Routine Description:
+// - gets the number of rows in the archive
+// Arguments:
+// - <none>
+// Return Value:
+// - the number of archived rows
+size_t ScrollbackArchive::size() const noexcept
+{
+    return _offsets.size();
+}
+
+// Routine Description:
+// - Retrieves an archived row, paging it in from the backing file if it
+//   isn't in the cache already.
+// Arguments:
+// - index - the index of the row, with 0 being the oldest archived row
+// Return Value:
+// - a copy of the archived row
+// Note: will throw exception if index is out of bounds
+ArchivedRow ScrollbackArchive::GetRow(const size_t index)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _offsets.size());
+
+    const auto it = std::find_if(_cache.begin(), _cache.end(), [=](const auto& entry) noexcept {
+        return entry.first == index;
+    });
+    if (it != _cache.end())
+    {
+        _cache.splice(_cache.begin(), _cache, it);
+        return _cache.front().second;
+    }
+
+    _cache.emplace_front(index, _ReadRow(index));
+    if (_cache.size() > CacheSize)
+    {
+        _cache.pop_back();
+    }
+    return _cache.front().second;
+}
+
+// Routine Description:
+// - retrieves the text of an archived row
+// Arguments:
+// - index - the index of the row, with 0 being the oldest archived row
+// Return Value:
+// - the text of the row, without any trailing spaces
+// Note: will throw exception if index is out of bounds
+std::wstring ScrollbackArchive::GetText(const size_t index)
+{
+    return GetRow(index).text;
+}
+
+// Routine Description:
+// - Looks for the first archived row at or after startIndex that contains
+//   the needle. The search is case-sensitive and doesn't span rows.
+// Arguments:
+// - needle - the text to search for
+// - startIndex - the index of the first row to search
+// Return Value:
+// - the index of the matching row, if any
+std::optional<size_t> ScrollbackArchive::FindRow(const std::wstring_view needle, const size_t startIndex)
+{
+    if (needle.empty())
+    {
+        return std::nullopt;
+    }
+
+    for (auto index = startIndex; index < _offsets.size(); ++index)
+    {
+        // Searching reads the rows straight from the mapped file, so that
+        // a search across the archive doesn't flush the cache.
+        if (_ReadRow(index).text.find(needle) != std::wstring::npos)
+        {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+// Routine Description:
+// - decodes a row from the mapped backing file
+// Arguments:
+// - index - the index of the row. Must be in bounds.
+// Return Value:
+// - the decoded row
+ArchivedRow ScrollbackArchive::_ReadRow(const size_t index)
+{
+    _EnsureMapped();
+
+    const auto offset = til::at(_offsets, index);
+    const auto end = index + 1 < _offsets.size() ? til::at(_offsets, index + 1) : _fileSize;
+    THROW_HR_IF(E_UNEXPECTED, end - offset < sizeof(RecordHeader));
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+    const auto* in = _view.get() + offset;
+
+    RecordHeader header{};
+    memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+
+    const auto textBytes = size_t{ header.textLength } * sizeof(wchar_t);
+    const auto runBytes = size_t{ header.runCount } * sizeof(RecordRun);
+    THROW_HR_IF(E_UNEXPECTED, end - offset != sizeof(header) + textBytes + runBytes);
+
+    ArchivedRow row;
+    row.wrapForced = WI_IsFlagSet(header.flags, WrapForcedFlag);
+    row.text.resize(header.textLength);
+    memcpy(row.text.data(), in, textBytes);
+    in += textBytes;
+
+    row.attributes.reserve(header.runCount);
+    for (uint16_t i = 0; i < header.runCount; ++i)
+    {
+        RecordRun run{};
+        memcpy(&run, in, sizeof(run));
+        in += sizeof(run);
+        row.attributes.emplace_back(run.attr, run.length);
+    }
+#pragma warning(pop)
+
+    return row;
+}
+
+// Routine Description:
+// - (re)maps the backing file, if it has grown since it was last mapped
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ScrollbackArchive::_EnsureMapped()
+{
+    if (_mappedSize == _fileSize)
+    {
+        return;
+    }
+
+    _view.reset();
+    _mapping.reset(CreateFileMappingW(_file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+    THROW_LAST_ERROR_IF(!_mapping);
+
+    _view.reset(static_cast<std::byte*>(MapViewOfFile(_mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+    THROW_LAST_ERROR_IF(!_view);
+
+    _mappedSize = _fileSize;
+}
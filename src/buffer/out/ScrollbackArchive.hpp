@@ -0,0 +1,80 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ScrollbackArchive.hpp
+
+Abstract:
+- Disk-backed storage for rows that have been pushed off the top of a
+  TextBuffer. Rows are serialized into an append-only temporary file, which
+  is memory-mapped for reading. Recently read rows are kept in a small LRU
+  cache, so that scrolling through the archive doesn't decode the same rows
+  over and over again.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+#include <list>
+
+class ROW;
+
+struct ArchivedRow
+{
+    std::wstring text;
+    std::vector<std::pair<TextAttribute, uint16_t>> attributes;
+    bool wrapForced = false;
+};
+
+class ScrollbackArchive final
+{
+public:
+    ScrollbackArchive();
+
+    void Append(const ROW& row);
+    size_t size() const noexcept;
+
+    ArchivedRow GetRow(const size_t index);
+    std::wstring GetText(const size_t index);
+    std::optional<size_t> FindRow(const std::wstring_view needle, const size_t startIndex);
+
+private:
+#pragma pack(push, 1)
+    struct RecordHeader
+    {
+        uint32_t textLength;
+        uint16_t runCount;
+        uint16_t flags;
+    };
+
+    struct RecordRun
+    {
+        TextAttribute attr;
+        uint16_t length;
+    };
+#pragma pack(pop)
+
+    static constexpr uint16_t WrapForcedFlag = 0x1;
+    static constexpr size_t CacheSize = 256;
+
+    ArchivedRow _ReadRow(const size_t index);
+    void _EnsureMapped();
+
+    wil::unique_hfile _file;
+    wil::unique_handle _mapping;
+    wil::unique_mapview_ptr<std::byte> _view;
+    uint64_t _mappedSize;
+    uint64_t _fileSize;
+
+    // file offset of each archived row, in the order they were appended
+    std::vector<uint64_t> _offsets;
+
+    // most recently used rows come first
+    std::list<std::pair<size_t, ArchivedRow>> _cache;
+
+#ifdef UNIT_TESTING
+    friend class ScrollbackArchiveTests;
+#endif
+};
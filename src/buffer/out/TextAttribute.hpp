@@ -180,6 +180,8 @@ private:
     TextColor _background; // sizeof: 4, alignof: 1
     ExtendedAttributes _extendedAttrs; // sizeof: 1, alignof: 1
 
+    friend struct std::hash<TextAttribute>;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class TextAttributeTests;
@@ -209,6 +211,32 @@ constexpr bool operator!=(const TextAttribute& a, const TextAttribute& b) noexce
     return !(a == b);
 }
 
+namespace std
+{
+    template<>
+    struct hash<TextAttribute>
+    {
+        // Routine Description:
+        // - hashes an attribute from all of the members its operator== compares.
+        // Arguments:
+        // - attr - the attribute to hash
+        // Return Value:
+        // - the hashed attribute
+        size_t operator()(const TextAttribute& attr) const noexcept
+        {
+            const hash<TextColor> hashColor;
+            const auto low = static_cast<uint64_t>(attr._wAttrLegacy) |
+                             static_cast<uint64_t>(attr._hyperlinkId) << 16 |
+                             static_cast<uint64_t>(hashColor(attr._foreground)) << 32;
+            const auto high = static_cast<uint64_t>(hashColor(attr._background)) |
+                              static_cast<uint64_t>(attr._extendedAttrs) << 32;
+            // Spread the high half over all bits before mixing it in, so that
+            // attributes that only differ in their background don't collide.
+            return hash<uint64_t>{}(low ^ (high * 0x9E3779B97F4A7C15ull));
+        }
+    };
+}
+
 #ifdef UNIT_TESTING
 
 #define LOG_ATTR(attr) (Log::Comment(NoThrowString().Format( \
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "TextAttributeTable.hpp"
+
+// Routine Description:
+// - Returns the ID for an attribute, handing out a new one if the attribute
+//   wasn't interned before.
+// Arguments:
+// - attr - The attribute to intern.
+// Return Value:
+// - The ID for the attribute, or nothing if it's new and the table is full.
+// Note:
+// - will throw on allocation failure
+std::optional<TextAttributeTable::id_type> TextAttributeTable::TryIntern(const TextAttribute& attr)
+{
+    if (_hasLast && _lastAttr == attr)
+    {
+        return _lastId;
+    }
+
+    if (const auto it = _ids.find(attr); it != _ids.end())
+    {
+        _lastAttr = attr;
+        _lastId = it->second;
+        _hasLast = true;
+        return it->second;
+    }
+
+    if (IsFull())
+    {
+        return std::nullopt;
+    }
+
+    if ((_size & PageMask) == 0)
+    {
+        _pages.emplace_back(std::make_unique<Page>());
+    }
+
+    const auto id = gsl::narrow_cast<id_type>(_size);
+    _ids.emplace(attr, id);
+    (*_pages.back())[id & PageMask] = attr;
+    ++_size;
+
+    _lastAttr = attr;
+    _lastId = id;
+    _hasLast = true;
+    return id;
+}
+
+// Routine Description:
+// - Returns the ID for an attribute without interning it.
+// Arguments:
+// - attr - The attribute to look for.
+// Return Value:
+// - The ID for the attribute, or nothing if it wasn't interned.
+std::optional<TextAttributeTable::id_type> TextAttributeTable::Find(const TextAttribute& attr) const noexcept
+{
+    if (_hasLast && _lastAttr == attr)
+    {
+        return _lastId;
+    }
+
+    if (const auto it = _ids.find(attr); it != _ids.end())
+    {
+        return it->second;
+    }
+
+    return std::nullopt;
+}
+
+size_t TextAttributeTable::Size() const noexcept
+{
+    return _size;
+}
+
+bool TextAttributeTable::IsFull() const noexcept
+{
+    return _size >= MaxSize;
+}
+
+// Routine Description:
+// - Estimates the bytes the table holds on to: its pages, and the nodes of
+//   the map the IDs are looked up in.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of bytes.
+size_t TextAttributeTable::MemoryUsage() const noexcept
+{
+    // Every node of the map holds the key and value next to a pointer to the next node.
+    static constexpr auto nodeSize = sizeof(std::pair<const TextAttribute, id_type>) + 2 * sizeof(void*);
+    return _pages.size() * sizeof(Page) + _ids.size() * nodeSize + _ids.bucket_count() * sizeof(void*);
+}
+
+// Routine Description:
+// - Returns the table that rows move to once this table is full, creating it on first use.
+// Arguments:
+// - <none>
+// Return Value:
+// - The successor of this table.
+// Note:
+// - will throw on allocation failure
+std::shared_ptr<TextAttributeTable> TextAttributeTable::GetSuccessor()
+{
+    if (!_successor)
+    {
+        _successor = std::make_shared<TextAttributeTable>();
+    }
+    return _successor;
+}
@@ -0,0 +1,75 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TextAttributeTable.hpp
+
+Abstract:
+- Interns the TextAttributes used by the rows of a text buffer, so that each
+  row only has to store a 16-bit ID per run of attributes.
+- The same handful of attributes is usually used across the whole buffer,
+  which makes the runs a lot smaller than full TextAttributes and turns the
+  comparison of two runs into a comparison of two integers.
+- IDs are never reused. Once all of them have been handed out, the table is
+  full and rows that need another attribute move over to its successor.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+class TextAttributeTable final
+{
+public:
+    using id_type = uint16_t;
+
+    static constexpr size_t MaxSize = static_cast<size_t>(std::numeric_limits<id_type>::max()) + 1;
+
+    TextAttributeTable() = default;
+
+    TextAttributeTable(const TextAttributeTable&) = delete;
+    TextAttributeTable& operator=(const TextAttributeTable&) = delete;
+
+    std::optional<id_type> TryIntern(const TextAttribute& attr);
+    std::optional<id_type> Find(const TextAttribute& attr) const noexcept;
+
+    // Routine Description:
+    // - Returns the attribute an ID was handed out for. The reference stays
+    //   valid for the lifetime of the table, even if attributes are added.
+    // Arguments:
+    // - id - An ID returned by TryIntern or Find.
+    // Return Value:
+    // - The attribute for the ID.
+    const TextAttribute& At(const id_type id) const noexcept
+    {
+        return (*_pages[id >> PageShift])[id & PageMask];
+    }
+
+    size_t Size() const noexcept;
+    bool IsFull() const noexcept;
+    size_t MemoryUsage() const noexcept;
+
+    std::shared_ptr<TextAttributeTable> GetSuccessor();
+
+private:
+    // The attributes are stored in fixed size pages, so that adding
+    // attributes never moves the ones that were handed out before.
+    static constexpr size_t PageShift = 8;
+    static constexpr size_t PageSize = 1 << PageShift;
+    static constexpr size_t PageMask = PageSize - 1;
+
+    using Page = std::array<TextAttribute, PageSize>;
+
+    std::vector<std::unique_ptr<Page>> _pages;
+    std::unordered_map<TextAttribute, id_type> _ids;
+    size_t _size = 0;
+
+    // Text is mostly written in long stretches of the same attribute,
+    // which this saves us from having to look up over and over again.
+    TextAttribute _lastAttr;
+    id_type _lastId = 0;
+    bool _hasLast = false;
+
+    std::shared_ptr<TextAttributeTable> _successor;
+};
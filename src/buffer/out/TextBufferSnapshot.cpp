@@ -0,0 +1,348 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "TextBufferSnapshot.hpp"
+#include "textBuffer.hpp"
+
+namespace
+{
+    // Collects what's saved into chunks and writes them to the file,
+    // so that a large buffer isn't written a few bytes at a time.
+    class ChunkWriter final
+    {
+    public:
+        ChunkWriter(const HANDLE file, const size_t chunkSize) :
+            _file{ file },
+            _chunkSize{ chunkSize }
+        {
+            _chunk.reserve(chunkSize);
+        }
+
+        void Append(const void* const data, const size_t length)
+        {
+            const auto bytes = static_cast<const std::byte*>(data);
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+            _chunk.insert(_chunk.end(), bytes, bytes + length);
+            if (_chunk.size() >= _chunkSize)
+            {
+                Flush();
+            }
+        }
+
+        template<typename T>
+        void Append(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Append(&value, sizeof(value));
+        }
+
+        void Append(const std::wstring_view text)
+        {
+            Append(text.data(), text.size() * sizeof(wchar_t));
+        }
+
+        void Flush()
+        {
+            if (_chunk.empty())
+            {
+                return;
+            }
+
+            DWORD written = 0;
+            THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file, _chunk.data(), gsl::narrow<DWORD>(_chunk.size()), &written, nullptr));
+            THROW_HR_IF(E_UNEXPECTED, written != _chunk.size());
+            _chunk.clear();
+        }
+
+    private:
+        HANDLE _file;
+        size_t _chunkSize;
+        std::vector<std::byte> _chunk;
+    };
+
+    // Reads what's saved from a mapped view of the file,
+    // making sure that nothing is read past its end.
+    class ViewReader final
+    {
+    public:
+        ViewReader(const std::byte* const data, const size_t length) noexcept :
+            _data{ data },
+            _length{ length },
+            _offset{ 0 }
+        {
+        }
+
+        const std::byte* Consume(const size_t length)
+        {
+            THROW_HR_IF(E_UNEXPECTED, length > _length - _offset);
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+            const auto data = _data + _offset;
+            _offset += length;
+            return data;
+        }
+
+        template<typename T>
+        T Read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            memcpy(&value, Consume(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        std::wstring_view ReadText(const size_t length)
+        {
+            THROW_HR_IF(E_UNEXPECTED, length > (_length - _offset) / sizeof(wchar_t));
+            // The records are packed, so the text might not be aligned.
+            // That's fine for the CPUs we run on, but it's why it's read
+            // as a view instead of being cast to wchar_t up front.
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast.
+            return { reinterpret_cast<const wchar_t*>(Consume(length * sizeof(wchar_t))), length };
+        }
+
+    private:
+        const std::byte* _data;
+        size_t _length;
+        size_t _offset;
+    };
+}
+
+// Routine Description:
+// - Saves the contents of the given buffer into a new file at the given path,
+//   replacing any file that's already there.
+// - The rows are serialized one at a time and written out in large chunks,
+//   so this doesn't need more memory than one row and one chunk take.
+// Arguments:
+// - buffer - The buffer to save.
+// - path - The path of the snapshot file.
+// Return Value:
+// - <none>
+// Note: will throw if the file couldn't be written
+void TextBufferSnapshot::Save(const TextBuffer& buffer, const std::filesystem::path& path)
+{
+    wil::unique_hfile file{ CreateFileW(path.c_str(),
+                                        GENERIC_WRITE,
+                                        0,
+                                        nullptr,
+                                        CREATE_ALWAYS,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    ChunkWriter writer{ file.get(), WriteChunkSize };
+
+    const auto& cursor = buffer.GetCursor();
+    const auto cursorPosition = cursor.GetPosition();
+
+    FileHeader header{};
+    header.magic = Magic;
+    header.version = Version;
+    header.width = gsl::narrow<uint16_t>(buffer.GetSize().Width());
+    header.height = buffer.TotalRowCount();
+    header.cursorX = cursorPosition.X;
+    header.cursorY = cursorPosition.Y;
+    header.cursorSize = cursor.GetSize();
+    header.cursorType = gsl::narrow<uint8_t>(static_cast<int>(cursor.GetType()));
+    header.cursorFlags = cursor.IsVisible() ? CursorVisibleFlag : 0;
+    header.currentHyperlinkId = buffer._currentHyperlinkId;
+    header.hyperlinkCount = gsl::narrow<uint32_t>(buffer._hyperlinkMap.size());
+    header.customIdCount = gsl::narrow<uint32_t>(buffer._hyperlinkCustomIdMap.size());
+    writer.Append(header);
+
+    const std::wstring_view uris{ buffer._hyperlinkUris };
+    for (const auto& [id, uri] : buffer._hyperlinkMap)
+    {
+        writer.Append(HyperlinkRecord{ id, gsl::narrow<uint32_t>(uri.length) });
+        writer.Append(uris.substr(uri.offset, uri.length));
+    }
+    for (const auto& [customId, id] : buffer._hyperlinkCustomIdMap)
+    {
+        writer.Append(HyperlinkRecord{ id, gsl::narrow<uint32_t>(customId.size()) });
+        writer.Append(customId);
+    }
+
+    // These are reused from one row to the next.
+    RowCells cells;
+    std::wstring text;
+    std::vector<uint16_t> cellTable;
+
+    for (size_t y = 0; y < header.height; ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        row.ReadCells(0, row.size(), cells);
+
+        // Blanks at the end of the row aren't stored, they're what a row is reset to.
+        auto cellCount = cells.size();
+        while (cellCount > 0 && cells.dbcsAttrs[cellCount - 1].IsSingle() && cells.glyphs[cellCount - 1] == L" ")
+        {
+            --cellCount;
+        }
+
+        text.clear();
+        cellTable.clear();
+        auto simple = true;
+        for (size_t x = 0; x < cellCount; ++x)
+        {
+            const auto& dbcsAttr = cells.dbcsAttrs[x];
+            if (dbcsAttr.IsTrailing())
+            {
+                continue;
+            }
+
+            const auto glyph = cells.glyphs[x];
+            text.append(glyph);
+            cellTable.emplace_back(gsl::narrow_cast<uint16_t>(gsl::narrow<uint16_t>(glyph.size()) | (dbcsAttr.IsLeading() ? WideCell : 0)));
+            simple = simple && dbcsAttr.IsSingle() && glyph.size() == 1;
+        }
+
+        RowHeader rowHeader{};
+        rowHeader.textLength = gsl::narrow<uint32_t>(text.size());
+        rowHeader.cellCount = gsl::narrow<uint16_t>(cellCount);
+        rowHeader.runCount = gsl::narrow<uint16_t>(cells.attrs.size());
+        rowHeader.flags = gsl::narrow_cast<uint8_t>((row.WasWrapForced() ? WrapForcedFlag : 0) |
+                                                    (row.WasDoubleBytePadded() ? DoubleBytePaddedFlag : 0) |
+                                                    (simple ? 0 : CellTableFlag));
+        rowHeader.lineRendition = gsl::narrow<uint8_t>(static_cast<int>(row.GetLineRendition()));
+        writer.Append(rowHeader);
+        writer.Append(text);
+        if (!simple)
+        {
+            writer.Append(cellTable.data(), cellTable.size() * sizeof(uint16_t));
+        }
+        for (const auto& run : cells.attrs)
+        {
+            writer.Append(RecordRun{ run.attr, gsl::narrow<uint16_t>(run.length) });
+        }
+    }
+
+    writer.Flush();
+}
+
+// Routine Description:
+// - Replaces the contents of the given buffer with those of a snapshot that
+//   was saved by Save. The buffer is resized to the size of the snapshot.
+// - The file is mapped rather than read in, so it's paged in by the system
+//   as the rows are decoded, and each row is decoded straight into the buffer.
+// Arguments:
+// - buffer - The buffer to restore the snapshot into.
+// - path - The path of the snapshot file.
+// Return Value:
+// - <none>
+// Note: will throw if the file couldn't be read or isn't a valid snapshot.
+//   The buffer might have been partially restored by then.
+void TextBufferSnapshot::Load(TextBuffer& buffer, const std::filesystem::path& path)
+{
+    wil::unique_hfile file{ CreateFileW(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+    THROW_HR_IF(E_UNEXPECTED, gsl::narrow<uint64_t>(fileSize.QuadPart) < sizeof(FileHeader));
+
+    wil::unique_handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    THROW_LAST_ERROR_IF(!mapping);
+    wil::unique_mapview_ptr<std::byte> view{ static_cast<std::byte*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0)) };
+    THROW_LAST_ERROR_IF(!view);
+
+    ViewReader reader{ view.get(), gsl::narrow<size_t>(fileSize.QuadPart) };
+
+    const auto header = reader.Read<FileHeader>();
+    THROW_HR_IF(E_UNEXPECTED, header.magic != Magic || header.version != Version);
+    THROW_HR_IF(E_UNEXPECTED, header.width == 0 || header.height == 0 || header.height > SHRT_MAX);
+
+    THROW_IF_FAILED(buffer.ResizeTraditional({ gsl::narrow<SHORT>(header.width), gsl::narrow<SHORT>(header.height) }));
+
+    buffer._hyperlinkUris.clear();
+    buffer._hyperlinkUrisGarbage = 0;
+    buffer._hyperlinkMap.clear();
+    buffer._hyperlinkCustomIdMap.clear();
+    for (uint32_t i = 0; i < header.hyperlinkCount; ++i)
+    {
+        const auto record = reader.Read<HyperlinkRecord>();
+        buffer.AddHyperlinkToMap(reader.ReadText(record.length), record.id);
+    }
+    for (uint32_t i = 0; i < header.customIdCount; ++i)
+    {
+        const auto record = reader.Read<HyperlinkRecord>();
+        buffer._hyperlinkCustomIdMap.insert_or_assign(std::wstring{ reader.ReadText(record.length) }, record.id);
+    }
+    buffer._currentHyperlinkId = header.currentHyperlinkId;
+
+    const auto fillAttributes = buffer.GetCurrentAttributes();
+    for (size_t y = 0; y < header.height; ++y)
+    {
+        const auto rowHeader = reader.Read<RowHeader>();
+        THROW_HR_IF(E_UNEXPECTED, rowHeader.cellCount > header.width);
+
+        auto& row = buffer.GetRowByOffset(y);
+        row.Reset(fillAttributes);
+        row.SetWrapForced(WI_IsFlagSet(rowHeader.flags, WrapForcedFlag));
+        row.SetDoubleBytePadded(WI_IsFlagSet(rowHeader.flags, DoubleBytePaddedFlag));
+        row.SetLineRendition(static_cast<LineRendition>(rowHeader.lineRendition));
+
+        const auto text = reader.ReadText(rowHeader.textLength);
+        auto& charRow = row.GetCharRow();
+        if (WI_IsFlagClear(rowHeader.flags, CellTableFlag))
+        {
+            THROW_HR_IF(E_UNEXPECTED, text.size() != rowHeader.cellCount);
+            charRow.WriteNarrowGlyphs(0, text);
+        }
+        else
+        {
+            size_t offset = 0;
+            size_t x = 0;
+            while (x < rowHeader.cellCount)
+            {
+                const auto cell = reader.Read<uint16_t>();
+                const size_t length = cell & ~WideCell;
+                const auto wide = WI_IsFlagSet(cell, WideCell);
+                THROW_HR_IF(E_UNEXPECTED, length == 0 || length > text.size() - offset || (wide && x + 1 >= rowHeader.cellCount));
+
+                const auto glyph = text.substr(offset, length);
+                offset += length;
+                charRow.GlyphAt(x) = glyph;
+                if (wide)
+                {
+                    charRow.DbcsAttrAt(x).SetLeading();
+                    charRow.GlyphAt(x + 1) = glyph;
+                    charRow.DbcsAttrAt(x + 1).SetTrailing();
+                    x += 2;
+                }
+                else
+                {
+                    ++x;
+                }
+            }
+            THROW_HR_IF(E_UNEXPECTED, offset != text.size());
+        }
+
+        auto& attrRow = row.GetAttrRow();
+        size_t column = 0;
+        for (uint16_t i = 0; i < rowHeader.runCount; ++i)
+        {
+            const auto run = reader.Read<RecordRun>();
+            THROW_HR_IF(E_UNEXPECTED, run.length > header.width - column);
+            attrRow.Replace(gsl::narrow_cast<uint16_t>(column), gsl::narrow_cast<uint16_t>(column + run.length), run.attr);
+            column += run.length;
+        }
+    }
+
+    auto& cursor = buffer.GetCursor();
+    cursor.SetSize(header.cursorSize);
+    cursor.SetType(static_cast<CursorType>(header.cursorType));
+    cursor.SetIsVisible(WI_IsFlagSet(header.cursorFlags, CursorVisibleFlag));
+    COORD cursorPosition{ header.cursorX, header.cursorY };
+    buffer.GetSize().Clamp(cursorPosition);
+    cursor.SetPosition(cursorPosition);
+
+    buffer._hyperlinkCountsStale = true;
+    buffer.GetRenderTarget().TriggerRedrawAll();
+}
@@ -0,0 +1,94 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TextBufferSnapshot.hpp
+
+Abstract:
+- Saves the contents of a TextBuffer into a compact binary file and restores
+  them from it, so that a buffer can outlive the session it was created in.
+- A snapshot holds the text and the attribute runs of every row, its wrap
+  and double byte padding flags and line rendition, the hyperlinks the rows
+  refer to and the cursor. Rows are streamed into the file one at a time
+  on save, and decoded straight into the buffer from a mapped view of the
+  file on restore, so neither side holds a copy of the whole buffer.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+class TextBuffer;
+
+class TextBufferSnapshot final
+{
+public:
+    static void Save(const TextBuffer& buffer, const std::filesystem::path& path);
+    static void Load(TextBuffer& buffer, const std::filesystem::path& path);
+
+private:
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t width;
+        uint32_t height;
+        int16_t cursorX;
+        int16_t cursorY;
+        uint32_t cursorSize;
+        uint8_t cursorType;
+        uint8_t cursorFlags;
+        uint16_t currentHyperlinkId;
+        uint32_t hyperlinkCount;
+        uint32_t customIdCount;
+    };
+
+    // Followed by the URI, or the custom ID respectively.
+    struct HyperlinkRecord
+    {
+        uint16_t id;
+        uint32_t length;
+    };
+
+    // Followed by the text of the cells, the cell table (if CellTableFlag
+    // is set) and the attribute runs. The text is that of the cells up to
+    // the last one that isn't a blank, and the trailing half of a wide glyph
+    // doesn't repeat it. Rows that only hold one UTF-16 code unit per cell
+    // don't need a cell table, for all the others it holds the number of
+    // code units of each cell in the text, and whether it's a wide glyph.
+    struct RowHeader
+    {
+        uint32_t textLength;
+        uint16_t cellCount;
+        uint16_t runCount;
+        uint8_t flags;
+        uint8_t lineRendition;
+    };
+
+    struct RecordRun
+    {
+        TextAttribute attr;
+        uint16_t length;
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t Magic = 0x53425457; // "WTBS"
+    static constexpr uint16_t Version = 1;
+
+    static constexpr uint8_t CursorVisibleFlag = 0x1;
+
+    static constexpr uint8_t WrapForcedFlag = 0x1;
+    static constexpr uint8_t DoubleBytePaddedFlag = 0x2;
+    static constexpr uint8_t CellTableFlag = 0x4;
+
+    static constexpr uint16_t WideCell = 0x8000;
+
+    // How much is collected before it's written to the file.
+    static constexpr size_t WriteChunkSize = 1024 * 1024;
+
+#ifdef UNIT_TESTING
+    friend class TextBufferSnapshotTests;
+#endif
+};
@@ -108,6 +108,8 @@ private:
     BYTE _blue;
     ColorType _meta;
 
+    friend struct std::hash<TextColor>;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     template<typename TextColor>
@@ -128,6 +130,27 @@ bool constexpr operator!=(const TextColor& a, const TextColor& b) noexcept
     return !(a == b);
 }
 
+namespace std
+{
+    template<>
+    struct hash<TextColor>
+    {
+        // Routine Description:
+        // - hashes a color by storing its type and its three bytes consecutively in the lower bits of a size_t.
+        // Arguments:
+        // - color - the color to hash
+        // Return Value:
+        // - the hashed color
+        constexpr size_t operator()(const TextColor& color) const noexcept
+        {
+            return static_cast<size_t>(color._red) |
+                   static_cast<size_t>(color._green) << 8 |
+                   static_cast<size_t>(color._blue) << 16 |
+                   static_cast<size_t>(color._meta) << 24;
+        }
+    };
+}
+
 #ifdef UNIT_TESTING
 
 namespace WEX
@@ -77,6 +77,7 @@ public:
     void DecrementYPosition(const int DeltaY) noexcept;
 
     void CopyProperties(const Cursor& OtherCursor) noexcept;
+    void Reset(const ULONG ulSize) noexcept;
 
     void DelayEOLWrap(const COORD coordDelayedAt) noexcept;
     void ResetDelayEOLWrap() noexcept;
@@ -10,6 +10,8 @@
 #include "../types/inc/Utf16Parser.hpp"
 #include "../types/inc/GlyphWidth.hpp"
 
+#include <thread>
+
 using namespace Microsoft::Console::Types;
 
 // Routine Description:
@@ -22,13 +24,17 @@ using namespace Microsoft::Console::Types;
 // - str - The search term you want to find (the "needle")
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
+// - mode - Whether str is the literal text to find or a regular expression
 Search::Search(IUiaData& uiaData,
                const std::wstring& str,
                const Direction direction,
-               const Sensitivity sensitivity) :
+               const Sensitivity sensitivity,
+               const Mode mode) :
     _direction(direction),
     _sensitivity(sensitivity),
+    _mode(mode),
     _needle(s_CreateNeedleFromString(str)),
+    _pattern(str),
     _uiaData(uiaData),
     _coordAnchor(s_GetInitialAnchor(uiaData, direction))
 {
@@ -46,14 +52,18 @@ Search::Search(IUiaData& uiaData,
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
 // - anchor - starting search location in screenInfo
+// - mode - Whether str is the literal text to find or a regular expression
 Search::Search(IUiaData& uiaData,
                const std::wstring& str,
                const Direction direction,
                const Sensitivity sensitivity,
-               const COORD anchor) :
+               const COORD anchor,
+               const Mode mode) :
     _direction(direction),
     _sensitivity(sensitivity),
+    _mode(mode),
     _needle(s_CreateNeedleFromString(str)),
+    _pattern(str),
     _coordAnchor(anchor),
     _uiaData(uiaData)
 {
@@ -75,22 +85,82 @@ bool Search::FindNext()
         return false;
     }
 
-    do
+    // We visit the positions up to the end of the written text, starting at
+    // _coordNext and wrapping around, until we get back to the anchor.
+    // Instead of comparing at every one of them, pick the closest match.
+    const auto& matches = _GetMatches();
+    const auto positions = _CoordToOffset(_uiaData.GetTextBufferEndPosition()) + 1;
+    const auto next = _CoordToOffset(_coordNext);
+    const auto anchor = _CoordToOffset(_coordAnchor);
+    const auto forward = _direction == Direction::Forward;
+
+    const auto distance = [&](const size_t offset) noexcept {
+        return forward ? (offset + positions - next) % positions : (next + positions - offset) % positions;
+    };
+
+    // matches are sorted by their offset, which is all we compare here
+    const auto byOffset = [](const auto& lhs, const auto& rhs) noexcept {
+        return lhs.first < rhs.first;
+    };
+
+    std::optional<std::pair<size_t, size_t>> found;
+    if (forward)
     {
-        if (_FindNeedleInHaystackAt(_coordNext, _coordSelStart, _coordSelEnd))
+        const auto it = std::lower_bound(matches.begin(), matches.end(), std::pair{ next, size_t{ 0 } }, byOffset);
+        if (it != matches.end() && it->first < positions)
         {
-            _UpdateNextPosition();
-            _reachedEnd = _coordNext == _coordAnchor;
-            return true;
+            found = *it;
         }
-        else
+        else if (!matches.empty() && matches.front().first < positions)
         {
-            _UpdateNextPosition();
+            found = matches.front();
         }
+    }
+    else
+    {
+        auto it = std::upper_bound(matches.begin(), matches.end(), std::pair{ std::min(next, positions - 1), size_t{ 0 } }, byOffset);
+        if (it == matches.begin())
+        {
+            it = std::lower_bound(matches.begin(), matches.end(), std::pair{ positions, size_t{ 0 } }, byOffset);
+        }
+        if (it != matches.begin())
+        {
+            found = *(it - 1);
+        }
+    }
 
-    } while (_coordNext != _coordAnchor);
+    const auto limit = next == anchor ? positions : distance(anchor);
+    if (!found || distance(found->first) >= limit)
+    {
+        _coordNext = _coordAnchor;
+        return false;
+    }
 
-    return false;
+    _coordSelStart = _OffsetToCoord(found->first);
+    _coordSelEnd = _OffsetToCoord(found->first + found->second - 1);
+    _coordNext = _coordSelStart;
+    _UpdateNextPosition();
+    _reachedEnd = _coordNext == _coordAnchor;
+    return true;
+}
+
+// Routine Description
+// - Locates every instance of the search term within the screen buffer.
+// Arguments:
+// - <none> - Uses internal state from constructor
+// Return Value:
+// - The [start, end] coord positions of every match, from the top of the buffer to the bottom.
+std::vector<std::pair<COORD, COORD>> Search::FindAll()
+{
+    const auto& matches = _GetMatches();
+
+    std::vector<std::pair<COORD, COORD>> found;
+    found.reserve(matches.size());
+    for (const auto& [offset, length] : matches)
+    {
+        found.emplace_back(_OffsetToCoord(offset), _OffsetToCoord(offset + length - 1));
+    }
+    return found;
 }
 
 // Routine Description:
@@ -323,6 +393,294 @@ void Search::_UpdateNextPosition()
     }
 }
 
+// Routine Description:
+// - Finds all the matches in the buffer, the first time it's called.
+// Arguments:
+// - <none>
+// Return Value:
+// - The buffer offset and length of every match, in ascending order.
+const std::vector<std::pair<size_t, size_t>>& Search::_GetMatches()
+{
+    if (!_matches)
+    {
+        _matches = _mode == Mode::Regex ? _GetRegexMatches() : _GetLiteralMatches();
+    }
+    return *_matches;
+}
+
+// Routine Description:
+// - Finds all the matches of the needle in the buffer.
+// - The text of the buffer is extracted into one flat array with one wchar_t
+//   per cell, which is then scanned in chunks of rows on multiple threads.
+//   Matches may span rows, like with _FindNeedleInHaystackAt.
+// Arguments:
+// - <none>
+// Return Value:
+// - The buffer offset and length of every match, in ascending order.
+std::vector<std::pair<size_t, size_t>> Search::_GetLiteralMatches() const
+{
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    const auto width = gsl::narrow_cast<size_t>(textBuffer.GetSize().Width());
+    const auto height = gsl::narrow_cast<size_t>(textBuffer.GetSize().Height());
+    const auto needle = _GetFlattenedNeedle();
+
+    std::vector<std::pair<size_t, size_t>> matches;
+    if (!needle.empty() && needle.size() <= width * height)
+    {
+        // Small buffers aren't worth spinning up threads for.
+        constexpr size_t minimumRowsPerChunk = 256;
+        const auto chunkCount = std::clamp<size_t>(height / minimumRowsPerChunk, 1, std::max(1u, std::thread::hardware_concurrency()));
+        const auto rowsPerChunk = (height + chunkCount - 1) / chunkCount;
+
+        std::vector<wchar_t> haystack(width * height);
+        s_ForEachChunk(chunkCount, [&](const size_t chunk) {
+            const auto lastRow = std::min(height, (chunk + 1) * rowsPerChunk);
+            for (auto row = chunk * rowsPerChunk; row < lastRow; ++row)
+            {
+                const gsl::span<wchar_t> rowText{ haystack.data() + row * width, width };
+                textBuffer.GetRowByOffset(row).GetCharRow().CopyCellChars(rowText, s_storedGlyphPlaceholder);
+                if (_sensitivity == Sensitivity::CaseInsensitive)
+                {
+                    std::transform(rowText.begin(), rowText.end(), rowText.begin(), [](const wchar_t wch) noexcept {
+                        return wch == s_storedGlyphPlaceholder ? wch : gsl::narrow_cast<wchar_t>(::towlower(wch));
+                    });
+                }
+            }
+        });
+
+        const std::wstring_view haystackView{ haystack.data(), haystack.size() };
+        const std::wstring_view needleView{ needle.data(), needle.size() };
+        std::vector<std::vector<size_t>> chunkMatches(chunkCount);
+        s_ForEachChunk(chunkCount, [&](const size_t chunk) {
+            const auto first = std::min(height, chunk * rowsPerChunk) * width;
+            const auto last = std::min(height, (chunk + 1) * rowsPerChunk) * width;
+            s_FindInRange(haystackView, needleView, first, last, til::at(chunkMatches, chunk));
+        });
+
+        // A placeholder only tells us that both cells hold some glyph that
+        // doesn't fit into a wchar_t. Check those candidates cell by cell.
+        const auto needsVerification = needleView.find(s_storedGlyphPlaceholder) != std::wstring_view::npos;
+        for (const auto& found : chunkMatches)
+        {
+            for (const auto offset : found)
+            {
+                COORD start{};
+                COORD end{};
+                if (!needsVerification || _FindNeedleInHaystackAt(_OffsetToCoord(offset), start, end))
+                {
+                    matches.emplace_back(offset, needle.size());
+                }
+            }
+        }
+    }
+
+    return matches;
+}
+
+// Routine Description:
+// - Finds all the matches of the regular expression in the buffer.
+// - The text of all rows is joined together, so that matches can span rows.
+//   The row text is shared with TextBuffer::GetPatterns through
+//   TextBuffer::GetCachedRowText, so it's only extracted once for as
+//   long as the row doesn't change. Empty matches are skipped.
+// Arguments:
+// - <none>
+// Return Value:
+// - The buffer offset and length of every match, in ascending order.
+//   Empty if the pattern isn't a valid regular expression.
+std::vector<std::pair<size_t, size_t>> Search::_GetRegexMatches() const
+{
+    std::wregex regex;
+    try
+    {
+        auto flags = std::regex_constants::ECMAScript | std::regex_constants::optimize;
+        if (_sensitivity == Sensitivity::CaseInsensitive)
+        {
+            flags |= std::regex_constants::icase;
+        }
+        regex.assign(_pattern, flags);
+    }
+    catch (const std::regex_error&)
+    {
+        return {};
+    }
+
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    const auto height = gsl::narrow_cast<size_t>(textBuffer.GetSize().Height());
+
+    std::wstring text;
+    text.reserve(gsl::narrow_cast<size_t>(textBuffer.GetSize().Width()) * height);
+    for (size_t row = 0; row < height; ++row)
+    {
+        text += textBuffer.GetCachedRowText(row);
+    }
+
+    // The text has one character per narrow cell and one per wide glyph,
+    // so count the cells between the matches as we go.
+    const auto countCells = [](auto first, const auto last) noexcept {
+        size_t cells = 0;
+        for (; first != last; ++first)
+        {
+            cells += IsGlyphFullWidth(*first) ? 2 : 1;
+        }
+        return cells;
+    };
+
+    std::vector<std::pair<size_t, size_t>> matches;
+    size_t cellsUpToLast = 0;
+    auto lastEnd = text.cbegin();
+    const auto end = std::wsregex_iterator();
+    for (auto it = std::wsregex_iterator(text.cbegin(), text.cend(), regex); it != end; ++it)
+    {
+        const auto& match = (*it)[0];
+        if (match.length() == 0)
+        {
+            continue;
+        }
+
+        const auto start = cellsUpToLast + countCells(lastEnd, match.first);
+        const auto length = countCells(match.first, match.second);
+        matches.emplace_back(start, length);
+
+        cellsUpToLast = start + length;
+        lastEnd = match.second;
+    }
+    return matches;
+}
+
+// Routine Description:
+// - Runs func(chunk) for every chunk in [0, chunkCount), in parallel.
+//   The first chunk is run on the calling thread.
+// Arguments:
+// - chunkCount - the number of chunks
+// - func - the work to do for each chunk
+// Return Value:
+// - <none>
+// Note: rethrows the first exception thrown by any of the chunks
+template<typename F>
+void Search::s_ForEachChunk(const size_t chunkCount, F&& func)
+{
+    std::vector<std::exception_ptr> exceptions(chunkCount);
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount);
+
+    const auto run = [&](const size_t chunk) noexcept {
+        try
+        {
+            func(chunk);
+        }
+        catch (...)
+        {
+            til::at(exceptions, chunk) = std::current_exception();
+        }
+    };
+
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        threads.emplace_back(run, chunk);
+    }
+    run(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+// Routine Description:
+// - Finds all occurrences of needle that start within [first, last) of the
+//   haystack using Boyer-Moore-Horspool. Overlapping occurrences are reported.
+//   The bad character table is indexed by the low byte of each character,
+//   which keeps it small and only makes some of the skips shorter.
+// Arguments:
+// - haystack - the text to search through
+// - needle - the text to search for. Must not be empty.
+// - first - the offset of the first start position to check
+// - last - one past the offset of the last start position to check
+// - matches - receives the start offsets of the occurrences, in ascending order
+// Return Value:
+// - <none>
+void Search::s_FindInRange(const std::wstring_view haystack,
+                           const std::wstring_view needle,
+                           const size_t first,
+                           const size_t last,
+                           std::vector<size_t>& matches)
+{
+    const auto needleLength = needle.size();
+    if (needleLength > haystack.size())
+    {
+        return;
+    }
+
+    std::array<size_t, 256> skip;
+    skip.fill(needleLength);
+    for (size_t i = 0; i + 1 < needleLength; ++i)
+    {
+        til::at(skip, static_cast<size_t>(needle[i] & 0xFF)) = needleLength - 1 - i;
+    }
+
+    const auto lastStart = std::min(last, haystack.size() - needleLength + 1);
+    const auto needleBack = needle.back();
+    for (auto pos = first; pos < lastStart;)
+    {
+        const auto hayBack = haystack[pos + needleLength - 1];
+        if (hayBack == needleBack && haystack.compare(pos, needleLength - 1, needle, 0, needleLength - 1) == 0)
+        {
+            matches.emplace_back(pos);
+        }
+        pos += til::at(skip, static_cast<size_t>(hayBack & 0xFF));
+    }
+}
+
+// Routine Description:
+// - Flattens the needle into one wchar_t per cell, matching what
+//   CharRow::CopyCellChars produces for the buffer.
+// Arguments:
+// - <none>
+// Return Value:
+// - The flattened needle, with sensitivity applied.
+std::vector<wchar_t> Search::_GetFlattenedNeedle() const
+{
+    std::vector<wchar_t> needle;
+    needle.reserve(_needle.size());
+    for (const auto& cell : _needle)
+    {
+        needle.emplace_back(cell.size() == 1 ? _ApplySensitivity(cell.front()) : s_storedGlyphPlaceholder);
+    }
+    return needle;
+}
+
+// Routine Description:
+// - Converts an offset into the flattened buffer into a buffer coordinate.
+// Arguments:
+// - offset - Y * width + X
+// Return Value:
+// - the coordinate
+COORD Search::_OffsetToCoord(const size_t offset) const
+{
+    const auto width = gsl::narrow_cast<size_t>(_uiaData.GetTextBuffer().GetSize().Width());
+    return { gsl::narrow<SHORT>(offset % width), gsl::narrow<SHORT>(offset / width) };
+}
+
+// Routine Description:
+// - Converts a buffer coordinate into an offset into the flattened buffer.
+// Arguments:
+// - coord - the coordinate
+// Return Value:
+// - Y * width + X
+size_t Search::_CoordToOffset(const COORD coord) const
+{
+    const auto width = gsl::narrow_cast<size_t>(_uiaData.GetTextBuffer().GetSize().Width());
+    return gsl::narrow<size_t>(coord.Y) * width + gsl::narrow<size_t>(coord.X);
+}
+
 // Routine Description:
 // - Creates a "needle" of the correct format for comparison to the screen buffer text data
 //   that we can use for our search
@@ -40,18 +40,27 @@ public:
         CaseSensitive
     };
 
+    enum class Mode
+    {
+        Literal,
+        Regex
+    };
+
     Search(Microsoft::Console::Types::IUiaData& uiaData,
            const std::wstring& str,
            const Direction dir,
-           const Sensitivity sensitivity);
+           const Sensitivity sensitivity,
+           const Mode mode = Mode::Literal);
 
     Search(Microsoft::Console::Types::IUiaData& uiaData,
            const std::wstring& str,
            const Direction dir,
            const Sensitivity sensitivity,
-           const COORD anchor);
+           const COORD anchor,
+           const Mode mode = Mode::Literal);
 
     bool FindNext();
+    std::vector<std::pair<COORD, COORD>> FindAll();
     void Select() const;
     void Color(const TextAttribute attr) const;
 
@@ -63,6 +72,25 @@ private:
     bool _CompareChars(const std::wstring_view one, const std::wstring_view two) const noexcept;
     void _UpdateNextPosition();
 
+    const std::vector<std::pair<size_t, size_t>>& _GetMatches();
+    std::vector<std::pair<size_t, size_t>> _GetLiteralMatches() const;
+    std::vector<std::pair<size_t, size_t>> _GetRegexMatches() const;
+    std::vector<wchar_t> _GetFlattenedNeedle() const;
+    COORD _OffsetToCoord(const size_t offset) const;
+    size_t _CoordToOffset(const COORD coord) const;
+
+    template<typename F>
+    static void s_ForEachChunk(const size_t chunkCount, F&& func);
+    static void s_FindInRange(const std::wstring_view haystack,
+                              const std::wstring_view needle,
+                              const size_t first,
+                              const size_t last,
+                              std::vector<size_t>& matches);
+
+    // Stands in for cells whose glyph doesn't fit into a single wchar_t.
+    // Candidate matches involving it are verified against the real glyph.
+    static constexpr wchar_t s_storedGlyphPlaceholder{ 0xFFFF };
+
     void _IncrementCoord(COORD& coord) const noexcept;
     void _DecrementCoord(COORD& coord) const noexcept;
 
@@ -71,14 +99,19 @@ private:
     static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr);
 
     bool _reachedEnd = false;
+    // the buffer offset (Y * width + X) and length in cells of every match,
+    // in ascending order of their offsets
+    std::optional<std::vector<std::pair<size_t, size_t>>> _matches;
     COORD _coordNext = { 0 };
     COORD _coordSelStart = { 0 };
     COORD _coordSelEnd = { 0 };
 
     const COORD _coordAnchor;
     const std::vector<std::vector<wchar_t>> _needle;
+    const std::wstring _pattern;
     const Direction _direction;
     const Sensitivity _sensitivity;
+    const Mode _mode;
     Microsoft::Console::Types::IUiaData& _uiaData;
 
 #ifdef UNIT_TESTING
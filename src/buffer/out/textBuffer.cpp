@@ -10,6 +10,8 @@
 #include "../types/inc/convert.hpp"
 #include "../../types/inc/GlyphWidth.hpp"
 
+#include <execution>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console;
@@ -34,18 +36,23 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
     _firstRow{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
+    _rowPool{ til::pmr::get_default_resource() },
     _storage{},
-    _unicodeStorage{},
+    _attributeTable{ std::make_shared<TextAttributeTable>() },
     _renderTarget{ renderTarget },
     _size{},
+    _hyperlinkUrisGarbage{ 0 },
     _currentHyperlinkId{ 1 },
-    _currentPatternId{ 0 }
+    _hyperlinkCountsGeneration{ 0 },
+    _hyperlinkCountsStale{ true },
+    _currentPatternId{ 0 },
+    _generation{ 0 }
 {
     // initialize ROWs
     _storage.reserve(static_cast<size_t>(screenBufferSize.Y));
     for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
     {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
+        _MarkRowDirty(_storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this));
     }
 
     _UpdateSize();
@@ -103,7 +110,11 @@ ROW& TextBuffer::GetRowByOffset(const size_t index)
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    auto& row = _storage.at(offsetIndex);
+
+    // The caller might modify the row.
+    _MarkRowDirty(row);
+    return row;
 }
 
 // Routine Description:
@@ -335,6 +346,8 @@ OutputCellIterator TextBuffer::Write(const OutputCellIterator givenIt,
                                      const COORD target,
                                      const std::optional<bool> wrap)
 {
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
     // Make mutable copy so we can walk.
     auto it = givenIt;
 
@@ -373,6 +386,8 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
                                          const std::optional<bool> wrap,
                                          std::optional<size_t> limitRight)
 {
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
     // If we're not in bounds, exit early.
     if (!GetSize().IsInBounds(target))
     {
@@ -391,6 +406,218 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes a run of plain narrow text onto one line of the output buffer.
+// - This is a faster alternative to WriteLine for the common case of printable
+//   ASCII text with a single attribute. It stops at the end of the line and at
+//   the first character that needs a width lookup, leaving the rest to the caller.
+// - Like Write, this marks the row as wrapped if the last column gets filled.
+// Arguments:
+// - chars - The text to write
+// - attr - The attributes to apply to the written cells
+// - target - Coordinate targeted within output buffer
+// - onlyRedrawChanges - Only invalidate the cells whose text or attributes
+//   changed, see ROW::FindChangedCells. ConPTY doesn't want that, as it
+//   relies on every write being invalidated to keep the cursor and the
+//   wrapping of the terminal in sync with the buffer.
+// Return Value:
+// - The number of characters written, which is also the number of cells written.
+size_t TextBuffer::WriteRun(const std::wstring_view chars,
+                            const TextAttribute& attr,
+                            const COORD target,
+                            const bool onlyRedrawChanges)
+{
+    // If we're not in bounds, exit early.
+    if (chars.empty() || !GetSize().IsInBounds(target))
+    {
+        return 0;
+    }
+
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
+    ROW& row = GetRowByOffset(target.Y);
+    const auto [changedBegin, changedEnd] = onlyRedrawChanges ? row.FindChangedCells(chars, target.X, attr) : std::pair<size_t, size_t>{};
+    const auto written = row.WriteRun(chars, target.X, attr, true);
+
+    if (onlyRedrawChanges)
+    {
+        if (changedBegin < changedEnd)
+        {
+            const Viewport paint = Viewport::FromDimensions({ gsl::narrow<SHORT>(changedBegin), target.Y }, { gsl::narrow<SHORT>(changedEnd - changedBegin), 1 });
+            _NotifyPaint(paint);
+        }
+    }
+    else if (written != 0)
+    {
+        const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(written), 1 });
+        _NotifyPaint(paint);
+    }
+
+    return written;
+}
+
+// Routine Description:
+// - Draws a row of cells of an inline image onto one line of the output buffer.
+//   The image becomes part of the row, see ROW::CopyImageCells. The pixels
+//   beyond the right edge of the buffer are cut off.
+// Arguments:
+// - target - The cell the pixels start at
+// - cellSize - The number of pixels per cell the image is stored in
+// - pixels - cellSize.height() rows of pixelWidth pixels each
+// - pixelWidth - The width of a row of pixels, which must be whole cells
+// Return Value:
+// - <none>
+void TextBuffer::WriteImageSlice(const COORD target,
+                                 const til::size cellSize,
+                                 const gsl::span<const RGBQUAD> pixels,
+                                 const size_t pixelWidth)
+{
+    if (!GetSize().IsInBounds(target) || pixelWidth == 0)
+    {
+        return;
+    }
+
+    const auto cellWidth = cellSize.width<size_t>();
+    const auto cellHeight = cellSize.height<size_t>();
+    const auto available = gsl::narrow_cast<size_t>(GetSize().Width() - target.X);
+    const auto columns = std::min(pixelWidth / cellWidth, available);
+
+    ROW& row = GetRowByOffset(target.Y);
+    if (columns * cellWidth == pixelWidth)
+    {
+        row.CopyImageCells(cellSize, pixels, pixelWidth, target.X);
+    }
+    else
+    {
+        std::vector<RGBQUAD> clipped;
+        clipped.reserve(columns * cellWidth * cellHeight);
+        for (size_t y = 0; y < cellHeight; ++y)
+        {
+            const auto line = pixels.subspan(y * pixelWidth, columns * cellWidth);
+            clipped.insert(clipped.end(), line.begin(), line.end());
+        }
+        row.CopyImageCells(cellSize, clipped, columns * cellWidth, target.X);
+    }
+
+    _NotifyPaint(Viewport::FromDimensions(target, { gsl::narrow<SHORT>(columns), 1 }));
+}
+
+// Routine Description:
+// - Writes legacy CHAR_INFO cells onto one line of the output buffer.
+// - This is what WriteLine does with an OutputCellIterator over the same cells,
+//   without going through a view per cell. It stops at the end of the line.
+// Arguments:
+// - charInfos - The cells to write
+// - target - Coordinate targeted within output buffer
+// Return Value:
+// - The number of cells of charInfos that were written.
+size_t TextBuffer::WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos,
+                                  const COORD target)
+{
+    // If we're not in bounds, exit early.
+    if (charInfos.empty() || !GetSize().IsInBounds(target))
+    {
+        return 0;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    const auto written = row.WriteCharInfos(charInfos, target.X);
+
+    // Padding out the lead and trail bytes cut off by the edges of the row
+    // can touch one more column than there were cells.
+    const auto width = std::min(gsl::narrow_cast<size_t>(charInfos.size()) + 1, row.size() - target.X);
+    const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(width), 1 });
+    _NotifyPaint(paint);
+
+    return written;
+}
+
+// Routine Description:
+// - Hands the cells from target on to fillRow a row at a time, until count
+//   cells were filled or the end of the buffer was reached, and then
+//   invalidates the whole region at once.
+// Arguments:
+// - target - Coordinate the fill starts at
+// - count - The number of cells to fill
+// - fillRow - Called with the row, the column to start at and the number of
+//   cells left. Returns the number of cells it filled.
+// Return Value:
+// - The number of cells filled.
+template<typename FillRow>
+size_t TextBuffer::_FillCells(const COORD target, const size_t count, FillRow fillRow)
+{
+    const auto size = GetSize();
+    if (count == 0 || !size.IsInBounds(target))
+    {
+        return 0;
+    }
+
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
+    size_t filled = 0;
+    auto column = gsl::narrow_cast<size_t>(target.X);
+    auto y = target.Y;
+    while (filled < count && y < size.BottomExclusive())
+    {
+        filled += fillRow(GetRowByOffset(y), column, count - filled);
+        column = 0;
+        ++y;
+    }
+
+    // A fill that spans rows invalidates them whole, which is as good as
+    // invalidating just their filled parts, and is a single invalidation.
+    const auto rows = gsl::narrow_cast<SHORT>(y - target.Y);
+    const Viewport paint = rows == 1 ? Viewport::FromDimensions(target, { gsl::narrow<SHORT>(filled), 1 }) :
+                                       Viewport::FromDimensions({ 0, target.Y }, { size.Width(), rows });
+    _NotifyPaint(paint);
+
+    return filled;
+}
+
+// Routine Description:
+// - Fills count cells with a single narrow character, starting at target and
+//   continuing at the start of the next row, and leaves their attributes alone.
+// - This is what Write does with an OutputCellIterator that repeats a
+//   character, with a single fill per row instead of a trip through the
+//   iterator per cell, and a single invalidation for the whole region.
+// Arguments:
+// - wch - The character to fill with. It must be narrow and not a surrogate.
+// - target - Coordinate the fill starts at
+// - count - The number of cells to fill
+// - wrap - change the wrap flag of the rows whose last column gets filled
+// Return Value:
+// - The number of cells filled, which is less than count if the fill
+//   reached the end of the buffer.
+size_t TextBuffer::FillText(const wchar_t wch,
+                            const COORD target,
+                            const size_t count,
+                            const std::optional<bool> wrap)
+{
+    return _FillCells(target, count, [&](ROW& row, const size_t column, const size_t remaining) {
+        return row.FillText(wch, column, remaining, wrap);
+    });
+}
+
+// Routine Description:
+// - Applies a single attribute to count cells, starting at target and
+//   continuing at the start of the next row, and leaves their text alone.
+//   See FillText.
+// Arguments:
+// - attr - The attributes to apply
+// - target - Coordinate the fill starts at
+// - count - The number of cells to change
+// Return Value:
+// - The number of cells changed, which is less than count if the fill
+//   reached the end of the buffer.
+size_t TextBuffer::FillAttributes(const TextAttribute& attr,
+                                  const COORD target,
+                                  const size_t count)
+{
+    return _FillCells(target, count, [&](ROW& row, const size_t column, const size_t remaining) {
+        return row.FillAttributes(attr, column, remaining);
+    });
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -569,20 +796,136 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
         // the current background color, but with no meta attributes set.
         fillAttributes.SetStandardErase();
     }
-    const bool fSuccess = _storage.at(_firstRow).Reset(fillAttributes);
-    if (fSuccess)
+    // Before the row is recycled, spill it into the archive if we've got one.
+    if (_archive)
     {
-        // Now proceed to increment.
-        // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
-        _firstRow++;
-
-        // If we pass up the height of the buffer, loop back to 0.
-        if (_firstRow >= GetSize().Height())
+        try
         {
-            _firstRow = 0;
+            _archive->Append(_storage.at(_firstRow));
         }
+        CATCH_LOG();
     }
-    return fSuccess;
+
+    // The row is only cleared once it's accessed again, which makes this a pure index bump.
+    // The new generation stamp marks anything cached for its old contents as stale.
+    _MarkRowDirty(_storage.at(_firstRow));
+    _storage.at(_firstRow).Recycle(fillAttributes);
+    _marks.DiscardRows(1);
+
+    // Now proceed to increment.
+    // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
+    _firstRow++;
+
+    // If we pass up the height of the buffer, loop back to 0.
+    if (_firstRow >= GetSize().Height())
+    {
+        _firstRow = 0;
+    }
+    _InvalidateTextCache();
+    return true;
+}
+
+//Routine Description:
+// - Stores the given rows in their compact form, trimming trailing blank cells.
+//   Meant for rows that have scrolled out of the mutable viewport into the
+//   scrollback, where they're typically only read from again.
+//   A row is re-expanded automatically as soon as it's written to.
+//Arguments:
+// - firstRow - the offset of the first row to compact
+// - count - the number of rows to compact
+//Return Value:
+// - <none>
+void TextBuffer::CompactRows(const size_t firstRow, const size_t count)
+{
+    const auto end = std::min(firstRow + count, static_cast<size_t>(TotalRowCount()));
+    for (auto i = firstRow; i < end; ++i)
+    {
+        LOG_IF_FAILED(GetRowByOffset(i).GetCharRow().Compact());
+    }
+}
+
+//Routine Description:
+// - Blanks out the given rows, as if they were filled with spaces in the given
+//   attributes. They're only marked as blank and cleared once they're accessed
+//   again (see ROW::Recycle), so erasing a large buffer takes a moment per row
+//   and not per cell. The line renditions of the rows are left alone, which
+//   the parts of the ED sequence that reset them take care of.
+//Arguments:
+// - firstRow - the offset of the first row to clear
+// - count - the number of rows to clear
+// - fillAttributes - the attributes to fill the rows with
+//Return Value:
+// - <none>
+void TextBuffer::ClearRows(const size_t firstRow, const size_t count, const TextAttribute& fillAttributes)
+{
+    const auto end = std::min(firstRow + count, static_cast<size_t>(TotalRowCount()));
+    if (firstRow >= end)
+    {
+        return;
+    }
+
+    for (auto i = firstRow; i < end; ++i)
+    {
+        auto& row = GetRowByOffset(i);
+        const auto lineRendition = row.GetLineRendition();
+        row.Recycle(fillAttributes);
+        row.SetLineRendition(lineRendition);
+    }
+
+    const Viewport paint = Viewport::FromDimensions({ 0, gsl::narrow<SHORT>(firstRow) }, { GetSize().Width(), gsl::narrow<SHORT>(end - firstRow) });
+    _NotifyPaint(paint);
+}
+
+//Routine Description:
+// - Enables spilling rows that are pushed off the top of the buffer into a
+//   disk-backed ScrollbackArchive, instead of discarding them.
+//Arguments:
+// - <none>
+//Return Value:
+// - <none>
+// Note: will throw if the archive's backing file can't be created
+void TextBuffer::EnableScrollbackArchive()
+{
+    if (!_archive)
+    {
+        _archive = std::make_unique<ScrollbackArchive>();
+    }
+}
+
+//Routine Description:
+// - gets the archive of rows that were pushed off the top of the buffer
+//Arguments:
+// - <none>
+//Return Value:
+// - the archive, or nullptr if archiving isn't enabled
+ScrollbackArchive* TextBuffer::GetScrollbackArchive() noexcept
+{
+    return _archive.get();
+}
+
+//Routine Description:
+// - Marks the given position as the start of a prompt, a command or its
+//   output, as told by the shell. See ScrollMarks.
+//Arguments:
+// - position - the position to mark, relative to the top of the buffer
+// - kind - what's marked
+// - exitCode - the exit code of the command, for MarkKind::CommandFinished
+//Return Value:
+// - <none>
+void TextBuffer::AddMark(const COORD position, const MarkKind kind, const std::optional<unsigned int> exitCode)
+{
+    _marks.Add(position, kind, exitCode);
+}
+
+//Routine Description:
+// - gets the marks the shell left in the rows of the buffer
+//Arguments:
+// - <none>
+//Return Value:
+// - the marks, which are kept where their rows are as the buffer is modified
+const ScrollMarks& TextBuffer::GetMarks() const noexcept
+{
+    return _marks;
 }
 
 //Routine Description:
@@ -679,6 +1022,7 @@ void TextBuffer::_UpdateSize()
 void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex) noexcept
 {
     _firstRow = FirstRowIndex;
+    _InvalidateTextCache();
 }
 
 void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta)
@@ -689,6 +1033,10 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
+    _InvalidateTextCache();
+    _hyperlinkCountsStale = true;
+    _marks.MoveRows(firstRow, size, delta);
+
     // OK. We're about to play games by moving rows around within the deque to
     // scroll a massive region in a faster way than copying things.
     // To make this easier, first correct the circular buffer to have the first row be 0 again.
@@ -778,7 +1126,7 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
     }
 
     // Renumber the IDs now that we've rearranged where the rows sit within the buffer.
-    // Refreshing should also delegate to the UnicodeStorage to re-key all the stored unicode sequences (where applicable).
+    // The glyphs that don't fit into a single cell are owned by their rows and move along with them.
     _RefreshRowIDs(std::nullopt);
 }
 
@@ -883,8 +1231,10 @@ void TextBuffer::Reset()
 
     for (auto& row : _storage)
     {
+        _MarkRowDirty(row);
         row.Reset(attr);
     }
+    _marks.Clear();
 }
 
 // Routine Description:
@@ -897,6 +1247,9 @@ void TextBuffer::Reset()
 {
     RETURN_HR_IF(E_INVALIDARG, newSize.X < 0 || newSize.Y < 0);
 
+    _InvalidateTextCache();
+    _hyperlinkCountsStale = true;
+
     try
     {
         const auto currentSize = GetSize().Dimensions();
@@ -930,9 +1283,12 @@ void TextBuffer::Reset()
             _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
         }
 
+        // The marks stay on the rows that were kept.
+        _marks.DiscardRows(gsl::narrow_cast<size_t>(TopRow));
+        _marks.Truncate(gsl::narrow_cast<size_t>(newSize.Y));
+
         // Now that we've tampered with the row placement, refresh all the row IDs.
-        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
-        // and cleanup the UnicodeStorage characters that might fall outside the resized buffer.
+        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension.
         _RefreshRowIDs(newSize.X);
 
         // Update the cached size value
@@ -943,14 +1299,70 @@ void TextBuffer::Reset()
     return S_OK;
 }
 
-const UnicodeStorage& TextBuffer::GetUnicodeStorage() const noexcept
+// Routine Description:
+// - Returns the table new rows intern their attributes in. Once it's full,
+//   this moves on to its successor, which the rows will end up in anyways.
+// Arguments:
+// - <none>
+// Return Value:
+// - The attribute table for new rows.
+// Note:
+// - will throw on allocation failure
+std::shared_ptr<TextAttributeTable> TextBuffer::GetAttributeTable()
+{
+    while (_attributeTable->IsFull())
+    {
+        _attributeTable = _attributeTable->GetSuccessor();
+    }
+    return _attributeTable;
+}
+
+// Routine Description:
+// - Returns the resource the rows of this buffer allocate from, see _rowPool.
+//   It isn't synchronized, like the rows themselves aren't.
+// Arguments:
+// - <none>
+// Return Value:
+// - The resource for the rows.
+std::pmr::memory_resource* TextBuffer::GetRowResource() noexcept
 {
-    return _unicodeStorage;
+    return &_rowPool;
 }
 
-UnicodeStorage& TextBuffer::GetUnicodeStorage() noexcept
+// Routine Description:
+// - Estimates the bytes the buffer holds on to, by what they're used for.
+//   This walks all of the rows, so it's meant to be called every now and
+//   then, like for diagnostics, and not for every frame.
+// - The rows of the scrollback archive live in a file and aren't counted.
+// Arguments:
+// - <none>
+// Return Value:
+// - The bytes held by the text, glyphs, attributes, hyperlinks and images.
+BufferMemoryUsage TextBuffer::GetMemoryUsage() const noexcept
 {
-    return _unicodeStorage;
+    BufferMemoryUsage usage;
+    for (const auto& row : _storage)
+    {
+        row.AddMemoryUsage(usage);
+    }
+    usage.text += (_storage.capacity() - _storage.size()) * sizeof(ROW);
+    usage.attributes += _attributeTable->MemoryUsage();
+
+    // Every node of the maps holds the key and value next to a pointer to the next node.
+    static constexpr auto nodeOverhead = 2 * sizeof(void*);
+    usage.hyperlinks += _hyperlinkUris.capacity() * sizeof(wchar_t);
+    usage.hyperlinks += _hyperlinkMap.size() * (sizeof(std::pair<const uint16_t, HyperlinkUri>) + nodeOverhead);
+    for (const auto& [customId, id] : _hyperlinkCustomIdMap)
+    {
+        usage.hyperlinks += sizeof(std::pair<const std::wstring, uint16_t>) + nodeOverhead + customId.capacity() * sizeof(wchar_t);
+    }
+    usage.hyperlinks += _rowHyperlinks.capacity() * sizeof(RowHyperlinks);
+    for (const auto& rowHyperlinks : _rowHyperlinks)
+    {
+        usage.hyperlinks += rowHyperlinks.ids.capacity() * sizeof(uint16_t);
+    }
+    usage.hyperlinks += _hyperlinkRowCounts.size() * (sizeof(std::pair<const uint16_t, size_t>) + nodeOverhead);
+    return usage;
 }
 
 // Routine Description:
@@ -958,19 +1370,15 @@ UnicodeStorage& TextBuffer::GetUnicodeStorage() noexcept
 //   by shuffling pointers around.
 // - This will also update parent pointers that are stored in depth within the buffer
 //   (e.g. it will update CharRow parents pointing at Rows that might have been moved around)
-// - Optionally takes a new row width if we're resizing to perform a resize operation and cleanup
-//   any high unicode (UnicodeStorage) runs while we're already looping through the rows.
+// - Optionally takes a new row width if we're resizing to perform a resize operation
+//   while we're already looping through the rows.
 // Arguments:
 // - newRowWidth - Optional new value for the row width.
 void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
 {
-    std::unordered_map<SHORT, SHORT> rowMap;
     SHORT i = 0;
     for (auto& it : _storage)
     {
-        // Build a map so we can update Unicode Storage
-        rowMap.emplace(it.GetId(), i);
-
         // Update the IDs
         it.SetId(i++);
 
@@ -981,17 +1389,15 @@ void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
         if (newRowWidth.has_value())
         {
             // Realloc in the X direction
+            _MarkRowDirty(it);
             THROW_IF_FAILED(it.Resize(newRowWidth.value()));
         }
     }
-
-    // Give the new mapping to Unicode Storage
-    _unicodeStorage.Remap(rowMap, newRowWidth);
 }
 
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
 {
-    _renderTarget.TriggerRedraw(viewport);
+    _renderTarget.TriggerRedrawContent(viewport);
 }
 
 // Routine Description:
@@ -1023,7 +1429,138 @@ ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
     }
 
     THROW_HR_IF(E_FAIL, Row.GetId() == _firstRow);
-    return _storage.at(prevRowIndex);
+    auto& prevRow = _storage.at(prevRowIndex);
+    _MarkRowDirty(prevRow);
+    return prevRow;
+}
+
+// Routine Description:
+// - Bumps the generation of the buffer. Called whenever the rows of the
+//   buffer could be modified or moved around.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_InvalidateTextCache() noexcept
+{
+    ++_generation;
+}
+
+// Routine Description:
+// - Stamps the given row with a new generation, marking any text or patterns
+//   cached for it as stale. Called whenever the row could be modified.
+// Arguments:
+// - row - the row that might be modified
+// Return Value:
+// - <none>
+void TextBuffer::_MarkRowDirty(ROW& row) noexcept
+{
+    // The first modification since the hyperlinks were counted queues the row to be
+    // counted again. Each row is queued at most once, so the reserved space suffices.
+    if (row.GetGeneration() <= _hyperlinkCountsGeneration && _hyperlinkDirtyRows.size() < _hyperlinkDirtyRows.capacity())
+    {
+        _hyperlinkDirtyRows.push_back(gsl::narrow_cast<size_t>(row.GetId()));
+    }
+    row.SetGeneration(++_generation);
+}
+
+// Routine Description:
+// - Gets a number that changes whenever the contents of the buffer might have
+//   changed. Two calls returning the same value are guaranteed to have seen
+//   the same buffer contents.
+// Arguments:
+// - <none>
+// Return Value:
+// - the generation of the buffer contents
+uint64_t TextBuffer::GetGeneration() const noexcept
+{
+    return _generation;
+}
+
+// Routine Description:
+// - Gets the text of a row, like ROW::GetText, but caches it until the
+//   row is modified. This way repeated searches and pattern detection
+//   only extract the text of the rows that changed since the last pass.
+// Arguments:
+// - index - the offset of the row from the first row of the buffer
+// Return Value:
+// - the text of the row, one character per cell and padded with spaces.
+//   Only valid until the buffer is modified.
+const std::wstring& TextBuffer::GetCachedRowText(const size_t index) const
+{
+    return _GetRowTextCacheEntry(index).text;
+}
+
+// Routine Description:
+// - Gets the text of the given columns of a row out of the cache kept by
+//   GetCachedRowText. Like GetPlainText, a wide glyph is part of the text
+//   if its leading half is within the columns.
+// Arguments:
+// - index - the offset of the row from the first row of the buffer
+// - beginColumn - the first column to get the text of
+// - endColumn - the column after the last one to get the text of
+// Return Value:
+// - the text of the columns. Only valid until the buffer is modified.
+std::wstring_view TextBuffer::GetCachedRowText(const size_t index, const size_t beginColumn, const size_t endColumn) const
+{
+    const auto& entry = _GetRowTextCacheEntry(index);
+    const auto width = entry.columns.empty() ? entry.text.size() : entry.columns.size() - 1;
+    const auto end = std::min(endColumn, width);
+    const auto begin = std::min(beginColumn, end);
+    if (entry.columns.empty())
+    {
+        return std::wstring_view{ entry.text }.substr(begin, end - begin);
+    }
+
+    const auto offset = entry.columns.at(begin);
+    return std::wstring_view{ entry.text }.substr(offset, entry.columns.at(end) - offset);
+}
+
+// Routine Description:
+// - Gets the cached text of a row, extracting it again if the row changed
+//   since it was last cached.
+// Arguments:
+// - index - the offset of the row from the first row of the buffer
+// Return Value:
+// - the cache entry of the row. Only valid until the buffer is modified.
+const TextBuffer::RowTextCacheEntry& TextBuffer::_GetRowTextCacheEntry(const size_t index) const
+{
+    if (_rowTextCache.size() != TotalRowCount())
+    {
+        _rowTextCache.clear();
+        _rowTextCache.resize(TotalRowCount());
+    }
+
+    const auto& row = GetRowByOffset(index);
+    // Every row is stamped with a nonzero generation on construction,
+    // so an empty entry never matches.
+    auto& entry = _rowTextCache.at((_firstRow + index) % TotalRowCount());
+    if (entry.generation != row.GetGeneration())
+    {
+        entry.text = row.GetText();
+        entry.columns.clear();
+
+        // Only rows with wide or stored glyphs need to map their columns
+        // onto the text, which skips the trailing halves of wide glyphs.
+        const auto& charRow = row.GetCharRow();
+        if (entry.text.size() != charRow.size() || charRow.GetNarrowRun(0, charRow.size()).size() != charRow.size())
+        {
+            entry.columns.reserve(charRow.size() + 1);
+            size_t offset = 0;
+            for (size_t column = 0; column < charRow.size(); ++column)
+            {
+                entry.columns.push_back(offset);
+                const auto& attr = charRow.DbcsAttrAt(column);
+                if (!attr.IsTrailing())
+                {
+                    offset += attr.IsGlyphStored() ? std::wstring_view{ charRow.GlyphAt(column) }.size() : 1;
+                }
+            }
+            entry.columns.push_back(offset);
+        }
+        entry.generation = row.GetGeneration();
+    }
+    return entry;
 }
 
 // Method Description:
@@ -1037,17 +1574,34 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
     return _renderTarget;
 }
 
+// Method Description:
+// - get the lookup table of the given word delimiters
+// - The table is only rebuilt when the delimiters differ from the last
+//   ones, which in practice means whenever the setting changes.
+// Arguments:
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// Return Value:
+// - the table of the delimiters. Only valid until the next call.
+const DelimiterTable& TextBuffer::_GetDelimiterTable(const std::wstring_view wordDelimiters) const
+{
+    if (!_delimiterTable.IsFor(wordDelimiters))
+    {
+        _delimiterTable = DelimiterTable{ wordDelimiters };
+    }
+    return _delimiterTable;
+}
+
 // Method Description:
 // - get delimiter class for buffer cell position
 // - used for double click selection and uia word navigation
 // Arguments:
 // - pos: the buffer cell under observation
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - delimiters: the table of the delimiters defined as a part of the DelimiterClass::DelimiterChar
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
+const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const DelimiterTable& delimiters) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, delimiters);
 }
 
 // Method Description:
@@ -1088,13 +1642,14 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
         copy = { bufferSize.RightInclusive(), bufferSize.BottomInclusive() };
     }
 
+    const auto& delimiters = _GetDelimiterTable(wordDelimiters);
     if (accessibilityMode)
     {
-        return _GetWordStartForAccessibility(copy, wordDelimiters);
+        return _GetWordStartForAccessibility(copy, delimiters);
     }
     else
     {
-        return _GetWordStartForSelection(copy, wordDelimiters);
+        return _GetWordStartForSelection(copy, delimiters);
     }
 }
 
@@ -1102,17 +1657,17 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (accessibility definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the table of the characters we are considering for the separation of words
 // Return Value:
 // - The COORD for the first character on the current/previous READABLE "word" (inclusive)
-const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const DelimiterTable& delimiters) const
 {
     COORD result = target;
     const auto bufferSize = GetSize();
     bool stayAtOrigin = false;
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, delimiters) != DelimiterClass::RegularChar)
     {
         if (!bufferSize.DecrementInBounds(result))
         {
@@ -1124,7 +1679,7 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, delimiters) == DelimiterClass::RegularChar)
     {
         if (!bufferSize.DecrementInBounds(result))
         {
@@ -1135,7 +1690,7 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // move off of delimiter and onto word start
-    if (!stayAtOrigin && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    if (!stayAtOrigin && _GetDelimiterClassAt(result, delimiters) != DelimiterClass::RegularChar)
     {
         bufferSize.IncrementInBounds(result);
     }
@@ -1147,26 +1702,22 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (selection definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the table of the characters we are considering for the separation of words
 // Return Value:
 // - The COORD for the first character on the current word or delimiter run (stopped by the left margin)
-const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const DelimiterTable& delimiters) const
 {
     COORD result = target;
-    const auto bufferSize = GetSize();
+    const auto left = GetSize().Left();
 
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    // The word never leaves the row, so scan the row directly.
+    const auto& charRow = GetRowByOffset(target.Y).GetCharRow();
+    const auto initialDelimiter = charRow.DelimiterClassAt(target.X, delimiters);
 
     // expand left until we hit the left boundary or a different delimiter class
-    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
-    {
-        bufferSize.DecrementInBounds(result);
-    }
-
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    while (result.X > left && charRow.DelimiterClassAt(result.X - 1, delimiters) == initialDelimiter)
     {
-        // move off of delimiter
-        bufferSize.IncrementInBounds(result);
+        --result.X;
     }
 
     return result;
@@ -1200,14 +1751,15 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
         return target;
     }
 
+    const auto& delimiters = _GetDelimiterTable(wordDelimiters);
     if (accessibilityMode)
     {
         const auto lastCharPos{ GetLastNonSpaceCharacter() };
-        return _GetWordEndForAccessibility(target, wordDelimiters, lastCharPos);
+        return _GetWordEndForAccessibility(target, delimiters, lastCharPos);
     }
     else
     {
-        return _GetWordEndForSelection(target, wordDelimiters);
+        return _GetWordEndForSelection(target, delimiters);
     }
 }
 
@@ -1215,11 +1767,11 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the next READABLE word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the table of the characters we are considering for the separation of words
 // - lastCharPos - the position of the last nonspace character in the text buffer (to improve performance)
 // Return Value:
 // - The COORD for the first character of the next readable "word". If no next word, return one past the end of the buffer
-const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const
+const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const DelimiterTable& delimiters, const COORD lastCharPos) const
 {
     const auto bufferSize = GetSize();
     COORD result = target;
@@ -1231,7 +1783,7 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // ignore right boundary. Continue through readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, delimiters) == DelimiterClass::RegularChar)
     {
         if (!bufferSize.IncrementInBounds(result, true))
         {
@@ -1246,7 +1798,7 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // make sure we expand to the beginning of the NEXT word
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, delimiters) != DelimiterClass::RegularChar)
     {
         if (!bufferSize.IncrementInBounds(result, true))
         {
@@ -1264,81 +1816,144 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the NEXT word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the table of the characters we are considering for the separation of words
 // Return Value:
 // - The COORD for the last character of the current word or delimiter run (stopped by right margin)
-const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const DelimiterTable& delimiters) const
 {
-    const auto bufferSize = GetSize();
+    const auto right = GetSize().RightInclusive();
 
     // can't expand right
-    if (target.X == bufferSize.RightInclusive())
+    if (target.X == right)
     {
         return target;
     }
 
     COORD result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+
+    // The word never leaves the row, so scan the row directly.
+    const auto& charRow = GetRowByOffset(target.Y).GetCharRow();
+    const auto initialDelimiter = charRow.DelimiterClassAt(target.X, delimiters);
 
     // expand right until we hit the right boundary or a different delimiter class
-    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
+    while (result.X < right && charRow.DelimiterClassAt(result.X + 1, delimiters) == initialDelimiter)
     {
-        bufferSize.IncrementInBounds(result);
+        ++result.X;
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    return result;
+}
+
+// Routine Description:
+// - Removes the hyperlinks that only appear in the first row from the hyperlink
+//   map, as that row is about to be recycled. Whether a hyperlink appears
+//   anywhere else is answered by the number of rows it appears in, so only
+//   the rows that were modified since the last time are looked at.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_PruneHyperlinks()
+{
+    const auto firstRow = gsl::narrow_cast<size_t>(_firstRow);
+
+    // There's nothing to prune and nothing to count for rows without any hyperlinks,
+    // which is the common case. Their ID list doesn't allocate when it's empty.
+    if (_hyperlinkMap.empty() || _storage.at(firstRow).GetAttrRow().GetHyperlinks().empty())
     {
-        // move off of delimiter
-        bufferSize.DecrementInBounds(result);
+        return;
     }
 
-    return result;
+    _UpdateHyperlinkCounts();
+
+    // The contents of the first row are going away, and so are its references.
+    auto& entry = til::at(_rowHyperlinks, firstRow);
+    for (const auto id : entry.ids)
+    {
+        const auto count = _hyperlinkRowCounts.find(id);
+        if (count != _hyperlinkRowCounts.end() && --count->second == 0)
+        {
+            _hyperlinkRowCounts.erase(count);
+            RemoveHyperlinkFromMap(id);
+        }
+    }
+    entry.ids.clear();
 }
 
-void TextBuffer::_PruneHyperlinks()
+// Routine Description:
+// - Brings the number of rows each hyperlink appears in up to date.
+// - Only the rows that were modified since the last update are counted
+//   again, unless rows were moved around within _storage, which
+//   invalidates the rows the counts are kept for.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_UpdateHyperlinkCounts()
 {
-    // Check the old first row for hyperlink references
-    // If there are any, search the entire buffer for the same reference
-    // If the buffer does not contain the same reference, we can remove that hyperlink from our map
-    // This way, obsolete hyperlink references are cleared from our hyperlink map instead of hanging around
-    // Get all the hyperlink references in the row we're erasing
-    const auto hyperlinks = _storage.at(_firstRow).GetAttrRow().GetHyperlinks();
-
-    if (!hyperlinks.empty())
-    {
-        // Move to unordered set so we can use hashed lookup of IDs instead of linear search.
-        // Only make it an unordered set now because set always heap allocates but vector
-        // doesn't when the set is empty (saving an allocation in the common case of no links.)
-        std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
-
-        const auto total = TotalRowCount();
-        // Loop through all the rows in the buffer except the first row -
-        // we have found all hyperlink references in the first row and put them in refs,
-        // now we need to search the rest of the buffer (i.e. all the rows except the first)
-        // to see if those references are anywhere else
-        for (size_t i = 1; i != total; ++i)
-        {
-            const auto nextRowRefs = GetRowByOffset(i).GetAttrRow().GetHyperlinks();
-            for (auto id : nextRowRefs)
-            {
-                if (firstRowRefs.find(id) != firstRowRefs.end())
-                {
-                    firstRowRefs.erase(id);
-                }
-            }
-            if (firstRowRefs.empty())
-            {
-                // No more hyperlink references left to search for, terminate early
-                break;
-            }
+    if (_hyperlinkCountsStale || _rowHyperlinks.size() != _storage.size())
+    {
+        _rowHyperlinks.clear();
+        _rowHyperlinks.resize(_storage.size());
+        _hyperlinkRowCounts.clear();
+        _hyperlinkDirtyRows.clear();
+        _hyperlinkDirtyRows.reserve(_storage.size());
+        for (size_t i = 0; i < _storage.size(); ++i)
+        {
+            _CountRowHyperlinks(i);
+        }
+        _hyperlinkCountsStale = false;
+    }
+    else
+    {
+        for (const auto index : _hyperlinkDirtyRows)
+        {
+            _CountRowHyperlinks(index);
         }
+        _hyperlinkDirtyRows.clear();
+    }
+    _hyperlinkCountsGeneration = _generation;
+}
+
+// Routine Description:
+// - Counts the hyperlinks of a row again, if the row changed since it was last counted.
+// Arguments:
+// - index - the index of the row in _storage
+// Return Value:
+// - <none>
+void TextBuffer::_CountRowHyperlinks(const size_t index)
+{
+    if (index >= _storage.size())
+    {
+        return;
+    }
+
+    const auto& row = til::at(_storage, index);
+    auto& entry = til::at(_rowHyperlinks, index);
+    if (entry.generation == row.GetGeneration())
+    {
+        return;
+    }
 
-        // Now delete obsolete references from our map
-        for (auto hyperlinkReference : firstRowRefs)
+    auto ids = row.GetAttrRow().GetHyperlinks();
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    for (const auto id : entry.ids)
+    {
+        const auto count = _hyperlinkRowCounts.find(id);
+        if (count != _hyperlinkRowCounts.end() && --count->second == 0)
         {
-            RemoveHyperlinkFromMap(hyperlinkReference);
+            _hyperlinkRowCounts.erase(count);
         }
     }
+    for (const auto id : ids)
+    {
+        ++_hyperlinkRowCounts[id];
+    }
+
+    entry.ids = std::move(ids);
+    entry.generation = row.GetGeneration();
 }
 
 // Method Description:
@@ -1355,7 +1970,7 @@ bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimite
     // move to the beginning of the next word
     // NOTE: _GetWordEnd...() returns the exclusive position of the "end of the word"
     //       This is also the inclusive start of the next word.
-    auto copy{ _GetWordEndForAccessibility(pos, wordDelimiters, lastCharPos) };
+    auto copy{ _GetWordEndForAccessibility(pos, _GetDelimiterTable(wordDelimiters), lastCharPos) };
 
     if (copy == GetSize().EndExclusive())
     {
@@ -1620,6 +2235,9 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
         data.BkAttr.reserve(rows);
     }
 
+    // reused for every row, see ROW::ReadCells
+    RowCells cells;
+
     // for each row in the selection
     for (UINT i = 0; i < rows; i++)
     {
@@ -1628,7 +2246,8 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
         const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
 
         // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
+        THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(highlight));
+        GetRowByOffset(iRow).ReadCells(highlight.Left(), highlight.RightExclusive(), cells);
 
         // allocate a string buffer
         std::wstring selectionText;
@@ -1643,29 +2262,32 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
             selectionBkAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
         }
 
-        // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+        // copy char data into the string buffer, skipping trailing bytes.
+        // The colors only need to be looked up once per run of attributes.
+        size_t cell = 0;
+        for (const auto& run : cells.attrs)
         {
-            const auto& cell = *it;
+            std::pair<COLORREF, COLORREF> colors{};
+            if (copyTextColor)
+            {
+                colors = GetAttributeColors(run.attr);
+            }
 
-            if (!cell.DbcsAttr().IsTrailing())
+            for (const auto runEnd = cell + run.length; cell < runEnd; ++cell)
             {
-                selectionText.append(cell.Chars());
+                if (til::at(cells.dbcsAttrs, cell).IsTrailing())
+                {
+                    continue;
+                }
 
+                const auto glyph = til::at(cells.glyphs, cell);
+                selectionText.append(glyph);
                 if (copyTextColor)
                 {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (const wchar_t wch : cell.Chars())
-                    {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
-                    }
+                    selectionFgAttr.insert(selectionFgAttr.end(), glyph.size(), colors.first);
+                    selectionBkAttr.insert(selectionBkAttr.end(), glyph.size(), colors.second);
                 }
             }
-#pragma warning(suppress : 26444)
-            // TODO GH 2675: figure out why there's custom construction/destruction happening here
-            it++;
         }
 
         // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
@@ -1721,6 +2343,89 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     return data;
 }
 
+// Routine Description:
+// - Retrieves just the text of the selected region, concatenated into a single
+//   clipboard-ready string. Unlike GetText, this doesn't build a string per row
+//   and it never looks at the colors. Runs of printable ASCII are appended
+//   straight from the row without going through the cell iterators.
+// Arguments:
+// - includeCRLF - inject CRLF pairs to the end of each line
+// - trimTrailingWhitespace - remove the trailing whitespace at the end of each line
+// - selectionRects - the rectangular regions from which the data will be extracted from the buffer (i.e.: selection rects)
+// - formatWrappedRows - if set we will apply formatting (CRLF inclusion and whitespace trimming) on wrapped rows
+// Return Value:
+// - The text of the selected region of the text buffer.
+std::wstring TextBuffer::GetPlainText(const bool includeCRLF,
+                                      const bool trimTrailingWhitespace,
+                                      const std::vector<SMALL_RECT>& selectionRects,
+                                      const bool formatWrappedRows) const
+{
+    std::wstring text;
+
+    size_t capacity = 0;
+    for (const auto& rect : selectionRects)
+    {
+        capacity += gsl::narrow_cast<size_t>(std::max(0, rect.Right - rect.Left + 1)) + 2; // + 2 for \r\n
+    }
+    text.reserve(capacity);
+
+    const auto rows = selectionRects.size();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto& rect = selectionRects.at(i);
+        const auto& row = GetRowByOffset(rect.Top);
+        const auto& charRow = row.GetCharRow();
+
+        // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
+        const bool shouldFormatRow = formatWrappedRows || !row.WasWrapForced();
+        const bool trimRow = trimTrailingWhitespace && shouldFormatRow;
+
+        // The cells past the last non-space glyph would be trimmed off anyways.
+        auto end = std::min(gsl::narrow_cast<size_t>(rect.Right) + 1, charRow.size());
+        if (trimRow)
+        {
+            end = std::min(end, charRow.MeasureRight());
+        }
+
+        const auto rowStart = text.size();
+        auto column = gsl::narrow_cast<size_t>(rect.Left);
+        while (column < end)
+        {
+            const auto run = charRow.GetNarrowRun(column, end - column);
+            if (!run.empty())
+            {
+                text.append(run);
+                column += run.size();
+                continue;
+            }
+
+            // skip the trailing half of wide glyphs, like GetText does
+            if (!charRow.DbcsAttrAt(column).IsTrailing())
+            {
+                text.append(std::wstring_view{ charRow.GlyphAt(column) });
+            }
+            ++column;
+        }
+
+        if (trimRow)
+        {
+            while (text.size() > rowStart && text.back() == UNICODE_SPACE)
+            {
+                text.pop_back();
+            }
+        }
+
+        // apply CR/LF to the end of the final string, unless we're the last line.
+        if (includeCRLF && shouldFormatRow && i < rows - 1)
+        {
+            text.push_back(UNICODE_CARRIAGERETURN);
+            text.push_back(UNICODE_LINEFEED);
+        }
+    }
+
+    return text;
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure based on the passed in text and color data
 // Arguments:
@@ -2095,6 +2800,275 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
     }
 }
 
+// Function Description:
+// - Reflows the contents of the old buffer into the new one like the row by row
+//   loop of Reflow does, but in two passes:
+//   1. The rows of the old buffer are laid out in the new one. This only walks
+//      the wrap flags and the double width cells of the rows, to find the
+//      stretches of cells that land on the same new row.
+//   2. The text of the new rows is copied in parallel, with bulk copies of
+//      those stretches. The attributes (and the wrap and padding flags) are
+//      applied afterwards on this thread, since they're interned in the
+//      attribute table shared by all rows of the new buffer.
+// - Buffers that this layout doesn't cover exactly are left untouched for
+//   Reflow to copy: buffers that would be circled while reflowing, rows with a
+//   line rendition other than single width and broken double byte sequences.
+// Arguments:
+// - oldBuffer - the text buffer to copy the contents FROM
+// - newBuffer - the text buffer to copy the contents TO. Must still be empty.
+// - oldRowsTotal - the number of rows of oldBuffer to copy
+// - positionInfo - see Reflow
+// - newCursorPos - receives the new position of the old cursor, if found
+// - foundCursorPos - set to true if the old cursor was found in the copied cells
+// - rowStarts - receives where each old row starts in the new buffer, see _ReflowMarks
+// Return Value:
+// - true if the contents were copied, false if Reflow has to copy them.
+// Note: may throw exception, after which newBuffer is partially written.
+bool TextBuffer::_ReflowInParallel(const TextBuffer& oldBuffer,
+                                   TextBuffer& newBuffer,
+                                   const short oldRowsTotal,
+                                   std::optional<std::reference_wrapper<PositionInformation>> positionInfo,
+                                   COORD& newCursorPos,
+                                   bool& foundCursorPos,
+                                   std::vector<std::pair<int64_t, SHORT>>& rowStarts)
+{
+    const auto oldCursorPos = oldBuffer.GetCursor().GetPosition();
+    const auto oldWidth = gsl::narrow_cast<size_t>(oldBuffer.GetSize().Width());
+    const auto newWidth = gsl::narrow_cast<size_t>(newBuffer.GetSize().Width());
+    const auto newHeight = gsl::narrow_cast<size_t>(newBuffer.GetSize().Height());
+    const auto newStart = newBuffer.GetCursor().GetPosition();
+    if (newWidth < 2 || newStart.X != 0 || newStart.Y != 0)
+    {
+        return false;
+    }
+
+    // A stretch of cells of an old row that lands on a single row of the new buffer.
+    struct Span
+    {
+        size_t oldRow;
+        size_t oldColumn;
+        size_t length;
+        size_t newRow;
+        size_t newColumn;
+    };
+    std::vector<Span> spans;
+    std::vector<const ROW*> oldRows;
+    std::vector<size_t> wrappedRows;
+    std::vector<size_t> paddedRows;
+    spans.reserve(gsl::narrow_cast<size_t>(oldRowsTotal) * (oldWidth / newWidth + 2));
+    oldRows.reserve(gsl::narrow_cast<size_t>(oldRowsTotal));
+
+    std::optional<COORD> foundCursor;
+    std::optional<short> mutableTop;
+    std::optional<short> visibleTop;
+    size_t x = 0;
+    size_t y = 0;
+    // Whether the cursor got onto its current row by running off the end of the
+    // previous one, which is what the last row's newline has to look out for.
+    bool arrivedByWrap = false;
+
+    const auto wrap = [&]() {
+        wrappedRows.emplace_back(y);
+        arrivedByWrap = true;
+        x = 0;
+        ++y;
+    };
+    const auto newline = [&]() noexcept {
+        arrivedByWrap = false;
+        x = 0;
+        ++y;
+    };
+
+    for (short i = 0; i < oldRowsTotal; ++i)
+    {
+        const auto& row = oldBuffer.GetRowByOffset(i);
+        const auto& charRow = row.GetCharRow();
+        if (row.GetLineRendition() != LineRendition::SingleWidth)
+        {
+            return false;
+        }
+        oldRows.emplace_back(&row);
+        rowStarts.emplace_back(newBuffer._marks.GetOrigin() + gsl::narrow_cast<int64_t>(y), gsl::narrow_cast<SHORT>(x));
+
+        // See Reflow for how far a row is copied.
+        auto right = charRow.MeasureRight();
+        if (row.WasWrapForced())
+        {
+            right = row.WasDoubleBytePadded() ? oldWidth - 1 : oldWidth;
+        }
+
+        const auto cursorColumn = i == oldCursorPos.Y ? std::optional<size_t>{ gsl::narrow_cast<size_t>(oldCursorPos.X) } : std::nullopt;
+        const auto allNarrow = charRow.GetNarrowRun(0, right).size() == right;
+
+        for (size_t column = 0; column < right;)
+        {
+            const auto& dbcsAttr = charRow.DbcsAttrAt(column);
+            if (!allNarrow && dbcsAttr.IsLeading())
+            {
+                // The double byte sequences are copied as a whole. A leading half
+                // that would land on the last column is pushed onto the next row.
+                if (column + 1 >= right || !charRow.DbcsAttrAt(column + 1).IsTrailing())
+                {
+                    return false;
+                }
+                if (cursorColumn == column)
+                {
+                    foundCursor = COORD{ gsl::narrow<short>(x), gsl::narrow<short>(y) };
+                }
+                if (x == newWidth - 1)
+                {
+                    paddedRows.emplace_back(y);
+                    wrap();
+                }
+                if (cursorColumn == column + 1)
+                {
+                    foundCursor = COORD{ gsl::narrow<short>(x + 1), gsl::narrow<short>(y) };
+                }
+                spans.push_back({ oldRows.size() - 1, column, 2, y, x });
+                column += 2;
+                x += 2;
+            }
+            else if (!allNarrow && dbcsAttr.IsTrailing())
+            {
+                return false;
+            }
+            else
+            {
+                auto end = column + 1;
+                if (allNarrow)
+                {
+                    end = right;
+                }
+                else
+                {
+                    while (end < right && charRow.DbcsAttrAt(end).IsSingle())
+                    {
+                        ++end;
+                    }
+                }
+
+                const auto length = std::min(end - column, newWidth - x);
+                if (cursorColumn && *cursorColumn >= column && *cursorColumn < column + length)
+                {
+                    foundCursor = COORD{ gsl::narrow<short>(x + *cursorColumn - column), gsl::narrow<short>(y) };
+                }
+                spans.push_back({ oldRows.size() - 1, column, length, y, x });
+                column += length;
+                x += length;
+            }
+
+            if (x == newWidth)
+            {
+                wrap();
+            }
+            if (y >= newHeight)
+            {
+                // The new buffer would have to be circled.
+                return false;
+            }
+        }
+
+        if (positionInfo.has_value())
+        {
+            if (!mutableTop && i >= positionInfo.value().get().mutableViewportTop)
+            {
+                mutableTop = gsl::narrow<short>(y);
+            }
+            if (!visibleTop && i >= positionInfo.value().get().visibleViewportTop)
+            {
+                visibleTop = gsl::narrow<short>(y);
+            }
+        }
+
+        if (right < oldWidth && !row.WasWrapForced())
+        {
+            if (cursorColumn == right)
+            {
+                foundCursor = COORD{ gsl::narrow<short>(x), gsl::narrow<short>(y) };
+            }
+            // The last row only ends in a newline if it just barely wrapped, see Reflow.
+            if (i < oldRowsTotal - 1 || (x == 0 && y > 0 && arrivedByWrap))
+            {
+                newline();
+            }
+            if (y >= newHeight)
+            {
+                return false;
+            }
+        }
+    }
+
+    // Each row of the new buffer is written by a single task.
+    std::vector<ROW*> newRows;
+    newRows.reserve(y + 1);
+    for (size_t row = 0; row <= y; ++row)
+    {
+        newRows.emplace_back(&newBuffer.GetRowByOffset(row));
+    }
+
+    std::vector<std::pair<size_t, size_t>> rowSpans;
+    for (size_t begin = 0; begin < spans.size();)
+    {
+        auto end = begin + 1;
+        while (end < spans.size() && til::at(spans, end).newRow == til::at(spans, begin).newRow)
+        {
+            ++end;
+        }
+        rowSpans.emplace_back(begin, end);
+        begin = end;
+    }
+
+    std::atomic<HRESULT> copyResult{ S_OK };
+    std::for_each(std::execution::par, rowSpans.begin(), rowSpans.end(), [&](const std::pair<size_t, size_t>& range) noexcept {
+        try
+        {
+            for (auto s = range.first; s < range.second; ++s)
+            {
+                const auto& span = til::at(spans, s);
+                til::at(newRows, span.newRow)->CopyTextFrom(*til::at(oldRows, span.oldRow), span.oldColumn, span.length, span.newColumn);
+            }
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            copyResult.store(wil::ResultFromCaughtException(), std::memory_order_relaxed);
+        }
+    });
+    THROW_IF_FAILED(copyResult.load());
+
+    for (const auto& span : spans)
+    {
+        til::at(newRows, span.newRow)->CopyAttrsFrom(*til::at(oldRows, span.oldRow), span.oldColumn, span.length, span.newColumn);
+    }
+    for (const auto row : wrappedRows)
+    {
+        til::at(newRows, row)->SetWrapForced(true);
+    }
+    for (const auto row : paddedRows)
+    {
+        til::at(newRows, row)->SetDoubleBytePadded(true);
+    }
+
+    newBuffer.GetCursor().SetPosition({ gsl::narrow<short>(x), gsl::narrow<short>(y) });
+    if (foundCursor)
+    {
+        newCursorPos = *foundCursor;
+        foundCursorPos = true;
+    }
+    if (positionInfo.has_value())
+    {
+        if (mutableTop)
+        {
+            positionInfo.value().get().mutableViewportTop = *mutableTop;
+        }
+        if (visibleTop)
+        {
+            positionInfo.value().get().visibleViewportTop = *visibleTop;
+        }
+    }
+    return true;
+}
+
 // Function Description:
 // - Reflow the contents from the old buffer into the new buffer. The new buffer
 //   can have different dimensions than the old buffer. If it does, then this
@@ -2129,11 +3103,36 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
 
     COORD cNewCursorPos = { 0 };
     bool fFoundCursorPos = false;
+
+    // Where each old row starts in the new buffer, to move the marks along.
+    std::vector<std::pair<int64_t, SHORT>> rowStarts;
+
+    // Most buffers can be laid out up front and copied into the new buffer
+    // in parallel. The rows of all others are reprinted one by one below.
+    short iOldRow = 0;
+    try
+    {
+        rowStarts.reserve(gsl::narrow_cast<size_t>(cOldRowsTotal));
+        if (_ReflowInParallel(oldBuffer, newBuffer, cOldRowsTotal, positionInfo, cNewCursorPos, fFoundCursorPos, rowStarts))
+        {
+            iOldRow = cOldRowsTotal;
+        }
+        else
+        {
+            rowStarts.clear();
+        }
+    }
+    CATCH_RETURN();
+
     bool foundOldMutable = false;
     bool foundOldVisible = false;
+    // Whether the last cell we inserted into the new buffer was a narrow one.
+    // If so, the next narrow cell can't form an invalid double byte sequence
+    // with it and it's safe to copy text in bulk.
+    bool lastInsertedSingle = false;
     HRESULT hr = S_OK;
     // Loop through all the rows of the old buffer and reprint them into the new buffer
-    for (short iOldRow = 0; iOldRow < cOldRowsTotal; iOldRow++)
+    for (; iOldRow < cOldRowsTotal; iOldRow++)
     {
         // Fetch the row and its "right" which is the last printable character.
         const ROW& row = oldBuffer.GetRowByOffset(iOldRow);
@@ -2144,6 +3143,11 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
         // If we're starting a new row, try and preserve the line rendition
         // from the row in the original buffer.
         const auto newBufferPos = newBuffer.GetCursor().GetPosition();
+        try
+        {
+            rowStarts.emplace_back(newBuffer._marks.GetOrigin() + newBufferPos.Y, newBufferPos.X);
+        }
+        CATCH_RETURN();
         if (newBufferPos.X == 0)
         {
             auto& newRow = newBuffer.GetRowByOffset(newBufferPos.Y);
@@ -2177,7 +3181,8 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
         // Loop through every character in the current row (up to
         // the "right" boundary, which is one past the final valid
         // character)
-        for (short iOldCol = 0; iOldCol < iRight; iOldCol++)
+        auto attrIt = row.GetAttrRow().begin();
+        for (short iOldCol = 0; iOldCol < iRight;)
         {
             if (iOldCol == cOldCursorPos.X && iOldRow == cOldCursorPos.Y)
             {
@@ -2187,18 +3192,65 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
 
             try
             {
+                // Most of the buffer is plain narrow text. Copy as much of it as
+                // shares one attribute and fits onto the current row of the new
+                // buffer in one go. Stop in front of the old cursor, so that
+                // we can still find its new position above.
+                if (lastInsertedSingle)
+                {
+                    const auto newPos = newCursor.GetPosition();
+                    auto limit = std::min<size_t>(iRight - iOldCol, newBuffer.GetLineWidth(newPos.Y) - newPos.X);
+                    if (iOldRow == cOldCursorPos.Y && cOldCursorPos.X > iOldCol)
+                    {
+                        limit = std::min<size_t>(limit, cOldCursorPos.X - iOldCol);
+                    }
+
+                    const auto run = charRow.GetNarrowRun(iOldCol, limit);
+                    size_t runLength = 0;
+                    for (auto it = attrIt; runLength < run.size() && *it == *attrIt; ++it)
+                    {
+                        ++runLength;
+                    }
+
+                    if (runLength > 1)
+                    {
+                        auto& newRow = newBuffer.GetRowByOffset(newPos.Y);
+                        newRow.GetCharRow().WriteNarrowGlyphs(newPos.X, run.substr(0, runLength));
+                        if (!newRow.GetAttrRow().SetAttrToEnd(newPos.X, *attrIt))
+                        {
+                            hr = E_OUTOFMEMORY;
+                            break;
+                        }
+
+                        newCursor.IncrementXPosition(gsl::narrow_cast<int>(runLength - 1));
+                        if (!newBuffer.IncrementCursor())
+                        {
+                            hr = E_OUTOFMEMORY;
+                            break;
+                        }
+
+                        iOldCol += gsl::narrow_cast<short>(runLength);
+                        attrIt += gsl::narrow_cast<ptrdiff_t>(runLength);
+                        continue;
+                    }
+                }
+
                 // TODO: MSFT: 19446208 - this should just use an iterator and the inserter...
-                const auto glyph = row.GetCharRow().GlyphAt(iOldCol);
-                const auto dbcsAttr = row.GetCharRow().DbcsAttrAt(iOldCol);
-                const auto textAttr = row.GetAttrRow().GetAttrByColumn(iOldCol);
+                const auto glyph = charRow.GlyphAt(iOldCol);
+                const auto dbcsAttr = charRow.DbcsAttrAt(iOldCol);
+                const auto textAttr = *attrIt;
 
                 if (!newBuffer.InsertCharacter(glyph, dbcsAttr, textAttr))
                 {
                     hr = E_OUTOFMEMORY;
                     break;
                 }
+                lastInsertedSingle = dbcsAttr.IsSingle();
             }
             CATCH_RETURN();
+
+            iOldCol++;
+            ++attrIt;
         }
 
         // If we found the old row that the caller was interested in, set the
@@ -2352,18 +3404,123 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
 
         // Set size back to real size as it will be taking over the rendering duties.
         newCursor.SetSize(ulSize);
+
+        // The archived history lives on in the new buffer.
+        newBuffer._archive = std::move(oldBuffer._archive);
+
+        // Losing the marks isn't worth failing the reflow over.
+        try
+        {
+            _ReflowMarks(oldBuffer, newBuffer, rowStarts, cOldCursorPos);
+        }
+        CATCH_LOG();
     }
 
     return hr;
 }
 
+// Routine Description:
+// - Carries the marks of the old buffer over to the rows their rows were
+//   reflowed into. A mark is moved along with its row as if all the cells
+//   before it were narrow, which they almost always are in front of a prompt.
+// - The rows below the last one that was copied were blank, and keep their
+//   distance to the cursor.
+// Arguments:
+// - oldBuffer - the text buffer the contents were copied FROM
+// - newBuffer - the text buffer the contents were copied TO
+// - rowStarts - the absolute row (see ScrollMarks::GetOrigin) and the column
+//   of newBuffer that each copied row of oldBuffer starts at
+// - oldCursorPos - the position of the cursor in oldBuffer
+// Return Value:
+// - <none>
+// Note: may throw exception
+void TextBuffer::_ReflowMarks(const TextBuffer& oldBuffer,
+                              TextBuffer& newBuffer,
+                              const std::vector<std::pair<int64_t, SHORT>>& rowStarts,
+                              const COORD oldCursorPos)
+{
+    const int64_t newWidth = newBuffer.GetSize().Width();
+    const int64_t newHeight = newBuffer.GetSize().Height();
+    const auto newOrigin = newBuffer._marks.GetOrigin();
+    const auto newCursorRow = newOrigin + newBuffer.GetCursor().GetPosition().Y;
+
+    for (const auto& mark : oldBuffer._marks.GetAll())
+    {
+        const auto oldRow = gsl::narrow_cast<size_t>(mark.position.Y);
+        int64_t row = 0;
+        int64_t column = 0;
+        if (oldRow < rowStarts.size())
+        {
+            const auto& [startRow, startColumn] = til::at(rowStarts, oldRow);
+            const auto cell = startColumn + mark.position.X;
+            row = startRow + cell / newWidth;
+            column = cell % newWidth;
+
+            // A mark behind the end of the text of its row would otherwise
+            // spill onto the row that the next old row starts on.
+            if (oldRow + 1 < rowStarts.size())
+            {
+                const auto& [nextRow, nextColumn] = til::at(rowStarts, oldRow + 1);
+                if (row > nextRow || (row == nextRow && column > nextColumn))
+                {
+                    row = nextRow;
+                    column = nextColumn;
+                }
+            }
+        }
+        else
+        {
+            row = newCursorRow + mark.position.Y - oldCursorPos.Y;
+            column = std::min<int64_t>(mark.position.X, newWidth - 1);
+        }
+
+        if (row >= newOrigin && row < newOrigin + newHeight)
+        {
+            const COORD position{ gsl::narrow_cast<SHORT>(column), gsl::narrow_cast<SHORT>(row - newOrigin) };
+            newBuffer._marks.Add(position, mark.kind, mark.exitCode);
+        }
+    }
+}
+
 // Method Description:
 // - Adds or updates a hyperlink in our hyperlink table
+// - The URI is appended to the end of _hyperlinkUris. Once the URIs of
+//   removed hyperlinks make up more than half of it, the remaining
+//   ones are moved together first.
 // Arguments:
 // - The hyperlink URI, the hyperlink id (could be new or old)
 void TextBuffer::AddHyperlinkToMap(std::wstring_view uri, uint16_t id)
 {
-    _hyperlinkMap[id] = uri;
+    const auto existing = _hyperlinkMap.find(id);
+    if (existing != _hyperlinkMap.end())
+    {
+        // Links with a custom id are added again every time they're used.
+        if (std::wstring_view{ _hyperlinkUris }.substr(existing->second.offset, existing->second.length) == uri)
+        {
+            return;
+        }
+        _hyperlinkUrisGarbage += existing->second.length;
+    }
+
+    if (_hyperlinkUrisGarbage > _hyperlinkUris.size() / 2)
+    {
+        std::wstring uris;
+        uris.reserve(_hyperlinkUris.size() - _hyperlinkUrisGarbage + uri.size());
+        for (auto& [otherId, otherUri] : _hyperlinkMap)
+        {
+            if (otherId != id)
+            {
+                const auto offset = uris.size();
+                uris.append(_hyperlinkUris, otherUri.offset, otherUri.length);
+                otherUri.offset = offset;
+            }
+        }
+        _hyperlinkUris = std::move(uris);
+        _hyperlinkUrisGarbage = 0;
+    }
+
+    _hyperlinkMap.insert_or_assign(id, HyperlinkUri{ _hyperlinkUris.size(), uri.size() });
+    _hyperlinkUris.append(uri);
 }
 
 // Method Description:
@@ -2374,7 +3531,8 @@ void TextBuffer::AddHyperlinkToMap(std::wstring_view uri, uint16_t id)
 // - The URI
 std::wstring TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
 {
-    return _hyperlinkMap.at(id);
+    const auto& uri = _hyperlinkMap.at(id);
+    return _hyperlinkUris.substr(uri.offset, uri.length);
 }
 
 // Method description:
@@ -2421,7 +3579,13 @@ uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 // - The ID of the hyperlink to be removed
 void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 {
-    _hyperlinkMap.erase(id);
+    const auto uri = _hyperlinkMap.find(id);
+    if (uri == _hyperlinkMap.end())
+    {
+        return;
+    }
+    _hyperlinkUrisGarbage += uri->second.length;
+    _hyperlinkMap.erase(uri);
     for (const auto& customIdPair : _hyperlinkCustomIdMap)
     {
         if (customIdPair.second == id)
@@ -2458,6 +3622,8 @@ std::wstring TextBuffer::GetCustomIdFromId(uint16_t id) const
 // - The other buffer
 void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
 {
+    _hyperlinkUris = other._hyperlinkUris;
+    _hyperlinkUrisGarbage = other._hyperlinkUrisGarbage;
     _hyperlinkMap = other._hyperlinkMap;
     _hyperlinkCustomIdMap = other._hyperlinkCustomIdMap;
     _currentHyperlinkId = other._currentHyperlinkId;
@@ -2465,15 +3631,19 @@ void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
 
 // Method Description:
 // - Adds a regex pattern we should search for
-// - The searching does not happen here, we only search when asked to by TerminalCore
+// - The searching does not happen here, we only search when asked to by TerminalCore.
+//   The pattern is compiled right away though, so that GetPatterns doesn't
+//   have to, and shared with the buffers that copy it.
 // Arguments:
 // - The regex pattern
 // Return value:
 // - An ID that the caller should associate with the given pattern
 const size_t TextBuffer::AddPatternRecognizer(const std::wstring_view regexString)
 {
+    auto regex = std::make_shared<const std::wregex>(regexString.data(), regexString.size(), std::regex_constants::ECMAScript | std::regex_constants::optimize);
     ++_currentPatternId;
-    _idsAndPatterns.emplace(std::make_pair(_currentPatternId, regexString));
+    _idsAndPatterns.emplace(_currentPatternId, std::move(regex));
+    _patternCache.clear();
     return _currentPatternId;
 }
 
@@ -2483,6 +3653,7 @@ void TextBuffer::ClearPatternRecognizers() noexcept
 {
     _idsAndPatterns.clear();
     _currentPatternId = 0;
+    _patternCache.clear();
 }
 
 // Method Description:
@@ -2493,10 +3664,14 @@ void TextBuffer::CopyPatterns(const TextBuffer& OtherBuffer)
 {
     _idsAndPatterns = OtherBuffer._idsAndPatterns;
     _currentPatternId = OtherBuffer._currentPatternId;
+    _patternCache.clear();
 }
 
 // Method Description:
 // - Finds patterns within the requested region of the text buffer
+// - The region is split into lines (runs of rows joined by a forced wrap),
+//   and the matches of each line are cached by the generations of its rows.
+//   This way only the lines that changed since the last call get rescanned.
 // Arguments:
 // - The firstRow to start searching from
 // - The lastRow to search
@@ -2506,60 +3681,97 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
 {
     PointTree::interval_vector intervals;
 
-    std::wstring concatAll;
     const auto rowSize = GetRowByOffset(0).size();
-    concatAll.reserve(rowSize * (lastRow - firstRow + 1));
 
-    // to deal with text that spans multiple lines, we will first concatenate
-    // all the text into one string and find the patterns in that string
-    for (auto i = firstRow; i <= lastRow; ++i)
-    {
-        auto& row = GetRowByOffset(i);
-        concatAll += row.GetText();
-    }
+    // The cache is rebuilt from the lines seen in this pass,
+    // so it doesn't accumulate lines that have scrolled away.
+    decltype(_patternCache) usedCache;
 
-    // for each pattern we know of, iterate through the string
-    for (const auto& idAndPattern : _idsAndPatterns)
+    auto lineStart = firstRow;
+    while (lineStart <= lastRow)
     {
-        std::wregex regexObj{ idAndPattern.second };
-
-        // search through the run with our regex object
-        auto words_begin = std::wsregex_iterator(concatAll.begin(), concatAll.end(), regexObj);
-        auto words_end = std::wsregex_iterator();
-
-        size_t lenUpToThis = 0;
-        for (auto i = words_begin; i != words_end; ++i)
+        // to deal with text that spans multiple lines, we will first concatenate
+        // all the wrapped rows into one string and find the patterns in that string
+        std::vector<uint64_t> key;
+        auto lineEnd = lineStart;
+        for (;; ++lineEnd)
         {
-            // record the locations -
-            // when we find a match, the prefix is text that is between this
-            // match and the previous match, so we use the size of the prefix
-            // along with the size of the match to determine the locations
-            size_t prefixSize = 0;
+            const auto& row = GetRowByOffset(lineEnd);
+            key.emplace_back(row.GetGeneration());
+            if (!row.WasWrapForced() || lineEnd == lastRow)
+            {
+                break;
+            }
+        }
 
-            for (const auto ch : i->prefix().str())
+        auto cached = _patternCache.find(key);
+        if (cached == _patternCache.end())
+        {
+            // The line's text is assembled in a buffer that's reused across calls.
+            auto& concatAll = _patternText;
+            concatAll.clear();
+            concatAll.reserve(rowSize * key.size());
+            for (auto i = lineStart; i <= lineEnd; ++i)
             {
-                prefixSize += IsGlyphFullWidth(ch) ? 2 : 1;
+                concatAll += GetCachedRowText(i);
             }
-            const auto start = lenUpToThis + prefixSize;
-            size_t matchSize = 0;
-            for (const auto ch : i->str())
+
+            // The text has one character per narrow cell and one per wide glyph,
+            // so count the cells between the matches as we go.
+            const auto countCells = [](auto first, const auto last) noexcept {
+                size_t cells = 0;
+                for (; first != last; ++first)
+                {
+                    cells += IsGlyphFullWidth(*first) ? 2 : 1;
+                }
+                return cells;
+            };
+
+            std::vector<std::tuple<size_t, size_t, size_t>> matches;
+
+            // for each pattern we know of, iterate through the string
+            for (const auto& [patternId, regex] : _idsAndPatterns)
             {
-                matchSize += IsGlyphFullWidth(ch) ? 2 : 1;
+                size_t cellsUpToLast = 0;
+                auto lastEnd = concatAll.cbegin();
+                const auto wordsEnd = std::wsregex_iterator();
+                for (auto it = std::wsregex_iterator(concatAll.cbegin(), concatAll.cend(), *regex); it != wordsEnd; ++it)
+                {
+                    const auto& match = (*it)[0];
+                    const auto start = cellsUpToLast + countCells(lastEnd, match.first);
+                    const auto end = start + countCells(match.first, match.second);
+                    matches.emplace_back(patternId, start, end);
+
+                    cellsUpToLast = end;
+                    lastEnd = match.second;
+                }
             }
-            const auto end = start + matchSize;
-            lenUpToThis = end;
 
-            const til::point startCoord{ gsl::narrow<SHORT>(start % rowSize), gsl::narrow<SHORT>(start / rowSize) };
-            const til::point endCoord{ gsl::narrow<SHORT>(end % rowSize), gsl::narrow<SHORT>(end / rowSize) };
+            cached = _patternCache.emplace(std::move(key), std::move(matches)).first;
+        }
+
+        const auto lineOffset = (lineStart - firstRow) * rowSize;
+        for (const auto& [patternId, start, end] : cached->second)
+        {
+            const auto bufferStart = lineOffset + start;
+            const auto bufferEnd = lineOffset + end;
+            const til::point startCoord{ gsl::narrow<SHORT>(bufferStart % rowSize), gsl::narrow<SHORT>(bufferStart / rowSize) };
+            const til::point endCoord{ gsl::narrow<SHORT>(bufferEnd % rowSize), gsl::narrow<SHORT>(bufferEnd / rowSize) };
 
             // store the intervals
             // NOTE: these intervals are relative to the VIEWPORT not the buffer
             // Keeping these relative to the viewport for now because its the renderer
             // that actually uses these locations and the renderer works relative to
             // the viewport
-            intervals.push_back(PointTree::interval(startCoord, endCoord, idAndPattern.first));
+            intervals.push_back(PointTree::interval(startCoord, endCoord, patternId));
         }
+
+        usedCache.insert(_patternCache.extract(cached));
+        lineStart = lineEnd + 1;
     }
+
+    _patternCache = std::move(usedCache);
+
     PointTree result(std::move(intervals));
     return result;
 }
@@ -53,8 +53,10 @@ filling in the last row, and updating the screen.
 
 #include "cursor.h"
 #include "Row.hpp"
+#include "ScrollbackArchive.hpp"
+#include "ScrollMarks.hpp"
 #include "TextAttribute.hpp"
-#include "UnicodeStorage.hpp"
+#include "TextAttributeTable.hpp"
 #include "../types/inc/Viewport.hpp"
 
 #include "../buffer/out/textBufferCellIterator.hpp"
@@ -97,6 +99,28 @@ public:
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    size_t WriteRun(const std::wstring_view chars,
+                    const TextAttribute& attr,
+                    const COORD target,
+                    const bool onlyRedrawChanges = false);
+
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos,
+                          const COORD target);
+
+    size_t FillText(const wchar_t wch,
+                    const COORD target,
+                    const size_t count,
+                    const std::optional<bool> wrap = std::nullopt);
+
+    size_t FillAttributes(const TextAttribute& attr,
+                          const COORD target,
+                          const size_t count);
+
+    void WriteImageSlice(const COORD target,
+                         const til::size cellSize,
+                         const gsl::span<const RGBQUAD> pixels,
+                         const size_t pixelWidth);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -105,6 +129,15 @@ public:
     // Scroll needs access to this to quickly rotate around the buffer.
     bool IncrementCircularBuffer(const bool inVtMode = false);
 
+    void CompactRows(const size_t firstRow, const size_t count);
+    void ClearRows(const size_t firstRow, const size_t count, const TextAttribute& fillAttributes);
+
+    void EnableScrollbackArchive();
+    ScrollbackArchive* GetScrollbackArchive() noexcept;
+
+    void AddMark(const COORD position, const MarkKind kind, const std::optional<unsigned int> exitCode = std::nullopt);
+    const ScrollMarks& GetMarks() const noexcept;
+
     COORD GetLastNonSpaceCharacter(std::optional<const Microsoft::Console::Types::Viewport> viewOptional = std::nullopt) const;
 
     Cursor& GetCursor() noexcept;
@@ -118,6 +151,10 @@ public:
 
     UINT TotalRowCount() const noexcept;
 
+    uint64_t GetGeneration() const noexcept;
+    const std::wstring& GetCachedRowText(const size_t index) const;
+    std::wstring_view GetCachedRowText(const size_t index, const size_t beginColumn, const size_t endColumn) const;
+
     [[nodiscard]] TextAttribute GetCurrentAttributes() const noexcept;
 
     void SetCurrentAttributes(const TextAttribute& currentAttributes) noexcept;
@@ -136,8 +173,10 @@ public:
 
     [[nodiscard]] HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
-    const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    UnicodeStorage& GetUnicodeStorage() noexcept;
+
+    std::shared_ptr<TextAttributeTable> GetAttributeTable();
+    std::pmr::memory_resource* GetRowResource() noexcept;
+    BufferMemoryUsage GetMemoryUsage() const noexcept;
 
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget() noexcept;
 
@@ -174,6 +213,11 @@ public:
                                std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors = nullptr,
                                const bool formatWrappedRows = false) const;
 
+    std::wstring GetPlainText(const bool includeCRLF,
+                              const bool trimTrailingWhitespace,
+                              const std::vector<SMALL_RECT>& selectionRects,
+                              const bool formatWrappedRows = false) const;
+
     static std::string GenHTML(const TextAndColor& rows,
                                const int fontHeightPoints,
                                const std::wstring_view fontFaceName,
@@ -201,8 +245,26 @@ public:
     interval_tree::IntervalTree<til::point, size_t> GetPatterns(const size_t firstRow, const size_t lastRow) const;
 
 private:
+    [[nodiscard]] static bool _ReflowInParallel(const TextBuffer& oldBuffer,
+                                                TextBuffer& newBuffer,
+                                                const short oldRowsTotal,
+                                                std::optional<std::reference_wrapper<PositionInformation>> positionInfo,
+                                                COORD& newCursorPos,
+                                                bool& foundCursorPos,
+                                                std::vector<std::pair<int64_t, SHORT>>& rowStarts);
+    static void _ReflowMarks(const TextBuffer& oldBuffer,
+                             TextBuffer& newBuffer,
+                             const std::vector<std::pair<int64_t, SHORT>>& rowStarts,
+                             const COORD oldCursorPos);
+
     void _UpdateSize();
     Microsoft::Console::Types::Viewport _size;
+
+    // The storage of the rows that doesn't fit into them, like the cells of
+    // wide rows and the runs of their attributes. It has to outlive _storage.
+    // Pooling it makes creating, resizing and destroying the rows cheap,
+    // as they all need blocks of the same few sizes.
+    std::pmr::unsynchronized_pool_resource _rowPool;
     std::vector<ROW> _storage;
     Cursor _cursor;
 
@@ -210,13 +272,46 @@ private:
 
     TextAttribute _currentAttributes;
 
-    // storage location for glyphs that can't fit into the buffer normally
-    UnicodeStorage _unicodeStorage;
+    // the table the attributes of new rows are interned in
+    std::shared_ptr<TextAttributeTable> _attributeTable;
 
-    std::unordered_map<uint16_t, std::wstring> _hyperlinkMap;
+    // where the URI of a hyperlink is stored in _hyperlinkUris
+    struct HyperlinkUri
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    // The URIs of all hyperlinks back to back, so that each of them
+    // doesn't need an allocation of its own. Removed URIs are only
+    // squeezed out once they make up most of it. See AddHyperlinkToMap.
+    std::wstring _hyperlinkUris;
+    size_t _hyperlinkUrisGarbage;
+    std::unordered_map<uint16_t, HyperlinkUri> _hyperlinkMap;
     std::unordered_map<std::wstring, uint16_t> _hyperlinkCustomIdMap;
     uint16_t _currentHyperlinkId;
 
+    // The hyperlink IDs of a row in _storage, as of the row generation they were collected at.
+    struct RowHyperlinks
+    {
+        uint64_t generation = 0;
+        std::vector<uint16_t> ids;
+    };
+
+    // For every row in _storage the hyperlinks it held when it was last
+    // counted, and for every hyperlink the number of rows it appears in.
+    // _MarkRowDirty notes the rows that need to be counted again in
+    // _hyperlinkDirtyRows, so keeping the counts up to date only costs
+    // as much as the rows that were modified in the meantime.
+    std::vector<RowHyperlinks> _rowHyperlinks;
+    std::unordered_map<uint16_t, size_t> _hyperlinkRowCounts;
+    std::vector<size_t> _hyperlinkDirtyRows;
+    uint64_t _hyperlinkCountsGeneration;
+    bool _hyperlinkCountsStale;
+
+    void _UpdateHyperlinkCounts();
+    void _CountRowHyperlinks(const size_t index);
+
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
 
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
@@ -230,6 +325,9 @@ private:
 
     void _NotifyPaint(const Microsoft::Console::Types::Viewport& viewport) const;
 
+    template<typename FillRow>
+    size_t _FillCells(const COORD target, const size_t count, FillRow fillRow);
+
     // Assist with maintaining proper buffer state for Double Byte character sequences
     bool _PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute);
     bool _AssertValidDoubleByteSequence(const DbcsAttribute dbcsAttribute);
@@ -239,17 +337,59 @@ private:
 
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
-    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
-    const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
+    const DelimiterTable& _GetDelimiterTable(const std::wstring_view wordDelimiters) const;
+    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const DelimiterTable& delimiters) const;
+    const COORD _GetWordStartForAccessibility(const COORD target, const DelimiterTable& delimiters) const;
+    const COORD _GetWordStartForSelection(const COORD target, const DelimiterTable& delimiters) const;
+    const COORD _GetWordEndForAccessibility(const COORD target, const DelimiterTable& delimiters, const COORD lastCharPos) const;
+    const COORD _GetWordEndForSelection(const COORD target, const DelimiterTable& delimiters) const;
+
+    // the lookup table for the word delimiters that were used last
+    mutable DelimiterTable _delimiterTable;
 
     void _PruneHyperlinks();
 
-    std::unordered_map<size_t, std::wstring> _idsAndPatterns;
+    // the compiled regexes, shared with the buffers that copy our patterns
+    std::unordered_map<size_t, std::shared_ptr<const std::wregex>> _idsAndPatterns;
     size_t _currentPatternId;
 
+    // rows pushed off the top of the buffer are spilled into here, if enabled
+    std::unique_ptr<ScrollbackArchive> _archive;
+
+    // the prompts and commands the shell marked in the rows
+    ScrollMarks _marks;
+
+    void _InvalidateTextCache() noexcept;
+    void _MarkRowDirty(ROW& row) noexcept;
+
+    // incremented whenever the rows could have been modified or moved around
+    uint64_t _generation;
+
+    struct RowTextCacheEntry
+    {
+        // the row generation the text was extracted at
+        uint64_t generation = 0;
+        std::wstring text;
+        // the offset into text at which each column starts, plus the end of the text.
+        // Empty if every cell holds exactly one character.
+        std::vector<size_t> columns;
+    };
+
+    // the text of each row in _storage
+    mutable std::vector<RowTextCacheEntry> _rowTextCache;
+
+    const RowTextCacheEntry& _GetRowTextCacheEntry(const size_t index) const;
+
+    // The patterns found by GetPatterns in each line (a run of wrapped rows),
+    // keyed by the generations of the rows in that line. Each match is stored
+    // as (pattern ID, start cell, end cell) relative to the start of the line.
+    mutable std::map<std::vector<uint64_t>, std::vector<std::tuple<size_t, size_t, size_t>>> _patternCache;
+    // the text of the line GetPatterns is scanning, kept to reuse its allocation
+    mutable std::wstring _patternText;
+
+    // saves and restores the hyperlink maps along with the rows
+    friend class TextBufferSnapshot;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
@@ -0,0 +1,289 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../Row.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class CharRowTests
+{
+    TEST_CLASS(CharRowTests);
+
+    TEST_METHOD(CanOverwriteEmoji)
+    {
+        ROW row{ 0, 10, TextAttribute{}, nullptr };
+        auto& charRow = row.GetCharRow();
+        const std::wstring_view newMoon{ L"\xD83C\xDF11" };
+        const std::wstring_view fullMoon{ L"\xD83C\xDF15" };
+
+        // store initial glyph
+        charRow.GlyphAt(1) = newMoon;
+        VERIFY_IS_TRUE(charRow.DbcsAttrAt(1).IsGlyphStored());
+        VERIFY_ARE_EQUAL(String(newMoon.data(), 2), String(std::wstring_view{ charRow.GlyphAt(1) }.data(), 2));
+
+        // overwrite it
+        charRow.GlyphAt(1) = fullMoon;
+        VERIFY_IS_TRUE(charRow.DbcsAttrAt(1).IsGlyphStored());
+        VERIFY_ARE_EQUAL(String(fullMoon.data(), 2), String(std::wstring_view{ charRow.GlyphAt(1) }.data(), 2));
+
+        // overwriting it with a narrow glyph clears the stored flag
+        charRow.GlyphAt(1) = L"a";
+        VERIFY_IS_FALSE(charRow.DbcsAttrAt(1).IsGlyphStored());
+        VERIFY_ARE_EQUAL(L'a', std::wstring_view{ charRow.GlyphAt(1) }.front());
+    }
+
+    TEST_METHOD(ReclaimsSlotsOfOverwrittenGlyphs)
+    {
+        constexpr size_t width = 4;
+        ROW row{ 0, width, TextAttribute{}, nullptr };
+        auto& charRow = row.GetCharRow();
+        const std::wstring_view glyph{ L"e\x0301" };
+
+        // Keep storing and clearing glyphs in the same cells. The slots of the
+        // cleared glyphs have to be reclaimed, as there are never more slots than cells.
+        for (size_t i = 0; i < width * 10; ++i)
+        {
+            charRow.GlyphAt(0) = glyph;
+            charRow.GlyphAt(i % width) = glyph;
+            charRow.ClearGlyph(i % width);
+            VERIFY_IS_LESS_THAN_OR_EQUAL(charRow._glyphs.size(), width);
+        }
+
+        // make sure the survivors still point at the right glyphs after renumbering
+        charRow.GlyphAt(0) = L"\xD83C\xDF11";
+        charRow.GlyphAt(2) = glyph;
+        charRow.GlyphAt(3) = L"\xD83C\xDF15";
+        VERIFY_ARE_EQUAL(String(L"\xD83C\xDF11"), String(std::wstring_view{ charRow.GlyphAt(0) }.data(), 2));
+        VERIFY_ARE_EQUAL(String(glyph.data(), 2), String(std::wstring_view{ charRow.GlyphAt(2) }.data(), 2));
+        VERIFY_ARE_EQUAL(String(L"\xD83C\xDF15"), String(std::wstring_view{ charRow.GlyphAt(3) }.data(), 2));
+    }
+
+    TEST_METHOD(RowsThatLookTheSameHashTheSame)
+    {
+        ROW row{ 0, 10, TextAttribute{}, nullptr };
+        ROW other{ 0, 10, TextAttribute{}, nullptr };
+        row.WriteRun(L"abc", 0, TextAttribute{});
+        other.WriteRun(L"abc", 0, TextAttribute{});
+        other.GetCharRow().GlyphAt(5) = L"\xD83C\xDF11";
+        other.GetCharRow().GlyphAt(5) = L" ";
+        VERIFY_ARE_EQUAL(row.GetHash(), other.GetHash());
+
+        // compacting doesn't change how the row looks
+        VERIFY_SUCCEEDED(other.GetCharRow().Compact());
+        VERIFY_ARE_EQUAL(row.GetHash(), other.GetHash());
+
+        // but the colors and the text do
+        other.WriteRun(L"b", 1, TextAttribute{ FOREGROUND_RED });
+        VERIFY_ARE_NOT_EQUAL(row.GetHash(), other.GetHash());
+        row.WriteRun(L"b", 1, TextAttribute{ FOREGROUND_RED });
+        VERIFY_ARE_EQUAL(row.GetHash(), other.GetHash());
+        row.WriteRun(L"x", 9, TextAttribute{ FOREGROUND_RED });
+        VERIFY_ARE_NOT_EQUAL(row.GetHash(), other.GetHash());
+    }
+
+    TEST_METHOD(CharInfosRoundTripThroughTheRow)
+    {
+        ROW row{ 0, 6, TextAttribute{}, nullptr };
+        const std::array<CHAR_INFO, 5> written{ {
+            { L'a', FOREGROUND_RED },
+            { L'\x3042', FOREGROUND_GREEN | COMMON_LVB_LEADING_BYTE },
+            { L'\x3042', FOREGROUND_GREEN | COMMON_LVB_TRAILING_BYTE },
+            { L'b', BACKGROUND_BLUE },
+            { L'c', BACKGROUND_BLUE },
+        } };
+        VERIFY_ARE_EQUAL(size_t{ 5 }, row.WriteCharInfos(written, 1));
+
+        std::array<CHAR_INFO, 6> read{};
+        VERIFY_ARE_EQUAL(size_t{ 6 }, row.ReadCharInfos(0, read));
+        VERIFY_ARE_EQUAL(L' ', read[0].Char.UnicodeChar);
+        for (size_t i = 0; i < written.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(written[i].Char.UnicodeChar, read[i + 1].Char.UnicodeChar);
+            VERIFY_ARE_EQUAL(written[i].Attributes, read[i + 1].Attributes);
+        }
+
+        // A leading byte doesn't fit into the last column and isn't written.
+        const std::array<CHAR_INFO, 2> wide{ {
+            { L'\x3042', COMMON_LVB_LEADING_BYTE },
+            { L'\x3042', COMMON_LVB_TRAILING_BYTE },
+        } };
+        VERIFY_ARE_EQUAL(size_t{ 0 }, row.WriteCharInfos(wide, 5));
+        VERIFY_IS_TRUE(row.WasDoubleBytePadded());
+        VERIFY_ARE_EQUAL(size_t{ 1 }, row.ReadCharInfos(5, read));
+        VERIFY_ARE_EQUAL(L' ', read[0].Char.UnicodeChar);
+    }
+
+    TEST_METHOD(DelimiterTableClassifiesCells)
+    {
+        const std::wstring_view wordDelimiters{ L" /\\()\"'-.,:;<>~!@#$%^&*|+=[]{}~?\x2502" };
+        const DelimiterTable delimiters{ wordDelimiters };
+        VERIFY_IS_TRUE(delimiters.IsFor(wordDelimiters));
+        VERIFY_IS_FALSE(delimiters.IsFor(L" "));
+
+        ROW row{ 0, 6, TextAttribute{}, nullptr };
+        auto& charRow = row.GetCharRow();
+        row.WriteRun(L"a/", 0, TextAttribute{});
+        charRow.GlyphAt(2) = L"\x2502";
+        charRow.GlyphAt(3) = L"\xD83C\xDF11";
+        charRow.GlyphAt(4) = L"\t";
+
+        VERIFY_IS_TRUE(DelimiterClass::RegularChar == charRow.DelimiterClassAt(0, delimiters));
+        VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == charRow.DelimiterClassAt(1, delimiters));
+        VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == charRow.DelimiterClassAt(2, delimiters));
+        VERIFY_IS_TRUE(DelimiterClass::RegularChar == charRow.DelimiterClassAt(3, delimiters));
+        VERIFY_IS_TRUE(DelimiterClass::ControlChar == charRow.DelimiterClassAt(4, delimiters));
+        VERIFY_IS_TRUE(DelimiterClass::ControlChar == charRow.DelimiterClassAt(5, delimiters));
+
+        // without any delimiters, everything but spaces and control characters is part of a word
+        const DelimiterTable none{};
+        VERIFY_IS_TRUE(DelimiterClass::RegularChar == charRow.DelimiterClassAt(1, none));
+        VERIFY_IS_TRUE(DelimiterClass::ControlChar == charRow.DelimiterClassAt(5, none));
+    }
+
+    TEST_METHOD(ReadCellsReturnsTheSegment)
+    {
+        ROW row{ 0, 8, TextAttribute{}, nullptr };
+        auto& charRow = row.GetCharRow();
+        row.WriteRun(L"ab", 0, TextAttribute{ FOREGROUND_RED });
+        charRow.GlyphAt(2) = L"\xD83C\xDF11";
+        charRow.DbcsAttrAt(2).SetLeading();
+        charRow.GlyphAt(3) = L"\xD83C\xDF11";
+        charRow.DbcsAttrAt(3).SetTrailing();
+        VERIFY_SUCCEEDED(charRow.Compact());
+
+        RowCells cells;
+        row.ReadCells(1, 100, cells);
+        VERIFY_ARE_EQUAL(size_t{ 7 }, cells.size());
+        VERIFY_ARE_EQUAL(String(L"b"), String(cells.glyphs[0].data(), 1));
+        VERIFY_ARE_EQUAL(String(L"\xD83C\xDF11"), String(cells.glyphs[1].data(), 2));
+        VERIFY_ARE_EQUAL(String(L"\xD83C\xDF11"), String(cells.glyphs[2].data(), 2));
+        VERIFY_ARE_EQUAL(size_t{ 2 }, cells.ColumnsAt(1));
+        VERIFY_IS_TRUE(cells.dbcsAttrs[2].IsTrailing());
+
+        // the cells past the end of the compacted row are blanks
+        for (size_t i = 3; i < cells.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(String(L" "), String(cells.glyphs[i].data(), 1));
+            VERIFY_IS_TRUE(cells.dbcsAttrs[i].IsSingle());
+        }
+
+        // the attribute runs are clipped to the segment and cover all of it
+        VERIFY_ARE_EQUAL(size_t{ 2 }, cells.attrs.size());
+        VERIFY_IS_TRUE(TextAttribute{ FOREGROUND_RED } == cells.attrs[0].attr);
+        VERIFY_ARE_EQUAL(size_t{ 1 }, cells.attrs[0].length);
+        VERIFY_ARE_EQUAL(size_t{ 6 }, cells.attrs[1].length);
+
+        // and they match what the rest of the row says about the cells
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(charRow.DbcsAttrAt(i + 1).IsLeading(), cells.dbcsAttrs[i].IsLeading());
+        }
+
+        row.ReadCells(8, 10, cells);
+        VERIFY_ARE_EQUAL(size_t{ 0 }, cells.size());
+        VERIFY_IS_TRUE(cells.attrs.empty());
+    }
+
+    TEST_METHOD(GlyphsMoveWithTheirRow)
+    {
+        std::vector<ROW> rows;
+        rows.emplace_back(SHORT{ 0 }, gsl::narrow_cast<unsigned short>(10), TextAttribute{}, nullptr);
+        rows.emplace_back(SHORT{ 1 }, gsl::narrow_cast<unsigned short>(10), TextAttribute{}, nullptr);
+        rows[0].GetCharRow().GlyphAt(3) = L"\xD83C\xDF46";
+
+        std::rotate(rows.begin(), rows.begin() + 1, rows.end());
+        for (auto& row : rows)
+        {
+            row.GetCharRow().UpdateParent(&row);
+        }
+
+        VERIFY_IS_FALSE(rows[0].GetCharRow().DbcsAttrAt(3).IsGlyphStored());
+        VERIFY_IS_TRUE(rows[1].GetCharRow().DbcsAttrAt(3).IsGlyphStored());
+        const std::wstring_view text{ rows[1].GetCharRow().GlyphAt(3) };
+        VERIFY_ARE_EQUAL(String(L"\xD83C\xDF46"), String(text.data(), gsl::narrow<int>(text.size())));
+    }
+
+    TEST_METHOD(FindsTheCellsARunChanges)
+    {
+        ROW row{ 0, 20, TextAttribute{}, nullptr };
+        const TextAttribute red{ FOREGROUND_RED };
+        row.WriteRun(L"[#####     ] 50%", 0, TextAttribute{});
+
+        Log::Comment(L"Rewriting the line with one step of progress only changes those cells.");
+        auto changed = row.FindChangedCells(L"[######    ] 60%", 0, TextAttribute{});
+        VERIFY_ARE_EQUAL(6u, changed.first);
+        VERIFY_ARE_EQUAL(14u, changed.second);
+
+        Log::Comment(L"Rewriting it as it is changes nothing.");
+        changed = row.FindChangedCells(L"[#####     ] 50%", 0, TextAttribute{});
+        VERIFY_ARE_EQUAL(changed.first, changed.second);
+
+        Log::Comment(L"Other attributes change the cells, too.");
+        changed = row.FindChangedCells(L"#####", 1, red);
+        VERIFY_ARE_EQUAL(1u, changed.first);
+        VERIFY_ARE_EQUAL(6u, changed.second);
+
+        Log::Comment(L"Only the printable ASCII at the start is written and compared.");
+        changed = row.FindChangedCells(L"[#x\x263A", 0, TextAttribute{});
+        VERIFY_ARE_EQUAL(2u, changed.first);
+        VERIFY_ARE_EQUAL(3u, changed.second);
+
+        Log::Comment(L"The blanks past the end of a compacted row don't count as unchanged.");
+        VERIFY_SUCCEEDED(row.GetCharRow().Compact());
+        changed = row.FindChangedCells(L"   ", 17, TextAttribute{});
+        VERIFY_ARE_EQUAL(17u, changed.first);
+        VERIFY_ARE_EQUAL(20u, changed.second);
+    }
+
+    TEST_METHOD(WideRowsAllocateFromTheirResource)
+    {
+        struct CountingResource : std::pmr::memory_resource
+        {
+            size_t allocations = 0;
+
+            void* do_allocate(const size_t bytes, const size_t align) override
+            {
+                ++allocations;
+                return til::pmr::get_default_resource()->allocate(bytes, align);
+            }
+
+            void do_deallocate(void* const ptr, const size_t bytes, const size_t align) override
+            {
+                til::pmr::get_default_resource()->deallocate(ptr, bytes, align);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        } resource;
+
+        ROW row{ 0, 10, TextAttribute{}, nullptr };
+
+        Log::Comment(L"Narrow rows and rows with a single run of attributes fit into themselves.");
+        {
+            CharRow charRow{ 10, &row, &resource };
+            ATTR_ROW attrRow{ 200, TextAttribute{}, nullptr, &resource };
+        }
+        VERIFY_ARE_EQUAL(0u, resource.allocations);
+
+        Log::Comment(L"Everything beyond that comes from the resource.");
+        {
+            CharRow charRow{ 200, &row, &resource };
+            VERIFY_ARE_EQUAL(2u, resource.allocations);
+            VERIFY_SUCCEEDED(charRow.Resize(400));
+            VERIFY_IS_GREATER_THAN(resource.allocations, 2u);
+            const auto charRowAllocations = resource.allocations;
+
+            ATTR_ROW attrRow{ 200, TextAttribute{}, nullptr, &resource };
+            attrRow.Replace(10, 20, TextAttribute{ FOREGROUND_RED });
+            VERIFY_IS_GREATER_THAN(resource.allocations, charRowAllocations);
+        }
+    }
+};
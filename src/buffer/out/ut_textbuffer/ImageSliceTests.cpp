@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../ImageSlice.hpp"
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ImageSliceTests
+{
+    TEST_CLASS(ImageSliceTests);
+
+    // Cells of one by two pixels keep the pixel math in these tests simple.
+    static constexpr til::size CellSize{ 1, 2 };
+    static constexpr RGBQUAD Red{ 0, 0, 0xff, 0xff };
+    static constexpr RGBQUAD Blue{ 0xff, 0, 0, 0xff };
+
+    TEST_METHOD(LayersTransparentPixels)
+    {
+        ImageSlice slice{ CellSize };
+        VERIFY_ARE_EQUAL(0u, slice.PixelWidth());
+        const auto revision = slice.Revision();
+
+        const std::vector<RGBQUAD> first{ Red, Red, Red, Red };
+        slice.CopyCells(first, 2, 3);
+        VERIFY_ARE_EQUAL(3u, slice.ColumnBegin());
+        VERIFY_ARE_EQUAL(5u, slice.ColumnEnd());
+        VERIFY_ARE_NOT_EQUAL(revision, slice.Revision());
+
+        Log::Comment(L"The transparent pixels leave the ones below, the slice grows to the left.");
+        const std::vector<RGBQUAD> second{ Blue, RGBQUAD{}, RGBQUAD{}, Blue };
+        slice.CopyCells(second, 2, 2);
+        VERIFY_ARE_EQUAL(2u, slice.ColumnBegin());
+        VERIFY_ARE_EQUAL(3u, slice.PixelWidth());
+
+        const auto pixels = slice.Pixels();
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, pixels[0].rgbBlue);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, pixels[1].rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, pixels[2].rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, pixels[3].rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, pixels[4].rgbBlue);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, pixels[5].rgbRed);
+
+        Log::Comment(L"Erasing all of the cells leaves nothing.");
+        VERIFY_IS_FALSE(slice.EraseCells(0, 3));
+        VERIFY_IS_TRUE(slice.EraseCells(3, 10));
+    }
+
+    TEST_METHOD(SlicesFollowTheRows)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 10, 4 }, TextAttribute{}, 12, target };
+
+        Log::Comment(L"The pixels beyond the right edge of the buffer are cut off.");
+        const std::vector<RGBQUAD> pixels(4 * 2, Red);
+        buffer.WriteImageSlice({ 8, 1 }, CellSize, pixels, 4);
+        const auto slice = buffer.GetRowByOffset(1).GetImageSlice();
+        VERIFY_IS_NOT_NULL(slice);
+        VERIFY_ARE_EQUAL(8u, slice->ColumnBegin());
+        VERIFY_ARE_EQUAL(10u, slice->ColumnEnd());
+
+        Log::Comment(L"Circling the buffer takes the slice along, until its row is recycled.");
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+        VERIFY_ARE_EQUAL(slice, buffer.GetRowByOffset(0).GetImageSlice());
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+        for (SHORT y = 0; y < 4; ++y)
+        {
+            VERIFY_IS_NULL(buffer.GetRowByOffset(y).GetImageSlice());
+        }
+    }
+
+    TEST_METHOD(TextErasesCells)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 10, 4 }, TextAttribute{}, 12, target };
+        const std::vector<RGBQUAD> pixels(3 * 2, Red);
+        buffer.WriteImageSlice({ 2, 0 }, CellSize, pixels, 3);
+
+        Log::Comment(L"Text written into the image erases its cells...");
+        buffer.WriteRun(L"a", TextAttribute{}, { 3, 0 });
+        const auto slice = buffer.GetRowByOffset(0).GetImageSlice();
+        VERIFY_IS_NOT_NULL(slice);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, slice->Pixels()[0].rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, slice->Pixels()[1].rgbReserved);
+
+        Log::Comment(L"...and once all of them are gone, so is the slice.");
+        buffer.WriteRun(L"a", TextAttribute{}, { 2, 0 });
+        buffer.WriteRun(L"a", TextAttribute{}, { 4, 0 });
+        VERIFY_IS_NULL(buffer.GetRowByOffset(0).GetImageSlice());
+    }
+
+    TEST_METHOD(SlicesCountTowardsMemoryUsage)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 10, 4 }, TextAttribute{}, 12, target };
+        const auto before = buffer.GetMemoryUsage();
+        VERIFY_ARE_EQUAL(0u, before.images);
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(before.text, 4 * sizeof(ROW));
+
+        const std::vector<RGBQUAD> pixels(3 * 2, Red);
+        buffer.WriteImageSlice({ 2, 0 }, CellSize, pixels, 3);
+        const auto after = buffer.GetMemoryUsage();
+        VERIFY_ARE_EQUAL(sizeof(ImageSlice) + pixels.size() * sizeof(RGBQUAD), after.images);
+        VERIFY_ARE_EQUAL(before.Total() + after.images, after.Total());
+    }
+};
@@ -746,21 +746,21 @@ class ReflowTests
             row.SetWrapForced(testRow.wrap);
 
             size_t j{};
-            for (auto it{ charRow.begin() }; it != charRow.end(); ++it)
+            for (size_t col{}; col < charRow.size(); ++col)
             {
                 // Yes, we're about to manually create a buffer. It is unpleasant.
                 const auto ch{ til::at(testRow.text, j) };
-                it->Char() = ch;
+                charRow.GlyphAt(col) = std::wstring_view{ &ch, 1 };
                 if (IsGlyphFullWidth(ch))
                 {
-                    it->DbcsAttr().SetLeading();
-                    it++;
-                    it->Char() = ch;
-                    it->DbcsAttr().SetTrailing();
+                    charRow.DbcsAttrAt(col).SetLeading();
+                    col++;
+                    charRow.GlyphAt(col) = std::wstring_view{ &ch, 1 };
+                    charRow.DbcsAttrAt(col).SetTrailing();
                 }
                 else
                 {
-                    it->DbcsAttr().SetSingle();
+                    charRow.DbcsAttrAt(col).SetSingle();
                 }
                 j++;
             }
@@ -795,27 +795,27 @@ class ReflowTests
             VERIFY_ARE_EQUAL(testRow.wrap, row.WasWrapForced(), indexString);
 
             size_t j{};
-            for (auto it{ charRow.begin() }; it != charRow.end(); ++it)
+            for (size_t col{}; col < charRow.size(); ++col)
             {
-                indexString.Format(L"[Cell %d, %d; Text line index %d]", it - charRow.begin(), i, j);
+                indexString.Format(L"[Cell %d, %d; Text line index %d]", col, i, j);
                 // Yes, we're about to manually create a buffer. It is unpleasant.
                 const auto ch{ til::at(testRow.text, j) };
                 if (IsGlyphFullWidth(ch))
                 {
                     // Char is full width in test buffer, so
                     // ensure that real buffer is LEAD, TRAIL (ch)
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsLeading(), indexString);
-                    VERIFY_ARE_EQUAL(ch, it->Char(), indexString);
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsLeading(), indexString);
+                    VERIFY_ARE_EQUAL(ch, *charRow.GlyphAt(col).begin(), indexString);
 
-                    it++;
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsTrailing(), indexString);
+                    col++;
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsTrailing(), indexString);
                 }
                 else
                 {
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsSingle(), indexString);
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsSingle(), indexString);
                 }
 
-                VERIFY_ARE_EQUAL(ch, it->Char(), indexString);
+                VERIFY_ARE_EQUAL(ch, *charRow.GlyphAt(col).begin(), indexString);
                 j++;
             }
             i++;
@@ -851,6 +851,42 @@ class ReflowTests
             _compareTextBufferAgainstTestBuffer(*textBuffer, testBuffer);
         }
     }
+
+    TEST_METHOD(ReflowCopiesTheAttributesOfTheCells)
+    {
+        const TextAttribute red{ FOREGROUND_RED };
+        const TextAttribute blue{ FOREGROUND_BLUE };
+        const TextAttribute green{ FOREGROUND_GREEN };
+
+        TextBuffer oldBuffer{ { 10, 3 }, TextAttribute{ 0x7 }, 0, target };
+        auto& first = oldBuffer.GetRowByOffset(0);
+        first.WriteRun(L"abcde", 0, red);
+        first.WriteRun(L"fghij", 5, blue, true);
+        oldBuffer.GetRowByOffset(1).WriteRun(L"kl", 0, green);
+        oldBuffer.GetCursor().SetPosition({ 2, 1 });
+
+        const auto newBuffer = _textBufferByReflowingTextBuffer(oldBuffer, { 4, 6 });
+
+        // The attributes move along with their cells, across the new row boundaries...
+        const auto& row0 = newBuffer->GetRowByOffset(0);
+        const auto& row1 = newBuffer->GetRowByOffset(1);
+        const auto& row2 = newBuffer->GetRowByOffset(2);
+        VERIFY_ARE_EQUAL(String(L"abcd"), String(row0.GetText().c_str()));
+        VERIFY_ARE_EQUAL(String(L"efgh"), String(row1.GetText().c_str()));
+        VERIFY_ARE_EQUAL(String(L"ijkl"), String(row2.GetText().c_str()));
+        VERIFY_IS_TRUE(row0.WasWrapForced());
+        VERIFY_IS_TRUE(row1.WasWrapForced());
+        VERIFY_IS_TRUE(row2.WasWrapForced());
+        VERIFY_IS_TRUE(red == row0.GetAttrRow().GetAttrByColumn(3));
+        VERIFY_IS_TRUE(red == row1.GetAttrRow().GetAttrByColumn(0));
+        VERIFY_IS_TRUE(blue == row1.GetAttrRow().GetAttrByColumn(1));
+        VERIFY_IS_TRUE(blue == row2.GetAttrRow().GetAttrByColumn(1));
+        VERIFY_IS_TRUE(green == row2.GetAttrRow().GetAttrByColumn(2));
+        VERIFY_IS_TRUE(green == row2.GetAttrRow().GetAttrByColumn(3));
+
+        // ...and the cursor stays behind the last cell of its line.
+        VERIFY_ARE_EQUAL((COORD{ 0, 3 }), newBuffer->GetCursor().GetPosition());
+    }
 };
 
 DummyRenderTarget ReflowTests::target{};
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../ScrollMarks.hpp"
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ScrollMarksTests
+{
+    TEST_CLASS(ScrollMarksTests);
+
+    TEST_METHOD(FindsTheClosestMarks)
+    {
+        ScrollMarks marks;
+        marks.Add({ 0, 2 }, MarkKind::Prompt);
+        marks.Add({ 0, 20 }, MarkKind::Prompt);
+        marks.Add({ 0, 10 }, MarkKind::Prompt);
+        marks.Add({ 4, 10 }, MarkKind::Command);
+
+        Log::Comment(L"A prompt that's drawn again doesn't add another mark.");
+        marks.Add({ 0, 10 }, MarkKind::Prompt);
+        VERIFY_ARE_EQUAL(4u, marks.size());
+
+        VERIFY_ARE_EQUAL(2, marks.Previous(MarkKind::Prompt, 10)->position.Y);
+        VERIFY_ARE_EQUAL(20, marks.Next(MarkKind::Prompt, 10)->position.Y);
+        VERIFY_IS_FALSE(marks.Previous(MarkKind::Prompt, 2).has_value());
+        VERIFY_IS_FALSE(marks.Next(MarkKind::Prompt, 20).has_value());
+
+        Log::Comment(L"The kinds are looked up separately.");
+        VERIFY_IS_FALSE(marks.Previous(MarkKind::Command, 10).has_value());
+        VERIFY_ARE_EQUAL(COORD({ 4, 10 }), marks.Next(MarkKind::Command, 9)->position);
+
+        const auto all = marks.GetAll();
+        VERIFY_ARE_EQUAL(4u, all.size());
+        VERIFY_ARE_EQUAL(COORD({ 0, 10 }), all.at(1).position);
+        VERIFY_ARE_EQUAL(COORD({ 4, 10 }), all.at(2).position);
+        VERIFY_IS_TRUE(all.at(2).kind == MarkKind::Command);
+    }
+
+    TEST_METHOD(FindsTheCommandOutput)
+    {
+        ScrollMarks marks;
+        marks.Add({ 0, 0 }, MarkKind::Prompt);
+        marks.Add({ 2, 0 }, MarkKind::Command);
+        marks.Add({ 0, 1 }, MarkKind::Output);
+        marks.Add({ 0, 3 }, MarkKind::CommandFinished, 0u);
+        marks.Add({ 0, 3 }, MarkKind::Prompt);
+        marks.Add({ 2, 3 }, MarkKind::Command);
+        marks.Add({ 0, 4 }, MarkKind::Output);
+
+        const COORD cursor{ 0, 6 };
+        VERIFY_IS_FALSE(marks.GetCommandOutput(0, cursor).has_value());
+
+        auto output = marks.GetCommandOutput(2, cursor).value();
+        VERIFY_ARE_EQUAL(COORD({ 0, 1 }), output.first);
+        VERIFY_ARE_EQUAL(COORD({ 0, 3 }), output.second);
+
+        Log::Comment(L"On the next prompt, it's still the output above it.");
+        output = marks.GetCommandOutput(3, cursor).value();
+        VERIFY_ARE_EQUAL(COORD({ 0, 1 }), output.first);
+        VERIFY_ARE_EQUAL(COORD({ 0, 3 }), output.second);
+
+        Log::Comment(L"The output of a running command ends at the cursor.");
+        output = marks.GetCommandOutput(5, cursor).value();
+        VERIFY_ARE_EQUAL(COORD({ 0, 4 }), output.first);
+        VERIFY_ARE_EQUAL(cursor, output.second);
+    }
+
+    TEST_METHOD(MarksFollowTheRows)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 10, 6 }, TextAttribute{}, 12, target };
+
+        Log::Comment(L"Circling the buffer moves the marks up, and drops the ones of the top row.");
+        buffer.AddMark({ 0, 1 }, MarkKind::Prompt);
+        buffer.AddMark({ 0, 3 }, MarkKind::Prompt);
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+        VERIFY_ARE_EQUAL(1u, buffer.GetMarks().size());
+        VERIFY_ARE_EQUAL(1, buffer.GetMarks().Next(MarkKind::Prompt, 0)->position.Y);
+
+        Log::Comment(L"Scrolled rows take their marks along, the ones scrolled over lose theirs.");
+        buffer.AddMark({ 0, 3 }, MarkKind::Output);
+        buffer.ScrollRows(3, 2, -2);
+        VERIFY_IS_FALSE(buffer.GetMarks().Next(MarkKind::Prompt, -1).has_value());
+        VERIFY_ARE_EQUAL(1, buffer.GetMarks().Next(MarkKind::Output, -1)->position.Y);
+
+        Log::Comment(L"Resizing keeps the marks on the rows that are kept.");
+        buffer.GetCursor().SetPosition({ 0, 4 });
+        VERIFY_SUCCEEDED(buffer.ResizeTraditional({ 10, 4 }));
+        VERIFY_ARE_EQUAL(0, buffer.GetMarks().Next(MarkKind::Output, -1)->position.Y);
+    }
+
+    TEST_METHOD(MarksAreReflowed)
+    {
+        DummyRenderTarget target;
+        TextBuffer oldBuffer{ { 10, 5 }, TextAttribute{}, 12, target };
+        oldBuffer.WriteRun(L"0123456789", TextAttribute{}, { 0, 0 });
+        oldBuffer.GetRowByOffset(0).SetWrapForced(true);
+        oldBuffer.WriteRun(L"ab", TextAttribute{}, { 0, 1 });
+        oldBuffer.WriteRun(L"$", TextAttribute{}, { 0, 2 });
+        oldBuffer.GetCursor().SetPosition({ 2, 2 });
+        oldBuffer.AddMark({ 0, 2 }, MarkKind::Prompt);
+        oldBuffer.AddMark({ 2, 2 }, MarkKind::Command);
+
+        TextBuffer newBuffer{ { 5, 10 }, TextAttribute{}, 12, target };
+        VERIFY_SUCCEEDED(TextBuffer::Reflow(oldBuffer, newBuffer, std::nullopt, std::nullopt));
+
+        Log::Comment(L"The first line now takes up three rows, which pushes the prompt down by one.");
+        const auto all = newBuffer.GetMarks().GetAll();
+        VERIFY_ARE_EQUAL(2u, all.size());
+        VERIFY_ARE_EQUAL(COORD({ 0, 3 }), all.at(0).position);
+        VERIFY_ARE_EQUAL(COORD({ 2, 3 }), all.at(1).position);
+        VERIFY_ARE_EQUAL(newBuffer.GetCursor().GetPosition(), all.at(1).position);
+    }
+};
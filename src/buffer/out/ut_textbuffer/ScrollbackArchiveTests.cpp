@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../ScrollbackArchive.hpp"
+#include "../Row.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ScrollbackArchiveTests
+{
+    TEST_CLASS(ScrollbackArchiveTests);
+
+    TEST_METHOD(RoundTripsRows)
+    {
+        ScrollbackArchive archive;
+        const TextAttribute defaultAttr{};
+        const TextAttribute redAttr{ FOREGROUND_RED };
+
+        ROW row{ 0, 20, defaultAttr, nullptr };
+        row.WriteRun(L"Hello", 2, redAttr);
+        row.SetWrapForced(true);
+        archive.Append(row);
+
+        ROW blankRow{ 1, 20, defaultAttr, nullptr };
+        archive.Append(blankRow);
+
+        VERIFY_ARE_EQUAL(2u, archive.size());
+
+        Log::Comment(L"Text is trimmed of trailing spaces, attributes are kept as runs.");
+        const auto archived = archive.GetRow(0);
+        VERIFY_ARE_EQUAL(L"  Hello", std::wstring_view{ archived.text });
+        VERIFY_IS_TRUE(archived.wrapForced);
+        VERIFY_ARE_EQUAL(3u, archived.attributes.size());
+        VERIFY_ARE_EQUAL(defaultAttr, archived.attributes.at(0).first);
+        VERIFY_ARE_EQUAL(uint16_t{ 2 }, archived.attributes.at(0).second);
+        VERIFY_ARE_EQUAL(redAttr, archived.attributes.at(1).first);
+        VERIFY_ARE_EQUAL(uint16_t{ 5 }, archived.attributes.at(1).second);
+        VERIFY_ARE_EQUAL(uint16_t{ 13 }, archived.attributes.at(2).second);
+
+        VERIFY_IS_TRUE(archive.GetText(1).empty());
+        VERIFY_IS_FALSE(archive.GetRow(1).wrapForced);
+
+        Log::Comment(L"Rows can be searched.");
+        VERIFY_ARE_EQUAL(0u, archive.FindRow(L"llo", 0).value_or(SIZE_MAX));
+        VERIFY_IS_FALSE(archive.FindRow(L"llo", 1).has_value());
+        VERIFY_IS_FALSE(archive.FindRow(L"World", 0).has_value());
+
+        VERIFY_THROWS(archive.GetRow(2), wil::ResultException);
+    }
+
+    TEST_METHOD(ReadsBackMoreRowsThanCached)
+    {
+        ScrollbackArchive archive;
+        const TextAttribute attr{};
+
+        Log::Comment(L"Interleave appends and reads so the file gets remapped as it grows.");
+        constexpr size_t rowCount = 1000;
+        for (size_t i = 0; i < rowCount; ++i)
+        {
+            ROW row{ 0, 20, attr, nullptr };
+            row.WriteRun(std::to_wstring(i), 0, attr);
+            archive.Append(row);
+            VERIFY_ARE_EQUAL(std::to_wstring(i), archive.GetText(i));
+        }
+
+        for (size_t i = 0; i < rowCount; ++i)
+        {
+            VERIFY_ARE_EQUAL(std::to_wstring(i), archive.GetText(i));
+        }
+
+        VERIFY_ARE_EQUAL(999u, archive.FindRow(L"999", 0).value_or(SIZE_MAX));
+    }
+};
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../TextAttributeTable.hpp"
+#include "../AttrRow.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextAttributeTableTests
+{
+    TEST_CLASS(TextAttributeTableTests);
+
+    // Fills up the table with distinct RGB attributes.
+    static void s_FillTable(TextAttributeTable& table)
+    {
+        for (size_t i = 0; !table.IsFull(); ++i)
+        {
+            const TextAttribute attr{ RGB(i & 0xff, (i >> 8) & 0xff, 1), RGB(0, 0, 0) };
+            VERIFY_IS_TRUE(table.TryIntern(attr).has_value());
+        }
+    }
+
+    TEST_METHOD(InternsEachAttributeOnce)
+    {
+        TextAttributeTable table;
+        const TextAttribute defaultAttr{};
+        const TextAttribute redAttr{ FOREGROUND_RED };
+        auto underlinedAttr = redAttr;
+        underlinedAttr.SetUnderlined(true);
+
+        const auto defaultId = table.TryIntern(defaultAttr);
+        const auto redId = table.TryIntern(redAttr);
+        const auto underlinedId = table.TryIntern(underlinedAttr);
+        VERIFY_IS_TRUE(defaultId.has_value());
+        VERIFY_IS_TRUE(redId.has_value());
+        VERIFY_IS_TRUE(underlinedId.has_value());
+        VERIFY_ARE_NOT_EQUAL(*defaultId, *redId);
+        VERIFY_ARE_NOT_EQUAL(*redId, *underlinedId);
+
+        VERIFY_ARE_EQUAL(*defaultId, table.TryIntern(defaultAttr).value());
+        VERIFY_ARE_EQUAL(*redId, table.Find(redAttr).value());
+        VERIFY_ARE_EQUAL(size_t{ 3 }, table.Size());
+
+        VERIFY_ARE_EQUAL(defaultAttr, table.At(*defaultId));
+        VERIFY_ARE_EQUAL(redAttr, table.At(*redId));
+        VERIFY_ARE_EQUAL(underlinedAttr, table.At(*underlinedId));
+
+        VERIFY_IS_FALSE(table.Find(TextAttribute{ FOREGROUND_GREEN }).has_value());
+    }
+
+    TEST_METHOD(RefusesAttributesOnceFull)
+    {
+        TextAttributeTable table;
+        s_FillTable(table);
+
+        VERIFY_IS_TRUE(table.IsFull());
+        VERIFY_IS_FALSE(table.TryIntern(TextAttribute{}).has_value());
+        VERIFY_IS_TRUE(table.TryIntern(TextAttribute{ RGB(0, 0, 1), RGB(0, 0, 0) }).has_value());
+    }
+
+    TEST_METHOD(RowMovesToSuccessorOnceFull)
+    {
+        const auto table = std::make_shared<TextAttributeTable>();
+        const TextAttribute defaultAttr{};
+        const TextAttribute redAttr{ FOREGROUND_RED };
+
+        ATTR_ROW row{ 10, defaultAttr, table };
+        row.Replace(2, 4, redAttr);
+        s_FillTable(*table);
+
+        // The green attribute doesn't fit into the full table anymore.
+        const TextAttribute greenAttr{ FOREGROUND_GREEN };
+        row.Replace(6, 8, greenAttr);
+        VERIFY_IS_TRUE(table->IsFull());
+        VERIFY_ARE_EQUAL(size_t{ 3 }, table->GetSuccessor()->Size());
+
+        const std::vector<TextAttribute> expected{
+            defaultAttr, defaultAttr, redAttr, redAttr, defaultAttr, defaultAttr, greenAttr, greenAttr, defaultAttr, defaultAttr
+        };
+        const std::vector<TextAttribute> actual{ row.begin(), row.end() };
+        VERIFY_ARE_EQUAL(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i], actual[i]);
+        }
+
+        // Rows still compare equal, even if they're interned in different tables.
+        ATTR_ROW other{ 10, defaultAttr };
+        other.Replace(2, 4, redAttr);
+        other.Replace(6, 8, greenAttr);
+        VERIFY_IS_TRUE(row == other);
+    }
+};
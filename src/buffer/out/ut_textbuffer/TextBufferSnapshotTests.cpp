@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../TextBufferSnapshot.hpp"
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextBufferSnapshotTests
+{
+    TEST_CLASS(TextBufferSnapshotTests);
+
+    TEST_METHOD(RoundTripsTheBuffer)
+    {
+        DummyRenderTarget target;
+        const TextAttribute defaultAttr{};
+        const TextAttribute redAttr{ FOREGROUND_RED };
+
+        TextBuffer buffer{ { 20, 10 }, defaultAttr, 12, target };
+
+        const std::wstring_view uri{ L"https://example.com" };
+        const auto hyperlinkId = buffer.GetHyperlinkId(uri, L"custom");
+        buffer.AddHyperlinkToMap(uri, hyperlinkId);
+        auto linkAttr = redAttr;
+        linkAttr.SetHyperlinkId(hyperlinkId);
+
+        buffer.WriteRun(L"Hello", redAttr, { 2, 0 });
+        buffer.WriteRun(L"link", linkAttr, { 10, 0 });
+
+        auto& wideRow = buffer.GetRowByOffset(1);
+        auto& charRow = wideRow.GetCharRow();
+        charRow.GlyphAt(0) = L"\x3042";
+        charRow.DbcsAttrAt(0).SetLeading();
+        charRow.GlyphAt(1) = L"\x3042";
+        charRow.DbcsAttrAt(1).SetTrailing();
+        charRow.GlyphAt(2) = L"e\x0301";
+        charRow.GlyphAt(3) = L"\xD83C\xDF11";
+        charRow.DbcsAttrAt(3).SetLeading();
+        charRow.GlyphAt(4) = L"\xD83C\xDF11";
+        charRow.DbcsAttrAt(4).SetTrailing();
+        wideRow.SetWrapForced(true);
+
+        buffer.GetRowByOffset(2).SetLineRendition(LineRendition::DoubleWidth);
+        buffer.GetCursor().SetPosition({ 3, 4 });
+
+        const auto path = std::filesystem::temp_directory_path() / L"TextBufferSnapshotTests.bin";
+        auto removeFile = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+        TextBufferSnapshot::Save(buffer, path);
+
+        Log::Comment(L"The buffer is restored into one of another size, which is resized to fit.");
+        TextBuffer restored{ { 5, 3 }, defaultAttr, 12, target };
+        TextBufferSnapshot::Load(restored, path);
+        VERIFY_ARE_EQUAL(buffer.GetSize().Dimensions(), restored.GetSize().Dimensions());
+
+        for (size_t y = 0; y < buffer.TotalRowCount(); ++y)
+        {
+            const auto& expected = buffer.GetRowByOffset(y);
+            const auto& actual = restored.GetRowByOffset(y);
+            VERIFY_ARE_EQUAL(expected.GetText(), actual.GetText());
+            VERIFY_ARE_EQUAL(expected.WasWrapForced(), actual.WasWrapForced());
+            VERIFY_IS_TRUE(expected.GetLineRendition() == actual.GetLineRendition());
+            VERIFY_IS_TRUE(expected.GetAttrRow() == actual.GetAttrRow());
+            for (size_t x = 0; x < expected.size(); ++x)
+            {
+                VERIFY_ARE_EQUAL(expected.GetCharRow().DbcsAttrAt(x).IsLeading(), actual.GetCharRow().DbcsAttrAt(x).IsLeading());
+                VERIFY_ARE_EQUAL(expected.GetCharRow().DbcsAttrAt(x).IsTrailing(), actual.GetCharRow().DbcsAttrAt(x).IsTrailing());
+            }
+        }
+
+        Log::Comment(L"Wide and combined glyphs keep their cells.");
+        const std::wstring_view combined{ restored.GetRowByOffset(1).GetCharRow().GlyphAt(2) };
+        VERIFY_ARE_EQUAL(String(L"e\x0301"), String(combined.data(), gsl::narrow<int>(combined.size())));
+
+        Log::Comment(L"The hyperlinks and the cursor are restored too.");
+        VERIFY_ARE_EQUAL(std::wstring{ uri }, restored.GetHyperlinkUriFromId(hyperlinkId));
+        VERIFY_ARE_EQUAL(buffer.GetCustomIdFromId(hyperlinkId), restored.GetCustomIdFromId(hyperlinkId));
+        VERIFY_ARE_EQUAL(hyperlinkId, restored.GetHyperlinkId(uri, L"custom"));
+        VERIFY_ARE_EQUAL(COORD({ 3, 4 }), restored.GetCursor().GetPosition());
+    }
+
+    TEST_METHOD(RejectsInvalidFiles)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 20, 10 }, TextAttribute{}, 12, target };
+        buffer.WriteRun(L"Hello", TextAttribute{}, { 0, 0 });
+
+        const auto path = std::filesystem::temp_directory_path() / L"TextBufferSnapshotTests.bin";
+        auto removeFile = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+        TextBufferSnapshot::Save(buffer, path);
+
+        Log::Comment(L"A truncated snapshot is rejected instead of being read past its end.");
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+        VERIFY_THROWS(TextBufferSnapshot::Load(buffer, path), wil::ResultException);
+
+        Log::Comment(L"So is anything that isn't a snapshot.");
+        std::filesystem::resize_file(path, 4);
+        VERIFY_THROWS(TextBufferSnapshot::Load(buffer, path), wil::ResultException);
+    }
+};
@@ -49,6 +49,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(TestReorderWithNullGuids);
         TEST_METHOD(TestReorderingWithoutGuid);
         TEST_METHOD(TestLayeringNameOnlyProfiles);
+        TEST_METHOD(TestLayeringManyProfiles);
         TEST_METHOD(TestExplodingNameOnlyProfiles);
         TEST_METHOD(TestHideAllProfiles);
         TEST_METHOD(TestInvalidColorSchemeName);
@@ -87,6 +88,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(TestCloneInheritanceTree);
 
         TEST_METHOD(TestValidDefaults);
+        TEST_METHOD(TestDefaultsAreCopied);
 
         TEST_METHOD(TestInheritedCommand);
 
@@ -1103,6 +1105,56 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(L"NeitherShouldThisOne", settings->_allProfiles.GetAt(4).Name());
     }
 
+    void DeserializationTests::TestLayeringManyProfiles()
+    {
+        // Profiles are matched through an index of their GUIDs while the json is
+        // layered. Make sure it finds the same profiles the list used to, even
+        // for the profiles added in the same layer.
+
+        constexpr auto count = 100;
+        const auto makeProfiles = [](const int historySize, const bool reverse) {
+            Json::Value profiles{ Json::ValueType::arrayValue };
+            for (auto n = 0; n < count; ++n)
+            {
+                const auto i = reverse ? count - 1 - n : n;
+                Json::Value withGuid{ Json::ValueType::objectValue };
+                withGuid["guid"] = fmt::format("{{{:08x}-0000-49a3-80bd-e8fdd045185c}}", i);
+                withGuid["name"] = fmt::format("profile{}", i);
+                withGuid["historySize"] = historySize + i;
+                profiles.append(withGuid);
+
+                Json::Value nameOnly{ Json::ValueType::objectValue };
+                nameOnly["name"] = fmt::format("nameOnly{}", i);
+                nameOnly["historySize"] = historySize + i;
+                profiles.append(nameOnly);
+            }
+
+            Json::Value json{ Json::ValueType::objectValue };
+            json["profiles"] = profiles;
+            return json;
+        };
+
+        auto settings = winrt::make_self<implementation::CascadiaSettings>();
+        settings->LayerJson(makeProfiles(1000, false));
+        VERIFY_ARE_EQUAL(2u * count, settings->_allProfiles.Size());
+
+        // Nothing new is added when the same profiles are layered again, in any order.
+        settings->LayerJson(makeProfiles(2000, true));
+        VERIFY_ARE_EQUAL(2u * count, settings->_allProfiles.Size());
+        VERIFY_IS_FALSE(settings->_profileIndex.has_value());
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto withGuid{ settings->_allProfiles.GetAt(2 * i) };
+            VERIFY_ARE_EQUAL(winrt::to_hstring(fmt::format("profile{}", i)), withGuid.Name());
+            VERIFY_ARE_EQUAL(gsl::narrow_cast<int32_t>(2000 + i), withGuid.HistorySize());
+
+            const auto nameOnly{ settings->_allProfiles.GetAt(2 * i + 1) };
+            VERIFY_ARE_EQUAL(winrt::to_hstring(fmt::format("nameOnly{}", i)), nameOnly.Name());
+            VERIFY_ARE_EQUAL(gsl::narrow_cast<int32_t>(2000 + i), nameOnly.HistorySize());
+        }
+    }
+
     void DeserializationTests::TestExplodingNameOnlyProfiles()
     {
         // This is a test for GH#2782. When we add a name-only profile, we'll
@@ -2764,6 +2816,22 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(settings.AllProfiles().Size(), 2u);
     }
 
+    void DeserializationTests::TestDefaultsAreCopied()
+    {
+        // The defaults are only layered once. Every LoadDefaults call gets its own copy of them.
+
+        const auto settings{ CascadiaSettings::LoadDefaults() };
+        const auto name{ settings.AllProfiles().GetAt(0).Name() };
+        settings.AllProfiles().GetAt(0).Name(L"changed");
+        settings.GlobalSettings().InitialRows(12);
+
+        const auto other{ CascadiaSettings::LoadDefaults() };
+        VERIFY_ARE_EQUAL(name, other.AllProfiles().GetAt(0).Name());
+        VERIFY_ARE_NOT_EQUAL(12, other.GlobalSettings().InitialRows());
+        VERIFY_ARE_EQUAL(other.ActiveProfiles().Size(), other.AllProfiles().Size());
+        VERIFY_IS_TRUE(other.AllProfiles().GetAt(0).Origin() == OriginTag::InBox);
+    }
+
     void DeserializationTests::TestInheritedCommand()
     {
         // Test unbinding a command's key chord or name that originated in another layer.
@@ -38,6 +38,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(ManyKeysSameAction);
         TEST_METHOD(LayerKeybindings);
         TEST_METHOD(UnbindKeybindings);
+        TEST_METHOD(DispatchTableMatchesTheLayers);
 
         TEST_METHOD(TestArbitraryArgs);
         TEST_METHOD(TestSplitPaneArgs);
@@ -50,6 +51,7 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestToggleCommandPaletteArgs);
         TEST_METHOD(TestMoveTabArgs);
+        TEST_METHOD(TestFindInPanesArgs);
 
         TEST_METHOD(TestGetKeyBindingForAction);
 
@@ -180,6 +182,48 @@ namespace SettingsModelLocalTests
         VERIFY_IS_NULL(actionMap->GetActionByKeyChord({ KeyModifiers::Ctrl, static_cast<int32_t>('c') }));
     }
 
+    void KeyBindingsTests::DispatchTableMatchesTheLayers()
+    {
+        const std::string parentString{ R"([
+            { "command": "copy", "keys": ["ctrl+c"] },
+            { "command": "paste", "keys": ["ctrl+v"] },
+            { "command": "find", "keys": ["ctrl+f"] }
+        ])" };
+        const std::string childString{ R"([
+            { "command": "unbound", "keys": ["ctrl+v"] },
+            { "command": "paste", "keys": ["ctrl+shift+v"] }
+        ])" };
+        const std::string rebindString{ R"([ { "command": "closePane", "keys": ["ctrl+f"] } ])" };
+
+        auto parent = winrt::make_self<implementation::ActionMap>();
+        parent->LayerJson(VerifyParseSucceeded(parentString));
+        auto child = winrt::make_self<implementation::ActionMap>();
+        child->InsertParent(parent);
+        child->LayerJson(VerifyParseSucceeded(childString));
+
+        const KeyChord ctrlC{ true, false, false, static_cast<int32_t>('C') };
+        const KeyChord ctrlV{ true, false, false, static_cast<int32_t>('V') };
+        const KeyChord ctrlShiftV{ true, false, true, static_cast<int32_t>('V') };
+        const KeyChord ctrlF{ true, false, false, static_cast<int32_t>('F') };
+        const KeyChord ctrlAltF{ true, true, false, static_cast<int32_t>('F') };
+
+        Log::Comment(L"The flattened table answers like walking the layers does");
+        for (const auto& kc : { ctrlC, ctrlV, ctrlShiftV, ctrlF, ctrlAltF })
+        {
+            const auto expected = child->_GetActionByKeyChordInternal(kc).value_or(nullptr);
+            VERIFY_ARE_EQUAL(expected, child->GetActionByKeyChord(kc));
+        }
+        VERIFY_IS_TRUE(ShortcutAction::CopyText == child->GetActionByKeyChord(ctrlC).ActionAndArgs().Action());
+        VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlV));
+        VERIFY_IS_TRUE(ShortcutAction::PasteText == child->GetActionByKeyChord(ctrlShiftV).ActionAndArgs().Action());
+        VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlAltF));
+
+        Log::Comment(L"Adding an action rebuilds the table");
+        VERIFY_IS_TRUE(ShortcutAction::Find == child->GetActionByKeyChord(ctrlF).ActionAndArgs().Action());
+        child->LayerJson(VerifyParseSucceeded(rebindString));
+        VERIFY_IS_TRUE(ShortcutAction::ClosePane == child->GetActionByKeyChord(ctrlF).ActionAndArgs().Action());
+    }
+
     void KeyBindingsTests::TestArbitraryArgs()
     {
         const std::string bindings0String{ R"([
@@ -589,6 +633,52 @@ namespace SettingsModelLocalTests
         }
     }
 
+    void KeyBindingsTests::TestFindInPanesArgs()
+    {
+        const std::string bindings0String{ R"([
+            { "keys": ["up"], "command": { "action": "findInPanes", "query": "error" } },
+            { "keys": ["down"], "command": { "action": "findInPanes", "query": "Error", "caseSensitive": true, "scope": "window" } }
+        ])" };
+
+        const auto bindings0Json = VerifyParseSucceeded(bindings0String);
+
+        auto actionMap = winrt::make_self<implementation::ActionMap>();
+        VERIFY_IS_NOT_NULL(actionMap);
+        VERIFY_ARE_EQUAL(0u, actionMap->_KeyMap.size());
+        actionMap->LayerJson(bindings0Json);
+        VERIFY_ARE_EQUAL(2u, actionMap->_KeyMap.size());
+
+        {
+            KeyChord kc{ false, false, false, static_cast<int32_t>(VK_UP) };
+            auto actionAndArgs = ::TestUtils::GetActionAndArgs(*actionMap, kc);
+            VERIFY_ARE_EQUAL(ShortcutAction::FindInPanes, actionAndArgs.Action());
+            const auto& realArgs = actionAndArgs.Args().try_as<FindInPanesArgs>();
+            VERIFY_IS_NOT_NULL(realArgs);
+            // Verify the args have the expected value
+            VERIFY_ARE_EQUAL(L"error", realArgs.Query());
+            VERIFY_IS_FALSE(realArgs.CaseSensitive());
+            VERIFY_ARE_EQUAL(FindScope::Tab, realArgs.Scope());
+        }
+        {
+            KeyChord kc{ false, false, false, static_cast<int32_t>(VK_DOWN) };
+            auto actionAndArgs = ::TestUtils::GetActionAndArgs(*actionMap, kc);
+            VERIFY_ARE_EQUAL(ShortcutAction::FindInPanes, actionAndArgs.Action());
+            const auto& realArgs = actionAndArgs.Args().try_as<FindInPanesArgs>();
+            VERIFY_IS_NOT_NULL(realArgs);
+            // Verify the args have the expected value
+            VERIFY_ARE_EQUAL(L"Error", realArgs.Query());
+            VERIFY_IS_TRUE(realArgs.CaseSensitive());
+            VERIFY_ARE_EQUAL(FindScope::Window, realArgs.Scope());
+        }
+        {
+            // The query is required.
+            const std::string bindingsInvalidString{ R"([{ "keys": ["up"], "command": "findInPanes" }])" };
+            auto actionMapNoArgs = winrt::make_self<implementation::ActionMap>();
+            actionMapNoArgs->LayerJson(bindingsInvalidString);
+            VERIFY_ARE_EQUAL(0u, actionMapNoArgs->_KeyMap.size());
+        }
+    }
+
     void KeyBindingsTests::TestToggleCommandPaletteArgs()
     {
         const std::string bindings0String{ R"([
@@ -42,6 +42,8 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestLayerProfileOnColorScheme);
 
+        TEST_METHOD(TestResolvedProfileSettingsAreShared);
+
         TEST_CLASS_SETUP(ClassSetup)
         {
             return true;
@@ -554,4 +556,68 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(ARGB(0, 0x45, 0x67, 0x89), terminalSettings4->CursorColor()); // from profile (no color scheme)
         VERIFY_ARE_EQUAL(DEFAULT_CURSOR_COLOR, terminalSettings5->CursorColor()); // default
     }
+
+    void TerminalSettingsTests::TestResolvedProfileSettingsAreShared()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Ensure that panes of the same profile share the resolved profile settings, without sharing their own overrides."));
+
+        const std::string settingsString{ R"(
+        {
+            "defaultProfile": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+            "profiles": [
+                {
+                    "name" : "profile0",
+                    "guid": "{6239a42c-1111-49a3-80bd-e8fdd045185c}",
+                    "historySize": 1
+                },
+                {
+                    "name" : "profile1",
+                    "guid": "{6239a42c-2222-49a3-80bd-e8fdd045185c}",
+                    "historySize": 2
+                }
+            ]
+        })" };
+
+        const winrt::guid guid0{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-1111-49a3-80bd-e8fdd045185c}") };
+        const winrt::guid guid1{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-2222-49a3-80bd-e8fdd045185c}") };
+
+        CascadiaSettings settings{ til::u8u16(settingsString) };
+
+        const auto first{ TerminalSettings::CreateWithProfileByID(settings, guid0, nullptr).DefaultSettings() };
+        const auto second{ TerminalSettings::CreateWithProfileByID(settings, guid0, nullptr).DefaultSettings() };
+        const auto other{ TerminalSettings::CreateWithProfileByID(settings, guid1, nullptr).DefaultSettings() };
+
+        VERIFY_IS_TRUE(first != second);
+        VERIFY_IS_NOT_NULL(first.GetParent());
+        VERIFY_IS_TRUE(first.GetParent() == second.GetParent());
+        VERIFY_IS_TRUE(first.GetParent() != other.GetParent());
+        VERIFY_ARE_EQUAL(1, first.HistorySize());
+        VERIFY_ARE_EQUAL(2, other.HistorySize());
+
+        Log::Comment(L"Overrides on one pane's settings must not leak into the other panes of the profile");
+        first.HistorySize(10);
+        first.Commandline(L"foo.exe");
+        VERIFY_ARE_EQUAL(10, first.HistorySize());
+        VERIFY_ARE_EQUAL(1, second.HistorySize());
+        VERIFY_IS_TRUE(second.Commandline() != first.Commandline());
+
+        const auto withArgs{ TerminalSettings::CreateWithNewTerminalArgs(settings, nullptr, nullptr).DefaultSettings() };
+        VERIFY_IS_TRUE(first.GetParent() == withArgs.GetParent());
+        VERIFY_ARE_EQUAL(1, withArgs.HistorySize());
+
+        Log::Comment(L"A reloaded CascadiaSettings resolves its profiles again");
+        CascadiaSettings reloaded{ til::u8u16(settingsString) };
+        const auto afterReload{ TerminalSettings::CreateWithProfileByID(reloaded, guid0, nullptr).DefaultSettings() };
+        VERIFY_IS_TRUE(first.GetParent() != afterReload.GetParent());
+        VERIFY_ARE_EQUAL(1, afterReload.HistorySize());
+
+        Log::Comment(L"A copy of the settings (as edited by the settings UI) picks up changes to its profiles");
+        const auto copy{ settings.Copy() };
+        const auto before{ TerminalSettings::CreateWithProfileByID(copy, guid0, nullptr).DefaultSettings() };
+        VERIFY_ARE_EQUAL(1, before.HistorySize());
+        copy.FindProfile(guid0).HistorySize(5);
+        const auto after{ TerminalSettings::CreateWithProfileByID(copy, guid0, nullptr).DefaultSettings() };
+        VERIFY_ARE_EQUAL(5, after.HistorySize());
+    }
 }
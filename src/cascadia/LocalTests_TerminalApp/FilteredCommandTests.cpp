@@ -26,6 +26,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(VerifyWeight);
         TEST_METHOD(VerifyCompare);
         TEST_METHOD(VerifyCompareIgnoreCase);
+        TEST_METHOD(VerifyHighlightingFollowsRename);
     };
 
     void FilteredCommandTests::VerifyHighlighting()
@@ -229,4 +230,35 @@ namespace TerminalAppLocalTests
 
         VERIFY_SUCCEEDED(result);
     }
+
+    void FilteredCommandTests::VerifyHighlightingFollowsRename()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"Close Tab") };
+            const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+            filteredCommand->UpdateFilter(L"cta");
+
+            auto segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 4u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"C");
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(1).TextSegment(), L"lose ");
+            VERIFY_IS_FALSE(segments.GetAt(1).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(2).TextSegment(), L"Ta");
+            VERIFY_IS_TRUE(segments.GetAt(2).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(3).TextSegment(), L"b");
+            VERIFY_IS_FALSE(segments.GetAt(3).IsHighlighted());
+            VERIFY_IS_GREATER_THAN(filteredCommand->Weight(), 0);
+
+            Log::Comment(L"Renaming the item has to update the lowercase name it's matched against");
+            paletteItem.Name(L"Next Pane");
+            segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 1u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"Next Pane");
+            VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+            VERIFY_ARE_EQUAL(filteredCommand->Weight(), 0);
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
 }
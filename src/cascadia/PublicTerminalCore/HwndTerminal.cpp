@@ -220,7 +220,7 @@ HRESULT HwndTerminal::Initialize()
     RETURN_IF_FAILED(localPointerToThread->Initialize(_renderer.get()));
 
     auto dxEngine = std::make_unique<::Microsoft::Console::Render::DxEngine>();
-    RETURN_IF_FAILED(dxEngine->SetHwnd(_hwnd.get()));
+    RETURN_IF_FAILED(dxEngine->SetHwndForComposition(_hwnd.get()));
     RETURN_IF_FAILED(dxEngine->Enable());
     _renderer->AddRenderEngine(dxEngine.get());
 
@@ -326,7 +326,7 @@ IRawElementProviderSimple* HwndTerminal::_GetUiaProvider() noexcept
 {
     if (nullptr == _uiaProvider && !_uiaProviderInitialized)
     {
-        std::unique_lock<std::shared_mutex> lock;
+        std::unique_lock<::Microsoft::Terminal::Core::TerminalLock> lock;
         try
         {
 #pragma warning(suppress : 26441) // The lock is named, this appears to be a false positive
@@ -385,6 +385,34 @@ void HwndTerminal::SendOutput(std::wstring_view data)
     _terminal->Write(data);
 }
 
+// Method Description:
+// - Writes several chunks of UTF-8 output to the terminal, while taking the
+//   terminal's lock only once. Code points may be split across chunks, and
+//   across calls. The conversion buffers are kept around, so that writing a
+//   steady stream of output doesn't allocate.
+// Arguments:
+// - spans: the UTF-8 chunks to write, in order
+void HwndTerminal::SendOutput(const gsl::span<const TerminalUtf8Span> spans)
+{
+    const std::lock_guard guard{ _utf8OutputLock };
+
+    if (_utf16Chunks.size() < spans.size())
+    {
+        _utf16Chunks.resize(spans.size());
+    }
+
+    _utf16ChunkViews.clear();
+    for (size_t i = 0; i < spans.size(); ++i)
+    {
+        const auto& span = til::at(spans, i);
+        auto& chunk = til::at(_utf16Chunks, i);
+        THROW_IF_FAILED(til::u8u16(std::string_view{ span.Data, span.Length }, chunk, _utf8State));
+        _utf16ChunkViews.emplace_back(chunk);
+    }
+
+    _terminal->Write(_utf16ChunkViews);
+}
+
 HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal)
 {
     // In order for UIA to hook up properly there needs to be a "static" window hosting the
@@ -433,6 +461,20 @@ void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data)
     publicTerminal->SendOutput(data);
 }
 
+/// <summary>
+/// Writes UTF-8 output to the terminal without marshaling it into a UTF-16 string first.
+/// </summary>
+/// <param name="terminal">Terminal pointer.</param>
+/// <param name="spans">The chunks of output to write, in order. Code points may be split across chunks.</param>
+/// <param name="count">The number of chunks.</param>
+void _stdcall TerminalSendOutputUtf8(void* terminal, const TerminalUtf8Span* spans, size_t count)
+try
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->SendOutput(gsl::make_span(spans, count));
+}
+CATCH_LOG()
+
 /// <summary>
 /// Triggers a terminal resize using the new width and height in pixel.
 /// </summary>
@@ -633,16 +675,9 @@ const wchar_t* _stdcall TerminalGetSelection(void* terminal)
 {
     auto publicTerminal = static_cast<HwndTerminal*>(terminal);
 
-    const auto bufferData = publicTerminal->_terminal->RetrieveSelectedTextFromBuffer(false);
+    const auto selectedText = publicTerminal->_terminal->RetrieveSelectedPlainTextFromBuffer(false);
     publicTerminal->_ClearSelection();
 
-    // convert text: vector<string> --> string
-    std::wstring selectedText;
-    for (const auto& text : bufferData.text)
-    {
-        selectedText += text;
-    }
-
     auto returnText = wil::make_cotaskmem_string_nothrow(selectedText.c_str());
     return returnText.release();
 }
@@ -23,9 +23,17 @@ typedef struct _TerminalTheme
     COLORREF ColorTable[16];
 } TerminalTheme, *LPTerminalTheme;
 
+// Keep in sync with NativeMethods.cs
+typedef struct _TerminalUtf8Span
+{
+    const char* Data;
+    size_t Length;
+} TerminalUtf8Span, *LPTerminalUtf8Span;
+
 extern "C" {
 __declspec(dllexport) HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal);
 __declspec(dllexport) void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data);
+__declspec(dllexport) void _stdcall TerminalSendOutputUtf8(void* terminal, const TerminalUtf8Span* spans, size_t count);
 __declspec(dllexport) void _stdcall TerminalRegisterScrollCallback(void* terminal, void __stdcall callback(int, int, int));
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResize(_In_ void* terminal, _In_ short width, _In_ short height, _Out_ COORD* dimensions);
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResizeWithDimension(_In_ void* terminal, _In_ COORD dimensions, _Out_ SIZE* dimensionsInPixels);
@@ -60,6 +68,7 @@ public:
     HRESULT Initialize();
     void Teardown() noexcept;
     void SendOutput(std::wstring_view data);
+    void SendOutput(const gsl::span<const TerminalUtf8Span> spans);
     HRESULT Refresh(const SIZE windowSize, _Out_ COORD* dimensions);
     void RegisterScrollCallback(std::function<void(int, int, int)> callback);
     void RegisterWriteCallback(const void _stdcall callback(wchar_t*));
@@ -82,6 +91,12 @@ private:
     std::unique_ptr<::Microsoft::Console::Render::Renderer> _renderer;
     std::unique_ptr<::Microsoft::Console::Render::DxEngine> _renderEngine;
 
+    // UTF-8 output is converted into these buffers, which are reused for every call. See SendOutput.
+    std::mutex _utf8OutputLock;
+    til::u8state _utf8State;
+    std::vector<std::wstring> _utf16Chunks;
+    std::vector<std::wstring_view> _utf16ChunkViews;
+
     bool _focused{ false };
 
     std::chrono::milliseconds _multiClickTime;
@@ -77,7 +77,13 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             peasant.WindowActivated({ this, &Monarch::_peasantWindowActivated });
             peasant.IdentifyWindowsRequested({ this, &Monarch::_identifyWindows });
             peasant.RenameRequested({ this, &Monarch::_renameRequested });
+            peasant.WindowNameChanged([this, newPeasantsId](auto&& /*sender*/, const winrt::hstring& name) {
+                _peasantNames[newPeasantsId] = name;
+            });
 
+            // A peasant that was moved over from an older monarch might
+            // already have a name. Any later changes are pushed to us.
+            _peasantNames[newPeasantsId] = peasant.WindowName();
             _peasants[newPeasantsId] = peasant;
 
             TraceLoggingWrite(g_hRemotingProvider,
@@ -141,20 +147,33 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         catch (...)
         {
             LOG_CAUGHT_EXCEPTION();
-            // Remove the peasant from the list of peasants
-            _peasants.erase(peasantID);
-
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(peasantID);
+            _removePeasant(peasantID);
             return nullptr;
         }
     }
 
+    // Method Description:
+    // - Forget everything we know about the given peasant, because it died.
+    // Arguments:
+    // - peasantID: The ID of the peasant to remove
+    // Return Value:
+    // - <none>
+    void Monarch::_removePeasant(const uint64_t peasantID)
+    {
+        // Remove the peasant from the list of peasants
+        _peasants.erase(peasantID);
+        _peasantNames.erase(peasantID);
+
+        // Remove the peasant from the list of MRU windows. They're dead.
+        // They can't be the MRU anymore.
+        _clearOldMruEntries(peasantID);
+    }
+
     // Method Description:
     // - Find the ID of the peasant with the given name. If no such peasant
-    //   exists, then we'll return 0. If we encounter any peasants who have died
-    //   during this process, then we'll remove them from the set of _peasants
+    //   exists, then we'll return 0. The names are looked up in our own copy
+    //   of them, so only the peasant with that name is called, to make sure
+    //   it's still alive. If it died, we'll remove it and return 0.
     // Arguments:
     // - name: The window name to look for
     // Return Value:
@@ -167,41 +186,17 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             return 0;
         }
 
-        std::vector<uint64_t> peasantsToErase{};
-        uint64_t result = 0;
-        for (const auto& [id, p] : _peasants)
+        const auto match = std::find_if(_peasantNames.begin(), _peasantNames.end(), [&](const auto& idAndName) {
+            return idAndName.second == name;
+        });
+        if (match == _peasantNames.end())
         {
-            try
-            {
-                auto otherName = p.WindowName();
-                if (otherName == name)
-                {
-                    result = id;
-                    break;
-                }
-            }
-            catch (...)
-            {
-                LOG_CAUGHT_EXCEPTION();
-                // Normally, we'd just erase the peasant here. However, we can't
-                // erase from the map while we're iterating over it like this.
-                // Instead, pull a good ole Java and collect this id for removal
-                // later.
-                peasantsToErase.push_back(id);
-            }
-        }
-
-        // Remove the dead peasants we came across while iterating.
-        for (const auto& id : peasantsToErase)
-        {
-            // Remove the peasant from the list of peasants
-            _peasants.erase(id);
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(id);
+            return 0;
         }
 
-        return result;
+        // _getPeasant will remove the peasant if it died.
+        const auto result = match->first;
+        return _getPeasant(result) ? result : 0;
     }
 
     // Method Description:
@@ -387,7 +382,8 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
                 continue;
             }
 
-            if (ignoreQuakeWindow && peasant.WindowName() == QuakeWindowName)
+            const auto peasantName = _peasantNames.find(mruWindowArgs.PeasantID());
+            if (ignoreQuakeWindow && peasantName != _peasantNames.end() && peasantName->second == QuakeWindowName)
             {
                 // The _quake window should never be treated as the MRU window.
                 // Skip it if we see it. Users can still target it with `wt -w
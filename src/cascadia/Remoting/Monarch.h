@@ -7,29 +7,7 @@
 #include "Peasant.h"
 #include "../cascadia/inc/cppwinrt_utils.h"
 #include "WindowActivatedArgs.h"
-
-// We sure different GUIDs here depending on whether we're running a Release,
-// Preview, or Dev build. This ensures that different installs don't
-// accidentally talk to one another.
-//
-// * Release: {06171993-7eb1-4f3e-85f5-8bdd7386cce3}
-// * Preview: {04221993-7eb1-4f3e-85f5-8bdd7386cce3}
-// * Dev:     {08302020-7eb1-4f3e-85f5-8bdd7386cce3}
-constexpr GUID Monarch_clsid
-{
-#if defined(WT_BRANDING_RELEASE)
-    0x06171993,
-#elif defined(WT_BRANDING_PREVIEW)
-    0x04221993,
-#else
-    0x08302020,
-#endif
-        0x7eb1,
-        0x4f3e,
-    {
-        0x85, 0xf5, 0x8b, 0xdd, 0x73, 0x86, 0xcc, 0xe3
-    }
-};
+#include "../cascadia/inc/MonarchClsid.h"
 
 namespace RemotingUnitTests
 {
@@ -63,10 +41,14 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         winrt::com_ptr<IVirtualDesktopManager> _desktopManager{ nullptr };
 
         std::unordered_map<uint64_t, winrt::Microsoft::Terminal::Remoting::IPeasant> _peasants;
+        // The names of the peasants, as they told us. This way looking up a
+        // window by name doesn't need to call into every peasant's process.
+        std::unordered_map<uint64_t, winrt::hstring> _peasantNames;
 
         std::vector<Remoting::WindowActivatedArgs> _mruPeasants;
 
         winrt::Microsoft::Terminal::Remoting::IPeasant _getPeasant(uint64_t peasantID);
+        void _removePeasant(const uint64_t peasantID);
         uint64_t _getMostRecentPeasantID(bool limitToCurrentDesktop, const bool ignoreQuakeWindow);
         uint64_t _lookupPeasantIdForName(std::wstring_view name);
 
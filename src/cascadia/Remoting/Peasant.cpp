@@ -120,6 +120,40 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         return _lastActivatedArgs;
     }
 
+    winrt::hstring Peasant::WindowName() const
+    {
+        return _WindowName;
+    }
+
+    // Method Description:
+    // - Sets the name of this window. The monarch keeps a copy of the names of
+    //   all windows, so it can look them up without asking every peasant, so
+    //   we'll raise a WindowNameChanged event to let it know about the new name.
+    // Arguments:
+    // - name: the new name of this window
+    // Return Value:
+    // - <none>
+    void Peasant::WindowName(const winrt::hstring& name)
+    {
+        if (name == _WindowName)
+        {
+            return;
+        }
+
+        _WindowName = name;
+        try
+        {
+            // The monarch might have died. If they have, this will throw an
+            // exception. Just eat it, the new monarch will ask us for our name
+            // once we've been added to it.
+            _WindowNameChangedHandlers(*this, name);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+        }
+    }
+
     // Method Description:
     // - Summon this peasant to become the active window. Currently, it just
     //   causes the peasant to become the active window wherever the window
@@ -204,7 +238,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             _RenameRequestedHandlers(*this, args);
             if (args.Succeeded())
             {
-                _WindowName = args.NewName();
+                WindowName(args.NewName());
             }
             successfullyNotified = true;
         }
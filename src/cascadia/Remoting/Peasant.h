@@ -32,7 +32,9 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         winrt::Microsoft::Terminal::Remoting::WindowActivatedArgs GetLastActivatedArgs();
 
         winrt::Microsoft::Terminal::Remoting::CommandlineArgs InitialArgs();
-        WINRT_PROPERTY(winrt::hstring, WindowName);
+
+        winrt::hstring WindowName() const;
+        void WindowName(const winrt::hstring& name);
 
         TYPED_EVENT(WindowActivated, winrt::Windows::Foundation::IInspectable, winrt::Microsoft::Terminal::Remoting::WindowActivatedArgs);
         TYPED_EVENT(ExecuteCommandlineRequested, winrt::Windows::Foundation::IInspectable, winrt::Microsoft::Terminal::Remoting::CommandlineArgs);
@@ -40,12 +42,14 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         TYPED_EVENT(DisplayWindowIdRequested, winrt::Windows::Foundation::IInspectable, winrt::Windows::Foundation::IInspectable);
         TYPED_EVENT(RenameRequested, winrt::Windows::Foundation::IInspectable, winrt::Microsoft::Terminal::Remoting::RenameRequestArgs);
         TYPED_EVENT(SummonRequested, winrt::Windows::Foundation::IInspectable, winrt::Microsoft::Terminal::Remoting::SummonWindowBehavior);
+        TYPED_EVENT(WindowNameChanged, winrt::Windows::Foundation::IInspectable, winrt::hstring);
 
     private:
         Peasant(const uint64_t testPID);
         uint64_t _ourPID;
 
         uint64_t _id{ 0 };
+        winrt::hstring _WindowName;
 
         winrt::Microsoft::Terminal::Remoting::CommandlineArgs _initialArgs{ nullptr };
         winrt::Microsoft::Terminal::Remoting::WindowActivatedArgs _lastActivatedArgs{ nullptr };
@@ -4,6 +4,7 @@
 #include "pch.h"
 #include "OpenTerminalHere.h"
 #include "../WinRTUtils/inc/WtExeUtils.h"
+#include "../inc/MonarchClsid.h"
 #include <ShlObj.h>
 
 // TODO GH#6112: Localize these strings
@@ -18,6 +19,8 @@ static constexpr std::wstring_view VerbName{ L"WindowsTerminalOpenHere" };
 // Method Description:
 // - This method is called when the user activates the context menu item. We'll
 //   launch the Terminal using the current working directory.
+// - If a Terminal is already running, the commandline is handed straight to it
+//   and we only start a new process when it asks for a new window.
 // Arguments:
 // - psiItemArray: a IShellItemArray which contains the item that's selected.
 // Return Value:
@@ -26,6 +29,7 @@ static constexpr std::wstring_view VerbName{ L"WindowsTerminalOpenHere" };
 HRESULT OpenTerminalHere::Invoke(IShellItemArray* psiItemArray,
                                  IBindCtx* /*pBindContext*/)
 {
+    const auto invokeStart = std::chrono::steady_clock::now();
     wil::unique_cotaskmem_string pszName;
 
     if (psiItemArray == nullptr)
@@ -50,13 +54,18 @@ HRESULT OpenTerminalHere::Invoke(IShellItemArray* psiItemArray,
         RETURN_IF_FAILED(psi->GetDisplayName(SIGDN_FILESYSPATH, &pszName));
     }
 
+    const auto exePath{ GetWtExePath() };
+    // Append a "\." to the given path, so that this will work in "C:\"
+    const auto startingDirectory{ wil::str_printf<std::wstring>(LR"-(%s\.)-", pszName.get()) };
+
+    const auto handedOff = _TryHandOffToMonarch(exePath, startingDirectory);
+    if (!handedOff)
     {
         wil::unique_process_information _piClient;
         STARTUPINFOEX siEx{ 0 };
         siEx.StartupInfo.cb = sizeof(STARTUPINFOEX);
 
-        // Append a "\." to the given path, so that this will work in "C:\"
-        auto cmdline{ wil::str_printf<std::wstring>(LR"-("%s" -d "%s\.")-", GetWtExePath().c_str(), pszName.get()) };
+        auto cmdline{ wil::str_printf<std::wstring>(LR"-("%s" -d "%s")-", exePath.c_str(), startingDirectory.c_str()) };
         RETURN_IF_WIN32_BOOL_FALSE(CreateProcessW(
             nullptr,
             cmdline.data(),
@@ -71,9 +80,60 @@ HRESULT OpenTerminalHere::Invoke(IShellItemArray* psiItemArray,
             ));
     }
 
+    // This measures how long Explorer waits on us. For a hand-off, the tab has
+    // already been opened by then; otherwise the new process is just starting.
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - invokeStart);
+    TraceLoggingWrite(g_hShellExtensionProvider,
+                      "ShellExtension_OpenTerminalHere",
+                      TraceLoggingBool(handedOff, "handedOff", "true if a running Terminal took the commandline"),
+                      TraceLoggingInt64(duration.count(), "durationUs", "Time from the invocation until the Terminal took the commandline or was started"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
     return S_OK;
 }
 
+// Method Description:
+// - Proposes `wt -d <startingDirectory>` to the monarch of a running Terminal,
+//   exactly like a new `wt` process would, but without starting one first.
+// - The monarch class is only registered while a Terminal is running, so when
+//   there isn't one, the activation fails right away rather than starting it.
+// Arguments:
+// - exePath: the `wt` executable the commandline would have started.
+// - startingDirectory: the directory to open the Terminal in.
+// Return Value:
+// - true if a running window took the commandline. false if a new Terminal
+//   process needs to be started, either because none is running or because
+//   the monarch asked for a new window.
+bool OpenTerminalHere::_TryHandOffToMonarch(const std::wstring& exePath, const std::wstring& startingDirectory) const noexcept
+try
+{
+    using namespace winrt::Microsoft::Terminal::Remoting;
+
+    const auto monarch{ winrt::try_create_instance<Monarch>(Monarch_clsid, CLSCTX_LOCAL_SERVER) };
+    if (!monarch)
+    {
+        return false;
+    }
+
+    // The commandline is run by a window in another process. Explorer gave us
+    // the right to take the foreground, so pass it along. If we don't have it,
+    // this fails and the window just won't be brought forward.
+    AllowSetForegroundWindow(ASFW_ANY);
+
+    const std::array<winrt::hstring, 3> args{ winrt::hstring{ exePath }, L"-d", winrt::hstring{ startingDirectory } };
+    const CommandlineArgs eventArgs{ args, winrt::hstring{ startingDirectory } };
+    const auto result = monarch.ProposeCommandline(eventArgs);
+    return !result.ShouldCreateWindow();
+}
+catch (...)
+{
+    // The monarch may have gone away under us. Starting a new process will
+    // elect a new one.
+    LOG_CAUGHT_EXCEPTION();
+    return false;
+}
+
 HRESULT OpenTerminalHere::GetToolTip(IShellItemArray* /*psiItemArray*/,
                                      LPWSTR* ppszInfoTip)
 {
@@ -56,6 +56,7 @@ struct
 
 private:
     std::wstring _GetPathFromExplorer() const;
+    bool _TryHandOffToMonarch(const std::wstring& exePath, const std::wstring& startingDirectory) const noexcept;
 };
 
 CoCreatableClass(OpenTerminalHere);
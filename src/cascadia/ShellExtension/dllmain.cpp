@@ -6,6 +6,15 @@
 
 using namespace Microsoft::WRL;
 
+// Note: Generate GUID using TlgGuid.exe tool
+#pragma warning(suppress : 26477) // One of the macros uses 0/NULL. We don't have control to make it nullptr.
+TRACELOGGING_DEFINE_PROVIDER(
+    g_hShellExtensionProvider,
+    "Microsoft.Windows.Terminal.ShellExtension",
+    // {0c84dd43-0f98-5d54-c1b4-88a62f408376}
+    (0x0c84dd43, 0x0f98, 0x5d54, 0xc1, 0xb4, 0x88, 0xa6, 0x2f, 0x40, 0x83, 0x76),
+    TraceLoggingOptionMicrosoftTelemetry());
+
 STDAPI DllCanUnloadNow()
 {
     return Module<InProc>::GetModule().Terminate() ? S_OK : S_FALSE;
@@ -27,6 +36,14 @@ DllMain(_In_opt_ HINSTANCE hinst, DWORD reason, _In_opt_ void*)
     if (reason == DLL_PROCESS_ATTACH)
     {
         DisableThreadLibraryCalls(hinst);
+        TraceLoggingRegister(g_hShellExtensionProvider);
+    }
+    else if (reason == DLL_PROCESS_DETACH)
+    {
+        if (g_hShellExtensionProvider)
+        {
+            TraceLoggingUnregister(g_hShellExtensionProvider);
+        }
     }
     return TRUE;
 }
@@ -26,8 +26,15 @@
 #include <winrt/Windows.Foundation.h>
 #include <winrt/Windows.ApplicationModel.h>
 
+#include <winrt/Microsoft.Terminal.Remoting.h>
+
 #include <Shobjidl.h>
 #include <shlwapi.h>
 
 #include <wrl.h>
 #include <wrl/module.h>
+
+// Including TraceLogging essentials for the binary
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+TRACELOGGING_DECLARE_PROVIDER(g_hShellExtensionProvider);
@@ -74,9 +74,10 @@ namespace winrt::TerminalApp::implementation
             const auto& controlSettings{ activeControl.Settings().as<TerminalSettings>() };
 
             // Get the control's root settings, the ones that we actually
-            // assigned to it.
+            // assigned to it. Their own parent is the resolved profile
+            // settings, which are shared with every other pane of the profile.
             auto parentSettings{ controlSettings.GetParent() };
-            while (parentSettings.GetParent() != nullptr)
+            while (parentSettings.GetParent() != nullptr && parentSettings.GetParent().GetParent() != nullptr)
             {
                 parentSettings = parentSettings.GetParent();
             }
@@ -123,9 +124,11 @@ namespace winrt::TerminalApp::implementation
                 // this while you're currently previewing a SetColorScheme
                 // action, then the parent of the control's settings is _the
                 // last preview TerminalSettings we inserted! We don't want
-                // to save that one!
+                // to save that one! Stop right below the resolved profile
+                // settings though, those are shared by all the panes of the
+                // profile.
                 _originalSettings = controlSettings.GetParent();
-                while (_originalSettings.GetParent() != nullptr)
+                while (_originalSettings.GetParent() != nullptr && _originalSettings.GetParent().GetParent() != nullptr)
                 {
                     _originalSettings = _originalSettings.GetParent();
                 }
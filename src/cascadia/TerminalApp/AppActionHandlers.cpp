@@ -815,4 +815,17 @@ namespace winrt::TerminalApp::implementation
             }
         }
     }
+
+    void TerminalPage::_HandleFindInPanes(const IInspectable& /*sender*/,
+                                          const ActionEventArgs& args)
+    {
+        if (args)
+        {
+            if (const auto& realArgs = args.ActionArgs().try_as<FindInPanesArgs>())
+            {
+                _FindInPanes(realArgs.Query(), realArgs.CaseSensitive(), realArgs.Scope());
+                args.Handled(true);
+            }
+        }
+    }
 }
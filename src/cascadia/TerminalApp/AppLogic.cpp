@@ -290,6 +290,11 @@ namespace winrt::TerminalApp::implementation
             // in focus nor fullscreen mode. So "Toggle" here will always work
             // to "enable".
             const auto launchMode = this->GetLaunchMode();
+
+            // Nobody can open the jumplist before the window is up anyways,
+            // so it's updated only after the first tabs were created.
+            Jumplist::UpdateJumplist(_settings);
+
             if (IsQuakeWindow())
             {
                 _root->ToggleFocusMode();
@@ -846,7 +851,8 @@ namespace winrt::TerminalApp::implementation
         // Register for directory change notification.
         _RegisterSettingsChange();
 
-        Jumplist::UpdateJumplist(_settings);
+        // The jumplist isn't updated here, but once the window is initialized,
+        // so that it doesn't compete with the first frame. See Create().
     }
 
     // Method Description:
@@ -1141,6 +1147,21 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Called by the host when the window was hidden from or shown to the
+    //   user, see TerminalPage::WindowVisibilityChanged.
+    // Arguments:
+    // - showOrHide: true if the window is visible
+    // Return Value:
+    // - <none>
+    void AppLogic::WindowVisibilityChanged(const bool showOrHide)
+    {
+        if (_root)
+        {
+            _root->WindowVisibilityChanged(showOrHide);
+        }
+    }
+
     // Method Description:
     // - Gets the taskbar state value from the last active control
     // Return Value:
@@ -86,6 +86,7 @@ namespace winrt::TerminalApp::implementation
         bool OnDirectKeyEvent(const uint32_t vkey, const uint8_t scanCode, const bool down);
 
         void WindowCloseButtonClicked();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         size_t GetLastActiveControlTaskbarState();
         size_t GetLastActiveControlTaskbarProgress();
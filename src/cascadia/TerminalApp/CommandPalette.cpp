@@ -613,6 +613,7 @@ namespace winrt::TerminalApp::implementation
                     _nestedActionStack.Append(filteredCommand);
                     ParentCommandName(actionPaletteItem.Command().Name());
                     _currentNestedCommands.Clear();
+                    _lastFilterMatches.reset();
                     for (const auto& nameAndCommand : actionPaletteItem.Command().NestedCommands())
                     {
                         const auto action = nameAndCommand.Value();
@@ -871,6 +872,7 @@ namespace winrt::TerminalApp::implementation
     void CommandPalette::SetCommands(Collections::IVector<Command> const& actions)
     {
         _allCommands.Clear();
+        _lastFilterMatches.reset();
         for (const auto& action : actions)
         {
             auto actionPaletteItem{ winrt::make<winrt::TerminalApp::implementation::ActionPaletteItem>(action) };
@@ -1001,7 +1003,8 @@ namespace winrt::TerminalApp::implementation
     {
         std::vector<winrt::TerminalApp::FilteredCommand> actions;
 
-        winrt::hstring searchText{ _getTrimmedInput() };
+        const auto trimmedInput{ _getTrimmedInput() };
+        winrt::hstring searchText{ trimmedInput };
 
         auto commandsToFilter = _commandsToFilter();
 
@@ -1011,7 +1014,27 @@ namespace winrt::TerminalApp::implementation
         }
         else if (_currentMode == CommandPaletteMode::TabSearchMode || _currentMode == CommandPaletteMode::ActionMode || _currentMode == CommandPaletteMode::CommandlineMode)
         {
-            for (const auto& action : commandsToFilter)
+            // Every character of the search text has to be found in a command's
+            // name for it to match, so when the user keeps typing, only the
+            // commands that matched so far can still match. The commands of
+            // the action mode only change along with the search text being
+            // cleared, unlike the names of tabs for instance, so that's the
+            // only mode where the previous matches are reused.
+            std::vector<winrt::TerminalApp::FilteredCommand> candidates;
+            if (_currentMode == CommandPaletteMode::ActionMode &&
+                _lastFilterMatches &&
+                _lastFilterMatches->source == commandsToFilter &&
+                !_lastFilterMatches->searchText.empty() &&
+                til::starts_with(trimmedInput, _lastFilterMatches->searchText))
+            {
+                candidates = std::move(_lastFilterMatches->commands);
+            }
+            else
+            {
+                std::copy(begin(commandsToFilter), end(commandsToFilter), std::back_inserter(candidates));
+            }
+
+            for (const auto& action : candidates)
             {
                 // Update filter for all commands
                 // This will modify the highlighting but will also lead to re-computation of weight (and consequently sorting).
@@ -1024,6 +1047,11 @@ namespace winrt::TerminalApp::implementation
                     actions.push_back(action);
                 }
             }
+
+            if (_currentMode == CommandPaletteMode::ActionMode)
+            {
+                _lastFilterMatches = FilterMatches{ commandsToFilter, trimmedInput, actions };
+            }
         }
 
         // We want to present the commands sorted
@@ -1048,6 +1076,23 @@ namespace winrt::TerminalApp::implementation
 
         // Make _filteredActions look identical to actions, using only Insert and Remove.
         // This allows WinUI to nicely animate the ListView as it changes.
+        // While the user is typing, most of the changes are commands that don't
+        // match anymore. Those are removed first, so that the loop below only
+        // has to deal with the commands that were reordered or added.
+        std::unordered_set<void*> remainingItems;
+        remainingItems.reserve(actions.size());
+        for (const auto& action : actions)
+        {
+            remainingItems.emplace(winrt::get_abi(action.Item()));
+        }
+        for (auto i = _filteredActions.Size(); i-- > 0;)
+        {
+            if (remainingItems.find(winrt::get_abi(_filteredActions.GetAt(i).Item())) == remainingItems.end())
+            {
+                _filteredActions.RemoveAt(i);
+            }
+        }
+
         for (uint32_t i = 0; i < _filteredActions.Size() && i < actions.size(); i++)
         {
             for (uint32_t j = i; j < _filteredActions.Size(); j++)
@@ -70,6 +70,16 @@ namespace winrt::TerminalApp::implementation
 
         Windows::Foundation::Collections::IVector<winrt::TerminalApp::FilteredCommand> _commandsToFilter();
 
+        // The commands that matched the search text, the last time the actions
+        // were filtered in the action mode. See _collectFilteredActions.
+        struct FilterMatches
+        {
+            Windows::Foundation::Collections::IVector<winrt::TerminalApp::FilteredCommand> source{ nullptr };
+            std::wstring searchText;
+            std::vector<winrt::TerminalApp::FilteredCommand> commands;
+        };
+        std::optional<FilterMatches> _lastFilterMatches;
+
         bool _lastFilterTextWasEmpty{ true };
 
         void _filterTextChanged(Windows::Foundation::IInspectable const& sender,
@@ -3,9 +3,11 @@
 
 #include "pch.h"
 #include "DebugTapConnection.h"
+#include "../inc/DebugCapture.h"
 
 using namespace ::winrt::Microsoft::Terminal::TerminalConnection;
 using namespace ::winrt::Windows::Foundation;
+using namespace ::Microsoft::Terminal::DebugCapture;
 namespace winrt::Microsoft::TerminalApp::implementation
 {
     // DebugInputTapConnection is an implementation detail of DebugTapConnection.
@@ -109,6 +111,174 @@ namespace winrt::Microsoft::TerminalApp::implementation
     {
         _inputSide = inputTap;
     }
+
+    // DebugCaptureWriter writes the records of a capture (see DebugCapture.h)
+    // into a file of a fixed size. The current segment is collected in memory
+    // and only written out once it's full, so that capturing a connection
+    // costs little more than a copy of what goes through it.
+    class DebugCaptureWriter
+    {
+    public:
+        // 64 segments of 1 MiB each keep the last 64 MiB of a session.
+        static constexpr uint16_t SegmentCount = 64;
+        static constexpr uint32_t SegmentSize = 1024 * 1024;
+
+        explicit DebugCaptureWriter(const std::filesystem::path& path) :
+            _file{ CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) }
+        {
+            THROW_LAST_ERROR_IF(!_file);
+
+            LARGE_INTEGER frequency{};
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&_start);
+
+            FileHeader header{};
+            header.magic = Magic;
+            header.version = Version;
+            header.segmentCount = SegmentCount;
+            header.segmentSize = SegmentSize;
+            header.ticksPerSecond = frequency.QuadPart;
+            _Write(0, &header, sizeof(header));
+
+            _segment.reserve(SegmentSize);
+            _StartSegment();
+        }
+
+        ~DebugCaptureWriter()
+        {
+            try
+            {
+                Flush();
+            }
+            CATCH_LOG();
+        }
+
+        // Appends a record with the given text, splitting it up into multiple
+        // records if it doesn't fit into the rest of the current segment.
+        void Append(const RecordKind kind, std::wstring_view text) noexcept
+        try
+        {
+            LARGE_INTEGER now{};
+            QueryPerformanceCounter(&now);
+
+            std::lock_guard guard{ _lock };
+            while (!text.empty())
+            {
+                auto available = (SegmentSize - _segment.size()) / sizeof(wchar_t);
+                if (available <= sizeof(RecordHeader) / sizeof(wchar_t))
+                {
+                    _WriteSegment();
+                    _StartSegment();
+                    available = (SegmentSize - _segment.size()) / sizeof(wchar_t);
+                }
+
+                const auto piece = text.substr(0, available - sizeof(RecordHeader) / sizeof(wchar_t));
+                RecordHeader record{};
+                record.timestamp = now.QuadPart - _start.QuadPart;
+                record.length = gsl::narrow<uint32_t>(piece.size() * sizeof(wchar_t));
+                record.kind = static_cast<uint8_t>(kind);
+                _Append(&record, sizeof(record));
+                _Append(piece.data(), piece.size() * sizeof(wchar_t));
+                text = text.substr(piece.size());
+            }
+        }
+        CATCH_LOG()
+
+        // Writes out the current segment as far as it's filled.
+        void Flush()
+        {
+            std::lock_guard guard{ _lock };
+            _WriteSegment();
+        }
+
+    private:
+        void _StartSegment()
+        {
+            ++_sequence;
+            _segment.resize(sizeof(SegmentHeader));
+        }
+
+        void _Append(const void* data, const size_t length)
+        {
+            const auto bytes = static_cast<const std::byte*>(data);
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+            _segment.insert(_segment.end(), bytes, bytes + length);
+        }
+
+        // Writes the current segment into its slot in the ring of segments.
+        // Once it's full, the next one goes into the slot after it, which is
+        // the oldest one once the ring has been filled.
+        void _WriteSegment()
+        {
+            SegmentHeader header{};
+            header.sequence = _sequence;
+            header.used = gsl::narrow<uint32_t>(_segment.size() - sizeof(header));
+            memcpy(_segment.data(), &header, sizeof(header));
+
+            const auto slot = (_sequence - 1) % SegmentCount;
+            _Write(sizeof(FileHeader) + slot * SegmentSize, _segment.data(), _segment.size());
+        }
+
+        void _Write(const uint64_t offset, const void* data, const size_t length)
+        {
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD written = 0;
+            THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), data, gsl::narrow<DWORD>(length), &written, &overlapped));
+            THROW_HR_IF(E_UNEXPECTED, written != length);
+        }
+
+        wil::unique_hfile _file;
+        std::mutex _lock;
+        std::vector<std::byte> _segment;
+        uint64_t _sequence{ 0 };
+        LARGE_INTEGER _start{};
+    };
+
+    // DebugCaptureConnection wraps a connection and records all of its
+    // output and input into a capture file, without changing either.
+    // Unlike the DebugTapConnection, it doesn't format anything or feed it
+    // into another terminal, so it can be left on while measuring.
+    class DebugCaptureConnection : public winrt::implements<DebugCaptureConnection, ITerminalConnection>
+    {
+    public:
+        DebugCaptureConnection(ITerminalConnection wrappedConnection, const std::filesystem::path& path) :
+            _writer{ path },
+            _wrappedConnection{ std::move(wrappedConnection) }
+        {
+            _outputRevoker = _wrappedConnection.TerminalOutput(winrt::auto_revoke, [this](const hstring& str) {
+                _writer.Append(RecordKind::Output, str);
+            });
+        }
+        ~DebugCaptureConnection() = default;
+        void Start()
+        {
+            _wrappedConnection.Start();
+        }
+        void WriteInput(hstring const& data)
+        {
+            _writer.Append(RecordKind::Input, data);
+            _wrappedConnection.WriteInput(data);
+        }
+        void Resize(uint32_t rows, uint32_t columns) { _wrappedConnection.Resize(rows, columns); }
+        void Close()
+        {
+            _wrappedConnection.Close();
+            _outputRevoker.revoke();
+            LOG_IF_FAILED(wil::ResultFromException([&]() { _writer.Flush(); }));
+        }
+        winrt::event_token TerminalOutput(TerminalOutputHandler const& args) { return _wrappedConnection.TerminalOutput(args); };
+        void TerminalOutput(winrt::event_token const& token) noexcept { _wrappedConnection.TerminalOutput(token); };
+        winrt::event_token StateChanged(TypedEventHandler<ITerminalConnection, IInspectable> const& handler) { return _wrappedConnection.StateChanged(handler); };
+        void StateChanged(winrt::event_token const& token) noexcept { _wrappedConnection.StateChanged(token); };
+        ConnectionState State() const noexcept { return _wrappedConnection.State(); }
+
+    private:
+        DebugCaptureWriter _writer;
+        ITerminalConnection _wrappedConnection;
+        ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+    };
 }
 
 // Function Description
@@ -124,3 +294,14 @@ std::tuple<ITerminalConnection, ITerminalConnection> OpenDebugTapConnection(ITer
     std::tuple<ITerminalConnection, ITerminalConnection> p{ *inputSide, *debugSide };
     return p;
 }
+
+// Function Description
+// - Wraps the given connection in one that records all of its raw output and
+//   input into a capture file at the given path. See DebugCapture.h for the
+//   format, and VtOutputPerfTests for replaying the output of a capture.
+// Note: will throw if the capture file couldn't be created
+ITerminalConnection OpenDebugCaptureConnection(ITerminalConnection baseConnection, const std::filesystem::path& path)
+{
+    using namespace winrt::Microsoft::TerminalApp::implementation;
+    return winrt::make<DebugCaptureConnection>(std::move(baseConnection), path);
+}
@@ -40,3 +40,4 @@ namespace winrt::Microsoft::TerminalApp::implementation
 }
 
 std::tuple<winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection> OpenDebugTapConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection);
+winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection OpenDebugCaptureConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection, const std::filesystem::path& path);
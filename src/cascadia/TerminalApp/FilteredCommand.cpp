@@ -26,6 +26,7 @@ namespace winrt::TerminalApp::implementation
         _Filter(L""),
         _Weight(0)
     {
+        _foldedName = _foldCase(_Item.Name());
         _HighlightedName = _computeHighlightedName();
 
         // Recompute the highlighted name if the item name changes
@@ -33,6 +34,7 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
+                filteredCommand->_foldedName = _foldCase(filteredCommand->_Item.Name());
                 filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
@@ -51,6 +53,30 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Lowercases the given text according to the user's locale, so that
+    //   names and filters can be matched regardless of their case.
+    // - GH#9941: search should be locale-aware.
+    // - Every character is mapped to exactly one character, so offsets into the
+    //   returned string are offsets into the given text as well.
+    // Arguments:
+    // - text: the text to lowercase
+    // Return Value:
+    // - The lowercase text.
+    std::wstring FilteredCommand::_foldCase(const std::wstring_view text)
+    {
+        std::wstring folded{ text };
+        if (!folded.empty())
+        {
+            const auto length = gsl::narrow<int>(folded.size());
+            if (LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING, text.data(), length, folded.data(), length, nullptr, nullptr, 0) != length)
+            {
+                std::transform(text.begin(), text.end(), folded.begin(), [](const wchar_t ch) { return gsl::narrow_cast<wchar_t>(std::towlower(ch)); });
+            }
+        }
+        return folded;
+    }
+
     // Method Description:
     // - Looks up the filter characters within the item name.
     // Iterating through the filter and the item name it tries to associate the next filter character
@@ -66,6 +92,9 @@ namespace winrt::TerminalApp::implementation
     //
     // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
     //
+    // The filter characters are looked up in the lowercase name first, so that
+    // no segments are created at all if the item doesn't match.
+    //
     // TODO: we probably need to merge this logic with _getWeight computation?
     //
     // Return Value:
@@ -73,78 +102,55 @@ namespace winrt::TerminalApp::implementation
     winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
     {
         const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
-        auto commandName = _Item.Name();
-        bool isProcessingMatchedSegment = false;
-        uint32_t nextOffsetToReport = 0;
-        uint32_t currentOffset = 0;
-
-        for (const auto searchChar : _Filter)
+        const auto commandName = _Item.Name();
+        const std::wstring_view name{ commandName };
+        const auto filter = _foldCase(_Filter);
+
+        std::vector<size_t> matchedOffsets;
+        matchedOffsets.reserve(filter.size());
+        size_t currentOffset = 0;
+        for (const auto searchChar : filter)
         {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+            currentOffset = _foldedName.find(searchChar, currentOffset);
+            if (currentOffset == std::wstring::npos)
             {
-                if (currentOffset == commandName.size())
-                {
-                    // There are still unmatched filter characters but we finished scanning the name.
-                    // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
-                }
-
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
-                if (isProcessingMatchedSegment != isCurrentCharMatched)
-                {
-                    // We reached the end of the region (matched character came after a series of unmatched or vice versa).
-                    // Conclude the segment and add it to the list.
-                    // Skip segment if it is empty (might happen when the first character of the name is matched)
-                    auto sizeToReport = currentOffset - nextOffsetToReport;
-                    if (sizeToReport > 0)
-                    {
-                        winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                        auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, isProcessingMatchedSegment) };
-                        segments.Append(highlightedSegment);
-                        nextOffsetToReport = currentOffset;
-                    }
-                    isProcessingMatchedSegment = isCurrentCharMatched;
-                }
-
-                currentOffset++;
-
-                if (isCurrentCharMatched)
-                {
-                    // We have matched this filter character, let's move to matching the next filter char
-                    break;
-                }
+                // There are still unmatched filter characters but we finished scanning the name.
+                // In this case we return the entire item name as unmatched
+                segments.Append(winrt::make<HighlightedTextSegment>(commandName, false));
+                return winrt::make<HighlightedText>(segments);
             }
+            matchedOffsets.push_back(currentOffset++);
         }
 
-        // Either the filter or the item name were fully processed.
-        // If we were in the middle of the matched segment - add it.
-        if (isProcessingMatchedSegment)
+        // Consecutive matched characters form one highlighted segment,
+        // the characters between them form the segments that aren't highlighted.
+        size_t nextOffsetToReport = 0;
+        for (auto it = matchedOffsets.begin(); it != matchedOffsets.end();)
         {
-            auto sizeToReport = currentOffset - nextOffsetToReport;
-            if (sizeToReport > 0)
+            const auto matchBegin = *it;
+            auto matchEnd = matchBegin + 1;
+            while (++it != matchedOffsets.end() && *it == matchEnd)
+            {
+                matchEnd++;
+            }
+
+            if (matchBegin > nextOffsetToReport)
             {
-                winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, true) };
-                segments.Append(highlightedSegment);
-                nextOffsetToReport = currentOffset;
+                const winrt::hstring segment{ name.substr(nextOffsetToReport, matchBegin - nextOffsetToReport) };
+                segments.Append(winrt::make<HighlightedTextSegment>(segment, false));
             }
+
+            const winrt::hstring segment{ name.substr(matchBegin, matchEnd - matchBegin) };
+            segments.Append(winrt::make<HighlightedTextSegment>(segment, true));
+            nextOffsetToReport = matchEnd;
         }
 
         // Now create a segment for all remaining characters.
         // We will have remaining characters as long as the filter is shorter than the item name.
-        auto sizeToReport = commandName.size() - nextOffsetToReport;
-        if (sizeToReport > 0)
+        if (nextOffsetToReport < name.size())
         {
-            winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-            auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, false) };
-            segments.Append(highlightedSegment);
+            const winrt::hstring segment{ name.substr(nextOffsetToReport) };
+            segments.Append(winrt::make<HighlightedTextSegment>(segment, false));
         }
 
         return winrt::make<HighlightedText>(segments);
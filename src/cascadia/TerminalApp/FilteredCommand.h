@@ -31,8 +31,13 @@ namespace winrt::TerminalApp::implementation
         WINRT_OBSERVABLE_PROPERTY(int, Weight, _PropertyChangedHandlers);
 
     private:
+        static std::wstring _foldCase(const std::wstring_view text);
+
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
         int _computeWeight();
+
+        // The lowercase item name, computed once per name rather than once per filter.
+        std::wstring _foldedName;
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
@@ -113,7 +113,9 @@ static std::wstring_view _getExePath()
 }
 
 // Method Description:
-// - Updates the items of the Jumplist based on the given settings.
+// - Updates the items of the Jumplist based on the given settings. This is
+//   done on a background thread with a background priority, since it's
+//   never urgent and shouldn't slow down the UI.
 // Arguments:
 // - settings - The settings object to update the jumplist with.
 // Return Value:
@@ -125,6 +127,16 @@ winrt::fire_and_forget Jumplist::UpdateJumplist(const CascadiaSettings& settings
 
     co_await winrt::resume_background();
 
+    // Lowers the CPU and I/O priority of this threadpool thread. It has to
+    // be restored before the thread is handed back to the pool.
+    const auto backgroundMode = SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    const auto restorePriority = wil::scope_exit([backgroundMode]() {
+        if (backgroundMode)
+        {
+            SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+        }
+    });
+
     try
     {
         auto jumplistInstance = winrt::create_instance<ICustomDestinationList>(CLSID_DestinationList, CLSCTX_ALL);
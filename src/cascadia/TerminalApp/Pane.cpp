@@ -72,39 +72,38 @@ Pane::Pane(const GUID& profile, const TermControl& control, const bool lastFocus
 }
 
 // Method Description:
-// - Update the size of this pane. Resizes each of our columns so they have the
-//   same relative sizes, given the newSize.
-// - Because we're just manually setting the row/column sizes in pixels, we have
-//   to be told our new size, we can't just use our own OnSized event, because
-//   that _won't fire when we get smaller_.
+// - Update the size of this pane, when the space it has to fill changed.
+// - Our rows and columns are sized in proportion to each other (see
+//   _CreateRowColDefinitions), and XAML applies those proportions to whatever
+//   size it gives us, in the same layout pass that sizes the controls. So the
+//   new size itself doesn't need any computation. All that's done here is to
+//   bring the definitions of the splits in this tree up to date. The ones that
+//   didn't change are left alone, so that they don't cause another measure
+//   pass. On a window resize, that's all of them.
 // Arguments:
 // - newSize: the amount of space that this pane has to fill now.
 // Return Value:
 // - <none>
-void Pane::ResizeContent(const Size& newSize)
+void Pane::ResizeContent(const Size& /*newSize*/)
 {
-    const auto width = newSize.Width;
-    const auto height = newSize.Height;
+    _UpdateRowColDefinitions();
+}
 
+// Method Description:
+// - Brings the row and column definitions of this pane and all of its
+//   descendants up to date with their split positions.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Pane::_UpdateRowColDefinitions()
+{
     _CreateRowColDefinitions();
 
-    if (_splitState == SplitState::Vertical)
-    {
-        const auto paneSizes = _CalcChildrenSizes(width);
-
-        const Size firstSize{ paneSizes.first, height };
-        const Size secondSize{ paneSizes.second, height };
-        _firstChild->ResizeContent(firstSize);
-        _secondChild->ResizeContent(secondSize);
-    }
-    else if (_splitState == SplitState::Horizontal)
+    if (!_IsLeaf())
     {
-        const auto paneSizes = _CalcChildrenSizes(height);
-
-        const Size firstSize{ width, paneSizes.first };
-        const Size secondSize{ width, paneSizes.second };
-        _firstChild->ResizeContent(firstSize);
-        _secondChild->ResizeContent(secondSize);
+        _firstChild->_UpdateRowColDefinitions();
+        _secondChild->_UpdateRowColDefinitions();
     }
 }
 
@@ -1040,43 +1039,62 @@ void Pane::_SetupChildCloseHandlers()
 //   available space, and the percent of the space they respectively consume,
 //   which is stored in _desiredSplitPosition
 // - Does nothing if our split state is currently set to SplitState::None
+// - The definitions are only created once, and updated afterwards if their
+//   size actually changed, since every change makes XAML measure and arrange
+//   the whole subtree again.
 // Arguments:
 // - <none>
 // Return Value:
 // - <none>
 void Pane::_CreateRowColDefinitions()
 {
-    const auto first = _desiredSplitPosition * 100.0f;
-    const auto second = 100.0f - first;
+    const auto first = GridLengthHelper::FromValueAndType(_desiredSplitPosition * 100.0f, GridUnitType::Star);
+    const auto second = GridLengthHelper::FromValueAndType(100.0f - _desiredSplitPosition * 100.0f, GridUnitType::Star);
     if (_splitState == SplitState::Vertical)
     {
-        _root.ColumnDefinitions().Clear();
-
-        // Create two columns in this grid: one for each pane
-
-        auto firstColDef = Controls::ColumnDefinition();
-        firstColDef.Width(GridLengthHelper::FromValueAndType(first, GridUnitType::Star));
+        auto columns = _root.ColumnDefinitions();
+        if (columns.Size() != 2)
+        {
+            columns.Clear();
 
-        auto secondColDef = Controls::ColumnDefinition();
-        secondColDef.Width(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
+            // Create two columns in this grid: one for each pane
+            columns.Append(Controls::ColumnDefinition());
+            columns.Append(Controls::ColumnDefinition());
+        }
 
-        _root.ColumnDefinitions().Append(firstColDef);
-        _root.ColumnDefinitions().Append(secondColDef);
+        const auto firstColDef = columns.GetAt(0);
+        const auto secondColDef = columns.GetAt(1);
+        if (firstColDef.Width() != first)
+        {
+            firstColDef.Width(first);
+        }
+        if (secondColDef.Width() != second)
+        {
+            secondColDef.Width(second);
+        }
     }
     else if (_splitState == SplitState::Horizontal)
     {
-        _root.RowDefinitions().Clear();
-
-        // Create two rows in this grid: one for each pane
-
-        auto firstRowDef = Controls::RowDefinition();
-        firstRowDef.Height(GridLengthHelper::FromValueAndType(first, GridUnitType::Star));
+        auto rows = _root.RowDefinitions();
+        if (rows.Size() != 2)
+        {
+            rows.Clear();
 
-        auto secondRowDef = Controls::RowDefinition();
-        secondRowDef.Height(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
+            // Create two rows in this grid: one for each pane
+            rows.Append(Controls::RowDefinition());
+            rows.Append(Controls::RowDefinition());
+        }
 
-        _root.RowDefinitions().Append(firstRowDef);
-        _root.RowDefinitions().Append(secondRowDef);
+        const auto firstRowDef = rows.GetAt(0);
+        const auto secondRowDef = rows.GetAt(1);
+        if (firstRowDef.Height() != first)
+        {
+            firstRowDef.Height(first);
+        }
+        if (secondRowDef.Height() != second)
+        {
+            secondRowDef.Height(second);
+        }
     }
 }
 
@@ -2133,6 +2151,46 @@ bool Pane::ContainsReadOnly() const
     return _IsLeaf() ? _control.ReadOnly() : (_firstChild->ContainsReadOnly() || _secondChild->ContainsReadOnly());
 }
 
+// Method Description:
+// - Informs the control of this pane, or those of its descendants, that the
+//   window was hidden from or shown to the user.
+// Arguments:
+// - showOrHide: true if the window is visible
+// Return Value:
+// - <none>
+void Pane::WindowVisibilityChanged(const bool showOrHide)
+{
+    if (_IsLeaf())
+    {
+        _control.WindowVisibilityChanged(showOrHide);
+    }
+    else
+    {
+        _firstChild->WindowVisibilityChanged(showOrHide);
+        _secondChild->WindowVisibilityChanged(showOrHide);
+    }
+}
+
+// Method Description:
+// - Appends the control of this pane, or those of its descendants, to the
+//   given list, in the order they're laid out in.
+// Arguments:
+// - controls: receives the ID and the control of every leaf pane
+// Return Value:
+// - <none>
+void Pane::CollectTerminalControls(std::vector<std::pair<uint32_t, TermControl>>& controls)
+{
+    if (_IsLeaf())
+    {
+        controls.emplace_back(_id.value_or(0), _control);
+    }
+    else
+    {
+        _firstChild->CollectTerminalControls(controls);
+        _secondChild->CollectTerminalControls(controls);
+    }
+}
+
 DEFINE_EVENT(Pane, GotFocus, _GotFocusHandlers, winrt::delegate<std::shared_ptr<Pane>>);
 DEFINE_EVENT(Pane, LostFocus, _LostFocusHandlers, winrt::delegate<std::shared_ptr<Pane>>);
 DEFINE_EVENT(Pane, PaneRaiseBell, _PaneRaiseBellHandlers, winrt::Windows::Foundation::EventHandler<bool>);
@@ -81,6 +81,8 @@ public:
     bool FocusPane(const uint32_t id);
 
     bool ContainsReadOnly() const;
+    void WindowVisibilityChanged(const bool showOrHide);
+    void CollectTerminalControls(std::vector<std::pair<uint32_t, winrt::Microsoft::Terminal::Control::TermControl>>& controls);
 
     WINRT_CALLBACK(Closed, winrt::Windows::Foundation::EventHandler<winrt::Windows::Foundation::IInspectable>);
     DECLARE_EVENT(GotFocus, _GotFocusHandlers, winrt::delegate<std::shared_ptr<Pane>>);
@@ -132,6 +134,7 @@ private:
                                                                    const winrt::Microsoft::Terminal::Control::TermControl& control);
 
     void _CreateRowColDefinitions();
+    void _UpdateRowColDefinitions();
     void _ApplySplitDefinitions();
     void _SetupEntranceAnimation();
     void _UpdateBorders();
@@ -111,20 +111,37 @@ namespace winrt::TerminalApp::implementation
         flyout.Items().Append(_closeTabsAfterMenuItem);
         flyout.Items().Append(_closeOtherTabsMenuItem);
         flyout.Items().Append(closeTabMenuItem);
+
+        // The items depend on the number of tabs, which changes much more
+        // often than the menu is opened, so they're only updated for that.
+        flyout.Opening([weakThis](auto&&, auto&&) {
+            if (auto tab{ weakThis.get() })
+            {
+                tab->_EnableCloseMenuItems();
+            }
+        });
     }
 
     // Method Description:
     // - Enable the Close menu items based on tab index and total number of tabs
+    // - The number of tabs is that of the tab row the TabViewItem is in, so
+    //   that the tabs don't all have to be told about it whenever it changes.
     // Arguments:
     // - <none>
     // Return Value:
     // - <none>
     void TabBase::_EnableCloseMenuItems()
     {
+        uint32_t numTabs = 1;
+        if (const auto tabRow = Controls::ItemsControl::ItemsControlFromItemContainer(TabViewItem()))
+        {
+            numTabs = tabRow.Items().Size();
+        }
+
         // close other tabs is enabled only if there are other tabs
-        _closeOtherTabsMenuItem.IsEnabled(TabViewNumTabs() > 1);
+        _closeOtherTabsMenuItem.IsEnabled(numTabs > 1);
         // close tabs after is enabled only if there are other tabs on the right
-        _closeTabsAfterMenuItem.IsEnabled(TabViewIndex() < TabViewNumTabs() - 1);
+        _closeTabsAfterMenuItem.IsEnabled(TabViewIndex() + 1 < numTabs);
     }
 
     void TabBase::_CloseTabsAfter()
@@ -143,12 +160,15 @@ namespace winrt::TerminalApp::implementation
         _dispatch.DoAction(closeOtherTabs);
     }
 
-    void TabBase::UpdateTabViewIndex(const uint32_t idx, const uint32_t numTabs)
+    void TabBase::UpdateTabViewIndex(const uint32_t idx)
     {
-        TabViewIndex(idx);
-        TabViewNumTabs(numTabs);
-        _EnableCloseMenuItems();
-        _UpdateSwitchToTabKeyChord();
+        // Looking up the key chord for the index isn't free, and most tabs
+        // keep theirs when a tab is opened or closed further to the right.
+        if (_TabViewIndex != idx)
+        {
+            TabViewIndex(idx);
+            _UpdateSwitchToTabKeyChord();
+        }
     }
 
     void TabBase::SetDispatch(const winrt::TerminalApp::ShortcutActionDispatch& dispatch)
@@ -22,7 +22,7 @@ namespace winrt::TerminalApp::implementation
         virtual void Shutdown();
         void SetDispatch(const winrt::TerminalApp::ShortcutActionDispatch& dispatch);
 
-        void UpdateTabViewIndex(const uint32_t idx, const uint32_t numTabs);
+        void UpdateTabViewIndex(const uint32_t idx);
         void SetActionMap(const Microsoft::Terminal::Settings::Model::IActionMapView& actionMap);
 
         WINRT_CALLBACK(RequestFocusActiveControl, winrt::delegate<void()>);
@@ -33,8 +33,6 @@ namespace winrt::TerminalApp::implementation
 
         // The TabViewIndex is the index this Tab object resides in TerminalPage's _tabs vector.
         WINRT_PROPERTY(uint32_t, TabViewIndex, 0);
-        // The TabViewNumTabs is the number of Tab objects in TerminalPage's _tabs vector.
-        WINRT_PROPERTY(uint32_t, TabViewNumTabs, 0);
 
         WINRT_OBSERVABLE_PROPERTY(winrt::hstring, Title, _PropertyChangedHandlers);
         WINRT_OBSERVABLE_PROPERTY(winrt::hstring, Icon, _PropertyChangedHandlers);
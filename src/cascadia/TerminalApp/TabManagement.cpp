@@ -59,6 +59,12 @@ namespace winrt::TerminalApp::implementation
     void TerminalPage::_OpenNewTab(const NewTerminalArgs& newTerminalArgs, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection existingConnection)
     try
     {
+        // The first startup tab takes the connection that was launched for it.
+        if (!existingConnection && _startupConnection && newTerminalArgs == _startupConnectionArgs)
+        {
+            existingConnection = std::exchange(_startupConnection, nullptr);
+        }
+
         const auto profileGuid{ _settings.GetProfileForArgs(newTerminalArgs) };
         const auto settings{ TerminalSettings::CreateWithNewTerminalArgs(_settings, newTerminalArgs, *_bindings) };
 
@@ -113,7 +119,20 @@ namespace winrt::TerminalApp::implementation
             const auto lAltState = window.GetKeyState(VirtualKey::LeftMenu);
             const bool bothAltsPressed = WI_IsFlagSet(lAltState, CoreVirtualKeyStates::Down) &&
                                          WI_IsFlagSet(rAltState, CoreVirtualKeyStates::Down);
-            if (bothAltsPressed)
+            const bool shiftPressed = WI_IsFlagSet(window.GetKeyState(VirtualKey::Shift), CoreVirtualKeyStates::Down);
+            if (bothAltsPressed && shiftPressed)
+            {
+                // Instead of tapping the connection into a second pane, record its raw
+                // output and input into a capture file, which costs next to nothing.
+                try
+                {
+                    const auto path = std::filesystem::temp_directory_path() /
+                                      fmt::format(L"WindowsTerminal-{}-{}.wtcapture", GetCurrentProcessId(), GetTickCount64());
+                    connection = OpenDebugCaptureConnection(connection, path);
+                }
+                CATCH_LOG();
+            }
+            else if (bothAltsPressed)
             {
                 std::tie(connection, debugConnection) = OpenDebugTapConnection(connection);
             }
@@ -133,7 +152,7 @@ namespace winrt::TerminalApp::implementation
         newTabImpl->SetActionMap(_settings.ActionMap());
 
         // Give the tab its index in the _tabs vector so it can manage its own SwitchToTab command.
-        _UpdateTabIndices();
+        _UpdateTabIndices(_tabs.Size() - 1);
 
         // Hookup our event handlers to the new terminal
         _RegisterTerminalEvents(term, *newTabImpl);
@@ -375,7 +394,7 @@ namespace winrt::TerminalApp::implementation
     void TerminalPage::_RemoveTab(const winrt::TerminalApp::TabBase& tab)
     {
         uint32_t tabIndex{};
-        if (!_tabs.IndexOf(tab, tabIndex))
+        if (!_FindTabIndex(tab, tabIndex))
         {
             // The tab is already removed
             return;
@@ -400,7 +419,7 @@ namespace winrt::TerminalApp::implementation
 
         _tabs.RemoveAt(tabIndex);
         _tabView.TabItems().RemoveAt(tabIndex);
-        _UpdateTabIndices();
+        _UpdateTabIndices(tabIndex);
 
         // To close the window here, we need to close the hosting window.
         if (_tabs.Size() == 0)
@@ -527,7 +546,7 @@ namespace winrt::TerminalApp::implementation
     void TerminalPage::_OnSwitchToTabRequested(const IInspectable& /*sender*/, const winrt::TerminalApp::TabBase& tab)
     {
         uint32_t index{};
-        if (_tabs.IndexOf(tab, index))
+        if (_FindTabIndex(tab, index))
         {
             _SelectTab(index);
         }
@@ -610,7 +629,7 @@ namespace winrt::TerminalApp::implementation
         {
             // Make sure the tab was not removed
             uint32_t tabIndex{};
-            if (_tabs.IndexOf(tab, tabIndex))
+            if (_FindTabIndex(tab, tabIndex))
             {
                 _tabView.SelectedItem(tab.TabViewItem());
             }
@@ -798,20 +817,45 @@ namespace winrt::TerminalApp::implementation
     }
 
     // Method Description:
-    // - Updates all tabs with their current index in _tabs.
+    // - Updates the tabs with their current index in _tabs.
+    // - Only the tabs in the given range are updated, which should be the
+    //   range of tabs that were inserted, removed or moved. Opening a tab
+    //   at the end of the tab row then only updates that tab, no matter how
+    //   many tabs there are.
     // Arguments:
-    // - <none>
+    // - begin: the index of the first tab whose index may have changed
+    // - end: the index past the last tab whose index may have changed
     // Return Value:
     // - <none>
-    void TerminalPage::_UpdateTabIndices()
+    void TerminalPage::_UpdateTabIndices(const uint32_t begin, const uint32_t end)
     {
-        const uint32_t size = _tabs.Size();
-        for (uint32_t i = 0; i < size; ++i)
+        const auto size = std::min(end, _tabs.Size());
+        for (auto i = begin; i < size; ++i)
         {
             auto tab{ _tabs.GetAt(i) };
             auto tabImpl{ winrt::get_self<TabBase>(tab) };
-            tabImpl->UpdateTabViewIndex(i, size);
+            tabImpl->UpdateTabViewIndex(i);
+        }
+    }
+
+    // Method Description:
+    // - Finds the index of a tab in _tabs. The tab's TabViewIndex is checked
+    //   first, which is where it almost always is, so that this doesn't have
+    //   to search through all tabs.
+    // Arguments:
+    // - tab: the tab to look for
+    // - index: receives the index of the tab
+    // Return Value:
+    // - true if the tab is in _tabs
+    bool TerminalPage::_FindTabIndex(const winrt::TerminalApp::TabBase& tab, uint32_t& index) const
+    {
+        const auto hint = tab.TabViewIndex();
+        if (hint < _tabs.Size() && _tabs.GetAt(hint) == tab)
+        {
+            index = hint;
+            return true;
         }
+        return _tabs.IndexOf(tab, index);
     }
 
     // Method Description:
@@ -849,7 +893,7 @@ namespace winrt::TerminalApp::implementation
             auto tabViewItem = tab.TabViewItem();
             _tabs.RemoveAt(currentTabIndex);
             _tabs.InsertAt(newTabIndex, tab);
-            _UpdateTabIndices();
+            _UpdateTabIndices(std::min(currentTabIndex, newTabIndex), std::max(currentTabIndex, newTabIndex) + 1);
 
             _tabView.TabItems().RemoveAt(currentTabIndex);
             _tabView.TabItems().InsertAt(newTabIndex, tabViewItem);
@@ -877,7 +921,7 @@ namespace winrt::TerminalApp::implementation
             auto tab = tabs.GetAt(from.value());
             tabs.RemoveAt(from.value());
             tabs.InsertAt(to.value(), tab);
-            _UpdateTabIndices();
+            _UpdateTabIndices(gsl::narrow_cast<uint32_t>(std::min(from.value(), to.value())), gsl::narrow_cast<uint32_t>(std::max(from.value(), to.value()) + 1));
         }
 
         _rearranging = false;
@@ -1,4 +1,4 @@
-// Copyright (c) Microsoft Corporation.
+﻿// Copyright (c) Microsoft Corporation.
 // Licensed under the MIT license.
 
 #include "pch.h"
@@ -112,6 +112,12 @@ namespace winrt::TerminalApp::implementation
         // Upon settings update we reload the system settings for scrolling as well.
         // TODO: consider reloading this value periodically.
         _systemRowsToScroll = _ReadSystemRowsToScroll();
+
+        // New tabs and panes take their pseudoconsole from this pool, if there's one.
+        const auto globals = _settings.GlobalSettings();
+        TerminalConnection::ConptyConnection::PrewarmPseudoConsoles(gsl::narrow_cast<uint32_t>(std::clamp(globals.PseudoConsolePoolSize(), 0, 8)),
+                                                                    gsl::narrow_cast<uint32_t>(globals.InitialRows()),
+                                                                    gsl::narrow_cast<uint32_t>(globals.InitialCols()));
     }
 
     void TerminalPage::Create()
@@ -119,6 +125,10 @@ namespace winrt::TerminalApp::implementation
         // Hookup the key bindings
         _HookupKeyBindings(_settings.ActionMap());
 
+        // The first tab's shell is what the user waits for, so it's spawned
+        // first, and starts up while the rest of the window is being built.
+        _LaunchStartupConnection();
+
         _tabContent = this->TabContent();
         _tabRow = this->TabRow();
         _tabView = _tabRow.TabView();
@@ -313,6 +323,15 @@ namespace winrt::TerminalApp::implementation
         if (_startupState == StartupState::NotInitialized)
         {
             _startupState = StartupState::InStartup;
+
+            TraceLoggingWrite(
+                g_hTerminalAppProvider,
+                "StartupFirstLayout",
+                TraceLoggingDescription("Event emitted when the window was first laid out and the startup tabs are about to be created"),
+                TraceLoggingFloat64(Utils::TimeSinceProcessStart().count(), "SinceProcessStart", "Seconds since the process was created"),
+                TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+
             ProcessStartupActions(_startupActions, true);
 
             // If we were told that the COM server needs to be started to listen for incoming
@@ -452,9 +471,101 @@ namespace winrt::TerminalApp::implementation
     void TerminalPage::_CompleteInitialization()
     {
         _startupState = StartupState::Initialized;
+
+        // If the startup tabs didn't use the connection that was launched for
+        // them, it goes away with its client. Its destruction is deferred to
+        // a background thread by the connection itself.
+        const bool usedStartupConnection = !_startupConnection;
+        _startupConnection = nullptr;
+        _startupConnectionArgs = nullptr;
+
+        TraceLoggingWrite(
+            g_hTerminalAppProvider,
+            "StartupInitialized",
+            TraceLoggingDescription("Event emitted when the startup tabs were created"),
+            TraceLoggingFloat64(Utils::TimeSinceProcessStart().count(), "SinceProcessStart", "Seconds since the process was created"),
+            TraceLoggingBool(usedStartupConnection, "UsedStartupConnection", "Whether the first tab got the connection launched during startup"),
+            TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+            TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+
         _InitializedHandlers(*this, nullptr);
     }
 
+    // Method Description:
+    // - Creates the connection of the first startup tab and launches its
+    //   client on a background thread, before the window was even laid out.
+    //   The client has to be launched at the size of the settings, but it
+    //   usually isn't done starting up by the time the control knows its
+    //   actual size and starts the connection, which resizes it then. The
+    //   first tab then takes this connection, see _OpenNewTab.
+    // - This only covers a first startup action that opens a tab with a
+    //   ConptyConnection. The tabs and panes after it are created as usual.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TerminalPage::_LaunchStartupConnection()
+    try
+    {
+        if (_startupState != StartupState::NotInitialized ||
+            _startupActions.Size() == 0)
+        {
+            return;
+        }
+
+        const auto action = _startupActions.GetAt(0);
+        if (action.Action() != ShortcutAction::NewTab)
+        {
+            return;
+        }
+
+        NewTerminalArgs newTerminalArgs{ nullptr };
+        if (const auto args = action.Args())
+        {
+            if (const auto newTabArgs = args.try_as<NewTabArgs>())
+            {
+                newTerminalArgs = newTabArgs.TerminalArgs();
+            }
+        }
+
+        const auto profileGuid{ _settings.GetProfileForArgs(newTerminalArgs) };
+        const auto settings{ TerminalSettings::CreateWithNewTerminalArgs(_settings, newTerminalArgs, *_bindings) };
+        const auto connection = _CreateConnectionFromSettings(profileGuid, settings.DefaultSettings());
+        if (const auto conpty = connection.try_as<TerminalConnection::ConptyConnection>())
+        {
+            _startupConnection = connection;
+            _startupConnectionArgs = newTerminalArgs;
+            _LaunchConnectionInBackground(conpty);
+        }
+    }
+    CATCH_LOG();
+
+    // Method Description:
+    // - Launches the client of the given connection on a background thread.
+    //   See ConptyConnection::Launch.
+    // Arguments:
+    // - connection: the connection to launch
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget TerminalPage::_LaunchConnectionInBackground(TerminalConnection::ConptyConnection connection)
+    {
+        co_await winrt::resume_background();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        connection.Launch();
+        const std::chrono::duration<double> delta = std::chrono::high_resolution_clock::now() - start;
+
+        TraceLoggingWrite(
+            g_hTerminalAppProvider,
+            "StartupConnectionLaunched",
+            TraceLoggingDescription("Event emitted when the client of the first startup tab was launched"),
+            TraceLoggingGuid(connection.Guid(), "SessionGuid", "The WT_SESSION's GUID"),
+            TraceLoggingFloat64(delta.count(), "Duration", "Seconds spent creating the pseudoconsole and the client"),
+            TraceLoggingFloat64(Utils::TimeSinceProcessStart().count(), "SinceProcessStart", "Seconds since the process was created"),
+            TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+            TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+    }
+
     // Method Description:
     // - Show a dialog with "About" information. Displays the app's Display
     //   Name, version, getting started link, documentation link, release
@@ -1119,6 +1230,24 @@ namespace winrt::TerminalApp::implementation
         return nullptr;
     }
 
+    // Method Description:
+    // - Called when the window was minimized, restored, cloaked or uncloaked.
+    //   Controls stop rendering while the window is hidden from the user.
+    // Arguments:
+    // - showOrHide: true if the window is visible
+    // Return Value:
+    // - <none>
+    void TerminalPage::WindowVisibilityChanged(const bool showOrHide)
+    {
+        for (const auto& tab : _tabs)
+        {
+            if (auto terminalTab = _GetTerminalTabImpl(tab))
+            {
+                terminalTab->WindowVisibilityChanged(showOrHide);
+            }
+        }
+    }
+
     // Method Description:
     // - Close the terminal app. If there is more
     //   than one tab opened, show a warning dialog.
@@ -1436,15 +1565,17 @@ namespace winrt::TerminalApp::implementation
     // Method Description:
     // - Place `copiedData` into the clipboard as text. Triggered when a
     //   terminal control raises it's CopyToClipboard event.
+    // - The HTML and RTF formats are generated on a background thread,
+    //   as they can take a while for big selections.
     // Arguments:
     // - copiedData: the new string content to place on the clipboard.
     winrt::fire_and_forget TerminalPage::_CopyToClipboardHandler(const IInspectable /*sender*/,
                                                                  const CopyToClipboardEventArgs copiedData)
     {
-        co_await winrt::resume_foreground(Dispatcher(), CoreDispatcherPriority::High);
+        // Keep ourselves alive across the hop to the background thread.
+        auto strongThis{ get_strong() };
 
-        DataPackage dataPack = DataPackage();
-        dataPack.RequestedOperation(DataPackageOperation::Copy);
+        co_await winrt::resume_foreground(Dispatcher(), CoreDispatcherPriority::High);
 
         // The EventArgs.Formats() is an override for the global setting "copyFormatting"
         //   iff it is set
@@ -1453,27 +1584,41 @@ namespace winrt::TerminalApp::implementation
                                _settings.GlobalSettings().CopyFormatting() :
                                copiedData.Formats().Value();
 
+        // Only the formats we're going to place on the clipboard are generated.
+        winrt::hstring htmlData;
+        winrt::hstring rtfData;
+        if (WI_IsAnyFlagSet(copyFormats, CopyFormat::HTML | CopyFormat::RTF))
+        {
+            co_await winrt::resume_background();
+
+            if (WI_IsFlagSet(copyFormats, CopyFormat::HTML))
+            {
+                htmlData = copiedData.Html();
+            }
+            if (WI_IsFlagSet(copyFormats, CopyFormat::RTF))
+            {
+                rtfData = copiedData.Rtf();
+            }
+
+            co_await winrt::resume_foreground(Dispatcher(), CoreDispatcherPriority::High);
+        }
+
+        DataPackage dataPack = DataPackage();
+        dataPack.RequestedOperation(DataPackageOperation::Copy);
+
         // copy text to dataPack
         dataPack.SetText(copiedData.Text());
 
-        if (WI_IsFlagSet(copyFormats, CopyFormat::HTML))
+        // copy html to dataPack
+        if (!htmlData.empty())
         {
-            // copy html to dataPack
-            const auto htmlData = copiedData.Html();
-            if (!htmlData.empty())
-            {
-                dataPack.SetHtmlFormat(htmlData);
-            }
+            dataPack.SetHtmlFormat(htmlData);
         }
 
-        if (WI_IsFlagSet(copyFormats, CopyFormat::RTF))
+        // copy rtf data to dataPack
+        if (!rtfData.empty())
         {
-            // copy rtf data to dataPack
-            const auto rtfData = copiedData.Rtf();
-            if (!rtfData.empty())
-            {
-                dataPack.SetRtf(rtfData);
-            }
+            dataPack.SetRtf(rtfData);
         }
 
         try
@@ -2076,6 +2221,131 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Highlights every match of the query in all the panes of the focused
+    //   tab, or of every tab in the window. All the buffers are searched on
+    //   the thread pool at once, each holding only the lock of its own
+    //   terminal, and every pane shows its matches as soon as its own search
+    //   is done. A toast sums up the matches of each pane as they come in.
+    // - This will load the FindInPanesToast TeachingTip the first time it's called.
+    // Arguments:
+    // - query: the text to search for
+    // - caseSensitive: whether the case of the text must match the query
+    // - scope: whether to search the panes of the focused tab or of the window
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget TerminalPage::_FindInPanes(const winrt::hstring query,
+                                                      const bool caseSensitive,
+                                                      const FindScope scope)
+    {
+        struct PaneSearch
+        {
+            winrt::hstring tabTitle;
+            uint32_t paneId;
+            winrt::Windows::Foundation::IAsyncOperation<uint32_t> operation;
+        };
+
+        // Start all the searches before waiting on any of them.
+        std::vector<PaneSearch> searches;
+        const auto searchTab = [&](const winrt::com_ptr<TerminalTab>& tab) {
+            for (const auto& [id, control] : tab->GetTerminalControls())
+            {
+                searches.push_back({ tab->Title(), id, control.HighlightAllMatchesAsync(query, caseSensitive) });
+            }
+        };
+
+        if (scope == FindScope::Window)
+        {
+            for (const auto& tab : _tabs)
+            {
+                if (const auto terminalTab{ _GetTerminalTabImpl(tab) })
+                {
+                    searchTab(terminalTab);
+                }
+            }
+        }
+        else if (const auto terminalTab{ _GetFocusedTabImpl() })
+        {
+            searchTab(terminalTab);
+        }
+
+        if (searches.empty())
+        {
+            co_return;
+        }
+
+        uint32_t totalMatches = 0;
+        uint32_t panesWithMatches = 0;
+        std::wstring summary;
+        const auto showResults = [&](TerminalPage& page, const bool open) {
+            // If we haven't ever loaded the TeachingTip, then do so now and
+            // create the toast for it.
+            if (page._findInPanesToast == nullptr)
+            {
+                if (MUX::Controls::TeachingTip tip{ page.FindName(L"FindInPanesToast").try_as<MUX::Controls::TeachingTip>() })
+                {
+                    page._findInPanesToast = std::make_shared<Toast>(tip);
+                    // Make sure to use the weak ref when setting up this
+                    // callback.
+                    tip.Closed({ page.get_weak(), &TerminalPage::_FocusActiveControl });
+                }
+            }
+
+            if (page._findInPanesToast != nullptr)
+            {
+                const auto tip{ page.FindInPanesToast() };
+                tip.Title(fmt::format(std::wstring_view{ RS_(L"FindInPanesToastTitle") },
+                                      totalMatches,
+                                      panesWithMatches,
+                                      searches.size()));
+                tip.Subtitle(summary);
+                if (open)
+                {
+                    page._UpdateTeachingTipTheme(tip.try_as<winrt::Windows::UI::Xaml::FrameworkElement>());
+                    page._findInPanesToast->Open();
+                }
+            }
+        };
+
+        auto weakThis{ get_weak() };
+        for (auto& search : searches)
+        {
+            const auto matches = co_await search.operation;
+            auto page{ weakThis.get() };
+            if (!page)
+            {
+                co_return;
+            }
+
+            if (matches != 0)
+            {
+                totalMatches += matches;
+                ++panesWithMatches;
+                if (!summary.empty())
+                {
+                    summary += L"\n";
+                }
+                summary += fmt::format(std::wstring_view{ RS_(L"FindInPanesPaneMatches") },
+                                       std::wstring_view{ search.tabTitle },
+                                       search.paneId,
+                                       matches);
+
+                // Open the toast with the first results, and let the
+                // results of the other panes stream into it.
+                showResults(*page, panesWithMatches == 1);
+            }
+        }
+
+        // Let the user know that the search is done, even if nothing was found.
+        if (panesWithMatches == 0)
+        {
+            if (auto page{ weakThis.get() })
+            {
+                showResults(*page, true);
+            }
+        }
+    }
+
     // Method Description:
     // - Toggles borderless mode. Hides the tab row, and raises our
     //   FocusModeChanged event.
@@ -2374,7 +2644,7 @@ namespace winrt::TerminalApp::implementation
             newTabImpl->SetActionMap(_settings.ActionMap());
 
             // Give the tab its index in the _tabs vector so it can manage its own SwitchToTab command.
-            _UpdateTabIndices();
+            _UpdateTabIndices(_tabs.Size() - 1);
 
             // Don't capture a strong ref to the tab. If the tab is removed as this
             // is called, we don't really care anymore about handling the event.
@@ -69,6 +69,8 @@ namespace winrt::TerminalApp::implementation
 
         winrt::fire_and_forget CloseWindow();
 
+        void WindowVisibilityChanged(const bool showOrHide);
+
         void ToggleFocusMode();
         void ToggleFullscreen();
         void ToggleAlwaysOnTop();
@@ -145,7 +147,8 @@ namespace winrt::TerminalApp::implementation
         Windows::Foundation::Collections::IObservableVector<TerminalApp::TabBase> _mruTabs;
         static winrt::com_ptr<TerminalTab> _GetTerminalTabImpl(const TerminalApp::TabBase& tab);
 
-        void _UpdateTabIndices();
+        void _UpdateTabIndices(const uint32_t begin = 0, const uint32_t end = UINT32_MAX);
+        bool _FindTabIndex(const winrt::TerminalApp::TabBase& tab, uint32_t& index) const;
 
         TerminalApp::SettingsTab _settingsTab{ nullptr };
 
@@ -175,8 +178,14 @@ namespace winrt::TerminalApp::implementation
         bool _shouldStartInboundListener{ false };
         bool _isEmbeddingInboundListener{ false };
 
+        // The connection of the first startup tab, which is launched while
+        // the rest of the window is still being set up. See _LaunchStartupConnection.
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection _startupConnection{ nullptr };
+        Microsoft::Terminal::Settings::Model::NewTerminalArgs _startupConnectionArgs{ nullptr };
+
         std::shared_ptr<Toast> _windowIdToast{ nullptr };
         std::shared_ptr<Toast> _windowRenameFailedToast{ nullptr };
+        std::shared_ptr<Toast> _findInPanesToast{ nullptr };
 
         void _ShowAboutDialog();
         winrt::Windows::Foundation::IAsyncOperation<winrt::Windows::UI::Xaml::Controls::ContentDialogResult> _ShowCloseWarningDialog();
@@ -290,6 +299,7 @@ namespace winrt::TerminalApp::implementation
         void _OnSwitchToTabRequested(const IInspectable& sender, const winrt::TerminalApp::TabBase& tab);
 
         void _Find();
+        winrt::fire_and_forget _FindInPanes(const winrt::hstring query, const bool caseSensitive, const Microsoft::Terminal::Settings::Model::FindScope scope);
 
         winrt::Microsoft::Terminal::Control::TermControl _InitControl(const winrt::Microsoft::Terminal::Settings::Model::TerminalSettingsCreateResult& settings,
                                                                       const winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection& connection);
@@ -303,6 +313,9 @@ namespace winrt::TerminalApp::implementation
 
         void _StartInboundListener();
 
+        void _LaunchStartupConnection();
+        static winrt::fire_and_forget _LaunchConnectionInBackground(winrt::Microsoft::Terminal::TerminalConnection::ConptyConnection connection);
+
         void _CompleteInitialization();
 
         void _FocusActiveControl(IInspectable sender, IInspectable eventArgs);
@@ -232,6 +232,18 @@ namespace winrt::TerminalApp::implementation
         _UpdateHeaderControlMaxWidth();
     }
 
+    // Method Description:
+    // - Informs all the controls in this tab's tree of panes that the window
+    //   was hidden from or shown to the user.
+    // Arguments:
+    // - showOrHide: true if the window is visible
+    // Return Value:
+    // - <none>
+    void TerminalTab::WindowVisibilityChanged(const bool showOrHide)
+    {
+        _rootPane->WindowVisibilityChanged(showOrHide);
+    }
+
     // Method Description:
     // - Set the icon on the TabViewItem for this tab.
     // Arguments:
@@ -842,21 +854,6 @@ namespace winrt::TerminalApp::implementation
         chooseColorMenuItem.Text(RS_(L"TabColorChoose"));
         chooseColorMenuItem.Icon(colorPickSymbol);
 
-        // Color Picker (it's convenient to have it here)
-        _tabColorPickup.ColorSelected([weakThis](auto newTabColor) {
-            if (auto tab{ weakThis.get() })
-            {
-                tab->SetRuntimeTabColor(newTabColor);
-            }
-        });
-
-        _tabColorPickup.ColorCleared([weakThis]() {
-            if (auto tab{ weakThis.get() })
-            {
-                tab->ResetRuntimeTabColor();
-            }
-        });
-
         Controls::MenuFlyoutItem renameTabMenuItem;
         {
             // "Rename Tab"
@@ -1110,6 +1107,28 @@ namespace winrt::TerminalApp::implementation
     // - <none>
     void TerminalTab::ActivateColorPicker()
     {
+        // The color picker is a whole flyout full of controls, which most
+        // tabs never show, so it's only created once it's needed.
+        if (!_tabColorPickup)
+        {
+            auto weakThis{ get_weak() };
+            _tabColorPickup = winrt::TerminalApp::ColorPickupFlyout{};
+
+            _tabColorPickup.ColorSelected([weakThis](auto newTabColor) {
+                if (auto tab{ weakThis.get() })
+                {
+                    tab->SetRuntimeTabColor(newTabColor);
+                }
+            });
+
+            _tabColorPickup.ColorCleared([weakThis]() {
+                if (auto tab{ weakThis.get() })
+                {
+                    tab->ResetRuntimeTabColor();
+                }
+            });
+        }
+
         _tabColorPickup.ShowAt(TabViewItem());
     }
 
@@ -1243,6 +1262,19 @@ namespace winrt::TerminalApp::implementation
         return _activePane;
     }
 
+    // Method Description:
+    // - Gets the controls of all the panes in this tab.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The ID and the control of every leaf pane, in the order they're laid out in.
+    std::vector<std::pair<uint32_t, TermControl>> TerminalTab::GetTerminalControls() const
+    {
+        std::vector<std::pair<uint32_t, TermControl>> controls;
+        _rootPane->CollectTerminalControls(controls);
+        return controls;
+    }
+
     // Method Description:
     // - Creates a text for the title run in the tool tip by returning tab title
     // or <profile name>: <tab title> in the case the profile name differs from the title
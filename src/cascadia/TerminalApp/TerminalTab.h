@@ -57,6 +57,7 @@ namespace winrt::TerminalApp::implementation
 
         void UpdateSettings(const Microsoft::Terminal::Settings::Model::TerminalSettingsCreateResult& settings, const GUID& profile);
         winrt::fire_and_forget UpdateTitle();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         void Shutdown() override;
         void ClosePane();
@@ -81,6 +82,7 @@ namespace winrt::TerminalApp::implementation
 
         void TogglePaneReadOnly();
         std::shared_ptr<Pane> GetActivePane() const;
+        std::vector<std::pair<uint32_t, winrt::Microsoft::Terminal::Control::TermControl>> GetTerminalControls() const;
 
         winrt::TerminalApp::TerminalTabStatus TabStatus()
         {
@@ -99,7 +101,7 @@ namespace winrt::TerminalApp::implementation
         std::shared_ptr<Pane> _activePane{ nullptr };
         std::shared_ptr<Pane> _zoomedPane{ nullptr };
         winrt::hstring _lastIconPath{};
-        winrt::TerminalApp::ColorPickupFlyout _tabColorPickup{};
+        winrt::TerminalApp::ColorPickupFlyout _tabColorPickup{ nullptr };
         std::optional<winrt::Windows::UI::Color> _themeTabColor{};
         std::optional<winrt::Windows::UI::Color> _runtimeTabColor{};
         winrt::TerminalApp::TabHeaderControl _headerControl{};
@@ -28,6 +28,10 @@ static constexpr int CurrentCredentialVersion = 1;
 static constexpr auto PasswordVaultResourceName = L"Terminal";
 static constexpr auto HttpUserAgent = L"Terminal/0.0";
 
+// Websocket messages that already arrived are converted and passed to our
+// handlers together, up to this many bytes at a time.
+static constexpr size_t MaxCoalescedOutputSize = 128 * 1024;
+
 static constexpr int USER_INPUT_COLOR = 93; // yellow - the color of something the user can type
 static constexpr int USER_INFO_COLOR = 97; // white - the color of clarifying information
 
@@ -380,35 +384,55 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                 case AzureState::TermConnected:
                 {
                     _transitionToState(ConnectionState::Connected);
-                    while (true)
-                    {
-                        // Read from websocket
-                        pplx::task<websocket_incoming_message> msgT;
-                        try
+
+                    // The messages are collected in this buffer, which keeps its
+                    // capacity from one batch to the next. _u8State carries UTF-8
+                    // sequences that were split between messages over to the next batch.
+                    std::string output;
+                    const auto flushOutput = [&]() {
+                        // An empty chunk converts possible remaining partials to U+FFFD instead.
+                        THROW_IF_FAILED(til::u8u16(output, _u16Str, _u8State));
+                        output.clear();
+                        if (!_u16Str.empty())
                         {
-                            msgT = _cloudShellSocket.receive();
-                            msgT.wait();
+                            // Pass the output to our registered event handlers
+                            _TerminalOutputHandlers(_u16Str);
                         }
-                        catch (...)
+                    };
+
+                    // The next message is always received while the previous
+                    // ones are being processed. If it has already arrived by
+                    // then, it's appended to them instead of being passed to
+                    // our handlers on its own. There's never more than one
+                    // receive in flight, so none of them is left unobserved.
+                    auto msgT = _cloudShellSocket.receive();
+                    while (true)
+                    {
+                        do
                         {
-                            // Websocket has been closed; consider it a graceful exit?
-                            // This should result in our termination.
-                            if (_transitionToState(ConnectionState::Closed))
+                            websocket_incoming_message msg;
+                            try
                             {
-                                // End the output thread.
-                                return S_FALSE;
+                                msg = msgT.get();
+                            }
+                            catch (...)
+                            {
+                                // Websocket has been closed; consider it a graceful exit?
+                                // This should result in our termination.
+                                flushOutput();
+                                if (_transitionToState(ConnectionState::Closed))
+                                {
+                                    // End the output thread.
+                                    return S_FALSE;
+                                }
+                                throw;
                             }
-                        }
-
-                        auto msg = msgT.get();
-                        auto msgStringTask = msg.extract_string();
-                        auto msgString = msgStringTask.get();
 
-                        // Convert to hstring
-                        const auto hstr = winrt::to_hstring(msgString);
+                            output.append(msg.extract_string().get());
+                            msgT = _cloudShellSocket.receive();
+                        } while (msgT.is_done() && output.size() < MaxCoalescedOutputSize);
 
-                        // Pass the output to our registered event handlers
-                        _TerminalOutputHandlers(hstr);
+                        flushOutput();
                     }
                     return S_OK;
                 }
@@ -95,6 +95,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         std::optional<std::wstring> _ReadUserInput(InputMode mode);
 
         web::websockets::client::websocket_client _cloudShellSocket;
+        til::u8state _u8State{};
+        std::wstring _u16Str;
 
         static std::optional<utility::string_t> _ParsePreferredShellType(const web::json::value& settingsResponse);
     };
@@ -34,8 +34,17 @@ using namespace ::Microsoft::Console;
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
+    // The output thread starts out reading MinReadSize bytes at a time. Whenever a
+    // read fills the whole request, the next one asks for twice as much (up to
+    // MaxReadSize), so that floods of output take fewer reads. Once the output
+    // calms down, the read size shrinks back again.
+    static constexpr size_t MinReadSize{ 4 * 1024 };
+    static constexpr size_t MaxReadSize{ 128 * 1024 };
+
+    static constexpr DWORD PseudoConsoleFlags{ PSEUDOCONSOLE_RESIZE_QUIRK | PSEUDOCONSOLE_WIN32_INPUT_MODE | PSEUDOCONSOLE_RESIZE_NEGOTIATED };
+
     // Function Description:
-    // - creates some basic anonymous pipes and passes them to CreatePseudoConsole
+    // - creates some basic pipes and passes them to CreatePseudoConsole
     // Arguments:
     // - size: The size of the conpty to create, in characters.
     // - phInput: Receives the handle to the newly-created anonymous pipe for writing input to the conpty.
@@ -50,13 +59,311 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_hfile inPipeOurSide, inPipePseudoConsoleSide;
 
         RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&inPipePseudoConsoleSide, &inPipeOurSide, nullptr, 0));
-        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&outPipeOurSide, &outPipePseudoConsoleSide, nullptr, 0));
+
+        // Anonymous pipes don't support overlapped I/O, which our output thread
+        // relies on to read the next chunk while the previous one is processed.
+        // So our side of the output pipe is the server end of a named pipe instead.
+        try
+        {
+            const auto pipeName{ fmt::format(L"\\\\.\\pipe\\conpty-output-{}-{}", GetCurrentProcessId(), Utils::GuidToString(Utils::CreateGuid())) };
+            outPipeOurSide.reset(CreateNamedPipeW(pipeName.c_str(),
+                                                  PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+                                                  PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                                  1,
+                                                  0,
+                                                  gsl::narrow_cast<DWORD>(MaxReadSize),
+                                                  0,
+                                                  nullptr));
+            RETURN_LAST_ERROR_IF(!outPipeOurSide);
+
+            outPipePseudoConsoleSide.reset(CreateFileW(pipeName.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr));
+            RETURN_LAST_ERROR_IF(!outPipePseudoConsoleSide);
+        }
+        CATCH_RETURN();
+
         RETURN_IF_FAILED(ConptyCreatePseudoConsole(size, inPipePseudoConsoleSide.get(), outPipePseudoConsoleSide.get(), dwFlags, phPC));
         *phInput = inPipeOurSide.release();
         *phOutput = outPipeOurSide.release();
         return S_OK;
     }
 
+    // Pseudoconsoles that were created ahead of time, see PrewarmPseudoConsoles.
+    // Their hosts sit idle until a client attaches.
+    struct PrewarmedPseudoConsole
+    {
+        wil::unique_hfile inPipe;
+        wil::unique_hfile outPipe;
+        wil::unique_static_pseudoconsole_handle hPC;
+        COORD size;
+    };
+
+    struct PrewarmedPseudoConsolePool
+    {
+        std::mutex mutex;
+        std::vector<PrewarmedPseudoConsole> pseudoConsoles;
+        size_t count{ 0 };
+        COORD size{ 80, 25 };
+        bool refilling{ false };
+    };
+
+    // The pool is never destroyed. Closing a pseudoconsole waits for its host
+    // to exit, which can't happen while the module unloads. Their hosts exit
+    // on their own, once the process is gone and their pipes break.
+    static PrewarmedPseudoConsolePool& _GetPrewarmedPool()
+    {
+        static auto* const pool = new PrewarmedPseudoConsolePool();
+        return *pool;
+    }
+
+    // Method Description:
+    // - Keeps the given number of pseudoconsoles created ahead of time, so that
+    //   starting a connection only has to launch its client.
+    // - Only the pseudoconsoles are created ahead, not their clients: those
+    //   depend on the profile's commandline, directory and environment.
+    // Arguments:
+    // - count: the number of pseudoconsoles to keep around. 0 turns this off.
+    // - rows, columns: the size to create them with. Connections of a different
+    //   size resize the pseudoconsole they take before their client attaches.
+    void ConptyConnection::PrewarmPseudoConsoles(const uint32_t count, const uint32_t rows, const uint32_t columns)
+    {
+        std::vector<PrewarmedPseudoConsole> discarded;
+        bool refill = false;
+        {
+            auto& pool = _GetPrewarmedPool();
+            std::lock_guard lock{ pool.mutex };
+
+            pool.count = count;
+            pool.size = { gsl::narrow_cast<SHORT>(columns), gsl::narrow_cast<SHORT>(rows) };
+            while (pool.pseudoConsoles.size() > pool.count)
+            {
+                discarded.emplace_back(std::move(pool.pseudoConsoles.back()));
+                pool.pseudoConsoles.pop_back();
+            }
+
+            refill = pool.pseudoConsoles.size() < pool.count && !pool.refilling;
+            pool.refilling = pool.refilling || refill;
+        }
+
+        if (refill &&
+            !TrySubmitThreadpoolCallback([](PTP_CALLBACK_INSTANCE, PVOID) noexcept { _RefillPrewarmedPseudoConsoles(); }, nullptr, nullptr))
+        {
+            LOG_LAST_ERROR();
+            auto& pool = _GetPrewarmedPool();
+            std::lock_guard lock{ pool.mutex };
+            pool.refilling = false;
+        }
+    }
+
+    // Method Description:
+    // - Creates pseudoconsoles until the pool is full again. Runs on the thread pool.
+    void ConptyConnection::_RefillPrewarmedPseudoConsoles() noexcept
+    {
+        auto& pool = _GetPrewarmedPool();
+        for (;;)
+        {
+            COORD size;
+            {
+                std::lock_guard lock{ pool.mutex };
+                if (pool.pseudoConsoles.size() >= pool.count)
+                {
+                    pool.refilling = false;
+                    return;
+                }
+                size = pool.size;
+            }
+
+            PrewarmedPseudoConsole pseudoConsole{};
+            pseudoConsole.size = size;
+            const auto hr = _CreatePseudoConsoleAndPipes(size, PseudoConsoleFlags, &pseudoConsole.inPipe, &pseudoConsole.outPipe, &pseudoConsole.hPC);
+
+            std::lock_guard lock{ pool.mutex };
+            if (FAILED(hr))
+            {
+                // Connections just create their own pseudoconsole until the next refill.
+                LOG_HR(hr);
+                pool.refilling = false;
+                return;
+            }
+
+            try
+            {
+                pool.pseudoConsoles.emplace_back(std::move(pseudoConsole));
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION();
+                pool.refilling = false;
+                return;
+            }
+        }
+    }
+
+    // Method Description:
+    // - Takes a pseudoconsole out of the pool for this connection, if there is
+    //   one, and starts refilling the pool in the background.
+    // Arguments:
+    // - size: the size this connection wants its pseudoconsole to be.
+    // Return Value:
+    // - true if the connection got its pipes and pseudoconsole from the pool.
+    bool ConptyConnection::_TakePrewarmedPseudoConsole(const COORD size)
+    {
+        PrewarmedPseudoConsole pseudoConsole{};
+        uint32_t count;
+        COORD poolSize;
+        {
+            auto& pool = _GetPrewarmedPool();
+            std::lock_guard lock{ pool.mutex };
+            if (pool.pseudoConsoles.empty())
+            {
+                return false;
+            }
+
+            pseudoConsole = std::move(pool.pseudoConsoles.back());
+            pool.pseudoConsoles.pop_back();
+            count = gsl::narrow_cast<uint32_t>(pool.count);
+            poolSize = pool.size;
+        }
+
+        PrewarmPseudoConsoles(count, poolSize.Y, poolSize.X);
+
+        if (pseudoConsole.size.X != size.X || pseudoConsole.size.Y != size.Y)
+        {
+            THROW_IF_FAILED(ConptyResizePseudoConsole(pseudoConsole.hPC.get(), size));
+        }
+
+        _inPipe = std::move(pseudoConsole.inPipe);
+        _outPipe = std::move(pseudoConsole.outPipe);
+        _hPC = std::move(pseudoConsole.hPC);
+        return true;
+    }
+
+    // Method Description:
+    // - Creates the pseudoconsole and launches the client ahead of Start, so
+    //   that the client can start up while the terminal is still being set
+    //   up. Whatever the client writes waits in the output pipe until Start
+    //   starts reading it, so no output is lost. This blocks for as long as
+    //   creating the processes takes, so it shouldn't be called on the UI
+    //   thread. It does nothing once the connection was started or closed.
+    // - Start resizes the pseudoconsole if the size the client was launched
+    //   with was changed by the time the connection is started.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ConptyConnection::Launch()
+    try
+    {
+        std::lock_guard lock{ _launchLock };
+        if (_inPipe || !_isStateOneOf(ConnectionState::NotConnected))
+        {
+            return;
+        }
+
+        // If anything fails, Start tries again and reports the failure.
+        auto cleanup = wil::scope_exit([&]() noexcept {
+            _piClient.reset();
+            _hPC.reset();
+            _inPipe.reset();
+            _outPipe.reset();
+        });
+
+        const COORD dimensions{ gsl::narrow_cast<SHORT>(_initialCols), gsl::narrow_cast<SHORT>(_initialRows) };
+        if (!_TakePrewarmedPseudoConsole(dimensions))
+        {
+            THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(dimensions, PseudoConsoleFlags, &_inPipe, &_outPipe, &_hPC));
+        }
+        _outPipeOverlapped = true;
+        THROW_IF_FAILED(_LaunchAttachedClient());
+
+        cleanup.release();
+        _launched = true;
+        _launchedSize = dimensions;
+        _startTime = std::chrono::high_resolution_clock::now();
+    }
+    CATCH_LOG()
+
+    static void _ZeroEnvironmentValues(Utils::EnvironmentVariableMapW& environment) noexcept
+    {
+        // Can't zero the keys, but at least we can zero the values.
+        for (auto& [name, value] : environment)
+        {
+            ::SecureZeroMemory(value.data(), value.size() * sizeof(decltype(value.begin())::value_type));
+        }
+    }
+
+    static void _DeleteEnvironment(Utils::EnvironmentVariableMapW* environment) noexcept
+    {
+        _ZeroEnvironmentValues(*environment);
+        delete environment;
+    }
+
+    // The user's environment as CreateEnvironmentBlock builds it from the
+    // registry. Building it means reading and expanding the user and system
+    // environment, so it's done once and reused for every client we launch,
+    // until ReloadEnvironmentVariables throws it away.
+    struct BaseEnvironmentCache
+    {
+        std::mutex mutex;
+        std::shared_ptr<const Utils::EnvironmentVariableMapW> environment;
+    };
+
+    static BaseEnvironmentCache& _GetBaseEnvironmentCache()
+    {
+        static BaseEnvironmentCache cache;
+        return cache;
+    }
+
+    // Function Description:
+    // - Returns the cached base environment, building it first if needed.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - the environment every client starts out with
+    static std::shared_ptr<const Utils::EnvironmentVariableMapW> _GetBaseEnvironment()
+    {
+        auto& cache = _GetBaseEnvironmentCache();
+        {
+            std::lock_guard lock{ cache.mutex };
+            if (cache.environment)
+            {
+                return cache.environment;
+            }
+        }
+
+        // Build it outside of the lock. Two connections starting at the same
+        // time may both do this, but they'd come up with the same result.
+        std::shared_ptr<Utils::EnvironmentVariableMapW> environment{ new Utils::EnvironmentVariableMapW(), &_DeleteEnvironment };
+        const auto newEnvironmentBlock{ Utils::CreateEnvironmentBlock() };
+        THROW_IF_FAILED(Utils::UpdateEnvironmentMapW(*environment, newEnvironmentBlock.get()));
+
+        std::lock_guard lock{ cache.mutex };
+        if (!cache.environment)
+        {
+            cache.environment = std::move(environment);
+        }
+        return cache.environment;
+    }
+
+    // Method Description:
+    // - Forgets the cached base environment, so that the next client we launch
+    //   sees the current user and system environment variables. Called when
+    //   the window receives the WM_SETTINGCHANGE "Environment" broadcast.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ConptyConnection::ReloadEnvironmentVariables()
+    {
+        auto& cache = _GetBaseEnvironmentCache();
+        std::shared_ptr<const Utils::EnvironmentVariableMapW> old;
+        {
+            std::lock_guard lock{ cache.mutex };
+            old = std::move(cache.environment);
+        }
+        // old is zeroed and freed here, outside of the lock, unless a
+        // launch in progress still holds on to it.
+    }
+
     // Function Description:
     // - launches the client application attached to the new pseudoconsole
     HRESULT ConptyConnection::_LaunchAttachedClient() noexcept
@@ -84,23 +391,14 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         std::wstring cmdline{ wil::ExpandEnvironmentStringsW<std::wstring>(_commandline.c_str()) }; // mutable copy -- required for CreateProcessW
 
-        Utils::EnvironmentVariableMapW environment;
+        // Start out with the user's environment and only apply our own
+        // variables on top of it.
+        Utils::EnvironmentVariableMapW environment{ *_GetBaseEnvironment() };
         auto zeroEnvMap = wil::scope_exit([&]() noexcept {
-            // Can't zero the keys, but at least we can zero the values.
-            for (auto& [name, value] : environment)
-            {
-                ::SecureZeroMemory(value.data(), value.size() * sizeof(decltype(value.begin())::value_type));
-            }
-
+            _ZeroEnvironmentValues(environment);
             environment.clear();
         });
 
-        {
-            const auto newEnvironmentBlock{ Utils::CreateEnvironmentBlock() };
-            // Populate the environment map with the current environment.
-            RETURN_IF_FAILED(Utils::UpdateEnvironmentMapW(environment, newEnvironmentBlock.get()));
-        }
-
         {
             // Convert connection Guid to string and ignore the enclosing '{}'.
             std::wstring wsGuid{ Utils::GuidToString(_guid) };
@@ -206,9 +504,10 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         _guid{},
         _u8State{},
         _u16Str{},
-        _buffer{},
+        _buffers{},
         _inPipe{ hIn },
-        _outPipe{ hOut }
+        _outPipe{ hOut },
+        _outPipeOverlapped{ false }
     {
         THROW_IF_FAILED(ConptyPackPseudoConsole(hServerProcess, hRef, hSig, &_hPC));
         if (_guid == guid{})
@@ -235,7 +534,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         _guid{ initialGuid },
         _u8State{},
         _u16Str{},
-        _buffer{}
+        _buffers{}
     {
         if (_guid == guid{})
         {
@@ -253,14 +552,41 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     {
         _transitionToState(ConnectionState::Connecting);
 
-        if (!_inPipe)
         {
+            // This waits for Launch, if it's still launching the client on another thread.
+            std::lock_guard lock{ _launchLock };
             const COORD dimensions{ gsl::narrow_cast<SHORT>(_initialCols), gsl::narrow_cast<SHORT>(_initialRows) };
-            THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(dimensions, PSEUDOCONSOLE_RESIZE_QUIRK | PSEUDOCONSOLE_WIN32_INPUT_MODE, &_inPipe, &_outPipe, &_hPC));
-            THROW_IF_FAILED(_LaunchAttachedClient());
+            if (!_inPipe)
+            {
+                if (!_TakePrewarmedPseudoConsole(dimensions))
+                {
+                    THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(dimensions, PseudoConsoleFlags, &_inPipe, &_outPipe, &_hPC));
+                }
+                _outPipeOverlapped = true;
+                THROW_IF_FAILED(_LaunchAttachedClient());
+                _startTime = std::chrono::high_resolution_clock::now();
+            }
+            else if (_launched)
+            {
+                // The terminal has usually found its actual size since the
+                // client was launched at the size of the settings.
+                if (_launchedSize.X != dimensions.X || _launchedSize.Y != dimensions.Y)
+                {
+                    THROW_IF_FAILED(ConptyResizePseudoConsole(_hPC.get(), dimensions));
+                }
+            }
+            else
+            {
+                _startTime = std::chrono::high_resolution_clock::now();
+            }
         }
 
-        _startTime = std::chrono::high_resolution_clock::now();
+        // The output thread reads into these. Only overlapped reads use both of them.
+        til::at(_buffers, 0).resize(MaxReadSize);
+        if (_outPipeOverlapped)
+        {
+            til::at(_buffers, 1).resize(MaxReadSize);
+        }
 
         // Create our own output handling thread
         // This must be done after the pipes are populated.
@@ -387,8 +713,10 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
     void ConptyConnection::Resize(uint32_t rows, uint32_t columns)
     {
-        if (!_hPC)
+        if (!_isStateAtOrBeyond(ConnectionState::Connecting))
         {
+            // Start resizes the pseudoconsole to this, if Launch already created it.
+            std::lock_guard lock{ _launchLock };
             _initialRows = rows;
             _initialCols = columns;
         }
@@ -403,6 +731,9 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     {
         if (_transitionToState(ConnectionState::Closing))
         {
+            // Launch mustn't be creating what we're about to tear down.
+            std::lock_guard lock{ _launchLock };
+
             // EXIT POINT
             _clientExitWait.reset(); // immediately stop waiting for the client to exit.
 
@@ -431,72 +762,264 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     }
     CATCH_LOG()
 
+    // Method Description:
+    // - converts a chunk of the output to UTF-16 and passes it to our handlers
+    // Arguments:
+    // - chunk: the bytes read from the output pipe. When empty, possible remaining
+    //   partials are converted to U+FFFD instead.
+    // - exitCode: receives the exit code of the output thread, if it should exit.
+    // Return Value:
+    // - true if the output thread should keep reading, false if it should exit.
+    bool ConptyConnection::_ProcessOutput(const std::string_view chunk, DWORD& exitCode)
+    {
+        exitCode = 0;
+
+        _outputStatistics.chunks++;
+        _outputStatistics.bytes += chunk.size();
+
+        const auto convertStart = std::chrono::steady_clock::now();
+        const HRESULT result{ til::u8u16(chunk, _u16Str, _u8State) };
+        _outputStatistics.convert += std::chrono::steady_clock::now() - convertStart;
+        if (FAILED(result))
+        {
+            if (_isStateAtOrBeyond(ConnectionState::Closing))
+            {
+                // This termination was expected.
+                return false;
+            }
+
+            // EXIT POINT
+            _indicateExitWithStatus(result); // print a message
+            _transitionToState(ConnectionState::Failed);
+            exitCode = gsl::narrow_cast<DWORD>(result);
+            return false;
+        }
+
+        if (_u16Str.empty())
+        {
+            return false;
+        }
+
+        if (!_receivedFirstByte)
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::chrono::duration<double> delta = now - _startTime;
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+            TraceLoggingWrite(g_hTerminalConnectionProvider,
+                              "ReceivedFirstByte",
+                              TraceLoggingDescription("An event emitted when the connection receives the first byte"),
+                              TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
+                              TraceLoggingFloat64(delta.count(), "Duration"),
+                              TraceLoggingFloat64(Utils::TimeSinceProcessStart().count(), "SinceProcessStart", "Seconds since the terminal process was created, the time to the first prompt for the first tab"),
+                              TraceLoggingBool(_launched, "LaunchedEarly", "Whether the client was launched ahead of Start"),
+                              TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                              TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+            _receivedFirstByte = true;
+        }
+
+        // Pass the output to our registered event handlers
+        const auto handlersStart = std::chrono::steady_clock::now();
+        _TerminalOutputHandlers(_u16Str);
+        _outputStatistics.handlers += std::chrono::steady_clock::now() - handlersStart;
+
+        _TraceOutputStatistics();
+        return true;
+    }
+
+    // Method Description:
+    // - Traces the statistics of the output thread and starts over, if it's
+    //   been ThroughputTraceInterval since the last time they were traced.
+    // - Only called on the output thread.
+    void ConptyConnection::_TraceOutputStatistics() noexcept
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalConnectionProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto interval = now - _outputStatisticsSince;
+        if (interval < ThroughputTraceInterval)
+        {
+            return;
+        }
+
+        const auto statistics = std::exchange(_outputStatistics, {});
+        _outputStatisticsSince = now;
+
+        const auto count = [](const auto duration) noexcept {
+            return gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        };
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalConnectionProvider,
+                          "OutputThroughput",
+                          TraceLoggingDescription("Where the output of the connection spent its time since the last event"),
+                          TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
+                          TraceLoggingUInt64(count(interval), "intervalNs", "The time since the last event"),
+                          TraceLoggingUInt64(statistics.chunks, "chunks", "The number of chunks read from the output pipe"),
+                          TraceLoggingUInt64(statistics.bytes, "bytes", "The number of bytes read from the output pipe"),
+                          TraceLoggingUInt64(count(statistics.read), "readNs", "The time spent waiting for the output pipe"),
+                          TraceLoggingUInt64(count(statistics.convert), "convertNs", "The time spent converting UTF-8 to UTF-16"),
+                          TraceLoggingUInt64(count(statistics.handlers), "handlersNs", "The time spent handing the output to the terminal"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
     DWORD ConptyConnection::_OutputThread()
     {
         // Keep us alive until the output thread terminates; the destructor
         // won't wait for us, and the known exit points _do_.
         auto strongThis{ get_strong() };
 
-        // process the data of the output pipe in a loop
-        while (true)
+        // Grow the read size while the reads come back full and shrink it again once they don't.
+        size_t readSize{ MinReadSize };
+        const auto adaptReadSize = [&](const size_t requested, const DWORD read) noexcept {
+            if (read == requested)
+            {
+                readSize = std::min(requested * 2, MaxReadSize);
+            }
+            else if (read < requested / 4)
+            {
+                readSize = std::max(requested / 2, MinReadSize);
+            }
+        };
+
+        // Returns the exit code of the output thread after a failed read.
+        const auto readFailed = [&](const DWORD lastError) {
+            if (lastError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
+            {
+                // EXIT POINT
+                _indicateExitWithStatus(HRESULT_FROM_WIN32(lastError)); // print a message
+                _transitionToState(ConnectionState::Failed);
+                return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(lastError));
+            }
+
+            // convert possible remaining partials to U+FFFD
+            DWORD exitCode{};
+            _ProcessOutput({}, exitCode);
+            return exitCode;
+        };
+
+        if (!_outPipeOverlapped)
         {
-            DWORD read{};
+            auto& buffer{ til::at(_buffers, 0) };
 
-            const auto readFail{ !ReadFile(_outPipe.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &read, nullptr) };
-            if (readFail) // reading failed (we must check this first, because read will also be 0.)
+            // process the data of the output pipe in a loop
+            while (true)
             {
-                const auto lastError = GetLastError();
-                if (lastError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
+                const auto requested{ readSize };
+                DWORD read{};
+
+                const auto readStart = std::chrono::steady_clock::now();
+                if (!ReadFile(_outPipe.get(), buffer.data(), gsl::narrow_cast<DWORD>(requested), &read, nullptr))
+                {
+                    return readFailed(GetLastError());
+                }
+                _outputStatistics.read += std::chrono::steady_clock::now() - readStart;
+
+                adaptReadSize(requested, read);
+
+                DWORD exitCode{};
+                if (!_ProcessOutput({ buffer.data(), read }, exitCode))
+                {
+                    return exitCode;
+                }
+            }
+        }
+
+        // With overlapped I/O, the next chunk is read into one buffer while the
+        // previous chunk in the other one is converted and passed to our handlers.
+        std::array<wil::unique_event, 2> events;
+        std::array<OVERLAPPED, 2> overlapped{};
+        std::array<size_t, 2> requested{};
+        std::array<DWORD, 2> errors{};
+        std::array<bool, 2> pending{};
+
+        for (size_t slot = 0; slot < events.size(); ++slot)
+        {
+            if (!til::at(events, slot).try_create(wil::EventOptions::ManualReset, nullptr))
+            {
+                return readFailed(GetLastError());
+            }
+            til::at(overlapped, slot).hEvent = til::at(events, slot).get();
+        }
+
+        // The buffers and OVERLAPPED structs must outlive any read that's still in flight.
+        auto cancelReads = wil::scope_exit([&]() noexcept {
+            for (size_t slot = 0; slot < pending.size(); ++slot)
+            {
+                if (til::at(pending, slot))
                 {
-                    // EXIT POINT
-                    _indicateExitWithStatus(HRESULT_FROM_WIN32(lastError)); // print a message
-                    _transitionToState(ConnectionState::Failed);
-                    return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(lastError));
+                    DWORD read{};
+                    CancelIoEx(_outPipe.get(), &til::at(overlapped, slot));
+                    GetOverlappedResult(_outPipe.get(), &til::at(overlapped, slot), &read, TRUE);
                 }
-                // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
             }
+        });
 
-            const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
-            if (FAILED(result))
+        const auto startRead = [&](const size_t slot) noexcept {
+            auto& ov{ til::at(overlapped, slot) };
+            const auto event{ ov.hEvent };
+            ov = {};
+            ov.hEvent = event;
+
+            til::at(requested, slot) = readSize;
+            til::at(errors, slot) = ERROR_SUCCESS;
+            if (!ReadFile(_outPipe.get(), til::at(_buffers, slot).data(), gsl::narrow_cast<DWORD>(readSize), nullptr, &ov))
             {
-                if (_isStateAtOrBeyond(ConnectionState::Closing))
+                const auto lastError = GetLastError();
+                if (lastError != ERROR_IO_PENDING)
                 {
-                    // This termination was expected.
-                    return 0;
+                    til::at(errors, slot) = lastError;
+                    return;
                 }
+            }
+            til::at(pending, slot) = true;
+        };
 
-                // EXIT POINT
-                _indicateExitWithStatus(result); // print a message
-                _transitionToState(ConnectionState::Failed);
-                return gsl::narrow_cast<DWORD>(result);
+        const auto finishRead = [&](const size_t slot, DWORD& read) noexcept {
+            read = 0;
+            if (!til::at(pending, slot))
+            {
+                return til::at(errors, slot);
             }
 
-            if (_u16Str.empty())
+            til::at(pending, slot) = false;
+            if (!GetOverlappedResult(_outPipe.get(), &til::at(overlapped, slot), &read, TRUE))
             {
-                return 0;
+                return GetLastError();
             }
+            return static_cast<DWORD>(ERROR_SUCCESS);
+        };
+
+        size_t slot{ 0 };
+        startRead(slot);
 
-            if (!_receivedFirstByte)
+        // process the data of the output pipe in a loop
+        while (true)
+        {
+            DWORD read{};
+            const auto readStart = std::chrono::steady_clock::now();
+            const auto lastError = finishRead(slot, read);
+            if (lastError != ERROR_SUCCESS)
             {
-                const auto now = std::chrono::high_resolution_clock::now();
-                const std::chrono::duration<double> delta = now - _startTime;
+                return readFailed(lastError);
+            }
+            _outputStatistics.read += std::chrono::steady_clock::now() - readStart;
 
-#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
-                TraceLoggingWrite(g_hTerminalConnectionProvider,
-                                  "ReceivedFirstByte",
-                                  TraceLoggingDescription("An event emitted when the connection receives the first byte"),
-                                  TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
-                                  TraceLoggingFloat64(delta.count(), "Duration"),
-                                  TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-                                  TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
-                _receivedFirstByte = true;
+            adaptReadSize(til::at(requested, slot), read);
+            startRead(slot ^ 1);
+
+            DWORD exitCode{};
+            if (!_ProcessOutput({ til::at(_buffers, slot).data(), read }, exitCode))
+            {
+                return exitCode;
             }
 
-            // Pass the output to our registered event handlers
-            _TerminalOutputHandlers(_u16Str);
+            slot ^= 1;
         }
-
-        return 0;
     }
 
     static winrt::event<NewConnectionHandler> _newConnectionHandlers;
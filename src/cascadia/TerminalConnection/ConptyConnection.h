@@ -37,6 +37,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         static winrt::fire_and_forget final_release(std::unique_ptr<ConptyConnection> connection);
 
         void Start();
+        void Launch();
         void WriteInput(hstring const& data);
         void Resize(uint32_t rows, uint32_t columns);
         void Close() noexcept;
@@ -46,6 +47,9 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         static void StartInboundListener();
         static void StopInboundListener();
 
+        static void PrewarmPseudoConsoles(const uint32_t count, const uint32_t rows, const uint32_t columns);
+        static void ReloadEnvironmentVariables();
+
         static winrt::event_token NewConnection(NewConnectionHandler const& handler);
         static void NewConnection(winrt::event_token const& token);
 
@@ -53,6 +57,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
     private:
         HRESULT _LaunchAttachedClient() noexcept;
+        bool _TakePrewarmedPseudoConsole(const COORD size);
+        static void _RefillPrewarmedPseudoConsoles() noexcept;
         void _indicateExitWithStatus(unsigned int status) noexcept;
         void _ClientTerminated() noexcept;
 
@@ -67,11 +73,18 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         guid _guid{}; // A unique session identifier for connected client
         hstring _clientName{}; // The name of the process hosted by this ConPTY connection (as of launch).
 
+        // Guards the creation of the pseudoconsole and the client by Launch,
+        // which may run on another thread than the rest of the connection.
+        std::mutex _launchLock;
+        bool _launched{ false };
+        COORD _launchedSize{};
+
         bool _receivedFirstByte{ false };
         std::chrono::high_resolution_clock::time_point _startTime{};
 
         wil::unique_hfile _inPipe; // The pipe for writing input to
         wil::unique_hfile _outPipe; // The pipe for reading output from
+        bool _outPipeOverlapped{ false }; // Whether _outPipe was opened for overlapped I/O
         wil::unique_handle _hOutputThread;
         wil::unique_process_information _piClient;
         wil::unique_static_pseudoconsole_handle _hPC;
@@ -79,9 +92,25 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         til::u8state _u8State;
         std::wstring _u16Str;
-        std::array<char, 4096> _buffer;
+        std::array<std::vector<char>, 2> _buffers;
+
+        // Where the output thread spends its time, traced as "OutputThroughput"
+        // at most every ThroughputTraceInterval while the provider is enabled.
+        static constexpr std::chrono::seconds ThroughputTraceInterval{ 1 };
+        struct OutputStatistics
+        {
+            uint64_t chunks = 0;
+            uint64_t bytes = 0;
+            std::chrono::nanoseconds read{}; // waiting for the output pipe
+            std::chrono::nanoseconds convert{}; // UTF-8 to UTF-16
+            std::chrono::nanoseconds handlers{}; // handing the output to the terminal
+        };
+        OutputStatistics _outputStatistics;
+        std::chrono::steady_clock::time_point _outputStatisticsSince{ std::chrono::steady_clock::now() };
 
         DWORD _OutputThread();
+        bool _ProcessOutput(const std::string_view chunk, DWORD& exitCode);
+        void _TraceOutputStatistics() noexcept;
     };
 }
 
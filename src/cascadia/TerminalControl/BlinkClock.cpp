@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "BlinkClock.h"
+#include "ControlCore.h"
+
+namespace winrt::Microsoft::Terminal::Control::implementation
+{
+    // Method Description:
+    // - Returns the clock shared by all the controls, creating it if there
+    //   isn't one yet. It uses the caret blink time of the system, and only
+    //   blinks text if client area animations are enabled.
+    std::shared_ptr<BlinkClock> BlinkClock::Get()
+    {
+        static std::mutex lock;
+        static std::weak_ptr<BlinkClock> instance;
+
+        std::scoped_lock guard{ lock };
+        auto clock = instance.lock();
+        if (!clock)
+        {
+            const auto blinkTime = GetCaretBlinkTime();
+            BOOL animationsEnabled = TRUE;
+            SystemParametersInfoW(SPI_GETCLIENTAREAANIMATION, 0, &animationsEnabled, 0);
+
+            // An INFINITE blink time means that the user has disabled blinking.
+            // The interval is left at 0 then, which disables the clock.
+            const auto interval = blinkTime == INFINITE ? std::chrono::milliseconds::zero() : std::chrono::milliseconds(blinkTime);
+            clock = std::make_shared<BlinkClock>(interval, animationsEnabled != FALSE);
+            instance = clock;
+        }
+        return clock;
+    }
+
+    // Arguments:
+    // - interval: The time between two ticks. Zero disables blinking.
+    // - attributesEnabled: If false, blinking text isn't blinked.
+    BlinkClock::BlinkClock(const std::chrono::milliseconds interval, const bool attributesEnabled) :
+        _interval{ interval },
+        _attributesEnabled{ attributesEnabled && interval.count() > 0 }
+    {
+        if (_interval.count() > 0)
+        {
+            _timer.reset(CreateThreadpoolTimer(&BlinkClock::_timerCallback, this, nullptr));
+            THROW_LAST_ERROR_IF(!_timer);
+        }
+    }
+
+    // The timer is closed before anything else is destroyed, which cancels it
+    // and waits for the callback to return, if it's running.
+    BlinkClock::~BlinkClock()
+    {
+        _timer.reset();
+    }
+
+    // Method Description:
+    // - Returns false if the user disabled blinking, in which case the cursor
+    //   is never hidden.
+    bool BlinkClock::IsCursorBlinkEnabled() const noexcept
+    {
+        return _interval.count() > 0;
+    }
+
+    // Method Description:
+    // - Starts or stops blinking the cursor of the given core.
+    // Arguments:
+    // - core: The core whose cursor should blink.
+    // - blink: true while the control is focused.
+    // Return Value:
+    // - <none>
+    void BlinkClock::BlinkCursor(ControlCore* core, const bool blink)
+    {
+        if (!IsCursorBlinkEnabled())
+        {
+            return;
+        }
+
+        std::scoped_lock guard{ _lock };
+        auto& subscriber = _subscriber(core);
+        subscriber.cursor = blink;
+        subscriber.skipCursorTick = blink;
+        _updateTimer();
+    }
+
+    // Method Description:
+    // - Starts or stops blinking the text with the blinking attribute of the
+    //   given core. A core that doesn't have any blinking text on the screen
+    //   just advances its blinking cycle on every tick, without redrawing.
+    // Arguments:
+    // - core: The core whose text should blink.
+    // - blink: true while the control is visible.
+    // Return Value:
+    // - <none>
+    void BlinkClock::BlinkAttributes(ControlCore* core, const bool blink)
+    {
+        if (!_attributesEnabled)
+        {
+            return;
+        }
+
+        std::scoped_lock guard{ _lock };
+        _subscriber(core).attributes = blink;
+        _updateTimer();
+    }
+
+    // Method Description:
+    // - Leaves the cursor of the given core on for the next tick. The cores
+    //   call this whenever they show their cursor because of some input, so
+    //   that it doesn't flicker. It has the same effect as restarting a timer
+    //   of their own would have, without having one.
+    // Arguments:
+    // - core: The core whose cursor was just shown.
+    // Return Value:
+    // - <none>
+    void BlinkClock::RestartCursorBlink(ControlCore* core)
+    {
+        std::scoped_lock guard{ _lock };
+        for (auto& subscriber : _subscribers)
+        {
+            if (subscriber.core == core && subscriber.cursor)
+            {
+                subscriber.skipCursorTick = true;
+            }
+        }
+    }
+
+    // Method Description:
+    // - Stops blinking anything of the given core. If it's being ticked right
+    //   now, this waits until that's done, so the core is safe to destroy
+    //   once this returns.
+    // Arguments:
+    // - core: The core to remove.
+    // Return Value:
+    // - <none>
+    void BlinkClock::Remove(ControlCore* core)
+    {
+        std::scoped_lock guard{ _lock };
+        _subscribers.erase(std::remove_if(_subscribers.begin(), _subscribers.end(), [&](const auto& subscriber) {
+                               return subscriber.core == core;
+                           }),
+                           _subscribers.end());
+        _updateTimer();
+    }
+
+    // Method Description:
+    // - Blinks the cursors and the text of all the subscribers once. This is
+    //   called by the timer, on the threadpool.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void BlinkClock::Tick()
+    {
+        std::scoped_lock guard{ _lock };
+        for (auto& subscriber : _subscribers)
+        {
+            try
+            {
+                if (subscriber.cursor)
+                {
+                    if (subscriber.skipCursorTick)
+                    {
+                        subscriber.skipCursorTick = false;
+                    }
+                    else
+                    {
+                        subscriber.core->BlinkCursor();
+                    }
+                }
+                if (subscriber.attributes)
+                {
+                    subscriber.core->BlinkAttributeTick();
+                }
+            }
+            CATCH_LOG();
+        }
+    }
+
+    // Method Description:
+    // - Returns the subscription of the given core, adding one if it doesn't
+    //   have one yet. The caller must hold _lock.
+    BlinkClock::Subscriber& BlinkClock::_subscriber(ControlCore* core)
+    {
+        for (auto& subscriber : _subscribers)
+        {
+            if (subscriber.core == core)
+            {
+                return subscriber;
+            }
+        }
+        return _subscribers.emplace_back(Subscriber{ core, false, false, false });
+    }
+
+    // Method Description:
+    // - Drops the subscriptions that don't blink anything anymore, and starts
+    //   or stops the timer, depending on whether any are left. The caller must
+    //   hold _lock.
+    void BlinkClock::_updateTimer()
+    {
+        _subscribers.erase(std::remove_if(_subscribers.begin(), _subscribers.end(), [](const auto& subscriber) {
+                               return !subscriber.cursor && !subscriber.attributes;
+                           }),
+                           _subscribers.end());
+
+        const auto running = !_subscribers.empty();
+        if (!_timer || running == _running)
+        {
+            return;
+        }
+        _running = running;
+
+        if (_running)
+        {
+            // A negative due time is relative to now, in units of 100ns. The
+            // system may delay the ticks by a tenth of the interval, so it can
+            // coalesce them with other timers that are due around the same time.
+            const auto interval = gsl::narrow_cast<DWORD>(_interval.count());
+            ULARGE_INTEGER due{};
+            due.QuadPart = static_cast<ULONGLONG>(-static_cast<LONGLONG>(interval) * 10000);
+            FILETIME dueTime{ due.LowPart, due.HighPart };
+            SetThreadpoolTimer(_timer.get(), &dueTime, interval, interval / 10);
+        }
+        else
+        {
+            SetThreadpoolTimer(_timer.get(), nullptr, 0, 0);
+        }
+    }
+
+    void CALLBACK BlinkClock::_timerCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
+    try
+    {
+        static_cast<BlinkClock*>(context)->Tick();
+    }
+    CATCH_LOG()
+}
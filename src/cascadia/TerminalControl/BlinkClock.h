@@ -0,0 +1,73 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- BlinkClock.h
+
+Abstract:
+- A single timer that blinks the cursor and the blinking text of all the
+  controls in the process, instead of two DispatcherTimers per control.
+- Controls subscribe to it while they need it: the focused control for its
+  cursor, and the visible ones for their blinking text. While nobody is
+  subscribed, the timer doesn't run at all.
+- It ticks on the threadpool. The controls' cores take the terminal lock and
+  ask their renderer for a redraw themselves, so the UI thread isn't woken up.
+--*/
+
+#pragma once
+
+namespace ControlUnitTests
+{
+    class ControlCoreTests;
+};
+
+namespace winrt::Microsoft::Terminal::Control::implementation
+{
+    struct ControlCore;
+
+    class BlinkClock final
+    {
+    public:
+        static std::shared_ptr<BlinkClock> Get();
+
+        BlinkClock(const std::chrono::milliseconds interval, const bool attributesEnabled);
+        ~BlinkClock();
+
+        BlinkClock(const BlinkClock&) = delete;
+        BlinkClock& operator=(const BlinkClock&) = delete;
+
+        bool IsCursorBlinkEnabled() const noexcept;
+        void BlinkCursor(ControlCore* core, const bool blink);
+        void BlinkAttributes(ControlCore* core, const bool blink);
+        void RestartCursorBlink(ControlCore* core);
+        void Remove(ControlCore* core);
+
+        void Tick();
+
+    private:
+        struct Subscriber
+        {
+            ControlCore* core;
+            bool cursor;
+            bool attributes;
+            // The cursor was just shown, so it's left on for the next tick.
+            bool skipCursorTick;
+        };
+
+        Subscriber& _subscriber(ControlCore* core);
+        void _updateTimer();
+        static void CALLBACK _timerCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_TIMER timer) noexcept;
+
+        // Guards the subscribers, and keeps them from being removed while
+        // they're ticked, so that a core can't be destroyed in the middle of it.
+        std::mutex _lock;
+        std::vector<Subscriber> _subscribers;
+        std::chrono::milliseconds _interval;
+        bool _attributesEnabled;
+        bool _running{ false };
+        wil::unique_threadpool_timer _timer;
+
+        friend class ControlUnitTests::ControlCoreTests;
+    };
+}
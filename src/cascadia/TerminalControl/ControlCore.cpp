@@ -54,6 +54,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _EnsureStaticInitialization();
 
         _terminal = std::make_unique<::Microsoft::Terminal::Core::Terminal>();
+        _blinkClock = BlinkClock::Get();
+
+        // The connection, render, UI and UIA threads all take the terminal's
+        // lock. Holding it for long freezes the pane, so those holds are
+        // traced, and the last few of them are kept around for debugging.
+        _terminal->GetLock().EnableProfiling(LockHoldTraceThreshold, [this](const auto& hold) {
+            _traceLongLockHold(hold);
+        });
 
         // Subscribe to the connection's disconnected event and call our connection closed handlers.
         _connectionStateChangedRevoker = _connection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*v*/) {
@@ -101,12 +109,39 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         Close();
 
+        // Dropping the producer tells the output thread to exit, once it has
+        // parsed whatever is still queued up.
+        _outputProducer = til::spsc::producer<winrt::hstring>{ nullptr };
+        if (_outputThread.joinable())
+        {
+            _outputThread.join();
+        }
+
         if (_renderer)
         {
             _renderer->TriggerTeardown();
         }
     }
 
+    // Method Description:
+    // - Called by C++/WinRT once the last reference to the core is released,
+    //   which is usually the TermControl's, on the UI thread, when a pane or
+    //   a tab closes. Destroying the core joins the output and render threads
+    //   and frees the whole text buffer and the device resources of the
+    //   render engine, which for a large buffer is long enough to freeze the
+    //   UI. Nothing in the core needs the UI thread anymore by the time it's
+    //   released, as Close already disconnected it from the control and the
+    //   connection, so it's destroyed on a background thread instead.
+    // Arguments:
+    // - core: the final living reference to an outgoing core
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::final_release(std::unique_ptr<ControlCore> core)
+    {
+        co_await winrt::resume_background(); // move to background
+        core.reset(); // explicitly destruct
+    }
+
     bool ControlCore::Initialize(const double actualWidth,
                                  const double actualHeight,
                                  const double compositionScale)
@@ -139,6 +174,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             auto renderThread = std::make_unique<::Microsoft::Console::Render::RenderThread>();
             auto* const localPointerToThread = renderThread.get();
 
+            // Both of our engines present through a swap chain with a frame latency
+            // waitable object, so frames can be aligned to the display refresh.
+            localPointerToThread->SetPacing(::Microsoft::Console::Render::RenderPacing::Display);
+            localPointerToThread->SetLowLatencyInput(_settings.LowLatencyInput());
+            localPointerToThread->SetPriorityBoost(_settings.BoostRenderPriority());
+
             // Now create the renderer and initialize the render thread.
             _renderer = std::make_unique<::Microsoft::Console::Render::Renderer>(_terminal.get(), nullptr, 0, std::move(renderThread));
             ::Microsoft::Console::Render::IRenderTarget& renderTarget = *_renderer;
@@ -150,11 +191,39 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+            // Resizing the buffer reflows all of its text. While the window
+            // is being resized, only the latest size is applied, once per frame.
+            _renderer->SetFrameStartingCallback([weakThis = get_weak()]() {
+                if (auto strongThis{ weakThis.get() })
+                {
+                    strongThis->_applyPendingResize();
+                    strongThis->_applyPendingCursorOn();
+                }
+            });
+
+            // Scroll and cursor position changes are collected while output is
+            // being processed and raised once per frame, on the render thread.
+            _renderer->SetFrameCompletedCallback([weakThis = get_weak()]() {
+                if (auto strongThis{ weakThis.get() })
+                {
+                    strongThis->_framesPainted.fetch_add(1, std::memory_order_relaxed);
+                    strongThis->_raisePendingNotifications();
+                }
+            });
+
             THROW_IF_FAILED(localPointerToThread->Initialize(_renderer.get()));
 
-            // Set up the DX Engine
-            auto dxEngine = std::make_unique<::Microsoft::Console::Render::DxEngine>();
-            _renderer->AddRenderEngine(dxEngine.get());
+            // Set up the render engine. The atlas engine is opt-in for now.
+            std::unique_ptr<::Microsoft::Console::Render::IRenderEngine> renderEngine;
+            if (_settings.UseAtlasEngine())
+            {
+                renderEngine = std::make_unique<::Microsoft::Console::Render::AtlasEngine>();
+            }
+            else
+            {
+                renderEngine = std::make_unique<::Microsoft::Console::Render::DxEngine>();
+            }
+            _renderer->AddRenderEngine(renderEngine.get());
 
             // Initialize our font with the renderer
             // We don't have to care about DPI. We'll get a change message immediately if it's not 96
@@ -168,12 +237,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // Then, using the font, get the number of characters that can fit.
             // Resize our terminal connection to match that size, and initialize the terminal with that size.
             const auto viewInPixels = Viewport::FromDimensions({ 0, 0 }, windowSize);
-            LOG_IF_FAILED(dxEngine->SetWindowSize({ viewInPixels.Width(), viewInPixels.Height() }));
+            LOG_IF_FAILED(renderEngine->SetWindowSize({ viewInPixels.Width(), viewInPixels.Height() }));
 
-            // Update DxEngine's SelectionBackground
-            dxEngine->SetSelectionBackground(til::color{ _settings.SelectionBackground() });
+            // Update the engine's SelectionBackground
+            renderEngine->SetSelectionBackground(til::color{ _settings.SelectionBackground() });
 
-            const auto vp = dxEngine->GetViewportInCharacters(viewInPixels);
+            const auto vp = renderEngine->GetViewportInCharacters(viewInPixels);
             const auto width = vp.Width();
             const auto height = vp.Height();
             _connection.Resize(height, width);
@@ -188,31 +257,47 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // after Enable, then it'll be possible to paint the frame once
             // _before_ the warning handler is set up, and then warnings from
             // the first paint will be ignored!
-            dxEngine->SetWarningCallback(std::bind(&ControlCore::_rendererWarning, this, std::placeholders::_1));
+            renderEngine->SetWarningCallback(std::bind(&ControlCore::_rendererWarning, this, std::placeholders::_1));
 
-            // Tell the DX Engine to notify us when the swap chain changes.
+            // Tell the render engine to notify us when the swap chain changes.
             // We do this after we initially set the swapchain so as to avoid unnecessary callbacks (and locking problems)
-            dxEngine->SetCallback(std::bind(&ControlCore::_renderEngineSwapChainChanged, this));
+            renderEngine->SetCallback(std::bind(&ControlCore::_renderEngineSwapChainChanged, this));
 
-            dxEngine->SetRetroTerminalEffect(_settings.RetroTerminalEffect());
-            dxEngine->SetPixelShaderPath(_settings.PixelShaderPath());
-            dxEngine->SetForceFullRepaintRendering(_settings.ForceFullRepaintRendering());
-            dxEngine->SetSoftwareRendering(_settings.SoftwareRendering());
+            renderEngine->SetRetroTerminalEffect(_settings.RetroTerminalEffect());
+            renderEngine->SetPixelShaderPath(_settings.PixelShaderPath());
+            renderEngine->SetForceFullRepaintRendering(_settings.ForceFullRepaintRendering());
+            renderEngine->SetSoftwareRendering(_settings.SoftwareRendering());
+            renderEngine->SetPreferredAdapter(_settings.RenderingAdapter());
 
-            _updateAntiAliasingMode(dxEngine.get());
+            _updateAntiAliasingMode(renderEngine.get());
 
             // GH#5098: Inform the engine of the opacity of the default text background.
             if (_settings.UseAcrylic())
             {
-                dxEngine->SetDefaultTextBackgroundOpacity(::base::saturated_cast<float>(_settings.TintOpacity()));
+                renderEngine->SetDefaultTextBackgroundOpacity(::base::saturated_cast<float>(_settings.TintOpacity()));
             }
 
-            THROW_IF_FAILED(dxEngine->Enable());
-            _renderEngine = std::move(dxEngine);
+            // The window may have been hidden before we had anything to render with.
+            renderEngine->SetWindowOccluded(_windowHidden || _controlHidden);
+
+            THROW_IF_FAILED(renderEngine->Enable());
+            _renderEngine = std::move(renderEngine);
 
             _initializedTerminal = true;
         } // scope for TerminalLock
 
+        // The clock takes the terminal lock while it's holding its own, so it
+        // mustn't be subscribed to while the terminal lock is held.
+        _updateBlinking();
+
+        // The connection can't produce any output before it's started, so the output
+        // thread isn't spun up before then either. Controls in tabs that were never
+        // selected (e.g. all but the last one of `wt nt ; nt ; nt`) thus don't
+        // have a thread, a renderer or a running connection.
+        auto [outputProducer, outputConsumer] = til::spsc::channel<winrt::hstring>(OutputQueueCapacity);
+        _outputProducer = std::move(outputProducer);
+        _outputThread = std::thread{ &ControlCore::_processOutput, this, std::move(outputConsumer) };
+
         // Start the connection outside of lock, because it could
         // start writing output immediately.
         _connection.Start();
@@ -251,6 +336,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
         else
         {
+            if (_renderer)
+            {
+                _renderer->NotifyInput();
+            }
             _connection.WriteInput(wstr);
         }
     }
@@ -392,6 +481,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     void ControlCore::ToggleShaderEffects()
     {
         auto lock = _terminal->LockForWriting();
+        const auto engineLock = _renderer->LockEngines();
         // Originally, this action could be used to enable the retro effects
         // even when they're set to `false` in the settings. If the user didn't
         // specify a custom pixel shader, manually enable the legacy retro
@@ -412,6 +502,75 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Called when the window was hidden from or shown to the user. While
+    //   hidden, the render engine stops painting and accumulates the changes
+    //   to the buffer instead, which it'll catch up on once we're visible.
+    // Arguments:
+    // - showOrHide: true if the window is visible
+    // Return Value:
+    // - <none>
+    void ControlCore::WindowVisibilityChanged(const bool showOrHide)
+    {
+        _windowHidden = !showOrHide;
+        _updateOccluded();
+    }
+
+    // Method Description:
+    // - Informs the renderer whether this control itself is visible, as opposed
+    //   to the window containing it. A control in a tab that isn't selected
+    //   isn't visible, even if its window is. Its output is still processed,
+    //   it's just not painted until it's visible again.
+    // Arguments:
+    // - visible: true if the control is part of the visual tree
+    void ControlCore::ControlVisibilityChanged(const bool visible)
+    {
+        _controlHidden = !visible;
+        _updateOccluded();
+    }
+
+    // Method Description:
+    // - Releases the swap chain and the other GPU resources of the renderer, if
+    //   nothing is visible anyways. They're recreated on the first frame that's
+    //   painted after the window or the control became visible again.
+    void ControlCore::TrimRenderResources()
+    {
+        if (!_initializedTerminal || !(_windowHidden || _controlHidden))
+        {
+            return;
+        }
+
+        _renderer->TrimDeviceResources();
+    }
+
+    void ControlCore::_updateOccluded()
+    {
+        if (!_initializedTerminal)
+        {
+            return;
+        }
+
+        // No need for the terminal lock: the engines only flip a flag and the
+        // paint thread is woken up to catch up. This runs for every control
+        // whenever the window is shown, so it mustn't wait for their output.
+        _renderer->SetWindowOccluded(_windowHidden || _controlHidden);
+        _updateBlinking();
+    }
+
+    // Method Description:
+    // - Subscribes to the blink clock for the cursor while we're focused, and
+    //   for the blinking text while we're visible.
+    void ControlCore::_updateBlinking()
+    {
+        if (!_initializedTerminal || _closing)
+        {
+            return;
+        }
+
+        _blinkClock->BlinkCursor(this, _focused);
+        _blinkClock->BlinkAttributes(this, !(_windowHidden || _controlHidden));
+    }
+
     // Method Description:
     // - Tell TerminalCore to update its knowledge about the locations of visible regex patterns
     // - We should call this (through the throttled function) when something causes the visible
@@ -442,9 +601,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         decltype(_terminal->GetHyperlinkIntervalFromPosition(til::point{})) newInterval{ std::nullopt };
         if (terminalPosition.has_value())
         {
-            auto lock = _terminal->LockForReading(); // Lock for the duration of our reads.
-            newId = _terminal->GetHyperlinkIdAtPosition(*terminalPosition);
-            newInterval = _terminal->GetHyperlinkIntervalFromPosition(*terminalPosition);
+            // The hover index doesn't need the lock, which the connection
+            // may be holding for a while as it's writing lots of output.
+            if (const auto hoverIndex = _terminal->GetHoverIndex())
+            {
+                newId = hoverIndex->GetHyperlinkIdAtPosition(*terminalPosition);
+                newInterval = hoverIndex->GetHyperlinkIntervalFromPosition(*terminalPosition);
+            }
+            else
+            {
+                auto lock = _terminal->LockForReading(); // Lock for the duration of our reads.
+                newId = _terminal->GetHyperlinkIdAtPosition(*terminalPosition);
+                newInterval = _terminal->GetHyperlinkIntervalFromPosition(*terminalPosition);
+            }
         }
 
         // If the hyperlink ID changed or the interval changed, trigger a redraw all
@@ -461,6 +630,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
                 _lastHoveredId = newId;
                 _lastHoveredInterval = newInterval;
+                const auto engineLock = _renderer->LockEngines();
                 _renderEngine->UpdateHyperlinkHoveredId(newId);
                 _renderer->UpdateLastHoveredInterval(newInterval);
                 _renderer->TriggerRedrawAll();
@@ -511,8 +681,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         //      The family is only used to determine if the font is truetype or
         //      not, but DX doesn't use that info at all.
         //      The Codepage is additionally not actually used by the DX engine at all.
-        _actualFont = { fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
-        _desiredFont = { _actualFont };
+        const FontInfoDesired desiredFont{ fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8 };
+
+        // Re-creating the font is expensive. A settings reload gets here for
+        // every control, even if it only changed a keybinding, so only do it
+        // if the font (or the zoom, which the reload resets) actually changed.
+        const auto fontChanged = !_initializedTerminal || !(desiredFont == _desiredFont);
+        if (fontChanged)
+        {
+            _actualFont = { fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
+            _desiredFont = { _actualFont };
+        }
 
         // Update the terminal core with its new Core settings
         _terminal->UpdateSettings(_settings);
@@ -524,10 +703,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return;
         }
 
+        // The engine might be in the middle of painting a frame without our lock.
+        const auto engineLock = _renderer->LockEngines();
+
         _renderEngine->SetForceFullRepaintRendering(_settings.ForceFullRepaintRendering());
         _renderEngine->SetSoftwareRendering(_settings.SoftwareRendering());
+        _renderEngine->SetPreferredAdapter(_settings.RenderingAdapter());
         _updateAntiAliasingMode(_renderEngine.get());
 
+        if (!fontChanged)
+        {
+            return;
+        }
+
         // Refresh our font with the renderer
         const auto actualFontOldSize = _actualFont.GetSize();
         _updateFont();
@@ -552,6 +740,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         if (_renderEngine)
         {
             // Update DxEngine settings under the lock
+            const auto engineLock = _renderer->LockEngines();
             _renderEngine->SetSelectionBackground(til::color{ newAppearance.SelectionBackground() });
             _renderEngine->SetRetroTerminalEffect(newAppearance.RetroTerminalEffect());
             _renderEngine->SetPixelShaderPath(newAppearance.PixelShaderPath());
@@ -559,20 +748,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
-    void ControlCore::_updateAntiAliasingMode(::Microsoft::Console::Render::DxEngine* const dxEngine)
+    void ControlCore::_updateAntiAliasingMode(::Microsoft::Console::Render::IRenderEngine* const renderEngine)
     {
-        // Update DxEngine's AntialiasingMode
+        // Update the engine's AntialiasingMode
         switch (_settings.AntialiasingMode())
         {
         case TextAntialiasingMode::Cleartype:
-            dxEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_CLEARTYPE);
+            renderEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_CLEARTYPE);
             break;
         case TextAntialiasingMode::Aliased:
-            dxEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_ALIASED);
+            renderEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_ALIASED);
             break;
         case TextAntialiasingMode::Grayscale:
         default:
-            dxEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
+            renderEngine->SetAntialiasingMode(D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
             break;
         }
     }
@@ -706,6 +895,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _terminal->ClearSelection();
 
         // Tell the dx engine that our window is now the new size.
+        const auto engineLock = _renderer->LockEngines();
         THROW_IF_FAILED(_renderEngine->SetWindowSize(size));
 
         // Invalidate everything
@@ -725,17 +915,54 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Called by the UI thread while the swapchain panel is being resized.
+    //   This only records the new size: reflowing the buffer and resizing the
+    //   swapchain happen on the render thread, right before its next frame.
+    //   If the size changes several times in between, only the latest size
+    //   is applied. See _applyPendingResize.
+    // Arguments:
+    // - width: the new width of the swapchain panel, in DIPs.
+    // - height: the new height of the swapchain panel, in DIPs.
     void ControlCore::SizeChanged(const double width,
                                   const double height)
     {
         _panelWidth = width;
         _panelHeight = height;
 
+        {
+            const std::lock_guard guard{ _pendingResizeLock };
+            _pendingResize = PendingResize{ width, height };
+        }
+
+        // Wake up the render thread, so that it picks up the new size.
+        _renderer->TriggerRedrawAll();
+    }
+
+    // Method Description:
+    // - Resizes the buffer and the swapchain to the latest size SizeChanged
+    //   recorded, if there's one. This is called by the renderer before every
+    //   frame, on the render thread.
+    // Arguments:
+    // - <none>
+    void ControlCore::_applyPendingResize()
+    {
+        std::optional<PendingResize> resize;
+        {
+            const std::lock_guard guard{ _pendingResizeLock };
+            resize = std::exchange(_pendingResize, std::nullopt);
+        }
+
+        if (!resize)
+        {
+            return;
+        }
+
         auto lock = _terminal->LockForWriting();
         const auto currentEngineScale = _renderEngine->GetScaling();
 
-        auto scaledWidth = width * currentEngineScale;
-        auto scaledHeight = height * currentEngineScale;
+        const auto scaledWidth = resize->width * currentEngineScale;
+        const auto scaledHeight = resize->height * currentEngineScale;
         _doResizeUnderLock(scaledWidth, scaledHeight);
     }
 
@@ -833,35 +1060,57 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return false;
         }
 
-        // extract text from buffer
-        // RetrieveSelectedTextFromBuffer will lock while it's reading
-        const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+        const auto copyHtml = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML);
+        const auto copyRtf = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF);
 
-        // convert text: vector<string> --> string
+        // extract text from buffer
+        // RetrieveSelected*TextFromBuffer will lock while it's reading
+        // The colors are only resolved if they're going to be formatted.
+        // This is a snapshot of the selection, so the formats can be
+        // generated later on, without holding the lock.
+        std::shared_ptr<const TextBuffer::TextAndColor> bufferData;
         std::wstring textData;
-        for (const auto& text : bufferData.text)
+        if (copyHtml || copyRtf)
+        {
+            bufferData = std::make_shared<const TextBuffer::TextAndColor>(_terminal->RetrieveSelectedTextFromBuffer(singleLine));
+
+            // convert text: vector<string> --> string
+            for (const auto& text : bufferData->text)
+            {
+                textData += text;
+            }
+        }
+        else
         {
-            textData += text;
+            textData = _terminal->RetrieveSelectedPlainTextFromBuffer(singleLine);
         }
 
+        // The HTML and RTF formats are only generated if and when the
+        // receiver of the event asks for them, which it may do on any thread.
+        const auto fontHeight = _actualFont.GetUnscaledSize().Y;
+        const std::wstring fontFaceName{ _actualFont.GetFaceName() };
+        const til::color background{ _settings.DefaultBackground() };
+
         // convert text to HTML format
         // GH#5347 - Don't provide a title for the generated HTML, as many
         // web applications will paste the title first, followed by the HTML
         // content, which is unexpected.
-        const auto htmlData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML) ?
-                                  TextBuffer::GenHTML(bufferData,
-                                                      _actualFont.GetUnscaledSize().Y,
-                                                      _actualFont.GetFaceName(),
-                                                      til::color{ _settings.DefaultBackground() }) :
-                                  "";
+        std::function<winrt::hstring()> htmlGenerator;
+        if (copyHtml)
+        {
+            htmlGenerator = [=]() {
+                return winrt::to_hstring(TextBuffer::GenHTML(*bufferData, fontHeight, fontFaceName, background));
+            };
+        }
 
         // convert to RTF format
-        const auto rtfData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF) ?
-                                 TextBuffer::GenRTF(bufferData,
-                                                    _actualFont.GetUnscaledSize().Y,
-                                                    _actualFont.GetFaceName(),
-                                                    til::color{ _settings.DefaultBackground() }) :
-                                 "";
+        std::function<winrt::hstring()> rtfGenerator;
+        if (copyRtf)
+        {
+            rtfGenerator = [=]() {
+                return winrt::to_hstring(TextBuffer::GenRTF(*bufferData, fontHeight, fontFaceName, background));
+            };
+        }
 
         if (!_settings.CopyOnSelect())
         {
@@ -872,8 +1121,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // send data up for clipboard
         _CopyToClipboardHandlers(*this,
                                  winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
-                                                                       winrt::to_hstring(htmlData),
-                                                                       winrt::to_hstring(rtfData),
+                                                                       std::move(htmlGenerator),
+                                                                       std::move(rtfGenerator),
                                                                        formats));
         return true;
     }
@@ -1032,8 +1281,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // Method Description:
     // - Update the position and size of the scrollbar to match the given
     //      viewport top, viewport height, and buffer size.
-    //   Additionally fires a ScrollPositionChanged event for anyone who's
-    //      registered an event handler for us.
+    //   The ScrollPositionChanged event for anyone who's registered an event
+    //      handler for us is raised with the next frame, see
+    //      _raisePendingNotifications. During a flood of output this is called
+    //      for every single line, but only the latest position matters.
     // Arguments:
     // - viewTop: the top of the visible viewport, in rows. 0 indicates the top
     //      of the buffer.
@@ -1049,15 +1300,59 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // TODO GH#9617: refine locking around pattern tree
         _terminal->ClearPatternTree();
 
-        _ScrollPositionChangedHandlers(*this,
-                                       winrt::make<ScrollPositionChangedArgs>(viewTop,
-                                                                              viewHeight,
-                                                                              bufferSize));
+        const std::lock_guard guard{ _pendingNotificationsLock };
+        _pendingScrollPosition = PendingScrollPosition{ viewTop, viewHeight, bufferSize };
     }
 
     void ControlCore::_terminalCursorPositionChanged()
     {
-        _CursorPositionChangedHandlers(*this, nullptr);
+        const std::lock_guard guard{ _pendingNotificationsLock };
+        _pendingCursorPositionChanged = true;
+    }
+
+    // Method Description:
+    // - Raises the ScrollPositionChanged and CursorPositionChanged events, if
+    //   the positions changed since they were last raised. This is called by
+    //   the renderer after every frame, so they're raised at most once per frame.
+    // Arguments:
+    // - <none>
+    void ControlCore::_raisePendingNotifications()
+    {
+        // The handlers are invoked outside of _pendingNotificationsLock, so they're
+        // free to call back into us. This lock only keeps two threads from
+        // raising the same change out of order.
+        const std::lock_guard raiseGuard{ _raiseNotificationsLock };
+
+        std::optional<PendingScrollPosition> scrollPosition;
+        bool cursorPositionChanged = false;
+        {
+            const std::lock_guard guard{ _pendingNotificationsLock };
+            scrollPosition = std::exchange(_pendingScrollPosition, std::nullopt);
+            cursorPositionChanged = std::exchange(_pendingCursorPositionChanged, false);
+        }
+
+        // The terminal only tells us about the cursor moving as text is
+        // written. Other moves, like those of cursor positioning sequences,
+        // are picked up from the frame that was just painted.
+        const til::point paintedCursorPosition{ _renderer->GetPaintedCursorPosition() };
+        if (paintedCursorPosition != _raisedCursorPosition)
+        {
+            _raisedCursorPosition = paintedCursorPosition;
+            cursorPositionChanged = true;
+        }
+
+        if (scrollPosition)
+        {
+            _ScrollPositionChangedHandlers(*this,
+                                           winrt::make<ScrollPositionChangedArgs>(scrollPosition->viewTop,
+                                                                                  scrollPosition->viewHeight,
+                                                                                  scrollPosition->bufferSize));
+        }
+
+        if (cursorPositionChanged)
+        {
+            _CursorPositionChangedHandlers(*this, nullptr);
+        }
     }
 
     void ControlCore::_terminalTaskbarProgressChanged()
@@ -1120,6 +1415,61 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             search.Select();
             _renderer->TriggerSelection();
         }
+
+        // FindNext already found all the matches, FindAll just hands them out.
+        _terminal->SetSearchHighlights(search.FindAll());
+        _renderer->TriggerRedrawAll();
+    }
+
+    // Method Description:
+    // - Highlights every match of the given text in the text buffer, without
+    //   touching the selection. Unlike Search, this isn't tied to the search
+    //   box and may be called from any thread, so that the buffers of many
+    //   controls can be searched at the same time.
+    // Arguments:
+    // - text: the text to search. An empty text clears the highlights.
+    // - caseSensitive: boolean that represents if the search is case sensitive
+    // Return Value:
+    // - The number of matches that were found.
+    uint32_t ControlCore::HighlightAllMatches(const winrt::hstring& text,
+                                              const bool caseSensitive)
+    {
+        if (!_initializedTerminal)
+        {
+            return 0;
+        }
+
+        const Search::Sensitivity sensitivity = caseSensitive ?
+                                                    Search::Sensitivity::CaseSensitive :
+                                                    Search::Sensitivity::CaseInsensitive;
+
+        auto lock = _terminal->LockForWriting();
+        std::vector<std::pair<COORD, COORD>> matches;
+        if (!text.empty())
+        {
+            // Anchor at the top, so that an active selection doesn't matter.
+            ::Search search(*GetUiaData(), text.c_str(), Search::Direction::Forward, sensitivity, COORD{ 0, 0 });
+            matches = search.FindAll();
+        }
+
+        const auto count = gsl::narrow_cast<uint32_t>(matches.size());
+        _terminal->SetSearchHighlights(matches);
+        _renderer->TriggerRedrawAll();
+        return count;
+    }
+
+    // Method Description:
+    // - Removes the highlights of the last search. This is called when the
+    //   search box is closed.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::ClearSearch()
+    {
+        auto lock = _terminal->LockForWriting();
+        _terminal->ClearSearchHighlights();
+        _renderer->TriggerRedrawAll();
     }
 
     void ControlCore::SetBackgroundOpacity(const float opacity)
@@ -1127,6 +1477,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         if (_renderEngine)
         {
             auto lock = _terminal->LockForWriting();
+            const auto engineLock = _renderer->LockEngines();
             _renderEngine->SetDefaultTextBackgroundOpacity(::base::saturated_cast<float>(opacity));
         }
     }
@@ -1165,6 +1516,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _connection.TerminalOutput(_connectionOutputEventToken);
             _connectionStateChangedRevoker.revoke();
 
+            // This waits for the clock, if it's ticking us right now.
+            _blinkClock->Remove(this);
+
             // GH#1996 - Close the connection asynchronously on a background
             // thread.
             // Since TermControl::Close is only ever triggered by the UI, we
@@ -1225,6 +1579,61 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _terminal->SetCursorOn(isCursorOn);
     }
 
+    // Method Description:
+    // - Shows the cursor and starts blinking it when the control gains focus,
+    //   and hides it and stops blinking it when it loses focus. If the user
+    //   disabled blinking, the cursor is left alone.
+    // Arguments:
+    // - focused: true if the control gained focus.
+    // Return Value:
+    // - <none>
+    void ControlCore::FocusChanged(const bool focused)
+    {
+        _focused = focused;
+        if (!_initializedTerminal)
+        {
+            return;
+        }
+
+        if (_blinkClock->IsCursorBlinkEnabled())
+        {
+            _terminal->SetCursorOn(focused);
+        }
+        _updateBlinking();
+    }
+
+    // Method Description:
+    // - Shows the cursor for a full blink period. This is called on every key
+    //   press, so that the cursor doesn't flicker while typing.
+    // - Key presses must never wait for the output thread, or a Ctrl+C takes
+    //   as long to land as the flood it's meant to stop. If the output thread
+    //   holds the lock, the cursor is shown at the start of the next frame
+    //   instead, which the output it's writing has already asked for.
+    void ControlCore::RestartCursorBlink()
+    {
+        if (!_initializedTerminal || !_blinkClock->IsCursorBlinkEnabled())
+        {
+            return;
+        }
+
+        if (!_terminal->TrySetCursorOn(true))
+        {
+            _cursorOnPending.store(true, std::memory_order_relaxed);
+        }
+        _blinkClock->RestartCursorBlink(this);
+    }
+
+    // Method Description:
+    // - Shows the cursor, if RestartCursorBlink couldn't. Called on the
+    //   render thread, at the start of every frame.
+    void ControlCore::_applyPendingCursorOn()
+    {
+        if (_cursorOnPending.exchange(false, std::memory_order_relaxed))
+        {
+            _terminal->SetCursorOn(true);
+        }
+    }
+
     void ControlCore::ResumeRendering()
     {
         _renderer->ResetErrorStateAndResume();
@@ -1243,8 +1652,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return { 0, 0 };
         }
 
-        auto lock = _terminal->LockForReading();
-        return _terminal->GetCursorPosition();
+        // The renderer remembers where it painted the cursor in the last
+        // frame, which is where the user sees it. That way this doesn't wait
+        // for the terminal lock, which is held most of the time while output
+        // is processed.
+        return til::point{ _renderer->GetPaintedCursorPosition() };
     }
 
     // This one's really pushing the boundary of what counts as "encapsulation".
@@ -1336,20 +1748,252 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     }
     void ControlCore::_connectionOutputHandler(const hstring& hstr)
     {
-        _terminal->Write(hstr);
-
-        // NOTE: We're raising an event here to inform the TermControl that
-        // output has been received, so it can queue up a throttled
-        // UpdatePatternLocations call. In the future, we should have the
-        // _updatePatternLocations ThrottledFunc internal to this class, and
-        // run on this object's dispatcher queue.
-        //
-        // We're not doing that quite yet, because the Core will eventually
-        // be out-of-proc from the UI thread, and won't be able to just use
-        // the UI thread as the dispatcher queue thread.
-        //
-        // See TODO: https://github.com/microsoft/terminal/projects/5#card-50760282
-        _ReceivedOutputHandlers(*this, nullptr);
+        // This only waits if the output thread has fallen behind by
+        // OutputQueueCapacity chunks, which throttles the connection.
+        const auto start = std::chrono::steady_clock::now();
+        _outputProducer.emplace(hstr);
+        _outputQueueWaitNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+        _outputQueued.fetch_add(1, std::memory_order_relaxed);
+        _charsReceived.fetch_add(hstr.size(), std::memory_order_relaxed);
+    }
+
+    // Method Description:
+    // - Traces where the output spent its time in the terminal as
+    //   "OutputThroughput", if it's been ThroughputTraceInterval since the
+    //   last time and the provider is enabled.
+    // - Only called on the output thread.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceOutputStatistics()
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto interval = now - _outputStatisticsSince;
+        if (interval < ThroughputTraceInterval)
+        {
+            return;
+        }
+        _outputStatisticsSince = now;
+
+        ::Microsoft::Terminal::Core::Terminal::OutputStatistics statistics;
+        {
+            auto lock = _terminal->LockForWriting();
+            statistics = _terminal->TakeOutputStatistics();
+        }
+        const auto queueWait = _outputQueueWaitNs.exchange(0, std::memory_order_relaxed);
+
+        const auto count = [](const auto duration) noexcept {
+            return gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        };
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "OutputThroughput",
+                          TraceLoggingDescription("Where the output of the connection spent its time in the terminal since the last event"),
+                          TraceLoggingPointer(this, "core"),
+                          TraceLoggingUInt64(count(interval), "intervalNs", "The time since the last event"),
+                          TraceLoggingUInt64(statistics.chunks, "chunks", "The number of chunks parsed"),
+                          TraceLoggingUInt64(statistics.chars, "chars", "The number of UTF-16 code units parsed"),
+                          TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(queueWait), "queueWaitNs", "The time the connection waited for the output queue to drain"),
+                          TraceLoggingUInt64(count(statistics.lockWait), "lockWaitNs", "The time spent waiting for the terminal's write lock"),
+                          TraceLoggingUInt64(count(statistics.parse), "parseNs", "The time spent in the state machine, including the buffer writes"),
+                          TraceLoggingUInt64(count(statistics.bufferWrite), "bufferWriteNs", "The time spent writing text into the buffer"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        // Busy controls get their resources traced along with their throughput.
+        Statistics();
+    }
+
+    // Method Description:
+    // - Gathers what this control is costing: how much output it receives
+    //   and how many frames it paints, and the memory its buffer and
+    //   renderer hold on to. It's traced as "ControlStatistics" too.
+    // - Estimating the memory walks all the rows of the buffer, so this is
+    //   meant to be called every now and then, like for a tooltip.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The statistics of this control.
+    Control::ControlStatistics ControlCore::Statistics()
+    {
+        Control::ControlStatistics statistics{};
+        _updateRates(statistics);
+        if (!_initializedTerminal)
+        {
+            return statistics;
+        }
+
+        {
+            auto lock = _terminal->LockForReading();
+            statistics.ScrollbackRows = gsl::narrow_cast<uint64_t>(std::max(0, _terminal->ViewStartIndex()));
+
+            const auto usage = _terminal->GetTextBuffer().GetMemoryUsage();
+            statistics.BufferTextBytes = usage.text;
+            statistics.BufferGlyphBytes = usage.glyphs;
+            statistics.BufferAttributeBytes = usage.attributes;
+            statistics.BufferHyperlinkBytes = usage.hyperlinks;
+            statistics.BufferImageBytes = usage.images;
+        }
+
+        const auto usage = _renderer->GetMemoryUsage();
+        statistics.RendererSwapChainBytes = usage.swapChain;
+        statistics.RendererCacheBytes = usage.caches;
+
+        _traceStatistics(statistics);
+        return statistics;
+    }
+
+    // Method Description:
+    // - Fills in the rates of the statistics. They're only computed again
+    //   once at least ThroughputTraceInterval has passed, so that calling
+    //   this often doesn't make them jump around.
+    // Arguments:
+    // - statistics: the statistics to fill in
+    // Return Value:
+    // - <none>
+    void ControlCore::_updateRates(Control::ControlStatistics& statistics)
+    {
+        std::lock_guard guard{ _ratesLock };
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto interval = now - _ratesSince;
+        if (interval >= ThroughputTraceInterval)
+        {
+            const auto seconds = std::chrono::duration<double>(interval).count();
+            const auto chars = _charsReceived.load(std::memory_order_relaxed);
+            const auto frames = _framesPainted.load(std::memory_order_relaxed);
+            _charsPerSecond = static_cast<double>(chars - _ratesChars) / seconds;
+            _framesPerSecond = static_cast<double>(frames - _ratesFrames) / seconds;
+            _ratesChars = chars;
+            _ratesFrames = frames;
+            _ratesSince = now;
+        }
+
+        statistics.OutputCharsPerSecond = _charsPerSecond;
+        statistics.FramesPerSecond = _framesPerSecond;
+    }
+
+    void ControlCore::_traceStatistics(const Control::ControlStatistics& statistics)
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "ControlStatistics",
+                          TraceLoggingDescription("The output, frames and memory of a control"),
+                          TraceLoggingPointer(this, "core"),
+                          TraceLoggingFloat64(statistics.OutputCharsPerSecond, "outputCharsPerSecond", "The UTF-16 code units received from the connection per second"),
+                          TraceLoggingFloat64(statistics.FramesPerSecond, "framesPerSecond", "The frames painted per second"),
+                          TraceLoggingUInt64(statistics.ScrollbackRows, "scrollbackRows", "The rows above the viewport"),
+                          TraceLoggingUInt64(statistics.BufferTextBytes, "bufferTextBytes", "The bytes held by the cells of the buffer"),
+                          TraceLoggingUInt64(statistics.BufferGlyphBytes, "bufferGlyphBytes", "The bytes held by the glyphs that don't fit into a single wchar_t"),
+                          TraceLoggingUInt64(statistics.BufferAttributeBytes, "bufferAttributeBytes", "The bytes held by the attributes of the buffer"),
+                          TraceLoggingUInt64(statistics.BufferHyperlinkBytes, "bufferHyperlinkBytes", "The bytes held by the hyperlinks of the buffer"),
+                          TraceLoggingUInt64(statistics.BufferImageBytes, "bufferImageBytes", "The bytes held by the images in the buffer"),
+                          TraceLoggingUInt64(statistics.RendererSwapChainBytes, "rendererSwapChainBytes", "The bytes held by the swap chain"),
+                          TraceLoggingUInt64(statistics.RendererCacheBytes, "rendererCacheBytes", "The bytes held by the glyph and image caches of the renderer"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    // Method Description:
+    // - Traces a hold of, or a wait for, the terminal's lock that took at
+    //   least LockHoldTraceThreshold as "TerminalLockHeld".
+    // - Called by whichever thread released the lock, after releasing it.
+    // Arguments:
+    // - hold: who held the lock and for how long
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceLongLockHold(const ::Microsoft::Terminal::Core::TerminalLock::Hold& hold) noexcept
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "TerminalLockHeld",
+                          TraceLoggingDescription("The terminal's lock was held or waited for for a long time"),
+                          TraceLoggingPointer(this, "core"),
+                          TraceLoggingString(hold.tag ? hold.tag : "", "tag", "What the lock was taken for, if known"),
+                          TraceLoggingPointer(hold.caller, "caller", "The return address of whoever took the lock"),
+                          TraceLoggingUInt32(hold.threadId, "threadId", "The thread that held the lock"),
+                          TraceLoggingBool(hold.exclusive, "exclusive", "Whether the lock was held for writing"),
+                          TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(hold.wait.count()), "waitNs", "The time spent waiting for the lock"),
+                          TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(hold.hold.count()), "holdNs", "The time the lock was held"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    // Method Description:
+    // - Blocks until all the output that was received from the connection
+    //   so far has been parsed by the terminal.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_waitForParsedOutput() const noexcept
+    {
+        const auto queued = _outputQueued.load(std::memory_order_relaxed);
+        for (auto parsed = _outputParsed.load(std::memory_order_acquire); parsed < queued; parsed = _outputParsed.load(std::memory_order_acquire))
+        {
+            WaitOnAddress(const_cast<std::atomic<size_t>*>(&_outputParsed), &parsed, sizeof(parsed), INFINITE);
+        }
+    }
+
+    // Method Description:
+    // - The body of the output thread. Parses the output queued up by
+    //   _connectionOutputHandler, handing everything that's available to
+    //   the terminal at once, until the producer is dropped.
+    // Arguments:
+    // - consumer: the receiving end of the output queue
+    // Return Value:
+    // - <none>
+    void ControlCore::_processOutput(til::spsc::consumer<winrt::hstring> consumer)
+    {
+        std::array<winrt::hstring, MaxOutputChunksPerLock> chunks;
+        std::array<std::wstring_view, MaxOutputChunksPerLock> views;
+
+        for (;;)
+        {
+            const auto [count, alive] = consumer.pop_n(til::spsc::block_initially, chunks.begin(), chunks.size());
+            if (count != 0)
+            {
+                try
+                {
+                    std::transform(chunks.begin(), chunks.begin() + count, views.begin(), [](const auto& chunk) {
+                        return std::wstring_view{ chunk };
+                    });
+                    _terminal->Write({ views.data(), count });
+
+                    // NOTE: We're raising an event here to inform the TermControl that
+                    // output has been received, so it can queue up a throttled
+                    // UpdatePatternLocations call. In the future, we should have the
+                    // _updatePatternLocations ThrottledFunc internal to this class, and
+                    // run on this object's dispatcher queue.
+                    //
+                    // We're not doing that quite yet, because the Core will eventually
+                    // be out-of-proc from the UI thread, and won't be able to just use
+                    // the UI thread as the dispatcher queue thread.
+                    //
+                    // See TODO: https://github.com/microsoft/terminal/projects/5#card-50760282
+                    _ReceivedOutputHandlers(*this, nullptr);
+
+                    _traceOutputStatistics();
+                }
+                CATCH_LOG();
+
+                std::fill_n(chunks.begin(), count, winrt::hstring{});
+                _outputParsed.fetch_add(count, std::memory_order_release);
+                WakeByAddressAll(&_outputParsed);
+            }
+
+            if (!alive)
+            {
+                break;
+            }
+        }
     }
 
 }
@@ -5,7 +5,7 @@
 // - ControlCore.h
 //
 // Abstract:
-// - This encapsulates a `Terminal` instance, a `DxEngine` and `Renderer`, and
+// - This encapsulates a `Terminal` instance, a render engine and `Renderer`, and
 //   an `ITerminalConnection`. This is intended to be everything that someone
 //   might need to stand up a terminal instance in a control, but without any
 //   regard for how the UX works.
@@ -19,16 +19,19 @@
 #include "ControlCore.g.h"
 #include "../../renderer/base/Renderer.hpp"
 #include "../../renderer/dx/DxRenderer.hpp"
+#include "../../renderer/dx/AtlasEngine.hpp"
 #include "../../renderer/uia/UiaRenderer.hpp"
 #include "../../cascadia/TerminalCore/Terminal.hpp"
 #include "../buffer/out/search.h"
 #include "cppwinrt_utils.h"
 #include "ThrottledFunc.h"
+#include "BlinkClock.h"
 
 namespace ControlUnitTests
 {
     class ControlCoreTests;
     class ControlInteractivityTests;
+    class KeystrokeLatencyPerfTests;
 };
 
 namespace winrt::Microsoft::Terminal::Control::implementation
@@ -39,6 +42,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         ControlCore(IControlSettings settings,
                     TerminalConnection::ITerminalConnection connection);
         ~ControlCore();
+        static winrt::fire_and_forget final_release(std::unique_ptr<ControlCore> core);
 
         bool Initialize(const double actualWidth,
                         const double actualHeight,
@@ -64,6 +68,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool CopySelectionToClipboard(bool singleLine, const Windows::Foundation::IReference<CopyFormat>& formats);
 
         void ToggleShaderEffects();
+        void WindowVisibilityChanged(const bool showOrHide);
+        void ControlVisibilityChanged(const bool visible);
+        void TrimRenderResources();
         void AdjustOpacity(const double adjustment);
         void ResumeRendering();
 
@@ -92,6 +99,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         int BufferHeight() const;
 
         bool BracketedPasteEnabled() const noexcept;
+
+        Control::ControlStatistics Statistics();
 #pragma endregion
 
 #pragma region ITerminalInput
@@ -114,6 +123,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void BlinkCursor();
         bool CursorOn() const;
         void CursorOn(const bool isCursorOn);
+        void FocusChanged(const bool focused);
+        void RestartCursorBlink();
 
         bool IsVtMouseModeEnabled() const;
         til::point CursorPosition() const;
@@ -124,9 +135,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void SetSelectionAnchor(til::point const& position);
         void SetEndSelectionPoint(til::point const& position);
 
+        void ClearSearch();
         void Search(const winrt::hstring& text,
                     const bool goForward,
                     const bool caseSensitive);
+        uint32_t HighlightAllMatches(const winrt::hstring& text,
+                                     const bool caseSensitive);
 
         void LeftClickOnTerminal(const til::point terminalPosition,
                                  const int numberOfClicks,
@@ -168,6 +182,43 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         TerminalConnection::ITerminalConnection _connection{ nullptr };
         event_token _connectionOutputEventToken;
+
+        // Output from the connection is queued up here and parsed on
+        // _outputThread, which drains as many chunks as are available under
+        // a single acquisition of the terminal's write lock. The connection
+        // thus never waits on the lock the renderer takes every frame.
+        // Both are only created in Initialize, right before the connection is started.
+        static constexpr uint32_t OutputQueueCapacity = 64;
+        static constexpr size_t MaxOutputChunksPerLock = 16;
+        til::spsc::producer<winrt::hstring> _outputProducer{ nullptr };
+        std::thread _outputThread;
+        std::atomic<size_t> _outputQueued{ 0 };
+        std::atomic<size_t> _outputParsed{ 0 };
+
+        // How long the connection waited for room in the output queue, and
+        // when the output statistics were last traced (output thread only).
+        static constexpr std::chrono::seconds ThroughputTraceInterval{ 1 };
+        std::atomic<int64_t> _outputQueueWaitNs{ 0 };
+        std::chrono::steady_clock::time_point _outputStatisticsSince{ std::chrono::steady_clock::now() };
+        void _traceOutputStatistics();
+
+        // The totals the rates of Statistics are computed from, counted by the
+        // connection and the render thread, and the rates as of the last time
+        // at least ThroughputTraceInterval had passed. See _updateRates.
+        std::atomic<uint64_t> _charsReceived{ 0 };
+        std::atomic<uint64_t> _framesPainted{ 0 };
+        std::mutex _ratesLock;
+        std::chrono::steady_clock::time_point _ratesSince{ std::chrono::steady_clock::now() };
+        uint64_t _ratesChars{ 0 };
+        uint64_t _ratesFrames{ 0 };
+        double _charsPerSecond{ 0 };
+        double _framesPerSecond{ 0 };
+        void _updateRates(Control::ControlStatistics& statistics);
+        void _traceStatistics(const Control::ControlStatistics& statistics);
+
+        // A few frames worth of time.
+        static constexpr std::chrono::milliseconds LockHoldTraceThreshold{ 50 };
+        void _traceLongLockHold(const ::Microsoft::Terminal::Core::TerminalLock::Hold& hold) noexcept;
         TerminalConnection::ITerminalConnection::StateChanged_revoker _connectionStateChangedRevoker;
 
         std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
@@ -177,7 +228,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // As _renderer has a dependency on _renderEngine (through a raw pointer)
         // we must ensure the _renderer is deallocated first.
         // (C++ class members are destroyed in reverse order.)
-        std::unique_ptr<::Microsoft::Console::Render::DxEngine> _renderEngine{ nullptr };
+        std::unique_ptr<::Microsoft::Console::Render::IRenderEngine> _renderEngine{ nullptr };
         std::unique_ptr<::Microsoft::Console::Render::Renderer> _renderer{ nullptr };
 
         IControlSettings _settings{ nullptr };
@@ -194,19 +245,60 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         bool _isReadOnly{ false };
 
+        // Whether the window or this control (e.g. in an unselected tab) is hidden.
+        bool _windowHidden{ false };
+        bool _controlHidden{ false };
+
+        // Blinks the cursor while we're focused, and the blinking text while
+        // we're visible. It's shared with all the other controls.
+        std::shared_ptr<BlinkClock> _blinkClock;
+        bool _focused{ false };
+
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
+        // The latest scroll position and whether the cursor moved, as reported
+        // by the terminal since the last frame. See _raisePendingNotifications.
+        struct PendingScrollPosition
+        {
+            int viewTop;
+            int viewHeight;
+            int bufferSize;
+        };
+        std::mutex _pendingNotificationsLock;
+        std::mutex _raiseNotificationsLock;
+        std::optional<PendingScrollPosition> _pendingScrollPosition;
+        bool _pendingCursorPositionChanged{ false };
+        // The cursor position the last CursorPositionChanged was raised for.
+        // Only touched under _raiseNotificationsLock.
+        til::point _raisedCursorPosition;
+
         // These members represent the size of the surface that we should be
         // rendering to.
         double _panelWidth{ 0 };
         double _panelHeight{ 0 };
+
+        // The latest size of the surface (in DIPs) that the buffer wasn't
+        // resized to yet. See _applyPendingResize.
+        struct PendingResize
+        {
+            double width;
+            double height;
+        };
+        std::mutex _pendingResizeLock;
+        std::optional<PendingResize> _pendingResize;
         double _compositionScale{ 0 };
 
+        // Set when a key press couldn't show the cursor, because the output
+        // thread was holding the terminal lock. See RestartCursorBlink.
+        std::atomic<bool> _cursorOnPending{ false };
+
         winrt::fire_and_forget _asyncCloseConnection();
 
         void _setFontSize(int fontSize);
         void _updateFont(const bool initialUpdate = false);
         void _refreshSizeUnderLock();
+        void _applyPendingResize();
+        void _applyPendingCursorOn();
         void _doResizeUnderLock(const double newWidth,
                                 const double newHeight);
 
@@ -223,6 +315,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                             const int bufferSize);
         void _terminalCursorPositionChanged();
         void _terminalTaskbarProgressChanged();
+        void _raisePendingNotifications();
 #pragma endregion
 
 #pragma region RendererCallbacks
@@ -231,11 +324,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 #pragma endregion
 
         void _raiseReadOnlyWarning();
-        void _updateAntiAliasingMode(::Microsoft::Console::Render::DxEngine* const dxEngine);
+        void _updateOccluded();
+        void _updateBlinking();
+        void _updateAntiAliasingMode(::Microsoft::Console::Render::IRenderEngine* const renderEngine);
         void _connectionOutputHandler(const hstring& hstr);
+        void _processOutput(til::spsc::consumer<winrt::hstring> consumer);
+        void _waitForParsedOutput() const noexcept;
 
         friend class ControlUnitTests::ControlCoreTests;
         friend class ControlUnitTests::ControlInteractivityTests;
+        friend class ControlUnitTests::KeystrokeLatencyPerfTests;
     };
 }
 
@@ -164,6 +164,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
 
+        // The moves leading up to the click go first, and the click has to
+        // land on the rows that are on the screen.
+        FlushPendingMouseMove();
+        FlushPendingScroll();
+
         const auto altEnabled = modifiers.IsAltPressed();
         const auto shiftEnabled = modifiers.IsShiftPressed();
         const auto ctrlEnabled = modifiers.IsCtrlPressed();
@@ -249,7 +254,22 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // Short-circuit isReadOnly check to avoid warning dialog
         if (focused && !_core->IsInReadOnlyMode() && _canSendVTMouseInput(modifiers))
         {
-            _core->SendMouseEvent(terminalPosition, pointerUpdateKind, modifiers, 0, buttonState);
+            // Mice can report their position 1000 times a second, which would
+            // flood the connection in any-event tracking mode. So a move is only
+            // remembered here, and just the last one is sent when the
+            // control flushes it, once per frame. TerminalInput drops the
+            // moves that stay in the same cell as the last one sent.
+            // Buttons that are pressed or released while moving are reported
+            // as moves too, and those are sent right away, in order.
+            if (pointerUpdateKind == WM_MOUSEMOVE)
+            {
+                _pendingMouseMove = PendingMouseMove{ terminalPosition, pointerUpdateKind, modifiers, buttonState };
+            }
+            else
+            {
+                FlushPendingMouseMove();
+                _core->SendMouseEvent(terminalPosition, pointerUpdateKind, modifiers, 0, buttonState);
+            }
         }
         else if (focused && buttonState.isLeftButtonDown)
         {
@@ -306,7 +326,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 // panning down)
                 const float numRows = -1.0f * (dy / fontSizeInDips.height<float>());
 
-                const double currentOffset = ::base::ClampedNumeric<double>(_core->ScrollOffset());
+                const double currentOffset = ::base::ClampedNumeric<double>(_scrollTop());
                 const double newValue = numRows + currentOffset;
 
                 // Update the Core's viewport position, and raise a
@@ -325,6 +345,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                const til::point pixelPosition)
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
+        FlushPendingMouseMove();
+        FlushPendingScroll();
+
         // Short-circuit isReadOnly check to avoid warning dialog
         if (!_core->IsInReadOnlyMode() && _canSendVTMouseInput(modifiers))
         {
@@ -369,6 +392,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                           const TerminalInput::MouseButtonState state)
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
+        FlushPendingMouseMove();
 
         // Short-circuit isReadOnly check to avoid warning dialog
         if (!_core->IsInReadOnlyMode() && _canSendVTMouseInput(modifiers))
@@ -448,7 +472,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // another ScrollPositionChanged handler. If the scrollbar should be
         // somewhere other than where it is currently, then start from that row.
         const int currentInternalRow = ::base::saturated_cast<int>(::std::round(_internalScrollbarPosition));
-        const int currentCoreRow = _core->ScrollOffset();
+        const int currentCoreRow = _scrollTop();
         const double currentOffset = currentInternalRow == currentCoreRow ?
                                          _internalScrollbarPosition :
                                          currentCoreRow;
@@ -473,6 +497,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         {
             // If user is mouse selecting and scrolls, they then point at new
             // character. Make sure selection reflects that immediately.
+            FlushPendingScroll();
             SetEndSelectionPoint(pixelPosition);
         }
     }
@@ -504,18 +529,113 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // row, then actually update the scroll position in the core, and raise
         // a ScrollPositionChanged to inform the control.
         int viewTop = ::base::saturated_cast<int>(::std::round(_internalScrollbarPosition));
-        if (viewTop != _core->ScrollOffset())
+        if (viewTop != _scrollTop())
         {
-            _core->UserScrollViewport(viewTop);
+            // Moving the core's viewport takes the terminal's write lock,
+            // which the connection's output thread is holding most of the
+            // time while it's busy. Precision touchpads easily report a
+            // hundred scroll deltas a second, so if scrolling is coalesced
+            // the viewport is only moved once per frame. The scrollbar is
+            // told about every step right away, so it doesn't lag behind.
+            if (_coalesceScrolling)
+            {
+                _pendingScrollTop = viewTop;
+            }
+            else
+            {
+                _core->UserScrollViewport(viewTop);
+            }
 
-            // _core->ScrollOffset() is now set to newValue
             _ScrollPositionChangedHandlers(*this,
-                                           winrt::make<ScrollPositionChangedArgs>(_core->ScrollOffset(),
+                                           winrt::make<ScrollPositionChangedArgs>(viewTop,
                                                                                   _core->ViewHeight(),
                                                                                   _core->BufferHeight()));
         }
     }
 
+    // Method Description:
+    // - Returns the top of the viewport as far as scrolling is concerned: the
+    //   one that's waiting for FlushPendingScroll, if there is one, or the
+    //   core's otherwise.
+    int ControlInteractivity::_scrollTop()
+    {
+        return _pendingScrollTop.value_or(_core->ScrollOffset());
+    }
+
+    // Method Description:
+    // - Sets whether UpdateScrollbar moves the core's viewport right away, or
+    //   only remembers where it should be moved to until FlushPendingScroll
+    //   is called. The hosting control enables this and flushes once per
+    //   frame.
+    // Arguments:
+    // - coalesce: true to coalesce the viewport updates.
+    // Return Value:
+    // - <none>
+    void ControlInteractivity::CoalesceScrolling(const bool coalesce) noexcept
+    {
+        _coalesceScrolling = coalesce;
+    }
+
+    // Method Description:
+    // - Returns true if UpdateScrollbar remembered a viewport position that
+    //   still has to be applied with FlushPendingScroll.
+    bool ControlInteractivity::HasPendingScroll() const noexcept
+    {
+        return _pendingScrollTop.has_value();
+    }
+
+    // Method Description:
+    // - Moves the core's viewport to the last position UpdateScrollbar
+    //   remembered, if there is one. The renderer gets the whole distance
+    //   as a single scroll, which moves the rows it already painted and only
+    //   paints the ones that were revealed.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlInteractivity::FlushPendingScroll()
+    {
+        if (!_pendingScrollTop)
+        {
+            return;
+        }
+
+        const auto viewTop = *_pendingScrollTop;
+        _pendingScrollTop.reset();
+        if (viewTop != _core->ScrollOffset())
+        {
+            _core->UserScrollViewport(viewTop);
+        }
+    }
+
+    // Method Description:
+    // - Returns true if PointerMoved remembered a mouse move that still has
+    //   to be sent with FlushPendingMouseMove.
+    bool ControlInteractivity::HasPendingMouseMove() const noexcept
+    {
+        return _pendingMouseMove.has_value();
+    }
+
+    // Method Description:
+    // - Sends the last mouse move that PointerMoved remembered as a VT mouse
+    //   event, if there is one. All the moves before it are dropped, since an
+    //   application only cares about where the mouse is now.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlInteractivity::FlushPendingMouseMove()
+    {
+        if (!_pendingMouseMove)
+        {
+            return;
+        }
+
+        const auto move = *_pendingMouseMove;
+        _pendingMouseMove.reset();
+        _core->SendMouseEvent(move.terminalPosition, move.pointerUpdateKind, move.modifiers, 0, move.buttonState);
+    }
+
     void ControlInteractivity::_hyperlinkHandler(const std::wstring_view uri)
     {
         _OpenHyperlinkHandlers(*this, winrt::make<OpenHyperlinkEventArgs>(winrt::hstring{ uri }));
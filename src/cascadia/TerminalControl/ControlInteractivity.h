@@ -76,6 +76,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void UpdateScrollbar(const double newValue);
 
+        bool HasPendingMouseMove() const noexcept;
+        void FlushPendingMouseMove();
+
+        void CoalesceScrolling(const bool coalesce) noexcept;
+        bool HasPendingScroll() const noexcept;
+        void FlushPendingScroll();
+
 #pragma endregion
 
         bool CopySelectionToClipboard(bool singleLine,
@@ -114,11 +121,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
+        // The last mouse move that wasn't sent as a VT mouse event yet.
+        struct PendingMouseMove
+        {
+            til::point terminalPosition;
+            unsigned int pointerUpdateKind;
+            ::Microsoft::Terminal::Core::ControlKeyStates modifiers;
+            ::Microsoft::Console::VirtualTerminal::TerminalInput::MouseButtonState buttonState;
+        };
+        std::optional<PendingMouseMove> _pendingMouseMove{ std::nullopt };
+
+        // If scrolling is coalesced, UpdateScrollbar only remembers the new
+        // top of the viewport here, until FlushPendingScroll moves the core.
+        bool _coalesceScrolling{ false };
+        std::optional<int> _pendingScrollTop{ std::nullopt };
+
         unsigned int _numberOfClicks(til::point clickPos, Timestamp clickTime);
         void _updateSystemParameterSettings() noexcept;
 
         void _mouseTransparencyHandler(const double mouseDelta);
         void _mouseZoomHandler(const double mouseDelta);
+        int _scrollTop();
         void _mouseScrollHandler(const double mouseDelta,
                                  const til::point terminalPosition,
                                  const bool isLeftButtonPressed);
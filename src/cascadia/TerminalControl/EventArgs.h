@@ -39,15 +39,38 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _rtf(rtf),
             _formats(formats) {}
 
+        // The HTML and RTF formats are expensive to generate for big selections,
+        // so they can be handed over as generators instead, which are run the
+        // first time the format is asked for.
+        CopyToClipboardEventArgs(hstring text, std::function<hstring()> htmlGenerator, std::function<hstring()> rtfGenerator, Windows::Foundation::IReference<CopyFormat> formats) :
+            _text(text),
+            _html(),
+            _rtf(),
+            _htmlGenerator(std::move(htmlGenerator)),
+            _rtfGenerator(std::move(rtfGenerator)),
+            _formats(formats) {}
+
         hstring Text() { return _text; };
-        hstring Html() { return _html; };
-        hstring Rtf() { return _rtf; };
+        hstring Html() { return _Generate(_html, _htmlGenerator); };
+        hstring Rtf() { return _Generate(_rtf, _rtfGenerator); };
         Windows::Foundation::IReference<CopyFormat> Formats() { return _formats; };
 
     private:
+        static hstring _Generate(hstring& value, std::function<hstring()>& generator)
+        {
+            if (generator)
+            {
+                value = generator();
+                generator = nullptr;
+            }
+            return value;
+        }
+
         hstring _text;
         hstring _html;
         hstring _rtf;
+        std::function<hstring()> _htmlGenerator;
+        std::function<hstring()> _rtfGenerator;
         Windows::Foundation::IReference<CopyFormat> _formats;
     };
 
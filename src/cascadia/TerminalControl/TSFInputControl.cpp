@@ -127,18 +127,38 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     }
 
     // Method Description:
-    // - Redraw the canvas if certain dimensions have changed since the last
-    //   redraw. This includes the Terminal cursor position, the Canvas width, and the TextBlock height.
+    // - Called when the Terminal cursor moved. If there's a composition in
+    //   progress, it's moved along with the cursor, and the IME is told to
+    //   request the new layout, so that its candidate window follows too.
+    //   Outside of a composition there's nothing to show, and the IME asks for
+    //   the layout itself when it needs it (see _layoutRequestedHandler), so
+    //   nothing is done.
     // Arguments:
     // - <none>
     // Return Value:
     // - <none>
     void TSFInputControl::TryRedrawCanvas()
     try
+    {
+        if (_inComposition && _UpdateCanvasLayout())
+        {
+            _editContext.NotifyLayoutChanged();
+        }
+    }
+    CATCH_LOG()
+
+    // Method Description:
+    // - Redraw the canvas if certain dimensions have changed since the last
+    //   redraw. This includes the Terminal cursor position, the Canvas width, and the TextBlock height.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - true if the canvas was redrawn.
+    bool TSFInputControl::_UpdateCanvasLayout()
     {
         if (!_focused || !Canvas())
         {
-            return;
+            return false;
         }
 
         // Get the cursor position in text buffer position
@@ -155,7 +175,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _currentTextBlockHeight == actualTextBlockHeight &&
             _currentWindowBounds == actualWindowBounds)
         {
-            return;
+            return false;
         }
 
         _currentTerminalCursorPos = cursorPos;
@@ -164,8 +184,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _currentWindowBounds = actualWindowBounds;
 
         _RedrawCanvas();
+        return true;
     }
-    CATCH_LOG()
 
     // Method Description:
     // - Redraw the Canvas and update the current Text Bounds and Control Bounds for
@@ -268,7 +288,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         auto request = args.Request();
 
-        TryRedrawCanvas();
+        try
+        {
+            _UpdateCanvasLayout();
+        }
+        CATCH_LOG();
 
         // Set the text block bounds
         request.LayoutBounds().TextBounds(_currentTextBounds);
@@ -76,6 +76,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool _inComposition;
         size_t _activeTextStart;
         void _SendAndClearText();
+        bool _UpdateCanvasLayout();
         void _RedrawCanvas();
         bool _focused;
 
@@ -39,9 +39,26 @@ constexpr const auto TsfRedrawInterval = std::chrono::milliseconds(100);
 // The minimum delay between updating the locations of regex patterns
 constexpr const auto UpdatePatternLocationsInterval = std::chrono::milliseconds(500);
 
+// The delay between sending the mouse moves in VT mouse mode, which are
+// coalesced into one per frame at 60 Hz.
+constexpr const auto MouseMoveFlushInterval = std::chrono::milliseconds(16);
+
+// The delay between moving the viewport while scrolling with the mouse wheel,
+// a touchpad or the scrollbar. The steps in between are coalesced.
+constexpr const auto ScrollFlushInterval = std::chrono::milliseconds(16);
+
+// The delay between passing on the title and the taskbar progress of the
+// terminal. Shells and build tools may change them on every line they print,
+// which is coalesced into one update per frame at 60 Hz.
+constexpr const auto TitleUpdateInterval = std::chrono::milliseconds(16);
+
 // The minimum delay between emitting warning bells
 constexpr const auto TerminalWarningBellInterval = std::chrono::milliseconds(1000);
 
+// How long a control has to be out of the visual tree (e.g. in a tab that isn't
+// selected) before the swap chain and the other GPU resources are released.
+constexpr const auto TrimRenderResourcesDelay = std::chrono::seconds(30);
+
 DEFINE_ENUM_FLAG_OPERATORS(winrt::Microsoft::Terminal::Control::CopyFormat);
 
 namespace winrt::Microsoft::Terminal::Control::implementation
@@ -56,8 +73,6 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _autoScrollingPointerPoint{ std::nullopt },
         _autoScrollTimer{},
         _lastAutoScrollUpdateTime{ std::nullopt },
-        _cursorTimer{},
-        _blinkTimer{},
         _searchBox{ nullptr }
     {
         InitializeComponent();
@@ -74,6 +89,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // are safe.
         _core->ScrollPositionChanged({ this, &TermControl::_ScrollPositionChanged });
         _core->WarningBell({ this, &TermControl::_coreWarningBell });
+        _core->TitleChanged({ this, &TermControl::_coreTitleChanged });
+        _core->TaskbarProgressChanged({ this, &TermControl::_coreTaskbarProgressChanged });
         _core->CursorPositionChanged({ this, &TermControl::_CursorPositionChanged });
 
         // This event is specifically triggered by the renderer thread, a BG thread. Use a weak ref here.
@@ -130,6 +147,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+        _flushPendingMouseMove = std::make_shared<ThrottledFuncTrailing<>>(
+            Dispatcher(),
+            MouseMoveFlushInterval,
+            [weakThis = get_weak()]() {
+                if (auto control{ weakThis.get() })
+                {
+                    control->_interactivity->FlushPendingMouseMove();
+                }
+            });
+
+        _flushPendingScroll = std::make_shared<ThrottledFuncTrailing<>>(
+            Dispatcher(),
+            ScrollFlushInterval,
+            [weakThis = get_weak()]() {
+                if (auto control{ weakThis.get() })
+                {
+                    control->_interactivity->FlushPendingScroll();
+                }
+            });
+        _interactivity->CoalesceScrolling(true);
+
         _playWarningBell = std::make_shared<ThrottledFuncLeading>(
             Dispatcher(),
             TerminalWarningBellInterval,
@@ -140,6 +178,28 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+        // Only the last title of a frame is passed on, the ones before it
+        // would never be seen anyways.
+        _updateTitle = std::make_shared<ThrottledFuncTrailing<winrt::hstring>>(
+            Dispatcher(),
+            TitleUpdateInterval,
+            [weakThis = get_weak()](const auto& title) {
+                if (auto control{ weakThis.get() })
+                {
+                    control->_TitleChangedHandlers(*control, winrt::make<TitleChangedEventArgs>(title));
+                }
+            });
+
+        _updateTaskbarProgress = std::make_shared<ThrottledFuncTrailing<>>(
+            Dispatcher(),
+            TitleUpdateInterval,
+            [weakThis = get_weak()]() {
+                if (auto control{ weakThis.get() })
+                {
+                    control->_SetTaskbarProgressHandlers(*control, nullptr);
+                }
+            });
+
         _updateScrollBar = std::make_shared<ThrottledFuncTrailing<ScrollBarUpdate>>(
             Dispatcher(),
             ScrollBarUpdateInterval,
@@ -167,6 +227,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _autoScrollTimer.Interval(AutoScrollUpdateInterval);
         _autoScrollTimer.Tick({ this, &TermControl::_UpdateAutoScroll });
 
+        _trimRenderResourcesTimer.Interval(TrimRenderResourcesDelay);
+        _trimRenderResourcesTimer.Tick({ get_weak(), &TermControl::_TrimRenderResourcesTimerTick });
+
+        // Loaded and Unloaded are raised when we're added to and removed from
+        // the visual tree, e.g. when our tab is selected and unselected.
+        Loaded({ get_weak(), &TermControl::_LoadedChanged });
+        Unloaded({ get_weak(), &TermControl::_LoadedChanged });
+
         _ApplyUISettings(_settings);
     }
 
@@ -219,6 +287,29 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Highlights every match of the given text in this control's buffer.
+    //   The search runs on a background thread and only holds the lock of
+    //   this control's terminal, so that the buffers of many controls can be
+    //   searched at the same time.
+    // Arguments:
+    // - text: the text to search
+    // - caseSensitive: boolean that represents if the search is case sensitive
+    // Return Value:
+    // - The number of matches that were found.
+    Windows::Foundation::IAsyncOperation<uint32_t> TermControl::HighlightAllMatchesAsync(const winrt::hstring text, const bool caseSensitive)
+    {
+        if (_closing)
+        {
+            co_return 0;
+        }
+
+        // Keep the core alive, in case the control is closed in the meantime.
+        const auto core{ _core };
+        co_await winrt::resume_background();
+        co_return core->HighlightAllMatches(text, caseSensitive);
+    }
+
     // Method Description:
     // - Search text in text buffer. This is triggered if the user click
     //   search button or press enter.
@@ -247,6 +338,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                              RoutedEventArgs const& /*args*/)
     {
         _searchBox->Visibility(Visibility::Collapsed);
+        _core->ClearSearch();
 
         // Set focus back to terminal control
         this->Focus(FocusState::Programmatic);
@@ -379,6 +471,46 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core->ToggleShaderEffects();
     }
 
+    // Method Description:
+    // - Handles both the Loaded and the Unloaded event. While we're not part
+    //   of the visual tree, nothing gets painted, and once we've been gone for
+    //   a while the GPU resources of the renderer are released as well.
+    // - Loaded and Unloaded aren't guaranteed to be raised in order when the
+    //   control is moved around quickly, which is why IsLoaded() is checked
+    //   instead of trusting which of the two events got us here.
+    void TermControl::_LoadedChanged(const IInspectable& /*sender*/, const RoutedEventArgs& /*args*/)
+    {
+        if (_closing)
+        {
+            return;
+        }
+
+        const auto loaded = IsLoaded();
+        _core->ControlVisibilityChanged(loaded);
+        if (loaded)
+        {
+            _trimRenderResourcesTimer.Stop();
+        }
+        else
+        {
+            _trimRenderResourcesTimer.Start();
+        }
+    }
+
+    void TermControl::_TrimRenderResourcesTimerTick(const IInspectable& /*sender*/, const IInspectable& /*e*/)
+    {
+        _trimRenderResourcesTimer.Stop();
+        if (!_closing && !IsLoaded())
+        {
+            _core->TrimRenderResources();
+        }
+    }
+
+    void TermControl::WindowVisibilityChanged(const bool showOrHide)
+    {
+        _core->WindowVisibilityChanged(showOrHide);
+    }
+
     // Method Description:
     // - Style our UI elements based on the values in our _settings, and set up
     //   other control-specific settings. This method will be called whenever
@@ -692,40 +824,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         ScrollBar().ViewportSize(bufferHeight);
         ScrollBar().LargeChange(std::max(bufferHeight - 1, 0)); // scroll one "screenful" at a time when the scroll bar is clicked
 
-        // Set up blinking cursor
-        int blinkTime = GetCaretBlinkTime();
-        if (blinkTime != INFINITE)
-        {
-            // Create a timer
-            DispatcherTimer cursorTimer;
-            cursorTimer.Interval(std::chrono::milliseconds(blinkTime));
-            cursorTimer.Tick({ get_weak(), &TermControl::_CursorTimerTick });
-            cursorTimer.Start();
-            _cursorTimer.emplace(std::move(cursorTimer));
-        }
-        else
-        {
-            // The user has disabled cursor blinking
-            _cursorTimer = std::nullopt;
-        }
-
-        // Set up blinking attributes
-        BOOL animationsEnabled = TRUE;
-        SystemParametersInfoW(SPI_GETCLIENTAREAANIMATION, 0, &animationsEnabled, 0);
-        if (animationsEnabled && blinkTime != INFINITE)
-        {
-            // Create a timer
-            DispatcherTimer blinkTimer;
-            blinkTimer.Interval(std::chrono::milliseconds(blinkTime));
-            blinkTimer.Tick({ get_weak(), &TermControl::_BlinkTimerTick });
-            blinkTimer.Start();
-            _blinkTimer.emplace(std::move(blinkTimer));
-        }
-        else
-        {
-            // The user has disabled blinking
-            _blinkTimer = std::nullopt;
-        }
+        // The cursor and the blinking text are blinked by the core, with the
+        // BlinkClock that all the controls share.
 
         // Now that the renderer is set up, update the appearance for initialization
         _UpdateAppearanceFromUIThread(_settings);
@@ -997,13 +1097,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                         keyDown) :
                                  true;
 
-        if (_cursorTimer.has_value())
-        {
-            // Manually show the cursor when a key is pressed. Restarting
-            // the timer prevents flickering.
-            _core->CursorOn(true);
-            _cursorTimer.value().Start();
-        }
+        // Manually show the cursor when a key is pressed. Restarting
+        // the blink prevents flickering.
+        _core->RestartCursorBlink();
 
         return handled;
     }
@@ -1105,6 +1201,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                          _focused,
                                          pixelPosition);
 
+            if (_interactivity->HasPendingMouseMove())
+            {
+                _flushPendingMouseMove->Run();
+            }
+
             if (_focused && point.Properties().IsLeftButtonPressed())
             {
                 const double cursorBelowBottomDist = cursorPosition.Y - SwapChainPanel().Margin().Top - SwapChainPanel().ActualHeight();
@@ -1137,6 +1238,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             til::point newTouchPoint{ til::math::rounding, contactRect.X, contactRect.Y };
 
             _interactivity->TouchMoved(newTouchPoint, _focused);
+            _SchedulePendingScroll();
         }
 
         args.Handled(true);
@@ -1206,6 +1308,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                  point.Properties().MouseWheelDelta(),
                                                  _toTerminalOrigin(point.Position()),
                                                  TermControl::GetPressedMouseButtons(point));
+        _SchedulePendingScroll();
         if (result)
         {
             args.Handled(true);
@@ -1232,7 +1335,25 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         TerminalInput::MouseButtonState state{ leftButtonDown,
                                                midButtonDown,
                                                rightButtonDown };
-        return _interactivity->MouseWheel(modifiers, delta, _toTerminalOrigin(location), state);
+        const auto result = _interactivity->MouseWheel(modifiers, delta, _toTerminalOrigin(location), state);
+        _SchedulePendingScroll();
+        return result;
+    }
+
+    // Method Description:
+    // - Moves the viewport to where the user scrolled to once the current
+    //   frame is over, if the scroll is still pending. See
+    //   ControlInteractivity::UpdateScrollbar.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TermControl::_SchedulePendingScroll()
+    {
+        if (_interactivity->HasPendingScroll())
+        {
+            _flushPendingScroll->Run();
+        }
     }
 
     // Method Description:
@@ -1305,6 +1426,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         const auto newValue = args.NewValue();
         _interactivity->UpdateScrollbar(newValue);
+        _SchedulePendingScroll();
 
         // User input takes priority over terminal events so cancel
         // any pending scroll bar update if the user scrolls.
@@ -1468,17 +1590,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             TSFInputControl().NotifyFocusEnter();
         }
 
-        if (_cursorTimer.has_value())
-        {
-            // When the terminal focuses, show the cursor immediately
-            _core->CursorOn(true);
-            _cursorTimer.value().Start();
-        }
-
-        if (_blinkTimer.has_value())
-        {
-            _blinkTimer.value().Start();
-        }
+        // When the terminal focuses, show the cursor immediately
+        _core->FocusChanged(true);
 
         _interactivity->GainFocus();
 
@@ -1517,16 +1630,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             TSFInputControl().NotifyFocusLeave();
         }
 
-        if (_cursorTimer.has_value())
-        {
-            _cursorTimer.value().Stop();
-            _core->CursorOn(false);
-        }
-
-        if (_blinkTimer.has_value())
-        {
-            _blinkTimer.value().Stop();
-        }
+        _core->FocusChanged(false);
 
         // Check if there is an unfocused config we should set the appearance to
         // upon losing focus
@@ -1588,34 +1692,6 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core->ScaleChanged(scaleX);
     }
 
-    // Method Description:
-    // - Toggle the cursor on and off when called by the cursor blink timer.
-    // Arguments:
-    // - sender: not used
-    // - e: not used
-    void TermControl::_CursorTimerTick(Windows::Foundation::IInspectable const& /* sender */,
-                                       Windows::Foundation::IInspectable const& /* e */)
-    {
-        if (!_closing)
-        {
-            _core->BlinkCursor();
-        }
-    }
-
-    // Method Description:
-    // - Toggle the blinking rendition state when called by the blink timer.
-    // Arguments:
-    // - sender: not used
-    // - e: not used
-    void TermControl::_BlinkTimerTick(Windows::Foundation::IInspectable const& /* sender */,
-                                      Windows::Foundation::IInspectable const& /* e */)
-    {
-        if (!_closing)
-        {
-            _core->BlinkAttributeTick();
-        }
-    }
-
     // Method Description:
     // - Sets selection's end position to match supplied cursor position, e.g. while mouse dragging.
     // Arguments:
@@ -1723,7 +1799,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
             _RestorePointerCursorHandlers(*this, nullptr);
 
-            // These four throttled functions are triggered by terminal output and interact with the UI.
+            // These throttled functions are triggered by terminal output and interact with the UI.
             // Since Close() is the point after which we are removed from the UI, but before the destructor
             // has run, we should disconnect them *right now*. If we don't, they may fire between the
             // throttle delay (from the final output) and the dtor.
@@ -1731,10 +1807,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _updatePatternLocations.reset();
             _updateScrollBar.reset();
             _playWarningBell.reset();
+            _updateTitle.reset();
+            _updateTaskbarProgress.reset();
 
             // Disconnect the TSF input control so it doesn't receive EditContext events.
             TSFInputControl().Close();
             _autoScrollTimer.Stop();
+            _trimRenderResourcesTimer.Stop();
 
             _core->Close();
         }
@@ -1763,6 +1842,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _core->ViewHeight();
     }
 
+    // Method Description:
+    // - Gets the resources this control uses and the work it does.
+    //   See ControlCore::Statistics.
+    Control::ControlStatistics TermControl::Statistics()
+    {
+        return _core->Statistics();
+    }
+
     // Function Description:
     // - Determines how much space (in pixels) an app would need to reserve to
     //   create a control with the settings stored in the settings param. This
@@ -2563,4 +2650,26 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         _playWarningBell->Run();
     }
+
+    // Method Description:
+    // - Passes the title of the terminal on, at most once per frame. This is
+    //   called on the thread reading the output of the connection.
+    void TermControl::_coreTitleChanged(const IInspectable& /*sender*/, const Control::TitleChangedEventArgs& args)
+    {
+        if (const auto updateTitle{ _updateTitle })
+        {
+            updateTitle->Run(args.Title());
+        }
+    }
+
+    // Method Description:
+    // - Passes a change of the taskbar progress on, at most once per frame.
+    //   The listeners query the current state when they're called.
+    void TermControl::_coreTaskbarProgressChanged(const IInspectable& /*sender*/, const IInspectable& /*args*/)
+    {
+        if (const auto updateTaskbarProgress{ _updateTaskbarProgress })
+        {
+            updateTaskbarProgress->Run();
+        }
+    }
 }
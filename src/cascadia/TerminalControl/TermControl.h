@@ -55,6 +55,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         int BufferHeight() const;
 
         bool BracketedPasteEnabled() const noexcept;
+
+        Control::ControlStatistics Statistics();
 #pragma endregion
 
         void ScrollViewport(int viewTop);
@@ -65,6 +67,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void SendInput(const winrt::hstring& input);
         void ToggleShaderEffects();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         winrt::fire_and_forget RenderEngineSwapChainChanged(IInspectable sender, IInspectable args);
         void _AttachDxgiSwapChainToXaml(HANDLE swapChainHandle);
@@ -77,6 +80,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void CreateSearchBoxControl();
 
         void SearchMatch(const bool goForward);
+        Windows::Foundation::IAsyncOperation<uint32_t> HighlightAllMatchesAsync(const winrt::hstring text, const bool caseSensitive);
 
         bool OnDirectKeyEvent(const uint32_t vkey, const uint8_t scanCode, const bool down);
 
@@ -113,9 +117,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         WINRT_CALLBACK(FontSizeChanged, Control::FontSizeChangedEventArgs);
 
         FORWARDED_TYPED_EVENT(CopyToClipboard,        IInspectable, Control::CopyToClipboardEventArgs, _core, CopyToClipboard);
-        FORWARDED_TYPED_EVENT(TitleChanged,           IInspectable, Control::TitleChangedEventArgs, _core, TitleChanged);
         FORWARDED_TYPED_EVENT(TabColorChanged,        IInspectable, IInspectable, _core, TabColorChanged);
-        FORWARDED_TYPED_EVENT(SetTaskbarProgress,     IInspectable, IInspectable, _core, TaskbarProgressChanged);
         FORWARDED_TYPED_EVENT(ConnectionStateChanged, IInspectable, IInspectable, _core, ConnectionStateChanged);
         FORWARDED_TYPED_EVENT(PasteFromClipboard,     IInspectable, Control::PasteFromClipboardEventArgs, _interactivity, PasteFromClipboard);
 
@@ -127,6 +129,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         TYPED_EVENT(FocusFollowMouseRequested, IInspectable, IInspectable);
         TYPED_EVENT(Initialized,               Control::TermControl, Windows::UI::Xaml::RoutedEventArgs);
         TYPED_EVENT(WarningBell,               IInspectable, IInspectable);
+        TYPED_EVENT(TitleChanged,              IInspectable, Control::TitleChangedEventArgs);
+        TYPED_EVENT(SetTaskbarProgress,        IInspectable, IInspectable);
         // clang-format on
 
         WINRT_PROPERTY(IControlAppearance, UnfocusedAppearance);
@@ -156,7 +160,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         std::shared_ptr<ThrottledFuncTrailing<>> _tsfTryRedrawCanvas;
         std::shared_ptr<ThrottledFuncTrailing<>> _updatePatternLocations;
+        std::shared_ptr<ThrottledFuncTrailing<>> _flushPendingMouseMove;
+        std::shared_ptr<ThrottledFuncTrailing<>> _flushPendingScroll;
         std::shared_ptr<ThrottledFuncLeading> _playWarningBell;
+        std::shared_ptr<ThrottledFuncTrailing<winrt::hstring>> _updateTitle;
+        std::shared_ptr<ThrottledFuncTrailing<>> _updateTaskbarProgress;
 
         struct ScrollBarUpdate
         {
@@ -177,8 +185,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         winrt::Windows::UI::Composition::ScalarKeyFrameAnimation _bellLightAnimation{ nullptr };
         Windows::UI::Xaml::DispatcherTimer _bellLightTimer{ nullptr };
 
-        std::optional<Windows::UI::Xaml::DispatcherTimer> _cursorTimer;
-        std::optional<Windows::UI::Xaml::DispatcherTimer> _blinkTimer;
+        Windows::UI::Xaml::DispatcherTimer _trimRenderResourcesTimer;
 
         event_token _coreOutputEventToken;
 
@@ -213,8 +220,6 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         winrt::fire_and_forget _HyperlinkHandler(Windows::Foundation::IInspectable sender, Control::OpenHyperlinkEventArgs e);
 
-        void _CursorTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
-        void _BlinkTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
         void _BellLightOff(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
 
         void _SetEndSelectionPointAtCursor(Windows::Foundation::Point const& cursorPosition);
@@ -232,7 +237,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void _TryStartAutoScroll(Windows::UI::Input::PointerPoint const& pointerPoint, const double scrollVelocity);
         void _TryStopAutoScroll(const uint32_t pointerId);
+        void _SchedulePendingScroll();
         void _UpdateAutoScroll(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
+        void _LoadedChanged(const IInspectable& sender, const Windows::UI::Xaml::RoutedEventArgs& args);
+        void _TrimRenderResourcesTimerTick(const IInspectable& sender, const IInspectable& e);
 
         static Windows::UI::Xaml::Thickness _ParseThicknessFromPadding(const hstring padding);
 
@@ -262,6 +270,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _coreReceivedOutput(const IInspectable& sender, const IInspectable& args);
         void _coreRaisedNotice(const IInspectable& s, const Control::NoticeEventArgs& args);
         void _coreWarningBell(const IInspectable& sender, const IInspectable& args);
+        void _coreTitleChanged(const IInspectable& sender, const Control::TitleChangedEventArgs& args);
+        void _coreTaskbarProgressChanged(const IInspectable& sender, const IInspectable& args);
     };
 }
 
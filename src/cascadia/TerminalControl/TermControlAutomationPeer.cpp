@@ -111,6 +111,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         });
     }
 
+    // Method Description:
+    // - Checks whether any ui automation client is listening to events at all
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - true if the signals could be received by a client
+    bool TermControlAutomationPeer::IsListening() const noexcept
+    {
+        return UiaClientsAreListening();
+    }
+
     hstring TermControlAutomationPeer::GetClassNameCore() const
     {
         return L"TermControl";
@@ -56,6 +56,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void SignalSelectionChanged() override;
         void SignalTextChanged() override;
         void SignalCursorChanged() override;
+        bool IsListening() const noexcept override;
 #pragma endregion
 
 #pragma region ITextProvider Pattern
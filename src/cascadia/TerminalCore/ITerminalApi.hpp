@@ -59,6 +59,7 @@ namespace Microsoft::Terminal::Core
         virtual bool EnableAlternateScrollMode(const bool enabled) noexcept = 0;
         virtual bool EnableXtermBracketedPasteMode(const bool enabled) noexcept = 0;
         virtual bool IsXtermBracketedPasteModeEnabled() const = 0;
+        virtual bool SetSynchronizedOutput(const bool enabled) noexcept = 0;
 
         virtual bool IsVtInputEnabled() const = 0;
 
@@ -67,6 +68,8 @@ namespace Microsoft::Terminal::Core
         virtual bool AddHyperlink(std::wstring_view uri, std::wstring_view params) noexcept = 0;
         virtual bool EndHyperlink() noexcept = 0;
 
+        virtual bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept = 0;
+
         virtual bool SetTaskbarProgress(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::TaskbarState state, const size_t progress) noexcept = 0;
 
         virtual bool SetWorkingDirectory(std::wstring_view uri) noexcept = 0;
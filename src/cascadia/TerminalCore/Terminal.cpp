@@ -70,21 +70,44 @@ Terminal::Terminal() :
     };
 
     _terminalInput = std::make_unique<TerminalInput>(passAlongInput);
+    // The sequences are passed along as they are, instead of being turned into
+    // key events and back. The string is reused, so that typing doesn't allocate.
+    _terminalInput->SetWriteSequenceCallback([&](const std::wstring_view sequence) {
+        if (!_pfnWriteInput)
+        {
+            return;
+        }
+        _inputSequence.assign(sequence);
+        _pfnWriteInput(_inputSequence);
+    });
 
     _InitializeColorTable();
 }
 
-void Terminal::Create(COORD viewportSize, SHORT scrollbackLines, IRenderTarget& renderTarget)
+void Terminal::Create(COORD viewportSize, int scrollbackLines, IRenderTarget& renderTarget)
 {
     _mutableViewport = Viewport::FromDimensions({ 0, 0 }, viewportSize);
-    _scrollbackLines = scrollbackLines;
-    const COORD bufferSize{ viewportSize.X,
-                            Utils::ClampToShortMax(viewportSize.Y + scrollbackLines, 1) };
+    _scrollbackLines = std::max(scrollbackLines, 0);
+    const COORD bufferSize{ viewportSize.X, _BufferHeight(viewportSize.Y) };
     const TextAttribute attr{};
     const UINT cursorSize = 12;
     _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, renderTarget);
 }
 
+// Method Description:
+// - Returns how tall the buffer should be for the given viewport, to hold the
+//   scrollback on top of it. The rows of the buffer are still addressed with
+//   SHORTs, so this is where a larger scrollback is cut down to what fits.
+// Arguments:
+// - viewportHeight: The height of the mutable viewport.
+// Return Value:
+// - The height of the buffer.
+short Terminal::_BufferHeight(const short viewportHeight) const noexcept
+{
+    const int height = ::base::ClampAdd(int{ viewportHeight }, _scrollbackLines);
+    return Utils::ClampToShortMax(height, 1);
+}
+
 // Method Description:
 // - Initializes the Terminal from the given set of settings.
 // Arguments:
@@ -97,7 +120,7 @@ void Terminal::CreateFromSettings(ICoreSettings settings,
                               Utils::ClampToShortMax(settings.InitialRows(), 1) };
 
     // TODO:MSFT:20642297 - Support infinite scrollback here, if HistorySize is -1
-    Create(viewportSize, Utils::ClampToShortMax(settings.HistorySize(), 0), renderTarget);
+    Create(viewportSize, settings.HistorySize(), renderTarget);
 
     UpdateSettings(settings);
 }
@@ -144,8 +167,12 @@ void Terminal::UpdateSettings(ICoreSettings settings)
     // size is smaller than where the mutable viewport currently is, we'll want
     // to make sure to rotate the buffer contents upwards, so the mutable viewport
     // remains at the bottom of the buffer.
-    if (_buffer)
+    // Setting up the patterns again means scanning the whole viewport for
+    // them, so only do that if they actually changed.
+    if (_buffer && _detectURLs != settings.DetectURLs())
     {
+        _detectURLs = settings.DetectURLs();
+
         // Clear the patterns first
         _buffer->ClearPatternRecognizers();
         if (settings.DetectURLs())
@@ -234,7 +261,7 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
 
     const auto oldTop = _mutableViewport.Top();
 
-    const short newBufferHeight = ::base::ClampAdd(viewportSize.Y, _scrollbackLines);
+    const short newBufferHeight = _BufferHeight(viewportSize.Y);
 
     COORD bufferSize{ viewportSize.X, newBufferHeight };
 
@@ -405,6 +432,9 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
 
     _buffer.swap(newTextBuffer);
 
+    // The reflowed text isn't where the matches were found anymore.
+    ClearSearchHighlights();
+
     // GH#3494: Maintain scrollbar position during resize
     // Make sure that we don't scroll past the mutableViewport at the bottom of the buffer
     newVisibleTop = std::min(newVisibleTop, _mutableViewport.Top());
@@ -428,9 +458,123 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
 
 void Terminal::Write(std::wstring_view stringView)
 {
-    auto lock = LockForWriting();
+    auto lock = _LockForTimedWriting();
+
+    _ProcessTimed(stringView);
+}
+
+// Method Description:
+// - Parses several chunks of output, one after the other, while holding the
+//   write lock only once.
+// Arguments:
+// - chunks: the strings to parse, in order
+// Return Value:
+// - <none>
+void Terminal::Write(const gsl::span<const std::wstring_view> chunks)
+{
+    auto lock = _LockForTimedWriting();
+
+    for (const auto& chunk : chunks)
+    {
+        _ProcessTimed(chunk);
+    }
+}
+
+// Method Description:
+// - Returns the statistics of the output that was written since the last call
+//   and starts over. This is meant for periodic throughput tracing.
+// - The caller needs to hold the write lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - the chunks and characters written, and where they spent their time
+Terminal::OutputStatistics Terminal::TakeOutputStatistics() noexcept
+{
+    return std::exchange(_outputStatistics, {});
+}
+
+// Method Description:
+// - Acquires the write lock for Write and counts the time it took.
+// Arguments:
+// - <none>
+// Return Value:
+// - the acquired write lock
+std::unique_lock<TerminalLock> Terminal::_LockForTimedWriting()
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto lock = LockForWriting("Write");
+    _outputStatistics.lockWait += std::chrono::steady_clock::now() - start;
+    return lock;
+}
+
+// Method Description:
+// - Parses a single chunk of output and counts it. The write lock must be held.
+// Arguments:
+// - chunk: the string to parse
+// Return Value:
+// - <none>
+void Terminal::_ProcessTimed(const std::wstring_view chunk)
+{
+    const auto start = std::chrono::steady_clock::now();
+    _deferColorChanges = true;
+    {
+        // Apply whatever we collected even if parsing threw.
+        auto flushColors = wil::scope_exit([&]() noexcept {
+            _deferColorChanges = false;
+            try
+            {
+                _FlushColorChanges();
+            }
+            CATCH_LOG();
+        });
+        _stateMachine->ProcessString(chunk);
+    }
+    _outputStatistics.parse += std::chrono::steady_clock::now() - start;
+    _outputStatistics.chunks++;
+    _outputStatistics.chars += chunk.size();
+}
+
+// Method Description:
+// - Called whenever the color table, the default colors or the screen
+//   reversal changed. While a chunk of output is being parsed, we only remember
+//   that it happened, so that a stream of OSC 4 sequences doesn't invalidate
+//   and notify once per sequence. Otherwise the change is applied right away.
+// Arguments:
+// - backgroundChanged: true if the default background color changed
+// Return Value:
+// - <none>
+void Terminal::_NotifyColorsChanged(const bool backgroundChanged)
+{
+    _colorsChanged = true;
+    _backgroundColorChanged |= backgroundChanged;
+
+    if (!_deferColorChanges)
+    {
+        _FlushColorChanges();
+    }
+}
+
+// Method Description:
+// - Repaints everything once, and tells our host about the new background
+//   color, if any color changed since the last flush.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::_FlushColorChanges()
+{
+    if (!std::exchange(_colorsChanged, false))
+    {
+        return;
+    }
 
-    _stateMachine->ProcessString(stringView);
+    if (std::exchange(_backgroundColorChanged, false) && _pfnBackgroundColorChanged)
+    {
+        _pfnBackgroundColorChanged(_defaultBg);
+    }
+
+    // Repaint everything - the colors might have changed
+    _buffer->GetRenderTarget().TriggerRedrawAll();
 }
 
 void Terminal::WritePastedText(std::wstring_view stringView)
@@ -469,6 +613,32 @@ void Terminal::TrySnapOnInput()
     }
 }
 
+// Method Description:
+// - Scrolls the closest prompt above or below the top of the viewport to
+//   the top of it. The prompts are the ones the shell marked, which are
+//   looked up instead of searched for, however long the history is.
+// Arguments:
+// - next: true to scroll down to the next prompt, false to scroll up
+// Return Value:
+// - false if there's no prompt in that direction.
+bool Terminal::ScrollToPrompt(const bool next)
+{
+    auto lock = LockForWriting();
+
+    const auto top = gsl::narrow_cast<SHORT>(_VisibleStartIndex());
+    const auto& marks = _buffer->GetMarks();
+    const auto prompt = next ? marks.Next(MarkKind::Prompt, top) : marks.Previous(MarkKind::Prompt, top);
+    if (!prompt)
+    {
+        return false;
+    }
+
+    _scrollOffset = std::max(0, ViewStartIndex() - prompt->position.Y);
+    _buffer->GetRenderTarget().TriggerScroll();
+    _NotifyScrollEvent();
+    return true;
+}
+
 // Routine Description:
 // - Relays if we are tracking mouse input
 // Parameters:
@@ -699,12 +869,13 @@ bool Terminal::SendCharEvent(const wchar_t ch, const WORD scanCode, const Contro
     // Unfortunately, the UI doesn't give us both a character down and a
     // character up event, only a character received event. So fake sending both
     // to the terminal input translator. Unless it's in win32-input-mode, it'll
-    // ignore the keyup.
-    KeyEvent keyDown{ true, 1, vkey, scanCode, ch, states.Value() };
-    KeyEvent keyUp{ false, 1, vkey, scanCode, ch, states.Value() };
-    const auto handledDown = _terminalInput->HandleKey(&keyDown);
-    const auto handledUp = _terminalInput->HandleKey(&keyUp);
-    return handledDown || handledUp;
+    // ignore the keyup. They're handed over together, so that they're written
+    // to the connection with a single write in win32-input-mode.
+    const std::array<KeyEvent, 2> keys{
+        KeyEvent{ true, 1, vkey, scanCode, ch, states.Value() },
+        KeyEvent{ false, 1, vkey, scanCode, ch, states.Value() },
+    };
+    return _terminalInput->HandleKeys(keys);
 }
 
 // Method Description:
@@ -864,22 +1035,38 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 
 // Method Description:
 // - Acquire a read lock on the terminal.
+// - These aren't inlined, so that the lock's history can tell who took it.
+// Arguments:
+// - tag: what the lock is taken for, for the history of the lock. Optional,
+//   must be a literal.
 // Return Value:
 // - a shared_lock which can be used to unlock the terminal. The shared_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::shared_lock<std::shared_mutex> Terminal::LockForReading()
+[[nodiscard]] __declspec(noinline) std::shared_lock<TerminalLock> Terminal::LockForReading(const char* tag)
 {
-    return std::shared_lock<std::shared_mutex>(_readWriteLock);
+    _readWriteLock.lock_shared(tag, _ReturnAddress());
+    return std::shared_lock<TerminalLock>(_readWriteLock, std::adopt_lock);
 }
 
 // Method Description:
 // - Acquire a write lock on the terminal.
+// Arguments:
+// - tag: what the lock is taken for, for the history of the lock. Optional,
+//   must be a literal.
 // Return Value:
 // - a unique_lock which can be used to unlock the terminal. The unique_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<std::shared_mutex> Terminal::LockForWriting()
+[[nodiscard]] __declspec(noinline) std::unique_lock<TerminalLock> Terminal::LockForWriting(const char* tag)
+{
+    _readWriteLock.lock(tag, _ReturnAddress());
+    return std::unique_lock<TerminalLock>(_readWriteLock, std::adopt_lock);
+}
+
+// Method Description:
+// - Returns the lock of the terminal, to profile who holds it. See TerminalLock.
+TerminalLock& Terminal::GetLock() noexcept
 {
-    return std::unique_lock<std::shared_mutex>(_readWriteLock);
+    return _readWriteLock;
 }
 
 Viewport Terminal::_GetMutableViewport() const noexcept
@@ -943,6 +1130,19 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
         const COORD cursorPosBefore = cursor.GetPosition();
         COORD proposedCursorPosition = cursorPosBefore;
 
+        // Plain narrow text doesn't need to go through an OutputCellIterator
+        // one character at a time. Write as much of it as fits on this row at once.
+        // Only the cells that changed are redrawn, so rewriting a line over
+        // and over (like progress bars do) doesn't repaint all of it.
+        const auto runLength = _buffer->WriteRun(stringView.substr(i), _buffer->GetCurrentAttributes(), cursorPosBefore, true);
+        if (runLength > 0)
+        {
+            proposedCursorPosition.X += gsl::narrow<SHORT>(runLength);
+            i += runLength - 1;
+            _AdjustCursorPosition(proposedCursorPosition);
+            continue;
+        }
+
         // TODO: MSFT 21006766
         // This is not great but I need it demoable. Fix by making a buffer stream writer.
         //
@@ -1015,6 +1215,7 @@ void Terminal::_AdjustCursorPosition(const COORD proposedPosition)
 
         // manually erase our pattern intervals since the locations have changed now
         _patternIntervalTree = {};
+        std::atomic_store(&_hoverIndex, std::shared_ptr<const HoverIndex>{});
     }
 
     // Update Cursor Position
@@ -1034,6 +1235,15 @@ void Terminal::_AdjustCursorPosition(const COORD proposedPosition)
         }
     }
 
+    // Rows that just left the top of the mutable viewport are scrollback now.
+    // Store them compactly; they're re-expanded if anything writes to them.
+    const auto rowsScrolledOut = std::min<int>(scrollAmount + newRows, _mutableViewport.Top());
+    if (rowsScrolledOut > 0)
+    {
+        _buffer->CompactRows(gsl::narrow_cast<size_t>(_mutableViewport.Top() - rowsScrolledOut),
+                             gsl::narrow_cast<size_t>(rowsScrolledOut));
+    }
+
     // If the viewport moved, or we circled the buffer, we might need to update
     // our _scrollOffset
     if (updatedViewport || newRows != 0)
@@ -1204,6 +1414,24 @@ void Terminal::SetCursorOn(const bool isOn)
     _buffer->GetCursor().SetIsOn(isOn);
 }
 
+// Method Description:
+// - Like SetCursorOn, but gives up instead of waiting if someone else holds
+//   the write lock, which is usually the output thread parsing a flood.
+// Arguments:
+// - isOn: whether the cursor should be on
+// Return Value:
+// - false if the lock was held and the cursor was left alone.
+bool Terminal::TrySetCursorOn(const bool isOn)
+{
+    std::unique_lock<TerminalLock> lock{ _readWriteLock, std::try_to_lock };
+    if (!lock)
+    {
+        return false;
+    }
+    _buffer->GetCursor().SetIsOn(isOn);
+    return true;
+}
+
 bool Terminal::IsCursorBlinkingAllowed() const noexcept
 {
     const auto& cursor = _buffer->GetCursor();
@@ -1221,6 +1449,105 @@ void Terminal::UpdatePatternsUnderLock() noexcept
     _patternIntervalTree = _buffer->GetPatterns(_VisibleStartIndex(), _VisibleEndIndex());
     _InvalidatePatternTree(oldTree);
     _InvalidatePatternTree(_patternIntervalTree);
+    _PublishHoverIndex();
+}
+
+// Method Description:
+// - Publishes a new HoverIndex for the current viewport, made of the hyperlink
+//   IDs of its cells and the URI patterns in _patternIntervalTree.
+// - INVARIANT: this function can only be called if the caller has the writing lock on the terminal
+void Terminal::_PublishHoverIndex() noexcept
+try
+{
+    const auto viewport = _GetVisibleViewport();
+    const til::size size{ viewport.Width(), viewport.Height() };
+    const auto width = gsl::narrow_cast<size_t>(viewport.Width());
+
+    std::vector<uint16_t> hyperlinkIds;
+    for (auto y = 0; y < viewport.Height(); ++y)
+    {
+        const auto& attrRow = _buffer->GetRowByOffset(gsl::narrow_cast<size_t>(viewport.Top()) + y).GetAttrRow();
+        if (attrRow.GetHyperlinks().empty())
+        {
+            continue;
+        }
+
+        hyperlinkIds.resize(width * viewport.Height());
+        for (size_t x = 0; x < width; ++x)
+        {
+            til::at(hyperlinkIds, y * width + x) = attrRow.GetAttrByColumn(gsl::narrow_cast<uint16_t>(x)).GetHyperlinkId();
+        }
+    }
+
+    std::vector<HoverIndex::interval> patterns;
+    _patternIntervalTree.visit_all([&](const auto& interval) {
+        if (interval.value == _hyperlinkPatternId)
+        {
+            patterns.emplace_back(interval);
+        }
+    });
+
+    std::atomic_store(&_hoverIndex, std::shared_ptr<const HoverIndex>{ std::make_shared<HoverIndex>(size, std::move(hyperlinkIds), std::move(patterns)) });
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    std::atomic_store(&_hoverIndex, std::shared_ptr<const HoverIndex>{});
+}
+
+// Method Description:
+// - Gets the hyperlinks in the viewport, as of the last pattern update.
+// - This can be called without holding the terminal lock.
+// Return value:
+// - The index, or null if the viewport moved since the last pattern update.
+std::shared_ptr<const Terminal::HoverIndex> Terminal::GetHoverIndex() const noexcept
+{
+    return std::atomic_load(&_hoverIndex);
+}
+
+Terminal::HoverIndex::HoverIndex(const til::size size, std::vector<uint16_t> hyperlinkIds, std::vector<interval> patterns) noexcept :
+    _size{ size },
+    _hyperlinkIds{ std::move(hyperlinkIds) },
+    _patterns{ std::move(patterns) }
+{
+}
+
+// Method Description:
+// - Gets the hyperlink ID of the text at the given position, like Terminal::GetHyperlinkIdAtPosition
+// Arguments:
+// - The position of the text, relative to the viewport
+// Return value:
+// - The hyperlink ID
+uint16_t Terminal::HoverIndex::GetHyperlinkIdAtPosition(const til::point position) const noexcept
+{
+    if (_hyperlinkIds.empty())
+    {
+        return 0;
+    }
+
+    // like _ConvertToBufferCell, positions outside of the viewport are clamped to it
+    const auto x = std::clamp<ptrdiff_t>(position.x(), 0, _size.width() - 1);
+    const auto y = std::clamp<ptrdiff_t>(position.y(), 0, _size.height() - 1);
+    return til::at(_hyperlinkIds, gsl::narrow_cast<size_t>(y * _size.width() + x));
+}
+
+// Method Description:
+// - Gets the URI pattern at the given position, like Terminal::GetHyperlinkIntervalFromPosition
+// Arguments:
+// - The position, relative to the viewport
+// Return value:
+// - The interval representing the start and end coordinates
+std::optional<Terminal::HoverIndex::interval> Terminal::HoverIndex::GetHyperlinkIntervalFromPosition(const til::point position) const noexcept
+{
+    const til::point next{ position.x() + 1, position.y() };
+    for (const auto& pattern : _patterns)
+    {
+        if (pattern.stop >= next && pattern.start <= position)
+        {
+            return pattern;
+        }
+    }
+    return std::nullopt;
 }
 
 // Method Description:
@@ -1232,6 +1559,38 @@ void Terminal::ClearPatternTree() noexcept
     auto oldTree = _patternIntervalTree;
     _patternIntervalTree = {};
     _InvalidatePatternTree(oldTree);
+    std::atomic_store(&_hoverIndex, std::shared_ptr<const HoverIndex>{});
+}
+
+// Method Description:
+// - Highlights all the matches of a search, until the next search replaces
+//   them or ClearSearchHighlights is called. Their rows are stored counted
+//   from the first row the buffer ever had, so that they stay on their text
+//   while new output circles the buffer.
+// Arguments:
+// - matches: the inclusive start and end of every match, in buffer coordinates
+// Return Value:
+// - <none>
+void Terminal::SetSearchHighlights(const std::vector<std::pair<COORD, COORD>>& matches)
+{
+    const auto origin = gsl::narrow_cast<ptrdiff_t>(_buffer->GetMarks().GetOrigin());
+
+    PointTree::interval_vector intervals;
+    intervals.reserve(matches.size());
+    for (const auto& [start, end] : matches)
+    {
+        const til::point first{ gsl::narrow_cast<ptrdiff_t>(start.X), origin + start.Y };
+        const til::point last{ gsl::narrow_cast<ptrdiff_t>(end.X), origin + end.Y };
+        intervals.push_back(PointTree::interval(first, last, intervals.size()));
+    }
+    _searchHighlights = PointTree{ std::move(intervals) };
+}
+
+// Method Description:
+// - Removes the highlights of the last search.
+void Terminal::ClearSearchHighlights() noexcept
+{
+    _searchHighlights = {};
 }
 
 // Method Description:
@@ -16,6 +16,7 @@
 #include "../../types/IUiaData.h"
 #include "../../cascadia/terminalcore/ITerminalApi.hpp"
 #include "../../cascadia/terminalcore/ITerminalInput.hpp"
+#include "../../cascadia/terminalcore/TerminalLock.hpp"
 
 static constexpr std::wstring_view linkPattern{ LR"(\b(https?|ftp|file)://[-A-Za-z0-9+&@#/%?=~_|$!:,.;]*[A-Za-z0-9+&@#/%=~_|$])" };
 static constexpr size_t TaskbarMinProgress{ 10 };
@@ -60,7 +61,7 @@ public:
     Terminal& operator=(Terminal&&) = default;
 
     void Create(COORD viewportSize,
-                SHORT scrollbackLines,
+                int scrollbackLines,
                 Microsoft::Console::Render::IRenderTarget& renderTarget);
 
     void CreateFromSettings(winrt::Microsoft::Terminal::Core::ICoreSettings settings,
@@ -71,12 +72,25 @@ public:
 
     // Write goes through the parser
     void Write(std::wstring_view stringView);
+    void Write(const gsl::span<const std::wstring_view> chunks);
+
+    // Where the output that went through Write spent its time, see TakeOutputStatistics.
+    struct OutputStatistics
+    {
+        uint64_t chunks = 0;
+        uint64_t chars = 0;
+        std::chrono::nanoseconds lockWait{}; // waiting for the write lock
+        std::chrono::nanoseconds parse{}; // in the state machine, including the buffer writes
+        std::chrono::nanoseconds bufferWrite{}; // putting printable text into the buffer
+    };
+    OutputStatistics TakeOutputStatistics() noexcept;
 
     // WritePastedText goes directly to the connection
     void WritePastedText(std::wstring_view stringView);
 
-    [[nodiscard]] std::shared_lock<std::shared_mutex> LockForReading();
-    [[nodiscard]] std::unique_lock<std::shared_mutex> LockForWriting();
+    [[nodiscard]] std::shared_lock<TerminalLock> LockForReading(const char* tag = nullptr);
+    [[nodiscard]] std::unique_lock<TerminalLock> LockForWriting(const char* tag = nullptr);
+    TerminalLock& GetLock() noexcept;
 
     short GetBufferHeight() const noexcept;
 
@@ -120,6 +134,7 @@ public:
     bool EnableAlternateScrollMode(const bool enabled) noexcept override;
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override;
     bool IsXtermBracketedPasteModeEnabled() const noexcept override;
+    bool SetSynchronizedOutput(const bool enabled) noexcept override;
 
     bool IsVtInputEnabled() const noexcept override;
 
@@ -128,6 +143,8 @@ public:
     bool AddHyperlink(std::wstring_view uri, std::wstring_view params) noexcept override;
     bool EndHyperlink() noexcept override;
 
+    bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept override;
+
     bool SetTaskbarProgress(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::TaskbarState state, const size_t progress) noexcept override;
     bool SetWorkingDirectory(std::wstring_view uri) noexcept override;
     std::wstring_view GetWorkingDirectory() noexcept override;
@@ -149,10 +166,33 @@ public:
 
     void TrySnapOnInput() override;
     bool IsTrackingMouseInput() const noexcept;
+    bool ScrollToPrompt(const bool next);
 
     std::wstring GetHyperlinkAtPosition(const COORD position);
     uint16_t GetHyperlinkIdAtPosition(const COORD position);
     std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> GetHyperlinkIntervalFromPosition(const COORD position);
+
+    // The hyperlinks in the viewport, as of the last UpdatePatternsUnderLock.
+    // It's immutable once published, so it can be queried without the
+    // terminal lock, e.g. whenever the mouse moves.
+    class HoverIndex
+    {
+    public:
+        using interval = interval_tree::IntervalTree<til::point, size_t>::interval;
+
+        HoverIndex(const til::size size, std::vector<uint16_t> hyperlinkIds, std::vector<interval> patterns) noexcept;
+
+        uint16_t GetHyperlinkIdAtPosition(const til::point position) const noexcept;
+        std::optional<interval> GetHyperlinkIntervalFromPosition(const til::point position) const noexcept;
+
+    private:
+        til::size _size;
+        // one per viewport cell, row by row. Empty if there are no hyperlinks at all.
+        std::vector<uint16_t> _hyperlinkIds;
+        std::vector<interval> _patterns;
+    };
+
+    std::shared_ptr<const HoverIndex> GetHoverIndex() const noexcept;
 #pragma endregion
 
 #pragma region IBaseData(base to IRenderData and IUiaData)
@@ -182,7 +222,8 @@ public:
     const bool IsGridLineDrawingAllowed() noexcept override;
     const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
     const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
-    const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+    void GetPatternId(const COORD location, std::vector<size_t>& ids) const noexcept override;
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept override;
 #pragma endregion
 
 #pragma region IUiaData
@@ -208,11 +249,15 @@ public:
     void TaskbarProgressChangedCallback(std::function<void()> pfn) noexcept;
 
     void SetCursorOn(const bool isOn);
+    bool TrySetCursorOn(const bool isOn);
     bool IsCursorBlinkingAllowed() const noexcept;
 
     void UpdatePatternsUnderLock() noexcept;
     void ClearPatternTree() noexcept;
 
+    void SetSearchHighlights(const std::vector<std::pair<COORD, COORD>>& matches);
+    void ClearSearchHighlights() noexcept;
+
     const std::optional<til::color> GetTabColor() const noexcept;
     til::color GetDefaultBackground() const noexcept;
 
@@ -233,12 +278,15 @@ public:
     void SetSelectionAnchor(const COORD position);
     void SetSelectionEnd(const COORD position, std::optional<SelectionExpansionMode> newExpansionMode = std::nullopt);
     void SetBlockSelection(const bool isEnabled) noexcept;
+    bool SelectCommandOutput(const COORD viewportPos);
 
     const TextBuffer::TextAndColor RetrieveSelectedTextFromBuffer(bool trimTrailingWhitespace);
+    std::wstring RetrieveSelectedPlainTextFromBuffer(bool singleLine);
 #pragma endregion
 
 private:
     std::function<void(std::wstring&)> _pfnWriteInput;
+    std::wstring _inputSequence;
     std::function<void()> _pfnWarningBell;
     std::function<void(std::wstring_view)> _pfnTitleChanged;
     std::function<void(std::wstring_view)> _pfnCopyToClipboard;
@@ -274,6 +322,8 @@ private:
     size_t _taskbarProgress;
 
     size_t _hyperlinkPatternId;
+    // The DetectURLs setting the pattern recognizers of _buffer were set up for
+    std::optional<bool> _detectURLs;
 
     std::wstring _workingDirectory;
 #pragma region Text Selection
@@ -293,13 +343,28 @@ private:
     SelectionExpansionMode _multiClickSelectionMode;
 #pragma endregion
 
-    std::shared_mutex _readWriteLock;
+    TerminalLock _readWriteLock;
+
+    // Only touched while the write lock is held.
+    OutputStatistics _outputStatistics;
+    std::unique_lock<TerminalLock> _LockForTimedWriting();
+    void _ProcessTimed(const std::wstring_view chunk);
+
+    // Color changes made while a chunk is parsed (OSC 4/10/11, DECSCNM) are
+    // collected here and applied with a single redraw once it's done.
+    bool _deferColorChanges{ false };
+    bool _colorsChanged{ false };
+    bool _backgroundColorChanged{ false };
+    void _NotifyColorsChanged(const bool backgroundChanged);
+    void _FlushColorChanges();
 
     // TODO: These members are not shared by an alt-buffer. They should be
     //      encapsulated, such that a Terminal can have both a main and alt buffer.
     std::unique_ptr<TextBuffer> _buffer;
     Microsoft::Console::Types::Viewport _mutableViewport;
-    SHORT _scrollbackLines;
+    // The scrollback the user asked for. The buffer can't be taller than
+    // SHRT_MAX rows yet, which _BufferHeight takes care of.
+    int _scrollbackLines;
 
     // _scrollOffset is the number of lines above the viewport that are currently visible
     // If _scrollOffset is 0, then the visible region of the buffer is the viewport.
@@ -319,6 +384,14 @@ private:
 
     interval_tree::IntervalTree<til::point, size_t> _patternIntervalTree;
     void _InvalidatePatternTree(interval_tree::IntervalTree<til::point, size_t>& tree);
+
+    // The matches of the last search, with their rows counted from the first
+    // row the buffer ever had (see ScrollMarks::GetOrigin).
+    interval_tree::IntervalTree<til::point, size_t> _searchHighlights;
+
+    // only accessed through std::atomic_load and std::atomic_store, see GetHoverIndex
+    std::shared_ptr<const HoverIndex> _hoverIndex;
+    void _PublishHoverIndex() noexcept;
     void _InvalidateFromCoords(const COORD start, const COORD end);
 
     // Since virtual keys are non-zero, you assume that this field is empty/invalid if it is.
@@ -344,6 +417,7 @@ private:
     Microsoft::Console::Types::Viewport _GetVisibleViewport() const noexcept;
 
     void _InitializeColorTable();
+    short _BufferHeight(const short viewportHeight) const noexcept;
 
     void _WriteBuffer(const std::wstring_view& stringView);
 
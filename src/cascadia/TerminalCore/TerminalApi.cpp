@@ -13,7 +13,9 @@ using namespace Microsoft::Console::VirtualTerminal;
 bool Terminal::PrintString(std::wstring_view stringView) noexcept
 try
 {
+    const auto start = std::chrono::steady_clock::now();
     _WriteBuffer(stringView);
+    _outputStatistics.bufferWrite += std::chrono::steady_clock::now() - start;
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -323,11 +325,13 @@ try
 
         // Since we only did a rotation, the text that was in the scrollback is now _below_ where we are going to move the viewport
         // and we have to make sure we erase that text
+        // The rows are only marked as blank, which is what keeps this quick for a large scrollback.
         const auto eraseStart = _mutableViewport.Height();
         const auto eraseEnd = _buffer->GetLastNonSpaceCharacter(_mutableViewport).Y;
-        for (SHORT i = eraseStart; i <= eraseEnd; i++)
+        if (eraseEnd >= eraseStart)
         {
-            _buffer->GetRowByOffset(i).Reset(_buffer->GetCurrentAttributes());
+            _buffer->ClearRows(eraseStart, gsl::narrow_cast<size_t>(eraseEnd - eraseStart + 1), _buffer->GetCurrentAttributes());
+            _buffer->ResetLineRenditionRange(eraseStart, gsl::narrow_cast<size_t>(eraseEnd) + 1);
         }
 
         // Reset the scroll offset now because there's nothing for the user to 'scroll' to
@@ -383,8 +387,7 @@ try
 {
     _colorTable.at(tableIndex) = color;
 
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(false);
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -453,8 +456,7 @@ try
 {
     _defaultFg = color;
 
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(false);
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -469,10 +471,8 @@ bool Terminal::SetDefaultBackground(const COLORREF color) noexcept
 try
 {
     _defaultBg = color;
-    _pfnBackgroundColorChanged(color);
 
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(true);
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -505,8 +505,7 @@ try
 {
     _screenReversed = reverseMode;
 
-    // Repaint everything - the colors will have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(false);
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -558,6 +557,14 @@ bool Terminal::IsXtermBracketedPasteModeEnabled() const noexcept
     return _bracketedPasteMode;
 }
 
+bool Terminal::SetSynchronizedOutput(const bool enabled) noexcept
+try
+{
+    _buffer->GetRenderTarget().SetSynchronizedOutput(enabled);
+    return true;
+}
+CATCH_RETURN_FALSE()
+
 bool Terminal::IsVtInputEnabled() const noexcept
 {
     // We should never be getting this call in Terminal.
@@ -622,6 +629,21 @@ bool Terminal::EndHyperlink() noexcept
     return true;
 }
 
+// Method Description:
+// - Marks the position of the cursor, see TextBuffer::AddMark
+// Arguments:
+// - kind - what's marked
+// - exitCode - the exit code of the command, if it finished
+// Return Value:
+// - true
+bool Terminal::AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept
+try
+{
+    _buffer->AddMark(_buffer->GetCursor().GetPosition(), kind, exitCode);
+    return true;
+}
+CATCH_LOG_RETURN_FALSE()
+
 // Method Description:
 // - Updates the taskbar progress indicator
 // Arguments:
@@ -452,6 +452,18 @@ bool TerminalDispatch::EnableXtermBracketedPasteMode(const bool enabled) noexcep
     return true;
 }
 
+//Routine Description:
+// Synchronized Output - While enabled, the renderer holds back its frames,
+//      so that the partial frames the application writes aren't shown.
+//Arguments:
+// - enabled - true when the application begins a frame, false when it ends it.
+// Return value:
+// True if handled successfully. False otherwise.
+bool TerminalDispatch::SetSynchronizedOutput(const bool enabled) noexcept
+{
+    return _terminalApi.SetSynchronizedOutput(enabled);
+}
+
 bool TerminalDispatch::SetMode(const DispatchTypes::ModeParams param) noexcept
 {
     return _ModeParamsHelper(param, true);
@@ -483,6 +495,19 @@ bool TerminalDispatch::EndHyperlink() noexcept
     return _terminalApi.EndHyperlink();
 }
 
+// Method Description:
+// - Marks where a prompt, a command or its output starts, or where the
+//   command finished, as told by the shell with a FinalTerm OSC 133.
+// Arguments:
+// - kind - what's marked
+// - exitCode - the exit code of the command, if it finished
+// Return Value:
+// - true
+bool TerminalDispatch::AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept
+{
+    return _terminalApi.AddMark(kind, exitCode);
+}
+
 // Method Description:
 // - Performs a ConEmu action
 // - Currently, the only action we support is setting the taskbar state/progress
@@ -610,6 +635,9 @@ bool TerminalDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param,
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = SetSynchronizedOutput(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -72,6 +72,7 @@ public:
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override; // ?1003
     bool EnableAlternateScroll(const bool enabled) noexcept override; // ?1007
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+    bool SetSynchronizedOutput(const bool enabled) noexcept override; // ?2026
 
     bool SetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECSET
     bool ResetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECRST
@@ -81,6 +82,8 @@ public:
 
     bool DoConEmuAction(const std::wstring_view string) noexcept override;
 
+    bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept override;
+
 private:
     ::Microsoft::Terminal::Core::ITerminalApi& _terminalApi;
 
@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "TerminalLock.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+thread_local std::array<TerminalLock::Acquisition, TerminalLock::MaxSharedHolds> TerminalLock::_sharedAcquisitions{};
+
+// Method Description:
+// - Acquires the lock exclusively. While profiling, the time spent waiting
+//   for it is measured and the hold is recorded once it's released.
+// Arguments:
+// - tag: what the lock is taken for, for the history. Must be a literal.
+// - caller: the return address of whoever takes the lock
+// Return Value:
+// - <none>
+void TerminalLock::lock(const char* tag, const void* caller)
+{
+    if (!_profiling.load(std::memory_order_relaxed))
+    {
+        _mutex.lock();
+        _exclusive.lock = nullptr;
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    _mutex.lock();
+    const auto acquired = std::chrono::steady_clock::now();
+    _exclusive = { this, tag, caller, acquired - start, acquired };
+}
+
+bool TerminalLock::try_lock() noexcept
+{
+    if (!_mutex.try_lock())
+    {
+        return false;
+    }
+
+    _exclusive = {};
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        _exclusive.lock = this;
+        _exclusive.acquired = std::chrono::steady_clock::now();
+    }
+    return true;
+}
+
+void TerminalLock::unlock() noexcept
+{
+    const auto acquisition = _exclusive;
+    const auto released = acquisition.lock ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    _exclusive.lock = nullptr;
+    _mutex.unlock();
+
+    if (acquisition.lock)
+    {
+        _Record(acquisition, released, true);
+    }
+}
+
+// Method Description:
+// - Acquires the lock shared, see lock.
+// Arguments:
+// - tag: what the lock is taken for, for the history. Must be a literal.
+// - caller: the return address of whoever takes the lock
+// Return Value:
+// - <none>
+void TerminalLock::lock_shared(const char* tag, const void* caller)
+{
+    if (!_profiling.load(std::memory_order_relaxed))
+    {
+        _mutex.lock_shared();
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    _mutex.lock_shared();
+    const auto acquired = std::chrono::steady_clock::now();
+    _BeginShared({ this, tag, caller, acquired - start, acquired });
+}
+
+bool TerminalLock::try_lock_shared() noexcept
+{
+    if (!_mutex.try_lock_shared())
+    {
+        return false;
+    }
+
+    if (_profiling.load(std::memory_order_relaxed))
+    {
+        _BeginShared({ this, nullptr, nullptr, {}, std::chrono::steady_clock::now() });
+    }
+    return true;
+}
+
+void TerminalLock::unlock_shared() noexcept
+{
+    Acquisition acquisition;
+    for (auto& slot : _sharedAcquisitions)
+    {
+        if (slot.lock == this)
+        {
+            acquisition = std::exchange(slot, {});
+            break;
+        }
+    }
+
+    const auto released = acquisition.lock ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    _mutex.unlock_shared();
+
+    if (acquisition.lock)
+    {
+        _Record(acquisition, released, false);
+    }
+}
+
+// Method Description:
+// - Starts recording every hold of the lock into the history.
+// Arguments:
+// - threshold: the holds and waits that take at least this long are
+//   handed to the callback
+// - callback: called with the long holds, may be empty
+// Return Value:
+// - <none>
+void TerminalLock::EnableProfiling(const std::chrono::nanoseconds threshold, LongHoldCallback callback)
+{
+    {
+        std::lock_guard guard{ _historyLock };
+        _threshold = threshold;
+        _callback = std::move(callback);
+    }
+    _profiling.store(true, std::memory_order_relaxed);
+}
+
+void TerminalLock::DisableProfiling() noexcept
+{
+    _profiling.store(false, std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Returns the last HistorySize holds, the oldest first.
+// Arguments:
+// - <none>
+// Return Value:
+// - the holds
+std::vector<TerminalLock::Hold> TerminalLock::GetHistory() const
+{
+    std::lock_guard guard{ _historyLock };
+
+    const auto count = std::min(_historyCount, HistorySize);
+    std::vector<Hold> history;
+    history.reserve(count);
+    for (auto i = _historyCount - count; i < _historyCount; ++i)
+    {
+        history.emplace_back(til::at(_history, i % HistorySize));
+    }
+    return history;
+}
+
+void TerminalLock::_BeginShared(const Acquisition& acquisition) noexcept
+{
+    for (auto& slot : _sharedAcquisitions)
+    {
+        if (!slot.lock)
+        {
+            slot = acquisition;
+            return;
+        }
+    }
+}
+
+void TerminalLock::_Record(const Acquisition& acquisition, const std::chrono::steady_clock::time_point released, const bool exclusive) noexcept
+try
+{
+    const Hold hold{
+        acquisition.tag,
+        acquisition.caller,
+        GetCurrentThreadId(),
+        exclusive,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(acquisition.wait),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(released - acquisition.acquired),
+    };
+
+    std::lock_guard guard{ _historyLock };
+    til::at(_history, _historyCount % HistorySize) = hold;
+    ++_historyCount;
+
+    if (_callback && (hold.hold >= _threshold || hold.wait >= _threshold))
+    {
+        _callback(hold);
+    }
+}
+CATCH_LOG()
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <intrin.h>
+
+namespace Microsoft::Terminal::Core
+{
+    class TerminalLock;
+}
+
+// The read-write lock of the Terminal. It's a std::shared_mutex that can
+// record who held it, for how long and how long they waited for it, into a
+// ring buffer. That's meant for diagnosing frozen panes, where the lock is
+// usually held by one thread while the others pile up behind it.
+//
+// Profiling is off until EnableProfiling is called, which leaves a single
+// relaxed load on every acquisition.
+class Microsoft::Terminal::Core::TerminalLock final
+{
+public:
+    struct Hold
+    {
+        // What the lock was taken for, if the caller said so, and the
+        // return address of whoever took it, which a debugger can resolve.
+        const char* tag;
+        const void* caller;
+        DWORD threadId;
+        bool exclusive;
+        std::chrono::nanoseconds wait;
+        std::chrono::nanoseconds hold;
+    };
+
+    // Called for every hold or wait that takes at least the threshold,
+    // right after the lock was released. It's called under the lock of the
+    // history, so it mustn't take long or call back into the TerminalLock.
+    using LongHoldCallback = std::function<void(const Hold&)>;
+
+    static constexpr size_t HistorySize = 256;
+
+    TerminalLock() = default;
+    TerminalLock(const TerminalLock&) = delete;
+    TerminalLock& operator=(const TerminalLock&) = delete;
+
+    // These satisfy the SharedMutex requirements, so std::unique_lock and
+    // std::shared_lock work with them. The tag and caller are optional.
+    void lock(const char* tag = nullptr, const void* caller = nullptr);
+    bool try_lock() noexcept;
+    void unlock() noexcept;
+    void lock_shared(const char* tag = nullptr, const void* caller = nullptr);
+    bool try_lock_shared() noexcept;
+    void unlock_shared() noexcept;
+
+    void EnableProfiling(const std::chrono::nanoseconds threshold, LongHoldCallback callback);
+    void DisableProfiling() noexcept;
+    std::vector<Hold> GetHistory() const;
+
+private:
+    // When a hold started and what's known about it until it ends.
+    struct Acquisition
+    {
+        const TerminalLock* lock = nullptr;
+        const char* tag = nullptr;
+        const void* caller = nullptr;
+        std::chrono::steady_clock::duration wait{};
+        std::chrono::steady_clock::time_point acquired{};
+    };
+
+    void _BeginShared(const Acquisition& acquisition) noexcept;
+    void _Record(const Acquisition& acquisition, const std::chrono::steady_clock::time_point released, const bool exclusive) noexcept;
+
+    // The shared holds of this thread. A thread rarely holds the lock of
+    // more than one terminal, so the holds beyond these aren't profiled.
+    static constexpr size_t MaxSharedHolds = 4;
+    static thread_local std::array<Acquisition, MaxSharedHolds> _sharedAcquisitions;
+
+    std::shared_mutex _mutex;
+    std::atomic<bool> _profiling{ false };
+
+    // There's only ever one exclusive holder, which owns this member.
+    Acquisition _exclusive;
+
+    mutable std::mutex _historyLock;
+    std::array<Hold, HistorySize> _history{};
+    size_t _historyCount = 0;
+    std::chrono::nanoseconds _threshold{ 0 };
+    LongHoldCallback _callback;
+};
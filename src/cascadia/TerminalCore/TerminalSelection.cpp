@@ -235,6 +235,44 @@ void Terminal::SetBlockSelection(const bool isEnabled) noexcept
     _blockSelection = isEnabled;
 }
 
+// Method Description:
+// - Selects the output of the command at the given position, as marked by
+//   the shell. On a prompt, that's the output of the command above it. The
+//   output of a command that's still running ends at the cursor.
+// Arguments:
+// - viewportPos: the (x,y) coordinate on the visible viewport
+// Return Value:
+// - false if no command is marked there, or its output is empty.
+bool Terminal::SelectCommandOutput(const COORD viewportPos)
+{
+    const auto bufferPos = _ConvertToBufferCell(viewportPos);
+    const auto output = _buffer->GetMarks().GetCommandOutput(bufferPos.Y, _buffer->GetCursor().GetPosition());
+    if (!output)
+    {
+        return false;
+    }
+
+    // The output ends right in front of its end.
+    const auto [start, end] = *output;
+    if (end.Y < start.Y || (end.Y == start.Y && end.X <= start.X))
+    {
+        return false;
+    }
+    auto last = end;
+    if (last.X > 0)
+    {
+        --last.X;
+    }
+    else
+    {
+        --last.Y;
+        last.X = gsl::narrow_cast<SHORT>(_buffer->GetLineWidth(gsl::narrow_cast<size_t>(last.Y)) - 1);
+    }
+
+    SelectNewRegion(start, last);
+    return true;
+}
+
 // Method Description:
 // - clear selection data and disable rendering it
 #pragma warning(disable : 26440) // changing this to noexcept would require a change to ConHost's selection model
@@ -267,6 +305,26 @@ const TextBuffer::TextAndColor Terminal::RetrieveSelectedTextFromBuffer(bool sin
     return _buffer->GetText(includeCRLF, trimTrailingWhitespace, selectionRects, GetAttributeColors, formatWrappedRows);
 }
 
+// Method Description:
+// - get just the text from highlighted portion of text buffer, without resolving
+//   any colors. Much cheaper than RetrieveSelectedTextFromBuffer for large selections.
+// Arguments:
+// - singleLine: collapse all of the text to one line
+// Return Value:
+// - wstring text from buffer. If extended to multiple lines, each line is separated by \r\n
+std::wstring Terminal::RetrieveSelectedPlainTextFromBuffer(bool singleLine)
+{
+    auto lock = LockForReading();
+
+    const auto selectionRects = _GetSelectionRects();
+
+    // See RetrieveSelectedTextFromBuffer for how these are chosen.
+    const auto includeCRLF = !singleLine || _blockSelection;
+    const auto trimTrailingWhitespace = !singleLine && (!_blockSelection || _trimBlockSelection);
+    const auto formatWrappedRows = _blockSelection;
+    return _buffer->GetPlainText(includeCRLF, trimTrailingWhitespace, selectionRects, formatWrappedRows);
+}
+
 // Method Description:
 // - convert viewport position to the corresponding location on the buffer
 // Arguments:
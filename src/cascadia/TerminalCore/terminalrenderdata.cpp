@@ -137,25 +137,49 @@ const std::wstring Microsoft::Terminal::Core::Terminal::GetHyperlinkCustomId(uin
 // - Gets the regex pattern ids of a location
 // Arguments:
 // - The location
+// - ids - receives the pattern IDs of the location
 // Return value:
-// - The pattern IDs of the location
-const std::vector<size_t> Terminal::GetPatternId(const COORD location) const noexcept
+// - <none>
+void Terminal::GetPatternId(const COORD location, std::vector<size_t>& ids) const noexcept
 {
+    ids.clear();
+
     // Look through our interval tree for this location
-    const auto intervals = _patternIntervalTree.findOverlapping(COORD{ location.X + 1, location.Y }, location);
-    if (intervals.size() == 0)
-    {
-        return {};
-    }
-    else
-    {
-        std::vector<size_t> result{};
-        for (const auto& interval : intervals)
+    _patternIntervalTree.visit_overlapping(COORD{ location.X + 1, location.Y }, location, [&](const auto& interval) {
+        ids.emplace_back(interval.value);
+    });
+}
+
+// Method Description:
+// - Returns the rectangles of the search matches within the viewport. Only
+//   the matches that intersect it are looked up, so scrolling through a long
+//   history with many matches doesn't cost more than the viewport has.
+std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSearchHighlightRects() noexcept
+try
+{
+    std::vector<Viewport> result;
+
+    const auto origin = gsl::narrow_cast<ptrdiff_t>(_buffer->GetMarks().GetOrigin());
+    const til::point bufferStart{ ptrdiff_t{ 0 }, origin };
+    const til::point viewStart{ ptrdiff_t{ 0 }, origin + _VisibleStartIndex() };
+    const til::point viewEnd{ gsl::narrow_cast<ptrdiff_t>(_buffer->GetSize().RightInclusive()), origin + _VisibleEndIndex() };
+
+    _searchHighlights.visit_overlapping(viewStart, viewEnd, [&](const auto& interval) {
+        // The beginning of a match may have left the top of the buffer already.
+        const auto first = std::max(interval.start, bufferStart);
+        const COORD start{ gsl::narrow<SHORT>(first.x()), gsl::narrow<SHORT>(first.y() - origin) };
+        const COORD end{ gsl::narrow<SHORT>(interval.stop.x()), gsl::narrow<SHORT>(interval.stop.y() - origin) };
+        for (const auto& lineRect : _buffer->GetTextRects(start, end, false, true))
         {
-            result.emplace_back(interval.value);
+            result.emplace_back(Viewport::FromInclusive(lineRect));
         }
-        return result;
-    }
+    });
+
+    return result;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
     return {};
 }
 
@@ -236,9 +260,9 @@ catch (...)
 //      operation.
 //   Callers should make sure to also call Terminal::UnlockConsole once
 //      they're done with any querying they need to do.
-void Terminal::LockConsole() noexcept
+__declspec(noinline) void Terminal::LockConsole() noexcept
 {
-    _readWriteLock.lock_shared();
+    _readWriteLock.lock_shared("LockConsole", _ReturnAddress());
 }
 
 // Method Description:
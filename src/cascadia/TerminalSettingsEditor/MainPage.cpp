@@ -99,7 +99,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                     {
                         if (const auto& tag{ navViewItem.Tag() })
                         {
-                            if (tag.try_as<Editor::ProfileViewModel>())
+                            if (_ProfileGuidForTag(tag))
                             {
                                 // remove NavViewItem pointing to a Profile
                                 return true;
@@ -149,17 +149,14 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                                 }
                             }
                         }
-                        else if (const auto& profileTag{ tag.try_as<ProfileViewModel>() })
+                        else if (const auto profileGuid{ _ProfileGuidForTag(tag) })
                         {
-                            if (const auto& selectedItemProfileTag{ selectedItemTag.try_as<ProfileViewModel>() })
+                            if (profileGuid == _ProfileGuidForTag(selectedItemTag))
                             {
-                                if (profileTag->OriginalProfileGuid() == selectedItemProfileTag->OriginalProfileGuid())
-                                {
-                                    // found the one that was selected before the refresh
-                                    SettingsNav().SelectedItem(item);
-                                    _Navigate(*profileTag);
-                                    return;
-                                }
+                                // found the one that was selected before the refresh
+                                SettingsNav().SelectedItem(item);
+                                _Navigate(_ViewModelForNavItem(menuItem));
+                                return;
                             }
                         }
                     }
@@ -269,10 +266,13 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
             {
                 _Navigate(*navString);
             }
-            else if (const auto profile = clickedItemContainer.Tag().try_as<Editor::ProfileViewModel>())
+            else if (const auto navItem = clickedItemContainer.try_as<MUX::Controls::NavigationViewItem>())
             {
-                // Navigate to a page with the given profile
-                _Navigate(profile);
+                if (const auto profile = _ViewModelForNavItem(navItem))
+                {
+                    // Navigate to a page with the given profile
+                    _Navigate(profile);
+                }
             }
         }
     }
@@ -350,9 +350,17 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         }
     }
 
-    void MainPage::SaveButton_Click(IInspectable const& /*sender*/, RoutedEventArgs const& /*args*/)
+    fire_and_forget MainPage::SaveButton_Click(IInspectable const& /*sender*/, RoutedEventArgs const& /*args*/)
     {
-        _settingsClone.WriteSettingsToDisk();
+        // Serializing and writing the settings file can take a while with a
+        // lot of profiles, so that happens on a background thread. The
+        // settings are snapshotted before we leave the UI thread.
+        const auto settings{ _settingsClone };
+        try
+        {
+            co_await settings.WriteSettingsToDiskAsync();
+        }
+        CATCH_LOG();
     }
 
     void MainPage::ResetButton_Click(IInspectable const& /*sender*/, RoutedEventArgs const& /*args*/)
@@ -368,7 +376,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         // profile changes.
         for (const auto& profile : _settingsClone.AllProfiles())
         {
-            auto navItem = _CreateProfileNavViewItem(_viewModelForProfile(profile, _settingsClone));
+            auto navItem = _CreateProfileNavViewItem(profile);
             SettingsNav().MenuItems().Append(navItem);
         }
 
@@ -388,29 +396,66 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     void MainPage::_CreateAndNavigateToNewProfile(const uint32_t index, const Model::Profile& profile)
     {
         const auto newProfile{ profile ? profile : _settingsClone.CreateNewProfile() };
-        const auto profileViewModel{ _viewModelForProfile(newProfile, _settingsClone) };
-        const auto navItem{ _CreateProfileNavViewItem(profileViewModel) };
+        const auto navItem{ _CreateProfileNavViewItem(newProfile) };
         SettingsNav().MenuItems().InsertAt(index, navItem);
 
         // Select and navigate to the new profile
         SettingsNav().SelectedItem(navItem);
-        _Navigate(profileViewModel);
+        _Navigate(_ViewModelForNavItem(navItem));
     }
 
-    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Editor::ProfileViewModel& profile)
+    // Method Description:
+    // - Creates the menu item for the given profile. The item's Tag is the
+    //   profile itself until the item is navigated to for the first time, see
+    //   _ViewModelForNavItem.
+    // Arguments:
+    // - profile - the profile to create a menu item for
+    // Return Value:
+    // - the new menu item
+    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Model::Profile& profile)
     {
         MUX::Controls::NavigationViewItem profileNavItem;
         profileNavItem.Content(box_value(profile.Name()));
-        profileNavItem.Tag(box_value<Editor::ProfileViewModel>(profile));
+        profileNavItem.Tag(profile);
 
         const auto iconSource{ IconPathConverter::IconSourceWUX(profile.Icon()) };
         WUX::Controls::IconSourceElement icon;
         icon.IconSource(iconSource);
         profileNavItem.Icon(icon);
 
+        return profileNavItem;
+    }
+
+    // Method Description:
+    // - Returns the view model for the profile that the given menu item
+    //   points to. View models are only created once their profile is
+    //   navigated to. Building one for every profile up front made opening
+    //   the settings UI slow with a lot of generated profiles.
+    // Arguments:
+    // - navItem - a menu item created by _CreateProfileNavViewItem
+    // Return Value:
+    // - the view model of the item's profile, or nullptr if the item doesn't
+    //   point to a profile
+    Editor::ProfileViewModel MainPage::_ViewModelForNavItem(const MUX::Controls::NavigationViewItem& navItem)
+    {
+        const auto tag{ navItem.Tag() };
+        if (const auto viewModel{ tag.try_as<Editor::ProfileViewModel>() })
+        {
+            return viewModel;
+        }
+
+        const auto profile{ tag.try_as<Model::Profile>() };
+        if (!profile)
+        {
+            return nullptr;
+        }
+
+        const auto viewModel{ _viewModelForProfile(profile, _settingsClone) };
+        navItem.Tag(box_value<Editor::ProfileViewModel>(viewModel));
+
         // Update the menu item when the icon/name changes
-        auto weakMenuItem{ make_weak(profileNavItem) };
-        profile.PropertyChanged([weakMenuItem](const auto&, const WUX::Data::PropertyChangedEventArgs& args) {
+        auto weakMenuItem{ make_weak(navItem) };
+        viewModel.PropertyChanged([weakMenuItem](const auto&, const WUX::Data::PropertyChangedEventArgs& args) {
             if (auto menuItem{ weakMenuItem.get() })
             {
                 const auto& tag{ menuItem.Tag().as<Editor::ProfileViewModel>() };
@@ -427,7 +472,27 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                 }
             }
         });
-        return profileNavItem;
+        return viewModel;
+    }
+
+    // Method Description:
+    // - Returns the original guid of the profile that a menu item's Tag
+    //   points to, whether or not its view model was created yet.
+    // Arguments:
+    // - tag - the Tag of a menu item
+    // Return Value:
+    // - the guid of the profile, or nullopt if the tag isn't a profile
+    std::optional<winrt::guid> MainPage::_ProfileGuidForTag(const IInspectable& tag)
+    {
+        if (const auto viewModel{ tag.try_as<ProfileViewModel>() })
+        {
+            return viewModel->OriginalProfileGuid();
+        }
+        if (const auto profile{ tag.try_as<Model::Profile>() })
+        {
+            return profile.Guid();
+        }
+        return std::nullopt;
     }
 
     void MainPage::_DeleteProfile(const IInspectable /*sender*/, const Editor::DeleteProfileEventArgs& args)
@@ -454,6 +519,6 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         // navigate to the profile next to this one
         const auto newSelectedItem{ menuItems.GetAt(index < menuItems.Size() - 1 ? index : index - 1) };
         SettingsNav().SelectedItem(newSelectedItem);
-        _Navigate(newSelectedItem.try_as<MUX::Controls::NavigationViewItem>().Tag().try_as<Editor::ProfileViewModel>());
+        _Navigate(_ViewModelForNavItem(newSelectedItem.try_as<MUX::Controls::NavigationViewItem>()));
     }
 }
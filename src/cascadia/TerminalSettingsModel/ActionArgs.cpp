@@ -31,6 +31,7 @@
 #include "RenameWindowArgs.g.cpp"
 #include "GlobalSummonArgs.g.cpp"
 #include "FocusPaneArgs.g.cpp"
+#include "FindInPanesArgs.g.cpp"
 
 #include <LibraryResources.h>
 
@@ -608,4 +609,15 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                         Id())
         };
     }
+
+    winrt::hstring FindInPanesArgs::GenerateName() const
+    {
+        // The string will be similar to the following:
+        // * "Find "...query..." in all panes of the tab"
+        // * "Find "...query..." in all panes of the window"
+
+        const auto escapedQuery = til::visualize_control_codes(Query());
+        const auto format = Scope() == FindScope::Window ? RS_(L"FindInWindowPanesCommandKey") : RS_(L"FindInTabPanesCommandKey");
+        return winrt::hstring{ fmt::format(std::wstring_view(format), escapedQuery) };
+    }
 }
@@ -33,6 +33,7 @@
 #include "RenameWindowArgs.g.h"
 #include "GlobalSummonArgs.g.h"
 #include "FocusPaneArgs.g.h"
+#include "FindInPanesArgs.g.h"
 
 #include "../../cascadia/inc/cppwinrt_utils.h"
 #include "JsonUtils.h"
@@ -1577,6 +1578,73 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         }
     };
 
+    struct FindInPanesArgs : public FindInPanesArgsT<FindInPanesArgs>
+    {
+        FindInPanesArgs() = default;
+        FindInPanesArgs(const winrt::hstring& query) :
+            _Query{ query } {};
+        ACTION_ARG(winrt::hstring, Query, L"");
+        ACTION_ARG(bool, CaseSensitive, false);
+        ACTION_ARG(FindScope, Scope, FindScope::Tab);
+
+        static constexpr std::string_view QueryKey{ "query" };
+        static constexpr std::string_view CaseSensitiveKey{ "caseSensitive" };
+        static constexpr std::string_view ScopeKey{ "scope" };
+
+    public:
+        hstring GenerateName() const;
+
+        bool Equals(const IActionArgs& other)
+        {
+            auto otherAsUs = other.try_as<FindInPanesArgs>();
+            if (otherAsUs)
+            {
+                return otherAsUs->_Query == _Query &&
+                       otherAsUs->_CaseSensitive == _CaseSensitive &&
+                       otherAsUs->_Scope == _Scope;
+            }
+            return false;
+        };
+        static FromJsonResult FromJson(const Json::Value& json)
+        {
+            // LOAD BEARING: Not using make_self here _will_ break you in the future!
+            auto args = winrt::make_self<FindInPanesArgs>();
+            JsonUtils::GetValueForKey(json, QueryKey, args->_Query);
+            JsonUtils::GetValueForKey(json, CaseSensitiveKey, args->_CaseSensitive);
+            JsonUtils::GetValueForKey(json, ScopeKey, args->_Scope);
+            if (args->Query().empty())
+            {
+                return { nullptr, { SettingsLoadWarnings::MissingRequiredParameter } };
+            }
+            return { *args, {} };
+        }
+        static Json::Value ToJson(const IActionArgs& val)
+        {
+            if (!val)
+            {
+                return {};
+            }
+            Json::Value json{ Json::ValueType::objectValue };
+            const auto args{ get_self<FindInPanesArgs>(val) };
+            JsonUtils::SetValueForKey(json, QueryKey, args->_Query);
+            JsonUtils::SetValueForKey(json, CaseSensitiveKey, args->_CaseSensitive);
+            JsonUtils::SetValueForKey(json, ScopeKey, args->_Scope);
+            return json;
+        }
+        IActionArgs Copy() const
+        {
+            auto copy{ winrt::make_self<FindInPanesArgs>() };
+            copy->_Query = _Query;
+            copy->_CaseSensitive = _CaseSensitive;
+            copy->_Scope = _Scope;
+            return *copy;
+        }
+        size_t Hash() const
+        {
+            return ::Microsoft::Terminal::Settings::Model::HashUtils::HashProperty(Query(), CaseSensitive(), Scope());
+        }
+    };
+
 }
 
 namespace winrt::Microsoft::Terminal::Settings::Model::factory_implementation
@@ -1596,4 +1664,5 @@ namespace winrt::Microsoft::Terminal::Settings::Model::factory_implementation
     BASIC_FACTORY(FindMatchArgs);
     BASIC_FACTORY(NewWindowArgs);
     BASIC_FACTORY(FocusPaneArgs);
+    BASIC_FACTORY(FindInPanesArgs);
 }
@@ -336,6 +336,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _NameMapCache = nullptr;
         _GlobalHotkeysCache = nullptr;
         _KeyBindingMapCache = nullptr;
+        _KeyChordDispatchTable.clear();
+        _KeyChordDispatchTableValid = false;
 
         // Handle nested commands
         const auto cmdImpl{ get_self<Command>(cmd) };
@@ -533,8 +535,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             const auto conflictingCmdImpl{ get_self<implementation::Command>(conflictingCmd) };
             conflictingCmdImpl->EraseKey(keys);
         }
-        else if (const auto& conflictingCmd{ GetActionByKeyChord(keys) })
+        else if (const auto& conflictingCmd{ _GetActionByKeyChordInternal(keys).value_or(nullptr) })
         {
+            // (This walks the layers instead of using the dispatch table,
+            // since the table is dropped by every AddAction while loading.)
+
             // Collision with ancestor: The key chord was already in use, but by an action in another layer
             //
             // Example:
@@ -600,17 +605,57 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullptr if the key chord is explicitly unbound
     Model::Command ActionMap::GetActionByKeyChord(Control::KeyChord const& keys) const
     {
-        // Check the current layer
-        const auto cmd{ _GetActionByKeyChordInternal(keys) };
-        if (cmd.has_value())
+        if (!_KeyChordDispatchTableValid)
+        {
+            _BuildKeyChordDispatchTable();
+        }
+
+        const auto cmd{ _KeyChordDispatchTable.find(_PackKeyChord(keys.Modifiers(), keys.Vkey())) };
+        if (cmd != _KeyChordDispatchTable.end())
         {
-            return *cmd;
+            return cmd->second;
         }
 
-        // This key chord is not explicitly bound
+        // This key chord is either not bound or explicitly unbound
         return nullptr;
     }
 
+    // Method Description:
+    // - Packs the parts of a key chord that identify it into a single integer.
+    // Arguments:
+    // - modifiers: the modifiers of the key chord
+    // - vkey: the virtual key of the key chord
+    // Return Value:
+    // - the key of the key chord in _KeyChordDispatchTable
+    uint64_t ActionMap::_PackKeyChord(const Control::KeyModifiers modifiers, const int32_t vkey) noexcept
+    {
+        return (static_cast<uint64_t>(modifiers) << 32) | static_cast<uint32_t>(vkey);
+    }
+
+    // Method Description:
+    // - Flattens the key bindings of this layer and its parents into
+    //   _KeyChordDispatchTable. The layers are resolved the same way as
+    //   in KeyBindings(), so the table answers the same as
+    //   _GetActionByKeyChordInternal would.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ActionMap::_BuildKeyChordDispatchTable() const
+    {
+        std::unordered_map<KeyChord, Model::Command, KeyChordHash, KeyChordEquality> keyBindingsMap;
+        std::unordered_set<KeyChord, KeyChordHash, KeyChordEquality> unboundKeys;
+        _PopulateKeyBindingMapWithStandardCommands(keyBindingsMap, unboundKeys);
+
+        _KeyChordDispatchTable.clear();
+        _KeyChordDispatchTable.reserve(keyBindingsMap.size());
+        for (const auto& [keys, cmd] : keyBindingsMap)
+        {
+            _KeyChordDispatchTable.emplace(_PackKeyChord(keys.Modifiers(), keys.Vkey()), cmd);
+        }
+        _KeyChordDispatchTableValid = true;
+    }
+
     // Method Description:
     // - Retrieves the assigned command with the given key chord.
     // - Can return nullopt to differentiate explicit unbinding vs lack of binding.
@@ -80,6 +80,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     private:
         std::optional<Model::Command> _GetActionByID(const InternalActionID actionID) const;
         std::optional<Model::Command> _GetActionByKeyChordInternal(Control::KeyChord const& keys) const;
+        static uint64_t _PackKeyChord(const Control::KeyModifiers modifiers, const int32_t vkey) noexcept;
+        void _BuildKeyChordDispatchTable() const;
 
         void _PopulateNameMapWithSpecialCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
         void _PopulateNameMapWithStandardCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
@@ -96,6 +98,15 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Windows::Foundation::Collections::IMap<hstring, Model::Command> _NestedCommands{ nullptr };
         Windows::Foundation::Collections::IVector<Model::Command> _IterableCommands{ nullptr };
         std::unordered_map<Control::KeyChord, InternalActionID, KeyChordHash, KeyChordEquality> _KeyMap;
+
+        // The key bindings of this layer and all of its parents, flattened
+        // into a single table from the packed modifiers and vkey of a key
+        // chord to the bound command (unbound keys aren't in it).
+        // GetActionByKeyChord is called for every key press, and this way
+        // it neither walks the layers nor hashes WinRT objects.
+        // It's built on first use and dropped whenever an action is added.
+        mutable std::unordered_map<uint64_t, Model::Command> _KeyChordDispatchTable;
+        mutable bool _KeyChordDispatchTableValid{ false };
         std::unordered_map<InternalActionID, Model::Command> _ActionMap;
 
         // Masking Actions:
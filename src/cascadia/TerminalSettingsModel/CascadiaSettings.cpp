@@ -90,6 +90,10 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 
     _CopyProfileInheritanceTree(settings);
 
+    // A copy is what the settings UI edits, so its profiles keep changing
+    // underneath any TerminalSettings we'd resolve from them.
+    settings->_cacheResolvedProfileSettings = false;
+
     return *settings;
 }
 
@@ -227,6 +231,8 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::ProfileDe
 // - a reference to the new profile
 winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::CreateNewProfile()
 {
+    _ClearResolvedProfileSettings();
+
     if (_allProfiles.Size() == std::numeric_limits<uint32_t>::max())
     {
         // Shouldn't really happen
@@ -265,6 +271,7 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::CreateNew
 winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::DuplicateProfile(Model::Profile source)
 {
     THROW_HR_IF_NULL(E_INVALIDARG, source);
+    _ClearResolvedProfileSettings();
 
     winrt::com_ptr<Profile> duplicated;
     if (_userDefaultProfileSettings)
@@ -328,6 +335,9 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::Duplicate
     DUPLICATE_SETTING_MACRO(AntialiasingMode);
     DUPLICATE_SETTING_MACRO(ForceFullRepaintRendering);
     DUPLICATE_SETTING_MACRO(SoftwareRendering);
+    DUPLICATE_SETTING_MACRO(UseAtlasEngine);
+    DUPLICATE_SETTING_MACRO(LowLatencyInput);
+    DUPLICATE_SETTING_MACRO(BoostRenderPriority);
     DUPLICATE_SETTING_MACRO(HistorySize);
     DUPLICATE_SETTING_MACRO(SnapOnInput);
     DUPLICATE_SETTING_MACRO(AltGrAliasing);
@@ -1052,6 +1062,8 @@ winrt::Microsoft::Terminal::Settings::Model::ColorScheme CascadiaSettings::GetCo
 // - <none>
 void CascadiaSettings::UpdateColorSchemeReferences(const hstring oldName, const hstring newName)
 {
+    _ClearResolvedProfileSettings();
+
     // update profiles.defaults, if necessary
     if (_userDefaultProfileSettings &&
         _userDefaultProfileSettings->DefaultAppearance().HasColorSchemeName() &&
@@ -1220,3 +1232,16 @@ void CascadiaSettings::CurrentDefaultTerminal(Settings::Model::DefaultTerminal t
 {
     _currentDefaultTerminal = terminal;
 }
+
+// Method Description:
+// - Drops the TerminalSettings resolved from our profiles, so that the next
+//   pane created from these settings picks up any changes made to them.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CascadiaSettings::_ClearResolvedProfileSettings() noexcept
+{
+    std::scoped_lock lock{ _resolvedProfileSettingsLock };
+    _resolvedProfileSettings.clear();
+}
@@ -26,6 +26,8 @@ Author(s):
 #include "Profile.h"
 #include "ColorScheme.h"
 
+#include <future>
+
 // fwdecl unittest classes
 namespace SettingsModelLocalTests
 {
@@ -76,6 +78,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void LayerJson(const Json::Value& json);
 
         void WriteSettingsToDisk() const;
+        Windows::Foundation::IAsyncAction WriteSettingsToDiskAsync() const;
         Json::Value ToJson() const;
 
         static hstring SettingsPath();
@@ -119,6 +122,31 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         std::vector<std::unique_ptr<::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator>> _profileGenerators;
 
+        // winrt::guid doesn't have a std::hash specialization
+        struct GuidHash
+        {
+            size_t operator()(const winrt::guid& guid) const noexcept
+            {
+                static_assert(sizeof(guid) == 2 * sizeof(uint64_t));
+                std::array<uint64_t, 2> halves;
+                memcpy(halves.data(), &guid, sizeof(guid));
+                return std::hash<uint64_t>{}(til::at(halves, 0) ^ til::at(halves, 1));
+            }
+        };
+
+        // Maps the GUID of every profile to its indices in _allProfiles, in
+        // ascending order. It only exists while json is layered onto the
+        // profiles, see _BuildProfileIndex.
+        std::optional<std::unordered_map<winrt::guid, std::vector<uint32_t>, GuidHash>> _profileIndex;
+
+        // The TerminalSettings resolved from each profile and the globals,
+        // built the first time a pane of that profile is created. Every pane
+        // of the profile inherits from the same object. A settings reload
+        // creates a new CascadiaSettings, which starts out with an empty map.
+        mutable std::unordered_map<winrt::guid, Model::TerminalSettings, GuidHash> _resolvedProfileSettings;
+        mutable std::mutex _resolvedProfileSettingsLock;
+        bool _cacheResolvedProfileSettings{ true };
+
         std::string _userSettingsString;
         Json::Value _userSettings;
         Json::Value _defaultSettings;
@@ -127,8 +155,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _LayerOrCreateProfile(const Json::Value& profileJson);
         winrt::com_ptr<implementation::Profile> _FindMatchingProfile(const Json::Value& profileJson);
         std::optional<uint32_t> _FindMatchingProfileIndex(const Json::Value& profileJson);
+        void _BuildProfileIndex();
+        void _UpdateProfileIndex(const uint32_t index, const std::optional<winrt::guid> previousGuid);
         void _LayerOrCreateColorScheme(const Json::Value& schemeJson);
-        Json::Value _ParseUtf8JsonString(std::string_view fileData);
+        static Json::Value _ParseUtf8JsonString(std::string_view fileData);
+        static winrt::com_ptr<CascadiaSettings> _LayerDefaults();
 
         winrt::com_ptr<implementation::ColorScheme> _FindMatchingColorScheme(const Json::Value& schemeJson);
         void _ParseJsonString(std::string_view fileData, const bool isDefaultSettings);
@@ -140,15 +171,27 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _CopyProfileInheritanceTree(com_ptr<CascadiaSettings>& cloneSettings) const;
 
         void _ApplyDefaultsFromUserSettings();
+        void _ClearResolvedProfileSettings() noexcept;
+
+        // The parsed json files of a fragment extension
+        struct FragmentSource
+        {
+            winrt::hstring source;
+            std::vector<Json::Value> files;
+        };
 
+        static std::unordered_set<std::wstring> _GetIgnoredNamespaces(const Json::Value& userSettings);
         void _LoadDynamicProfiles();
-        void _LoadFragmentExtensions();
-        void _ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces);
-        std::unordered_set<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
-        void _ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source);
+        static std::vector<FragmentSource> _CollectFragmentExtensions(const std::unordered_set<std::wstring>& ignoredNamespaces);
+        static void _CollectJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces, std::vector<std::future<FragmentSource>>& sources);
+        static FragmentSource _ParseFragmentFiles(const std::wstring directory, const winrt::hstring source);
+        static std::vector<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
+        void _LayerFragmentExtensions(std::vector<FragmentSource> fragments);
+        void _LayerFragmentFiles(std::vector<Json::Value>& files, const winrt::hstring& source);
 
         static bool _IsPackaged();
         static void _WriteSettings(std::string_view content, const hstring filepath);
+        static void _WriteSettingsSnapshot(const std::string_view userSettingsString, const Json::Value& json);
         static std::optional<std::string> _ReadUserSettings();
         static std::optional<std::string> _ReadFile(HANDLE hFile);
 
@@ -177,6 +220,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         friend class SettingsModelLocalTests::KeyBindingsTests;
         friend class TerminalAppUnitTests::DynamicProfileTests;
         friend class TerminalAppUnitTests::JsonTests;
+        friend struct TerminalSettings;
     };
 }
 
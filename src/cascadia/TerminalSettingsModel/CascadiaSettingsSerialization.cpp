@@ -169,13 +169,19 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
             resultPtr->_ParseJsonString(fileData.value(), false);
         }
 
+        // Read and parse the fragments in the background while the dynamic
+        // profiles are generated. Like the generators, this checks _userSettings
+        // for any sources that should be disabled.
+        auto fragments = std::async(std::launch::async, &CascadiaSettings::_CollectFragmentExtensions, _GetIgnoredNamespaces(resultPtr->_userSettings));
+
         // Load profiles from dynamic profile generators. _userSettings should be
         // created by now, because we're going to check in there for any generators
         // that should be disabled (if the user had any settings.)
         resultPtr->_LoadDynamicProfiles();
         try
         {
-            resultPtr->_LoadFragmentExtensions();
+            // Fragments can modify the dynamic profiles, so they're only layered now.
+            resultPtr->_LayerFragmentExtensions(fragments.get());
         }
         CATCH_LOG();
 
@@ -307,11 +313,50 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 // Function Description:
 // - Creates a new CascadiaSettings object initialized with settings from the
 //   hardcoded defaults.json.
+// - defaults.json can't change while we're running, so it's only parsed and
+//   layered once. Every call gets its own copy of the result.
 // Arguments:
 // - <none>
 // Return Value:
 // - a unique_ptr to a CascadiaSettings with the settings from defaults.json
 winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::LoadDefaults()
+{
+    static std::mutex mutex;
+    static winrt::com_ptr<CascadiaSettings> defaults;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const std::unique_lock<std::mutex> lock{ mutex };
+
+    const auto cacheHit = static_cast<bool>(defaults);
+    if (!cacheHit)
+    {
+        defaults = _LayerDefaults();
+    }
+
+    auto settings = defaults->Copy();
+    // Copy() shares the list of default terminals, which is refreshed in place.
+    winrt::get_self<CascadiaSettings>(settings)->_defaultTerminals = winrt::single_threaded_observable_vector<Model::DefaultTerminal>();
+
+    const std::chrono::duration<double> delta = std::chrono::high_resolution_clock::now() - start;
+    TraceLoggingWrite(
+        g_hSettingsModelProvider,
+        "DefaultSettingsLoaded",
+        TraceLoggingDescription("Event emitted when the default settings were loaded"),
+        TraceLoggingBool(cacheHit, "CacheHit"),
+        TraceLoggingFloat64(delta.count(), "Duration"),
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+        TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+
+    return settings;
+}
+
+// Function Description:
+// - Parses the hardcoded defaults.json and layers it onto a new CascadiaSettings object.
+// Arguments:
+// - <none>
+// Return Value:
+// - a CascadiaSettings with the settings from defaults.json
+winrt::com_ptr<CascadiaSettings> CascadiaSettings::_LayerDefaults()
 {
     auto resultPtr{ winrt::make_self<CascadiaSettings>() };
 
@@ -330,23 +375,20 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         profileImpl->Origin(OriginTag::InBox);
     }
 
-    return *resultPtr;
+    return resultPtr;
 }
 
 // Method Description:
-// - Runs each of the configured dynamic profile generators (DPGs). Adds
-//   profiles from any DPGs that ran to the end of our list of profiles.
-// - Uses the Json::Value _userSettings to check which DPGs should not be run.
-//   If the user settings has any namespaces in the "disabledProfileSources"
-//   property, we'll ensure that any DPGs with a matching namespace _don't_ run.
+// - Collects the namespaces listed in the "disabledProfileSources" property
+//   of the given user settings.
 // Arguments:
-// - <none>
+// - userSettings: the user's settings json
 // Return Value:
-// - <none>
-void CascadiaSettings::_LoadDynamicProfiles()
+// - The namespaces of the profile sources that shouldn't be loaded
+std::unordered_set<std::wstring> CascadiaSettings::_GetIgnoredNamespaces(const Json::Value& userSettings)
 {
     std::unordered_set<std::wstring> ignoredNamespaces;
-    const auto disabledProfileSources = CascadiaSettings::_GetDisabledProfileSourcesJsonObject(_userSettings);
+    const auto disabledProfileSources = CascadiaSettings::_GetDisabledProfileSourcesJsonObject(userSettings);
     if (disabledProfileSources.isArray())
     {
         for (const auto& json : disabledProfileSources)
@@ -354,11 +396,31 @@ void CascadiaSettings::_LoadDynamicProfiles()
             ignoredNamespaces.emplace(JsonUtils::GetValue<std::wstring>(json));
         }
     }
+    return ignoredNamespaces;
+}
 
-    const GUID nullGuid{ 0 };
+// Method Description:
+// - Runs each of the configured dynamic profile generators (DPGs). Adds
+//   profiles from any DPGs that ran to the end of our list of profiles.
+// - Uses the Json::Value _userSettings to check which DPGs should not be run.
+//   If the user settings has any namespaces in the "disabledProfileSources"
+//   property, we'll ensure that any DPGs with a matching namespace _don't_ run.
+// - The generators run concurrently on the thread pool (enumerating the WSL
+//   distros alone can take a while), but their profiles are always appended
+//   in the order of _profileGenerators.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CascadiaSettings::_LoadDynamicProfiles()
+{
+    const auto ignoredNamespaces = _GetIgnoredNamespaces(_userSettings);
+
+    std::vector<std::pair<std::wstring, std::future<std::vector<winrt::Microsoft::Terminal::Settings::Model::Profile>>>> generated;
+    generated.reserve(_profileGenerators.size());
     for (auto& generator : _profileGenerators)
     {
-        const std::wstring generatorNamespace{ generator->GetNamespace() };
+        std::wstring generatorNamespace{ generator->GetNamespace() };
 
         if (ignoredNamespaces.find(generatorNamespace) != ignoredNamespaces.end())
         {
@@ -366,18 +428,24 @@ void CascadiaSettings::_LoadDynamicProfiles()
         }
         else
         {
-            try
+            generated.emplace_back(std::move(generatorNamespace), std::async(std::launch::async, [&generator]() {
+                                       return generator->GenerateProfiles();
+                                   }));
+        }
+    }
+
+    for (auto& [generatorNamespace, profiles] : generated)
+    {
+        try
+        {
+            for (auto& profile : profiles.get())
             {
-                auto profiles = generator->GenerateProfiles();
-                for (auto& profile : profiles)
-                {
-                    profile.Source(generatorNamespace);
+                profile.Source(generatorNamespace);
 
-                    _allProfiles.Append(profile);
-                }
+                _allProfiles.Append(profile);
             }
-            CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
         }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
     }
 }
 
@@ -387,18 +455,17 @@ void CascadiaSettings::_LoadDynamicProfiles()
 //   modify existing profiles or add new color schemes
 // - If the user settings has any namespaces in the "disabledProfileSources"
 //   property, we'll ensure that the corresponding folders do not get searched
-void CascadiaSettings::_LoadFragmentExtensions()
+// - This doesn't touch the settings object, so that it can run on a
+//   background thread while the dynamic profiles are generated. Each source
+//   is read and parsed concurrently, but the result is always in the order
+//   of the sources. Use _LayerFragmentExtensions to apply it.
+// Arguments:
+// - ignoredNamespaces: the namespaces the user wants to ignore
+// Return Value:
+// - The parsed json files of each source, in the order they should be layered
+std::vector<CascadiaSettings::FragmentSource> CascadiaSettings::_CollectFragmentExtensions(const std::unordered_set<std::wstring>& ignoredNamespaces)
 {
-    // First, accumulate the namespaces the user wants to ignore
-    std::unordered_set<std::wstring> ignoredNamespaces;
-    const auto disabledProfileSources = CascadiaSettings::_GetDisabledProfileSourcesJsonObject(_userSettings);
-    if (disabledProfileSources.isArray())
-    {
-        for (const auto& json : disabledProfileSources)
-        {
-            ignoredNamespaces.emplace(JsonUtils::GetValue<std::wstring>(json));
-        }
-    }
+    std::vector<std::future<FragmentSource>> sources;
 
     // Search through the local app data folder
     wil::unique_cotaskmem_string localAppDataFolder;
@@ -407,7 +474,7 @@ void CascadiaSettings::_LoadFragmentExtensions()
 
     if (std::filesystem::exists(localAppDataFragments))
     {
-        _ApplyJsonStubsHelper(localAppDataFragments, ignoredNamespaces);
+        _CollectJsonStubsHelper(localAppDataFragments, ignoredNamespaces, sources);
     }
 
     // Search through the program data folder
@@ -416,7 +483,7 @@ void CascadiaSettings::_LoadFragmentExtensions()
     auto programDataFragments = std::wstring(programDataFolder.get()) + FragmentsPath.data();
     if (std::filesystem::exists(programDataFragments))
     {
-        _ApplyJsonStubsHelper(programDataFragments, ignoredNamespaces);
+        _CollectJsonStubsHelper(programDataFragments, ignoredNamespaces, sources);
     }
 
     // Search through app extensions
@@ -447,22 +514,29 @@ void CascadiaSettings::_LoadFragmentExtensions()
                 // If the directory exists, use the fragments in it
                 if (std::filesystem::exists(path))
                 {
-                    const auto jsonFiles = _AccumulateJsonFilesInDirectory(til::u8u16(path));
-
                     // Provide the package name as the source
-                    _ParseAndLayerFragmentFiles(jsonFiles, ext.Package().Id().FamilyName().c_str());
+                    sources.emplace_back(std::async(std::launch::async, &CascadiaSettings::_ParseFragmentFiles, til::u8u16(path), ext.Package().Id().FamilyName()));
                 }
             }
         }
     }
+
+    std::vector<FragmentSource> fragments;
+    fragments.reserve(sources.size());
+    for (auto& source : sources)
+    {
+        fragments.emplace_back(source.get());
+    }
+    return fragments;
 }
 
 // Method Description:
-// - Helper function to apply json stubs in the local app data folder and the global program data folder
+// - Helper function to find the json stubs in the local app data folder and the global program data folder
 // Arguments:
 // - The directory to find json files in
 // - The set of ignored namespaces
-void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces)
+// - sources: receives a pending FragmentSource for each source in the directory
+void CascadiaSettings::_CollectJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces, std::vector<std::future<FragmentSource>>& sources)
 {
     // The json files should be within subdirectories where the subdirectory name is the app name
     for (const auto& fragmentExtFolder : std::filesystem::directory_iterator(directory))
@@ -474,62 +548,104 @@ void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory,
         // (also make sure this is a directory for sanity)
         if (std::filesystem::is_directory(fragmentExtFolder) && ignoredNamespaces.find(source) == ignoredNamespaces.end())
         {
-            const auto jsonFiles = _AccumulateJsonFilesInDirectory(fragmentExtFolder.path().c_str());
-            _ParseAndLayerFragmentFiles(jsonFiles, winrt::hstring{ source });
+            sources.emplace_back(std::async(std::launch::async, &CascadiaSettings::_ParseFragmentFiles, fragmentExtFolder.path().wstring(), winrt::hstring{ source }));
         }
     }
 }
 
 // Method Description:
-// - Finds all the json files within the given directory
+// - Reads and parses all the json files within the given directory
+// - A file that fails to parse is logged and skipped, instead of aborting
+//   the remaining fragments.
 // Arguments:
 // - directory: the directory to search
+// - source: the location the files came from
 // Return Value:
-// - A set containing all the found file data
-std::unordered_set<std::string> CascadiaSettings::_AccumulateJsonFilesInDirectory(const std::wstring_view directory)
+// - The parsed files of the source
+CascadiaSettings::FragmentSource CascadiaSettings::_ParseFragmentFiles(const std::wstring directory, const winrt::hstring source)
 {
-    std::unordered_set<std::string> jsonFiles;
+    FragmentSource fragment{ source };
+    for (const auto& file : _AccumulateJsonFilesInDirectory(directory))
+    {
+        try
+        {
+            // A file could have many new profiles/many profiles it wants to modify/many new color schemes
+            // so we first parse the entire file into one json object
+            fragment.files.emplace_back(_ParseUtf8JsonString(file));
+        }
+        CATCH_LOG_MSG("Fragment source: \"%ls\"", source.c_str());
+    }
+    return fragment;
+}
 
+// Method Description:
+// - Finds all the json files within the given directory
+// Arguments:
+// - directory: the directory to search
+// Return Value:
+// - The data of all the found files, sorted by their file name
+std::vector<std::string> CascadiaSettings::_AccumulateJsonFilesInDirectory(const std::wstring_view directory)
+{
+    // Sort the files so that they are always layered in the same order.
+    std::vector<std::filesystem::path> paths;
     for (const auto& fragmentExt : std::filesystem::directory_iterator(directory))
     {
         if (fragmentExt.path().extension() == jsonExtension)
         {
-            wil::unique_hfile hFile{ CreateFileW(fragmentExt.path().c_str(),
-                                                 GENERIC_READ,
-                                                 FILE_SHARE_READ | FILE_SHARE_WRITE,
-                                                 nullptr,
-                                                 OPEN_EXISTING,
-                                                 FILE_ATTRIBUTE_NORMAL,
-                                                 nullptr) };
+            paths.emplace_back(fragmentExt.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
 
-            if (!hFile)
-            {
-                LOG_LAST_ERROR();
-            }
-            else
-            {
-                const auto fileData = _ReadFile(hFile.get()).value();
-                jsonFiles.emplace(fileData);
-            }
+    std::vector<std::string> jsonFiles;
+    jsonFiles.reserve(paths.size());
+    for (const auto& path : paths)
+    {
+        wil::unique_hfile hFile{ CreateFileW(path.c_str(),
+                                             GENERIC_READ,
+                                             FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                             nullptr,
+                                             OPEN_EXISTING,
+                                             FILE_ATTRIBUTE_NORMAL,
+                                             nullptr) };
+
+        if (!hFile)
+        {
+            LOG_LAST_ERROR();
+        }
+        else
+        {
+            jsonFiles.emplace_back(_ReadFile(hFile.get()).value());
         }
     }
     return jsonFiles;
 }
 
 // Method Description:
-// - Given a set of json files, uses them to modify existing profiles,
+// - Applies the fragments collected by _CollectFragmentExtensions, in order.
+// Arguments:
+// - fragments: the parsed json files of each source
+void CascadiaSettings::_LayerFragmentExtensions(std::vector<FragmentSource> fragments)
+{
+    _BuildProfileIndex();
+    auto dropProfileIndex = wil::scope_exit([this]() noexcept { _profileIndex.reset(); });
+
+    for (auto& fragment : fragments)
+    {
+        _LayerFragmentFiles(fragment.files, fragment.source);
+    }
+}
+
+// Method Description:
+// - Given a set of parsed json files, uses them to modify existing profiles,
 //   create new profiles, and create new color schemes
 // Arguments:
-// - files: the set of json files (each item in the set is the file data)
+// - files: the parsed json files
 // - source: the location the files came from
-void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source)
+void CascadiaSettings::_LayerFragmentFiles(std::vector<Json::Value>& files, const winrt::hstring& source)
 {
-    for (const auto& file : files)
+    for (auto& fullFile : files)
     {
-        // A file could have many new profiles/many profiles it wants to modify/many new color schemes
-        // so we first parse the entire file into one json object
-        auto fullFile = _ParseUtf8JsonString(file.data());
-
         if (fullFile.isMember(JsonKey(ProfilesKey)))
         {
             // Now we separately get each stub that modifies/adds a profile
@@ -542,17 +658,19 @@ void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std:
                     // This stub is meant to be a modification to an existing profile,
                     // try to find the matching profile
                     profileStub[JsonKey(GuidKey)] = profileStub[JsonKey(UpdatesKey)];
-                    auto matchingProfile = _FindMatchingProfile(profileStub);
-                    if (matchingProfile)
+                    if (const auto matchingIndex = _FindMatchingProfileIndex(profileStub))
                     {
                         // We found a matching profile, create a child of it and put the modifications there
                         // (we add a new inheritance layer)
+                        const auto matchingProfile{ winrt::get_self<Profile>(_allProfiles.GetAt(*matchingIndex)) };
+                        const auto previousGuid{ matchingProfile->Guid() };
                         auto childImpl{ matchingProfile->CreateChild() };
                         childImpl->LayerJson(profileStub);
                         childImpl->Origin(OriginTag::Fragment);
 
                         // replace parent in _profiles with child
-                        _allProfiles.SetAt(_FindMatchingProfileIndex(matchingProfile->ToJson()).value(), *childImpl);
+                        _allProfiles.SetAt(*matchingIndex, *childImpl);
+                        _UpdateProfileIndex(*matchingIndex, previousGuid);
                     }
                 }
                 else
@@ -568,6 +686,7 @@ void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std:
                         newProfile->Source(source);
                         newProfile->Origin(OriginTag::Fragment);
                         _allProfiles.Append(*newProfile);
+                        _UpdateProfileIndex(_allProfiles.Size() - 1, std::nullopt);
                     }
                 }
             }
@@ -847,6 +966,8 @@ void CascadiaSettings::LayerJson(const Json::Value& json)
         }
     }
 
+    _BuildProfileIndex();
+    auto dropProfileIndex = wil::scope_exit([this]() noexcept { _profileIndex.reset(); });
     for (auto profileJson : _GetProfilesJsonObject(json))
     {
         if (profileJson.isObject() && _IsValidProfileObject(profileJson))
@@ -876,6 +997,7 @@ void CascadiaSettings::_LayerOrCreateProfile(const Json::Value& profileJson)
     {
         auto parentProj{ _allProfiles.GetAt(*profileIndex) };
         auto parent{ winrt::get_self<Profile>(parentProj) };
+        const auto previousGuid{ parent->Guid() };
 
         if (_userDefaultProfileSettings)
         {
@@ -893,6 +1015,9 @@ void CascadiaSettings::_LayerOrCreateProfile(const Json::Value& profileJson)
             // replace parent in _profiles with child
             _allProfiles.SetAt(*profileIndex, *childImpl);
         }
+
+        // The layered json may have changed the name the GUID is generated from.
+        _UpdateProfileIndex(*profileIndex, previousGuid);
     }
     else
     {
@@ -912,6 +1037,7 @@ void CascadiaSettings::_LayerOrCreateProfile(const Json::Value& profileJson)
 
             profile->LayerJson(profileJson);
             _allProfiles.Append(*profile);
+            _UpdateProfileIndex(_allProfiles.Size() - 1, std::nullopt);
         }
     }
 }
@@ -951,6 +1077,23 @@ winrt::com_ptr<Profile> CascadiaSettings::_FindMatchingProfile(const Json::Value
 // - The index for the matching Profile, iff it exists. Otherwise, nullopt.
 std::optional<uint32_t> CascadiaSettings::_FindMatchingProfileIndex(const Json::Value& profileJson)
 {
+    if (_profileIndex)
+    {
+        // Only the profiles with the right GUID can match.
+        const auto it = _profileIndex->find(Profile::GetGuidForLayering(profileJson));
+        if (it != _profileIndex->end())
+        {
+            for (const auto i : it->second)
+            {
+                if (winrt::get_self<Profile>(_allProfiles.GetAt(i))->ShouldBeLayered(profileJson))
+                {
+                    return i;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
     for (uint32_t i = 0; i < _allProfiles.Size(); ++i)
     {
         const auto profile{ _allProfiles.GetAt(i) };
@@ -963,6 +1106,60 @@ std::optional<uint32_t> CascadiaSettings::_FindMatchingProfileIndex(const Json::
     return std::nullopt;
 }
 
+// Method Description:
+// - Indexes _allProfiles by their GUIDs, so that _FindMatchingProfileIndex
+//   doesn't need to look at every profile for every json object it's given.
+// - The index has to be kept up to date with _UpdateProfileIndex while it
+//   exists. Only _LayerOrCreateProfile and _LayerFragmentFiles do that, so
+//   callers must reset _profileIndex again when they're done layering.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CascadiaSettings::_BuildProfileIndex()
+{
+    _profileIndex.emplace();
+    const auto size{ _allProfiles.Size() };
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        (*_profileIndex)[_allProfiles.GetAt(i).Guid()].emplace_back(i);
+    }
+}
+
+// Method Description:
+// - Updates _profileIndex, if it exists, for a profile that was appended to
+//   _allProfiles or whose json was layered.
+// Arguments:
+// - index: the index of the profile in _allProfiles
+// - previousGuid: the GUID the profile was indexed with, if any
+// Return Value:
+// - <none>
+void CascadiaSettings::_UpdateProfileIndex(const uint32_t index, const std::optional<winrt::guid> previousGuid)
+{
+    if (!_profileIndex)
+    {
+        return;
+    }
+
+    const auto guid{ _allProfiles.GetAt(index).Guid() };
+    if (previousGuid == guid)
+    {
+        return;
+    }
+
+    if (previousGuid)
+    {
+        if (const auto it = _profileIndex->find(*previousGuid); it != _profileIndex->end())
+        {
+            auto& previous{ it->second };
+            previous.erase(std::remove(previous.begin(), previous.end(), index), previous.end());
+        }
+    }
+
+    auto& indices{ (*_profileIndex)[guid] };
+    indices.insert(std::lower_bound(indices.begin(), indices.end(), index), index);
+}
+
 // Method Description:
 // - Finds the "default profile settings" if they exist in the users settings,
 //   and applies them to the existing profiles. The "default profile settings"
@@ -1075,6 +1272,9 @@ bool CascadiaSettings::_IsPackaged()
 // Method Description:
 // - Writes the given content in UTF-8 to a settings file using the Win32 APIS's.
 //   Will overwrite any existing content in the file.
+// - The content is written to a temporary file next to the settings file
+//   first, which then replaces the settings file. That way a crash or a full
+//   disk halfway through a save never leaves a truncated settings file behind.
 // Arguments:
 // - content: the given string of content to write to the file.
 // Return Value:
@@ -1083,9 +1283,28 @@ bool CascadiaSettings::_IsPackaged()
 //      fail to write the file
 void CascadiaSettings::_WriteSettings(const std::string_view content, const hstring filepath)
 {
-    wil::unique_hfile hOut{ CreateFileW(filepath.c_str(),
+    // GH#5186 - settings.json might be a symbolic link. Replacing the link
+    // itself would turn it into a regular file, so replace its target instead.
+    std::wstring targetPath{ filepath };
+    {
+        wil::unique_hfile hExisting{ CreateFileW(filepath.c_str(),
+                                                 0,
+                                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                                 nullptr,
+                                                 OPEN_EXISTING,
+                                                 FILE_ATTRIBUTE_NORMAL,
+                                                 nullptr) };
+        std::wstring finalPath;
+        if (hExisting && SUCCEEDED_LOG(wil::GetFinalPathNameByHandleW(hExisting.get(), finalPath)))
+        {
+            targetPath = std::move(finalPath);
+        }
+    }
+
+    const auto tempPath{ targetPath + L".tmp" };
+    wil::unique_hfile hOut{ CreateFileW(tempPath.c_str(),
                                         GENERIC_WRITE,
-                                        FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                        FILE_SHARE_READ,
                                         nullptr,
                                         CREATE_ALWAYS,
                                         FILE_ATTRIBUTE_NORMAL,
@@ -1094,7 +1313,17 @@ void CascadiaSettings::_WriteSettings(const std::string_view content, const hstr
     {
         THROW_LAST_ERROR();
     }
+    auto deleteTempFile = wil::scope_exit([&]() noexcept {
+        hOut.reset();
+        DeleteFileW(tempPath.c_str());
+    });
+
     THROW_LAST_ERROR_IF(!WriteFile(hOut.get(), content.data(), gsl::narrow<DWORD>(content.size()), nullptr, nullptr));
+    THROW_LAST_ERROR_IF(!FlushFileBuffers(hOut.get()));
+    hOut.reset();
+
+    THROW_LAST_ERROR_IF(!MoveFileExW(tempPath.c_str(), targetPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH));
+    deleteTempFile.release();
 }
 
 // Method Description:
@@ -1291,6 +1520,70 @@ const Json::Value& CascadiaSettings::_GetDisabledProfileSourcesJsonObject(const
 // Return Value:
 // - <none>
 void CascadiaSettings::WriteSettingsToDisk() const
+{
+    _WriteSettingsSnapshot(_userSettingsString, ToJson());
+
+    // Persists the default terminal choice
+    //
+    // GH#10003 - Only do this if _currentDefaultTerminal was actually
+    // initialized. It's only initialized when Launch.cpp calls
+    // `CascadiaSettings::RefreshDefaultTerminals`. We really don't need it
+    // otherwise.
+    if (_currentDefaultTerminal)
+    {
+        Model::DefaultTerminal::Current(_currentDefaultTerminal);
+    }
+}
+
+// Method Description:
+// - Does the same as WriteSettingsToDisk, but formats and writes the settings
+//   on a background thread. The content of the settings is captured before
+//   this returns, so the caller is free to keep modifying them.
+// - Saves are written one at a time. If a later save already made it to disk
+//   by the time an earlier one gets its turn, the earlier one is dropped.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+winrt::Windows::Foundation::IAsyncAction CascadiaSettings::WriteSettingsToDiskAsync() const
+{
+    static std::mutex writeLock;
+    static std::atomic<uint64_t> lastQueuedSave{ 0 };
+    static uint64_t lastWrittenSave{ 0 };
+
+    // Don't touch `this` past the co_await: the settings UI keeps editing the
+    // settings while we're writing them.
+    const auto userSettingsString{ _userSettingsString };
+    const auto json{ ToJson() };
+    const auto currentDefaultTerminal{ _currentDefaultTerminal };
+    const auto save{ ++lastQueuedSave };
+
+    co_await winrt::resume_background();
+
+    std::scoped_lock lock{ writeLock };
+    if (save < lastWrittenSave)
+    {
+        co_return;
+    }
+    lastWrittenSave = save;
+
+    _WriteSettingsSnapshot(userSettingsString, json);
+
+    if (currentDefaultTerminal)
+    {
+        Model::DefaultTerminal::Current(currentDefaultTerminal);
+    }
+}
+
+// Method Description:
+// - Writes the given settings to our settings file, after creating a
+//   timestamped backup of the settings file's previous content.
+// Arguments:
+// - userSettingsString: the content of the settings file when it was loaded
+// - json: the settings to write
+// Return Value:
+// - <none>
+void CascadiaSettings::_WriteSettingsSnapshot(const std::string_view userSettingsString, const Json::Value& json)
 {
     const auto settingsPath{ CascadiaSettings::SettingsPath() };
 
@@ -1300,7 +1593,7 @@ void CascadiaSettings::WriteSettingsToDisk() const
         const auto clock{ std::chrono::system_clock() };
         const auto timeStamp{ clock.to_time_t(clock.now()) };
         const winrt::hstring backupSettingsPath{ fmt::format(L"{}.{:%Y-%m-%dT%H-%M-%S}.backup", settingsPath, fmt::localtime(timeStamp)) };
-        _WriteSettings(_userSettingsString, backupSettingsPath);
+        _WriteSettings(userSettingsString, backupSettingsPath);
     }
     CATCH_LOG();
 
@@ -1309,19 +1602,8 @@ void CascadiaSettings::WriteSettingsToDisk() const
     wbuilder.settings_["indentation"] = "    ";
     wbuilder.settings_["enableYAMLCompatibility"] = true; // suppress spaces around colons
 
-    const auto styledString{ Json::writeString(wbuilder, ToJson()) };
+    const auto styledString{ Json::writeString(wbuilder, json) };
     _WriteSettings(styledString, settingsPath);
-
-    // Persists the default terminal choice
-    //
-    // GH#10003 - Only do this if _currentDefaultTerminal was actually
-    // initialized. It's only initialized when Launch.cpp calls
-    // `CascadiaSettings::RefreshDefaultTerminals`. We really don't need it
-    // otherwise.
-    if (_currentDefaultTerminal)
-    {
-        Model::DefaultTerminal::Current(_currentDefaultTerminal);
-    }
 }
 
 // Method Description:
@@ -53,8 +53,10 @@ static constexpr std::string_view DebugFeaturesKey{ "debugFeatures" };
 
 static constexpr std::string_view ForceFullRepaintRenderingKey{ "experimental.rendering.forceFullRepaint" };
 static constexpr std::string_view SoftwareRenderingKey{ "experimental.rendering.software" };
+static constexpr std::string_view RenderingAdapterKey{ "experimental.rendering.adapter" };
 static constexpr std::string_view ForceVTInputKey{ "experimental.input.forceVT" };
 static constexpr std::string_view DetectURLsKey{ "experimental.detectURLs" };
+static constexpr std::string_view PseudoConsolePoolSizeKey{ "experimental.pseudoConsolePoolSize" };
 
 #ifdef _DEBUG
 static constexpr bool debugFeaturesDefault{ true };
@@ -118,6 +120,7 @@ winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
     globals->_SnapToGridOnResize = _SnapToGridOnResize;
     globals->_ForceFullRepaintRendering = _ForceFullRepaintRendering;
     globals->_SoftwareRendering = _SoftwareRendering;
+    globals->_RenderingAdapter = _RenderingAdapter;
     globals->_ForceVTInput = _ForceVTInput;
     globals->_DebugFeaturesEnabled = _DebugFeaturesEnabled;
     globals->_StartOnUserLogin = _StartOnUserLogin;
@@ -129,6 +132,7 @@ winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
     globals->_WindowingBehavior = _WindowingBehavior;
     globals->_TrimBlockSelection = _TrimBlockSelection;
     globals->_DetectURLs = _DetectURLs;
+    globals->_PseudoConsolePoolSize = _PseudoConsolePoolSize;
 
     globals->_UnparsedDefaultProfile = _UnparsedDefaultProfile;
     globals->_validDefaultProfile = _validDefaultProfile;
@@ -295,6 +299,7 @@ void GlobalAppSettings::LayerJson(const Json::Value& json)
     JsonUtils::GetValueForKey(json, ForceFullRepaintRenderingKey, _ForceFullRepaintRendering);
 
     JsonUtils::GetValueForKey(json, SoftwareRenderingKey, _SoftwareRendering);
+    JsonUtils::GetValueForKey(json, RenderingAdapterKey, _RenderingAdapter);
     JsonUtils::GetValueForKey(json, ForceVTInputKey, _ForceVTInput);
 
     JsonUtils::GetValueForKey(json, EnableStartupTaskKey, _StartOnUserLogin);
@@ -319,6 +324,8 @@ void GlobalAppSettings::LayerJson(const Json::Value& json)
 
     JsonUtils::GetValueForKey(json, DetectURLsKey, _DetectURLs);
 
+    JsonUtils::GetValueForKey(json, PseudoConsolePoolSizeKey, _PseudoConsolePoolSize);
+
     // This is a helper lambda to get the keybindings and commands out of both
     // and array of objects. We'll use this twice, once on the legacy
     // `keybindings` key, and again on the newer `bindings` key.
@@ -404,6 +411,7 @@ Json::Value GlobalAppSettings::ToJson() const
     JsonUtils::SetValueForKey(json, DebugFeaturesKey,               _DebugFeaturesEnabled);
     JsonUtils::SetValueForKey(json, ForceFullRepaintRenderingKey,   _ForceFullRepaintRendering);
     JsonUtils::SetValueForKey(json, SoftwareRenderingKey,           _SoftwareRendering);
+    JsonUtils::SetValueForKey(json, RenderingAdapterKey,            _RenderingAdapter);
     JsonUtils::SetValueForKey(json, ForceVTInputKey,                _ForceVTInput);
     JsonUtils::SetValueForKey(json, EnableStartupTaskKey,           _StartOnUserLogin);
     JsonUtils::SetValueForKey(json, AlwaysOnTopKey,                 _AlwaysOnTop);
@@ -414,6 +422,7 @@ Json::Value GlobalAppSettings::ToJson() const
     JsonUtils::SetValueForKey(json, WindowingBehaviorKey,           _WindowingBehavior);
     JsonUtils::SetValueForKey(json, TrimBlockSelectionKey,          _TrimBlockSelection);
     JsonUtils::SetValueForKey(json, DetectURLsKey,                  _DetectURLs);
+    JsonUtils::SetValueForKey(json, PseudoConsolePoolSizeKey,       _PseudoConsolePoolSize);
     // clang-format on
 
     json[JsonKey(ActionsKey)] = _actionMap->ToJson();
@@ -81,6 +81,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, SnapToGridOnResize, true);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, ForceFullRepaintRendering, false);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, SoftwareRendering, false);
+        INHERITABLE_SETTING(Model::GlobalAppSettings, hstring, RenderingAdapter, L"");
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, ForceVTInput, false);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, DebugFeaturesEnabled, _getDefaultDebugFeaturesValue());
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, StartOnUserLogin, false);
@@ -92,6 +93,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::GlobalAppSettings, Model::WindowingMode, WindowingBehavior, Model::WindowingMode::UseNew);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, TrimBlockSelection, false);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, DetectURLs, true);
+        INHERITABLE_SETTING(Model::GlobalAppSettings, int32_t, PseudoConsolePoolSize, 0);
 
     private:
         guid _defaultProfile;
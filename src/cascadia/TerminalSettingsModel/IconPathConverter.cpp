@@ -154,6 +154,47 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         return iconSource;
     }
 
+    // Method Description:
+    // - Same as _getIconSource, but each path is only turned into an
+    //   IconSource once. The tabs, the new tab menu and the command palette
+    //   all ask for the icons of the same few profiles over and over again,
+    //   and each new IconSource has XAML load and decode its image again.
+    // - The IconSources are XAML objects, which can only be used on the thread
+    //   that created them, so they are cached per thread. Nothing modifies the
+    //   returned IconSources, so they're safe to share between elements.
+    // Template Types:
+    // - <TIconSource>: The type of IconSource (MUX, WUX) to generate.
+    // Arguments:
+    // - path: the unprocessed path to the icon.
+    // Return Value:
+    // - An IconElement with its IconSource set, if possible.
+    template<typename TIconSource>
+    TIconSource _getCachedIconSource(const winrt::hstring& iconPath)
+    {
+        // This is leaked on purpose: releasing the IconSources when the
+        // process exits would happen long after XAML was torn down.
+        static auto& cache = *new std::map<std::pair<DWORD, std::wstring>, TIconSource>();
+        static std::mutex lock;
+
+        std::pair<DWORD, std::wstring> key{ GetCurrentThreadId(), std::wstring{ iconPath } };
+        {
+            std::scoped_lock guard{ lock };
+            if (const auto it = cache.find(key); it != cache.end())
+            {
+                return it->second;
+            }
+        }
+
+        // The IconSource is created outside of the lock, since that calls
+        // into XAML. The key contains the thread, so no other thread can
+        // race us for it.
+        auto iconSource = _getIconSource<TIconSource>(iconPath);
+
+        std::scoped_lock guard{ lock };
+        cache.emplace(std::move(key), iconSource);
+        return iconSource;
+    }
+
     static winrt::hstring _expandIconPath(hstring iconPath)
     {
         if (iconPath.empty())
@@ -183,7 +224,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                                                         hstring const& /* language */)
     {
         const auto& iconPath = winrt::unbox_value_or<winrt::hstring>(value, L"");
-        return _getIconSource<Controls::IconSource>(iconPath);
+        return _getCachedIconSource<Controls::IconSource>(iconPath);
     }
 
     // unused for one-way bindings
@@ -197,11 +238,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
     Windows::UI::Xaml::Controls::IconSource IconPathConverter::IconSourceWUX(hstring path)
     {
-        return _getIconSource<Windows::UI::Xaml::Controls::IconSource>(path);
+        return _getCachedIconSource<Windows::UI::Xaml::Controls::IconSource>(path);
     }
 
     Microsoft::UI::Xaml::Controls::IconSource IconPathConverter::IconSourceMUX(hstring path)
     {
-        return _getIconSource<Microsoft::UI::Xaml::Controls::IconSource>(path);
+        return _getCachedIconSource<Microsoft::UI::Xaml::Controls::IconSource>(path);
     }
 }
@@ -45,6 +45,9 @@ static constexpr std::string_view PaddingKey{ "padding" };
 static constexpr std::string_view StartingDirectoryKey{ "startingDirectory" };
 static constexpr std::string_view IconKey{ "icon" };
 static constexpr std::string_view AntialiasingModeKey{ "antialiasingMode" };
+static constexpr std::string_view UseAtlasEngineKey{ "experimental.useAtlasEngine" };
+static constexpr std::string_view LowLatencyInputKey{ "experimental.lowLatencyInput" };
+static constexpr std::string_view BoostRenderPriorityKey{ "experimental.rendering.boostPriority" };
 static constexpr std::string_view TabColorKey{ "tabColor" };
 static constexpr std::string_view BellStyleKey{ "bellStyle" };
 static constexpr std::string_view UnfocusedAppearanceKey{ "unfocusedAppearance" };
@@ -85,6 +88,9 @@ winrt::com_ptr<Profile> Profile::CopySettings(winrt::com_ptr<Profile> source)
     profile->_AntialiasingMode = source->_AntialiasingMode;
     profile->_ForceFullRepaintRendering = source->_ForceFullRepaintRendering;
     profile->_SoftwareRendering = source->_SoftwareRendering;
+    profile->_UseAtlasEngine = source->_UseAtlasEngine;
+    profile->_LowLatencyInput = source->_LowLatencyInput;
+    profile->_BoostRenderPriority = source->_BoostRenderPriority;
     profile->_HistorySize = source->_HistorySize;
     profile->_SnapOnInput = source->_SnapOnInput;
     profile->_AltGrAliasing = source->_AltGrAliasing;
@@ -244,26 +250,13 @@ bool Profile::ShouldBeLayered(const Json::Value& json) const
 {
     // First, check that GUIDs match. This is easy. If they don't match, they
     // should _definitely_ not layer.
-    const auto otherGuid{ JsonUtils::GetValueForKey<std::optional<winrt::guid>>(json, GuidKey) };
-    const auto otherSource{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
-    if (otherGuid)
-    {
-        if (otherGuid.value() != Guid())
-        {
-            return false;
-        }
-    }
-    else
+    if (GetGuidForLayering(json) != Guid())
     {
-        // If the other json object didn't have a GUID,
-        // check if we auto-generate the same guid using the name and source.
-        const auto otherName{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, NameKey) };
-        if (Guid() != _GenerateGuidForProfile(otherName ? *otherName : L"Default", otherSource ? *otherSource : L""))
-        {
-            return false;
-        }
+        return false;
     }
 
+    const auto otherSource{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
+
     // For profiles with a `source`, also check the `source` property.
     bool sourceMatches = false;
     const auto mySource{ Source() };
@@ -348,6 +341,9 @@ void Profile::LayerJson(const Json::Value& json)
 
     JsonUtils::GetValueForKey(json, IconKey, _Icon);
     JsonUtils::GetValueForKey(json, AntialiasingModeKey, _AntialiasingMode);
+    JsonUtils::GetValueForKey(json, UseAtlasEngineKey, _UseAtlasEngine);
+    JsonUtils::GetValueForKey(json, LowLatencyInputKey, _LowLatencyInput);
+    JsonUtils::GetValueForKey(json, BoostRenderPriorityKey, _BoostRenderPriority);
     JsonUtils::GetValueForKey(json, TabColorKey, _TabColor);
     JsonUtils::GetValueForKey(json, BellStyleKey, _BellStyle);
 
@@ -481,6 +477,27 @@ winrt::guid Profile::GetGuidOrGenerateForJson(const Json::Value& json) noexcept
     return Profile::_GenerateGuidForProfile(name, source);
 }
 
+// Function Description:
+// - Gets the GUID a profile needs to have for the given json object to be
+//   layered on it (see ShouldBeLayered). Unlike GetGuidOrGenerateForJson, a
+//   json object without a name is treated as if it was named "Default".
+// Arguments:
+// - json: the JSON object to get a GUID from
+// Return Value:
+// - The json's `guid`, or the guid synthesized from its name and source.
+winrt::guid Profile::GetGuidForLayering(const Json::Value& json)
+{
+    if (const auto guid{ JsonUtils::GetValueForKey<std::optional<winrt::guid>>(json, GuidKey) })
+    {
+        return *guid;
+    }
+
+    // If the json object doesn't have a GUID, we auto-generate one using the name and source.
+    const auto name{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, NameKey) };
+    const auto source{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
+    return _GenerateGuidForProfile(name ? *name : L"Default", source ? *source : L"");
+}
+
 // Method Description:
 // - Create a new serialized JsonObject from an instance of this class
 // Arguments:
@@ -527,6 +544,9 @@ Json::Value Profile::ToJson() const
     JsonUtils::SetValueForKey(json, StartingDirectoryKey, _StartingDirectory);
     JsonUtils::SetValueForKey(json, IconKey, _Icon);
     JsonUtils::SetValueForKey(json, AntialiasingModeKey, _AntialiasingMode);
+    JsonUtils::SetValueForKey(json, UseAtlasEngineKey, _UseAtlasEngine);
+    JsonUtils::SetValueForKey(json, LowLatencyInputKey, _LowLatencyInput);
+    JsonUtils::SetValueForKey(json, BoostRenderPriorityKey, _BoostRenderPriority);
     JsonUtils::SetValueForKey(json, TabColorKey, _TabColor);
     JsonUtils::SetValueForKey(json, BellStyleKey, _BellStyle);
 
@@ -96,6 +96,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         hstring EvaluatedStartingDirectory() const;
         static guid GetGuidOrGenerateForJson(const Json::Value& json) noexcept;
+        static guid GetGuidForLayering(const Json::Value& json);
 
         Model::IAppearanceConfig DefaultAppearance();
 
@@ -132,6 +133,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::Profile, Microsoft::Terminal::Control::TextAntialiasingMode, AntialiasingMode, Microsoft::Terminal::Control::TextAntialiasingMode::Grayscale);
         INHERITABLE_SETTING(Model::Profile, bool, ForceFullRepaintRendering, false);
         INHERITABLE_SETTING(Model::Profile, bool, SoftwareRendering, false);
+        INHERITABLE_SETTING(Model::Profile, bool, UseAtlasEngine, false);
+        INHERITABLE_SETTING(Model::Profile, bool, LowLatencyInput, false);
+        INHERITABLE_SETTING(Model::Profile, bool, BoostRenderPriority, false);
 
         INHERITABLE_SETTING(Model::Profile, int32_t, HistorySize, DEFAULT_HISTORY_SIZE);
         INHERITABLE_SETTING(Model::Profile, bool, SnapOnInput, true);
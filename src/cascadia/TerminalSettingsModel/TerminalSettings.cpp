@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include "TerminalSettings.h"
+#include "CascadiaSettings.h"
 #include "../../types/inc/colorTable.hpp"
 
 #include "TerminalSettings.g.cpp"
@@ -55,6 +56,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     //   use the guid to look up the profile that should be used to
     //   create these TerminalSettings. Then, we'll apply settings contained in the
     //   global and profile settings to the instance.
+    // - The global and profile settings are only resolved once per profile (see
+    //   _GetResolvedProfileSettings). The returned defaultSettings is a child of
+    //   that shared object, so any changes made to it stay local to the caller.
     // Arguments:
     // - appSettings: the set of settings being used to construct the new terminal
     // - profileGuid: the unique identifier (guid) of the profile
@@ -64,16 +68,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     //   one for when the terminal is focused and the other for when the terminal is unfocused
     Model::TerminalSettingsCreateResult TerminalSettings::CreateWithProfileByID(const Model::CascadiaSettings& appSettings, winrt::guid profileGuid, const IKeyBindings& keybindings)
     {
-        auto settings{ winrt::make_self<TerminalSettings>() };
-        settings->_KeyBindings = keybindings;
-
         const auto profile = appSettings.FindProfile(profileGuid);
         THROW_HR_IF_NULL(E_INVALIDARG, profile);
 
         const auto globals = appSettings.GlobalSettings();
-        settings->_ApplyProfileSettings(profile);
-        settings->_ApplyGlobalSettings(globals);
-        settings->_ApplyAppearanceSettings(profile.DefaultAppearance(), globals.ColorSchemes());
+        auto settings{ _GetResolvedProfileSettings(appSettings, profileGuid, profile)->CreateChild() };
+        settings->_KeyBindings = keybindings;
 
         Model::TerminalSettings child{ nullptr };
         if (const auto& unfocusedAppearance{ profile.UnfocusedAppearance() })
@@ -86,6 +86,54 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         return winrt::make<TerminalSettingsCreateResult>(*settings, child);
     }
 
+    // Method Description:
+    // - Returns the TerminalSettings resolved from the given profile and the
+    //   globals of appSettings. They're built the first time they're requested
+    //   and then cached on appSettings, so creating another pane of the same
+    //   profile doesn't need to evaluate the profile again. The cache lives as
+    //   long as appSettings, so a settings reload starts over with a new one.
+    // - The returned object is shared by every pane of the profile, and must
+    //   not be modified. Callers should create a child of it instead.
+    // - Copies of a CascadiaSettings are edited in place by the settings UI,
+    //   so for those the profile is evaluated again on every call.
+    // Arguments:
+    // - appSettings: the set of settings being used to construct the new terminal
+    // - profileGuid: the unique identifier (guid) of the profile
+    // - profile: the profile that profileGuid belongs to
+    // Return Value:
+    // - the resolved settings of the profile
+    com_ptr<TerminalSettings> TerminalSettings::_GetResolvedProfileSettings(const Model::CascadiaSettings& appSettings,
+                                                                            const guid& profileGuid,
+                                                                            const Model::Profile& profile)
+    {
+        const auto resolve = [&]() {
+            const auto globals = appSettings.GlobalSettings();
+            auto settings{ winrt::make_self<TerminalSettings>() };
+            settings->_ApplyProfileSettings(profile);
+            settings->_ApplyGlobalSettings(globals);
+            settings->_ApplyAppearanceSettings(profile.DefaultAppearance(), globals.ColorSchemes());
+            return settings;
+        };
+
+        const auto appSettingsImpl{ get_self<CascadiaSettings>(appSettings) };
+        if (!appSettingsImpl->_cacheResolvedProfileSettings)
+        {
+            return resolve();
+        }
+
+        std::scoped_lock lock{ appSettingsImpl->_resolvedProfileSettingsLock };
+
+        auto& resolved{ appSettingsImpl->_resolvedProfileSettings[profileGuid] };
+        if (!resolved)
+        {
+            resolved = *resolve();
+        }
+
+        com_ptr<TerminalSettings> resolvedImpl;
+        resolvedImpl.copy_from(get_self<TerminalSettings>(resolved));
+        return resolvedImpl;
+    }
+
     // Method Description:
     // - Create a TerminalSettings object for the provided newTerminalArgs. We'll
     //   use the newTerminalArgs to look up the profile that should be used to
@@ -281,6 +329,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _ScrollState = profile.ScrollState();
 
         _AntialiasingMode = profile.AntialiasingMode();
+        _UseAtlasEngine = profile.UseAtlasEngine();
+        _LowLatencyInput = profile.LowLatencyInput();
+        _BoostRenderPriority = profile.BoostRenderPriority();
 
         if (profile.TabColor())
         {
@@ -305,6 +356,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _FocusFollowMouse = globalSettings.FocusFollowMouse();
         _ForceFullRepaintRendering = globalSettings.ForceFullRepaintRendering();
         _SoftwareRendering = globalSettings.SoftwareRendering();
+        _RenderingAdapter = globalSettings.RenderingAdapter();
         _ForceVTInput = globalSettings.ForceVTInput();
         _TrimBlockSelection = globalSettings.TrimBlockSelection();
         _DetectURLs = globalSettings.DetectURLs();
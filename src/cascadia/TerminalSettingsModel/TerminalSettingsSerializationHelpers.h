@@ -442,6 +442,14 @@ JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Settings::Model::FindMatchDirecti
     };
 };
 
+JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Settings::Model::FindScope)
+{
+    JSON_MAPPINGS(2) = {
+        pair_type{ "tab", ValueType::Tab },
+        pair_type{ "window", ValueType::Window },
+    };
+};
+
 JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Settings::Model::WindowingMode)
 {
     JSON_MAPPINGS(3) = {
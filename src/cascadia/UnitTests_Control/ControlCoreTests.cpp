@@ -31,6 +31,11 @@ namespace ControlUnitTests
         TEST_METHOD(TestFreeAfterClose);
 
         TEST_METHOD(TestFontInitializedInCtor);
+        TEST_METHOD(TestUpdateSettingsKeepsUnchangedFont);
+
+        TEST_METHOD(TestBlinkClockFollowsFocusAndVisibility);
+        TEST_METHOD(TestTypingDoesntWaitForOutput);
+        TEST_METHOD(TestStatistics);
 
         TEST_CLASS_SETUP(ModuleSetup)
         {
@@ -197,4 +202,152 @@ namespace ControlUnitTests
         VERIFY_ARE_EQUAL(L"Impact", std::wstring_view{ core->_actualFont.GetFaceName() });
     }
 
+    void ControlCoreTests::TestUpdateSettingsKeepsUnchangedFont()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        Log::Comment(L"Create ControlCore object");
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+
+        int fontChanges = 0;
+        core->FontSizeChanged([&](auto&&...) { ++fontChanges; });
+
+        core->Initialize(270, 380, 1.0);
+        VERIFY_IS_TRUE(core->_initializedTerminal);
+        VERIFY_ARE_EQUAL(1, fontChanges);
+
+        Log::Comment(L"Settings that don't affect the font don't re-create it");
+        settings->CopyOnSelect(!settings->CopyOnSelect());
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(1, fontChanges);
+
+        Log::Comment(L"Changing the font size does");
+        settings->FontSize(settings->FontSize() + 2);
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(2, fontChanges);
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<SHORT>(settings->FontSize()), core->_desiredFont.GetEngineSize().Y);
+
+        Log::Comment(L"A reload resets the zoom, even if the font settings stayed the same");
+        core->AdjustFontSize(2);
+        VERIFY_ARE_EQUAL(3, fontChanges);
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(4, fontChanges);
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<SHORT>(settings->FontSize()), core->_desiredFont.GetEngineSize().Y);
+    }
+
+    void ControlCoreTests::TestBlinkClockFollowsFocusAndVisibility()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        Log::Comment(L"Create ControlCore object, with a clock that never ticks by itself");
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+        const auto clock = std::make_shared<Control::implementation::BlinkClock>(std::chrono::hours(1), true);
+        core->_blinkClock = clock;
+        core->Initialize(270, 420, 1.0);
+
+        Log::Comment(L"A visible control blinks its text, but not its cursor while it isn't focused");
+        VERIFY_ARE_EQUAL(size_t{ 1 }, clock->_subscribers.size());
+        VERIFY_IS_FALSE(clock->_subscribers[0].cursor);
+        VERIFY_IS_TRUE(clock->_subscribers[0].attributes);
+
+        Log::Comment(L"Gaining focus shows the cursor, and leaves it on for the first tick");
+        core->FocusChanged(true);
+        VERIFY_IS_TRUE(core->CursorOn());
+        clock->Tick();
+        VERIFY_IS_TRUE(core->CursorOn());
+        clock->Tick();
+        VERIFY_IS_FALSE(core->CursorOn());
+
+        Log::Comment(L"So does typing");
+        core->RestartCursorBlink();
+        VERIFY_IS_TRUE(core->CursorOn());
+        clock->Tick();
+        VERIFY_IS_TRUE(core->CursorOn());
+        clock->Tick();
+        VERIFY_IS_FALSE(core->CursorOn());
+
+        Log::Comment(L"Losing focus hides the cursor and stops blinking it");
+        core->FocusChanged(false);
+        VERIFY_IS_FALSE(core->CursorOn());
+        clock->Tick();
+        VERIFY_IS_FALSE(core->CursorOn());
+
+        Log::Comment(L"The clock stops while no control is visible, and a closed control is removed");
+        core->ControlVisibilityChanged(false);
+        VERIFY_IS_TRUE(clock->_subscribers.empty());
+        VERIFY_IS_FALSE(clock->_running);
+        core->ControlVisibilityChanged(true);
+        VERIFY_IS_TRUE(clock->_running);
+        core->Close();
+        VERIFY_IS_TRUE(clock->_subscribers.empty());
+        VERIFY_IS_FALSE(clock->_running);
+    }
+
+    void ControlCoreTests::TestTypingDoesntWaitForOutput()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+        core->_blinkClock = std::make_shared<Control::implementation::BlinkClock>(std::chrono::hours(1), true);
+        core->Initialize(270, 420, 1.0);
+        core->FocusChanged(true);
+        core->CursorOn(false);
+
+        Log::Comment(L"Hold the terminal lock on another thread, like the output thread does during a flood");
+        wil::slim_event_manual_reset locked;
+        wil::slim_event_manual_reset release;
+        std::thread output{ [&]() {
+            auto lock = core->_terminal->LockForWriting();
+            locked.SetEvent();
+            release.wait();
+        } };
+        locked.wait();
+
+        Log::Comment(L"A key press returns right away, and leaves showing the cursor to the next frame");
+        core->RestartCursorBlink();
+        VERIFY_IS_FALSE(core->CursorOn());
+        VERIFY_IS_TRUE(core->_cursorOnPending.load());
+
+        release.SetEvent();
+        output.join();
+        core->_applyPendingCursorOn();
+        VERIFY_IS_TRUE(core->CursorOn());
+        VERIFY_IS_FALSE(core->_cursorOnPending.load());
+
+        Log::Comment(L"Without contention the cursor is shown immediately");
+        core->CursorOn(false);
+        core->RestartCursorBlink();
+        VERIFY_IS_TRUE(core->CursorOn());
+        VERIFY_IS_FALSE(core->_cursorOnPending.load());
+    }
+
+    void ControlCoreTests::TestStatistics()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+        core->Initialize(270, 420, 1.0);
+
+        Log::Comment(L"The rates start out at zero, the buffer holds at least its rows");
+        auto statistics = core->Statistics();
+        VERIFY_ARE_EQUAL(0.0, statistics.OutputCharsPerSecond);
+        VERIFY_ARE_EQUAL(0u, statistics.ScrollbackRows);
+        VERIFY_IS_GREATER_THAN(statistics.BufferTextBytes, uint64_t{ 0 });
+
+        Log::Comment(L"Once a second has passed, the output received in it makes up the rate");
+        core->_connectionOutputHandler(L"0123456789");
+        core->_waitForParsedOutput();
+        core->_ratesSince -= std::chrono::seconds{ 2 };
+        statistics = core->Statistics();
+        VERIFY_IS_GREATER_THAN(statistics.OutputCharsPerSecond, 0.0);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(statistics.OutputCharsPerSecond, 5.0);
+
+        Log::Comment(L"Asking again right away doesn't change the rate");
+        const auto rate = statistics.OutputCharsPerSecond;
+        VERIFY_ARE_EQUAL(rate, core->Statistics().OutputCharsPerSecond);
+    }
 }
@@ -32,6 +32,8 @@ namespace ControlUnitTests
         TEST_METHOD(ScrollWithSelection);
         TEST_METHOD(TestScrollWithTrackpad);
         TEST_METHOD(TestQuickDragOnSelect);
+        TEST_METHOD(CoalesceMouseMovesInAnyEventMode);
+        TEST_METHOD(CoalesceScrollingUntilFlushed);
 
         TEST_CLASS_SETUP(ClassSetup)
         {
@@ -189,6 +191,8 @@ namespace ControlUnitTests
             }
 
             conn->WriteInput(L"Foo\r\n");
+            core->_waitForParsedOutput();
+            core->_raisePendingNotifications();
         }
         // We printed that 40 times, but the final \r\n bumped the view down one MORE row.
         VERIFY_ARE_EQUAL(20, core->_terminal->GetViewport().Height());
@@ -349,6 +353,7 @@ namespace ControlUnitTests
         for (int i = 0; i < 40; ++i)
         {
             conn->WriteInput(L"Foo\r\n");
+            core->_waitForParsedOutput();
         }
         // We printed that 40 times, but the final \r\n bumped the view down one MORE row.
         VERIFY_ARE_EQUAL(20, core->_terminal->GetViewport().Height());
@@ -426,6 +431,7 @@ namespace ControlUnitTests
         for (int i = 0; i < 40; ++i)
         {
             conn->WriteInput(L"Foo\r\n");
+            core->_waitForParsedOutput();
         }
         // We printed that 40 times, but the final \r\n bumped the view down one MORE row.
         VERIFY_ARE_EQUAL(20, core->_terminal->GetViewport().Height());
@@ -485,6 +491,7 @@ namespace ControlUnitTests
         VERIFY_ARE_EQUAL(21, core->ScrollOffset());
 
         conn->WriteInput(L"Foo\r\n");
+        core->_waitForParsedOutput();
         VERIFY_ARE_EQUAL(22, core->ScrollOffset());
         interactivity->MouseWheel(modifiers, delta, mousePos, state); // 1/5
         VERIFY_ARE_EQUAL(22, core->ScrollOffset());
@@ -542,4 +549,103 @@ namespace ControlUnitTests
         COORD expectedAnchor{ 0, 0 };
         VERIFY_ARE_EQUAL(expectedAnchor, core->_terminal->GetSelectionAnchor());
     }
+
+    void ControlInteractivityTests::CoalesceMouseMovesInAnyEventMode()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+        auto [core, interactivity] = _createCoreAndInteractivity(*settings, *conn);
+        _standardInit(core, interactivity);
+
+        Log::Comment(L"Enable any-event mouse tracking with SGR encoding");
+        conn->WriteInput(L"\x1b[?1003h\x1b[?1006h");
+        VERIFY_IS_TRUE(core->IsVtMouseModeEnabled());
+
+        // The MockConnection echoes the input, so that's where the mouse
+        // events the terminal sends show up.
+        std::wstring written;
+        conn->TerminalOutput([&](const winrt::hstring& data) {
+            written += data;
+        });
+
+        const auto modifiers = ControlKeyStates();
+        const TerminalInput::MouseButtonState leftMouseDown{ true, false, false };
+        const TerminalInput::MouseButtonState noMouseDown{ false, false, false };
+        const til::size fontSize{ 9, 21 };
+        const auto cellCenter = [&](const int x) {
+            return til::point{ x * fontSize.width<int>() + 4, 10 };
+        };
+
+        Log::Comment(L"Move across a few cells. Nothing is sent until the moves are flushed.");
+        for (const auto x : { 0, 1, 1, 2 })
+        {
+            interactivity->PointerMoved(noMouseDown, WM_MOUSEMOVE, modifiers, true, cellCenter(x));
+        }
+        VERIFY_IS_TRUE(interactivity->HasPendingMouseMove());
+        VERIFY_IS_TRUE(written.empty());
+
+        Log::Comment(L"Only the last move is sent");
+        interactivity->FlushPendingMouseMove();
+        VERIFY_IS_FALSE(interactivity->HasPendingMouseMove());
+        VERIFY_ARE_EQUAL(String(L"\x1b[<35;3;1M"), String(written.c_str()));
+
+        Log::Comment(L"Moves within the same cell aren't sent again");
+        written.clear();
+        interactivity->PointerMoved(noMouseDown, WM_MOUSEMOVE, modifiers, true, cellCenter(2));
+        interactivity->FlushPendingMouseMove();
+        VERIFY_IS_TRUE(written.empty());
+
+        Log::Comment(L"A click sends the pending move before itself");
+        interactivity->PointerMoved(noMouseDown, WM_MOUSEMOVE, modifiers, true, cellCenter(4));
+        interactivity->PointerPressed(leftMouseDown, WM_LBUTTONDOWN, 0, modifiers, cellCenter(4));
+        VERIFY_IS_FALSE(interactivity->HasPendingMouseMove());
+        VERIFY_ARE_EQUAL(String(L"\x1b[<35;5;1M\x1b[<0;5;1M"), String(written.c_str()));
+    }
+
+    void ControlInteractivityTests::CoalesceScrollingUntilFlushed()
+    {
+        WEX::TestExecution::DisableVerifyExceptions disableVerifyExceptions{};
+
+        auto [settings, conn] = _createSettingsAndConnection();
+        auto [core, interactivity] = _createCoreAndInteractivity(*settings, *conn);
+        _standardInit(core, interactivity);
+        interactivity->_rowsToScroll = 1;
+        interactivity->CoalesceScrolling(true);
+
+        for (int i = 0; i < 40; ++i)
+        {
+            conn->WriteInput(L"Foo\r\n");
+            core->_waitForParsedOutput();
+        }
+        VERIFY_ARE_EQUAL(21, core->ScrollOffset());
+
+        int reportedTop = -1;
+        interactivity->ScrollPositionChanged([&](auto&&, const Control::ScrollPositionChangedArgs& args) {
+            reportedTop = args.ViewTop();
+        });
+
+        const auto modifiers = ControlKeyStates();
+        const til::point mousePos{ 0, 0 };
+        const TerminalInput::MouseButtonState noMouseDown{ false, false, false };
+
+        Log::Comment(L"Scroll up three rows. The scrollbar follows, the viewport doesn't move yet.");
+        for (int i = 0; i < 3; ++i)
+        {
+            interactivity->MouseWheel(modifiers, WHEEL_DELTA, mousePos, noMouseDown);
+        }
+        VERIFY_IS_TRUE(interactivity->HasPendingScroll());
+        VERIFY_ARE_EQUAL(18, reportedTop);
+        VERIFY_ARE_EQUAL(21, core->ScrollOffset());
+
+        Log::Comment(L"Flushing moves the viewport all the way at once");
+        interactivity->FlushPendingScroll();
+        VERIFY_IS_FALSE(interactivity->HasPendingScroll());
+        VERIFY_ARE_EQUAL(18, core->ScrollOffset());
+
+        Log::Comment(L"A click flushes the pending scroll first, so it lands on the rows on the screen");
+        interactivity->UpdateScrollbar(5);
+        VERIFY_IS_TRUE(interactivity->HasPendingScroll());
+        interactivity->PointerPressed(noMouseDown, WM_LBUTTONDOWN, 0, modifiers, mousePos);
+        VERIFY_IS_FALSE(interactivity->HasPendingScroll());
+        VERIFY_ARE_EQUAL(5, core->ScrollOffset());
+    }
 }
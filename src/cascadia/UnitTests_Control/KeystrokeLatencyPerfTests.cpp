@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class measures the time from a keystroke to the presentation of
+// the frame showing its echo ("keystroke to photon"), to catch latency
+// regressions in the input, output and rendering paths of the ControlCore.
+//
+// The keys are sent through ControlCore::SendCharEvent, the MockConnection
+// echoes them like the EchoConnection or `echokey` would, and the renderer's
+// frame presented callback tells us when the echo was on screen. This is done
+// once while the terminal is otherwise idle and once while it's flooded
+// with output, and the p50/p95/p99 latencies are logged:
+//   te.exe Control.Unit.Tests.dll /name:*KeystrokeLatencyPerfTests* /inproc
+
+#include "pch.h"
+#include "../TerminalControl/ControlCore.h"
+#include "MockControlSettings.h"
+#include "MockConnection.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace winrt;
+using namespace winrt::Microsoft::Terminal;
+
+namespace ControlUnitTests
+{
+    class KeystrokeLatencyPerfTests
+    {
+        BEGIN_TEST_CLASS(KeystrokeLatencyPerfTests)
+            TEST_CLASS_PROPERTY(L"TestTimeout", L"0:2:00")
+        END_TEST_CLASS()
+
+        // The number of keystrokes to measure per test.
+        static constexpr size_t Keystrokes = 500;
+        // How long to wait for the echo of a single keystroke before giving up.
+        static constexpr std::chrono::seconds EchoTimeout{ 5 };
+
+        TEST_CLASS_SETUP(ClassSetup)
+        {
+            winrt::init_apartment(winrt::apartment_type::single_threaded);
+            return true;
+        }
+
+        TEST_CLASS_CLEANUP(ClassCleanup)
+        {
+            winrt::uninit_apartment();
+            return true;
+        }
+
+        BEGIN_TEST_METHOD(KeystrokeToPresent)
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+            TEST_METHOD_PROPERTY(L"Data:flood", L"{false, true}")
+        END_TEST_METHOD()
+
+    private:
+        static void _LogPercentiles(const std::wstring_view condition, std::vector<double>& latencies);
+    };
+
+    // Routine Description:
+    // - Logs the p50, p95 and p99 of the given latencies.
+    // Arguments:
+    // - condition - What the terminal was doing while they were measured, for the log.
+    // - latencies - The latencies in microseconds. They're sorted in the process.
+    // Return Value:
+    // - <none>
+    void KeystrokeLatencyPerfTests::_LogPercentiles(const std::wstring_view condition, std::vector<double>& latencies)
+    {
+        VERIFY_IS_FALSE(latencies.empty());
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&](const size_t p) {
+            return latencies.at(std::min(latencies.size() - 1, latencies.size() * p / 100));
+        };
+
+        Log::Comment(String().Format(L"%.*s: %zu keystrokes, p50 %.1f us, p95 %.1f us, p99 %.1f us",
+                                     gsl::narrow_cast<int>(condition.size()),
+                                     condition.data(),
+                                     latencies.size(),
+                                     percentile(50),
+                                     percentile(95),
+                                     percentile(99)));
+    }
+
+    void KeystrokeLatencyPerfTests::KeystrokeToPresent()
+    {
+        bool flood = false;
+        VERIFY_SUCCEEDED(TestData::TryGetValue(L"flood", flood), L"Get flood variant");
+
+        auto settings = winrt::make_self<MockControlSettings>();
+        auto conn = winrt::make_self<MockConnection>();
+        settings->LowLatencyInput(true);
+
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        core->Initialize(270, 380, 1.0);
+        VERIFY_IS_TRUE(core->_initializedTerminal);
+        core->EnablePainting();
+
+        std::mutex presentedLock;
+        std::condition_variable presentedChanged;
+        uint64_t presented = 0;
+        core->_renderer->SetFramePresentedCallback([&](const uint64_t frame) {
+            {
+                std::lock_guard guard{ presentedLock };
+                presented = std::max(presented, frame);
+            }
+            presentedChanged.notify_all();
+        });
+
+        // The flood is written as if the connection produced it, so that
+        // the echoes have to queue up behind it, like they would behind the
+        // output of a busy build.
+        std::atomic<bool> flooding{ flood };
+        std::thread flooder;
+        if (flood)
+        {
+            flooder = std::thread([&]() {
+                const winrt::hstring noise{ L"\x1b[32mThe quick brown fox jumps over the lazy dog.\x1b[m 0123456789\r\n" };
+                while (flooding.load(std::memory_order_relaxed))
+                {
+                    core->_connectionOutputHandler(noise);
+                }
+            });
+        }
+        auto stopFlood = wil::scope_exit([&]() {
+            flooding.store(false, std::memory_order_relaxed);
+            if (flooder.joinable())
+            {
+                flooder.join();
+            }
+            core->_renderer->SetFramePresentedCallback(nullptr);
+        });
+
+        std::vector<double> latencies;
+        latencies.reserve(Keystrokes);
+
+        for (size_t i = 0; i < Keystrokes; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            core->SendCharEvent(gsl::narrow_cast<wchar_t>(L'a' + i % 26), 0, {});
+
+            // Once the echo was parsed, it's in every frame that starts from now on.
+            core->_waitForParsedOutput();
+            const auto written = core->_renderer->GetFrameCount();
+
+            std::unique_lock guard{ presentedLock };
+            VERIFY_IS_TRUE(presentedChanged.wait_for(guard, EchoTimeout, [&]() { return presented > written; }), L"The echo was presented");
+            latencies.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            guard.unlock();
+
+            if (!flood)
+            {
+                // Give the render thread a chance to go idle again, as it
+                // would between the keystrokes of someone typing.
+                Sleep(20);
+            }
+        }
+
+        _LogPercentiles(flood ? L"flood" : L"idle", latencies);
+    }
+}
@@ -76,6 +76,10 @@ namespace ControlUnitTests
         WINRT_PROPERTY(bool, RetroTerminalEffect, false);
         WINRT_PROPERTY(bool, ForceFullRepaintRendering, false);
         WINRT_PROPERTY(bool, SoftwareRendering, false);
+        WINRT_PROPERTY(winrt::hstring, RenderingAdapter);
+        WINRT_PROPERTY(bool, UseAtlasEngine, false);
+        WINRT_PROPERTY(bool, LowLatencyInput, false);
+        WINRT_PROPERTY(bool, BoostRenderPriority, false);
         WINRT_PROPERTY(bool, ForceVTInput, false);
 
         WINRT_PROPERTY(winrt::hstring, PixelShaderPath);
@@ -95,6 +95,7 @@ namespace RemotingUnitTests
         TYPED_EVENT(DisplayWindowIdRequested, winrt::Windows::Foundation::IInspectable, winrt::Windows::Foundation::IInspectable);
         TYPED_EVENT(RenameRequested, winrt::Windows::Foundation::IInspectable, Remoting::RenameRequestArgs);
         TYPED_EVENT(SummonRequested, winrt::Windows::Foundation::IInspectable, Remoting::SummonWindowBehavior);
+        TYPED_EVENT(WindowNameChanged, winrt::Windows::Foundation::IInspectable, winrt::hstring);
     };
 
     class RemotingTests
@@ -1263,9 +1264,8 @@ namespace RemotingUnitTests
 
     void RemotingTests::LookupNamedPeasantWhenOthersDied()
     {
-        Log::Comment(L"Test that looking for a peasant by name when a different"
-                     L" peasant has died cleans up the corpses of any peasants "
-                     L"we may have tripped over.");
+        Log::Comment(L"Test that looking for a peasant by name doesn't call "
+                     L"into any of the other peasants, even if they died.");
 
         const auto monarch0PID = 12345u;
         const auto peasant1PID = 23456u;
@@ -1300,18 +1300,18 @@ namespace RemotingUnitTests
         VERIFY_ARE_EQUAL(p1->GetID(), m0->_lookupPeasantIdForName(L"one"));
         VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"two"));
 
-        Log::Comment(L"Kill peasant 1. Make sure that it gets removed from the monarch.");
+        Log::Comment(L"Kill peasant 1. Looking for \"two\" shouldn't even notice.");
         RemotingTests::_killPeasant(m0, p1->GetID());
 
-        // By killing 1, then looking for "two", we happen to iterate over the
-        // corpse of 1 when looking for the peasant named "two". This causes us
-        // to remove 1 while looking for "two". Technically, we shouldn't be
-        // relying on any sort of ordering for an unordered_map iterator, but
-        // this one just so happens to work.
+        // The names are looked up in the monarch's own copy of them, so the
+        // corpse of 1 isn't called (which would throw) while looking for 2.
         VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"two"));
+        VERIFY_ARE_EQUAL(2u, m0->_peasants.size());
 
-        Log::Comment(L"Peasant 1 should have been pruned");
+        Log::Comment(L"Looking for peasant 1 itself should prune it");
+        VERIFY_ARE_EQUAL(0, m0->_lookupPeasantIdForName(L"one"));
         VERIFY_ARE_EQUAL(1u, m0->_peasants.size());
+        VERIFY_ARE_EQUAL(1u, m0->_peasantNames.size());
     }
 
     void RemotingTests::LookupNamedPeasantWhenItDied()
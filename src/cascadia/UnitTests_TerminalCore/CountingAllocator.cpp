@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// The allocations of this test module are counted by replacing the global
+// allocation functions, so that tests can assert on how many allocations
+// a code path makes. See TestUtils::AllocationCount(). They're also handed
+// to til::allocation_tracker, which tells the regions of the code apart.
+
+#include "pch.h"
+#include "TestUtils.h"
+
+#include <new.h>
+
+// The array, nothrow and sized variants all forward to these two.
+static std::atomic<size_t> s_allocations{ 0 };
+
+void* __cdecl operator new(size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    til::allocation_tracker::record(size);
+    for (;;)
+    {
+        if (const auto block = malloc(size ? size : 1))
+        {
+            return block;
+        }
+        if (_callnewh(size) == 0)
+        {
+            throw std::bad_alloc{};
+        }
+    }
+}
+
+void __cdecl operator delete(void* block) noexcept
+{
+    free(block);
+}
+
+size_t TerminalCoreUnitTests::TestUtils::AllocationCount() noexcept
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
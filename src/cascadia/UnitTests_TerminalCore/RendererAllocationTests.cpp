@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class makes sure that painting a frame of an unchanged buffer
+// doesn't allocate once the renderer is warmed up. The clusters, the row
+// segments and the pattern IDs are kept in buffers owned by the renderer,
+// which are reused from frame to frame.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "../renderer/base/Renderer.hpp"
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "TestUtils.h"
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace
+{
+    // An engine that paints every cell of the viewport on every frame, but
+    // doesn't draw anything, so that only the renderer's allocations are counted.
+    class MockPaintEngine final : public RenderEngineBase
+    {
+    public:
+        MockPaintEngine(const til::size size) :
+            _dirty{ size }
+        {
+        }
+
+        size_t PaintedClusters() const noexcept
+        {
+            return _paintedClusters;
+        }
+
+        [[nodiscard]] HRESULT StartPaint() noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT EndPaint() noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT Present() noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override
+        {
+            *pForcePaint = false;
+            return S_OK;
+        }
+
+        [[nodiscard]] HRESULT ScrollFrame() noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT InvalidateCursor(const SMALL_RECT* const) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT InvalidateSystem(const RECT* const) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>&) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT InvalidateScroll(const COORD* const) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT InvalidateAll() noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override
+        {
+            *pForcePaint = false;
+            return S_OK;
+        }
+
+        [[nodiscard]] HRESULT PaintBackground() noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                              const COORD,
+                                              const bool,
+                                              const bool) noexcept override
+        {
+            _paintedClusters += clusters.size();
+            return S_OK;
+        }
+
+        [[nodiscard]] HRESULT PaintBufferGridLines(const GridLines, const COLORREF, const size_t, const COORD) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT PaintCursor(const CursorOptions&) noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT UpdateDrawingBrushes(const TextAttribute&,
+                                                   const gsl::not_null<IRenderData*>,
+                                                   const bool) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired&, _Out_ FontInfo&) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT UpdateDpi(const int) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT) noexcept override { return S_OK; }
+        [[nodiscard]] HRESULT GetProposedFont(const FontInfoDesired&, _Out_ FontInfo&, const int) noexcept override { return S_OK; }
+
+        [[nodiscard]] HRESULT GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept override
+        {
+            area = { &_dirty, 1 };
+            return S_OK;
+        }
+
+        [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override
+        {
+            *pFontSize = { 1, 1 };
+            return S_OK;
+        }
+
+        [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view, _Out_ bool* const pResult) noexcept override
+        {
+            *pResult = false;
+            return S_OK;
+        }
+
+    protected:
+        [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring_view) noexcept override { return S_OK; }
+
+    private:
+        til::rectangle _dirty;
+        size_t _paintedClusters{ 0 };
+    };
+}
+
+namespace TerminalCoreUnitTests
+{
+    class RendererAllocationTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::RendererAllocationTests final
+{
+    static const SHORT TerminalViewWidth = 80;
+    static const SHORT TerminalViewHeight = 32;
+
+    TEST_CLASS(RendererAllocationTests);
+
+    TEST_METHOD(PaintingAnUnchangedFrameDoesNotAllocate);
+};
+
+void RendererAllocationTests::PaintingAnUnchangedFrameDoesNotAllocate()
+{
+    DummyRenderTarget renderTarget;
+    auto term = std::make_unique<Terminal>();
+    term->Create({ TerminalViewWidth, TerminalViewHeight }, 0, renderTarget);
+
+    // Fill the viewport with colored runs, wide glyphs and a URL, so that
+    // every path through _PaintBufferOutputHelper is taken.
+    for (SHORT y = 0; y < TerminalViewHeight - 1; ++y)
+    {
+        term->Write(L"\x1b[31mred\x1b[m \x1b[1;44mbold on blue\x1b[m \x3042\x3044\x3046 \xD83C\xDF11 https://example.com/path white\r\n");
+    }
+    {
+        auto lock = term->LockForWriting();
+        term->UpdatePatternsUnderLock();
+    }
+
+    MockPaintEngine engine{ { TerminalViewWidth, TerminalViewHeight } };
+    Renderer renderer{ term.get(), nullptr, 0, nullptr };
+    renderer.AddRenderEngine(&engine);
+
+    // The first frames size the renderer's buffers.
+    for (auto i = 0; i < 3; ++i)
+    {
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+    }
+
+    constexpr size_t frames = 10;
+    const auto paintedBefore = engine.PaintedClusters();
+    const auto allocationsBefore = TestUtils::AllocationCount();
+    const auto paintBefore = til::allocation_tracker::get(til::allocation_region::paint);
+    const auto presentBefore = til::allocation_tracker::get(til::allocation_region::present);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+    }
+    const auto allocations = TestUtils::AllocationCount() - allocationsBefore;
+    const auto paint = til::allocation_tracker::get(til::allocation_region::paint) - paintBefore;
+    const auto present = til::allocation_tracker::get(til::allocation_region::present) - presentBefore;
+
+    VERIFY_IS_GREATER_THAN(engine.PaintedClusters(), paintedBefore, L"The frames were painted");
+    VERIFY_ARE_EQUAL(size_t{ 0 }, allocations, L"Painting the frames didn't allocate");
+    VERIFY_ARE_EQUAL(size_t{ 0 }, paint.allocations, L"Nothing was counted towards painting");
+    VERIFY_ARE_EQUAL(size_t{ 0 }, present.allocations, L"Nothing was counted towards presenting");
+}
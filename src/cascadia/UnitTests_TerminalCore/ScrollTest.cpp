@@ -43,6 +43,7 @@ namespace
 
         virtual void TriggerRedraw(const Microsoft::Console::Types::Viewport&){};
         virtual void TriggerRedraw(const COORD* const){};
+        virtual void TriggerRedrawContent(const Microsoft::Console::Types::Viewport&){};
         virtual void TriggerRedrawCursor(const COORD* const){};
         virtual void TriggerRedrawAll(){};
         virtual void TriggerTeardown() noexcept {};
@@ -52,8 +53,10 @@ namespace
         {
             _triggerScrollDelta = { *delta };
         };
+        virtual void TriggerScrollRegion(const Microsoft::Console::Types::Viewport&, const SHORT){};
         virtual void TriggerCircling(){};
         void TriggerTitleChange(){};
+        void SetSynchronizedOutput(const bool){};
 
     private:
         std::optional<COORD> _triggerScrollDelta;
@@ -25,6 +25,7 @@ namespace TerminalCoreUnitTests
         TEST_CLASS(TerminalApiTest);
 
         TEST_METHOD(SetColorTableEntry);
+        TEST_METHOD(ColorChangesRedrawOncePerChunk);
 
         TEST_METHOD(CursorVisibility);
         TEST_METHOD(CursorVisibilityViaStateMachine);
@@ -38,9 +39,12 @@ namespace TerminalCoreUnitTests
         TEST_METHOD(AddHyperlink);
         TEST_METHOD(AddHyperlinkCustomId);
         TEST_METHOD(AddHyperlinkCustomIdDifferentUri);
+        TEST_METHOD(HoverIndexMatchesTheBuffer);
 
         TEST_METHOD(SetTaskbarProgress);
         TEST_METHOD(SetWorkingDirectory);
+
+        TEST_METHOD(SearchHighlightsFollowTheText);
     };
 };
 
@@ -63,6 +67,71 @@ void TerminalApiTest::SetColorTableEntry()
     VERIFY_IS_FALSE(term.SetColorTableEntry(512, 100));
 }
 
+// Counts the full redraws the terminal asks for.
+class RedrawCountingRenderTarget final : public Microsoft::Console::Render::IRenderTarget
+{
+public:
+    size_t redrawAllCount{ 0 };
+
+    void TriggerRedraw(const Microsoft::Console::Types::Viewport& /*region*/) override {}
+    void TriggerRedraw(const COORD* const /*pcoord*/) override {}
+    void TriggerRedrawContent(const Microsoft::Console::Types::Viewport& /*region*/) override {}
+    void TriggerRedrawCursor(const COORD* const /*pcoord*/) override {}
+    void TriggerRedrawAll() override { redrawAllCount++; }
+    void TriggerTeardown() noexcept override {}
+    void TriggerSelection() override {}
+    void TriggerScroll() override {}
+    void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
+    void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& /*region*/, const SHORT /*delta*/) override {}
+    void TriggerCircling() override {}
+    void TriggerTitleChange() override {}
+    void SetSynchronizedOutput(const bool /*enabled*/) override {}
+};
+
+void TerminalApiTest::ColorChangesRedrawOncePerChunk()
+{
+    Terminal term;
+    RedrawCountingRenderTarget renderTarget;
+    term.Create({ 100, 100 }, 0, renderTarget);
+
+    size_t backgroundCallbacks = 0;
+    til::color lastBackground;
+    term.SetBackgroundCallback([&](const til::color color) {
+        backgroundCallbacks++;
+        lastBackground = color;
+    });
+
+    Log::Comment(L"A whole palette in one chunk should be applied with a single redraw.");
+    std::wstring palette;
+    for (auto i = 0; i < 16; i++)
+    {
+        palette += fmt::format(L"\x1b]4;{};rgb:{:02x}/00/00\x1b\\", i, i * 16);
+    }
+    renderTarget.redrawAllCount = 0;
+    term.Write(palette);
+    VERIFY_ARE_EQUAL(1u, renderTarget.redrawAllCount);
+    VERIFY_ARE_EQUAL(0u, backgroundCallbacks);
+
+    Log::Comment(L"The background callback should only see the last color of the chunk.");
+    renderTarget.redrawAllCount = 0;
+    term.Write(L"\x1b]11;rgb:11/22/33\x1b\\\x1b]10;rgb:44/55/66\x1b\\\x1b]11;rgb:aa/bb/cc\x1b\\");
+    VERIFY_ARE_EQUAL(1u, renderTarget.redrawAllCount);
+    VERIFY_ARE_EQUAL(1u, backgroundCallbacks);
+    VERIFY_IS_TRUE(lastBackground == til::color{ 0xaa, 0xbb, 0xcc });
+    VERIFY_IS_TRUE(term.GetDefaultBackground() == til::color{ 0xaa, 0xbb, 0xcc });
+
+    Log::Comment(L"Output without color changes shouldn't redraw everything.");
+    renderTarget.redrawAllCount = 0;
+    term.Write(L"hello");
+    VERIFY_ARE_EQUAL(0u, renderTarget.redrawAllCount);
+
+    Log::Comment(L"Changes made outside of a chunk are still applied right away.");
+    VERIFY_IS_TRUE(term.SetDefaultBackground(RGB(1, 2, 3)));
+    VERIFY_ARE_EQUAL(1u, renderTarget.redrawAllCount);
+    VERIFY_ARE_EQUAL(2u, backgroundCallbacks);
+    VERIFY_IS_TRUE(lastBackground == til::color{ 1, 2, 3 });
+}
+
 // Terminal::_WriteBuffer used to enter infinite loops under certain conditions.
 // This test ensures that Terminal::_WriteBuffer doesn't get stuck when
 // PrintString() is called with more code units than the buffer width.
@@ -343,6 +412,40 @@ void TerminalCoreUnitTests::TerminalApiTest::AddHyperlinkCustomIdDifferentUri()
     VERIFY_ARE_NOT_EQUAL(oldAttributes.GetHyperlinkId(), tbi.GetCurrentAttributes().GetHyperlinkId());
 }
 
+void TerminalCoreUnitTests::TerminalApiTest::HoverIndexMatchesTheBuffer()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 100, 100 }, 0, emptyRT);
+
+    auto& stateMachine = *(term._stateMachine);
+    stateMachine.ProcessString(L"abc\x1b]8;;test.url\x9cHello\x1b]8;;\x9c World\r\n");
+    stateMachine.ProcessString(L"\x1b]8;;other.url\x9cWorld\x1b]8;;\x9c");
+
+    // Nothing is published until the patterns are updated.
+    VERIFY_IS_NULL(term.GetHoverIndex().get());
+
+    term.UpdatePatternsUnderLock();
+    const auto hoverIndex = term.GetHoverIndex();
+    VERIFY_IS_NOT_NULL(hoverIndex.get());
+    for (auto y = 0; y < 3; ++y)
+    {
+        for (auto x = 0; x < 12; ++x)
+        {
+            const til::point position{ x, y };
+            VERIFY_ARE_EQUAL(term.GetHyperlinkIdAtPosition(position), hoverIndex->GetHyperlinkIdAtPosition(position));
+        }
+    }
+    VERIFY_ARE_NOT_EQUAL(uint16_t{ 0 }, hoverIndex->GetHyperlinkIdAtPosition(til::point{ 3, 0 }));
+    VERIFY_ARE_EQUAL(uint16_t{ 0 }, hoverIndex->GetHyperlinkIdAtPosition(til::point{ 8, 0 }));
+    VERIFY_ARE_NOT_EQUAL(hoverIndex->GetHyperlinkIdAtPosition(til::point{ 3, 0 }), hoverIndex->GetHyperlinkIdAtPosition(til::point{ 0, 1 }));
+    VERIFY_IS_FALSE(hoverIndex->GetHyperlinkIntervalFromPosition(til::point{ 3, 0 }).has_value());
+
+    // Once the viewport moves, the snapshot is withdrawn until the next update.
+    term.ClearPatternTree();
+    VERIFY_IS_NULL(term.GetHoverIndex().get());
+}
+
 void TerminalCoreUnitTests::TerminalApiTest::SetTaskbarProgress()
 {
     Terminal term;
@@ -469,3 +572,35 @@ void TerminalCoreUnitTests::TerminalApiTest::SetWorkingDirectory()
     stateMachine.ProcessString(L"\x1b]9;9;\"\"\"\"\x9c");
     VERIFY_ARE_EQUAL(term.GetWorkingDirectory(), L"\"\"");
 }
+
+void TerminalApiTest::SearchHighlightsFollowTheText()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 10, 5 }, 0, renderTarget);
+
+    Log::Comment(L"A match that wraps is highlighted on both of its rows.");
+    term.SetSearchHighlights({ { { 2, 1 }, { 4, 1 } }, { { 8, 3 }, { 1, 4 } } });
+    auto rects = term.GetSearchHighlightRects();
+    VERIFY_ARE_EQUAL(3u, rects.size());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 2, 1, 4, 1 }), rects.at(0).ToInclusive());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 8, 3, 9, 3 }), rects.at(1).ToInclusive());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 4, 1, 4 }), rects.at(2).ToInclusive());
+
+    Log::Comment(L"Circling the buffer takes the highlights along with the text.");
+    VERIFY_IS_TRUE(term._buffer->IncrementCircularBuffer());
+    rects = term.GetSearchHighlightRects();
+    VERIFY_ARE_EQUAL(3u, rects.size());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 2, 0, 4, 0 }), rects.at(0).ToInclusive());
+
+    Log::Comment(L"A match that left the buffer isn't highlighted anymore, one that partially did is cut off.");
+    VERIFY_IS_TRUE(term._buffer->IncrementCircularBuffer());
+    VERIFY_IS_TRUE(term._buffer->IncrementCircularBuffer());
+    VERIFY_IS_TRUE(term._buffer->IncrementCircularBuffer());
+    rects = term.GetSearchHighlightRects();
+    VERIFY_ARE_EQUAL(1u, rects.size());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 0, 1, 0 }), rects.at(0).ToInclusive());
+
+    term.ClearSearchHighlights();
+    VERIFY_IS_TRUE(term.GetSearchHighlightRects().empty());
+}
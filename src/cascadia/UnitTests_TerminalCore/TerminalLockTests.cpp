@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace Microsoft::Terminal::Core;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+
+namespace TerminalCoreUnitTests
+{
+    class TerminalLockTests
+    {
+        TEST_CLASS(TerminalLockTests);
+
+        TEST_METHOD(NothingIsRecordedUntilProfiling);
+        TEST_METHOD(HoldsAreRecorded);
+        TEST_METHOD(LongHoldsAreReported);
+        TEST_METHOD(HistoryKeepsTheLastHolds);
+
+        static bool _HasTag(const TerminalLock::Hold& hold, const std::string_view tag)
+        {
+            return hold.tag && tag == hold.tag;
+        }
+    };
+}
+
+using namespace TerminalCoreUnitTests;
+
+void TerminalLockTests::NothingIsRecordedUntilProfiling()
+{
+    Terminal term;
+    {
+        auto lock = term.LockForWriting("write");
+    }
+    {
+        auto lock = term.LockForReading("read");
+    }
+    VERIFY_ARE_EQUAL(0u, term.GetLock().GetHistory().size());
+}
+
+void TerminalLockTests::HoldsAreRecorded()
+{
+    Terminal term;
+    term.GetLock().EnableProfiling(std::chrono::hours{ 1 }, nullptr);
+    {
+        auto lock = term.LockForWriting("write");
+    }
+    {
+        auto lock = term.LockForReading("read");
+    }
+    term.LockConsole();
+    term.UnlockConsole();
+    {
+        std::unique_lock<TerminalLock> lock{ term.GetLock(), std::try_to_lock };
+        VERIFY_IS_TRUE(lock.owns_lock());
+    }
+
+    const auto history = term.GetLock().GetHistory();
+    VERIFY_ARE_EQUAL(4u, history.size());
+    VERIFY_IS_TRUE(_HasTag(history[0], "write"));
+    VERIFY_IS_TRUE(history[0].exclusive);
+    VERIFY_IS_NOT_NULL(history[0].caller);
+    VERIFY_ARE_EQUAL(GetCurrentThreadId(), history[0].threadId);
+    VERIFY_IS_TRUE(_HasTag(history[1], "read"));
+    VERIFY_IS_FALSE(history[1].exclusive);
+    VERIFY_IS_TRUE(_HasTag(history[2], "LockConsole"));
+    VERIFY_IS_NULL(history[3].tag);
+    VERIFY_IS_TRUE(history[3].exclusive);
+}
+
+void TerminalLockTests::LongHoldsAreReported()
+{
+    Terminal term;
+    std::vector<TerminalLock::Hold> reported;
+    term.GetLock().EnableProfiling(std::chrono::milliseconds{ 20 }, [&](const TerminalLock::Hold& hold) {
+        reported.emplace_back(hold);
+    });
+
+    {
+        auto lock = term.LockForReading("short");
+    }
+    VERIFY_ARE_EQUAL(0u, reported.size());
+
+    Log::Comment(L"The writer has to wait for the reader on the other thread to let go.");
+    wil::slim_event_manual_reset locked;
+    std::thread reader{ [&]() {
+        auto lock = term.LockForReading("long");
+        locked.SetEvent();
+        Sleep(50);
+    } };
+    locked.wait();
+    {
+        auto lock = term.LockForWriting("waiting");
+    }
+    reader.join();
+
+    Log::Comment(L"Both threads let go of the lock before they record, in either order.");
+    VERIFY_ARE_EQUAL(2u, reported.size());
+    const auto readerFirst = _HasTag(reported[0], "long");
+    const auto& longHold = reported[readerFirst ? 0 : 1];
+    const auto& longWait = reported[readerFirst ? 1 : 0];
+    VERIFY_IS_TRUE(_HasTag(longHold, "long"));
+    VERIFY_IS_TRUE(longHold.hold >= std::chrono::milliseconds{ 20 });
+    VERIFY_IS_TRUE(_HasTag(longWait, "waiting"));
+    VERIFY_IS_TRUE(longWait.wait >= std::chrono::milliseconds{ 20 });
+}
+
+void TerminalLockTests::HistoryKeepsTheLastHolds()
+{
+    Terminal term;
+    term.GetLock().EnableProfiling(std::chrono::hours{ 1 }, nullptr);
+    for (size_t i = 0; i < TerminalLock::HistorySize + 10; ++i)
+    {
+        auto lock = term.LockForWriting(i < 10 ? "old" : "new");
+    }
+
+    const auto history = term.GetLock().GetHistory();
+    VERIFY_ARE_EQUAL(TerminalLock::HistorySize, history.size());
+    for (const auto& hold : history)
+    {
+        VERIFY_IS_TRUE(_HasTag(hold, "new"));
+    }
+
+    Log::Comment(L"Nothing is added once profiling is off again.");
+    term.GetLock().DisableProfiling();
+    {
+        auto lock = term.LockForWriting("off");
+    }
+    VERIFY_IS_TRUE(_HasTag(term.GetLock().GetHistory().back(), "new"));
+}
@@ -25,6 +25,16 @@ public:
         LR"(!"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_`abcdefghijklmnopqrstuvwxyz{|}~!"#$%&)"
     };
 
+    // Function Description:
+    // - Returns the number of allocations this test module made so far. The
+    //   global allocation functions are replaced in CountingAllocator.cpp to
+    //   count them.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The number of calls to operator new since the module was loaded.
+    static size_t AllocationCount() noexcept;
+
     // Function Description:
     // - Helper function to validate that a number of characters in a row are all
     //   the same. Validates that the next end-start characters are all equal to the
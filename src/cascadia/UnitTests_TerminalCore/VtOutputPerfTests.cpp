@@ -0,0 +1,444 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class replays captures of typical terminal output through both
+// output paths: the conhost one (StateMachine -> OutputStateMachineEngine ->
+// AdaptDispatch -> SCREEN_INFORMATION) and the Terminal one (StateMachine ->
+// OutputStateMachineEngine -> TerminalDispatch -> Terminal). For each of them
+// it logs the throughput, the number of allocations and the 99th percentile
+// latency of processing a single chunk.
+//
+// The built-in captures are generated, so that they're the same on every
+// machine. Recorded captures (for instance made with `script`) can be added by
+// pointing the tests at a directory of UTF-8 files:
+//   te.exe Terminal.Core.Unit.Tests.dll /name:*VtOutputPerfTests* /p:VtCaptureDirectory=c:\captures
+// The directory can also hold the binary captures written by the capture mode
+// of the debug tap (see DebugCapture.h), whose output records are replayed,
+// or the slow inputs saved by the throughput mode of the conhost fuzzer
+// (see host/ft_fuzzer/fuzzmain.cpp).
+
+#include "pch.h"
+#include "../../types/inc/Viewport.hpp"
+
+#include "../renderer/inc/DummyRenderTarget.hpp"
+
+class InputBuffer; // This for some reason needs to be fwd-decl'd
+#include "../host/inputBuffer.hpp"
+#include "test/CommonState.hpp"
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/inc/DebugCapture.h"
+#include "TestUtils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Console::Interactivity;
+
+using namespace Microsoft::Terminal::Core;
+
+namespace TerminalCoreUnitTests
+{
+    class VtOutputPerfTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::VtOutputPerfTests final
+{
+    static constexpr SHORT ViewWidth = 120;
+    static constexpr SHORT ViewHeight = 30;
+    static constexpr SHORT BufferHeight = 1000;
+
+    // Roughly the size of a single read from the conpty pipe.
+    static constexpr size_t ChunkSize = 4096;
+    // Every capture is replayed until at least this much text was processed.
+    static constexpr size_t TotalBytes = 32 * 1024 * 1024;
+
+    TEST_CLASS(VtOutputPerfTests);
+
+    TEST_CLASS_SETUP(ClassSetup)
+    {
+        m_state = std::make_unique<CommonState>();
+
+        m_state->InitEvents();
+        m_state->PrepareGlobalFont();
+        m_state->PrepareGlobalScreenBuffer(ViewWidth, ViewHeight, ViewWidth, BufferHeight);
+        m_state->PrepareGlobalInputBuffer();
+
+        return true;
+    }
+
+    TEST_CLASS_CLEANUP(ClassCleanup)
+    {
+        m_state->CleanupGlobalScreenBuffer();
+        m_state->CleanupGlobalFont();
+        m_state->CleanupGlobalInputBuffer();
+
+        m_state.reset();
+
+        return true;
+    }
+
+    BEGIN_TEST_METHOD(ConhostThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Data:capture", L"{cat, ls, vim, htop, unicode}")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(TerminalThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Data:capture", L"{cat, ls, vim, htop, unicode}")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(RecordedCapturesThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD()
+
+private:
+    static std::wstring _GetCapture(const std::wstring_view name);
+    static std::wstring _GenerateCat();
+    static std::wstring _GenerateLs();
+    static std::wstring _GenerateVim();
+    static std::wstring _GenerateHtop();
+    static std::wstring _GenerateUnicode();
+
+    static void _Replay(const std::wstring_view target,
+                        const std::wstring_view capture,
+                        const std::function<void(std::wstring_view)>& write);
+    void _ReplayThroughConhost(const std::wstring_view name, const std::wstring_view capture);
+    void _ReplayThroughTerminal(const std::wstring_view name, const std::wstring_view capture);
+
+    std::unique_ptr<CommonState> m_state;
+};
+
+// Routine Description:
+// - Feeds the capture through the given write function in ChunkSize pieces,
+//   over and over, until TotalBytes worth of UTF-16 text has been processed.
+//   Logs the throughput, the allocations per MB and the p99 chunk latency.
+// Arguments:
+// - target - The name of the output path, for the log.
+// - capture - The text to replay.
+// - write - Processes a single chunk of the capture.
+// Return Value:
+// - <none>
+void VtOutputPerfTests::_Replay(const std::wstring_view target,
+                                const std::wstring_view capture,
+                                const std::function<void(std::wstring_view)>& write)
+{
+    VERIFY_IS_FALSE(capture.empty());
+
+    const auto iterations = std::max<size_t>(1, TotalBytes / (capture.size() * sizeof(wchar_t)));
+    std::vector<double> latencies;
+    latencies.reserve(iterations * (capture.size() / ChunkSize + 1));
+
+    const auto allocationsBefore = TestUtils::AllocationCount();
+    const auto parseBefore = til::allocation_tracker::get(til::allocation_region::parse);
+    const auto bufferWriteBefore = til::allocation_tracker::get(til::allocation_region::buffer_write);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (size_t offset = 0; offset < capture.size(); offset += ChunkSize)
+        {
+            const auto chunkStart = std::chrono::steady_clock::now();
+            write(capture.substr(offset, ChunkSize));
+            latencies.emplace_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - chunkStart).count());
+        }
+    }
+    const auto delta = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto allocations = TestUtils::AllocationCount() - allocationsBefore;
+    const auto parse = til::allocation_tracker::get(til::allocation_region::parse) - parseBefore;
+    const auto bufferWrite = til::allocation_tracker::get(til::allocation_region::buffer_write) - bufferWriteBefore;
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto p99 = latencies.at(std::min(latencies.size() - 1, latencies.size() * 99 / 100));
+
+    const auto megabytes = static_cast<double>(iterations * capture.size() * sizeof(wchar_t)) / (1024 * 1024);
+    Log::Comment(String().Format(L"%.*s: %.1f MB in %.3f s: %.1f MB/s, %.1f allocations/MB, p99 latency %.1f us per %zu chars",
+                                 gsl::narrow_cast<int>(target.size()),
+                                 target.data(),
+                                 megabytes,
+                                 delta,
+                                 delta > 0 ? megabytes / delta : 0.0,
+                                 static_cast<double>(allocations) / megabytes,
+                                 p99,
+                                 ChunkSize));
+    Log::Comment(String().Format(L"%.1f allocations/MB (%.1f KB/MB) while parsing, %.1f allocations/MB (%.1f KB/MB) while writing to the buffer",
+                                 static_cast<double>(parse.allocations) / megabytes,
+                                 static_cast<double>(parse.bytes) / 1024 / megabytes,
+                                 static_cast<double>(bufferWrite.allocations) / megabytes,
+                                 static_cast<double>(bufferWrite.bytes) / 1024 / megabytes));
+}
+
+// Routine Description:
+// - Replays the capture into the global conhost screen buffer.
+// Arguments:
+// - name - The name of the capture, for the log.
+// - capture - The text to replay.
+// Return Value:
+// - <none>
+void VtOutputPerfTests::_ReplayThroughConhost(const std::wstring_view name, const std::wstring_view capture)
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.SetDefaultForegroundColor(INVALID_COLOR);
+    gci.SetDefaultBackgroundColor(INVALID_COLOR);
+    gci.SetFillAttribute(0x07); // DARK_WHITE on DARK_BLACK
+
+    m_state->PrepareNewTextBufferInfo(true, ViewWidth, BufferHeight);
+    auto& si = gci.GetActiveOutputBuffer();
+    VERIFY_SUCCEEDED(si.SetViewportOrigin(true, { 0, 0 }, true));
+    auto& stateMachine = si.GetStateMachine();
+
+    _Replay(fmt::format(L"conhost/{}", name), capture, [&](const std::wstring_view chunk) {
+        stateMachine.ProcessString(chunk);
+    });
+
+    m_state->CleanupNewTextBufferInfo();
+}
+
+// Routine Description:
+// - Replays the capture into a new Terminal.
+// Arguments:
+// - name - The name of the capture, for the log.
+// - capture - The text to replay.
+// Return Value:
+// - <none>
+void VtOutputPerfTests::_ReplayThroughTerminal(const std::wstring_view name, const std::wstring_view capture)
+{
+    DummyRenderTarget emptyRT;
+    Terminal term;
+    term.Create({ ViewWidth, ViewHeight }, BufferHeight - ViewHeight, emptyRT);
+
+    _Replay(fmt::format(L"Terminal/{}", name), capture, [&](const std::wstring_view chunk) {
+        term.Write(chunk);
+    });
+}
+
+void VtOutputPerfTests::ConhostThroughput()
+{
+    String capture;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"capture", capture));
+
+    _ReplayThroughConhost(capture.GetBuffer(), _GetCapture(capture.GetBuffer()));
+}
+
+void VtOutputPerfTests::TerminalThroughput()
+{
+    String capture;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"capture", capture));
+
+    _ReplayThroughTerminal(capture.GetBuffer(), _GetCapture(capture.GetBuffer()));
+}
+
+void VtOutputPerfTests::RecordedCapturesThroughput()
+{
+    String directory;
+    if (FAILED(RuntimeParameters::TryGetValue(L"VtCaptureDirectory", directory)) || directory.IsEmpty())
+    {
+        Log::Result(TestResults::Skipped, L"Pass /p:VtCaptureDirectory=<path> to replay recorded captures.");
+        return;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator{ std::wstring_view{ directory.GetBuffer() } })
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        std::ifstream file{ entry.path(), std::ios::binary };
+        const std::string bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        std::wstring capture;
+        if (::Microsoft::Terminal::DebugCapture::IsCapture(bytes))
+        {
+            const auto valid = ::Microsoft::Terminal::DebugCapture::ReadRecords(bytes, [&](const auto kind, const auto /*timestamp*/, const std::wstring_view text) {
+                if (kind == ::Microsoft::Terminal::DebugCapture::RecordKind::Output)
+                {
+                    capture.append(text);
+                }
+            });
+            if (!valid)
+            {
+                Log::Warning(String().Format(L"%s is truncated, only replaying what could be read", entry.path().c_str()));
+            }
+        }
+        else
+        {
+            VERIFY_SUCCEEDED(til::u8u16(bytes, capture));
+        }
+        if (capture.empty())
+        {
+            continue;
+        }
+
+        const auto name = entry.path().filename().wstring();
+        _ReplayThroughConhost(name, capture);
+        _ReplayThroughTerminal(name, capture);
+    }
+}
+
+// Routine Description:
+// - Returns the built-in capture with the given name.
+// Arguments:
+// - name - One of the names in the "capture" test data.
+// Return Value:
+// - The capture.
+std::wstring VtOutputPerfTests::_GetCapture(const std::wstring_view name)
+{
+    if (name == L"cat")
+    {
+        return _GenerateCat();
+    }
+    if (name == L"ls")
+    {
+        return _GenerateLs();
+    }
+    if (name == L"vim")
+    {
+        return _GenerateVim();
+    }
+    if (name == L"htop")
+    {
+        return _GenerateHtop();
+    }
+    if (name == L"unicode")
+    {
+        return _GenerateUnicode();
+    }
+    VERIFY_FAIL(L"Unknown capture");
+    return {};
+}
+
+// Routine Description:
+// - `cat` of a large source file: plain ASCII lines of varying length,
+//   indented, with the occasional tab and empty line.
+std::wstring VtOutputPerfTests::_GenerateCat()
+{
+    static constexpr std::array<std::wstring_view, 6> lines{
+        L"#include \"precomp.h\"",
+        L"void StateMachine::ProcessString(const std::wstring_view string)",
+        L"    // Skip over every printable char in one go. They all belong to the current run.",
+        L"        current = _findActionableFromGround(string, current);",
+        L"\tif (success && !_cachedSequence.empty())",
+        L"",
+    };
+
+    std::wstring capture;
+    for (size_t i = 0; capture.size() < 256 * 1024; ++i)
+    {
+        capture.append(til::at(lines, (i * 7) % lines.size()));
+        capture.append(L"\r\n");
+    }
+    return capture;
+}
+
+// Routine Description:
+// - `ls --color`: short file names in columns, every one of them wrapped in
+//   its own color (directories, executables, archives, links).
+std::wstring VtOutputPerfTests::_GenerateLs()
+{
+    static constexpr std::array<std::wstring_view, 5> colors{
+        L"\x1b[0m",
+        L"\x1b[01;34m",
+        L"\x1b[01;32m",
+        L"\x1b[01;31m",
+        L"\x1b[01;36m",
+    };
+
+    std::wstring capture;
+    for (size_t i = 0; capture.size() < 256 * 1024; ++i)
+    {
+        capture.append(til::at(colors, i % colors.size()));
+        capture.append(fmt::format(L"file_{:04}.txt", i));
+        capture.append(L"\x1b[0m");
+        capture.append(i % 6 == 5 ? L"\r\n" : L"  ");
+    }
+    return capture;
+}
+
+// Routine Description:
+// - `vim` redrawing the screen while scrolling through a file: the cursor is
+//   hidden, every line is positioned absolutely, syntax highlighted and
+//   erased to the end, and the status line is drawn in reverse video.
+std::wstring VtOutputPerfTests::_GenerateVim()
+{
+    std::wstring capture;
+    for (size_t frame = 0; capture.size() < 256 * 1024; ++frame)
+    {
+        capture.append(L"\x1b[?25l\x1b[H");
+        for (SHORT row = 1; row < ViewHeight; ++row)
+        {
+            const auto line = frame + row;
+            capture.append(fmt::format(L"\x1b[{};1H\x1b[33m{:5} \x1b[m", row, line));
+            capture.append(fmt::format(L"\x1b[38;5;81mif\x1b[m (\x1b[38;5;186mvalue_{}\x1b[m == \x1b[38;5;141m{}\x1b[m)", line % 13, line));
+            capture.append(L" \x1b[38;5;244m// compare against the line number\x1b[m\x1b[K");
+        }
+        capture.append(fmt::format(L"\x1b[{};1H\x1b[7m stateMachine.cpp  line {}  \x1b[m\x1b[K", ViewHeight, frame));
+        capture.append(fmt::format(L"\x1b[{};7H\x1b[?25h", (frame % (ViewHeight - 1)) + 1));
+    }
+    return capture;
+}
+
+// Routine Description:
+// - `htop` refreshing: meter bars made of colored runs, a process table with
+//   a highlighted row, and lots of cursor positioning and 256-color SGRs.
+std::wstring VtOutputPerfTests::_GenerateHtop()
+{
+    std::wstring capture;
+    for (size_t frame = 0; capture.size() < 256 * 1024; ++frame)
+    {
+        for (SHORT cpu = 0; cpu < 4; ++cpu)
+        {
+            const auto used = (frame * 7 + cpu * 13) % 40;
+            capture.append(fmt::format(L"\x1b[{};3H\x1b[36m{}\x1b[1;39m[\x1b[32m", cpu + 1, cpu));
+            capture.append(used / 2, L'|');
+            capture.append(L"\x1b[31m");
+            capture.append(used - used / 2, L'|');
+            capture.append(40 - used, L' ');
+            capture.append(fmt::format(L"\x1b[37m{:5.1f}%\x1b[1;39m]\x1b[m", used * 2.5));
+        }
+        capture.append(L"\x1b[6;1H\x1b[30;42m  PID USER      PRI  NI  VIRT   RES   SHR S CPU% MEM%   TIME+  Command\x1b[K\x1b[m");
+        for (SHORT row = 7; row < ViewHeight; ++row)
+        {
+            const auto pid = 1000 + (frame + row) % 97;
+            const auto selected = row == 7 + static_cast<SHORT>(frame % (ViewHeight - 7));
+            capture.append(fmt::format(L"\x1b[{};1H{}", row, selected ? L"\x1b[30;46m" : L"\x1b[m"));
+            capture.append(fmt::format(L"{:5} user       20   0 \x1b[38;5;81m{:5}M\x1b[39m {:5} {:5} S {:4.1f} {:4.1f}  0:{:02}.{:02} ",
+                                       pid,
+                                       pid % 512,
+                                       pid % 300,
+                                       pid % 200,
+                                       (pid % 17) / 2.0,
+                                       (pid % 11) / 3.0,
+                                       pid % 60,
+                                       frame % 100));
+            capture.append(fmt::format(L"\x1b[1;32m/usr/bin/process\x1b[m{} --worker {}\x1b[K", selected ? L"\x1b[30;46m" : L"", row));
+        }
+    }
+    return capture;
+}
+
+// Routine Description:
+// - Unicode-heavy text: CJK (wide glyphs), emoji (surrogate pairs),
+//   combining marks, box drawing and accented Latin text.
+std::wstring VtOutputPerfTests::_GenerateUnicode()
+{
+    static constexpr std::array<std::wstring_view, 5> lines{
+        L"\u65e5\u672c\u8a9e\u306e\u30c6\u30ad\u30b9\u30c8\u3068\u4e2d\u6587\u6587\u672c\u548c\ud55c\uad6d\uc5b4",
+        L"\U0001F600\U0001F680\U0001F4BB emoji \U0001F44D\U0001F3FD and flags \U0001F1FA\U0001F1F8",
+        L"e\u0301 a\u0300 o\u0302 n\u0303 u\u0308 combining marks on every letter",
+        L"\u250c\u2500\u2500\u2500\u2500\u252c\u2500\u2500\u2500\u2500\u2510 \u2502 box \u2502 drawing \u2502",
+        L"Fran\u00e7ais, \u0420\u0443\u0441\u0441\u043a\u0438\u0439, \u0395\u03bb\u03bb\u03b7\u03bd\u03b9\u03ba\u03ac, \u05e2\u05d1\u05e8\u05d9\u05ea",
+    };
+
+    std::wstring capture;
+    for (size_t i = 0; capture.size() < 256 * 1024; ++i)
+    {
+        capture.append(til::at(lines, i % lines.size()));
+        capture.append(L"\r\n");
+    }
+    return capture;
+}
@@ -25,12 +25,20 @@ using namespace ::Microsoft::Console::Types;
 static constexpr short KeyPressed{ gsl::narrow_cast<short>(0x8000) };
 
 AppHost::AppHost() noexcept :
-    _app{},
+    _app{ nullptr },
     _windowManager{},
     _logic{ nullptr }, // don't make one, we're going to take a ref on app's
     _window{ nullptr }
 {
-    _logic = _app.Logic(); // get a ref to app's logic
+    // Creating the App initializes XAML for this thread, and the AppLogic
+    // creates a TerminalPage. That's a waste for the processes that only hand
+    // their commandline over to an existing window (e.g. `wt -w 0 nt`), so
+    // they're only created once we know we'll need them. The monarch needs
+    // its AppLogic to find the target window of its own commandline, though.
+    if (_windowManager.IsMonarch())
+    {
+        _CreateApp();
+    }
 
     // Inform the WindowManager that it can use us to find the target window for
     // a set of commandline args. This needs to be done before
@@ -92,8 +100,26 @@ AppHost::~AppHost()
     // destruction order is important for proper teardown here
 
     _window = nullptr;
-    _app.Close();
-    _app = nullptr;
+    if (_app)
+    {
+        _app.Close();
+        _app = nullptr;
+    }
+}
+
+// Method Description:
+// - Creates the App and gets a ref to its AppLogic, if that hasn't happened yet.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void AppHost::_CreateApp()
+{
+    if (!_app)
+    {
+        _app = winrt::TerminalApp::App{};
+        _logic = _app.Logic(); // get a ref to app's logic
+    }
 }
 
 bool AppHost::OnDirectKeyEvent(const uint32_t vkey, const uint8_t scanCode, const bool down)
@@ -176,6 +202,8 @@ void AppHost::_HandleCommandlineArgs()
         return;
     }
 
+    _CreateApp();
+
     if (auto peasant{ _windowManager.CurrentWindow() })
     {
         if (auto args{ peasant.InitialArgs() })
@@ -247,6 +275,9 @@ void AppHost::Initialize()
     // tabs opened, this is consistent with Alt+F4 closing
     _window->WindowCloseButtonClicked([this]() { _logic.WindowCloseButtonClicked(); });
 
+    // GH#1989: Stop rendering while the window is minimized or cloaked.
+    _window->WindowVisibilityChanged([this](bool showOrHide) { _logic.WindowVisibilityChanged(showOrHide); });
+
     // Add an event handler to plumb clicks in the titlebar area down to the
     // application layer.
     _window->DragRegionClicked([this]() { _logic.TitlebarClicked(); });
@@ -614,6 +645,12 @@ void AppHost::_DispatchCommandline(winrt::Windows::Foundation::IInspectable send
 void AppHost::_FindTargetWindow(const winrt::Windows::Foundation::IInspectable& /*sender*/,
                                 const Remoting::FindTargetWindowArgs& args)
 {
+    // Only the monarch is asked to find target windows, and it always has an AppLogic.
+    if (!_logic)
+    {
+        return;
+    }
+
     const auto targetWindow = _logic.FindTargetWindow(args.Args().Commandline());
     args.ResultTargetWindow(targetWindow.WindowId());
     args.ResultTargetWindowName(targetWindow.WindowName());
@@ -33,6 +33,7 @@ private:
 
     winrt::com_ptr<IVirtualDesktopManager> _desktopManager{ nullptr };
 
+    void _CreateApp();
     void _HandleCommandlineArgs();
 
     void _HandleCreateWindow(const HWND hwnd, RECT proposedRect, winrt::Microsoft::Terminal::Settings::Model::LaunchMode& launchMode);
@@ -307,6 +307,16 @@ void IslandWindow::Initialize()
             _taskbar = std::move(taskbar);
         }
     }
+
+    // GH#1989: Listen for our window being cloaked, so we can stop rendering.
+    _cloakedHook.reset(SetWinEventHook(EVENT_OBJECT_CLOAKED,
+                                       EVENT_OBJECT_UNCLOAKED,
+                                       nullptr,
+                                       _cloakedWinEventProc,
+                                       GetCurrentProcessId(),
+                                       GetCurrentThreadId(),
+                                       WINEVENT_OUTOFCONTEXT));
+    LOG_LAST_ERROR_IF(!_cloakedHook);
 }
 
 void IslandWindow::OnSize(const UINT width, const UINT height)
@@ -506,6 +516,18 @@ long IslandWindow::_calculateTotalSize(const bool isWidth, const long clientSize
     case WM_THEMECHANGED:
         UpdateWindowIconForActiveMetrics(_window.get());
         return 0;
+    case WM_SETTINGCHANGE:
+        // The user or system environment variables changed. New tabs should
+        // see them, so the connections have to build their environment again.
+        if (lparam && std::wstring_view{ reinterpret_cast<const wchar_t*>(lparam) } == L"Environment")
+        {
+            try
+            {
+                winrt::Microsoft::Terminal::TerminalConnection::ConptyConnection::ReloadEnvironmentVariables();
+            }
+            CATCH_LOG();
+        }
+        break;
     }
 
     // TODO: handle messages here...
@@ -529,14 +551,52 @@ void IslandWindow::OnResize(const UINT width, const UINT height)
 // - Called when the window is minimized to the taskbar.
 void IslandWindow::OnMinimize()
 {
-    // TODO GH#1989 Stop rendering island content when the app is minimized.
+    // GH#1989 Stop rendering island content when the app is minimized.
+    _updateWindowVisibility(_cloaked);
 }
 
 // Method Description:
 // - Called when the window is restored from having been minimized.
 void IslandWindow::OnRestore()
 {
-    // TODO GH#1989 Stop rendering island content when the app is minimized.
+    _updateWindowVisibility(_cloaked);
+}
+
+// Method Description:
+// - The WinEvent callback for EVENT_OBJECT_CLOAKED and EVENT_OBJECT_UNCLOAKED.
+//   It's called for all windows of this thread, so we have to make sure
+//   it's about one of ours before we go looking for the IslandWindow.
+void CALLBACK IslandWindow::_cloakedWinEventProc(HWINEVENTHOOK /*hook*/, DWORD event, HWND hwnd, LONG idObject, LONG /*idChild*/, DWORD /*idEventThread*/, DWORD /*dwmsEventTime*/)
+{
+    if (idObject != OBJID_WINDOW || !hwnd)
+    {
+        return;
+    }
+
+    wchar_t className[ARRAYSIZE(XAML_HOSTING_WINDOW_CLASS_NAME)]{};
+    if (GetClassNameW(hwnd, &className[0], ARRAYSIZE(className)) == 0 ||
+        std::wstring_view{ &className[0] } != XAML_HOSTING_WINDOW_CLASS_NAME)
+    {
+        return;
+    }
+
+    if (auto window = GetThisFromHandle(hwnd))
+    {
+        window->_updateWindowVisibility(event == EVENT_OBJECT_CLOAKED);
+    }
+}
+
+// Method Description:
+// - Informs our listeners whether the window is visible to the user: it's
+//   neither minimized nor cloaked.
+// Arguments:
+// - cloaked: whether DWM currently cloaks the window
+// Return Value:
+// - <none>
+void IslandWindow::_updateWindowVisibility(const bool cloaked)
+{
+    _cloaked = cloaked;
+    _WindowVisibilityChangedHandlers(!_minimized && !_cloaked);
 }
 
 void IslandWindow::SetContent(winrt::Windows::UI::Xaml::UIElement content)
@@ -1021,8 +1081,13 @@ void IslandWindow::SetGlobalHotkeys(const std::vector<winrt::Microsoft::Terminal
 // - <none>
 winrt::fire_and_forget IslandWindow::SummonWindow(Remoting::SummonWindowBehavior args)
 {
-    // On the foreground thread:
-    co_await winrt::resume_foreground(_rootGrid.Dispatcher());
+    // On the foreground thread. Global hotkeys for this window arrive on it
+    // already, and resume_foreground would queue them behind whatever XAML
+    // has pending, so only hop over if we have to.
+    if (!_rootGrid.Dispatcher().HasThreadAccess())
+    {
+        co_await winrt::resume_foreground(_rootGrid.Dispatcher());
+    }
     _summonWindowRoutineBody(args);
 }
 
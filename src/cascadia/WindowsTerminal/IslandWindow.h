@@ -51,6 +51,7 @@ public:
     WINRT_CALLBACK(MouseScrolled, winrt::delegate<void(til::point, int32_t)>);
     WINRT_CALLBACK(WindowActivated, winrt::delegate<void()>);
     WINRT_CALLBACK(HotkeyPressed, winrt::delegate<void(long)>);
+    WINRT_CALLBACK(WindowVisibilityChanged, winrt::delegate<void(bool)>);
 
 protected:
     void ForceResize()
@@ -111,6 +112,13 @@ protected:
     bool _isQuakeWindow{ false };
     void _enterQuakeMode();
 
+    // DWM cloaks windows that are on another virtual desktop, for instance.
+    // There's no window message for that, only a WinEvent.
+    wil::unique_hwineventhook _cloakedHook;
+    bool _cloaked{ false };
+    static void CALLBACK _cloakedWinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD idEventThread, DWORD dwmsEventTime);
+    void _updateWindowVisibility(const bool cloaked);
+
     void _summonWindowRoutineBody(winrt::Microsoft::Terminal::Remoting::SummonWindowBehavior args);
 
 private:
@@ -69,6 +69,7 @@ Abstract:
 #include <winrt/Microsoft.Terminal.Settings.Model.h>
 #include <winrt/Microsoft.Terminal.Remoting.h>
 #include <winrt/Microsoft.Terminal.Control.h>
+#include <winrt/Microsoft.Terminal.TerminalConnection.h>
 
 #include <wil/resource.h>
 #include <wil/win32_helpers.h>
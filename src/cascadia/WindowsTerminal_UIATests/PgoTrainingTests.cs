@@ -0,0 +1,123 @@
+﻿//----------------------------------------------------------------------------------------------------------------------
+// <copyright file="PgoTrainingTests.cs" company="Microsoft">
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+// </copyright>
+// <summary>PGO training scenarios for the hot paths that the smoke tests don't cover.</summary>
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace WindowsTerminal.UIA.Tests
+{
+    using OpenQA.Selenium;
+    using OpenQA.Selenium.Appium;
+    using WEX.TestExecution.Markup;
+
+    using WindowsTerminal.UIA.Tests.Common;
+    using WindowsTerminal.UIA.Tests.Elements;
+
+    // These scenarios drive the Terminal through what it spends most of its
+    // time on: colored output floods, reflowing on resizes, searching the
+    // scrollback and shaping complex text. The output is generated by
+    // PowerShell from fixed scripts, so that every training run is the same.
+    // They run against the shipped binaries, which is what the PGO
+    // databases are merged for, with the real renderer on screen.
+    [TestClass]
+    public class PgoTrainingTests
+    {
+        public TestContext TestContext { get; set; }
+
+        private static void RunScript(AppiumWebElement root, string script, int waitMilliseconds)
+        {
+            root.SendKeys(script);
+            root.SendKeys(Keys.Enter);
+            System.Threading.Thread.Sleep(waitMilliseconds);
+        }
+
+        private static void RepeatKeys(AppiumWebElement root, string keys, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                root.SendKeys(keys);
+                Globals.WaitForTimeout();
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunSgrFlood()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+                RunScript(root, "$e=[char]27; 1..20000 | % { \"$e[3$($_ % 8);4$(($_ -shr 3) % 8)mline $_ $e[1;38;5;$($_ % 256)mpalette$e[22;38;2;$($_ % 256);128;$(255 - $_ % 256)mrgb$e[m plain\" }", 25000);
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunReflowOnResize()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+                RunScript(root, "1..3000 | % { \"$_ \" + ('wrapped ' * ($_ % 40)) }", 15000);
+
+                // Fullscreen and back reflows the buffer to a wider and back to the original width.
+                RepeatKeys(root, Keys.F11, 1);
+                Globals.WaitForLongTimeout();
+                RepeatKeys(root, Keys.F11, 1);
+                Globals.WaitForLongTimeout();
+
+                // Splitting and resizing the pane reflows it in small steps.
+                root.SendKeys(Keys.LeftAlt + Keys.LeftShift + "+");
+                Globals.WaitForLongTimeout();
+                RepeatKeys(root, Keys.LeftAlt + Keys.LeftShift + Keys.Left, 20);
+                RepeatKeys(root, Keys.LeftAlt + Keys.LeftShift + Keys.Right, 40);
+                RepeatKeys(root, Keys.LeftAlt + Keys.LeftShift + Keys.Left, 20);
+                root.SendKeys(Keys.LeftControl + Keys.LeftShift + "W");
+                Globals.WaitForLongTimeout();
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunSearchScrollback()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+                RunScript(root, "1..8000 | % { if ($_ % 97 -eq 0) { \"needle in line $_\" } else { \"hay in line $_ hay hay hay\" } }", 15000);
+
+                root.SendKeys(Keys.LeftControl + Keys.LeftShift + "F");
+                Globals.WaitForTimeout();
+                root.SendKeys("needle");
+                Globals.WaitForTimeout();
+                RepeatKeys(root, Keys.Enter, 40);
+                RepeatKeys(root, Keys.LeftShift + Keys.Enter, 40);
+
+                // A search that doesn't match has to go through the whole buffer.
+                root.SendKeys(Keys.LeftControl + "a");
+                root.SendKeys("haystack");
+                RepeatKeys(root, Keys.Enter, 10);
+                root.SendKeys(Keys.Escape);
+                Globals.WaitForLongTimeout();
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunComplexTextShaping()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+
+                // Devanagari conjuncts, Arabic, Japanese, emoji with ZWJ sequences and combining marks.
+                RunScript(root, "$s = -join [char[]](0x915,0x94d,0x937,0x20,0x645,0x631,0x62d,0x628,0x627,0x20,0x3053,0x3093,0x306b,0x3061,0x306f,0x20,0x65,0x301,0x20); " +
+                                "$s += [char]::ConvertFromUtf32(0x1F600) + [char]::ConvertFromUtf32(0x1F469) + [char]0x200D + [char]::ConvertFromUtf32(0x1F4BB); " +
+                                "1..4000 | % { \"$_ $s $s\" }",
+                          25000);
+            }
+        }
+    }
+}
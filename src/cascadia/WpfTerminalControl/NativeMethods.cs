@@ -185,6 +185,9 @@ namespace Microsoft.Terminal.Wpf
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern void TerminalSendOutput(IntPtr terminal, string lpdata);
 
+        [DllImport("PublicTerminalCore.dll", CallingConvention = CallingConvention.StdCall)]
+        public static extern void TerminalSendOutputUtf8(IntPtr terminal, [In] TerminalUtf8Span[] spans, UIntPtr count);
+
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern uint TerminalTriggerResize(IntPtr terminal, short width, short height, out COORD dimensions);
 
@@ -271,6 +274,23 @@ namespace Microsoft.Terminal.Wpf
             public uint flags;
         }
 
+        /// <summary>
+        /// A chunk of UTF-8 output. The memory has to stay pinned for the duration of the call.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct TerminalUtf8Span
+        {
+            /// <summary>
+            /// Pointer to the first byte of the chunk.
+            /// </summary>
+            public IntPtr Data;
+
+            /// <summary>
+            /// The number of bytes in the chunk.
+            /// </summary>
+            public UIntPtr Length;
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         public struct COORD
         {
@@ -0,0 +1,152 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- DebugCapture.h
+
+Abstract:
+- The format of the binary captures written by the capture mode of the debug
+  tap (see OpenDebugCaptureConnection), and a reader for them.
+- A capture holds the raw output and input of a connection in timestamped
+  records. To bound its size it's a ring of fixed size segments: once all of
+  them are in use, the oldest one is overwritten. Every segment starts with
+  a header holding its sequence number and how much of it is in use, so
+  that a reader can put them back in order.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::DebugCapture
+{
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t segmentCount;
+        uint32_t segmentSize; // including the SegmentHeader
+        int64_t ticksPerSecond; // of the record timestamps
+    };
+
+    struct SegmentHeader
+    {
+        uint64_t sequence; // 0 for segments that were never written
+        uint32_t used; // the number of bytes of records after this header
+        uint32_t reserved;
+    };
+
+    // Followed by length bytes of UTF-16 text. Records never span segments.
+    struct RecordHeader
+    {
+        int64_t timestamp; // in ticksPerSecond since the capture started
+        uint32_t length;
+        uint8_t kind;
+        uint8_t reserved[3];
+    };
+#pragma pack(pop)
+
+    enum class RecordKind : uint8_t
+    {
+        Output = 1,
+        Input = 2,
+    };
+
+    constexpr uint32_t Magic = 0x43445457; // "WTDC"
+    constexpr uint16_t Version = 1;
+
+    // Routine Description:
+    // - Returns whether the given bytes start like a capture.
+    inline bool IsCapture(const std::string_view capture) noexcept
+    {
+        uint32_t magic = 0;
+        if (capture.size() < sizeof(FileHeader))
+        {
+            return false;
+        }
+        memcpy(&magic, capture.data(), sizeof(magic));
+        return magic == Magic;
+    }
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+    // Routine Description:
+    // - Calls the given callback for every record in the capture, from the
+    //   oldest one to the most recent one.
+    // Arguments:
+    // - capture - The contents of the capture file.
+    // - callback - Called with the RecordKind, the timestamp and the text of each record.
+    // Return Value:
+    // - false if the capture is invalid or truncated. The records before
+    //   the point where that was noticed have been passed to the callback.
+    template<typename TCallback>
+    bool ReadRecords(const std::string_view capture, TCallback&& callback)
+    {
+        if (!IsCapture(capture))
+        {
+            return false;
+        }
+
+        FileHeader header{};
+        memcpy(&header, capture.data(), sizeof(header));
+        if (header.version != Version || header.segmentSize <= sizeof(SegmentHeader))
+        {
+            return false;
+        }
+
+        // The segments in the order they were written in.
+        std::vector<std::pair<uint64_t, std::string_view>> segments;
+        for (size_t i = 0; i < header.segmentCount; ++i)
+        {
+            const auto offset = sizeof(FileHeader) + i * header.segmentSize;
+            if (offset + sizeof(SegmentHeader) > capture.size())
+            {
+                break;
+            }
+
+            SegmentHeader segment{};
+            memcpy(&segment, capture.data() + offset, sizeof(segment));
+            if (segment.sequence == 0)
+            {
+                continue;
+            }
+            if (segment.used > header.segmentSize - sizeof(SegmentHeader) || offset + sizeof(SegmentHeader) + segment.used > capture.size())
+            {
+                return false;
+            }
+            segments.emplace_back(segment.sequence, capture.substr(offset + sizeof(SegmentHeader), segment.used));
+        }
+        std::sort(segments.begin(), segments.end(), [](const auto& a, const auto& b) noexcept {
+            return a.first < b.first;
+        });
+
+        std::wstring text;
+        for (const auto& [sequence, records] : segments)
+        {
+            size_t offset = 0;
+            while (offset < records.size())
+            {
+                RecordHeader record{};
+                if (records.size() - offset < sizeof(record))
+                {
+                    return false;
+                }
+                memcpy(&record, records.data() + offset, sizeof(record));
+                offset += sizeof(record);
+
+                if (record.length > records.size() - offset || record.length % sizeof(wchar_t) != 0)
+                {
+                    return false;
+                }
+                // The records are packed, so the text is copied out to align it.
+                text.resize(record.length / sizeof(wchar_t));
+                memcpy(text.data(), records.data() + offset, record.length);
+                offset += record.length;
+
+                callback(static_cast<RecordKind>(record.kind), record.timestamp, std::wstring_view{ text });
+            }
+        }
+        return true;
+    }
+#pragma warning(pop)
+}
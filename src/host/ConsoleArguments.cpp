@@ -19,8 +19,13 @@ const std::wstring_view ConsoleArguments::FILEPATH_LEADER_PREFIX = L"\\??\\";
 const std::wstring_view ConsoleArguments::WIDTH_ARG = L"--width";
 const std::wstring_view ConsoleArguments::HEIGHT_ARG = L"--height";
 const std::wstring_view ConsoleArguments::INHERIT_CURSOR_ARG = L"--inheritcursor";
+const std::wstring_view ConsoleArguments::CURSOR_X_ARG = L"--cursorx";
+const std::wstring_view ConsoleArguments::CURSOR_Y_ARG = L"--cursory";
 const std::wstring_view ConsoleArguments::RESIZE_QUIRK = L"--resizeQuirk";
 const std::wstring_view ConsoleArguments::WIN32_INPUT_MODE = L"--win32input";
+const std::wstring_view ConsoleArguments::DIFF_RENDERING = L"--diffRendering";
+const std::wstring_view ConsoleArguments::PASSTHROUGH_MODE = L"--passthrough";
+const std::wstring_view ConsoleArguments::RESIZE_NEGOTIATED = L"--resizeNegotiated";
 const std::wstring_view ConsoleArguments::FEATURE_ARG = L"--feature";
 const std::wstring_view ConsoleArguments::FEATURE_PTY_ARG = L"pty";
 const std::wstring_view ConsoleArguments::COM_SERVER_ARG = L"-Embedding";
@@ -144,6 +149,8 @@ ConsoleArguments& ConsoleArguments::operator=(const ConsoleArguments& other)
         _width = other._width;
         _height = other._height;
         _inheritCursor = other._inheritCursor;
+        _cursorX = other._cursorX;
+        _cursorY = other._cursorY;
         _receivedEarlySizeChange = other._receivedEarlySizeChange;
         _runAsComServer = other._runAsComServer;
         _forceNoHandoff = other._forceNoHandoff;
@@ -500,6 +507,14 @@ void ConsoleArguments::s_ConsumeArg(_Inout_ std::vector<std::wstring>& args, _In
             s_ConsumeArg(args, i);
             hr = S_OK;
         }
+        else if (arg == CURSOR_X_ARG)
+        {
+            hr = s_GetArgumentValue(args, i, &_cursorX);
+        }
+        else if (arg == CURSOR_Y_ARG)
+        {
+            hr = s_GetArgumentValue(args, i, &_cursorY);
+        }
         else if (arg == RESIZE_QUIRK)
         {
             _resizeQuirk = true;
@@ -512,6 +527,24 @@ void ConsoleArguments::s_ConsumeArg(_Inout_ std::vector<std::wstring>& args, _In
             s_ConsumeArg(args, i);
             hr = S_OK;
         }
+        else if (arg == DIFF_RENDERING)
+        {
+            _diffRendering = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
+        else if (arg == PASSTHROUGH_MODE)
+        {
+            _passthrough = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
+        else if (arg == RESIZE_NEGOTIATED)
+        {
+            _resizeNegotiated = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
         else if (arg == CLIENT_COMMANDLINE_ARG)
         {
             // Everything after this is the explicit commandline
@@ -659,6 +692,22 @@ bool ConsoleArguments::GetInheritCursor() const
 {
     return _inheritCursor;
 }
+
+// Method Description:
+// - The cursor position the terminal told us to inherit up front, with
+//   --cursorx and --cursory, so that we don't have to ask it with a DSR.
+// Arguments:
+// - <none>
+// Return Value:
+// - The 0-based position within the viewport, if both were given and valid.
+std::optional<COORD> ConsoleArguments::GetInheritedCursorPosition() const
+{
+    if (_cursorX < 0 || _cursorY < 0)
+    {
+        return std::nullopt;
+    }
+    return COORD{ _cursorX, _cursorY };
+}
 bool ConsoleArguments::IsResizeQuirkEnabled() const
 {
     return _resizeQuirk;
@@ -667,6 +716,18 @@ bool ConsoleArguments::IsWin32InputModeEnabled() const
 {
     return _win32InputMode;
 }
+bool ConsoleArguments::IsDiffRenderingEnabled() const
+{
+    return _diffRendering;
+}
+bool ConsoleArguments::IsPassthroughEnabled() const
+{
+    return _passthrough;
+}
+bool ConsoleArguments::IsResizeNegotiated() const
+{
+    return _resizeNegotiated;
+}
 
 // Method Description:
 // - Tell us to use a different size than the one parsed as the size of the
@@ -53,8 +53,12 @@ public:
     short GetWidth() const;
     short GetHeight() const;
     bool GetInheritCursor() const;
+    std::optional<COORD> GetInheritedCursorPosition() const;
     bool IsResizeQuirkEnabled() const;
     bool IsWin32InputModeEnabled() const;
+    bool IsDiffRenderingEnabled() const;
+    bool IsPassthroughEnabled() const;
+    bool IsResizeNegotiated() const;
 
     void SetExpectedSize(COORD dimensions) noexcept;
 
@@ -74,8 +78,13 @@ public:
     static const std::wstring_view WIDTH_ARG;
     static const std::wstring_view HEIGHT_ARG;
     static const std::wstring_view INHERIT_CURSOR_ARG;
+    static const std::wstring_view CURSOR_X_ARG;
+    static const std::wstring_view CURSOR_Y_ARG;
     static const std::wstring_view RESIZE_QUIRK;
     static const std::wstring_view WIN32_INPUT_MODE;
+    static const std::wstring_view DIFF_RENDERING;
+    static const std::wstring_view PASSTHROUGH_MODE;
+    static const std::wstring_view RESIZE_NEGOTIATED;
     static const std::wstring_view FEATURE_ARG;
     static const std::wstring_view FEATURE_PTY_ARG;
     static const std::wstring_view COM_SERVER_ARG;
@@ -143,8 +152,13 @@ private:
     DWORD _serverHandle;
     DWORD _signalHandle;
     bool _inheritCursor;
+    short _cursorX{ -1 };
+    short _cursorY{ -1 };
     bool _resizeQuirk{ false };
     bool _win32InputMode{ false };
+    bool _diffRendering{ false };
+    bool _passthrough{ false };
+    bool _resizeNegotiated{ false };
 
     bool _receivedEarlySizeChange;
     short _originalWidth;
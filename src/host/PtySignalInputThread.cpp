@@ -89,6 +89,19 @@ void PtySignalInputThread::ConnectConsole() noexcept
             PTY_SIGNAL_RESIZE resizeMsg = { 0 };
             _GetData(&resizeMsg, sizeof(resizeMsg));
 
+            // While the window is being dragged, resizes can queue up in the
+            // pipe faster than we can reflow the buffer and repaint. Every
+            // reflow but the last would be thrown away, so skip right to
+            // the latest size that's already there.
+            unsigned short nextSignalId = 0;
+            while (_PeekSignal(nextSignalId, sizeof(resizeMsg)) && nextSignalId == PTY_SIGNAL_RESIZE_WINDOW)
+            {
+                if (!_GetData(&nextSignalId, sizeof(nextSignalId)) || !_GetData(&resizeMsg, sizeof(resizeMsg)))
+                {
+                    return S_OK;
+                }
+            }
+
             LockConsole();
             auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
             // If the client app hasn't yet connected, stash the new size in the launchArgs.
@@ -162,6 +175,27 @@ bool PtySignalInputThread::_GetData(_Out_writes_bytes_(cbBuffer) void* const pBu
     return true;
 }
 
+// Method Description:
+// - Looks at the next signal in the pipe without taking it out, if it has
+//   already arrived completely, together with its payload.
+// Arguments:
+// - signalId - receives the ID of the next signal.
+// - cbPayload - The size of the payload that comes with the signal.
+// Return Value:
+// - True if the signal and its payload can be read without blocking. False otherwise.
+bool PtySignalInputThread::_PeekSignal(_Out_ unsigned short& signalId, const DWORD cbPayload) noexcept
+{
+    signalId = 0;
+
+    DWORD dwRead = 0;
+    DWORD dwAvailable = 0;
+    if (FALSE == PeekNamedPipe(_hFile.get(), &signalId, sizeof(signalId), &dwRead, &dwAvailable, nullptr))
+    {
+        return false;
+    }
+    return dwRead == sizeof(signalId) && dwAvailable >= sizeof(signalId) + cbPayload;
+}
+
 // Method Description:
 // - Starts the PTY Signal input thread.
 [[nodiscard]] HRESULT PtySignalInputThread::Start() noexcept
@@ -35,6 +35,7 @@ namespace Microsoft::Console
     private:
         [[nodiscard]] HRESULT _InputThread();
         bool _GetData(_Out_writes_bytes_(cbBuffer) void* const pBuffer, const DWORD cbBuffer);
+        bool _PeekSignal(_Out_ unsigned short& signalId, const DWORD cbPayload) noexcept;
         void _Shutdown();
 
         wil::unique_hfile _hFile;
@@ -31,6 +31,16 @@ void ScreenBufferRenderTarget::TriggerRedraw(const COORD* const pcoord)
     }
 }
 
+void ScreenBufferRenderTarget::TriggerRedrawContent(const Microsoft::Console::Types::Viewport& region)
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
+    if (pRenderer != nullptr && pActive == &_owner)
+    {
+        pRenderer->TriggerRedrawContent(region);
+    }
+}
+
 void ScreenBufferRenderTarget::TriggerRedrawCursor(const COORD* const pcoord)
 {
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
@@ -91,6 +101,16 @@ void ScreenBufferRenderTarget::TriggerScroll(const COORD* const pcoordDelta)
     }
 }
 
+void ScreenBufferRenderTarget::TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const SHORT delta)
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
+    if (pRenderer != nullptr && pActive == &_owner)
+    {
+        pRenderer->TriggerScrollRegion(region, delta);
+    }
+}
+
 void ScreenBufferRenderTarget::TriggerCircling()
 {
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
@@ -110,3 +130,15 @@ void ScreenBufferRenderTarget::TriggerTitleChange()
         pRenderer->TriggerTitleChange();
     }
 }
+
+void ScreenBufferRenderTarget::SetSynchronizedOutput(const bool enabled)
+{
+    // Unlike the invalidations, this is forwarded even if the buffer isn't
+    // the active one, because an application that switches buffers in the
+    // middle of a synchronized frame still expects it to end.
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->SetSynchronizedOutput(enabled);
+    }
+}
@@ -29,6 +29,8 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
     _hFile{ std::move(hPipe) },
     _hThread{},
     _u8State{},
+    _buffer(s_minBatchSize, '\0'),
+    _wstr{},
     _dwThreadId{ 0 },
     _exitRequested{ false },
     _exitResult{ S_OK }
@@ -40,6 +42,7 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
     auto pGetSet = std::make_unique<ConhostInternalGetSet>(gci);
 
     auto dispatch = std::make_unique<InteractDispatch>(std::move(pGetSet));
+    _pDispatch = dispatch.get();
 
     auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch), inheritCursor);
 
@@ -72,14 +75,16 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
 
     try
     {
-        std::wstring wstr{};
-        auto hr = til::u8u16(u8Str, wstr, _u8State);
+        auto hr = til::u8u16(u8Str, _wstr, _u8State);
         // If we hit a parsing error, eat it. It's bad utf-8, we can't do anything with it.
         if (FAILED(hr))
         {
             return S_FALSE;
         }
-        _pInputStateMachine->ProcessString(wstr);
+        _pInputStateMachine->ProcessString(_wstr);
+
+        // A paste that spans more than this read is written as far as it got.
+        LOG_HR_IF(E_FAIL, !_pDispatch->FlushInputBatch());
     }
     CATCH_RETURN();
 
@@ -99,8 +104,11 @@ DWORD WINAPI VtInputThread::StaticVtInputThreadProc(_In_ LPVOID lpParameter)
 }
 
 // Method Description:
-// - Do a single ReadFile from our pipe, and try and handle it. If handling
+// - Do a ReadFile from our pipe, and try and handle it. If handling
 //      failed, throw or log, depending on what the caller wants.
+// - Whatever else has already arrived in the pipe by then is read as well,
+//      so that a large paste is handled in a few batches that take the
+//      console lock once each, instead of in many small reads.
 // Arguments:
 // - throwOnFail: If true, throw an exception if there was an error processing
 //      the input received. Otherwise, log the error.
@@ -108,9 +116,8 @@ DWORD WINAPI VtInputThread::StaticVtInputThreadProc(_In_ LPVOID lpParameter)
 // - <none>
 void VtInputThread::DoReadInput(const bool throwOnFail)
 {
-    char buffer[256];
     DWORD dwRead = 0;
-    bool fSuccess = !!ReadFile(_hFile.get(), buffer, ARRAYSIZE(buffer), &dwRead, nullptr);
+    bool fSuccess = !!ReadFile(_hFile.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &dwRead, nullptr);
 
     // If we failed to read because the terminal broke our pipe (usually due
     //      to dying itself), close gracefully with ERROR_BROKEN_PIPE.
@@ -123,7 +130,22 @@ void VtInputThread::DoReadInput(const bool throwOnFail)
         return;
     }
 
-    HRESULT hr = _HandleRunInput({ buffer, gsl::narrow_cast<size_t>(dwRead) });
+    auto total = gsl::narrow_cast<size_t>(dwRead);
+    try
+    {
+        total = _DrainPipe(total);
+    }
+    CATCH_LOG();
+
+    HRESULT hr = _HandleRunInput({ _buffer.data(), total });
+
+    // Once the terminal doesn't send that much anymore, let go of the memory.
+    if (total < s_minBatchSize && _buffer.size() > s_minBatchSize)
+    {
+        _buffer.resize(s_minBatchSize);
+        _buffer.shrink_to_fit();
+    }
+
     if (FAILED(hr))
     {
         if (throwOnFail)
@@ -138,6 +160,41 @@ void VtInputThread::DoReadInput(const bool throwOnFail)
     }
 }
 
+// Method Description:
+// - Appends what has already arrived in the pipe to the given number of
+//      bytes in _buffer, without blocking, growing the buffer as needed.
+//      Errors are left for the next blocking read to report.
+// Arguments:
+// - total - The number of bytes at the start of _buffer that were read so far.
+// Return Value:
+// - The number of bytes at the start of _buffer that were read now.
+size_t VtInputThread::_DrainPipe(size_t total)
+{
+    while (total < s_maxBatchSize)
+    {
+        DWORD dwAvailable = 0;
+        if (!PeekNamedPipe(_hFile.get(), nullptr, 0, nullptr, &dwAvailable, nullptr) || dwAvailable == 0)
+        {
+            break;
+        }
+
+        const auto wanted = std::min(total + dwAvailable, s_maxBatchSize);
+        if (wanted > _buffer.size())
+        {
+            _buffer.resize(std::min(std::max(wanted, _buffer.size() * 2), s_maxBatchSize));
+        }
+
+        // Only what's available is read, so that this never blocks.
+        DWORD dwRead = 0;
+        if (!ReadFile(_hFile.get(), _buffer.data() + total, gsl::narrow_cast<DWORD>(wanted - total), &dwRead, nullptr) || dwRead == 0)
+        {
+            break;
+        }
+        total += dwRead;
+    }
+    return total;
+}
+
 // Method Description:
 // - The ThreadProc for the VT Input Thread. Reads input from the pipe, and
 //      passes it to _HandleRunInput to be processed by the
@@ -16,6 +16,11 @@ Author(s):
 
 #include "../terminal/parser/StateMachine.hpp"
 
+namespace Microsoft::Console::VirtualTerminal
+{
+    class InteractDispatch;
+}
+
 namespace Microsoft::Console
 {
     class VtInputThread
@@ -29,6 +34,7 @@ namespace Microsoft::Console
 
     private:
         [[nodiscard]] HRESULT _HandleRunInput(const std::string_view u8Str);
+        size_t _DrainPipe(size_t total);
         DWORD _InputThread();
 
         wil::unique_hfile _hFile;
@@ -39,6 +45,15 @@ namespace Microsoft::Console
         HRESULT _exitResult;
 
         std::unique_ptr<Microsoft::Console::VirtualTerminal::StateMachine> _pInputStateMachine;
+        Microsoft::Console::VirtualTerminal::InteractDispatch* _pDispatch{ nullptr }; // Non-ownership pointer, owned by the state machine
         til::u8state _u8State;
+
+        // What a batch of reads is collected in, and its conversion to UTF-16.
+        // The buffer grows while the terminal sends more than it can hold,
+        // like during a large paste, and shrinks back once it doesn't.
+        static constexpr size_t s_minBatchSize = 4 * 1024;
+        static constexpr size_t s_maxBatchSize = 256 * 1024;
+        std::string _buffer;
+        std::wstring _wstr;
     };
 }
@@ -68,8 +68,12 @@ VtIo::VtIo() :
 [[nodiscard]] HRESULT VtIo::Initialize(const ConsoleArguments* const pArgs)
 {
     _lookingForCursorPosition = pArgs->GetInheritCursor();
+    _inheritedCursorPosition = pArgs->GetInheritedCursorPosition();
     _resizeQuirk = pArgs->IsResizeQuirkEnabled();
     _win32InputMode = pArgs->IsWin32InputModeEnabled();
+    _diffRendering = pArgs->IsDiffRenderingEnabled();
+    _passthrough = pArgs->IsPassthroughEnabled();
+    _resizeNegotiated = pArgs->IsResizeNegotiated();
 
     // If we were already given VT handles, set up the VT IO engine to use those.
     if (pArgs->InConptyMode())
@@ -143,7 +147,8 @@ VtIo::VtIo() :
     {
         if (IsValidHandle(_hInput.get()))
         {
-            _pVtInputThread = std::make_unique<VtInputThread>(std::move(_hInput), _lookingForCursorPosition);
+            // The input only needs to look for the DSR response if we're going to ask for one.
+            _pVtInputThread = std::make_unique<VtInputThread>(std::move(_hInput), _lookingForCursorPosition && !_inheritedCursorPosition);
         }
 
         if (IsValidHandle(_hOutput.get()))
@@ -174,6 +179,16 @@ VtIo::VtIo() :
             {
                 _pVtRenderEngine->SetTerminalOwner(this);
                 _pVtRenderEngine->SetResizeQuirk(_resizeQuirk);
+                _pVtRenderEngine->SetDiffRendering(_diffRendering);
+                _pVtRenderEngine->SetResizeNegotiated(_resizeNegotiated);
+
+                // The output can only be passed through as is, if the terminal
+                // understands everything the client could write.
+                _passthrough = _passthrough && _IoMode == VtIoMode::XTERM_256;
+                if (_passthrough)
+                {
+                    _pVtRenderEngine->BeginPassthrough();
+                }
             }
         }
     }
@@ -237,13 +252,26 @@ bool VtIo::IsUsingVt() const
     // We need both handles for this initialization to work. If we don't have
     //      both, we'll skip it. They either aren't going to be reading output
     //      (so they can't get the DSR) or they can't write the response to us.
-    if (_lookingForCursorPosition && _pVtRenderEngine && _pVtInputThread)
+    // If the terminal already told us where the cursor is (--cursorx and
+    //      --cursory), we take that instead and skip the round trip.
+    if (_lookingForCursorPosition && _pVtRenderEngine && _inheritedCursorPosition)
     {
+        Tracing::s_TraceInheritCursorBegin(false);
+        LOG_IF_FAILED(_InheritCursorPosition(*_inheritedCursorPosition));
+        // If that failed, we start out without an inherited cursor rather
+        // than waiting for a position that nobody is going to send.
+        _lookingForCursorPosition = false;
+        Tracing::s_TraceInheritCursorEnd();
+    }
+    else if (_lookingForCursorPosition && _pVtRenderEngine && _pVtInputThread)
+    {
+        Tracing::s_TraceInheritCursorBegin(true);
         LOG_IF_FAILED(_pVtRenderEngine->RequestCursor());
         while (_lookingForCursorPosition)
         {
             _pVtInputThread->DoReadInput(false);
         }
+        Tracing::s_TraceInheritCursorEnd();
     }
 
     if (_pVtInputThread)
@@ -337,6 +365,27 @@ bool VtIo::IsUsingVt() const
     return hr;
 }
 
+// Method Description:
+// - Moves the cursor to the position the terminal passed on the commandline,
+//      the same way the response to our DSR would have: relative to the
+//      viewport and clamped to it. SetConsoleCursorPositionImpl calls
+//      SetCursorPosition above, which makes the renderer inherit it.
+// Arguments:
+// - viewportPosition: The 0-based position of the cursor within the viewport.
+// Return Value:
+// - S_OK if we moved the cursor, else an appropriate HRESULT
+[[nodiscard]] HRESULT VtIo::_InheritCursorPosition(const COORD viewportPosition)
+{
+    auto& g = ServiceLocator::LocateGlobals();
+    auto& screenInfo = g.getConsoleInformation().GetActiveOutputBuffer();
+    const auto& viewport = screenInfo.GetViewport();
+
+    COORD position{ gsl::narrow_cast<SHORT>(viewportPosition.X + viewport.Left()),
+                    gsl::narrow_cast<SHORT>(viewportPosition.Y + viewport.Top()) };
+    viewport.Clamp(position);
+    return g.api.SetConsoleCursorPositionImpl(screenInfo, position);
+}
+
 void VtIo::CloseInput()
 {
     // This will release the lock when it goes out of scope
@@ -456,6 +505,135 @@ bool VtIo::IsResizeQuirkEnabled() const
     return _resizeQuirk;
 }
 
+// Method Description:
+// - In passthrough mode, forwards the output of a VT-native client straight to
+//   the terminal, instead of parsing it into our buffer and rendering it from
+//   there again. The output is kept in a journal though, so that the buffer
+//   can be brought up to date, if a client ends up calling an API that
+//   depends on its contents. See SyncPassthroughBuffer.
+// - Output that can't be passed through (for instance, because VT processing
+//   is disabled) ends the passthrough, and is then written to the buffer.
+// Arguments:
+// - screenInfo - the buffer the client is writing to
+// - text - the output of the client
+// - requiresVtQuirk - true if the legacy attribute quirk is required for this client
+// Return Value:
+// - S_OK if the text was passed through, S_FALSE if it needs to be written to
+//   the buffer instead, or an appropriate HRESULT for failing to write.
+[[nodiscard]] HRESULT VtIo::WritePassthrough(SCREEN_INFORMATION& screenInfo, const std::wstring_view text, const bool requiresVtQuirk)
+try
+{
+    if (!_passthrough)
+    {
+        return S_FALSE;
+    }
+
+    if (requiresVtQuirk ||
+        !screenInfo.IsActiveScreenBuffer() ||
+        WI_IsAnyFlagClear(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING) ||
+        (_passthroughBuffer && _passthroughBuffer != &screenInfo))
+    {
+        EndPassthrough();
+        return S_FALSE;
+    }
+
+    // Without DISABLE_NEWLINE_AUTO_RETURN, we'd treat a line feed like a
+    // carriage return followed by a line feed. The terminal doesn't know that.
+    std::wstring translated;
+    auto output = text;
+    if (WI_IsFlagClear(screenInfo.OutputMode, DISABLE_NEWLINE_AUTO_RETURN) && text.find(L'\n') != std::wstring_view::npos)
+    {
+        translated.reserve(text.size() + text.size() / 8);
+        for (const auto wch : text)
+        {
+            if (wch == L'\n')
+            {
+                translated.push_back(L'\r');
+            }
+            translated.push_back(wch);
+        }
+        output = translated;
+    }
+
+    RETURN_IF_FAILED(_pVtRenderEngine->WritePassthrough(output));
+
+    _passthroughBuffer = &screenInfo;
+    _passthroughJournal.append(text);
+
+    // Bring the buffer up to date in batches, so that the journal doesn't grow without bounds.
+    if (_passthroughJournal.size() >= s_passthroughJournalLimit)
+    {
+        SyncPassthroughBuffer();
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Method Description:
+// - Brings the buffer up to date with the output that was passed through to
+//   the terminal, by replaying the journal into the buffer. Call this before
+//   reading from the buffer. The passthrough stays active.
+// - We're not painting during the passthrough and any queries or reports
+//   the replay might cause have already been answered by the terminal.
+//   See IsReplayingPassthrough.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtIo::SyncPassthroughBuffer()
+{
+    // The adapter calls into the same APIs that sync the buffer while we replay.
+    if (_replayingPassthrough || _passthroughJournal.empty() || !_passthroughBuffer)
+    {
+        return;
+    }
+
+    _replayingPassthrough = true;
+    auto resetJournal = wil::scope_exit([&]() noexcept {
+        _replayingPassthrough = false;
+        _passthroughJournal.clear();
+    });
+
+    _passthroughBuffer->GetStateMachine().ProcessString(_passthroughJournal);
+}
+
+// Method Description:
+// - Ends the passthrough for good, after bringing the buffer up to date. Call
+//   this before modifying the buffer in any other way than by writing VT to it.
+//   From here on, the buffer is rendered to the terminal as usual.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtIo::EndPassthrough()
+{
+    if (!_passthrough || _replayingPassthrough)
+    {
+        return;
+    }
+
+    SyncPassthroughBuffer();
+
+    _passthrough = false;
+    _passthroughBuffer = nullptr;
+    if (_pVtRenderEngine)
+    {
+        LOG_IF_FAILED(_pVtRenderEngine->EndPassthrough());
+    }
+}
+
+// Method Description:
+// - Returns true while SyncPassthroughBuffer replays the passthrough journal.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we're replaying the journal.
+bool VtIo::IsReplayingPassthrough() const noexcept
+{
+    return _replayingPassthrough;
+}
+
 // Method Description:
 // - Manually tell the renderer that it should emit a "Erase Scrollback"
 //   sequence to the connected terminal. We need to do this in certain cases
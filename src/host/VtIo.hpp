@@ -10,6 +10,7 @@
 #include "PtySignalInputThread.hpp"
 
 class ConsoleArguments;
+class SCREEN_INFORMATION;
 
 namespace Microsoft::Console::VirtualTerminal
 {
@@ -45,6 +46,11 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool IsResizeQuirkEnabled() const;
 
+        [[nodiscard]] HRESULT WritePassthrough(SCREEN_INFORMATION& screenInfo, const std::wstring_view text, const bool requiresVtQuirk);
+        void SyncPassthroughBuffer();
+        void EndPassthrough();
+        bool IsReplayingPassthrough() const noexcept;
+
         [[nodiscard]] HRESULT ManuallyClearScrollback() const noexcept;
 
     private:
@@ -59,10 +65,23 @@ namespace Microsoft::Console::VirtualTerminal
         bool _objectsCreated;
 
         bool _lookingForCursorPosition;
+        // The cursor position the terminal passed on the commandline, which
+        // saves us from asking for it with a DSR.
+        std::optional<COORD> _inheritedCursorPosition;
+        [[nodiscard]] HRESULT _InheritCursorPosition(const COORD viewportPosition);
         std::mutex _shutdownLock;
 
         bool _resizeQuirk{ false };
         bool _win32InputMode{ false };
+        bool _diffRendering{ false };
+        bool _resizeNegotiated{ false };
+
+        // See WritePassthrough.
+        static constexpr size_t s_passthroughJournalLimit = 64 * 1024;
+        bool _passthrough{ false };
+        bool _replayingPassthrough{ false };
+        SCREEN_INFORMATION* _passthroughBuffer{ nullptr };
+        std::wstring _passthroughJournal;
 
         std::unique_ptr<Microsoft::Console::Render::VtEngine> _pVtRenderEngine;
         std::unique_ptr<Microsoft::Console::VtInputThread> _pVtInputThread;
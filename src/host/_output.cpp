@@ -14,6 +14,7 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../types/inc/Viewport.hpp"
 #include "../types/inc/convert.hpp"
+#include "../types/inc/GlyphWidth.hpp"
 #include "../types/inc/Utf16Parser.hpp"
 
 #include <algorithm>
@@ -84,6 +85,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     auto& screenInfo = OutContext.GetActiveBuffer();
     const auto bufferSize = screenInfo.GetBufferSize();
     if (!bufferSize.IsInBounds(target))
@@ -124,6 +128,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     auto& screenInfo = OutContext.GetActiveBuffer();
     const auto bufferSize = screenInfo.GetBufferSize();
     if (!bufferSize.IsInBounds(target))
@@ -209,6 +216,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     auto& screenBuffer = OutContext.GetActiveBuffer();
     const auto bufferSize = screenBuffer.GetBufferSize();
     if (!bufferSize.IsInBounds(startingCoordinate))
@@ -218,11 +228,10 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
 
     try
     {
-        TextAttribute useThisAttr(attribute);
-        const OutputCellIterator it(useThisAttr, lengthToWrite);
-        const auto done = screenBuffer.Write(it, startingCoordinate);
-
-        cellsModified = done.GetCellDistance(it);
+        // Legacy applications paint whole screens with this, so the
+        // attributes are applied to each row at once instead of a cell at a time.
+        const TextAttribute useThisAttr(attribute);
+        cellsModified = screenBuffer.GetTextBuffer().FillAttributes(useThisAttr, startingCoordinate, lengthToWrite);
 
         // Notify accessibility
         auto endingCoordinate = startingCoordinate;
@@ -265,6 +274,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     // TODO: does this even need to be here or will it exit quickly?
     auto& screenInfo = OutContext.GetActiveBuffer();
     const auto bufferSize = screenInfo.GetBufferSize();
@@ -276,12 +288,20 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     HRESULT hr = S_OK;
     try
     {
-        const OutputCellIterator it(character, lengthToWrite);
-
         // when writing to the buffer, specifically unset wrap if we get to the last column.
         // a fill operation should UNSET wrap in that scenario. See GH #1126 for more details.
-        const auto done = screenInfo.Write(it, startingCoordinate, false);
-        cellsModified = done.GetInputDistance(it);
+        if (!IS_HIGH_SURROGATE(character) && !IS_LOW_SURROGATE(character) && !IsGlyphFullWidth(character))
+        {
+            // Legacy applications paint whole screens with this, so narrow
+            // characters are filled into each row at once instead of a cell at a time.
+            cellsModified = screenInfo.GetTextBuffer().FillText(character, startingCoordinate, lengthToWrite, false);
+        }
+        else
+        {
+            const OutputCellIterator it(character, lengthToWrite);
+            const auto done = screenInfo.Write(it, startingCoordinate, false);
+            cellsModified = done.GetInputDistance(it);
+        }
 
         // Notify accessibility
         auto endingCoordinate = startingCoordinate;
@@ -553,15 +553,27 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             }
 
             // line was wrapped if we're writing up to the end of the current row
-            OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
-            const auto itEnd = screenInfo.Write(it);
+            // Plain narrow text can be written in bulk. Only whatever is left after
+            // that has to go through an OutputCellIterator.
+            const std::wstring_view text{ LocalBuffer, i };
+            const auto bulkWritten = textBuffer.WriteRun(text, Attributes, CursorPosition);
+            size_t cellsWritten = bulkWritten;
+            if (bulkWritten < text.size())
+            {
+                auto target = CursorPosition;
+                target.X += gsl::narrow_cast<SHORT>(bulkWritten);
+
+                OutputCellIterator it(text.substr(bulkWritten), Attributes);
+                const auto itEnd = screenInfo.Write(it, target);
+                cellsWritten += itEnd.GetCellDistance(it);
+            }
 
             // Notify accessibility
             screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, CursorPosition.X + gsl::narrow<SHORT>(i - 1), CursorPosition.Y);
 
             // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
             // when/if we need to erase the command line.
-            TempNumSpaces += itEnd.GetCellDistance(it);
+            TempNumSpaces += cellsWritten;
             // WCL-NOTE: We are using the "estimated" X position delta instead of the actual delta from
             // WCL-NOTE: the iterator. It is not clear why. If they differ, the cursor ends up in the
             // WCL-NOTE: wrong place (typically inside another character).
@@ -905,6 +917,88 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     return STATUS_SUCCESS;
 }
 
+// Routine Description:
+// - Writes the printable ASCII at the start of the text straight into the rows
+//   of a VT mode buffer, a line at a time, and moves the cursor along with it.
+// - This is what WriteCharsLegacy does with WC_DELAY_EOL_WRAP for text like
+//   this, minus the copy into its local buffer and the per character checks.
+// - It stops at the first character that needs more than that (control
+//   characters, wide or complex glyphs), or when the buffer doesn't wrap at
+//   the end of the line, and leaves the rest to WriteCharsLegacy.
+// Arguments:
+// - screenInfo - the buffer to write into. Its output mode has to be VT processing.
+// - text - the text to write. On return, the part of it that wasn't written yet.
+// Return Value:
+// - STATUS_SUCCESS, or the failure to move the cursor.
+[[nodiscard]] NTSTATUS WritePrintableTextVt(SCREEN_INFORMATION& screenInfo,
+                                            std::wstring_view& text)
+{
+    if (WI_IsFlagClear(screenInfo.OutputMode, ENABLE_WRAP_AT_EOL_OUTPUT))
+    {
+        return STATUS_SUCCESS;
+    }
+
+    TextBuffer& textBuffer = screenInfo.GetTextBuffer();
+    Cursor& cursor = textBuffer.GetCursor();
+    const TextAttribute attributes = screenInfo.GetAttributes();
+
+    while (!text.empty() && text.front() >= UNICODE_SPACE && text.front() <= L'~')
+    {
+        // correct for delayed EOL, the same way WriteCharsLegacy does
+        if (cursor.IsDelayedEOLWrap())
+        {
+            const COORD coordDelayedAt = cursor.GetDelayedAtPosition();
+            const COORD coordCursor = cursor.GetPosition();
+            cursor.ResetDelayEOLWrap();
+            if (coordDelayedAt.X == coordCursor.X && coordDelayedAt.Y == coordCursor.Y)
+            {
+                const COORD coordNextLine{ 0, gsl::narrow_cast<SHORT>(coordCursor.Y + 1) };
+                const auto Status = AdjustCursorPosition(screenInfo, coordNextLine, FALSE, nullptr);
+                if (!NT_SUCCESS(Status))
+                {
+                    return Status;
+                }
+            }
+        }
+
+        COORD coordCursor = cursor.GetPosition();
+        const SHORT lineWidth = textBuffer.GetLineWidth(coordCursor.Y);
+        if (coordCursor.X >= lineWidth)
+        {
+            break;
+        }
+
+        const auto written = textBuffer.WriteRun(text.substr(0, gsl::narrow_cast<size_t>(lineWidth) - coordCursor.X), attributes, coordCursor);
+        if (written == 0)
+        {
+            break;
+        }
+        text = text.substr(written);
+
+        const auto lastColumn = gsl::narrow_cast<SHORT>(coordCursor.X + written - 1);
+        screenInfo.NotifyAccessibilityEventing(coordCursor.X, coordCursor.Y, lastColumn, coordCursor.Y);
+
+        if (lastColumn + 1 >= lineWidth)
+        {
+            // Filled the line: stay on its last column until the next character wraps.
+            coordCursor.X = lastColumn;
+            cursor.SetPosition(coordCursor);
+            cursor.DelayEOLWrap(coordCursor);
+        }
+        else
+        {
+            coordCursor.X = lastColumn + 1;
+            const auto Status = AdjustCursorPosition(screenInfo, coordCursor, FALSE, nullptr);
+            if (!NT_SUCCESS(Status))
+            {
+                return Status;
+            }
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
 // Routine Description:
 // - This routine writes a string to the screen, processing any embedded
 //   unicode characters.  The string is also copied to the input buffer, if
@@ -969,6 +1063,11 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                 StateMachine& machine = screenInfo.GetStateMachine();
                 size_t const cch = BufferSize / sizeof(WCHAR);
 
+                // Color changes within this write are repainted once, at the end.
+                CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+                gci.BeginDeferColorRedraw();
+                auto endDefer = wil::scope_exit([&]() noexcept { gci.EndDeferColorRedraw(); });
+
                 machine.ProcessString({ pwchRealUnicode, cch });
                 *pcb += BufferSize;
             }
@@ -1004,7 +1103,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                                       bool requiresVtQuirk,
                                       std::unique_ptr<WriteData>& waiter)
 {
-    const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     if (WI_IsAnyFlagSet(gci.Flags, (CONSOLE_SUSPENDED | CONSOLE_SELECTING | CONSOLE_SCROLLBAR_TRACKING)))
     {
         try
@@ -1023,6 +1122,20 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         return CONSOLE_STATUS_WAIT;
     }
 
+    if (gci.IsInVtIoMode())
+    {
+        // In passthrough mode, the output goes straight to the terminal.
+        const auto hr = gci.GetVtIo()->WritePassthrough(screenInfo, { pwchBuffer, *pcbBuffer / sizeof(wchar_t) }, requiresVtQuirk);
+        if (hr == S_OK)
+        {
+            return STATUS_SUCCESS;
+        }
+        else if (FAILED(hr))
+        {
+            return NTSTATUS_FROM_HRESULT(hr);
+        }
+    }
+
     auto restoreVtQuirk{
         wil::scope_exit([&]() { screenInfo.ResetIgnoreLegacyEquivalentVTAttributes(); })
     };
@@ -1108,6 +1221,53 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
 // - S_OK if successful.
 // - S_OK if we need to wait (check if ppWaiter is not nullptr).
 // - Or a suitable HRESULT code for math/string/memory failures.
+// Routine Description:
+// - Converts the given text to Unicode without MultiByteToWideChar, if it's
+//   plain ASCII and the code page maps ASCII to the same code points.
+// - That's what most legacy tools write through the A APIs, and for it the
+//   conversion is a simple widening, which is done 16 bytes at a time.
+// Arguments:
+// - codepage - The output code page.
+// - buffer - The text written by the client.
+// - wstr - Receives the converted text, if the conversion was possible.
+// Return Value:
+// - true if buffer was converted into wstr.
+// - false if it has to go through the code page conversion instead.
+static bool _TryWidenAscii(const UINT codepage, const std::string_view buffer, std::wstring& wstr)
+{
+    // Most code pages (all the ANSI and OEM ones and the DBCS ones) map the
+    // first 128 bytes to ASCII, but a few like the EBCDIC ones don't.
+    // Checking that takes a call to MultiByteToWideChar, so we remember the
+    // result for the last code page. We're called under the console lock.
+    static UINT s_checkedCodepage{ CP_UTF8 };
+    static bool s_isAsciiCompatible{ false };
+    if (s_checkedCodepage != codepage)
+    {
+        std::array<char, 128> ascii{};
+        std::iota(ascii.begin(), ascii.end(), '\0');
+        std::array<wchar_t, 128> wide{};
+        const auto length = MultiByteToWideChar(codepage, 0, ascii.data(), gsl::narrow_cast<int>(ascii.size()), wide.data(), gsl::narrow_cast<int>(wide.size()));
+        s_isAsciiCompatible = length == gsl::narrow_cast<int>(ascii.size()) &&
+                              std::equal(ascii.begin(), ascii.end(), wide.begin(), [](const char ch, const wchar_t wch) {
+                                  return static_cast<wchar_t>(ch) == wch;
+                              });
+        s_checkedCodepage = codepage;
+    }
+
+    if (!s_isAsciiCompatible)
+    {
+        return false;
+    }
+
+    wstr.resize(buffer.size());
+    if (til::details::u8u16WidenAscii(buffer.data(), buffer.size(), wstr.data()) != buffer.size())
+    {
+        wstr.clear();
+        return false;
+    }
+    return true;
+}
+
 [[nodiscard]] HRESULT ApiRoutines::WriteConsoleAImpl(IConsoleOutputObject& context,
                                                      const std::string_view buffer,
                                                      size_t& read,
@@ -1133,6 +1293,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
+        auto asciiOnly{ false };
         std::wstring wstr{};
         static til::u8state u8State{};
 
@@ -1142,6 +1303,13 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             RETURN_IF_FAILED(til::u8u16(buffer, wstr, u8State));
             read = buffer.size();
         }
+        else if (screenInfo.WriteConsoleDbcsLeadByte[0] == 0 && _TryWidenAscii(codepage, buffer, wstr))
+        {
+            // ASCII is never a part of a DBCS character, unless there's
+            // a lead byte left over from a previous call, which we checked.
+            u8State.reset();
+            asciiOnly = true;
+        }
         else
         {
             // In case the codepage changes from UTF-8 to another,
@@ -1235,11 +1403,19 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                 size_t mbBufferRead{};
 
                 // Start by counting the number of A bytes we used in printing our W string to the screen.
-                try
+                // For ASCII, that's one byte per character.
+                if (asciiOnly)
                 {
-                    mbBufferRead = GetALengthFromW(codepage, { wstr.data(), wcBufferWritten });
+                    mbBufferRead = wcBufferWritten;
+                }
+                else
+                {
+                    try
+                    {
+                        mbBufferRead = GetALengthFromW(codepage, { wstr.data(), wcBufferWritten });
+                    }
+                    CATCH_LOG();
                 }
-                CATCH_LOG();
 
                 // If we captured a byte off the string this time around up above, it means we didn't feed
                 // it into the WriteConsoleW above, and therefore its consumption isn't accounted for
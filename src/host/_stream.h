@@ -77,6 +77,10 @@ Note:
                                         const DWORD dwFlags,
                                         _Inout_opt_ PSHORT const psScrollY);
 
+// Writes the leading printable text straight into the rows of a VT mode buffer.
+[[nodiscard]] NTSTATUS WritePrintableTextVt(SCREEN_INFORMATION& screenInfo,
+                                            std::wstring_view& text);
+
 // The new entry point for WriteChars to act as an intercept in case we place a Virtual Terminal processor in the way.
 [[nodiscard]] NTSTATUS WriteChars(SCREEN_INFORMATION& screenInfo,
                                   _In_range_(<=, pwchBuffer) const wchar_t* const pwchBufferBackupLimit,
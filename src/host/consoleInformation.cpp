@@ -266,6 +266,60 @@ std::pair<COLORREF, COLORREF> CONSOLE_INFORMATION::LookupAttributeColors(const T
                                    _blinkingState.IsBlinkingFaint());
 }
 
+// Routine Description:
+// - Repaints everything after the color table, the default colors or the
+//   screen reversal changed. While a chunk of VT output is being processed the
+//   repaint is postponed until the chunk is done, so that a stream of OSC 4
+//   sequences only invalidates the screen once.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CONSOLE_INFORMATION::TriggerColorRedraw()
+{
+    if (_colorRedrawDeferrals != 0)
+    {
+        _colorRedrawPending = true;
+        return;
+    }
+
+    auto& g = ServiceLocator::LocateGlobals();
+    if (g.pRender)
+    {
+        g.pRender->TriggerRedrawAll();
+    }
+}
+
+// Routine Description:
+// - Starts collecting color redraws. Must be paired with EndDeferColorRedraw.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CONSOLE_INFORMATION::BeginDeferColorRedraw() noexcept
+{
+    _colorRedrawDeferrals++;
+}
+
+// Routine Description:
+// - Stops collecting color redraws, and repaints once if any were requested
+//   since the outermost BeginDeferColorRedraw.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CONSOLE_INFORMATION::EndDeferColorRedraw() noexcept
+{
+    if (--_colorRedrawDeferrals == 0 && std::exchange(_colorRedrawPending, false))
+    {
+        try
+        {
+            TriggerColorRedraw();
+        }
+        CATCH_LOG();
+    }
+}
+
 // Method Description:
 // - Set the console's title, and trigger a renderer update of the title.
 //      This does not include the title prefix, such as "Mark", "Select", or "Scroll"
@@ -227,3 +227,116 @@ _Ret_range_(0, cbAnsi)
     delete[] TmpUni;
     return j;
 }
+
+// Routine Description:
+// - Returns the translation table for the given code page, creating it on first use.
+// - Tables are kept for the lifetime of the process since only a handful of code pages are ever used.
+// Arguments:
+// - codepage - The code page to translate into
+// Return Value:
+// - The cached table for that code page.
+OemTranslationTable& OemTranslationTable::ForCodePage(const UINT codepage)
+{
+    static std::unordered_map<UINT, std::unique_ptr<OemTranslationTable>> tables;
+
+    auto& table = tables[codepage];
+    if (!table)
+    {
+        table.reset(new OemTranslationTable(codepage));
+    }
+    return *table;
+}
+
+OemTranslationTable::OemTranslationTable(const UINT codepage) :
+    _codepage{ codepage },
+    _pages{}
+{
+    CPINFO cpInfo{};
+    if (GetCPInfo(codepage, &cpInfo) && cpInfo.MaxCharSize == 1)
+    {
+        _BuildSingleByteTable();
+    }
+}
+
+// Routine Description:
+// - Translates the whole UTF-16 range into a single byte code page, one page of 256 code units per call.
+//   A page never contains a high surrogate followed by a low one, so every code unit converts on its own
+//   exactly like a single cell would. If any page doesn't come back as 256 bytes, the flat table is
+//   dropped and lookups go through the paged table instead.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OemTranslationTable::_BuildSingleByteTable()
+{
+    auto table = std::make_unique<std::array<char, 0x10000>>();
+
+    std::array<wchar_t, 256> source;
+    for (size_t high = 0; high < _pages.size(); ++high)
+    {
+        for (size_t low = 0; low < source.size(); ++low)
+        {
+            source[low] = gsl::narrow_cast<wchar_t>((high << 8) | low);
+        }
+
+        const auto converted = ConvertToOem(_codepage,
+                                            source.data(),
+                                            gsl::narrow_cast<UINT>(source.size()),
+                                            table->data() + (high << 8),
+                                            gsl::narrow_cast<UINT>(source.size()));
+        if (converted != gsl::narrow_cast<int>(source.size()))
+        {
+            return;
+        }
+    }
+
+    _singleByte = std::move(table);
+}
+
+// Routine Description:
+// - Returns the page of translations that share the given high byte, translating it on first use.
+// Arguments:
+// - high - The high byte of the UTF-16 code units on the page
+// Return Value:
+// - The page of 256 translations.
+const OemTranslationTable::Page& OemTranslationTable::_GetPage(const BYTE high)
+{
+    auto& page = _pages.at(high);
+    if (!page)
+    {
+        auto newPage = std::make_unique<Page>();
+        for (size_t low = 0; low < newPage->size(); ++low)
+        {
+            const auto wch = gsl::narrow_cast<wchar_t>((high << 8) | low);
+            auto& entry = newPage->at(low);
+            entry.bytes[0] = 0;
+            entry.bytes[1] = 0;
+            entry.length = gsl::narrow_cast<BYTE>(ConvertToOem(_codepage, &wch, 1, &entry.bytes[0], ARRAYSIZE(entry.bytes)));
+        }
+        page = std::move(newPage);
+    }
+    return *page;
+}
+
+// Routine Description:
+// - Translates one UTF-16 code unit the same way ConvertToOem would when given only that code unit
+//   and a two byte target.
+// Arguments:
+// - wch - The code unit to translate
+// - bytes - Receives the translated bytes. The second byte is 0 when the translation is a single byte.
+// Return Value:
+// - The number of bytes the code unit translates into, or 0 if it can't be translated.
+size_t OemTranslationTable::Translate(const wchar_t wch, char (&bytes)[2])
+{
+    if (_singleByte)
+    {
+        bytes[0] = _singleByte->at(wch);
+        bytes[1] = 0;
+        return 1;
+    }
+
+    const auto& entry = _GetPage(gsl::narrow_cast<BYTE>(wch >> 8)).at(wch & 0xFF);
+    bytes[0] = entry.bytes[0];
+    bytes[1] = entry.bytes[1];
+    return entry.length;
+}
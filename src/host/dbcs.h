@@ -30,6 +30,38 @@ BYTE CodePageToCharSet(const UINT uiCodePage);
 
 BOOL IsAvailableEastAsianCodePage(const UINT uiCodePage);
 
+// Caches the Unicode to OEM translation of every UTF-16 code unit for one code page,
+// so the A APIs can convert buffer contents without a WideCharToMultiByte call per cell.
+// Callers must hold the console lock; tables are built on first use.
+class OemTranslationTable final
+{
+public:
+    static OemTranslationTable& ForCodePage(const UINT codepage);
+
+    size_t Translate(const wchar_t wch, char (&bytes)[2]);
+
+private:
+    struct Entry
+    {
+        char bytes[2];
+        BYTE length;
+    };
+
+    using Page = std::array<Entry, 256>;
+
+    explicit OemTranslationTable(const UINT codepage);
+
+    void _BuildSingleByteTable();
+    const Page& _GetPage(const BYTE high);
+
+    const UINT _codepage;
+    // For single byte code pages every code unit becomes exactly one byte, so one flat table covers them.
+    std::unique_ptr<std::array<char, 0x10000>> _singleByte;
+    // For double byte code pages the table is split by the high byte of the code unit,
+    // and each page of 256 entries is only translated once something on it is looked up.
+    std::array<std::unique_ptr<Page>, 256> _pages;
+};
+
 _Ret_range_(0, cbAnsi)
     ULONG TranslateUnicodeToOem(_In_reads_(cchUnicode) PCWCHAR pwchUnicode,
                                 const ULONG cchUnicode,
@@ -563,6 +563,8 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 // Routine Description:
 // - This is used when the app is reading output as cells and needs them converted
 //   into a particular codepage on the way out.
+// - Translations come from the cached table for the codepage, and the cells are rewritten in place
+//   since every cell is only ever written after it has been read.
 // Arguments:
 // - codepage - The relevant codepage for translation
 // - buffer - This is the buffer containing all of the character data to be converted
@@ -575,10 +577,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        std::vector<CHAR_INFO> tempBuffer(buffer.begin(), buffer.end());
+        auto& table = OemTranslationTable::ForCodePage(codepage);
 
         const auto size = rectangle.Dimensions();
-        auto tempIter = tempBuffer.cbegin();
         auto outIter = buffer.begin();
 
         for (int i = 0; i < size.Y; i++)
@@ -588,7 +589,7 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
                 // Any time we see the lead flag, we presume there will be a trailing one following it.
                 // Giving us two bytes of space (one per cell in the ascii part of the character union)
                 // to fill with whatever this Unicode character converts into.
-                if (WI_IsFlagSet(tempIter->Attributes, COMMON_LVB_LEADING_BYTE))
+                if (WI_IsFlagSet(outIter->Attributes, COMMON_LVB_LEADING_BYTE))
                 {
                     // As long as we're not looking at the exact last column of the buffer...
                     if (j < size.X - 1)
@@ -598,38 +599,39 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 
                         // Try to convert the unicode character (2 bytes) in the leading cell to the codepage.
                         CHAR AsciiDbcs[2] = { 0 };
-                        UINT NumBytes = gsl::narrow<UINT>(sizeof(AsciiDbcs));
-                        NumBytes = ConvertToOem(codepage, &tempIter->Char.UnicodeChar, 1, &AsciiDbcs[0], NumBytes);
+                        table.Translate(outIter->Char.UnicodeChar, AsciiDbcs);
 
                         // Fill the 1 byte (AsciiChar) portion of the leading and trailing cells with each of the bytes returned.
                         outIter->Char.AsciiChar = AsciiDbcs[0];
-                        outIter->Attributes = tempIter->Attributes;
                         outIter++;
-                        tempIter++;
                         outIter->Char.AsciiChar = AsciiDbcs[1];
-                        outIter->Attributes = tempIter->Attributes;
                         outIter++;
-                        tempIter++;
                     }
                     else
                     {
                         // When we're in the last column with only a leading byte, we can't return that without a trailing.
                         // Instead, replace the output data with just a space and clear all flags.
                         outIter->Char.AsciiChar = UNICODE_SPACE;
-                        outIter->Attributes = tempIter->Attributes;
                         WI_ClearAllFlags(outIter->Attributes, COMMON_LVB_SBCSDBCS);
                         outIter++;
-                        tempIter++;
                     }
                 }
-                else if (WI_AreAllFlagsClear(tempIter->Attributes, COMMON_LVB_SBCSDBCS))
+                else if (WI_AreAllFlagsClear(outIter->Attributes, COMMON_LVB_SBCSDBCS))
                 {
                     // If there are no leading/trailing pair flags, then we only have 1 ascii byte to try to fit the
                     // 2 byte UTF-16 character into. Give it a go.
-                    ConvertToOem(codepage, &tempIter->Char.UnicodeChar, 1, &outIter->Char.AsciiChar, 1);
-                    outIter->Attributes = tempIter->Attributes;
+                    const auto wch = outIter->Char.UnicodeChar;
+                    CHAR AsciiDbcs[2];
+                    if (table.Translate(wch, AsciiDbcs) == 1)
+                    {
+                        outIter->Char.AsciiChar = AsciiDbcs[0];
+                    }
+                    else
+                    {
+                        // Anything that doesn't fit in one byte keeps the exact result of converting into a 1 byte target.
+                        ConvertToOem(codepage, &wch, 1, &outIter->Char.AsciiChar, 1);
+                    }
                     outIter++;
-                    tempIter++;
                 }
             }
         }
@@ -786,7 +788,6 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -824,42 +825,22 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 
         // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
         const auto sourcePoint = clippedRequestRectangle.Origin();
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
 
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Every row of the clipped request is read straight into its place in the user's buffer.
+        // The cells of the user's buffer outside of the clipped request are left alone.
+        const auto targetLength = gsl::narrow_cast<size_t>(targetBuffer.size());
+        for (SHORT y = 0; y < clippedRequestRectangle.Height(); ++y)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
+            const auto targetOffset = gsl::narrow_cast<size_t>(targetPoint.Y + y) * targetSize.X + targetPoint.X;
+            if (targetOffset >= targetLength)
             {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
+                break;
             }
 
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
-
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
-            {
-                targetPos.X = 0;
-                targetPos.Y++;
-            }
+            const auto width = std::min(gsl::narrow_cast<size_t>(clippedRequestRectangle.Width()), targetLength - targetOffset);
+            const auto& row = textBuffer.GetRowByOffset(sourcePoint.Y + y);
+            row.ReadCharInfos(sourcePoint.X, targetBuffer.subspan(targetOffset, width));
         }
 
         // Reply with the region we read out of the backing buffer (potentially clipped)
@@ -878,6 +859,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // The buffer needs to be up to date, see VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
     try
     {
         const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -900,6 +884,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // The buffer needs to be up to date, see VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
     try
     {
         RETURN_IF_FAILED(_ReadConsoleOutputWImplHelper(context, buffer, sourceRectangle, readRectangle));
@@ -1006,12 +993,17 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Now we make a subspan starting from that offset for as much of the original request as would fit
             const auto subspan = buffer.subspan(totalOffset, writeRectangle.Width());
 
-            // Convert to a CHAR_INFO view to fit into the iterator
+            // Convert to a CHAR_INFO view and write it straight into the row at the target position.
             const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
+            const auto written = storageBuffer.GetTextBuffer().WriteCharInfos(charInfos, target);
 
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            // A leading byte that doesn't fit at the end of the row carries over
+            // onto the next one, just like any other write of cells would do it.
+            if (written < gsl::narrow_cast<size_t>(charInfos.size()))
+            {
+                OutputCellIterator it(charInfos.subspan(written));
+                storageBuffer.Write(it, { 0, gsl::narrow_cast<SHORT>(target.Y + 1) });
+            }
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
@@ -1030,6 +1022,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     try
     {
         const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -1051,6 +1046,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
     try
     {
         if (!context.GetActiveBuffer().GetCurrentFont().IsTrueTypeFont())
@@ -1080,6 +1078,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // The buffer needs to be up to date, see VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
     try
     {
         const auto attrs = ReadOutputAttributes(context.GetActiveBuffer(), origin, buffer.size());
@@ -1101,6 +1102,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // The buffer needs to be up to date, see VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
     try
     {
         const auto chars = ReadOutputStringA(context.GetActiveBuffer(),
@@ -1130,6 +1134,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // The buffer needs to be up to date, see VtIo::WritePassthrough.
+    ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
     try
     {
         const auto chars = ReadOutputStringW(context.GetActiveBuffer(),
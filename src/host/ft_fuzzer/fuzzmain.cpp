@@ -13,6 +13,10 @@
 #include "../getset.h"
 #include <til/u8u16convert.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 struct NullDeviceComm : public IDeviceComm
 {
     HRESULT SetServerInformation(CD_IO_SERVER_INFORMATION* const) const override
@@ -117,6 +121,131 @@ extern "C" __declspec(dllexport) HRESULT RunConhost()
     return hr;
 }
 
+static void WriteToConsole(const std::wstring_view text)
+{
+    auto& gci = Microsoft::Console::Interactivity::ServiceLocator::LocateGlobals().getConsoleInformation();
+
+    SHORT scrollY{};
+    size_t sizeInBytes{ text.size() * 2 };
+    gci.LockConsole();
+    auto u = wil::scope_exit([&]() { gci.UnlockConsole(); });
+    (void)WriteCharsLegacy(gci.GetActiveOutputBuffer(),
+                           text.data(),
+                           text.data(),
+                           text.data(),
+                           &sizeInBytes,
+                           nullptr,
+                           0,
+                           WC_PRINTABLE_CONTROL_CHARS | WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE,
+                           &scrollY);
+}
+
+// The throughput mode looks for inputs that are slow for their size, like
+// huge parameter counts or giant OSC strings, instead of crashes. It's
+// enabled by pointing CONHOST_FUZZ_SLOW_INPUTS at a directory. Every input
+// that's processed SlowFactor times slower than the running baseline is
+// minimized and saved there as UTF-8, which is the format the perf tests
+// replay as regression benchmarks:
+//   te.exe Terminal.Core.Unit.Tests.dll /name:*RecordedCapturesThroughput* /p:VtCaptureDirectory=<directory>
+namespace throughput
+{
+    static constexpr double SlowFactor = 10.0;
+    // Short inputs are written over and over until this much time has
+    // passed, as a single write would be too quick to be measured.
+    static constexpr std::chrono::microseconds MinMeasureTime{ 500 };
+    // The baseline is a moving average of the time per character, which
+    // isn't compared against until WarmupInputs have gone into it.
+    static constexpr double BaselineWeight = 1.0 / 64;
+    static constexpr size_t WarmupInputs = 64;
+    // Minimizing measures the input once per step, so it's cut off at some point.
+    static constexpr size_t MaxMinimizeSteps = 256;
+
+    static std::filesystem::path s_directory;
+    static double s_baseline = 0;
+    static size_t s_inputs = 0;
+
+    static void Initialize()
+    {
+        std::wstring directory(MAX_PATH, L'\0');
+        const auto length = GetEnvironmentVariableW(L"CONHOST_FUZZ_SLOW_INPUTS", directory.data(), gsl::narrow_cast<DWORD>(directory.size()));
+        if (length != 0 && length < directory.size())
+        {
+            directory.resize(length);
+            s_directory = directory;
+            std::filesystem::create_directories(s_directory);
+        }
+    }
+
+    // Returns the time it takes to write the text, in nanoseconds per character.
+    static double Measure(const std::wstring_view text)
+    {
+        size_t repetitions = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        do
+        {
+            WriteToConsole(text);
+            ++repetitions;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < MinMeasureTime);
+
+        const auto nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+        return nanoseconds / static_cast<double>(repetitions * text.size());
+    }
+
+    // Cuts out every part of the text it can while it's still at least as
+    // slow as the threshold, from halves down to single characters.
+    static std::wstring Minimize(std::wstring text, const double threshold)
+    {
+        size_t steps = 0;
+        for (auto chunk = text.size() / 2; chunk != 0 && steps < MaxMinimizeSteps; chunk /= 2)
+        {
+            for (size_t offset = 0; offset < text.size() && steps < MaxMinimizeSteps; ++steps)
+            {
+                auto candidate = text;
+                candidate.erase(offset, chunk);
+                if (!candidate.empty() && Measure(candidate) >= threshold)
+                {
+                    text = std::move(candidate);
+                }
+                else
+                {
+                    offset += chunk;
+                }
+            }
+        }
+        return text;
+    }
+
+    static void Save(const std::wstring_view text, const double nanosecondsPerChar)
+    {
+        const auto name = fmt::format(L"slow-{:016x}.txt", std::hash<std::wstring_view>{}(text));
+        const auto path = s_directory / name;
+        std::ofstream file{ path, std::ios::binary };
+        const auto bytes = til::u16u8(text);
+        file.write(bytes.data(), bytes.size());
+
+        fwprintf(stderr, L"Slow input (%.1f ns/char, baseline %.1f ns/char): %s\n", nanosecondsPerChar, s_baseline, path.c_str());
+    }
+
+    static void Run(const std::wstring_view text)
+    {
+        const auto nanosecondsPerChar = Measure(text);
+
+        const auto threshold = s_baseline * SlowFactor;
+        if (s_inputs >= WarmupInputs && nanosecondsPerChar >= threshold)
+        {
+            const auto minimized = Minimize(std::wstring{ text }, threshold);
+            Save(minimized, Measure(minimized));
+            return;
+        }
+
+        // Slow inputs are kept out of the baseline, so they can't drag it along.
+        ++s_inputs;
+        s_baseline = s_inputs == 1 ? nanosecondsPerChar : s_baseline + (nanosecondsPerChar - s_baseline) * BaselineWeight;
+    }
+}
+
 #ifdef FUZZING_BUILD
 extern "C" __declspec(dllexport) int LLVMFuzzerInitialize(int* /*argc*/, char*** /*argv*/)
 #else
@@ -124,26 +253,25 @@ int main(int /*argc*/, char** /*argv*/)
 #endif
 {
     RETURN_IF_FAILED(RunConhost());
+    throughput::Initialize();
     return 0;
 }
 
 extern "C" __declspec(dllexport) int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 {
-    auto& gci = Microsoft::Console::Interactivity::ServiceLocator::LocateGlobals().getConsoleInformation();
-
     const auto u16String{ til::u8u16(std::string_view{ reinterpret_cast<const char*>(data), size }) };
-    SHORT scrollY{};
-    size_t sizeInBytes{ u16String.size() * 2 };
-    gci.LockConsole();
-    auto u = wil::scope_exit([&]() { gci.UnlockConsole(); });
-    (void)WriteCharsLegacy(gci.GetActiveOutputBuffer(),
-                           u16String.data(),
-                           u16String.data(),
-                           u16String.data(),
-                           &sizeInBytes,
-                           nullptr,
-                           0,
-                           WC_PRINTABLE_CONTROL_CHARS | WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE,
-                           &scrollY);
+    if (u16String.empty())
+    {
+        return 0;
+    }
+
+    if (throughput::s_directory.empty())
+    {
+        WriteToConsole(u16String);
+    }
+    else
+    {
+        throughput::Run(u16String);
+    }
     return 0;
 }
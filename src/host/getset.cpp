@@ -111,6 +111,9 @@ void ApiRoutines::GetConsoleScreenBufferInfoExImpl(const SCREEN_INFORMATION& con
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // The buffer needs to be up to date, see VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->SyncPassthroughBuffer();
+
         data.bFullscreenSupported = FALSE; // traditional full screen with the driver support is no longer supported.
         // see MSFT: 19918103
         // Make sure to use the active buffer here. There are clients that will
@@ -460,6 +463,9 @@ void ApiRoutines::SetConsoleActiveScreenBufferImpl(SCREEN_INFORMATION& newContex
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         SetActiveScreenBuffer(newContext.GetActiveBuffer());
     }
     CATCH_LOG();
@@ -516,6 +522,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         SCREEN_INFORMATION& screenInfo = context.GetActiveBuffer();
 
         // microsoft/terminal#3907 - We shouldn't resize the buffer to be
@@ -586,6 +595,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         Globals& g = ServiceLocator::LocateGlobals();
         CONSOLE_INFORMATION& gci = g.getConsoleInformation();
 
@@ -689,6 +701,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
         auto& buffer = context.GetActiveBuffer();
@@ -800,6 +815,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         Globals& g = ServiceLocator::LocateGlobals();
         SMALL_RECT Window = windowRect;
 
@@ -909,6 +927,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         auto& buffer = context.GetActiveBuffer();
 
         TextAttribute useThisAttr(fillAttribute);
@@ -964,6 +985,9 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+        // This changes the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
         RETURN_HR_IF(E_INVALIDARG, WI_IsAnyFlagSet(attribute, ~VALID_TEXT_ATTRIBUTES));
 
         const TextAttribute attr{ attribute };
@@ -1312,11 +1336,7 @@ void DoSrvPrivateEnableWin32InputMode(const bool win32InputMode)
         CONSOLE_INFORMATION& gci = g.getConsoleInformation();
 
         gci.SetScreenReversed(reverseMode);
-
-        if (g.pRender)
-        {
-            g.pRender->TriggerRedrawAll();
-        }
+        gci.TriggerColorRedraw();
 
         return STATUS_SUCCESS;
     }
@@ -2104,9 +2124,9 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
 
         // Update the screen colors if we're not a pty
         // No need to force a redraw in pty mode.
-        if (g.pRender && !gci.IsInVtIoMode())
+        if (!gci.IsInVtIoMode())
         {
-            g.pRender->TriggerRedrawAll();
+            gci.TriggerColorRedraw();
         }
 
         return S_OK;
@@ -2131,9 +2151,9 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
 
         // Update the screen colors if we're not a pty
         // No need to force a redraw in pty mode.
-        if (g.pRender && !gci.IsInVtIoMode())
+        if (!gci.IsInVtIoMode())
         {
-            g.pRender->TriggerRedrawAll();
+            gci.TriggerColorRedraw();
         }
 
         return S_OK;
@@ -2158,9 +2178,9 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
 
         // Update the screen colors if we're not a pty
         // No need to force a redraw in pty mode.
-        if (g.pRender && !gci.IsInVtIoMode())
+        if (!gci.IsInVtIoMode())
         {
-            g.pRender->TriggerRedrawAll();
+            gci.TriggerColorRedraw();
         }
 
         return S_OK;
@@ -2206,12 +2226,42 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        const auto bufferSize = screenInfo.GetBufferSize();
+        const auto width = gsl::narrow_cast<size_t>(bufferSize.Width());
+        auto position = startPosition;
+        auto remaining = fillLength;
+
+        // Erasing whole rows only marks them as blank (see TextBuffer::ClearRows),
+        // which keeps clearing the screen or the scrollback of a large buffer
+        // from taking a noticeable moment. What's left of the first and last
+        // rows is written out as usual.
+        if (fillChar == UNICODE_SPACE && bufferSize.IsInBounds(position))
+        {
+            if (position.X != 0)
+            {
+                const auto length = std::min(remaining, width - position.X);
+                screenInfo.Write(OutputCellIterator{ fillChar, fillAttrs, length }, position, false);
+                remaining -= length;
+                position.X = 0;
+                position.Y++;
+            }
+
+            const auto rows = std::min(remaining / width, gsl::narrow_cast<size_t>(bufferSize.Height() - position.Y));
+            if (rows != 0)
+            {
+                screenInfo.GetTextBuffer().ClearRows(position.Y, rows, fillAttrs);
+                remaining -= rows * width;
+                position.Y += gsl::narrow_cast<SHORT>(rows);
+            }
+        }
+
+        if (remaining != 0 && bufferSize.IsInBounds(position))
+        {
+            screenInfo.Write(OutputCellIterator{ fillChar, fillAttrs, remaining }, position, false);
+        }
 
         // Notify accessibility
         auto endPosition = startPosition;
-        const auto bufferSize = screenInfo.GetBufferSize();
         bufferSize.MoveInBounds(fillLength - 1, endPosition);
         screenInfo.NotifyAccessibilityEventing(startPosition.X, startPosition.Y, endPosition.X, endPosition.Y);
         return S_OK;
@@ -56,6 +56,10 @@ public:
     int dpi = USER_DEFAULT_SCREEN_DPI;
     ULONG cursorPixelWidth = 1;
 
+    // Bumped by the window whenever the monitor, DPI or frame it's measured against may have changed,
+    // so sizes derived from window metrics know to be recomputed.
+    std::atomic<ULONG> windowMetricsVersion{ 0 };
+
     NTSTATUS ntstatusConsoleInputInitStatus;
     wil::unique_event_nothrow hConsoleInputInitEvent;
     DWORD dwInputThreadId;
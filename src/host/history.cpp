@@ -112,7 +112,7 @@ void CommandHistory::_Reset()
         {
             std::wstring reuse{};
 
-            if (suppressDuplicates)
+            if (suppressDuplicates && _commandCounts.find(s_FoldCase(newCommand)) != _commandCounts.end())
             {
                 SHORT index;
                 if (FindMatchingCommand(newCommand, LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch))
@@ -124,6 +124,7 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
+                _TrackCommand(_commands.front(), false);
                 _commands.erase(_commands.cbegin());
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
@@ -139,6 +140,7 @@ void CommandHistory::_Reset()
             {
                 _commands.emplace_back(newCommand);
             }
+            _TrackCommand(_commands.back(), true);
 
             if (LastDisplayed == -1 ||
                 _commands.at(LastDisplayed).size() != newCommand.size() ||
@@ -249,6 +251,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _commandCounts.clear();
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
 }
@@ -290,6 +293,7 @@ void CommandHistory::Realloc(const size_t commands)
     {
         _commands.emplace_back(oldCommands[i]);
     }
+    _RetrackCommands();
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -392,6 +396,7 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         if (!SameApp)
         {
             BestCandidate->_commands.clear();
+            BestCandidate->_commandCounts.clear();
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
         }
@@ -471,6 +476,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     try
     {
         const auto str = _commands.at(iDel);
+        _TrackCommand(str, false);
 
         if (iDel < iLast)
         {
@@ -552,6 +558,48 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     return false;
 }
 
+// Routine Description:
+// - Folds the case of a command the way CaseInsensitiveEquality compares it.
+// Arguments:
+// - command - The command to fold.
+// Return Value:
+// - The command in lower case.
+std::wstring CommandHistory::s_FoldCase(const std::wstring_view command)
+{
+    std::wstring folded{ command };
+    std::transform(folded.begin(), folded.end(), folded.begin(), ::towlower);
+    return folded;
+}
+
+// Routine Description:
+// - Counts a command that was added to or removed from _commands.
+// Arguments:
+// - command - The command.
+// - added - true if the command was added, false if it was removed.
+void CommandHistory::_TrackCommand(const std::wstring_view command, const bool added)
+{
+    auto folded = s_FoldCase(command);
+    if (added)
+    {
+        ++_commandCounts[std::move(folded)];
+    }
+    else if (const auto it = _commandCounts.find(folded); it != _commandCounts.end() && --it->second == 0)
+    {
+        _commandCounts.erase(it);
+    }
+}
+
+// Routine Description:
+// - Counts all commands in _commands again, after they were replaced wholesale.
+void CommandHistory::_RetrackCommands()
+{
+    _commandCounts.clear();
+    for (const auto& command : _commands)
+    {
+        _TrackCommand(command, true);
+    }
+}
+
 #ifdef UNIT_TESTING
 void CommandHistory::s_ClearHistoryListStorage()
 {
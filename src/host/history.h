@@ -83,9 +83,18 @@ private:
     void _Dec(SHORT& ind) const;
     void _Inc(SHORT& ind) const;
 
+    static std::wstring s_FoldCase(const std::wstring_view command);
+    void _TrackCommand(const std::wstring_view command, const bool added);
+    void _RetrackCommands();
+
     std::vector<std::wstring> _commands;
     SHORT _maxCommands;
 
+    // How often each command occurs in _commands, compared the way
+    // FindMatchingCommand does for MatchOptions::ExactMatch. Lets Add skip
+    // the search for a duplicate if there is none, which is the usual case.
+    std::unordered_map<std::wstring, size_t> _commandCounts;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
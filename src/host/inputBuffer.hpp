@@ -30,6 +30,79 @@ Revision History:
 
 #include <deque>
 
+// A queue of input records, stored back to back in a ring that only ever grows.
+// Unlike a deque of events, storing a record doesn't allocate anything once
+// the ring is large enough, and records can be updated in place.
+class InputRecordRing final
+{
+public:
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    INPUT_RECORD& operator[](const size_t index) noexcept
+    {
+        return til::at(_records, (_head + index) & (_records.size() - 1));
+    }
+
+    const INPUT_RECORD& operator[](const size_t index) const noexcept
+    {
+        return til::at(_records, (_head + index) & (_records.size() - 1));
+    }
+
+    INPUT_RECORD& front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    INPUT_RECORD& back() noexcept
+    {
+        return (*this)[_size - 1];
+    }
+
+    const INPUT_RECORD& front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    const INPUT_RECORD& back() const noexcept
+    {
+        return (*this)[_size - 1];
+    }
+
+    void push_back(const INPUT_RECORD& record);
+    void pop_front() noexcept;
+    void clear() noexcept;
+
+    template<typename Predicate>
+    void remove_if(Predicate&& predicate)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < _size; ++i)
+        {
+            if (!predicate((*this)[i]))
+            {
+                (*this)[kept++] = (*this)[i];
+            }
+        }
+        _size = kept;
+    }
+
+private:
+    void _Grow();
+
+    // The capacity is always a power of two, so that indices wrap with a mask.
+    std::vector<INPUT_RECORD> _records;
+    size_t _head = 0;
+    size_t _size = 0;
+};
+
 class InputBuffer final : public ConsoleObjectHeader
 {
 public:
@@ -81,7 +154,7 @@ public:
     void PassThroughWin32MouseRequest(bool enable);
 
 private:
-    std::deque<std::unique_ptr<IInputEvent>> _storage;
+    InputRecordRing _storage;
     std::unique_ptr<IInputEvent> _readPartialByteSequence;
     std::unique_ptr<IInputEvent> _writePartialByteSequence;
     Microsoft::Console::VirtualTerminal::TerminalInput _termInput;
@@ -105,9 +178,11 @@ private:
                       _Out_ size_t& eventsWritten,
                       _Out_ bool& setWaitEvent);
 
-    bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
-    bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    void _WriteRecord(const INPUT_RECORD& record, const bool coalesce);
+
+    bool _CanCoalesce(const KEY_EVENT_RECORD& a, const KEY_EVENT_RECORD& b) const noexcept;
+    bool _CoalesceMouseMovedEvents(const INPUT_RECORD& inRecord) noexcept;
+    bool _CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& inRecord) noexcept;
     void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
     void _HandleTerminalInputCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
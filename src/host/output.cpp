@@ -92,23 +92,33 @@ static void _CopyRectangle(SCREEN_INFORMATION& screenInfo,
         }
     }
 
-    // 2. We can move any other scenario in-place without copying. We just have to carefully
-    //    choose which direction we walk through filling up the target so it doesn't accidentally
-    //    erase the source material before it can be copied/moved to the new location.
+    // 2. Any other scenario is moved one row at a time. Each row of the source is read
+    //    in full before it's written to the target, so the source and the target are
+    //    free to overlap within a row. We just have to walk the rows away from the target
+    //    so that we don't overwrite any source rows before they've been moved.
     {
         const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
-        const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
+        const auto moveDown = target.Top() > source.Top();
 
-        auto sourcePos = source.GetWalkOrigin(walkDirection);
-        auto targetPos = target.GetWalkOrigin(walkDirection);
+        std::vector<OutputCell> cells;
+        cells.reserve(source.Width());
 
-        do
+        for (SHORT i = 0; i < source.Height(); ++i)
         {
-            const auto data = OutputCell(*screenInfo.GetCellDataAt(sourcePos));
-            screenInfo.Write(OutputCellIterator({ &data, 1 }), targetPos);
+            const auto offset = gsl::narrow_cast<SHORT>(moveDown ? source.Height() - 1 - i : i);
+            const COORD sourcePos{ source.Left(), gsl::narrow_cast<SHORT>(source.Top() + offset) };
+            const auto sourceRow = Viewport::FromDimensions(sourcePos, source.Width(), 1);
 
-            source.WalkInBounds(sourcePos, walkDirection);
-        } while (target.WalkInBounds(targetPos, walkDirection));
+            cells.clear();
+            for (auto it = screenInfo.GetCellDataAt(sourcePos, sourceRow); it; ++it)
+            {
+                cells.emplace_back(*it);
+            }
+
+            const COORD targetPos{ target.Left(), gsl::narrow_cast<SHORT>(target.Top() + offset) };
+            const auto targetRow = Viewport::FromDimensions(targetPos, target.Width(), 1);
+            screenInfo.WriteRect(OutputCellIterator(cells), targetRow);
+        }
     }
 }
 
@@ -261,6 +271,51 @@ void ScreenBufferSizeChange(const COORD coordNewSize)
     }
 }
 
+// Routine Description:
+// - Checks whether a copy and fill moved whole rows up or down within a region
+//   and blanked the rows that were revealed, which is what a scroll within the
+//   margins does (IL, DL, SU and SD). Renderers can move the rows they already
+//   show in that case, instead of repainting all of them.
+// Arguments:
+// - source - The viewport describing the region where data was copied from
+// - fill - The viewport describing the area that was filled in with the fill character
+// - target - The viewport describing the region where data was copied to
+// - bufferWidth - The width of the screen buffer
+// Return Value:
+// - The region whose rows were moved, and the distance they were moved by,
+//   or nullopt if the rows weren't moved like that.
+static std::optional<std::pair<Viewport, SHORT>> _GetRowScroll(const Viewport& source,
+                                                                const Viewport& fill,
+                                                                const Viewport& target,
+                                                                const SHORT bufferWidth) noexcept
+{
+    const auto isFullWidth = [=](const Viewport& view) noexcept {
+        return view.Left() == 0 && view.Width() == bufferWidth;
+    };
+    if (!isFullWidth(source) || !isFullWidth(fill) || !isFullWidth(target) || source.Top() == target.Top())
+    {
+        return std::nullopt;
+    }
+
+    const auto top = std::min(fill.Top(), target.Top());
+    const auto bottom = std::max(fill.BottomExclusive(), target.BottomExclusive());
+    const auto delta = gsl::narrow_cast<SHORT>(target.Top() - source.Top());
+
+    // The rows that are moved have to end up exactly where the region
+    // leaves them, and all the others have to have been filled.
+    const auto movedTop = std::max(top, gsl::narrow_cast<SHORT>(top + delta));
+    const auto movedBottom = std::min(bottom, gsl::narrow_cast<SHORT>(bottom + delta));
+    const auto revealedTop = delta > 0 ? top : movedBottom;
+    const auto revealedBottom = delta > 0 ? movedTop : bottom;
+    if (target.Top() != movedTop || target.BottomExclusive() != movedBottom ||
+        fill.Top() > revealedTop || fill.BottomExclusive() < revealedBottom)
+    {
+        return std::nullopt;
+    }
+
+    return std::pair{ Viewport::FromExclusive({ 0, top, bufferWidth, bottom }), delta };
+}
+
 // Routine Description:
 // - This is simply a notifier method to let accessibility and renderers know that a region of the buffer
 //   has been copied/moved to another location in a block fashion.
@@ -283,6 +338,12 @@ static void _ScrollScreen(SCREEN_INFORMATION& screenInfo, const Viewport& source
     // Get the render target and send it commands.
     // It will figure out whether or not we're active and where the messages need to go.
     auto& render = screenInfo.GetRenderTarget();
+    // If whole rows were moved, the renderers may move what they already show.
+    if (const auto scroll = _GetRowScroll(source, fill, target, screenInfo.GetBufferSize().Width()))
+    {
+        render.TriggerScrollRegion(scroll->first, scroll->second);
+        return;
+    }
     // Redraw anything in the target area
     render.TriggerRedraw(target);
     // Also redraw anything that was filled.
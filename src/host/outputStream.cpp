@@ -74,17 +74,26 @@ void WriteBuffer::_DefaultCase(const wchar_t wch)
 // - <none>
 void WriteBuffer::_DefaultStringCase(const std::wstring_view string)
 {
-    size_t dwNumBytes = string.size() * sizeof(wchar_t);
-
-    _io.GetActiveOutputBuffer().GetTextBuffer().GetCursor().SetIsOn(true);
-
-    _ntstatus = WriteCharsLegacy(_io.GetActiveOutputBuffer(),
-                                 string.data(),
-                                 string.data(),
-                                 string.data(),
+    auto& screenInfo = _io.GetActiveOutputBuffer();
+    screenInfo.GetTextBuffer().GetCursor().SetIsOn(true);
+
+    // Plain text goes straight into the rows. Only what's left after that
+    // (controls, wide glyphs, etc.) needs the legacy per character handling.
+    auto remaining = string;
+    _ntstatus = WritePrintableTextVt(screenInfo, remaining);
+    if (!NT_SUCCESS(_ntstatus) || remaining.empty())
+    {
+        return;
+    }
+
+    size_t dwNumBytes = remaining.size() * sizeof(wchar_t);
+    _ntstatus = WriteCharsLegacy(screenInfo,
+                                 remaining.data(),
+                                 remaining.data(),
+                                 remaining.data(),
                                  &dwNumBytes,
                                  nullptr,
-                                 _io.GetActiveOutputBuffer().GetTextBuffer().GetCursor().GetPosition().X,
+                                 screenInfo.GetTextBuffer().GetCursor().GetPosition().X,
                                  WC_LIMIT_BACKSPACE | WC_DELAY_EOL_WRAP,
                                  nullptr);
 }
@@ -130,6 +139,23 @@ bool ConhostInternalGetSet::SetConsoleCursorPosition(const COORD position)
     return SUCCEEDED(ServiceLocator::LocateGlobals().api.SetConsoleCursorPositionImpl(info, clampedPosition));
 }
 
+// Method Description:
+// - Retrieves the cursor position of the active screen buffer, relative to
+//   the top of its viewport. Unlike GetConsoleScreenBufferInfoEx, this
+//   doesn't need to gather the rest of the buffer information (nor sync the
+//   passthrough buffer), which makes it cheap enough for DECSC.
+// Arguments:
+// - position: Receives the cursor position.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateGetViewportCursorPosition(COORD& position) const
+{
+    const auto& info = _io.GetActiveOutputBuffer();
+    position = info.GetTextBuffer().GetCursor().GetPosition();
+    position.Y -= info.GetViewport().Top();
+    return true;
+}
+
 // Method Description:
 // - Retrieves the current TextAttribute of the active screen buffer.
 // Arguments:
@@ -210,6 +236,14 @@ bool ConhostInternalGetSet::PrivateWriteConsoleInputW(std::deque<std::unique_ptr
 {
     eventsWritten = 0;
 
+    // The terminal has already answered any queries that are replayed from
+    // the passthrough journal, so their responses would only be duplicates.
+    if (ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->IsReplayingPassthrough())
+    {
+        eventsWritten = events.size();
+        return true;
+    }
+
     return SUCCEEDED(DoSrvPrivateWriteConsoleInputW(_io.GetActiveInputBuffer(),
                                                     events,
                                                     eventsWritten,
@@ -515,6 +549,19 @@ bool ConhostInternalGetSet::PrivateEnableAlternateScroll(const bool enabled)
     return true;
 }
 
+// Routine Description:
+// - Connects the PrivateSetSynchronizedOutput call directly into the renderer
+//   of the active screen buffer. It holds back its frames while enabled.
+// Arguments:
+// - enabled - true when the application begins a frame, false when it ends it.
+// Return Value:
+// - true.
+bool ConhostInternalGetSet::PrivateSetSynchronizedOutput(const bool enabled)
+{
+    _io.GetActiveOutputBuffer().GetRenderTarget().SetSynchronizedOutput(enabled);
+    return true;
+}
+
 // Routine Description:
 // - Connects the PrivateEraseAll call directly into our Driver Message servicing call inside Conhost.exe
 //   PrivateEraseAll is an internal-only "API" call that the vt commands can execute,
@@ -801,3 +848,33 @@ bool ConhostInternalGetSet::PrivateEndHyperlink() const
     DoSrvEndHyperlink(_io.GetActiveOutputBuffer());
     return true;
 }
+
+// Method Description:
+// - Marks the position of the cursor in the active buffer, see TextBuffer::AddMark.
+// Arguments:
+// - kind - what's marked
+// - exitCode - the exit code of the command, if it finished
+// Return Value:
+// - true
+bool ConhostInternalGetSet::PrivateAddMark(const MarkKind kind, const std::optional<unsigned int> exitCode)
+{
+    auto& textBuffer = _io.GetActiveOutputBuffer().GetTextBuffer();
+    textBuffer.AddMark(textBuffer.GetCursor().GetPosition(), kind, exitCode);
+    return true;
+}
+
+// Method Description:
+// - Puts a slice of an image into the row of the cursor, starting at its
+//   column, see TextBuffer::WriteImageSlice.
+// Arguments:
+// - cellSize - the number of pixels per cell
+// - pixels - cellSize.height() rows of pixelWidth premultiplied BGRA pixels
+// - pixelWidth - the width of the slice in pixels
+// Return Value:
+// - true
+bool ConhostInternalGetSet::PrivateWriteImageSlice(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth)
+{
+    auto& textBuffer = _io.GetActiveOutputBuffer().GetTextBuffer();
+    textBuffer.WriteImageSlice(textBuffer.GetCursor().GetPosition(), cellSize, pixels, pixelWidth);
+    return true;
+}
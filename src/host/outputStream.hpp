@@ -58,6 +58,7 @@ public:
     bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) override;
 
     bool SetConsoleCursorPosition(const COORD position) override;
+    bool PrivateGetViewportCursorPosition(COORD& position) const override;
 
     bool PrivateGetTextAttributes(TextAttribute& attrs) const override;
     bool PrivateSetTextAttributes(const TextAttribute& attrs) override;
@@ -103,6 +104,7 @@ public:
     bool PrivateEnableButtonEventMouseMode(const bool enabled) override;
     bool PrivateEnableAnyEventMouseMode(const bool enabled) override;
     bool PrivateEnableAlternateScroll(const bool enabled) override;
+    bool PrivateSetSynchronizedOutput(const bool enabled) override;
     bool PrivateEraseAll() override;
 
     bool GetUserDefaultCursorStyle(CursorType& style) override;
@@ -147,6 +149,9 @@ public:
     bool PrivateAddHyperlink(const std::wstring_view uri, const std::wstring_view params) const override;
     bool PrivateEndHyperlink() const override;
 
+    bool PrivateAddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) override;
+    bool PrivateWriteImageSlice(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth) override;
+
 private:
     Microsoft::Console::IIoProvider& _io;
 };
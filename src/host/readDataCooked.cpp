@@ -454,6 +454,58 @@ bool COOKED_READ_DATA::AtEol() const noexcept
     return Status;
 }
 
+// Routine Description:
+// - Writes the command line from the given character to its end, starting at
+//   the cursor, which has to be where that character goes. Whatever the
+//   previous, longer command line left behind its new end is blanked out.
+// Arguments:
+// - editPosition - Index of the first character to write.
+// - dwFlags - Flags for WriteCharsLegacy.
+// - scrollY - Receives how far writing scrolled the buffer.
+// Return Value:
+// - STATUS_SUCCESS or the failure from WriteCharsLegacy.
+[[nodiscard]] NTSTATUS COOKED_READ_DATA::_writeFromEditPosition(const size_t editPosition,
+                                                                const DWORD dwFlags,
+                                                                SHORT& scrollY) noexcept
+{
+    const auto width = _screenInfo.GetBufferSize().Width();
+    const auto cursorPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
+
+    // Cells taken up by the part of the command line in front of the edit.
+    const auto prefixCells = gsl::narrow_cast<ptrdiff_t>(cursorPosition.Y - _originalCursorPosition.Y) * width +
+                             (cursorPosition.X - _originalCursorPosition.X);
+
+    size_t NumToWrite = _bytesRead - editPosition * sizeof(WCHAR);
+    size_t suffixCells = 0;
+    const auto status = WriteCharsLegacy(_screenInfo,
+                                         _backupLimit,
+                                         _backupLimit + editPosition,
+                                         _backupLimit + editPosition,
+                                         &NumToWrite,
+                                         &suffixCells,
+                                         _originalCursorPosition.X,
+                                         dwFlags,
+                                         &scrollY);
+    if (!NT_SUCCESS(status))
+    {
+        return status;
+    }
+
+    const auto previousCells = _visibleCharCount;
+    _visibleCharCount = gsl::narrow_cast<size_t>(std::max<ptrdiff_t>(prefixCells, 0)) + suffixCells;
+    if (_visibleCharCount < previousCells)
+    {
+        try
+        {
+            const auto end = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
+            _screenInfo.Write(OutputCellIterator(UNICODE_SPACE, previousCells - _visibleCharCount), end);
+        }
+        CATCH_LOG();
+    }
+
+    return STATUS_SUCCESS;
+}
+
 void COOKED_READ_DATA::ProcessAliases(DWORD& lineCount)
 {
     Alias::s_MatchAndCopyAliasLegacy(_backupLimit,
@@ -579,12 +631,15 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
         bool CallWrite = true;
         const SHORT sScreenBufferSizeX = _screenInfo.GetBufferSize().Width();
 
+        // The first character whose position on the screen might have changed.
+        // The cursor is on it when we write the new command line.
+        size_t editPosition = 0;
+
         // processing in the middle of the line is more complex:
 
         // calculate new cursor position
         // store new char
-        // clear the current command line from the screen
-        // write the new command line to the screen
+        // write the changed rest of the command line to the screen
         // update the cursor position
 
         if (wch == UNICODE_BACKSPACE && _processedInput)
@@ -642,6 +697,8 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
                         loop = true;
                     }
                 }
+
+                editPosition = _currentPosition;
             }
             else
             {
@@ -686,6 +743,7 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
                 *_bufPtr = wch;
                 _bufPtr += 1;
                 _currentPosition += 1;
+                editPosition = _currentPosition - 1;
 
                 // calculate new cursor position
                 if (_echoInput)
@@ -707,29 +765,35 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
             CursorPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
             CursorPosition.X = (SHORT)(CursorPosition.X + NumSpaces);
 
-            // clear the current command line from the screen
-            // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
-            // clang-format on
-            DeleteCommandLine(*this, FALSE);
-
-            // write the new command line to the screen
-            NumToWrite = _bytesRead;
-
             DWORD dwFlags = WC_DESTRUCTIVE_BACKSPACE | WC_PRINTABLE_CONTROL_CHARS;
             if (wch == UNICODE_CARRIAGERETURN)
             {
+                // The line is complete. Write all of it once more.
+                // clang-format off
+#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
+                // clang-format on
+                DeleteCommandLine(*this, FALSE);
+
+                NumToWrite = _bytesRead;
                 dwFlags |= WC_KEEP_CURSOR_VISIBLE;
+                status = WriteCharsLegacy(_screenInfo,
+                                          _backupLimit,
+                                          _backupLimit,
+                                          _backupLimit,
+                                          &NumToWrite,
+                                          &_visibleCharCount,
+                                          _originalCursorPosition.X,
+                                          dwFlags,
+                                          &ScrollY);
+            }
+            else
+            {
+                // Everything in front of the edit stays where it is on the screen,
+                // so only the rest of the command line is written again. This keeps
+                // keystrokes in the middle of long command lines from rewriting
+                // thousands of cells each time.
+                status = _writeFromEditPosition(editPosition, dwFlags, ScrollY);
             }
-            status = WriteCharsLegacy(_screenInfo,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      &NumToWrite,
-                                      &_visibleCharCount,
-                                      _originalCursorPosition.X,
-                                      dwFlags,
-                                      &ScrollY);
             if (!NT_SUCCESS(status))
             {
                 RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", status);
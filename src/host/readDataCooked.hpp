@@ -159,4 +159,5 @@ private:
     [[nodiscard]] NTSTATUS _readCharInputLoop(const bool isUnicode, size_t& numBytes) noexcept;
 
     [[nodiscard]] NTSTATUS _handlePostCharInputLoop(const bool isUnicode, size_t& numBytes, ULONG& controlKeyState) noexcept;
+    [[nodiscard]] NTSTATUS _writeFromEditPosition(const size_t editPosition, const DWORD dwFlags, SHORT& scrollY) noexcept;
 };
@@ -349,7 +349,13 @@ const std::wstring RenderData::GetHyperlinkCustomId(uint16_t id) const noexcept
 }
 
 // For now, we ignore regex patterns in conhost
-const std::vector<size_t> RenderData::GetPatternId(const COORD /*location*/) const noexcept
+void RenderData::GetPatternId(const COORD /*location*/, std::vector<size_t>& ids) const noexcept
+{
+    ids.clear();
+}
+
+// Conhost's find dialog colors its matches in the buffer instead.
+std::vector<Microsoft::Console::Types::Viewport> RenderData::GetSearchHighlightRects() noexcept
 {
     return {};
 }
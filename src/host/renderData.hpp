@@ -59,7 +59,8 @@ public:
     const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
     const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
 
-    const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+    void GetPatternId(const COORD location, std::vector<size_t>& ids) const noexcept override;
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept override;
 #pragma endregion
 
 #pragma region IUiaData
@@ -51,6 +51,7 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _viewport(Viewport::Empty()),
     _psiAlternateBuffer{ nullptr },
     _psiMainBuffer{ nullptr },
+    _psiCachedAlternateBuffer{ nullptr },
     _rcAltSavedClientNew{ 0 },
     _rcAltSavedClientOld{ 0 },
     _fAltWindowChanged{ false },
@@ -198,13 +199,27 @@ void SCREEN_INFORMATION::s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
 }
 
 // Routine Description:
-// - This routine removes the screen buffer pointer from the console's list of screen buffers.
+// - This routine removes the screen buffer pointer from the console's list of screen buffers, and deletes it.
 // Arguments:
 // - ScreenInfo - Pointer to screen information structure.
 // Return Value:
 // Note:
 // - The console lock must be held when calling this routine.
 void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
+{
+    s_DetachScreenBuffer(pScreenInfo);
+    delete pScreenInfo;
+}
+
+// Routine Description:
+// - This routine removes the screen buffer pointer from the console's list of
+//   screen buffers, like s_RemoveScreenBuffer, but doesn't delete it.
+// Arguments:
+// - ScreenInfo - Pointer to screen information structure.
+// Return Value:
+// Note:
+// - The console lock must be held when calling this routine.
+void SCREEN_INFORMATION::s_DetachScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     if (pScreenInfo == gci.ScreenBuffers)
@@ -242,8 +257,6 @@ void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
             gci.pCurrentScreenBuffer = nullptr;
         }
     }
-
-    delete pScreenInfo;
 }
 
 #pragma endregion
@@ -284,6 +297,9 @@ void SCREEN_INFORMATION::_FreeOutputStateMachine()
             s_RemoveScreenBuffer(_psiAlternateBuffer);
         }
 
+        // The cached alternate buffer isn't in the list of screen buffers.
+        delete std::exchange(_psiCachedAlternateBuffer, nullptr);
+
         _stateMachine.reset();
     }
 }
@@ -366,7 +382,38 @@ void SCREEN_INFORMATION::GetScreenBufferInformation(_Out_ PCOORD pcoordSize,
         lpColorTable[i] = gci.GetColorTableEntry(i);
     }
 
-    *pcoordMaximumWindowSize = GetMaxWindowSizeInCharacters();
+    *pcoordMaximumWindowSize = _GetCachedMaxWindowSizeInCharacters();
+}
+
+// Routine Description:
+// - Returns the same value as GetMaxWindowSizeInCharacters, but only measures the window again
+//   when the buffer size, font, or window metrics have changed since the last call.
+// Arguments:
+// - <none>
+// Return Value:
+// - COORD containing the maximum window size in characters.
+COORD SCREEN_INFORMATION::_GetCachedMaxWindowSizeInCharacters() const
+{
+    const auto& g = ServiceLocator::LocateGlobals();
+    const auto windowMetricsVersion = g.windowMetricsVersion.load();
+    const auto bufferSize = GetBufferSize().Dimensions();
+    const auto fontSize = GetScreenFontSize();
+    const auto hasRenderer = g.pRender != nullptr;
+
+    if (!_maxWindowSizeCache ||
+        _maxWindowSizeCache->windowMetricsVersion != windowMetricsVersion ||
+        _maxWindowSizeCache->bufferSize != bufferSize ||
+        _maxWindowSizeCache->fontSize != fontSize ||
+        _maxWindowSizeCache->hasRenderer != hasRenderer)
+    {
+        _maxWindowSizeCache = MaxWindowSizeCache{ windowMetricsVersion,
+                                                  bufferSize,
+                                                  fontSize,
+                                                  hasRenderer,
+                                                  GetMaxWindowSizeInCharacters() };
+    }
+
+    return _maxWindowSizeCache->maxWindowSize;
 }
 
 // Routine Description:
@@ -1853,6 +1900,9 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
 // - Instantiates a new buffer to be used as an alternate buffer. This buffer
 //     does not have a driver handle associated with it and shares a state
 //     machine with the main buffer it belongs to.
+// - Applications switch to the alternate buffer and back all the time, so
+//     the one that was left last is reused if it still has the right size,
+//     instead of allocating a new buffer every time.
 // TODO: MSFT:19817348 Don't create alt screenbuffer's via an out SCREEN_INFORMATION**
 // Parameters:
 // - ppsiNewScreenBuffer - a pointer to receive the newly created buffer.
@@ -1870,6 +1920,23 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     auto initAttributes = GetAttributes();
     initAttributes.SetStandardErase();
 
+    auto& siMain = GetMainBuffer();
+    if (auto* const cachedBuffer = std::exchange(siMain._psiCachedAlternateBuffer, nullptr))
+    {
+        if (cachedBuffer->GetBufferSize().Dimensions() == WindowSize)
+        {
+            cachedBuffer->_ResetAltBuffer(existingFont, initAttributes, GetPopupAttributes());
+
+            auto& myCursor = GetTextBuffer().GetCursor();
+            cachedBuffer->GetTextBuffer().GetCursor().SetStyle(myCursor.GetSize(), myCursor.GetColor(), myCursor.GetType());
+
+            s_InsertScreenBuffer(cachedBuffer);
+            *ppsiNewScreenBuffer = cachedBuffer;
+            return STATUS_SUCCESS;
+        }
+        delete cachedBuffer;
+    }
+
     NTSTATUS Status = SCREEN_INFORMATION::CreateInstance(WindowSize,
                                                          existingFont,
                                                          WindowSize,
@@ -1896,6 +1963,38 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     return Status;
 }
 
+// Routine Description:
+// - Puts an alternate buffer that was left back into the state a newly
+//     created one would be in, so that it can be used as the alternate
+//     buffer again. Its size and its state machine are kept.
+// Parameters:
+// - fontInfo - The font of the buffer that switches to it.
+// - initAttributes - The attributes to fill the buffer with.
+// - popupAttributes - The attributes of popups.
+// Return value:
+// - <none>
+void SCREEN_INFORMATION::_ResetAltBuffer(const FontInfo& fontInfo, const TextAttribute initAttributes, const TextAttribute popupAttributes)
+{
+    const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+    OutputMode = ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT;
+    WI_SetFlagIf(OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING, gci.GetVirtTermLevel() != 0);
+    ResizingWindow = 0;
+    WheelDelta = 0;
+    HWheelDelta = 0;
+    _PopupAttributes = popupAttributes;
+    _currentFont = fontInfo;
+    _desiredFont = FontInfoDesired{ fontInfo };
+    _ignoreLegacyEquivalentVTAttributes = false;
+    _scrollMargins = Viewport::FromCoord({ 0 });
+    _viewport = Viewport::FromDimensions({ 0, 0 }, GetBufferSize().Dimensions());
+    UpdateBottom();
+
+    _textBuffer->SetCurrentAttributes(initAttributes);
+    _textBuffer->Reset();
+    _textBuffer->GetCursor().Reset(Cursor::CURSOR_SMALL_SIZE);
+}
+
 // Routine Description:
 // - Creates an "alternate" screen buffer for this buffer. In virtual terminals, there exists both a "main"
 //     screen buffer and an alternate. ASBSET creates a new alternate, and switches to it. If there is an already
@@ -1970,8 +2069,9 @@ void SCREEN_INFORMATION::UseMainScreenBuffer()
 
         SCREEN_INFORMATION* psiAlt = psiMain->_psiAlternateBuffer;
         psiMain->_psiAlternateBuffer = nullptr;
-        s_RemoveScreenBuffer(psiAlt); // this will also delete the alt buffer
-        // deleting the alt buffer will give the GetSet back to its main
+        // The alt buffer is kept, so that the next one can reuse it.
+        s_DetachScreenBuffer(psiAlt);
+        delete std::exchange(psiMain->_psiCachedAlternateBuffer, psiAlt);
 
         // Tell the VT MouseInput handler that we're in the main buffer now
         gci.GetActiveInputBuffer()->GetTerminalInput().UseMainScreenBuffer();
@@ -2224,12 +2324,10 @@ void SCREEN_INFORMATION::SetViewport(const Viewport& newViewport,
 
     // Update all the rows in the current viewport with the standard erase attributes,
     // i.e. the current background color, but with no meta attributes set.
+    // They're below the last character, so they only hold spaces anyway.
     auto fillAttributes = GetAttributes();
     fillAttributes.SetStandardErase();
-    auto fillPosition = COORD{ 0, _viewport.Top() };
-    auto fillLength = gsl::narrow_cast<size_t>(_viewport.Height() * GetBufferSize().Width());
-    auto fillData = OutputCellIterator{ fillAttributes, fillLength };
-    Write(fillData, fillPosition, false);
+    _textBuffer->ClearRows(_viewport.Top(), _viewport.Height(), fillAttributes);
 
     // Also reset the line rendition for the erased rows.
     _textBuffer->ResetLineRenditionRange(_viewport.Top(), _viewport.BottomExclusive());
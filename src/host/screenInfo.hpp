@@ -124,6 +124,7 @@ public:
     // TODO: MSFT 9355062 these methods should probably be a part of construction/destruction. http://osgvsowi/9355062
     static void s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
     static void s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
+    static void s_DetachScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
 
     OutputCellRect ReadRect(const Microsoft::Console::Types::Viewport location) const;
 
@@ -270,6 +271,7 @@ private:
     void _FreeOutputStateMachine();
 
     [[nodiscard]] NTSTATUS _CreateAltBuffer(_Out_ SCREEN_INFORMATION** const ppsiNewScreenBuffer);
+    void _ResetAltBuffer(const FontInfo& fontInfo, const TextAttribute initAttributes, const TextAttribute popupAttributes);
 
     bool _IsAltBuffer() const;
     bool _IsInPtyMode() const;
@@ -285,6 +287,7 @@ private:
 
     SCREEN_INFORMATION* _psiAlternateBuffer; // The VT "Alternate" screen buffer.
     SCREEN_INFORMATION* _psiMainBuffer; // A pointer to the main buffer, if this is the alternate buffer.
+    SCREEN_INFORMATION* _psiCachedAlternateBuffer; // The alternate buffer that was left last, kept to be reused by the next one.
 
     RECT _rcAltSavedClientNew;
     RECT _rcAltSavedClientOld;
@@ -304,6 +307,20 @@ private:
 
     bool _ignoreLegacyEquivalentVTAttributes;
 
+    // GetConsoleScreenBufferInfoEx is polled by many clients before nearly every write, and its
+    // maximum window size needs a round of monitor queries. It's kept until one of its inputs changes.
+    struct MaxWindowSizeCache
+    {
+        ULONG windowMetricsVersion;
+        COORD bufferSize;
+        COORD fontSize;
+        bool hasRenderer;
+        COORD maxWindowSize;
+    };
+    mutable std::optional<MaxWindowSizeCache> _maxWindowSizeCache;
+
+    COORD _GetCachedMaxWindowSizeInCharacters() const;
+
 #ifdef UNIT_TESTING
     friend class TextBufferIteratorTests;
     friend class ScreenBufferTests;
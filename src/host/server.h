@@ -128,6 +128,10 @@ public:
     COLORREF GetDefaultBackground() const noexcept;
     std::pair<COLORREF, COLORREF> LookupAttributeColors(const TextAttribute& attr) const noexcept;
 
+    void TriggerColorRedraw();
+    void BeginDeferColorRedraw() noexcept;
+    void EndDeferColorRedraw() noexcept;
+
     void SetTitle(const std::wstring_view newTitle);
     void SetTitlePrefix(const std::wstring_view newTitlePrefix);
     void SetOriginalTitle(const std::wstring_view originalTitle);
@@ -162,6 +166,9 @@ private:
     Microsoft::Console::VirtualTerminal::VtIo _vtIo;
     Microsoft::Console::CursorBlinker _blinker;
     mutable Microsoft::Console::Render::BlinkingState _blinkingState;
+
+    size_t _colorRedrawDeferrals{ 0 };
+    bool _colorRedrawPending{ false };
 };
 
 #define ConsoleLocked() (ServiceLocator::LocateGlobals()->getConsoleInformation()->ConsoleLock.OwningThread == NtCurrentTeb()->ClientId.UniqueThread)
@@ -44,6 +44,8 @@ try
 {
     Globals& Globals = ServiceLocator::LocateGlobals();
 
+    Tracing::s_TraceStartupBegin(args->IsHeadless());
+
     if (!Globals.pDeviceComm)
     {
         // in rare circumstances (such as in the fuzzing harness), there will already be a device comm
@@ -61,8 +63,11 @@ try
 
     // Check if this conhost is allowed to delegate its activities to another.
     // If so, look up the registered default console handler.
+    // A PTY session never hands off (see IoDispatchers), so it can skip the
+    // policy check and the registry lookups on its way to the first output.
     bool isEnabled = false;
-    if (SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
+    if (!args->IsHeadless() &&
+        SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
     {
         IID delegationClsid;
         if (SUCCEEDED(DelegationConfig::s_GetDefaultConsoleId(delegationClsid)))
@@ -706,6 +711,7 @@ PWSTR TranslateConsoleTitle(_In_ PCWSTR pwszConsoleTitle, const BOOL fUnexpand,
     NTSTATUS Status = SetUpConsole(&p->ConsoleInfo, p->TitleLength, p->Title, p->CurDir, p->AppName);
     if (!NT_SUCCESS(Status))
     {
+        Tracing::s_TraceStartupEnd(Status);
         return Status;
     }
 
@@ -827,6 +833,7 @@ PWSTR TranslateConsoleTitle(_In_ PCWSTR pwszConsoleTitle, const BOOL fUnexpand,
         }
     }
 
+    Tracing::s_TraceStartupEnd(Status);
     return Status;
 }
 
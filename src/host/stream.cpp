@@ -719,6 +719,9 @@ size_t RetrieveNumberOfSpaces(_In_ SHORT sOriginalCursorPositionX,
         }
         else if (WI_IsFlagSet(inputBuffer.InputMode, ENABLE_LINE_INPUT))
         {
+            // Cooked reads echo into the buffer, which the passthrough skips. See VtIo::WritePassthrough.
+            ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo()->EndPassthrough();
+
             return NTSTATUS_FROM_HRESULT(_ReadLineInput(inputBuffer,
                                                         processData,
                                                         buffer,
@@ -83,6 +83,83 @@ Tracing Tracing::s_TraceApiCall(const NTSTATUS& result, PCSTR traceName)
     // clang-format on
 }
 
+// Routine Description:
+// - Marks the start of the server's startup, before anything is set up. Together
+//   with s_TraceStartupEnd this forms the Startup region, and together with the
+//   first output of the VT renderer it forms the TimeToFirstByte region.
+// Arguments:
+// - headless - Whether the server is starting up without a window (e.g. as a ConPTY).
+// Return Value:
+// - <none>
+void Tracing::s_TraceStartupBegin(const bool headless)
+{
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "Startup",
+        TraceLoggingBool(headless, "Headless"),
+        TraceLoggingOpcode(WINEVENT_OPCODE_START),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::General));
+}
+
+// Routine Description:
+// - Marks the end of the server's startup, once the console for the first
+//   client is allocated and ready to serve its API calls.
+// Arguments:
+// - status - The result of allocating the console.
+// Return Value:
+// - <none>
+void Tracing::s_TraceStartupEnd(const NTSTATUS status)
+{
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "Startup",
+        TraceLoggingNTStatus(status, "Result"),
+        TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::General));
+}
+
+// Routine Description:
+// - Marks the start of inheriting the cursor position of the terminal,
+//   with --inheritcursor. Together with s_TraceInheritCursorEnd this forms
+//   the InheritCursor region, which is part of the TimeToFirstByte region.
+// Arguments:
+// - requested - Whether we have to ask the terminal for the position with a
+//   DSR, as opposed to it being passed on the commandline.
+// Return Value:
+// - <none>
+void Tracing::s_TraceInheritCursorBegin(const bool requested)
+{
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "InheritCursor",
+        TraceLoggingBool(requested, "Requested"),
+        TraceLoggingOpcode(WINEVENT_OPCODE_START),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::General));
+}
+
+// Routine Description:
+// - Marks the end of inheriting the cursor position, once we know it.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Tracing::s_TraceInheritCursorEnd()
+{
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "InheritCursor",
+        TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::General));
+}
+
 ULONG Tracing::s_ulDebugFlag = 0x0;
 
 void Tracing::s_TraceApi(const NTSTATUS status, const CONSOLE_GETLARGESTWINDOWSIZE_MSG* const a)
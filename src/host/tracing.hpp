@@ -42,6 +42,11 @@ public:
 
     static Tracing s_TraceApiCall(const NTSTATUS& result, PCSTR traceName);
 
+    static void s_TraceStartupBegin(const bool headless);
+    static void s_TraceStartupEnd(const NTSTATUS status);
+    static void s_TraceInheritCursorBegin(const bool requested);
+    static void s_TraceInheritCursorEnd();
+
     static void s_TraceApi(const NTSTATUS status, const CONSOLE_GETLARGESTWINDOWSIZE_MSG* const a);
     static void s_TraceApi(const NTSTATUS status, const CONSOLE_SCREENBUFFERINFO_MSG* const a, const bool fSet);
     static void s_TraceApi(const NTSTATUS status, const CONSOLE_SETSCREENBUFFERSIZE_MSG* const a);
@@ -11,6 +11,7 @@
 #include "getset.h"
 #include "dbcs.h"
 #include "misc.h"
+#include "../../types/inc/convert.hpp"
 
 #include "../interactivity/inc/ServiceLocator.hpp"
 
@@ -426,6 +427,44 @@ class ApiRoutinesTests
         }
     }
 
+    TEST_METHOD(ApiWriteConsoleAConvertsAsciiPerCodePage)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"Data:dwCodePage", L"{437, 932, 37}")
+        END_TEST_METHOD_PROPERTIES();
+
+        DWORD dwCodePage;
+        VERIFY_SUCCEEDED(TestData::TryGetValue(L"dwCodePage", dwCodePage), L"Get the codepage for the test. EBCDIC (37) doesn't map ASCII to itself.");
+
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        gci.OutputCP = dwCodePage;
+        SetConsoleCPInfo(TRUE);
+
+        // Long enough to take the vectorized path of the ASCII conversion.
+        const std::string_view text{ "HelloWorldFromTheAnsiApis" };
+        const auto expected = ConvertToW(dwCodePage, text);
+        const auto origin = si.GetTextBuffer().GetCursor().GetPosition();
+
+        size_t read = 0;
+        std::unique_ptr<IWaitRoutine> waiter;
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleAImpl(si, text, read, false, waiter));
+        VERIFY_IS_NULL(waiter.get());
+        VERIFY_ARE_EQUAL(text.size(), read);
+
+        Log::Comment(L"The text has to be converted like the code page says, whether it's ASCII compatible or not.");
+        auto it = si.GetCellDataAt(origin);
+        for (const auto wch : expected)
+        {
+            VERIFY_ARE_EQUAL(String(&wch, 1), String(it->Chars().data(), 1));
+            ++it;
+        }
+    }
+
     TEST_METHOD(ApiWriteConsoleW)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
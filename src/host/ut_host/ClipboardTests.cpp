@@ -155,6 +155,27 @@ class ClipboardTests
         VERIFY_IS_NOT_NULL(ptr);
     }
 
+    TEST_METHOD(TestPlainTextMatchesRetrievedRows)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& buffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+        for (const auto lineSelection : { false, true })
+        {
+            std::vector<SMALL_RECT> selection;
+            const auto rows = SetupRetrieveFromBuffers(lineSelection, selection);
+
+            std::wstring expected;
+            for (const auto& row : rows)
+            {
+                expected += row;
+            }
+
+            const auto actual = buffer.GetPlainText(true, lineSelection, selection);
+            VERIFY_ARE_EQUAL(String(expected.c_str()), String(actual.c_str()));
+        }
+    }
+
     TEST_METHOD(CanConvertTextToInputEvents)
     {
         std::wstring wstr = L"hello world";
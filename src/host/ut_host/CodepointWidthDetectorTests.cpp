@@ -74,6 +74,55 @@ class CodepointWidthDetectorTests
         }
     }
 
+    TEST_METHOD(MatchesRangesAcrossBlocks)
+    {
+        // The lookup table is split into blocks of 256 codepoints.
+        // These ranges start or end right at the edges of those blocks.
+        CodepointWidthDetector widthDetector;
+        VERIFY_ARE_EQUAL(CodepointWidth::Narrow, widthDetector.GetWidth(L"\x10FF"));
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\x1100")); // U+1100 hangul choseong kiyeok
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\x4E00")); // U+4E00 first CJK unified ideograph
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\x9FFF"));
+        VERIFY_ARE_EQUAL(CodepointWidth::Ambiguous, widthDetector.GetWidth(L"\xDB80\xDC00")); // U+F0000 first private use codepoint of plane 15
+        VERIFY_ARE_EQUAL(CodepointWidth::Narrow, widthDetector.GetWidth(L"\xDBFF\xDFFF")); // U+10FFFF noncharacter
+    }
+
+    TEST_METHOD(SegmentsGraphemeClusters)
+    {
+        // The text and the length of the first cluster in it.
+        static constexpr std::array<std::pair<std::wstring_view, size_t>, 10> clusters{ {
+            { L"ab", 1 },
+            { L"e\x301\x302x", 3 }, // combining acute and circumflex accent
+            { L"\r\n", 1 }, // every control character gets a cell of its own
+            { L"\t\x301", 1 },
+            { L"\x1100\x1161\x11A8\xAC00", 3 }, // hangul L V T, then the syllable LV
+            { L"\x0600a", 2 }, // arabic number sign prepends
+            { L"\xD83D\xDC68\x200D\xD83D\xDC69\x200D\xD83D\xDC67!", 8 }, // family: man, woman, girl
+            { L"a\x200D\xD83D\xDC69", 2 }, // ZWJ only joins pictographs
+            { L"\xD83C\xDDE9\xD83C\xDDEA\xD83C\xDDEB", 4 }, // regional indicators pair up
+            { L"\xD83Da", 1 }, // unpaired surrogates stand alone
+        } };
+
+        for (const auto& [text, expected] : clusters)
+        {
+            VERIFY_ARE_EQUAL(expected, CodepointWidthDetector::GetNextCluster(text).size());
+        }
+        VERIFY_IS_TRUE(CodepointWidthDetector::GetNextCluster({}).empty());
+    }
+
+    TEST_METHOD(MeasuresClusters)
+    {
+        CodepointWidthDetector widthDetector;
+        VERIFY_ARE_EQUAL(CodepointWidth::Narrow, widthDetector.GetWidth(L"e\x301"));
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\x306A\x3099")); // hiragana na with voiced sound mark
+        VERIFY_ARE_EQUAL(CodepointWidth::Ambiguous, widthDetector.GetWidth(L"\x414\x301"));
+
+        Log::Comment(L"VS16 asks for the wide emoji presentation of a pictograph.");
+        VERIFY_ARE_EQUAL(CodepointWidth::Narrow, widthDetector.GetWidth(L"\x2764"));
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\x2764\xFE0F"));
+        VERIFY_ARE_EQUAL(CodepointWidth::Wide, widthDetector.GetWidth(L"\xD83C\xDDE9\xD83C\xDDEA"));
+    }
+
     TEST_METHOD(AmbiguousCache)
     {
         // Set up a detector with fallback.
@@ -91,7 +140,7 @@ class CodepointWidthDetectorTests
 
         // Cached item should match what we expect
         const auto it = widthDetector._fallbackCache.begin();
-        VERIFY_ARE_EQUAL(ambiguous, it->first);
+        VERIFY_ARE_EQUAL(0x414u, it->first);
         VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), it->second);
 
         // Cache should empty when font changes.
@@ -534,4 +534,44 @@ class CommandLineTests
             }
         }
     }
+
+    TEST_METHOD(EditingInTheMiddleRewritesTheRestOfTheLine)
+    {
+        auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
+        VERIFY_IS_NOT_NULL(buffer.get());
+        auto& consoleInfo = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& screenInfo = consoleInfo.GetActiveOutputBuffer();
+        auto& cookedReadData = consoleInfo.CookedReadData();
+        InitCookedReadData(cookedReadData, m_pHistory, buffer.get(), PROMPT_SIZE);
+        VERIFY_IS_TRUE(cookedReadData.IsEchoInput());
+
+        auto& cursor = screenInfo.GetTextBuffer().GetCursor();
+        cookedReadData.OriginalCursorPosition() = cursor.GetPosition();
+        const auto origin = cursor.GetPosition();
+        const auto rowText = [&]() {
+            return screenInfo.GetTextBuffer().GetRowByOffset(origin.Y).GetText().substr(origin.X, 8);
+        };
+
+        VERIFY_ARE_EQUAL(6u, cookedReadData.Write(L"abcdef"));
+
+        Log::Comment(L"Insert a character in the middle of the line.");
+        MoveCursor(cookedReadData, 2);
+        LOG_IF_FAILED(screenInfo.SetCursorPosition({ gsl::narrow_cast<SHORT>(origin.X + 2), origin.Y }, true));
+        cookedReadData._insertMode = true;
+        NTSTATUS status = STATUS_SUCCESS;
+        VERIFY_IS_FALSE(cookedReadData.ProcessInput(L'X', 0, status));
+        VERIFY_ARE_EQUAL(STATUS_SUCCESS, status);
+        VerifyPromptText(cookedReadData, L"abXcdef");
+        VERIFY_ARE_EQUAL(std::wstring{ L"abXcdef " }, rowText());
+        VERIFY_ARE_EQUAL((COORD{ gsl::narrow_cast<SHORT>(origin.X + 3), origin.Y }), cursor.GetPosition());
+        VERIFY_ARE_EQUAL(7u, cookedReadData.VisibleCharCount());
+
+        Log::Comment(L"Erase it again. The cell that the line no longer covers is blanked.");
+        VERIFY_IS_FALSE(cookedReadData.ProcessInput(UNICODE_BACKSPACE, 0, status));
+        VERIFY_ARE_EQUAL(STATUS_SUCCESS, status);
+        VerifyPromptText(cookedReadData, L"abcdef");
+        VERIFY_ARE_EQUAL(std::wstring{ L"abcdef  " }, rowText());
+        VERIFY_ARE_EQUAL((COORD{ gsl::narrow_cast<SHORT>(origin.X + 2), origin.Y }), cursor.GetPosition());
+        VERIFY_ARE_EQUAL(6u, cookedReadData.VisibleCharCount());
+    }
 };
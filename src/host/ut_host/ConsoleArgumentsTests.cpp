@@ -32,6 +32,7 @@ public:
     TEST_METHOD(HeadlessArgTests);
     TEST_METHOD(SignalHandleTests);
     TEST_METHOD(FeatureArgTests);
+    TEST_METHOD(InheritedCursorPositionTests);
 };
 
 ConsoleArguments CreateAndParse(std::wstring& commandline, HANDLE hVtIn, HANDLE hVtOut)
@@ -1284,3 +1285,30 @@ void ConsoleArgumentsTests::FeatureArgTests()
                                     false), // runAsComServer
                    false); // successful parse?
 }
+
+void ConsoleArgumentsTests::InheritedCursorPositionTests()
+{
+    std::wstring commandline;
+
+    commandline = L"conhost.exe --headless --inheritcursor --cursorx 12 --cursory 3";
+    Log::Comment(commandline.c_str());
+    auto args = CreateAndParse(commandline, INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE);
+    VERIFY_IS_TRUE(args.GetInheritCursor());
+    VERIFY_IS_TRUE(args.GetInheritedCursorPosition().has_value());
+    VERIFY_ARE_EQUAL((COORD{ 12, 3 }), args.GetInheritedCursorPosition().value());
+
+    commandline = L"conhost.exe --headless --inheritcursor";
+    Log::Comment(L"Without a position, we have to ask the terminal for it.");
+    args = CreateAndParse(commandline, INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE);
+    VERIFY_IS_TRUE(args.GetInheritCursor());
+    VERIFY_IS_FALSE(args.GetInheritedCursorPosition().has_value());
+
+    commandline = L"conhost.exe --headless --inheritcursor --cursorx 12";
+    Log::Comment(L"Half a position is as good as none.");
+    args = CreateAndParse(commandline, INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE);
+    VERIFY_IS_FALSE(args.GetInheritedCursorPosition().has_value());
+
+    commandline = L"conhost.exe --headless --inheritcursor --cursorx 12 --cursory foo";
+    Log::Comment(commandline.c_str());
+    CreateAndParseUnsuccessfully(commandline, INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE);
+}
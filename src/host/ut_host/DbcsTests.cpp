@@ -13,6 +13,7 @@
 #include "dbcs.h"
 
 #include "input.h"
+#include "misc.h"
 
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -87,4 +88,34 @@ class DbcsTests
             }
         }
     }
+
+    TEST_METHOD(TestOemTranslationTableMatchesConvertToOem)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"Data:codepage", L"{437, 1252, 932, 936, 949, 950}")
+        END_TEST_METHOD_PROPERTIES()
+
+        UINT codepage;
+        VERIFY_SUCCEEDED_RETURN(TestData::TryGetValue(L"codepage", codepage));
+
+        auto& table = OemTranslationTable::ForCodePage(codepage);
+        VERIFY_ARE_EQUAL(&table, &OemTranslationTable::ForCodePage(codepage), L"Tables should be cached per codepage.");
+
+        // Every code unit should come back exactly as converting it alone with a two byte target would.
+        for (UINT i = 0; i <= 0xFFFF; ++i)
+        {
+            const auto wch = gsl::narrow_cast<wchar_t>(i);
+
+            CHAR expected[2] = { 0 };
+            const auto expectedLength = ConvertToOem(codepage, &wch, 1, &expected[0], ARRAYSIZE(expected));
+
+            CHAR actual[2] = { 0 };
+            const auto actualLength = table.Translate(wch, actual);
+
+            if (gsl::narrow_cast<size_t>(expectedLength) != actualLength || expected[0] != actual[0] || expected[1] != actual[1])
+            {
+                VERIFY_FAIL(NoThrowString().Format(L"Mismatch for U+%04X in codepage %u", i, codepage));
+            }
+        }
+    }
 };
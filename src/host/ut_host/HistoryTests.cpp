@@ -242,6 +242,37 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(DuplicatesAreFoundAfterTheHistoryChanged)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        history->Realloc(3);
+
+        // Duplicates are compared without regard to case.
+        VERIFY_SUCCEEDED(history->Add(L"dir", true));
+        VERIFY_SUCCEEDED(history->Add(L"cd", true));
+        VERIFY_SUCCEEDED(history->Add(L"DIR", true));
+        VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
+        // The command keeps the spelling it was added with first.
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"dir" }, history->GetNth(1));
+
+        // "cd" falls out of the full history, so it's no duplicate anymore.
+        VERIFY_SUCCEEDED(history->Add(L"ver", true));
+        VERIFY_SUCCEEDED(history->Add(L"echo", true));
+        VERIFY_SUCCEEDED(history->Add(L"cd", true));
+        VERIFY_ARE_EQUAL(3ul, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"ver" }, history->GetNth(0));
+
+        // A removed command isn't one either.
+        VERIFY_ARE_EQUAL(std::wstring{ L"ver" }, history->Remove(0));
+        VERIFY_SUCCEEDED(history->Add(L"ver", true));
+        VERIFY_SUCCEEDED(history->Add(L"echo", true));
+        VERIFY_ARE_EQUAL(3ul, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"cd" }, history->GetNth(0));
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"ver" }, history->GetNth(1));
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"echo" }, history->GetNth(2));
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
@@ -511,4 +511,53 @@ class OutputCellIteratorTests
         VERIFY_ARE_EQUAL(cellsExpected, it.GetCellDistance(original));
         VERIFY_ARE_EQUAL(inputExpected, it.GetInputDistance(original));
     }
+
+    TEST_METHOD(ClusterStringData)
+    {
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        Log::Comment(L"Combining marks and emoji sequences share the cell of their base.");
+        const std::wstring testText(L"e\x301\xD83D\xDC4D\xD83C\xDFFDx");
+
+        OutputCellIterator it(testText);
+        const auto original = it;
+
+        VERIFY_IS_TRUE(it);
+        VERIFY_ARE_EQUAL(L"e\x301", it->Chars());
+        VERIFY_IS_TRUE(it->DbcsAttr().IsSingle());
+        it++;
+
+        VERIFY_IS_TRUE(it);
+        VERIFY_ARE_EQUAL(L"\xD83D\xDC4D\xD83C\xDFFD", it->Chars());
+        VERIFY_IS_TRUE(it->DbcsAttr().IsLeading());
+        it++;
+        VERIFY_IS_TRUE(it->DbcsAttr().IsTrailing());
+        it++;
+
+        VERIFY_IS_TRUE(it);
+        VERIFY_ARE_EQUAL(L"x", it->Chars());
+        it++;
+
+        VERIFY_IS_FALSE(it);
+        VERIFY_ARE_EQUAL(ptrdiff_t{ 4 }, it.GetCellDistance(original));
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<ptrdiff_t>(testText.size()), it.GetInputDistance(original));
+    }
+
+    TEST_METHOD(BrokenSurrogateStringData)
+    {
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        const std::wstring testText(L"\xD83Da\xDC4D");
+
+        OutputCellIterator it(testText);
+
+        for (const auto expected : { L"\xFFFD", L"a", L"\xFFFD" })
+        {
+            VERIFY_IS_TRUE(it);
+            VERIFY_ARE_EQUAL(expected, it->Chars());
+            it++;
+        }
+
+        VERIFY_IS_FALSE(it);
+    }
 };
@@ -85,6 +85,8 @@ class ScreenBufferTests
 
     TEST_METHOD(SingleAlternateBufferCreationTest);
 
+    TEST_METHOD(AlternateBufferIsReused);
+
     TEST_METHOD(MultipleAlternateBufferCreationTest);
 
     TEST_METHOD(MultipleAlternateBuffersFromMainCreationTest);
@@ -185,6 +187,7 @@ class ScreenBufferTests
     TEST_METHOD(SetScreenMode);
     TEST_METHOD(SetOriginMode);
     TEST_METHOD(SetAutoWrapMode);
+    TEST_METHOD(PrintableTextWrapsAcrossLines);
 
     TEST_METHOD(HardResetBuffer);
 
@@ -218,6 +221,8 @@ class ScreenBufferTests
     TEST_METHOD(RetainHorizontalOffsetWhenMovingToBottom);
 
     TEST_METHOD(TestWriteConsoleVTQuirkMode);
+
+    TEST_METHOD(CachedMaxWindowSizeFollowsBufferSize);
 };
 
 void ScreenBufferTests::SingleAlternateBufferCreationTest()
@@ -252,6 +257,41 @@ void ScreenBufferTests::SingleAlternateBufferCreationTest()
     }
 }
 
+void ScreenBufferTests::AlternateBufferIsReused()
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION* const psiOriginal = &gci.GetActiveOutputBuffer();
+    VERIFY_SUCCEEDED(psiOriginal->UseAlternateScreenBuffer());
+    SCREEN_INFORMATION* const psiFirstAlternate = &gci.GetActiveOutputBuffer();
+
+    Log::Comment(L"Dirty the alternate buffer, then leave it.");
+    auto& firstTextBuffer = psiFirstAlternate->GetTextBuffer();
+    firstTextBuffer.WriteRun(L"alt", TextAttribute{ FOREGROUND_RED }, { 0, 0 });
+    firstTextBuffer.GetCursor().SetPosition({ 3, 2 });
+    firstTextBuffer.GetCursor().SetIsVisible(false);
+    WI_ClearFlag(psiFirstAlternate->OutputMode, ENABLE_WRAP_AT_EOL_OUTPUT);
+    psiFirstAlternate->UseMainScreenBuffer();
+    VERIFY_ARE_EQUAL(psiFirstAlternate, psiOriginal->_psiCachedAlternateBuffer);
+
+    Log::Comment(L"The next alternate buffer is the same one, as good as new.");
+    VERIFY_SUCCEEDED(psiOriginal->UseAlternateScreenBuffer());
+    SCREEN_INFORMATION* const psiSecondAlternate = &gci.GetActiveOutputBuffer();
+    VERIFY_ARE_EQUAL(psiFirstAlternate, psiSecondAlternate);
+    VERIFY_IS_NULL(psiOriginal->_psiCachedAlternateBuffer);
+    VERIFY_ARE_EQUAL(psiOriginal, psiSecondAlternate->_psiMainBuffer);
+
+    const auto& secondTextBuffer = psiSecondAlternate->GetTextBuffer();
+    VERIFY_ARE_EQUAL(L' ', secondTextBuffer.GetRowByOffset(0).GetText().at(0));
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), secondTextBuffer.GetCursor().GetPosition());
+    VERIFY_IS_TRUE(secondTextBuffer.GetCursor().IsVisible());
+    VERIFY_IS_TRUE(WI_IsFlagSet(psiSecondAlternate->OutputMode, ENABLE_WRAP_AT_EOL_OUTPUT));
+
+    psiSecondAlternate->UseMainScreenBuffer();
+}
+
 void ScreenBufferTests::MultipleAlternateBufferCreationTest()
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -4690,6 +4730,48 @@ void ScreenBufferTests::SetAutoWrapMode()
     VERIFY_ARE_EQUAL(COORD({ 3, startLine + 1 }), cursor.GetPosition());
 }
 
+void ScreenBufferTests::PrintableTextWrapsAcrossLines()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer();
+    auto& stateMachine = si.GetStateMachine();
+    auto& textBuffer = si.GetTextBuffer();
+    auto& cursor = textBuffer.GetCursor();
+    const auto attributes = si.GetAttributes();
+    WI_SetFlag(si.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    const auto view = Viewport::FromDimensions({ 0, 0 }, { 80, 25 });
+    si.SetViewport(view, true);
+
+    Log::Comment(L"Filling a line exactly delays the wrap until the next character.");
+    const std::wstring line(80, L'a');
+    cursor.SetPosition({ 0, 0 });
+    stateMachine.ProcessString(line);
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 0 }, line, attributes));
+    VERIFY_ARE_EQUAL(COORD({ 79, 0 }), cursor.GetPosition());
+    VERIFY_IS_TRUE(cursor.IsDelayedEOLWrap());
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(0).WasWrapForced());
+
+    Log::Comment(L"A long run is spread over as many lines as it takes.");
+    const std::wstring text = std::wstring(80, L'b') + std::wstring(80, L'c') + L"dd";
+    stateMachine.ProcessString(text);
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 1 }, std::wstring(80, L'b'), attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 2 }, std::wstring(80, L'c'), attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 3 }, L"dd", attributes));
+    VERIFY_ARE_EQUAL(COORD({ 2, 3 }), cursor.GetPosition());
+    VERIFY_IS_FALSE(cursor.IsDelayedEOLWrap());
+
+    Log::Comment(L"Text that isn't plain ASCII continues right where the ASCII stopped.");
+    stateMachine.ProcessString(L"e\x3042f\r\ng");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 2, 3 }, L"e", attributes));
+    const auto wide = si.GetCellDataAt({ 3, 3 });
+    VERIFY_ARE_EQUAL(L"\x3042", wide->Chars());
+    VERIFY_IS_TRUE(wide->DbcsAttr().IsLeading());
+    VERIFY_IS_TRUE(_ValidateLineContains({ 5, 3 }, L"f", attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 4 }, L"g", attributes));
+    VERIFY_ARE_EQUAL(COORD({ 1, 4 }), cursor.GetPosition());
+}
+
 void ScreenBufferTests::HardResetBuffer()
 {
     auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -6180,3 +6262,35 @@ void ScreenBufferTests::TestWriteConsoleVTQuirkMode()
         verifyLastAttribute(vtWhiteOnBlack256Attribute);
     }
 }
+
+void ScreenBufferTests::CachedMaxWindowSizeFollowsBufferSize()
+{
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+
+    const auto getMaxWindowSize = [&]() {
+        COORD size, cursorPosition, maxWindowSize;
+        SMALL_RECT window;
+        WORD attributes, popupAttributes;
+        COLORREF colorTable[COLOR_TABLE_SIZE];
+        si.GetScreenBufferInformation(&size, &cursorPosition, &window, &attributes, &maxWindowSize, &popupAttributes, colorTable);
+        return maxWindowSize;
+    };
+
+    Log::Comment(L"The first query measures the window.");
+    VERIFY_ARE_EQUAL(si.GetMaxWindowSizeInCharacters(), getMaxWindowSize());
+
+    Log::Comment(L"Shrinking the buffer must not return the size cached for the larger buffer.");
+    auto newBufferSize = si.GetBufferSize().Dimensions();
+    newBufferSize.X /= 2;
+    newBufferSize.Y /= 2;
+    VERIFY_SUCCEEDED(si.ResizeScreenBuffer(newBufferSize, false));
+    VERIFY_ARE_EQUAL(si.GetMaxWindowSizeInCharacters(), getMaxWindowSize());
+    VERIFY_IS_LESS_THAN_OR_EQUAL(getMaxWindowSize().X, newBufferSize.X);
+    VERIFY_IS_LESS_THAN_OR_EQUAL(getMaxWindowSize().Y, newBufferSize.Y);
+
+    Log::Comment(L"A change in window metrics measures the window again.");
+    g.windowMetricsVersion++;
+    VERIFY_ARE_EQUAL(si.GetMaxWindowSizeInCharacters(), getMaxWindowSize());
+}
@@ -156,4 +156,81 @@ class SearchTests
         Search s(gci.renderData, L"\x304b", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
         DoFoundChecks(s, coordStartExpected, -1);
     }
+
+    void DoFindAllChecks(Search& s, const COORD coordStartExpected, const SHORT width)
+    {
+        const auto found = s.FindAll();
+        VERIFY_ARE_EQUAL(4u, found.size());
+        for (SHORT i = 0; i < 4; ++i)
+        {
+            const COORD start{ coordStartExpected.X, gsl::narrow_cast<SHORT>(coordStartExpected.Y + i) };
+            const COORD end{ gsl::narrow_cast<SHORT>(start.X + width - 1), start.Y };
+            VERIFY_ARE_EQUAL(start, found.at(i).first);
+            VERIFY_ARE_EQUAL(end, found.at(i).second);
+        }
+    }
+
+    TEST_METHOD(FindAllCaseSensitive)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s(gci.renderData, L"AB", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        DoFindAllChecks(s, { 0, 0 }, 2);
+
+        Search none(gci.renderData, L"ab", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        VERIFY_ARE_EQUAL(0u, none.FindAll().size());
+        VERIFY_IS_FALSE(none.FindNext());
+    }
+
+    TEST_METHOD(FindAllCaseInsensitive)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s(gci.renderData, L"ab", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
+        DoFindAllChecks(s, { 0, 0 }, 2);
+    }
+
+    TEST_METHOD(FindAllJapanese)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s(gci.renderData, L"\x304b", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        DoFindAllChecks(s, { 2, 0 }, 2);
+    }
+
+    TEST_METHOD(ForwardRegex)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        COORD coordStartExpected = { 7, 0 };
+        Search s(gci.renderData, L"D[A-Z]", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Mode::Regex);
+        DoFoundChecks(s, coordStartExpected, 1);
+    }
+
+    TEST_METHOD(BackwardRegexCaseInsensitive)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        COORD coordStartExpected = { 7, 3 };
+        Search s(gci.renderData, L"d[a-z]", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive, Search::Mode::Regex);
+        DoFoundChecks(s, coordStartExpected, -1);
+    }
+
+    TEST_METHOD(FindAllRegexJapanese)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Log::Comment(L"Wide glyphs count as two cells, both inside and in front of the match.");
+        Search s(gci.renderData, L"B\x304b+", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Mode::Regex);
+        DoFindAllChecks(s, { 1, 0 }, 3);
+    }
+
+    TEST_METHOD(InvalidRegex)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s(gci.renderData, L"(AB", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Mode::Regex);
+        VERIFY_ARE_EQUAL(0u, s.FindAll().size());
+        VERIFY_IS_FALSE(s.FindNext());
+    }
 };
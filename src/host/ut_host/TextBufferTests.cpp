@@ -79,6 +79,19 @@ class TextBufferTests
 
     TEST_METHOD(TestWrapThroughWriteLine);
 
+    TEST_METHOD(TestWriteRun);
+
+    TEST_METHOD(TestCompactRows);
+
+    TEST_METHOD(TestClearRows);
+    TEST_METHOD(TestFillCells);
+
+    TEST_METHOD(TestCachedRowText);
+    TEST_METHOD(TestCachedRowTextSlices);
+
+    TEST_METHOD(TestPatternsOnlyRescanDirtyLines);
+    TEST_METHOD(TestPatternsAfterWideGlyphs);
+
     TEST_METHOD(TestDoubleBytePadFlag);
 
     void DoBoundaryTest(PWCHAR const pwszInputString,
@@ -156,6 +169,8 @@ class TextBufferTests
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+    TEST_METHOD(HyperlinkTrimAfterRowsChanged);
+    TEST_METHOD(HyperlinkUrisSurviveCompaction);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -282,6 +297,262 @@ void TextBufferTests::TestWrapThroughWriteLine()
     }
 }
 
+void TextBufferTests::TestWriteRun()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const auto width = textBuffer.GetSize().Width();
+    const TextAttribute expectedAttr(FOREGROUND_RED);
+
+    Log::Comment(L"Plain text is written in one go.");
+    VERIFY_ARE_EQUAL(5u, textBuffer.WriteRun(L"Hello", expectedAttr, { 2, 0 }));
+    {
+        const auto& row = textBuffer.GetRowByOffset(0);
+        const auto text = row.GetText();
+        VERIFY_ARE_EQUAL(L"  Hello ", std::wstring_view{ text }.substr(0, 8));
+        VERIFY_ARE_EQUAL(expectedAttr, row.GetAttrRow().GetAttrByColumn(2));
+        VERIFY_ARE_EQUAL(expectedAttr, row.GetAttrRow().GetAttrByColumn(6));
+        VERIFY_ARE_NOT_EQUAL(expectedAttr, row.GetAttrRow().GetAttrByColumn(7));
+        VERIFY_IS_FALSE(row.WasWrapForced());
+    }
+
+    Log::Comment(L"Text that needs a width lookup is left to the caller.");
+    VERIFY_ARE_EQUAL(2u, textBuffer.WriteRun(L"ab\x304Bxy", expectedAttr, { 0, 1 }));
+    VERIFY_ARE_EQUAL(0u, textBuffer.WriteRun(L"\x304Bxy", expectedAttr, { 2, 1 }));
+    VERIFY_ARE_EQUAL(0u, textBuffer.WriteRun(L"\txy", expectedAttr, { 2, 1 }));
+
+    Log::Comment(L"Writing stops at the end of the row, which is then marked as wrapped.");
+    const std::wstring lineOfText(width, L'z');
+    VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(width - 3), textBuffer.WriteRun(lineOfText, expectedAttr, { 3, 2 }));
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(2).WasWrapForced());
+
+    Log::Comment(L"Nothing is written out of bounds.");
+    VERIFY_ARE_EQUAL(0u, textBuffer.WriteRun(L"Hello", expectedAttr, { width, 0 }));
+}
+
+void TextBufferTests::TestCompactRows()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const auto width = textBuffer.GetSize().Width();
+    const TextAttribute attr(FOREGROUND_GREEN);
+
+    textBuffer.WriteRun(L"Hello", attr, { 2, 0 });
+    const auto expectedText = textBuffer.GetRowByOffset(0).GetText();
+
+    Log::Comment(L"Compacted rows still read back as their full width.");
+    textBuffer.CompactRows(0, 2);
+    {
+        const auto& row = textBuffer.GetRowByOffset(0);
+        const auto& charRow = row.GetCharRow();
+        VERIFY_IS_TRUE(charRow.IsCompact());
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(width), charRow.size());
+        VERIFY_ARE_EQUAL(2u, charRow.MeasureLeft());
+        VERIFY_ARE_EQUAL(7u, charRow.MeasureRight());
+        VERIFY_ARE_EQUAL(expectedText, row.GetText());
+        VERIFY_ARE_EQUAL(L" ", std::wstring_view{ charRow.GlyphAt(width - 1) });
+        VERIFY_IS_TRUE(charRow.DbcsAttrAt(width - 1).IsSingle());
+
+        const auto& blankRow = textBuffer.GetRowByOffset(1).GetCharRow();
+        VERIFY_IS_TRUE(blankRow.IsCompact());
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(width), blankRow.MeasureLeft());
+        VERIFY_ARE_EQUAL(0u, blankRow.MeasureRight());
+        VERIFY_IS_FALSE(blankRow.ContainsText());
+    }
+
+    Log::Comment(L"Writing to a compacted row expands it again.");
+    textBuffer.WriteRun(L"World", attr, { 8, 0 });
+    {
+        const auto& row = textBuffer.GetRowByOffset(0);
+        VERIFY_IS_FALSE(row.GetCharRow().IsCompact());
+        VERIFY_ARE_EQUAL(L"  Hello World ", std::wstring_view{ row.GetText() }.substr(0, 14));
+    }
+
+    Log::Comment(L"Rows outside of the buffer are ignored.");
+    textBuffer.CompactRows(textBuffer.TotalRowCount() - 1, 10);
+}
+
+void TextBufferTests::TestClearRows()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const TextAttribute attr(FOREGROUND_GREEN);
+    const TextAttribute fillAttr(BACKGROUND_BLUE);
+
+    textBuffer.WriteRun(L"Hello", attr, { 0, 0 });
+    textBuffer.WriteRun(L"World", attr, { 0, 1 });
+    textBuffer.WriteRun(L"Again", attr, { 0, 2 });
+    textBuffer.GetRowByOffset(1).SetLineRendition(LineRendition::DoubleWidth);
+
+    Log::Comment(L"Cleared rows are only filled once they're accessed.");
+    textBuffer.ClearRows(0, 2, fillAttr);
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(0).IsRecycled());
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(1).IsRecycled());
+    VERIFY_IS_FALSE(textBuffer.GetRowByOffset(2).IsRecycled());
+
+    const auto& row = textBuffer.GetRowByOffset(0);
+    VERIFY_IS_FALSE(row.GetCharRow().ContainsText());
+    VERIFY_ARE_EQUAL(fillAttr, row.GetAttrRow().GetAttrByColumn(0));
+    VERIFY_IS_FALSE(row.IsRecycled());
+
+    Log::Comment(L"They keep their line rendition.");
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(1).GetLineRendition() == LineRendition::DoubleWidth);
+    VERIFY_ARE_EQUAL(L'A', textBuffer.GetRowByOffset(2).GetText().front());
+
+    Log::Comment(L"Rows outside of the buffer are ignored.");
+    textBuffer.ClearRows(textBuffer.TotalRowCount() - 1, 10, fillAttr);
+}
+
+void TextBufferTests::TestFillCells()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const auto width = gsl::narrow_cast<size_t>(textBuffer.GetSize().Width());
+    const TextAttribute attr(FOREGROUND_GREEN);
+    const TextAttribute fillAttr(BACKGROUND_BLUE);
+
+    textBuffer.WriteRun(L"Hello", attr, { 0, 0 });
+    textBuffer.GetRowByOffset(0).SetWrapForced(true);
+
+    Log::Comment(L"Filling text continues on the next rows and leaves the attributes alone.");
+    VERIFY_ARE_EQUAL(width + 5, textBuffer.FillText(L'x', { 2, 0 }, width + 5, false));
+    const auto& first = textBuffer.GetRowByOffset(0);
+    VERIFY_IS_TRUE(first.GetText().substr(0, 5) == L"Hexxx");
+    VERIFY_ARE_EQUAL(attr, first.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_IS_FALSE(first.WasWrapForced());
+    VERIFY_IS_TRUE(textBuffer.GetRowByOffset(1).GetText().substr(0, 8) == L"xxxxxxx ");
+
+    Log::Comment(L"Filling attributes leaves the text alone.");
+    VERIFY_ARE_EQUAL(width, textBuffer.FillAttributes(fillAttr, { 3, 0 }, width));
+    VERIFY_ARE_EQUAL(attr, first.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(fillAttr, first.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(fillAttr, textBuffer.GetRowByOffset(1).GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_NOT_EQUAL(fillAttr, textBuffer.GetRowByOffset(1).GetAttrRow().GetAttrByColumn(3));
+    VERIFY_IS_TRUE(first.GetText().substr(0, 5) == L"Hexxx");
+
+    Log::Comment(L"Fills stop at the end of the buffer.");
+    const COORD lastCell{ gsl::narrow<SHORT>(width - 2), gsl::narrow<SHORT>(textBuffer.TotalRowCount() - 1) };
+    VERIFY_ARE_EQUAL(size_t{ 2 }, textBuffer.FillText(L'y', lastCell, 10));
+    VERIFY_ARE_EQUAL(size_t{ 2 }, textBuffer.FillAttributes(fillAttr, lastCell, 10));
+    VERIFY_ARE_EQUAL(size_t{ 0 }, textBuffer.FillText(L'y', { 0, gsl::narrow<SHORT>(textBuffer.TotalRowCount()) }, 10));
+}
+
+void TextBufferTests::TestCachedRowText()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const TextAttribute attr{};
+
+    textBuffer.WriteRun(L"Hello", attr, { 0, 0 });
+    const auto& constBuffer = std::as_const(textBuffer);
+
+    Log::Comment(L"The cached text is the text of the row, and is kept while nothing changes.");
+    const auto generation = constBuffer.GetGeneration();
+    const auto& cached = constBuffer.GetCachedRowText(0);
+    VERIFY_ARE_EQUAL(constBuffer.GetRowByOffset(0).GetText(), cached);
+    VERIFY_ARE_EQUAL(&cached, &constBuffer.GetCachedRowText(0));
+    VERIFY_ARE_EQUAL(generation, constBuffer.GetGeneration());
+
+    Log::Comment(L"Modifying the buffer invalidates the cache.");
+    textBuffer.WriteRun(L"World", attr, { 0, 0 });
+    VERIFY_ARE_NOT_EQUAL(generation, constBuffer.GetGeneration());
+    VERIFY_ARE_EQUAL(L"World", std::wstring_view{ constBuffer.GetCachedRowText(0) }.substr(0, 5));
+
+    Log::Comment(L"So does circling the buffer.");
+    const auto secondRow = constBuffer.GetRowByOffset(1).GetText();
+    VERIFY_IS_TRUE(textBuffer.IncrementCircularBuffer());
+    VERIFY_ARE_EQUAL(secondRow, constBuffer.GetCachedRowText(0));
+}
+
+void TextBufferTests::TestCachedRowTextSlices()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const TextAttribute attr{};
+    const auto& constBuffer = std::as_const(textBuffer);
+
+    Log::Comment(L"Rows of narrow characters are sliced by column.");
+    textBuffer.WriteRun(L"Hello", attr, { 0, 0 });
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"ell" }, constBuffer.GetCachedRowText(0, 1, 4));
+
+    Log::Comment(L"Wide glyphs are part of the slice if their leading half is.");
+    textBuffer.WriteLine(OutputCellIterator{ L"a\x3042b", attr }, { 0, 1 });
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"a\x3042" }, constBuffer.GetCachedRowText(1, 0, 2));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"b" }, constBuffer.GetCachedRowText(1, 2, 4));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x3042b" }, constBuffer.GetCachedRowText(1, 1, 4));
+
+    Log::Comment(L"Columns past the end of the row are ignored.");
+    const auto width = gsl::narrow_cast<size_t>(constBuffer.GetSize().Width());
+    VERIFY_ARE_EQUAL(width - 2, constBuffer.GetCachedRowText(1, 1, width * 2).size());
+    VERIFY_IS_TRUE(constBuffer.GetCachedRowText(0, width, width * 2).empty());
+}
+
+void TextBufferTests::TestPatternsOnlyRescanDirtyLines()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const TextAttribute attr{};
+    const auto width = textBuffer.GetSize().Width();
+
+    const auto patternId = textBuffer.AddPatternRecognizer(L"https?://\\S+");
+
+    textBuffer.WriteRun(L"see http://a.b", attr, { 0, 1 });
+
+    Log::Comment(L"A match in a wrapped line spans both rows.");
+    // Filling the last column of row 3 marks it as wrapped.
+    textBuffer.WriteRun(L"https", attr, { gsl::narrow_cast<SHORT>(width - 5), 3 });
+    textBuffer.WriteRun(L"://c.d end", attr, { 0, 4 });
+
+    const auto& constBuffer = std::as_const(textBuffer);
+    auto patterns = constBuffer.GetPatterns(0, 5);
+    auto found = patterns.findContained(til::point{ 0, 0 }, til::point{ 0, 6 });
+    VERIFY_ARE_EQUAL(2u, found.size());
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.start < b.start; });
+    VERIFY_ARE_EQUAL(patternId, found.at(0).value);
+    VERIFY_ARE_EQUAL((til::point{ 4, 1 }), found.at(0).start);
+    VERIFY_ARE_EQUAL((til::point{ 14, 1 }), found.at(0).stop);
+    VERIFY_ARE_EQUAL((til::point{ width - 5, 3 }), found.at(1).start);
+    VERIFY_ARE_EQUAL((til::point{ 6, 4 }), found.at(1).stop);
+
+    Log::Comment(L"Rows 3 and 4 form a single line, so 5 lines are cached.");
+    VERIFY_ARE_EQUAL(5u, textBuffer._patternCache.size());
+    const std::vector<uint64_t> firstLineKey{ constBuffer.GetRowByOffset(1).GetGeneration() };
+    const auto firstLine = textBuffer._patternCache.find(firstLineKey);
+    VERIFY_IS_TRUE(firstLine != textBuffer._patternCache.end());
+    const auto firstLineMatches = &firstLine->second;
+
+    Log::Comment(L"Modifying another row keeps the cached matches of the unchanged lines.");
+    textBuffer.WriteRun(L"no links here", attr, { 0, 2 });
+    patterns = constBuffer.GetPatterns(0, 5);
+    VERIFY_ARE_EQUAL(2u, patterns.findContained(til::point{ 0, 0 }, til::point{ 0, 6 }).size());
+    VERIFY_ARE_EQUAL(5u, textBuffer._patternCache.size());
+    VERIFY_ARE_EQUAL(firstLineMatches, &textBuffer._patternCache.at(firstLineKey));
+
+    Log::Comment(L"Lines that are no longer visible are evicted.");
+    patterns = constBuffer.GetPatterns(0, 0);
+    VERIFY_IS_TRUE(patterns.empty());
+    VERIFY_ARE_EQUAL(1u, textBuffer._patternCache.size());
+
+    textBuffer.ClearPatternRecognizers();
+    VERIFY_IS_TRUE(textBuffer._patternCache.empty());
+}
+
+void TextBufferTests::TestPatternsAfterWideGlyphs()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const TextAttribute attr{};
+
+    const auto patternId = textBuffer.AddPatternRecognizer(L"https?://\\S+");
+
+    Log::Comment(L"Wide glyphs before and between the matches take up two cells each.");
+    textBuffer.WriteLine(OutputCellIterator{ L"\x3042 http://a.b \x3042 http://c", attr }, { 0, 0 });
+
+    const auto patterns = std::as_const(textBuffer).GetPatterns(0, 0);
+    auto found = patterns.findContained(til::point{ 0, 0 }, til::point{ 0, 1 });
+    VERIFY_ARE_EQUAL(2u, found.size());
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.start < b.start; });
+    VERIFY_ARE_EQUAL(patternId, found.at(0).value);
+    VERIFY_ARE_EQUAL((til::point{ 3, 0 }), found.at(0).start);
+    VERIFY_ARE_EQUAL((til::point{ 13, 0 }), found.at(0).stop);
+    VERIFY_ARE_EQUAL((til::point{ 17, 0 }), found.at(1).start);
+    VERIFY_ARE_EQUAL((til::point{ 25, 0 }), found.at(1).stop);
+
+    textBuffer.ClearPatternRecognizers();
+}
+
 void TextBufferTests::TestDoubleBytePadFlag()
 {
     TextBuffer& textBuffer = GetTbi();
@@ -629,8 +900,12 @@ void TextBufferTests::TestIncrementCircularBuffer()
         VERIFY_ARE_EQUAL(textBuffer._firstRow, iNextRowIndex); // first row has incremented
         VERIFY_ARE_NOT_EQUAL(textBuffer._GetFirstRow(), FirstRow); // the old first row is no longer the first
 
+        // the old first row is only cleared once it's accessed again
+        VERIFY_IS_TRUE(FirstRow.IsRecycled());
+
         // ensure old first row has been emptied
         VERIFY_IS_FALSE(FirstRow.GetCharRow().ContainsText());
+        VERIFY_IS_FALSE(FirstRow.IsRecycled());
     }
 }
 
@@ -1911,7 +2186,7 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
 }
 
 // This tests that rows removed from the buffer while resizing traditionally will also drop the high unicode
-// characters from the Unicode Storage buffer
+// characters that were stored for them
 void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
 {
     // Set up a text buffer for us
@@ -1935,18 +2210,21 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetCharRow()._glyphs.size(), L"There should be one stored glyph in the row.");
 
     // Perform resize to trim off the row of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X, bufferSize.Y - 1 };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (const auto& row : _buffer->_storage)
+    {
+        VERIFY_IS_TRUE(row.GetCharRow()._glyphs.empty(), L"No row should have a stored glyph anymore.");
+    }
 }
 
 // This tests that columns removed from the buffer while resizing traditionally will also drop the high unicode
-// characters from the Unicode Storage buffer
+// characters that were stored for them
 void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
 {
     // Set up a text buffer for us
@@ -1970,14 +2248,14 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetCharRow()._glyphs.size(), L"There should be one stored glyph in the row.");
 
     // Perform resize to trim off the column of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X - 1, bufferSize.Y };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    VERIFY_IS_TRUE(_buffer->_storage[pos.Y].GetCharRow()._glyphs.empty(), L"The glyph should have been dropped with its column.");
 }
 
 void TextBufferTests::TestBurrito()
@@ -2622,7 +2900,7 @@ void TextBufferTests::HyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap.find(finalCustomId), _buffer->_hyperlinkCustomIdMap.end());
 
     // The other hyperlink reference should not be deleted
-    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap[otherId], otherUrl);
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(otherId), otherUrl);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalOtherCustomId], otherId);
 }
 
@@ -2660,3 +2938,69 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+// This tests that the hyperlink references that are counted for each row follow
+// the rows being modified between two increments of the circular buffer
+void TextBufferTests::HyperlinkTrimAfterRowsChanged()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const auto url = L"test.url";
+    const auto id = _buffer->GetHyperlinkId(url, L"");
+    TextAttribute linkAttr{ 0x7f };
+    linkAttr.SetHyperlinkId(id);
+    _buffer->AddHyperlinkToMap(url, id);
+
+    Log::Comment(L"The link is in the first row and in another one, so it's kept.");
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(70, linkAttr);
+    _buffer->GetRowByOffset(5).GetAttrRow().SetAttrToEnd(70, linkAttr);
+    _buffer->IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
+
+    Log::Comment(L"Move the link from the other row into the new first row.");
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(70, linkAttr);
+    _buffer->GetRowByOffset(4).GetAttrRow().SetAttrToEnd(0, attr);
+
+    Log::Comment(L"Now the first row is the only one with the link, so it's removed.");
+    _buffer->IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap.find(id), _buffer->_hyperlinkMap.end());
+}
+
+// This tests that the URIs of the hyperlinks are kept intact when the
+// URIs of removed hyperlinks are squeezed out of the storage
+void TextBufferTests::HyperlinkUrisSurviveCompaction()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    std::vector<std::pair<uint16_t, std::wstring>> kept;
+    for (auto i = 0; i < 100; ++i)
+    {
+        const auto url = fmt::format(L"https://example.com/{}", i);
+        const auto id = _buffer->GetHyperlinkId(url, L"");
+        _buffer->AddHyperlinkToMap(url, id);
+        if (i % 4 == 0)
+        {
+            kept.emplace_back(id, url);
+        }
+        else
+        {
+            _buffer->RemoveHyperlinkFromMap(id);
+        }
+    }
+
+    Log::Comment(L"Replacing the URI of a hyperlink removes the old one, too.");
+    _buffer->AddHyperlinkToMap(L"other.url", kept.front().first);
+    kept.front().second = L"other.url";
+
+    VERIFY_IS_LESS_THAN(_buffer->_hyperlinkUris.size(), size_t{ 100 * 20 });
+    for (const auto& [id, url] : kept)
+    {
+        VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
+    }
+}
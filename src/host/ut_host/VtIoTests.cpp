@@ -402,7 +402,12 @@ public:
         return {};
     }
 
-    const std::vector<size_t> GetPatternId(const COORD /*location*/) const noexcept
+    void GetPatternId(const COORD /*location*/, std::vector<size_t>& ids) const noexcept
+    {
+        ids.clear();
+    }
+
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept override
     {
         return {};
     }
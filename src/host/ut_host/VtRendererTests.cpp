@@ -80,9 +80,15 @@ class Microsoft::Console::Render::VtRendererTest
     TEST_METHOD(TestWrapping);
 
     TEST_METHOD(TestResize);
+    TEST_METHOD(TestResizeNegotiated);
 
     TEST_METHOD(TestCursorVisibility);
 
+    TEST_METHOD(TestDiffRendering);
+    TEST_METHOD(TestPassthrough);
+    TEST_METHOD(TestWholeFrame);
+    TEST_METHOD(TestScrollRegion);
+
     void Test16Colors(VtEngine* engine);
 
     std::deque<std::string> qExpectedInput;
@@ -1401,6 +1407,226 @@ void VtRendererTest::TestWrapping()
     });
 }
 
+void VtRendererTest::TestDiffRendering()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    engine->SetDiffRendering(true);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaint(*engine, [&]() {
+        qExpectedInput.push_back("\x1b[H");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 0 }));
+    });
+
+    const auto makeClusters = [](const std::wstring_view text) {
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            clusters.emplace_back(text.substr(i, 1), 1u);
+        }
+        return clusters;
+    };
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Runs of the same character are compressed with REP."));
+        qExpectedInput.push_back("abc-");
+        qExpectedInput.push_back("\x1b[11b");
+        qExpectedInput.push_back("def");
+
+        const auto clusters = makeClusters(L"abc------------def");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 0, 0 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Only the cell that changed since the last frame is emitted."));
+        qExpectedInput.push_back("\x1b[1;17H");
+        qExpectedInput.push_back("X");
+
+        const auto clusters = makeClusters(L"abc------------dXf");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 0, 0 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Repainting an unchanged line emits nothing at all."));
+        const auto clusters = makeClusters(L"abc------------dXf");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 0, 0 }, false, false));
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
+void VtRendererTest::TestPassthrough()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    engine->BeginPassthrough();
+
+    Log::Comment(NoThrowString().Format(
+        L"While passing through, the client's output is written as is and nothing is painted."));
+    qExpectedInput.push_back("\x1b[31mHello\r\n");
+    VERIFY_SUCCEEDED(engine->WritePassthrough(L"\x1b[31mHello\r\n"));
+
+    const SMALL_RECT invalid = { 0, 0, 4, 0 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    VERIFY_ARE_EQUAL(S_FALSE, engine->StartPaint());
+    VERIFY_ARE_EQUAL(S_FALSE, engine->WriteTerminalW(L"X"));
+
+    Log::Comment(NoThrowString().Format(
+        L"Ending the passthrough resets the attributes and hides the cursor."));
+    qExpectedInput.push_back("\x1b[m");
+    qExpectedInput.push_back("\x1b[?25l");
+    VERIFY_SUCCEEDED(engine->EndPassthrough());
+    VERIFY_IS_FALSE(engine->_passthrough);
+    VERIFY_IS_FALSE(engine->_invalidMap.any());
+
+    VerifyExpectedInputsDrained();
+}
+
+void VtRendererTest::TestWholeFrame()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    const Viewport view = SetUpViewport();
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), view);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Invalidating less than most of the viewport only invalidates that portion."));
+    SMALL_RECT invalid = view.ToExclusive();
+    invalid.Bottom = invalid.Bottom / 2;
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_invalidMap.all());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Invalidating most of the viewport invalidates all of it."));
+    invalid = view.ToExclusive();
+    invalid.Bottom = invalid.Bottom * 3 / 8;
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    invalid = view.ToExclusive();
+    invalid.Top = invalid.Bottom * 4 / 8;
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_TRUE(engine->_invalidMap.all());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Frames that scroll keep their partial invalidation."));
+    invalid = view.ToExclusive();
+    invalid.Bottom = invalid.Bottom * 7 / 8;
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    const COORD scrollDelta = { 0, -1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_invalidMap.all());
+        qExpectedInput.push_back("\x1b[32;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\n"); // Scroll down once
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
+void VtRendererTest::TestScrollRegion()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    const Viewport view = SetUpViewport();
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), view);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    const auto width = view.Width();
+    SMALL_RECT region{ 0, 5, width, 15 };
+
+    const auto isInvalid = [&](const til::point point) {
+        const auto runs = engine->_invalidMap.runs();
+        return std::any_of(runs.begin(), runs.end(), [&](const auto& run) { return run.contains(point); });
+    };
+
+    Log::Comment(NoThrowString().Format(
+        L"Scrolling a region up sets the margins around it and only invalidates the revealed rows."));
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, -2));
+    TestPaint(*engine, [&]() {
+        auto invalidRect = engine->_invalidMap.runs().front();
+        for (const auto& run : engine->_invalidMap.runs())
+        {
+            invalidRect |= run;
+        }
+        VERIFY_ARE_EQUAL(til::rectangle(0, 13, width, 15), invalidRect);
+
+        qExpectedInput.push_back("\x1b[6;15r"); // Set the margins
+        qExpectedInput.push_back("\x1b[2S"); // Scroll up twice
+        qExpectedInput.push_back("\x1b[r"); // Reset the margins
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+        VERIFY_ARE_EQUAL(COORD({ 0, 0 }), engine->_lastText);
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Invalid cells within the region move along with its rows, and scrolls accumulate."));
+    SMALL_RECT invalid{ 3, 10, 4, 11 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, 1));
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, 1));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_TRUE(isInvalid(til::point{ 3, 12 }));
+        VERIFY_IS_FALSE(isInvalid(til::point{ 3, 10 }));
+        VERIFY_IS_TRUE(isInvalid(til::point{ 0, 5 }));
+        VERIFY_IS_TRUE(isInvalid(til::point{ 0, 6 }));
+        VERIFY_IS_FALSE(isInvalid(til::point{ 0, 7 }));
+
+        qExpectedInput.push_back("\x1b[6;15r"); // Set the margins
+        qExpectedInput.push_back("\x1b[2T"); // Scroll down twice
+        qExpectedInput.push_back("\x1b[r"); // Reset the margins
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"A region that doesn't span the whole width is just repainted."));
+    SMALL_RECT narrow{ 0, 5, gsl::narrow_cast<SHORT>(width / 2), 15 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&narrow, -1));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_scrollRegion.has_value());
+        VERIFY_IS_TRUE(isInvalid(til::point{ 0, 5 }));
+        VERIFY_IS_FALSE(isInvalid(til::point{ width - 1, 5 }));
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
 void VtRendererTest::TestResize()
 {
     Viewport view = SetUpViewport();
@@ -1438,6 +1664,52 @@ void VtRendererTest::TestResize()
     });
 }
 
+void VtRendererTest::TestResizeNegotiated()
+{
+    Viewport view = SetUpViewport();
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), view);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    engine->SetResizeQuirk(true);
+    engine->SetResizeNegotiated(true);
+
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_SUCCEEDED(engine->UpdateViewport(view.ToInclusive()));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"A resize that moves the viewport doesn't scroll the terminal, "
+        L"but the whole viewport is resent."));
+    const auto newView = Viewport::FromDimensions({ 0, 0 }, { 60, 30 });
+    engine->BeginResizeRequest();
+    VERIFY_SUCCEEDED(engine->UpdateViewport(newView.ToInclusive()));
+    const COORD scrollDelta = { 0, -3 };
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    engine->EndResizeRequest();
+
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_TRUE(engine->_invalidMap.all());
+        VERIFY_ARE_EQUAL(til::point{}, engine->_scrollDelta);
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Outside of a resize, scrolling is replayed as usual."));
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_invalidMap.all());
+        VERIFY_ARE_EQUAL(til::point(0, -3), engine->_scrollDelta);
+        qExpectedInput.push_back("\x1b[30;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\n\n\n"); // Scroll down three times
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
 void VtRendererTest::TestCursorVisibility()
 {
     Viewport view = SetUpViewport();
@@ -1584,4 +1856,10 @@ void VtRendererTest::FormattedString()
     const auto bigValue = 500;
     qExpectedInput.push_back("\x1b[28;3;500;500;500m");
     VERIFY_SUCCEEDED(engine->_WriteFormattedString(&bigFormat, bigValue, bigValue, bigValue));
+
+    Log::Comment(L"4.) Now write something that doesn't fit on the stack. Should still be fine.");
+    static const std::string hugeFormat("\x1b]0;%s\x7");
+    const std::string hugeValue(200, 'x');
+    qExpectedInput.push_back("\x1b]0;" + hugeValue + "\x7");
+    VERIFY_SUCCEEDED(engine->_WriteFormattedString(&hugeFormat, hugeValue.c_str()));
 }
@@ -17,9 +17,14 @@ extern "C" {
 
 #define PSEUDOCONSOLE_RESIZE_QUIRK (2u)
 #define PSEUDOCONSOLE_WIN32_INPUT_MODE (4u)
+#define PSEUDOCONSOLE_DIFF_RENDERING (8u)
+#define PSEUDOCONSOLE_PASSTHROUGH_MODE (16u)
+#define PSEUDOCONSOLE_RESIZE_NEGOTIATED (32u)
 
 HRESULT WINAPI ConptyCreatePseudoConsole(COORD size, HANDLE hInput, HANDLE hOutput, DWORD dwFlags, HPCON* phPC);
 
+HRESULT WINAPI ConptyCreatePseudoConsoleWithCursor(COORD size, HANDLE hInput, HANDLE hOutput, DWORD dwFlags, COORD cursor, HPCON* phPC);
+
 HRESULT WINAPI ConptyResizePseudoConsole(HPCON hPC, COORD size);
 
 VOID WINAPI ConptyClosePseudoConsole(HPCON hPC);
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#ifdef _DEBUG
+#include <crtdbg.h>
+#endif
+
+// The allocation tracker counts the allocations, and the bytes they asked for,
+// of a few named regions of the output and render paths. The regions are
+// marked with allocation_tracker::scope, which only sets a thread-local
+// variable. Nothing is counted unless something calls record() for every
+// allocation, like the CRT hook that debug builds can install, or a test
+// module that replaces operator new.
+namespace til
+{
+    enum class allocation_region : size_t
+    {
+        none,
+        parse,
+        buffer_write,
+        paint,
+        present,
+    };
+
+    class allocation_tracker
+    {
+    public:
+        static constexpr size_t region_count = 5;
+
+        struct counts
+        {
+            size_t allocations = 0;
+            size_t bytes = 0;
+
+            constexpr counts operator-(const counts& other) const noexcept
+            {
+                return { allocations - other.allocations, bytes - other.bytes };
+            }
+
+            constexpr counts operator+(const counts& other) const noexcept
+            {
+                return { allocations + other.allocations, bytes + other.bytes };
+            }
+        };
+
+        // Attributes the allocations this thread makes to a region, for as
+        // long as the scope exists. Scopes nest and the innermost one wins,
+        // so a buffer write during parsing only counts as a buffer write.
+        class scope
+        {
+        public:
+            explicit scope(const allocation_region region) noexcept :
+                _previous{ std::exchange(_current, region) }
+            {
+            }
+
+            ~scope()
+            {
+                _current = _previous;
+            }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+            scope(scope&&) = delete;
+            scope& operator=(scope&&) = delete;
+
+        private:
+            allocation_region _previous;
+        };
+
+        // Counts an allocation of the given size towards the region this thread is in.
+        static void record(const size_t bytes) noexcept
+        {
+            const auto index = static_cast<size_t>(_current);
+            if (index != 0 && index < region_count)
+            {
+                til::at(_allocations, index).fetch_add(1, std::memory_order_relaxed);
+                til::at(_bytes, index).fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+
+        // Returns what was counted towards a region so far, across all threads.
+        static counts get(const allocation_region region) noexcept
+        {
+            const auto index = static_cast<size_t>(region);
+            if (index >= region_count)
+            {
+                return {};
+            }
+            return { til::at(_allocations, index).load(std::memory_order_relaxed), til::at(_bytes, index).load(std::memory_order_relaxed) };
+        }
+
+        // Makes the CRT call record() for every allocation, which only its
+        // debug build can do. Returns false in release builds, where it's up
+        // to whoever wants the numbers to call record().
+        static bool install_crt_hook() noexcept
+        {
+#ifdef _DEBUG
+            _CrtSetAllocHook(&_crt_hook);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    private:
+#ifdef _DEBUG
+        static int __cdecl _crt_hook(int allocType, void* /*userData*/, size_t size, int /*blockType*/, long /*requestNumber*/, const unsigned char* /*filename*/, int /*lineNumber*/) noexcept
+        {
+            if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+            {
+                record(size);
+            }
+            return TRUE;
+        }
+#endif
+
+        inline static thread_local allocation_region _current = allocation_region::none;
+        inline static std::array<std::atomic<size_t>, region_count> _allocations{};
+        inline static std::array<std::atomic<size_t>, region_count> _bytes{};
+    };
+}
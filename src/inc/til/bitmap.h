@@ -101,25 +101,27 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 if (_nextPos < _end)
                 {
                     // pos is now at the first on bit.
-                    const auto runStart = _rc.point_at(_nextPos);
+                    // _nextPos is known to be within _rc, so we can skip the
+                    // checked math of point_at and index_of here.
+                    const auto width = _rc.width();
+                    const auto row = _nextPos / width;
+                    const til::point runStart{ _rc.left() + _nextPos % width, _rc.top() + row };
 
                     // We'll only count up until the end of this row.
                     // a run can be a max of one row tall.
-                    const ptrdiff_t rowEndIndex = _rc.index_of(til::point(_rc.right() - 1, runStart.y())) + 1;
-
-                    // Find the length for the rectangle.
-                    ptrdiff_t runLength = 0;
+                    const ptrdiff_t rowEndIndex = (row + 1) * width;
+                    const auto runBegin = _nextPos;
 
                     // We have at least 1 so start with a do/while.
                     do
                     {
                         ++_nextPos;
-                        ++runLength;
-                    } while (_nextPos < rowEndIndex && _values[_nextPos]);
+#pragma warning(suppress : 26472) // we can't depend on GSL here, so we use static_cast for explicit narrowing
+                    } while (_nextPos < rowEndIndex && _values.test(static_cast<size_t>(_nextPos)));
                     // Keep going until we reach end of row, end of the buffer, or the next bit is off.
 
                     // Assemble and store that run.
-                    _run = til::rectangle{ runStart, til::size{ runLength, static_cast<ptrdiff_t>(1) } };
+                    _run = til::rectangle{ runStart, til::size{ _nextPos - runBegin, static_cast<ptrdiff_t>(1) } };
                 }
                 else
                 {
@@ -285,22 +287,36 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     return;
                 }
 
-                // FUTURE: PERF: GH #4015: This could use in-place walk semantics instead of a temporary.
-                bitmap<allocator_type> other{ _sz, _alloc };
-
-                for (auto run : *this)
+                // If everything slides out to the side, there's nothing left to move.
+                if (std::abs(delta.x()) >= _sz.width())
                 {
-                    // Offset by the delta
-                    run += delta;
+                    if (fill)
+                    {
+                        set_all();
+                    }
+                    else
+                    {
+                        reset_all();
+                    }
+                    return;
+                }
 
-                    // Intersect with the bounds of our bitmap area
-                    // as part of it could have slid out of bounds.
-                    run &= _rc;
+                // Moving every bit by delta.y() rows and delta.x() columns is the same as moving
+                // it by delta.y() * width + delta.x() bits, as the bits are stored row by row.
+                // Only the bits that slide out of a row on one side end up in the wrong place:
+                // at the other side of the next or previous row, in the columns that got uncovered.
+                const auto columns = std::abs(delta.x());
+                _shift(delta.y() * _sz.width() + delta.x());
 
-                    // Set it into the new bitmap.
-                    other.set(run);
+                const auto uncoveredColumn = delta.x() > 0 ? 0 : _sz.width() - columns;
+                for (ptrdiff_t row = 0; row < _sz.height(); ++row)
+                {
+#pragma warning(suppress : 26472) // we can't depend on GSL here, so we use static_cast for explicit narrowing
+                    _bits.reset(static_cast<size_t>(row * _sz.width() + uncoveredColumn), static_cast<size_t>(columns));
                 }
 
+                _runs.reset(); // reset cached runs on any non-const method
+
                 // If we were asked to fill... find the uncovered region.
                 if (fill)
                 {
@@ -340,12 +356,9 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     const auto fillRects = originalRect - translatedRect;
                     for (const auto& f : fillRects)
                     {
-                        other.set(f);
+                        set(f);
                     }
                 }
-
-                // Swap us with the temporary one.
-                std::swap(other, *this);
             }
 
             void set(const til::point pt)
@@ -361,10 +374,33 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 THROW_HR_IF(E_INVALIDARG, !_rc.contains(rc));
                 _runs.reset(); // reset cached runs on any non-const method
 
-                for (auto row = rc.top(); row < rc.bottom(); ++row)
-                {
-                    _bits.set(_rc.index_of(til::point{ rc.left(), row }), rc.width(), true);
-                }
+                _setRows(rc, true);
+            }
+
+            void reset(const til::point pt)
+            {
+                THROW_HR_IF(E_INVALIDARG, !_rc.contains(pt));
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _bits.reset(_rc.index_of(pt));
+            }
+
+            void reset(const til::rectangle rc)
+            {
+                THROW_HR_IF(E_INVALIDARG, !_rc.contains(rc));
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _setRows(rc, false);
+            }
+
+            // Leaves only the bits that are set in exactly one of the two bitmaps.
+            bitmap& operator^=(const bitmap& other)
+            {
+                THROW_HR_IF(E_INVALIDARG, _sz != other._sz);
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _bits ^= other._bits;
+                return *this;
             }
 
             void set_all() noexcept
@@ -473,6 +509,53 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             }
 
         private:
+            // Sets or resets the bits of the given rectangle, which has to be within _rc.
+            void _setRows(const til::rectangle rc, const bool value)
+            {
+                if (rc.empty())
+                {
+                    return;
+                }
+
+                // A rectangle spanning entire rows is a single range of bits.
+                if (rc.width() == _sz.width())
+                {
+                    _bits.set(_rc.index_of(rc.origin()), rc.size().area(), value);
+                    return;
+                }
+
+                for (auto row = rc.top(); row < rc.bottom(); ++row)
+                {
+                    _bits.set(_rc.index_of(til::point{ rc.left(), row }), rc.width(), value);
+                }
+            }
+
+            // Moves all bits by the given number of positions towards the end
+            // (or the start, if negative). The bits shifted in are 0.
+            void _shift(const ptrdiff_t bitShift)
+            {
+#pragma warning(push)
+                // we can't depend on GSL here, so we use static_cast for explicit narrowing
+#pragma warning(disable : 26472)
+                const auto newBits = static_cast<size_t>(std::abs(bitShift));
+#pragma warning(pop)
+
+                if (newBits >= _bits.size())
+                {
+                    _bits.reset();
+                }
+                else if (bitShift > 0)
+                {
+                    // This operator doesn't modify the size of `_bits`: the
+                    // new bits are set to 0.
+                    _bits <<= newBits;
+                }
+                else
+                {
+                    _bits >>= newBits;
+                }
+            }
+
             void translate_y(ptrdiff_t delta_y, bool fill)
             {
                 if (delta_y == 0)
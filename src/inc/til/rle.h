@@ -3,6 +3,10 @@
 
 #pragma once
 
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#endif
+
 #ifdef UNIT_TESTING
 class RunLengthEncodingTests;
 #endif
@@ -11,6 +15,54 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
     namespace details
     {
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+#pragma warning(disable : 26490) // Don't use reinterpret_cast.
+        // Routine Description:
+        // - Returns the end of the run of values equal to *first, that starts at first.
+        // - On x86/x64 16-bit integers (like the attribute IDs of ATTR_ROW)
+        //   are compared 8 at a time with SSE2.
+        // Arguments:
+        // - first - the beginning of the values
+        // - last - the end of the values
+        // Return Value:
+        // - a pointer to the first value that isn't equal to *first, or last
+        template<typename T>
+        const T* find_run_end(const T* first, const T* const last) noexcept
+        {
+            if (first == last)
+            {
+                return last;
+            }
+
+            const T value = *first;
+
+#if defined(_M_X64) || defined(_M_IX86)
+            if constexpr (std::is_integral_v<T> && sizeof(T) == 2)
+            {
+                const auto needle = _mm_set1_epi16(static_cast<short>(value));
+                for (; last - first >= 8; first += 8)
+                {
+                    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                    // Every value that differs leaves two bytes of the mask set.
+                    const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_cmpeq_epi16(chunk, needle))) ^ 0xffff;
+                    if (mask != 0)
+                    {
+                        unsigned long index{};
+                        _BitScanForward(&index, mask);
+                        return first + index / 2;
+                    }
+                }
+            }
+#endif
+
+            for (; first != last && *first == value; ++first)
+            {
+            }
+            return first;
+        }
+#pragma warning(pop)
+
         template<typename T, typename S, typename ParentIt>
         class rle_iterator
         {
@@ -313,6 +365,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         constexpr basic_rle() noexcept = default;
         ~basic_rle() = default;
 
+        explicit basic_rle(const allocator_type& allocator) noexcept :
+            _runs(allocator)
+        {
+        }
+
         basic_rle(const basic_rle& other) = default;
         basic_rle& operator=(const basic_rle& other) = default;
 
@@ -477,6 +534,37 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             _replace_unchecked(start_index, end_index, replacements);
         }
 
+        // Replace the range [start_index, start_index + values.size()) with values, one per position.
+        // If start_index + values.size() is larger than size() the vector grows to fit.
+        // start_index must be smaller or equal to size().
+        // This encodes all values in a single pass, which is much cheaper than
+        // calling replace() for every value or for every run of them.
+        void replace(size_type start_index, const gsl::span<const value_type> values)
+        {
+            if (start_index == 0 && values.size() >= _total_length)
+            {
+                assign(values);
+                return;
+            }
+
+            auto end_index = gsl::narrow<size_type>(start_index + values.size());
+            _check_indices(start_index, end_index);
+            const auto runs = _encode(values);
+            _replace_unchecked(start_index, end_index, { runs.data(), runs.size() });
+        }
+
+        // Replaces the contents of this vector with values, one per position.
+        void assign(const gsl::span<const value_type> values)
+        {
+            // Narrow first, so that a failure leaves the vector untouched.
+            const auto total_length = gsl::narrow<size_type>(values.size());
+
+            _runs.clear();
+            _total_length = 0;
+            _append_encoded(_runs, values);
+            _total_length = total_length;
+        }
+
         // Replaces every instance of old_value in this vector with new_value.
         void replace_values(const value_type& old_value, const value_type& new_value)
         {
@@ -641,6 +729,27 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         {
         }
 
+        // Appends the runs of values to runs.
+        static void _append_encoded(container& runs, const gsl::span<const value_type> values)
+        {
+            const auto data = values.data();
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+            const auto end = data + values.size();
+            for (auto it = data; it != end;)
+            {
+                const auto run_end = details::find_run_end(it, end);
+                runs.emplace_back(*it, static_cast<size_type>(run_end - it));
+                it = run_end;
+            }
+        }
+
+        static container _encode(const gsl::span<const value_type> values)
+        {
+            container runs;
+            _append_encoded(runs, values);
+            return runs;
+        }
+
         void _compact()
         {
             auto it = _runs.begin();
@@ -1024,6 +1133,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 #ifdef BOOST_CONTAINER_CONTAINER_SMALL_VECTOR_HPP
     template<typename T, typename S = std::size_t, std::size_t N = 1>
     using small_rle = basic_rle<T, S, boost::container::small_vector<rle_pair<T, S>, N>>;
+
+    namespace pmr
+    {
+        template<typename T, typename S = std::size_t, std::size_t N = 1>
+        using small_rle = basic_rle<T, S, boost::container::small_vector<rle_pair<T, S>, N, std::pmr::polymorphic_allocator<rle_pair<T, S>>>>;
+    }
 #endif
 };
 
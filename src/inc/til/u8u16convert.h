@@ -14,6 +14,9 @@ could overcome disadvantages of syscalls. Test results can be read up
 in PR #4093 and the test algorithms are available in src\tools\U8U16Test.
 Based on the results the decision was made to keep using the platform
 functions MultiByteToWideChar and WideCharToMultiByte.
+The only exception are runs of ASCII characters, which are widened (UTF-8)
+or narrowed (UTF-16) with SSE2 on x86/x64 before the remainder is handed to
+the platform.
 
 Author(s):
 - Steffen Illhardt (german-one) 2020
@@ -21,8 +24,185 @@ Author(s):
 
 #pragma once
 
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#endif
+
 namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
+    namespace details
+    {
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+#pragma warning(disable : 26490) // Don't use reinterpret_cast.
+        // Routine Description:
+        // - Widens the leading ASCII characters of a UTF-8 string to UTF-16.
+        // - On x86/x64 this converts 16 characters at a time with SSE2. The vector
+        //   loop might write up to 15 code units past the ones it returns, so out
+        //   needs to have room for at least length code units.
+        // Arguments:
+        // - in - the UTF-8 string
+        // - length - the length of in
+        // - out - receives the UTF-16 code units
+        // Return Value:
+        // - the number of leading ASCII characters that were converted
+        inline size_t u8u16WidenAscii(const char* const in, const size_t length, wchar_t* const out) noexcept
+        {
+            size_t i{};
+
+#if defined(_M_X64) || defined(_M_IX86)
+            const auto zero = _mm_setzero_si128();
+            for (; length - i >= 16; i += 16)
+            {
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(chars, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(chars, zero));
+
+                // Non-ASCII bytes have their highest bit set.
+                const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(chars));
+                if (mask != 0)
+                {
+                    unsigned long index{};
+                    _BitScanForward(&index, mask);
+                    return i + index;
+                }
+            }
+#endif
+
+            for (; i < length && static_cast<unsigned char>(in[i]) < 0x80; ++i)
+            {
+                out[i] = static_cast<wchar_t>(in[i]);
+            }
+            return i;
+        }
+
+        // Routine Description:
+        // - Finds the next run of 16 ASCII characters in a UTF-8 string. Everything
+        //   up to there is converted by the platform in a single call. ASCII
+        //   characters are never part of a multi-byte sequence, so splitting the
+        //   string in front of one doesn't change the result of the conversion.
+        // Arguments:
+        // - in - the UTF-8 string
+        // - length - the length of in
+        // Return Value:
+        // - the offset of the run, or length if there is none
+        inline size_t u8u16FindAsciiRun(const char* const in, const size_t length) noexcept
+        {
+            size_t i{};
+
+#if defined(_M_X64) || defined(_M_IX86)
+            for (; length - i >= 16; i += 16)
+            {
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                if (_mm_movemask_epi8(chars) == 0)
+                {
+                    return i;
+                }
+            }
+            return length;
+#else
+            size_t run{};
+            for (; i < length; ++i)
+            {
+                run = static_cast<unsigned char>(in[i]) < 0x80 ? run + 1 : 0;
+                if (run == 16)
+                {
+                    return i - 15;
+                }
+            }
+            return length;
+#endif
+        }
+
+        // Routine Description:
+        // - Narrows the leading ASCII characters of a UTF-16 string to UTF-8.
+        // - On x86/x64 this converts 16 characters at a time with SSE2. The vector
+        //   loop might write up to 15 code units past the ones it returns, so out
+        //   needs to have room for at least length code units.
+        // Arguments:
+        // - in - the UTF-16 string
+        // - length - the length of in
+        // - out - receives the UTF-8 code units
+        // Return Value:
+        // - the number of leading ASCII characters that were converted
+        inline size_t u16u8NarrowAscii(const wchar_t* const in, const size_t length, char* const out) noexcept
+        {
+            size_t i{};
+
+#if defined(_M_X64) || defined(_M_IX86)
+            const auto zero = _mm_setzero_si128();
+            const auto nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xff80));
+            for (; length - i >= 16; i += 16)
+            {
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+
+                // ASCII code units have none of the bits above 0x7f set. Their
+                // lanes compare equal to zero, which packs to a byte of 0xff.
+                const auto asciiLo = _mm_cmpeq_epi16(_mm_and_si128(lo, nonAsciiBits), zero);
+                const auto asciiHi = _mm_cmpeq_epi16(_mm_and_si128(hi, nonAsciiBits), zero);
+                const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_packs_epi16(asciiLo, asciiHi)));
+                if (mask != 0xffff)
+                {
+                    unsigned long index{};
+                    _BitScanForward(&index, ~mask & 0xffff);
+                    return i + index;
+                }
+            }
+#endif
+
+            for (; i < length && in[i] < 0x80; ++i)
+            {
+                out[i] = static_cast<char>(in[i]);
+            }
+            return i;
+        }
+
+        // Routine Description:
+        // - Finds the next run of 16 ASCII characters in a UTF-16 string. Everything
+        //   up to there is converted by the platform in a single call. ASCII
+        //   characters are never part of a surrogate pair, so splitting the
+        //   string in front of one doesn't change the result of the conversion.
+        // Arguments:
+        // - in - the UTF-16 string
+        // - length - the length of in
+        // Return Value:
+        // - the offset of the run, or length if there is none
+        inline size_t u16u8FindAsciiRun(const wchar_t* const in, const size_t length) noexcept
+        {
+            size_t i{};
+
+#if defined(_M_X64) || defined(_M_IX86)
+            const auto zero = _mm_setzero_si128();
+            const auto nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xff80));
+            for (; length - i >= 16; i += 16)
+            {
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+                const auto bits = _mm_and_si128(_mm_or_si128(lo, hi), nonAsciiBits);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(bits, zero)) == 0xffff)
+                {
+                    return i;
+                }
+            }
+            return length;
+#else
+            size_t run{};
+            for (; i < length; ++i)
+            {
+                run = in[i] < 0x80 ? run + 1 : 0;
+                if (run == 16)
+                {
+                    return i - 15;
+                }
+            }
+            return length;
+#endif
+        }
+#pragma warning(pop)
+    }
+
     template<class charT>
     class u8u16state final
     {
@@ -279,10 +459,42 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1 if UTF-8 consists of ASCII only.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthRequired));
             out.resize(in.length()); // avoid to call MultiByteToWideChar twice only to get the required size
-            const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthRequired, out.data(), lengthRequired);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+            // Since the ratio is never worse than 1 to 1, the remainder of out
+            // always has room for the conversion of the remainder of in.
+            const auto inData = in.data();
+            const auto outData = out.data();
+            const auto length = in.length();
+            size_t inPos{};
+            size_t outPos{};
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+            while (inPos < length)
+            {
+                const auto ascii = details::u8u16WidenAscii(inData + inPos, length - inPos, outData + outPos);
+                inPos += ascii;
+                outPos += ascii;
+                if (inPos == length)
+                {
+                    break;
+                }
+
+                const auto segment = details::u8u16FindAsciiRun(inData + inPos, length - inPos);
+                const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, inData + inPos, gsl::narrow_cast<int>(segment), outData + outPos, gsl::narrow_cast<int>(length - outPos));
+                if (lengthOut == 0)
+                {
+                    out.clear();
+                    return E_UNEXPECTED;
+                }
+
+                inPos += segment;
+                outPos += gsl::narrow_cast<size_t>(lengthOut);
+            }
+#pragma warning(pop)
+
+            out.resize(outPos);
+            return S_OK;
         }
         catch (std::length_error&)
         {
@@ -319,10 +531,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     }
 
     // Routine Description:
-    // - Takes a UTF-16 string and performs the conversion to UTF-8. NOTE: The function relies on getting complete UTF-16 characters at the string boundaries.
+    // - Takes a UTF-16 string and appends its conversion to UTF-8 to the given string, like u16u8.
+    //   This lets callers encode right into their output buffer, without an intermediate string.
+    //   NOTE: The function relies on getting complete UTF-16 characters at the string boundaries.
     // Arguments:
     // - in - UTF-16 string to be converted
-    // - out - reference to the resulting UTF-8 string
+    // - out - reference to the string the UTF-8 code units are appended to. It's left as it was if the conversion fails.
     // Return Value:
     // - S_OK          - the conversion succeeded
     // - E_OUTOFMEMORY - the function failed to allocate memory for the resulting string
@@ -330,12 +544,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     // - E_UNEXPECTED  - an unexpected error occurred
     template<class inT, class outT>
     [[nodiscard]] typename std::enable_if<std::is_same<typename inT::value_type, wchar_t>::value && std::is_same<typename outT::value_type, char>::value, HRESULT>::type
-    u16u8(const inT in, outT& out) noexcept
+    u16u8_append(const inT in, outT& out) noexcept
     {
+        const auto offset = out.size();
         try
         {
-            out.clear();
-
             if (in.empty())
             {
                 return S_OK;
@@ -347,11 +560,44 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // Code Points >U+FFFF: 2 UTF-16 code units --> 4 UTF-8 code units.
             // Thus, the worst ratio of UTF-16 code units to UTF-8 code units is 1 to 3.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
-            out.resize(gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
-            const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthIn, out.data(), lengthRequired, nullptr, nullptr);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
+            out.resize(offset + gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
+
+            // Since the ratio is never worse than 1 to 3, the remainder of out
+            // always has room for the conversion of the remainder of in.
+            const auto inData = in.data();
+            const auto outData = out.data() + offset;
+            const auto length = in.length();
+            const auto capacity = gsl::narrow_cast<size_t>(lengthRequired);
+            size_t inPos{};
+            size_t outPos{};
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+            while (inPos < length)
+            {
+                const auto ascii = details::u16u8NarrowAscii(inData + inPos, length - inPos, outData + outPos);
+                inPos += ascii;
+                outPos += ascii;
+                if (inPos == length)
+                {
+                    break;
+                }
+
+                const auto segment = details::u16u8FindAsciiRun(inData + inPos, length - inPos);
+                const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, inData + inPos, gsl::narrow_cast<int>(segment), outData + outPos, gsl::narrow_cast<int>(capacity - outPos), nullptr, nullptr);
+                if (lengthOut == 0)
+                {
+                    out.resize(offset);
+                    return E_UNEXPECTED;
+                }
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+                inPos += segment;
+                outPos += gsl::narrow_cast<size_t>(lengthOut);
+            }
+#pragma warning(pop)
+
+            out.resize(offset + outPos);
+            return S_OK;
         }
         catch (std::length_error&)
         {
@@ -367,6 +613,24 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         }
     }
 
+    // Routine Description:
+    // - Takes a UTF-16 string and performs the conversion to UTF-8. NOTE: The function relies on getting complete UTF-16 characters at the string boundaries.
+    // Arguments:
+    // - in - UTF-16 string to be converted
+    // - out - reference to the resulting UTF-8 string
+    // Return Value:
+    // - S_OK          - the conversion succeeded
+    // - E_OUTOFMEMORY - the function failed to allocate memory for the resulting string
+    // - E_ABORT       - the resulting string length would exceed the upper boundary of an int and thus, the conversion was aborted before the conversion has been completed
+    // - E_UNEXPECTED  - an unexpected error occurred
+    template<class inT, class outT>
+    [[nodiscard]] typename std::enable_if<std::is_same<typename inT::value_type, wchar_t>::value && std::is_same<typename outT::value_type, char>::value, HRESULT>::type
+    u16u8(const inT in, outT& out) noexcept
+    {
+        out.clear();
+        return u16u8_append(in, out);
+    }
+
     // Routine Description:
     // - Takes a UTF-16 string, complements and/or caches partials, and performs the conversion to UTF-8.
     // Arguments:
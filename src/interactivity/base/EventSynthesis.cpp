@@ -16,6 +16,84 @@
 static constexpr WORD altScanCode = 0x38;
 static constexpr WORD leftShiftScanCode = 0x2A;
 
+// Routine Description:
+// - appends the KeyEvents for typing wch with the given VkKeyScanW result
+//   and the scan code of its virtual key. See SynthesizeKeyboardEvents.
+template<typename T>
+static void AppendKeyboardEvents(const wchar_t wch,
+                                 const short keyState,
+                                 const WORD virtualScanCode,
+                                 std::deque<std::unique_ptr<T>>& keyEvents)
+{
+    const byte modifierState = HIBYTE(keyState);
+
+    bool altGrSet = false;
+    bool shiftSet = false;
+
+    // add modifier key event if necessary
+    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
+    {
+        altGrSet = true;
+        keyEvents.push_back(std::make_unique<KeyEvent>(true,
+                                                       1ui16,
+                                                       static_cast<WORD>(VK_MENU),
+                                                       altScanCode,
+                                                       UNICODE_NULL,
+                                                       (ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED)));
+    }
+    else if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
+    {
+        shiftSet = true;
+        keyEvents.push_back(std::make_unique<KeyEvent>(true,
+                                                       1ui16,
+                                                       static_cast<WORD>(VK_SHIFT),
+                                                       leftShiftScanCode,
+                                                       UNICODE_NULL,
+                                                       SHIFT_PRESSED));
+    }
+
+    KeyEvent keyEvent{ true, 1, LOBYTE(keyState), virtualScanCode, wch, 0 };
+
+    // add modifier flags if necessary
+    if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::Shift);
+    }
+    if (WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::LeftCtrl);
+    }
+    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::RightAlt);
+    }
+
+    // add key event down and up
+    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
+    keyEvent.SetKeyDown(false);
+    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
+
+    // add modifier key up event
+    if (altGrSet)
+    {
+        keyEvents.push_back(std::make_unique<KeyEvent>(false,
+                                                       1ui16,
+                                                       static_cast<WORD>(VK_MENU),
+                                                       altScanCode,
+                                                       UNICODE_NULL,
+                                                       ENHANCED_KEY));
+    }
+    else if (shiftSet)
+    {
+        keyEvents.push_back(std::make_unique<KeyEvent>(false,
+                                                       1ui16,
+                                                       static_cast<WORD>(VK_SHIFT),
+                                                       leftShiftScanCode,
+                                                       UNICODE_NULL,
+                                                       0));
+    }
+}
+
 // Routine Description:
 // - naively determines the width of a UCS2 encoded wchar (with caveats noted above)
 #pragma warning(suppress : 4505) // this function will be deleted if numpad events are disabled
@@ -75,87 +153,82 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToK
 }
 
 // Routine Description:
-// - converts a wchar_t into a series of KeyEvents as if it was typed
-// using the keyboard
+// - converts a string into KeyEvents, like calling CharToKeyEvents for each
+//   of its characters, and appends them to keyEvents.
+// - Pasted and typed text is mostly ASCII. The VkKeyScanW and MapVirtualKeyW
+//   results for ASCII are looked up once per keyboard layout and remembered,
+//   instead of twice per character.
 // Arguments:
-// - wch - the wchar_t to convert
-// Return Value:
-// - deque of KeyEvents that represent the wchar_t being typed
+// - wstr - the string to convert
+// - codepage - the codepage for characters that have to be typed on the numpad
+// - keyEvents - receives the KeyEvents
 // Note:
 // - will throw exception on error
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+void Microsoft::Console::Interactivity::CharsToKeyEvents(const std::wstring_view wstr,
+                                                         const unsigned int codepage,
+                                                         std::deque<std::unique_ptr<IInputEvent>>& keyEvents)
 {
-    const byte modifierState = HIBYTE(keyState);
-
-    bool altGrSet = false;
-    bool shiftSet = false;
-    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
+#ifndef BUILD_ONECORE_INTERACTIVITY
+    // VkKeyScanW uses the keyboard layout of the calling thread,
+    // so each thread has to remember its own results.
+    struct AsciiKeys
+    {
+        HKL layout = nullptr;
+        std::array<short, 0x80> keyStates{};
+        std::array<WORD, 0x80> scanCodes{};
+    };
+    static thread_local AsciiKeys asciiKeys;
 
-    // add modifier key event if necessary
-    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
+    const auto layout = GetKeyboardLayout(0);
+    if (asciiKeys.layout != layout)
     {
-        altGrSet = true;
-        keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_MENU),
-                                                       altScanCode,
-                                                       UNICODE_NULL,
-                                                       (ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED)));
+        for (wchar_t wch = 0; wch < 0x80; ++wch)
+        {
+            const auto keyState = VkKeyScanW(wch);
+            til::at(asciiKeys.keyStates, wch) = keyState;
+            til::at(asciiKeys.scanCodes, wch) = keyState == -1 ? 0 : gsl::narrow<WORD>(MapVirtualKeyW(LOBYTE(keyState), MAPVK_VK_TO_VSC));
+        }
+        asciiKeys.layout = layout;
     }
-    else if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
+#endif
+
+    for (const auto wch : wstr)
     {
-        shiftSet = true;
-        keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_SHIFT),
-                                                       leftShiftScanCode,
-                                                       UNICODE_NULL,
-                                                       SHIFT_PRESSED));
+#ifndef BUILD_ONECORE_INTERACTIVITY
+        if (wch < 0x80)
+        {
+            const auto keyState = til::at(asciiKeys.keyStates, wch);
+            if (keyState != -1)
+            {
+                AppendKeyboardEvents(wch, keyState, til::at(asciiKeys.scanCodes, wch), keyEvents);
+                continue;
+            }
+        }
+#endif
+
+        auto convertedEvents = CharToKeyEvents(wch, codepage);
+        std::move(convertedEvents.begin(),
+                  convertedEvents.end(),
+                  std::back_inserter(keyEvents));
     }
+}
 
+// Routine Description:
+// - converts a wchar_t into a series of KeyEvents as if it was typed
+// using the keyboard
+// Arguments:
+// - wch - the wchar_t to convert
+// Return Value:
+// - deque of KeyEvents that represent the wchar_t being typed
+// Note:
+// - will throw exception on error
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+{
     const auto vk = LOBYTE(keyState);
     const WORD virtualScanCode = gsl::narrow<WORD>(MapVirtualKeyW(vk, MAPVK_VK_TO_VSC));
-    KeyEvent keyEvent{ true, 1, LOBYTE(keyState), virtualScanCode, wch, 0 };
-
-    // add modifier flags if necessary
-    if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::Shift);
-    }
-    if (WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::LeftCtrl);
-    }
-    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::RightAlt);
-    }
-
-    // add key event down and up
-    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
-    keyEvent.SetKeyDown(false);
-    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
-
-    // add modifier key up event
-    if (altGrSet)
-    {
-        keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_MENU),
-                                                       altScanCode,
-                                                       UNICODE_NULL,
-                                                       ENHANCED_KEY));
-    }
-    else if (shiftSet)
-    {
-        keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_SHIFT),
-                                                       leftShiftScanCode,
-                                                       UNICODE_NULL,
-                                                       0));
-    }
 
+    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
+    AppendKeyboardEvents(wch, keyState, virtualScanCode, keyEvents);
     return keyEvents;
 }
 
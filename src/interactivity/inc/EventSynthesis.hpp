@@ -16,12 +16,17 @@ Author:
 #pragma once
 #include <deque>
 #include <memory>
+#include <string_view>
 #include "../../types/inc/IInputEvent.hpp"
 
 namespace Microsoft::Console::Interactivity
 {
     std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch, const unsigned int codepage);
 
+    void CharsToKeyEvents(const std::wstring_view wstr,
+                          const unsigned int codepage,
+                          std::deque<std::unique_ptr<IInputEvent>>& keyEvents);
+
     std::deque<std::unique_ptr<KeyEvent>> SynthesizeKeyboardEvents(const wchar_t wch,
                                                                    const short keyState);
 
@@ -25,6 +25,8 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     _sharedViewBase((ULONG_PTR)SharedViewBase),
     _displayHeight(DisplayHeight),
     _displayWidth(DisplayWidth),
+    _invalidRows(gsl::narrow_cast<size_t>(std::max(DisplayHeight, 0L)), true),
+    _forceUpdate(true),
     _currentLegacyColorAttribute(DEFAULT_COLOR_ATTRIBUTE)
 {
     _runLength = sizeof(CD_IO_CHARACTER) * DisplayWidth;
@@ -33,33 +35,48 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     _fontSize.Y = FontHeight > SHORT_MAX ? SHORT_MAX : (SHORT)FontHeight;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
 {
+    _InvalidateRows(psrRegion->Top, psrRegion->Bottom + 1);
     return S_OK;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const /*psrRegion*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
 {
+    _InvalidateRows(psrRegion->Top, psrRegion->Bottom + 1);
     return S_OK;
 }
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
 {
-    return S_OK;
+    return InvalidateAll();
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
+    for (const auto& rect : rectangles)
+    {
+        _InvalidateRows(rect.Top, rect.Bottom + 1);
+    }
     return S_OK;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 {
+    // The runs can't be moved around, so every row needs to be painted again.
+    if (pcoordDelta->X != 0 || pcoordDelta->Y != 0)
+    {
+        _InvalidateRows(0, _displayHeight);
+    }
     return S_OK;
 }
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateAll() noexcept
 {
+    // This is how a complete redraw is forced, for instance when we get the
+    // display back from another console. Send it even if nothing changed.
+    _InvalidateRows(0, _displayHeight);
+    _forceUpdate = true;
     return S_OK;
 }
 
@@ -75,29 +92,72 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     return S_FALSE;
 }
 
+// Routine Description:
+// - Starts a frame, unless no row was invalidated since the last one.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or S_FALSE if there's nothing to paint.
 [[nodiscard]] HRESULT BgfxEngine::StartPaint() noexcept
 {
+    if (std::none_of(_invalidRows.begin(), _invalidRows.end(), [](const bool invalid) noexcept { return invalid; }))
+    {
+        return S_FALSE;
+    }
     return S_OK;
 }
 
+// Routine Description:
+// - Finishes the frame. Each row of the shared view has the run ConIoSrv
+//   shows, followed by the run we just painted. Rows that were repainted
+//   exactly as they were are left alone, and if that's all the frame did,
+//   ConIoSrv isn't asked to update the display at all. That is, unless the
+//   whole display was invalidated.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or the error ConIoSrv reported.
 [[nodiscard]] HRESULT BgfxEngine::EndPaint() noexcept
 {
-    NTSTATUS Status;
+    std::vector<size_t> changedRows;
+    try
+    {
+        for (size_t row = 0; row < _invalidRows.size(); row++)
+        {
+            if (_invalidRows[row] && memcmp(_GetOldRun(row), _GetNewRun(row), _runLength) != 0)
+            {
+                changedRows.emplace_back(row);
+            }
+        }
+    }
+    CATCH_RETURN();
 
-    PVOID OldRunBase;
-    PVOID NewRunBase;
+    std::fill(_invalidRows.begin(), _invalidRows.end(), false);
+
+    const auto forceUpdate = std::exchange(_forceUpdate, false);
+    if (changedRows.empty() && !forceUpdate)
+    {
+        return S_OK;
+    }
 
-    Status = ServiceLocator::LocateInputServices<ConIoSrvComm>()->RequestUpdateDisplay(0);
+    const NTSTATUS Status = ServiceLocator::LocateInputServices<ConIoSrvComm>()->RequestUpdateDisplay(0);
 
     if (NT_SUCCESS(Status))
     {
-        for (SHORT i = 0; i < _displayHeight; i++)
+        for (const auto row : changedRows)
         {
-            OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
-            NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
-            memcpy_s(OldRunBase, _runLength, NewRunBase, _runLength);
+            memcpy_s(_GetOldRun(row), _runLength, _GetNewRun(row), _runLength);
         }
     }
+    else
+    {
+        // ConIoSrv might not show the new runs, so try them again next frame.
+        for (const auto row : changedRows)
+        {
+            _invalidRows[row] = true;
+        }
+        _forceUpdate = true;
+    }
 
     return HRESULT_FROM_NT(Status);
 }
@@ -121,20 +181,15 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 
 [[nodiscard]] HRESULT BgfxEngine::PaintBackground() noexcept
 {
-    PVOID OldRunBase;
-    PVOID NewRunBase;
-
-    PCD_IO_CHARACTER OldRun;
-    PCD_IO_CHARACTER NewRun;
-
-    for (SHORT i = 0; i < _displayHeight; i++)
+    // Only the invalid rows get painted again. The others keep their runs.
+    for (size_t i = 0; i < _invalidRows.size(); i++)
     {
-        OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
-        NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
-
-        OldRun = (PCD_IO_CHARACTER)OldRunBase;
-        NewRun = (PCD_IO_CHARACTER)NewRunBase;
+        if (!_invalidRows[i])
+        {
+            continue;
+        }
 
+        const PCD_IO_CHARACTER NewRun = _GetNewRun(i);
         for (SHORT j = 0; j < _displayWidth; j++)
         {
             NewRun[j].Character = L' ';
@@ -152,10 +207,9 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 {
     try
     {
-        PVOID NewRunBase = (PVOID)(_sharedViewBase + (coord.Y * 2 * _runLength) + _runLength);
-        PCD_IO_CHARACTER NewRun = (PCD_IO_CHARACTER)NewRunBase;
+        PCD_IO_CHARACTER NewRun = _GetNewRun(gsl::narrow_cast<size_t>(coord.Y));
 
-        for (size_t i = 0; i < clusters.size() && i < (size_t)_displayWidth; i++)
+        for (size_t i = 0; i < clusters.size() && coord.X + i < (size_t)_displayWidth; i++)
         {
             NewRun[coord.X + i].Character = til::at(clusters, i).GetTextAsSingle();
             NewRun[coord.X + i].Attribute = _currentLegacyColorAttribute;
@@ -230,21 +284,43 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     return S_OK;
 }
 
+// Routine Description:
+// - Gets the rows that were invalidated since the last frame, each run of
+//   them as one rectangle spanning the width of the display.
+// Arguments:
+// - area - receives the rectangles
+// Return Value:
+// - S_OK or a memory error.
 [[nodiscard]] HRESULT BgfxEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
 {
-    SMALL_RECT r;
-    r.Bottom = _displayHeight > 0 ? (SHORT)(_displayHeight - 1) : 0;
-    r.Top = 0;
-    r.Left = 0;
-    r.Right = _displayWidth > 0 ? (SHORT)(_displayWidth - 1) : 0;
+    _dirtyArea.clear();
 
-    _dirtyArea = r;
+    const auto width = std::max<ptrdiff_t>(_displayWidth, 0);
+    const auto height = _invalidRows.size();
+    for (size_t top = 0; top < height;)
+    {
+        if (!_invalidRows[top])
+        {
+            top++;
+            continue;
+        }
 
-    area = { &_dirtyArea,
-             1 };
+        auto bottom = top + 1;
+        while (bottom < height && _invalidRows[bottom])
+        {
+            bottom++;
+        }
+
+        _dirtyArea.emplace_back(0, gsl::narrow_cast<ptrdiff_t>(top), width, gsl::narrow_cast<ptrdiff_t>(bottom));
+        top = bottom;
+    }
+
+    area = { _dirtyArea.data(), _dirtyArea.size() };
 
     return S_OK;
 }
+CATCH_RETURN()
 
 [[nodiscard]] HRESULT BgfxEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
 {
@@ -269,3 +345,41 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 {
     return S_OK;
 }
+
+// Routine Description:
+// - Marks the rows in [top, bottom) as invalid, clamped to the display.
+// Arguments:
+// - top - the first row to invalidate
+// - bottom - one past the last row to invalidate
+// Return Value:
+// - <none>
+void BgfxEngine::_InvalidateRows(const ptrdiff_t top, const ptrdiff_t bottom) noexcept
+{
+    const auto height = gsl::narrow_cast<ptrdiff_t>(_invalidRows.size());
+    for (auto row = std::max<ptrdiff_t>(top, 0); row < std::min(bottom, height); row++)
+    {
+        _invalidRows[gsl::narrow_cast<size_t>(row)] = true;
+    }
+}
+
+// Routine Description:
+// - Gets the run of the given row that ConIoSrv currently shows.
+// Arguments:
+// - row - the row of the display
+// Return Value:
+// - The first character of the run.
+PCD_IO_CHARACTER BgfxEngine::_GetOldRun(const size_t row) const noexcept
+{
+    return (PCD_IO_CHARACTER)(_sharedViewBase + (row * 2 * _runLength));
+}
+
+// Routine Description:
+// - Gets the run of the given row that is painted into.
+// Arguments:
+// - row - the row of the display
+// Return Value:
+// - The first character of the run.
+PCD_IO_CHARACTER BgfxEngine::_GetNewRun(const size_t row) const noexcept
+{
+    return (PCD_IO_CHARACTER)(_sharedViewBase + (row * 2 * _runLength) + _runLength);
+}
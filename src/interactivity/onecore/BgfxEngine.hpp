@@ -80,10 +80,21 @@ namespace Microsoft::Console::Render
 
         LONG _displayHeight;
         LONG _displayWidth;
-        til::rectangle _dirtyArea;
+
+        // The rows invalidated since the last frame. Only those are painted,
+        // and ConIoSrv is only asked to update the display if one of them
+        // ended up different from what it shows, or if everything was
+        // invalidated, like when the console gets the display back.
+        std::vector<bool> _invalidRows;
+        bool _forceUpdate;
+        std::vector<til::rectangle> _dirtyArea;
 
         COORD _fontSize;
 
         WORD _currentLegacyColorAttribute;
+
+        void _InvalidateRows(const ptrdiff_t top, const ptrdiff_t bottom) noexcept;
+        PCD_IO_CHARACTER _GetOldRun(const size_t row) const noexcept;
+        PCD_IO_CHARACTER _GetNewRun(const size_t row) const noexcept;
     };
 }
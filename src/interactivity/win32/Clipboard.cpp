@@ -136,7 +136,8 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
 {
     THROW_HR_IF_NULL(E_INVALIDARG, pData);
 
-    std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    std::wstring text;
+    text.reserve(cchData);
 
     for (size_t i = 0; i < cchData; ++i)
     {
@@ -174,14 +175,12 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
             currentChar = UNICODE_CARRIAGERETURN;
         }
 
-        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
-        while (!convertedEvents.empty())
-        {
-            keyEvents.push_back(std::move(convertedEvents.front()));
-            convertedEvents.pop_front();
-        }
+        text.push_back(currentChar);
     }
+
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+    std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    CharsToKeyEvents(text, codepage, keyEvents);
     return keyEvents;
 }
 
@@ -221,31 +220,42 @@ void Clipboard::StoreSelectionToClipboard(bool const copyFormatting)
         includeCRLF = trimTrailingWhitespace = true;
     }
 
-    const auto text = buffer.GetText(includeCRLF,
+    // The colors are only needed for the HTML & RTF formats. Without them,
+    // the text is streamed straight into a single string instead.
+    if (!copyFormatting)
+    {
+        const auto text = buffer.GetPlainText(includeCRLF,
+                                              trimTrailingWhitespace,
+                                              selectionRects);
+
+        CopyTextToSystemClipboard(text, nullptr);
+        return;
+    }
+
+    const auto rows = buffer.GetText(includeCRLF,
                                      trimTrailingWhitespace,
                                      selectionRects,
                                      GetAttributeColors);
 
-    CopyTextToSystemClipboard(text, copyFormatting);
+    // Concatenate strings into one giant string to put onto the clipboard.
+    std::wstring text;
+    for (const auto& str : rows.text)
+    {
+        text += str;
+    }
+
+    CopyTextToSystemClipboard(text, &rows);
 }
 
 // Routine Description:
 // - Copies the text given onto the global system clipboard.
 // Arguments:
-// - rows - Rows of text data to copy
-// - fAlsoCopyFormatting - true if the color and formatting should also be copied, false otherwise
-void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyFormatting)
+// - text - The text to copy
+// - formattedRows - Rows of text and color data to also copy as HTML & RTF, or nullptr to only copy the text
+void Clipboard::CopyTextToSystemClipboard(const std::wstring_view text, const TextBuffer::TextAndColor* const formattedRows)
 {
-    std::wstring finalString;
-
-    // Concatenate strings into one giant string to put onto the clipboard.
-    for (const auto& str : rows.text)
-    {
-        finalString += str;
-    }
-
     // allocate the final clipboard data
-    const size_t cchNeeded = finalString.size() + 1;
+    const size_t cchNeeded = text.size() + 1;
     const size_t cbNeeded = sizeof(wchar_t) * cchNeeded;
     wil::unique_hglobal globalHandle(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeeded));
     THROW_LAST_ERROR_IF_NULL(globalHandle.get());
@@ -255,7 +265,7 @@ void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows,
 
     // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
     // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
-    const HRESULT hr = StringCchCopyW(pwszClipboard, cchNeeded, finalString.data());
+    const HRESULT hr = StringCchCopyNW(pwszClipboard, cchNeeded, text.data(), text.size());
     GlobalUnlock(globalHandle.get());
     THROW_IF_FAILED(hr);
 
@@ -270,8 +280,9 @@ void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows,
         THROW_LAST_ERROR_IF(!EmptyClipboard());
         THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_UNICODETEXT, globalHandle.get()));
 
-        if (fAlsoCopyFormatting)
+        if (formattedRows)
         {
+            const auto& rows = *formattedRows;
             const auto& fontData = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetCurrentFont();
             int const iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
             const COLORREF bgColor = ServiceLocator::LocateGlobals().getConsoleInformation().GetDefaultBackground();
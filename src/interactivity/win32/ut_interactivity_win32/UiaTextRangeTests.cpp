@@ -171,9 +171,9 @@ class UiaTextRangeTests
         {
             ROW& row = _pTextBuffer->GetRowByOffset(i);
             auto& charRow = row.GetCharRow();
-            for (auto& cell : charRow)
+            for (size_t j = 0; j < charRow.size(); ++j)
             {
-                cell.Char() = L' ';
+                charRow.GlyphAt(j) = L" ";
             }
         }
 
@@ -183,6 +183,8 @@ void Window::_UpdateSystemMetrics() const
     const auto sysConfig = ServiceLocator::LocateSystemConfigurationProvider();
 
     g.cursorPixelWidth = sysConfig->GetCursorWidth();
+
+    g.windowMetricsVersion++;
 }
 
 // Routine Description:
@@ -1183,6 +1185,9 @@ void Window::SetIsFullscreen(const bool fFullscreenEnabled)
     const bool fChangingFullscreen = (fFullscreenEnabled != _fIsInFullscreen);
     _fIsInFullscreen = fFullscreenEnabled;
 
+    // The maximum window size is measured against the whole monitor in full screen.
+    ServiceLocator::LocateGlobals().windowMetricsVersion++;
+
     HWND const hWnd = GetWindowHandle();
 
     // First, modify regular window styles as appropriate
@@ -16,6 +16,8 @@ Author(s):
 
 #include "../inc/IConsoleWindow.hpp"
 
+#include <chrono>
+
 namespace Microsoft::Console::Interactivity::Win32
 {
     class WindowUiaProvider;
@@ -126,6 +128,11 @@ namespace Microsoft::Console::Interactivity::Win32
         void _HandleDrop(const WPARAM wParam) const;
         [[nodiscard]] HRESULT _HandlePaint() const;
         void _HandleWindowPosChanged(const LPARAM lParam);
+        void _HandleUpdateScrollBars(SCREEN_INFORMATION& screenInfo);
+
+        // See CM_UPDATE_SCROLL_BARS.
+        std::chrono::steady_clock::time_point _lastScrollBarUpdate{};
+        bool _scrollBarUpdatePending{ false };
 
         // Accessibility/UI Automation
         [[nodiscard]] LRESULT _HandleGetObject(const HWND hwnd,
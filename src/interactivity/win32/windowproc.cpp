@@ -37,6 +37,13 @@
 using namespace Microsoft::Console::Interactivity::Win32;
 using namespace Microsoft::Console::Types;
 
+// Screen buffers ask for a scroll bar update on (nearly) every write that
+// moves the viewport. We apply those at most once per interval, which matches
+// the render thread's frame limit, so that floods of output don't turn
+// SetScrollInfo into a bottleneck.
+static constexpr auto ScrollBarUpdateInterval = std::chrono::milliseconds(8);
+static constexpr UINT_PTR ScrollBarUpdateTimerId = 1;
+
 // The static and specific window procedures for this class are contained here
 #pragma region Window Procedure
 
@@ -678,7 +685,26 @@ using namespace Microsoft::Console::Types;
 
     case CM_UPDATE_SCROLL_BARS:
     {
-        ScreenInfo.InternalUpdateScrollBars();
+        _HandleUpdateScrollBars(ScreenInfo);
+        break;
+    }
+
+    case WM_TIMER:
+    {
+        if (wParam != ScrollBarUpdateTimerId)
+        {
+            goto CallDefWin;
+        }
+
+        KillTimer(hWnd, ScrollBarUpdateTimerId);
+        _scrollBarUpdatePending = false;
+        _lastScrollBarUpdate = std::chrono::steady_clock::now();
+
+        // A resize may have updated the scroll bars directly in the meantime.
+        if (WI_IsFlagSet(gci.Flags, CONSOLE_UPDATING_SCROLL_BARS))
+        {
+            ScreenInfo.InternalUpdateScrollBars();
+        }
         break;
     }
 
@@ -779,6 +805,9 @@ void Window::_HandleWindowPosChanged(const LPARAM lParam)
 
     LPWINDOWPOS const lpWindowPos = (LPWINDOWPOS)lParam;
 
+    // The window may have moved onto another monitor, which changes the maximum window size.
+    ServiceLocator::LocateGlobals().windowMetricsVersion++;
+
     // If the frame changed, update the system metrics.
     if (WI_IsFlagSet(lpWindowPos->flags, SWP_FRAMECHANGED))
     {
@@ -883,6 +912,38 @@ void Window::_HandleDrop(const WPARAM wParam) const
     }
 }
 
+// Routine Description:
+// - This routine is called when ConsoleWindowProc receives a CM_UPDATE_SCROLL_BARS message.
+// - If the scroll bars were updated less than ScrollBarUpdateInterval ago, the update is deferred
+//   to a timer instead. CONSOLE_UPDATING_SCROLL_BARS stays set until then, so that screen buffers
+//   don't post any more messages in the meantime.
+// Arguments:
+// - screenInfo - the active screen buffer
+// Return Value:
+// - <none>
+void Window::_HandleUpdateScrollBars(SCREEN_INFORMATION& screenInfo)
+{
+    if (_scrollBarUpdatePending)
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = now - _lastScrollBarUpdate;
+    if (elapsed < ScrollBarUpdateInterval)
+    {
+        const auto delay = std::chrono::ceil<std::chrono::milliseconds>(ScrollBarUpdateInterval - elapsed);
+        if (SetTimer(_hWnd, ScrollBarUpdateTimerId, gsl::narrow_cast<UINT>(delay.count()), nullptr))
+        {
+            _scrollBarUpdatePending = true;
+            return;
+        }
+    }
+
+    _lastScrollBarUpdate = now;
+    screenInfo.InternalUpdateScrollBars();
+}
+
 [[nodiscard]] LRESULT Window::_HandleGetObject(const HWND hwnd, const WPARAM wParam, const LPARAM lParam)
 {
     LRESULT retVal = 0;
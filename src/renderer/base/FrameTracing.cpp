@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "FrameTracing.hpp"
+
+#pragma hdrstop
+
+TRACELOGGING_DEFINE_PROVIDER(g_hConsoleRenderTraceProvider,
+                             "Microsoft.Windows.Console.Render",
+                             // tl:{41a35baf-cd55-5e23-782b-7323338b5283}
+                             (0x41a35baf, 0xcd55, 0x5e23, 0x78, 0x2b, 0x73, 0x23, 0x33, 0x8b, 0x52, 0x83),
+                             TraceLoggingOptionMicrosoftTelemetry());
+
+using namespace Microsoft::Console::Render;
+
+// There can be a renderer per tab (or pane) and they share the provider.
+static std::atomic<size_t> s_registrations{ 0 };
+
+static uint64_t s_Microseconds(const FrameTiming::duration duration) noexcept
+{
+    return gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+FrameTracing::FrameTracing() noexcept
+{
+#ifndef UNIT_TESTING
+    if (s_registrations.fetch_add(1) == 0)
+    {
+        TraceLoggingRegister(g_hConsoleRenderTraceProvider);
+
+        // Debug builds can count the allocations for the frame events themselves.
+        til::allocation_tracker::install_crt_hook();
+    }
+#endif UNIT_TESTING
+}
+
+FrameTracing::~FrameTracing()
+{
+#ifndef UNIT_TESTING
+    if (s_registrations.fetch_sub(1) == 1)
+    {
+        TraceLoggingUnregister(g_hConsoleRenderTraceProvider);
+    }
+#endif UNIT_TESTING
+}
+
+// Routine Description:
+// - Records the timing of a frame that was painted.
+// - The frame is traced on its own at the verbose level. Every HistorySize
+//   frames, a summary of them is traced at the informational level.
+// Arguments:
+// - engine - The engine that painted the frame, to tell engines apart.
+// - timing - How long the frame took.
+// Return Value:
+// - <none>
+void FrameTracing::TraceFrame(const IRenderEngine* const engine, const FrameTiming& timing) noexcept
+{
+    til::at(_history, _count % HistorySize) = timing;
+    ++_count;
+
+#ifndef UNIT_TESTING
+    if (TraceLoggingProviderEnabled(g_hConsoleRenderTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hConsoleRenderTraceProvider,
+                          "Frame",
+                          TraceLoggingPointer(engine, "engine"),
+                          TraceLoggingUInt64(s_Microseconds(timing.total), "totalUs"),
+                          TraceLoggingUInt64(s_Microseconds(timing.startPaint), "startPaintUs"),
+                          TraceLoggingUInt64(s_Microseconds(timing.bufferOutput), "bufferOutputUs"),
+                          TraceLoggingUInt64(s_Microseconds(timing.cursor), "cursorUs"),
+                          TraceLoggingUInt64(s_Microseconds(timing.replay), "replayUs"),
+                          TraceLoggingUInt64(s_Microseconds(timing.present), "presentUs"),
+                          TraceLoggingUInt64(timing.dirtyCells, "dirtyCells"),
+                          TraceLoggingUInt64(timing.allocations, "allocations"),
+                          TraceLoggingUInt64(timing.allocatedBytes, "allocatedBytes"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    if (_count % HistorySize == 0)
+    {
+        _TraceSummary();
+    }
+#else
+    UNREFERENCED_PARAMETER(engine);
+#endif UNIT_TESTING
+}
+
+// Routine Description:
+// - Traces the time it took from an input to the presentation of the first
+//   frame that showed its answer.
+// Arguments:
+// - engine - the engine that presented the frame
+// - latency - the time since the input
+// Return Value:
+// - <none>
+void FrameTracing::TraceInputLatency(const IRenderEngine* const engine, const FrameTiming::duration latency) noexcept
+{
+#ifndef UNIT_TESTING
+    if (TraceLoggingProviderEnabled(g_hConsoleRenderTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hConsoleRenderTraceProvider,
+                          "InputLatency",
+                          TraceLoggingPointer(engine, "engine"),
+                          TraceLoggingUInt64(s_Microseconds(latency), "latencyUs"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+#else
+    UNREFERENCED_PARAMETER(engine);
+    UNREFERENCED_PARAMETER(latency);
+#endif UNIT_TESTING
+}
+
+// Routine Description:
+// - Traces the average and worst frame times of the frames in the history.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void FrameTracing::_TraceSummary() const noexcept
+{
+#ifndef UNIT_TESTING
+    if (TraceLoggingProviderEnabled(g_hConsoleRenderTraceProvider, WINEVENT_LEVEL_INFO, TIL_KEYWORD_TRACE))
+    {
+        FrameTiming::duration sum{};
+        FrameTiming::duration max{};
+        size_t dirtyCells = 0;
+        size_t allocations = 0;
+        for (const auto& timing : _history)
+        {
+            sum += timing.total;
+            max = std::max(max, timing.total);
+            dirtyCells += timing.dirtyCells;
+            allocations += timing.allocations;
+        }
+
+        // The parsing and buffer writes happen on other threads, so only
+        // their totals so far can be told.
+        const auto parse = til::allocation_tracker::get(til::allocation_region::parse);
+        const auto bufferWrite = til::allocation_tracker::get(til::allocation_region::buffer_write);
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hConsoleRenderTraceProvider,
+                          "FrameSummary",
+                          TraceLoggingUInt64(HistorySize, "frames"),
+                          TraceLoggingUInt64(s_Microseconds(sum / HistorySize), "averageUs"),
+                          TraceLoggingUInt64(s_Microseconds(max), "maxUs"),
+                          TraceLoggingUInt64(dirtyCells / HistorySize, "averageDirtyCells"),
+                          TraceLoggingUInt64(allocations / HistorySize, "averageAllocations"),
+                          TraceLoggingUInt64(parse.allocations, "parseAllocations"),
+                          TraceLoggingUInt64(parse.bytes, "parseAllocatedBytes"),
+                          TraceLoggingUInt64(bufferWrite.allocations, "bufferWriteAllocations"),
+                          TraceLoggingUInt64(bufferWrite.bytes, "bufferWriteAllocatedBytes"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+#endif UNIT_TESTING
+}
@@ -0,0 +1,88 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- FrameTracing.hpp
+
+Abstract:
+- Records how long the phases of each frame took to paint and emits them as
+  ETW events, so that the cost of rendering can be looked at in the field.
+- The last few frames are kept around and summarized once they're all in,
+  for traces that don't want an event per frame.
+--*/
+
+#pragma once
+
+#include <chrono>
+#include <windows.h>
+#include <winmeta.h>
+#include <TraceLoggingProvider.h>
+#include <telemetry/ProjectTelemetry.h>
+
+TRACELOGGING_DECLARE_PROVIDER(g_hConsoleRenderTraceProvider);
+
+namespace Microsoft::Console::Render
+{
+    class IRenderEngine;
+
+    // The time spent in each phase of a frame. Phases that didn't happen
+    // (e.g. the replay for engines without snapshot painting) stay zero.
+    struct FrameTiming
+    {
+        using duration = std::chrono::steady_clock::duration;
+
+        duration startPaint{};
+        duration bufferOutput{};
+        duration cursor{};
+        duration replay{};
+        duration present{};
+        duration total{};
+        size_t dirtyCells = 0;
+
+        // What was allocated while painting and presenting the frame (see til::allocation_tracker).
+        size_t allocations = 0;
+        size_t allocatedBytes = 0;
+    };
+
+    class FrameTracing final
+    {
+    public:
+        FrameTracing() noexcept;
+        ~FrameTracing();
+
+        FrameTracing(const FrameTracing&) = delete;
+        FrameTracing& operator=(const FrameTracing&) = delete;
+
+        void TraceFrame(const IRenderEngine* const engine, const FrameTiming& timing) noexcept;
+        void TraceInputLatency(const IRenderEngine* const engine, const FrameTiming::duration latency) noexcept;
+
+        // Measures the time between its construction and the call to Stop,
+        // or rather adds it to the given duration.
+        class Stopwatch final
+        {
+        public:
+            explicit Stopwatch(FrameTiming::duration& target) noexcept :
+                _target{ target },
+                _start{ std::chrono::steady_clock::now() }
+            {
+            }
+
+            void Stop() noexcept
+            {
+                _target += std::chrono::steady_clock::now() - _start;
+            }
+
+        private:
+            FrameTiming::duration& _target;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+    private:
+        void _TraceSummary() const noexcept;
+
+        static constexpr size_t HistorySize = 64;
+        std::array<FrameTiming, HistorySize> _history{};
+        size_t _count = 0;
+    };
+}
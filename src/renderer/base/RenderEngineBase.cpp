@@ -36,6 +36,44 @@ HRESULT RenderEngineBase::UpdateTitle(const std::wstring_view newTitle) noexcept
     return hr;
 }
 
+// Method Description:
+// - Resolves the colors of the given attributes, like IRenderData::GetAttributeColors,
+//   but only does so once per frame for every attribute. The renderer sets
+//   the default brushes at the start of every frame, which forgets the
+//   colors of the last one, so that changes to the color table, the default
+//   colors or the blinking state are picked up by the next frame. They can't
+//   change in the middle of one, while the console lock is held.
+// Arguments:
+// - textAttributes - The attributes to resolve the colors of.
+// - pData - The render data to resolve them with.
+// - isSettingDefaultBrushes - True at the start of a frame.
+// Return Value:
+// - The foreground and background color.
+std::pair<COLORREF, COLORREF> RenderEngineBase::_GetAttributeColors(const TextAttribute& textAttributes,
+                                                                   const gsl::not_null<IRenderData*> pData,
+                                                                   const bool isSettingDefaultBrushes) noexcept
+{
+    if (isSettingDefaultBrushes)
+    {
+        // Entries from an older generation are stale. 0 is never used, so
+        // that the zeroed entries the table starts out with are too.
+        if (++_attributeColorGeneration == 0)
+        {
+            _attributeColors.fill({});
+            _attributeColorGeneration = 1;
+        }
+    }
+
+    const auto index = std::hash<TextAttribute>{}(textAttributes) % AttributeColorCacheSize;
+    auto& entry = til::at(_attributeColors, index);
+    if (entry.generation != _attributeColorGeneration || entry.attributes != textAttributes)
+    {
+        const auto [foreground, background] = pData->GetAttributeColors(textAttributes);
+        entry = { textAttributes, foreground, background, _attributeColorGeneration };
+    }
+    return { entry.foreground, entry.background };
+}
+
 HRESULT RenderEngineBase::PrepareRenderInfo(const RenderFrameInfo& /*info*/) noexcept
 {
     return S_FALSE;
@@ -63,9 +101,169 @@ HRESULT RenderEngineBase::PrepareLineTransform(const LineRendition /*lineRenditi
     return false;
 }
 
+// Method Description:
+// - Engines may read from the render data anywhere between StartPaint and
+//   EndPaint, so by default frames are painted under the console lock.
+//   Engines that only look at what they're handed (and at attribute colors)
+//   can opt into having their frames replayed from a snapshot instead.
+[[nodiscard]] bool RenderEngineBase::SupportsSnapshotPainting() noexcept
+{
+    return false;
+}
+
+// Method Description:
+// - Engines that can redraw the cursor on its own, without the rest of the
+//   frame, do so if nothing but the cursor was invalidated since the last frame.
+//   Everyone else gets a regular frame for every blink.
+// Arguments:
+// - options - The cursor to draw.
+// Return Value:
+// - S_FALSE, to have the renderer paint a regular frame instead.
+[[nodiscard]] HRESULT RenderEngineBase::PaintCursorFrame(const CursorOptions& /*options*/) noexcept
+{
+    return S_FALSE;
+}
+
+// Method Description:
+// - Draws the image that covers a row over its text. Engines that can't draw
+//   images just leave the text as it is.
+// Arguments:
+// - imageSlice - The part of the image that covers the row.
+// - targetRow - The row on the screen to draw it in.
+// - viewportLeft - The column of the buffer at the left edge of the screen.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT RenderEngineBase::PaintImageSlice(const ImageSlice& /*imageSlice*/,
+                                                        const size_t /*targetRow*/,
+                                                        const size_t /*viewportLeft*/) noexcept
+{
+    return S_OK;
+}
+
+// Method Description:
+// - Notifies us that the rows of the given region were moved up or down
+//   within it. Engines that can't move parts of what they've painted just
+//   repaint the whole region.
+// Arguments:
+// - psrRegion - The full-width region, relative to the viewport, whose rows moved.
+// - delta - How far the rows moved. Negative if they moved up.
+// Return Value:
+// - S_OK or a relevant error from invalidating the region.
+[[nodiscard]] HRESULT RenderEngineBase::InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const SHORT /*delta*/) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
+// Method Description:
+// - Paints the highlight of a search match. Engines that can't tell it apart
+//   from the selection paint it just like the selection.
+// Arguments:
+// - rect - The exclusive rectangle of the cells to highlight.
+// Return Value:
+// - S_OK or a relevant error from painting the selection.
+[[nodiscard]] HRESULT RenderEngineBase::PaintSearchHighlight(const SMALL_RECT rect) noexcept
+{
+    return PaintSelection(rect);
+}
+
 // Method Description:
 // - Blocks until the engine is able to render without blocking.
 void RenderEngineBase::WaitUntilCanRender() noexcept
 {
     // do nothing by default
 }
+
+// Method Description:
+// - The following are only meaningful for engines that draw into a swap chain
+//   handed out to their host. Everyone else can ignore them, so by default
+//   they do nothing.
+[[nodiscard]] HRESULT RenderEngineBase::Enable() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT RenderEngineBase::SetWindowSize(const SIZE /*pixels*/) noexcept
+{
+    return S_FALSE;
+}
+
+void RenderEngineBase::SetCallback(std::function<void()> /*pfn*/)
+{
+}
+
+void RenderEngineBase::SetWarningCallback(std::function<void(const HRESULT)> /*pfn*/)
+{
+}
+
+void RenderEngineBase::ToggleShaderEffects()
+{
+}
+
+bool RenderEngineBase::GetRetroTerminalEffect() const noexcept
+{
+    return false;
+}
+
+void RenderEngineBase::SetRetroTerminalEffect(bool /*enable*/) noexcept
+{
+}
+
+void RenderEngineBase::SetPixelShaderPath(std::wstring_view /*value*/) noexcept
+{
+}
+
+void RenderEngineBase::SetForceFullRepaintRendering(bool /*enable*/) noexcept
+{
+}
+
+void RenderEngineBase::SetSoftwareRendering(bool /*enable*/) noexcept
+{
+}
+
+void RenderEngineBase::SetPreferredAdapter(std::wstring_view /*description*/) noexcept
+{
+}
+
+HANDLE RenderEngineBase::GetSwapChainHandle()
+{
+    return nullptr;
+}
+
+[[nodiscard]] Microsoft::Console::Types::Viewport RenderEngineBase::GetViewportInCharacters(const Types::Viewport& /*viewInPixels*/) noexcept
+{
+    return Types::Viewport::Empty();
+}
+
+float RenderEngineBase::GetScaling() const noexcept
+{
+    return 1.0f;
+}
+
+void RenderEngineBase::SetSelectionBackground(const COLORREF /*color*/, const float /*alpha*/) noexcept
+{
+}
+
+void RenderEngineBase::SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE /*antialiasingMode*/) noexcept
+{
+}
+
+void RenderEngineBase::SetDefaultTextBackgroundOpacity(const float /*opacity*/) noexcept
+{
+}
+
+void RenderEngineBase::UpdateHyperlinkHoveredId(const uint16_t /*hoveredId*/) noexcept
+{
+}
+
+void RenderEngineBase::SetWindowOccluded(const bool /*occluded*/) noexcept
+{
+}
+
+void RenderEngineBase::TrimDeviceResources() noexcept
+{
+}
+
+RenderMemoryUsage RenderEngineBase::GetMemoryUsage() noexcept
+{
+    return {};
+}
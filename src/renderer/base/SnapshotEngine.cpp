@@ -0,0 +1,359 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "SnapshotEngine.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+// Routine Description:
+// - Discards the previous frame and starts recording a new one.
+// Arguments:
+// - target - The engine the frame will be replayed into. Its dirty area is
+//            what the renderer composes the frame against.
+// Return Value:
+// - <none>
+void SnapshotEngine::Begin(IRenderEngine* const target) noexcept
+{
+    _target = target;
+    _commands.clear();
+    _clusters.clear();
+    _text.clear();
+    _imageSlices.clear();
+}
+
+// Routine Description:
+// - Hands the recorded frame to the engine, in the order it was recorded.
+// - This doesn't need the console lock, as everything the engine is given was
+//   copied out of the console while recording. To resolve colors, the engine
+//   will still ask the render data for the color of each attribute though.
+// Arguments:
+// - target - The engine to paint the frame with. Its StartPaint must have been called.
+// - pData - The render data used to resolve attribute colors.
+// Return Value:
+// - S_OK, or the first failure that stopped the frame from being painted.
+[[nodiscard]] HRESULT SnapshotEngine::Replay(IRenderEngine& target, const gsl::not_null<IRenderData*> pData) noexcept
+try
+{
+    // The line transform is reset at the end of the buffer pass, but a failing
+    // call can leave us in the middle of it. Make sure it doesn't stick around.
+    auto resetLineTransform = wil::scope_exit([&]() {
+        LOG_IF_FAILED(target.ResetLineTransform());
+    });
+
+    auto imageSlice = _imageSlices.cbegin();
+    for (const auto& command : _commands)
+    {
+        switch (command.type)
+        {
+        case CommandType::UpdateDrawingBrushes:
+            RETURN_IF_FAILED(target.UpdateDrawingBrushes(command.attributes, pData, command.flag));
+            break;
+        case CommandType::ScrollFrame:
+            RETURN_IF_FAILED(target.ScrollFrame());
+            break;
+        case CommandType::PrepareRenderInfo:
+            RETURN_IF_FAILED(target.PrepareRenderInfo(_renderInfo));
+            break;
+        case CommandType::PaintBackground:
+            RETURN_IF_FAILED(target.PaintBackground());
+            break;
+        case CommandType::ResetLineTransform:
+            LOG_IF_FAILED(target.ResetLineTransform());
+            break;
+        case CommandType::PrepareLineTransform:
+            LOG_IF_FAILED(target.PrepareLineTransform(command.lineRendition, command.first, command.second));
+            break;
+        case CommandType::PaintBufferLine:
+        {
+            _replayClusters.clear();
+            const auto clusters = gsl::make_span(_clusters).subspan(command.first, command.second);
+            for (const auto& cluster : clusters)
+            {
+                _replayClusters.emplace_back(std::wstring_view{ _text }.substr(cluster.offset, cluster.length), cluster.columns);
+            }
+            RETURN_IF_FAILED(target.PaintBufferLine({ _replayClusters.data(), _replayClusters.size() }, command.coord, command.flag, command.lineWrapped));
+            break;
+        }
+        case CommandType::PaintBufferGridLines:
+            LOG_IF_FAILED(target.PaintBufferGridLines(command.lines, command.color, command.first, command.coord));
+            break;
+        case CommandType::PaintImageSlice:
+            LOG_IF_FAILED(target.PaintImageSlice(*imageSlice++, command.first, command.second));
+            break;
+        case CommandType::PaintSelection:
+            LOG_IF_FAILED(target.PaintSelection(command.rect));
+            break;
+        case CommandType::PaintSearchHighlight:
+            LOG_IF_FAILED(target.PaintSearchHighlight(command.rect));
+            break;
+        case CommandType::PaintCursor:
+            LOG_IF_FAILED(target.PaintCursor(_cursorOptions));
+            break;
+        case CommandType::UpdateTitle:
+            RETURN_IF_FAILED(target.UpdateTitle(_title));
+            break;
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+[[nodiscard]] HRESULT SnapshotEngine::_Record(Command command) noexcept
+try
+{
+    _commands.emplace_back(std::move(command));
+    return S_OK;
+}
+CATCH_RETURN()
+
+[[nodiscard]] HRESULT SnapshotEngine::StartPaint() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::EndPaint() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::Present() noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::ScrollFrame() noexcept
+{
+    return _Record({ CommandType::ScrollFrame });
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateCursor(const SMALL_RECT* const /*psrRegion*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateAll() noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+// Routine Description:
+// - Records the title, which the renderer passes on every frame. Whether it
+//   actually changed is for the real engine to decide during the replay.
+[[nodiscard]] HRESULT SnapshotEngine::UpdateTitle(const std::wstring_view newTitle) noexcept
+try
+{
+    _title = newTitle;
+    return _Record({ CommandType::UpdateTitle });
+}
+CATCH_RETURN()
+
+[[nodiscard]] HRESULT SnapshotEngine::PrepareRenderInfo(const RenderFrameInfo& info) noexcept
+{
+    _renderInfo = info;
+    return _Record({ CommandType::PrepareRenderInfo });
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::ResetLineTransform() noexcept
+{
+    return _Record({ CommandType::ResetLineTransform });
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::PrepareLineTransform(const LineRendition lineRendition,
+                                                           const size_t targetRow,
+                                                           const size_t viewportLeft) noexcept
+{
+    Command command{ CommandType::PrepareLineTransform };
+    command.lineRendition = lineRendition;
+    command.first = targetRow;
+    command.second = viewportLeft;
+    return _Record(command);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::PaintBackground() noexcept
+{
+    return _Record({ CommandType::PaintBackground });
+}
+
+// Routine Description:
+// - Records a line of text. The clusters point into the text buffer, so
+//   their text is copied, to stay valid after the console lock is released.
+[[nodiscard]] HRESULT SnapshotEngine::PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                                      const COORD coord,
+                                                      const bool fTrimLeft,
+                                                      const bool lineWrapped) noexcept
+try
+{
+    Command command{ CommandType::PaintBufferLine };
+    command.first = _clusters.size();
+    command.second = clusters.size();
+    command.coord = coord;
+    command.flag = fTrimLeft;
+    command.lineWrapped = lineWrapped;
+
+    for (const auto& cluster : clusters)
+    {
+        const auto& text = cluster.GetText();
+        _clusters.emplace_back(ClusterInfo{ _text.size(), text.size(), cluster.GetColumns() });
+        _text.append(text);
+    }
+
+    return _Record(command);
+}
+CATCH_RETURN()
+
+[[nodiscard]] HRESULT SnapshotEngine::PaintBufferGridLines(const GridLines lines,
+                                                           const COLORREF color,
+                                                           const size_t cchLine,
+                                                           const COORD coordTarget) noexcept
+{
+    Command command{ CommandType::PaintBufferGridLines };
+    command.lines = lines;
+    command.color = color;
+    command.first = cchLine;
+    command.coord = coordTarget;
+    return _Record(command);
+}
+
+// Routine Description:
+// - Records the image of a row. Its pixels are copied, for the same reason as
+//   the text is. The copy keeps the revision, so an engine that already made
+//   a texture out of the slice can keep using it.
+[[nodiscard]] HRESULT SnapshotEngine::PaintImageSlice(const ImageSlice& imageSlice,
+                                                      const size_t targetRow,
+                                                      const size_t viewportLeft) noexcept
+try
+{
+    Command command{ CommandType::PaintImageSlice };
+    command.first = targetRow;
+    command.second = viewportLeft;
+    _imageSlices.emplace_back(imageSlice);
+    const auto hr = _Record(command);
+    if (FAILED(hr))
+    {
+        _imageSlices.pop_back();
+    }
+    return hr;
+}
+CATCH_RETURN()
+
+[[nodiscard]] HRESULT SnapshotEngine::PaintSelection(const SMALL_RECT rect) noexcept
+{
+    Command command{ CommandType::PaintSelection };
+    command.rect = rect;
+    return _Record(command);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::PaintSearchHighlight(const SMALL_RECT rect) noexcept
+{
+    Command command{ CommandType::PaintSearchHighlight };
+    command.rect = rect;
+    return _Record(command);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::PaintCursor(const CursorOptions& options) noexcept
+{
+    _cursorOptions = options;
+    return _Record({ CommandType::PaintCursor });
+}
+
+// Routine Description:
+// - Records the attributes for the following calls. Their colors are only
+//   resolved by the real engine during the replay.
+[[nodiscard]] HRESULT SnapshotEngine::UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                           const gsl::not_null<IRenderData*> /*pData*/,
+                                                           const bool isSettingDefaultBrushes) noexcept
+{
+    Command command{ CommandType::UpdateDrawingBrushes };
+    command.attributes = textAttributes;
+    command.flag = isSettingDefaultBrushes;
+    return _Record(command);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::UpdateFont(const FontInfoDesired& /*FontInfoDesired*/,
+                                                 _Out_ FontInfo& /*FontInfo*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::UpdateDpi(const int /*iDpi*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::UpdateViewport(const SMALL_RECT /*srNewViewport*/) noexcept
+{
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::GetProposedFont(const FontInfoDesired& /*FontInfoDesired*/,
+                                                      _Out_ FontInfo& /*FontInfo*/,
+                                                      const int /*iDpi*/) noexcept
+{
+    return S_FALSE;
+}
+
+// Routine Description:
+// - The frame is composed against the dirty area of the engine it's going to
+//   be replayed into, which is valid until that engine's EndPaint.
+[[nodiscard]] HRESULT SnapshotEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+{
+    RETURN_HR_IF_NULL(E_NOT_VALID_STATE, _target);
+    return _target->GetDirtyArea(area);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
+{
+    RETURN_HR_IF_NULL(E_NOT_VALID_STATE, _target);
+    return _target->GetFontSize(pFontSize);
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::IsGlyphWideByFont(const std::wstring_view /*glyph*/, _Out_ bool* const pResult) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pResult);
+    *pResult = false;
+    return S_FALSE;
+}
+
+[[nodiscard]] HRESULT SnapshotEngine::_DoUpdateTitle(const std::wstring_view /*newTitle*/) noexcept
+{
+    return S_OK;
+}
@@ -0,0 +1,151 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SnapshotEngine.hpp
+
+Abstract:
+- A render engine that doesn't draw anything, but records the drawing calls
+  the renderer makes for one frame, together with copies of the text they
+  refer to.
+- The renderer composes a frame into it while holding the console lock and
+  replays it into the real engine once the lock has been released, so that
+  output can keep being processed while the real engine shapes and draws.
+--*/
+
+#pragma once
+
+#include "../inc/RenderEngineBase.hpp"
+#include "../../buffer/out/ImageSlice.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class SnapshotEngine final : public RenderEngineBase
+    {
+    public:
+        SnapshotEngine() = default;
+
+        void Begin(IRenderEngine* const target) noexcept;
+        [[nodiscard]] HRESULT Replay(IRenderEngine& target, const gsl::not_null<IRenderData*> pData) noexcept;
+
+        [[nodiscard]] HRESULT StartPaint() noexcept override;
+        [[nodiscard]] HRESULT EndPaint() noexcept override;
+        [[nodiscard]] HRESULT Present() noexcept override;
+
+        [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
+
+        [[nodiscard]] HRESULT ScrollFrame() noexcept override;
+
+        [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateAll() noexcept override;
+        [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override;
+
+        [[nodiscard]] HRESULT UpdateTitle(const std::wstring_view newTitle) noexcept override;
+
+        [[nodiscard]] HRESULT PrepareRenderInfo(const RenderFrameInfo& info) noexcept override;
+
+        [[nodiscard]] HRESULT ResetLineTransform() noexcept override;
+        [[nodiscard]] HRESULT PrepareLineTransform(const LineRendition lineRendition,
+                                                   const size_t targetRow,
+                                                   const size_t viewportLeft) noexcept override;
+
+        [[nodiscard]] HRESULT PaintBackground() noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                              const COORD coord,
+                                              const bool fTrimLeft,
+                                              const bool lineWrapped) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferGridLines(const GridLines lines,
+                                                   const COLORREF color,
+                                                   const size_t cchLine,
+                                                   const COORD coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                              const size_t targetRow,
+                                              const size_t viewportLeft) noexcept override;
+        [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
+        [[nodiscard]] HRESULT PaintSearchHighlight(const SMALL_RECT rect) noexcept override;
+
+        [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
+
+        [[nodiscard]] HRESULT UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                   const gsl::not_null<IRenderData*> pData,
+                                                   const bool isSettingDefaultBrushes) noexcept override;
+        [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& FontInfoDesired,
+                                         _Out_ FontInfo& FontInfo) noexcept override;
+        [[nodiscard]] HRESULT UpdateDpi(const int iDpi) noexcept override;
+        [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT srNewViewport) noexcept override;
+
+        [[nodiscard]] HRESULT GetProposedFont(const FontInfoDesired& FontInfoDesired,
+                                              _Out_ FontInfo& FontInfo,
+                                              const int iDpi) noexcept override;
+
+        [[nodiscard]] HRESULT GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept override;
+        [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
+        [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
+
+    protected:
+        [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
+
+    private:
+        enum class CommandType
+        {
+            UpdateDrawingBrushes,
+            ScrollFrame,
+            PrepareRenderInfo,
+            PaintBackground,
+            ResetLineTransform,
+            PrepareLineTransform,
+            PaintBufferLine,
+            PaintBufferGridLines,
+            PaintImageSlice,
+            PaintSelection,
+            PaintSearchHighlight,
+            PaintCursor,
+            UpdateTitle,
+        };
+
+        // A single recorded call. Only the members relevant to its type are used.
+        // Clusters are stored as ranges into _clusters and _text, since the
+        // buffer they were read from may change as soon as the lock is released.
+        struct Command
+        {
+            CommandType type;
+            TextAttribute attributes{};
+            bool flag = false;
+            bool lineWrapped = false;
+            LineRendition lineRendition = LineRendition::SingleWidth;
+            size_t first = 0;
+            size_t second = 0;
+            COORD coord{};
+            GridLines lines = GridLines::None;
+            COLORREF color = 0;
+            SMALL_RECT rect{};
+        };
+
+        struct ClusterInfo
+        {
+            size_t offset;
+            size_t length;
+            size_t columns;
+        };
+
+        [[nodiscard]] HRESULT _Record(Command command) noexcept;
+
+        IRenderEngine* _target = nullptr;
+
+        std::vector<Command> _commands;
+        std::vector<ClusterInfo> _clusters;
+        std::wstring _text;
+        // The PaintImageSlice commands use these in the order they were recorded.
+        std::vector<ImageSlice> _imageSlices;
+        RenderFrameInfo _renderInfo;
+        CursorOptions _cursorOptions{};
+        std::wstring _title;
+
+        std::vector<Cluster> _replayClusters;
+    };
+}
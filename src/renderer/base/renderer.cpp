@@ -15,6 +15,9 @@ using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 static constexpr auto maxRetriesForRenderEngine = 3;
 // The renderer will wait this number of milliseconds * how many tries have elapsed before trying again.
 static constexpr auto renderBackoffBaseTimeMilliseconds{ 150 };
+// Applications that synchronize their output usually finish a frame within a
+// few milliseconds. If one doesn't end it within this time, it's painted anyway.
+static constexpr std::chrono::milliseconds synchronizedOutputTimeout{ 500 };
 
 // Routine Description:
 // - Creates a new renderer controller for a console.
@@ -60,6 +63,7 @@ Renderer::~Renderer()
 // - <none>
 // Return Value:
 // - HRESULT S_OK, GDI error, Safe Math error, or state/argument errors.
+// - S_FALSE if none of the engines had anything to paint.
 [[nodiscard]] HRESULT Renderer::PaintFrame()
 {
     if (_destructing)
@@ -67,6 +71,25 @@ Renderer::~Renderer()
         return S_FALSE;
     }
 
+    if (_IsHoldingSynchronizedOutput())
+    {
+        // Everything that's invalidated in the meantime is accumulated by the
+        // engines. The frame is asked for again, so that the thread checks
+        // back every frame interval until the output ends or times out.
+        _NotifyPaintFrame();
+        return S_FALSE;
+    }
+
+    if (_pfnFrameStarting)
+    {
+        try
+        {
+            _pfnFrameStarting();
+        }
+        CATCH_LOG();
+    }
+
+    auto painted = false;
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
         auto tries = maxRetriesForRenderEngine;
@@ -99,11 +122,21 @@ Renderer::~Renderer()
                 continue;
             }
             LOG_IF_FAILED(hr);
+            painted = painted || hr != S_FALSE;
             break;
         }
     }
 
-    return S_OK;
+    if (_pfnFrameCompleted)
+    {
+        try
+        {
+            _pfnFrameCompleted();
+        }
+        CATCH_LOG();
+    }
+
+    return painted ? S_OK : S_FALSE;
 }
 
 [[nodiscard]] HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
@@ -111,16 +144,40 @@ try
 {
     FAIL_FAST_IF_NULL(pEngine); // This is a programming error. Fail fast.
 
+    if (pEngine->SupportsSnapshotPainting())
+    {
+        return _PaintSnapshotFrameForEngine(pEngine);
+    }
+
     _pData->LockConsole();
     auto unlock = wil::scope_exit([&]() {
         _pData->UnlockConsole();
     });
 
+    // Everything written to the buffer before this point is part of this frame.
+    const auto frame = _frameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
     // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
     _CheckViewportAndScroll();
+    _RememberCursorPosition();
+
+    if (_TryPaintCursorFrame(pEngine))
+    {
+        unlock.reset();
+        return pEngine->Present();
+    }
+
+    FrameTiming timing;
+    FrameTracing::Stopwatch totalTime{ timing.total };
+
+    // Whatever is allocated until the frame is presented is counted towards painting it.
+    til::allocation_tracker::scope paintAllocations{ til::allocation_region::paint };
+    const auto allocationsBefore = s_CountFrameAllocations();
 
     // Try to start painting a frame
+    FrameTracing::Stopwatch startPaintTime{ timing.startPaint };
     HRESULT const hr = pEngine->StartPaint();
+    startPaintTime.Stop();
     RETURN_IF_FAILED(hr);
 
     // Return early if there's nothing to paint.
@@ -128,9 +185,18 @@ try
     //      engine won't know that.
     if (S_FALSE == hr)
     {
-        return S_OK;
+        // Nothing was invalidated, so the engine still shows what the buffer holds.
+        _RememberPaintedRows(pEngine);
+        return S_FALSE;
     }
 
+    timing.dirtyCells = s_CountDirtyCells(*pEngine);
+
+    // If the frame fails halfway through, there's no telling what the engine shows.
+    auto forgetRows = wil::scope_exit([&]() {
+        _paintedRows.erase(pEngine);
+    });
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
 
@@ -156,16 +222,21 @@ try
     RETURN_IF_FAILED(_PaintBackground(pEngine));
 
     // 2. Paint Rows of Text
+    FrameTracing::Stopwatch bufferOutputTime{ timing.bufferOutput };
     _PaintBufferOutput(pEngine);
+    bufferOutputTime.Stop();
 
     // 3. Paint overlays that reside above the text buffer
     _PaintOverlays(pEngine);
 
-    // 4. Paint Selection
+    // 4. Paint the highlighted search matches and then the selection above them
+    _PaintSearchHighlights(pEngine);
     _PaintSelection(pEngine);
 
     // 5. Paint Cursor
+    FrameTracing::Stopwatch cursorTime{ timing.cursor };
     _PaintCursor(pEngine);
+    cursorTime.Stop();
 
     // 6. Paint window title
     RETURN_IF_FAILED(_PaintTitle(pEngine));
@@ -173,17 +244,348 @@ try
     // Force scope exit end paint to finish up collecting information and possibly painting
     endPaint.reset();
 
+    // 7. Remember the rows the engine shows now, while the buffer still holds them
+    _RememberPaintedRows(pEngine);
+    forgetRows.release();
+
     // Force scope exit unlock to let go of global lock so other threads can run
     unlock.reset();
 
     // Trigger out-of-lock presentation for renderers that can support it
-    RETURN_IF_FAILED(pEngine->Present());
+    FrameTracing::Stopwatch presentTime{ timing.present };
+    {
+        til::allocation_tracker::scope presentAllocations{ til::allocation_region::present };
+        RETURN_IF_FAILED(pEngine->Present());
+    }
+    presentTime.Stop();
+
+    totalTime.Stop();
+    const auto allocations = s_CountFrameAllocations() - allocationsBefore;
+    timing.allocations = allocations.allocations;
+    timing.allocatedBytes = allocations.bytes;
+    _frameTracing.TraceFrame(pEngine, timing);
+    _TraceInputLatency(pEngine);
+    _NotifyFramePresented(frame);
 
     // As we leave the scope, EndPaint will be called (declared above)
     return S_OK;
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Paints a frame for an engine that supports snapshot painting.
+// - The frame is composed the same way _PaintFrameForEngine does it, but into
+//   _snapshot, which copies out the bits of the console it needs. The console
+//   lock is then released and the snapshot is replayed into the engine, so
+//   output can continue to be processed while the engine shapes and draws.
+// - Until the engine's EndPaint, invalidations for it are deferred (see _Invalidate).
+// Arguments:
+// - pEngine - The engine to paint the frame with.
+// Return Value:
+// - S_OK, or S_FALSE if there was nothing to paint, or a relevant error via HRESULT.
+[[nodiscard]] HRESULT Renderer::_PaintSnapshotFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
+try
+{
+    _pData->LockConsole();
+    auto unlock = wil::scope_exit([&]() {
+        _pData->UnlockConsole();
+    });
+
+    // Everything written to the buffer before this point is part of this frame.
+    const auto frame = _frameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // Nobody else gets to talk to the engines until this frame is done.
+    // Whatever was deferred while we painted the previous one can go out now.
+    std::unique_lock engineLock{ _engineMutex };
+    _FlushDeferredInvalidations();
+
+    // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
+    _CheckViewportAndScroll();
+    _RememberCursorPosition();
+
+    if (_TryPaintCursorFrame(pEngine))
+    {
+        unlock.reset();
+        engineLock.unlock();
+        return pEngine->Present();
+    }
+
+    FrameTiming timing;
+    FrameTracing::Stopwatch totalTime{ timing.total };
+
+    // Whatever is allocated until the frame is presented is counted towards painting it.
+    til::allocation_tracker::scope paintAllocations{ til::allocation_region::paint };
+    const auto allocationsBefore = s_CountFrameAllocations();
+
+    FrameTracing::Stopwatch startPaintTime{ timing.startPaint };
+    HRESULT const hr = pEngine->StartPaint();
+    startPaintTime.Stop();
+    RETURN_IF_FAILED(hr);
+
+    if (S_FALSE == hr)
+    {
+        _RememberPaintedRows(pEngine);
+        return S_FALSE;
+    }
+
+    timing.dirtyCells = s_CountDirtyCells(*pEngine);
+
+    auto forgetRows = wil::scope_exit([&]() {
+        _paintedRows.erase(pEngine);
+    });
+
+    auto endPaint = wil::scope_exit([&]() {
+        LOG_IF_FAILED(pEngine->EndPaint());
+
+        if (pEngine->RequiresContinuousRedraw())
+        {
+            _NotifyPaintFrame();
+        }
+    });
+
+    _snapshot.Begin(pEngine);
+    IRenderEngine* const snapshot = &_snapshot;
+
+    RETURN_IF_FAILED(_UpdateDrawingBrushes(snapshot, _pData->GetDefaultBrushColors(), true));
+    RETURN_IF_FAILED(_PerformScrolling(snapshot));
+    RETURN_IF_FAILED(_PrepareRenderInfo(snapshot));
+    RETURN_IF_FAILED(_PaintBackground(snapshot));
+    FrameTracing::Stopwatch bufferOutputTime{ timing.bufferOutput };
+    _PaintBufferOutput(snapshot);
+    bufferOutputTime.Stop();
+    _PaintOverlays(snapshot);
+    _PaintSearchHighlights(snapshot);
+    _PaintSelection(snapshot);
+    FrameTracing::Stopwatch cursorTime{ timing.cursor };
+    _PaintCursor(snapshot);
+    cursorTime.Stop();
+    RETURN_IF_FAILED(_PaintTitle(snapshot));
+
+    // The snapshot holds copies of everything the engine is going to draw.
+    _RememberPaintedRows(pEngine);
+    forgetRows.release();
+    unlock.reset();
+
+    // The buffer output and cursor timings above only cover taking the snapshot.
+    // The engine's share of drawing them happens during the replay.
+    FrameTracing::Stopwatch replayTime{ timing.replay };
+    RETURN_IF_FAILED(_snapshot.Replay(*pEngine, _pData));
+    endPaint.reset();
+    replayTime.Stop();
+    engineLock.unlock();
+
+    FrameTracing::Stopwatch presentTime{ timing.present };
+    {
+        til::allocation_tracker::scope presentAllocations{ til::allocation_region::present };
+        RETURN_IF_FAILED(pEngine->Present());
+    }
+    presentTime.Stop();
+
+    totalTime.Stop();
+    const auto allocations = s_CountFrameAllocations() - allocationsBefore;
+    timing.allocations = allocations.allocations;
+    timing.allocatedBytes = allocations.bytes;
+    _frameTracing.TraceFrame(pEngine, timing);
+    _TraceInputLatency(pEngine);
+    _NotifyFramePresented(frame);
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Counts the cells an engine is about to repaint, for FrameTracing.
+// Arguments:
+// - engine - The engine that started painting a frame.
+// Return Value:
+// - The number of dirty cells.
+size_t Renderer::s_CountDirtyCells(IRenderEngine& engine)
+{
+    gsl::span<const til::rectangle> dirtyAreas;
+    LOG_IF_FAILED(engine.GetDirtyArea(dirtyAreas));
+
+    size_t cells = 0;
+    for (const auto& dirtyArea : dirtyAreas)
+    {
+        cells += dirtyArea.size().area<size_t>();
+    }
+    return cells;
+}
+
+// Routine Description:
+// - Gets the allocations made while painting and presenting frames so far,
+//   for FrameTracing. They're counted for the whole process, so the frames
+//   of other renderers that are painted at the same time are part of it.
+// Arguments:
+// - <none>
+// Return Value:
+// - The allocations and bytes counted for the paint and present regions.
+til::allocation_tracker::counts Renderer::s_CountFrameAllocations() noexcept
+{
+    return til::allocation_tracker::get(til::allocation_region::paint) +
+           til::allocation_tracker::get(til::allocation_region::present);
+}
+
+// Routine Description:
+// - A blinking cursor is usually all that changes in an idle terminal.
+//   Engines that can redraw the cursor on its own are given the chance to
+//   do so, instead of going through a regular frame with all of its text.
+// Arguments:
+// - pEngine - The engine to paint the cursor frame with.
+// Return Value:
+// - true if the engine painted the cursor frame and only has to present it.
+bool Renderer::_TryPaintCursorFrame(_In_ IRenderEngine* const pEngine)
+{
+    const auto cursorInfo = _GetCursorInfo();
+    if (!cursorInfo.has_value())
+    {
+        return false;
+    }
+
+    const auto hr = pEngine->PaintCursorFrame(cursorInfo.value());
+    LOG_IF_FAILED(hr);
+    return hr == S_OK;
+}
+
+// Routine Description:
+// - Hands an invalidation to every engine.
+// - Engines that are painting a frame outside of the console lock can't take
+//   it right now. It gets queued for them instead and is handed over before
+//   anything else happens to them, in the order it arrived.
+// - Like all of the Trigger* methods, this expects the console lock to be held.
+// Arguments:
+// - invalidation - What to invalidate.
+// Return Value:
+// - <none>
+void Renderer::_Invalidate(const Invalidation& invalidation)
+{
+    switch (invalidation.kind)
+    {
+    case Invalidation::Kind::Scroll:
+        _ScrollPaintedRows(invalidation.delta);
+        break;
+    case Invalidation::Kind::ScrollRegion:
+        _ScrollPaintedRowsInRegion(invalidation.region.Top, invalidation.region.Bottom, invalidation.delta.Y);
+        break;
+    case Invalidation::Kind::All:
+    case Invalidation::Kind::Circling:
+        _paintedRows.clear();
+        break;
+    default:
+        break;
+    }
+
+    const auto engineLock = _TryLockEngines();
+    for (IRenderEngine* const pEngine : _rgpEngines)
+    {
+        if (engineLock || !pEngine->SupportsSnapshotPainting())
+        {
+            s_ApplyInvalidation(*pEngine, invalidation);
+        }
+        else
+        {
+            _deferredInvalidations.emplace_back(pEngine, invalidation);
+        }
+    }
+}
+
+// Routine Description:
+// - Hands an invalidation to a single engine.
+// Arguments:
+// - engine - The engine to invalidate.
+// - invalidation - What to invalidate.
+// Return Value:
+// - <none>
+void Renderer::s_ApplyInvalidation(IRenderEngine& engine, const Invalidation& invalidation) noexcept
+{
+    switch (invalidation.kind)
+    {
+    case Invalidation::Kind::System:
+        LOG_IF_FAILED(engine.InvalidateSystem(&invalidation.client));
+        break;
+    case Invalidation::Kind::Region:
+        LOG_IF_FAILED(engine.Invalidate(&invalidation.region));
+        break;
+    case Invalidation::Kind::Cursor:
+        LOG_IF_FAILED(engine.InvalidateCursor(&invalidation.region));
+        break;
+    case Invalidation::Kind::Selection:
+        LOG_IF_FAILED(engine.InvalidateSelection(invalidation.rectangles));
+        break;
+    case Invalidation::Kind::Scroll:
+        LOG_IF_FAILED(engine.InvalidateScroll(&invalidation.delta));
+        break;
+    case Invalidation::Kind::ScrollRegion:
+        LOG_IF_FAILED(engine.InvalidateScrollRegion(&invalidation.region, invalidation.delta.Y));
+        break;
+    case Invalidation::Kind::All:
+        LOG_IF_FAILED(engine.InvalidateAll());
+        break;
+    case Invalidation::Kind::Circling:
+    {
+        // By the time a deferred circling gets here, there's no point in
+        // painting before it anymore. The buffer has long since circled.
+        bool forcePaint = false;
+        LOG_IF_FAILED(engine.InvalidateCircling(&forcePaint));
+        break;
+    }
+    case Invalidation::Kind::Viewport:
+        LOG_IF_FAILED(engine.UpdateViewport(invalidation.region));
+        break;
+    case Invalidation::Kind::Title:
+        LOG_IF_FAILED(engine.InvalidateTitle(invalidation.title));
+        break;
+    }
+}
+
+// Routine Description:
+// - Acquires the engine lock, unless a frame is being painted outside of the
+//   console lock, and hands out the invalidations deferred while it was.
+// Arguments:
+// - <none>
+// Return Value:
+// - The engine lock, which doesn't own the mutex if a frame is being painted.
+[[nodiscard]] std::unique_lock<std::recursive_mutex> Renderer::_TryLockEngines()
+{
+    std::unique_lock engineLock{ _engineMutex, std::try_to_lock };
+    if (engineLock)
+    {
+        _FlushDeferredInvalidations();
+    }
+    return engineLock;
+}
+
+// Routine Description:
+// - Hands the deferred invalidations to their engines. Requires the engine lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_FlushDeferredInvalidations() noexcept
+{
+    for (const auto& [engine, invalidation] : _deferredInvalidations)
+    {
+        s_ApplyInvalidation(*engine, invalidation);
+    }
+    _deferredInvalidations.clear();
+}
+
+// Routine Description:
+// - Waits for the frame that's being painted outside of the console lock, if
+//   any, and keeps another one from starting. Hosts that reconfigure their
+//   engines directly, instead of going through the renderer, need to hold
+//   this (in addition to the console lock) while they do so.
+// Arguments:
+// - <none>
+// Return Value:
+// - The engine lock.
+[[nodiscard]] std::unique_lock<std::recursive_mutex> Renderer::LockEngines()
+{
+    std::unique_lock engineLock{ _engineMutex };
+    _FlushDeferredInvalidations();
+    return engineLock;
+}
+
 void Renderer::_NotifyPaintFrame()
 {
     // If we're running in the unittests, we might not have a render thread.
@@ -202,9 +604,9 @@ void Renderer::_NotifyPaintFrame()
 // - <none>
 void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
 {
-    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-        LOG_IF_FAILED(pEngine->InvalidateSystem(prcDirtyClient));
-    });
+    Invalidation invalidation{ Invalidation::Kind::System };
+    invalidation.client = *prcDirtyClient;
+    _Invalidate(invalidation);
 
     _NotifyPaintFrame();
 }
@@ -217,6 +619,8 @@ void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
 // - <none>
 void Renderer::TriggerRedraw(const Viewport& region)
 {
+    _NoteInputEchoed();
+
     Viewport view = _viewport;
     SMALL_RECT srUpdateRegion = region.ToExclusive();
 
@@ -235,14 +639,207 @@ void Renderer::TriggerRedraw(const Viewport& region)
     if (view.TrimToViewport(&srUpdateRegion))
     {
         view.ConvertToOrigin(&srUpdateRegion);
-        std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-            LOG_IF_FAILED(pEngine->Invalidate(&srUpdateRegion));
-        });
+
+        Invalidation invalidation{ Invalidation::Kind::Region };
+        invalidation.region = srUpdateRegion;
+        _Invalidate(invalidation);
 
         _NotifyPaintFrame();
     }
 }
 
+// Routine Description:
+// - Called when the text buffer has written to a region, which might or might
+//   not have changed what it holds. Rows that every engine already shows
+//   exactly as they are now are dropped from the region, so that the engines
+//   don't repaint (or, for VT, retransmit) them. This is common in apps that
+//   redraw their whole screen on every update, like a status bar or a clock.
+// - Anything that changes how a row looks without changing its contents,
+//   like a hovered hyperlink, has to use TriggerRedraw instead.
+// Arguments:
+// - region - The buffer-space region that was written to.
+// Return Value:
+// - <none>
+void Renderer::TriggerRedrawContent(const Viewport& region)
+{
+    if (_paintedRows.size() != _rgpEngines.size())
+    {
+        TriggerRedraw(region);
+        return;
+    }
+
+    const auto& buffer = _pData->GetTextBuffer();
+    const auto rect = region.ToExclusive();
+    const auto top = std::max(rect.Top, _viewport.Top());
+    const auto bottom = std::min(rect.Bottom, _viewport.BottomExclusive());
+
+    // The remaining rows are invalidated in runs, to keep the number of invalidations down.
+    auto runTop = top;
+    for (auto row = top; row < bottom; ++row)
+    {
+        if (_IsRowPainted(buffer, row))
+        {
+            if (runTop < row)
+            {
+                TriggerRedraw(Viewport::FromExclusive({ rect.Left, runTop, rect.Right, row }));
+            }
+            runTop = row + 1;
+        }
+    }
+
+    if (runTop < bottom)
+    {
+        TriggerRedraw(Viewport::FromExclusive({ rect.Left, runTop, rect.Right, bottom }));
+    }
+}
+
+// Routine Description:
+// - Checks whether every engine shows a row of the viewport exactly as the buffer holds it now.
+// Arguments:
+// - buffer - The text buffer.
+// - row - The buffer-space row to check. Must be within the viewport.
+// Return Value:
+// - true if none of the engines need to repaint the row.
+bool Renderer::_IsRowPainted(const TextBuffer& buffer, const SHORT row) const
+{
+    const auto& bufferRow = buffer.GetRowByOffset(row);
+    const auto index = gsl::narrow_cast<size_t>(row - _viewport.Top());
+
+    std::optional<size_t> hash;
+    for (const auto& [engine, rows] : _paintedRows)
+    {
+        if (index >= rows.size())
+        {
+            return false;
+        }
+
+        const auto& painted = til::at(rows, index);
+        if (painted.generation == 0)
+        {
+            return false;
+        }
+
+        // Rows have to be written to for their contents to change, which gets them a new generation.
+        if (painted.generation == bufferRow.GetGeneration())
+        {
+            continue;
+        }
+
+        if (!hash)
+        {
+            hash = bufferRow.GetHash();
+        }
+        if (painted.hash != *hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Routine Description:
+// - Records the rows of the viewport as the given engine shows them after a frame.
+// - Every change to the buffer is followed by an invalidation, so once an engine
+//   has painted all of its invalid regions, it shows what the buffer holds.
+//   Like all of the painting, this expects the console lock to be held.
+// Arguments:
+// - pEngine - The engine that finished a frame.
+// Return Value:
+// - <none>
+void Renderer::_RememberPaintedRows(const IRenderEngine* const pEngine) noexcept
+try
+{
+    const auto& buffer = _pData->GetTextBuffer();
+    const auto height = gsl::narrow_cast<size_t>(_viewport.Height());
+
+    auto& rows = _paintedRows[pEngine];
+    if (rows.size() != height)
+    {
+        rows.assign(height, {});
+    }
+
+    for (size_t i = 0; i < height; ++i)
+    {
+        auto& painted = til::at(rows, i);
+        const auto& row = buffer.GetRowByOffset(_viewport.Top() + i);
+        // Only the rows that were written to since the last frame need to be hashed again.
+        if (painted.generation != row.GetGeneration())
+        {
+            painted.generation = row.GetGeneration();
+            painted.hash = row.GetHash();
+        }
+    }
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Moves the rows recorded by _RememberPaintedRows along with the contents of the engines.
+// Arguments:
+// - delta - The distance the contents of the viewport were moved by.
+// Return Value:
+// - <none>
+void Renderer::_ScrollPaintedRows(const COORD delta) noexcept
+{
+    for (auto& [engine, rows] : _paintedRows)
+    {
+        const auto distance = gsl::narrow_cast<ptrdiff_t>(std::abs(delta.Y));
+        if (delta.X != 0 || distance >= gsl::narrow_cast<ptrdiff_t>(rows.size()))
+        {
+            std::fill(rows.begin(), rows.end(), PaintedRow{});
+        }
+        else if (delta.Y > 0)
+        {
+            std::rotate(rows.begin(), rows.end() - distance, rows.end());
+            std::fill(rows.begin(), rows.begin() + distance, PaintedRow{});
+        }
+        else if (delta.Y < 0)
+        {
+            std::rotate(rows.begin(), rows.begin() + distance, rows.end());
+            std::fill(rows.end() - distance, rows.end(), PaintedRow{});
+        }
+    }
+}
+
+// Routine Description:
+// - Moves the rows recorded by _RememberPaintedRows within a part of the
+//   viewport, along with the contents of the engines. This is what
+//   _ScrollPaintedRows does, if the scroll margins are set.
+// Arguments:
+// - top - The first row of the region, relative to the top of the viewport.
+// - bottom - The row below the region, relative to the top of the viewport.
+// - delta - The distance the rows of the region were moved by.
+// Return Value:
+// - <none>
+void Renderer::_ScrollPaintedRowsInRegion(const SHORT top, const SHORT bottom, const SHORT delta) noexcept
+{
+    for (auto& [engine, rows] : _paintedRows)
+    {
+        if (top < 0 || bottom > gsl::narrow_cast<ptrdiff_t>(rows.size()) || top >= bottom)
+        {
+            std::fill(rows.begin(), rows.end(), PaintedRow{});
+            continue;
+        }
+
+        const auto first = rows.begin() + top;
+        const auto last = rows.begin() + bottom;
+        const auto distance = gsl::narrow_cast<ptrdiff_t>(std::abs(delta));
+        if (distance >= last - first)
+        {
+            std::fill(first, last, PaintedRow{});
+        }
+        else if (delta > 0)
+        {
+            std::rotate(first, last - distance, last);
+            std::fill(first, first + distance, PaintedRow{});
+        }
+        else if (delta < 0)
+        {
+            std::rotate(first, first + distance, last);
+            std::fill(last - distance, last, PaintedRow{});
+        }
+    }
+}
+
 // Routine Description:
 // - Called when a particular coordinate within the console buffer has changed.
 // Arguments:
@@ -285,11 +882,9 @@ void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
 
         if (cursorView.IsValid())
         {
-            const SMALL_RECT updateRect = view.ConvertToOrigin(cursorView).ToExclusive();
-            for (IRenderEngine* pEngine : _rgpEngines)
-            {
-                LOG_IF_FAILED(pEngine->InvalidateCursor(&updateRect));
-            }
+            Invalidation invalidation{ Invalidation::Kind::Cursor };
+            invalidation.region = view.ConvertToOrigin(cursorView).ToExclusive();
+            _Invalidate(invalidation);
 
             _NotifyPaintFrame();
         }
@@ -305,9 +900,7 @@ void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
 // - <none>
 void Renderer::TriggerRedrawAll()
 {
-    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-        LOG_IF_FAILED(pEngine->InvalidateAll());
-    });
+    _Invalidate({ Invalidation::Kind::All });
 
     _NotifyPaintFrame();
 }
@@ -351,32 +944,114 @@ void Renderer::TriggerSelection()
         // Get selection rectangles
         const auto rects = _GetSelectionRects();
 
-        // Restrict all previous selection rectangles to inside the current viewport bounds
-        for (auto& sr : _previousSelection)
+        // Make a viewport representing the coordinates that are currently presentable.
+        const til::rectangle viewport{ til::size{ _pData->GetViewport().Dimensions() } };
+
+        // Only the cells that were selected or deselected since the last time need to be redrawn.
+        // Dragging a selection across many rows otherwise redraws all of them on every mouse move.
+        auto changes = s_GetSelectionChanges(_previousSelection, rects, viewport);
+        _previousSelection = rects;
+
+        if (!changes.empty())
         {
-            // Make the exclusive SMALL_RECT into a til::rectangle.
-            til::rectangle rc{ Viewport::FromExclusive(sr).ToInclusive() };
+            Invalidation invalidation{ Invalidation::Kind::Selection };
+            invalidation.rectangles = std::move(changes);
+            _Invalidate(invalidation);
 
-            // Make a viewport representing the coordinates that are currently presentable.
-            const til::rectangle viewport{ til::size{ _pData->GetViewport().Dimensions() } };
+            _NotifyPaintFrame();
+        }
+    }
+    CATCH_LOG();
+}
 
-            // Intersect them so we only invalidate things that are still visible.
-            rc &= viewport;
+// Routine Description:
+// - Computes the cells that are part of exactly one of two selections.
+// - A selection that is a single rectangle, like any block selection or a
+//   selection within a single row, is compared as a whole. Everything else
+//   is compared cell by cell in a bitmap of the viewport.
+// Arguments:
+// - previous - the exclusive rectangles of the previous selection
+// - current - the exclusive rectangles of the current selection
+// - viewport - the cells that are presentable. Changes outside of it are ignored.
+// Return Value:
+// - The exclusive rectangles of the cells that were selected or deselected.
+std::vector<SMALL_RECT> Renderer::s_GetSelectionChanges(const std::vector<SMALL_RECT>& previous,
+                                                        const std::vector<SMALL_RECT>& current,
+                                                        const til::rectangle viewport)
+{
+    const auto toRectangle = [&](const SMALL_RECT& sr) {
+        return til::rectangle{ Viewport::FromExclusive(sr).ToInclusive() } & viewport;
+    };
 
-            // Convert back into the exclusive SMALL_RECT and store in the vector.
-            sr = Viewport::FromInclusive(rc).ToExclusive();
+    // Returns the rectangle covered by the rows of the selection,
+    // if they are stacked on top of each other with the same columns.
+    const auto asSingleRectangle = [&](const std::vector<SMALL_RECT>& rects) -> std::optional<til::rectangle> {
+        if (rects.empty())
+        {
+            return til::rectangle{};
+        }
+
+        for (size_t i = 1; i < rects.size(); ++i)
+        {
+            const auto& rect = til::at(rects, i);
+            if (rect.Left != rects.front().Left || rect.Right != rects.front().Right || rect.Top != til::at(rects, i - 1).Bottom)
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto merged = rects.front();
+        merged.Bottom = rects.back().Bottom;
+        return toRectangle(merged);
+    };
+
+    std::vector<SMALL_RECT> changes;
+    const auto addChange = [&](const til::rectangle& rc) {
+        if (!rc.empty())
+        {
+            changes.emplace_back(Viewport::FromInclusive(rc).ToExclusive());
+        }
+    };
+
+    const auto previousRectangle = asSingleRectangle(previous);
+    const auto currentRectangle = asSingleRectangle(current);
+    if (previousRectangle && currentRectangle)
+    {
+        for (const auto& rc : *previousRectangle - *currentRectangle)
+        {
+            addChange(rc);
+        }
+        for (const auto& rc : *currentRectangle - *previousRectangle)
+        {
+            addChange(rc);
         }
+        return changes;
+    }
 
-        std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-            LOG_IF_FAILED(pEngine->InvalidateSelection(_previousSelection));
-            LOG_IF_FAILED(pEngine->InvalidateSelection(rects));
-        });
+    til::bitmap previousCells{ viewport.size() };
+    for (const auto& sr : previous)
+    {
+        if (const auto rc = toRectangle(sr); !rc.empty())
+        {
+            previousCells.set(rc);
+        }
+    }
 
-        _previousSelection = rects;
+    til::bitmap currentCells{ viewport.size() };
+    for (const auto& sr : current)
+    {
+        if (const auto rc = toRectangle(sr); !rc.empty())
+        {
+            currentCells.set(rc);
+        }
+    }
 
-        _NotifyPaintFrame();
+    previousCells ^= currentCells;
+    for (const auto& rc : previousCells.runs())
+    {
+        addChange(rc);
     }
-    CATCH_LOG();
+    return changes;
 }
 
 // Routine Description:
@@ -394,12 +1069,16 @@ bool Renderer::_CheckViewportAndScroll()
     coordDelta.X = srOldViewport.Left - srNewViewport.Left;
     coordDelta.Y = srOldViewport.Top - srNewViewport.Top;
 
-    for (auto engine : _rgpEngines)
+    Invalidation viewport{ Invalidation::Kind::Viewport };
+    viewport.region = srNewViewport;
+    _Invalidate(viewport);
+
+    const auto newViewport = Viewport::FromInclusive(srNewViewport);
+    if (newViewport.Dimensions() != _viewport.Dimensions())
     {
-        LOG_IF_FAILED(engine->UpdateViewport(srNewViewport));
+        _paintedRows.clear();
     }
-
-    _viewport = Viewport::FromInclusive(srNewViewport);
+    _viewport = newViewport;
 
     // If we're keeping some buffers between calls, let them know about the viewport size
     // so they can prepare the buffers for changes to either preallocate memory at once
@@ -409,10 +1088,9 @@ bool Renderer::_CheckViewportAndScroll()
 
     if (coordDelta.X != 0 || coordDelta.Y != 0)
     {
-        for (auto engine : _rgpEngines)
-        {
-            LOG_IF_FAILED(engine->InvalidateScroll(&coordDelta));
-        }
+        Invalidation scroll{ Invalidation::Kind::Scroll };
+        scroll.delta = coordDelta;
+        _Invalidate(scroll);
 
         _ScrollPreviousSelection(coordDelta);
 
@@ -448,15 +1126,46 @@ void Renderer::TriggerScroll()
 // - <none>
 void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 {
-    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-        LOG_IF_FAILED(pEngine->InvalidateScroll(pcoordDelta));
-    });
+    Invalidation scroll{ Invalidation::Kind::Scroll };
+    scroll.delta = *pcoordDelta;
+    _Invalidate(scroll);
+    _NoteInputEchoed();
 
     _ScrollPreviousSelection(*pcoordDelta);
 
     _NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Called when the rows of a part of the buffer were moved up or down, like
+//   a scroll within the margins (DECSTBM) does. Engines that can move the
+//   rows they already show may do so and only paint the rows that were
+//   revealed. All the others repaint the whole region.
+// Arguments:
+// - region - The buffer-space region whose rows were moved, including the rows that were revealed.
+// - delta - The distance the rows were moved by, negative is upwards.
+// Return Value:
+// - <none>
+void Renderer::TriggerScrollRegion(const Viewport& region, const SHORT delta)
+{
+    SMALL_RECT srRegion = region.ToExclusive();
+    if (!_viewport.IsInBounds(region) || delta == 0)
+    {
+        TriggerRedraw(region);
+        return;
+    }
+
+    _viewport.ConvertToOrigin(&srRegion);
+
+    Invalidation invalidation{ Invalidation::Kind::ScrollRegion };
+    invalidation.region = srRegion;
+    invalidation.delta = { 0, delta };
+    _Invalidate(invalidation);
+    _NoteInputEchoed();
+
+    _NotifyPaintFrame();
+}
+
 // Routine Description:
 // - Called when the text buffer is about to circle its backing buffer.
 //      A renderer might want to get painted before that happens.
@@ -466,8 +1175,20 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 // - <none>
 void Renderer::TriggerCircling()
 {
+    _paintedRows.clear();
+
+    const auto engineLock = _TryLockEngines();
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
+        // An engine that's painting the current frame can't paint another one
+        // before the buffer circles, but it doesn't need to: the frame already
+        // holds copies of everything it's going to draw.
+        if (!engineLock && pEngine->SupportsSnapshotPainting())
+        {
+            _deferredInvalidations.emplace_back(pEngine, Invalidation{ Invalidation::Kind::Circling });
+            continue;
+        }
+
         bool fEngineRequestsRepaint = false;
         HRESULT hr = pEngine->InvalidateCircling(&fEngineRequestsRepaint);
         LOG_IF_FAILED(hr);
@@ -488,12 +1209,51 @@ void Renderer::TriggerCircling()
 // - <none>
 void Renderer::TriggerTitleChange()
 {
-    const auto newTitle = _pData->GetConsoleTitle();
-    for (IRenderEngine* const pEngine : _rgpEngines)
+    Invalidation invalidation{ Invalidation::Kind::Title };
+    invalidation.title = _pData->GetConsoleTitle();
+    _Invalidate(invalidation);
+    _NotifyPaintFrame();
+}
+
+// Routine Description:
+// - Called when the application starts or ends synchronizing its output
+//   (DECSET/DECRST 2026). While it does, no frames are painted, so that the
+//   partial frames it writes in between aren't shown. Once it ends, the
+//   frame is painted all at once. A frame that isn't ended within
+//   synchronizedOutputTimeout is painted anyway.
+// Arguments:
+// - enabled - true when the application begins a frame, false when it ends it.
+// Return Value:
+// - <none>
+void Renderer::SetSynchronizedOutput(const bool enabled) noexcept
+{
+    if (enabled)
     {
-        LOG_IF_FAILED(pEngine->InvalidateTitle(newTitle));
+        const auto deadline = std::chrono::steady_clock::now() + synchronizedOutputTimeout;
+        _synchronizedOutputDeadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
     }
-    _NotifyPaintFrame();
+    else if (_synchronizedOutputDeadline.exchange(0, std::memory_order_relaxed) != 0)
+    {
+        _NotifyPaintFrame();
+    }
+}
+
+// Routine Description:
+// - Returns true while frames are held back for a synchronized output that
+//   hasn't ended yet. Once it timed out, it's ended here.
+bool Renderer::_IsHoldingSynchronizedOutput() noexcept
+{
+    auto deadline = _synchronizedOutputDeadline.load(std::memory_order_relaxed);
+    if (deadline == 0)
+    {
+        return false;
+    }
+    if (std::chrono::steady_clock::now().time_since_epoch().count() < deadline)
+    {
+        return true;
+    }
+    _synchronizedOutputDeadline.compare_exchange_strong(deadline, 0, std::memory_order_relaxed);
+    return false;
 }
 
 // Routine Description:
@@ -518,6 +1278,10 @@ HRESULT Renderer::_PaintTitle(IRenderEngine* const pEngine)
 // - <none>
 void Renderer::TriggerFontChange(const int iDpi, const FontInfoDesired& FontInfoDesired, _Out_ FontInfo& FontInfo)
 {
+    // Swapping out the font in the middle of a frame isn't an option.
+    const auto engineLock = LockEngines();
+    _paintedRows.clear();
+
     std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
         LOG_IF_FAILED(pEngine->UpdateDpi(iDpi));
         LOG_IF_FAILED(pEngine->UpdateFont(FontInfoDesired, FontInfo));
@@ -656,6 +1420,14 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
         LOG_IF_FAILED(pEngine->ResetLineTransform());
     });
 
+    // No row has more clusters than the viewport has columns. Once the buffers
+    // are that large, steady frames don't allocate anything for the text.
+    const auto width = gsl::narrow_cast<size_t>(view.Width());
+    _clusterBuffer.reserve(width);
+    _rowCells.glyphs.reserve(width);
+    _rowCells.dbcsAttrs.reserve(width);
+    _rowCells.attrs.reserve(width);
+
     for (const auto& dirtyRect : dirtyAreas)
     {
         auto dirty = Viewport::FromInclusive(dirtyRect);
@@ -675,16 +1447,13 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             // Retrieve the text buffer so we can read information out of it.
             const auto& buffer = _pData->GetTextBuffer();
 
-            // Now walk through each row of text that we need to redraw.
-            for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
-            {
+            const auto paintRow = [&](const SHORT row, const LineRendition lineRendition) {
                 // Calculate the boundaries of a single line. This is from the left to right edge of the dirty
                 // area in width and exactly 1 tall.
                 const auto screenLine = SMALL_RECT{ redraw.Left(), row, redraw.RightInclusive(), row };
 
                 // Convert the screen coordinates of the line to an equivalent
                 // range of buffer cells, taking line rendition into account.
-                const auto lineRendition = buffer.GetLineRendition(row);
                 const auto bufferLine = Viewport::FromInclusive(ScreenToBufferLine(screenLine, lineRendition));
 
                 // Find where on the screen we should place this line information. This requires us to re-map
@@ -694,21 +1463,69 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
                 // of the backing buffer to fill in line 1 of the screen.
                 const auto screenPosition = bufferLine.Origin() - COORD{ 0, view.Top() };
 
-                // Retrieve the cell information iterator limited to just this line we want to redraw.
-                auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+                // Retrieve the row that holds the cells of the line we want to redraw.
+                const auto& bufferRow = buffer.GetRowByOffset(bufferLine.Origin().Y);
 
                 // Calculate if two things are true:
                 // 1. this row wrapped
                 // 2. We're painting the last col of the row.
                 // In that case, set lineWrapped=true for the _PaintBufferOutputHelper call.
-                const auto lineWrapped = (buffer.GetRowByOffset(bufferLine.Origin().Y).WasWrapForced()) &&
+                const auto lineWrapped = bufferRow.WasWrapForced() &&
                                          (bufferLine.RightExclusive() == buffer.GetSize().Width());
 
                 // Prepare the appropriate line transform for the current row and viewport offset.
                 LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.Y, view.Left()));
 
                 // Ask the helper to paint through this specific line.
-                _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+                _PaintBufferOutputHelper(pEngine, bufferRow, bufferLine.Left(), bufferLine.RightExclusive(), screenPosition, lineWrapped);
+
+                // Images are drawn over the text of their rows.
+                if (const auto imageSlice = bufferRow.GetImageSlice())
+                {
+                    LOG_IF_FAILED(pEngine->PaintImageSlice(*imageSlice, screenPosition.Y, view.Left()));
+                }
+            };
+
+            // Every change of the line transform makes the engine flush the text it has batched up,
+            // so rows are painted grouped by their rendition, instead of switching back and forth
+            // whenever single and double width rows are interleaved (e.g. in DEC banner apps or vttest).
+            // Rows don't overlap each other, so the order they're painted in doesn't change the frame.
+            // Single width rows go first, then all the double width rows, which share one transform.
+            // Double height rows still need a transform of their own, so they're painted last in order.
+            auto hasDoubleWidth = false;
+            auto hasDoubleHeight = false;
+            for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
+            {
+                const auto lineRendition = buffer.GetLineRendition(row);
+                switch (lineRendition)
+                {
+                case LineRendition::SingleWidth:
+                    paintRow(row, lineRendition);
+                    break;
+                case LineRendition::DoubleWidth:
+                    hasDoubleWidth = true;
+                    break;
+                default:
+                    hasDoubleHeight = true;
+                    break;
+                }
+            }
+
+            for (auto row = redraw.Top(); hasDoubleWidth && row < redraw.BottomExclusive(); row++)
+            {
+                if (buffer.GetLineRendition(row) == LineRendition::DoubleWidth)
+                {
+                    paintRow(row, LineRendition::DoubleWidth);
+                }
+            }
+
+            for (auto row = redraw.Top(); hasDoubleHeight && row < redraw.BottomExclusive(); row++)
+            {
+                const auto lineRendition = buffer.GetLineRendition(row);
+                if (lineRendition == LineRendition::DoubleHeightTop || lineRendition == LineRendition::DoubleHeightBottom)
+                {
+                    paintRow(row, lineRendition);
+                }
             }
         }
     }
@@ -721,31 +1538,54 @@ static bool _IsAllSpaces(const std::wstring_view v)
 }
 
 void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+                                        const ROW& row,
+                                        const size_t left,
+                                        const size_t right,
                                         const COORD target,
                                         const bool lineWrapped)
 {
     auto globalInvert{ _pData->IsScreenReversed() };
 
+    // Read the entire segment at once and loop over the plain arrays,
+    // instead of having an iterator build a view for every single cell.
+    row.ReadCells(left, right, _rowCells);
+    const auto& cells = _rowCells;
+
+    // The attributes are only stored as runs. This finds the run of a cell,
+    // starting from the one the last lookup ended up in.
+    size_t run = 0;
+    size_t runStart = 0;
+    const auto attrAt = [&](const size_t index) -> const TextAttribute& {
+        if (index < runStart)
+        {
+            run = 0;
+            runStart = 0;
+        }
+        while (index >= runStart + til::at(cells.attrs, run).length)
+        {
+            runStart += til::at(cells.attrs, run).length;
+            ++run;
+        }
+        return til::at(cells.attrs, run).attr;
+    };
+
     // If we have valid data, let's figure out how to draw it.
-    if (it)
+    if (cells.size() != 0)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
+        size_t index = 0;
         size_t cols = 0;
 
         // Retrieve the first color.
-        auto color = it->TextAttr();
+        auto color = attrAt(0);
         // Retrieve the first pattern id
-        auto patternIds = _pData->GetPatternId(target);
+        auto& patternIds = _runPatternIds;
+        _pData->GetPatternId(target, patternIds);
 
         // And hold the point where we should start drawing.
         auto screenPoint = target;
 
         // This outer loop will continue until we reach the end of the text we are trying to draw.
-        while (it)
+        while (index < cells.size())
         {
             // Hold onto the current run color right here for the length of the outer loop.
             // We'll be changing the persistent one as we run through the inner loops to detect
@@ -753,9 +1593,6 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // when we go to draw gridlines for the length of the run.
             const auto currentRunColor = color;
 
-            // Hold onto the current pattern id as well
-            const auto currentPatternId = patternIds;
-
             // Update the drawing brushes with our color.
             THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, false));
 
@@ -763,9 +1600,9 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             screenPoint.X += gsl::narrow<SHORT>(cols);
             cols = 0;
 
-            // Hold onto the start of this run iterator and the target location where we started
+            // Hold onto the start of this run and the target location where we started
             // in case we need to do some special work to paint the line drawing characters.
-            const auto currentRunItStart = it;
+            const auto currentRunStart = index;
             const auto currentRunTargetStart = screenPoint;
 
             // Ensure that our cluster vector is clear.
@@ -785,42 +1622,39 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             do
             {
                 COORD thisPoint{ screenPoint.X + gsl::narrow<SHORT>(cols), screenPoint.Y };
-                const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
-                if (color != it->TextAttr() || patternIds != thisPointPatterns)
+                auto& thisPointPatterns = _cellPatternIds;
+                _pData->GetPatternId(thisPoint, thisPointPatterns);
+                const auto& attr = attrAt(index);
+                const auto glyph = til::at(cells.glyphs, index);
+                if (color != attr || patternIds != thisPointPatterns)
                 {
-                    auto newAttr{ it->TextAttr() };
                     // foreground doesn't matter for runs of spaces (!)
                     // if we trick it . . . we call Paint far fewer times for cmatrix
-                    if (!_IsAllSpaces(it->Chars()) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || patternIds != thisPointPatterns)
+                    if (!_IsAllSpaces(glyph) || !attr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || patternIds != thisPointPatterns)
                     {
-                        color = newAttr;
-                        patternIds = thisPointPatterns;
+                        color = attr;
+                        patternIds.swap(thisPointPatterns);
                         break; // vend this run
                     }
                 }
 
                 // Walk through the text data and turn it into rendering clusters.
                 // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
-                size_t columnCount = 0;
+                const auto cellColumns = cells.ColumnsAt(index);
+                size_t columnCount = cellColumns;
 
                 // If we're on the first cluster to be added and it's marked as "trailing"
                 // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr().IsTrailing())
+                if (_clusterBuffer.empty() && til::at(cells.dbcsAttrs, index).IsTrailing())
                 {
                     // Move left to the one so the whole character can be struck correctly.
                     --screenPoint.X;
                     // And tell the next function to trim off the left half of it.
                     trimLeft = true;
                     // And add one to the number of columns we expect it to take as we insert it.
-                    columnCount = it->Columns() + 1;
-                    _clusterBuffer.emplace_back(it->Chars(), columnCount);
-                }
-                // Otherwise if it's not a special case, just insert it as is.
-                else
-                {
-                    columnCount = it->Columns();
-                    _clusterBuffer.emplace_back(it->Chars(), columnCount);
+                    columnCount = cellColumns + 1;
                 }
+                _clusterBuffer.emplace_back(glyph, columnCount);
 
                 if (columnCount > 1)
                 {
@@ -828,10 +1662,10 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 }
 
                 // Advance the cluster and column counts.
-                it += std::max<size_t>(it->Columns(), 1); // prevent infinite loop for no visible columns
+                index += cellColumns;
                 cols += columnCount;
 
-            } while (it);
+            } while (index < cells.size());
 
             // Do the painting.
             THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
@@ -845,21 +1679,17 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 // attribute that could have contained different line information than the left half.
                 if (containsWideCharacter)
                 {
-                    // Start from the original position in this run.
-                    auto lineIt = currentRunItStart;
                     // Start from the original target in this run.
                     auto lineTarget = currentRunTargetStart;
 
-                    // We need to go through the iterators again to ensure we get the lines associated with each
+                    // We need to go through the cells again to ensure we get the lines associated with each
                     // exact column. The code above will condense two-column characters into one, but it is possible
                     // (like with the IME) that the line drawing characters will vary from the left to right half
                     // of a wider character.
-                    // We could theoretically pre-pass for this in the loop above to be more efficient about walking
-                    // the iterator, but I fear it would make the code even more confusing than it already is.
-                    // Do that in the future if some WPR trace points you to this spot as super bad.
-                    for (auto colsPainted = 0u; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.X)
+                    for (size_t colsPainted = 0; colsPainted < cols; ++colsPainted, ++lineTarget.X)
                     {
-                        auto lines = lineIt->TextAttr();
+                        // A leading trailing half adds a column the segment doesn't have at its end.
+                        const auto lines = attrAt(std::min(currentRunStart + colsPainted, cells.size() - 1));
                         _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
                     }
                 }
@@ -954,7 +1784,8 @@ void Renderer::_PaintBufferOutputGridLineHelper(_In_ IRenderEngine* const pEngin
         if (_hoveredInterval->start <= coordTargetTil &&
             coordTargetTil <= _hoveredInterval->stop)
         {
-            if (_pData->GetPatternId(coordTarget).size() > 0)
+            _pData->GetPatternId(coordTarget, _cellPatternIds);
+            if (!_cellPatternIds.empty())
             {
                 lines |= IRenderEngine::GridLines::Underline;
             }
@@ -1113,9 +1944,9 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
                     const COORD target{ viewDirty.Left(), iRow };
                     const auto source = target - overlay.origin;
 
-                    auto it = overlay.buffer.GetCellLineDataAt(source);
+                    const auto& row = overlay.buffer.GetRowByOffset(source.Y);
 
-                    _PaintBufferOutputHelper(&engine, it, target, false);
+                    _PaintBufferOutputHelper(&engine, row, source.X, row.size(), target, false);
                 }
             }
         }
@@ -1155,27 +1986,60 @@ void Renderer::_PaintSelection(_In_ IRenderEngine* const pEngine)
 {
     try
     {
-        gsl::span<const til::rectangle> dirtyAreas;
-        LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
+        _PaintDirtyRects(pEngine, _GetSelectionRects(), &IRenderEngine::PaintSelection);
+    }
+    CATCH_LOG();
+}
 
-        // Get selection rectangles
-        const auto rectangles = _GetSelectionRects();
-        for (auto rect : rectangles)
+// Routine Description:
+// - Paint helper to draw the highlights of all the matches of the last search.
+//   They're an overlay like the selection, the buffer's attributes are
+//   left alone.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_PaintSearchHighlights(_In_ IRenderEngine* const pEngine)
+{
+    try
+    {
+        const auto rectangles = _ToScreenRects(_pData->GetSearchHighlightRects());
+        if (!rectangles.empty())
+        {
+            _PaintDirtyRects(pEngine, rectangles, &IRenderEngine::PaintSearchHighlight);
+        }
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Paints the parts of the given rectangles that are within the dirty area.
+// Arguments:
+// - rectangles - the exclusive rectangles to paint, relative to the viewport
+// - paint - the engine method that paints one of them
+// Return Value:
+// - <none>
+void Renderer::_PaintDirtyRects(_In_ IRenderEngine* const pEngine,
+                                const std::vector<SMALL_RECT>& rectangles,
+                                HRESULT (IRenderEngine::*paint)(const SMALL_RECT) noexcept)
+{
+    gsl::span<const til::rectangle> dirtyAreas;
+    LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
+
+    for (auto rect : rectangles)
+    {
+        for (auto& dirtyRect : dirtyAreas)
         {
-            for (auto& dirtyRect : dirtyAreas)
+            // Make a copy as `TrimToViewport` will manipulate it and
+            // can destroy it for the next dirtyRect to test against.
+            auto rectCopy = rect;
+            Viewport dirtyView = Viewport::FromInclusive(dirtyRect);
+            if (dirtyView.TrimToViewport(&rectCopy))
             {
-                // Make a copy as `TrimToViewport` will manipulate it and
-                // can destroy it for the next dirtyRect to test against.
-                auto rectCopy = rect;
-                Viewport dirtyView = Viewport::FromInclusive(dirtyRect);
-                if (dirtyView.TrimToViewport(&rectCopy))
-                {
-                    LOG_IF_FAILED(pEngine->PaintSelection(rectCopy));
-                }
+                LOG_IF_FAILED((pEngine->*paint)(rectCopy));
             }
         }
     }
-    CATCH_LOG();
 }
 
 // Routine Description:
@@ -1214,9 +2078,20 @@ void Renderer::_PaintSelection(_In_ IRenderEngine* const pEngine)
 // Return Value:
 // - A vector of rectangles representing the regions to select, line by line.
 std::vector<SMALL_RECT> Renderer::_GetSelectionRects() const
+{
+    return _ToScreenRects(_pData->GetSelectionRects());
+}
+
+// Routine Description:
+// - Converts line-by-line rectangles of the buffer into the exclusive
+//   rectangles of the screen cells they cover, relative to the viewport.
+// Arguments:
+// - rects - the inclusive rectangles, in buffer coordinates
+// Return Value:
+// - The rectangles, ready to be painted.
+std::vector<SMALL_RECT> Renderer::_ToScreenRects(const std::vector<Viewport>& rects) const
 {
     const auto& buffer = _pData->GetTextBuffer();
-    auto rects = _pData->GetSelectionRects();
     // Adjust rectangles to viewport
     Viewport view = _pData->GetViewport();
 
@@ -1295,6 +2170,226 @@ void Renderer::SetRendererEnteredErrorStateCallback(std::function<void()> pfn)
     _pfnRendererEnteredErrorState = std::move(pfn);
 }
 
+// Method Description:
+// - Registers a callback that will be called on the render thread before
+//   every frame. Hosts can use this to apply changes that are too expensive
+//   to make every time they're requested, like resizing the buffer, only for
+//   the latest request that's pending when the next frame is painted.
+// Arguments:
+// - pfn: the callback
+// Return Value:
+// - <none>
+void Renderer::SetFrameStartingCallback(std::function<void()> pfn)
+{
+    _pfnFrameStarting = std::move(pfn);
+}
+
+// Method Description:
+// - Lets the renderer know that the user just typed something. The render
+//   thread uses this to paint the answer to it (usually the echo) as soon as
+//   it arrives, and the time from the input to the presentation of the first
+//   frame that changed the buffer afterwards is traced as "InputLatency".
+// - Can be called from any thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::NotifyInput() noexcept
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    int64_t expected = 0;
+    // Only the oldest unanswered input counts, so that typing faster than
+    // the shell can echo doesn't make the latency look better than it is.
+    _inputTimestamp.compare_exchange_strong(expected, now, std::memory_order_relaxed);
+
+    if (_pThread)
+    {
+        _pThread->NotifyInput();
+    }
+}
+
+// Method Description:
+// - Registers a callback that will be called on the render thread whenever an
+//   engine presented a frame, with the frame's number (see GetFrameCount).
+//   This is meant for instrumentation, like measuring how long it takes for
+//   something that was written to the buffer to show up on screen.
+// Arguments:
+// - pfn: the callback
+// Return Value:
+// - <none>
+void Renderer::SetFramePresentedCallback(std::function<void(uint64_t)> pfn)
+{
+    _pfnFramePresented = std::move(pfn);
+}
+
+// Method Description:
+// - Returns the number of frames that started painting so far. Everything that
+//   was in the buffer when this is called will be part of the frames numbered
+//   higher than the result.
+// Arguments:
+// - <none>
+// Return Value:
+// - the number of the last frame that started painting
+uint64_t Renderer::GetFrameCount() const noexcept
+{
+    return _frameCount.load(std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Returns where the cursor was, relative to the top left of the viewport,
+//   when the last frame was painted. This can be called without holding the
+//   console lock, so it's cheap to poll for something that only has to
+//   follow the cursor on the screen, like the IME's composition window.
+// Arguments:
+// - <none>
+// Return Value:
+// - the position of the cursor in the last frame, in cells
+COORD Renderer::GetPaintedCursorPosition() const noexcept
+{
+    return _paintedCursorPosition.load(std::memory_order_relaxed);
+}
+
+// Routine Description:
+// - Remembers the position of the cursor for GetPaintedCursorPosition.
+//   Must be called with the console lock held, after the viewport was
+//   updated for the frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_RememberCursorPosition() noexcept
+{
+    auto position = _pData->GetCursorPosition();
+    position.X -= _viewport.Left();
+    position.Y -= _viewport.Top();
+    _paintedCursorPosition.store(position, std::memory_order_relaxed);
+}
+
+// Routine Description:
+// - Calls the frame presented callback, if there is one.
+// Arguments:
+// - frame - the number of the frame that was presented
+// Return Value:
+// - <none>
+void Renderer::_NotifyFramePresented(const uint64_t frame) noexcept
+{
+    if (_pfnFramePresented)
+    {
+        try
+        {
+            _pfnFramePresented(frame);
+        }
+        CATCH_LOG();
+    }
+}
+
+// Routine Description:
+// - Remembers that the buffer was written to while an input is pending,
+//   which makes the next frame the answer to that input.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_NoteInputEchoed() noexcept
+{
+    if (_inputTimestamp.load(std::memory_order_relaxed) != 0)
+    {
+        _inputEchoed.store(true, std::memory_order_relaxed);
+    }
+}
+
+// Routine Description:
+// - Traces the time between the pending input and now, if the frame that was
+//   just presented answered it.
+// Arguments:
+// - pEngine - the engine that presented the frame
+// Return Value:
+// - <none>
+void Renderer::_TraceInputLatency(const IRenderEngine* const pEngine) noexcept
+{
+    if (!_inputEchoed.exchange(false, std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const auto input = _inputTimestamp.exchange(0, std::memory_order_relaxed);
+    if (input != 0)
+    {
+        const std::chrono::steady_clock::time_point inputTime{ std::chrono::steady_clock::duration{ input } };
+        _frameTracing.TraceInputLatency(pEngine, std::chrono::steady_clock::now() - inputTime);
+    }
+}
+
+// Method Description:
+// - Registers a callback that will be called on the render thread after
+//   every frame, whether or not any of the engines had something to paint.
+//   Hosts can use this to hand out state that changes at a high rate at most
+//   once per frame, instead of every time it changes.
+// Arguments:
+// - pfn: the callback
+// Return Value:
+// - <none>
+void Renderer::SetFrameCompletedCallback(std::function<void()> pfn)
+{
+    _pfnFrameCompleted = std::move(pfn);
+}
+
+// Routine Description:
+// - Informs the engines whether the window is hidden from the user (for
+//   instance minimized or cloaked). Engines may skip painting while it is.
+//   Once the window is visible again, a frame is requested to catch up.
+// - Doesn't need the console lock, see DxEngine::SetWindowOccluded.
+// Arguments:
+// - occluded: true if nothing drawn would be visible
+// Return Value:
+// - <none>
+void Renderer::SetWindowOccluded(const bool occluded)
+{
+    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+        pEngine->SetWindowOccluded(occluded);
+    });
+
+    if (!occluded)
+    {
+        _NotifyPaintFrame();
+    }
+}
+
+// Routine Description:
+// - Asks the engines to release their device resources, like swap chains and
+//   the textures they hold on the GPU. They're recreated with the next frame
+//   that's actually painted, so this is meant for windows that are occluded.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::TrimDeviceResources()
+{
+    const auto engineLock = LockEngines();
+    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+        pEngine->TrimDeviceResources();
+    });
+}
+
+// Routine Description:
+// - Adds up the bytes all the engines hold on to, to draw their frames.
+// Arguments:
+// - <none>
+// Return Value:
+// - The bytes held by the swap chains and caches of all engines.
+RenderMemoryUsage Renderer::GetMemoryUsage()
+{
+    const auto engineLock = LockEngines();
+    RenderMemoryUsage usage;
+    for (const auto pEngine : _rgpEngines)
+    {
+        const auto engineUsage = pEngine->GetMemoryUsage();
+        usage.swapChain += engineUsage.swapChain;
+        usage.caches += engineUsage.caches;
+    }
+    return usage;
+}
+
 // Method Description:
 // - Attempts to restart the renderer.
 void Renderer::ResetErrorStateAndResume()
@@ -21,6 +21,8 @@ Author(s):
 #include "../inc/IRenderData.hpp"
 
 #include "thread.hpp"
+#include "SnapshotEngine.hpp"
+#include "FrameTracing.hpp"
 
 #include "../../buffer/out/textBuffer.hpp"
 #include "../../buffer/out/CharRow.hpp"
@@ -50,6 +52,7 @@ namespace Microsoft::Console::Render
         void TriggerSystemRedraw(const RECT* const prcDirtyClient) override;
         void TriggerRedraw(const Microsoft::Console::Types::Viewport& region) override;
         void TriggerRedraw(const COORD* const pcoord) override;
+        void TriggerRedrawContent(const Microsoft::Console::Types::Viewport& region) override;
         void TriggerRedrawCursor(const COORD* const pcoord) override;
         void TriggerRedrawAll() override;
         void TriggerTeardown() noexcept override;
@@ -57,10 +60,13 @@ namespace Microsoft::Console::Render
         void TriggerSelection() override;
         void TriggerScroll() override;
         void TriggerScroll(const COORD* const pcoordDelta) override;
+        void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const SHORT delta) override;
 
         void TriggerCircling() override;
         void TriggerTitleChange() override;
 
+        void SetSynchronizedOutput(const bool enabled) noexcept override;
+
         void TriggerFontChange(const int iDpi,
                                const FontInfoDesired& FontInfoDesired,
                                _Out_ FontInfo& FontInfo) override;
@@ -78,11 +84,48 @@ namespace Microsoft::Console::Render
         void AddRenderEngine(_In_ IRenderEngine* const pEngine) override;
 
         void SetRendererEnteredErrorStateCallback(std::function<void()> pfn);
+        void SetFrameStartingCallback(std::function<void()> pfn);
+        void SetFrameCompletedCallback(std::function<void()> pfn);
+        void NotifyInput() noexcept;
+        void SetFramePresentedCallback(std::function<void(uint64_t)> pfn);
+        uint64_t GetFrameCount() const noexcept;
+        COORD GetPaintedCursorPosition() const noexcept;
         void ResetErrorStateAndResume();
 
+        void SetWindowOccluded(const bool occluded);
+        void TrimDeviceResources();
+        RenderMemoryUsage GetMemoryUsage();
+
         void UpdateLastHoveredInterval(const std::optional<interval_tree::IntervalTree<til::point, size_t>::interval>& newInterval);
 
+        [[nodiscard]] std::unique_lock<std::recursive_mutex> LockEngines();
+
     private:
+        // An invalidation as it's handed to each engine. See _Invalidate.
+        struct Invalidation
+        {
+            enum class Kind
+            {
+                System,
+                Region,
+                Cursor,
+                Selection,
+                Scroll,
+                ScrollRegion,
+                All,
+                Circling,
+                Viewport,
+                Title
+            };
+
+            Kind kind;
+            RECT client{};
+            SMALL_RECT region{};
+            COORD delta{};
+            std::vector<SMALL_RECT> rectangles;
+            std::wstring title;
+        };
+
         std::deque<IRenderEngine*> _rgpEngines;
 
         IRenderData* _pData; // Non-ownership pointer
@@ -90,20 +133,80 @@ namespace Microsoft::Console::Render
         std::unique_ptr<IRenderThread> _pThread;
         bool _destructing = false;
 
+        // While the application synchronizes its output (DECSET 2026), frames
+        // are held back until this point in time, in steady_clock ticks. 0 if it doesn't.
+        std::atomic<std::chrono::steady_clock::rep> _synchronizedOutputDeadline{ 0 };
+        bool _IsHoldingSynchronizedOutput() noexcept;
+
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _hoveredInterval;
 
         void _NotifyPaintFrame();
 
         [[nodiscard]] HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
+        [[nodiscard]] HRESULT _PaintSnapshotFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
+        bool _TryPaintCursorFrame(_In_ IRenderEngine* const pEngine);
+
+        void _Invalidate(const Invalidation& invalidation);
+        static void s_ApplyInvalidation(IRenderEngine& engine, const Invalidation& invalidation) noexcept;
+        [[nodiscard]] std::unique_lock<std::recursive_mutex> _TryLockEngines();
+        void _FlushDeferredInvalidations() noexcept;
+
+        // Held while an engine that supports snapshot painting is painting a frame
+        // outside of the console lock. Invalidations meant for such an engine are
+        // queued in _deferredInvalidations (under the console lock) in the meantime.
+        std::recursive_mutex _engineMutex;
+        std::vector<std::pair<IRenderEngine*, Invalidation>> _deferredInvalidations;
+        SnapshotEngine _snapshot;
 
         bool _CheckViewportAndScroll();
 
+        FrameTracing _frameTracing;
+        void _NoteInputEchoed() noexcept;
+        void _TraceInputLatency(const IRenderEngine* const pEngine) noexcept;
+        void _NotifyFramePresented(const uint64_t frame) noexcept;
+
+        // When the oldest input that hasn't been answered by a frame yet was
+        // received (in steady_clock ticks, 0 if there is none) and whether
+        // the buffer has changed since. Both are touched without the console lock.
+        std::atomic<int64_t> _inputTimestamp{ 0 };
+        std::atomic<bool> _inputEchoed{ false };
+
+        // The number of frames that took the console lock so far. The n-th frame
+        // contains everything that was written to the buffer before its number
+        // was handed out.
+        std::atomic<uint64_t> _frameCount{ 0 };
+
+        // Where the cursor was relative to the viewport when the last frame
+        // took the console lock, for the hosts that need to know without it.
+        std::atomic<COORD> _paintedCursorPosition{ COORD{ 0, 0 } };
+        void _RememberCursorPosition() noexcept;
+        static size_t s_CountDirtyCells(IRenderEngine& engine);
+        static til::allocation_tracker::counts s_CountFrameAllocations() noexcept;
+
+        // What a row of the viewport held when an engine last finished a frame.
+        // The generation saves us from hashing rows that weren't touched since.
+        struct PaintedRow
+        {
+            uint64_t generation = 0;
+            size_t hash = 0;
+        };
+
+        // The rows each engine shows right now, by their offset from the top of the viewport.
+        std::unordered_map<const IRenderEngine*, std::vector<PaintedRow>> _paintedRows;
+
+        bool _IsRowPainted(const TextBuffer& buffer, const SHORT row) const;
+        void _RememberPaintedRows(const IRenderEngine* const pEngine) noexcept;
+        void _ScrollPaintedRows(const COORD delta) noexcept;
+        void _ScrollPaintedRowsInRegion(const SHORT top, const SHORT bottom, const SHORT delta) noexcept;
+
         [[nodiscard]] HRESULT _PaintBackground(_In_ IRenderEngine* const pEngine);
 
         void _PaintBufferOutput(_In_ IRenderEngine* const pEngine);
 
         void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                      TextBufferCellIterator it,
+                                      const ROW& row,
+                                      const size_t left,
+                                      const size_t right,
                                       const COORD target,
                                       const bool lineWrapped);
 
@@ -114,7 +217,11 @@ namespace Microsoft::Console::Render
                                               const size_t cchLine,
                                               const COORD coordTarget);
 
+        void _PaintSearchHighlights(_In_ IRenderEngine* const pEngine);
         void _PaintSelection(_In_ IRenderEngine* const pEngine);
+        void _PaintDirtyRects(_In_ IRenderEngine* const pEngine,
+                              const std::vector<SMALL_RECT>& rectangles,
+                              HRESULT (IRenderEngine::*paint)(const SMALL_RECT) noexcept);
         void _PaintCursor(_In_ IRenderEngine* const pEngine);
 
         void _PaintOverlays(_In_ IRenderEngine* const pEngine);
@@ -128,8 +235,15 @@ namespace Microsoft::Console::Render
 
         static constexpr float _shrinkThreshold = 0.8f;
         std::vector<Cluster> _clusterBuffer;
+        RowCells _rowCells;
+        std::vector<size_t> _runPatternIds;
+        std::vector<size_t> _cellPatternIds;
 
         std::vector<SMALL_RECT> _GetSelectionRects() const;
+        std::vector<SMALL_RECT> _ToScreenRects(const std::vector<Microsoft::Console::Types::Viewport>& rects) const;
+        static std::vector<SMALL_RECT> s_GetSelectionChanges(const std::vector<SMALL_RECT>& previous,
+                                                             const std::vector<SMALL_RECT>& current,
+                                                             const til::rectangle viewport);
         void _ScrollPreviousSelection(const til::point delta);
         std::vector<SMALL_RECT> _previousSelection;
 
@@ -143,6 +257,9 @@ namespace Microsoft::Console::Render
         bool _fDebug = false;
 
         std::function<void()> _pfnRendererEnteredErrorState;
+        std::function<void()> _pfnFrameStarting;
+        std::function<void()> _pfnFrameCompleted;
+        std::function<void(uint64_t)> _pfnFramePresented;
 
 #ifdef UNIT_TESTING
         friend class ConptyOutputTests;
@@ -5,6 +5,8 @@
 
 #include "thread.hpp"
 
+#include <avrt.h>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console::Render;
@@ -17,7 +19,11 @@ RenderThread::RenderThread() :
     _fKeepRunning(true),
     _hPaintEnabledEvent(nullptr),
     _fNextFrameRequested(false),
-    _fWaiting(false)
+    _fWaiting(false),
+    _pacing(RenderPacing::Fixed),
+    _lowLatencyInput(false),
+    _priorityBoost(false),
+    _lastInput(0)
 {
 }
 
@@ -159,10 +165,14 @@ DWORD WINAPI RenderThread::s_ThreadProc(_In_ LPVOID lpParameter)
 
 DWORD WINAPI RenderThread::_ThreadProc()
 {
+    const auto mmcssTask = _BeginPriorityBoost();
+
     while (_fKeepRunning)
     {
         WaitForSingleObject(_hPaintEnabledEvent, INFINITE);
 
+        const auto pacing = _pacing.load(std::memory_order_relaxed);
+
         if (!_fNextFrameRequested.exchange(false, std::memory_order_acq_rel))
         {
             // <--
@@ -203,17 +213,52 @@ DWORD WINAPI RenderThread::_ThreadProc()
         ResetEvent(_hPaintCompletedEvent);
 
         _pRenderer->WaitUntilCanRender();
-        LOG_IF_FAILED(_pRenderer->PaintFrame());
+
+        if (pacing == RenderPacing::Display)
+        {
+            // Everything that was invalidated while we waited for the display
+            // will be picked up by this frame. Only requests made from here on
+            // out need another one.
+            _fNextFrameRequested.store(false, std::memory_order_release);
+        }
+
+        // Without MMCSS the priority is only raised while painting, so that
+        // the thread can't starve anything while it spins for other reasons.
+        const auto raisePriority = !mmcssTask && _priorityBoost.load(std::memory_order_relaxed);
+        if (raisePriority)
+        {
+            SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+        }
+
+        const auto hr = _pRenderer->PaintFrame();
+        LOG_IF_FAILED(hr);
+
+        if (raisePriority)
+        {
+            SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
+        }
 
         SetEvent(_hPaintCompletedEvent);
 
         // extra check before we sleep since it's a "long" activity, relatively speaking.
-        if (_fKeepRunning)
+        // Right after an input the answer to it is painted the moment it's
+        // written, instead of waiting out the frame limit first.
+        if (_fKeepRunning && !_IsAnsweringInput())
         {
-            Sleep(s_FrameLimitMilliseconds);
+            if (pacing == RenderPacing::Fixed)
+            {
+                Sleep(s_FrameLimitMilliseconds);
+            }
+            else if (hr == S_FALSE)
+            {
+                // We woke up, but nothing was invalidated. Whatever keeps requesting
+                // frames doesn't need them at the rate of the display.
+                Sleep(s_IdleFrameLimitMilliseconds);
+            }
         }
     }
 
+    _EndPriorityBoost(mmcssTask);
     return S_OK;
 }
 
@@ -229,6 +274,134 @@ void RenderThread::NotifyPaint()
     }
 }
 
+// Method Description:
+// - Changes how frames are scheduled, see RenderPacing. Takes effect with the next frame.
+// Arguments:
+// - pacing: the new pacing mode
+// Return Value:
+// - <none>
+void RenderThread::SetPacing(const RenderPacing pacing) noexcept
+{
+    _pacing.store(pacing, std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Enables or disables the low latency input mode. While it's enabled the
+//   thread doesn't sleep between frames for a short while after an input,
+//   so that the echo of a keystroke shows up as soon as it's written.
+// Arguments:
+// - enabled: whether to paint the frames after an input without delay
+// Return Value:
+// - <none>
+void RenderThread::SetLowLatencyInput(const bool enabled) noexcept
+{
+    _lowLatencyInput.store(enabled, std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Enables or disables the priority boost. While it's enabled the thread
+//   registers itself with the Multimedia Class Scheduler Service, which
+//   schedules it ahead of the CPU hungry programs that run next to it, so
+//   that the frames don't stutter while the machine is busy. This must be
+//   called before Initialize, since the thread registers when it starts.
+// Arguments:
+// - enabled: whether to boost the priority of the thread
+// Return Value:
+// - <none>
+void RenderThread::SetPriorityBoost(const bool enabled) noexcept
+{
+    _priorityBoost.store(enabled, std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Remembers when the user last typed something, see SetLowLatencyInput.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderThread::NotifyInput()
+{
+    _lastInput.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+// Routine Description:
+// - Returns true if the low latency input mode is enabled and the last input
+//   is recent enough that the frames painted now are likely answering it.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the frames shouldn't be delayed
+bool RenderThread::_IsAnsweringInput() const noexcept
+{
+    if (!_lowLatencyInput.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    const std::chrono::steady_clock::time_point lastInput{ std::chrono::steady_clock::duration{ _lastInput.load(std::memory_order_relaxed) } };
+    return std::chrono::steady_clock::now() - lastInput < s_LowLatencyInputWindow;
+}
+
+// Routine Description:
+// - Registers the calling thread with MMCSS as a playback thread, if the
+//   priority boost is enabled. avrt.dll is loaded on demand, so that the
+//   processes that don't use this don't need to load it.
+// Arguments:
+// - <none>
+// Return Value:
+// - The MMCSS task handle, or nullptr if the boost is disabled or the
+//   registration failed. The frames are painted at a raised priority then.
+HANDLE RenderThread::_BeginPriorityBoost() noexcept
+{
+    if (!_priorityBoost.load(std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+
+    // The module is left loaded for as long as the process lives,
+    // since the task handle has to be reverted with it later on.
+    const auto avrt = LoadLibraryExW(L"avrt.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
+    if (!avrt)
+    {
+        LOG_LAST_ERROR();
+        return nullptr;
+    }
+
+    const auto setCharacteristics = GetProcAddressByFunctionDeclaration(avrt, AvSetMmThreadCharacteristicsW);
+    if (!setCharacteristics)
+    {
+        LOG_LAST_ERROR();
+        return nullptr;
+    }
+
+    DWORD taskIndex = 0;
+    const auto task = setCharacteristics(L"Playback", &taskIndex);
+    LOG_LAST_ERROR_IF_NULL(task);
+    return task;
+}
+
+// Routine Description:
+// - Reverts the MMCSS registration of _BeginPriorityBoost, if there is one.
+// Arguments:
+// - mmcssTask: the task handle _BeginPriorityBoost returned
+// Return Value:
+// - <none>
+void RenderThread::_EndPriorityBoost(const HANDLE mmcssTask) noexcept
+{
+    if (!mmcssTask)
+    {
+        return;
+    }
+
+    if (const auto avrt = GetModuleHandleW(L"avrt.dll"))
+    {
+        if (const auto revertCharacteristics = GetProcAddressByFunctionDeclaration(avrt, AvRevertMmThreadCharacteristics))
+        {
+            LOG_IF_WIN32_BOOL_FALSE(revertCharacteristics(mmcssTask));
+        }
+    }
+}
+
 void RenderThread::EnablePainting()
 {
     SetEvent(_hPaintEnabledEvent);
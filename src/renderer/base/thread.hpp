@@ -19,6 +19,17 @@ Author(s):
 
 namespace Microsoft::Console::Render
 {
+    // How the render thread schedules its frames.
+    enum class RenderPacing
+    {
+        // Paint as soon as a frame is requested and sleep for a fixed interval in between frames.
+        Fixed,
+        // Wait until the engines can present without blocking (for swap chains that's
+        // aligned to the display refresh) and collect all requests that arrived in the
+        // meantime into a single frame. Engines that can't wait should use Fixed instead.
+        Display,
+    };
+
     class RenderThread final : public IRenderThread
     {
     public:
@@ -28,16 +39,27 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Initialize(_In_ IRenderer* const pRendererParent) noexcept;
 
         void NotifyPaint() override;
+        void NotifyInput() override;
 
         void EnablePainting() override;
         void DisablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
 
+        void SetPacing(const RenderPacing pacing) noexcept;
+        void SetLowLatencyInput(const bool enabled) noexcept;
+        void SetPriorityBoost(const bool enabled) noexcept;
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
         static DWORD const s_FrameLimitMilliseconds = 8;
+        static DWORD const s_IdleFrameLimitMilliseconds = 33;
+        static constexpr std::chrono::milliseconds s_LowLatencyInputWindow{ 100 };
+
+        bool _IsAnsweringInput() const noexcept;
+        HANDLE _BeginPriorityBoost() noexcept;
+        void _EndPriorityBoost(const HANDLE mmcssTask) noexcept;
 
         HANDLE _hThread;
         HANDLE _hEvent;
@@ -50,5 +72,9 @@ namespace Microsoft::Console::Render
         bool _fKeepRunning;
         std::atomic<bool> _fNextFrameRequested;
         std::atomic<bool> _fWaiting;
+        std::atomic<RenderPacing> _pacing;
+        std::atomic<bool> _lowLatencyInput;
+        std::atomic<bool> _priorityBoost;
+        std::atomic<int64_t> _lastInput;
     };
 }
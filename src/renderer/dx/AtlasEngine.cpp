@@ -0,0 +1,1617 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "AtlasEngine.hpp"
+#include "CustomTextRenderer.h"
+
+#include "../../interactivity/win32/CustomWindowMessages.h"
+#include "../../types/inc/Viewport.hpp"
+#include "../../inc/DefaultSettings.h"
+#include "../../inc/unicode.hpp"
+#include <VersionHelpers.h>
+
+#include "AtlasShaders.h"
+#include <d3dcompiler.h>
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+
+// Routine Description:
+// - Compiles one of the shaders in AtlasShaders.h
+// Arguments:
+// - source - Shader source
+// - target - What kind of shader this is
+// Return Value:
+// - Compiled binary. Errors are thrown and logged.
+static Microsoft::WRL::ComPtr<ID3DBlob> s_CompileShader(const std::string_view source, const char* const target)
+{
+#if !TIL_FEATURE_DXENGINESHADERSUPPORT_ENABLED
+    UNREFERENCED_PARAMETER(source);
+    UNREFERENCED_PARAMETER(target);
+    THROW_HR(E_UNEXPECTED);
+#else
+    Microsoft::WRL::ComPtr<ID3DBlob> code{};
+    Microsoft::WRL::ComPtr<ID3DBlob> error{};
+
+    const HRESULT hr = D3DCompile(source.data(), source.size(), nullptr, nullptr, nullptr, "main", target, 0, 0, &code, &error);
+    if (FAILED(hr))
+    {
+        if (error)
+        {
+            LOG_HR_MSG(hr, "D3DCompile error\n%.*S", static_cast<int>(error->GetBufferSize()), static_cast<PCSTR>(error->GetBufferPointer()));
+        }
+        THROW_HR(hr);
+    }
+
+    return code;
+#endif
+}
+
+// Routine Description:
+// - Splits a COLORREF into normalized RGBA components for a constant buffer.
+// Arguments:
+// - color - GDI color
+// - alpha - The alpha component to use
+// - out - Filled with the components
+// Return Value:
+// - <none>
+static void s_ColorToFloat4(const COLORREF color, const float alpha, float (&out)[4]) noexcept
+{
+    out[0] = GetRValue(color) / 255.0f;
+    out[1] = GetGValue(color) / 255.0f;
+    out[2] = GetBValue(color) / 255.0f;
+    out[3] = alpha;
+}
+
+// Routine Description:
+// - Constructs the glyph atlas rendering engine
+#pragma warning(suppress : 26455)
+// TODO GH 2683: The default constructor should not throw.
+AtlasEngine::AtlasEngine() :
+    RenderEngineBase(),
+    _chainMode{ SwapChainMode::ForComposition },
+    _hwndTarget{ static_cast<HWND>(INVALID_HANDLE_VALUE) },
+    _sizeTarget{},
+    _dpi{ USER_DEFAULT_SCREEN_DPI },
+    _scale{ 1.0f },
+    _prevScale{ 1.0f },
+    _isEnabled{ false },
+    _isPainting{ false },
+    _presentReady{ false },
+    _redrawRequested{ false },
+    _displaySizePixels{},
+    _defaultForegroundColor{ DEFAULT_FOREGROUND },
+    _defaultBackgroundColor{ DEFAULT_BACKGROUND },
+    _foregroundColor{ DEFAULT_FOREGROUND },
+    _backgroundColor{ DEFAULT_BACKGROUND },
+    _selectionColor{ DEFAULT_FOREGROUND },
+    _selectionAlpha{ 0.5f },
+    _useItalicFont{ false },
+    _hyperlinkHoveredId{ 0 },
+    _isHoveredHyperlink{ false },
+    _gridSize{},
+    _pool{ til::pmr::get_default_resource() },
+    _invalidMap{ &_pool },
+    _allInvalid{ false },
+    _atlasPosition{ 1, 0 },
+    _atlasDrawing{ false },
+    _atlasNeedsClear{ true },
+    _atlasOverflowed{ false },
+    _atlasFlushedLastFrame{ false },
+    _recreateDeviceRequested{ false },
+    _haveDeviceResources{ false },
+    _swapChainDesc{ 0 },
+    _instanceBufferCapacity{ 0 },
+    _softwareRendering{ false },
+    _antialiasingMode{ D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE }
+{
+    THROW_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, IID_PPV_ARGS(&_d2dFactory)));
+
+    THROW_IF_FAILED(DWriteCreateFactory(
+        DWRITE_FACTORY_TYPE_SHARED,
+        __uuidof(_dwriteFactory),
+        reinterpret_cast<IUnknown**>(_dwriteFactory.GetAddressOf())));
+
+    _fontRenderData = std::make_unique<DxFontRenderData>(_dwriteFactory);
+}
+
+// Routine Description:
+// - Destroys an instance of the glyph atlas rendering engine
+AtlasEngine::~AtlasEngine()
+{
+    _ReleaseDeviceResources();
+}
+
+// Routine Description:
+// - Sets this engine to enabled allowing painting and presentation to occur
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or E_NOT_VALID_STATE if the engine is already enabled
+[[nodiscard]] HRESULT AtlasEngine::Enable() noexcept
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, _isEnabled);
+    _isEnabled = true;
+    return S_OK;
+}
+
+// Routine Description:
+// - Sets this engine to disabled to prevent painting and presentation from occurring
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or E_NOT_VALID_STATE if the engine is already disabled
+[[nodiscard]] HRESULT AtlasEngine::Disable() noexcept
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, !_isEnabled);
+    _isEnabled = false;
+    _ReleaseDeviceResources();
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT AtlasEngine::SetHwnd(const HWND hwnd) noexcept
+{
+    _hwndTarget = hwnd;
+    _chainMode = SwapChainMode::ForHwnd;
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT AtlasEngine::SetWindowSize(const SIZE pixels) noexcept
+{
+    // The grid and the swap chain are resized in StartPaint.
+    _sizeTarget = pixels;
+    return S_OK;
+}
+
+void AtlasEngine::SetCallback(std::function<void()> pfn)
+{
+    _pfn = pfn;
+}
+
+void AtlasEngine::SetWarningCallback(std::function<void(const HRESULT)> pfn)
+{
+    _pfnWarningCallback = pfn;
+}
+
+void AtlasEngine::SetSoftwareRendering(bool enable) noexcept
+try
+{
+    if (_softwareRendering != enable)
+    {
+        _softwareRendering = enable;
+        _recreateDeviceRequested = true;
+        LOG_IF_FAILED(InvalidateAll());
+    }
+}
+CATCH_LOG()
+
+HANDLE AtlasEngine::GetSwapChainHandle()
+{
+    if (!_swapChainHandle)
+    {
+        THROW_IF_FAILED(_CreateDeviceResources());
+    }
+
+    return _swapChainHandle.get();
+}
+
+// Routine Description:
+// - Creates the handle of the composition surface our swap chain is bound to
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or a relevant error from DirectComposition
+[[nodiscard]] HRESULT AtlasEngine::_CreateSurfaceHandle() noexcept
+{
+    wil::unique_hmodule hDComp{ LoadLibraryEx(L"Dcomp.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32) };
+    RETURN_LAST_ERROR_IF(hDComp.get() == nullptr);
+
+    auto fn = GetProcAddressByFunctionDeclaration(hDComp.get(), DCompositionCreateSurfaceHandle);
+    RETURN_LAST_ERROR_IF(fn == nullptr);
+
+    return fn(GENERIC_ALL, nullptr, &_swapChainHandle);
+}
+
+// Routine Description;
+// - Creates the device, the swap chain, the shaders and the glyph atlas.
+// - Will free device resources that already existed as first operation.
+// Arguments:
+// - <none>
+// Return Value:
+// - Could be any DirectX/D3D/D2D/DXGI/DWrite error or memory issue.
+[[nodiscard]] HRESULT AtlasEngine::_CreateDeviceResources() noexcept
+try
+{
+    if (_haveDeviceResources)
+    {
+        _ReleaseDeviceResources();
+    }
+
+    auto freeOnFail = wil::scope_exit([&]() noexcept { _ReleaseDeviceResources(); });
+
+    RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
+
+    const DWORD DeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT | D3D11_CREATE_DEVICE_SINGLETHREADED;
+
+    // Instancing and SV_InstanceID require at least feature level 10.0.
+    const std::array<D3D_FEATURE_LEVEL, 3> FeatureLevels{ D3D_FEATURE_LEVEL_11_1,
+                                                          D3D_FEATURE_LEVEL_11_0,
+                                                          D3D_FEATURE_LEVEL_10_0 };
+
+    HRESULT hardwareResult = E_NOT_SET;
+    if (!_softwareRendering)
+    {
+        hardwareResult = D3D11CreateDevice(nullptr,
+                                           D3D_DRIVER_TYPE_HARDWARE,
+                                           nullptr,
+                                           DeviceFlags,
+                                           FeatureLevels.data(),
+                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
+                                           D3D11_SDK_VERSION,
+                                           &_d3dDevice,
+                                           nullptr,
+                                           &_d3dDeviceContext);
+    }
+
+    if (FAILED(hardwareResult))
+    {
+        RETURN_IF_FAILED(D3D11CreateDevice(nullptr,
+                                           D3D_DRIVER_TYPE_WARP,
+                                           nullptr,
+                                           DeviceFlags,
+                                           FeatureLevels.data(),
+                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
+                                           D3D11_SDK_VERSION,
+                                           &_d3dDevice,
+                                           nullptr,
+                                           &_d3dDeviceContext));
+    }
+
+    _displaySizePixels = _GetClientSize();
+
+    RETURN_IF_FAILED(_d3dDevice.As(&_dxgiDevice));
+    RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
+    RETURN_IF_FAILED(_d2dDevice->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, &_d2dDeviceContext));
+
+    _swapChainDesc = { 0 };
+
+    // requires DXGI 1.3 which was introduced in Windows 8.1
+    WI_SetFlagIf(_swapChainDesc.Flags, DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT, IsWindows8Point1OrGreater());
+
+    _swapChainDesc.Width = _displaySizePixels.width<UINT>();
+    _swapChainDesc.Height = _displaySizePixels.height<UINT>();
+    _swapChainDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    _swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+    _swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+    _swapChainDesc.BufferCount = 2;
+    _swapChainDesc.SampleDesc.Count = 1;
+    // It's 100% required to use scaling mode stretch for composition. There is no other choice.
+    _swapChainDesc.Scaling = DXGI_SCALING_STRETCH;
+
+    switch (_chainMode)
+    {
+    case SwapChainMode::ForHwnd:
+    {
+        // We can't do alpha for HWNDs. Set to ignore. It will fail otherwise.
+        _swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+        RETURN_IF_FAILED(_dxgiFactory2->CreateSwapChainForHwnd(_d3dDevice.Get(),
+                                                               _hwndTarget,
+                                                               &_swapChainDesc,
+                                                               nullptr,
+                                                               nullptr,
+                                                               &_dxgiSwapChain));
+        break;
+    }
+    case SwapChainMode::ForComposition:
+    {
+        if (!_swapChainHandle)
+        {
+            RETURN_IF_FAILED(_CreateSurfaceHandle());
+        }
+
+        RETURN_IF_FAILED(_dxgiFactory2.As(&_dxgiFactoryMedia));
+
+        // The pixel shader outputs premultiplied colors.
+        _swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_PREMULTIPLIED;
+        RETURN_IF_FAILED(_dxgiFactoryMedia->CreateSwapChainForCompositionSurfaceHandle(_d3dDevice.Get(),
+                                                                                       _swapChainHandle.get(),
+                                                                                       &_swapChainDesc,
+                                                                                       nullptr,
+                                                                                       &_dxgiSwapChain));
+        break;
+    }
+    default:
+        THROW_HR(E_NOTIMPL);
+    }
+
+    if (IsWindows8Point1OrGreater())
+    {
+        ::Microsoft::WRL::ComPtr<IDXGISwapChain2> swapChain2;
+        const HRESULT asResult = _dxgiSwapChain.As(&swapChain2);
+        if (SUCCEEDED(asResult))
+        {
+            _swapChainFrameLatencyWaitableObject = wil::unique_handle{ swapChain2->GetFrameLatencyWaitableObject() };
+        }
+        else
+        {
+            LOG_HR_MSG(asResult, "Failed to obtain IDXGISwapChain2 from swap chain");
+        }
+    }
+
+    RETURN_IF_FAILED(_CreateShaders());
+    RETURN_IF_FAILED(_CreateAtlas());
+    RETURN_IF_FAILED(_PrepareRenderTarget());
+
+    // With a new swap chain, mark the entire thing as invalid.
+    RETURN_IF_FAILED(InvalidateAll());
+
+    _haveDeviceResources = true;
+    freeOnFail.release(); // don't need to release if we made it to the bottom and everything was good.
+
+    // Notify that swap chain changed.
+    if (_pfn)
+    {
+        try
+        {
+            _pfn();
+        }
+        CATCH_LOG(); // A failure in the notification function isn't a failure to prepare, so just log it and go on.
+    }
+
+    _recreateDeviceRequested = false;
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Compiles the shaders and creates the pipeline state that goes with them.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or a relevant D3D error.
+[[nodiscard]] HRESULT AtlasEngine::_CreateShaders() noexcept
+try
+{
+    const auto vertexBlob = s_CompileShader(atlasVertexShaderString, "vs_4_0");
+    const auto pixelBlob = s_CompileShader(atlasPixelShaderString, "ps_4_0");
+
+    RETURN_IF_FAILED(_d3dDevice->CreateVertexShader(vertexBlob->GetBufferPointer(), vertexBlob->GetBufferSize(), nullptr, &_vertexShader));
+    RETURN_IF_FAILED(_d3dDevice->CreatePixelShader(pixelBlob->GetBufferPointer(), pixelBlob->GetBufferSize(), nullptr, &_pixelShader));
+
+    // There's no vertex buffer. The corners of each quad are derived from
+    // SV_VertexID and the cells are fed in as per-instance data.
+    static constexpr std::array<D3D11_INPUT_ELEMENT_DESC, 4> layout{ {
+        { "TILE", 0, DXGI_FORMAT_R16G16_UINT, 0, offsetof(CellInstance, tileX), D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "FOREGROUND", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof(CellInstance, foreground), D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "BACKGROUND", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof(CellInstance, background), D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "FLAGS", 0, DXGI_FORMAT_R32_UINT, 0, offsetof(CellInstance, flags), D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    } };
+    RETURN_IF_FAILED(_d3dDevice->CreateInputLayout(layout.data(),
+                                                   gsl::narrow_cast<UINT>(layout.size()),
+                                                   vertexBlob->GetBufferPointer(),
+                                                   vertexBlob->GetBufferSize(),
+                                                   &_inputLayout));
+
+    D3D11_RASTERIZER_DESC rasterizerDesc{};
+    rasterizerDesc.FillMode = D3D11_FILL_SOLID;
+    rasterizerDesc.CullMode = D3D11_CULL_NONE;
+    rasterizerDesc.DepthClipEnable = TRUE;
+    RETURN_IF_FAILED(_d3dDevice->CreateRasterizerState(&rasterizerDesc, &_rasterizerState));
+
+    D3D11_BUFFER_DESC constantBufferDesc{};
+    constantBufferDesc.ByteWidth = sizeof(ConstBuffer);
+    constantBufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    RETURN_IF_FAILED(_d3dDevice->CreateBuffer(&constantBufferDesc, nullptr, &_constantBuffer));
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Creates the glyph atlas texture and binds it to our D2D device context,
+//   which is used to rasterize glyphs into it.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or a relevant D3D/D2D error.
+[[nodiscard]] HRESULT AtlasEngine::_CreateAtlas() noexcept
+try
+{
+    D3D11_TEXTURE2D_DESC textureDesc{};
+    textureDesc.Width = AtlasSize;
+    textureDesc.Height = AtlasSize;
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&textureDesc, nullptr, &_atlasTexture));
+    RETURN_IF_FAILED(_d3dDevice->CreateShaderResourceView(_atlasTexture.Get(), nullptr, &_atlasView));
+
+    ::Microsoft::WRL::ComPtr<IDXGISurface> surface;
+    RETURN_IF_FAILED(_atlasTexture.As(&surface));
+
+    const auto bitmapProperties = D2D1::BitmapProperties1(
+        D2D1_BITMAP_OPTIONS_TARGET | D2D1_BITMAP_OPTIONS_CANNOT_DRAW,
+        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+    RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmapFromDxgiSurface(surface.Get(), bitmapProperties, &_atlasBitmap));
+    _d2dDeviceContext->SetTarget(_atlasBitmap.Get());
+    _d2dDeviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+    RETURN_IF_FAILED(_d2dDeviceContext->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &_d2dBrushWhite));
+
+    // A new texture starts out without any glyphs in it.
+    _FlushAtlas();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Creates the render target view for the back buffer of the swap chain.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or a relevant D3D/DXGI error.
+[[nodiscard]] HRESULT AtlasEngine::_PrepareRenderTarget() noexcept
+try
+{
+    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer;
+    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer)));
+    RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(backBuffer.Get(), nullptr, &_renderTargetView));
+
+    // If in composition mode, apply scaling factor matrix
+    if (_chainMode == SwapChainMode::ForComposition)
+    {
+        DXGI_MATRIX_3X2_F inverseScale = { 0 };
+        inverseScale._11 = 1.0f / _scale;
+        inverseScale._22 = inverseScale._11;
+
+        ::Microsoft::WRL::ComPtr<IDXGISwapChain2> sc2;
+        RETURN_IF_FAILED(_dxgiSwapChain.As(&sc2));
+        RETURN_IF_FAILED(sc2->SetMatrixTransform(&inverseScale));
+    }
+
+    _prevScale = _scale;
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Releases device-specific resources (typically held on the GPU)
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void AtlasEngine::_ReleaseDeviceResources() noexcept
+{
+    try
+    {
+        _haveDeviceResources = false;
+
+        if (_d2dDeviceContext && _atlasDrawing)
+        {
+            LOG_IF_FAILED(_d2dDeviceContext->EndDraw());
+        }
+        _atlasDrawing = false;
+
+        _d2dBrushWhite.Reset();
+        _atlasBitmap.Reset();
+        _atlasView.Reset();
+        _atlasTexture.Reset();
+
+        _instanceBuffer.Reset();
+        _instanceBufferCapacity = 0;
+        _constantBuffer.Reset();
+        _rasterizerState.Reset();
+        _inputLayout.Reset();
+        _pixelShader.Reset();
+        _vertexShader.Reset();
+        _renderTargetView.Reset();
+
+        _d2dDeviceContext.Reset();
+
+        _dxgiSwapChain.Reset();
+        _swapChainFrameLatencyWaitableObject.reset();
+
+        _d2dDevice.Reset();
+        _dxgiDevice.Reset();
+
+        if (_d3dDeviceContext)
+        {
+            // To ensure the swap chain goes away we must unbind any views from the
+            // D3D pipeline
+            _d3dDeviceContext->ClearState();
+        }
+        _d3dDeviceContext.Reset();
+        _d3dDevice.Reset();
+
+        _dxgiFactoryMedia.Reset();
+        _dxgiFactory2.Reset();
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Gets the area in pixels of the surface we are targeting
+// Arguments:
+// - <none>
+// Return Value:
+// - X by Y area in pixels of the surface
+[[nodiscard]] til::size AtlasEngine::_GetClientSize() const
+{
+    switch (_chainMode)
+    {
+    case SwapChainMode::ForHwnd:
+    {
+        RECT clientRect = { 0 };
+        LOG_IF_WIN32_BOOL_FALSE(GetClientRect(_hwndTarget, &clientRect));
+
+        return til::rectangle{ clientRect }.size();
+    }
+    case SwapChainMode::ForComposition:
+    {
+        return _sizeTarget;
+    }
+    default:
+        FAIL_FAST_HR(E_NOTIMPL);
+    }
+}
+
+// Routine Description:
+// - Resizes the cell grid to cover the given client area. Partially visible
+//   cells at the right and bottom edges are part of the grid, so that the
+//   single draw call covers every pixel of the swap chain.
+// Arguments:
+// - clientSize - The size of the swap chain in pixels
+// Return Value:
+// - <none>
+void AtlasEngine::_ResizeGrid(const til::size clientSize)
+{
+    const auto cell = _fontRenderData->GlyphCell();
+    const til::size gridSize{ (clientSize.width() + cell.width() - 1) / cell.width(),
+                              (clientSize.height() + cell.height() - 1) / cell.height() };
+
+    if (gridSize != _gridSize)
+    {
+        _gridSize = gridSize;
+        _cells.assign(gridSize.area<size_t>(),
+                      CellInstance{ 0, 0, _defaultForegroundColor, _defaultBackgroundColor, 1 });
+        _invalidMap.resize(gridSize, true);
+        LOG_IF_FAILED(InvalidateAll());
+    }
+}
+
+// Routine Description:
+// - Gets the cell at the given position in the grid
+// Arguments:
+// - x, y - The position of the cell
+// Return Value:
+// - The cell or nullptr if the position is outside of the grid
+[[nodiscard]] AtlasEngine::CellInstance* AtlasEngine::_GetCell(const ptrdiff_t x, const ptrdiff_t y) noexcept
+{
+    if (x < 0 || y < 0 || x >= _gridSize.width() || y >= _gridSize.height())
+    {
+        return nullptr;
+    }
+    return &til::at(_cells, gsl::narrow_cast<size_t>(y * _gridSize.width() + x));
+}
+
+void AtlasEngine::_InvalidateRectangle(const til::rectangle& rc)
+{
+    // Cells are always repainted in full rows, as wide glyphs and their
+    // trailing halves need to be written together.
+    _invalidMap.set(til::rectangle{ til::point{ static_cast<ptrdiff_t>(0), rc.top() }, til::size{ _invalidMap.size().width(), rc.height() } });
+}
+
+// Routine Description:
+// - Invalidates a rectangle described in characters
+// Arguments:
+// - psrRegion - Character rectangle
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+
+    if (!_allInvalid)
+    {
+        _InvalidateRectangle(Viewport::FromExclusive(*psrRegion).ToInclusive());
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Invalidates the cells of the cursor
+// Arguments:
+// - psrRegion - the region covered by the cursor
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
+// Routine Description:
+// - Invalidates a rectangle describing a pixel area on the display
+// Arguments:
+// - prcDirtyClient - pixel rectangle
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::InvalidateSystem(const RECT* const prcDirtyClient) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, prcDirtyClient);
+
+    if (!_allInvalid)
+    {
+        _InvalidateRectangle(til::rectangle{ *prcDirtyClient }.scale_down(_fontRenderData->GlyphCell()));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Invalidates a series of character rectangles
+// Arguments:
+// - rectangles - One or more rectangles describing character positions on the grid
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
+{
+    if (!_allInvalid)
+    {
+        for (const auto& rect : rectangles)
+        {
+            RETURN_IF_FAILED(Invalidate(&rect));
+        }
+    }
+    return S_OK;
+}
+
+// Routine Description:
+// - Scrolls the cell grid and invalidates the area that is uncovered.
+//   Since every frame draws the entire grid, this is all it takes to scroll.
+// Arguments:
+// - pcoordDelta - The number of characters to move and uncover.
+//               - -Y is up, Y is down, -X is left, X is right.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, !pcoordDelta);
+
+    const til::point deltaCells{ *pcoordDelta };
+    if (_allInvalid || deltaCells == til::point{ 0, 0 })
+    {
+        return S_OK;
+    }
+
+    const auto dy = deltaCells.y();
+    if (deltaCells.x() != 0 || std::abs(dy) >= _gridSize.height())
+    {
+        return InvalidateAll();
+    }
+
+    const auto shift = std::abs(dy) * _gridSize.width();
+    if (dy > 0)
+    {
+        std::copy_backward(_cells.begin(), _cells.end() - shift, _cells.end());
+    }
+    else
+    {
+        std::copy(_cells.begin() + shift, _cells.end(), _cells.begin());
+    }
+
+    // Shift the contents of the map and fill in revealed area.
+    _invalidMap.translate(deltaCells, true);
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Invalidates the entire window area
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::InvalidateAll() noexcept
+try
+{
+    _invalidMap.set_all();
+    _allInvalid = true;
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - This currently has no effect in this renderer.
+// Arguments:
+// - pForcePaint - Always filled with false
+// Return Value:
+// - S_FALSE because we don't use this.
+[[nodiscard]] HRESULT AtlasEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+// Routine Description:
+// - This is unused by this renderer.
+// Arguments:
+// - pForcePaint - always filled with false.
+// Return Value:
+// - S_FALSE because this is unused.
+[[nodiscard]] HRESULT AtlasEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+// Routine description:
+// - Prepares the device resources and the cell grid for painting
+// Arguments:
+// - <none>
+// Return Value:
+// - S_FALSE if there's nothing to paint onto, otherwise S_OK or any
+//   DirectX error, a memory error, etc.
+[[nodiscard]] HRESULT AtlasEngine::StartPaint() noexcept
+try
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, _isPainting); // invalid to start a paint while painting.
+
+    // There's nothing to draw until we've got a surface and a font to draw with.
+    const auto clientSize = _GetClientSize();
+    const auto cell = _fontRenderData->GlyphCell();
+    if (!_isEnabled || clientSize.width() <= 0 || clientSize.height() <= 0 || cell.width() <= 0 || cell.height() <= 0)
+    {
+        return S_FALSE;
+    }
+
+    // If we don't have device resources or if someone has requested that we
+    // recreate the device... then make new resources. (Create will dump the old ones.)
+    if (!_haveDeviceResources || _recreateDeviceRequested)
+    {
+        RETURN_IF_FAILED(_CreateDeviceResources());
+    }
+    else if (_displaySizePixels != clientSize || _prevScale != _scale)
+    {
+        auto resetDeviceResourcesOnFailure = wil::scope_exit([&]() noexcept {
+            _ReleaseDeviceResources();
+        });
+
+        // The back buffer can't be resized while a view of it is bound.
+        _d3dDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+        _renderTargetView.Reset();
+
+        RETURN_IF_FAILED(_dxgiSwapChain->ResizeBuffers(2, clientSize.width<UINT>(), clientSize.height<UINT>(), _swapChainDesc.Format, _swapChainDesc.Flags));
+        RETURN_IF_FAILED(_PrepareRenderTarget());
+
+        resetDeviceResourcesOnFailure.release();
+        _displaySizePixels = clientSize;
+    }
+
+    _ResizeGrid(clientSize);
+
+    _isPainting = true;
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Finishes rasterizing glyphs into the atlas and draws the cell grid
+//   into the back buffer of the swap chain.
+// Arguments:
+// - <none>
+// Return Value:
+// - Any DirectX error, a memory error, etc.
+[[nodiscard]] HRESULT AtlasEngine::EndPaint() noexcept
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, !_isPainting); // invalid to end paint when we're not painting
+
+    _isPainting = false;
+    _presentReady = false;
+
+    auto hr = S_OK;
+    if (_atlasDrawing)
+    {
+        _atlasDrawing = false;
+        hr = _d2dDeviceContext->EndDraw();
+    }
+
+    _invalidMap.reset_all();
+    _allInvalid = false;
+
+    if (SUCCEEDED(hr))
+    {
+        // If the atlas ran full, some cells are missing their glyphs.
+        // Start over with an empty atlas and repaint everything, instead of
+        // presenting an incomplete frame. If the atlas was emptied for this
+        // frame already, there are more unique glyphs on screen than fit into
+        // it, and the best we can do is to present what we've got.
+        const auto overflowed = std::exchange(_atlasOverflowed, false);
+        if (overflowed && !_atlasFlushedLastFrame)
+        {
+            _FlushAtlas();
+            _atlasFlushedLastFrame = true;
+            _redrawRequested = true;
+            return InvalidateAll();
+        }
+        _atlasFlushedLastFrame = false;
+
+        hr = _DrawCells();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        _presentReady = true;
+    }
+    else
+    {
+        _ReleaseDeviceResources();
+    }
+
+    return hr;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Uploads the cell grid and draws all of it with a single instanced draw call.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or a relevant D3D error.
+[[nodiscard]] HRESULT AtlasEngine::_DrawCells() noexcept
+try
+{
+    const auto cellCount = _cells.size();
+
+    if (cellCount > _instanceBufferCapacity)
+    {
+        D3D11_BUFFER_DESC instanceBufferDesc{};
+        instanceBufferDesc.ByteWidth = gsl::narrow<UINT>(cellCount * sizeof(CellInstance));
+        instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+        instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        RETURN_IF_FAILED(_d3dDevice->CreateBuffer(&instanceBufferDesc, nullptr, _instanceBuffer.ReleaseAndGetAddressOf()));
+        _instanceBufferCapacity = cellCount;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    RETURN_IF_FAILED(_d3dDeviceContext->Map(_instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped));
+    memcpy(mapped.pData, _cells.data(), cellCount * sizeof(CellInstance));
+    _d3dDeviceContext->Unmap(_instanceBuffer.Get(), 0);
+
+    ConstBuffer constants{};
+    _FillConstBuffer(constants);
+    _d3dDeviceContext->UpdateSubresource(_constantBuffer.Get(), 0, nullptr, &constants, 0, 0);
+
+    D3D11_VIEWPORT viewport{};
+    viewport.Width = _displaySizePixels.width<float>();
+    viewport.Height = _displaySizePixels.height<float>();
+    viewport.MaxDepth = 1.0f;
+
+    static constexpr UINT stride = sizeof(CellInstance);
+    static constexpr UINT offset = 0;
+
+    _d3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    _d3dDeviceContext->IASetInputLayout(_inputLayout.Get());
+    _d3dDeviceContext->IASetVertexBuffers(0, 1, _instanceBuffer.GetAddressOf(), &stride, &offset);
+    _d3dDeviceContext->VSSetShader(_vertexShader.Get(), nullptr, 0);
+    _d3dDeviceContext->VSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
+    _d3dDeviceContext->RSSetState(_rasterizerState.Get());
+    _d3dDeviceContext->RSSetViewports(1, &viewport);
+    _d3dDeviceContext->PSSetShader(_pixelShader.Get(), nullptr, 0);
+    _d3dDeviceContext->PSSetConstantBuffers(0, 1, _constantBuffer.GetAddressOf());
+    _d3dDeviceContext->PSSetShaderResources(0, 1, _atlasView.GetAddressOf());
+    _d3dDeviceContext->OMSetRenderTargets(1, _renderTargetView.GetAddressOf(), nullptr);
+
+    _d3dDeviceContext->DrawInstanced(4, gsl::narrow<UINT>(cellCount), 0, 0);
+
+    // The atlas is a render target for Direct2D again next frame.
+    ID3D11ShaderResourceView* const nullView = nullptr;
+    _d3dDeviceContext->PSSetShaderResources(0, 1, &nullView);
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Fills the constant buffer shared by both shaders with the state of this frame.
+// Arguments:
+// - data - The buffer to fill
+// Return Value:
+// - <none>
+void AtlasEngine::_FillConstBuffer(ConstBuffer& data) const
+{
+    const auto cell = _fontRenderData->GlyphCell();
+    const auto lineMetrics = _fontRenderData->GetLineMetrics();
+
+    data.viewport[0] = _displaySizePixels.width<float>();
+    data.viewport[1] = _displaySizePixels.height<float>();
+    data.viewport[2] = cell.width<float>();
+    data.viewport[3] = cell.height<float>();
+
+    if (_cursorInfo.has_value() && _cursorInfo->isOn)
+    {
+        const auto& options = _cursorInfo.value();
+
+        // The shapes match the ones drawn by the DxEngine's CustomTextRenderer.
+        D2D1_RECT_F rect = til::rectangle{ til::point{ options.coordCursor } }.scale_up(cell);
+        if (options.fIsDoubleWidth)
+        {
+            rect.right += cell.width<float>();
+        }
+
+        D2D1_RECT_F upperLine{};
+        auto outline = false;
+        switch (options.cursorType)
+        {
+        case CursorType::Legacy:
+        {
+            // Enforce min/max cursor height
+            ULONG ulHeight = std::clamp(options.ulCursorHeightPercent, MinCursorHeightPercent, MaxCursorHeightPercent);
+            ulHeight = (cell.height<ULONG>() * ulHeight) / 100;
+            ulHeight = std::max(ulHeight, MinCursorHeightPixels); // No smaller than 1px
+
+            rect.top = rect.bottom - ulHeight;
+            break;
+        }
+        case CursorType::VerticalBar:
+            rect.right = std::min(rect.right, rect.left + options.cursorPixelWidth);
+            break;
+        case CursorType::Underscore:
+            rect.top = rect.bottom - 1;
+            break;
+        case CursorType::DoubleUnderscore:
+            rect.top = rect.bottom - 1;
+            upperLine = D2D1_RECT_F{ rect.left, rect.top - 2, rect.right, rect.bottom - 2 };
+            break;
+        case CursorType::EmptyBox:
+            outline = true;
+            break;
+        case CursorType::FullBox:
+        default:
+            break;
+        }
+
+        data.cursorRect[0] = rect.left;
+        data.cursorRect[1] = rect.top;
+        data.cursorRect[2] = rect.right;
+        data.cursorRect[3] = rect.bottom;
+        data.cursorRect2[0] = upperLine.left;
+        data.cursorRect2[1] = upperLine.top;
+        data.cursorRect2[2] = upperLine.right;
+        data.cursorRect2[3] = upperLine.bottom;
+        s_ColorToFloat4(options.cursorColor, 1.0f, data.cursorColor);
+        data.cursorOptions[0] = 1;
+        data.cursorOptions[1] = outline;
+        data.cursorOptions[2] = !options.fUseColor;
+        // Like in the DxEngine, only a colored full box is drawn behind the text.
+        data.cursorOptions[3] = options.cursorType == CursorType::FullBox;
+    }
+
+    s_ColorToFloat4(_selectionColor, _selectionAlpha, data.selectionColor);
+
+    data.lineMetrics[0] = lineMetrics.underlineOffset;
+    data.lineMetrics[1] = lineMetrics.underlineOffset2;
+    data.lineMetrics[2] = lineMetrics.underlineWidth;
+    data.lineMetrics[3] = lineMetrics.gridlineWidth;
+    data.strikethrough[0] = lineMetrics.strikethroughOffset;
+    data.strikethrough[1] = lineMetrics.strikethroughWidth;
+
+    data.grid[0] = _gridSize.width<uint32_t>();
+    data.grid[1] = _gridSize.height<uint32_t>();
+}
+
+// Routine Description:
+// - Looks up the atlas tile of the given glyph, rasterizing it if this is
+//   the first time we see it.
+// Arguments:
+// - text - The text of the glyph cluster
+// - columns - The number of columns the glyph covers
+// Return Value:
+// - The position of the tile in the atlas in pixels. (0, 0) if the glyph
+//   didn't fit into the atlas anymore.
+[[nodiscard]] std::pair<uint16_t, uint16_t> AtlasEngine::_GetGlyphTile(const std::wstring_view text, const uint8_t columns)
+{
+    GlyphKey key{ std::wstring{ text }, _useItalicFont, columns };
+    if (const auto it = _glyphs.find(key); it != _glyphs.end())
+    {
+        return it->second;
+    }
+
+    const auto cell = _fontRenderData->GlyphCell();
+    const auto tileWidth = cell.width() * columns;
+
+    if (_atlasPosition.x() + tileWidth > AtlasSize)
+    {
+        _atlasPosition = til::point{ static_cast<ptrdiff_t>(0), _atlasPosition.y() + cell.height() };
+    }
+    if (_atlasPosition.y() + cell.height() > AtlasSize)
+    {
+        _atlasOverflowed = true;
+        return {};
+    }
+
+    if (!_atlasDrawing)
+    {
+        _d2dDeviceContext->BeginDraw();
+        _atlasDrawing = true;
+
+        // ClearType needs to know the color it's blended onto, which we only
+        // get to know in the pixel shader. Grayscale antialiasing is the best
+        // we can do for a glyph that's shared by all colors.
+        _d2dDeviceContext->SetTextAntialiasMode(_antialiasingMode == D2D1_TEXT_ANTIALIAS_MODE_ALIASED ? D2D1_TEXT_ANTIALIAS_MODE_ALIASED : D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
+
+        if (std::exchange(_atlasNeedsClear, false))
+        {
+            _d2dDeviceContext->Clear(D2D1::ColorF(0, 0.0f));
+        }
+    }
+
+    const D2D1_RECT_F rect{ _atlasPosition.x<float>(),
+                            _atlasPosition.y<float>(),
+                            _atlasPosition.x<float>() + tileWidth,
+                            _atlasPosition.y<float>() + cell.height<float>() };
+    const auto format = _useItalicFont ? _fontRenderData->ItalicTextFormat() : _fontRenderData->DefaultTextFormat();
+
+    // The glyph is drawn in white, so that its coverage ends up in the alpha
+    // channel and the pixel shader can apply any foreground color to it.
+    _d2dDeviceContext->PushAxisAlignedClip(rect, D2D1_ANTIALIAS_MODE_ALIASED);
+    _d2dDeviceContext->DrawTextW(text.data(),
+                                 gsl::narrow<UINT32>(text.size()),
+                                 format.Get(),
+                                 rect,
+                                 _d2dBrushWhite.Get(),
+                                 D2D1_DRAW_TEXT_OPTIONS_NONE,
+                                 DWRITE_MEASURING_MODE_NATURAL);
+    _d2dDeviceContext->PopAxisAlignedClip();
+
+    const std::pair<uint16_t, uint16_t> tile{ _atlasPosition.x<uint16_t>(), _atlasPosition.y<uint16_t>() };
+    _glyphs.emplace(std::move(key), tile);
+    _atlasPosition += til::point{ tileWidth, static_cast<ptrdiff_t>(0) };
+    return tile;
+}
+
+// Routine Description:
+// - Forgets all glyphs in the atlas. The texture is cleared the next time
+//   a glyph is rasterized.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void AtlasEngine::_FlushAtlas() noexcept
+{
+    _glyphs.clear();
+    // The tile at (0, 0) marks cells without a glyph, so don't hand it out.
+    _atlasPosition = til::point{ 1, 0 };
+    _atlasNeedsClear = true;
+}
+
+// Method Description:
+// - Asks for another frame right away, if the last one couldn't be
+//   presented because the glyph atlas ran full.
+[[nodiscard]] bool AtlasEngine::RequiresContinuousRedraw() noexcept
+{
+    return std::exchange(_redrawRequested, false);
+}
+
+// Method Description:
+// - Everything we draw is handed to us in the paint calls,
+//   so the renderer doesn't need to hold the console lock while we're painting.
+[[nodiscard]] bool AtlasEngine::SupportsSnapshotPainting() noexcept
+{
+    return true;
+}
+
+// Method Description:
+// - Blocks until the engine is able to render without blocking.
+// - See https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains.
+void AtlasEngine::WaitUntilCanRender() noexcept
+{
+    if (!_swapChainFrameLatencyWaitableObject)
+    {
+        return;
+    }
+
+    const auto ret = WaitForSingleObjectEx(
+        _swapChainFrameLatencyWaitableObject.get(),
+        1000, // 1 second timeout (shouldn't ever occur)
+        true);
+    if (ret != WAIT_OBJECT_0)
+    {
+        LOG_WIN32_MSG(ret, "Waiting for swap chain frame latency waitable object returned error or timeout.");
+    }
+}
+
+// Routine Description:
+// - Presents the frame drawn in EndPaint.
+// - This is separated out so it can be done outside the lock as it's expensive.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK on success, E_PENDING to indicate a retry or a relevant DirectX error
+[[nodiscard]] HRESULT AtlasEngine::Present() noexcept
+{
+    if (!_presentReady)
+    {
+        return S_OK;
+    }
+
+    _presentReady = false;
+
+    // Every frame redraws the entire back buffer,
+    // so there's no point in presenting only the dirty parts of it.
+    const auto hr = _dxgiSwapChain->Present(1, 0);
+    if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+    {
+        // We don't need to end painting here, as the renderer has done it for us.
+        _ReleaseDeviceResources();
+        FAIL_FAST_IF_FAILED(InvalidateAll());
+        return E_PENDING; // Indicate a retry to the renderer.
+    }
+
+    return hr;
+}
+
+// Routine Description:
+// - This is currently unused. Scrolling happens in InvalidateScroll.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::ScrollFrame() noexcept
+{
+    return S_OK;
+}
+
+// Routine Description:
+// - Resets all invalidated cells to the default background color.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::PaintBackground() noexcept
+try
+{
+    const CellInstance blank{ 0, 0, _defaultForegroundColor, _defaultBackgroundColor, 1 };
+
+    for (const auto& rect : _invalidMap.runs())
+    {
+        for (auto y = rect.top(); y < rect.bottom(); ++y)
+        {
+            for (auto x = rect.left(); x < rect.right(); ++x)
+            {
+                if (const auto cell = _GetCell(x, y))
+                {
+                    *cell = blank;
+                }
+            }
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Writes one line of text into the cell grid, rasterizing glyphs
+//   that aren't in the atlas yet.
+// Arguments:
+// - clusters - Iterable collection of cluster information (text and columns it should consume)
+// - coord - Character coordinate position in the cell grid
+// - fTrimLeft - Whether or not to trim off the left half of a double wide character
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT AtlasEngine::PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                                   COORD const coord,
+                                                   const bool /*trimLeft*/,
+                                                   const bool /*lineWrapped*/) noexcept
+try
+{
+    ptrdiff_t x = coord.X;
+    const ptrdiff_t y = coord.Y;
+
+    for (const auto& cluster : clusters)
+    {
+        const auto cell = _GetCell(x, y);
+        if (!cell)
+        {
+            break;
+        }
+
+        const auto text = cluster.GetText();
+        const auto columns = gsl::narrow_cast<uint8_t>(std::clamp<size_t>(cluster.GetColumns(), 1, ColumnsMask));
+
+        std::pair<uint16_t, uint16_t> tile{};
+        if (text.find_first_not_of(UNICODE_SPACE) != std::wstring_view::npos)
+        {
+            tile = _GetGlyphTile(text, columns);
+        }
+
+        *cell = CellInstance{ tile.first, tile.second, _foregroundColor, _backgroundColor, columns };
+
+        // The trailing half of a wide glyph is drawn by the leading one.
+        for (uint8_t i = 1; i < columns; ++i)
+        {
+            if (const auto trailing = _GetCell(x + i, y))
+            {
+                *trailing = CellInstance{ 0, 0, _foregroundColor, _backgroundColor, 0 };
+            }
+        }
+
+        x += columns;
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Flags the cells that need lines drawn around them or through them.
+//   The lines are drawn in the foreground color of the cell by the pixel shader.
+// Arguments:
+// - lines - Which grid lines (top, left, bottom, right) to draw
+// - color - Unused, the lines use the foreground color of the cell
+// - cchLine - Length of the line to draw in character cells
+// - coordTarget - The X,Y character position in the grid where we should start drawing
+//               - We will draw rightward (+X) from here
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::PaintBufferGridLines(GridLines const lines,
+                                                        COLORREF const /*color*/,
+                                                        size_t const cchLine,
+                                                        COORD const coordTarget) noexcept
+{
+    uint32_t flags = 0;
+    WI_SetFlagIf(flags, CellFlags::GridTop, WI_IsFlagSet(lines, GridLines::Top));
+    WI_SetFlagIf(flags, CellFlags::GridBottom, WI_IsFlagSet(lines, GridLines::Bottom));
+    WI_SetFlagIf(flags, CellFlags::GridLeft, WI_IsFlagSet(lines, GridLines::Left));
+    WI_SetFlagIf(flags, CellFlags::GridRight, WI_IsFlagSet(lines, GridLines::Right));
+    WI_SetFlagIf(flags, CellFlags::Underline, WI_IsFlagSet(lines, GridLines::Underline));
+    WI_SetFlagIf(flags, CellFlags::DoubleUnderline, WI_IsFlagSet(lines, GridLines::DoubleUnderline));
+    WI_SetFlagIf(flags, CellFlags::Strikethrough, WI_IsFlagSet(lines, GridLines::Strikethrough));
+    if (WI_IsFlagSet(lines, GridLines::HyperlinkUnderline))
+    {
+        // The hovered hyperlink gets a solid underline, all others a dashed one.
+        if (_isHoveredHyperlink)
+        {
+            WI_SetFlag(flags, CellFlags::Underline);
+        }
+        else
+        {
+            WI_SetFlag(flags, CellFlags::DashedUnderline);
+        }
+    }
+
+    for (size_t i = 0; i < cchLine; ++i)
+    {
+        const auto cell = _GetCell(coordTarget.X + gsl::narrow_cast<ptrdiff_t>(i), coordTarget.Y);
+        if (!cell)
+        {
+            break;
+        }
+        cell->flags |= flags;
+    }
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Flags the cells of the given rectangle as selected.
+// Arguments:
+//  - rect - Rectangle to highlight to make the selection area
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::PaintSelection(const SMALL_RECT rect) noexcept
+try
+{
+    const til::rectangle selection{ Viewport::FromExclusive(rect).ToInclusive() };
+
+    for (auto y = selection.top(); y < selection.bottom(); ++y)
+    {
+        for (auto x = selection.left(); x < selection.right(); ++x)
+        {
+            if (const auto cell = _GetCell(x, y))
+            {
+                WI_SetFlag(cell->flags, CellFlags::Selected);
+            }
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Does nothing. Our cursor is drawn by the pixel shader,
+//   based on the information passed to PrepareRenderInfo.
+// Arguments:
+// - options - unused
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::PaintCursor(const CursorOptions& /*options*/) noexcept
+{
+    return S_OK;
+}
+
+// Routine Description:
+// - Updates the colors and the font style used for the following cells
+// Arguments:
+// - textAttributes - Text attributes to use for the colors
+// - pData - The interface to console data structures required for rendering
+// - isSettingDefaultBrushes - Lets us know that these are the default colors to reset cells to
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                        const gsl::not_null<IRenderData*> pData,
+                                                        const bool isSettingDefaultBrushes) noexcept
+{
+    const auto [colorForeground, colorBackground] = _GetAttributeColors(textAttributes, pData, isSettingDefaultBrushes);
+
+    _foregroundColor = OPACITY_OPAQUE | colorForeground;
+    // Only a composition swap chain supports transparency.
+    _backgroundColor = _chainMode == SwapChainMode::ForHwnd ? OPACITY_OPAQUE | colorBackground : colorBackground;
+
+    if (isSettingDefaultBrushes)
+    {
+        _defaultForegroundColor = _foregroundColor;
+        _defaultBackgroundColor = _backgroundColor;
+    }
+
+    _useItalicFont = textAttributes.IsItalic();
+    _isHoveredHyperlink = textAttributes.IsHyperlink() && textAttributes.GetHyperlinkId() == _hyperlinkHoveredId;
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Updates the font used for drawing. All glyphs in the atlas have to be
+//   rasterized again afterwards.
+// Arguments:
+// - pfiFontInfoDesired - Information specifying the font that is requested
+// - fiFontInfo - Filled with the nearest font actually chosen for drawing
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT AtlasEngine::UpdateFont(const FontInfoDesired& pfiFontInfoDesired, FontInfo& fiFontInfo) noexcept
+try
+{
+    RETURN_IF_FAILED(_fontRenderData->UpdateFont(pfiFontInfoDesired, fiFontInfo, _dpi));
+
+    _FlushAtlas();
+    return InvalidateAll();
+}
+CATCH_RETURN();
+
+[[nodiscard]] Viewport AtlasEngine::GetViewportInCharacters(const Viewport& viewInPixels) noexcept
+{
+    const short widthInChars = base::saturated_cast<short>(viewInPixels.Width() / _fontRenderData->GlyphCell().width());
+    const short heightInChars = base::saturated_cast<short>(viewInPixels.Height() / _fontRenderData->GlyphCell().height());
+
+    return Viewport::FromDimensions(viewInPixels.Origin(), { widthInChars, heightInChars });
+}
+
+// Routine Description:
+// - Sets the DPI in this renderer
+// Arguments:
+// - iDpi - DPI
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::UpdateDpi(int const iDpi) noexcept
+{
+    _dpi = iDpi;
+
+    // The scale factor may be necessary for composition contexts, so save it once here.
+    _scale = _dpi / static_cast<float>(USER_DEFAULT_SCREEN_DPI);
+
+    return InvalidateAll();
+}
+
+// Method Description:
+// - Get the current scale factor of this renderer. The actual DPI the renderer
+//   is USER_DEFAULT_SCREEN_DPI * GetScaling()
+// Arguments:
+// - <none>
+// Return Value:
+// - the scaling multiplier of this render engine
+float AtlasEngine::GetScaling() const noexcept
+{
+    return _scale;
+}
+
+// Method Description:
+// - This method will update our internal reference for how big the viewport is.
+//      Does nothing for this renderer.
+// Arguments:
+// - srNewViewport - The bounds of the new viewport.
+// Return Value:
+// - HRESULT S_OK
+[[nodiscard]] HRESULT AtlasEngine::UpdateViewport(const SMALL_RECT /*srNewViewport*/) noexcept
+{
+    return S_OK;
+}
+
+// Routine Description:
+// - Figures out the font that would be chosen for the given request
+// Arguments:
+// - pfiFontInfoDesired - Information specifying the font that is requested
+// - pfiFontInfo - Filled with the nearest font actually chosen
+// - iDpi - The DPI to choose the font for
+// Return Value:
+// - S_OK or relevant DirectWrite error
+[[nodiscard]] HRESULT AtlasEngine::GetProposedFont(const FontInfoDesired& pfiFontInfoDesired,
+                                                   FontInfo& pfiFontInfo,
+                                                   int const iDpi) noexcept
+{
+    DxFontRenderData fontRenderData(_dwriteFactory);
+    return fontRenderData.UpdateFont(pfiFontInfoDesired, pfiFontInfo, iDpi);
+}
+
+// Routine Description:
+// - Gets the area that we currently believe is dirty within the character cell grid
+// Arguments:
+// - area - Rectangle describing dirty area in characters.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
+{
+    area = _invalidMap.runs();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Gets the current font size
+// Arguments:
+// - pFontSize - Filled with the font size.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
+try
+{
+    *pFontSize = _fontRenderData->GlyphCell();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Measures whether the given glyph is wider than one cell in the current font.
+// Arguments:
+// - glyph - The glyph run to process for column width.
+// - pResult - True if it should take two columns. False if it should take one.
+// Return Value:
+// - S_OK or relevant DirectWrite error.
+[[nodiscard]] HRESULT AtlasEngine::IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pResult);
+
+    ::Microsoft::WRL::ComPtr<IDWriteTextLayout> layout;
+    RETURN_IF_FAILED(_dwriteFactory->CreateTextLayout(glyph.data(),
+                                                      gsl::narrow<UINT32>(glyph.size()),
+                                                      _fontRenderData->DefaultTextFormat().Get(),
+                                                      FLT_MAX,
+                                                      FLT_MAX,
+                                                      &layout));
+
+    DWRITE_TEXT_METRICS metrics{};
+    RETURN_IF_FAILED(layout->GetMetrics(&metrics));
+
+    const auto columns = std::lround(metrics.widthIncludingTrailingWhitespace / _fontRenderData->GlyphCell().width<float>());
+    *pResult = columns != 1;
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Method Description:
+// - Updates the window's title string.
+// Arguments:
+// - newTitle: the new string to use for the title of the window
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::_DoUpdateTitle(_In_ const std::wstring_view /*newTitle*/) noexcept
+{
+    if (_hwndTarget != INVALID_HANDLE_VALUE)
+    {
+        return PostMessageW(_hwndTarget, CM_UPDATE_TITLE, 0, 0) ? S_OK : E_FAIL;
+    }
+    return S_FALSE;
+}
+
+// Routine Description:
+// - Updates the selection background color
+// Arguments:
+// - color - GDI Color
+// - alpha - The opacity of the selection
+// Return Value:
+// - N/A
+void AtlasEngine::SetSelectionBackground(const COLORREF color, const float alpha) noexcept
+{
+    _selectionColor = color;
+    _selectionAlpha = alpha;
+}
+
+// Routine Description:
+// - Changes the antialiasing mode of the glyphs in the atlas. ClearType is
+//   drawn as grayscale, see _GetGlyphTile.
+// Arguments:
+// - antialiasingMode: a value from the D2D1_TEXT_ANTIALIAS_MODE enum.
+// Return Value:
+// - N/A
+void AtlasEngine::SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept
+try
+{
+    if (_antialiasingMode != antialiasingMode)
+    {
+        _antialiasingMode = antialiasingMode;
+        _FlushAtlas();
+        LOG_IF_FAILED(InvalidateAll());
+    }
+}
+CATCH_LOG()
+
+// Method Description:
+// - Updates our internal tracker for which hyperlink ID we are hovering over
+//   This is needed for UpdateDrawingBrushes to know where we need to set a different style
+// Arguments:
+// - The new link ID we are hovering over
+void AtlasEngine::UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept
+{
+    _hyperlinkHoveredId = hoveredId;
+}
+
+// Method Description:
+// - Estimates the bytes this engine holds on to. The caches are the glyph
+//   atlas, the instance buffer the cells are uploaded into and the map of
+//   the glyphs in the atlas.
+// Arguments:
+// - <none>
+// Return Value:
+// - The bytes held by the swap chain and the caches.
+RenderMemoryUsage AtlasEngine::GetMemoryUsage() noexcept
+{
+    RenderMemoryUsage usage;
+    DXGI_SWAP_CHAIN_DESC1 desc{};
+    if (_dxgiSwapChain && SUCCEEDED(_dxgiSwapChain->GetDesc1(&desc)))
+    {
+        usage.swapChain = size_t{ desc.Width } * desc.Height * desc.BufferCount * 4;
+    }
+    if (_atlasTexture)
+    {
+        usage.caches += size_t{ AtlasSize } * AtlasSize * 4;
+    }
+    usage.caches += _instanceBufferCapacity * sizeof(CellInstance);
+    usage.caches += _cells.capacity() * sizeof(CellInstance);
+    usage.caches += _glyphs.size() * (sizeof(decltype(_glyphs)::value_type) + 2 * sizeof(void*));
+    return usage;
+}
+
+// Method Description:
+// - Informs this render engine about the cursor at the beginning of this
+//   frame. The cursor is drawn by the pixel shader in EndPaint.
+// Arguments:
+// - info - a RenderFrameInfo with information about the state of the cursor in this frame.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT AtlasEngine::PrepareRenderInfo(const RenderFrameInfo& info) noexcept
+{
+    _cursorInfo = info.cursorInfo;
+    return S_OK;
+}
@@ -0,0 +1,306 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- AtlasEngine.hpp
+
+Abstract:
+- An alternative to the DxEngine that doesn't call into DirectWrite for every
+  run of text it draws. Instead every unique glyph is rasterized only once into
+  a texture (the "atlas") and the entire viewport is then drawn with a single
+  instanced Direct3D draw call, one quad per cell.
+- The engine keeps a copy of the cell grid. Only the cells the renderer
+  invalidated are updated every frame, while the draw call always covers the
+  entire grid, which makes partial presentation unnecessary.
+--*/
+
+#pragma once
+
+#include "../../renderer/inc/RenderEngineBase.hpp"
+
+#include <functional>
+#include <unordered_map>
+
+#include <dxgi.h>
+#include <dxgi1_2.h>
+#include <dxgi1_3.h>
+
+#include <d3d11.h>
+#include <d2d1.h>
+#include <d2d1_1.h>
+#include <dwrite.h>
+
+#include <wrl.h>
+#include <wrl/client.h>
+
+#include "DxFontRenderData.h"
+
+#include "../../types/inc/Viewport.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class AtlasEngine final : public RenderEngineBase
+    {
+    public:
+        AtlasEngine();
+        ~AtlasEngine();
+        AtlasEngine(const AtlasEngine&) = delete;
+        AtlasEngine(AtlasEngine&&) = delete;
+        AtlasEngine& operator=(const AtlasEngine&) = delete;
+        AtlasEngine& operator=(AtlasEngine&&) = delete;
+
+        [[nodiscard]] HRESULT Enable() noexcept override;
+        [[nodiscard]] HRESULT Disable() noexcept;
+
+        [[nodiscard]] HRESULT SetHwnd(const HWND hwnd) noexcept;
+        [[nodiscard]] HRESULT SetWindowSize(const SIZE pixels) noexcept override;
+
+        void SetCallback(std::function<void()> pfn) override;
+        void SetWarningCallback(std::function<void(const HRESULT)> pfn) override;
+        void SetSoftwareRendering(bool enable) noexcept override;
+        HANDLE GetSwapChainHandle() override;
+
+        // IRenderEngine Members
+        [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateAll() noexcept override;
+        [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override;
+        [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
+
+        [[nodiscard]] HRESULT StartPaint() noexcept override;
+        [[nodiscard]] HRESULT EndPaint() noexcept override;
+
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
+        [[nodiscard]] bool SupportsSnapshotPainting() noexcept override;
+
+        void WaitUntilCanRender() noexcept override;
+        [[nodiscard]] HRESULT Present() noexcept override;
+
+        [[nodiscard]] HRESULT ScrollFrame() noexcept override;
+
+        [[nodiscard]] HRESULT PrepareRenderInfo(const RenderFrameInfo& info) noexcept override;
+
+        [[nodiscard]] HRESULT PaintBackground() noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                              COORD const coord,
+                                              bool const fTrimLeft,
+                                              const bool lineWrapped) noexcept override;
+
+        [[nodiscard]] HRESULT PaintBufferGridLines(GridLines const lines, COLORREF const color, size_t const cchLine, COORD const coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
+
+        [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
+
+        [[nodiscard]] HRESULT UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                   const gsl::not_null<IRenderData*> pData,
+                                                   const bool isSettingDefaultBrushes) noexcept override;
+        [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo) noexcept override;
+        [[nodiscard]] HRESULT UpdateDpi(int const iDpi) noexcept override;
+        [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT srNewViewport) noexcept override;
+
+        [[nodiscard]] HRESULT GetProposedFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo, int const iDpi) noexcept override;
+
+        [[nodiscard]] HRESULT GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept override;
+
+        [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
+        [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
+
+        [[nodiscard]] ::Microsoft::Console::Types::Viewport GetViewportInCharacters(const ::Microsoft::Console::Types::Viewport& viewInPixels) noexcept override;
+
+        float GetScaling() const noexcept override;
+
+        void SetSelectionBackground(const COLORREF color, const float alpha = 0.5f) noexcept override;
+        void SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept override;
+
+        void UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept override;
+        RenderMemoryUsage GetMemoryUsage() noexcept override;
+
+    protected:
+        [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring_view newTitle) noexcept override;
+
+    private:
+        enum class SwapChainMode
+        {
+            ForHwnd,
+            ForComposition
+        };
+
+        // The flags of a cell. The lowest two bits hold the number of columns
+        // the glyph in the cell covers. A value of 0 marks the trailing half
+        // of a wide glyph, which is drawn by the cell to its left.
+        enum CellFlags : uint32_t
+        {
+            ColumnsMask = 0x3,
+            Underline = 0x4,
+            DoubleUnderline = 0x8,
+            DashedUnderline = 0x10,
+            Strikethrough = 0x20,
+            GridTop = 0x40,
+            GridBottom = 0x80,
+            GridLeft = 0x100,
+            GridRight = 0x200,
+            Selected = 0x400,
+        };
+
+        // The per-instance vertex data. Must match the input layout and the
+        // VS_INPUT struct of the vertex shader.
+        struct CellInstance
+        {
+            uint16_t tileX;
+            uint16_t tileY;
+            COLORREF foreground;
+            COLORREF background;
+            uint32_t flags;
+        };
+
+        // Must match the ConstBuffer in the shaders.
+        // DirectX constant buffers need to be a multiple of 16 bytes in size.
+        struct alignas(16) ConstBuffer
+        {
+            float viewport[4];
+            float cursorRect[4];
+            float cursorRect2[4];
+            float cursorColor[4];
+            uint32_t cursorOptions[4];
+            float selectionColor[4];
+            float lineMetrics[4];
+            float strikethrough[4];
+            uint32_t grid[4];
+        };
+
+        struct GlyphKey
+        {
+            std::wstring text;
+            bool italic;
+            uint8_t columns;
+
+            bool operator==(const GlyphKey& other) const noexcept
+            {
+                return italic == other.italic && columns == other.columns && text == other.text;
+            }
+        };
+
+        struct GlyphKeyHash
+        {
+            size_t operator()(const GlyphKey& key) const noexcept
+            {
+                const auto hash = std::hash<std::wstring_view>{}(key.text);
+                return hash ^ (size_t{ key.columns } << 1) ^ size_t{ key.italic };
+            }
+        };
+
+        static constexpr UINT AtlasSize = 2048;
+
+        SwapChainMode _chainMode;
+
+        HWND _hwndTarget;
+        til::size _sizeTarget;
+        int _dpi;
+        float _scale;
+        float _prevScale;
+
+        std::function<void()> _pfn;
+        std::function<void(const HRESULT)> _pfnWarningCallback;
+
+        bool _isEnabled;
+        bool _isPainting;
+        bool _presentReady;
+        bool _redrawRequested;
+
+        til::size _displaySizePixels;
+
+        COLORREF _defaultForegroundColor;
+        COLORREF _defaultBackgroundColor;
+        COLORREF _foregroundColor;
+        COLORREF _backgroundColor;
+        COLORREF _selectionColor;
+        float _selectionAlpha;
+        bool _useItalicFont;
+
+        uint16_t _hyperlinkHoveredId;
+        bool _isHoveredHyperlink;
+
+        std::optional<CursorOptions> _cursorInfo;
+
+        // The cell grid. It's as large as the swap chain divided by the cell
+        // size, rounded up, and stored row by row.
+        til::size _gridSize;
+        std::vector<CellInstance> _cells;
+
+        std::pmr::unsynchronized_pool_resource _pool;
+        til::pmr::bitmap _invalidMap;
+        bool _allInvalid;
+
+        // The glyph atlas. Tiles are allocated from left to right in rows of
+        // one cell height. The tile at the origin is reserved for whitespace.
+        std::unordered_map<GlyphKey, std::pair<uint16_t, uint16_t>, GlyphKeyHash> _glyphs;
+        til::point _atlasPosition;
+        bool _atlasDrawing;
+        bool _atlasNeedsClear;
+        bool _atlasOverflowed;
+        bool _atlasFlushedLastFrame;
+
+        wil::unique_handle _swapChainHandle;
+
+        // Device-Independent Resources
+        ::Microsoft::WRL::ComPtr<ID2D1Factory1> _d2dFactory;
+        ::Microsoft::WRL::ComPtr<IDWriteFactory1> _dwriteFactory;
+        std::unique_ptr<DxFontRenderData> _fontRenderData;
+
+        // Device-Dependent Resources
+        bool _recreateDeviceRequested;
+        bool _haveDeviceResources;
+        ::Microsoft::WRL::ComPtr<ID3D11Device> _d3dDevice;
+        ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> _d3dDeviceContext;
+        ::Microsoft::WRL::ComPtr<ID2D1Device> _d2dDevice;
+        ::Microsoft::WRL::ComPtr<ID2D1DeviceContext> _d2dDeviceContext;
+        ::Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> _d2dBrushWhite;
+
+        ::Microsoft::WRL::ComPtr<IDXGIFactory2> _dxgiFactory2;
+        ::Microsoft::WRL::ComPtr<IDXGIFactoryMedia> _dxgiFactoryMedia;
+        ::Microsoft::WRL::ComPtr<IDXGIDevice> _dxgiDevice;
+
+        DXGI_SWAP_CHAIN_DESC1 _swapChainDesc;
+        ::Microsoft::WRL::ComPtr<IDXGISwapChain1> _dxgiSwapChain;
+        wil::unique_handle _swapChainFrameLatencyWaitableObject;
+        ::Microsoft::WRL::ComPtr<ID3D11RenderTargetView> _renderTargetView;
+
+        ::Microsoft::WRL::ComPtr<ID3D11VertexShader> _vertexShader;
+        ::Microsoft::WRL::ComPtr<ID3D11PixelShader> _pixelShader;
+        ::Microsoft::WRL::ComPtr<ID3D11InputLayout> _inputLayout;
+        ::Microsoft::WRL::ComPtr<ID3D11RasterizerState> _rasterizerState;
+        ::Microsoft::WRL::ComPtr<ID3D11Buffer> _constantBuffer;
+        ::Microsoft::WRL::ComPtr<ID3D11Buffer> _instanceBuffer;
+        size_t _instanceBufferCapacity;
+
+        ::Microsoft::WRL::ComPtr<ID3D11Texture2D> _atlasTexture;
+        ::Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> _atlasView;
+        ::Microsoft::WRL::ComPtr<ID2D1Bitmap1> _atlasBitmap;
+
+        // Preferences and overrides
+        bool _softwareRendering;
+        D2D1_TEXT_ANTIALIAS_MODE _antialiasingMode;
+
+        [[nodiscard]] HRESULT _CreateDeviceResources() noexcept;
+        [[nodiscard]] HRESULT _CreateSurfaceHandle() noexcept;
+        [[nodiscard]] HRESULT _CreateShaders() noexcept;
+        [[nodiscard]] HRESULT _CreateAtlas() noexcept;
+        [[nodiscard]] HRESULT _PrepareRenderTarget() noexcept;
+        void _ReleaseDeviceResources() noexcept;
+
+        [[nodiscard]] til::size _GetClientSize() const;
+        void _ResizeGrid(const til::size clientSize);
+        void _InvalidateRectangle(const til::rectangle& rc);
+
+        [[nodiscard]] CellInstance* _GetCell(const ptrdiff_t x, const ptrdiff_t y) noexcept;
+        [[nodiscard]] std::pair<uint16_t, uint16_t> _GetGlyphTile(const std::wstring_view text, const uint8_t columns);
+        void _FlushAtlas() noexcept;
+
+        [[nodiscard]] HRESULT _DrawCells() noexcept;
+        void _FillConstBuffer(ConstBuffer& data) const;
+    };
+}
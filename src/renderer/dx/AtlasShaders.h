@@ -0,0 +1,160 @@
+#pragma once
+
+#if !TIL_FEATURE_DXENGINESHADERSUPPORT_ENABLED
+const char atlasVertexShaderString[] = "";
+const char atlasPixelShaderString[] = "";
+#else
+// Both shaders share the same constant buffer, see AtlasEngine::ConstBuffer.
+#define ATLAS_SHADER_COMMON R"(
+cbuffer ConstBuffer : register(b0)
+{
+    float4 viewport;      // x, y: size of the swap chain in pixels, z, w: size of a cell in pixels
+    float4 cursorRect;    // left, top, right, bottom in pixels
+    float4 cursorRect2;   // the upper line of a double underscore cursor
+    float4 cursorColor;
+    uint4 cursorOptions;  // x: visible, y: outline only, z: inverted, w: drawn behind the text
+    float4 selectionColor;
+    float4 lineMetrics;   // x: underline offset, y: second underline offset, z: underline width, w: gridline width
+    float4 strikethrough; // x: offset, y: width
+    uint4 grid;           // x: number of columns
+};
+
+#define COLUMNS_MASK 0x3
+#define UNDERLINE 0x4
+#define DOUBLE_UNDERLINE 0x8
+#define DASHED_UNDERLINE 0x10
+#define STRIKETHROUGH 0x20
+#define GRID_TOP 0x40
+#define GRID_BOTTOM 0x80
+#define GRID_LEFT 0x100
+#define GRID_RIGHT 0x200
+#define SELECTED 0x400
+
+struct PS_INPUT
+{
+    float4 position : SV_Position;
+    float2 local : TEXCOORD0;
+    nointerpolation uint2 tile : TILE;
+    nointerpolation float4 foreground : FOREGROUND;
+    nointerpolation float4 background : BACKGROUND;
+    nointerpolation uint flags : FLAGS;
+};
+)"
+
+const char atlasVertexShaderString[] = ATLAS_SHADER_COMMON R"(
+struct VS_INPUT
+{
+    uint2 tile : TILE;
+    float4 foreground : FOREGROUND;
+    float4 background : BACKGROUND;
+    uint flags : FLAGS;
+    uint vertexId : SV_VertexID;
+    uint instanceId : SV_InstanceID;
+};
+
+// Every instance is one cell of the grid, drawn as a 4 vertex triangle strip.
+// Wide glyphs get a quad that spans all of their columns.
+PS_INPUT main(VS_INPUT input)
+{
+    const float2 corner = float2(input.vertexId & 1, input.vertexId >> 1);
+    const float2 cell = float2(input.instanceId % grid.x, input.instanceId / grid.x);
+    const float columns = (float)(input.flags & COLUMNS_MASK);
+
+    PS_INPUT output;
+    output.local = corner * float2(viewport.z * columns, viewport.w);
+    const float2 pixel = cell * viewport.zw + output.local;
+    output.position = float4(pixel / viewport.xy * float2(2, -2) + float2(-1, 1), 0, 1);
+    output.tile = input.tile;
+    output.foreground = input.foreground;
+    output.background = input.background;
+    output.flags = input.flags;
+    return output;
+}
+)";
+
+const char atlasPixelShaderString[] = ATLAS_SHADER_COMMON R"(
+Texture2D<float4> glyphAtlas : register(t0);
+
+bool insideRect(float2 position, float4 rect)
+{
+    return position.x >= rect.x && position.y >= rect.y && position.x < rect.z && position.y < rect.w;
+}
+
+bool insideLine(float y, float offset, float width)
+{
+    return abs(y - offset) < max(width, 1) * 0.5;
+}
+
+float4 main(PS_INPUT input) : SV_Target
+{
+    const float2 local = input.local;
+    const float cellX = local.x % viewport.z;
+
+    // The glyphs were drawn in white, so the alpha channel holds the coverage.
+    float coverage = 0;
+    if (any(input.tile))
+    {
+        coverage = glyphAtlas.Load(int3(input.tile + uint2(local), 0)).a;
+    }
+
+    const uint flags = input.flags;
+    if (((flags & (UNDERLINE | DOUBLE_UNDERLINE)) && insideLine(local.y, lineMetrics.x, lineMetrics.z)) ||
+        ((flags & DOUBLE_UNDERLINE) && insideLine(local.y, lineMetrics.y, lineMetrics.z)) ||
+        ((flags & DASHED_UNDERLINE) && insideLine(local.y, lineMetrics.x, lineMetrics.z) && frac(local.x / (max(lineMetrics.z, 1) * 4)) < 0.25) ||
+        ((flags & STRIKETHROUGH) && insideLine(local.y, strikethrough.x, strikethrough.y)) ||
+        ((flags & GRID_TOP) && local.y < lineMetrics.w) ||
+        ((flags & GRID_BOTTOM) && local.y >= viewport.w - lineMetrics.w) ||
+        ((flags & GRID_LEFT) && cellX < lineMetrics.w) ||
+        ((flags & GRID_RIGHT) && cellX >= viewport.z - lineMetrics.w))
+    {
+        coverage = 1;
+    }
+
+    bool cursor = false;
+    if (cursorOptions.x)
+    {
+        const float2 position = input.position.xy;
+        cursor = insideRect(position, cursorRect) || insideRect(position, cursorRect2);
+        if (cursor && cursorOptions.y)
+        {
+            // Only the outline of an empty box is drawn.
+            cursor = !insideRect(position, cursorRect + float4(1, 1, -1, -1));
+        }
+    }
+
+    float4 background = input.background;
+    if (cursor && !cursorOptions.z && cursorOptions.w)
+    {
+        background = float4(cursorColor.rgb, 1);
+    }
+
+    // Premultiplied alpha, as required by the swap chain.
+    float4 color = float4(background.rgb * background.a * (1 - coverage) + input.foreground.rgb * coverage,
+                          background.a * (1 - coverage) + coverage);
+
+    if (flags & SELECTED)
+    {
+        color = float4(selectionColor.rgb * selectionColor.a, selectionColor.a) + color * (1 - selectionColor.a);
+    }
+
+    if (cursor)
+    {
+        if (cursorOptions.z)
+        {
+            // There's nothing to invert on a transparent background,
+            // so the inversion happens on top of an opaque background.
+            const float3 opaque = background.rgb * (1 - coverage) + input.foreground.rgb * coverage;
+            color = float4(1 - opaque, 1);
+        }
+        else if (!cursorOptions.w)
+        {
+            color = float4(cursorColor.rgb, 1);
+        }
+    }
+
+    return color;
+}
+)";
+
+#undef ATLAS_SHADER_COMMON
+#endif
@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "BoxGlyphs.h"
+
+using namespace Microsoft::Console::Render;
+
+// The weight of the line running from the center of the cell towards each of
+// its edges is stored in 2 bits each: up, right, down and left, in that order.
+// A weight of 0 means no line, 1 a light and 2 a heavy line.
+static constexpr uint8_t Arms(const uint8_t up, const uint8_t right, const uint8_t down, const uint8_t left) noexcept
+{
+    return gsl::narrow_cast<uint8_t>(up | right << 2 | down << 4 | left << 6);
+}
+
+// Dashed lines, arcs and diagonals aren't made of solid rectangles. We leave those
+// to the font, just like the double lines, which are built separately below.
+static constexpr uint8_t NoArms = 0;
+
+static constexpr std::array<uint8_t, 0x80> s_lineArms{
+    Arms(0, 1, 0, 1), Arms(0, 2, 0, 2), Arms(1, 0, 1, 0), Arms(2, 0, 2, 0), // U+2500
+    NoArms, NoArms, NoArms, NoArms, // U+2504
+    NoArms, NoArms, NoArms, NoArms, // U+2508
+    Arms(0, 1, 1, 0), Arms(0, 2, 1, 0), Arms(0, 1, 2, 0), Arms(0, 2, 2, 0), // U+250C
+    Arms(0, 0, 1, 1), Arms(0, 0, 1, 2), Arms(0, 0, 2, 1), Arms(0, 0, 2, 2), // U+2510
+    Arms(1, 1, 0, 0), Arms(1, 2, 0, 0), Arms(2, 1, 0, 0), Arms(2, 2, 0, 0), // U+2514
+    Arms(1, 0, 0, 1), Arms(1, 0, 0, 2), Arms(2, 0, 0, 1), Arms(2, 0, 0, 2), // U+2518
+    Arms(1, 1, 1, 0), Arms(1, 2, 1, 0), Arms(2, 1, 1, 0), Arms(1, 1, 2, 0), // U+251C
+    Arms(2, 1, 2, 0), Arms(2, 2, 1, 0), Arms(1, 2, 2, 0), Arms(2, 2, 2, 0), // U+2520
+    Arms(1, 0, 1, 1), Arms(1, 0, 1, 2), Arms(2, 0, 1, 1), Arms(1, 0, 2, 1), // U+2524
+    Arms(2, 0, 2, 1), Arms(2, 0, 1, 2), Arms(1, 0, 2, 2), Arms(2, 0, 2, 2), // U+2528
+    Arms(0, 1, 1, 1), Arms(0, 1, 1, 2), Arms(0, 2, 1, 1), Arms(0, 2, 1, 2), // U+252C
+    Arms(0, 1, 2, 1), Arms(0, 1, 2, 2), Arms(0, 2, 2, 1), Arms(0, 2, 2, 2), // U+2530
+    Arms(1, 1, 0, 1), Arms(1, 1, 0, 2), Arms(1, 2, 0, 1), Arms(1, 2, 0, 2), // U+2534
+    Arms(2, 1, 0, 1), Arms(2, 1, 0, 2), Arms(2, 2, 0, 1), Arms(2, 2, 0, 2), // U+2538
+    Arms(1, 1, 1, 1), Arms(1, 1, 1, 2), Arms(1, 2, 1, 1), Arms(1, 2, 1, 2), // U+253C
+    Arms(2, 1, 1, 1), Arms(1, 1, 2, 1), Arms(2, 1, 2, 1), Arms(2, 1, 1, 2), // U+2540
+    Arms(2, 2, 1, 1), Arms(1, 1, 2, 2), Arms(1, 2, 2, 1), Arms(2, 2, 1, 2), // U+2544
+    Arms(1, 2, 2, 2), Arms(2, 1, 2, 2), Arms(2, 2, 2, 1), Arms(2, 2, 2, 2), // U+2548
+    NoArms, NoArms, NoArms, NoArms, // U+254C
+    NoArms, NoArms, NoArms, NoArms, // U+2550
+    NoArms, NoArms, NoArms, NoArms, // U+2554
+    NoArms, NoArms, NoArms, NoArms, // U+2558
+    NoArms, NoArms, NoArms, NoArms, // U+255C
+    NoArms, NoArms, NoArms, NoArms, // U+2560
+    NoArms, NoArms, NoArms, NoArms, // U+2564
+    NoArms, NoArms, NoArms, NoArms, // U+2568
+    NoArms, NoArms, NoArms, NoArms, // U+256C
+    NoArms, NoArms, NoArms, NoArms, // U+2570
+    Arms(0, 0, 0, 1), Arms(1, 0, 0, 0), Arms(0, 1, 0, 0), Arms(0, 0, 1, 0), // U+2574
+    Arms(0, 0, 0, 2), Arms(2, 0, 0, 0), Arms(0, 2, 0, 0), Arms(0, 0, 2, 0), // U+2578
+    Arms(0, 2, 0, 1), Arms(1, 0, 2, 0), Arms(0, 1, 0, 2), Arms(2, 0, 1, 0), // U+257C
+};
+
+// Routine Description:
+// - Builds the rectangles of all box drawing and block element characters
+//   for the given cell size.
+// Arguments:
+// - cellSize - The size of a cell in pixels
+// - lineWidth - The width of a light line in pixels. We use the underline
+//   thickness of the font for this, so that the lines match its stroke weight.
+BoxGlyphs::BoxGlyphs(const til::size cellSize, const float lineWidth)
+{
+    const auto width = cellSize.width<float>();
+    const auto height = cellSize.height<float>();
+    const auto light = std::max(1.0f, std::round(lineWidth));
+
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < s_lineArms.size(); ++i)
+    {
+        const auto arms = til::at(s_lineArms, i);
+        if (arms != NoArms)
+        {
+            _AddLines(i, arms, width, height, light);
+        }
+    }
+
+    // Double lines need room for two lines and a gap in between.
+    if (3 * light <= width && 3 * light <= height)
+    {
+        _AddDoubleLines(width, height, light);
+    }
+
+    _AddBlocks(width, height);
+}
+
+// Routine Description:
+// - Returns the rectangles that make up the given character.
+// Arguments:
+// - wch - The character to look up
+// Return Value:
+// - The rectangles relative to the top left corner of the cell,
+//   or an empty span if the character needs to be drawn by the font.
+[[nodiscard]] gsl::span<const D2D1_RECT_F> BoxGlyphs::Lookup(const wchar_t wch) const noexcept
+{
+    if (wch < FirstGlyph || wch > LastGlyph)
+    {
+        return {};
+    }
+    return til::at(_rects, wch - FirstGlyph);
+}
+
+// Routine Description:
+// - Adds the rectangles of a light or heavy line character, which consist
+//   of up to 4 lines running from the center of the cell to its edges.
+// Arguments:
+// - index - The offset of the character from FirstGlyph
+// - arms - The weights of the lines, as packed by Arms()
+// - width, height - The cell size in pixels
+// - light - The width of a light line in pixels
+void BoxGlyphs::_AddLines(const size_t index, const uint8_t arms, const float width, const float height, const float light)
+{
+    const auto heavy = 2 * light;
+    const auto stroke = [=](const uint8_t weight) {
+        return weight == 0 ? 0.0f : weight == 1 ? light : heavy;
+    };
+    // Lines are centered in the cell, but rounded to full pixels so that they
+    // end up at the very same position in every cell.
+    const auto start = [](const float length, const float thickness) {
+        return std::floor((length - thickness) / 2);
+    };
+
+    const auto up = stroke(arms & 3);
+    const auto right = stroke(arms >> 2 & 3);
+    const auto down = stroke(arms >> 4 & 3);
+    const auto left = stroke(arms >> 6 & 3);
+
+    // Horizontal lines reach across the widest vertical line and vice versa,
+    // which closes the corners. A lone half line stops right after the center.
+    const auto vertical = std::max(up, down);
+    const auto horizontal = std::max(left, right);
+
+    auto& rects = til::at(_rects, index);
+    if (left != 0)
+    {
+        const auto overlap = vertical != 0 ? vertical : left;
+        const auto y = start(height, left);
+        rects.push_back({ 0, y, start(width, overlap) + overlap, y + left });
+    }
+    if (right != 0)
+    {
+        const auto overlap = vertical != 0 ? vertical : right;
+        const auto y = start(height, right);
+        rects.push_back({ start(width, overlap), y, width, y + right });
+    }
+    if (up != 0)
+    {
+        const auto overlap = horizontal != 0 ? horizontal : up;
+        const auto x = start(width, up);
+        rects.push_back({ x, 0, x + up, start(height, overlap) + overlap });
+    }
+    if (down != 0)
+    {
+        const auto overlap = horizontal != 0 ? horizontal : down;
+        const auto x = start(width, down);
+        rects.push_back({ x, start(height, overlap), x + down, height });
+    }
+}
+
+// Routine Description:
+// - Adds the rectangles of the double line characters that don't mix in
+//   single lines, which covers the frames that double lines are used for.
+// Arguments:
+// - width, height - The cell size in pixels
+// - light - The width of each of the two lines in pixels
+void BoxGlyphs::_AddDoubleLines(const float width, const float height, const float light)
+{
+    // The outer and inner edges of the two lines, left to right and top to bottom.
+    const auto x0 = std::floor((width - 3 * light) / 2);
+    const auto x1 = x0 + light;
+    const auto x2 = x1 + light;
+    const auto x3 = x2 + light;
+    const auto y0 = std::floor((height - 3 * light) / 2);
+    const auto y1 = y0 + light;
+    const auto y2 = y1 + light;
+    const auto y3 = y2 + light;
+
+    const auto add = [&](const wchar_t wch, std::initializer_list<D2D1_RECT_F> rects) {
+        til::at(_rects, wch - FirstGlyph).assign(rects);
+    };
+
+    // The corners with an up and left, up and right, ... pair of lines.
+    const D2D1_RECT_F upLeft[]{ { 0, y0, x1, y1 }, { x0, 0, x1, y1 } };
+    const D2D1_RECT_F upRight[]{ { x2, y0, width, y1 }, { x2, 0, x3, y1 } };
+    const D2D1_RECT_F downLeft[]{ { 0, y2, x1, y3 }, { x0, y2, x1, height } };
+    const D2D1_RECT_F downRight[]{ { x2, y2, width, y3 }, { x2, y2, x3, height } };
+
+    add(0x2550, { { 0, y0, width, y1 }, { 0, y2, width, y3 } });
+    add(0x2551, { { x0, 0, x1, height }, { x2, 0, x3, height } });
+    add(0x2554, { { x0, y0, width, y1 }, { x0, y0, x1, height }, downRight[0], downRight[1] });
+    add(0x2557, { { 0, y0, x3, y1 }, { x2, y0, x3, height }, downLeft[0], downLeft[1] });
+    add(0x255A, { { x0, 0, x1, y3 }, { x0, y2, width, y3 }, upRight[0], upRight[1] });
+    add(0x255D, { { x2, 0, x3, y3 }, { 0, y2, x3, y3 }, upLeft[0], upLeft[1] });
+    add(0x2560, { { x0, 0, x1, height }, upRight[0], upRight[1], downRight[0], downRight[1] });
+    add(0x2563, { { x2, 0, x3, height }, upLeft[0], upLeft[1], downLeft[0], downLeft[1] });
+    add(0x2566, { { 0, y0, width, y1 }, downLeft[0], downLeft[1], downRight[0], downRight[1] });
+    add(0x2569, { { 0, y2, width, y3 }, upLeft[0], upLeft[1], upRight[0], upRight[1] });
+    add(0x256C, { upLeft[0], upLeft[1], upRight[0], upRight[1], downLeft[0], downLeft[1], downRight[0], downRight[1] });
+}
+
+// Routine Description:
+// - Adds the rectangles of the block elements, except for the shades.
+// Arguments:
+// - width, height - The cell size in pixels
+void BoxGlyphs::_AddBlocks(const float width, const float height)
+{
+    // Block elements are sized in eighths of the cell.
+    const auto x = [=](const int eighths) { return std::round(width * eighths / 8); };
+    const auto y = [=](const int eighths) { return std::round(height * eighths / 8); };
+
+    const auto add = [&](const wchar_t wch, std::initializer_list<D2D1_RECT_F> rects) {
+        til::at(_rects, wch - FirstGlyph).assign(rects);
+    };
+
+    add(0x2580, { { 0, 0, width, y(4) } });
+    // U+2581 to U+2588 are the lower 1/8 to 8/8 blocks...
+    for (int i = 1; i <= 8; ++i)
+    {
+        add(gsl::narrow_cast<wchar_t>(0x2580 + i), { { 0, y(8 - i), width, height } });
+    }
+    // ...and U+2589 to U+258F the left 7/8 to 1/8 blocks.
+    for (int i = 1; i <= 7; ++i)
+    {
+        add(gsl::narrow_cast<wchar_t>(0x2588 + i), { { 0, 0, x(8 - i), height } });
+    }
+    add(0x2590, { { x(4), 0, width, height } });
+    add(0x2594, { { 0, 0, width, y(1) } });
+    add(0x2595, { { x(7), 0, width, height } });
+
+    const D2D1_RECT_F upperLeft{ 0, 0, x(4), y(4) };
+    const D2D1_RECT_F upperRight{ x(4), 0, width, y(4) };
+    const D2D1_RECT_F lowerLeft{ 0, y(4), x(4), height };
+    const D2D1_RECT_F lowerRight{ x(4), y(4), width, height };
+
+    add(0x2596, { lowerLeft });
+    add(0x2597, { lowerRight });
+    add(0x2598, { upperLeft });
+    add(0x2599, { upperLeft, lowerLeft, lowerRight });
+    add(0x259A, { upperLeft, lowerRight });
+    add(0x259B, { upperLeft, upperRight, lowerLeft });
+    add(0x259C, { upperLeft, upperRight, lowerRight });
+    add(0x259D, { upperRight });
+    add(0x259E, { upperRight, lowerLeft });
+    add(0x259F, { upperRight, lowerLeft, lowerRight });
+}
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <d2d1.h>
+
+namespace Microsoft::Console::Render
+{
+    // BoxGlyphs holds the geometry of the box drawing (U+2500-U+257F) and block
+    // element (U+2580-U+259F) characters for one cell size, as a list of rectangles
+    // in pixels relative to the top left corner of the cell.
+    // These characters are supposed to connect seamlessly with their neighbors,
+    // which the font's own outlines rarely do once they're fit into our cells.
+    class BoxGlyphs
+    {
+    public:
+        static constexpr wchar_t FirstGlyph = 0x2500;
+        static constexpr wchar_t LastGlyph = 0x259F;
+
+        BoxGlyphs() = default;
+        BoxGlyphs(const til::size cellSize, const float lineWidth);
+
+        [[nodiscard]] gsl::span<const D2D1_RECT_F> Lookup(const wchar_t wch) const noexcept;
+
+    private:
+        void _AddLines(const size_t index, const uint8_t arms, const float width, const float height, const float light);
+        void _AddDoubleLines(const float width, const float height, const float light);
+        void _AddBlocks(const float width, const float height);
+
+        std::array<std::vector<D2D1_RECT_F>, LastGlyph - FirstGlyph + 1> _rects;
+    };
+}
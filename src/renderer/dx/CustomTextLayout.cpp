@@ -18,7 +18,8 @@ using namespace Microsoft::Console::Render;
 // - Creates a CustomTextLayout object for calculating which glyphs should be placed and where
 // Arguments:
 // - dxFontRenderData - The DirectWrite font render data for our layout
-CustomTextLayout::CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRenderData) :
+// - shapedLineCacheSize - The number of recently drawn lines to keep the final layout of
+CustomTextLayout::CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRenderData, const size_t shapedLineCacheSize) :
     _fontRenderData{ fontRenderData },
     _formatInUse{ fontRenderData->DefaultTextFormat().Get() },
     _fontInUse{ fontRenderData->DefaultFontFace().Get() },
@@ -28,7 +29,8 @@ CustomTextLayout::CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRe
     _breakpoints{},
     _runIndex{ 0 },
     _width{ gsl::narrow_cast<size_t>(fontRenderData->GlyphCell().width()) },
-    _isEntireTextSimple{ false }
+    _isEntireTextSimple{ false },
+    _shapedLineCacheSize{ shapedLineCacheSize }
 {
     _localeName.resize(gsl::narrow_cast<size_t>(fontRenderData->DefaultTextFormat()->GetLocaleNameLength()) + 1); // +1 for null
     THROW_IF_FAILED(fontRenderData->DefaultTextFormat()->GetLocaleName(_localeName.data(), gsl::narrow<UINT32>(_localeName.size())));
@@ -47,6 +49,7 @@ try
     _breakpoints.clear();
     _runIndex = 0;
     _isEntireTextSimple = false;
+    _isPrepared = false;
     _textClusterColumns.clear();
     _text.clear();
     _glyphScaleCorrections.clear();
@@ -114,11 +117,45 @@ CATCH_RETURN()
     return S_OK;
 }
 
+// Routine Description:
+// - Analyzes the text for complexity and shapes up the glyphs, without drawing them.
+// - This doesn't touch the Direct2D device context, so lines can be prepared on any
+//   thread, as long as each of them has a layout of its own. Draw then only has to
+//   put the prepared glyphs onto the screen.
+// Arguments:
+// - useItalicFont - Whether the text will be drawn with the italic font
+// Return Value:
+// - S_OK or suitable DirectX/DirectWrite/Direct2D result code.
+[[nodiscard]] HRESULT STDMETHODCALLTYPE CustomTextLayout::Prepare(const bool useItalicFont) noexcept
+{
+    _formatInUse = useItalicFont ? _fontRenderData->ItalicTextFormat().Get() : _fontRenderData->DefaultTextFormat().Get();
+    _fontInUse = useItalicFont ? _fontRenderData->ItalicFontFace().Get() : _fontRenderData->DefaultFontFace().Get();
+
+    const auto hash = _HashLine();
+    if (!_RestoreShapedLine(hash))
+    {
+        RETURN_IF_FAILED(_AnalyzeTextComplexity());
+        RETURN_IF_FAILED(_AnalyzeRuns());
+        RETURN_IF_FAILED(_ShapeGlyphRuns());
+        RETURN_IF_FAILED(_CorrectGlyphRuns());
+        // Correcting box drawing has to come after both font fallback and
+        // the glyph run advance correction (which will apply a font size scaling factor).
+        // We need to know all the proposed X and Y dimension metrics to get this right.
+        RETURN_IF_FAILED(_CorrectBoxDrawing());
+
+        _StoreShapedLine(hash);
+    }
+
+    _isPrepared = true;
+    return S_OK;
+}
+
 // Routine Description:
 // - Implements a drawing interface similarly to the default IDWriteTextLayout which will
 //   take the string from construction, analyze it for complexity, shape up the glyphs,
 //   and then draw the final product to the given renderer at the point and pass along
 //   the context information.
+// - If the text was already prepared (see Prepare), it's only drawn.
 // - This specific class does the layout calculations and complexity analysis, not the
 //   final drawing. That's the renderer's job (passed in.)
 // Arguments:
@@ -134,18 +171,11 @@ CATCH_RETURN()
                                                                FLOAT originX,
                                                                FLOAT originY) noexcept
 {
-    const auto drawingContext = static_cast<const DrawingContext*>(clientDrawingContext);
-    _formatInUse = drawingContext->useItalicFont ? _fontRenderData->ItalicTextFormat().Get() : _fontRenderData->DefaultTextFormat().Get();
-    _fontInUse = drawingContext->useItalicFont ? _fontRenderData->ItalicFontFace().Get() : _fontRenderData->DefaultFontFace().Get();
-
-    RETURN_IF_FAILED(_AnalyzeTextComplexity());
-    RETURN_IF_FAILED(_AnalyzeRuns());
-    RETURN_IF_FAILED(_ShapeGlyphRuns());
-    RETURN_IF_FAILED(_CorrectGlyphRuns());
-    // Correcting box drawing has to come after both font fallback and
-    // the glyph run advance correction (which will apply a font size scaling factor).
-    // We need to know all the proposed X and Y dimension metrics to get this right.
-    RETURN_IF_FAILED(_CorrectBoxDrawing());
+    if (!_isPrepared)
+    {
+        const auto drawingContext = static_cast<const DrawingContext*>(clientDrawingContext);
+        RETURN_IF_FAILED(Prepare(drawingContext->useItalicFont));
+    }
 
     RETURN_IF_FAILED(_DrawGlyphRuns(clientDrawingContext, renderer, { originX, originY }));
 
@@ -918,7 +948,7 @@ CATCH_RETURN();
         DWRITE_GLYPH_RUN_DESCRIPTION glyphRunDescription;
         glyphRunDescription.clusterMap = _glyphClusters.data();
         glyphRunDescription.localeName = _localeName.data();
-        glyphRunDescription.string = _text.data();
+        glyphRunDescription.string = &_text.at(run.textStart);
         glyphRunDescription.stringLength = run.textLength;
         glyphRunDescription.textPosition = run.textStart;
 
@@ -969,6 +999,84 @@ CATCH_RETURN();
     return 3 * textLength / 2 + 16;
 }
 
+// Routine Description:
+// - Hashes everything the final layout of the current text depends on:
+//   the text, the columns the buffer assigned to it and the text format.
+//   The format is immutable and thus stands in for the font face, size and weight.
+// Arguments:
+// - <none> - Uses internal state
+// Return Value:
+// - The hash of the line
+[[nodiscard]] size_t CustomTextLayout::_HashLine() const noexcept
+{
+    auto hash = std::hash<std::wstring_view>{}(_text);
+    const auto combine = [&](const size_t value) noexcept {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    for (const auto columns : _textClusterColumns)
+    {
+        combine(columns);
+    }
+    combine(std::hash<const void*>{}(_formatInUse));
+    return hash;
+}
+
+// Routine Description:
+// - Looks for a cached layout of the current text and, if one is found,
+//   loads its runs and glyphs as if the text had just been shaped.
+// Arguments:
+// - hash - The hash of the current line, see _HashLine
+// Return Value:
+// - true if the layout was restored from the cache
+[[nodiscard]] bool CustomTextLayout::_RestoreShapedLine(const size_t hash) noexcept
+try
+{
+    const auto it = std::find_if(_shapedLines.begin(), _shapedLines.end(), [&](const ShapedLine& line) {
+        return line.hash == hash && line.format == _formatInUse && line.text == _text && line.textClusterColumns == _textClusterColumns;
+    });
+    if (it == _shapedLines.end())
+    {
+        return false;
+    }
+
+    _shapedLines.splice(_shapedLines.begin(), _shapedLines, it);
+
+    const auto& line = _shapedLines.front();
+    _isEntireTextSimple = line.isEntireTextSimple;
+    _runs = line.runs;
+    _glyphClusters = line.glyphClusters;
+    _glyphIndices = line.glyphIndices;
+    _glyphAdvances = line.glyphAdvances;
+    _glyphOffsets = line.glyphOffsets;
+    return true;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    // The members might be partially overwritten. Make sure the line is laid out from scratch.
+    _runs.clear();
+    return false;
+}
+
+// Routine Description:
+// - Caches the final layout of the current text, evicting the least recently used line if necessary.
+// Arguments:
+// - hash - The hash of the current line, see _HashLine
+// Return Value:
+// - <none>
+void CustomTextLayout::_StoreShapedLine(const size_t hash) noexcept
+try
+{
+    ShapedLine line{ hash, _formatInUse, _text, _textClusterColumns, _isEntireTextSimple, _runs, _glyphClusters, _glyphIndices, _glyphAdvances, _glyphOffsets };
+    _shapedLines.emplace_front(std::move(line));
+    if (_shapedLines.size() > _shapedLineCacheSize)
+    {
+        _shapedLines.pop_back();
+    }
+}
+CATCH_LOG()
+
 #pragma region IDWriteTextAnalysisSource methods
 // Routine Description:
 // - Implementation of IDWriteTextAnalysisSource::GetTextAtPosition
@@ -1246,16 +1354,14 @@ CATCH_RETURN();
             fallback = _fontRenderData->SystemFontFallback();
         }
 
-        // Walk through and analyze the entire string
-        while (textLength > 0)
-        {
+        const auto mapCharacters = [&](UINT32 position, UINT32 length, DxFontRenderData::FontFallback& mapped) {
             UINT32 mappedLength = 0;
             ::Microsoft::WRL::ComPtr<IDWriteFont> mappedFont;
             FLOAT scale = 0.0f;
 
             fallback->MapCharacters(source,
-                                    textPosition,
-                                    textLength,
+                                    position,
+                                    length,
                                     collection.Get(),
                                     familyName.data(),
                                     weight,
@@ -1265,10 +1371,76 @@ CATCH_RETURN();
                                     &mappedFont,
                                     &scale);
 
-            RETURN_IF_FAILED(_SetMappedFont(textPosition, mappedLength, mappedFont.Get(), scale));
+            mapped.fontFace.Reset();
+            mapped.scale = scale;
+            if (mappedFont)
+            {
+                ::Microsoft::WRL::ComPtr<IDWriteFontFace> face;
+                THROW_IF_FAILED(mappedFont->CreateFontFace(&face));
+                THROW_IF_FAILED(face.As(&mapped.fontFace));
+            }
+            return mappedLength;
+        };
 
-            textPosition += mappedLength;
-            textLength -= mappedLength;
+        // Walk through the string one text cluster at a time. The font a cluster maps to only
+        // depends on its text, so the result is cached across layouts by the font render data.
+        // Consecutive clusters mapped to the same font are coalesced into a single run.
+        const auto textEnd = textPosition + textLength;
+        auto runStart = textPosition;
+        DxFontRenderData::FontFallback runFont{ nullptr, 1.0f };
+
+        for (auto clusterStart = textPosition; clusterStart < textEnd;)
+        {
+            auto clusterEnd = clusterStart + 1;
+            while (clusterEnd < textEnd && _textClusterColumns.at(clusterEnd) == 0)
+            {
+                ++clusterEnd;
+            }
+
+            const std::wstring_view cluster{ &_text.at(clusterStart), gsl::narrow_cast<size_t>(clusterEnd - clusterStart) };
+            DxFontRenderData::FontFallback clusterFont{};
+            if (const auto cached = _fontRenderData->FindFontFallback(_formatInUse, cluster))
+            {
+                clusterFont = *cached;
+            }
+            else if (mapCharacters(clusterStart, clusterEnd - clusterStart, clusterFont) >= clusterEnd - clusterStart)
+            {
+                _fontRenderData->CacheFontFallback(_formatInUse, cluster, clusterFont);
+            }
+            else
+            {
+                // The cluster is covered by more than one font. This is rare enough that
+                // it's simply mapped piece by piece, without caching the result.
+                if (runStart < clusterStart)
+                {
+                    RETURN_IF_FAILED(_SetMappedFont(runStart, clusterStart - runStart, runFont.fontFace.Get(), runFont.scale));
+                }
+
+                for (auto position = clusterStart; position < clusterEnd;)
+                {
+                    const auto mappedLength = std::max(mapCharacters(position, clusterEnd - position, clusterFont), 1u);
+                    RETURN_IF_FAILED(_SetMappedFont(position, mappedLength, clusterFont.fontFace.Get(), clusterFont.scale));
+                    position += mappedLength;
+                }
+
+                runStart = clusterEnd;
+                clusterStart = clusterEnd;
+                continue;
+            }
+
+            if (runStart < clusterStart && (clusterFont.fontFace != runFont.fontFace || clusterFont.scale != runFont.scale))
+            {
+                RETURN_IF_FAILED(_SetMappedFont(runStart, clusterStart - runStart, runFont.fontFace.Get(), runFont.scale));
+                runStart = clusterStart;
+            }
+
+            runFont = std::move(clusterFont);
+            clusterStart = clusterEnd;
+        }
+
+        if (runStart < textEnd)
+        {
+            RETURN_IF_FAILED(_SetMappedFont(runStart, textEnd - runStart, runFont.fontFace.Get(), runFont.scale));
         }
     }
     CATCH_RETURN();
@@ -1282,13 +1454,13 @@ CATCH_RETURN();
 // Arguments:
 // - textPosition - the index to start the substring operation
 // - textLength - the length of the substring operation
-// - font - the font that applies to the substring range
+// - fontFace - the font face that applies to the substring range, or nullptr for the font in use
 // - scale - the scale of the font to apply
 // Return Value:
 // - S_OK or appropriate STL/GSL failure code.
 [[nodiscard]] HRESULT STDMETHODCALLTYPE CustomTextLayout::_SetMappedFont(UINT32 textPosition,
                                                                          UINT32 textLength,
-                                                                         _In_ IDWriteFont* const font,
+                                                                         _In_opt_ IDWriteFontFace1* const fontFace,
                                                                          FLOAT const scale)
 {
     try
@@ -1299,19 +1471,7 @@ CATCH_RETURN();
         {
             auto& run = _FetchNextRun(textLength);
 
-            if (font != nullptr)
-            {
-                // Get font face from font metadata
-                ::Microsoft::WRL::ComPtr<IDWriteFontFace> face;
-                RETURN_IF_FAILED(font->CreateFontFace(&face));
-
-                // QI for Face5 interface from base face interface, store into run
-                RETURN_IF_FAILED(face.As(&run.fontFace));
-            }
-            else
-            {
-                run.fontFace = _fontInUse;
-            }
+            run.fontFace = fontFace ? fontFace : _fontInUse;
 
             // Store the font scale as well.
             run.fontScale = scale;
@@ -21,7 +21,7 @@ namespace Microsoft::Console::Render
     public:
         // Based on the Windows 7 SDK sample at https://github.com/pauldotknopf/WindowsSDK7-Samples/tree/master/multimedia/DirectWrite/CustomLayout
 
-        CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRenderData);
+        CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRenderData, const size_t shapedLineCacheSize = 256);
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE AppendClusters(const gsl::span<const ::Microsoft::Console::Render::Cluster> clusters);
 
@@ -29,6 +29,8 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE GetColumns(_Out_ UINT32* columns);
 
+        [[nodiscard]] HRESULT STDMETHODCALLTYPE Prepare(const bool useItalicFont) noexcept;
+
         // IDWriteTextLayout methods (but we don't actually want to implement them all, so just this one matching the existing interface)
         [[nodiscard]] HRESULT STDMETHODCALLTYPE Draw(_In_opt_ void* clientDrawingContext,
                                                      _In_ IDWriteTextRenderer* renderer,
@@ -126,7 +128,7 @@ namespace Microsoft::Console::Render
         void _OrderRuns();
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE _AnalyzeFontFallback(IDWriteTextAnalysisSource* const source, UINT32 textPosition, UINT32 textLength);
-        [[nodiscard]] HRESULT STDMETHODCALLTYPE _SetMappedFont(UINT32 textPosition, UINT32 textLength, IDWriteFont* const font, FLOAT const scale);
+        [[nodiscard]] HRESULT STDMETHODCALLTYPE _SetMappedFont(UINT32 textPosition, UINT32 textLength, IDWriteFontFace1* const fontFace, FLOAT const scale);
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE _AnalyzeBoxDrawing(gsl::not_null<IDWriteTextAnalysisSource*> const source, UINT32 textPosition, UINT32 textLength);
         [[nodiscard]] HRESULT STDMETHODCALLTYPE _SetBoxEffect(UINT32 textPosition, UINT32 textLength);
@@ -148,6 +150,10 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] static constexpr UINT32 _EstimateGlyphCount(const UINT32 textLength) noexcept;
 
+        [[nodiscard]] size_t _HashLine() const noexcept;
+        [[nodiscard]] bool _RestoreShapedLine(const size_t hash) noexcept;
+        void _StoreShapedLine(const size_t hash) noexcept;
+
     private:
         // DirectWrite font render data
         DxFontRenderData* _fontRenderData;
@@ -180,6 +186,9 @@ namespace Microsoft::Console::Render
         // Whether the entire text is determined to be simple and does not require full script shaping.
         bool _isEntireTextSimple;
 
+        // Whether the text was already analyzed and shaped by Prepare and only needs to be drawn.
+        bool _isPrepared = false;
+
         std::vector<DWRITE_GLYPH_OFFSET> _glyphOffsets;
 
         // Clusters are complicated. They're in respect to each individual run.
@@ -206,6 +215,29 @@ namespace Microsoft::Console::Render
         // These are used to further break the runs apart and adjust the font size so glyphs fit inside the cells.
         std::vector<ScaleCorrection> _glyphScaleCorrections;
 
+        // The final layout of a recently drawn line. Lines are usually redrawn
+        // without any changes to their text (prompts, status bars, ...),
+        // in which case we can skip analysis, font fallback and shaping.
+        struct ShapedLine
+        {
+            size_t hash;
+            IDWriteTextFormat* format;
+            std::wstring text;
+            std::vector<UINT16> textClusterColumns;
+            bool isEntireTextSimple;
+            std::vector<LinkedRun> runs;
+            std::vector<UINT16> glyphClusters;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+        };
+
+        size_t _shapedLineCacheSize = 256;
+
+        // Most recently used first. The layout is recreated whenever the font
+        // changes, which conveniently discards the cache as well.
+        std::list<ShapedLine> _shapedLines;
+
 #ifdef UNIT_TESTING
     public:
         CustomTextLayout() = default;
@@ -804,7 +804,7 @@ CATCH_RETURN()
                                                               D2D1_POINT_2F baselineOrigin,
                                                               DWRITE_MEASURING_MODE /*measuringMode*/,
                                                               _In_ const DWRITE_GLYPH_RUN* glyphRun,
-                                                              _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* /*glyphRunDescription*/,
+                                                              _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
                                                               _In_ IBoxDrawingEffect* clientDrawingEffect) noexcept
 try
 {
@@ -812,6 +812,13 @@ try
     RETURN_HR_IF_NULL(E_INVALIDARG, glyphRun);
     RETURN_HR_IF_NULL(E_INVALIDARG, clientDrawingEffect);
 
+    // Most of these characters are plain rectangles, which we can fill exactly
+    // to the cell without asking DirectWrite for (and then bending) the outlines.
+    if (_DrawBoxRunAsRectangles(clientDrawingContext, baselineOrigin, glyphRun, glyphRunDescription))
+    {
+        return S_OK;
+    }
+
     ::Microsoft::WRL::ComPtr<ID2D1Factory> d2dFactory;
     clientDrawingContext->renderTarget->GetFactory(d2dFactory.GetAddressOf());
 
@@ -918,6 +925,60 @@ try
 }
 CATCH_RETURN();
 
+// Routine Description:
+// - Draws a run of box drawing characters from the precomputed cell geometry
+//   of the font, if every one of its characters has one.
+// Arguments:
+// - clientDrawingContext - Various information required to draw, including the box glyph geometry
+// - baselineOrigin - The position of the baseline of the first cell
+// - glyphRun - The glyphs of the run, for their advances
+// - glyphRunDescription - The text of the run
+// Return Value:
+// - true if the run was drawn, false if it has to be drawn from the glyph outlines instead.
+[[nodiscard]] bool CustomTextRenderer::_DrawBoxRunAsRectangles(const DrawingContext* clientDrawingContext,
+                                                               D2D1_POINT_2F baselineOrigin,
+                                                               _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                               _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept
+{
+    // We need to know which character each glyph stands for, which is simple as long
+    // as every character got exactly one glyph. Box drawing characters don't combine.
+    if (!clientDrawingContext->boxGlyphs ||
+        !glyphRunDescription ||
+        !glyphRunDescription->string ||
+        !glyphRun->glyphAdvances ||
+        glyphRunDescription->stringLength != glyphRun->glyphCount ||
+        glyphRun->isSideways ||
+        WI_IsFlagSet(glyphRun->bidiLevel, 1))
+    {
+        return false;
+    }
+
+    const auto& boxGlyphs = *clientDrawingContext->boxGlyphs;
+    const std::wstring_view text{ glyphRunDescription->string, glyphRunDescription->stringLength };
+    if (std::any_of(text.begin(), text.end(), [&](const wchar_t wch) { return boxGlyphs.Lookup(wch).empty(); }))
+    {
+        return false;
+    }
+
+    const gsl::span<const FLOAT> advances{ glyphRun->glyphAdvances, glyphRun->glyphCount };
+    const auto top = std::round(baselineOrigin.y - clientDrawingContext->spacing.baseline);
+    auto left = baselineOrigin.x;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        // Snap every cell to full pixels, so that neighboring cells meet without a seam.
+        const auto x = std::round(left);
+        for (const auto& rect : boxGlyphs.Lookup(til::at(text, i)))
+        {
+            clientDrawingContext->renderTarget->FillRectangle({ x + rect.left, top + rect.top, x + rect.right, top + rect.bottom },
+                                                              clientDrawingContext->foregroundBrush);
+        }
+        left += til::at(advances, i);
+    }
+
+    return true;
+}
+
 [[nodiscard]] HRESULT CustomTextRenderer::_DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                             D2D1_POINT_2F baselineOrigin,
                                                             DWRITE_MEASURING_MODE /*measuringMode*/,
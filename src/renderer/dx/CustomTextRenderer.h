@@ -5,6 +5,7 @@
 
 #include <wrl/implements.h>
 #include "BoxDrawingEffect.h"
+#include "BoxGlyphs.h"
 #include "../../renderer/inc/CursorOptions.h"
 
 namespace Microsoft::Console::Render
@@ -25,6 +26,7 @@ namespace Microsoft::Console::Render
             foregroundBrush(foregroundBrush),
             backgroundBrush(backgroundBrush),
             useItalicFont(false),
+            boxGlyphs(nullptr),
             forceGrayscaleAA(forceGrayscaleAA),
             dwriteFactory(dwriteFactory),
             spacing(spacing),
@@ -39,6 +41,7 @@ namespace Microsoft::Console::Render
         ID2D1SolidColorBrush* foregroundBrush;
         ID2D1SolidColorBrush* backgroundBrush;
         bool useItalicFont;
+        const BoxGlyphs* boxGlyphs;
         bool forceGrayscaleAA;
         IDWriteFactory* dwriteFactory;
         DWRITE_LINE_SPACING spacing;
@@ -131,6 +134,11 @@ namespace Microsoft::Console::Render
                                                   _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
                                                   _In_ IBoxDrawingEffect* clientDrawingEffect) noexcept;
 
+        [[nodiscard]] bool _DrawBoxRunAsRectangles(const DrawingContext* clientDrawingContext,
+                                                   D2D1_POINT_2F baselineOrigin,
+                                                   _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                   _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept;
+
         [[nodiscard]] HRESULT _DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                 D2D1_POINT_2F baselineOrigin,
                                                 DWRITE_MEASURING_MODE measuringMode,
@@ -19,7 +19,8 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     _dwriteFactory(dwriteFactory),
     _glyphCell{},
     _lineMetrics({}),
-    _boxDrawingEffect{}
+    _boxDrawingEffect{},
+    _fontFallbackCacheStats{}
 {
 }
 
@@ -30,6 +31,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
 
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteFontFallback> DxFontRenderData::SystemFontFallback()
 {
+    const std::lock_guard<std::mutex> lock{ _fontFallbackLock };
     if (!_systemFontFallback)
     {
         ::Microsoft::WRL::ComPtr<IDWriteFactory2> factory2;
@@ -110,6 +112,11 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     return _boxDrawingEffect;
 }
 
+[[nodiscard]] const BoxGlyphs& DxFontRenderData::BoxGlyphGeometry() const noexcept
+{
+    return _boxGlyphs;
+}
+
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteTextFormat> DxFontRenderData::ItalicTextFormat() noexcept
 {
     return _dwriteTextFormatItalic;
@@ -120,6 +127,61 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     return _dwriteFontFaceItalic;
 }
 
+// Routine Description:
+// - Looks up the cached font fallback result for a text cluster.
+// Arguments:
+// - format - The text format the cluster is laid out with
+// - cluster - The text of the cluster
+// Return Value:
+// - A copy of the cached result or std::nullopt if the cluster hasn't been mapped yet.
+[[nodiscard]] std::optional<DxFontRenderData::FontFallback> DxFontRenderData::FindFontFallback(IDWriteTextFormat* const format, const std::wstring_view cluster)
+{
+    const std::lock_guard<std::mutex> lock{ _fontFallbackLock };
+    if (const auto formatIt = _fontFallbackCache.find(format); formatIt != _fontFallbackCache.end())
+    {
+        if (const auto it = formatIt->second.find(std::wstring{ cluster }); it != formatIt->second.end())
+        {
+            ++_fontFallbackCacheStats.hits;
+            return it->second;
+        }
+    }
+
+    ++_fontFallbackCacheStats.misses;
+    return std::nullopt;
+}
+
+// Routine Description:
+// - Stores the font fallback result for a text cluster, see FindFontFallback.
+// Arguments:
+// - format - The text format the cluster is laid out with
+// - cluster - The text of the cluster
+// - fallback - The font the cluster was mapped to
+// Return Value:
+// - <none>
+void DxFontRenderData::CacheFontFallback(IDWriteTextFormat* const format, const std::wstring_view cluster, FontFallback fallback)
+{
+    const std::lock_guard<std::mutex> lock{ _fontFallbackLock };
+    auto& clusters = _fontFallbackCache[format];
+    if (clusters.size() >= _fontFallbackCacheSize)
+    {
+        clusters.clear();
+    }
+    clusters.insert_or_assign(std::wstring{ cluster }, std::move(fallback));
+}
+
+// Routine Description:
+// - Gets the number of font fallback lookups that were answered by the cache,
+//   and the number of lookups that weren't, since the font was last updated.
+// Arguments:
+// - <none>
+// Return Value:
+// - The hit and miss counts
+[[nodiscard]] DxFontRenderData::FontFallbackCacheStats DxFontRenderData::GetFontFallbackCacheStats() const noexcept
+{
+    const std::lock_guard<std::mutex> lock{ _fontFallbackLock };
+    return _fontFallbackCacheStats;
+}
+
 // Routine Description:
 // - Updates the font used for drawing
 // Arguments:
@@ -134,6 +196,59 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     {
         _userLocaleName.clear();
 
+        // The cache is keyed by the text formats, which are about to be replaced.
+        _fontFallbackCache.clear();
+        _fontFallbackCacheStats = {};
+
+        SharedFontKey key{ std::wstring{ desired.GetFaceName() }, _GetUserLocaleName(), desired.GetWeight(), desired.GetEngineSize().Y, dpi };
+        auto font = s_FindSharedFont(key);
+        if (!font)
+        {
+            font = _CreateSharedFont(desired, dpi);
+            s_CacheSharedFont(std::move(key), font);
+        }
+
+        _dwriteTextAnalyzer = font->textAnalyzer;
+        _dwriteTextFormat = font->textFormat;
+        _dwriteTextFormatItalic = font->textFormatItalic;
+        _dwriteFontFace = font->fontFace;
+        _dwriteFontFaceItalic = font->fontFaceItalic;
+        _boxDrawingEffect = font->boxDrawingEffect;
+        _boxGlyphs = font->boxGlyphs;
+        _lineMetrics = font->lineMetrics;
+        _glyphCell = font->glyphCell;
+
+        // Unscaled is for the purposes of re-communicating this font back to the renderer again later.
+        // As such, we need to give the same original size parameter back here without padding
+        // or rounding or scaling manipulation.
+        actual.SetFromEngine(font->fontName,
+                             desired.GetFamily(),
+                             _dwriteTextFormat->GetFontWeight(),
+                             false,
+                             _glyphCell,
+                             desired.GetEngineSize());
+        actual.SetFallback(font->didFallback);
+
+        _sharedFont = std::move(font);
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Resolves the desired font and calculates everything that's derived from it
+//   for the given DPI, see SharedFont.
+// Arguments:
+// - desired - Information specifying the font that is requested
+// - dpi - The DPI of the screen
+// Return Value:
+// - The resolved font
+[[nodiscard]] std::shared_ptr<DxFontRenderData::SharedFont> DxFontRenderData::_CreateSharedFont(const FontInfoDesired& desired, const int dpi)
+{
+    auto font = std::make_shared<SharedFont>();
+
+    {
         std::wstring fontName(desired.GetFaceName());
         DWRITE_FONT_WEIGHT weight = static_cast<DWRITE_FONT_WEIGHT>(desired.GetWeight());
         DWRITE_FONT_STYLE style = DWRITE_FONT_STYLE_NORMAL;
@@ -264,7 +379,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
                                                          localeName.data(),
                                                          &format));
 
-        THROW_IF_FAILED(format.As(&_dwriteTextFormat));
+        THROW_IF_FAILED(format.As(&font->textFormat));
 
         // We also need to create an italic variant of the font face and text
         // format, based on the same parameters, but using an italic style.
@@ -286,18 +401,18 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
                                                          localeName.data(),
                                                          &formatItalic));
 
-        THROW_IF_FAILED(formatItalic.As(&_dwriteTextFormatItalic));
+        THROW_IF_FAILED(formatItalic.As(&font->textFormatItalic));
 
         Microsoft::WRL::ComPtr<IDWriteTextAnalyzer> analyzer;
         THROW_IF_FAILED(_dwriteFactory->CreateTextAnalyzer(&analyzer));
-        THROW_IF_FAILED(analyzer.As(&_dwriteTextAnalyzer));
+        THROW_IF_FAILED(analyzer.As(&font->textAnalyzer));
 
-        _dwriteFontFace = face;
-        _dwriteFontFaceItalic = faceItalic;
+        font->fontFace = face;
+        font->fontFaceItalic = faceItalic;
 
-        THROW_IF_FAILED(_dwriteTextFormat->SetLineSpacing(lineSpacing.method, lineSpacing.height, lineSpacing.baseline));
-        THROW_IF_FAILED(_dwriteTextFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR));
-        THROW_IF_FAILED(_dwriteTextFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP));
+        THROW_IF_FAILED(font->textFormat->SetLineSpacing(lineSpacing.method, lineSpacing.height, lineSpacing.baseline));
+        THROW_IF_FAILED(font->textFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR));
+        THROW_IF_FAILED(font->textFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP));
 
         // The scaled size needs to represent the pixel box that each character will fit within for the purposes
         // of hit testing math and other such multiplication/division.
@@ -305,20 +420,9 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
         coordSize.X = gsl::narrow<SHORT>(widthExact);
         coordSize.Y = gsl::narrow_cast<SHORT>(lineSpacing.height);
 
-        // Unscaled is for the purposes of re-communicating this font back to the renderer again later.
-        // As such, we need to give the same original size parameter back here without padding
-        // or rounding or scaling manipulation.
-        const COORD unscaled = desired.GetEngineSize();
-
-        const COORD scaled = coordSize;
-
-        actual.SetFromEngine(fontName,
-                             desired.GetFamily(),
-                             _dwriteTextFormat->GetFontWeight(),
-                             false,
-                             scaled,
-                             unscaled);
-        actual.SetFallback(didFallback);
+        font->fontName = fontName;
+        font->didFallback = didFallback;
+        font->glyphCell = coordSize;
 
         LineMetrics lineMetrics;
         // There is no font metric for the grid line width, so we use a small
@@ -368,16 +472,108 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
         lineMetrics.underlineOffset2 += lineMetrics.underlineWidth / 2.0f;
         lineMetrics.strikethroughOffset += lineMetrics.strikethroughWidth / 2.0f;
 
-        _lineMetrics = lineMetrics;
-
-        _glyphCell = actual.GetSize();
+        font->lineMetrics = lineMetrics;
 
         // Calculate and cache the box effect for the base font. Scale is 1.0f because the base font is exactly the scale we want already.
-        RETURN_IF_FAILED(s_CalculateBoxEffect(DefaultTextFormat().Get(), _glyphCell.width(), DefaultFontFace().Get(), 1.0f, &_boxDrawingEffect));
+        THROW_IF_FAILED(s_CalculateBoxEffect(font->textFormat.Get(), font->glyphCell.width(), font->fontFace.Get(), 1.0f, &font->boxDrawingEffect));
+
+        // The box drawing characters that are made of rectangles don't depend on the font face
+        // at all, apart from the width of their lines, so they're built once for the cell size.
+        font->boxGlyphs = BoxGlyphs{ font->glyphCell, lineMetrics.underlineWidth };
     }
-    CATCH_RETURN();
 
-    return S_OK;
+    return font;
+}
+
+// Routine Description:
+// - Looks up a font that was resolved before by any instance, see SharedFont.
+// Arguments:
+// - key - The desired font and DPI
+// Return Value:
+// - The font or nullptr if no instance uses it at the moment.
+[[nodiscard]] std::shared_ptr<DxFontRenderData::SharedFont> DxFontRenderData::s_FindSharedFont(const SharedFontKey& key)
+{
+    auto& cache = s_GetSharedFontCache();
+    const std::lock_guard<std::mutex> lock{ cache.lock };
+    for (const auto& [cachedKey, font] : cache.fonts)
+    {
+        if (cachedKey == key)
+        {
+            return font.lock();
+        }
+    }
+    return nullptr;
+}
+
+// Routine Description:
+// - Makes a font available to all instances, see s_FindSharedFont.
+//   The cache only holds weak references. A font is released once
+//   no instance uses it anymore and its entry is dropped on the next insertion.
+// Arguments:
+// - key - The desired font and DPI
+// - font - The resolved font
+// Return Value:
+// - <none>
+void DxFontRenderData::s_CacheSharedFont(SharedFontKey key, const std::shared_ptr<SharedFont>& font)
+{
+    auto& cache = s_GetSharedFontCache();
+    const std::lock_guard<std::mutex> lock{ cache.lock };
+    cache.fonts.erase(std::remove_if(cache.fonts.begin(), cache.fonts.end(), [&](const auto& entry) {
+                          return entry.first == key || entry.second.expired();
+                      }),
+                      cache.fonts.end());
+    cache.fonts.emplace_back(std::move(key), font);
+}
+
+DxFontRenderData::SharedFontCache& DxFontRenderData::s_GetSharedFontCache()
+{
+    static SharedFontCache cache;
+    return cache;
+}
+
+// Routine Description:
+// - Looks up whether a glyph was found to be wider than a cell before, see
+//   DxEngine::IsGlyphWideByFont. The results are shared by all instances
+//   using the same font.
+// Arguments:
+// - glyph - The text of the glyph
+// Return Value:
+// - Whether the glyph is wide or std::nullopt if it wasn't measured yet.
+[[nodiscard]] std::optional<bool> DxFontRenderData::FindGlyphWidth(const std::wstring_view glyph) const
+{
+    if (!_sharedFont)
+    {
+        return std::nullopt;
+    }
+
+    const std::lock_guard<std::mutex> lock{ _sharedFont->glyphWidthLock };
+    if (const auto it = _sharedFont->glyphWidths.find(std::wstring{ glyph }); it != _sharedFont->glyphWidths.end())
+    {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+// Routine Description:
+// - Stores whether a glyph is wider than a cell, see FindGlyphWidth.
+// Arguments:
+// - glyph - The text of the glyph
+// - isWide - Whether the glyph is wide
+// Return Value:
+// - <none>
+void DxFontRenderData::CacheGlyphWidth(const std::wstring_view glyph, const bool isWide)
+{
+    if (!_sharedFont)
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock{ _sharedFont->glyphWidthLock };
+    if (_sharedFont->glyphWidths.size() >= _glyphWidthCacheSize)
+    {
+        _sharedFont->glyphWidths.clear();
+    }
+    _sharedFont->glyphWidths.insert_or_assign(std::wstring{ glyph }, isWide);
 }
 
 // Routine Description:
@@ -5,6 +5,7 @@
 
 #include "../../renderer/inc/FontInfoDesired.hpp"
 #include "BoxDrawingEffect.h"
+#include "BoxGlyphs.h"
 
 #include <dwrite.h>
 #include <dwrite_1.h>
@@ -13,6 +14,8 @@
 
 #include <wrl.h>
 
+#include <mutex>
+
 namespace Microsoft::Console::Render
 {
     class DxFontRenderData
@@ -28,6 +31,20 @@ namespace Microsoft::Console::Render
             float strikethroughWidth;
         };
 
+        // The font a text cluster was mapped to by font fallback.
+        // A null fontFace means that the text format's own font is used.
+        struct FontFallback
+        {
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace1> fontFace;
+            float scale;
+        };
+
+        struct FontFallbackCacheStats
+        {
+            size_t hits;
+            size_t misses;
+        };
+
         DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwriteFactory) noexcept;
 
         // DirectWrite text analyzer from the factory
@@ -49,6 +66,9 @@ namespace Microsoft::Console::Render
         // Box drawing scaling effects that are cached for the base font across layouts
         [[nodiscard]] Microsoft::WRL::ComPtr<IBoxDrawingEffect> DefaultBoxDrawingEffect() noexcept;
 
+        // The cell geometry of the box drawing and block element characters for the current cell size
+        [[nodiscard]] const BoxGlyphs& BoxGlyphGeometry() const noexcept;
+
         // The italic variant of the format object representing the size and other text properties for italic text
         [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteTextFormat> ItalicTextFormat() noexcept;
 
@@ -57,9 +77,72 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& desired, FontInfo& fiFontInfo, const int dpi) noexcept;
 
+        // Font fallback results of previously laid out text clusters, per text format
+        [[nodiscard]] std::optional<FontFallback> FindFontFallback(IDWriteTextFormat* const format, const std::wstring_view cluster);
+        void CacheFontFallback(IDWriteTextFormat* const format, const std::wstring_view cluster, FontFallback fallback);
+        [[nodiscard]] FontFallbackCacheStats GetFontFallbackCacheStats() const noexcept;
+
+        // Whether a glyph is wider than a cell, per font and shared across instances
+        [[nodiscard]] std::optional<bool> FindGlyphWidth(const std::wstring_view glyph) const;
+        void CacheGlyphWidth(const std::wstring_view glyph, const bool isWide);
+
         [[nodiscard]] static HRESULT STDMETHODCALLTYPE s_CalculateBoxEffect(IDWriteTextFormat* format, size_t widthPixels, IDWriteFontFace1* face, float fontScale, IBoxDrawingEffect** effect) noexcept;
 
     private:
+        // Everything UpdateFont derives from the desired font and the DPI.
+        // Each pane of a window has its own instance, but they usually all use
+        // the same font. So it's only resolved once and then shared between
+        // the instances (see s_FindSharedFont), along with the glyph widths
+        // that are measured with it. DirectWrite objects are thread-safe.
+        struct SharedFont
+        {
+            std::wstring fontName;
+            bool didFallback{ false };
+            til::size glyphCell;
+            LineMetrics lineMetrics{};
+
+            ::Microsoft::WRL::ComPtr<IDWriteTextAnalyzer1> textAnalyzer;
+            ::Microsoft::WRL::ComPtr<IDWriteTextFormat> textFormat;
+            ::Microsoft::WRL::ComPtr<IDWriteTextFormat> textFormatItalic;
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace1> fontFace;
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace1> fontFaceItalic;
+
+            ::Microsoft::WRL::ComPtr<IBoxDrawingEffect> boxDrawingEffect;
+            BoxGlyphs boxGlyphs;
+
+            std::mutex glyphWidthLock;
+            std::unordered_map<std::wstring, bool> glyphWidths;
+        };
+
+        struct SharedFontKey
+        {
+            std::wstring faceName;
+            std::wstring localeName;
+            unsigned int weight;
+            SHORT size;
+            int dpi;
+
+            bool operator==(const SharedFontKey& other) const noexcept
+            {
+                return faceName == other.faceName &&
+                       localeName == other.localeName &&
+                       weight == other.weight &&
+                       size == other.size &&
+                       dpi == other.dpi;
+            }
+        };
+
+        struct SharedFontCache
+        {
+            std::mutex lock;
+            std::vector<std::pair<SharedFontKey, std::weak_ptr<SharedFont>>> fonts;
+        };
+
+        [[nodiscard]] std::shared_ptr<SharedFont> _CreateSharedFont(const FontInfoDesired& desired, const int dpi);
+        [[nodiscard]] static std::shared_ptr<SharedFont> s_FindSharedFont(const SharedFontKey& key);
+        static void s_CacheSharedFont(SharedFontKey key, const std::shared_ptr<SharedFont>& font);
+        static SharedFontCache& s_GetSharedFontCache();
+
         [[nodiscard]] ::Microsoft::WRL::ComPtr<IDWriteFontFace1> _ResolveFontFaceWithFallback(std::wstring& familyName,
                                                                                               DWRITE_FONT_WEIGHT& weight,
                                                                                               DWRITE_FONT_STRETCH& stretch,
@@ -91,6 +174,7 @@ namespace Microsoft::Console::Render
         ::Microsoft::WRL::ComPtr<IDWriteFontFace1> _dwriteFontFaceItalic;
 
         ::Microsoft::WRL::ComPtr<IBoxDrawingEffect> _boxDrawingEffect;
+        BoxGlyphs _boxGlyphs;
 
         ::Microsoft::WRL::ComPtr<IDWriteFontFallback> _systemFontFallback;
         mutable ::Microsoft::WRL::ComPtr<IDWriteFontCollection1> _nearbyCollection;
@@ -99,5 +183,21 @@ namespace Microsoft::Console::Render
         til::size _glyphCell;
 
         LineMetrics _lineMetrics;
+
+        // Text can contain arbitrarily many distinct clusters. Once this many
+        // are cached for one format, the cache for that format starts over.
+        static constexpr size_t _fontFallbackCacheSize = 4096;
+
+        std::unordered_map<IDWriteTextFormat*, std::unordered_map<std::wstring, FontFallback>> _fontFallbackCache;
+        FontFallbackCacheStats _fontFallbackCacheStats;
+
+        // Lines may be laid out on several threads at once (see DxEngine::_DrawQueuedTextLines).
+        // This guards the font fallback cache and the lazily created system font fallback.
+        mutable std::mutex _fontFallbackLock;
+
+        // Like the font fallback cache, the glyph widths start over once this many are cached.
+        static constexpr size_t _glyphWidthCacheSize = 4096;
+
+        std::shared_ptr<SharedFont> _sharedFont;
     };
 }
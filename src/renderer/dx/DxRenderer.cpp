@@ -6,6 +6,7 @@
 #include "DxRenderer.hpp"
 #include "CustomTextLayout.h"
 
+#include "../../buffer/out/ImageSlice.hpp"
 #include "../../interactivity/win32/CustomWindowMessages.h"
 #include "../../types/inc/Viewport.hpp"
 #include "../../inc/unicode.hpp"
@@ -16,8 +17,12 @@
 #include "ScreenVertexShader.h"
 #include <DirectXMath.h>
 #include <d3dcompiler.h>
+#include <d3d11shader.h>
 #include <DirectXColors.h>
 
+#include <execution>
+#include <thread>
+
 using namespace DirectX;
 
 std::atomic<size_t> Microsoft::Console::Render::DxEngine::_tracelogCount{ 0 };
@@ -69,6 +74,9 @@ DxEngine::DxEngine() :
     _firstFrame{ true },
     _presentParams{ 0 },
     _presentReady{ false },
+    _onlyCursorInvalid{ false },
+    _windowOccluded{ false },
+    _presentOccluded{ false },
     _presentScroll{ 0 },
     _presentDirty{ 0 },
     _presentOffset{ 0 },
@@ -88,6 +96,7 @@ DxEngine::DxEngine() :
     _pixelShaderPath{},
     _forceFullRepaintRendering{ false },
     _softwareRendering{ false },
+    _softwareDevice{ false },
     _antialiasingMode{ D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE },
     _defaultTextBackgroundOpacity{ 1.0f },
     _hwndTarget{ static_cast<HWND>(INVALID_HANDLE_VALUE) },
@@ -96,9 +105,14 @@ DxEngine::DxEngine() :
     _scale{ 1.0f },
     _prevScale{ 1.0f },
     _chainMode{ SwapChainMode::ForComposition },
+    _hwndComposition{ false },
     _customLayout{},
     _customRenderer{ ::Microsoft::WRL::Make<CustomTextRenderer>() },
-    _drawingContext{}
+    _drawingContext{},
+    _queueTextLines{ false },
+    _queuedTextLines{},
+    _queuedTextLayouts{},
+    _queuedGridLines{}
 {
     const auto was = _tracelogCount.fetch_add(1);
     if (0 == was)
@@ -106,7 +120,8 @@ DxEngine::DxEngine() :
         TraceLoggingRegister(g_hDxRenderProvider);
     }
 
-    THROW_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, IID_PPV_ARGS(&_d2dFactory)));
+    _d2dFactory = s_GetSharedFactory();
+    THROW_IF_FAILED(_d2dFactory.As(&_d2dMultithread));
 
     THROW_IF_FAILED(DWriteCreateFactory(
         DWRITE_FACTORY_TYPE_SHARED,
@@ -229,6 +244,53 @@ _CompileShader(
 #endif
 }
 
+// Routine Description:
+// - Checks whether a compiled pixel shader reads the Time member of the
+//   settings we pass it. Only those shaders change without the frame changing.
+// - The settings are the first constant buffer and Time is their first member,
+//   so we look at what's at offset 0, whatever the shader chose to call it.
+// Arguments:
+// - blob - The compiled pixel shader
+// Return Value:
+// - true if the shader reads the time, or if we can't tell.
+inline bool _ShaderReadsTime(ID3DBlob* const blob) noexcept
+{
+#if !TIL_FEATURE_DXENGINESHADERSUPPORT_ENABLED
+    UNREFERENCED_PARAMETER(blob);
+    return false;
+#else
+    Microsoft::WRL::ComPtr<ID3D11ShaderReflection> reflection;
+    if (FAILED(D3DReflect(blob->GetBufferPointer(), blob->GetBufferSize(), IID_PPV_ARGS(&reflection))))
+    {
+        return true;
+    }
+
+    // A shader without constant buffers can't read the time at all.
+    // GetConstantBufferByIndex returns a dummy object whose GetDesc fails in that case.
+    const auto buffer = reflection->GetConstantBufferByIndex(0);
+    D3D11_SHADER_BUFFER_DESC bufferDesc{};
+    if (FAILED(buffer->GetDesc(&bufferDesc)))
+    {
+        return false;
+    }
+
+    for (UINT i = 0; i < bufferDesc.Variables; ++i)
+    {
+        D3D11_SHADER_VARIABLE_DESC variableDesc{};
+        if (FAILED(buffer->GetVariableByIndex(i)->GetDesc(&variableDesc)))
+        {
+            return true;
+        }
+        if (variableDesc.StartOffset == 0)
+        {
+            return WI_IsFlagSet(variableDesc.uFlags, D3D_SVF_USED);
+        }
+    }
+
+    return false;
+#endif
+}
+
 // Routine Description:
 // - Checks if terminal effects are enabled.
 // Arguments:
@@ -236,7 +298,7 @@ _CompileShader(
 // - True if terminal effects are enabled
 bool DxEngine::_HasTerminalEffects() const noexcept
 {
-    return _terminalEffectsEnabled && (_retroTerminalEffect || !_pixelShaderPath.empty());
+    return _terminalEffectsEnabled && !_softwareDevice && (_retroTerminalEffect || !_pixelShaderPath.empty());
 }
 
 // Routine Description:
@@ -247,6 +309,8 @@ bool DxEngine::_HasTerminalEffects() const noexcept
 void DxEngine::ToggleShaderEffects()
 {
     _terminalEffectsEnabled = !_terminalEffectsEnabled;
+    // We draw into a different target with effects (see _PrepareRenderTarget).
+    _recreateDeviceRequested = true;
     LOG_IF_FAILED(InvalidateAll());
 }
 
@@ -328,29 +392,8 @@ HRESULT DxEngine::_SetupTerminalEffects()
         return S_FALSE;
     }
 
-    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
-    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&swapBuffer));
-
-    // Setup render target.
-    RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(swapBuffer.Get(), nullptr, &_renderTargetView));
-
-    // Setup _framebufferCapture, to where we'll copy current frame when rendering effects.
-    D3D11_TEXTURE2D_DESC framebufferCaptureDesc{};
-    swapBuffer->GetDesc(&framebufferCaptureDesc);
-    WI_SetFlag(framebufferCaptureDesc.BindFlags, D3D11_BIND_SHADER_RESOURCE);
-    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&framebufferCaptureDesc, nullptr, &_framebufferCapture));
-
-    // Setup the viewport.
-    D3D11_VIEWPORT vp;
-    vp.Width = _displaySizePixels.width<float>();
-    vp.Height = _displaySizePixels.height<float>();
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0;
-    vp.TopLeftY = 0;
-    _d3dDeviceContext->RSSetViewports(1, &vp);
-
-    // Prepare shaders.
+    // Prepare shaders. The render targets are set up in _PrepareRenderTarget,
+    // as they need to follow the swap chain's size.
     auto vertexBlob = _CompileShader(screenVertexShaderString, "vs_5_0");
     Microsoft::WRL::ComPtr<ID3DBlob> pixelBlob;
     // As the pixel shader source is user provided it's possible there's a problem with it
@@ -385,6 +428,8 @@ HRESULT DxEngine::_SetupTerminalEffects()
         nullptr,
         &_pixelShader));
 
+    _pixelShaderReadsTime = _ShaderReadsTime(pixelBlob.Get());
+
     RETURN_IF_FAILED(_d3dDevice->CreateInputLayout(
         static_cast<const D3D11_INPUT_ELEMENT_DESC*>(_shaderInputLayout),
         ARRAYSIZE(_shaderInputLayout),
@@ -441,6 +486,39 @@ HRESULT DxEngine::_SetupTerminalEffects()
     return S_OK;
 }
 
+// Routine Description:
+// - Creates the textures that the terminal effects read from and draw into,
+//   in the size of the swap chain.
+// Arguments:
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_PrepareTerminalEffectsTarget() noexcept
+try
+{
+    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
+    RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&swapBuffer)));
+
+    // Setup render target.
+    RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(swapBuffer.Get(), nullptr, &_renderTargetView));
+
+    // Setup _framebufferCapture, which we draw the frame into and the effects read from.
+    D3D11_TEXTURE2D_DESC framebufferCaptureDesc{};
+    swapBuffer->GetDesc(&framebufferCaptureDesc);
+    WI_SetFlag(framebufferCaptureDesc.BindFlags, D3D11_BIND_SHADER_RESOURCE);
+    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&framebufferCaptureDesc, nullptr, &_framebufferCapture));
+
+    // Prepare the texture as input resource to the shader program.
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MostDetailedMip = 0;
+    srvDesc.Texture2D.MipLevels = framebufferCaptureDesc.MipLevels;
+    srvDesc.Format = framebufferCaptureDesc.Format;
+    RETURN_IF_FAILED(_d3dDevice->CreateShaderResourceView(_framebufferCapture.Get(), &srvDesc, &_framebufferCaptureView));
+
+    return S_OK;
+}
+CATCH_RETURN()
+
 // Routine Description:
 // - Puts the correct values in _pixelShaderSettings, so the struct can be
 //   passed the GPU and updates the GPU resource.
@@ -502,29 +580,110 @@ void DxEngine::_ComputePixelShaderSettings() noexcept
     return fn(GENERIC_ALL, nullptr, &_swapChainHandle);
 }
 
-// Routine Description;
-// - Creates device-specific resources required for drawing
-//   which generally means those that are represented on the GPU and can
-//   vary based on the monitor, display adapter, etc.
-// - These may need to be recreated during the course of painting a frame
-//   should something about that hardware pipeline change.
-// - Will free device resources that already existed as first operation.
+// Method Description:
+// - Creates a swap chain for composition and shows it in the target window
+//   through DirectComposition. Compared to a swap chain for the HWND, DWM can
+//   compose it directly, without copying it into the window's redirection
+//   surface first.
+// - DirectComposition is only present in Windows 8+, so it's delay-loaded
+//   just like in _CreateSurfaceHandle.
 // Arguments:
-// - createSwapChain - If true, we create the entire rendering pipeline
-//                   - If false, we just set up the adapter.
+// - <none>
 // Return Value:
-// - Could be any DirectX/D3D/D2D/DXGI/DWrite error or memory issue.
-[[nodiscard]] HRESULT DxEngine::_CreateDeviceResources(const bool createSwapChain) noexcept
-try
+// - An HRESULT for failing to load dcomp.dll, or failing to find the API, or an
+//   actual failure from DXGI or DirectComposition.
+[[nodiscard]] HRESULT DxEngine::_CreateHwndCompositionSwapChain() noexcept
 {
-    if (_haveDeviceResources)
+    if (!_dcompModule)
     {
-        _ReleaseDeviceResources();
+        _dcompModule.reset(LoadLibraryEx(L"Dcomp.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32));
+        RETURN_LAST_ERROR_IF(!_dcompModule);
     }
 
-    auto freeOnFail = wil::scope_exit([&]() noexcept { _ReleaseDeviceResources(); });
+    auto fn = GetProcAddressByFunctionDeclaration(_dcompModule.get(), DCompositionCreateDevice);
+    RETURN_LAST_ERROR_IF(fn == nullptr);
 
-    RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
+    // It's 100% required to use scaling mode stretch for composition. There is no other choice.
+    auto desc = _swapChainDesc;
+    desc.Scaling = DXGI_SCALING_STRETCH;
+    RETURN_IF_FAILED(_dxgiFactory2->CreateSwapChainForComposition(_d3dDevice.Get(), &desc, nullptr, &_dxgiSwapChain));
+
+    RETURN_IF_FAILED(fn(_dxgiDevice.Get(), IID_PPV_ARGS(&_dcompDevice)));
+    RETURN_IF_FAILED(_dcompDevice->CreateTargetForHwnd(_hwndTarget, TRUE, &_dcompTarget));
+    RETURN_IF_FAILED(_dcompDevice->CreateVisual(&_dcompVisual));
+    RETURN_IF_FAILED(_dcompVisual->SetContent(_dxgiSwapChain.Get()));
+    RETURN_IF_FAILED(_dcompTarget->SetRoot(_dcompVisual.Get()));
+    RETURN_IF_FAILED(_dcompDevice->Commit());
+
+    _swapChainDesc = desc;
+    return S_OK;
+}
+
+// Routine Description:
+// - Gets the Direct2D factory shared by all engines in the process. It's
+//   multithreaded, as the engines of different panes paint on different threads.
+// Arguments:
+// - <none>
+// Return Value:
+// - The factory.
+[[nodiscard]] ::Microsoft::WRL::ComPtr<ID2D1Factory1> DxEngine::s_GetSharedFactory()
+{
+    static const auto factory = [] {
+        ::Microsoft::WRL::ComPtr<ID2D1Factory1> factory;
+        THROW_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_MULTI_THREADED, IID_PPV_ARGS(&factory)));
+        return factory;
+    }();
+    return factory;
+}
+
+// Routine Description:
+// - Gets the devices shared by all engines in the process, creating them if
+//   there are none yet or if the ones there are were lost. They're released
+//   once the last engine using them lets go of them.
+// - The device context is made multithread protected, so that the engines can
+//   use it from their render threads. Calls that rely on the pipeline state
+//   they set up need to hold the Direct2D lock though (see ID2D1Multithread).
+// Arguments:
+// - factory - The shared Direct2D factory, see s_GetSharedFactory.
+// - adapter - The adapter to create the devices on, or nullptr for the default one.
+// - softwareRendering - Whether to use the WARP software renderer.
+// Return Value:
+// - The devices.
+[[nodiscard]] std::shared_ptr<DxEngine::SharedDevice> DxEngine::s_GetSharedDevice(ID2D1Factory1* const factory, IDXGIAdapter1* const adapter, const bool softwareRendering)
+{
+    struct Slot
+    {
+        LUID adapter;
+        bool softwareRendering;
+        std::weak_ptr<SharedDevice> device;
+    };
+
+    static std::mutex mutex;
+    static std::vector<Slot> slots;
+
+    // WARP doesn't run on any particular adapter.
+    LUID luid{};
+    if (adapter && !softwareRendering)
+    {
+        DXGI_ADAPTER_DESC1 desc{};
+        THROW_IF_FAILED(adapter->GetDesc1(&desc));
+        luid = desc.AdapterLuid;
+    }
+
+    const std::lock_guard guard{ mutex };
+    slots.erase(std::remove_if(slots.begin(), slots.end(), [](const Slot& s) { return s.device.expired(); }), slots.end());
+    auto slot = std::find_if(slots.begin(), slots.end(), [&](const Slot& s) {
+        return s.adapter.LowPart == luid.LowPart && s.adapter.HighPart == luid.HighPart && s.softwareRendering == softwareRendering;
+    });
+    if (slot != slots.end())
+    {
+        if (auto device = slot->device.lock(); device && SUCCEEDED(device->d3dDevice->GetDeviceRemovedReason()))
+        {
+            return device;
+        }
+    }
+
+    auto device = std::make_shared<SharedDevice>();
 
     const DWORD DeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT |
                               // clang-format off
@@ -538,7 +697,7 @@ try
 // https://docs.microsoft.com/en-us/windows/uwp/gaming/use-the-directx-runtime-and-visual-studio-graphics-diagnostic-features
                               // clang-format on
                               // D3D11_CREATE_DEVICE_DEBUG |
-                              D3D11_CREATE_DEVICE_SINGLETHREADED;
+                              0;
 
     const std::array<D3D_FEATURE_LEVEL, 5> FeatureLevels{ D3D_FEATURE_LEVEL_11_1,
                                                           D3D_FEATURE_LEVEL_11_0,
@@ -553,41 +712,171 @@ try
 
     // If we're not forcing software rendering, try hardware first.
     // Otherwise, let the error state fall down and create with the software renderer directly.
-    if (!_softwareRendering)
+    if (!softwareRendering)
     {
-        hardwareResult = D3D11CreateDevice(nullptr,
-                                           D3D_DRIVER_TYPE_HARDWARE,
+        // The driver type has to be unknown if we ask for a specific adapter.
+        hardwareResult = D3D11CreateDevice(adapter,
+                                           adapter ? D3D_DRIVER_TYPE_UNKNOWN : D3D_DRIVER_TYPE_HARDWARE,
                                            nullptr,
                                            DeviceFlags,
                                            FeatureLevels.data(),
                                            gsl::narrow_cast<UINT>(FeatureLevels.size()),
                                            D3D11_SDK_VERSION,
-                                           &_d3dDevice,
+                                           &device->d3dDevice,
                                            nullptr,
-                                           &_d3dDeviceContext);
+                                           &device->d3dDeviceContext);
     }
 
     if (FAILED(hardwareResult))
     {
-        RETURN_IF_FAILED(D3D11CreateDevice(nullptr,
-                                           D3D_DRIVER_TYPE_WARP,
-                                           nullptr,
-                                           DeviceFlags,
-                                           FeatureLevels.data(),
-                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
-                                           D3D11_SDK_VERSION,
-                                           &_d3dDevice,
-                                           nullptr,
-                                           &_d3dDeviceContext));
+        THROW_IF_FAILED(D3D11CreateDevice(nullptr,
+                                          D3D_DRIVER_TYPE_WARP,
+                                          nullptr,
+                                          DeviceFlags,
+                                          FeatureLevels.data(),
+                                          gsl::narrow_cast<UINT>(FeatureLevels.size()),
+                                          D3D11_SDK_VERSION,
+                                          &device->d3dDevice,
+                                          nullptr,
+                                          &device->d3dDeviceContext));
     }
 
-    _displaySizePixels = _GetClientSize();
-
     // Get the other device types so we have deeper access to more functionality
     // in our pipeline than by just walking straight from the D3D device.
+    THROW_IF_FAILED(device->d3dDevice.As(&device->dxgiDevice));
+    THROW_IF_FAILED(factory->CreateDevice(device->dxgiDevice.Get(), device->d2dDevice.ReleaseAndGetAddressOf()));
+    device->software = s_IsSoftwareDevice(device->dxgiDevice.Get());
+
+    // Without multithread protection the device can't be shared. The engine
+    // gets a device of its own then, like back when they weren't shared.
+    ::Microsoft::WRL::ComPtr<ID3D11Multithread> multithread;
+    if (SUCCEEDED(device->d3dDeviceContext.As(&multithread)))
+    {
+        multithread->SetMultithreadProtected(TRUE);
+        if (slot != slots.end())
+        {
+            slot->device = device;
+        }
+        else
+        {
+            slots.push_back({ luid, softwareRendering, device });
+        }
+    }
 
-    RETURN_IF_FAILED(_d3dDevice.As(&_dxgiDevice));
-    RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
+    return device;
+}
+
+// Routine Description:
+// - Checks whether a device renders on the CPU. That's the case for WARP, but
+//   also for the hardware device of a VM or a remote session that has no
+//   display driver, which Windows runs on the Basic Render Driver.
+// Arguments:
+// - device - The device to check.
+// Return Value:
+// - True if the device is a software one.
+[[nodiscard]] bool DxEngine::s_IsSoftwareDevice(IDXGIDevice* const device) noexcept
+{
+    ::Microsoft::WRL::ComPtr<IDXGIAdapter> adapter;
+    ::Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter1;
+    DXGI_ADAPTER_DESC1 desc{};
+    if (FAILED(device->GetAdapter(&adapter)) || FAILED(adapter.As(&adapter1)) || FAILED(adapter1->GetDesc1(&desc)))
+    {
+        return false;
+    }
+
+    static constexpr UINT MicrosoftVendorId = 0x1414;
+    static constexpr UINT BasicRenderDriverDeviceId = 0x8c;
+    return WI_IsFlagSet(desc.Flags, DXGI_ADAPTER_FLAG_SOFTWARE) ||
+           (desc.VendorId == MicrosoftVendorId && desc.DeviceId == BasicRenderDriverDeviceId);
+}
+
+// Routine Description:
+// - Picks the adapter to render with. That's the one SetPreferredAdapter named,
+//   if there is one like that, or else the one the monitor of the window is
+//   attached to, so that the frames don't need to be copied over to another
+//   adapter to get on the screen.
+// - The adapter is only picked when the device is created, and a window that
+//   isn't ours (like a composition surface) always gets the default one.
+// Arguments:
+// - <none>
+// Return Value:
+// - The adapter, or nullptr for the default one.
+[[nodiscard]] Microsoft::WRL::ComPtr<IDXGIAdapter1> DxEngine::_SelectAdapter() const
+{
+    const auto monitor = _hwndTarget != INVALID_HANDLE_VALUE ? MonitorFromWindow(_hwndTarget, MONITOR_DEFAULTTONULL) : nullptr;
+    if (_preferredAdapter.empty() && !monitor)
+    {
+        return nullptr;
+    }
+
+    const auto matchesPreference = [&](const std::wstring_view description) {
+        const auto it = std::search(description.begin(), description.end(), _preferredAdapter.begin(), _preferredAdapter.end(), [](const wchar_t a, const wchar_t b) {
+            return towlower(a) == towlower(b);
+        });
+        return it != description.end();
+    };
+
+    ::Microsoft::WRL::ComPtr<IDXGIAdapter1> monitorAdapter;
+    ::Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+    for (UINT i = 0; SUCCEEDED(_dxgiFactory2->EnumAdapters1(i, adapter.ReleaseAndGetAddressOf())); ++i)
+    {
+        DXGI_ADAPTER_DESC1 desc{};
+        if (FAILED(adapter->GetDesc1(&desc)))
+        {
+            continue;
+        }
+
+        if (!_preferredAdapter.empty() && matchesPreference(desc.Description))
+        {
+            return adapter;
+        }
+
+        ::Microsoft::WRL::ComPtr<IDXGIOutput> output;
+        for (UINT j = 0; !monitorAdapter && SUCCEEDED(adapter->EnumOutputs(j, output.ReleaseAndGetAddressOf())); ++j)
+        {
+            DXGI_OUTPUT_DESC outputDesc{};
+            if (SUCCEEDED(output->GetDesc(&outputDesc)) && outputDesc.Monitor == monitor)
+            {
+                monitorAdapter = adapter;
+            }
+        }
+    }
+
+    return monitorAdapter;
+}
+
+// Routine Description:
+// - Creates device-specific resources required for drawing
+//   which generally means those that are represented on the GPU and can
+//   vary based on the monitor, display adapter, etc.
+// - These may need to be recreated during the course of painting a frame
+//   should something about that hardware pipeline change.
+// - Will free device resources that already existed as first operation.
+// Arguments:
+// - createSwapChain - If true, we create the entire rendering pipeline
+//                   - If false, we just set up the adapter.
+// Return Value:
+// - Could be any DirectX/D3D/D2D/DXGI/DWrite error or memory issue.
+[[nodiscard]] HRESULT DxEngine::_CreateDeviceResources(const bool createSwapChain) noexcept
+try
+{
+    if (_haveDeviceResources)
+    {
+        _ReleaseDeviceResources();
+    }
+
+    auto freeOnFail = wil::scope_exit([&]() noexcept { _ReleaseDeviceResources(); });
+
+    RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
+
+    _sharedDevice = s_GetSharedDevice(_d2dFactory.Get(), _SelectAdapter().Get(), _softwareRendering);
+    _softwareDevice = _sharedDevice->software;
+    _d3dDevice = _sharedDevice->d3dDevice;
+    _d3dDeviceContext = _sharedDevice->d3dDeviceContext;
+    _dxgiDevice = _sharedDevice->dxgiDevice;
+    _d2dDevice = _sharedDevice->d2dDevice;
+
+    _displaySizePixels = _GetClientSize();
 
     // Create a device context out of it (supercedes render targets)
     RETURN_IF_FAILED(_d2dDevice->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, &_d2dDeviceContext));
@@ -621,6 +910,24 @@ try
 
             // We can't do alpha for HWNDs. Set to ignore. It will fail otherwise.
             _swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+
+            if (_hwndComposition)
+            {
+                const auto compositionResult = _CreateHwndCompositionSwapChain();
+                if (SUCCEEDED(compositionResult))
+                {
+                    break;
+                }
+
+                // Present to the window directly then, for instance on Windows 7.
+                LOG_HR_MSG(compositionResult, "Failed to compose the swap chain into the window");
+                _dcompVisual.Reset();
+                _dcompTarget.Reset();
+                _dcompDevice.Reset();
+                _dxgiSwapChain.Reset();
+                _hwndComposition = false;
+            }
+
             const auto createSwapChainResult = _dxgiFactory2->CreateSwapChainForHwnd(_d3dDevice.Get(),
                                                                                      _hwndTarget,
                                                                                      &_swapChainDesc,
@@ -665,16 +972,31 @@ try
                                                                                            &_dxgiSwapChain));
             break;
         }
+        case SwapChainMode::Offscreen:
+        {
+            // Draw like into a window, just that nobody ever sees it.
+            _swapChainDesc.Width = _displaySizePixels.width<UINT>();
+            _swapChainDesc.Height = _displaySizePixels.height<UINT>();
+            _swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+
+            RETURN_IF_FAILED(_CreateOffscreenBuffers(_displaySizePixels));
+            break;
+        }
         default:
             THROW_HR(E_NOTIMPL);
         }
 
-        if (IsWindows8Point1OrGreater())
+        if (_dxgiSwapChain && IsWindows8Point1OrGreater())
         {
             ::Microsoft::WRL::ComPtr<IDXGISwapChain2> swapChain2;
             const HRESULT asResult = _dxgiSwapChain.As(&swapChain2);
             if (SUCCEEDED(asResult))
             {
+                // Don't let more than one frame queue up behind the one that's
+                // on screen. WaitUntilCanRender then blocks until the previous
+                // frame was shown, so the next one contains the latest changes
+                // (like the echo of a keystroke) instead of going stale in a queue.
+                LOG_IF_FAILED(swapChain2->SetMaximumFrameLatency(1));
                 _swapChainFrameLatencyWaitableObject = wil::unique_handle{ swapChain2->GetFrameLatencyWaitableObject() };
             }
             else
@@ -751,14 +1073,27 @@ static constexpr D2D1_ALPHA_MODE _dxgiAlphaToD2d1Alpha(DXGI_ALPHA_MODE mode) noe
     try
     {
         // Pull surface out of swap chain.
-        RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&_dxgiSurface)));
+        RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&_dxgiSurface)));
+
+        // With terminal effects, we draw into a texture of our own instead, which the
+        // effects read from while they draw into the swap chain in Present. Since nothing
+        // else ever writes to it, it still holds the last frame when we start the next one
+        // and we only need to draw what changed.
+        auto targetSurface = _dxgiSurface;
+        _drawingToEffectsTexture = false;
+        if (_HasTerminalEffects() && _pixelShaderLoaded)
+        {
+            RETURN_IF_FAILED(_PrepareTerminalEffectsTarget());
+            RETURN_IF_FAILED(_framebufferCapture.As(&targetSurface));
+            _drawingToEffectsTexture = true;
+        }
 
-        // Make a bitmap and bind it to the swap chain surface
+        // Make a bitmap and bind it to the surface
         const auto bitmapProperties = D2D1::BitmapProperties1(
             D2D1_BITMAP_OPTIONS_TARGET | D2D1_BITMAP_OPTIONS_CANNOT_DRAW,
             D2D1::PixelFormat(_swapChainDesc.Format, _dxgiAlphaToD2d1Alpha(_swapChainDesc.AlphaMode)));
 
-        RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmapFromDxgiSurface(_dxgiSurface.Get(), bitmapProperties, &_d2dBitmap));
+        RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmapFromDxgiSurface(targetSurface.Get(), bitmapProperties, &_d2dBitmap));
 
         // Assign that bitmap as the target of the D2D device context. Draw commands hit the context
         // and are backed by the bitmap which is bound to the swap chain which goes on to be presented.
@@ -848,11 +1183,16 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         _pixelShaderSettingsBuffer.Reset();
         _samplerState.Reset();
         _framebufferCapture.Reset();
+        _framebufferCaptureView.Reset();
+        _drawingToEffectsTexture = false;
+
+        _cursorRowCache = {};
 
         _d2dBrushForeground.Reset();
         _d2dBrushBackground.Reset();
 
         _d2dBitmap.Reset();
+        _imageCache.clear();
 
         if (nullptr != _d2dDeviceContext.Get() && _isPainting)
         {
@@ -862,9 +1202,21 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         _d2dDeviceContext.Reset();
 
         _dxgiSurface.Reset();
+
+        // The window can only be the target of one composition device at a time.
+        _dcompVisual.Reset();
+        _dcompTarget.Reset();
+        _dcompDevice.Reset();
+
         _dxgiSwapChain.Reset();
         _swapChainFrameLatencyWaitableObject.reset();
 
+        _offscreenBuffers = {};
+        _gpuDisjointQuery.Reset();
+        _gpuFrameStartQuery.Reset();
+        _gpuFrameEndQuery.Reset();
+        _gpuFrameTimed = false;
+
         _d2dDevice.Reset();
         _dxgiDevice.Reset();
 
@@ -872,11 +1224,14 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         {
             // To ensure the swap chain goes away we must unbind any views from the
             // D3D pipeline
+            _d2dMultithread->Enter();
             _d3dDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+            _d2dMultithread->Leave();
         }
         _d3dDeviceContext.Reset();
 
         _d3dDevice.Reset();
+        _sharedDevice.reset();
 
         _dxgiFactory2.Reset();
     }
@@ -956,6 +1311,90 @@ CATCH_RETURN()
 {
     _hwndTarget = hwnd;
     _chainMode = SwapChainMode::ForHwnd;
+    _hwndComposition = false;
+    return S_OK;
+}
+
+// Routine Description:
+// - Sets the target window handle for our display pipeline, like SetHwnd.
+// - Instead of presenting to the window, the swap chain is placed on top of
+//   it with DirectComposition, which saves DWM a copy of every frame. If
+//   DirectComposition isn't available, this falls back to SetHwnd's behavior.
+// Arguments:
+// - hwnd - Window handle
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT DxEngine::SetHwndForComposition(const HWND hwnd) noexcept
+{
+    _hwndTarget = hwnd;
+    _chainMode = SwapChainMode::ForHwnd;
+    _hwndComposition = true;
+    return S_OK;
+}
+
+// Routine Description:
+// - Makes our display pipeline draw into textures of its own, in the size
+//   given to SetWindowSize, instead of into a window. Presenting a frame
+//   waits for the GPU to finish it, so that GetFrameStatistics can tell how
+//   long it took. This is meant for benchmarks and tests, which don't have
+//   (or don't want) a window to draw into.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT DxEngine::SetOffscreen() noexcept
+{
+    _hwndTarget = static_cast<HWND>(INVALID_HANDLE_VALUE);
+    _chainMode = SwapChainMode::Offscreen;
+    _hwndComposition = false;
+    return S_OK;
+}
+
+// Routine Description:
+// - Gets what went into the last frame that was presented.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of lines of text shaped for the frame, the number of grid lines
+//   and of the strokes they were drawn with, the number of pixels that were
+//   presented and, for offscreen targets, how long the GPU took.
+[[nodiscard]] DxEngine::FrameStatistics DxEngine::GetFrameStatistics() const noexcept
+{
+    return _lastFrameStatistics;
+}
+
+// Routine Description:
+// - Reads back the last frame that was presented to an offscreen target.
+// Arguments:
+// - pixels - receives the BGRA pixels of the frame, row by row
+// Return Value:
+// - S_OK, E_UNEXPECTED if we aren't an offscreen target with a frame,
+//   or a relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::ReadOffscreenPixels(std::vector<uint32_t>& pixels)
+{
+    const auto& frontBuffer = til::at(_offscreenBuffers, 1);
+    RETURN_HR_IF(E_UNEXPECTED, _chainMode != SwapChainMode::Offscreen || !frontBuffer);
+
+    D3D11_TEXTURE2D_DESC desc{};
+    frontBuffer->GetDesc(&desc);
+    desc.Usage = D3D11_USAGE_STAGING;
+    desc.BindFlags = 0;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> staging;
+    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&desc, nullptr, &staging));
+    _d3dDeviceContext->CopyResource(staging.Get(), frontBuffer.Get());
+
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    RETURN_IF_FAILED(_d3dDeviceContext->Map(staging.Get(), 0, D3D11_MAP_READ, 0, &mapped));
+    const auto unmap = wil::scope_exit([&]() noexcept { _d3dDeviceContext->Unmap(staging.Get(), 0); });
+
+    pixels.resize(static_cast<size_t>(desc.Width) * desc.Height);
+    const auto source = static_cast<const BYTE*>(mapped.pData);
+    for (UINT y = 0; y < desc.Height; ++y)
+    {
+        memcpy(&pixels.at(static_cast<size_t>(y) * desc.Width), source + static_cast<size_t>(y) * mapped.RowPitch, desc.Width * sizeof(uint32_t));
+    }
     return S_OK;
 }
 
@@ -1035,11 +1474,30 @@ try
 }
 CATCH_LOG()
 
-HANDLE DxEngine::GetSwapChainHandle()
+// Routine Description:
+// - Sets the adapter to render with, see _SelectAdapter.
+// Arguments:
+// - description - The name of the adapter or a part of it, in any case.
+//   Empty to go with the adapter of the window's monitor.
+// Return Value:
+// - <none>
+void DxEngine::SetPreferredAdapter(std::wstring_view description) noexcept
+try
 {
-    if (!_swapChainHandle)
+    if (_preferredAdapter != description)
     {
-        THROW_IF_FAILED(_CreateDeviceResources(true));
+        _preferredAdapter = description;
+        _recreateDeviceRequested = true;
+        LOG_IF_FAILED(InvalidateAll());
+    }
+}
+CATCH_LOG()
+
+HANDLE DxEngine::GetSwapChainHandle()
+{
+    if (!_swapChainHandle)
+    {
+        THROW_IF_FAILED(_CreateDeviceResources(true));
     }
 
     return _swapChainHandle.get();
@@ -1073,6 +1531,7 @@ try
 {
     RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
 
+    _onlyCursorInvalid = false;
     if (!_allInvalid)
     {
         _InvalidateRectangle(Viewport::FromExclusive(*psrRegion).ToInclusive());
@@ -1089,9 +1548,18 @@ CATCH_RETURN()
 // Return Value:
 // - S_OK
 [[nodiscard]] HRESULT DxEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+try
 {
-    return Invalidate(psrRegion);
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+
+    if (!_allInvalid)
+    {
+        _InvalidateRectangle(Viewport::FromExclusive(*psrRegion).ToInclusive());
+    }
+
+    return S_OK;
 }
+CATCH_RETURN()
 
 // Routine Description:
 // - Invalidates a rectangle describing a pixel area on the display
@@ -1104,6 +1572,7 @@ try
 {
     RETURN_HR_IF_NULL(E_INVALIDARG, prcDirtyClient);
 
+    _onlyCursorInvalid = false;
     if (!_allInvalid)
     {
         // Dirty client is in pixels. Use divide specialization against glyph factor to make conversion
@@ -1148,10 +1617,19 @@ try
 
     const til::point deltaCells{ *pcoordDelta };
 
+    // ScrollFrame can't move the contents of the texture we draw into for
+    // terminal effects, as it has no front buffer to copy from.
+    if (_drawingToEffectsTexture && deltaCells != til::point{ 0, 0 })
+    {
+        return InvalidateAll();
+    }
+
     if (!_allInvalid)
     {
         if (deltaCells != til::point{ 0, 0 })
         {
+            _onlyCursorInvalid = false;
+
             // Shift the contents of the map and fill in revealed area.
             _invalidMap.translate(deltaCells, true);
             _invalidScroll += deltaCells;
@@ -1174,6 +1652,7 @@ try
 {
     _invalidMap.set_all();
     _allInvalid = true;
+    _onlyCursorInvalid = false;
 
     // Since everything is invalidated here, mark this as a "first frame", so
     // that we won't use incremental drawing on it. The caller of this intended
@@ -1220,6 +1699,7 @@ CATCH_RETURN();
         return til::rectangle{ clientRect }.size();
     }
     case SwapChainMode::ForComposition:
+    case SwapChainMode::Offscreen:
     {
         return _sizeTarget;
     }
@@ -1287,6 +1767,36 @@ try
                           TraceLoggingWideString(invalidated),
                           TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
                           TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        // The counters accumulate since the last font change.
+        const auto fallbackStats = _fontRenderData->GetFontFallbackCacheStats();
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hDxRenderProvider,
+                          "FontFallbackCache",
+                          TraceLoggingUInt64(fallbackStats.hits, "hits"),
+                          TraceLoggingUInt64(fallbackStats.misses, "misses"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    // GH#1989: Don't draw anything nobody can see. The invalid region is left
+    // untouched, so it's painted in one go once we're visible again.
+    if (_windowOccluded)
+    {
+        return S_FALSE;
+    }
+
+    if (_presentOccluded)
+    {
+        // DXGI_PRESENT_TEST checks whether we're still occluded without presenting anything.
+        if (_dxgiSwapChain && _dxgiSwapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED)
+        {
+            return S_FALSE;
+        }
+
+        // The frame presented while we were occluded was discarded.
+        _presentOccluded = false;
+        _invalidMap.set_all();
     }
 
     if (_isEnabled)
@@ -1311,9 +1821,19 @@ try
             _dxgiSurface.Reset();
             _d2dDeviceContext->SetTarget(nullptr);
             _d2dBitmap.Reset();
+            _renderTargetView.Reset();
+            _framebufferCapture.Reset();
+            _framebufferCaptureView.Reset();
 
             // Change the buffer size and recreate the render target (and surface)
-            RETURN_IF_FAILED(_dxgiSwapChain->ResizeBuffers(2, clientSize.width<UINT>(), clientSize.height<UINT>(), _swapChainDesc.Format, _swapChainDesc.Flags));
+            if (_chainMode == SwapChainMode::Offscreen)
+            {
+                RETURN_IF_FAILED(_CreateOffscreenBuffers(clientSize));
+            }
+            else
+            {
+                RETURN_IF_FAILED(_dxgiSwapChain->ResizeBuffers(2, clientSize.width<UINT>(), clientSize.height<UINT>(), _swapChainDesc.Format, _swapChainDesc.Flags));
+            }
             RETURN_IF_FAILED(_PrepareRenderTarget());
 
             // OK we made it past the parts that can cause errors. We can release our failure handler.
@@ -1326,6 +1846,20 @@ try
             _firstFrame = true;
         }
 
+        // The whole frame is redrawn on a new target, so the captured cursor rows can't be reused.
+        if (_firstFrame || _invalidMap.all())
+        {
+            _onlyCursorInvalid = false;
+        }
+
+        // The GPU time of the frame is measured from here until it's presented.
+        if (_gpuDisjointQuery && !_gpuFrameTimed)
+        {
+            _d3dDeviceContext->Begin(_gpuDisjointQuery.Get());
+            _d3dDeviceContext->End(_gpuFrameStartQuery.Get());
+            _gpuFrameTimed = true;
+        }
+
         _d2dDeviceContext->BeginDraw();
         _isPainting = true;
 
@@ -1345,7 +1879,16 @@ try
                                                                _d2dDeviceContext->GetSize(),
                                                                std::nullopt,
                                                                D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
+            _drawingContext->boxGlyphs = &_fontRenderData->BoxGlyphGeometry();
+        }
+
+        // Shaping the lines on several threads only pays off if there are plenty of them.
+        ptrdiff_t invalidCells = 0;
+        for (const auto& rect : _invalidMap.runs())
+        {
+            invalidCells += rect.size().area();
         }
+        _queueTextLines = invalidCells >= _minQueuedTextCells && std::thread::hardware_concurrency() > 1;
     }
 
     return S_OK;
@@ -1369,6 +1912,10 @@ try
     {
         _isPainting = false;
 
+        // Draw the text that's still queued up, before anything else happens to the frame.
+        LOG_IF_FAILED(_DrawQueuedTextLines());
+        _queueTextLines = false;
+
         // If there's still a clip hanging around, remove it. We're all done.
         LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
 
@@ -1376,16 +1923,30 @@ try
 
         if (SUCCEEDED(hr))
         {
-            if (_invalidScroll != til::point{ 0, 0 })
+            // Unless the entire frame changed, tell DXGI which parts did, so that less
+            // of it needs to be composed. The rest of the back buffer is still a copy
+            // of the front buffer (see _CopyFrontToBack), so it doesn't matter anyway.
+            if (!_firstFrame && !_invalidMap.all() && _invalidMap.any() && !_FullRepaintNeeded() && !_drawingToEffectsTexture)
             {
+                // Scale all dirty rectangles into pixels
+                std::vector<til::rectangle> dirty;
+                dirty.reserve(_invalidMap.runs().size());
+                for (const auto& rc : _invalidMap.runs())
+                {
+                    dirty.emplace_back(rc.scale_up(_fontRenderData->GlyphCell()));
+                }
+
+                s_CoalesceDirtyRects(dirty);
+
                 // Copy `til::rectangles` into RECT map.
-                _presentDirty.assign(_invalidMap.begin(), _invalidMap.end());
+                _presentDirty.assign(dirty.begin(), dirty.end());
 
-                // Scale all dirty rectangles into pixels
-                std::transform(_presentDirty.begin(), _presentDirty.end(), _presentDirty.begin(), [&](til::rectangle rc) {
-                    return rc.scale_up(_fontRenderData->GlyphCell());
-                });
+                _presentParams.DirtyRectsCount = gsl::narrow<UINT>(_presentDirty.size());
+                _presentParams.pDirtyRects = _presentDirty.data();
+            }
 
+            if (_invalidScroll != til::point{ 0, 0 } && _presentParams.pDirtyRects)
+            {
                 // Invalid scroll is in characters, convert it to pixels.
                 const auto scrollPixels = (_invalidScroll * _fontRenderData->GlyphCell());
 
@@ -1402,9 +1963,6 @@ try
                 _presentOffset = scrollPixels;
 
                 // Now fill up the parameters structure from the member variables.
-                _presentParams.DirtyRectsCount = gsl::narrow<UINT>(_presentDirty.size());
-                _presentParams.pDirtyRects = _presentDirty.data();
-
                 _presentParams.pScrollOffset = &_presentOffset;
                 _presentParams.pScrollRect = &_presentScroll;
 
@@ -1418,6 +1976,8 @@ try
             }
 
             _presentReady = true;
+
+            LOG_IF_FAILED(_CaptureCursorRow());
         }
         else
         {
@@ -1428,13 +1988,107 @@ try
 
     _invalidMap.reset_all();
     _allInvalid = false;
+    _onlyCursorInvalid = true;
 
     _invalidScroll = {};
 
+    // Once many images were uploaded, drop the ones this frame didn't draw.
+    // They're uploaded again if they're drawn again, like after scrolling back.
+    if (_imageCache.size() > _imageCacheSize)
+    {
+        for (auto it = _imageCache.begin(); it != _imageCache.end();)
+        {
+            it = it->second.lastFrame == _imageFrame ? std::next(it) : _imageCache.erase(it);
+        }
+    }
+    ++_imageFrame;
+
     return hr;
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Reduces the dirty rectangles of a frame to a few larger ones. DWM pays for
+//   every rectangle Present1 hands it, so composing a bit of unchanged area is
+//   cheaper than composing dozens of thin rectangles, one for each row.
+// - First the spans of consecutive rows that cover the same columns are stacked
+//   into one rectangle. With _invalidateFullRows that's all of them. Then the
+//   neighbors that waste the least area when combined are merged, as long as that
+//   area costs less than another rectangle or there are too many rectangles.
+// Arguments:
+// - rects - The dirty rectangles in pixels, row by row and left to right,
+//   just like til::bitmap yields them. Replaced by the coalesced rectangles.
+// Return Value:
+// - <none>
+void DxEngine::s_CoalesceDirtyRects(std::vector<til::rectangle>& rects)
+{
+    // The area in pixels that's worth as much composition work as one more rectangle.
+    static constexpr ptrdiff_t rectangleCost = 64 * 64;
+    // The most rectangles we hand out, no matter how much area merging them wastes.
+    static constexpr size_t maxRectangles = 8;
+
+    std::vector<til::rectangle> stacked;
+    stacked.reserve(rects.size());
+    // The rectangles that reach down to the row we're at, and those reaching the next one.
+    std::vector<size_t> open;
+    std::vector<size_t> next;
+    ptrdiff_t row = 0;
+
+    for (const auto& rc : rects)
+    {
+        if (rc.top() != row)
+        {
+            open.swap(next);
+            next.clear();
+            row = rc.top();
+        }
+
+        const auto it = std::find_if(open.begin(), open.end(), [&](const size_t i) {
+            const auto& above = til::at(stacked, i);
+            return above.bottom() == rc.top() && above.left() == rc.left() && above.right() == rc.right();
+        });
+        if (it != open.end())
+        {
+            til::at(stacked, *it) |= rc;
+            next.push_back(*it);
+        }
+        else
+        {
+            next.push_back(stacked.size());
+            stacked.push_back(rc);
+        }
+    }
+
+    // The rectangles are still ordered by their top edge, so the neighbors
+    // in the list are the ones that are closest to each other.
+    while (stacked.size() > 1)
+    {
+        size_t best = 0;
+        auto bestCost = std::numeric_limits<ptrdiff_t>::max();
+        for (size_t i = 0; i + 1 < stacked.size(); ++i)
+        {
+            const auto& a = til::at(stacked, i);
+            const auto& b = til::at(stacked, i + 1);
+            const auto cost = (a | b).size().area() - a.size().area() - b.size().area();
+            if (cost < bestCost)
+            {
+                best = i;
+                bestCost = cost;
+            }
+        }
+
+        if (bestCost > rectangleCost && stacked.size() <= maxRectangles)
+        {
+            break;
+        }
+
+        til::at(stacked, best) |= til::at(stacked, best + 1);
+        stacked.erase(stacked.begin() + best + 1);
+    }
+
+    rects = std::move(stacked);
+}
+
 // Routine Description:
 // - Copies the front surface of the swap chain (the one being displayed)
 //   to the back surface of the swap chain (the one we draw on next)
@@ -1450,8 +2104,8 @@ CATCH_RETURN()
         Microsoft::WRL::ComPtr<ID3D11Resource> backBuffer;
         Microsoft::WRL::ComPtr<ID3D11Resource> frontBuffer;
 
-        RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer)));
-        RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(1, IID_PPV_ARGS(&frontBuffer)));
+        RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&backBuffer)));
+        RETURN_IF_FAILED(_GetSwapChainBuffer(1, IID_PPV_ARGS(&frontBuffer)));
 
         _d3dDeviceContext->CopyResource(backBuffer.Get(), frontBuffer.Get());
     }
@@ -1460,6 +2114,121 @@ CATCH_RETURN()
     return S_OK;
 }
 
+// Routine Description:
+// - Gets one of the buffers we draw into, like IDXGISwapChain::GetBuffer.
+//   For offscreen targets, those are the textures of _CreateOffscreenBuffers.
+// Arguments:
+// - index - 0 for the back buffer, 1 for the front buffer
+// - riid - the interface to get the buffer as
+// - buffer - receives the buffer
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_GetSwapChainBuffer(const UINT index, REFIID riid, void** buffer) noexcept
+{
+    if (_chainMode == SwapChainMode::Offscreen)
+    {
+        RETURN_HR_IF(E_INVALIDARG, index >= _offscreenBuffers.size());
+        const auto& texture = til::at(_offscreenBuffers, index);
+        RETURN_HR_IF_NULL(E_UNEXPECTED, texture.Get());
+        return texture->QueryInterface(riid, buffer);
+    }
+
+    return _dxgiSwapChain->GetBuffer(index, riid, buffer);
+}
+
+// Routine Description:
+// - Creates the back and front buffer of an offscreen target in the given
+//   size, and the queries that measure how long the GPU takes for a frame.
+// Arguments:
+// - size - the size of the buffers in pixels
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_CreateOffscreenBuffers(const til::size size) noexcept
+try
+{
+    D3D11_TEXTURE2D_DESC desc{};
+    desc.Width = size.width<UINT>();
+    desc.Height = size.height<UINT>();
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = _swapChainDesc.Format;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+    for (auto& buffer : _offscreenBuffers)
+    {
+        buffer.Reset();
+        RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&desc, nullptr, &buffer));
+    }
+
+    if (!_gpuDisjointQuery)
+    {
+        D3D11_QUERY_DESC queryDesc{ D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+        RETURN_IF_FAILED(_d3dDevice->CreateQuery(&queryDesc, &_gpuDisjointQuery));
+        queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+        RETURN_IF_FAILED(_d3dDevice->CreateQuery(&queryDesc, &_gpuFrameStartQuery));
+        RETURN_IF_FAILED(_d3dDevice->CreateQuery(&queryDesc, &_gpuFrameEndQuery));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Presents the frame of an offscreen target: the back buffer becomes the
+//   front buffer, like in a swap chain. Unlike in a swap chain, the back
+//   buffer keeps the frame as well, so it doesn't need to be copied back
+//   (see _CopyFrontToBack). As there's no vertical blank to wait for, this
+//   waits for the GPU to finish the frame instead and notes how long it took.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_PresentOffscreen() noexcept
+try
+{
+    _d3dDeviceContext->CopyResource(til::at(_offscreenBuffers, 1).Get(), til::at(_offscreenBuffers, 0).Get());
+
+    if (_gpuFrameTimed)
+    {
+        _gpuFrameTimed = false;
+        _d3dDeviceContext->End(_gpuFrameEndQuery.Get());
+        _d3dDeviceContext->End(_gpuDisjointQuery.Get());
+
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint{};
+        auto hr = _d3dDeviceContext->GetData(_gpuDisjointQuery.Get(), &disjoint, sizeof(disjoint), 0);
+        while (hr == S_FALSE)
+        {
+            SwitchToThread();
+            hr = _d3dDeviceContext->GetData(_gpuDisjointQuery.Get(), &disjoint, sizeof(disjoint), 0);
+        }
+        RETURN_IF_FAILED(hr);
+
+        UINT64 start = 0;
+        UINT64 end = 0;
+        RETURN_IF_FAILED(_d3dDeviceContext->GetData(_gpuFrameStartQuery.Get(), &start, sizeof(start), 0));
+        RETURN_IF_FAILED(_d3dDeviceContext->GetData(_gpuFrameEndQuery.Get(), &end, sizeof(end), 0));
+
+        // The timestamps can't be compared if the GPU changed its clock in between.
+        if (!disjoint.Disjoint && disjoint.Frequency != 0 && end > start)
+        {
+            const auto seconds = static_cast<double>(end - start) / static_cast<double>(disjoint.Frequency);
+            _lastFrameStatistics.gpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>{ seconds });
+        }
+    }
+
+    _firstFrame = false;
+    _presentReady = false;
+
+    _presentDirty.clear();
+    _presentOffset = { 0 };
+    _presentScroll = { 0 };
+    _presentParams = { 0 };
+    return S_OK;
+}
+CATCH_RETURN()
+
 // Method Description:
 // - When the shaders are on, say that we need to keep redrawing every
 //   possible frame in case they have some smooth action on every frame tick.
@@ -1468,18 +2237,26 @@ CATCH_RETURN()
 //   a perf detriment.
 [[nodiscard]] bool DxEngine::RequiresContinuousRedraw() noexcept
 {
-    // We're only going to request continuous redraw if someone is using
-    // a pixel shader from a path because we cannot tell if those are using the
-    // time parameter or not.
-    // And if they are using time, they probably need it to tick continuously.
+    // We're only going to request continuous redraw if the pixel shader
+    // reads the time parameter (see _ShaderReadsTime), because then it
+    // probably needs it to tick continuously.
     //
-    // By contrast, the in-built retro effect does NOT need it,
-    // so let's not tick for it and save some amount of performance.
+    // By contrast, the in-built retro effect and most other shaders do NOT
+    // need it, so let's not tick for them and save some amount of performance.
+    // The frame only needs to go through them again when it changes.
     //
     // Finally... if we're not using effects at all... let the render thread
     // go to sleep. It deserves it. That thread works hard. Also it sleeping
     // saves battery power and all sorts of related perf things.
-    return _terminalEffectsEnabled && !_pixelShaderPath.empty();
+    return _drawingToEffectsTexture && _pixelShaderReadsTime;
+}
+
+// Method Description:
+// - Everything we draw is handed to us in the paint calls, so the renderer
+//   can release the console lock before we shape and draw the frame.
+[[nodiscard]] bool DxEngine::SupportsSnapshotPainting() noexcept
+{
+    return true;
 }
 
 // Method Description:
@@ -1487,18 +2264,28 @@ CATCH_RETURN()
 // - See https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains.
 void DxEngine::WaitUntilCanRender() noexcept
 {
-    if (!_swapChainFrameLatencyWaitableObject)
+    if (_swapChainFrameLatencyWaitableObject)
     {
-        return;
+        const auto ret = WaitForSingleObjectEx(
+            _swapChainFrameLatencyWaitableObject.get(),
+            1000, // 1 second timeout (shouldn't ever occur)
+            true);
+        if (ret != WAIT_OBJECT_0)
+        {
+            LOG_WIN32_MSG(ret, "Waiting for swap chain frame latency waitable object returned error or timeout.");
+        }
     }
 
-    const auto ret = WaitForSingleObjectEx(
-        _swapChainFrameLatencyWaitableObject.get(),
-        1000, // 1 second timeout (shouldn't ever occur)
-        true);
-    if (ret != WAIT_OBJECT_0)
+    // A software device draws with the same CPU that the output is parsed
+    // with, so it gets fewer frames. The changes in the meantime pile up in
+    // the invalid region and are all drawn with the next one.
+    if (_softwareDevice)
     {
-        LOG_WIN32_MSG(ret, "Waiting for swap chain frame latency waitable object returned error or timeout.");
+        const auto wait = _lastPresentTime + SoftwarePresentInterval - std::chrono::steady_clock::now();
+        if (wait > std::chrono::steady_clock::duration::zero())
+        {
+            Sleep(gsl::narrow_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(wait).count()));
+        }
     }
 }
 
@@ -1513,18 +2300,40 @@ void DxEngine::WaitUntilCanRender() noexcept
 {
     if (_presentReady)
     {
-        if (_HasTerminalEffects() && _pixelShaderLoaded)
+        if (_drawingToEffectsTexture)
         {
             const HRESULT hr2 = _PaintTerminalEffects();
             if (FAILED(hr2))
             {
+                // The frame was drawn into the texture that failed to reach the screen.
+                // Go back to drawing straight into the swap chain.
                 _pixelShaderLoaded = false;
+                _terminalEffectsEnabled = false;
+                _recreateDeviceRequested = true;
                 LOG_HR_MSG(hr2, "Failed to paint terminal effects. Disabling.");
             }
         }
 
         try
         {
+            // What's presented is what we told DXGI has changed, or else the whole frame.
+            auto presentedPixels = _displaySizePixels.area();
+            if (!_firstFrame && _presentParams.pDirtyRects)
+            {
+                presentedPixels = 0;
+                for (const auto& rect : _presentDirty)
+                {
+                    presentedPixels += til::rectangle{ rect }.size().area();
+                }
+            }
+            _frameStatistics.presentedPixels = presentedPixels;
+            _lastFrameStatistics = std::exchange(_frameStatistics, FrameStatistics{});
+
+            if (_chainMode == SwapChainMode::Offscreen)
+            {
+                return _PresentOffscreen();
+            }
+
             HRESULT hr = S_OK;
 
             bool recreate = false;
@@ -1579,8 +2388,13 @@ void DxEngine::WaitUntilCanRender() noexcept
                 }
             }
 
-            // If we are doing full repaints we don't need to copy front buffer to back buffer
-            if (!_FullRepaintNeeded())
+            // We'll skip painting until DXGI tells us that we're visible again.
+            _presentOccluded = hr == DXGI_STATUS_OCCLUDED;
+
+            // If we are doing full repaints we don't need to copy front buffer to back buffer.
+            // With terminal effects we don't draw into the swap chain and the frame is kept
+            // in _framebufferCapture for us.
+            if (!_FullRepaintNeeded() && !_drawingToEffectsTexture)
             {
                 // Finally copy the front image (being presented now) onto the backing buffer
                 // (where we are about to draw the next frame) so we can draw only the differences
@@ -1589,6 +2403,7 @@ void DxEngine::WaitUntilCanRender() noexcept
             }
 
             _presentReady = false;
+            _lastPresentTime = std::chrono::steady_clock::now();
 
             _presentDirty.clear();
             _presentOffset = { 0 };
@@ -1602,15 +2417,54 @@ void DxEngine::WaitUntilCanRender() noexcept
 }
 
 // Routine Description:
-// - This is currently unused.
+// - Moves the contents of the back buffer by the distance the frame was
+//   scrolled since the last frame (see InvalidateScroll). That way only the
+//   revealed rows need to be drawn, and the Present1 scroll rect we hand out
+//   in EndPaint is actually true.
+// - The front buffer still holds the last frame (see _CopyFrontToBack),
+//   so we copy from there. This avoids overlapping copies within the same
+//   resource, which D3D doesn't support.
 // Arguments:
 // - <none>
 // Return Value:
-// - S_OK
+// - S_OK, S_FALSE if there was nothing to scroll, or a suitable DirectX error.
 [[nodiscard]] HRESULT DxEngine::ScrollFrame() noexcept
+try
 {
+    // If the entire frame is about to be redrawn, it doesn't matter what
+    // the back buffer contains. If full repaints are forced, the front
+    // buffer isn't copied to the back buffer and isn't a valid source either.
+    if (_invalidScroll == til::point{ 0, 0 } || !_isPainting || _firstFrame || _allInvalid || _FullRepaintNeeded())
+    {
+        return S_FALSE;
+    }
+
+    const auto cellSize = _fontRenderData->GlyphCell();
+    const auto scrollPixels = _invalidScroll * cellSize;
+    const til::rectangle field{ _invalidMap.size() * cellSize };
+
+    // The part of the field that continues to show previous content and where it came from.
+    const auto destination = field & (field + scrollPixels);
+    if (destination.empty())
+    {
+        return S_FALSE;
+    }
+    const auto source = destination - scrollPixels;
+
+    Microsoft::WRL::ComPtr<ID3D11Resource> backBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Resource> frontBuffer;
+    RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&backBuffer)));
+    RETURN_IF_FAILED(_GetSwapChainBuffer(1, IID_PPV_ARGS(&frontBuffer)));
+
+    // Direct2D might have batched up drawing commands for the back buffer already.
+    RETURN_IF_FAILED(_d2dDeviceContext->Flush());
+
+    const D3D11_BOX box{ source.left<UINT>(), source.top<UINT>(), 0, source.right<UINT>(), source.bottom<UINT>(), 1 };
+    _d3dDeviceContext->CopySubresourceRegion(backBuffer.Get(), 0, destination.left<UINT>(), destination.top<UINT>(), 0, frontBuffer.Get(), 0, &box);
+
     return S_OK;
 }
+CATCH_RETURN()
 
 // Routine Description:
 // - This paints in the back most layer of the frame with the background color.
@@ -1622,7 +2476,7 @@ void DxEngine::WaitUntilCanRender() noexcept
 try
 {
     D2D1_COLOR_F nothing{ 0 };
-    if (_chainMode == SwapChainMode::ForHwnd)
+    if (_chainMode == SwapChainMode::ForHwnd || _chainMode == SwapChainMode::Offscreen)
     {
         // When we're drawing over an HWND target, we need to fully paint the background color.
         nothing = _backgroundColor;
@@ -1673,6 +2527,30 @@ try
 {
     // Calculate positioning of our origin.
     const D2D1_POINT_2F origin = til::point{ coord } * _fontRenderData->GlyphCell();
+    ++_frameStatistics.shapedLines;
+
+    // Large frames are shaped on several threads. See _DrawQueuedTextLines.
+    if (_queueTextLines)
+    {
+        const auto index = _queuedTextLines.size();
+        if (index == _queuedTextLayouts.size())
+        {
+            _queuedTextLayouts.emplace_back(WRL::Make<CustomTextLayout>(_fontRenderData.get(), _queuedTextLayoutCacheSize));
+        }
+
+        const auto& layout = til::at(_queuedTextLayouts, index);
+        RETURN_IF_FAILED(layout->Reset());
+        RETURN_IF_FAILED(layout->AppendClusters(clusters));
+
+        _queuedTextLines.emplace_back(QueuedTextLine{ layout.Get(),
+                                                      origin,
+                                                      _d2dBrushForeground->GetColor(),
+                                                      _d2dBrushBackground->GetColor(),
+                                                      _drawingContext->useItalicFont,
+                                                      _drawingContext->forceGrayscaleAA,
+                                                      S_OK });
+        return S_OK;
+    }
 
     // Create the text layout
     RETURN_IF_FAILED(_customLayout->Reset());
@@ -1685,8 +2563,155 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Draws the lines PaintBufferLine queued up since this was last called.
+// - Analyzing and shaping the text is what most of the time of a large frame
+//   is spent on, and it doesn't need the device context. So that part is spread
+//   across the thread pool first. The prepared lines are then drawn on this
+//   thread, in the order they were painted in, as they may overlap each other.
+// - The grid lines PaintBufferGridLines queued up are drawn above them.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_DrawQueuedTextLines() noexcept
+try
+{
+    if (_queuedTextLines.empty())
+    {
+        return _DrawQueuedGridLines();
+    }
+
+    const auto clearQueueOnExit = wil::scope_exit([&]() noexcept { _queuedTextLines.clear(); });
+
+    std::for_each(std::execution::par, _queuedTextLines.begin(), _queuedTextLines.end(), [](QueuedTextLine& line) noexcept {
+        line.hr = line.layout->Prepare(line.useItalicFont);
+    });
+
+    // The lines carry the brushes they were painted with. Put back the current ones when we're done.
+    const auto existingForeground = _d2dBrushForeground->GetColor();
+    const auto existingBackground = _d2dBrushBackground->GetColor();
+    const auto existingUseItalicFont = _drawingContext->useItalicFont;
+    const auto existingForceGrayscaleAA = _drawingContext->forceGrayscaleAA;
+    const auto restoreStateOnExit = wil::scope_exit([&]() noexcept {
+        _d2dBrushForeground->SetColor(existingForeground);
+        _d2dBrushBackground->SetColor(existingBackground);
+        _drawingContext->useItalicFont = existingUseItalicFont;
+        _drawingContext->forceGrayscaleAA = existingForceGrayscaleAA;
+    });
+
+    for (const auto& line : _queuedTextLines)
+    {
+        RETURN_IF_FAILED(line.hr);
+
+        _d2dBrushForeground->SetColor(line.foregroundColor);
+        _d2dBrushBackground->SetColor(line.backgroundColor);
+        _drawingContext->useItalicFont = line.useItalicFont;
+        _drawingContext->forceGrayscaleAA = line.forceGrayscaleAA;
+
+        RETURN_IF_FAILED(line.layout->Draw(_drawingContext.get(), _customRenderer.Get(), line.origin.x, line.origin.y));
+    }
+
+    return _DrawQueuedGridLines();
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Queues up a grid line, to be drawn by _DrawQueuedGridLines. A horizontal
+//   line that starts where the last one of the same color and stroke ended is
+//   merged into it.
+// Arguments:
+// - start - The start of the line, at the edge of its first cell
+// - end - The end of the line, at the edge of its last cell
+// - color - The color to draw the line in
+// - width - The stroke width
+// - style - The stroke style
+// Return Value:
+// - <none>
+void DxEngine::_QueueGridLine(const D2D1_POINT_2F start, const D2D1_POINT_2F end, const D2D1_COLOR_F color, const float width, ID2D1StrokeStyle* const style)
+{
+    auto stroke = std::find_if(_queuedGridLines.begin(), _queuedGridLines.end(), [&](const QueuedGridLineStroke& s) noexcept {
+        return s.color.r == color.r && s.color.g == color.g && s.color.b == color.b && s.color.a == color.a &&
+               s.width == width && s.style.Get() == style;
+    });
+    if (stroke == _queuedGridLines.end())
+    {
+        stroke = _queuedGridLines.insert(_queuedGridLines.end(), QueuedGridLineStroke{ color, width, style, {} });
+    }
+
+    auto& lines = stroke->lines;
+    if (!lines.empty() && start.y == end.y)
+    {
+        auto& last = lines.back();
+        if (last.start.y == last.end.y && last.end.y == start.y && last.end.x == start.x)
+        {
+            last.end = end;
+            return;
+        }
+    }
+    lines.emplace_back(QueuedGridLine{ start, end });
+}
+
+// Routine Description:
+// - Draws the grid lines PaintBufferGridLines queued up since this was last
+//   called, with one geometry for each color and stroke. They span the rows
+//   of the frame, so the clip of the last row of text is removed first.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_DrawQueuedGridLines() noexcept
+try
+{
+    if (_queuedGridLines.empty())
+    {
+        return S_OK;
+    }
+
+    const auto clearQueueOnExit = wil::scope_exit([&]() noexcept { _queuedGridLines.clear(); });
+
+    LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
+
+    const auto existingColor = _d2dBrushForeground->GetColor();
+    const auto restoreBrushOnExit = wil::scope_exit([&]() noexcept { _d2dBrushForeground->SetColor(existingColor); });
+
+    for (const auto& stroke : _queuedGridLines)
+    {
+        ::Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+        RETURN_IF_FAILED(_d2dFactory->CreatePathGeometry(&geometry));
+        ::Microsoft::WRL::ComPtr<ID2D1GeometrySink> sink;
+        RETURN_IF_FAILED(geometry->Open(&sink));
+
+        // NOTE: Line coordinates are centered within the line, so they need to be
+        // offset by half the stroke width. For the start coordinate we add half
+        // the stroke width, and for the end coordinate we subtract half the width.
+        const auto halfWidth = stroke.width / 2.0f;
+        for (const auto& line : stroke.lines)
+        {
+            const auto horizontal = line.start.y == line.end.y;
+            const auto insetX = horizontal ? halfWidth : 0.0f;
+            const auto insetY = horizontal ? 0.0f : halfWidth;
+            sink->BeginFigure({ line.start.x + insetX, line.start.y + insetY }, D2D1_FIGURE_BEGIN_HOLLOW);
+            sink->AddLine({ line.end.x - insetX, line.end.y - insetY });
+            sink->EndFigure(D2D1_FIGURE_END_OPEN);
+        }
+        RETURN_IF_FAILED(sink->Close());
+
+        _d2dBrushForeground->SetColor(stroke.color);
+        _d2dDeviceContext->DrawGeometry(geometry.Get(), _d2dBrushForeground.Get(), stroke.width, stroke.style.Get());
+
+        _frameStatistics.gridLines += stroke.lines.size();
+        ++_frameStatistics.gridLineStrokes;
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
 // Routine Description:
 // - Paints lines around cells (draws in pieces of the grid)
+// - The lines are only queued up here. They're drawn above the text by
+//   _DrawQueuedGridLines, together with all the others of the frame.
 // Arguments:
 // - lines - Which grid lines (top, left, bottom, right) to draw
 // - color - The color to use for drawing the lines
@@ -1701,39 +2726,34 @@ CATCH_RETURN()
                                                      COORD const coordTarget) noexcept
 try
 {
-    const auto existingColor = _d2dBrushForeground->GetColor();
-    const auto restoreBrushOnExit = wil::scope_exit([&]() noexcept { _d2dBrushForeground->SetColor(existingColor); });
-
-    _d2dBrushForeground->SetColor(_ColorFFromColorRef(color));
-
+    const auto lineColor = _ColorFFromColorRef(color);
     const D2D1_SIZE_F font = _fontRenderData->GlyphCell();
     const D2D_POINT_2F target = { coordTarget.X * font.width, coordTarget.Y * font.height };
-    const auto fullRunWidth = font.width * gsl::narrow_cast<unsigned>(cchLine);
 
-    const auto DrawLine = [=](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) noexcept {
-        _d2dDeviceContext->DrawLine({ x0, y0 }, { x1, y1 }, _d2dBrushForeground.Get(), strokeWidth, _strokeStyle.Get());
+    const auto QueueLine = [&](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) {
+        _QueueGridLine({ x0, y0 }, { x1, y1 }, lineColor, strokeWidth, _strokeStyle.Get());
     };
 
-    const auto DrawHyperlinkLine = [=](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) noexcept {
-        _d2dDeviceContext->DrawLine({ x0, y0 }, { x1, y1 }, _d2dBrushForeground.Get(), strokeWidth, _hyperlinkStrokeStyle.Get());
+    const auto QueueHyperlinkLine = [&](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) {
+        _QueueGridLine({ x0, y0 }, { x1, y1 }, lineColor, strokeWidth, _hyperlinkStrokeStyle.Get());
     };
 
     // NOTE: Line coordinates are centered within the line, so they need to be
-    // offset by half the stroke width. For the start coordinate we add half
-    // the stroke width, and for the end coordinate we subtract half the width.
+    // offset by half the stroke width. Along the line, _DrawQueuedGridLines
+    // takes care of that. Across it, we do so here.
     const DxFontRenderData::LineMetrics lineMetrics = _fontRenderData->GetLineMetrics();
     if (WI_IsAnyFlagSet(lines, (GridLines::Left | GridLines::Right)))
     {
         const auto halfGridlineWidth = lineMetrics.gridlineWidth / 2.0f;
-        const auto startY = target.y + halfGridlineWidth;
-        const auto endY = target.y + font.height - halfGridlineWidth;
+        const auto startY = target.y;
+        const auto endY = target.y + font.height;
 
         if (WI_IsFlagSet(lines, GridLines::Left))
         {
             auto x = target.x + halfGridlineWidth;
             for (size_t i = 0; i < cchLine; i++, x += font.width)
             {
-                DrawLine(x, startY, x, endY, lineMetrics.gridlineWidth);
+                QueueLine(x, startY, x, endY, lineMetrics.gridlineWidth);
             }
         }
 
@@ -1742,27 +2762,30 @@ try
             auto x = target.x + font.width - halfGridlineWidth;
             for (size_t i = 0; i < cchLine; i++, x += font.width)
             {
-                DrawLine(x, startY, x, endY, lineMetrics.gridlineWidth);
+                QueueLine(x, startY, x, endY, lineMetrics.gridlineWidth);
             }
         }
     }
 
+    // The end is computed the same way as the start of the run that follows,
+    // so that _QueueGridLine can tell that they meet.
+    const auto startX = target.x;
+    const auto endX = (coordTarget.X + gsl::narrow_cast<unsigned>(cchLine)) * font.width;
+
     if (WI_IsAnyFlagSet(lines, GridLines::Top | GridLines::Bottom))
     {
         const auto halfGridlineWidth = lineMetrics.gridlineWidth / 2.0f;
-        const auto startX = target.x + halfGridlineWidth;
-        const auto endX = target.x + fullRunWidth - halfGridlineWidth;
 
         if (WI_IsFlagSet(lines, GridLines::Top))
         {
             const auto y = target.y + halfGridlineWidth;
-            DrawLine(startX, y, endX, y, lineMetrics.gridlineWidth);
+            QueueLine(startX, y, endX, y, lineMetrics.gridlineWidth);
         }
 
         if (WI_IsFlagSet(lines, GridLines::Bottom))
         {
             const auto y = target.y + font.height - halfGridlineWidth;
-            DrawLine(startX, y, endX, y, lineMetrics.gridlineWidth);
+            QueueLine(startX, y, endX, y, lineMetrics.gridlineWidth);
         }
     }
 
@@ -1771,38 +2794,74 @@ try
 
     if (WI_IsAnyFlagSet(lines, GridLines::Underline | GridLines::DoubleUnderline | GridLines::HyperlinkUnderline))
     {
-        const auto halfUnderlineWidth = lineMetrics.underlineWidth / 2.0f;
-        const auto startX = target.x + halfUnderlineWidth;
-        const auto endX = target.x + fullRunWidth - halfUnderlineWidth;
         const auto y = target.y + lineMetrics.underlineOffset;
 
         if (WI_IsFlagSet(lines, GridLines::Underline))
         {
-            DrawLine(startX, y, endX, y, lineMetrics.underlineWidth);
+            QueueLine(startX, y, endX, y, lineMetrics.underlineWidth);
         }
 
         if (WI_IsFlagSet(lines, GridLines::HyperlinkUnderline))
         {
-            DrawHyperlinkLine(startX, y, endX, y, lineMetrics.underlineWidth);
+            QueueHyperlinkLine(startX, y, endX, y, lineMetrics.underlineWidth);
         }
 
         if (WI_IsFlagSet(lines, GridLines::DoubleUnderline))
         {
-            DrawLine(startX, y, endX, y, lineMetrics.underlineWidth);
+            QueueLine(startX, y, endX, y, lineMetrics.underlineWidth);
             const auto y2 = target.y + lineMetrics.underlineOffset2;
-            DrawLine(startX, y2, endX, y2, lineMetrics.underlineWidth);
+            QueueLine(startX, y2, endX, y2, lineMetrics.underlineWidth);
         }
     }
 
     if (WI_IsFlagSet(lines, GridLines::Strikethrough))
     {
-        const auto halfStrikethroughWidth = lineMetrics.strikethroughWidth / 2.0f;
-        const auto startX = target.x + halfStrikethroughWidth;
-        const auto endX = target.x + fullRunWidth - halfStrikethroughWidth;
         const auto y = target.y + lineMetrics.strikethroughOffset;
+        QueueLine(startX, y, endX, y, lineMetrics.strikethroughWidth);
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Draws the image that covers a row, scaled from the cells of the image to
+//   ours. Its pixels are uploaded into a bitmap the first time a revision of
+//   the slice is drawn, after which drawing it again costs next to nothing.
+// Arguments:
+// - imageSlice - The part of the image that covers the row.
+// - targetRow - The row on the screen to draw it in.
+// - viewportLeft - The column of the buffer at the left edge of the screen.
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::PaintImageSlice(const ImageSlice& imageSlice,
+                                                const size_t targetRow,
+                                                const size_t viewportLeft) noexcept
+try
+{
+    if (imageSlice.PixelWidth() == 0)
+    {
+        return S_OK;
+    }
+
+    // The image is drawn above the text of the row.
+    RETURN_IF_FAILED(_DrawQueuedTextLines());
 
-        DrawLine(startX, y, endX, y, lineMetrics.strikethroughWidth);
+    auto& image = _imageCache[imageSlice.Revision()];
+    if (!image.bitmap)
+    {
+        const auto size = D2D1::SizeU(gsl::narrow<UINT32>(imageSlice.PixelWidth()), gsl::narrow<UINT32>(imageSlice.CellSize().height()));
+        const auto properties = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmap(size, imageSlice.Pixels().data(), size.width * sizeof(RGBQUAD), properties, &image.bitmap));
     }
+    image.lastFrame = _imageFrame;
+
+    const D2D1_SIZE_F font = _fontRenderData->GlyphCell();
+    const auto left = static_cast<float>(imageSlice.ColumnBegin()) - static_cast<float>(viewportLeft);
+    const auto right = static_cast<float>(imageSlice.ColumnEnd()) - static_cast<float>(viewportLeft);
+    const auto top = static_cast<float>(targetRow);
+    const D2D1_RECT_F rect{ left * font.width, top * font.height, right * font.width, (top + 1) * font.height };
+    _d2dDeviceContext->DrawBitmap(image.bitmap.Get(), rect, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
 
     return S_OK;
 }
@@ -1815,14 +2874,42 @@ CATCH_RETURN()
 // Return Value:
 // - S_OK or relevant DirectX error.
 [[nodiscard]] HRESULT DxEngine::PaintSelection(const SMALL_RECT rect) noexcept
+{
+    return _FillCells(rect, _selectionBackground);
+}
+
+// Routine Description:
+// - Paints the highlight of a search match. It's a fainter version of the
+//   selection, so that the selected match stands out among the others.
+// Arguments:
+//  - rect - Rectangle of the cells of the match
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::PaintSearchHighlight(const SMALL_RECT rect) noexcept
+{
+    auto color = _selectionBackground;
+    color.a /= 2;
+    return _FillCells(rect, color);
+}
+
+// Routine Description:
+// - Fills the given cells with a translucent color, above the text.
+// Arguments:
+//  - rect - Rectangle of the cells to fill
+//  - color - The color to fill them with
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_FillCells(const SMALL_RECT rect, const D2D1_COLOR_F color) noexcept
 try
 {
+    RETURN_IF_FAILED(_DrawQueuedTextLines());
+
     // If a clip rectangle is in place from drawing the text layer, remove it here.
     LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
 
     const auto existingColor = _d2dBrushForeground->GetColor();
 
-    _d2dBrushForeground->SetColor(_selectionBackground);
+    _d2dBrushForeground->SetColor(color);
     const auto resetColorOnExit = wil::scope_exit([&]() noexcept { _d2dBrushForeground->SetColor(existingColor); });
 
     const D2D1_RECT_F draw = til::rectangle{ Viewport::FromExclusive(rect).ToInclusive() }.scale_up(_fontRenderData->GlyphCell());
@@ -1846,45 +2933,204 @@ CATCH_RETURN()
 }
 
 // Routine Description:
-// - Paint terminal effects.
+// - Presents a blink of the cursor without painting a frame. If the cursor
+//   is all that was invalidated since the last frame and the row it's on was
+//   captured in the requested blink state before, it's copied back into the
+//   back buffer. No text needs to be laid out or drawn for that.
 // Arguments:
+// - options - The cursor to draw.
 // Return Value:
-// - S_OK or relevant DirectX error.
-[[nodiscard]] HRESULT DxEngine::_PaintTerminalEffects() noexcept
+// - S_OK if the cursor frame is ready to be presented, S_FALSE if a regular
+//   frame has to be painted instead, or a suitable DirectX error.
+[[nodiscard]] HRESULT DxEngine::PaintCursorFrame(const CursorOptions& options) noexcept
 try
 {
-    // Should have been initialized.
-    RETURN_HR_IF(E_NOT_VALID_STATE, !_framebufferCapture);
+    if (!_onlyCursorInvalid || _isPainting || _presentReady || !_haveDeviceResources || _recreateDeviceRequested ||
+        _firstFrame || _allInvalid || _windowOccluded || _presentOccluded || _titleChanged ||
+        _HasTerminalEffects() || _FullRepaintNeeded() || _displaySizePixels != _GetClientSize() || _prevScale != _scale)
+    {
+        return S_FALSE;
+    }
 
-    // Capture current frame in swap chain to a texture.
-    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
-    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&swapBuffer)));
-    _d3dDeviceContext->CopyResource(_framebufferCapture.Get(), swapBuffer.Get());
+    const auto& cache = _cursorRowCache;
+    const size_t state = options.isOn ? 1 : 0;
+    if (!cache.texture || !cache.cursor || !s_IsSameCursor(*cache.cursor, options) ||
+        cache.cellSize != _fontRenderData->GlyphCell() || !til::at(cache.captured, state))
+    {
+        return S_FALSE;
+    }
 
-    // Prepare captured texture as input resource to shader program.
-    D3D11_TEXTURE2D_DESC desc;
-    _framebufferCapture->GetDesc(&desc);
+    const auto row = _GetCursorRowRect(options);
+    if (row.empty())
+    {
+        return S_FALSE;
+    }
 
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MostDetailedMip = 0;
-    srvDesc.Texture2D.MipLevels = desc.MipLevels;
-    srvDesc.Format = desc.Format;
+    Microsoft::WRL::ComPtr<ID3D11Resource> backBuffer;
+    RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&backBuffer)));
+
+    const auto top = cache.cellSize.height<UINT>() * gsl::narrow_cast<UINT>(state);
+    const D3D11_BOX box{ 0, top, 0, row.width<UINT>(), top + row.height<UINT>(), 1 };
+    _d3dDeviceContext->CopySubresourceRegion(backBuffer.Get(), 0, row.left<UINT>(), row.top<UINT>(), 0, cache.texture.Get(), 0, &box);
+
+    // The cursor's rows were all that was invalid.
+    _invalidMap.reset_all();
+
+    _presentDirty.assign(1, row);
+    _presentParams.DirtyRectsCount = 1;
+    _presentParams.pDirtyRects = _presentDirty.data();
+    _presentReady = true;
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Gets the area of the back buffer that holds the row the cursor is on.
+// Arguments:
+// - options - The cursor.
+// Return Value:
+// - The row in pixels, clipped to the cells of the back buffer.
+[[nodiscard]] til::rectangle DxEngine::_GetCursorRowRect(const CursorOptions& options) const noexcept
+{
+    const auto cellSize = _fontRenderData->GlyphCell();
+    const til::rectangle field{ _invalidMap.size() * cellSize };
+    const til::rectangle row{ til::point{ static_cast<ptrdiff_t>(0), static_cast<ptrdiff_t>(options.coordCursor.Y) },
+                              til::size{ _invalidMap.size().width(), static_cast<ptrdiff_t>(1) } };
+    return row.scale_up(cellSize) & field;
+}
+
+// Routine Description:
+// - Copies the row the cursor is on out of the back buffer, after a frame was drawn.
+//   The row in the other blink state is kept, unless anything but the cursor
+//   was painted in this frame, in which case it might not be up to date anymore.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, S_FALSE if there's no cursor to capture, or a suitable DirectX error.
+[[nodiscard]] HRESULT DxEngine::_CaptureCursorRow() noexcept
+try
+{
+    auto& cache = _cursorRowCache;
+    const auto& cursor = _drawingContext->cursorInfo;
+    const auto cellSize = _fontRenderData->GlyphCell();
+
+    if (!_onlyCursorInvalid || !cache.cursor || !cursor || !s_IsSameCursor(*cache.cursor, *cursor) || cache.cellSize != cellSize)
+    {
+        cache.captured = {};
+    }
+
+    // The back buffer doesn't hold the final image when effects are applied in Present.
+    if (!cursor || _HasTerminalEffects() || _FullRepaintNeeded())
+    {
+        cache.cursor.reset();
+        return S_FALSE;
+    }
+
+    const auto row = _GetCursorRowRect(*cursor);
+    if (row.empty())
+    {
+        cache.cursor.reset();
+        return S_FALSE;
+    }
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer;
+    RETURN_IF_FAILED(_GetSwapChainBuffer(0, IID_PPV_ARGS(&backBuffer)));
+
+    D3D11_TEXTURE2D_DESC desc{};
+    backBuffer->GetDesc(&desc);
+    desc.Height = cellSize.height<UINT>() * 2;
+
+    D3D11_TEXTURE2D_DESC cacheDesc{};
+    if (cache.texture)
+    {
+        cache.texture->GetDesc(&cacheDesc);
+    }
+    if (!cache.texture || cacheDesc.Width != desc.Width || cacheDesc.Height != desc.Height)
+    {
+        cache.texture.Reset();
+        cache.captured = {};
+        desc.BindFlags = 0;
+        desc.MiscFlags = 0;
+        RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&desc, nullptr, &cache.texture));
+    }
+
+    const size_t state = cursor->isOn ? 1 : 0;
+    const auto top = cellSize.height<UINT>() * gsl::narrow_cast<UINT>(state);
+    const D3D11_BOX box{ row.left<UINT>(), row.top<UINT>(), 0, row.right<UINT>(), row.bottom<UINT>(), 1 };
+    _d3dDeviceContext->CopySubresourceRegion(cache.texture.Get(), 0, 0, top, 0, backBuffer.Get(), 0, &box);
+
+    cache.cursor = cursor;
+    cache.cellSize = cellSize;
+    til::at(cache.captured, state) = true;
+    return S_OK;
+}
+CATCH_RETURN()
 
-    ::Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResource;
-    RETURN_IF_FAILED(_d3dDevice->CreateShaderResourceView(_framebufferCapture.Get(), &srvDesc, &shaderResource));
+// Routine Description:
+// - Checks whether two cursors are drawn in the same place and the same way,
+//   no matter whether they've blinked on or off.
+// Arguments:
+// - a - The first cursor.
+// - b - The second cursor.
+// Return Value:
+// - true if both cursors only differ by their blink state.
+[[nodiscard]] bool DxEngine::s_IsSameCursor(const CursorOptions& a, const CursorOptions& b) noexcept
+{
+    return a.coordCursor == b.coordCursor &&
+           a.viewportLeft == b.viewportLeft &&
+           a.lineRendition == b.lineRendition &&
+           a.ulCursorHeightPercent == b.ulCursorHeightPercent &&
+           a.cursorPixelWidth == b.cursorPixelWidth &&
+           a.fIsDoubleWidth == b.fIsDoubleWidth &&
+           a.cursorType == b.cursorType &&
+           a.fUseColor == b.fUseColor &&
+           a.cursorColor == b.cursorColor;
+}
+
+// Routine Description:
+// - Paint terminal effects.
+// Arguments:
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_PaintTerminalEffects() noexcept
+try
+{
+    // Should have been initialized. The frame has already been drawn into
+    // _framebufferCapture (see _PrepareRenderTarget).
+    RETURN_HR_IF(E_NOT_VALID_STATE, !_drawingToEffectsTexture || !_framebufferCaptureView);
 
     // Render the screen quad with shader effects.
     const UINT stride = sizeof(ShaderInput);
     const UINT offset = 0;
 
+    D3D11_VIEWPORT vp;
+    vp.Width = _displaySizePixels.width<float>();
+    vp.Height = _displaySizePixels.height<float>();
+    vp.MinDepth = 0.0f;
+    vp.MaxDepth = 1.0f;
+    vp.TopLeftX = 0;
+    vp.TopLeftY = 0;
+
+    // The device context is shared with other engines (and Direct2D), which
+    // mustn't change the pipeline state while we're setting it up and drawing.
+    _d2dMultithread->Enter();
+    const auto leave = wil::scope_exit([&]() noexcept { _d2dMultithread->Leave(); });
+
+    // The time is otherwise only updated while drawing text,
+    // but an animated shader runs even if there's no new text.
+    if (_pixelShaderReadsTime)
+    {
+        _ComputePixelShaderSettings();
+    }
+
+    _d3dDeviceContext->RSSetViewports(1, &vp);
     _d3dDeviceContext->OMSetRenderTargets(1, _renderTargetView.GetAddressOf(), nullptr);
     _d3dDeviceContext->IASetVertexBuffers(0, 1, _screenQuadVertexBuffer.GetAddressOf(), &stride, &offset);
     _d3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
     _d3dDeviceContext->IASetInputLayout(_vertexLayout.Get());
     _d3dDeviceContext->VSSetShader(_vertexShader.Get(), nullptr, 0);
     _d3dDeviceContext->PSSetShader(_pixelShader.Get(), nullptr, 0);
-    _d3dDeviceContext->PSSetShaderResources(0, 1, shaderResource.GetAddressOf());
+    _d3dDeviceContext->PSSetShaderResources(0, 1, _framebufferCaptureView.GetAddressOf());
     _d3dDeviceContext->PSSetSamplers(0, 1, _samplerState.GetAddressOf());
     _d3dDeviceContext->PSSetConstantBuffers(0, 1, _pixelShaderSettingsBuffer.GetAddressOf());
     _d3dDeviceContext->Draw(ARRAYSIZE(_screenQuadVertices), 0);
@@ -1898,11 +3144,12 @@ CATCH_RETURN()
     // If someone explicitly requested differential rendering off, then we need to invalidate everything
     // so the entire frame is repainted.
     //
-    // If terminal effects are on, we must invalidate everything for them to draw correctly.
-    // Yes, this will further impact the performance of terminal effects.
-    // But we're talking about running the entire display pipeline through a shader for
-    // cosmetic effect, so performance isn't likely the top concern with this feature.
-    return _forceFullRepaintRendering || _HasTerminalEffects();
+    // Terminal effects overwrite the entire swap chain each frame, but we draw into
+    // _framebufferCapture for them, which still holds the previous frame.
+    //
+    // Repainting everything costs too much on a software device, which is why
+    // the setting is ignored there.
+    return _forceFullRepaintRendering && !_softwareDevice;
 }
 
 // Routine Description:
@@ -1928,13 +3175,25 @@ CATCH_RETURN()
     const bool usingTransparency = _defaultTextBackgroundOpacity != 1.0f;
     const bool forceOpaqueBG = usingCleartype && !usingTransparency;
 
-    const auto [colorForeground, colorBackground] = pData->GetAttributeColors(textAttributes);
+    const auto [colorForeground, colorBackground] = _GetAttributeColors(textAttributes, pData, isSettingDefaultBrushes);
+    const auto foreground = OPACITY_OPAQUE | colorForeground;
+    const auto background = (forceOpaqueBG ? OPACITY_OPAQUE : 0) | colorBackground;
 
-    _foregroundColor = _ColorFFromColorRef(OPACITY_OPAQUE | colorForeground);
-    _backgroundColor = _ColorFFromColorRef((forceOpaqueBG ? OPACITY_OPAQUE : 0) | colorBackground);
+    // Consecutive runs often only differ in attributes that don't affect
+    // their colors. The brushes (and the pixel shader, which depends on the
+    // background) are only updated when they do. They're always updated at
+    // the start of a frame, in case the brushes were recreated since the last.
+    const auto colorsChanged = isSettingDefaultBrushes || foreground != _lastBrushForeground || background != _lastBrushBackground;
+    if (colorsChanged)
+    {
+        _lastBrushForeground = foreground;
+        _lastBrushBackground = background;
+        _foregroundColor = _ColorFFromColorRef(foreground);
+        _backgroundColor = _ColorFFromColorRef(background);
 
-    _d2dBrushForeground->SetColor(_foregroundColor);
-    _d2dBrushBackground->SetColor(_backgroundColor);
+        _d2dBrushForeground->SetColor(_foregroundColor);
+        _d2dBrushBackground->SetColor(_backgroundColor);
+    }
 
     // If this flag is set, then we need to update the default brushes too and the swap chain background.
     if (isSettingDefaultBrushes)
@@ -1970,7 +3229,10 @@ CATCH_RETURN()
     }
 
     // Update pixel shader settings as background color might have changed
-    _ComputePixelShaderSettings();
+    if (colorsChanged)
+    {
+        _ComputePixelShaderSettings();
+    }
 
     return S_OK;
 }
@@ -1989,6 +3251,7 @@ try
 
     // Prepare the text layout.
     _customLayout = WRL::Make<CustomTextLayout>(_fontRenderData.get());
+    _queuedTextLayouts.clear();
 
     return S_OK;
 }
@@ -2111,6 +3374,13 @@ try
 {
     RETURN_HR_IF_NULL(E_INVALIDARG, pResult);
 
+    // The panes using the same font all ask about the same glyphs.
+    if (const auto isWide = _fontRenderData->FindGlyphWidth(glyph))
+    {
+        *pResult = *isWide;
+        return S_OK;
+    }
+
     const Cluster cluster(glyph, 0); // columns don't matter, we're doing analysis not layout.
 
     RETURN_IF_FAILED(_customLayout->Reset());
@@ -2120,6 +3390,7 @@ try
     RETURN_IF_FAILED(_customLayout->GetColumns(&columns));
 
     *pResult = columns != 1;
+    _fontRenderData->CacheGlyphWidth(glyph, *pResult);
 
     return S_OK;
 }
@@ -2154,6 +3425,7 @@ CATCH_RETURN();
     switch (_chainMode)
     {
     case SwapChainMode::ForHwnd:
+    case SwapChainMode::Offscreen:
     {
         return D2D1::ColorF(rgb);
     }
@@ -2237,6 +3509,94 @@ void DxEngine::UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept
     _hyperlinkHoveredId = hoveredId;
 }
 
+// Method Description:
+// - Informs this engine whether the window is hidden from the user, for
+//   instance because it was minimized or cloaked. While it is, StartPaint
+//   skips every frame and the invalid region accumulates, so that the
+//   first frame after the window becomes visible again catches up at once.
+//   The swap chain keeps the last frame in the meantime, which is what the
+//   user sees until then.
+// - May be called without holding the console lock.
+// Arguments:
+// - occluded: true if nothing we draw would be visible
+// Return Value:
+// - <none>
+void DxEngine::SetWindowOccluded(const bool occluded) noexcept
+{
+    _windowOccluded = occluded;
+}
+
+// Method Description:
+// - Releases the swap chain and every other device resource this engine holds,
+//   for instance because it's been hidden for a while and might stay hidden.
+//   The font and glyph data are kept. StartPaint recreates the device
+//   resources with the first frame it draws and announces the new swap chain
+//   through the callback, so hiding the window first keeps this from being
+//   undone right away.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::TrimDeviceResources() noexcept
+{
+    if (_haveDeviceResources && !_isPainting)
+    {
+        _ReleaseDeviceResources();
+    }
+}
+
+// Method Description:
+// - Estimates the bytes of GPU memory this engine holds on to. All of our
+//   textures are 4 bytes per pixel. The swap chain includes the offscreen
+//   buffers standing in for it and the copy of it the pixel shader reads.
+// Arguments:
+// - <none>
+// Return Value:
+// - The bytes held by the swap chain and the cached cursor rows and images.
+RenderMemoryUsage DxEngine::GetMemoryUsage() noexcept
+{
+    RenderMemoryUsage usage;
+    if (!_haveDeviceResources)
+    {
+        return usage;
+    }
+
+    const auto textureBytes = [](ID3D11Texture2D* const texture) noexcept -> size_t {
+        if (!texture)
+        {
+            return 0;
+        }
+        D3D11_TEXTURE2D_DESC desc{};
+        texture->GetDesc(&desc);
+        return size_t{ desc.Width } * desc.Height * desc.ArraySize * 4;
+    };
+
+    if (_dxgiSwapChain)
+    {
+        DXGI_SWAP_CHAIN_DESC1 desc{};
+        if (SUCCEEDED(_dxgiSwapChain->GetDesc1(&desc)))
+        {
+            usage.swapChain += size_t{ desc.Width } * desc.Height * desc.BufferCount * 4;
+        }
+    }
+    for (const auto& buffer : _offscreenBuffers)
+    {
+        usage.swapChain += textureBytes(buffer.Get());
+    }
+    usage.swapChain += textureBytes(_framebufferCapture.Get());
+
+    usage.caches += textureBytes(_cursorRowCache.texture.Get());
+    for (const auto& [revision, image] : _imageCache)
+    {
+        if (image.bitmap)
+        {
+            const auto size = image.bitmap->GetPixelSize();
+            usage.caches += size_t{ size.width } * size.height * 4;
+        }
+    }
+    return usage;
+}
+
 // Method Description:
 // - Informs this render engine about certain state for this frame at the
 //   beginning of this frame. We'll use it to get information about the cursor
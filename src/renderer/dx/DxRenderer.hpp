@@ -20,6 +20,7 @@
 #include <dwrite_1.h>
 #include <dwrite_2.h>
 #include <dwrite_3.h>
+#include <dcomp.h>
 
 #include <wrl.h>
 #include <wrl/client.h>
@@ -49,28 +50,45 @@ namespace Microsoft::Console::Render
         // Used to release device resources so that another instance of
         // conhost can render to the screen (i.e. only one DirectX
         // application may control the screen at a time.)
-        [[nodiscard]] HRESULT Enable() noexcept;
+        [[nodiscard]] HRESULT Enable() noexcept override;
         [[nodiscard]] HRESULT Disable() noexcept;
 
         [[nodiscard]] HRESULT SetHwnd(const HWND hwnd) noexcept;
+        [[nodiscard]] HRESULT SetHwndForComposition(const HWND hwnd) noexcept;
+        [[nodiscard]] HRESULT SetOffscreen() noexcept;
 
-        [[nodiscard]] HRESULT SetWindowSize(const SIZE pixels) noexcept;
+        [[nodiscard]] HRESULT SetWindowSize(const SIZE pixels) noexcept override;
 
-        void SetCallback(std::function<void()> pfn);
-        void SetWarningCallback(std::function<void(const HRESULT)> pfn);
+        void SetCallback(std::function<void()> pfn) override;
+        void SetWarningCallback(std::function<void(const HRESULT)> pfn) override;
 
-        void ToggleShaderEffects();
+        void ToggleShaderEffects() override;
 
-        bool GetRetroTerminalEffect() const noexcept;
-        void SetRetroTerminalEffect(bool enable) noexcept;
+        bool GetRetroTerminalEffect() const noexcept override;
+        void SetRetroTerminalEffect(bool enable) noexcept override;
 
-        void SetPixelShaderPath(std::wstring_view value) noexcept;
+        void SetPixelShaderPath(std::wstring_view value) noexcept override;
 
-        void SetForceFullRepaintRendering(bool enable) noexcept;
+        void SetForceFullRepaintRendering(bool enable) noexcept override;
 
-        void SetSoftwareRendering(bool enable) noexcept;
+        void SetSoftwareRendering(bool enable) noexcept override;
 
-        HANDLE GetSwapChainHandle();
+        void SetPreferredAdapter(std::wstring_view description) noexcept override;
+
+        HANDLE GetSwapChainHandle() override;
+
+        // What went into the last frame that was presented. The GPU time is
+        // only measured for offscreen targets (see SetOffscreen).
+        struct FrameStatistics
+        {
+            size_t shapedLines = 0;
+            size_t gridLines = 0;
+            size_t gridLineStrokes = 0;
+            ptrdiff_t presentedPixels = 0;
+            std::chrono::nanoseconds gpuTime{ 0 };
+        };
+        [[nodiscard]] FrameStatistics GetFrameStatistics() const noexcept;
+        [[nodiscard]] HRESULT ReadOffscreenPixels(std::vector<uint32_t>& pixels);
 
         // IRenderEngine Members
         [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
@@ -86,6 +104,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT EndPaint() noexcept override;
 
         [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
+        [[nodiscard]] bool SupportsSnapshotPainting() noexcept override;
 
         void WaitUntilCanRender() noexcept override;
         [[nodiscard]] HRESULT Present() noexcept override;
@@ -101,9 +120,14 @@ namespace Microsoft::Console::Render
                                               const bool lineWrapped) noexcept override;
 
         [[nodiscard]] HRESULT PaintBufferGridLines(GridLines const lines, COLORREF const color, size_t const cchLine, COORD const coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                              const size_t targetRow,
+                                              const size_t viewportLeft) noexcept override;
         [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
+        [[nodiscard]] HRESULT PaintSearchHighlight(const SMALL_RECT rect) noexcept override;
 
         [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
+        [[nodiscard]] HRESULT PaintCursorFrame(const CursorOptions& options) noexcept override;
 
         [[nodiscard]] HRESULT UpdateDrawingBrushes(const TextAttribute& textAttributes,
                                                    const gsl::not_null<IRenderData*> pData,
@@ -119,16 +143,19 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
         [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
 
-        [[nodiscard]] ::Microsoft::Console::Types::Viewport GetViewportInCharacters(const ::Microsoft::Console::Types::Viewport& viewInPixels) noexcept;
+        [[nodiscard]] ::Microsoft::Console::Types::Viewport GetViewportInCharacters(const ::Microsoft::Console::Types::Viewport& viewInPixels) noexcept override;
         [[nodiscard]] ::Microsoft::Console::Types::Viewport GetViewportInPixels(const ::Microsoft::Console::Types::Viewport& viewInCharacters) noexcept;
 
-        float GetScaling() const noexcept;
+        float GetScaling() const noexcept override;
 
-        void SetSelectionBackground(const COLORREF color, const float alpha = 0.5f) noexcept;
-        void SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept;
-        void SetDefaultTextBackgroundOpacity(const float opacity) noexcept;
+        void SetSelectionBackground(const COLORREF color, const float alpha = 0.5f) noexcept override;
+        void SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept override;
+        void SetDefaultTextBackgroundOpacity(const float opacity) noexcept override;
 
-        void UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept;
+        void UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept override;
+        void SetWindowOccluded(const bool occluded) noexcept override;
+        void TrimDeviceResources() noexcept override;
+        RenderMemoryUsage GetMemoryUsage() noexcept override;
 
     protected:
         [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring_view newTitle) noexcept override;
@@ -139,7 +166,8 @@ namespace Microsoft::Console::Render
         enum class SwapChainMode
         {
             ForHwnd,
-            ForComposition
+            ForComposition,
+            Offscreen
         };
 
         SwapChainMode _chainMode;
@@ -163,6 +191,8 @@ namespace Microsoft::Console::Render
 
         D2D1_COLOR_F _foregroundColor;
         D2D1_COLOR_F _backgroundColor;
+        COLORREF _lastBrushForeground{ 0 };
+        COLORREF _lastBrushBackground{ 0 };
         D2D1_COLOR_F _selectionBackground;
 
         uint16_t _hyperlinkHoveredId;
@@ -175,6 +205,31 @@ namespace Microsoft::Console::Render
         bool _allInvalid;
 
         bool _presentReady;
+
+        // Nothing but the cursor was invalidated since the last frame.
+        bool _onlyCursorInvalid;
+
+        // A blinking cursor only ever changes the row it's on. That row is copied
+        // out of the back buffer after every frame, once for each blink state,
+        // so that blinks can be presented by copying it back in (see PaintCursorFrame).
+        struct CursorRowCache
+        {
+            // The row with the cursor off, followed by the row with the cursor on.
+            ::Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+            // The cursor the rows were captured with, whether it was on aside.
+            std::optional<CursorOptions> cursor;
+            til::size cellSize;
+            std::array<bool, 2> captured{};
+        };
+        CursorRowCache _cursorRowCache;
+
+        // GH#1989: While the window is hidden from the user, nothing is drawn and
+        // the invalid region accumulates until it's visible again. _windowOccluded
+        // is reported by the host (minimized, cloaked), _presentOccluded by DXGI.
+        // The host flips _windowOccluded without the console lock, so that
+        // showing a window never has to wait for the output to be processed.
+        std::atomic<bool> _windowOccluded;
+        bool _presentOccluded;
         std::vector<RECT> _presentDirty;
         RECT _presentScroll;
         POINT _presentOffset;
@@ -184,6 +239,14 @@ namespace Microsoft::Console::Render
 
         wil::unique_handle _swapChainHandle;
 
+        // With SetHwndForComposition, the swap chain is shown in the window
+        // through DirectComposition, instead of being presented to it directly.
+        bool _hwndComposition;
+        wil::unique_hmodule _dcompModule;
+        ::Microsoft::WRL::ComPtr<IDCompositionDevice> _dcompDevice;
+        ::Microsoft::WRL::ComPtr<IDCompositionTarget> _dcompTarget;
+        ::Microsoft::WRL::ComPtr<IDCompositionVisual> _dcompVisual;
+
         // Device-Independent Resources
         ::Microsoft::WRL::ComPtr<ID2D1Factory1> _d2dFactory;
 
@@ -202,6 +265,23 @@ namespace Microsoft::Console::Render
         // Device-Dependent Resources
         bool _recreateDeviceRequested;
         bool _haveDeviceResources;
+
+        // The Direct3D and Direct2D devices are shared by all engines in the
+        // process, so that a window with many panes doesn't create a device for
+        // each of them. The swap chains and everything drawn into them aren't.
+        struct SharedDevice
+        {
+            ::Microsoft::WRL::ComPtr<ID3D11Device> d3dDevice;
+            ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3dDeviceContext;
+            ::Microsoft::WRL::ComPtr<IDXGIDevice> dxgiDevice;
+            ::Microsoft::WRL::ComPtr<ID2D1Device> d2dDevice;
+
+            // Whether the device renders on the CPU, because it's WARP or
+            // the Basic Render Driver of a machine without a display driver.
+            bool software = false;
+        };
+        std::shared_ptr<SharedDevice> _sharedDevice;
+        ::Microsoft::WRL::ComPtr<ID2D1Multithread> _d2dMultithread;
         ::Microsoft::WRL::ComPtr<ID3D11Device> _d3dDevice;
         ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> _d3dDeviceContext;
 
@@ -219,8 +299,69 @@ namespace Microsoft::Console::Render
         DXGI_SWAP_CHAIN_DESC1 _swapChainDesc;
         ::Microsoft::WRL::ComPtr<IDXGISwapChain1> _dxgiSwapChain;
         wil::unique_handle _swapChainFrameLatencyWaitableObject;
+
+        // Offscreen targets stand in for the swap chain with a back and a front
+        // buffer of their own, with the frame time measured between queries.
+        std::array<::Microsoft::WRL::ComPtr<ID3D11Texture2D>, 2> _offscreenBuffers;
+        ::Microsoft::WRL::ComPtr<ID3D11Query> _gpuDisjointQuery;
+        ::Microsoft::WRL::ComPtr<ID3D11Query> _gpuFrameStartQuery;
+        ::Microsoft::WRL::ComPtr<ID3D11Query> _gpuFrameEndQuery;
+        bool _gpuFrameTimed{ false };
+        FrameStatistics _frameStatistics;
+        FrameStatistics _lastFrameStatistics;
         std::unique_ptr<DrawingContext> _drawingContext;
 
+        // When a frame redraws most of the screen, PaintBufferLine only queues the
+        // lines up, so that they can be shaped on several threads before they're drawn.
+        // Each queued line gets a layout of its own. As the same layout is usually handed
+        // the same part of the screen every frame, each of them only caches a few lines.
+        struct QueuedTextLine
+        {
+            CustomTextLayout* layout;
+            D2D1_POINT_2F origin;
+            D2D1_COLOR_F foregroundColor;
+            D2D1_COLOR_F backgroundColor;
+            bool useItalicFont;
+            bool forceGrayscaleAA;
+            HRESULT hr;
+        };
+        static constexpr ptrdiff_t _minQueuedTextCells = 4000;
+        static constexpr size_t _queuedTextLayoutCacheSize = 4;
+        bool _queueTextLines;
+        std::vector<QueuedTextLine> _queuedTextLines;
+        std::vector<::Microsoft::WRL::ComPtr<CustomTextLayout>> _queuedTextLayouts;
+
+        // PaintBufferGridLines only queues its lines up as well, grouped by the
+        // color and stroke they're drawn with. Each group is drawn as a single
+        // geometry, and a horizontal line that continues where the last one of
+        // its group ended is merged into it. The ends of the lines are the edges
+        // of their cells. They're inset by half the stroke width when drawn.
+        struct QueuedGridLine
+        {
+            D2D1_POINT_2F start;
+            D2D1_POINT_2F end;
+        };
+        struct QueuedGridLineStroke
+        {
+            D2D1_COLOR_F color;
+            float width;
+            ::Microsoft::WRL::ComPtr<ID2D1StrokeStyle> style;
+            std::vector<QueuedGridLine> lines;
+        };
+        std::vector<QueuedGridLineStroke> _queuedGridLines;
+
+        // The images of the rows, each uploaded once for every revision of its
+        // slice. Once there are more than _imageCacheSize of them, the ones the
+        // last frame didn't draw are dropped again.
+        struct CachedImage
+        {
+            ::Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap;
+            uint64_t lastFrame;
+        };
+        static constexpr size_t _imageCacheSize = 256;
+        std::unordered_map<uint64_t, CachedImage> _imageCache;
+        uint64_t _imageFrame = 0;
+
         // Terminal effects resources.
 
         // Controls if configured terminal effects are enabled
@@ -236,6 +377,8 @@ namespace Microsoft::Console::Render
         //  Allows user to load a pixel shader from a few presets or from a file path
         std::wstring _pixelShaderPath;
         bool _pixelShaderLoaded{ false };
+        bool _pixelShaderReadsTime{ false };
+        bool _drawingToEffectsTexture{ false };
 
         std::chrono::steady_clock::time_point _shaderStartTime;
 
@@ -248,10 +391,19 @@ namespace Microsoft::Console::Render
         ::Microsoft::WRL::ComPtr<ID3D11Buffer> _pixelShaderSettingsBuffer;
         ::Microsoft::WRL::ComPtr<ID3D11SamplerState> _samplerState;
         ::Microsoft::WRL::ComPtr<ID3D11Texture2D> _framebufferCapture;
+        ::Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> _framebufferCaptureView;
 
         // Preferences and overrides
         bool _softwareRendering;
         bool _forceFullRepaintRendering;
+        std::wstring _preferredAdapter;
+
+        // On a software device (see SharedDevice) the engine leaves out the
+        // shader effects, always presents partially and caps the frame rate,
+        // so that rendering doesn't starve everything else of the CPU.
+        static constexpr std::chrono::milliseconds SoftwarePresentInterval{ 33 };
+        bool _softwareDevice;
+        std::chrono::steady_clock::time_point _lastPresentTime;
 
         D2D1_TEXT_ANTIALIAS_MODE _antialiasingMode;
 
@@ -271,11 +423,20 @@ namespace Microsoft::Console::Render
         } _pixelShaderSettings;
 
         [[nodiscard]] HRESULT _CreateDeviceResources(const bool createSwapChain) noexcept;
+        [[nodiscard]] static ::Microsoft::WRL::ComPtr<ID2D1Factory1> s_GetSharedFactory();
+        [[nodiscard]] static std::shared_ptr<SharedDevice> s_GetSharedDevice(ID2D1Factory1* const factory, IDXGIAdapter1* const adapter, const bool softwareRendering);
+        [[nodiscard]] static bool s_IsSoftwareDevice(IDXGIDevice* const device) noexcept;
+        [[nodiscard]] ::Microsoft::WRL::ComPtr<IDXGIAdapter1> _SelectAdapter() const;
         [[nodiscard]] HRESULT _CreateSurfaceHandle() noexcept;
+        [[nodiscard]] HRESULT _CreateHwndCompositionSwapChain() noexcept;
+        [[nodiscard]] HRESULT _CreateOffscreenBuffers(const til::size size) noexcept;
+        [[nodiscard]] HRESULT _GetSwapChainBuffer(const UINT index, REFIID riid, void** buffer) noexcept;
+        [[nodiscard]] HRESULT _PresentOffscreen() noexcept;
 
         bool _HasTerminalEffects() const noexcept;
         std::string _LoadPixelShaderFile() const;
         HRESULT _SetupTerminalEffects();
+        [[nodiscard]] HRESULT _PrepareTerminalEffectsTarget() noexcept;
         void _ComputePixelShaderSettings() noexcept;
 
         [[nodiscard]] HRESULT _PrepareRenderTarget() noexcept;
@@ -291,6 +452,16 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT _CopyFrontToBack() noexcept;
 
+        [[nodiscard]] HRESULT _DrawQueuedTextLines() noexcept;
+        void _QueueGridLine(const D2D1_POINT_2F start, const D2D1_POINT_2F end, const D2D1_COLOR_F color, const float width, ID2D1StrokeStyle* const style);
+        [[nodiscard]] HRESULT _DrawQueuedGridLines() noexcept;
+        [[nodiscard]] HRESULT _FillCells(const SMALL_RECT rect, const D2D1_COLOR_F color) noexcept;
+
+        [[nodiscard]] til::rectangle _GetCursorRowRect(const CursorOptions& options) const noexcept;
+        [[nodiscard]] HRESULT _CaptureCursorRow() noexcept;
+        [[nodiscard]] static bool s_IsSameCursor(const CursorOptions& a, const CursorOptions& b) noexcept;
+        static void s_CoalesceDirtyRects(std::vector<til::rectangle>& rects);
+
         [[nodiscard]] HRESULT _EnableDisplayAccess(const bool outputEnabled) noexcept;
 
         [[nodiscard]] til::size _GetClientSize() const;
@@ -310,5 +481,9 @@ namespace Microsoft::Console::Render
         {
             return { color.r, color.g, color.b, color.a };
         }
+
+#ifdef UNIT_TESTING
+        friend class DxEngineTests;
+#endif
     };
 }
@@ -25,6 +25,7 @@
 #include <dxgi1_3.h>
 
 #include <d3d11.h>
+#include <d3d11_4.h>
 #include <d2d1.h>
 #include <d2d1_1.h>
 #include <d2d1_2.h>
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../BoxGlyphs.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class BoxGlyphsTests
+{
+    TEST_CLASS(BoxGlyphsTests);
+
+    TEST_METHOD(LinesReachTheCellEdges)
+    {
+        const BoxGlyphs glyphs{ til::size{ 10, 20 }, 1.0f };
+
+        // U+2500 is made of a left and a right half, which together span the cell.
+        const auto horizontal = glyphs.Lookup(L'\x2500');
+        VERIFY_ARE_EQUAL(size_t{ 2 }, horizontal.size());
+        VERIFY_ARE_EQUAL(0.0f, til::at(horizontal, 0).left);
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(til::at(horizontal, 0).right, til::at(horizontal, 1).left);
+        VERIFY_ARE_EQUAL(10.0f, til::at(horizontal, 1).right);
+        VERIFY_ARE_EQUAL(9.0f, til::at(horizontal, 0).top);
+        VERIFY_ARE_EQUAL(10.0f, til::at(horizontal, 0).bottom);
+
+        // U+2502 goes from the top to the bottom.
+        const auto vertical = glyphs.Lookup(L'\x2502');
+        VERIFY_ARE_EQUAL(size_t{ 2 }, vertical.size());
+        VERIFY_ARE_EQUAL(0.0f, til::at(vertical, 0).top);
+        VERIFY_ARE_EQUAL(20.0f, til::at(vertical, 1).bottom);
+
+        // The corner of U+250C is closed: the right arm starts where the
+        // down arm starts, and both sit where the straight lines do.
+        const auto corner = glyphs.Lookup(L'\x250C');
+        VERIFY_ARE_EQUAL(size_t{ 2 }, corner.size());
+        VERIFY_ARE_EQUAL(til::at(vertical, 0).left, til::at(corner, 0).left);
+        VERIFY_ARE_EQUAL(til::at(horizontal, 0).top, til::at(corner, 0).top);
+        VERIFY_ARE_EQUAL(til::at(horizontal, 0).top, til::at(corner, 1).top);
+        VERIFY_ARE_EQUAL(20.0f, til::at(corner, 1).bottom);
+    }
+
+    TEST_METHOD(BlocksAreSizedInEighths)
+    {
+        const BoxGlyphs glyphs{ til::size{ 10, 20 }, 1.0f };
+
+        const auto full = glyphs.Lookup(L'\x2588');
+        VERIFY_ARE_EQUAL(size_t{ 1 }, full.size());
+        VERIFY_ARE_EQUAL(0.0f, til::at(full, 0).left);
+        VERIFY_ARE_EQUAL(0.0f, til::at(full, 0).top);
+        VERIFY_ARE_EQUAL(10.0f, til::at(full, 0).right);
+        VERIFY_ARE_EQUAL(20.0f, til::at(full, 0).bottom);
+
+        const auto upperHalf = glyphs.Lookup(L'\x2580');
+        VERIFY_ARE_EQUAL(size_t{ 1 }, upperHalf.size());
+        VERIFY_ARE_EQUAL(10.0f, til::at(upperHalf, 0).bottom);
+
+        // 7/8 of 20 pixels are rounded to full pixels.
+        const auto lowerEighth = glyphs.Lookup(L'\x2581');
+        VERIFY_ARE_EQUAL(size_t{ 1 }, lowerEighth.size());
+        VERIFY_ARE_EQUAL(18.0f, til::at(lowerEighth, 0).top);
+
+        const auto leftHalf = glyphs.Lookup(L'\x258C');
+        VERIFY_ARE_EQUAL(size_t{ 1 }, leftHalf.size());
+        VERIFY_ARE_EQUAL(5.0f, til::at(leftHalf, 0).right);
+
+        VERIFY_ARE_EQUAL(size_t{ 3 }, glyphs.Lookup(L'\x2599').size());
+    }
+
+    TEST_METHOD(OtherCharactersAreLeftToTheFont)
+    {
+        const BoxGlyphs glyphs{ til::size{ 10, 20 }, 1.0f };
+
+        VERIFY_IS_TRUE(glyphs.Lookup(L'a').empty());
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x2504').empty()); // dashed line
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x256D').empty()); // arc
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x2592').empty()); // shade
+        VERIFY_IS_FALSE(glyphs.Lookup(L'\x2554').empty());
+
+        // Double lines are left to the font if they don't fit into the cell.
+        const BoxGlyphs tiny{ til::size{ 2, 4 }, 1.0f };
+        VERIFY_IS_TRUE(tiny.Lookup(L'\x2550').empty());
+        VERIFY_IS_FALSE(tiny.Lookup(L'\x2500').empty());
+    }
+};
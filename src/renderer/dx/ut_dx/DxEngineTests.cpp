@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../DxRenderer.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class Microsoft::Console::Render::DxEngineTests
+{
+    TEST_CLASS(DxEngineTests);
+
+    TEST_METHOD(CoalesceStacksRowsOfTheSameWidth)
+    {
+        // Three full rows and, after a gap, two rows of a single cell.
+        std::vector<til::rectangle> rects{
+            til::rectangle{ 0, 0, 800, 20 },
+            til::rectangle{ 0, 20, 800, 40 },
+            til::rectangle{ 0, 40, 800, 60 },
+            til::rectangle{ 100, 400, 110, 420 },
+            til::rectangle{ 100, 420, 110, 440 },
+        };
+        DxEngine::s_CoalesceDirtyRects(rects);
+
+        // The rows are far apart, so the two blocks stay separate.
+        VERIFY_ARE_EQUAL(size_t{ 2 }, rects.size());
+        VERIFY_ARE_EQUAL((til::rectangle{ 0, 0, 800, 60 }), til::at(rects, 0));
+        VERIFY_ARE_EQUAL((til::rectangle{ 100, 400, 110, 440 }), til::at(rects, 1));
+    }
+
+    TEST_METHOD(CoalesceMergesNearbyRects)
+    {
+        // Two cells typed in consecutive rows, just a column apart.
+        std::vector<til::rectangle> rects{
+            til::rectangle{ 100, 20, 110, 40 },
+            til::rectangle{ 110, 40, 120, 60 },
+        };
+        DxEngine::s_CoalesceDirtyRects(rects);
+
+        VERIFY_ARE_EQUAL(size_t{ 1 }, rects.size());
+        VERIFY_ARE_EQUAL((til::rectangle{ 100, 20, 120, 60 }), til::at(rects, 0));
+    }
+
+    TEST_METHOD(CoalesceLimitsTheNumberOfRects)
+    {
+        // Every other row has a changed cell, too far apart to be merged for their area alone.
+        std::vector<til::rectangle> rects;
+        for (ptrdiff_t row = 0; row < 40; row += 2)
+        {
+            rects.emplace_back(row * 100, row * 100, row * 100 + 10, row * 100 + 20);
+        }
+        const auto original = rects;
+        DxEngine::s_CoalesceDirtyRects(rects);
+
+        VERIFY_IS_LESS_THAN_OR_EQUAL(rects.size(), size_t{ 8 });
+
+        // Whatever was merged, everything that was dirty is still covered.
+        for (const auto& rc : original)
+        {
+            VERIFY_IS_TRUE(std::any_of(rects.begin(), rects.end(), [&](const auto& merged) { return (merged & rc) == rc; }));
+        }
+    }
+
+    TEST_METHOD(OffscreenFramesArePresented)
+    {
+        DxEngine engine;
+        engine.SetSoftwareRendering(true);
+        VERIFY_SUCCEEDED(engine.SetOffscreen());
+
+        const FontInfoDesired desired{ L"Consolas", 0, DWRITE_FONT_WEIGHT_NORMAL, { 0, 12 }, CP_UTF8 };
+        FontInfo actual{ L"", 0, 0, { 0, 0 }, CP_UTF8 };
+        VERIFY_SUCCEEDED(engine.UpdateDpi(USER_DEFAULT_SCREEN_DPI));
+        VERIFY_SUCCEEDED(engine.UpdateFont(desired, actual));
+
+        COORD cell{};
+        VERIFY_SUCCEEDED(engine.GetFontSize(&cell));
+        VERIFY_SUCCEEDED(engine.SetWindowSize({ cell.X * 10, cell.Y * 4 }));
+        VERIFY_SUCCEEDED(engine.Enable());
+
+        const std::array<Cluster, 1> clusters{ Cluster{ L"a", 1 } };
+        const auto paintFrame = [&]() {
+            VERIFY_SUCCEEDED(engine.StartPaint());
+            VERIFY_SUCCEEDED(engine.PaintBackground());
+            VERIFY_SUCCEEDED(engine.PaintBufferLine(clusters, { 0, 1 }, false, false));
+            VERIFY_SUCCEEDED(engine.EndPaint());
+            VERIFY_SUCCEEDED(engine.Present());
+        };
+
+        Log::Comment(L"The first frame is presented as a whole.");
+        paintFrame();
+        auto statistics = engine.GetFrameStatistics();
+        VERIFY_ARE_EQUAL(size_t{ 1 }, statistics.shapedLines);
+        VERIFY_ARE_EQUAL(ptrdiff_t{ cell.X * 10 * cell.Y * 4 }, statistics.presentedPixels);
+
+        std::vector<uint32_t> pixels;
+        VERIFY_SUCCEEDED(engine.ReadOffscreenPixels(pixels));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(cell.X * 10 * cell.Y * 4), pixels.size());
+        VERIFY_ARE_EQUAL(0xff000000u, pixels.front() & 0xff000000u);
+
+        Log::Comment(L"After that, only the invalidated row is.");
+        const SMALL_RECT row{ 2, 1, 3, 2 };
+        VERIFY_SUCCEEDED(engine.Invalidate(&row));
+        paintFrame();
+        statistics = engine.GetFrameStatistics();
+        VERIFY_ARE_EQUAL(ptrdiff_t{ cell.X * 10 * cell.Y }, statistics.presentedPixels);
+    }
+
+    TEST_METHOD(GridLinesAreMergedIntoStrokes)
+    {
+        DxEngine engine;
+        engine.SetSoftwareRendering(true);
+        VERIFY_SUCCEEDED(engine.SetOffscreen());
+
+        const FontInfoDesired desired{ L"Consolas", 0, DWRITE_FONT_WEIGHT_NORMAL, { 0, 12 }, CP_UTF8 };
+        FontInfo actual{ L"", 0, 0, { 0, 0 }, CP_UTF8 };
+        VERIFY_SUCCEEDED(engine.UpdateDpi(USER_DEFAULT_SCREEN_DPI));
+        VERIFY_SUCCEEDED(engine.UpdateFont(desired, actual));
+
+        COORD cell{};
+        VERIFY_SUCCEEDED(engine.GetFontSize(&cell));
+        VERIFY_SUCCEEDED(engine.SetWindowSize({ cell.X * 10, cell.Y * 4 }));
+        VERIFY_SUCCEEDED(engine.Enable());
+
+        const auto red = RGB(255, 0, 0);
+        const auto blue = RGB(0, 0, 255);
+        VERIFY_SUCCEEDED(engine.StartPaint());
+        VERIFY_SUCCEEDED(engine.PaintBackground());
+
+        Log::Comment(L"Three adjacent underlined runs of the same color become one line.");
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, red, 2, { 0, 0 }));
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, red, 3, { 2, 0 }));
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, red, 1, { 5, 0 }));
+
+        Log::Comment(L"A gap or another row starts a new line of the same stroke.");
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, red, 2, { 7, 0 }));
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, red, 2, { 0, 1 }));
+
+        Log::Comment(L"Another color or stroke style is another stroke.");
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::Underline, blue, 2, { 2, 1 }));
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::HyperlinkUnderline, red, 2, { 0, 2 }));
+        VERIFY_SUCCEEDED(engine.PaintBufferGridLines(IRenderEngine::GridLines::HyperlinkUnderline, red, 2, { 2, 2 }));
+
+        VERIFY_SUCCEEDED(engine.EndPaint());
+        VERIFY_SUCCEEDED(engine.Present());
+
+        const auto statistics = engine.GetFrameStatistics();
+        VERIFY_ARE_EQUAL(size_t{ 5 }, statistics.gridLines);
+        VERIFY_ARE_EQUAL(size_t{ 3 }, statistics.gridLineStrokes);
+    }
+};
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../DxFontRenderData.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class DxFontRenderDataTests
+{
+    TEST_CLASS(DxFontRenderDataTests);
+
+    TEST_CLASS_SETUP(ClassSetup)
+    {
+        THROW_IF_FAILED(DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED,
+                                            __uuidof(_dwriteFactory),
+                                            reinterpret_cast<IUnknown**>(_dwriteFactory.GetAddressOf())));
+        return true;
+    }
+
+    TEST_METHOD(InstancesShareTheirFont)
+    {
+        const FontInfoDesired desired{ L"Consolas", 0, DWRITE_FONT_WEIGHT_NORMAL, { 0, 12 }, CP_UTF8 };
+        FontInfo actual{ L"", 0, 0, { 0, 0 }, CP_UTF8 };
+
+        DxFontRenderData first{ _dwriteFactory };
+        DxFontRenderData second{ _dwriteFactory };
+        VERIFY_SUCCEEDED(first.UpdateFont(desired, actual, USER_DEFAULT_SCREEN_DPI));
+        const auto firstSize = actual.GetSize();
+        VERIFY_SUCCEEDED(second.UpdateFont(desired, actual, USER_DEFAULT_SCREEN_DPI));
+
+        Log::Comment(L"The second instance gets the same font objects and metrics.");
+        VERIFY_ARE_EQUAL(first.DefaultFontFace().Get(), second.DefaultFontFace().Get());
+        VERIFY_ARE_EQUAL(first.DefaultTextFormat().Get(), second.DefaultTextFormat().Get());
+        VERIFY_ARE_EQUAL(first.ItalicTextFormat().Get(), second.ItalicTextFormat().Get());
+        VERIFY_ARE_EQUAL(first.DefaultBoxDrawingEffect().Get(), second.DefaultBoxDrawingEffect().Get());
+        VERIFY_ARE_EQUAL(firstSize, actual.GetSize());
+        VERIFY_ARE_EQUAL(first.GlyphCell(), second.GlyphCell());
+
+        Log::Comment(L"Glyph widths measured with one instance are known to the other.");
+        VERIFY_IS_FALSE(second.FindGlyphWidth(L"\x2500").has_value());
+        first.CacheGlyphWidth(L"\x2500", false);
+        VERIFY_IS_TRUE(second.FindGlyphWidth(L"\x2500") == std::optional<bool>{ false });
+
+        Log::Comment(L"A different DPI is a different font.");
+        DxFontRenderData third{ _dwriteFactory };
+        VERIFY_SUCCEEDED(third.UpdateFont(desired, actual, USER_DEFAULT_SCREEN_DPI * 2));
+        VERIFY_ARE_NOT_EQUAL(first.DefaultTextFormat().Get(), third.DefaultTextFormat().Get());
+        VERIFY_IS_FALSE(third.FindGlyphWidth(L"\x2500").has_value());
+    }
+
+private:
+    ::Microsoft::WRL::ComPtr<IDWriteFactory1> _dwriteFactory;
+};
@@ -16,6 +16,8 @@ Author(s):
 
 #include "../inc/RenderEngineBase.hpp"
 
+#include <bitset>
+
 namespace Microsoft::Console::Render
 {
     class GdiEngine final : public RenderEngineBase
@@ -92,13 +94,39 @@ namespace Microsoft::Console::Render
         HDC _hdcMemoryContext;
         bool _isTrueTypeFont;
         UINT _fontCodepage;
-        HFONT _hfont;
-        HFONT _hfontItalic;
         TEXTMETRICW _tmFontMetrics;
 
-        static const size_t s_cPolyTextCache = 80;
-        POLYTEXTW _pPolyText[s_cPolyTextCache];
-        size_t _cPolyText;
+        // The fonts created for a LOGFONT, together with the metrics measured
+        // for them. They're cached for the whole process (see _GetFont), so
+        // that switching between screen buffers or asking for the size of a
+        // font at another DPI doesn't create and measure the same fonts again.
+        struct FontResource
+        {
+            wil::unique_hfont font;
+            wil::unique_hfont fontItalic;
+            std::wstring faceName;
+            BYTE pitchAndFamily;
+            LONG weight;
+            COORD size;
+        };
+        std::shared_ptr<const FontResource> _font;
+
+        // Caches the results of IsGlyphWideByFont for the current font.
+        // Reset every time the font (or the DPI) changes.
+        std::bitset<0x10000> _glyphWidthMeasured;
+        std::bitset<0x10000> _glyphWidthWide;
+
+        // A run of text submitted by PaintBufferLine, together with the brushes
+        // it needs to be drawn with. The text and widths live in the frame arenas
+        // at textOffset and are only resolved into polyText when flushed.
+        struct PolyTextRun
+        {
+            COLORREF foreground;
+            COLORREF background;
+            bool italic;
+            size_t textOffset;
+            POLYTEXTW polyText;
+        };
         [[nodiscard]] HRESULT _FlushBufferLines() noexcept;
 
         std::vector<RECT> cursorInvertRects;
@@ -139,8 +167,10 @@ namespace Microsoft::Console::Render
         // frequently created and dropped.
         // It's important the pool is first so it can be given to the others on construction.
         std::pmr::unsynchronized_pool_resource _pool;
-        std::pmr::vector<std::pmr::wstring> _polyStrings;
-        std::pmr::vector<std::pmr::basic_string<int>> _polyWidths;
+        std::pmr::vector<PolyTextRun> _polyTextRuns;
+        std::pmr::wstring _polyTextArena;
+        std::pmr::vector<int> _polyWidthArena;
+        std::pmr::vector<POLYTEXTW> _polyTextBatch;
 
         [[nodiscard]] HRESULT _InvalidCombine(const RECT* const prc) noexcept;
         [[nodiscard]] HRESULT _InvalidOffset(const POINT* const ppt) noexcept;
@@ -171,10 +201,13 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _GetProposedFont(const FontInfoDesired& FontDesired,
                                                _Out_ FontInfo& Font,
                                                const int iDpi,
-                                               _Inout_ wil::unique_hfont& hFont,
-                                               _Inout_ wil::unique_hfont& hFontItalic) noexcept;
+                                               _Inout_ std::shared_ptr<const FontResource>& font) noexcept;
+        [[nodiscard]] HRESULT _GetFont(const bool isDefaultRasterFont,
+                                       const LOGFONTW& logFont,
+                                       _Inout_ std::shared_ptr<const FontResource>& font) noexcept;
 
         COORD _GetFontSize() const;
+        HFONT _GetFontHandle(const bool italic) const noexcept;
         bool _IsMinimized() const;
         bool _IsWindowValid() const;
 
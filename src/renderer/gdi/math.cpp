@@ -45,6 +45,16 @@ using namespace Microsoft::Console::Render;
     if (glyph.size() == 1)
     {
         const wchar_t wch = glyph.front();
+
+        // The answer only depends on the current font (at the current DPI),
+        // so we only need to ask GDI once per glyph until UpdateFont is called.
+        if (_glyphWidthMeasured.test(wch))
+        {
+            *pResult = _glyphWidthWide.test(wch);
+            return S_OK;
+        }
+
+        bool measured = false;
         if (_IsFontTrueType())
         {
             ABC abc;
@@ -53,6 +63,7 @@ using namespace Microsoft::Console::Render;
                 int const totalWidth = abc.abcA + abc.abcB + abc.abcC;
 
                 isFullWidth = totalWidth > _GetFontSize().X;
+                measured = true;
             }
         }
         else
@@ -61,8 +72,15 @@ using namespace Microsoft::Console::Render;
             if (GetCharWidth32W(_hdcMemoryContext, wch, wch, &cpxWidth))
             {
                 isFullWidth = cpxWidth > _GetFontSize().X;
+                measured = true;
             }
         }
+
+        if (measured)
+        {
+            _glyphWidthMeasured.set(wch);
+            _glyphWidthWide.set(wch, isFullWidth);
+        }
     }
     else
     {
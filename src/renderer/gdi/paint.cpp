@@ -31,7 +31,9 @@ using namespace Microsoft::Console::Render;
     RETURN_HR_IF(S_FALSE, (!IsWindowVisible(_hwndTargetWindow) && !_titleChanged));
 
     // At the beginning of a new frame, we have 0 lines ready for painting in PolyTextOut
-    _cPolyText = 0;
+    _polyTextRuns.clear();
+    _polyTextArena.clear();
+    _polyWidthArena.clear();
 
     // Prepare our in-memory bitmap for double-buffered composition.
     RETURN_IF_FAILED(_PrepareMemoryBitmap(_hwndTargetWindow));
@@ -295,7 +297,8 @@ using namespace Microsoft::Console::Render;
 
 // Routine Description:
 // - Draws one line of the buffer to the screen.
-// - This will now be cached in a PolyText buffer and flushed periodically instead of drawing every individual segment. Note this means that the PolyText buffer must be flushed before some operations (changing the brush color, drawing lines on top of the characters, inverting for cursor/selection, etc.)
+// - This will now be cached in a PolyText buffer and flushed periodically instead of drawing every individual segment. Note this means that the PolyText buffer must be flushed before some operations (changing the line transform, drawing lines on top of the characters, inverting for cursor/selection, etc.)
+// - The brushes are recorded with every run instead of flushing when they change, so that runs of the same color can be drawn together. See _FlushBufferLines.
 // Arguments:
 // - clusters - text to be written and columns expected per cluster
 // - coord - character coordinate target to render within viewport
@@ -326,14 +329,16 @@ using namespace Microsoft::Console::Render;
         POINT ptDraw = { 0 };
         RETURN_IF_FAILED(_ScaleByFont(&coord, &ptDraw));
 
-        const auto pPolyTextLine = &_pPolyText[_cPolyText];
-
-        auto& polyString = _polyStrings.emplace_back(cchLine, UNICODE_NULL);
+        // The text and widths of all runs in this frame are appended to the same arenas,
+        // which keep their capacity from frame to frame.
+        const auto textOffset = _polyTextArena.size();
+        _polyTextArena.resize(textOffset + cchLine, UNICODE_NULL);
+        _polyWidthArena.resize(textOffset + cchLine, 0);
+        const auto polyString = gsl::make_span(_polyTextArena).subspan(textOffset);
+        const auto polyWidth = gsl::make_span(_polyWidthArena).subspan(textOffset);
 
         COORD const coordFontSize = _GetFontSize();
 
-        auto& polyWidth = _polyWidths.emplace_back(cchLine, 0);
-
         // Sum up the total widths the entire line/run is expected to take while
         // copying the pixel widths into a structure to direct GDI how many pixels to use per character.
         size_t cchCharWidths = 0;
@@ -382,7 +387,7 @@ using namespace Microsoft::Console::Render;
                         if (cchConverted != 0)
                         {
                             // If all successful, use this instead.
-                            polyString.swap(polyConvert);
+                            std::copy_n(polyConvert.begin(), std::min<size_t>(cchConverted, cchLine), polyString.begin());
                         }
                     }
                 }
@@ -395,7 +400,14 @@ using namespace Microsoft::Console::Render;
         const auto topOffset = _currentLineRendition == LineRendition::DoubleHeightBottom ? halfHeight : 0;
         const auto bottomOffset = _currentLineRendition == LineRendition::DoubleHeightTop ? halfHeight : 0;
 
-        pPolyTextLine->lpstr = polyString.data();
+        auto& run = _polyTextRuns.emplace_back();
+        run.foreground = _lastFg;
+        run.background = _lastBg;
+        run.italic = _lastFontItalic;
+        run.textOffset = textOffset;
+
+        // lpstr and pdx are filled in by _FlushBufferLines, as the arenas may still grow.
+        const auto pPolyTextLine = &run.polyText;
         pPolyTextLine->n = gsl::narrow<UINT>(clusters.size());
         pPolyTextLine->x = ptDraw.x;
         pPolyTextLine->y = ptDraw.y;
@@ -404,20 +416,12 @@ using namespace Microsoft::Console::Render;
         pPolyTextLine->rcl.top = pPolyTextLine->y + topOffset;
         pPolyTextLine->rcl.right = pPolyTextLine->rcl.left + (SHORT)cchCharWidths;
         pPolyTextLine->rcl.bottom = pPolyTextLine->y + coordFontSize.Y - bottomOffset;
-        pPolyTextLine->pdx = polyWidth.data();
 
         if (trimLeft)
         {
             pPolyTextLine->rcl.left += coordFontSize.X;
         }
 
-        _cPolyText++;
-
-        if (_cPolyText >= s_cPolyTextCache)
-        {
-            LOG_IF_FAILED(_FlushBufferLines());
-        }
-
         return S_OK;
     }
     CATCH_RETURN();
@@ -425,32 +429,77 @@ using namespace Microsoft::Console::Render;
 
 // Routine Description:
 // - Flushes any buffer lines in the PolyTextOut cache by drawing them and freeing the strings.
+// - The runs are grouped by their brushes, so that each color only costs a single
+//   PolyTextOutW call, instead of one call per attribute change. This is fine since
+//   the runs are opaque and clipped to their cells and thus never overlap.
 // - See also: PaintBufferLine
 // Arguments:
 // - <none>
 // Return Value:
 // - S_OK or E_FAIL if GDI failed.
 [[nodiscard]] HRESULT GdiEngine::_FlushBufferLines() noexcept
+try
 {
+    if (_polyTextRuns.empty())
+    {
+        return S_OK;
+    }
+
+    // The arenas keep their capacity for the next batch.
+    auto clearRuns = wil::scope_exit([&]() noexcept {
+        _polyTextRuns.clear();
+        _polyTextArena.clear();
+        _polyWidthArena.clear();
+    });
+
+    const auto brushes = [](const PolyTextRun& run) noexcept {
+        return std::tie(run.foreground, run.background, run.italic);
+    };
+
+    // A stable sort keeps the runs of each color in the order they were painted.
+    std::stable_sort(_polyTextRuns.begin(), _polyTextRuns.end(), [&](const auto& a, const auto& b) noexcept {
+        return brushes(a) < brushes(b);
+    });
+
     HRESULT hr = S_OK;
 
-    if (_cPolyText > 0)
+    for (auto it = _polyTextRuns.begin(); it != _polyTextRuns.end();)
     {
-        if (!PolyTextOutW(_hdcMemoryContext, _pPolyText, (UINT)_cPolyText))
+        const auto& first = *it;
+
+        _polyTextBatch.clear();
+        for (; it != _polyTextRuns.end() && brushes(*it) == brushes(first); ++it)
         {
-            hr = E_FAIL;
+            auto& polyText = _polyTextBatch.emplace_back(it->polyText);
+            polyText.lpstr = &til::at(_polyTextArena, it->textOffset);
+            polyText.pdx = &til::at(_polyWidthArena, it->textOffset);
         }
 
-        _polyStrings.clear();
-        _polyWidths.clear();
+        SetTextColor(_hdcMemoryContext, first.foreground);
+        SetBkColor(_hdcMemoryContext, first.background);
+        SelectFont(_hdcMemoryContext, _GetFontHandle(first.italic));
 
-        ZeroMemory(_pPolyText, sizeof(_pPolyText));
+        if (!PolyTextOutW(_hdcMemoryContext, _polyTextBatch.data(), gsl::narrow<UINT>(_polyTextBatch.size())))
+        {
+            hr = E_FAIL;
+        }
+    }
 
-        _cPolyText = 0;
+    // UpdateDrawingBrushes only updates what changed, so the device
+    // context has to be left in the state it expects it to be in.
+    if (_lastFg != INVALID_COLOR)
+    {
+        SetTextColor(_hdcMemoryContext, _lastFg);
+    }
+    if (_lastBg != INVALID_COLOR)
+    {
+        SetBkColor(_hdcMemoryContext, _lastBg);
     }
+    SelectFont(_hdcMemoryContext, _GetFontHandle(_lastFontItalic));
 
     RETURN_HR(hr);
 }
+CATCH_RETURN()
 
 // Routine Description:
 // - Draws up to one line worth of grid lines on top of characters.
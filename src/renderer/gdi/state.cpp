@@ -25,7 +25,6 @@ GdiEngine::GdiEngine() :
 #endif
     _iCurrentDpi(s_iBaseDpi),
     _hbitmapMemorySurface(nullptr),
-    _cPolyText(0),
     _fInvalidRectUsed(false),
     _lastFg(INVALID_COLOR),
     _lastBg(INVALID_COLOR),
@@ -34,13 +33,12 @@ GdiEngine::GdiEngine() :
     _currentLineRendition(LineRendition::SingleWidth),
     _fPaintStarted(false),
     _invalidCharacters{},
-    _hfont(nullptr),
-    _hfontItalic(nullptr),
     _pool{ til::pmr::get_default_resource() }, // It's important the pool is first so it can be given to the others on construction.
-    _polyStrings{ &_pool },
-    _polyWidths{ &_pool }
+    _polyTextRuns{ &_pool },
+    _polyTextArena{ &_pool },
+    _polyWidthArena{ &_pool },
+    _polyTextBatch{ &_pool }
 {
-    ZeroMemory(_pPolyText, sizeof(POLYTEXTW) * s_cPolyTextCache);
     _rcInvalid = { 0 };
     _szInvalidScroll = { 0 };
     _szMemorySurface = { 0 };
@@ -79,31 +77,14 @@ GdiEngine::GdiEngine() :
 // - <none>
 GdiEngine::~GdiEngine()
 {
-    for (size_t iPoly = 0; iPoly < _cPolyText; iPoly++)
-    {
-        if (_pPolyText[iPoly].lpstr != nullptr)
-        {
-            delete[] _pPolyText[iPoly].lpstr;
-        }
-    }
-
     if (_hbitmapMemorySurface != nullptr)
     {
         LOG_HR_IF(E_FAIL, !(DeleteObject(_hbitmapMemorySurface)));
         _hbitmapMemorySurface = nullptr;
     }
 
-    if (_hfont != nullptr)
-    {
-        LOG_HR_IF(E_FAIL, !(DeleteObject(_hfont)));
-        _hfont = nullptr;
-    }
-
-    if (_hfontItalic != nullptr)
-    {
-        LOG_HR_IF(E_FAIL, !(DeleteObject(_hfontItalic)));
-        _hfontItalic = nullptr;
-    }
+    // Our fonts are (usually) kept alive by the font cache, see _GetFont.
+    _font.reset();
 
     if (_hdcMemoryContext != nullptr)
     {
@@ -143,9 +124,9 @@ GdiEngine::~GdiEngine()
     _hdcMemoryContext = hdcNewMemoryContext;
 
     // If we have a font, apply it to the context.
-    if (nullptr != _hfont)
+    if (_font)
     {
-        LOG_HR_IF_NULL(E_FAIL, SelectFont(_hdcMemoryContext, _hfont));
+        LOG_HR_IF_NULL(E_FAIL, SelectFont(_hdcMemoryContext, _GetFontHandle(false)));
     }
 
     // Record the fact that the selected font is not italic.
@@ -277,12 +258,12 @@ GdiEngine::~GdiEngine()
                                                       const gsl::not_null<IRenderData*> pData,
                                                       const bool isSettingDefaultBrushes) noexcept
 {
-    RETURN_IF_FAILED(_FlushBufferLines());
-
+    // Pending text isn't flushed here. Every run remembers the brushes it was
+    // submitted with, so that _FlushBufferLines can batch them across the frame.
     RETURN_HR_IF_NULL(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), _hdcMemoryContext);
 
     // Set the colors for painting text
-    const auto [colorForeground, colorBackground] = pData->GetAttributeColors(textAttributes);
+    const auto [colorForeground, colorBackground] = _GetAttributeColors(textAttributes, pData, isSettingDefaultBrushes);
 
     if (colorForeground != _lastFg)
     {
@@ -308,7 +289,7 @@ GdiEngine::~GdiEngine()
     const auto fontItalic = textAttributes.IsItalic();
     if (fontItalic != _lastFontItalic)
     {
-        SelectFont(_hdcMemoryContext, fontItalic ? _hfontItalic : _hfont);
+        SelectFont(_hdcMemoryContext, _GetFontHandle(fontItalic));
         _lastFontItalic = fontItalic;
     }
 
@@ -325,11 +306,11 @@ GdiEngine::~GdiEngine()
 // - S_OK if set successfully or relevant GDI error via HRESULT.
 [[nodiscard]] HRESULT GdiEngine::UpdateFont(const FontInfoDesired& FontDesired, _Out_ FontInfo& Font) noexcept
 {
-    wil::unique_hfont hFont, hFontItalic;
-    RETURN_IF_FAILED(_GetProposedFont(FontDesired, Font, _iCurrentDpi, hFont, hFontItalic));
+    std::shared_ptr<const FontResource> font;
+    RETURN_IF_FAILED(_GetProposedFont(FontDesired, Font, _iCurrentDpi, font));
 
     // Select into DC
-    RETURN_HR_IF_NULL(E_FAIL, SelectFont(_hdcMemoryContext, hFont.get()));
+    RETURN_HR_IF_NULL(E_FAIL, SelectFont(_hdcMemoryContext, font->font.get()));
 
     // Record the fact that the selected font is not italic.
     _lastFontItalic = false;
@@ -395,25 +376,12 @@ GdiEngine::~GdiEngine()
     // Now find the size of a 0 in this current font and save it for conversions done later.
     _coordFontLast = Font.GetSize();
 
-    // Persist font for cleanup (and free existing if necessary)
-    if (_hfont != nullptr)
-    {
-        LOG_HR_IF(E_FAIL, !(DeleteObject(_hfont)));
-        _hfont = nullptr;
-    }
-
-    // Save the font.
-    _hfont = hFont.release();
-
-    // Persist italic font for cleanup (and free existing if necessary)
-    if (_hfontItalic != nullptr)
-    {
-        LOG_HR_IF(E_FAIL, !(DeleteObject(_hfontItalic)));
-        _hfontItalic = nullptr;
-    }
+    // Save the fonts. This releases the previous ones, unless the font cache still holds on to them.
+    _font = std::move(font);
 
-    // Save the italic font.
-    _hfontItalic = hFontItalic.release();
+    // Any glyph widths we measured belong to the previous font.
+    _glyphWidthMeasured.reset();
+    _glyphWidthWide.reset();
 
     // Save raster vs. TrueType and codepage data in case we need to convert.
     _isTrueTypeFont = Font.IsTrueTypeFont();
@@ -461,8 +429,8 @@ GdiEngine::~GdiEngine()
 // - S_OK if set successfully or relevant GDI error via HRESULT.
 [[nodiscard]] HRESULT GdiEngine::GetProposedFont(const FontInfoDesired& FontDesired, _Out_ FontInfo& Font, const int iDpi) noexcept
 {
-    wil::unique_hfont hFont, hFontItalic;
-    return _GetProposedFont(FontDesired, Font, iDpi, hFont, hFontItalic);
+    std::shared_ptr<const FontResource> font;
+    return _GetProposedFont(FontDesired, Font, iDpi, font);
 }
 
 // Method Description:
@@ -487,34 +455,21 @@ GdiEngine::~GdiEngine()
 // - FontDesired - reference to font information we should use while instantiating a font.
 // - Font - the actual font
 // - iDpi - The DPI we will have when rendering
-// - hFont - A smart pointer to receive a handle to a ready-to-use GDI font.
-// - hFontItalic - A smart pointer to receive a handle to an italic variant of the font.
+// - font - Receives the ready-to-use GDI fonts (regular and italic) and their metrics.
 // Return Value:
 // - S_OK if set successfully or relevant GDI error via HRESULT.
 [[nodiscard]] HRESULT GdiEngine::_GetProposedFont(const FontInfoDesired& FontDesired,
                                                   _Out_ FontInfo& Font,
                                                   const int iDpi,
-                                                  _Inout_ wil::unique_hfont& hFont,
-                                                  _Inout_ wil::unique_hfont& hFontItalic) noexcept
+                                                  _Inout_ std::shared_ptr<const FontResource>& font) noexcept
+try
 {
-    wil::unique_hdc hdcTemp(CreateCompatibleDC(_hdcMemoryContext));
-    RETURN_HR_IF_NULL(E_FAIL, hdcTemp.get());
-
     // Get a special engine size because TT fonts can't specify X or we'll get weird scaling under some circumstances.
     COORD coordFontRequested = FontDesired.GetEngineSize();
 
-    // First, check to see if we're asking for the default raster font.
-    if (FontDesired.IsDefaultRasterFont())
-    {
-        // We're being asked for the default raster font, which gets special handling. In particular, it's the font
-        // returned by GetStockObject(OEM_FIXED_FONT).
-        // We do this because, for instance, if we ask GDI for an 8x12 OEM_FIXED_FONT,
-        // it may very well decide to choose Courier New instead of the Terminal raster.
-#pragma prefast(suppress : 38037, "raster fonts get special handling, we need to get it this way")
-        hFont.reset((HFONT)GetStockObject(OEM_FIXED_FONT));
-        hFontItalic.reset((HFONT)GetStockObject(OEM_FIXED_FONT));
-    }
-    else
+    // The default raster font gets special handling, see _GetFont.
+    LOGFONTW lf = { 0 };
+    if (!FontDesired.IsDefaultRasterFont())
     {
         // For future reference, here is the engine weighting and internal details on Windows Font Mapping:
         // https://msdn.microsoft.com/en-us/library/ms969909.aspx
@@ -530,7 +485,6 @@ GdiEngine::~GdiEngine()
         // While you're at it, make sure that the behavior matches what happens in the Fonts property sheet. Pay very close
         // attention to the font previews to ensure that the font being selected by GDI is exactly the font requested --
         // some monospace fonts look very similar.
-        LOGFONTW lf = { 0 };
         lf.lfHeight = s_ScaleByDpi(coordFontRequested.Y, iDpi);
         lf.lfWidth = s_ScaleByDpi(coordFontRequested.X, iDpi);
         lf.lfWeight = FontDesired.GetWeight();
@@ -568,32 +522,127 @@ GdiEngine::~GdiEngine()
         lf.lfPitchAndFamily = (FIXED_PITCH | FF_MODERN);
 
         RETURN_IF_FAILED(FontDesired.FillLegacyNameBuffer(gsl::make_span(lf.lfFaceName)));
+    }
+
+    RETURN_IF_FAILED(_GetFont(FontDesired.IsDefaultRasterFont(), lf, font));
+
+    // Now fill up the FontInfo we were passed with the full details of which font we actually chose
+    const auto coordFont = font->size;
+    if (FontDesired.IsDefaultRasterFont())
+    {
+        coordFontRequested = coordFont;
+    }
+    else if (coordFontRequested.X == 0)
+    {
+        coordFontRequested.X = (SHORT)s_ShrinkByDpi(coordFont.X, iDpi);
+    }
+
+    Font.SetFromEngine(font->faceName,
+                       font->pitchAndFamily,
+                       gsl::narrow_cast<unsigned int>(font->weight),
+                       FontDesired.IsDefaultRasterFont(),
+                       coordFont,
+                       coordFontRequested);
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Returns the fonts for the given LOGFONT, creating and measuring them if
+//   they aren't in our cache yet.
+// - The cache is shared by the whole process and keeps the few most recently
+//   used fonts. Screen buffers (including the alt buffer) usually ask for the
+//   same font over and over, and so do the DPI probes during a monitor move.
+// Arguments:
+// - isDefaultRasterFont - true if we're asking for the default raster font, in
+//   which case logFont is ignored.
+// - logFont - the description of the font to create.
+// - font - receives the fonts and their metrics.
+// Return Value:
+// - S_OK if set successfully or relevant GDI error via HRESULT.
+[[nodiscard]] HRESULT GdiEngine::_GetFont(const bool isDefaultRasterFont,
+                                          const LOGFONTW& logFont,
+                                          _Inout_ std::shared_ptr<const FontResource>& font) noexcept
+try
+{
+    struct CacheEntry
+    {
+        bool isDefaultRasterFont;
+        LOGFONTW logFont;
+        std::shared_ptr<const FontResource> font;
+    };
+    static constexpr size_t maxCacheSize = 8;
+    static std::mutex cacheLock;
+    static std::vector<CacheEntry> cache;
+
+    const auto matches = [&](const CacheEntry& entry) noexcept {
+        if (entry.isDefaultRasterFont || isDefaultRasterFont)
+        {
+            return entry.isDefaultRasterFont == isDefaultRasterFont;
+        }
+        // The face name buffer isn't necessarily zeroed past the terminator.
+        return memcmp(&entry.logFont, &logFont, offsetof(LOGFONTW, lfFaceName)) == 0 &&
+               wcsncmp(entry.logFont.lfFaceName, logFont.lfFaceName, LF_FACESIZE) == 0;
+    };
+
+    {
+        std::scoped_lock lock{ cacheLock };
+        const auto it = std::find_if(cache.begin(), cache.end(), matches);
+        if (it != cache.end())
+        {
+            // Keep the most recently used fonts at the front, so that we evict the oldest one.
+            std::rotate(cache.begin(), it, it + 1);
+            font = cache.front().font;
+            return S_OK;
+        }
+    }
+
+    auto resource = std::make_shared<FontResource>();
+
+    if (isDefaultRasterFont)
+    {
+        // We're being asked for the default raster font, which gets special handling. In particular, it's the font
+        // returned by GetStockObject(OEM_FIXED_FONT).
+        // We do this because, for instance, if we ask GDI for an 8x12 OEM_FIXED_FONT,
+        // it may very well decide to choose Courier New instead of the Terminal raster.
+#pragma prefast(suppress : 38037, "raster fonts get special handling, we need to get it this way")
+        resource->font.reset((HFONT)GetStockObject(OEM_FIXED_FONT));
+        resource->fontItalic.reset((HFONT)GetStockObject(OEM_FIXED_FONT));
+    }
+    else
+    {
+        LOGFONTW lf = logFont;
 
         // Create font.
-        hFont.reset(CreateFontIndirectW(&lf));
-        RETURN_HR_IF_NULL(E_FAIL, hFont.get());
+        resource->font.reset(CreateFontIndirectW(&lf));
+        RETURN_HR_IF_NULL(E_FAIL, resource->font.get());
 
         // Create italic variant of the font.
         lf.lfItalic = TRUE;
-        hFontItalic.reset(CreateFontIndirectW(&lf));
-        RETURN_HR_IF_NULL(E_FAIL, hFontItalic.get());
+        resource->fontItalic.reset(CreateFontIndirectW(&lf));
+        RETURN_HR_IF_NULL(E_FAIL, resource->fontItalic.get());
     }
 
+    wil::unique_hdc hdcTemp(CreateCompatibleDC(_hdcMemoryContext));
+    RETURN_HR_IF_NULL(E_FAIL, hdcTemp.get());
+
     // Select into DC
-    wil::unique_hfont hFontOld(SelectFont(hdcTemp.get(), hFont.get()));
+    wil::unique_hfont hFontOld(SelectFont(hdcTemp.get(), resource->font.get()));
     RETURN_HR_IF_NULL(E_FAIL, hFontOld.get());
 
     // Save off the font metrics for various other calculations
     TEXTMETRICW tm;
     RETURN_HR_IF(E_FAIL, !(GetTextMetricsW(hdcTemp.get(), &tm)));
+    resource->pitchAndFamily = tm.tmPitchAndFamily;
+    resource->weight = tm.tmWeight;
 
     // Now find the size of a 0 in this current font and save it for conversions done later.
     SIZE sz;
     RETURN_HR_IF(E_FAIL, !(GetTextExtentPoint32W(hdcTemp.get(), L"0", 1, &sz)));
 
-    COORD coordFont;
-    coordFont.X = static_cast<SHORT>(sz.cx);
-    coordFont.Y = static_cast<SHORT>(sz.cy);
+    resource->size.X = static_cast<SHORT>(sz.cx);
+    resource->size.Y = static_cast<SHORT>(sz.cy);
 
     // The extent point won't necessarily be perfect for the width, so get the ABC metrics for the 0 if possible to improve the measurement.
     // This will fail for non-TrueType fonts and we'll fall back to what GetTextExtentPoint said.
@@ -606,14 +655,13 @@ GdiEngine::~GdiEngine()
             // No negatives or zeros or we'll have bad character-to-pixel math later.
             if (abcTotal > 0)
             {
-                coordFont.X = static_cast<SHORT>(abcTotal);
+                resource->size.X = static_cast<SHORT>(abcTotal);
             }
         }
     }
 
-    // Now fill up the FontInfo we were passed with the full details of which font we actually chose
+    // Get the actual font face that we chose
     {
-        // Get the actual font face that we chose
         const size_t faceNameLength{ gsl::narrow<size_t>(GetTextFaceW(hdcTemp.get(), 0, nullptr)) };
 
         std::wstring currentFaceName{};
@@ -622,26 +670,22 @@ GdiEngine::~GdiEngine()
         RETURN_HR_IF(E_FAIL, !(GetTextFaceW(hdcTemp.get(), gsl::narrow_cast<int>(faceNameLength), currentFaceName.data())));
 
         currentFaceName.resize(faceNameLength - 1); // remove the null terminator (wstring!)
+        resource->faceName = std::move(currentFaceName);
+    }
 
-        if (FontDesired.IsDefaultRasterFont())
-        {
-            coordFontRequested = coordFont;
-        }
-        else if (coordFontRequested.X == 0)
+    {
+        std::scoped_lock lock{ cacheLock };
+        if (cache.size() == maxCacheSize)
         {
-            coordFontRequested.X = (SHORT)s_ShrinkByDpi(coordFont.X, iDpi);
+            cache.pop_back();
         }
-
-        Font.SetFromEngine(currentFaceName,
-                           tm.tmPitchAndFamily,
-                           gsl::narrow_cast<unsigned int>(tm.tmWeight),
-                           FontDesired.IsDefaultRasterFont(),
-                           coordFont,
-                           coordFontRequested);
+        cache.insert(cache.begin(), CacheEntry{ isDefaultRasterFont, logFont, resource });
     }
 
+    font = std::move(resource);
     return S_OK;
 }
+CATCH_RETURN();
 
 // Routine Description:
 // - Retrieves the current pixel size of the font we have selected for drawing.
@@ -655,6 +699,21 @@ GdiEngine::~GdiEngine()
     return S_OK;
 }
 
+// Routine Description:
+// - Retrieves the handle of the font we have selected for drawing.
+// Arguments:
+// - italic - true to retrieve the italic variant of the font.
+// Return Value:
+// - The font handle, or nullptr if no font was selected yet.
+HFONT GdiEngine::_GetFontHandle(const bool italic) const noexcept
+{
+    if (!_font)
+    {
+        return nullptr;
+    }
+    return italic ? _font->fontItalic.get() : _font->font.get();
+}
+
 // Routine Description:
 // - Retrieves the current pixel size of the font we have selected for drawing.
 // Arguments:
@@ -23,12 +23,15 @@ public:
     DummyRenderTarget() {}
     void TriggerRedraw(const Microsoft::Console::Types::Viewport& /*region*/) override {}
     void TriggerRedraw(const COORD* const /*pcoord*/) override {}
+    void TriggerRedrawContent(const Microsoft::Console::Types::Viewport& /*region*/) override {}
     void TriggerRedrawCursor(const COORD* const /*pcoord*/) override {}
     void TriggerRedrawAll() override {}
     void TriggerTeardown() noexcept override {}
     void TriggerSelection() override {}
     void TriggerScroll() override {}
     void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
+    void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& /*region*/, const SHORT /*delta*/) override {}
     void TriggerCircling() override {}
     void TriggerTitleChange() override {}
+    void SetSynchronizedOutput(const bool /*enabled*/) override {}
 };
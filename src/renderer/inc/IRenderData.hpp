@@ -69,7 +69,13 @@ namespace Microsoft::Console::Render
         virtual const std::wstring GetHyperlinkUri(uint16_t id) const noexcept = 0;
         virtual const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept = 0;
 
-        virtual const std::vector<size_t> GetPatternId(const COORD location) const noexcept = 0;
+        // Fills ids with the regex pattern IDs of the location. The vector is
+        // meant to be reused, so that nothing is allocated for every cell.
+        virtual void GetPatternId(const COORD location, std::vector<size_t>& ids) const noexcept = 0;
+
+        // Returns the line-by-line rectangles of the search matches that are
+        // highlighted within the viewport, in buffer coordinates.
+        virtual std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept = 0;
 
     protected:
         IRenderData() = default;
@@ -19,6 +19,11 @@ Author(s):
 #include "FontInfoDesired.hpp"
 #include "IRenderData.hpp"
 #include "../../buffer/out/LineRendition.hpp"
+#include "../../types/inc/viewport.hpp"
+
+#include <d2d1.h>
+
+class ImageSlice;
 
 namespace Microsoft::Console::Render
 {
@@ -27,6 +32,13 @@ namespace Microsoft::Console::Render
         std::optional<CursorOptions> cursorInfo;
     };
 
+    // The bytes an engine holds on to, mostly on the GPU, to draw its frames.
+    struct RenderMemoryUsage
+    {
+        size_t swapChain = 0; // the buffers the frames are drawn into and presented from
+        size_t caches = 0; // glyphs, images and whatever else is kept from one frame to the next
+    };
+
     class IRenderEngine
     {
     public:
@@ -57,6 +69,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] virtual HRESULT EndPaint() noexcept = 0;
 
         [[nodiscard]] virtual bool RequiresContinuousRedraw() noexcept = 0;
+        [[nodiscard]] virtual bool SupportsSnapshotPainting() noexcept = 0;
         virtual void WaitUntilCanRender() noexcept = 0;
         [[nodiscard]] virtual HRESULT Present() noexcept = 0;
 
@@ -69,6 +82,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] virtual HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept = 0;
+        [[nodiscard]] virtual HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const SHORT delta) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateAll() noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept = 0;
 
@@ -90,9 +104,14 @@ namespace Microsoft::Console::Render
                                                            const COLORREF color,
                                                            const size_t cchLine,
                                                            const COORD coordTarget) noexcept = 0;
+        [[nodiscard]] virtual HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                                      const size_t targetRow,
+                                                      const size_t viewportLeft) noexcept = 0;
         [[nodiscard]] virtual HRESULT PaintSelection(const SMALL_RECT rect) noexcept = 0;
+        [[nodiscard]] virtual HRESULT PaintSearchHighlight(const SMALL_RECT rect) noexcept = 0;
 
         [[nodiscard]] virtual HRESULT PaintCursor(const CursorOptions& options) noexcept = 0;
+        [[nodiscard]] virtual HRESULT PaintCursorFrame(const CursorOptions& options) noexcept = 0;
 
         [[nodiscard]] virtual HRESULT UpdateDrawingBrushes(const TextAttribute& textAttributes,
                                                            const gsl::not_null<IRenderData*> pData,
@@ -110,6 +129,32 @@ namespace Microsoft::Console::Render
         [[nodiscard]] virtual HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept = 0;
         [[nodiscard]] virtual HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept = 0;
         [[nodiscard]] virtual HRESULT UpdateTitle(const std::wstring_view newTitle) noexcept = 0;
+
+        // The following members are used by hosts that draw into a swap chain,
+        // like the Terminal control, which can pick between multiple DirectX
+        // based engines. The other engines fall back to the no-op defaults
+        // provided by RenderEngineBase.
+        [[nodiscard]] virtual HRESULT Enable() noexcept = 0;
+        [[nodiscard]] virtual HRESULT SetWindowSize(const SIZE pixels) noexcept = 0;
+        virtual void SetCallback(std::function<void()> pfn) = 0;
+        virtual void SetWarningCallback(std::function<void(const HRESULT)> pfn) = 0;
+        virtual void ToggleShaderEffects() = 0;
+        virtual bool GetRetroTerminalEffect() const noexcept = 0;
+        virtual void SetRetroTerminalEffect(bool enable) noexcept = 0;
+        virtual void SetPixelShaderPath(std::wstring_view value) noexcept = 0;
+        virtual void SetForceFullRepaintRendering(bool enable) noexcept = 0;
+        virtual void SetSoftwareRendering(bool enable) noexcept = 0;
+        virtual void SetPreferredAdapter(std::wstring_view description) noexcept = 0;
+        virtual HANDLE GetSwapChainHandle() = 0;
+        [[nodiscard]] virtual ::Microsoft::Console::Types::Viewport GetViewportInCharacters(const ::Microsoft::Console::Types::Viewport& viewInPixels) noexcept = 0;
+        virtual float GetScaling() const noexcept = 0;
+        virtual void SetSelectionBackground(const COLORREF color, const float alpha = 0.5f) noexcept = 0;
+        virtual void SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept = 0;
+        virtual void SetDefaultTextBackgroundOpacity(const float opacity) noexcept = 0;
+        virtual void UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept = 0;
+        virtual void SetWindowOccluded(const bool occluded) noexcept = 0;
+        virtual void TrimDeviceResources() noexcept = 0;
+        virtual RenderMemoryUsage GetMemoryUsage() noexcept = 0;
     };
 
     inline Microsoft::Console::Render::IRenderEngine::~IRenderEngine() {}
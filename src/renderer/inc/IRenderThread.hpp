@@ -25,6 +25,7 @@ namespace Microsoft::Console::Render
         IRenderThread& operator=(IRenderThread&&) = default;
 
         virtual void NotifyPaint() = 0;
+        virtual void NotifyInput() = 0;
         virtual void EnablePainting() = 0;
         virtual void DisablePainting() = 0;
         virtual void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) = 0;
@@ -36,6 +36,7 @@ namespace Microsoft::Console::Render
 
         virtual void TriggerRedraw(const Microsoft::Console::Types::Viewport& region) = 0;
         virtual void TriggerRedraw(const COORD* const pcoord) = 0;
+        virtual void TriggerRedrawContent(const Microsoft::Console::Types::Viewport& region) = 0;
         virtual void TriggerRedrawCursor(const COORD* const pcoord) = 0;
 
         virtual void TriggerRedrawAll() = 0;
@@ -44,8 +45,10 @@ namespace Microsoft::Console::Render
         virtual void TriggerSelection() = 0;
         virtual void TriggerScroll() = 0;
         virtual void TriggerScroll(const COORD* const pcoordDelta) = 0;
+        virtual void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const SHORT delta) = 0;
         virtual void TriggerCircling() = 0;
         virtual void TriggerTitleChange() = 0;
+        virtual void SetSynchronizedOutput(const bool enabled) = 0;
         virtual void TriggerFontChange(const int iDpi,
                                        const FontInfoDesired& FontInfoDesired,
                                        _Out_ FontInfo& FontInfo) = 0;
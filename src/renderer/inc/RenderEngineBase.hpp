@@ -35,6 +35,7 @@ namespace Microsoft::Console::Render
 
     public:
         [[nodiscard]] HRESULT InvalidateTitle(const std::wstring_view proposedTitle) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const SHORT delta) noexcept override;
 
         [[nodiscard]] HRESULT UpdateTitle(const std::wstring_view newTitle) noexcept override;
 
@@ -46,14 +47,62 @@ namespace Microsoft::Console::Render
                                                    const size_t viewportLeft) noexcept override;
 
         [[nodiscard]] virtual bool RequiresContinuousRedraw() noexcept override;
+        [[nodiscard]] bool SupportsSnapshotPainting() noexcept override;
+        [[nodiscard]] HRESULT PaintCursorFrame(const CursorOptions& options) noexcept override;
+        [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                              const size_t targetRow,
+                                              const size_t viewportLeft) noexcept override;
+        [[nodiscard]] HRESULT PaintSearchHighlight(const SMALL_RECT rect) noexcept override;
 
         void WaitUntilCanRender() noexcept override;
 
+        [[nodiscard]] HRESULT Enable() noexcept override;
+        [[nodiscard]] HRESULT SetWindowSize(const SIZE pixels) noexcept override;
+        void SetCallback(std::function<void()> pfn) override;
+        void SetWarningCallback(std::function<void(const HRESULT)> pfn) override;
+        void ToggleShaderEffects() override;
+        bool GetRetroTerminalEffect() const noexcept override;
+        void SetRetroTerminalEffect(bool enable) noexcept override;
+        void SetPixelShaderPath(std::wstring_view value) noexcept override;
+        void SetForceFullRepaintRendering(bool enable) noexcept override;
+        void SetSoftwareRendering(bool enable) noexcept override;
+        void SetPreferredAdapter(std::wstring_view description) noexcept override;
+        HANDLE GetSwapChainHandle() override;
+        [[nodiscard]] ::Microsoft::Console::Types::Viewport GetViewportInCharacters(const ::Microsoft::Console::Types::Viewport& viewInPixels) noexcept override;
+        float GetScaling() const noexcept override;
+        void SetSelectionBackground(const COLORREF color, const float alpha = 0.5f) noexcept override;
+        void SetAntialiasingMode(const D2D1_TEXT_ANTIALIAS_MODE antialiasingMode) noexcept override;
+        void SetDefaultTextBackgroundOpacity(const float opacity) noexcept override;
+        void UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept override;
+        void SetWindowOccluded(const bool occluded) noexcept override;
+        void TrimDeviceResources() noexcept override;
+        RenderMemoryUsage GetMemoryUsage() noexcept override;
+
     protected:
         [[nodiscard]] virtual HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept = 0;
 
+        std::pair<COLORREF, COLORREF> _GetAttributeColors(const TextAttribute& textAttributes,
+                                                          const gsl::not_null<IRenderData*> pData,
+                                                          const bool isSettingDefaultBrushes) noexcept;
+
         bool _titleChanged;
         std::wstring _lastFrameTitle;
+
+    private:
+        // A frame usually only uses a handful of attributes, but switches
+        // between them for every run. Their colors are remembered in a small
+        // table indexed by the hash of the attribute, for the current frame.
+        struct AttributeColors
+        {
+            TextAttribute attributes;
+            COLORREF foreground;
+            COLORREF background;
+            uint32_t generation;
+        };
+        static constexpr size_t AttributeColorCacheSize = 64;
+
+        std::array<AttributeColors, AttributeColorCacheSize> _attributeColors{};
+        uint32_t _attributeColorGeneration{ 1 };
     };
 
     inline Microsoft::Console::Render::RenderEngineBase::~RenderEngineBase() {}
@@ -20,12 +20,31 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     _textBufferChanged{ false },
     _cursorChanged{ false },
     _isEnabled{ true },
-    _prevSelection{},
     _prevCursorRegion{},
+    _coalesceWindow{ s_defaultCoalesceWindow },
+    _maxEventsPerSecond{ s_defaultMaxEventsPerSecond },
+    _lastSignal{},
+    _rateWindowStart{},
+    _eventsInRateWindow{ 0 },
     RenderEngineBase()
 {
 }
 
+// Routine Description:
+// - Sets how often automation clients may be notified of changes.
+//   Changes that happen in between are coalesced and signaled once
+//   the throttling allows it again, so nothing is lost.
+// Arguments:
+// - coalesceWindow - the minimum time between two batches of events
+// - maxEventsPerSecond - the maximum number of events signaled per second. 0 means no limit.
+// Return Value:
+// - <none>
+void UiaEngine::SetThrottling(const std::chrono::milliseconds coalesceWindow, const size_t maxEventsPerSecond) noexcept
+{
+    _coalesceWindow = coalesceWindow;
+    _maxEventsPerSecond = maxEventsPerSecond;
+}
+
 // Routine Description:
 // - Sets this engine to enabled allowing presentation to occur
 // Arguments:
@@ -100,44 +119,18 @@ CATCH_RETURN();
 // Routine Description:
 // - Notifies us that the console has changed the selection region and would
 //      like it updated
+// - The renderer only invalidates the cells that were selected or deselected,
+//   so any of them means that the selection has changed.
 // Arguments:
 // - rectangles - One or more rectangles describing character positions on the grid
 // Return Value:
 // - S_OK
 [[nodiscard]] HRESULT UiaEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
-    // early exit: different number of rows
-    if (_prevSelection.size() != rectangles.size())
-    {
-        try
-        {
-            _selectionChanged = true;
-            _prevSelection = rectangles;
-        }
-        CATCH_LOG_RETURN_HR(E_FAIL);
-        return S_OK;
-    }
-
-    for (size_t i = 0; i < rectangles.size(); i++)
+    if (!rectangles.empty())
     {
-        try
-        {
-            const auto prevRect = _prevSelection.at(i);
-            const auto newRect = rectangles.at(i);
-
-            // if any value is different, selection has changed
-            if (prevRect.Top != newRect.Top || prevRect.Right != newRect.Right || prevRect.Left != newRect.Left || prevRect.Bottom != newRect.Bottom)
-            {
-                _selectionChanged = true;
-                _prevSelection = rectangles;
-                return S_OK;
-            }
-        }
-        CATCH_LOG_RETURN_HR(E_FAIL);
+        _selectionChanged = true;
     }
-
-    // assume selection has not changed
-    _selectionChanged = false;
     return S_OK;
 }
 
@@ -206,6 +199,13 @@ CATCH_RETURN();
 {
     RETURN_HR_IF(S_FALSE, !_isEnabled);
 
+    // Nobody would receive the events, so there's no reason to even hold on to them.
+    if (!_dispatcher->IsListening())
+    {
+        _DropPendingEvents();
+        return S_FALSE;
+    }
+
     // add more events here
     const bool somethingToDo = _selectionChanged || _textBufferChanged || _cursorChanged;
 
@@ -226,6 +226,24 @@ CATCH_RETURN();
 {
     RETURN_HR_IF(S_FALSE, !_isEnabled);
     RETURN_HR_IF(E_INVALIDARG, !_isPainting); // invalid to end paint when we're not painting
+    _isPainting = false;
+
+    // Hold on to the events until we're allowed to signal them.
+    // RequiresContinuousRedraw makes sure we get another chance.
+    const auto now = std::chrono::steady_clock::now();
+    const auto events = size_t{ _selectionChanged } + size_t{ _textBufferChanged } + size_t{ _cursorChanged };
+    if (_IsThrottled(now, events))
+    {
+        return S_OK;
+    }
+
+    if (now - _rateWindowStart >= std::chrono::seconds{ 1 })
+    {
+        _rateWindowStart = now;
+        _eventsInRateWindow = 0;
+    }
+    _eventsInRateWindow += events;
+    _lastSignal = now;
 
     // Fire UIA Events here
     if (_selectionChanged)
@@ -253,12 +271,53 @@ CATCH_RETURN();
         CATCH_LOG();
     }
 
+    _DropPendingEvents();
+    return S_OK;
+}
+
+// Routine Description:
+// - Checks whether signaling the pending events now would exceed the throttling.
+// Arguments:
+// - now - the current time
+// - events - the number of events that would be signaled
+// Return Value:
+// - true if the events have to wait
+bool UiaEngine::_IsThrottled(const std::chrono::steady_clock::time_point now, const size_t events) const noexcept
+{
+    if (now - _lastSignal < _coalesceWindow)
+    {
+        return true;
+    }
+
+    // A new rate window starts once the current one has passed.
+    return _maxEventsPerSecond != 0 &&
+           now - _rateWindowStart < std::chrono::seconds{ 1 } &&
+           _eventsInRateWindow + events > _maxEventsPerSecond;
+}
+
+// Routine Description:
+// - Forgets about all the events that haven't been signaled yet.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void UiaEngine::_DropPendingEvents() noexcept
+{
     _selectionChanged = false;
     _textBufferChanged = false;
     _cursorChanged = false;
-    _isPainting = false;
+}
 
-    return S_OK;
+// Routine Description:
+// - Asks the renderer to paint another frame while events are held back by
+//   the throttling, so that they are signaled once it allows it again.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if there are events waiting to be signaled
+[[nodiscard]] bool UiaEngine::RequiresContinuousRedraw() noexcept
+{
+    return _isEnabled && (_selectionChanged || _textBufferChanged || _cursorChanged);
 }
 
 // Routine Description:
@@ -15,6 +15,8 @@ Author(s):
 
 #pragma once
 
+#include <chrono>
+
 #include "../../renderer/inc/RenderEngineBase.hpp"
 
 #include "../../types/IUiaEventDispatcher.h"
@@ -30,15 +32,20 @@ namespace Microsoft::Console::Render
         // Only one UiaEngine may present information at a time.
         // This ensures that an automation client isn't overwhelmed
         // by events when there are multiple TermControls
-        [[nodiscard]] HRESULT Enable() noexcept;
+        [[nodiscard]] HRESULT Enable() noexcept override;
         [[nodiscard]] HRESULT Disable() noexcept;
 
+        // Bursts of output are coalesced into at most one batch of events per
+        // coalesceWindow, and into at most maxEventsPerSecond events overall.
+        void SetThrottling(const std::chrono::milliseconds coalesceWindow, const size_t maxEventsPerSecond) noexcept;
+
         // IRenderEngine Members
         [[nodiscard]] HRESULT StartPaint() noexcept override;
         [[nodiscard]] HRESULT EndPaint() noexcept override;
         [[nodiscard]] HRESULT Present() noexcept override;
 
         [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
 
         [[nodiscard]] HRESULT ScrollFrame() noexcept override;
 
@@ -85,7 +92,18 @@ namespace Microsoft::Console::Render
 
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
 
-        std::vector<SMALL_RECT> _prevSelection;
+        static constexpr std::chrono::milliseconds s_defaultCoalesceWindow{ 50 };
+        static constexpr size_t s_defaultMaxEventsPerSecond = 40;
+
+        std::chrono::milliseconds _coalesceWindow;
+        size_t _maxEventsPerSecond;
+        std::chrono::steady_clock::time_point _lastSignal;
+        std::chrono::steady_clock::time_point _rateWindowStart;
+        size_t _eventsInRateWindow;
+
+        bool _IsThrottled(const std::chrono::steady_clock::time_point now, const size_t events) const noexcept;
+        void _DropPendingEvents() noexcept;
+
         SMALL_RECT _prevCursorRegion;
     };
 }
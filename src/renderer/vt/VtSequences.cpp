@@ -85,6 +85,19 @@ using namespace Microsoft::Console::Render;
     return _WriteFormattedString(&format, chars);
 }
 
+// Method Description:
+// - Formats and writes a sequence to repeat the preceding graphic character a
+//      number of times (REP).
+// Arguments:
+// - chars: the number of times to repeat the character
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_RepeatCharacter(const short chars) noexcept
+{
+    static const std::string format = "\x1b[%db";
+    return _WriteFormattedString(&format, chars);
+}
+
 // Method Description:
 // - Moves the cursor forward (right) a number of characters.
 // Arguments:
@@ -132,9 +145,10 @@ using namespace Microsoft::Console::Render;
     {
         return _Write(fInsertLine ? "\x1b[L" : "\x1b[M");
     }
-    const std::string format = fInsertLine ? "\x1b[%dL" : "\x1b[%dM";
+    static const std::string insertFormat = "\x1b[%dL";
+    static const std::string deleteFormat = "\x1b[%dM";
 
-    return _WriteFormattedString(&format, sLines);
+    return _WriteFormattedString(fInsertLine ? &insertFormat : &deleteFormat, sLines);
 }
 
 // Method Description:
@@ -161,6 +175,53 @@ using namespace Microsoft::Console::Render;
     return _InsertDeleteLine(sLines, true);
 }
 
+// Method Description:
+// - Formats and writes a sequence to scroll the contents within the margins
+//      up (SU) or down (SD) by a number of lines. The cursor doesn't move.
+// Arguments:
+// - sLines: the number of lines to scroll by. Negative scrolls up.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_ScrollUpDown(const short sLines) noexcept
+{
+    if (sLines == 0)
+    {
+        return S_OK;
+    }
+    static const std::string upFormat = "\x1b[%dS";
+    static const std::string downFormat = "\x1b[%dT";
+
+    return _WriteFormattedString(sLines < 0 ? &upFormat : &downFormat, std::abs(sLines));
+}
+
+// Method Description:
+// - Formats and writes a sequence to set the top and bottom margins (DECSTBM).
+//      This also moves the cursor to the origin.
+// Arguments:
+// - top: the first row within the margins, in console coordinates.
+// - bottom: the last row within the margins, in console coordinates.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_SetScrollMargins(const short top, const short bottom) noexcept
+{
+    static const std::string format = "\x1b[%d;%dr";
+
+    // VT coords start at 1,1
+    return _WriteFormattedString(&format, top + 1, bottom + 1);
+}
+
+// Method Description:
+// - Writes a sequence to reset the top and bottom margins to the whole
+//      screen. This also moves the cursor to the origin.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_ResetScrollMargins() noexcept
+{
+    return _Write("\x1b[r");
+}
+
 // Method Description:
 // - Formats and writes a sequence to move the cursor to the specified
 //      coordinate position. The input coord should be in console coordinates,
@@ -248,11 +309,10 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRendition256Color(const WORD index,
                                                               const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ?
-                                "\x1b[38;5;%dm" :
-                                "\x1b[48;5;%dm";
+    static const std::string foregroundFormat = "\x1b[38;5;%dm";
+    static const std::string backgroundFormat = "\x1b[48;5;%dm";
 
-    return _WriteFormattedString(&fmt, ::Xterm256ToWindowsIndex(index));
+    return _WriteFormattedString(fIsForeground ? &foregroundFormat : &backgroundFormat, ::Xterm256ToWindowsIndex(index));
 }
 
 // Method Description:
@@ -266,15 +326,14 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRenditionRGBColor(const COLORREF color,
                                                               const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ?
-                                "\x1b[38;2;%d;%d;%dm" :
-                                "\x1b[48;2;%d;%d;%dm";
+    static const std::string foregroundFormat = "\x1b[38;2;%d;%d;%dm";
+    static const std::string backgroundFormat = "\x1b[48;2;%d;%d;%dm";
 
     DWORD const r = GetRValue(color);
     DWORD const g = GetGValue(color);
     DWORD const b = GetBValue(color);
 
-    return _WriteFormattedString(&fmt, r, g, b);
+    return _WriteFormattedString(fIsForeground ? &foregroundFormat : &backgroundFormat, r, g, b);
 }
 
 // Method Description:
@@ -35,6 +35,10 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
 //      the pipe.
 [[nodiscard]] HRESULT XtermEngine::StartPaint() noexcept
 {
+    // While the client's output is passed through, our buffer
+    // doesn't reflect what the terminal displays. Don't paint it.
+    RETURN_HR_IF(S_FALSE, _passthrough);
+
     RETURN_IF_FAILED(VtEngine::StartPaint());
 
     _trace.TraceLastText(_lastText);
@@ -53,20 +57,30 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
         //      terminal's state is consistent with what we'll be rendering.
         RETURN_IF_FAILED(_ClearScreen());
         _clearedAllThisFrame = true;
+        _shadowRows.clear();
         _firstPaint = false;
     }
-    else
+    else if (_invalidMap.any() && !_invalidMap.all() && _scrollDelta == til::point{ 0, 0 } && !_scrollRegion)
     {
+        // If most of the viewport changed, like when a full-screen app redraws
+        // itself, paint the whole frame. The frame then becomes a single stream
+        // of rows from top to bottom: every row starts with a CR LF instead of
+        // a CUP, and no row is split into several pieces. The few cells that
+        // didn't change cost less than the cursor movements around them.
+        // Frames that scroll keep their partial invalidation - ScrollFrame
+        // relies on knowing which rows were revealed.
         gsl::span<const til::rectangle> dirty;
         RETURN_IF_FAILED(GetDirtyArea(dirty));
 
-        // If we have 0 or 1 dirty pieces in the area, set as appropriate.
-        Viewport dirtyView = dirty.empty() ? Viewport::Empty() : Viewport::FromInclusive(til::at(dirty, 0));
+        size_t dirtyCells = 0;
+        for (const auto& rect : dirty)
+        {
+            dirtyCells += rect.size().area<size_t>();
+        }
 
-        // If there's more than 1, union them all up with the 1 we already have.
-        for (size_t i = 1; i < dirty.size(); ++i)
+        if (dirtyCells * 100 >= _invalidMap.size().area<size_t>() * WHOLE_FRAME_MIN_PERCENT)
         {
-            dirtyView = Viewport::Union(dirtyView, Viewport::FromInclusive(til::at(dirty, i)));
+            _invalidMap.set_all();
         }
     }
 
@@ -353,8 +367,8 @@ try
     }
     if (_scrollDelta.y() == 0)
     {
-        // There's nothing to do here. Do nothing.
-        return S_OK;
+        // There's nothing to do here, except for a scroll within the margins.
+        return _ScrollRegionFrame();
     }
 
     const short dy = _scrollDelta.y<short>();
@@ -393,6 +407,8 @@ try
         RETURN_IF_FAILED(_InsertLine(absDy));
     }
 
+    _ScrollShadowRows(dy);
+
     // Restore our wrap state.
     _wrappedRow = oldWrappedRow;
     _delayedEolWrap = oldDelayedEolWrap;
@@ -452,6 +468,81 @@ try
         _newBottomLineBG = _lastTextAttributes.GetBackground();
     }
 
+    // A scroll within the margins always happened after the scroll of
+    // the whole viewport - see InvalidateScroll.
+    return _ScrollRegionFrame();
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Scrolls the rows within the margins by the delta we have collectively
+//      received through InvalidateScrollRegion since the last frame. The
+//      margins are set around the region (DECSTBM), and the rows are moved
+//      with SU or SD. The revealed rows were marked invalid by
+//      InvalidateScrollRegion, so they will later be written by PaintBufferLine.
+// - Unlike the newlines of a scroll of the whole viewport, this doesn't
+//      push any rows into the terminal's scrollback.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT XtermEngine::_ScrollRegionFrame() noexcept
+try
+{
+    if (!_scrollRegion)
+    {
+        return S_OK;
+    }
+
+    const auto region = *_scrollRegion;
+    const auto dy = _scrollRegionDelta;
+    _scrollRegion.reset();
+    _scrollRegionDelta = 0;
+
+    // If the viewport changed in the meantime, we can't be sure what the
+    // region refers to anymore. It's simply repainted then. The same holds
+    // if every row of the region was revealed: they're all invalid already.
+    const til::rectangle bounds{ _invalidMap.size() };
+    if (!bounds.contains(region) || region.width() != bounds.width())
+    {
+        const auto clipped = region & bounds;
+        if (!clipped.empty())
+        {
+            _invalidMap.set(clipped);
+        }
+        return S_OK;
+    }
+    if (dy == 0 || std::abs(dy) >= region.height())
+    {
+        return S_OK;
+    }
+
+    const auto top = region.top<short>();
+    const auto bottom = region.bottom<short>();
+
+    // Setting the margins moves the cursor to the origin, as does resetting them.
+    if (top != 0 || bottom != bounds.height())
+    {
+        RETURN_IF_FAILED(_SetScrollMargins(top, gsl::narrow_cast<short>(bottom - 1)));
+        RETURN_IF_FAILED(_ScrollUpDown(dy));
+        RETURN_IF_FAILED(_ResetScrollMargins());
+        _lastText = { 0, 0 };
+    }
+    else
+    {
+        RETURN_IF_FAILED(_ScrollUpDown(dy));
+    }
+
+    _ScrollShadowRows(dy, top, bottom);
+
+    // Like a scroll of the whole viewport, this breaks a wrapped row that's
+    // moved, or the delayed wrap at the end of it. See ScrollFrame.
+    _delayedEolWrap = false;
+    if (_wrappedRow.has_value() && _wrappedRow.value() >= top && _wrappedRow.value() < bottom)
+    {
+        _wrappedRow = std::nullopt;
+    }
+
     return S_OK;
 }
 CATCH_RETURN();
@@ -474,6 +565,27 @@ try
     {
         _trace.TraceInvalidateScroll(delta);
 
+        // The viewport moves during a negotiated resize because our reflow
+        // changed the number of rows above it. The terminal already reflowed
+        // these rows itself, so scrolling it would only push the rows of its
+        // viewport into its scrollback a second time. The viewport is
+        // repainted as a whole instead (see UpdateViewport).
+        if (_resizeNegotiated && _resizeQuirk && _inResizeRequest)
+        {
+            _invalidMap.set_all();
+            return S_OK;
+        }
+
+        // A scroll within the margins that's still pending happened before
+        // this one, but ScrollFrame would apply it afterwards. Its region
+        // is simply repainted instead.
+        if (_scrollRegion)
+        {
+            _invalidMap.set(*_scrollRegion & til::rectangle{ _invalidMap.size() });
+            _scrollRegion.reset();
+            _scrollRegionDelta = 0;
+        }
+
         // Scroll the current offset and invalidate the revealed area
         _invalidMap.translate(delta, true);
 
@@ -484,6 +596,62 @@ try
 }
 CATCH_RETURN();
 
+// Routine Description:
+// - Notifies us that the console moved the rows within a region of the
+//      viewport up or down, like a scroll within the margins does. If the
+//      region spans the whole width, the scroll is accumulated for
+//      ScrollFrame, so that only the revealed rows need to be repainted.
+//      Anything else just invalidates the region.
+// Arguments:
+// - psrRegion - the region whose rows were moved, in viewport coordinates, exclusive.
+// - delta - the distance the rows were moved by, negative is upwards.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate.
+[[nodiscard]] HRESULT XtermEngine::InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const SHORT delta) noexcept
+try
+{
+    const til::rectangle region{ Viewport::FromExclusive(*psrRegion).ToInclusive() };
+    const til::rectangle bounds{ _invalidMap.size() };
+
+    // During a negotiated resize, the viewport is repainted as a whole anyway
+    // (see InvalidateScroll). Two different regions can't be accumulated.
+    if (delta == 0 ||
+        !bounds.contains(region) ||
+        region.width() != bounds.width() ||
+        (_resizeNegotiated && _resizeQuirk && _inResizeRequest) ||
+        (_scrollRegion && *_scrollRegion != region))
+    {
+        return Invalidate(psrRegion);
+    }
+
+    _trace.TraceInvalidateScroll(til::point{ 0, delta });
+
+    // Move the invalid cells within the region along with its rows,
+    // and invalidate the rows that were revealed.
+    const std::vector<til::rectangle> runs{ _invalidMap.runs().begin(), _invalidMap.runs().end() };
+    _invalidMap.reset(region);
+    for (const auto& run : runs)
+    {
+        const auto moved = ((run & region) + til::point{ 0, delta }) & region;
+        if (!moved.empty())
+        {
+            _invalidMap.set(moved);
+        }
+    }
+
+    const auto height = region.height();
+    const auto distance = std::min<ptrdiff_t>(std::abs(delta), height);
+    const auto revealedTop = delta < 0 ? region.bottom() - distance : region.top();
+    _invalidMap.set(til::rectangle{ region.left(), revealedTop, region.right(), revealedTop + distance });
+
+    // Once every row was revealed, it doesn't matter how far they were moved.
+    _scrollRegion = region;
+    _scrollRegionDelta = gsl::narrow_cast<short>(std::clamp<ptrdiff_t>(_scrollRegionDelta + delta, -height, height));
+
+    return S_OK;
+}
+CATCH_RETURN();
+
 // Routine Description:
 // - Draws one line of the buffer to the screen. Writes the characters to the
 //      pipe, encoded in UTF-8 or ASCII only, depending on the VtIoMode.
@@ -504,8 +672,12 @@ CATCH_RETURN();
                                                    const bool /*trimLeft*/,
                                                    const bool lineWrapped) noexcept
 {
-    return _fUseAsciiOnly ?
-               VtEngine::_PaintAsciiBufferLine(clusters, coord) :
+    if (_fUseAsciiOnly)
+    {
+        return VtEngine::_PaintAsciiBufferLine(clusters, coord);
+    }
+    return _diffRendering ?
+               VtEngine::_PaintDiffBufferLine(clusters, coord, lineWrapped) :
                VtEngine::_PaintUtf8BufferLine(clusters, coord, lineWrapped);
 }
 
@@ -518,6 +690,12 @@ CATCH_RETURN();
 // - S_OK or suitable HRESULT error from either conversion or writing pipe.
 [[nodiscard]] HRESULT XtermEngine::WriteTerminalW(const std::wstring_view wstr) noexcept
 {
+    // During a passthrough, the terminal already got what this came from.
+    RETURN_HR_IF(S_FALSE, _passthrough);
+
+    // We can't know what this string does to the terminal's contents.
+    _shadowRows.clear();
+
     RETURN_IF_FAILED(_fUseAsciiOnly ?
                          VtEngine::_WriteTerminalAscii(wstr) :
                          VtEngine::_WriteTerminalUtf8(wstr));
@@ -535,6 +713,27 @@ CATCH_RETURN();
     return _Flush();
 }
 
+// Method Description:
+// - Resumes rendering after a passthrough. See VtEngine::EndPassthrough.
+//   The client might have hidden the cursor, so we hide it as well. The
+//   next frame will show it again if it should be visible.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT XtermEngine::EndPassthrough() noexcept
+{
+    const auto wasPassthrough = _passthrough;
+    RETURN_IF_FAILED(VtEngine::EndPassthrough());
+    if (wasPassthrough)
+    {
+        RETURN_IF_FAILED(_HideCursor());
+        _lastCursorIsVisible = false;
+        RETURN_IF_FAILED(_Flush());
+    }
+    return S_OK;
+}
+
 // Method Description:
 // - Updates the window's title string. Emits the VT sequence to SetWindowTitle.
 // Arguments:
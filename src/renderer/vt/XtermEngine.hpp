@@ -48,9 +48,12 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT ScrollFrame() noexcept override;
 
         [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const SHORT delta) noexcept override;
 
         [[nodiscard]] HRESULT WriteTerminalW(const std::wstring_view str) noexcept override;
 
+        [[nodiscard]] HRESULT EndPassthrough() noexcept override;
+
     protected:
         const bool _fUseAsciiOnly;
         bool _needToDisableCursor;
@@ -58,6 +61,7 @@ namespace Microsoft::Console::Render
         bool _nextCursorIsVisible;
 
         [[nodiscard]] HRESULT _MoveCursor(const COORD coord) noexcept override;
+        [[nodiscard]] HRESULT _ScrollRegionFrame() noexcept;
 
         [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
 
@@ -108,7 +108,8 @@ CATCH_RETURN();
 [[nodiscard]] HRESULT VtEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
 {
     // If we're in the middle of a resize request, don't try to immediately start a frame.
-    if (_inResizeRequest)
+    // The same goes for a passthrough, where we aren't painting at all.
+    if (_inResizeRequest || _passthrough)
     {
         *pForcePaint = false;
     }
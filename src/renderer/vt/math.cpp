@@ -65,7 +65,7 @@ void VtEngine::_OrRect(_Inout_ SMALL_RECT* const pRectExisting, const SMALL_RECT
 bool VtEngine::_WillWriteSingleChar() const
 {
     // If there is no scroll delta, return false.
-    if (til::point{ 0, 0 } != _scrollDelta)
+    if (til::point{ 0, 0 } != _scrollDelta || _scrollRegion.has_value())
     {
         return false;
     }
@@ -20,7 +20,7 @@ using namespace Microsoft::Console::Types;
 //      HRESULT error code if painting didn't start successfully.
 [[nodiscard]] HRESULT VtEngine::StartPaint() noexcept
 {
-    if (_pipeBroken)
+    if (_pipeBroken || _passthrough)
     {
         return S_FALSE;
     }
@@ -28,10 +28,19 @@ using namespace Microsoft::Console::Types;
     // If there's nothing to do, quick return
     bool somethingToDo = _invalidMap.any() ||
                          _scrollDelta != til::point{ 0, 0 } ||
+                         _scrollRegion.has_value() ||
                          _cursorMoved ||
                          _titleChanged;
 
     _quickReturn = !somethingToDo;
+
+    // Nothing happened since the last frame, so there's no point in
+    // holding back what _FlushFrame kept in the buffer any longer.
+    if (_quickReturn && !_buffer.empty())
+    {
+        RETURN_IF_FAILED(_Flush());
+    }
+
     _trace.TraceStartPaint(_quickReturn,
                            _invalidMap,
                            _lastViewport.ToInclusive(),
@@ -55,9 +64,14 @@ using namespace Microsoft::Console::Types;
 {
     _trace.TraceEndPaint();
 
+    // Everything we wrote this frame is still sitting in the buffer.
+    _trace.TraceFrameBytes(_buffer.size());
+
     _invalidMap.reset_all();
 
     _scrollDelta = { 0, 0 };
+    _scrollRegion.reset();
+    _scrollRegionDelta = 0;
     _clearedAllThisFrame = false;
     _cursorMoved = false;
     _firstPaint = false;
@@ -82,7 +96,7 @@ using namespace Microsoft::Console::Types;
         RETURN_IF_FAILED(_MoveCursor(_deferredCursorPos));
     }
 
-    RETURN_IF_FAILED(_Flush());
+    RETURN_IF_FAILED(_FlushFrame());
 
     return S_OK;
 }
@@ -489,7 +503,9 @@ using namespace Microsoft::Console::Types;
     RETURN_IF_FAILED(_MoveCursor(coord));
 
     // Write the actual text string
-    RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8({ _bufferLine.data(), cchActual }));
+    RETURN_IF_FAILED(_diffRendering ?
+                         VtEngine::_WriteTerminalUtf8Repeated({ _bufferLine.data(), cchActual }) :
+                         VtEngine::_WriteTerminalUtf8({ _bufferLine.data(), cchActual }));
 
     // GH#4415, GH#5181
     // If the renderer told us that this was a wrapped line, then mark
@@ -589,6 +605,239 @@ using namespace Microsoft::Console::Types;
     return S_OK;
 }
 
+// Routine Description:
+// - Draws one line of the buffer like _PaintUtf8BufferLine, but only emits the
+//      parts of the line that differ from what we last sent to the terminal.
+//      Unchanged gaps shorter than DIFF_SKIP_MIN_COLUMNS are sent anyways,
+//      since moving the cursor across them would cost about as much.
+// Arguments:
+// - clusters - text and column widths to be written
+// - coord - character coordinate target to render within viewport
+// - lineWrapped: true if this run we're painting is the end of a line that
+//   wrapped.
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]] HRESULT VtEngine::_PaintDiffBufferLine(gsl::span<const Cluster> const clusters,
+                                                     const COORD coord,
+                                                     const bool lineWrapped) noexcept
+try
+{
+    const auto width = gsl::narrow_cast<size_t>(_lastViewport.Width());
+    const auto height = gsl::narrow_cast<size_t>(_lastViewport.Height());
+    if (coord.Y < _virtualTop || coord.X < 0 || gsl::narrow_cast<size_t>(coord.Y) >= height)
+    {
+        return _PaintUtf8BufferLine(clusters, coord, lineWrapped);
+    }
+
+    if (_shadowRows.size() != height || _shadowRows.front().size() != width)
+    {
+        _shadowRows.assign(height, std::vector<ShadowCell>(width));
+    }
+    auto& row = til::at(_shadowRows, coord.Y);
+
+    const auto paintSegment = [&](const size_t begin, const size_t end, const size_t column) -> HRESULT {
+        const auto segment = clusters.subspan(begin, end - begin);
+        const COORD target{ gsl::narrow<short>(column), coord.Y };
+        // Only the segment that ends with the row may carry the wrap state.
+        RETURN_IF_FAILED(_PaintUtf8BufferLine(segment, target, lineWrapped && end == clusters.size()));
+        _RecordShadowCells(row, column, segment);
+        return S_OK;
+    };
+
+    std::optional<size_t> segmentBegin;
+    size_t segmentColumn = 0;
+    size_t unchangedBegin = 0;
+    size_t unchangedColumns = 0;
+    auto column = gsl::narrow_cast<size_t>(coord.X);
+
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        const auto& cluster = til::at(clusters, i);
+
+        // The last cell of a wrapped row always needs to be painted,
+        // or the terminal wouldn't know that the row wrapped.
+        const auto changed = (lineWrapped && i + 1 == clusters.size()) || !_ShadowCellMatches(row, column, cluster);
+        if (changed)
+        {
+            if (segmentBegin && unchangedColumns >= DIFF_SKIP_MIN_COLUMNS)
+            {
+                RETURN_IF_FAILED(paintSegment(*segmentBegin, unchangedBegin, segmentColumn));
+                segmentBegin.reset();
+            }
+            if (!segmentBegin)
+            {
+                segmentBegin = i;
+                segmentColumn = column;
+            }
+            unchangedColumns = 0;
+        }
+        else if (segmentBegin)
+        {
+            if (unchangedColumns == 0)
+            {
+                unchangedBegin = i;
+            }
+            unchangedColumns += cluster.GetColumns();
+        }
+
+        column += cluster.GetColumns();
+    }
+
+    if (segmentBegin)
+    {
+        RETURN_IF_FAILED(paintSegment(*segmentBegin, unchangedColumns ? unchangedBegin : clusters.size(), segmentColumn));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Checks whether the terminal already displays the given cluster with the
+//      current attributes at the given column.
+// Arguments:
+// - row - the shadow row to check
+// - column - the column of the cluster
+// - cluster - the cluster we're about to paint
+// Return Value:
+// - true iff painting the cluster wouldn't change anything.
+bool VtEngine::_ShadowCellMatches(const std::vector<ShadowCell>& row, const size_t column, const Cluster& cluster) const noexcept
+{
+    if (column >= row.size())
+    {
+        return false;
+    }
+
+    const auto& cell = til::at(row, column);
+    return cell.known &&
+           cell.columns == cluster.GetColumns() &&
+           cell.attributes == _lastTextAttributes &&
+           cell.text == cluster.GetText();
+}
+
+// Routine Description:
+// - Records the clusters we just painted with the current attributes in the
+//      shadow row, starting at the given column.
+// Arguments:
+// - row - the shadow row to update
+// - column - the column of the first cluster
+// - clusters - the clusters that were painted
+// Return Value:
+// - <none>
+void VtEngine::_RecordShadowCells(std::vector<ShadowCell>& row, size_t column, gsl::span<const Cluster> const clusters)
+{
+    // If we overwrote the trailing half of a wide glyph, the terminal erased all of it.
+    if (column < row.size() && til::at(row, column).known && til::at(row, column).columns == 0)
+    {
+        for (auto i = column; i-- > 0;)
+        {
+            auto& cell = til::at(row, i);
+            cell.known = false;
+            if (cell.columns != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Trailing spaces might have been erased with ECH/EL or skipped entirely
+    // (see _PaintUtf8BufferLine), instead of being written with the current
+    // attributes. We don't know what these cells look like now.
+    size_t trailingSpaces = 0;
+    for (auto it = clusters.rbegin(); it != clusters.rend() && it->GetText() == L" "; ++it)
+    {
+        ++trailingSpaces;
+    }
+
+    for (size_t i = 0; i < clusters.size() && column < row.size(); ++i)
+    {
+        const auto& cluster = til::at(clusters, i);
+        const auto known = i + trailingSpaces < clusters.size();
+        const auto columns = cluster.GetColumns();
+
+        auto& cell = til::at(row, column);
+        cell.text = cluster.GetText();
+        cell.attributes = _lastTextAttributes;
+        cell.columns = columns;
+        cell.known = known;
+
+        for (size_t j = 1; j < columns && column + j < row.size(); ++j)
+        {
+            auto& trailing = til::at(row, column + j);
+            trailing.text.clear();
+            trailing.columns = 0;
+            trailing.known = known;
+        }
+
+        column += columns;
+    }
+
+    // If we overwrote the leading half of a wide glyph, the rest of it is gone as well.
+    for (; column < row.size() && til::at(row, column).columns == 0; ++column)
+    {
+        til::at(row, column).known = false;
+    }
+}
+
+// Routine Description:
+// - Shifts the shadow rows along with the terminal's contents, after we've
+//      scrolled them by dy rows. Rows that are scrolled into view are unknown.
+// Arguments:
+// - dy - the number of rows we scrolled the terminal. Negative if it was scrolled up.
+// Return Value:
+// - <none>
+void VtEngine::_ScrollShadowRows(const short dy) noexcept
+{
+    const auto distance = gsl::narrow_cast<size_t>(std::abs(dy));
+    if (distance >= _shadowRows.size())
+    {
+        _shadowRows.clear();
+        return;
+    }
+
+    _ScrollShadowRows(dy, 0, _shadowRows.size());
+}
+
+// Routine Description:
+// - Shifts the shadow rows within the margins along with the terminal's
+//      contents, after we've scrolled them by dy rows. Rows that are scrolled
+//      into the margins are unknown. The rows outside of them stay where they are.
+// Arguments:
+// - dy - the number of rows we scrolled the margins by. Negative if they were scrolled up.
+// - top - the first row within the margins.
+// - bottom - the row below the margins.
+// Return Value:
+// - <none>
+void VtEngine::_ScrollShadowRows(const short dy, const size_t top, const size_t bottom) noexcept
+{
+    if (bottom > _shadowRows.size() || top >= bottom)
+    {
+        _shadowRows.clear();
+        return;
+    }
+
+    const auto first = _shadowRows.begin() + top;
+    const auto last = _shadowRows.begin() + bottom;
+    const auto distance = std::min(gsl::narrow_cast<ptrdiff_t>(std::abs(dy)), last - first);
+    const auto forget = [](auto& row) noexcept {
+        for (auto& cell : row)
+        {
+            cell.known = false;
+        }
+    };
+
+    if (dy < 0)
+    {
+        std::rotate(first, first + distance, last);
+        std::for_each(last - distance, last, forget);
+    }
+    else if (dy > 0)
+    {
+        std::rotate(first, last - distance, last);
+        std::for_each(first, first + distance, forget);
+    }
+}
+
 // Method Description:
 // - Updates the window's title string. Emits the VT sequence to SetWindowTitle.
 //      Because wintelnet does not understand these sequences by default, we
@@ -45,6 +45,7 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _firstPaint(true),
     _skipCursor(false),
     _pipeBroken(false),
+    _wroteOutput(false),
     _exitResult{ S_OK },
     _terminalOwner{ nullptr },
     _newBottomLine{ false },
@@ -53,7 +54,6 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _trace{},
     _bufferLine{},
     _buffer{},
-    _formatBuffer{},
     _conversionBuffer{}
 {
 #ifndef UNIT_TESTING
@@ -115,6 +115,12 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 
     if (!_pipeBroken)
     {
+        if (!_wroteOutput && !_buffer.empty())
+        {
+            _trace.TraceFirstOutput(_buffer.size());
+            _wroteOutput = true;
+        }
+
         bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), static_cast<DWORD>(_buffer.size()), nullptr, nullptr);
         _buffer.clear();
         if (!fSuccess)
@@ -129,13 +135,57 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
         }
     }
 
+    _lastFlush = std::chrono::steady_clock::now();
+    return S_OK;
+}
+
+// Method Description:
+// - Flushes the frame that was just painted, unless it's small and we've
+//   written to the pipe only a moment ago. In that case the frame stays in the
+//   buffer and goes out together with the next one, or on the next tick of the
+//   render thread at the latest - see RequiresContinuousRedraw. A program that
+//   prints lots of short lines thus doesn't cost a WriteFile per frame.
+// - WriteFile blocks while the terminal isn't reading, and the renderer keeps
+//   collecting invalidations in the meantime. The frames we'd have painted
+//   while blocked are merged into one, so we don't need to skip them here.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]] HRESULT VtEngine::_FlushFrame() noexcept
+{
+    // The first frame is what the terminal is waiting for while we start up.
+    if (!_wroteOutput ||
+        _buffer.size() >= s_flushThreshold ||
+        std::chrono::steady_clock::now() - _lastFlush >= s_maxFlushLatency)
+    {
+        return _Flush();
+    }
+
     return S_OK;
 }
 
+// Method Description:
+// - Asks the render thread for another frame while _FlushFrame holds back
+//   output, so that it's written even if nothing else gets invalidated.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if there's output we haven't written yet.
+[[nodiscard]] bool VtEngine::RequiresContinuousRedraw() noexcept
+{
+    return !_pipeBroken && !_buffer.empty();
+}
+
 // Method Description:
 // - Wrapper for ITerminalOutputConnection. See _Write.
 [[nodiscard]] HRESULT VtEngine::WriteTerminalUtf8(const std::string_view str) noexcept
 {
+    // During a passthrough, the terminal already got what this came from.
+    RETURN_HR_IF(S_FALSE, _passthrough);
+
+    // We can't know what this string does to the terminal's contents.
+    _shadowRows.clear();
     return _Write(str);
 }
 
@@ -148,10 +198,64 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // - S_OK or suitable HRESULT error from either conversion or writing pipe.
 [[nodiscard]] HRESULT VtEngine::_WriteTerminalUtf8(const std::wstring_view wstr) noexcept
 {
-    RETURN_IF_FAILED(til::u16u8(wstr, _conversionBuffer));
-    return _Write(_conversionBuffer);
+#ifdef UNIT_TESTING
+    if (_usingTestCallback)
+    {
+        RETURN_IF_FAILED(til::u16u8(wstr, _conversionBuffer));
+        return _Write(_conversionBuffer);
+    }
+#endif
+
+    // The text is encoded right into the buffer, like _Write would append it.
+    const auto offset = _buffer.size();
+    RETURN_IF_FAILED(til::u16u8_append(wstr, _buffer));
+    _trace.TraceString({ _buffer.data() + offset, _buffer.size() - offset });
+    return S_OK;
 }
 
+// Method Description:
+// - Writes a wstring to the tty, encoded as full utf-8, like _WriteTerminalUtf8.
+//      Runs of the same printable ASCII character are compressed into the
+//      first character, followed by a REP sequence for the rest of them.
+//      ASCII characters always occupy a single cell, so this is exact.
+// - REP is only worth it if the run is longer than the sequence
+//      (ESC [ %d b), which is REPEAT_CHARACTER_STRING_LENGTH chars for up to
+//      99 repetitions.
+// Arguments:
+// - wstr - wstring of text to be written
+// Return Value:
+// - S_OK or suitable HRESULT error from either conversion or writing pipe.
+[[nodiscard]] HRESULT VtEngine::_WriteTerminalUtf8Repeated(const std::wstring_view wstr) noexcept
+try
+{
+    size_t written = 0;
+    for (size_t i = 0; i < wstr.size();)
+    {
+        const auto wch = til::at(wstr, i);
+        size_t count = 1;
+        while (i + count < wstr.size() && til::at(wstr, i + count) == wch)
+        {
+            ++count;
+        }
+
+        if (wch >= L' ' && wch <= L'~' && count - 1 > REPEAT_CHARACTER_STRING_LENGTH)
+        {
+            RETURN_IF_FAILED(_WriteTerminalUtf8(wstr.substr(written, i + 1 - written)));
+            RETURN_IF_FAILED(_RepeatCharacter(gsl::narrow<short>(count - 1)));
+            written = i + count;
+        }
+
+        i += count;
+    }
+
+    if (written < wstr.size())
+    {
+        RETURN_IF_FAILED(_WriteTerminalUtf8(wstr.substr(written)));
+    }
+    return S_OK;
+}
+CATCH_RETURN();
+
 // Method Description:
 // - Writes a wstring to the tty, encoded as "utf-8" where characters that are
 //      outside the ASCII range are encoded as '?'
@@ -162,21 +266,21 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // Return Value:
 // - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]] HRESULT VtEngine::_WriteTerminalAscii(const std::wstring_view wstr) noexcept
+try
 {
-    const size_t cchActual = wstr.length();
-
-    std::string needed;
-    needed.reserve(wstr.size());
+    _conversionBuffer.clear();
+    _conversionBuffer.reserve(wstr.size());
 
     for (const auto& wch : wstr)
     {
         // We're explicitly replacing characters outside ASCII with a ? because
         //      that's what telnet wants.
-        needed.push_back((wch > L'\x7f') ? '?' : static_cast<char>(wch));
+        _conversionBuffer.push_back((wch > L'\x7f') ? '?' : static_cast<char>(wch));
     }
 
-    return _Write(needed);
+    return _Write(_conversionBuffer);
 }
+CATCH_RETURN();
 
 // Method Description:
 // - Helper for calling _Write with a string for formatting a sequence. Used
@@ -190,56 +294,48 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 [[nodiscard]] HRESULT VtEngine::_WriteFormattedString(const std::string* const pFormat, ...) noexcept
 try
 {
-    va_list args;
-    va_start(args, pFormat);
-
     // NOTE: pFormat is a pointer because varargs refuses to operate with a ref in that position
     // NOTE: We're not using string_view because it doesn't guarantee null (which will be needed
     //       later in the formatting method).
 
-    HRESULT hr = E_FAIL;
-
-    // We're going to hold onto our format string space across calls because
-    // the VT renderer will be formatting a LOT of strings and alloc/freeing them
-    // over and over is going to be way worse for perf than just holding some extra
-    // memory for formatting purposes.
-    // See _formatBuffer for its location.
-
-    // First, plow ahead using our pre-reserved string space.
-    LPSTR destEnd = nullptr;
+    // The sequences we format are short, so they're formatted on the stack.
+    // A frame emits a LOT of them (cursor movements, colors), and none of
+    // them should have to allocate.
+    std::array<char, 64> stackBuffer;
     size_t destRemaining = 0;
-    if (SUCCEEDED(StringCchVPrintfExA(_formatBuffer.data(),
-                                      _formatBuffer.size(),
-                                      &destEnd,
-                                      &destRemaining,
-                                      STRSAFE_NO_TRUNCATION,
-                                      pFormat->c_str(),
-                                      args)))
-    {
-        return _Write({ _formatBuffer.data(), _formatBuffer.size() - destRemaining });
-    }
 
-    // If we didn't succeed at filling/using the existing space, then
-    // we're going to take the long way by counting the space required and resizing up to that
-    // space and formatting.
-
-    const auto needed = _scprintf(pFormat->c_str(), args);
-    // -1 is the _scprintf error case https://msdn.microsoft.com/en-us/library/t32cf9tb.aspx
-    if (needed > -1)
-    {
-        _formatBuffer.resize(static_cast<size_t>(needed) + 1);
+    va_list args;
+    va_start(args, pFormat);
+    const auto hr = StringCchVPrintfExA(stackBuffer.data(),
+                                        stackBuffer.size(),
+                                        nullptr,
+                                        &destRemaining,
+                                        STRSAFE_NO_TRUNCATION,
+                                        pFormat->c_str(),
+                                        args);
+    va_end(args);
 
-        const auto written = _vsnprintf_s(_formatBuffer.data(), _formatBuffer.size(), needed, pFormat->c_str(), args);
-        hr = _Write({ _formatBuffer.data(), gsl::narrow<size_t>(written) });
-    }
-    else
+    if (SUCCEEDED(hr))
     {
-        hr = E_INVALIDARG;
+        return _Write({ stackBuffer.data(), stackBuffer.size() - destRemaining });
     }
+    RETURN_HR_IF(hr, hr != STRSAFE_E_INSUFFICIENT_BUFFER);
 
+    // If it didn't fit after all, take the long way by counting the
+    // space required and formatting into a string of that size.
+    va_start(args, pFormat);
+    const auto needed = _vscprintf(pFormat->c_str(), args);
     va_end(args);
+    // -1 is the _vscprintf error case
+    RETURN_HR_IF(E_INVALIDARG, needed < 0);
 
-    return hr;
+    std::string heapBuffer(static_cast<size_t>(needed) + 1, '\0');
+    va_start(args, pFormat);
+    const auto written = _vsnprintf_s(heapBuffer.data(), heapBuffer.size(), gsl::narrow_cast<size_t>(needed), pFormat->c_str(), args);
+    va_end(args);
+    RETURN_HR_IF(E_INVALIDARG, written < 0);
+
+    return _Write({ heapBuffer.data(), gsl::narrow_cast<size_t>(written) });
 }
 CATCH_RETURN();
 
@@ -286,8 +382,13 @@ CATCH_RETURN();
 
     _lastViewport = newView;
 
-    if ((oldView.Height() != newView.Height()) || (oldView.Width() != newView.Width()))
+    const bool sizeChanged = (oldView.Height() != newView.Height()) || (oldView.Width() != newView.Width());
+    if (sizeChanged)
     {
+        // The terminal might reflow its contents, so we can't know what it
+        // displays anymore.
+        _shadowRows.clear();
+
         // Don't emit a resize event if we've requested it be suppressed
         if (!_suppressResizeRepaint)
         {
@@ -313,6 +414,16 @@ CATCH_RETURN();
         // invalid. Previously, we'd invalidate everything if the width changed,
         // because we couldn't be sure if lines were reflowed.
         _invalidMap.resize(newView.Dimensions());
+
+        // With the negotiated resize, the terminal reflowed its own buffer and
+        // keeps it as its scrollback. The scroll that our own reflow caused
+        // isn't replayed (see XtermEngine::InvalidateScroll), so instead the
+        // whole viewport is sent once, to replace what the terminal's
+        // reflow left in it with what we've got.
+        if (_resizeNegotiated && sizeChanged)
+        {
+            _invalidMap.set_all();
+        }
     }
     else
     {
@@ -490,6 +601,98 @@ void VtEngine::SetResizeQuirk(const bool resizeQuirk)
     _resizeQuirk = resizeQuirk;
 }
 
+// Method Description:
+// - Enables the diff rendering mode, in which we keep a shadow copy of what we
+//   last sent to the terminal and only emit the cells that changed since. This
+//   is useful for slow connections, like a conpty that is used over ssh.
+// - See also: _PaintDiffBufferLine
+// Arguments:
+// - diffRendering - true iff we were started with the `--diffRendering` flag enabled.
+// Return Value:
+// - <none>
+void VtEngine::SetDiffRendering(const bool diffRendering)
+{
+    _diffRendering = diffRendering;
+    _shadowRows.clear();
+}
+
+// Method Description:
+// - Enables the negotiated resize. It builds on the resize quirk: The terminal
+//   reflows its own buffer on a resize and stays authoritative for everything
+//   above the viewport. We don't replay the scrolling our own reflow causes
+//   and only resend the viewport, instead of making the terminal apply both
+//   reflows on top of each other.
+// Arguments:
+// - resizeNegotiated - true iff we were started with the `--resizeNegotiated` flag enabled.
+// Return Value:
+// - <none>
+void VtEngine::SetResizeNegotiated(const bool resizeNegotiated)
+{
+    _resizeNegotiated = resizeNegotiated;
+}
+
+// Method Description:
+// - Stops us from rendering, because the client's output is forwarded to the
+//   terminal directly (see WritePassthrough) and our buffer doesn't reflect
+//   what the terminal displays until the passthrough ends.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::BeginPassthrough() noexcept
+{
+    _passthrough = true;
+}
+
+// Method Description:
+// - Resumes rendering after a passthrough. By now, the buffer has been brought
+//   up to date with what we forwarded, so everything that was invalidated in
+//   the meantime is already displayed by the terminal. We can't know where
+//   its cursor is or which attributes are set anymore though.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::EndPassthrough() noexcept
+{
+    RETURN_HR_IF(S_FALSE, !_passthrough);
+    _passthrough = false;
+
+    _invalidMap.reset_all();
+    _scrollDelta = { 0, 0 };
+    _scrollRegion.reset();
+    _scrollRegionDelta = 0;
+    _cursorMoved = false;
+    _circled = false;
+    _newBottomLine = false;
+    _newBottomLineBG = std::nullopt;
+    _wrappedRow = std::nullopt;
+    _delayedEolWrap = false;
+    _lastText = INVALID_COORDS;
+    _deferredCursorPos = INVALID_COORDS;
+    _shadowRows.clear();
+
+    // Reset the terminal's attributes and make sure that the next
+    // UpdateDrawingBrushes emits the colors, whatever they are.
+    RETURN_IF_FAILED(_SetGraphicsDefault());
+    _lastTextAttributes = TextAttribute{ INVALID_COLOR, INVALID_COLOR };
+
+    return _Flush();
+}
+
+// Method Description:
+// - Writes the client's output to the terminal as is, encoded as utf-8.
+//   Used by the passthrough mode, see VtIo::WritePassthrough.
+// Arguments:
+// - str - the output of the client
+// Return Value:
+// - S_OK or suitable HRESULT error from either conversion or writing pipe.
+[[nodiscard]] HRESULT VtEngine::WritePassthrough(const std::wstring_view str) noexcept
+{
+    RETURN_IF_FAILED(_WriteTerminalUtf8(str));
+    return _Flush();
+}
+
 // Method Description:
 // - Manually emit a "Erase Scrollback" sequence to the connected terminal. We
 //   need to do this in certain cases that we've identified where we believe the
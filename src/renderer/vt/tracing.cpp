@@ -212,6 +212,34 @@ void RenderTracing::TraceEndPaint() const
 #endif UNIT_TESTING
 }
 
+void RenderTracing::TraceFrameBytes(const size_t bytes) const
+{
+#ifndef UNIT_TESTING
+    TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
+                      "VtEngine_TraceFrameBytes",
+                      TraceLoggingUInt64(static_cast<uint64_t>(bytes), "bytes"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+#else
+    UNREFERENCED_PARAMETER(bytes);
+#endif UNIT_TESTING
+}
+
+// Marks the first bytes written to the terminal. Conhost's TimeToFirstByte
+// region goes from the start of its startup up to this event.
+void RenderTracing::TraceFirstOutput(const size_t bytes) const
+{
+#ifndef UNIT_TESTING
+    TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
+                      "VtEngine_FirstOutput",
+                      TraceLoggingUInt64(static_cast<uint64_t>(bytes), "bytes"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+#else
+    UNREFERENCED_PARAMETER(bytes);
+#endif UNIT_TESTING
+}
+
 void RenderTracing::TraceLastText(const til::point lastTextPos) const
 {
 #ifndef UNIT_TESTING
@@ -45,5 +45,7 @@ namespace Microsoft::Console::VirtualTerminal
                              const bool cursorMoved,
                              const std::optional<short>& wrappedRow) const;
         void TraceEndPaint() const;
+        void TraceFrameBytes(const size_t bytes) const;
+        void TraceFirstOutput(const size_t bytes) const;
     };
 }
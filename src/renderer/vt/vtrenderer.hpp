@@ -22,6 +22,7 @@ Author(s):
 #include "tracing.hpp"
 #include <string>
 #include <functional>
+#include <chrono>
 
 // fwdecl unittest classes
 #ifdef UNIT_TESTING
@@ -38,6 +39,11 @@ namespace Microsoft::Console::Render
     public:
         // See _PaintUtf8BufferLine for explanation of this value.
         static const size_t ERASE_CHARACTER_STRING_LENGTH = 8;
+        // See _PaintDiffBufferLine and _WriteTerminalUtf8Repeated for explanations of these values.
+        static const size_t DIFF_SKIP_MIN_COLUMNS = 8;
+        static const size_t REPEAT_CHARACTER_STRING_LENGTH = 5;
+        // See XtermEngine::StartPaint for an explanation of this value.
+        static const size_t WHOLE_FRAME_MIN_PERCENT = 75;
         static const COORD INVALID_COORDS;
 
         VtEngine(_In_ wil::unique_hfile hPipe,
@@ -88,6 +94,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept override;
         [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
         [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
 
         [[nodiscard]] HRESULT SuppressResizeRepaint() noexcept;
 
@@ -103,6 +110,12 @@ namespace Microsoft::Console::Render
         void EndResizeRequest();
 
         void SetResizeQuirk(const bool resizeQuirk);
+        void SetDiffRendering(const bool diffRendering);
+        void SetResizeNegotiated(const bool resizeNegotiated);
+
+        void BeginPassthrough() noexcept;
+        [[nodiscard]] virtual HRESULT EndPassthrough() noexcept;
+        [[nodiscard]] HRESULT WritePassthrough(const std::wstring_view str) noexcept;
 
         [[nodiscard]] virtual HRESULT ManuallyClearScrollback() noexcept;
 
@@ -112,7 +125,6 @@ namespace Microsoft::Console::Render
         wil::unique_hfile _hFile;
         std::string _buffer;
 
-        std::string _formatBuffer;
         std::string _conversionBuffer;
 
         TextAttribute _lastTextAttributes;
@@ -125,6 +137,12 @@ namespace Microsoft::Console::Render
         COORD _lastText;
         til::point _scrollDelta;
 
+        // A scroll within the margins (in viewport coordinates) that the
+        // terminal hasn't been told about yet, and how far it moves the rows
+        // of the region, negative is upwards. See InvalidateScrollRegion.
+        std::optional<til::rectangle> _scrollRegion;
+        short _scrollRegionDelta{ 0 };
+
         bool _quickReturn;
         bool _clearedAllThisFrame;
         bool _cursorMoved;
@@ -140,6 +158,10 @@ namespace Microsoft::Console::Render
         COORD _deferredCursorPos;
 
         bool _pipeBroken;
+        bool _wroteOutput;
+        std::chrono::steady_clock::time_point _lastFlush{};
+        static constexpr size_t s_flushThreshold = 16 * 1024;
+        static constexpr std::chrono::milliseconds s_maxFlushLatency{ 16 };
         HRESULT _exitResult;
         Microsoft::Console::ITerminalOwner* _terminalOwner;
 
@@ -151,11 +173,27 @@ namespace Microsoft::Console::Render
         bool _delayedEolWrap{ false };
 
         bool _resizeQuirk{ false };
+        bool _resizeNegotiated{ false };
         std::optional<TextColor> _newBottomLineBG{ std::nullopt };
 
+        // What we believe the connected terminal currently displays in the
+        // viewport, used to only emit the cells that changed. A cell that
+        // isn't known always gets repainted. See _PaintDiffBufferLine.
+        struct ShadowCell
+        {
+            std::wstring text;
+            TextAttribute attributes;
+            size_t columns{ 0 }; // 0 for the trailing cells of a wide glyph
+            bool known{ false };
+        };
+        bool _diffRendering{ false };
+        bool _passthrough{ false };
+        std::vector<std::vector<ShadowCell>> _shadowRows;
+
         [[nodiscard]] HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]] HRESULT _WriteFormattedString(const std::string* const pFormat, ...) noexcept;
         [[nodiscard]] HRESULT _Flush() noexcept;
+        [[nodiscard]] HRESULT _FlushFrame() noexcept;
 
         void _OrRect(_Inout_ SMALL_RECT* const pRectExisting, const SMALL_RECT* const pRectToOr) const;
         bool _AllIsInvalid() const;
@@ -168,8 +206,12 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _InsertDeleteLine(const short sLines, const bool fInsertLine) noexcept;
         [[nodiscard]] HRESULT _DeleteLine(const short sLines) noexcept;
         [[nodiscard]] HRESULT _InsertLine(const short sLines) noexcept;
+        [[nodiscard]] HRESULT _ScrollUpDown(const short sLines) noexcept;
+        [[nodiscard]] HRESULT _SetScrollMargins(const short top, const short bottom) noexcept;
+        [[nodiscard]] HRESULT _ResetScrollMargins() noexcept;
         [[nodiscard]] HRESULT _CursorForward(const short chars) noexcept;
         [[nodiscard]] HRESULT _EraseCharacter(const short chars) noexcept;
+        [[nodiscard]] HRESULT _RepeatCharacter(const short chars) noexcept;
         [[nodiscard]] HRESULT _CursorPosition(const COORD coord) noexcept;
         [[nodiscard]] HRESULT _CursorHome() noexcept;
         [[nodiscard]] HRESULT _ClearScreen() noexcept;
@@ -221,7 +263,16 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _PaintAsciiBufferLine(gsl::span<const Cluster> const clusters,
                                                     const COORD coord) noexcept;
 
+        [[nodiscard]] HRESULT _PaintDiffBufferLine(gsl::span<const Cluster> const clusters,
+                                                   const COORD coord,
+                                                   const bool lineWrapped) noexcept;
+        bool _ShadowCellMatches(const std::vector<ShadowCell>& row, const size_t column, const Cluster& cluster) const noexcept;
+        void _RecordShadowCells(std::vector<ShadowCell>& row, const size_t column, gsl::span<const Cluster> const clusters);
+        void _ScrollShadowRows(const short dy) noexcept;
+        void _ScrollShadowRows(const short dy, const size_t top, const size_t bottom) noexcept;
+
         [[nodiscard]] HRESULT _WriteTerminalUtf8(const std::wstring_view str) noexcept;
+        [[nodiscard]] HRESULT _WriteTerminalUtf8Repeated(const std::wstring_view str) noexcept;
         [[nodiscard]] HRESULT _WriteTerminalAscii(const std::wstring_view str) noexcept;
 
         [[nodiscard]] virtual HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
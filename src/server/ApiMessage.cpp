@@ -73,7 +73,8 @@ try
 
         ULONG const cbReadSize = Descriptor.InputSize - State.ReadOffset;
 
-        _inputBuffer.resize(cbReadSize);
+        // The payload is read right over it, so there's no need to zero it first.
+        _inputBuffer.resize(cbReadSize, boost::container::default_init);
 
         RETURN_IF_FAILED(ReadMessageInput(0, _inputBuffer.data(), cbReadSize));
 
@@ -112,10 +113,9 @@ try
         ULONG cbWriteSize = Descriptor.OutputSize - State.WriteOffset;
         RETURN_IF_FAILED(ULongMult(cbWriteSize, cbFactor, &cbWriteSize));
 
-        _outputBuffer.resize(cbWriteSize);
-
-        // 0 it out.
-        std::fill(_outputBuffer.begin(), _outputBuffer.end(), (BYTE)0);
+        // 0 it out. This is done in the same pass that sizes it, since resizing
+        // would only zero the part that's new to the buffer.
+        _outputBuffer.assign(cbWriteSize, BYTE{ 0 });
 
         State.OutputBuffer = _outputBuffer.data();
         State.OutputBufferSize = cbWriteSize;
@@ -159,7 +159,7 @@ CATCH_RETURN();
 
     if (State.InputBuffer != nullptr)
     {
-        _inputBuffer.clear();
+        _ReleaseBuffer(_inputBuffer);
         State.InputBuffer = nullptr;
         State.InputBufferSize = 0;
     }
@@ -177,7 +177,7 @@ CATCH_RETURN();
             LOG_IF_FAILED(_pDeviceComm->WriteOutput(&IoOperation));
         }
 
-        _outputBuffer.clear();
+        _ReleaseBuffer(_outputBuffer);
         State.OutputBuffer = nullptr;
         State.OutputBufferSize = 0;
     }
@@ -185,6 +185,23 @@ CATCH_RETURN();
     return hr;
 }
 
+// Routine Description:
+// - Empties the given buffer, but keeps its allocation for the next message,
+//   unless it grew larger than s_RetainedBufferSize. A single large read
+//   shouldn't pin that much memory for the rest of the session.
+// Arguments:
+// - buffer - The input or output buffer of this message.
+// Return Value:
+// - <none>
+void _CONSOLE_API_MSG::_ReleaseBuffer(boost::container::small_vector<BYTE, 128>& buffer)
+{
+    buffer.clear();
+    if (buffer.capacity() > s_RetainedBufferSize)
+    {
+        buffer.shrink_to_fit();
+    }
+}
+
 void _CONSOLE_API_MSG::SetReplyStatus(const NTSTATUS Status)
 {
     Complete.IoStatus.Status = Status;
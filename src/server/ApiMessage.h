@@ -36,9 +36,16 @@ typedef struct _CONSOLE_API_MSG
     IApiRoutines* _pApiRoutines;
 
 private:
+    // The IO thread receives all messages into the same CONSOLE_API_MSG, so these
+    // keep their capacity from one message to the next, up to this size. Only a
+    // message with a larger payload than any one before it allocates.
+    static constexpr size_t s_RetainedBufferSize = 64 * 1024;
+
     boost::container::small_vector<BYTE, 128> _inputBuffer;
     boost::container::small_vector<BYTE, 128> _outputBuffer;
 
+    static void _ReleaseBuffer(boost::container::small_vector<BYTE, 128>& buffer);
+
 public:
     // From here down is the actual packet data sent/received.
     CD_IO_DESCRIPTOR Descriptor;
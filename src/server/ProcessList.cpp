@@ -62,10 +62,21 @@ using namespace Microsoft::Console::Interactivity;
                                                 dwThreadId,
                                                 ulProcessGroupId);
 
-        // Some applications, when reading the process list through the GetConsoleProcessList API, are expecting
-        // the returned list of attached process IDs to be from newest to oldest.
-        // As such, we have to put the newest process into the head of the list.
-        _processes.push_front(pProcessData);
+        try
+        {
+            // Some applications, when reading the process list through the GetConsoleProcessList API, are expecting
+            // the returned list of attached process IDs to be from newest to oldest.
+            // As such, we have to put the newest process into the head of the list.
+            _processes.push_front(pProcessData);
+            _processesById.emplace(dwProcessId, _processes.begin());
+            _processesByGroupId[ulProcessGroupId].push_back(pProcessData);
+        }
+        catch (...)
+        {
+            _RemoveProcess(pProcessData);
+            delete pProcessData;
+            throw;
+        }
 
         if (nullptr != ppProcessData)
         {
@@ -87,14 +98,47 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 {
     FAIL_FAST_IF(!(ServiceLocator::LocateGlobals().getConsoleInformation().IsConsoleLocked()));
 
-    // Assert that the item exists in the list. If it doesn't exist, the end/last will be returned.
-    FAIL_FAST_IF(!(_processes.cend() != std::find(_processes.cbegin(), _processes.cend(), pProcessData)));
+    // Assert that the item exists in the list.
+    const auto found = _processesById.find(pProcessData->dwProcessId);
+    FAIL_FAST_IF(!(found != _processesById.end() && *found->second == pProcessData));
 
-    _processes.remove(pProcessData);
+    _RemoveProcess(pProcessData);
 
     delete pProcessData;
 }
 
+// Routine Description:
+// - Removes the given process from the list and its indexes, without freeing it.
+// Arguments:
+// - pProcessData - Pointer to the per-process data structure.
+// Return Value:
+// - <none>
+void ConsoleProcessList::_RemoveProcess(_In_ ConsoleProcessHandle* const pProcessData) noexcept
+{
+    // The process is only looked up by its ID if it's this process that's
+    // in the index, in case its insertion failed halfway through.
+    if (const auto found = _processesById.find(pProcessData->dwProcessId); found != _processesById.end() && *found->second == pProcessData)
+    {
+        _processes.erase(found->second);
+        _processesById.erase(found);
+    }
+    else
+    {
+        _processes.remove(pProcessData);
+    }
+
+    const auto group = _processesByGroupId.find(pProcessData->_ulProcessGroupId);
+    if (group != _processesByGroupId.end())
+    {
+        auto& processes = group->second;
+        processes.erase(std::remove(processes.begin(), processes.end(), pProcessData), processes.end());
+        if (processes.empty())
+        {
+            _processesByGroupId.erase(group);
+        }
+    }
+}
+
 // Routine Description:
 // - Locates a process handle in this list.
 // - NOTE: Calling FindProcessInList(0) means you want the root process.
@@ -104,25 +148,22 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 // - Pointer to the process handle information or nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProcessId) const
 {
+    if (ROOT_PROCESS_ID != dwProcessId)
+    {
+        const auto found = _processesById.find(dwProcessId);
+        return found != _processesById.end() ? *found->second : nullptr;
+    }
+
+    // The root process is rarely looked up, so it isn't indexed.
     auto it = _processes.cbegin();
 
     while (it != _processes.cend())
     {
         ConsoleProcessHandle* const pProcessHandleRecord = *it;
 
-        if (ROOT_PROCESS_ID != dwProcessId)
+        if (pProcessHandleRecord->fRootProcess)
         {
-            if (pProcessHandleRecord->dwProcessId == dwProcessId)
-            {
-                return pProcessHandleRecord;
-            }
-        }
-        else
-        {
-            if (pProcessHandleRecord->fRootProcess)
-            {
-                return pProcessHandleRecord;
-            }
+            return pProcessHandleRecord;
         }
 
         it = std::next(it);
@@ -139,20 +180,9 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProces
 // - Pointer to first matching process handle with given group ID. nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessByGroupId(_In_ ULONG ulProcessGroupId) const
 {
-    auto it = _processes.cbegin();
-
-    while (it != _processes.cend())
-    {
-        ConsoleProcessHandle* const pProcessHandleRecord = *it;
-        if (pProcessHandleRecord->_ulProcessGroupId == ulProcessGroupId)
-        {
-            return pProcessHandleRecord;
-        }
-
-        it = std::next(it);
-    }
-
-    return nullptr;
+    // The newest process of the group is the one that comes first in _processes.
+    const auto group = _processesByGroupId.find(ulProcessGroupId);
+    return group != _processesByGroupId.end() && !group->second.empty() ? group->second.back() : nullptr;
 }
 
 // Routine Description:
@@ -219,41 +249,43 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessByGroupId(_In_ ULONG ulProc
     {
         std::deque<std::unique_ptr<ConsoleProcessTerminationRecord>> TermRecords;
 
-        // Dig through known processes looking for a match
-        auto it = _processes.cbegin();
-        while (it != _processes.cend())
-        {
-            ConsoleProcessHandle* const pProcessHandleRecord = *it;
+        const auto addRecord = [&](ConsoleProcessHandle* const pProcessHandleRecord) {
+            std::unique_ptr<ConsoleProcessTerminationRecord> pNewRecord = std::make_unique<ConsoleProcessTerminationRecord>();
 
-            // If no limit was specified OR if we have a match, generate a new termination record.
-            if (0 == dwLimitingProcessId ||
-                pProcessHandleRecord->_ulProcessGroupId == dwLimitingProcessId)
-            {
-                std::unique_ptr<ConsoleProcessTerminationRecord> pNewRecord = std::make_unique<ConsoleProcessTerminationRecord>();
+            // If the duplicate failed, the best we can do is to skip including the process in the list and hope it goes away.
+            LOG_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(),
+                                                    pProcessHandleRecord->_hProcess.get(),
+                                                    GetCurrentProcess(),
+                                                    &pNewRecord->hProcess,
+                                                    0,
+                                                    0,
+                                                    DUPLICATE_SAME_ACCESS));
 
-                // If the duplicate failed, the best we can do is to skip including the process in the list and hope it goes away.
-                LOG_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(),
-                                                        pProcessHandleRecord->_hProcess.get(),
-                                                        GetCurrentProcess(),
-                                                        &pNewRecord->hProcess,
-                                                        0,
-                                                        0,
-                                                        DUPLICATE_SAME_ACCESS));
+            pNewRecord->dwProcessID = pProcessHandleRecord->dwProcessId;
 
-                pNewRecord->dwProcessID = pProcessHandleRecord->dwProcessId;
+            // If we're hard closing the window, increment the counter.
+            if (fCtrlClose)
+            {
+                pProcessHandleRecord->_ulTerminateCount++;
+            }
 
-                // If we're hard closing the window, increment the counter.
-                if (fCtrlClose)
-                {
-                    pProcessHandleRecord->_ulTerminateCount++;
-                }
+            pNewRecord->ulTerminateCount = pProcessHandleRecord->_ulTerminateCount;
 
-                pNewRecord->ulTerminateCount = pProcessHandleRecord->_ulTerminateCount;
+            TermRecords.push_back(std::move(pNewRecord));
+        };
 
-                TermRecords.push_back(std::move(pNewRecord));
+        // If no limit was specified, generate a termination record for every known process.
+        // Otherwise only for the ones in the given group, from newest to oldest like the list.
+        if (0 == dwLimitingProcessId)
+        {
+            for (const auto pProcessHandleRecord : _processes)
+            {
+                addRecord(pProcessHandleRecord);
             }
-
-            it = std::next(it);
+        }
+        else if (const auto group = _processesByGroupId.find(dwLimitingProcessId); group != _processesByGroupId.end())
+        {
+            std::for_each(group->second.rbegin(), group->second.rend(), addRecord);
         }
 
         // From all found matches, convert to C-style array to return
@@ -61,5 +61,12 @@ public:
 private:
     std::list<ConsoleProcessHandle*> _processes;
 
+    // Indexes into _processes, by process ID and by process group ID.
+    // The processes of a group are kept from oldest to newest,
+    // so they're walked backwards to match the order of _processes.
+    std::unordered_map<DWORD, std::list<ConsoleProcessHandle*>::iterator> _processesById;
+    std::unordered_map<ULONG, std::vector<ConsoleProcessHandle*>> _processesByGroupId;
+
+    void _RemoveProcess(_In_ ConsoleProcessHandle* const pProcessData) noexcept;
     void _ModifyProcessForegroundRights(const HANDLE hProcess, const bool fForeground) const;
 };
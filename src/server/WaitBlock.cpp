@@ -16,7 +16,7 @@
 // Routine Description:
 // - Initializes a ConsoleWaitBlock
 // - ConsoleWaitBlocks will mostly self-manage their position in their two queues.
-// - They will be pushed into the tail and the resulting iterator stored for constant deletion time later.
+// - They will be pushed into the tail of both and unlink themselves in constant time later.
 // Arguments:
 // - pProcessQueue - The queue attached to the client process ID that requested this action
 // - pObjectQueue - The queue attached to the console object that will service the action when data arrives
@@ -30,6 +30,9 @@ ConsoleWaitBlock::ConsoleWaitBlock(_In_ ConsoleWaitQueue* const pProcessQueue,
     _pObjectQueue(THROW_HR_IF_NULL(E_INVALIDARG, pObjectQueue)),
     _pWaiter(THROW_HR_IF_NULL(E_INVALIDARG, pWaiter))
 {
+    _processQueueLink.pBlock = this;
+    _objectQueueLink.pBlock = this;
+
     _WaitReplyMessage = *pWaitReplyMessage;
 
     // MSFT-33127449, GH#9692
@@ -80,12 +83,9 @@ ConsoleWaitBlock::ConsoleWaitBlock(_In_ ConsoleWaitQueue* const pProcessQueue,
 // Routine Description:
 // - Destroys a ConsolewaitBlock
 // - On deletion, ConsoleWaitBlocks will erase themselves from the process and object queues in
-//   constant time with the iterator acquired on construction.
+//   constant time, since their links unlink themselves when they're destroyed.
 ConsoleWaitBlock::~ConsoleWaitBlock()
 {
-    _pProcessQueue->_blocks.erase(_itProcessQueue);
-    _pObjectQueue->_blocks.erase(_itObjectQueue);
-
     if (_pWaiter != nullptr)
     {
         delete _pWaiter;
@@ -123,9 +123,9 @@ ConsoleWaitBlock::~ConsoleWaitBlock()
                                           pWaitReplyMessage,
                                           pWaiter);
 
-        // Set the iterators on the wait block so that it can remove itself later.
-        pWaitBlock->_itProcessQueue = pProcessQueue->_blocks.insert(pProcessQueue->_blocks.end(), pWaitBlock);
-        pWaitBlock->_itObjectQueue = pObjectQueue->_blocks.insert(pObjectQueue->_blocks.end(), pWaitBlock);
+        // Link the wait block into both queues. It will remove itself later.
+        pProcessQueue->_blocks.push_back(pWaitBlock->_processQueueLink);
+        pObjectQueue->_blocks.push_back(pWaitBlock->_objectQueueLink);
     }
     catch (...)
     {
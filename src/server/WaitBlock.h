@@ -21,13 +21,22 @@ Revision History:
 #include "IWaitRoutine.h"
 #include "WaitTerminationReason.h"
 
-#include <list>
+#include <boost/intrusive/list.hpp>
 
 class ConsoleWaitQueue;
 
 class ConsoleWaitBlock
 {
 public:
+    // A block is linked into two queues at once, so it has a link for each of
+    // them. The links unlink themselves when the block is destroyed, which
+    // takes constant time and doesn't allocate anything to enqueue a block.
+    struct Link : boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+    {
+        ConsoleWaitBlock* pBlock = nullptr;
+    };
+    using Queue = boost::intrusive::list<Link, boost::intrusive::constant_time_size<false>>;
+
     ~ConsoleWaitBlock();
 
     bool Notify(const WaitTerminationReason TerminationReason);
@@ -42,10 +51,10 @@ private:
                      _In_ IWaitRoutine* const pWaiter);
 
     ConsoleWaitQueue* const _pProcessQueue;
-    std::_List_const_iterator<std::_List_val<std::_List_simple_types<ConsoleWaitBlock*>>> _itProcessQueue;
+    Link _processQueueLink;
 
     ConsoleWaitQueue* const _pObjectQueue;
-    std::_List_const_iterator<std::_List_val<std::_List_simple_types<ConsoleWaitBlock*>>> _itObjectQueue;
+    Link _objectQueueLink;
 
     CONSOLE_API_MSG _WaitReplyMessage;
 
@@ -76,10 +76,10 @@ bool ConsoleWaitQueue::NotifyWaiters(const bool fNotifyAll,
 {
     bool fResult = false;
 
-    auto it = _blocks.cbegin();
-    while (!_blocks.empty() && it != _blocks.cend())
+    auto it = _blocks.begin();
+    while (!_blocks.empty() && it != _blocks.end())
     {
-        ConsoleWaitBlock* const WaitBlock = (*it);
+        ConsoleWaitBlock* const WaitBlock = it->pBlock;
         if (nullptr == WaitBlock)
         {
             break;
@@ -17,8 +17,6 @@ Revision History:
 
 #pragma once
 
-#include <list>
-
 #include "../host/conapi.h"
 
 #include "IWaitRoutine.h"
@@ -44,7 +42,7 @@ private:
     bool _NotifyBlock(_In_ ConsoleWaitBlock* pWaitBlock,
                       const WaitTerminationReason TerminationReason);
 
-    std::list<ConsoleWaitBlock*> _blocks;
+    ConsoleWaitBlock::Queue _blocks;
 
     friend class ConsoleWaitBlock; // Blocks live in multiple queues so we let them manage the lifetime.
 };
@@ -42,5 +42,10 @@ namespace Microsoft::Console::VirtualTerminal
                                 const size_t col) = 0;
 
         virtual bool IsVtInputEnabled() const = 0;
+
+        // Between these, the input written by WriteInput and WriteString may be
+        // held back and written in larger batches, e.g. for the text of a paste.
+        virtual void BeginInputBatch() = 0;
+        virtual bool EndInputBatch() = 0;
     };
 }
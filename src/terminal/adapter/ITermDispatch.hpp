@@ -14,6 +14,7 @@ Abstract:
 #pragma once
 #include "DispatchTypes.hpp"
 #include "../buffer/out/LineRendition.hpp"
+#include "../buffer/out/ScrollMarks.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
 {
@@ -23,6 +24,12 @@ namespace Microsoft::Console::VirtualTerminal
 class Microsoft::Console::VirtualTerminal::ITermDispatch
 {
 public:
+    // Sequences with a data string (like DECDLD soft fonts or sixel images)
+    // return one of these from their dispatch method, to be handed the data
+    // in chunks as it is parsed, rather than having it buffered up front.
+    // This is the same type as IStateMachineEngine::StringHandler.
+    using StringHandler = std::function<bool(const std::wstring_view)>;
+
 #pragma warning(push)
 #pragma warning(disable : 26432) // suppress rule of 5 violation on interface because tampering with this is fraught with peril
     virtual ~ITermDispatch() = 0;
@@ -80,6 +87,7 @@ public:
     virtual bool EnableAnyEventMouseMode(const bool enabled) = 0; // ?1003
     virtual bool EnableAlternateScroll(const bool enabled) = 0; // ?1007
     virtual bool EnableXtermBracketedPasteMode(const bool enabled) = 0; // ?2004
+    virtual bool SetSynchronizedOutput(const bool enabled) = 0; // ?2026
     virtual bool SetColorTableEntry(const size_t tableIndex, const DWORD color) = 0; // OSCColorTable
     virtual bool SetDefaultForeground(const DWORD color) = 0; // OSCDefaultForeground
     virtual bool SetDefaultBackground(const DWORD color) = 0; // OSCDefaultBackground
@@ -130,6 +138,10 @@ public:
     virtual bool EndHyperlink() = 0;
 
     virtual bool DoConEmuAction(const std::wstring_view string) = 0;
+
+    virtual bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) = 0; // FinalTerm OSC 133
+
+    virtual StringHandler DefineSixelImage(const VTParameter macroParameter, const VTParameter backgroundSelect) = 0; // DECSIXEL
 };
 inline Microsoft::Console::VirtualTerminal::ITermDispatch::~ITermDispatch() {}
 #pragma warning(pop)
@@ -32,10 +32,64 @@ InteractDispatch::InteractDispatch(std::unique_ptr<ConGetSet> pConApi) :
 // True if handled successfully. False otherwise.
 bool InteractDispatch::WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
 {
+    if (_batchingInput)
+    {
+        std::move(inputEvents.begin(), inputEvents.end(), std::back_inserter(_inputBatch));
+        inputEvents.clear();
+        return true;
+    }
+
     size_t written = 0;
     return _pConApi->PrivateWriteConsoleInputW(inputEvents, written);
 }
 
+// Method Description:
+// - Starts holding back the input given to WriteInput and WriteString, until
+//   EndInputBatch or FlushInputBatch writes all of it to the host at once.
+//   Every write wakes up the client's pending reads, which for the text of a
+//   paste would otherwise happen for every line, if not every key.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InteractDispatch::BeginInputBatch()
+{
+    _batchingInput = true;
+}
+
+// Method Description:
+// - Stops holding back input and writes what was held back so far.
+// Arguments:
+// - <none>
+// Return Value:
+// True if handled successfully. False otherwise.
+bool InteractDispatch::EndInputBatch()
+{
+    _batchingInput = false;
+    return FlushInputBatch();
+}
+
+// Method Description:
+// - Writes the input held back so far, if any, without ending the batch.
+//   This is called once all of the input currently available was parsed,
+//   so that a paste never waits for more of itself to arrive.
+// Arguments:
+// - <none>
+// Return Value:
+// True if handled successfully. False otherwise.
+bool InteractDispatch::FlushInputBatch()
+{
+    if (_inputBatch.empty())
+    {
+        return true;
+    }
+
+    size_t written = 0;
+    const bool success = _pConApi->PrivateWriteConsoleInputW(_inputBatch, written);
+    _inputBatch.clear();
+    return success;
+}
+
 // Method Description:
 // - Writes a key event to the host in a fashion that will enable the host to
 //   process special keys such as Ctrl-C or Ctrl+Break. The host will then
@@ -47,12 +101,14 @@ bool InteractDispatch::WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inpu
 // True if handled successfully. False otherwise.
 bool InteractDispatch::WriteCtrlKey(const KeyEvent& event)
 {
+    // The key mustn't overtake the input that came before it.
+    FlushInputBatch();
     return _pConApi->PrivateWriteConsoleControlInput(event);
 }
 
 // Method Description:
 // - Writes a string of input to the host. The string is converted to keystrokes
-//      that will faithfully represent the input by CharToKeyEvents.
+//      that will faithfully represent the input by CharsToKeyEvents.
 // Arguments:
 // - string : a string to write to the console.
 // Return Value:
@@ -69,15 +125,7 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
     if (success)
     {
         std::deque<std::unique_ptr<IInputEvent>> keyEvents;
-
-        for (const auto& wch : string)
-        {
-            std::deque<std::unique_ptr<KeyEvent>> convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, codepage);
-
-            std::move(convertedEvents.begin(),
-                      convertedEvents.end(),
-                      std::back_inserter(keyEvents));
-        }
+        Microsoft::Console::Interactivity::CharsToKeyEvents(string, codepage, keyEvents);
 
         success = WriteInput(keyEvents);
     }
@@ -100,6 +148,10 @@ bool InteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulatio
                                           const VTParameter parameter1,
                                           const VTParameter parameter2)
 {
+    // A resize is reported to the client as input, which mustn't
+    // overtake the input that came before it.
+    FlushInputBatch();
+
     bool success = false;
     // Other Window Manipulation functions:
     //  MSFT:13271098 - QueryViewport
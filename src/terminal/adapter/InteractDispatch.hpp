@@ -35,7 +35,14 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool IsVtInputEnabled() const override;
 
+        void BeginInputBatch() override;
+        bool EndInputBatch() override;
+        bool FlushInputBatch();
+
     private:
         std::unique_ptr<ConGetSet> _pConApi;
+
+        bool _batchingInput = false;
+        std::deque<std::unique_ptr<IInputEvent>> _inputBatch;
     };
 }
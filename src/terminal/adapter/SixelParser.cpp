@@ -0,0 +1,370 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "SixelParser.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+// Arguments:
+// - aspectRatioSelector - the first parameter of the DECSIXEL sequence,
+//   which selects the number of pixels each sixel dot is high
+// - transparentBackground - if false, the pixels that aren't painted get
+//   the color of the first palette entry
+// - maxWidth - the pixels to the right of this are discarded
+// - maxHeight - the pixels below this are discarded
+SixelParser::SixelParser(const size_t aspectRatioSelector, const bool transparentBackground, const size_t maxWidth, const size_t maxHeight) noexcept :
+    _transparentBackground{ transparentBackground },
+    _maxWidth{ maxWidth },
+    _maxHeight{ maxHeight }
+{
+    switch (aspectRatioSelector)
+    {
+    case 2:
+        _aspectRatio = 5;
+        break;
+    case 3:
+    case 4:
+        _aspectRatio = 3;
+        break;
+    case 7:
+    case 8:
+    case 9:
+        _aspectRatio = 1;
+        break;
+    default:
+        _aspectRatio = 2;
+        break;
+    }
+
+    // The VT340 starts out with these 16 colors, in percent of red, green
+    // and blue. The other entries are black until they're defined.
+    static constexpr std::array<std::array<uint8_t, 3>, 16> defaultColors{ {
+        { 0, 0, 0 },
+        { 20, 20, 80 },
+        { 80, 13, 13 },
+        { 20, 80, 20 },
+        { 80, 20, 80 },
+        { 20, 80, 80 },
+        { 80, 80, 20 },
+        { 53, 53, 53 },
+        { 26, 26, 26 },
+        { 33, 33, 60 },
+        { 60, 26, 26 },
+        { 33, 60, 33 },
+        { 60, 33, 60 },
+        { 33, 60, 60 },
+        { 60, 60, 33 },
+        { 80, 80, 80 },
+    } };
+    _palette.fill(_FromPercent(0, 0, 0));
+    for (size_t i = 0; i < defaultColors.size(); ++i)
+    {
+        const auto& color = til::at(defaultColors, i);
+        til::at(_palette, i) = _FromPercent(color[0], color[1], color[2]);
+    }
+}
+
+// Method Description:
+// - Decodes the next chunk of the data string. The numeric parameters of
+//   a command may be split across chunks, which is why a command is only
+//   executed once the character after its parameters comes in.
+// Arguments:
+// - data - the next part of the data string
+// Return Value:
+// - <none>
+void SixelParser::Parse(const std::wstring_view data)
+{
+    for (const auto ch : data)
+    {
+        if (_command != 0)
+        {
+            if (ch >= L'0' && ch <= L'9')
+            {
+                if (_parameterCount <= MaxParameters)
+                {
+                    auto& parameter = til::at(_parameters, _parameterCount - 1);
+                    parameter = std::min<size_t>(parameter * 10 + (ch - L'0'), 32767);
+                }
+                continue;
+            }
+            if (ch == L';')
+            {
+                _parameterCount = std::min(_parameterCount + 1, MaxParameters + 1);
+                continue;
+            }
+            _ExecuteCommand();
+            _command = 0;
+        }
+
+        switch (ch)
+        {
+        case L'!': // DECGRI - graphics repeat introducer
+        case L'#': // DECGCI - graphics color introducer
+        case L'"': // DECGRA - raster attributes
+            _command = ch;
+            _parameters.fill(0);
+            _parameterCount = 1;
+            break;
+        case L'$': // DECGCR - graphics carriage return
+            _x = 0;
+            break;
+        case L'-': // DECGNL - graphics next line
+            _x = 0;
+            _y += SixelHeight * _aspectRatio;
+            break;
+        default:
+            if (ch >= L'?' && ch <= L'~')
+            {
+                _PaintSixel(ch - L'?');
+            }
+            // Anything else, like the line breaks some applications put
+            // into long data strings, is ignored.
+            break;
+        }
+    }
+}
+
+// Method Description:
+// - Returns the width of the image in pixels.
+size_t SixelParser::Width() const noexcept
+{
+    return _width;
+}
+
+// Method Description:
+// - Returns the height of the image in pixels.
+size_t SixelParser::Height() const noexcept
+{
+    return _height;
+}
+
+// Method Description:
+// - Returns the number of buffer rows the image covers.
+size_t SixelParser::CellRows() const noexcept
+{
+    return (_height + CellHeight - 1) / CellHeight;
+}
+
+// Method Description:
+// - Returns the width of the image in pixels, rounded up to whole cells.
+size_t SixelParser::CellRowWidth() const noexcept
+{
+    return (_width + CellWidth - 1) / CellWidth * CellWidth;
+}
+
+// Method Description:
+// - Cuts out the part of the image that covers the given buffer row.
+// Arguments:
+// - cellRow - the row of cells, counted from the top of the image
+// Return Value:
+// - CellHeight rows of CellRowWidth() premultiplied BGRA pixels each.
+//   The pixels below or to the right of the image are transparent.
+std::vector<RGBQUAD> SixelParser::ReadCellRow(const size_t cellRow) const
+{
+    const auto width = CellRowWidth();
+    std::vector<RGBQUAD> pixels(width * CellHeight);
+
+    const auto background = _transparentBackground ? RGBQUAD{} : til::at(_palette, 0);
+    const auto top = cellRow * CellHeight;
+    const auto bottom = std::min(top + CellHeight, _height);
+    for (auto y = top; y < bottom; ++y)
+    {
+        const auto source = _pixels.begin() + y * _stride;
+        const auto target = pixels.begin() + (y - top) * width;
+        std::transform(source, source + _width, target, [&](const RGBQUAD& pixel) noexcept {
+            return pixel.rgbReserved ? pixel : background;
+        });
+    }
+    return pixels;
+}
+
+void SixelParser::_ExecuteCommand()
+{
+    switch (_command)
+    {
+    case L'!':
+        _repeat = std::max<size_t>(til::at(_parameters, 0), 1);
+        break;
+    case L'#':
+        if (_parameterCount >= MaxParameters)
+        {
+            _DefineColor();
+        }
+        _color = til::at(_parameters, 0) % _palette.size();
+        break;
+    case L'"':
+        _SetRasterAttributes();
+        break;
+    default:
+        break;
+    }
+}
+
+// Method Description:
+// - Applies DECGRA: Pan;Pad;Ph;Pv. The aspect ratio Pan/Pad can only be
+//   changed before any sixels were painted. With an opaque background,
+//   the Ph by Pv pixels are filled with it, even if they're never painted.
+void SixelParser::_SetRasterAttributes()
+{
+    const auto numerator = til::at(_parameters, 0);
+    const auto denominator = til::at(_parameters, 1);
+    if (!_anySixels && numerator > 0 && denominator > 0)
+    {
+        _aspectRatio = std::clamp<size_t>((numerator + denominator / 2) / denominator, 1, 10);
+    }
+
+    if (!_transparentBackground)
+    {
+        const auto width = std::min(til::at(_parameters, 2), _maxWidth);
+        const auto height = std::min(til::at(_parameters, 3), _maxHeight);
+        _Reserve(width, height);
+        _width = std::max(_width, width);
+        _height = std::max(_height, height);
+    }
+}
+
+// Method Description:
+// - Applies DECGCI with a color definition: Pc;Pu;Px;Py;Pz, where Pu is 1
+//   for hue, lightness and saturation, and 2 for red, green and blue.
+void SixelParser::_DefineColor() noexcept
+{
+    auto& color = til::at(_palette, til::at(_parameters, 0) % _palette.size());
+    switch (til::at(_parameters, 1))
+    {
+    case 1:
+        color = _FromHls(til::at(_parameters, 2), til::at(_parameters, 3), til::at(_parameters, 4));
+        break;
+    case 2:
+        color = _FromPercent(til::at(_parameters, 2), til::at(_parameters, 3), til::at(_parameters, 4));
+        break;
+    default:
+        break;
+    }
+}
+
+// Method Description:
+// - Paints a column of six dots, each _aspectRatio pixels high, in the
+//   current color, as many times as the last DECGRI asked for.
+// Arguments:
+// - bits - which of the dots are painted, with the top one in bit 0
+// Return Value:
+// - <none>
+void SixelParser::_PaintSixel(const size_t bits)
+{
+    _anySixels = true;
+
+    const auto xBegin = _x;
+    const auto xEnd = std::min(_x + _repeat, _maxWidth);
+    _x += _repeat;
+    _repeat = 1;
+
+    if (xBegin >= xEnd || _y >= _maxHeight)
+    {
+        return;
+    }
+
+    // Even a sixel without any dots makes the image as big as its band.
+    const auto yEnd = std::min(_y + SixelHeight * _aspectRatio, _maxHeight);
+    _Reserve(xEnd, yEnd);
+    _width = std::max(_width, xEnd);
+    _height = std::max(_height, yEnd);
+
+    const auto color = til::at(_palette, _color);
+    for (size_t bit = 0; bit < SixelHeight; ++bit)
+    {
+        if ((bits & (size_t{ 1 } << bit)) == 0)
+        {
+            continue;
+        }
+
+        const auto top = _y + bit * _aspectRatio;
+        const auto bottom = std::min(top + _aspectRatio, yEnd);
+        for (auto y = top; y < bottom; ++y)
+        {
+            const auto row = _pixels.begin() + y * _stride;
+            std::fill(row + xBegin, row + xEnd, color);
+        }
+    }
+}
+
+// Method Description:
+// - Makes room for at least the given number of pixels. Images that don't
+//   announce their size with DECGRA grow a sixel at a time, so the stride
+//   is at least doubled whenever it grows, to not move the pixels over and
+//   over. Both sizes must be within the maximum size.
+void SixelParser::_Reserve(const size_t width, const size_t height)
+{
+    if (width > _stride)
+    {
+        const auto stride = std::min(std::max(width, _stride * 2), _maxWidth);
+        const auto rows = _stride ? _pixels.size() / _stride : 0;
+        std::vector<RGBQUAD> pixels(rows * stride);
+        for (size_t y = 0; y < rows; ++y)
+        {
+            std::copy_n(_pixels.begin() + y * _stride, _stride, pixels.begin() + y * stride);
+        }
+        _pixels = std::move(pixels);
+        _stride = stride;
+    }
+
+    if (height * _stride > _pixels.size())
+    {
+        _pixels.resize(height * _stride);
+    }
+}
+
+RGBQUAD SixelParser::_FromPercent(const size_t red, const size_t green, const size_t blue) noexcept
+{
+    const auto toByte = [](const size_t percent) noexcept {
+        return gsl::narrow_cast<BYTE>((std::min<size_t>(percent, 100) * 255 + 50) / 100);
+    };
+    return RGBQUAD{ toByte(blue), toByte(green), toByte(red), 0xff };
+}
+
+RGBQUAD SixelParser::_FromHls(const size_t hue, const size_t lightness, const size_t saturation) noexcept
+{
+    // The hue circle of DEC starts at blue, where the usual one starts at red.
+    const auto h = static_cast<float>((hue % 360 + 240) % 360) / 60.0f;
+    const auto l = static_cast<float>(std::min<size_t>(lightness, 100)) / 100.0f;
+    const auto s = static_cast<float>(std::min<size_t>(saturation, 100)) / 100.0f;
+
+    const auto chroma = (1.0f - std::fabs(2.0f * l - 1.0f)) * s;
+    const auto x = chroma * (1.0f - std::fabs(std::fmod(h, 2.0f) - 1.0f));
+    const auto m = l - chroma / 2.0f;
+
+    float r = 0, g = 0, b = 0;
+    switch (static_cast<int>(h))
+    {
+    case 0:
+        r = chroma;
+        g = x;
+        break;
+    case 1:
+        r = x;
+        g = chroma;
+        break;
+    case 2:
+        g = chroma;
+        b = x;
+        break;
+    case 3:
+        g = x;
+        b = chroma;
+        break;
+    case 4:
+        r = x;
+        b = chroma;
+        break;
+    default:
+        r = chroma;
+        b = x;
+        break;
+    }
+
+    const auto toByte = [m](const float value) noexcept {
+        return gsl::narrow_cast<BYTE>(std::lround(std::clamp((value + m) * 255.0f, 0.0f, 255.0f)));
+    };
+    return RGBQUAD{ toByte(b), toByte(g), toByte(r), 0xff };
+}
@@ -0,0 +1,79 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SixelParser.hpp
+
+Abstract:
+- Decodes the data string of a DECSIXEL sequence (DCS q) into an image.
+- Like on the VT340, every character cell is 10 by 20 pixels big, which is
+  what lets the image be cut into one slice per row of the buffer. The
+  renderer scales the slices to the actual cell size of the font.
+- The data is parsed as it comes in, so nothing but the decoded pixels are
+  kept around, and the image is cut off at the given maximum size, no
+  matter how big the application claims it is.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class SixelParser final
+    {
+    public:
+        static constexpr size_t CellWidth = 10;
+        static constexpr size_t CellHeight = 20;
+        static constexpr til::size CellSize{ 10, 20 };
+
+        SixelParser(const size_t aspectRatioSelector, const bool transparentBackground, const size_t maxWidth, const size_t maxHeight) noexcept;
+
+        void Parse(const std::wstring_view data);
+
+        size_t Width() const noexcept;
+        size_t Height() const noexcept;
+        size_t CellRows() const noexcept;
+        size_t CellRowWidth() const noexcept;
+        std::vector<RGBQUAD> ReadCellRow(const size_t cellRow) const;
+
+    private:
+        static constexpr size_t MaxParameters = 5;
+        static constexpr size_t SixelHeight = 6;
+
+        void _ExecuteCommand();
+        void _SetRasterAttributes();
+        void _DefineColor() noexcept;
+        void _PaintSixel(const size_t bits);
+        void _Reserve(const size_t width, const size_t height);
+
+        static RGBQUAD _FromPercent(const size_t red, const size_t green, const size_t blue) noexcept;
+        static RGBQUAD _FromHls(const size_t hue, const size_t lightness, const size_t saturation) noexcept;
+
+        std::array<RGBQUAD, 256> _palette;
+        size_t _color = 0;
+
+        size_t _aspectRatio;
+        bool _transparentBackground;
+        size_t _maxWidth;
+        size_t _maxHeight;
+
+        // The command that collects the numeric parameters that follow it,
+        // or 0 while sixels are being painted.
+        wchar_t _command = 0;
+        std::array<size_t, MaxParameters> _parameters{};
+        size_t _parameterCount = 0;
+        bool _anySixels = false;
+
+        size_t _x = 0;
+        size_t _y = 0;
+        size_t _repeat = 1;
+
+        // The pixels are premultiplied BGRA, the ones that weren't painted
+        // are all 0. The rows are _stride pixels apart, of which the first
+        // _width are used.
+        std::vector<RGBQUAD> _pixels;
+        size_t _stride = 0;
+        size_t _width = 0;
+        size_t _height = 0;
+    };
+}
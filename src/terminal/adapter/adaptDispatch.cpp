@@ -47,6 +47,8 @@ AdaptDispatch::AdaptDispatch(std::unique_ptr<ConGetSet> pConApi,
 // - <none>
 void AdaptDispatch::Print(const wchar_t wchPrintable)
 {
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
     const auto wchTranslated = _termOutput.TranslateKey(wchPrintable);
     // By default the DEL character is meant to be ignored in the same way as a
     // NUL character. However, it's possible that it could be translated to a
@@ -67,6 +69,8 @@ void AdaptDispatch::Print(const wchar_t wchPrintable)
 // - <none>
 void AdaptDispatch::PrintString(const std::wstring_view string)
 {
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::buffer_write };
+
     try
     {
         if (_termOutput.NeedToTranslate())
@@ -320,23 +324,18 @@ bool AdaptDispatch::CursorPosition(const size_t line, const size_t column)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::CursorSaveState()
 {
-    // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    // Then retrieve the cursor position. In VT speak, the cursor row should be
+    // relative to the current viewport top, which is how it's given to us.
+    COORD coordCursor = { 0 };
+    bool success = (_pConApi->MoveToBottom() && _pConApi->PrivateGetViewportCursorPosition(coordCursor));
 
     TextAttribute attributes;
     success = success && (_pConApi->PrivateGetTextAttributes(attributes));
 
     if (success)
     {
-        // The cursor is given to us by the API as relative to the whole buffer.
-        // But in VT speak, the cursor row should be relative to the current viewport top.
-        COORD coordCursor = csbiex.dwCursorPosition;
-        coordCursor.Y -= csbiex.srWindow.Top;
-
         // VT is also 1 based, not 0 based, so correct by 1.
         auto& savedCursorState = _savedCursorState.at(_usingAltBuffer);
         savedCursorState.Column = coordCursor.X + 1;
@@ -1130,6 +1129,9 @@ bool AdaptDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param, con
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = SetSynchronizedOutput(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -2208,6 +2210,25 @@ bool AdaptDispatch::EnableXtermBracketedPasteMode(const bool /*enabled*/) noexce
     return NoOp();
 }
 
+//Routine Description:
+// Synchronized Output - While enabled, the frames the application writes
+//      aren't painted, until it disables it again and the frame is complete.
+//Arguments:
+// - enabled - true when the application begins a frame, false when it ends it.
+// Return value:
+// True if handled successfully. False otherwise.
+bool AdaptDispatch::SetSynchronizedOutput(const bool enabled)
+{
+    // If we're a conpty, always return false, so that the connected terminal
+    // holds back its frames instead. Our own frames aren't shown to anyone.
+    if (_pConApi->IsConsolePty())
+    {
+        return false;
+    }
+
+    return _pConApi->PrivateSetSynchronizedOutput(enabled);
+}
+
 //Routine Description:
 // Set Cursor Style - Changes the cursor's style to match the given Dispatch
 //      cursor style. Unix styles are a combination of the shape and the blinking state.
@@ -2436,6 +2457,85 @@ bool AdaptDispatch::DoConEmuAction(const std::wstring_view /*string*/) noexcept
     return false;
 }
 
+// Method Description:
+// - Marks the position of the cursor as the start of a prompt, a command or
+//   its output, or where the command finished, as told by the shell.
+// Arguments:
+// - kind - what's marked
+// - exitCode - the exit code of the command, if it finished
+// Return Value:
+// - True if handled successfully. False otherwise, which passes it through
+//   to the connected terminal when we're a conpty, where the marks are used.
+bool AdaptDispatch::AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode)
+{
+    if (_pConApi->IsConsolePty())
+    {
+        return false;
+    }
+    return _pConApi->PrivateAddMark(kind, exitCode);
+}
+
+// Method Description:
+// - DECSIXEL - Starts a sixel image at the cursor position. It's decoded as
+//   the data string comes in and put into the buffer once it's complete.
+//   Like on the VT340, it's cut off at the right edge of the buffer and at
+//   the height of the viewport.
+// Arguments:
+// - macroParameter - selects the aspect ratio of the sixel dots
+// - backgroundSelect - 1 leaves the pixels that aren't painted transparent
+// Return Value:
+// - the function that receives the data string, or nullptr when we're a
+//   conpty, because the connected terminal can't be sent the image
+ITermDispatch::StringHandler AdaptDispatch::DefineSixelImage(const VTParameter macroParameter, const VTParameter backgroundSelect)
+{
+    if (_pConApi->IsConsolePty())
+    {
+        return nullptr;
+    }
+
+    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
+    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    if (!_pConApi->GetConsoleScreenBufferInfoEx(csbiex))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        const auto columns = gsl::narrow_cast<size_t>(std::max(csbiex.dwSize.X - csbiex.dwCursorPosition.X, 0));
+        const auto rows = gsl::narrow_cast<size_t>(std::max(csbiex.srWindow.Bottom - csbiex.srWindow.Top, 0));
+        const auto parser = std::make_shared<SixelParser>(macroParameter.value_or(0),
+                                                          backgroundSelect.value_or(0) == 1,
+                                                          columns * SixelParser::CellWidth,
+                                                          rows * SixelParser::CellHeight);
+        return [this, parser](const std::wstring_view data) noexcept {
+            try
+            {
+                // The state machine passes a lone ESC once the string has ended.
+                if (data.size() == 1 && data.front() == AsciiChars::ESC)
+                {
+                    _WriteSixelImage(*parser);
+                }
+                else
+                {
+                    parser->Parse(data);
+                }
+                return true;
+            }
+            catch (...)
+            {
+                LOG_HR(wil::ResultFromCaughtException());
+                return false;
+            }
+        };
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return nullptr;
+    }
+}
+
 // Routine Description:
 // - Determines whether we should pass any sequence that manipulates
 //   TerminalInput's input generator through the PTY. It encapsulates
@@ -2454,3 +2554,23 @@ bool AdaptDispatch::_ShouldPassThroughInputModeChange() const
     // because SSH <=7.7 is out in the wild on all versions of Windows <=2004.
     return _pConApi->IsConsolePty() && _pConApi->PrivateIsVtInputEnabled();
 }
+
+// Routine Description:
+// - Puts a decoded sixel image into the buffer, a slice per row, starting at
+//   the cursor. Each row is followed by a line feed, so the buffer scrolls
+//   like it would for text, and the cursor ends up below the image, in the
+//   column the image started in.
+// Arguments:
+// - parser - the parser that decoded the complete data string
+// Return Value:
+// - <none>
+void AdaptDispatch::_WriteSixelImage(const SixelParser& parser)
+{
+    const auto pixelWidth = parser.CellRowWidth();
+    for (size_t row = 0; row < parser.CellRows(); ++row)
+    {
+        const auto pixels = parser.ReadCellRow(row);
+        _pConApi->PrivateWriteImageSlice(SixelParser::CellSize, pixels, pixelWidth);
+        _pConApi->PrivateLineFeed(false);
+    }
+}
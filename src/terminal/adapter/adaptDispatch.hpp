@@ -19,6 +19,7 @@ Author(s):
 #include "conGetSet.hpp"
 #include "adaptDefaults.hpp"
 #include "terminalOutput.hpp"
+#include "SixelParser.hpp"
 #include "..\..\types\inc\sgrStack.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
@@ -111,6 +112,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool EnableAnyEventMouseMode(const bool enabled) override; // ?1003
         bool EnableAlternateScroll(const bool enabled) override; // ?1007
         bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+        bool SetSynchronizedOutput(const bool enabled) override; // ?2026
         bool SetCursorStyle(const DispatchTypes::CursorStyle cursorStyle) override; // DECSCUSR
         bool SetCursorColor(const COLORREF cursorColor) override;
 
@@ -130,6 +132,10 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool DoConEmuAction(const std::wstring_view string) noexcept override;
 
+        bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) override; // FinalTerm OSC 133
+
+        StringHandler DefineSixelImage(const VTParameter macroParameter, const VTParameter backgroundSelect) override; // DECSIXEL
+
     private:
         enum class ScrollDirection
         {
@@ -181,6 +187,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool _ShouldPassThroughInputModeChange() const;
 
+        void _WriteSixelImage(const SixelParser& parser);
+
         std::vector<bool> _tabStopColumns;
         bool _initDefaultTabStops = true;
 
@@ -205,6 +213,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         SgrStack _sgrStack;
 
+        void _ApplyGraphicsOptions(const VTParameters options, TextAttribute& attr) noexcept;
         size_t _SetRgbColorsHelper(const VTParameters options,
                                    TextAttribute& attr,
                                    const bool isForeground) noexcept;
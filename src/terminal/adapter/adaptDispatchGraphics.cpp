@@ -103,190 +103,209 @@ bool AdaptDispatch::SetGraphicsRendition(const VTParameters options)
 
     if (success)
     {
-        // Run through the graphics options and apply them
-        for (size_t i = 0; i < options.size(); i++)
+        const auto previousAttr = attr;
+        _ApplyGraphicsOptions(options, attr);
+
+        // Colorized output tends to repeat the rendition it already has (like
+        // a reset after every token), in which case there's nothing to store.
+        if (attr != previousAttr)
         {
-            const GraphicsOptions opt = options.at(i);
-            switch (opt)
-            {
-            case Off:
-                attr.SetDefaultForeground();
-                attr.SetDefaultBackground();
-                attr.SetDefaultMetaAttrs();
-                break;
-            case ForegroundDefault:
-                attr.SetDefaultForeground();
-                break;
-            case BackgroundDefault:
-                attr.SetDefaultBackground();
-                break;
-            case BoldBright:
-                attr.SetBold(true);
-                break;
-            case RGBColorOrFaint:
-                attr.SetFaint(true);
-                break;
-            case NotBoldOrFaint:
-                attr.SetBold(false);
-                attr.SetFaint(false);
-                break;
-            case Italics:
-                attr.SetItalic(true);
-                break;
-            case NotItalics:
-                attr.SetItalic(false);
-                break;
-            case BlinkOrXterm256Index:
-            case RapidBlink: // We just interpret rapid blink as an alias of blink.
-                attr.SetBlinking(true);
-                break;
-            case Steady:
-                attr.SetBlinking(false);
-                break;
-            case Invisible:
-                attr.SetInvisible(true);
-                break;
-            case Visible:
-                attr.SetInvisible(false);
-                break;
-            case CrossedOut:
-                attr.SetCrossedOut(true);
-                break;
-            case NotCrossedOut:
-                attr.SetCrossedOut(false);
-                break;
-            case Negative:
-                attr.SetReverseVideo(true);
-                break;
-            case Positive:
-                attr.SetReverseVideo(false);
-                break;
-            case Underline:
-                attr.SetUnderlined(true);
-                break;
-            case DoublyUnderlined:
-                attr.SetDoublyUnderlined(true);
-                break;
-            case NoUnderline:
-                attr.SetUnderlined(false);
-                attr.SetDoublyUnderlined(false);
-                break;
-            case Overline:
-                attr.SetOverlined(true);
-                break;
-            case NoOverline:
-                attr.SetOverlined(false);
-                break;
-            case ForegroundBlack:
-                attr.SetIndexedForeground(DARK_BLACK);
-                break;
-            case ForegroundBlue:
-                attr.SetIndexedForeground(DARK_BLUE);
-                break;
-            case ForegroundGreen:
-                attr.SetIndexedForeground(DARK_GREEN);
-                break;
-            case ForegroundCyan:
-                attr.SetIndexedForeground(DARK_CYAN);
-                break;
-            case ForegroundRed:
-                attr.SetIndexedForeground(DARK_RED);
-                break;
-            case ForegroundMagenta:
-                attr.SetIndexedForeground(DARK_MAGENTA);
-                break;
-            case ForegroundYellow:
-                attr.SetIndexedForeground(DARK_YELLOW);
-                break;
-            case ForegroundWhite:
-                attr.SetIndexedForeground(DARK_WHITE);
-                break;
-            case BackgroundBlack:
-                attr.SetIndexedBackground(DARK_BLACK);
-                break;
-            case BackgroundBlue:
-                attr.SetIndexedBackground(DARK_BLUE);
-                break;
-            case BackgroundGreen:
-                attr.SetIndexedBackground(DARK_GREEN);
-                break;
-            case BackgroundCyan:
-                attr.SetIndexedBackground(DARK_CYAN);
-                break;
-            case BackgroundRed:
-                attr.SetIndexedBackground(DARK_RED);
-                break;
-            case BackgroundMagenta:
-                attr.SetIndexedBackground(DARK_MAGENTA);
-                break;
-            case BackgroundYellow:
-                attr.SetIndexedBackground(DARK_YELLOW);
-                break;
-            case BackgroundWhite:
-                attr.SetIndexedBackground(DARK_WHITE);
-                break;
-            case BrightForegroundBlack:
-                attr.SetIndexedForeground(BRIGHT_BLACK);
-                break;
-            case BrightForegroundBlue:
-                attr.SetIndexedForeground(BRIGHT_BLUE);
-                break;
-            case BrightForegroundGreen:
-                attr.SetIndexedForeground(BRIGHT_GREEN);
-                break;
-            case BrightForegroundCyan:
-                attr.SetIndexedForeground(BRIGHT_CYAN);
-                break;
-            case BrightForegroundRed:
-                attr.SetIndexedForeground(BRIGHT_RED);
-                break;
-            case BrightForegroundMagenta:
-                attr.SetIndexedForeground(BRIGHT_MAGENTA);
-                break;
-            case BrightForegroundYellow:
-                attr.SetIndexedForeground(BRIGHT_YELLOW);
-                break;
-            case BrightForegroundWhite:
-                attr.SetIndexedForeground(BRIGHT_WHITE);
-                break;
-            case BrightBackgroundBlack:
-                attr.SetIndexedBackground(BRIGHT_BLACK);
-                break;
-            case BrightBackgroundBlue:
-                attr.SetIndexedBackground(BRIGHT_BLUE);
-                break;
-            case BrightBackgroundGreen:
-                attr.SetIndexedBackground(BRIGHT_GREEN);
-                break;
-            case BrightBackgroundCyan:
-                attr.SetIndexedBackground(BRIGHT_CYAN);
-                break;
-            case BrightBackgroundRed:
-                attr.SetIndexedBackground(BRIGHT_RED);
-                break;
-            case BrightBackgroundMagenta:
-                attr.SetIndexedBackground(BRIGHT_MAGENTA);
-                break;
-            case BrightBackgroundYellow:
-                attr.SetIndexedBackground(BRIGHT_YELLOW);
-                break;
-            case BrightBackgroundWhite:
-                attr.SetIndexedBackground(BRIGHT_WHITE);
-                break;
-            case ForegroundExtended:
-                i += _SetRgbColorsHelper(options.subspan(i + 1), attr, true);
-                break;
-            case BackgroundExtended:
-                i += _SetRgbColorsHelper(options.subspan(i + 1), attr, false);
-                break;
-            }
+            success = _pConApi->PrivateSetTextAttributes(attr);
         }
-        success = _pConApi->PrivateSetTextAttributes(attr);
     }
 
     return success;
 }
 
+// Routine Description:
+// - Applies all of the given SGR options to an attribute, in a single pass
+//   over the parameter list. The caller is responsible for storing the result.
+// Arguments:
+// - options - An array of options that will be applied from 0 to N, in order.
+// - attr - The attribute that will be updated with the options.
+// Return Value:
+// - <none>
+void AdaptDispatch::_ApplyGraphicsOptions(const VTParameters options, TextAttribute& attr) noexcept
+{
+    for (size_t i = 0; i < options.size(); i++)
+    {
+        const GraphicsOptions opt = options.at(i);
+        switch (opt)
+        {
+        case Off:
+            attr.SetDefaultForeground();
+            attr.SetDefaultBackground();
+            attr.SetDefaultMetaAttrs();
+            break;
+        case ForegroundDefault:
+            attr.SetDefaultForeground();
+            break;
+        case BackgroundDefault:
+            attr.SetDefaultBackground();
+            break;
+        case BoldBright:
+            attr.SetBold(true);
+            break;
+        case RGBColorOrFaint:
+            attr.SetFaint(true);
+            break;
+        case NotBoldOrFaint:
+            attr.SetBold(false);
+            attr.SetFaint(false);
+            break;
+        case Italics:
+            attr.SetItalic(true);
+            break;
+        case NotItalics:
+            attr.SetItalic(false);
+            break;
+        case BlinkOrXterm256Index:
+        case RapidBlink: // We just interpret rapid blink as an alias of blink.
+            attr.SetBlinking(true);
+            break;
+        case Steady:
+            attr.SetBlinking(false);
+            break;
+        case Invisible:
+            attr.SetInvisible(true);
+            break;
+        case Visible:
+            attr.SetInvisible(false);
+            break;
+        case CrossedOut:
+            attr.SetCrossedOut(true);
+            break;
+        case NotCrossedOut:
+            attr.SetCrossedOut(false);
+            break;
+        case Negative:
+            attr.SetReverseVideo(true);
+            break;
+        case Positive:
+            attr.SetReverseVideo(false);
+            break;
+        case Underline:
+            attr.SetUnderlined(true);
+            break;
+        case DoublyUnderlined:
+            attr.SetDoublyUnderlined(true);
+            break;
+        case NoUnderline:
+            attr.SetUnderlined(false);
+            attr.SetDoublyUnderlined(false);
+            break;
+        case Overline:
+            attr.SetOverlined(true);
+            break;
+        case NoOverline:
+            attr.SetOverlined(false);
+            break;
+        case ForegroundBlack:
+            attr.SetIndexedForeground(DARK_BLACK);
+            break;
+        case ForegroundBlue:
+            attr.SetIndexedForeground(DARK_BLUE);
+            break;
+        case ForegroundGreen:
+            attr.SetIndexedForeground(DARK_GREEN);
+            break;
+        case ForegroundCyan:
+            attr.SetIndexedForeground(DARK_CYAN);
+            break;
+        case ForegroundRed:
+            attr.SetIndexedForeground(DARK_RED);
+            break;
+        case ForegroundMagenta:
+            attr.SetIndexedForeground(DARK_MAGENTA);
+            break;
+        case ForegroundYellow:
+            attr.SetIndexedForeground(DARK_YELLOW);
+            break;
+        case ForegroundWhite:
+            attr.SetIndexedForeground(DARK_WHITE);
+            break;
+        case BackgroundBlack:
+            attr.SetIndexedBackground(DARK_BLACK);
+            break;
+        case BackgroundBlue:
+            attr.SetIndexedBackground(DARK_BLUE);
+            break;
+        case BackgroundGreen:
+            attr.SetIndexedBackground(DARK_GREEN);
+            break;
+        case BackgroundCyan:
+            attr.SetIndexedBackground(DARK_CYAN);
+            break;
+        case BackgroundRed:
+            attr.SetIndexedBackground(DARK_RED);
+            break;
+        case BackgroundMagenta:
+            attr.SetIndexedBackground(DARK_MAGENTA);
+            break;
+        case BackgroundYellow:
+            attr.SetIndexedBackground(DARK_YELLOW);
+            break;
+        case BackgroundWhite:
+            attr.SetIndexedBackground(DARK_WHITE);
+            break;
+        case BrightForegroundBlack:
+            attr.SetIndexedForeground(BRIGHT_BLACK);
+            break;
+        case BrightForegroundBlue:
+            attr.SetIndexedForeground(BRIGHT_BLUE);
+            break;
+        case BrightForegroundGreen:
+            attr.SetIndexedForeground(BRIGHT_GREEN);
+            break;
+        case BrightForegroundCyan:
+            attr.SetIndexedForeground(BRIGHT_CYAN);
+            break;
+        case BrightForegroundRed:
+            attr.SetIndexedForeground(BRIGHT_RED);
+            break;
+        case BrightForegroundMagenta:
+            attr.SetIndexedForeground(BRIGHT_MAGENTA);
+            break;
+        case BrightForegroundYellow:
+            attr.SetIndexedForeground(BRIGHT_YELLOW);
+            break;
+        case BrightForegroundWhite:
+            attr.SetIndexedForeground(BRIGHT_WHITE);
+            break;
+        case BrightBackgroundBlack:
+            attr.SetIndexedBackground(BRIGHT_BLACK);
+            break;
+        case BrightBackgroundBlue:
+            attr.SetIndexedBackground(BRIGHT_BLUE);
+            break;
+        case BrightBackgroundGreen:
+            attr.SetIndexedBackground(BRIGHT_GREEN);
+            break;
+        case BrightBackgroundCyan:
+            attr.SetIndexedBackground(BRIGHT_CYAN);
+            break;
+        case BrightBackgroundRed:
+            attr.SetIndexedBackground(BRIGHT_RED);
+            break;
+        case BrightBackgroundMagenta:
+            attr.SetIndexedBackground(BRIGHT_MAGENTA);
+            break;
+        case BrightBackgroundYellow:
+            attr.SetIndexedBackground(BRIGHT_YELLOW);
+            break;
+        case BrightBackgroundWhite:
+            attr.SetIndexedBackground(BRIGHT_WHITE);
+            break;
+        case ForegroundExtended:
+            i += _SetRgbColorsHelper(options.subspan(i + 1), attr, true);
+            break;
+        case BackgroundExtended:
+            i += _SetRgbColorsHelper(options.subspan(i + 1), attr, false);
+            break;
+        }
+    }
+}
+
 // Method Description:
 // - Saves the current text attributes to an internal stack.
 // Arguments:
@@ -319,10 +338,22 @@ bool AdaptDispatch::PushGraphicsRendition(const VTParameters options)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::PopGraphicsRendition()
 {
+    // Popping an empty stack leaves the attributes as they are, so there's
+    // nothing to fetch or store.
+    if (_sgrStack.IsEmpty())
+    {
+        return true;
+    }
+
     bool success = true;
     TextAttribute currentAttributes;
 
-    success = _pConApi->PrivateGetTextAttributes(currentAttributes);
+    // The current attributes are only needed when the saved entry has to be
+    // combined with them. A full save replaces them outright.
+    if (!_sgrStack.TopRestoresAllAttributes())
+    {
+        success = _pConApi->PrivateGetTextAttributes(currentAttributes);
+    }
 
     if (success)
     {
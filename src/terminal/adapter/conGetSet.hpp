@@ -18,6 +18,7 @@ Author(s):
 #include "../../types/inc/IInputEvent.hpp"
 #include "../../buffer/out/LineRendition.hpp"
 #include "../../buffer/out/TextAttribute.hpp"
+#include "../../buffer/out/ScrollMarks.hpp"
 #include "../../inc/conattrs.hpp"
 
 #include <deque>
@@ -32,6 +33,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool GetConsoleScreenBufferInfoEx(CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) const = 0;
         virtual bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) = 0;
         virtual bool SetConsoleCursorPosition(const COORD position) = 0;
+        virtual bool PrivateGetViewportCursorPosition(COORD& position) const = 0;
 
         virtual bool PrivateIsVtInputEnabled() const = 0;
 
@@ -72,6 +74,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool PrivateEnableButtonEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAnyEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAlternateScroll(const bool enabled) = 0;
+        virtual bool PrivateSetSynchronizedOutput(const bool enabled) = 0;
         virtual bool PrivateEraseAll() = 0;
         virtual bool GetUserDefaultCursorStyle(CursorType& style) = 0;
         virtual bool SetCursorStyle(const CursorType style) = 0;
@@ -107,5 +110,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual bool PrivateAddHyperlink(const std::wstring_view uri, const std::wstring_view params) const = 0;
         virtual bool PrivateEndHyperlink() const = 0;
+
+        virtual bool PrivateAddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) = 0;
+        virtual bool PrivateWriteImageSlice(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth) = 0;
     };
 }
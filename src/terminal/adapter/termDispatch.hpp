@@ -73,6 +73,7 @@ public:
     bool EnableAnyEventMouseMode(const bool /*enabled*/) noexcept override { return false; } // ?1003
     bool EnableAlternateScroll(const bool /*enabled*/) noexcept override { return false; } // ?1007
     bool EnableXtermBracketedPasteMode(const bool /*enabled*/) noexcept override { return false; } // ?2004
+    bool SetSynchronizedOutput(const bool /*enabled*/) noexcept override { return false; } // ?2026
     bool SetColorTableEntry(const size_t /*tableIndex*/, const DWORD /*color*/) noexcept override { return false; } // OSCColorTable
     bool SetDefaultForeground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultForeground
     bool SetDefaultBackground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultBackground
@@ -123,4 +124,8 @@ public:
     bool EndHyperlink() noexcept override { return false; }
 
     bool DoConEmuAction(const std::wstring_view /*string*/) noexcept override { return false; }
+
+    bool AddMark(const MarkKind /*kind*/, const std::optional<unsigned int> /*exitCode*/) noexcept override { return false; }
+
+    StringHandler DefineSixelImage(const VTParameter /*macroParameter*/, const VTParameter /*backgroundSelect*/) noexcept override { return nullptr; } // DECSIXEL
 };
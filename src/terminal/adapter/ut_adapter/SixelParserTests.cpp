@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <wextestclass.h>
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "SixelParser.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+class SixelParserTests
+{
+    TEST_CLASS(SixelParserTests);
+
+    static RGBQUAD _PixelAt(const SixelParser& parser, const size_t x, const size_t y)
+    {
+        const auto width = parser.CellRowWidth();
+        const auto slice = parser.ReadCellRow(y / SixelParser::CellHeight);
+        return slice.at((y % SixelParser::CellHeight) * width + x);
+    }
+
+    TEST_METHOD(PaintsSixels)
+    {
+        SixelParser parser{ 0, true, 1000, 1000 };
+
+        Log::Comment(L"The default aspect ratio makes every dot two pixels high.");
+        parser.Parse(L"#2");
+        parser.Parse(L"!3A-@");
+        VERIFY_ARE_EQUAL(3u, parser.Width());
+        VERIFY_ARE_EQUAL(24u, parser.Height());
+        VERIFY_ARE_EQUAL(10u, parser.CellRowWidth());
+        VERIFY_ARE_EQUAL(2u, parser.CellRows());
+
+        Log::Comment(L"'A' paints the second dot, '@' the first one of the next band.");
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 2, 1).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 204 }, _PixelAt(parser, 2, 2).rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, _PixelAt(parser, 2, 3).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 2, 4).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, _PixelAt(parser, 0, 13).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 1, 13).rgbReserved);
+
+        Log::Comment(L"Anything right of or below the image is transparent.");
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 9, 2).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 0, 30).rgbReserved);
+    }
+
+    TEST_METHOD(DefinesColors)
+    {
+        SixelParser parser{ 9, true, 1000, 1000 };
+
+        Log::Comment(L"Colors are defined in percent of red, green and blue...");
+        parser.Parse(L"#20;2;100;0;50~");
+        auto pixel = _PixelAt(parser, 0, 0);
+        VERIFY_ARE_EQUAL(BYTE{ 255 }, pixel.rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, pixel.rgbGreen);
+        VERIFY_ARE_EQUAL(BYTE{ 128 }, pixel.rgbBlue);
+
+        Log::Comment(L"...or in hue, lightness and saturation, with blue at a hue of 0.");
+        parser.Parse(L"#21;1;0;50;100~#22;1;120;50;100~");
+        pixel = _PixelAt(parser, 1, 0);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, pixel.rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 255 }, pixel.rgbBlue);
+        pixel = _PixelAt(parser, 2, 0);
+        VERIFY_ARE_EQUAL(BYTE{ 255 }, pixel.rgbRed);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, pixel.rgbBlue);
+
+        Log::Comment(L"Selecting a defined color again paints with it.");
+        parser.Parse(L"#20~");
+        VERIFY_ARE_EQUAL(BYTE{ 128 }, _PixelAt(parser, 3, 0).rgbBlue);
+    }
+
+    TEST_METHOD(AppliesRasterAttributes)
+    {
+        Log::Comment(L"An opaque background fills the announced size with the first color.");
+        SixelParser parser{ 0, false, 1000, 1000 };
+        parser.Parse(L"\"1;1;15;30#1~");
+        VERIFY_ARE_EQUAL(15u, parser.Width());
+        VERIFY_ARE_EQUAL(30u, parser.Height());
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, _PixelAt(parser, 14, 29).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 14, 29).rgbBlue);
+
+        Log::Comment(L"The announced 1:1 aspect ratio makes the band six pixels high.");
+        VERIFY_ARE_EQUAL(BYTE{ 204 }, _PixelAt(parser, 0, 5).rgbBlue);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 0, 6).rgbBlue);
+    }
+
+    TEST_METHOD(ClipsToTheMaximumSize)
+    {
+        SixelParser parser{ 9, true, 25, 8 };
+        parser.Parse(L"!100~$-~");
+        VERIFY_ARE_EQUAL(25u, parser.Width());
+        VERIFY_ARE_EQUAL(8u, parser.Height());
+        VERIFY_ARE_EQUAL(30u, parser.CellRowWidth());
+        VERIFY_ARE_EQUAL(1u, parser.CellRows());
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, _PixelAt(parser, 0, 7).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, _PixelAt(parser, 24, 7).rgbReserved);
+    }
+};
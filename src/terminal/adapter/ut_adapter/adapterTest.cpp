@@ -98,6 +98,19 @@ public:
         return _setConsoleCursorPositionResult;
     }
 
+    bool PrivateGetViewportCursorPosition(COORD& position) const override
+    {
+        Log::Comment(L"PrivateGetViewportCursorPosition MOCK called...");
+
+        if (_getConsoleScreenBufferInfoExResult)
+        {
+            position = _cursorPos;
+            position.Y -= _viewport.Top;
+        }
+
+        return _getConsoleScreenBufferInfoExResult;
+    }
+
     bool SetConsoleWindowInfo(const bool absolute, const SMALL_RECT& window) override
     {
         Log::Comment(L"SetConsoleWindowInfo MOCK called...");
@@ -202,6 +215,8 @@ public:
     {
         Log::Comment(L"PrivateGetTextAttributes MOCK called...");
 
+        _privateGetTextAttributesCallCount++;
+
         if (_privateGetTextAttributesResult)
         {
             attrs = _attribute;
@@ -412,6 +427,13 @@ public:
         return _privateEnableAlternateScrollResult;
     }
 
+    bool PrivateSetSynchronizedOutput(const bool enabled) override
+    {
+        Log::Comment(L"PrivateSetSynchronizedOutput MOCK called...");
+        _synchronizedOutput = enabled;
+        return true;
+    }
+
     bool PrivateEraseAll() override
     {
         Log::Comment(L"PrivateEraseAll MOCK called...");
@@ -599,6 +621,7 @@ public:
         _setConsoleCursorPositionResult = TRUE;
         _getConsoleScreenBufferInfoExResult = TRUE;
         _privateGetTextAttributesResult = TRUE;
+        _privateGetTextAttributesCallCount = 0;
         _privateSetTextAttributesResult = TRUE;
         _privateWriteConsoleInputWResult = TRUE;
         _privateWriteConsoleControlInputResult = TRUE;
@@ -706,6 +729,24 @@ public:
         return TRUE;
     }
 
+    bool PrivateAddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) override
+    {
+        Log::Comment(L"PrivateAddMark MOCK called...");
+
+        _mark = { kind, exitCode };
+        return true;
+    }
+
+    bool PrivateWriteImageSlice(const til::size cellSize, const gsl::span<const RGBQUAD> pixels, const size_t pixelWidth) override
+    {
+        Log::Comment(L"PrivateWriteImageSlice MOCK called...");
+
+        VERIFY_ARE_EQUAL(cellSize, SixelParser::CellSize);
+        VERIFY_ARE_EQUAL(pixels.size(), pixelWidth * SixelParser::CellHeight);
+        _imageSlices.emplace_back(pixels.begin(), pixels.end());
+        return true;
+    }
+
     void _SetMarginsHelper(SMALL_RECT* rect, SHORT top, SHORT bottom)
     {
         rect->Top = top;
@@ -758,6 +799,7 @@ public:
     bool _getConsoleScreenBufferInfoExResult = false;
     bool _setConsoleCursorPositionResult = false;
     bool _privateGetTextAttributesResult = false;
+    mutable size_t _privateGetTextAttributesCallCount = 0;
     bool _privateSetTextAttributesResult = false;
     bool _privateWriteConsoleInputWResult = false;
     bool _privateWriteConsoleControlInputResult = false;
@@ -792,6 +834,9 @@ public:
     bool _privateEnableButtonEventMouseModeResult = false;
     bool _privateEnableAnyEventMouseModeResult = false;
     bool _privateEnableAlternateScrollResult = false;
+    std::optional<bool> _synchronizedOutput;
+    std::optional<std::pair<MarkKind, std::optional<unsigned int>>> _mark;
+    std::vector<std::vector<RGBQUAD>> _imageSlices;
     bool _setCursorStyleResult = false;
     CursorType _expectedCursorStyle;
     bool _setCursorColorResult = false;
@@ -1255,10 +1300,19 @@ public:
 
         _testGetSet->PrepData();
         _testGetSet->_privateSetTextAttributesResult = FALSE;
-        // Need at least one option in order for the call to be able to fail.
-        rgOptions[0] = (DispatchTypes::GraphicsOptions)0;
+        // Need at least one option that changes the attributes in order for the call to be able to fail.
+        rgOptions[0] = DispatchTypes::GraphicsOptions::Negative;
         cOptions = 1;
         VERIFY_IS_FALSE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Test 4: Don't set the attribute data when the options don't change it.");
+
+        _testGetSet->PrepData();
+        _testGetSet->_privateSetTextAttributesResult = FALSE;
+        rgOptions[0] = DispatchTypes::GraphicsOptions::Negative;
+        rgOptions[1] = DispatchTypes::GraphicsOptions::Positive;
+        cOptions = 2;
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
     }
 
     TEST_METHOD(GraphicsSingleTests)
@@ -1721,6 +1775,37 @@ public:
         VERIFY_IS_TRUE(_pDispatch->PopGraphicsRendition());
     }
 
+    TEST_METHOD(GraphicsPopOnlyFetchesAttributesToCombine)
+    {
+        Log::Comment(L"Starting test...");
+
+        _testGetSet->PrepData();
+
+        VTParameter rgStackOptions[16];
+        size_t cOptions = 0;
+
+        Log::Comment(L"Test 1: Popping an empty stack touches nothing");
+        _testGetSet->_privateGetTextAttributesCallCount = 0;
+        _testGetSet->_privateSetTextAttributesResult = FALSE;
+        VERIFY_IS_TRUE(_pDispatch->PopGraphicsRendition());
+        VERIFY_ARE_EQUAL(0u, _testGetSet->_privateGetTextAttributesCallCount);
+        _testGetSet->_privateSetTextAttributesResult = TRUE;
+
+        Log::Comment(L"Test 2: Popping a full save doesn't fetch the current attributes");
+        VERIFY_IS_TRUE(_pDispatch->PushGraphicsRendition({ rgStackOptions, cOptions }));
+        _testGetSet->_privateGetTextAttributesCallCount = 0;
+        VERIFY_IS_TRUE(_pDispatch->PopGraphicsRendition());
+        VERIFY_ARE_EQUAL(0u, _testGetSet->_privateGetTextAttributesCallCount);
+
+        Log::Comment(L"Test 3: Popping a partial save combines with the current attributes");
+        cOptions = 1;
+        rgStackOptions[0] = (size_t)DispatchTypes::SgrSaveRestoreStackOptions::Boldness;
+        VERIFY_IS_TRUE(_pDispatch->PushGraphicsRendition({ rgStackOptions, cOptions }));
+        _testGetSet->_privateGetTextAttributesCallCount = 0;
+        VERIFY_IS_TRUE(_pDispatch->PopGraphicsRendition());
+        VERIFY_ARE_EQUAL(1u, _testGetSet->_privateGetTextAttributesCallCount);
+    }
+
     TEST_METHOD(GraphicsPersistBrightnessTests)
     {
         Log::Comment(L"Starting test...");
@@ -2234,6 +2319,72 @@ public:
         VERIFY_IS_TRUE(_pDispatch.get()->EnableAlternateScroll(false));
     }
 
+    TEST_METHOD(SynchronizedOutputTest)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: The console holds back its own frames.");
+        VERIFY_IS_TRUE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+        VERIFY_IS_TRUE(_testGetSet->_synchronizedOutput.value_or(false));
+        VERIFY_IS_TRUE(_pDispatch.get()->ResetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+        VERIFY_IS_FALSE(_testGetSet->_synchronizedOutput.value_or(true));
+
+        Log::Comment(L"Test 2: A conpty leaves it to the connected terminal.");
+        _testGetSet->_synchronizedOutput.reset();
+        _testGetSet->_isPty = true;
+        VERIFY_IS_FALSE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+        VERIFY_IS_FALSE(_testGetSet->_synchronizedOutput.has_value());
+    }
+
+    TEST_METHOD(FinalTermMarkTest)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: The console marks its own buffer.");
+        VERIFY_IS_TRUE(_pDispatch.get()->AddMark(MarkKind::CommandFinished, 1u));
+        VERIFY_IS_TRUE(_testGetSet->_mark.has_value());
+        VERIFY_IS_TRUE(_testGetSet->_mark->first == MarkKind::CommandFinished);
+        VERIFY_ARE_EQUAL(1u, _testGetSet->_mark->second.value_or(0));
+
+        Log::Comment(L"Test 2: A conpty passes the marks through to the connected terminal.");
+        _testGetSet->_mark.reset();
+        _testGetSet->_isPty = true;
+        VERIFY_IS_FALSE(_pDispatch.get()->AddMark(MarkKind::Prompt, std::nullopt));
+        VERIFY_IS_FALSE(_testGetSet->_mark.has_value());
+    }
+
+    TEST_METHOD(SixelImageTest)
+    {
+        Log::Comment(L"Starting test...");
+        _testGetSet->PrepData();
+        _testGetSet->_privateLineFeedResult = true;
+        _testGetSet->_expectedLineFeedWithReturn = false;
+
+        Log::Comment(L"Test 1: The image is written a row at a time, once the string has ended.");
+        // With 1:1 dots, four bands of six are 24 pixels high, which takes two rows.
+        auto handler = _pDispatch.get()->DefineSixelImage(VTParameter{ 9 }, VTParameter{ 1 });
+        VERIFY_IS_TRUE(static_cast<bool>(handler));
+        VERIFY_IS_TRUE(handler(L"#1!12~-~-~-~"));
+        VERIFY_ARE_EQUAL(0u, _testGetSet->_imageSlices.size());
+        VERIFY_IS_TRUE(handler(L"\x1b"));
+        VERIFY_ARE_EQUAL(2u, _testGetSet->_imageSlices.size());
+
+        const auto& top = _testGetSet->_imageSlices.at(0);
+        const auto& bottom = _testGetSet->_imageSlices.at(1);
+        VERIFY_ARE_EQUAL(BYTE{ 204 }, top.at(0).rgbBlue);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, top.at(11).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, top.at(12).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, top.at(6 * 20 + 1).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0xff }, bottom.at(3 * 20).rgbReserved);
+        VERIFY_ARE_EQUAL(BYTE{ 0 }, bottom.at(4 * 20).rgbReserved);
+
+        Log::Comment(L"Test 2: A conpty can't pass images through to the connected terminal.");
+        _testGetSet->_imageSlices.clear();
+        _testGetSet->_isPty = true;
+        handler = _pDispatch.get()->DefineSixelImage(VTParameter{}, VTParameter{});
+        VERIFY_IS_FALSE(static_cast<bool>(handler));
+    }
+
     TEST_METHOD(Xterm256ColorTest)
     {
         Log::Comment(L"Starting test...");
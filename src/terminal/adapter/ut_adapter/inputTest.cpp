@@ -46,6 +46,7 @@ public:
     TEST_METHOD(TerminalInputNullKeyTests);
     TEST_METHOD(DifferentModifiersTest);
     TEST_METHOD(CtrlNumTest);
+    TEST_METHOD(Win32InputModeTest);
 
     wchar_t GetModifierChar(const bool fShift, const bool fAlt, const bool fCtrl)
     {
@@ -739,3 +740,40 @@ void InputTest::CtrlNumTest()
     s_expectedInput = L"9";
     TestKey(pInput, uiKeystate, vkey);
 }
+
+void InputTest::Win32InputModeTest()
+{
+    Log::Comment(L"Starting test...");
+
+    TerminalInput input{ s_TerminalInputTestNullCallback };
+    std::vector<std::wstring> written;
+    input.SetWriteSequenceCallback([&](const std::wstring_view sequence) {
+        written.emplace_back(sequence);
+    });
+    input.ChangeWin32InputMode(true);
+
+    Log::Comment(L"A single key is encoded with all of its fields.");
+    const KeyEvent key{ true, 1, 'A', 0x1e, L'a', SHIFT_PRESSED };
+    VERIFY_IS_TRUE(input.HandleKey(&key));
+    VERIFY_ARE_EQUAL(size_t{ 1 }, written.size());
+    VERIFY_ARE_EQUAL(String(L"\x1b[65;30;97;1;16;1_"), String(written.back().c_str()));
+
+    Log::Comment(L"A batch of keys is sent with a single write, and repeated presses are merged.");
+    written.clear();
+    const std::array<KeyEvent, 5> keys{
+        KeyEvent{ true, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ true, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ true, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ false, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ true, 1, 'A', 0x1e, L'A', SHIFT_PRESSED },
+    };
+    VERIFY_IS_TRUE(input.HandleKeys(keys));
+    VERIFY_ARE_EQUAL(size_t{ 1 }, written.size());
+    VERIFY_ARE_EQUAL(String(L"\x1b[65;30;97;1;0;3_\x1b[65;30;97;0;0;1_\x1b[65;30;65;1;16;1_"), String(written.back().c_str()));
+
+    Log::Comment(L"The largest sequence fits into the encoder's buffer.");
+    written.clear();
+    const KeyEvent largest{ true, 65535, 65535, 65535, L'\xffff', 0xffffffff };
+    VERIFY_IS_TRUE(input.HandleKey(&largest));
+    VERIFY_ARE_EQUAL(String(L"\x1b[65535;65535;65535;1;4294967295;65535_"), String(written.back().c_str()));
+}
@@ -499,6 +499,59 @@ static bool _translateDefaultMapping(const KeyEvent& keyEvent,
     return match.has_value();
 }
 
+// Routine Description:
+// - Sends the given key events to the shell, like HandleKey does for each of them.
+// - In win32-input-mode, they're all encoded into a single write. Runs of the
+//   same key press, like the autorepeat of a held key, are merged into a single
+//   sequence, with the repeat counts of the presses added up.
+// Arguments:
+// - keys - Key events to translate
+// Return Value:
+// - True if any of the events was handled.
+bool TerminalInput::HandleKeys(const gsl::span<const KeyEvent> keys)
+{
+    if (!_win32InputMode || _forceDisableWin32InputMode)
+    {
+        bool handled = false;
+        for (const auto& key : keys)
+        {
+            handled = HandleKey(&key) || handled;
+        }
+        return handled;
+    }
+
+    _win32Sequences.clear();
+    Win32KeySequence buffer;
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        auto key = *it;
+        size_t repeatCount = key.GetRepeatCount();
+        for (++it; it != keys.end() && _IsRepeatOf(key, *it) && repeatCount + it->GetRepeatCount() <= USHRT_MAX; ++it)
+        {
+            repeatCount += it->GetRepeatCount();
+        }
+        key.SetRepeatCount(gsl::narrow_cast<WORD>(repeatCount));
+        _win32Sequences.append(_GenerateWin32KeySequence(key, buffer));
+    }
+
+    _SendInputSequence(_win32Sequences);
+    return !keys.empty();
+}
+
+// Routine Description:
+// - Sets a callback that receives the input sequences as they are, instead of
+//   the key events that they're turned into for the callback given to the
+//   constructor. Terminals that write the sequences to a pipe use it, so that
+//   they don't have to turn the key events back into text.
+// Arguments:
+// - pfn - The callback, or nullptr to send key events again.
+// Return Value:
+// - <none>
+void TerminalInput::SetWriteSequenceCallback(std::function<void(const std::wstring_view)> pfn) noexcept
+{
+    _pfnWriteSequence = std::move(pfn);
+}
+
 // Routine Description:
 // - Sends the given input event to the shell.
 // - The caller should attempt to fill the char data in pInEvent if possible.
@@ -532,8 +585,8 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        Win32KeySequence buffer;
+        _SendInputSequence(_GenerateWin32KeySequence(keyEvent, buffer));
         return true;
     }
 
@@ -749,6 +802,12 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     {
         try
         {
+            if (_pfnWriteSequence)
+            {
+                _pfnWriteSequence(sequence);
+                return;
+            }
+
             std::deque<std::unique_ptr<IInputEvent>> inputEvents;
             for (const auto& wch : sequence)
             {
@@ -764,12 +823,15 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
 }
 
 // Method Description:
-// - Synthesize a win32-input-mode sequence for the given keyevent.
+// - Synthesize a win32-input-mode sequence for the given keyevent. The sequence
+//   is formatted into the given buffer, so that keys can be sent without
+//   allocating.
 // Arguments:
 // - key: the KeyEvent to serialize.
+// - buffer: the storage for the sequence.
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - the formatted string representation of this key, backed by buffer
+std::wstring_view TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key, Win32KeySequence& buffer)
 {
     // Sequences are formatted as follows:
     //
@@ -782,11 +844,33 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    const auto result = fmt::format_to_n(buffer.data(),
+                                         buffer.size(),
+                                         FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
+                                         key.GetVirtualKeyCode(),
+                                         key.GetVirtualScanCode(),
+                                         static_cast<int>(key.GetCharData()),
+                                         key.IsKeyDown() ? 1 : 0,
+                                         key.GetActiveModifierKeys(),
+                                         key.GetRepeatCount());
+    return { buffer.data(), std::min(result.size, buffer.size()) };
+}
+
+// Method Description:
+// - Checks whether the next key event is another press of the same key with the
+//   same modifiers, which can be sent along with the key by adding to its
+//   repeat count.
+// Arguments:
+// - key: the key press.
+// - next: the key event that follows it.
+// Return Value:
+// - true if next repeats key.
+bool TerminalInput::_IsRepeatOf(const KeyEvent& key, const KeyEvent& next) noexcept
+{
+    return key.IsKeyDown() &&
+           next.IsKeyDown() &&
+           key.GetVirtualKeyCode() == next.GetVirtualKeyCode() &&
+           key.GetVirtualScanCode() == next.GetVirtualScanCode() &&
+           key.GetCharData() == next.GetCharData() &&
+           key.GetActiveModifierKeys() == next.GetActiveModifierKeys();
 }
@@ -34,6 +34,8 @@ namespace Microsoft::Console::VirtualTerminal
         ~TerminalInput() = default;
 
         bool HandleKey(const IInputEvent* const pInEvent);
+        bool HandleKeys(const gsl::span<const KeyEvent> keys);
+        void SetWriteSequenceCallback(std::function<void(const std::wstring_view)> pfn) noexcept;
         void ChangeAnsiMode(const bool ansiMode) noexcept;
         void ChangeKeypadMode(const bool applicationMode) noexcept;
         void ChangeCursorKeysMode(const bool applicationMode) noexcept;
@@ -76,6 +78,7 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteEvents;
+        std::function<void(const std::wstring_view)> _pfnWriteSequence;
 
         // storage location for the leading surrogate of a utf-16 surrogate pair
         std::optional<wchar_t> _leadingSurrogate;
@@ -86,11 +89,16 @@ namespace Microsoft::Console::VirtualTerminal
         bool _win32InputMode{ false };
         bool _forceDisableWin32InputMode{ false };
 
+        // A win32-input-mode sequence is at most "\x1b[65535;65535;65535;1;4294967295;65535_".
+        using Win32KeySequence = std::array<wchar_t, 48>;
+        std::wstring _win32Sequences;
+
         void _SendChar(const wchar_t ch);
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(const std::wstring_view sequence) const noexcept;
         void _SendEscapedInputSequence(const wchar_t wch) const;
-        static std::wstring _GenerateWin32KeySequence(const KeyEvent& key);
+        static std::wstring_view _GenerateWin32KeySequence(const KeyEvent& key, Win32KeySequence& buffer);
+        static bool _IsRepeatOf(const KeyEvent& key, const KeyEvent& next) noexcept;
 
 #pragma region MouseInputState Management
         // These methods are defined in mouseInputState.cpp
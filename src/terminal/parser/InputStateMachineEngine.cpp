@@ -362,6 +362,25 @@ bool InputStateMachineEngine::ActionVt52EscDispatch(const VTID /*id*/, const VTP
 // - true iff we successfully dispatched the sequence.
 bool InputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParameters parameters)
 {
+    // The text of a bracketed paste is written to the input in batches,
+    // instead of a write per key. The brackets themselves are handled as
+    // they always were below, in the batch like the text they surround.
+    const auto genericIdentifier = id == CsiActionCodes::Generic ? parameters.at(0).value_or(0) : 0;
+    if (genericIdentifier == static_cast<size_t>(GenericKeyIdentifiers::BracketedPasteStart))
+    {
+        _pDispatch->BeginInputBatch();
+    }
+    auto endPaste = wil::scope_exit([&]() noexcept {
+        if (genericIdentifier == static_cast<size_t>(GenericKeyIdentifiers::BracketedPasteEnd))
+        {
+            try
+            {
+                LOG_HR_IF(E_FAIL, !_pDispatch->EndInputBatch());
+            }
+            CATCH_LOG();
+        }
+    });
+
     // GH#4999 - If the client was in VT input mode, but we received a
     // win32-input-mode sequence, then _don't_ passthrough the sequence to the
     // client. It's impossibly unlikely that the client actually wanted
@@ -108,6 +108,9 @@ namespace Microsoft::Console::VirtualTerminal
         F10 = 21,
         F11 = 23,
         F12 = 24,
+        // Not keys, but the brackets around a paste (see DECSET 2004).
+        BracketedPasteStart = 200,
+        BracketedPasteEnd = 201,
     };
 
     enum class Ss3ActionCodes : wchar_t
@@ -427,6 +427,42 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
 {
     bool success = false;
 
+    // SGR is by far the most frequent sequence in colored output, so it's
+    // dispatched ahead of the switch, which has to search through the
+    // (sparse) IDs of every other sequence to find it.
+    if (id == CsiActionCodes::SGR_SetGraphicsRendition)
+    {
+        success = _dispatch->SetGraphicsRendition(parameters);
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::SGR);
+    }
+    else
+    {
+        success = _DispatchControlSequence(id, parameters);
+    }
+
+    // If we were unable to process the string, and there's a TTY attached to us,
+    //      trigger the state machine to flush the string to the terminal.
+    if (_pfnFlushToTerminal != nullptr && !success)
+    {
+        success = _pfnFlushToTerminal();
+    }
+
+    _ClearLastChar();
+
+    return success;
+}
+
+// Routine Description:
+// - Dispatches all of the control sequences other than SGR. See ActionCsiDispatch.
+// Arguments:
+// - id - Identifier of the control sequence to dispatch.
+// - parameters - set of numeric parameters collected while parsing the sequence.
+// Return Value:
+// - true iff we successfully dispatched the sequence.
+bool OutputStateMachineEngine::_DispatchControlSequence(const VTID id, const VTParameters parameters)
+{
+    bool success = false;
+
     switch (id)
     {
     case CsiActionCodes::CUU_CursorUp:
@@ -512,10 +548,6 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
         });
         TermTelemetry::Instance().Log(TermTelemetry::Codes::DECRST);
         break;
-    case CsiActionCodes::SGR_SetGraphicsRendition:
-        success = _dispatch->SetGraphicsRendition(parameters);
-        TermTelemetry::Instance().Log(TermTelemetry::Codes::SGR);
-        break;
     case CsiActionCodes::DSR_DeviceStatusReport:
         success = _dispatch->DeviceStatusReport(parameters.at(0));
         TermTelemetry::Instance().Log(TermTelemetry::Codes::DSR);
@@ -624,15 +656,6 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
         break;
     }
 
-    // If we were unable to process the string, and there's a TTY attached to us,
-    //      trigger the state machine to flush the string to the terminal.
-    if (_pfnFlushToTerminal != nullptr && !success)
-    {
-        success = _pfnFlushToTerminal();
-    }
-
-    _ClearLastChar();
-
     return success;
 }
 
@@ -645,10 +668,19 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
 // - parameters - set of numeric parameters collected while parsing the sequence.
 // Return Value:
 // - the data string handler function or nullptr if the sequence is not supported
-IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionDcsDispatch(const VTID /*id*/, const VTParameters /*parameters*/) noexcept
+IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionDcsDispatch(const VTID id, const VTParameters parameters) noexcept
 {
     StringHandler handler = nullptr;
 
+    switch (id)
+    {
+    case DcsActionCodes::DECSIXEL_DefineImage:
+        handler = _dispatch->DefineSixelImage(parameters.at(0), parameters.at(1));
+        break;
+    default:
+        break;
+    }
+
     _ClearLastChar();
 
     return handler;
@@ -808,6 +840,14 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
         success = _dispatch->DoConEmuAction(string);
         break;
     }
+    case OscActionCodes::FinalTermAction:
+    {
+        MarkKind kind{};
+        std::optional<unsigned int> exitCode;
+        success = _GetOscFinalTermAction(string, kind, exitCode);
+        success = success && _dispatch->AddMark(kind, exitCode);
+        break;
+    }
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -1099,6 +1139,54 @@ bool OutputStateMachineEngine::_GetOscSetClipboard(const std::wstring_view strin
     return false;
 }
 
+// Routine Description:
+// - Parse the FinalTerm shell integration marks with the format `Pk[;Pe]`.
+//   `Pk` is A where the prompt starts, B where the command starts, C where
+//   its output starts and D where it finished. For D, `Pe` is the exit code
+//   of the command, if the shell knows it. Further parameters, like the
+//   `cl=m` of `A;cl=m`, are ignored.
+// Arguments:
+// - string - Osc String input.
+// - kind - Receives what the mark marks.
+// - exitCode - Receives the exit code of the command, if there is one.
+// Return Value:
+// - True if the string was one of the four marks.
+bool OutputStateMachineEngine::_GetOscFinalTermAction(const std::wstring_view string,
+                                                      MarkKind& kind,
+                                                      std::optional<unsigned int>& exitCode) const
+{
+    const auto parts = Utils::SplitString(string, L';');
+    if (parts.empty() || til::at(parts, 0).size() != 1)
+    {
+        return false;
+    }
+
+    switch (til::at(parts, 0).front())
+    {
+    case L'A':
+        kind = MarkKind::Prompt;
+        return true;
+    case L'B':
+        kind = MarkKind::Command;
+        return true;
+    case L'C':
+        kind = MarkKind::Output;
+        return true;
+    case L'D':
+    {
+        kind = MarkKind::CommandFinished;
+        unsigned int value = 0;
+        if (parts.size() >= 2 && Utils::StringToUint(til::at(parts, 1), value))
+        {
+            exitCode = value;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 // Method Description:
 // - Clears our last stored character. The last stored character is the last
 //      graphical character we printed, which is reset if any other action is
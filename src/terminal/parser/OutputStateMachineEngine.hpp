@@ -144,6 +144,11 @@ namespace Microsoft::Console::VirtualTerminal
             DECSCPP_SetColumnsPerPage = VTID("$|"),
         };
 
+        enum DcsActionCodes : uint64_t
+        {
+            DECSIXEL_DefineImage = VTID("q"),
+        };
+
         enum Vt52ActionCodes : uint64_t
         {
             CursorUp = VTID("A"),
@@ -178,9 +183,12 @@ namespace Microsoft::Console::VirtualTerminal
             SetClipboard = 52,
             ResetForegroundColor = 110, // Not implemented
             ResetBackgroundColor = 111, // Not implemented
-            ResetCursorColor = 112
+            ResetCursorColor = 112,
+            FinalTermAction = 133
         };
 
+        bool _DispatchControlSequence(const VTID id, const VTParameters parameters);
+
         bool _GetOscTitle(const std::wstring_view string,
                           std::wstring& title) const;
 
@@ -195,6 +203,10 @@ namespace Microsoft::Console::VirtualTerminal
                                  std::wstring& content,
                                  bool& queryClipboard) const noexcept;
 
+        bool _GetOscFinalTermAction(const std::wstring_view string,
+                                    MarkKind& kind,
+                                    std::optional<unsigned int>& exitCode) const;
+
         static constexpr std::wstring_view hyperlinkIDParameter{ L"id=" };
         bool _ParseHyperlink(const std::wstring_view string,
                              std::wstring& params,
@@ -41,6 +41,10 @@ static std::string GenerateOscColorTableToken();
 static std::string GenerateVt52Token();
 static std::string GenerateVt52CursorAddressToken();
 static std::string GenerateOscHyperlinkToken();
+static std::string GenerateManyParametersToken();
+static std::string GenerateLongCombiningToken();
+static std::string GenerateGiantOscToken();
+static std::string GenerateScrollMarginChurnToken();
 
 const fuzz::_fuzz_type_entry<BYTE> g_repeatMap[] = {
     { 4, [](BYTE) { return CFuzzChance::GetRandom<BYTE>(2, 0xF); } },
@@ -67,6 +71,16 @@ const std::function<std::string()> g_tokenGenerators[] = {
     GenerateOscHyperlinkToken
 };
 
+// Inputs that are valid, but expensive for their size. These make up the
+// files generated for the throughput mode of the conhost fuzzer, which
+// looks for inputs that make the terminal crawl instead of crash.
+const std::function<std::string()> g_slowTokenGenerators[] = {
+    GenerateManyParametersToken,
+    GenerateLongCombiningToken,
+    GenerateGiantOscToken,
+    GenerateScrollMarginChurnToken
+};
+
 std::string GenerateTokenLowProbability()
 {
     const _fuzz_type_entry<std::string> tokenGeneratorMap[] = {
@@ -602,13 +616,73 @@ std::string GenerateOscHyperlinkToken()
     return GenerateFuzzedOscToken(FUZZ_MAP(map), tokens, ARRAYSIZE(tokens));
 }
 
+// A CSI sequence with thousands of parameters, far more than are ever used.
+std::string GenerateManyParametersToken()
+{
+    const LPSTR tokens[] = { "m", "H", "r", "J", "h", "l" };
+    std::string s(CSI);
+    const auto count = CFuzzChance::GetRandom<USHORT>(256, 0x4000);
+    for (USHORT i = 0; i < count; i++)
+    {
+        AppendFormat(s, "%d;", CFuzzChance::GetRandom<BYTE>());
+    }
+    s += CFuzzChance::SelectOne(tokens, ARRAYSIZE(tokens));
+    return s;
+}
+
+// Letters with long runs of combining marks (U+0301 and U+0336), which
+// have to be stored out of line and are carried along when lines wrap.
+std::string GenerateLongCombiningToken()
+{
+    const LPSTR marks[] = { "\xcc\x81", "\xcc\xb6" };
+    std::string s;
+    const auto letters = CFuzzChance::GetRandom<USHORT>(80, 2000);
+    for (USHORT i = 0; i < letters; i++)
+    {
+        AppendFormat(s, "%c", CFuzzChance::GetRandom<BYTE>('a', 'z'));
+        const auto count = CFuzzChance::GetRandom<BYTE>(1, 64);
+        for (BYTE j = 0; j < count; j++)
+        {
+            s += CFuzzChance::SelectOne(marks, ARRAYSIZE(marks));
+        }
+    }
+    return s;
+}
+
+// An OSC title or hyperlink with a string of up to a megabyte.
+std::string GenerateGiantOscToken()
+{
+    const LPSTR prefixes[] = { "0;", "2;", "8;;" };
+    std::string s(OSC);
+    s += CFuzzChance::SelectOne(prefixes, ARRAYSIZE(prefixes));
+    s.append(CFuzzChance::GetRandom<ULONG>(0x10000, 0x100000), 'x');
+    s += "\x7";
+    return s;
+}
+
+// Scroll margins that are set over and over, each time followed by
+// scrolling and line feeds within them.
+std::string GenerateScrollMarginChurnToken()
+{
+    std::string s;
+    const auto count = CFuzzChance::GetRandom<USHORT>(64, 4096);
+    for (USHORT i = 0; i < count; i++)
+    {
+        const auto top = CFuzzChance::GetRandom<BYTE>(1, 20);
+        AppendFormat(s, "%s%d;%dr", CSI, top, top + CFuzzChance::GetRandom<BYTE>(1, 20));
+        AppendFormat(s, "%s%dS\n\n%s%dT", CSI, CFuzzChance::GetRandom<BYTE>(1, 10), CSI, CFuzzChance::GetRandom<BYTE>(1, 10));
+    }
+    return s;
+}
+
 int __cdecl wmain(int argc, WCHAR* argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && !(argc == 4 && wcscmp(argv[3], L"slow") == 0))
     {
-        wprintf(L"Usage: <file count> <output directory>");
+        wprintf(L"Usage: <file count> <output directory> [slow]");
         return -1;
     }
+    const auto slow = argc == 4;
 
     HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
     if (SUCCEEDED(hr))
@@ -634,7 +708,16 @@ int __cdecl wmain(int argc, WCHAR* argv[])
                 std::string text;
                 for (int j = 0; j < CFuzzChance::GetRandom<BYTE>(); j++)
                 {
-                    text.append(GenerateToken());
+                    // The slow files are mostly regular output, so that the
+                    // expensive parts have something to be compared to.
+                    if (slow && CFuzzChance::GetRandom<BYTE>(0, 9) == 0)
+                    {
+                        text.append(CFuzzChance::SelectOne(g_slowTokenGenerators, ARRAYSIZE(g_slowTokenGenerators))());
+                    }
+                    else
+                    {
+                        text.append(GenerateToken());
+                    }
                 }
 
                 wil::com_ptr<IStream> spStream;
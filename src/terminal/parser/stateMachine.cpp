@@ -7,6 +7,10 @@
 
 #include "ascii.hpp"
 
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#endif
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -18,9 +22,12 @@ StateMachine::StateMachine(std::unique_ptr<IStateMachineEngine> engine) :
     _parameters{},
     _parameterLimitReached(false),
     _oscString{},
-    _cachedSequence{ std::nullopt },
+    _cachedSequence{},
+    _scratchAllocations{ 0 },
     _processingIndividually(false)
 {
+    _oscString.reserve(s_scratchCapacity);
+    _cachedSequence.reserve(s_scratchCapacity);
     _ActionClear();
 }
 
@@ -188,30 +195,6 @@ static constexpr bool _isCsiInvalid(const wchar_t wch) noexcept
     return wch == L':'; // 0x3A
 }
 
-// Routine Description:
-// - Determines if a character is an invalid intermediate.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isIntermediateInvalid(const wchar_t wch) noexcept
-{
-    // 0x30 - 0x3F
-    return _isNumericParamValue(wch) || _isCsiInvalid(wch) || _isParameterDelimiter(wch) || _isCsiPrivateMarker(wch);
-}
-
-// Routine Description:
-// - Determines if a character is an invalid parameter.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isParameterInvalid(const wchar_t wch) noexcept
-{
-    // 0x3A, 0x3C - 0x3F
-    return _isCsiInvalid(wch) || _isCsiPrivateMarker(wch);
-}
-
 // Routine Description:
 // - Determines if a character is a string terminator indicator.
 // Arguments:
@@ -374,6 +357,90 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 
 #pragma warning(pop)
 
+// Routine Description:
+// - Finds the first character at or after the given offset that is actionable
+//   from the ground state (see _isActionableFromGround). Everything before it
+//   can be handed to the engine as a single printable run.
+// - On x86/x64 this checks 8 characters at a time with SSE2, which is part of
+//   the baseline for both architectures. Other architectures and the tail of
+//   the string fall back to the scalar check.
+// Arguments:
+// - string - The string to scan.
+// - offset - The index to start scanning at.
+// Return Value:
+// - The index of the first actionable character, or string.size() if there is none.
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead.
+#pragma warning(disable : 26490) // Don't use reinterpret_cast.
+static size_t _findActionableFromGround(const std::wstring_view string, const size_t offset) noexcept
+{
+    const auto end = string.data() + string.size();
+    auto begin = string.data() + std::min(offset, string.size());
+
+#if defined(_M_X64) || defined(_M_IX86)
+    // Actionable characters are 0x00-0x1F, 0x7F and 0x80-0x9F. SSE2 has no
+    // unsigned 16-bit comparison, but a saturating subtraction of 0x1F yields
+    // zero exactly for the values that are less than or equal to 0x1F.
+    // Shifting by 0x80 first (with wrap-around) maps the C1 range onto that.
+    const auto c0Max = _mm_set1_epi16(AsciiChars::US);
+    const auto c1Min = _mm_set1_epi16(0x80);
+    const auto del = _mm_set1_epi16(AsciiChars::DEL);
+    const auto zero = _mm_setzero_si128();
+
+    for (; end - begin >= 8; begin += 8)
+    {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const auto isC0 = _mm_cmpeq_epi16(_mm_subs_epu16(chars, c0Max), zero);
+        const auto isC1 = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, c1Min), c0Max), zero);
+        const auto isDel = _mm_cmpeq_epi16(chars, del);
+        const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isC0, isC1), isDel)));
+        if (mask != 0)
+        {
+            // The mask has 2 bits per wchar_t.
+            unsigned long index = 0;
+            _BitScanForward(&index, mask);
+            begin += index / 2;
+            return static_cast<size_t>(begin - string.data());
+        }
+    }
+#endif
+
+    for (; begin != end; ++begin)
+    {
+        if (_isActionableFromGround(*begin))
+        {
+            break;
+        }
+    }
+    return static_cast<size_t>(begin - string.data());
+}
+#pragma warning(pop)
+
+// Routine Description:
+// - Finds the end of the run of characters, starting at offset, that can be
+//   handed to a DCS string handler as they are. That's everything up to the
+//   first character that terminates the string (CAN, SUB and ESC), is a C1
+//   control, or would be ignored.
+// Arguments:
+// - string - The string to scan.
+// - offset - The index to start scanning at.
+// Return Value:
+// - The index of the first character that isn't part of the run.
+static size_t _findEndOfDcsPassThrough(const std::wstring_view string, const size_t offset) noexcept
+{
+    auto end = offset;
+    while (end < string.size())
+    {
+        const auto wch = til::at(string, end);
+        if (!_isC0Code(wch) && !_isDcsPassThroughValid(wch))
+        {
+            break;
+        }
+        ++end;
+    }
+    return end;
+}
+
 // Routine Description:
 // - Triggers the Execute action to indicate that the listener should immediately respond to a C0 control character.
 // Arguments:
@@ -606,7 +673,8 @@ void StateMachine::_ActionInterrupt()
     if (_state == VTStates::DcsPassThrough)
     {
         // The ESC signals the end of the data string.
-        _dcsStringHandler(AsciiChars::ESC);
+        static constexpr wchar_t esc = AsciiChars::ESC;
+        _dcsStringHandler({ &esc, 1 });
         _dcsStringHandler = nullptr;
     }
 }
@@ -634,9 +702,30 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscPut");
 
+    if (_oscString.size() == _oscString.capacity())
+    {
+        ++_scratchAllocations;
+    }
     _oscString.push_back(wch);
 }
 
+// Routine Description:
+// - Stores a run of characters as part of the OSC string
+// Arguments:
+// - string - Characters to store. None of them may end the string or be ignored.
+// Return Value:
+// - <none>
+void StateMachine::_ActionOscPutString(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"OscPut");
+
+    if (_oscString.size() + string.size() > _oscString.capacity())
+    {
+        ++_scratchAllocations;
+    }
+    _oscString.append(string);
+}
+
 // Routine Description:
 // - Triggers the CsiDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -716,6 +805,23 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
     }
 }
 
+// Routine Description:
+// - Hands a run of characters from a DCS data string to the string handler
+//   that was returned by the dispatch. If the handler fails, the rest of the
+//   string is ignored.
+// Arguments:
+// - string - The characters to pass through.
+// Return Value:
+// - <none>
+void StateMachine::_ActionDcsPassThrough(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"DcsPassThrough");
+    if (!_dcsStringHandler(string))
+    {
+        _EnterDcsIgnore();
+    }
+}
+
 // Routine Description:
 // - Moves the state machine into the Ground state.
 //   This state is entered:
@@ -728,7 +834,7 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 void StateMachine::_EnterGround() noexcept
 {
     _state = VTStates::Ground;
-    _cachedSequence.reset(); // entering ground means we've completed the pending sequence
+    _cachedSequence.clear(); // entering ground means we've completed the pending sequence
     _trace.TraceStateChange(L"Ground");
 }
 
@@ -1146,174 +1252,261 @@ void StateMachine::_EventEscapeIntermediate(const wchar_t wch)
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiEntry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Collect Control Sequence Private markers
-//   7. Dispatch a control sequence with parameters for action
+// - Determines the class of a character for the sequence table.
 // Arguments:
-// - wch - Character that triggered the event
+// - wch - Character to classify.
 // Return Value:
-// - <none>
-void StateMachine::_EventCsiEntry(const wchar_t wch)
+// - The class of the character.
+constexpr StateMachine::CharClass StateMachine::_ClassifyCharacter(const wchar_t wch) noexcept
 {
-    _trace.TraceOnEvent(L"CsiEntry");
     if (_isC0Code(wch))
     {
-        _ActionExecute(wch);
+        return CharClass::C0;
     }
-    else if (_isDelete(wch))
+    if (_isIntermediate(wch))
     {
-        _ActionIgnore();
+        return CharClass::Intermediate;
     }
-    else if (_isIntermediate(wch))
+    if (_isNumericParamValue(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
+        return CharClass::Digit;
     }
-    else if (_isCsiInvalid(wch))
+    if (_isCsiInvalid(wch))
     {
-        _EnterCsiIgnore();
+        return CharClass::Colon;
     }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
+    if (_isParameterDelimiter(wch))
     {
-        _ActionParam(wch);
-        _EnterCsiParam();
+        return CharClass::Delimiter;
     }
-    else if (_isCsiPrivateMarker(wch))
+    if (_isCsiPrivateMarker(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiParam();
+        return CharClass::PrivateMarker;
     }
-    else
+    if (_isDelete(wch))
     {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
+        return CharClass::Delete;
     }
+    return CharClass::Final;
 }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Dispatch a control sequence with parameters for action
+#pragma warning(push)
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator.
+#pragma warning(disable : 26482) // Only index into arrays using constant expressions.
+
+// Routine Description:
+// - Generates the transitions of the CSI, SS3 and DCS states for every class of
+//   character. See _EventSequence.
+//   In all of these states:
+//   1. C0 control characters are executed, except in DCS sequences, which ignore them
+//   2. Delete characters are ignored
+//   3. Parameter data is accumulated while in the entry or parameter states
+//   4. Intermediate characters are collected
+//   5. Invalid characters ignore the remainder of the sequence
+//   6. Final characters dispatch the sequence
+// Arguments:
+// - <none>
+// Return Value:
+// - The table of transitions, indexed by state and character class.
+constexpr StateMachine::SequenceTable StateMachine::_BuildSequenceTable() noexcept
+{
+    SequenceTable table{};
+
+    const auto set = [&](const VTStates state, const CharClass charClass, const SequenceAction action, const VTStates next) {
+        table[static_cast<size_t>(state)][static_cast<size_t>(charClass)] = { action, next };
+    };
+    const auto stay = [&](const VTStates state, const CharClass charClass, const SequenceAction action) {
+        set(state, charClass, action, state);
+    };
+
+    for (const auto state : { VTStates::CsiEntry, VTStates::CsiIntermediate, VTStates::CsiIgnore, VTStates::CsiParam, VTStates::Ss3Entry, VTStates::Ss3Param })
+    {
+        stay(state, CharClass::C0, SequenceAction::Execute);
+        stay(state, CharClass::Delete, SequenceAction::Ignore);
+    }
+    for (const auto state : { VTStates::DcsEntry, VTStates::DcsIntermediate, VTStates::DcsParam })
+    {
+        stay(state, CharClass::C0, SequenceAction::Ignore);
+        stay(state, CharClass::Delete, SequenceAction::Ignore);
+    }
+
+    set(VTStates::CsiEntry, CharClass::Intermediate, SequenceAction::Collect, VTStates::CsiIntermediate);
+    set(VTStates::CsiEntry, CharClass::Digit, SequenceAction::Param, VTStates::CsiParam);
+    set(VTStates::CsiEntry, CharClass::Colon, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiEntry, CharClass::Delimiter, SequenceAction::Param, VTStates::CsiParam);
+    set(VTStates::CsiEntry, CharClass::PrivateMarker, SequenceAction::Collect, VTStates::CsiParam);
+    set(VTStates::CsiEntry, CharClass::Final, SequenceAction::CsiDispatch, VTStates::Ground);
+
+    stay(VTStates::CsiIntermediate, CharClass::Intermediate, SequenceAction::Collect);
+    set(VTStates::CsiIntermediate, CharClass::Digit, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiIntermediate, CharClass::Colon, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiIntermediate, CharClass::Delimiter, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiIntermediate, CharClass::PrivateMarker, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiIntermediate, CharClass::Final, SequenceAction::CsiDispatch, VTStates::Ground);
+
+    stay(VTStates::CsiIgnore, CharClass::Intermediate, SequenceAction::Ignore);
+    stay(VTStates::CsiIgnore, CharClass::Digit, SequenceAction::Ignore);
+    stay(VTStates::CsiIgnore, CharClass::Colon, SequenceAction::Ignore);
+    stay(VTStates::CsiIgnore, CharClass::Delimiter, SequenceAction::Ignore);
+    stay(VTStates::CsiIgnore, CharClass::PrivateMarker, SequenceAction::Ignore);
+    set(VTStates::CsiIgnore, CharClass::Final, SequenceAction::None, VTStates::Ground);
+
+    set(VTStates::CsiParam, CharClass::Intermediate, SequenceAction::Collect, VTStates::CsiIntermediate);
+    stay(VTStates::CsiParam, CharClass::Digit, SequenceAction::Param);
+    set(VTStates::CsiParam, CharClass::Colon, SequenceAction::None, VTStates::CsiIgnore);
+    stay(VTStates::CsiParam, CharClass::Delimiter, SequenceAction::Param);
+    set(VTStates::CsiParam, CharClass::PrivateMarker, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::CsiParam, CharClass::Final, SequenceAction::CsiDispatch, VTStates::Ground);
+
+    // SS3 sequences are structurally the same as CSI sequences, just with a
+    // different initiation. Both of them ignore characters the same way.
+    set(VTStates::Ss3Entry, CharClass::Intermediate, SequenceAction::Ss3Dispatch, VTStates::Ground);
+    set(VTStates::Ss3Entry, CharClass::Digit, SequenceAction::Param, VTStates::Ss3Param);
+    set(VTStates::Ss3Entry, CharClass::Colon, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::Ss3Entry, CharClass::Delimiter, SequenceAction::Param, VTStates::Ss3Param);
+    set(VTStates::Ss3Entry, CharClass::PrivateMarker, SequenceAction::Ss3Dispatch, VTStates::Ground);
+    set(VTStates::Ss3Entry, CharClass::Final, SequenceAction::Ss3Dispatch, VTStates::Ground);
+
+    set(VTStates::Ss3Param, CharClass::Intermediate, SequenceAction::Ss3Dispatch, VTStates::Ground);
+    stay(VTStates::Ss3Param, CharClass::Digit, SequenceAction::Param);
+    set(VTStates::Ss3Param, CharClass::Colon, SequenceAction::None, VTStates::CsiIgnore);
+    stay(VTStates::Ss3Param, CharClass::Delimiter, SequenceAction::Param);
+    set(VTStates::Ss3Param, CharClass::PrivateMarker, SequenceAction::None, VTStates::CsiIgnore);
+    set(VTStates::Ss3Param, CharClass::Final, SequenceAction::Ss3Dispatch, VTStates::Ground);
+
+    // A DCS dispatch moves into the DcsPassThrough or DcsIgnore state itself.
+    set(VTStates::DcsEntry, CharClass::Intermediate, SequenceAction::Collect, VTStates::DcsIntermediate);
+    set(VTStates::DcsEntry, CharClass::Digit, SequenceAction::Param, VTStates::DcsParam);
+    set(VTStates::DcsEntry, CharClass::Colon, SequenceAction::None, VTStates::DcsIgnore);
+    set(VTStates::DcsEntry, CharClass::Delimiter, SequenceAction::Param, VTStates::DcsParam);
+    stay(VTStates::DcsEntry, CharClass::PrivateMarker, SequenceAction::DcsDispatch);
+    stay(VTStates::DcsEntry, CharClass::Final, SequenceAction::DcsDispatch);
+
+    stay(VTStates::DcsIntermediate, CharClass::Intermediate, SequenceAction::Collect);
+    set(VTStates::DcsIntermediate, CharClass::Digit, SequenceAction::None, VTStates::DcsIgnore);
+    set(VTStates::DcsIntermediate, CharClass::Colon, SequenceAction::None, VTStates::DcsIgnore);
+    set(VTStates::DcsIntermediate, CharClass::Delimiter, SequenceAction::None, VTStates::DcsIgnore);
+    set(VTStates::DcsIntermediate, CharClass::PrivateMarker, SequenceAction::None, VTStates::DcsIgnore);
+    stay(VTStates::DcsIntermediate, CharClass::Final, SequenceAction::DcsDispatch);
+
+    set(VTStates::DcsParam, CharClass::Intermediate, SequenceAction::Collect, VTStates::DcsIntermediate);
+    stay(VTStates::DcsParam, CharClass::Digit, SequenceAction::Param);
+    set(VTStates::DcsParam, CharClass::Colon, SequenceAction::None, VTStates::DcsIgnore);
+    stay(VTStates::DcsParam, CharClass::Delimiter, SequenceAction::Param);
+    set(VTStates::DcsParam, CharClass::PrivateMarker, SequenceAction::None, VTStates::DcsIgnore);
+    stay(VTStates::DcsParam, CharClass::Final, SequenceAction::DcsDispatch);
+
+    return table;
+}
+
+// Routine Description:
+// - Processes a character event while in one of the CSI, SS3 or DCS states
+//   that precede the final character, by looking up the transition for the
+//   class of the character in the sequence table.
 // Arguments:
 // - wch - Character that triggered the event
 // Return Value:
 // - <none>
-void StateMachine::_EventCsiIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIntermediate");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+void StateMachine::_EventSequence(const wchar_t wch)
+{
+    static constexpr std::array<std::wstring_view, static_cast<size_t>(VTStates::Count)> eventNames{
+        L"Ground",
+        L"Escape",
+        L"EscapeIntermediate",
+        L"CsiEntry",
+        L"CsiIntermediate",
+        L"CsiIgnore",
+        L"CsiParam",
+        L"OscParam",
+        L"OscString",
+        L"OscTermination",
+        L"Ss3Entry",
+        L"Ss3Param",
+        L"Vt52Param",
+        L"DcsEntry",
+        L"DcsIgnore",
+        L"DcsIntermediate",
+        L"DcsParam",
+        L"DcsPassThrough",
+        L"SosPmApcString",
+    };
+    static constexpr auto charClasses = [] {
+        std::array<CharClass, 128> classes{};
+        for (size_t i = 0; i < classes.size(); ++i)
+        {
+            classes[i] = _ClassifyCharacter(static_cast<wchar_t>(i));
+        }
+        return classes;
+    }();
+    static constexpr auto sequenceTable = _BuildSequenceTable();
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIgnore state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Return to Ground
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIgnore(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIgnore");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        _EnterGround();
-    }
-}
+    const auto state = _state;
+    _trace.TraceOnEvent(eventNames[static_cast<size_t>(state)]);
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiParam");
-    if (_isC0Code(wch))
+    const auto charClass = wch < charClasses.size() ? charClasses[wch] : CharClass::Final;
+    const auto& transition = sequenceTable[static_cast<size_t>(state)][static_cast<size_t>(charClass)];
+
+    switch (transition.action)
     {
+    case SequenceAction::Execute:
         _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
+        break;
+    case SequenceAction::Ignore:
         _ActionIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isIntermediate(wch))
-    {
+        break;
+    case SequenceAction::Collect:
         _ActionCollect(wch);
-        _EnterCsiIntermediate();
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterCsiIgnore();
+        break;
+    case SequenceAction::Param:
+        _ActionParam(wch);
+        break;
+    case SequenceAction::CsiDispatch:
+        _ActionCsiDispatch(wch);
+        break;
+    case SequenceAction::Ss3Dispatch:
+        _ActionSs3Dispatch(wch);
+        break;
+    case SequenceAction::DcsDispatch:
+        _ActionDcsDispatch(wch);
+        break;
+    default:
+        break;
     }
-    else
+
+    if (transition.next != state)
     {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
+        switch (transition.next)
+        {
+        case VTStates::Ground:
+            _EnterGround();
+            break;
+        case VTStates::CsiIntermediate:
+            _EnterCsiIntermediate();
+            break;
+        case VTStates::CsiIgnore:
+            _EnterCsiIgnore();
+            break;
+        case VTStates::CsiParam:
+            _EnterCsiParam();
+            break;
+        case VTStates::Ss3Param:
+            _EnterSs3Param();
+            break;
+        case VTStates::DcsIgnore:
+            _EnterDcsIgnore();
+            break;
+        case VTStates::DcsIntermediate:
+            _EnterDcsIntermediate();
+            break;
+        case VTStates::DcsParam:
+            _EnterDcsParam();
+            break;
+        default:
+            break;
+        }
     }
 }
+#pragma warning(pop)
 
 // Routine Description:
 // - Processes a character event into an Action that occurs while in the OscParam state.
@@ -1405,88 +1598,6 @@ void StateMachine::_EventOscTermination(const wchar_t wch)
     }
 }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the Ss3Entry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
-//  SS3 sequences are structurally the same as CSI sequences, just with a
-//      different initiation. It's safe to reuse CSI's functions for
-//      determining if a character is a parameter, delimiter, or invalid.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventSs3Entry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ss3Entry");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isCsiInvalid(wch))
-    {
-        // It's safe for us to go into the CSI ignore here, because both SS3 and
-        //      CSI sequences ignore characters the same way.
-        _EnterCsiIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterSs3Param();
-    }
-    else
-    {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventSs3Param(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ss3Param");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
-    }
-}
-
 // Routine Description:
 // - Processes a character event into an Action that occurs while in the Vt52Param state.
 //   Events in this state will:
@@ -1522,53 +1633,6 @@ void StateMachine::_EventVt52Param(const wchar_t wch)
     }
 }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsEntry state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining characters when an invalid character is detected (DcsIgnore)
-//   4. Store parameter data
-//   5. Collect Intermediate characters
-//   6. Dispatch the Final character in preparation for parsing the data string
-//  DCS sequences are structurally almost the same as CSI sequences, just with an
-//      extra data string. It's safe to reuse CSI functions for
-//      determining if a character is a parameter, delimiter, or invalid.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsEntry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsEntry");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isCsiInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterDcsParam();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterDcsIntermediate();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
 // Routine Description:
 // - Processes a character event into an Action that occurs while in the DcsIgnore state.
 //   In this state the entire DCS string is considered invalid and we will ignore everything.
@@ -1583,86 +1647,6 @@ void StateMachine::_EventDcsIgnore() noexcept
     _ActionIgnore();
 }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsIntermediate state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect intermediate data.
-//   4. Begin to ignore all remaining intermediates when an invalid character is detected (DcsIgnore)
-//   5. Dispatch the Final character in preparation for parsing the data string
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsIntermediate");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsParam state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect DCS parameter data
-//   4. Enter DcsIntermediate if we see an intermediate
-//   5. Begin to ignore all remaining parameters when an invalid character is detected (DcsIgnore)
-//   6. Dispatch the Final character in preparation for parsing the data string
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsParam");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterDcsIntermediate();
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
 // Routine Description:
 // - Processes a character event into an Action that occurs while in the DcsPassThrough state.
 //   Events in this state will:
@@ -1678,10 +1662,7 @@ void StateMachine::_EventDcsPassThrough(const wchar_t wch)
     _trace.TraceOnEvent(L"DcsPassThrough");
     if (_isC0Code(wch) || _isDcsPassThroughValid(wch))
     {
-        if (!_dcsStringHandler(wch))
-        {
-            _EnterDcsIgnore();
-        }
+        _ActionDcsPassThrough({ &wch, 1 });
     }
     else
     {
@@ -1750,33 +1731,25 @@ void StateMachine::ProcessCharacter(const wchar_t wch)
         case VTStates::EscapeIntermediate:
             return _EventEscapeIntermediate(wch);
         case VTStates::CsiEntry:
-            return _EventCsiEntry(wch);
         case VTStates::CsiIntermediate:
-            return _EventCsiIntermediate(wch);
         case VTStates::CsiIgnore:
-            return _EventCsiIgnore(wch);
         case VTStates::CsiParam:
-            return _EventCsiParam(wch);
+        case VTStates::Ss3Entry:
+        case VTStates::Ss3Param:
+        case VTStates::DcsEntry:
+        case VTStates::DcsIntermediate:
+        case VTStates::DcsParam:
+            return _EventSequence(wch);
         case VTStates::OscParam:
             return _EventOscParam(wch);
         case VTStates::OscString:
             return _EventOscString(wch);
         case VTStates::OscTermination:
             return _EventOscTermination(wch);
-        case VTStates::Ss3Entry:
-            return _EventSs3Entry(wch);
-        case VTStates::Ss3Param:
-            return _EventSs3Param(wch);
         case VTStates::Vt52Param:
             return _EventVt52Param(wch);
-        case VTStates::DcsEntry:
-            return _EventDcsEntry(wch);
         case VTStates::DcsIgnore:
             return _EventDcsIgnore();
-        case VTStates::DcsIntermediate:
-            return _EventDcsIntermediate(wch);
-        case VTStates::DcsParam:
-            return _EventDcsParam(wch);
         case VTStates::DcsPassThrough:
             return _EventDcsPassThrough(wch);
         case VTStates::SosPmApcString:
@@ -1794,7 +1767,7 @@ void StateMachine::ProcessCharacter(const wchar_t wch)
 //      it doesn't understand to the tty.
 //  This does not modify the state of the state machine. Callers should be in
 //      the Action*Dispatch state, and upon completion, the state's handler (eg
-//      _EventCsiParam) should move us into the ground state.
+//      _EventSequence) should move us into the ground state.
 // Arguments:
 // - <none>
 // Return Value:
@@ -1803,13 +1776,13 @@ bool StateMachine::FlushToTerminal()
 {
     bool success{ true };
 
-    if (success && _cachedSequence.has_value())
+    if (success && !_cachedSequence.empty())
     {
         // Flush the partial sequence to the terminal before we flush the rest of it.
         // We always want to clear the sequence, even if we failed, so we don't accumulate bad state
         // and dump it out elsewhere later.
-        success = _engine->ActionPassThroughString(*_cachedSequence);
-        _cachedSequence.reset();
+        success = _engine->ActionPassThroughString(_cachedSequence);
+        _cachedSequence.clear();
     }
 
     if (success)
@@ -1824,6 +1797,58 @@ bool StateMachine::FlushToTerminal()
     return success;
 }
 
+// Routine Description:
+// - Parses and dispatches a complete control sequence in one go, instead of
+//   running every character of it through the state machine. Only sequences
+//   whose parameters are made of nothing but digits and delimiters are handled
+//   here, which covers the SGR sequences of the output and the
+//   win32-input-mode key events of the input. Everything else - intermediates,
+//   private markers, sub-parameters, controls or a sequence that doesn't end
+//   in this string - is left to the state machine, and nothing is changed.
+// - The parameters are accumulated by _ActionParam, so that they describe the
+//   sequence exactly like they would have, if it were parsed one by one.
+// Arguments:
+// - string - The string being processed.
+// - offset - The index of the ESC that might start a control sequence.
+// Return Value:
+// - The index past the end of the dispatched sequence, or 0 if none was dispatched.
+size_t StateMachine::_TryDispatchCsi(const std::wstring_view string, const size_t offset)
+{
+    if (!_isInAnsiMode ||
+        string.size() - offset < 3 ||
+        !_isEscape(til::at(string, offset)) ||
+        !_isCsiIndicator(til::at(string, offset + 1)))
+    {
+        return 0;
+    }
+
+    auto end = offset + 2;
+    while (end < string.size() && (_isNumericParamValue(til::at(string, end)) || _isParameterDelimiter(til::at(string, end))))
+    {
+        ++end;
+    }
+
+    // The final character of a control sequence is in the range 0x40 - 0x7E.
+    if (end == string.size() || til::at(string, end) < L'@' || til::at(string, end) > L'~')
+    {
+        return 0;
+    }
+
+    _trace.ClearSequenceTrace();
+    _ActionClear();
+    for (auto i = offset + 2; i < end; ++i)
+    {
+        _ActionParam(til::at(string, i));
+    }
+
+    // Like in ProcessString, the run is the whole sequence, in case the
+    // engine decides to pass it through.
+    _run = string.substr(offset, end + 1 - offset);
+    _ActionCsiDispatch(til::at(string, end));
+    _EnterGround();
+    return end + 1;
+}
+
 // Routine Description:
 // - Helper for entry to the state machine. Will take an array of characters
 //     and print as many as it can without encountering a character indicating
@@ -1835,18 +1860,64 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    til::allocation_tracker::scope allocationScope{ til::allocation_region::parse };
+
     size_t start = 0;
     size_t current = start;
 
     while (current < string.size())
     {
-        // The run will be everything from the start INCLUDING the current one
-        // in case we process the current character and it turns into a passthrough
-        // fallback that picks up this _run inside `FlushToTerminal` above.
-        _run = string.substr(start, current - start + 1);
-
         if (_processingIndividually)
         {
+            // A control sequence that starts the run and is complete in this
+            // string can skip the state machine altogether.
+            if (_state == VTStates::Ground && current == start)
+            {
+                if (const auto end = _TryDispatchCsi(string, current))
+                {
+                    current = end;
+                    start = current;
+                    _processingIndividually = false;
+                    continue;
+                }
+            }
+
+            // Data strings can be megabytes long (sixel images, soft fonts),
+            // so the handler gets every run of data characters in one go.
+            // The run isn't kept for a flush, since the sequence was dispatched.
+            if (_state == VTStates::DcsPassThrough)
+            {
+                const auto end = _findEndOfDcsPassThrough(string, current);
+                if (end > current)
+                {
+                    _ActionDcsPassThrough(string.substr(current, end - current));
+                    current = end;
+                    start = current;
+                    continue;
+                }
+            }
+
+            // OSC strings can be long as well (the clipboard contents of
+            // OSC 52), so their printable runs are appended in one go too.
+            // None of the characters that end the string or are ignored in it
+            // are printable. Since the sequence isn't dispatched yet, the run
+            // stays part of _run, in case it has to be flushed.
+            if (_state == VTStates::OscString)
+            {
+                const auto end = _findActionableFromGround(string, current);
+                if (end > current)
+                {
+                    _ActionOscPutString(string.substr(current, end - current));
+                    current = end;
+                    continue;
+                }
+            }
+
+            // The run will be everything from the start INCLUDING the current one
+            // in case we process the current character and it turns into a passthrough
+            // fallback that picks up this _run inside `FlushToTerminal` above.
+            _run = string.substr(start, current - start + 1);
+
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(string.at(current));
             ++current;
@@ -1858,14 +1929,15 @@ void StateMachine::ProcessString(const std::wstring_view string)
         }
         else
         {
-            if (_isActionableFromGround(string.at(current))) // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Skip over every printable char in one go. They all belong to the current run.
+            current = _findActionableFromGround(string, current);
+
+            if (current < string.size()) // If the current char is the start of an escape sequence, or should be executed in ground state...
             {
-                if (!_run.empty())
+                if (current > start)
                 {
-                    // Because the _run above is composed INCLUDING current, we must
-                    // trim it off here since we just determined it's actionable
-                    // and only pass through everything before it.
-                    const auto allLeadingUpTo = _run.substr(0, _run.size() - 1);
+                    // Only pass through everything before the actionable char.
+                    const auto allLeadingUpTo = string.substr(start, current - start);
 
                     _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
                     _trace.DispatchPrintRunTrace(allLeadingUpTo);
@@ -1873,11 +1945,6 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
                 _processingIndividually = true; // begin processing future characters individually...
                 start = current;
-                continue;
-            }
-            else
-            {
-                ++current; // Otherwise, add this char to the current run to be printed.
             }
         }
     }
@@ -1961,7 +2028,11 @@ void StateMachine::ProcessString(const std::wstring_view string)
             // If the engine doesn't require flushing at the end of the string, we
             // want to cache the partial sequence in case we have to flush the whole
             // thing to the terminal later.
-            _cachedSequence = _cachedSequence.value_or(std::wstring{}) + std::wstring{ _run };
+            if (_cachedSequence.size() + _run.size() > _cachedSequence.capacity())
+            {
+                ++_scratchAllocations;
+            }
+            _cachedSequence.append(_run);
         }
     }
 }
@@ -65,9 +65,12 @@ namespace Microsoft::Console::VirtualTerminal
         void _ActionCsiDispatch(const wchar_t wch);
         void _ActionOscParam(const wchar_t wch) noexcept;
         void _ActionOscPut(const wchar_t wch);
+        void _ActionOscPutString(const std::wstring_view string);
         void _ActionOscDispatch(const wchar_t wch);
         void _ActionSs3Dispatch(const wchar_t wch);
         void _ActionDcsDispatch(const wchar_t wch);
+        void _ActionDcsPassThrough(const std::wstring_view string);
+        size_t _TryDispatchCsi(const std::wstring_view string, const size_t offset);
 
         void _ActionClear();
         void _ActionIgnore() noexcept;
@@ -96,20 +99,12 @@ namespace Microsoft::Console::VirtualTerminal
         void _EventGround(const wchar_t wch);
         void _EventEscape(const wchar_t wch);
         void _EventEscapeIntermediate(const wchar_t wch);
-        void _EventCsiEntry(const wchar_t wch);
-        void _EventCsiIntermediate(const wchar_t wch);
-        void _EventCsiIgnore(const wchar_t wch);
-        void _EventCsiParam(const wchar_t wch);
+        void _EventSequence(const wchar_t wch);
         void _EventOscParam(const wchar_t wch) noexcept;
         void _EventOscString(const wchar_t wch);
         void _EventOscTermination(const wchar_t wch);
-        void _EventSs3Entry(const wchar_t wch);
-        void _EventSs3Param(const wchar_t wch);
         void _EventVt52Param(const wchar_t wch);
-        void _EventDcsEntry(const wchar_t wch);
         void _EventDcsIgnore() noexcept;
-        void _EventDcsIntermediate(const wchar_t wch);
-        void _EventDcsParam(const wchar_t wch);
         void _EventDcsPassThrough(const wchar_t wch);
         void _EventSosPmApcString(const wchar_t wch) noexcept;
 
@@ -135,9 +130,50 @@ namespace Microsoft::Console::VirtualTerminal
             DcsIntermediate,
             DcsParam,
             DcsPassThrough,
-            SosPmApcString
+            SosPmApcString,
+            Count
         };
 
+        // The states of CSI, SS3 and DCS sequences up to their final character are
+        // only driven by the class of each character. Their transitions are looked up
+        // in a table of state x CharClass that's generated at compile time by
+        // _BuildSequenceTable, in the style of Paul Williams' DEC parser.
+        enum class CharClass : uint8_t
+        {
+            C0, // except for CAN, SUB and ESC, which never get here
+            Intermediate, // 0x20 - 0x2F
+            Digit, // 0x30 - 0x39
+            Colon, // 0x3A
+            Delimiter, // 0x3B
+            PrivateMarker, // 0x3C - 0x3F
+            Delete, // 0x7F
+            Final, // everything else
+            Count
+        };
+
+        enum class SequenceAction : uint8_t
+        {
+            None,
+            Execute,
+            Ignore,
+            Collect,
+            Param,
+            CsiDispatch,
+            Ss3Dispatch,
+            DcsDispatch
+        };
+
+        struct SequenceTransition
+        {
+            SequenceAction action;
+            VTStates next; // the state itself, if the action doesn't cause a transition
+        };
+
+        using SequenceTable = std::array<std::array<SequenceTransition, static_cast<size_t>(CharClass::Count)>, static_cast<size_t>(VTStates::Count)>;
+
+        static constexpr CharClass _ClassifyCharacter(const wchar_t wch) noexcept;
+        static constexpr SequenceTable _BuildSequenceTable() noexcept;
+
         Microsoft::Console::VirtualTerminal::ParserTracing _trace;
 
         std::unique_ptr<IStateMachineEngine> _engine;
@@ -148,8 +184,12 @@ namespace Microsoft::Console::VirtualTerminal
 
         std::wstring_view _run;
 
+        // The parameters and strings of a sequence are kept in storage that's
+        // reused from one sequence to the next, so that parsing doesn't need
+        // to allocate once it has seen the longest OSC string of the output.
+        // _scratchAllocations counts how often that storage had to grow.
         VTIDBuilder _identifier;
-        std::vector<VTParameter> _parameters;
+        til::some<VTParameter, MAX_PARAMETER_COUNT> _parameters;
         bool _parameterLimitReached;
 
         std::wstring _oscString;
@@ -157,7 +197,10 @@ namespace Microsoft::Console::VirtualTerminal
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
-        std::optional<std::wstring> _cachedSequence;
+        std::wstring _cachedSequence; // empty if there's no partial sequence to flush
+        size_t _scratchAllocations;
+
+        static constexpr size_t s_scratchCapacity = 256;
 
         // This is tracked per state machine instance so that separate calls to Process*
         //   can start and finish a sequence.
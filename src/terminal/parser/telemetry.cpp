@@ -32,7 +32,7 @@ TermTelemetry::TermTelemetry() noexcept :
     _activityId(),
     _fShouldWriteFinalLog(false)
 {
-    TraceLoggingRegister(g_hConsoleVirtTermParserEventTraceProvider);
+    TraceLoggingRegisterEx(g_hConsoleVirtTermParserEventTraceProvider, &s_ProviderEnabledCallback, nullptr);
 
     // Create a random activityId just in case it doesn't get set later in SetActivityId().
     EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &_activityId);
@@ -44,49 +44,31 @@ TermTelemetry::~TermTelemetry()
     try
     {
         WriteFinalTraceLog();
+        s_tracingEnabled.store(false, std::memory_order_relaxed);
         TraceLoggingUnregister(g_hConsoleVirtTermParserEventTraceProvider);
     }
     CATCH_LOG()
 }
 
 // Routine Description:
-// - Logs the usage of a particular VT100 code.
-//
+// - Called by ETW whenever a trace session enables, disables or changes the
+//   level or keywords of our provider, including once while registering it if
+//   a session is already running. Updates the flag behind IsTracingEnabled.
 // Arguments:
-// - code - VT100 code.
+// - <unused> - See EnableCallback (PENABLECALLBACK). The provider's own state
+//   has already been updated when we're called, so we just ask it.
 // Return Value:
 // - <none>
-void TermTelemetry::Log(const Codes code) noexcept
+void NTAPI TermTelemetry::s_ProviderEnabledCallback(LPCGUID /*sourceId*/,
+                                                    ULONG /*isEnabled*/,
+                                                    UCHAR /*level*/,
+                                                    ULONGLONG /*matchAnyKeyword*/,
+                                                    ULONGLONG /*matchAllKeyword*/,
+                                                    PEVENT_FILTER_DESCRIPTOR /*filterData*/,
+                                                    PVOID /*callbackContext*/) noexcept
 {
-    // Initially we wanted to pass over a string (ex. "CUU") and use a dictionary data type to hold the counts.
-    // However we would have to search through the dictionary every time we called this method, so we decided
-    // to use an array which has very quick access times.
-    // The downside is we have to create an enum type, and then convert them to strings when we finally
-    // send out the telemetry, but the upside is we should have very good performance.
-    _uiTimesUsed[code]++;
-    _uiTimesUsedCurrent++;
-}
-
-// Routine Description:
-// - Logs a particular VT100 escape code failed or was unsupported.
-//
-// Arguments:
-// - code - VT100 code.
-// Return Value:
-// - <none>
-void TermTelemetry::LogFailed(const wchar_t wch) noexcept
-{
-    if (wch > CHAR_MAX)
-    {
-        _uiTimesFailedOutsideRange++;
-        _uiTimesFailedOutsideRangeCurrent++;
-    }
-    else
-    {
-        // Even though we pass over a wide character, we only care about the ASCII single byte character.
-        _uiTimesFailed[wch]++;
-        _uiTimesFailedCurrent++;
-    }
+    const bool enabled = TraceLoggingProviderEnabled(g_hConsoleVirtTermParserEventTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE);
+    s_tracingEnabled.store(enabled, std::memory_order_relaxed);
 }
 
 // Routine Description:
@@ -15,6 +15,7 @@ Abstract:
 #include <winmeta.h>
 #include <TraceLoggingProvider.h>
 #include "climits"
+#include <atomic>
 
 TRACELOGGING_DECLARE_PROVIDER(g_hConsoleVirtTermParserEventTraceProvider);
 
@@ -109,8 +110,63 @@ namespace Microsoft::Console::VirtualTerminal
             // Only use this last enum as a count of the number of codes.
             NUMBER_OF_CODES
         };
-        void Log(const Codes code) noexcept;
-        void LogFailed(const wchar_t wch) noexcept;
+        // Routine Description:
+        // - Logs the usage of a particular VT100 code.
+        // - This is called for every dispatched sequence, so it's defined here
+        //   to be inlined into the dispatch paths. The counts are only sent out
+        //   once, by WriteFinalTraceLog.
+        // Arguments:
+        // - code - VT100 code.
+        // Return Value:
+        // - <none>
+        void Log(const Codes code) noexcept
+        {
+            // Initially we wanted to pass over a string (ex. "CUU") and use a dictionary data type to hold the counts.
+            // However we would have to search through the dictionary every time we called this method, so we decided
+            // to use an array which has very quick access times.
+            // The downside is we have to create an enum type, and then convert them to strings when we finally
+            // send out the telemetry, but the upside is we should have very good performance.
+#pragma warning(suppress : 26446 26482) // The code is always in range of the array, and gsl::at would check it again.
+            _uiTimesUsed[code]++;
+            _uiTimesUsedCurrent++;
+        }
+
+        // Routine Description:
+        // - Logs a particular VT100 escape code failed or was unsupported.
+        // Arguments:
+        // - wch - The final character of the failed sequence.
+        // Return Value:
+        // - <none>
+        void LogFailed(const wchar_t wch) noexcept
+        {
+            if (wch > CHAR_MAX)
+            {
+                _uiTimesFailedOutsideRange++;
+                _uiTimesFailedOutsideRangeCurrent++;
+            }
+            else
+            {
+                // Even though we pass over a wide character, we only care about the ASCII single byte character.
+#pragma warning(suppress : 26446 26482) // We just checked that wch is in range of the array.
+                _uiTimesFailed[wch]++;
+                _uiTimesFailedCurrent++;
+            }
+        }
+
+        // Routine Description:
+        // - Returns whether anyone is listening to the verbose parser events.
+        // - This is a copy of the provider's state that's updated by its enable
+        //   callback, so that the tracing calls in the parser cost one load and
+        //   one predictable branch while no trace session is running.
+        // Arguments:
+        // - <none>
+        // Return Value:
+        // - true if the verbose TIL_KEYWORD_TRACE events should be written.
+        static bool IsTracingEnabled() noexcept
+        {
+            return s_tracingEnabled.load(std::memory_order_relaxed);
+        }
+
         void SetShouldWriteFinalLog(const bool writeLog) noexcept;
         void SetActivityId(const GUID* activityId) noexcept;
         unsigned int GetAndResetTimesUsedCurrent() noexcept;
@@ -128,6 +184,16 @@ namespace Microsoft::Console::VirtualTerminal
 
         void WriteFinalTraceLog() const;
 
+        static void NTAPI s_ProviderEnabledCallback(LPCGUID sourceId,
+                                                    ULONG isEnabled,
+                                                    UCHAR level,
+                                                    ULONGLONG matchAnyKeyword,
+                                                    ULONGLONG matchAllKeyword,
+                                                    PEVENT_FILTER_DESCRIPTOR filterData,
+                                                    PVOID callbackContext) noexcept;
+
+        static inline std::atomic<bool> s_tracingEnabled{ false };
+
         unsigned int _uiTimesUsedCurrent;
         unsigned int _uiTimesFailedCurrent;
         unsigned int _uiTimesFailedOutsideRangeCurrent;
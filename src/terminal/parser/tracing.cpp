@@ -15,7 +15,7 @@ ParserTracing::ParserTracing() noexcept
     ClearSequenceTrace();
 }
 
-void ParserTracing::TraceStateChange(const std::wstring_view name) const noexcept
+void ParserTracing::_TraceStateChange(const std::wstring_view name) const noexcept
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
                       "StateMachine_EnterState",
@@ -24,7 +24,7 @@ void ParserTracing::TraceStateChange(const std::wstring_view name) const noexcep
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::TraceOnAction(const std::wstring_view name) const noexcept
+void ParserTracing::_TraceOnAction(const std::wstring_view name) const noexcept
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
                       "StateMachine_Action",
@@ -33,7 +33,7 @@ void ParserTracing::TraceOnAction(const std::wstring_view name) const noexcept
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::TraceOnExecute(const wchar_t wch) const noexcept
+void ParserTracing::_TraceOnExecute(const wchar_t wch) const noexcept
 {
     const auto sch = gsl::narrow_cast<INT16>(wch);
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
@@ -44,7 +44,7 @@ void ParserTracing::TraceOnExecute(const wchar_t wch) const noexcept
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::TraceOnExecuteFromEscape(const wchar_t wch) const noexcept
+void ParserTracing::_TraceOnExecuteFromEscape(const wchar_t wch) const noexcept
 {
     const auto sch = gsl::narrow_cast<INT16>(wch);
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
@@ -55,7 +55,7 @@ void ParserTracing::TraceOnExecuteFromEscape(const wchar_t wch) const noexcept
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::TraceOnEvent(const std::wstring_view name) const noexcept
+void ParserTracing::_TraceOnEvent(const std::wstring_view name) const noexcept
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
                       "StateMachine_Event",
@@ -64,9 +64,9 @@ void ParserTracing::TraceOnEvent(const std::wstring_view name) const noexcept
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::TraceCharInput(const wchar_t wch)
+void ParserTracing::_TraceCharInput(const wchar_t wch)
 {
-    AddSequenceTrace(wch);
+    _sequenceTrace.push_back(wch);
     const auto sch = gsl::narrow_cast<INT16>(wch);
 
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
@@ -77,16 +77,7 @@ void ParserTracing::TraceCharInput(const wchar_t wch)
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
-void ParserTracing::AddSequenceTrace(const wchar_t wch)
-{
-    // Don't waste time storing this if no one is listening.
-    if (TraceLoggingProviderEnabled(g_hConsoleVirtTermParserEventTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
-    {
-        _sequenceTrace.push_back(wch);
-    }
-}
-
-void ParserTracing::DispatchSequenceTrace(const bool fSuccess) noexcept
+void ParserTracing::_DispatchSequenceTrace(const bool fSuccess) const noexcept
 {
     if (fSuccess)
     {
@@ -104,17 +95,10 @@ void ParserTracing::DispatchSequenceTrace(const bool fSuccess) noexcept
                           TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
                           TraceLoggingKeyword(TIL_KEYWORD_TRACE));
     }
-
-    ClearSequenceTrace();
-}
-
-void ParserTracing::ClearSequenceTrace() noexcept
-{
-    _sequenceTrace.clear();
 }
 
 // NOTE: I'm expecting this to not be null terminated
-void ParserTracing::DispatchPrintRunTrace(const std::wstring_view string) const
+void ParserTracing::_DispatchPrintRunTrace(const std::wstring_view string) const
 {
     if (string.size() == 1)
     {
@@ -23,19 +23,98 @@ namespace Microsoft::Console::VirtualTerminal
     public:
         ParserTracing() noexcept;
 
-        void TraceStateChange(const std::wstring_view name) const noexcept;
-        void TraceOnAction(const std::wstring_view name) const noexcept;
-        void TraceOnExecute(const wchar_t wch) const noexcept;
-        void TraceOnExecuteFromEscape(const wchar_t wch) const noexcept;
-        void TraceOnEvent(const std::wstring_view name) const noexcept;
-        void TraceCharInput(const wchar_t wch);
-
-        void AddSequenceTrace(const wchar_t wch);
-        void DispatchSequenceTrace(const bool fSuccess) noexcept;
-        void ClearSequenceTrace() noexcept;
-        void DispatchPrintRunTrace(const std::wstring_view string) const;
+        // The state machine calls these for every character it processes.
+        // They're defined here so that, while no one is listening, each of
+        // them compiles down to a single check of TermTelemetry's cached
+        // provider state, instead of a call that checks it on its own.
+        void TraceStateChange(const std::wstring_view name) const noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceStateChange(name);
+            }
+        }
+
+        void TraceOnAction(const std::wstring_view name) const noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceOnAction(name);
+            }
+        }
+
+        void TraceOnExecute(const wchar_t wch) const noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceOnExecute(wch);
+            }
+        }
+
+        void TraceOnExecuteFromEscape(const wchar_t wch) const noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceOnExecuteFromEscape(wch);
+            }
+        }
+
+        void TraceOnEvent(const std::wstring_view name) const noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceOnEvent(name);
+            }
+        }
+
+        void TraceCharInput(const wchar_t wch)
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _TraceCharInput(wch);
+            }
+        }
+
+        void AddSequenceTrace(const wchar_t wch)
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _sequenceTrace.push_back(wch);
+            }
+        }
+
+        void DispatchSequenceTrace(const bool fSuccess) noexcept
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _DispatchSequenceTrace(fSuccess);
+            }
+            ClearSequenceTrace();
+        }
+
+        void ClearSequenceTrace() noexcept
+        {
+            _sequenceTrace.clear();
+        }
+
+        void DispatchPrintRunTrace(const std::wstring_view string) const
+        {
+            if (TermTelemetry::IsTracingEnabled())
+            {
+                _DispatchPrintRunTrace(string);
+            }
+        }
 
     private:
+        void _TraceStateChange(const std::wstring_view name) const noexcept;
+        void _TraceOnAction(const std::wstring_view name) const noexcept;
+        void _TraceOnExecute(const wchar_t wch) const noexcept;
+        void _TraceOnExecuteFromEscape(const wchar_t wch) const noexcept;
+        void _TraceOnEvent(const std::wstring_view name) const noexcept;
+        void _TraceCharInput(const wchar_t wch);
+        void _DispatchSequenceTrace(const bool fSuccess) const noexcept;
+        void _DispatchPrintRunTrace(const std::wstring_view string) const;
+
         std::wstring _sequenceTrace;
     };
 }
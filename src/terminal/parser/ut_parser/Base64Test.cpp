@@ -98,4 +98,36 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         VERIFY_ARE_EQUAL(true, success);
         VERIFY_ARE_EQUAL(L"👍👍🏻👍🏼👍🏽👍🏾👍🏿", result);
     }
+
+    TEST_METHOD(TestBase64DecodeLongPayload)
+    {
+        std::wstring text;
+        for (wchar_t i = 0; i < 1000; ++i)
+        {
+            text.push_back(static_cast<wchar_t>(L'0' + i % 64));
+        }
+        const auto encoded = Base64::s_Encode(text);
+
+        std::wstring result;
+        VERIFY_IS_TRUE(Base64::s_Decode(encoded, result));
+        VERIFY_ARE_EQUAL(text, result);
+
+        Log::Comment(L"Line breaks in the middle of a quantum are skipped.");
+        auto wrapped = encoded;
+        for (size_t i = 77; i < wrapped.size(); i += 79)
+        {
+            wrapped.insert(i, L"\r\n");
+        }
+        result.clear();
+        VERIFY_IS_TRUE(Base64::s_Decode(wrapped, result));
+        VERIFY_ARE_EQUAL(text, result);
+
+        Log::Comment(L"An invalid character is found wherever it is.");
+        for (const auto offset : { size_t{ 5 }, size_t{ 500 }, encoded.size() - 6 })
+        {
+            auto broken = encoded;
+            broken[offset] = L'!';
+            VERIFY_IS_FALSE(Base64::s_Decode(broken, result));
+        }
+    }
 };
@@ -282,6 +282,8 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
     TEST_METHOD(TestWin32InputParsing);
     TEST_METHOD(TestWin32InputOptionals);
 
+    TEST_METHOD(CharsToKeyEventsTest);
+
     friend class TestInteractDispatch;
 };
 
@@ -336,6 +338,9 @@ public:
 
     virtual bool IsVtInputEnabled() const override;
 
+    virtual void BeginInputBatch() override;
+    virtual bool EndInputBatch() override;
+
 private:
     std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteInputCallback;
     TestState* _testState; // non-ownership pointer
@@ -403,6 +408,15 @@ bool TestInteractDispatch::IsVtInputEnabled() const
     return true;
 }
 
+void TestInteractDispatch::BeginInputBatch()
+{
+}
+
+bool TestInteractDispatch::EndInputBatch()
+{
+    return true;
+}
+
 void InputEngineTest::C0Test()
 {
     auto pfn = std::bind(&TestState::TestInputCallback, &testState, std::placeholders::_1);
@@ -1611,3 +1625,31 @@ void InputEngineTest::TestWin32InputOptionals()
         }
     }
 }
+
+void InputEngineTest::CharsToKeyEventsTest()
+{
+    Log::Comment(L"Converting a string at once must give the same keys as converting it one char at a time.");
+
+    // Uppercase ASCII needs shift, the rest isn't on the keyboard, or not ASCII.
+    const std::wstring_view text{ L"aZ1 ~\r\t\x7f\x00e9\x4e00" };
+
+    std::deque<std::unique_ptr<IInputEvent>> expected;
+    for (const auto wch : text)
+    {
+        auto convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, CP_USA);
+        std::move(convertedEvents.begin(),
+                  convertedEvents.end(),
+                  std::back_inserter(expected));
+    }
+
+    std::deque<std::unique_ptr<IInputEvent>> actual;
+    Microsoft::Console::Interactivity::CharsToKeyEvents(text, CP_USA, actual);
+
+    const auto expectedRecords = IInputEvent::ToInputRecords(expected);
+    const auto actualRecords = IInputEvent::ToInputRecords(actual);
+    VERIFY_ARE_EQUAL(expectedRecords.size(), actualRecords.size());
+    for (size_t i = 0; i < expectedRecords.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expectedRecords[i], actualRecords[i]);
+    }
+}
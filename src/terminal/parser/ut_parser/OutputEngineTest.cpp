@@ -546,6 +546,29 @@ class Microsoft::Console::VirtualTerminal::OutputEngineTest final
         VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
     }
 
+    TEST_METHOD(TestScratchStorageIsReused)
+    {
+        auto dispatch = std::make_unique<DummyDispatch>();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        StateMachine mach(std::move(engine));
+
+        const std::wstring title(300, L't');
+        const std::wstring output = L"\x1b[38;2;255;128;0;48;2;0;64;255;1;4mA\x1b]0;" + title + L"\x7\x1b[m";
+
+        Log::Comment(L"The first OSC string that's longer than the initial capacity needs to grow the storage.");
+        mach.ProcessString(output);
+        const auto allocations = mach._scratchAllocations;
+        VERIFY_IS_GREATER_THAN(allocations, 0u);
+
+        Log::Comment(L"After that, the same output is parsed without growing it again.");
+        for (size_t i = 0; i < 100; i++)
+        {
+            mach.ProcessString(output);
+        }
+        VERIFY_ARE_EQUAL(allocations, mach._scratchAllocations);
+        VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
+    }
+
     TEST_METHOD(NormalTestOscParam)
     {
         auto dispatch = std::make_unique<DummyDispatch>();
@@ -1046,6 +1069,8 @@ public:
         _setDefaultCursorColor(false),
         _defaultCursorColor{ RGB(0, 0, 0) },
         _hyperlinkMode{ false },
+        _markKind{},
+        _markExitCode{},
         _options{ s_cMaxOptions, static_cast<DispatchTypes::GraphicsOptions>(s_uiGraphicsCleared) }, // fill with cleared option
         _colorTable{},
         _setColorTableEntry{ false }
@@ -1471,6 +1496,13 @@ public:
         return true;
     }
 
+    bool AddMark(const MarkKind kind, const std::optional<unsigned int> exitCode) noexcept override
+    {
+        _markKind = kind;
+        _markExitCode = exitCode;
+        return true;
+    }
+
     size_t _cursorDistance;
     size_t _line;
     size_t _column;
@@ -1534,6 +1566,8 @@ public:
     std::wstring _copyContent;
     std::wstring _uri;
     std::wstring _customId;
+    std::optional<MarkKind> _markKind;
+    std::optional<unsigned int> _markExitCode;
 
     static const size_t s_cMaxOptions = 16;
     static const size_t s_uiGraphicsCleared = UINT_MAX;
@@ -3289,6 +3323,29 @@ class StateMachineExternalTest final
         pDispatch->ClearState();
     }
 
+    TEST_METHOD(TestSetClipboardAcrossWrites)
+    {
+        auto dispatch = std::make_unique<StatefulDispatch>();
+        auto pDispatch = dispatch.get();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        StateMachine mach(std::move(engine));
+
+        // A large payload arrives in several writes, each of them ending in the middle of it.
+        mach.ProcessString(L"\x1b]52;;Zm9vYmFy");
+        mach.ProcessString(L"Zm9v");
+        mach.ProcessString(L"YmFy\x07");
+        VERIFY_ARE_EQUAL(L"foobarfoobar", pDispatch->_copyContent);
+
+        pDispatch->ClearState();
+
+        // Characters that are ignored in the string don't end the payload.
+        pDispatch->_copyContent = L"UNCHANGED";
+        mach.ProcessString(L"\x1b]52;;Zm9v\x01YmFy\x1b\\");
+        VERIFY_ARE_EQUAL(L"foobar", pDispatch->_copyContent);
+
+        pDispatch->ClearState();
+    }
+
     TEST_METHOD(TestAddHyperlink)
     {
         auto dispatch = std::make_unique<StatefulDispatch>();
@@ -3370,4 +3427,41 @@ class StateMachineExternalTest final
 
         pDispatch->ClearState();
     }
+
+    TEST_METHOD(TestFinalTermMarks)
+    {
+        auto dispatch = std::make_unique<StatefulDispatch>();
+        auto pDispatch = dispatch.get();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        StateMachine mach(std::move(engine));
+
+        mach.ProcessString(L"\x1b]133;A\x9c");
+        VERIFY_IS_TRUE(pDispatch->_markKind == MarkKind::Prompt);
+        VERIFY_IS_FALSE(pDispatch->_markExitCode.has_value());
+
+        // Further parameters are ignored.
+        mach.ProcessString(L"\x1b]133;B;cl=m\x9c");
+        VERIFY_IS_TRUE(pDispatch->_markKind == MarkKind::Command);
+
+        mach.ProcessString(L"\x1b]133;C\x9c");
+        VERIFY_IS_TRUE(pDispatch->_markKind == MarkKind::Output);
+
+        mach.ProcessString(L"\x1b]133;D;2\x9c");
+        VERIFY_IS_TRUE(pDispatch->_markKind == MarkKind::CommandFinished);
+        VERIFY_ARE_EQUAL(2u, pDispatch->_markExitCode.value());
+
+        // The shell doesn't have to know the exit code.
+        mach.ProcessString(L"\x1b]133;D\x9c");
+        VERIFY_IS_TRUE(pDispatch->_markKind == MarkKind::CommandFinished);
+        VERIFY_IS_FALSE(pDispatch->_markExitCode.has_value());
+
+        pDispatch->ClearState();
+
+        mach.ProcessString(L"\x1b]133;X\x9c");
+        VERIFY_IS_FALSE(pDispatch->_markKind.has_value());
+        mach.ProcessString(L"\x1b]133;\x9c");
+        VERIFY_IS_FALSE(pDispatch->_markKind.has_value());
+
+        pDispatch->ClearState();
+    }
 };
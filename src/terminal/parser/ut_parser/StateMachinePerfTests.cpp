@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "stateMachine.hpp"
+
+#include <chrono>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace Microsoft
+{
+    namespace Console
+    {
+        namespace VirtualTerminal
+        {
+            class StateMachinePerfTests;
+            class NullStateMachineEngine;
+        };
+    };
+};
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+// An engine that does as little as possible, so that the measurements
+// below reflect the cost of the state machine itself.
+class Microsoft::Console::VirtualTerminal::NullStateMachineEngine : public IStateMachineEngine
+{
+public:
+    bool ActionExecute(const wchar_t /* wch */) override { return true; };
+    bool ActionExecuteFromEscape(const wchar_t /* wch */) override { return true; };
+    bool ActionPrint(const wchar_t /* wch */) override
+    {
+        ++printed;
+        return true;
+    };
+    bool ActionPrintString(const std::wstring_view string) override
+    {
+        printed += string.size();
+        return true;
+    };
+    bool ActionPassThroughString(const std::wstring_view /* string */) override { return true; };
+    bool ActionEscDispatch(const VTID /* id */) override { return true; };
+    bool ActionVt52EscDispatch(const VTID /* id */, const VTParameters /* parameters */) override { return true; };
+    bool ActionCsiDispatch(const VTID /* id */, const VTParameters /* parameters */) override { return true; };
+    IStateMachineEngine::StringHandler ActionDcsDispatch(const VTID /* id */, const VTParameters /* parameters */) override { return nullptr; };
+    bool ActionClear() override { return true; };
+    bool ActionIgnore() override { return true; };
+    bool ActionOscDispatch(const wchar_t /* wch */,
+                           const size_t /* parameter */,
+                           const std::wstring_view /* string */) override { return true; };
+    bool ActionSs3Dispatch(const wchar_t /* wch */, const VTParameters /* parameters */) override { return true; };
+
+    bool ParseControlSequenceAfterSs3() const override { return false; }
+    bool FlushAtEndOfString() const override { return false; };
+    bool DispatchControlCharsFromEscape() const override { return false; };
+    bool DispatchIntermediatesFromEscape() const override { return false; };
+
+    size_t printed = 0;
+};
+
+class Microsoft::Console::VirtualTerminal::StateMachinePerfTests
+{
+    TEST_CLASS(StateMachinePerfTests);
+
+    TEST_METHOD(PlainTextThroughput);
+    TEST_METHOD(ShortLinesThroughput);
+    TEST_METHOD(ColoredTextThroughput);
+    TEST_METHOD(TrueColorCellsThroughput);
+    TEST_METHOD(MixedSequencesThroughput);
+
+private:
+    static void _MeasureThroughput(const std::wstring_view chunk);
+};
+
+// Routine Description:
+// - Feeds the given chunk through a StateMachine repeatedly, until roughly
+//   64 MB worth of UTF-16 text has been processed, and logs the throughput.
+// Arguments:
+// - chunk - The text to feed through the parser, one ProcessString call at a time.
+// Return Value:
+// - <none>
+void StateMachinePerfTests::_MeasureThroughput(const std::wstring_view chunk)
+{
+    auto enginePtr{ std::make_unique<NullStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    const auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    constexpr size_t totalBytes = 64 * 1024 * 1024;
+    const size_t iterations = totalBytes / (chunk.size() * sizeof(wchar_t));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        machine.ProcessString(chunk);
+    }
+    const auto delta = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto megabytes = static_cast<double>(iterations * chunk.size() * sizeof(wchar_t)) / (1024 * 1024);
+    Log::Comment(String().Format(L"Processed %.1f MB in %.3f s: %.1f MB/s (%zu chars printed)",
+                                 megabytes,
+                                 delta,
+                                 delta > 0 ? megabytes / delta : 0.0,
+                                 engine.printed));
+}
+
+void StateMachinePerfTests::PlainTextThroughput()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    Log::Comment(L"A large chunk of printable ASCII, like `cat`-ing a big file without newlines.");
+    std::wstring chunk;
+    while (chunk.size() < 16 * 1024)
+    {
+        chunk += L"The quick brown fox jumps over the lazy dog. ";
+    }
+    _MeasureThroughput(chunk);
+}
+
+void StateMachinePerfTests::ShortLinesThroughput()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    Log::Comment(L"Build-log style output: lines of varying length, each ending in CRLF.");
+    std::wstring chunk;
+    for (size_t i = 0; chunk.size() < 16 * 1024; ++i)
+    {
+        chunk += L"[build] compiling src\\terminal\\parser\\stateMachine.cpp";
+        chunk.append(i % 40, L'.');
+        chunk += L"\r\n";
+    }
+    _MeasureThroughput(chunk);
+}
+
+void StateMachinePerfTests::ColoredTextThroughput()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    Log::Comment(L"Short printable runs separated by SGR sequences, like colored compiler output.");
+    std::wstring chunk;
+    while (chunk.size() < 16 * 1024)
+    {
+        chunk += L"\x1b[1;31merror\x1b[0m: \x1b[38;5;208mwarning C4996\x1b[m in file.cpp(12,34)\r\n";
+    }
+    _MeasureThroughput(chunk);
+}
+
+void StateMachinePerfTests::TrueColorCellsThroughput()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    Log::Comment(L"Every cell gets its own 24-bit foreground and background, like an image rendered in the terminal.");
+    std::wstring chunk;
+    for (size_t i = 0; chunk.size() < 16 * 1024; ++i)
+    {
+        const auto r = i % 256;
+        const auto g = (i * 7) % 256;
+        const auto b = (i * 13) % 256;
+        chunk += fmt::format(L"\x1b[38;2;{};{};{};48;2;{};{};{}m\x2580", r, g, b, 255 - r, 255 - g, 255 - b);
+    }
+    _MeasureThroughput(chunk);
+}
+
+void StateMachinePerfTests::MixedSequencesThroughput()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    Log::Comment(L"A mix of the kinds of tokens the fuzzer generates, including invalid and unterminated sequences.");
+    static constexpr std::array<std::wstring_view, 12> tokens{
+        L"\x1b[1;31m",
+        L"\x1b[12;34H",
+        L"\x1b[?25h",
+        L"\x1b[?1049;1h",
+        L"\x1b]0;window title\x07",
+        L"\x1bOP",
+        L"\x1b[2K",
+        L"\x1b[1:2;3m",
+        L"\x1b[!p",
+        L"\x1bP1$r\x1b\\",
+        L"text ",
+        L"\r\n",
+    };
+    std::wstring chunk;
+    for (size_t i = 0; chunk.size() < 16 * 1024; ++i)
+    {
+        chunk += til::at(tokens, (i * 5 + i / tokens.size()) % tokens.size());
+    }
+    _MeasureThroughput(chunk);
+}
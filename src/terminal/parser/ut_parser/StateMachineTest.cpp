@@ -38,6 +38,7 @@ public:
         dcsId = 0;
         dcsParams.clear();
         dcsDataString.clear();
+        dcsDataChunks = 0;
     }
 
     bool ActionExecute(const wchar_t wch) override
@@ -115,7 +116,8 @@ public:
             dcsParams.push_back(parameters.at(i).value_or(0));
         }
         dcsDataString.clear();
-        return [=](const auto ch) { dcsDataString += ch; return true; };
+        dcsDataChunks = 0;
+        return [=](const auto chunk) { dcsDataString += chunk; dcsDataChunks++; return true; };
     }
 
     // These will only be populated if ActionCsiDispatch is called.
@@ -138,6 +140,7 @@ public:
     uint64_t dcsId = 0;
     std::vector<size_t> dcsParams;
     std::wstring dcsDataString;
+    size_t dcsDataChunks = 0;
 };
 
 class Microsoft::Console::VirtualTerminal::StateMachineTest
@@ -159,9 +162,12 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandled);
     TEST_METHOD(RunStorageBeforeEscape);
     TEST_METHOD(BulkTextPrint);
+    TEST_METHOD(BulkTextPrintAroundControlCharacters);
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
+    TEST_METHOD(CompleteControlSequencesDispatchedInOneGo);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
+    TEST_METHOD(DcsDataStringsReceivedInChunks);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachother()
@@ -234,6 +240,35 @@ void StateMachineTest::BulkTextPrint()
     VERIFY_ARE_EQUAL(String(L"12345 Hello World"), String(engine.printed.c_str()));
 }
 
+void StateMachineTest::BulkTextPrintAroundControlCharacters()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // The ground state scans for control characters several at a time.
+    // Make sure we find them no matter where they land relative to that.
+    const std::wstring text{ L"The quick brown fox jumps over the lazy dog." };
+    for (size_t i = 0; i <= text.size(); ++i)
+    {
+        engine.ResetTestState();
+
+        auto input{ text };
+        input.insert(i, 1, L'\n');
+        machine.ProcessString(input);
+
+        VERIFY_ARE_EQUAL(String(text.c_str()), String(engine.printed.c_str()));
+        VERIFY_ARE_EQUAL(String(L"\n"), String(engine.executed.c_str()));
+    }
+
+    // C1 controls and DEL are not printable either.
+    engine.ResetTestState();
+    machine.ProcessString(L"0123456789\x85abcdefghij\x7fklmnopqrst");
+    VERIFY_ARE_EQUAL(String(L"0123456789abcdefghijklmnopqrst"), String(engine.printed.c_str()));
+    VERIFY_ARE_EQUAL(String(L"\x7f"), String(engine.executed.c_str()));
+}
+
 void StateMachineTest::PassThroughUnhandledSplitAcrossWrites()
 {
     auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
@@ -280,6 +315,41 @@ void StateMachineTest::PassThroughUnhandledSplitAcrossWrites()
     VERIFY_ARE_EQUAL(L"", engine.printed);
 }
 
+void StateMachineTest::CompleteControlSequencesDispatchedInOneGo()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // A win32-input-mode key event between text.
+    machine.ProcessString(L"a\x1b[65;30;97;1;0;1_b");
+    VERIFY_ARE_EQUAL(L"ab", engine.printed);
+    VERIFY_ARE_EQUAL(VTID("_"), engine.csiId);
+    VERIFY_ARE_EQUAL(std::vector<size_t>({ 65, 30, 97, 1, 0, 1 }), engine.csiParams);
+
+    // Back to back sequences, with an omitted parameter.
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b[;5H\x1b[2J");
+    VERIFY_ARE_EQUAL(VTID("J"), engine.csiId);
+    VERIFY_ARE_EQUAL(std::vector<size_t>({ 0, 5, 2 }), engine.csiParams);
+
+    // A sequence that's split across writes is parsed like before.
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b[1;2");
+    VERIFY_ARE_EQUAL(uint64_t{ 0 }, engine.csiId);
+    machine.ProcessString(L"3m");
+    VERIFY_ARE_EQUAL(VTID("m"), engine.csiId);
+    VERIFY_ARE_EQUAL(std::vector<size_t>({ 1, 23 }), engine.csiParams);
+
+    // A sequence that's passed through is passed through completely.
+    engine.ResetTestState();
+    engine.pfnFlushToTerminal = std::bind(&StateMachine::FlushToTerminal, &machine);
+    machine.ProcessString(L"x\x1b[1;31my");
+    VERIFY_ARE_EQUAL(L"\x1b[1;31m", engine.passedThrough);
+    VERIFY_ARE_EQUAL(L"xy", engine.printed);
+}
+
 void StateMachineTest::DcsDataStringsReceivedByHandler()
 {
     BEGIN_TEST_METHOD_PROPERTIES()
@@ -342,3 +412,27 @@ void StateMachineTest::DcsDataStringsReceivedByHandler()
     // Verify the control characters were executed (if expected).
     VERIFY_ARE_EQUAL(expectedExecuted, engine.executed);
 }
+
+void StateMachineTest::DcsDataStringsReceivedInChunks()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"The data following the dispatch is handed over in one chunk.");
+    machine.ProcessString(L"\033P1;2;3|data string");
+    VERIFY_ARE_EQUAL(L"data string", engine.dcsDataString);
+    VERIFY_ARE_EQUAL(1u, engine.dcsDataChunks);
+
+    Log::Comment(L"Every write adds another chunk, and ignored characters split them.");
+    machine.ProcessString(L"\r\nmore\x7f data");
+    VERIFY_ARE_EQUAL(L"data string\r\nmore data", engine.dcsDataString);
+    VERIFY_ARE_EQUAL(3u, engine.dcsDataChunks);
+
+    Log::Comment(L"The terminating ESC is a chunk of its own.");
+    machine.ProcessString(L"\033\\printed text");
+    VERIFY_ARE_EQUAL(L"data string\r\nmore data\033", engine.dcsDataString);
+    VERIFY_ARE_EQUAL(4u, engine.dcsDataChunks);
+    VERIFY_ARE_EQUAL(L"printed text", engine.printed);
+}
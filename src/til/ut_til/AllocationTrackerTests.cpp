@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class AllocationTrackerTests
+{
+    TEST_CLASS(AllocationTrackerTests);
+
+    TEST_METHOD(CountsTowardsTheInnermostScope)
+    {
+        const auto parseBefore = til::allocation_tracker::get(til::allocation_region::parse);
+        const auto writeBefore = til::allocation_tracker::get(til::allocation_region::buffer_write);
+
+        Log::Comment(L"Outside of any scope, nothing is counted.");
+        til::allocation_tracker::record(100);
+        VERIFY_ARE_EQUAL(parseBefore.allocations, til::allocation_tracker::get(til::allocation_region::parse).allocations);
+
+        {
+            til::allocation_tracker::scope parse{ til::allocation_region::parse };
+            til::allocation_tracker::record(16);
+            {
+                til::allocation_tracker::scope write{ til::allocation_region::buffer_write };
+                til::allocation_tracker::record(64);
+                til::allocation_tracker::record(64);
+            }
+            Log::Comment(L"Leaving the inner scope goes back to the outer one.");
+            til::allocation_tracker::record(16);
+        }
+        til::allocation_tracker::record(100);
+
+        const auto parse = til::allocation_tracker::get(til::allocation_region::parse) - parseBefore;
+        const auto write = til::allocation_tracker::get(til::allocation_region::buffer_write) - writeBefore;
+        VERIFY_ARE_EQUAL(2u, parse.allocations);
+        VERIFY_ARE_EQUAL(32u, parse.bytes);
+        VERIFY_ARE_EQUAL(2u, write.allocations);
+        VERIFY_ARE_EQUAL(128u, write.bytes);
+    }
+
+    TEST_METHOD(ScopesAreThreadLocal)
+    {
+        const auto paintBefore = til::allocation_tracker::get(til::allocation_region::paint);
+
+        til::allocation_tracker::scope paint{ til::allocation_region::paint };
+        std::thread([]() {
+            til::allocation_tracker::record(8);
+        }).join();
+        til::allocation_tracker::record(8);
+
+        const auto counted = til::allocation_tracker::get(til::allocation_region::paint) - paintBefore;
+        VERIFY_ARE_EQUAL(1u, counted.allocations);
+    }
+};
@@ -5,6 +5,8 @@
 
 #include "til/bitmap.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -632,6 +634,130 @@ class BitmapTests
         _checkBits(expectedSet, bitmap);
     }
 
+    TEST_METHOD(ExclusiveOr)
+    {
+        const til::size sz{ 4, 4 };
+        til::bitmap bitmap{ sz };
+        til::bitmap other{ sz };
+
+        // |1 1|0 0      0 0 0 0      |1 1|0 0
+        // |1 1|0 0  ^   0|1 1|0  =   |1|0|1|0
+        //  0 0 0 0      0|1 1|0       0|1 1|0
+        //  0 0 0 0      0 0 0 0       0 0 0 0
+        bitmap.set(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 2 } });
+        other.set(til::rectangle{ til::point{ 1, 1 }, til::size{ 2, 2 } });
+        bitmap ^= other;
+
+        std::vector<til::rectangle> expectedSet;
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 1, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 2, 1 }, til::size{ 1, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 1, 2 }, til::size{ 2, 1 } });
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Applying the same bitmap twice restores the original.");
+        bitmap ^= other;
+        expectedSet.clear();
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 2 } });
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Bitmaps of different sizes can't be combined.");
+        til::bitmap wrongSize{ til::size{ 2, 2 } };
+        VERIFY_THROWS_SPECIFIC(bitmap ^= wrongSize, wil::ResultException, [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+    }
+
+    TEST_METHOD(ResetRectangles)
+    {
+        const til::size sz{ 4, 4 };
+        til::bitmap bitmap{ sz, true };
+
+        Log::Comment(L"Reset a rectangle in the middle.");
+        // 1 1 1 1        1 1 1 1
+        // 1 1 1 1  --\   1|0 0|1
+        // 1 1 1 1  --/   1|0 0|1
+        // 1 1 1 1        1 1 1 1
+        bitmap.reset(til::rectangle{ til::point{ 1, 1 }, til::size{ 2, 2 } });
+
+        std::vector<til::rectangle> expectedSet;
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 0 }, til::size{ 4, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 1, 2 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 3, 1 }, til::size{ 1, 2 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 3 }, til::size{ 4, 1 } });
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Reset entire rows, which is a single range of bits.");
+        bitmap.reset(til::rectangle{ til::point{ 0, 2 }, til::size{ 4, 2 } });
+
+        expectedSet.clear();
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 0 }, til::size{ 4, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 1, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 3, 1 }, til::size{ 1, 1 } });
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Reset a single point.");
+        bitmap.reset(til::point{ 3, 1 });
+        expectedSet.pop_back();
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Setting entire rows is a single range of bits, too.");
+        bitmap.set(til::rectangle{ til::point{ 0, 2 }, til::size{ 4, 2 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 2 }, til::size{ 4, 2 } });
+        _checkBits(expectedSet, bitmap);
+    }
+
+    TEST_METHOD(TranslateMatchesEveryCell)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"Data:fill", L"{true, false}")
+        END_TEST_METHOD_PROPERTIES()
+
+        bool fill;
+        VERIFY_SUCCEEDED(TestData::TryGetValue(L"fill", fill));
+
+        // A map that's wider than a single block of bits, with an irregular pattern.
+        const til::size sz{ 70, 5 };
+        til::bitmap original{ sz };
+        for (const auto pt : til::rectangle{ sz })
+        {
+            if ((pt.x() * 7 + pt.y() * 3) % 5 < 2)
+            {
+                original.set(pt);
+            }
+        }
+
+        const til::point deltas[]{
+            { 1, 0 },
+            { -1, 0 },
+            { 3, 1 },
+            { -3, 2 },
+            { 69, -1 },
+            { -69, 0 },
+            { 70, 0 },
+            { 5, -5 },
+        };
+
+        for (const auto delta : deltas)
+        {
+            Log::Comment(NoThrowString().Format(L"Translate by %s", delta.to_string().c_str()));
+
+            // Every cell whose origin is within the map gets the origin's bit,
+            // all others are uncovered and get filled.
+            til::bitmap expected{ sz };
+            for (const auto pt : expected._rc)
+            {
+                const auto from = pt - delta;
+                if (original._rc.contains(from) ? original._bits[original._rc.index_of(from)] : fill)
+                {
+                    expected.set(pt);
+                }
+            }
+
+            auto actual = original;
+            actual.translate(delta, fill);
+            VERIFY_ARE_EQUAL(expected, actual);
+        }
+    }
+
     TEST_METHOD(SetResetExceptions)
     {
         til::bitmap map{ til::size{ 4, 4 } };
@@ -1103,4 +1229,66 @@ class BitmapTests
         }
         VERIFY_ARE_EQUAL(expected, actual);
     }
+
+    // The benchmarks below work on the invalidation map of a 300x100 cell
+    // window, like the renderer does for every frame, 10k times over.
+    static constexpr til::size BenchmarkSize{ 300, 100 };
+    static constexpr size_t BenchmarkIterations = 10000;
+
+    template<typename Func>
+    static void _Benchmark(const wchar_t* name, Func func)
+    {
+        til::bitmap map{ BenchmarkSize };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BenchmarkIterations; ++i)
+        {
+            func(map);
+        }
+        const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(NoThrowString().Format(L"%s: %.1f ms for %zu frames", name, delta, BenchmarkIterations));
+    }
+
+    TEST_METHOD(SetRowsBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        _Benchmark(L"set() of every row", [](til::bitmap& map) {
+            map.reset_all();
+            for (ptrdiff_t row = 0; row < BenchmarkSize.height(); ++row)
+            {
+                map.set(til::rectangle{ til::point{ 0, row }, til::size{ BenchmarkSize.width(), 1 } });
+            }
+        });
+    }
+
+    TEST_METHOD(TranslateBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        _Benchmark(L"translate() with a horizontal delta", [](til::bitmap& map) {
+            map.reset_all();
+            map.set(til::rectangle{ til::point{ 10, 10 }, til::size{ 200, 50 } });
+            map.translate(til::point{ 1, -1 }, true);
+        });
+    }
+
+    TEST_METHOD(RunsBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        _Benchmark(L"runs() of a few dirty rows", [](til::bitmap& map) {
+            map.reset_all();
+            map.set(til::rectangle{ til::point{ 0, 40 }, til::size{ BenchmarkSize.width(), 3 } });
+            map.set(til::rectangle{ til::point{ 20, 90 }, til::size{ 5, 1 } });
+            VERIFY_IS_FALSE(map.runs().empty());
+        });
+    }
 };
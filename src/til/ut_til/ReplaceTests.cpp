@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "WexTestClass.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -22,6 +24,8 @@ class ReplaceTests
     TEST_METHOD(ReplaceWstringsInplace);
     TEST_METHOD(ReplaceWstringAndViewsInplace);
 
+    TEST_METHOD(ReplaceBenchmark);
+
     // There are explicitly no winrt::hstring tests here, because it's capital-H
     // hard to get the winrt hstring header included in this project without
     // pulling in all of the winrt machinery.
@@ -130,3 +134,28 @@ void ReplaceTests::ReplaceWstringAndViewsInplace()
     til::replace_needle_in_haystack_inplace(foo, o, zeroZero);
     VERIFY_ARE_EQUAL(L"b0000", foo);
 }
+
+void ReplaceTests::ReplaceBenchmark()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    // Something like a command line of a profile, with a few variables
+    // to expand into longer strings, 100k times over.
+    static constexpr size_t iterations = 100000;
+    const std::wstring commandline{ L"%SystemRoot%\\System32\\wsl.exe -d Ubuntu --cd %USERPROFILE%\\source\\repos %SystemRoot%" };
+
+    std::wstring result;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        result = commandline;
+        til::replace_needle_in_haystack_inplace(result, L"%SystemRoot%", L"C:\\Windows");
+        til::replace_needle_in_haystack_inplace(result, L"%USERPROFILE%", L"C:\\Users\\SomebodyWithALongName");
+    }
+    const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Log::Comment(NoThrowString().Format(L"replace_needle_in_haystack_inplace(): %.1f ms for %zu strings", delta, iterations));
+    VERIFY_ARE_EQUAL(std::wstring::npos, result.find(L'%'));
+}
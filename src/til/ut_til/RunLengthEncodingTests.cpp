@@ -6,6 +6,8 @@
 #include "til/rle.h"
 #include "consoletaeftemplates.hpp"
 
+#include <chrono>
+
 using namespace std::literals;
 using namespace WEX::Common;
 using namespace WEX::Logging;
@@ -429,6 +431,98 @@ class RunLengthEncodingTests
         }
     }
 
+    TEST_METHOD(ReplaceWithValues)
+    {
+        struct TestCase
+        {
+            std::string_view source;
+
+            size_type start_index;
+            std::string_view values;
+
+            std::string_view expected;
+        };
+
+        std::array<TestCase, 8> test_cases{
+            {
+                // empty source
+                { "", 0, "", "" },
+                { "", 0, "1 1 2", "1 1|2" },
+
+                // everything
+                { "1|3 3|2|1 1 1|5 5", 0, "6 6 7 7 7 7 8 8 8", "6 6|7 7 7 7|8 8 8" },
+
+                // beginning, middle and end
+                { "1|3 3|2|1 1 1|5 5", 0, "6 7", "6|7|2|1 1 1|5 5" },
+                { "1|3 3|2|1 1 1|5 5", 2, "6 7 7", "1|3|6|7 7|1 1|5 5" },
+                { "1|3 3|2|1 1 1|5 5", 7, "6 6 6", "1|3 3|2|1 1 1|6 6 6" }, // grows the vector
+
+                // join with predecessor/successor run
+                { "1|3 3|2|1 1 1|5 5", 1, "1 2 2", "1 1|2 2|1 1 1|5 5" },
+                { "1|3 3|2|1 1 1|5 5", 5, "1 5", "1|3 3|2|1 1 1|5 5 5" },
+            }
+        };
+
+        int idx = 0;
+
+        for (const auto& test_case : test_cases)
+        {
+            rle_vector rle{ rle_encode(test_case.source) };
+            const auto values = rle_decode(rle_encode(test_case.values));
+
+            rle.replace(test_case.start_index, { values.data(), values.size() });
+
+            VERIFY_ARE_EQUAL(
+                test_case.expected,
+                rle,
+                NoThrowString().Format(
+                    L"test case:   %d\nsource:      %hs\nstart_index: %u\nvalues:      %hs\nexpected:    %hs\nactual:      %s",
+                    idx,
+                    test_case.source.data(),
+                    test_case.start_index,
+                    test_case.values.data(),
+                    test_case.expected.data(),
+                    rle.to_string().c_str()));
+
+            ++idx;
+        }
+    }
+
+    TEST_METHOD(Assign)
+    {
+        rle_vector rle{ rle_encode("1|3 3|2|1 1 1|5 5") };
+
+        const auto values = rle_decode(rle_encode("4 4 4 4 4 4 4 4 4 4 4 4|6"));
+        rle.assign({ values.data(), values.size() });
+        VERIFY_ARE_EQUAL("4 4 4 4 4 4 4 4 4 4 4 4|6"sv, rle);
+
+        rle.assign({});
+        VERIFY_ARE_EQUAL(""sv, rle);
+        VERIFY_IS_TRUE(rle.empty());
+    }
+
+    TEST_METHOD(FindRunEnd)
+    {
+        // The vectorized search works on blocks of 8 values,
+        // so this covers runs ending in and after the first few blocks.
+        for (size_t length = 1; length <= 40; ++length)
+        {
+            for (size_t tail = 0; tail <= 9; ++tail)
+            {
+                basic_container values(length, 1);
+                values.append(tail, 2);
+
+                const auto begin = values.data();
+                const auto end = begin + values.size();
+                const auto actual = static_cast<size_t>(til::details::find_run_end(begin, end) - begin);
+                VERIFY_ARE_EQUAL(length, actual, NoThrowString().Format(L"length: %zu, tail: %zu", length, tail));
+            }
+        }
+
+        const basic_container empty;
+        VERIFY_ARE_EQUAL(empty.data(), til::details::find_run_end(empty.data(), empty.data()));
+    }
+
     TEST_METHOD(ResizeTrailingExtent)
     {
         constexpr std::string_view data{ "133211155" };
@@ -601,4 +695,69 @@ class RunLengthEncodingTests
             VERIFY_ARE_EQUAL(-static_cast<difference_type>(1), lower - upper);
         }
     }
+
+    // The benchmarks below rewrite a 120 column row, whose attribute changes
+    // every 3 columns like in syntax highlighted output, 100k times over.
+    static constexpr size_type BenchmarkWidth = 120;
+    static constexpr size_t BenchmarkIterations = 100000;
+
+    static basic_container _BenchmarkValues()
+    {
+        basic_container values;
+        for (size_type i = 0; i < BenchmarkWidth; ++i)
+        {
+            values.push_back(static_cast<value_type>(i / 3 % 7));
+        }
+        return values;
+    }
+
+    template<typename Func>
+    static void _Benchmark(const wchar_t* name, Func func)
+    {
+        rle_vector rle(BenchmarkWidth, 0);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BenchmarkIterations; ++i)
+        {
+            func(rle);
+        }
+        const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(NoThrowString().Format(L"%s: %.1f ms for %zu rows (%zu runs)", name, delta, BenchmarkIterations, rle.runs().size()));
+    }
+
+    TEST_METHOD(ReplacePerRunBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const auto values = _BenchmarkValues();
+        _Benchmark(L"replace() per run", [&](rle_vector& rle) {
+            rle.replace(0, BenchmarkWidth, 0);
+            for (size_type begin = 0; begin < BenchmarkWidth;)
+            {
+                const auto end = static_cast<size_type>(values.find_first_not_of(values[begin], begin));
+                const auto clamped = std::min(end, BenchmarkWidth);
+                rle.replace(begin, clamped, values[begin]);
+                begin = clamped;
+            }
+        });
+    }
+
+    TEST_METHOD(ReplaceWithValuesBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const auto values = _BenchmarkValues();
+        _Benchmark(L"replace() with values, partial row", [&](rle_vector& rle) {
+            rle.replace(0, BenchmarkWidth, 0);
+            rle.replace(1, { values.data() + 1, values.size() - 2 });
+        });
+        _Benchmark(L"assign()", [&](rle_vector& rle) {
+            rle.assign({ values.data(), values.size() });
+        });
+    }
 };
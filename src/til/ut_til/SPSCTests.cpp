@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "WexTestClass.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -55,6 +57,8 @@ class SPSCTests
     TEST_METHOD(DropSameRevolutionTest);
     TEST_METHOD(DropDifferentRevolutionTest);
     TEST_METHOD(IntegrationTest);
+
+    TEST_METHOD(ThroughputBenchmark);
 };
 
 void SPSCTests::SmokeTest()
@@ -225,3 +229,61 @@ void SPSCTests::IntegrationTest()
 
     t.join();
 }
+
+void SPSCTests::ThroughputBenchmark()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    // A million items through a channel the size of the one the render
+    // thread uses, once item by item and once in batches.
+    static constexpr int count = 1000000;
+    static constexpr int batch = 64;
+
+    {
+        auto [tx, rx] = til::spsc::channel<int>(1024);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread t([tx = std::move(tx)]() {
+            for (int i = 0; i < count; ++i)
+            {
+                tx.emplace(i);
+            }
+        });
+        int received = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            received += rx.pop().has_value();
+        }
+        t.join();
+        const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(NoThrowString().Format(L"emplace() and pop(): %.1f ms for %d items", delta, count));
+        VERIFY_ARE_EQUAL(count, received);
+    }
+
+    {
+        auto [tx, rx] = til::spsc::channel<int>(1024);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread t([tx = std::move(tx)]() {
+            std::array<int, batch> buffer{};
+            for (int i = 0; i < count; i += batch)
+            {
+                tx.push(buffer.begin(), buffer.end());
+            }
+        });
+        std::array<int, batch> buffer{};
+        size_t received = 0;
+        for (int i = 0; i < count; i += batch)
+        {
+            received += rx.pop_n(buffer.data(), buffer.size()).first;
+        }
+        t.join();
+        const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(NoThrowString().Format(L"push() and pop_n() of %d: %.1f ms for %d items", batch, delta, count));
+        VERIFY_ARE_EQUAL(static_cast<size_t>((count + batch - 1) / batch * batch), received);
+    }
+}
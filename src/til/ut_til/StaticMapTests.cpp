@@ -5,6 +5,8 @@
 
 #include <til/static_map.h>
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -120,4 +122,57 @@ class StaticMapTests
         VERIFY_THROWS(unused = intIntMap[7], std::runtime_error);
 #pragma warning(pop)
     }
+
+    TEST_METHOD(LookupBenchmark)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Names of keys like the ones settings are parsed with, all of them
+        // looked up 100k times over, in an order that isn't sorted.
+        const til::static_map keys{
+            std::pair{ L"background"sv, 0 },
+            std::pair{ L"black"sv, 1 },
+            std::pair{ L"blue"sv, 2 },
+            std::pair{ L"brightBlack"sv, 3 },
+            std::pair{ L"brightBlue"sv, 4 },
+            std::pair{ L"brightCyan"sv, 5 },
+            std::pair{ L"brightGreen"sv, 6 },
+            std::pair{ L"brightPurple"sv, 7 },
+            std::pair{ L"brightRed"sv, 8 },
+            std::pair{ L"brightWhite"sv, 9 },
+            std::pair{ L"brightYellow"sv, 10 },
+            std::pair{ L"cursorColor"sv, 11 },
+            std::pair{ L"cyan"sv, 12 },
+            std::pair{ L"foreground"sv, 13 },
+            std::pair{ L"green"sv, 14 },
+            std::pair{ L"purple"sv, 15 },
+            std::pair{ L"red"sv, 16 },
+            std::pair{ L"selectionBackground"sv, 17 },
+            std::pair{ L"white"sv, 18 },
+            std::pair{ L"yellow"sv, 19 },
+        };
+        const std::vector<std::wstring> lookups{
+            L"yellow", L"background", L"brightRed", L"cyan", L"foreground",
+            L"brightBlack", L"white", L"cursorColor", L"blue", L"selectionBackground",
+            L"purple", L"brightYellow", L"green", L"black", L"brightWhite",
+            L"brightCyan", L"red", L"brightPurple", L"brightBlue", L"brightGreen",
+        };
+
+        static constexpr size_t iterations = 100000;
+        int sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            for (const auto& key : lookups)
+            {
+                sum += keys.at(key);
+            }
+        }
+        const auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(NoThrowString().Format(L"at(): %.1f ms for %zu lookups", delta, iterations * lookups.size()));
+        VERIFY_ARE_EQUAL(190 * static_cast<int>(iterations), sum);
+    }
 };
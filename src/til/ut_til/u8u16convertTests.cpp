@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "WexTestClass.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -17,8 +19,35 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestU8ToU16AsciiRuns);
+    TEST_METHOD(TestU16ToU8AsciiRuns);
+    TEST_METHOD(TestU16ToU8Append);
+
+    TEST_METHOD(ConvertBenchmark);
+
+private:
+    template<typename Func>
+    static void _Benchmark(const wchar_t* name, const size_t bytes, Func func);
 };
 
+// The benchmarks convert 64 KiB of mostly ASCII text, like the output of
+// `ls -l` with the occasional accented letter and box drawing character.
+static constexpr size_t BenchmarkIterations = 1000;
+
+template<typename Func>
+void Utf8Utf16ConvertTests::_Benchmark(const wchar_t* name, const size_t bytes, Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < BenchmarkIterations; ++i)
+    {
+        func();
+    }
+    const auto delta = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto megabytes = static_cast<double>(bytes * BenchmarkIterations) / (1024 * 1024);
+    Log::Comment(NoThrowString().Format(L"%s: %.1f MB in %.3f s: %.1f MB/s", name, megabytes, delta, delta > 0 ? megabytes / delta : 0.0));
+}
+
 void Utf8Utf16ConvertTests::TestU8ToU16()
 {
     const std::string u8String{
@@ -191,3 +220,102 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestU8ToU16AsciiRuns()
+{
+    // ASCII runs are widened separately from the rest of the string. Make sure that
+    // the result doesn't depend on where the runs start and end, by comparing it
+    // with a conversion of the whole string by the platform for various offsets.
+    const std::string_view mixed{ "\xC3\xB6\xE2\x82\xAC\xF0\xA4\xBD\x9C\xFF\xE2\x82" };
+    std::string u8String;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        u8String.append(i, 'a');
+        u8String.append(mixed.substr(0, i % (mixed.size() + 1)));
+    }
+
+    for (size_t offset = 0; offset < 32; ++offset)
+    {
+        const std::string_view in{ std::string_view{ u8String }.substr(offset) };
+
+        std::wstring u16StringComp(in.size(), L'\0');
+        const auto length = MultiByteToWideChar(CP_UTF8, 0, in.data(), gsl::narrow_cast<int>(in.size()), u16StringComp.data(), gsl::narrow_cast<int>(u16StringComp.size()));
+        u16StringComp.resize(gsl::narrow_cast<size_t>(length));
+
+        std::wstring u16Out{};
+        VERIFY_ARE_EQUAL(S_OK, til::u8u16(in, u16Out));
+        VERIFY_ARE_EQUAL(u16StringComp, u16Out);
+    }
+}
+
+void Utf8Utf16ConvertTests::TestU16ToU8AsciiRuns()
+{
+    // Like TestU8ToU16AsciiRuns, but for the ASCII runs narrowed by u16u8.
+    // The mixed part contains an unpaired surrogate, which the platform
+    // replaces, and a surrogate pair that must not be split.
+    const std::wstring_view mixed{ L"\x00f6\x20ac\xd853\xdf5c\xd800\x0080\x07ff" };
+    std::wstring u16String;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        u16String.append(i, L'a');
+        u16String.append(mixed.substr(0, i % (mixed.size() + 1)));
+    }
+
+    for (size_t offset = 0; offset < 32; ++offset)
+    {
+        const std::wstring_view in{ std::wstring_view{ u16String }.substr(offset) };
+
+        std::string u8StringComp(in.size() * 3, '\0');
+        const auto length = WideCharToMultiByte(CP_UTF8, 0, in.data(), gsl::narrow_cast<int>(in.size()), u8StringComp.data(), gsl::narrow_cast<int>(u8StringComp.size()), nullptr, nullptr);
+        u8StringComp.resize(gsl::narrow_cast<size_t>(length));
+
+        std::string u8Out{};
+        VERIFY_ARE_EQUAL(S_OK, til::u16u8(in, u8Out));
+        VERIFY_ARE_EQUAL(u8StringComp, u8Out);
+    }
+}
+
+void Utf8Utf16ConvertTests::TestU16ToU8Append()
+{
+    std::string u8Out{ "prefix" };
+    VERIFY_ARE_EQUAL(S_OK, til::u16u8_append(std::wstring_view{ L"0123456789abcdef\x20ac!" }, u8Out));
+    VERIFY_ARE_EQUAL(std::string{ "prefix0123456789abcdef\xE2\x82\xAC!" }, u8Out);
+
+    Log::Comment(L"Appending nothing leaves the string as it is.");
+    VERIFY_ARE_EQUAL(S_OK, til::u16u8_append(std::wstring_view{}, u8Out));
+    VERIFY_ARE_EQUAL(std::string{ "prefix0123456789abcdef\xE2\x82\xAC!" }, u8Out);
+}
+
+void Utf8Utf16ConvertTests::ConvertBenchmark()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    std::string u8String;
+    while (u8String.size() < 64 * 1024)
+    {
+        u8String += "-rw-r--r-- 1 user group 4096 Jan  1 00:00 r\xC3\xA9sum\xC3\xA9.txt \xE2\x94\x82 12\xE2\x82\xAC\r\n";
+    }
+    std::wstring u16String;
+    VERIFY_ARE_EQUAL(S_OK, til::u8u16(u8String, u16String));
+
+    std::wstring u16Out;
+    _Benchmark(L"u8u16()", u8String.size(), [&]() {
+        (void)til::u8u16(u8String, u16Out);
+    });
+
+    std::string u8Out;
+    _Benchmark(L"u16u8()", u16String.size() * sizeof(wchar_t), [&]() {
+        (void)til::u16u8(u16String, u8Out);
+    });
+
+    Log::Comment(L"The same text, handed over in the 4 KiB chunks a pipe delivers it in.");
+    til::u8state state;
+    _Benchmark(L"u8u16() with state", u8String.size(), [&]() {
+        for (size_t offset = 0; offset < u8String.size(); offset += 4096)
+        {
+            (void)til::u8u16(std::string_view{ u8String }.substr(offset, 4096), u16Out, state);
+        }
+    });
+}
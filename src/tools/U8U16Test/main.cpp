@@ -3,6 +3,7 @@
 // NOTE The functions u8u16 and u16u8 contain own algorithms. Tests have shown that they perform
 // worse than the platform API functions.
 // Thus, these functions are *unrelated* to the til::u8u16 and til::u16u8 implementation.
+// The throughput tests at the end measure til::u8u16 itself, against MultiByteToWideChar.
 
 #include <iostream>
 #include <memory>
@@ -13,6 +14,11 @@
 
 #include "U8U16Test.hpp"
 
+#include <wil/result.h>
+#include <gsl/gsl>
+#include <base/numerics/safe_math.h>
+#include "til/u8u16convert.h"
+
 typedef NTSTATUS(WINAPI* t_RtlUTF8ToUnicodeN)(PWSTR, ULONG, PULONG, PCCH, ULONG);
 typedef NTSTATUS(WINAPI* t_RtlUnicodeToUTF8N)(PCHAR, ULONG, PULONG, PCWSTR, ULONG);
 NTSTATUS(WINAPI* p_RtlUTF8ToUnicodeN)
@@ -442,6 +448,72 @@ void CompNaturalLang_Chunks(const std::string& fileName)
     std::cout << " u16u8_ptr           length " << lenTotalU16U8 << " elapsed " << durTotalU16U8 << std::endl;
 }
 
+std::string LoadRepeated(const std::string& fileName, size_t minLength)
+{
+    std::ostringstream buf{};
+    buf << std::ifstream{ fileName }.rdbuf();
+    const std::string text{ buf.str() };
+    std::string u8Str{};
+    while (!text.empty() && u8Str.length() < minLength)
+    {
+        u8Str += text;
+    }
+    return u8Str;
+}
+
+// prints the throughput in MB of UTF-8 per second
+void PrintThroughput(const char* const name, size_t bytes, double duration)
+{
+    std::cout << " " << name << " " << (duration > 0.0 ? static_cast<double>(bytes) / duration / 1e6 : 0.0) << " MB/s" << std::endl;
+}
+
+void Throughput(const char* const inputName, const std::string& u8Str)
+{
+    std::string head{ __func__ };
+    head += " - ";
+    head += inputName;
+    PrintHeader(head.c_str());
+
+    constexpr size_t iterations{ 20u };
+    // ConptyConnection reads the output of the pseudoconsole in chunks of 4 to 128 KB.
+    constexpr size_t chunkLen{ 4096u };
+    const size_t bytes{ u8Str.length() * iterations };
+
+    std::unique_ptr<wchar_t[]> u16Buffer{ std::make_unique<wchar_t[]>(u8Str.length()) };
+    int length{};
+    GetDuration();
+    for (size_t i{}; i < iterations; ++i)
+    {
+        length = MultiByteToWideChar(65001, 0, u8Str.data(), static_cast<int>(u8Str.length()), u16Buffer.get(), static_cast<int>(u8Str.length()));
+    }
+    PrintThroughput("MultiByteToWideChar      ", bytes, GetDuration());
+
+    std::wstring u16Str{};
+    HRESULT hRes{};
+    GetDuration();
+    for (size_t i{}; i < iterations; ++i)
+    {
+        hRes = til::u8u16(u8Str, u16Str);
+    }
+    PrintThroughput("til::u8u16               ", bytes, GetDuration());
+
+    if (FAILED(hRes) || u16Str.length() != static_cast<size_t>(length) || !std::equal(u16Str.begin(), u16Str.end(), u16Buffer.get()))
+    {
+        std::cerr << " til::u8u16 doesn't match MultiByteToWideChar!" << std::endl;
+    }
+
+    til::u8state state{};
+    GetDuration();
+    for (size_t i{}; i < iterations; ++i)
+    {
+        for (size_t idx{}; idx < u8Str.length(); idx += chunkLen)
+        {
+            hRes = til::u8u16(std::string_view{ u8Str }.substr(idx, chunkLen), u16Str, state);
+        }
+    }
+    PrintThroughput("til::u8u16 (4 KB chunks) ", bytes, GetDuration());
+}
+
 int main()
 {
     // UTF-16 string length
@@ -519,6 +591,20 @@ int main()
     CompNaturalLang_Chunks("ru.txt");
     CompNaturalLang_Chunks("zh.txt");
 
+    std::cout << "\n\n### til::u8u16 Throughput ###" << std::endl;
+
+    constexpr size_t throughputLen{ 16u * 1024u * 1024u };
+    std::string ascii(throughputLen, '\0');
+    for (size_t i{}; i < ascii.length(); ++i)
+    {
+        // printable characters, with a line break every 80 columns
+        ascii[i] = i % 81 == 80 ? '\n' : static_cast<char>(' ' + i % 95);
+    }
+
+    Throughput("ASCII", ascii);
+    Throughput("mixed Latin (fr.txt)", LoadRepeated("fr.txt", throughputLen));
+    Throughput("CJK (zh.txt)", LoadRepeated("zh.txt", throughputLen));
+
     FreeLibrary(ntdll);
     return 0;
 }
@@ -0,0 +1,714 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// conbench - A throughput benchmark for conhost and ConPTY.
+//
+// conbench spawns a copy of itself as the client of either a ConPTY (using
+// the OpenConsole.exe next to it, if there is one) or a classic console
+// window, and has that client drive one of the standard workloads below. It
+// measures how long it takes until the host has processed all of it, and how
+// much CPU the host and the client spent on the way. Every run is reported as
+// a single line of JSON on stdout (or in --output), so that the results can
+// be collected by scripts and tracked for regressions.
+//
+//   conbench.exe [--host conpty|conhost|all] [--workload <name>|all]
+//                [--bytes <n>] [--runs <n>] [--width <n>] [--height <n>]
+//                [--output <file>]
+//
+// Workloads:
+//   write  - WriteConsoleW floods of plain text, VT processing disabled.
+//   sgr    - WriteConsoleW floods of text with a color change every word.
+//   rect   - WriteConsoleOutputW of full viewport rectangles.
+//   scroll - Text written into a scroll region, with lines inserted and deleted.
+//   input  - Key presses read with ReadConsoleInputW. Under a ConPTY they're
+//            written to its input pipe, otherwise the client writes them
+//            itself with WriteConsoleInputW.
+//
+// On the ConPTY, the run ends once the rendered output of the whole workload
+// has been read from the pty. The client finishes every workload with a
+// marker which conbench looks for in the output.
+
+#include <windows.h>
+#include <tlhelp32.h>
+#include <cstdio>
+#include <string>
+#include <wil/Common.h>
+#include <wil/result.h>
+#include <wil/resource.h>
+#include <wil/stl.h>
+#include <wil/win32_helpers.h>
+
+#include "../../inc/conpty-static.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+namespace
+{
+    constexpr std::wstring_view ClientArg{ L"--client" };
+    constexpr std::wstring_view InjectArg{ L"--inject" };
+    constexpr std::string_view DoneMarker{ "conbench-workload-done" };
+    constexpr std::array<std::wstring_view, 5> Workloads{ L"write"sv, L"sgr"sv, L"rect"sv, L"scroll"sv, L"input"sv };
+
+    constexpr DWORD ReadyTimeoutMs{ 30 * 1000 };
+    constexpr DWORD WorkloadTimeoutMs{ 10 * 60 * 1000 };
+    constexpr DWORD OutputTimeoutMs{ 60 * 1000 };
+
+    struct Options
+    {
+        std::vector<std::wstring_view> hosts{ L"conpty"sv, L"conhost"sv };
+        std::vector<std::wstring_view> workloads{ Workloads.begin(), Workloads.end() };
+        size_t bytes{ 16 * 1024 * 1024 };
+        size_t runs{ 3 };
+        SHORT width{ 120 };
+        SHORT height{ 30 };
+        std::wstring output;
+    };
+
+    struct Result
+    {
+        std::chrono::duration<double> elapsed{};
+        double hostCpuSeconds{ 0 };
+        double clientCpuSeconds{ 0 };
+        size_t ptyOutputBytes{ 0 };
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Client side
+
+    // Routine Description:
+    // - Writes the whole string to the console, in pieces of at most 16K
+    //   characters, so that every call stays well within what WriteConsoleW
+    //   accepts at once.
+    // Arguments:
+    // - out - The console output handle.
+    // - str - The text to write.
+    // Return Value:
+    // - The number of bytes passed to WriteConsoleW.
+    size_t _WriteAll(const HANDLE out, const std::wstring_view str)
+    {
+        for (auto remaining = str; !remaining.empty();)
+        {
+            const auto chunk = std::min<size_t>(remaining.size(), 0x4000);
+            DWORD written = 0;
+            THROW_IF_WIN32_BOOL_FALSE(WriteConsoleW(out, remaining.data(), static_cast<DWORD>(chunk), &written, nullptr));
+            THROW_HR_IF(E_UNEXPECTED, written == 0);
+            remaining.remove_prefix(written);
+        }
+        return str.size() * sizeof(wchar_t);
+    }
+
+    // Routine Description:
+    // - Writes the given block of text over and over, until at least the given
+    //   number of bytes was written.
+    // Arguments:
+    // - out - The console output handle.
+    // - block - The text to repeat.
+    // - bytes - How many bytes to write at least.
+    // Return Value:
+    // - The number of bytes passed to WriteConsoleW.
+    size_t _Flood(const HANDLE out, const std::wstring_view block, const size_t bytes)
+    {
+        size_t written = 0;
+        while (written < bytes)
+        {
+            written += _WriteAll(out, block);
+        }
+        return written;
+    }
+
+    size_t _RunWrite(const HANDLE out, const size_t bytes)
+    {
+        THROW_IF_WIN32_BOOL_FALSE(SetConsoleMode(out, ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT));
+
+        std::wstring block;
+        for (auto i = 0; i < 64; ++i)
+        {
+            block += L"The quick brown fox jumps over the lazy dog. 0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~\r\n";
+        }
+        return _Flood(out, block, bytes);
+    }
+
+    size_t _RunSgr(const HANDLE out, const size_t bytes)
+    {
+        THROW_IF_WIN32_BOOL_FALSE(SetConsoleMode(out, ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING));
+
+        // Every word gets its own colors, alternating between the 16 color
+        // palette, the 256 color palette and RGB, with the odd attribute.
+        std::wstring block;
+        wchar_t sgr[64];
+        for (auto line = 0; line < 64; ++line)
+        {
+            for (auto word = 0; word < 10; ++word)
+            {
+                const auto n = line * 10 + word;
+                switch (n % 3)
+                {
+                case 0:
+                    swprintf_s(sgr, L"\x1b[%d;%dm", 30 + n % 8, 40 + (n / 8) % 8);
+                    break;
+                case 1:
+                    swprintf_s(sgr, L"\x1b[1;38;5;%d;48;5;%dm", n % 256, (n * 7) % 256);
+                    break;
+                default:
+                    swprintf_s(sgr, L"\x1b[4;38;2;%d;%d;%dm", n % 256, (n * 3) % 256, (n * 5) % 256);
+                    break;
+                }
+                block += sgr;
+                block += L"lorem ipsum";
+                block += L"\x1b[m ";
+            }
+            block += L"\r\n";
+        }
+        return _Flood(out, block, bytes);
+    }
+
+    size_t _RunRect(const HANDLE out, const size_t bytes)
+    {
+        CONSOLE_SCREEN_BUFFER_INFO csbi{};
+        THROW_IF_WIN32_BOOL_FALSE(GetConsoleScreenBufferInfo(out, &csbi));
+        const auto window = csbi.srWindow;
+        const auto width = static_cast<SHORT>(window.Right - window.Left + 1);
+        const auto height = static_cast<SHORT>(window.Bottom - window.Top + 1);
+
+        std::vector<CHAR_INFO> cells(static_cast<size_t>(width) * height);
+        const auto rectBytes = cells.size() * sizeof(CHAR_INFO);
+
+        size_t written = 0;
+        for (size_t frame = 0; written < bytes; ++frame)
+        {
+            // Shift the pattern every frame, so that every cell changes.
+            for (size_t i = 0; i < cells.size(); ++i)
+            {
+                cells[i].Char.UnicodeChar = static_cast<wchar_t>(L'!' + (i + frame) % 94);
+                cells[i].Attributes = static_cast<WORD>((i / 7 + frame) % 256);
+            }
+
+            auto region = window;
+            THROW_IF_WIN32_BOOL_FALSE(WriteConsoleOutputW(out, cells.data(), { width, height }, { 0, 0 }, &region));
+            written += rectBytes;
+        }
+        return written;
+    }
+
+    size_t _RunScroll(const HANDLE out, const size_t bytes)
+    {
+        THROW_IF_WIN32_BOOL_FALSE(SetConsoleMode(out, ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING));
+
+        CONSOLE_SCREEN_BUFFER_INFO csbi{};
+        THROW_IF_WIN32_BOOL_FALSE(GetConsoleScreenBufferInfo(out, &csbi));
+        const auto height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+
+        // Keep the first and the last line of the viewport out of the scroll
+        // region, like a status line would be.
+        wchar_t margins[32];
+        swprintf_s(margins, L"\x1b[2;%dr\x1b[%d;1H", height - 1, height - 1);
+        size_t written = _WriteAll(out, margins);
+
+        std::wstring block;
+        for (auto i = 0; i < 64; ++i)
+        {
+            block += L"\x1b[32mscrolling\x1b[m inside of the margins, while the status lines stay put\r\n";
+            if (i % 8 == 7)
+            {
+                // Insert and delete lines in the middle of the region.
+                block += L"\x1b[s\x1b[5;1H\x1b[2L\x1b[10;1H\x1b[2M\x1b[u";
+            }
+        }
+        written += _Flood(out, block, bytes);
+
+        written += _WriteAll(out, L"\x1b[r");
+        return written;
+    }
+
+    size_t _RunInput(const HANDLE in, const size_t bytes, const bool inject)
+    {
+        THROW_IF_WIN32_BOOL_FALSE(SetConsoleMode(in, 0));
+
+        const auto keys = bytes;
+        std::vector<INPUT_RECORD> records(512);
+        size_t received = 0;
+        size_t injected = 0;
+        while (received < keys)
+        {
+            if (inject && injected == received)
+            {
+                // Write a batch of key presses and releases, the way a
+                // keyboard would produce them, and read it back below.
+                const auto batch = std::min(records.size() / 2, keys - injected);
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    const auto ch = static_cast<wchar_t>(L'a' + (injected + i) % 26);
+                    auto& down = records[i * 2];
+                    down = {};
+                    down.EventType = KEY_EVENT;
+                    down.Event.KeyEvent.bKeyDown = TRUE;
+                    down.Event.KeyEvent.wRepeatCount = 1;
+                    down.Event.KeyEvent.wVirtualKeyCode = static_cast<WORD>(L'A' + (injected + i) % 26);
+                    down.Event.KeyEvent.uChar.UnicodeChar = ch;
+                    records[i * 2 + 1] = down;
+                    records[i * 2 + 1].Event.KeyEvent.bKeyDown = FALSE;
+                }
+                DWORD written = 0;
+                THROW_IF_WIN32_BOOL_FALSE(WriteConsoleInputW(in, records.data(), static_cast<DWORD>(batch * 2), &written));
+                injected += batch;
+            }
+
+            DWORD read = 0;
+            THROW_IF_WIN32_BOOL_FALSE(ReadConsoleInputW(in, records.data(), static_cast<DWORD>(records.size()), &read));
+            for (DWORD i = 0; i < read; ++i)
+            {
+                const auto& record = records[i];
+                if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown && record.Event.KeyEvent.uChar.UnicodeChar != 0)
+                {
+                    received += record.Event.KeyEvent.wRepeatCount;
+                }
+            }
+        }
+        return keys;
+    }
+
+    // Routine Description:
+    // - The entry point of the client, which runs in the console under test.
+    //   It tells conbench that it's ready, waits for the go and then runs the
+    //   workload to completion.
+    // Arguments:
+    // - workload - The name of the workload to run.
+    // - bytes - How much the workload should write (or, for input, read).
+    // - events - The prefix of the names of the ready and go events.
+    // - inject - Whether the input workload generates its own input.
+    // Return Value:
+    // - The process exit code.
+    int _RunClient(const std::wstring_view workload, const size_t bytes, const std::wstring& events, const bool inject)
+    {
+        const auto out = GetStdHandle(STD_OUTPUT_HANDLE);
+        const auto in = GetStdHandle(STD_INPUT_HANDLE);
+
+        wil::unique_event_nothrow ready{ OpenEventW(EVENT_MODIFY_STATE, FALSE, (events + L"-ready").c_str()) };
+        wil::unique_event_nothrow go{ OpenEventW(SYNCHRONIZE, FALSE, (events + L"-go").c_str()) };
+        THROW_LAST_ERROR_IF(!ready || !go);
+
+        ready.SetEvent();
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), !go.wait(ReadyTimeoutMs));
+
+        if (workload == L"write")
+        {
+            _RunWrite(out, bytes);
+        }
+        else if (workload == L"sgr")
+        {
+            _RunSgr(out, bytes);
+        }
+        else if (workload == L"rect")
+        {
+            _RunRect(out, bytes);
+        }
+        else if (workload == L"scroll")
+        {
+            _RunScroll(out, bytes);
+        }
+        else if (workload == L"input")
+        {
+            _RunInput(in, bytes, inject);
+        }
+        else
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+
+        THROW_IF_WIN32_BOOL_FALSE(SetConsoleMode(out, ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT));
+        DWORD written = 0;
+        const auto marker = L"\r\n" + std::wstring{ DoneMarker.begin(), DoneMarker.end() } + L"\r\n";
+        THROW_IF_WIN32_BOOL_FALSE(WriteConsoleW(out, marker.data(), static_cast<DWORD>(marker.size()), &written, nullptr));
+        return 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Benchmark side
+
+    double _CpuSeconds(const HANDLE process)
+    {
+        FILETIME creation, exit, kernel, user;
+        THROW_IF_WIN32_BOOL_FALSE(GetProcessTimes(process, &creation, &exit, &kernel, &user));
+        const auto ticks = [](const FILETIME& ft) {
+            return static_cast<double>((static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime);
+        };
+        return (ticks(kernel) + ticks(user)) / 1e7;
+    }
+
+    // Routine Description:
+    // - Finds a running child of the given process with one of the given image
+    //   names and opens it. conhost is started by the client of a classic
+    //   console, and by us for a ConPTY, so it has to be looked for.
+    // Arguments:
+    // - parentPid - The process ID of the parent.
+    // - names - The image names to look for, compared case insensitively.
+    // Return Value:
+    // - The child process, or an empty handle if there's none.
+    wil::unique_handle _OpenChildProcess(const DWORD parentPid, std::initializer_list<std::wstring_view> names)
+    {
+        wil::unique_handle snapshot{ CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0) };
+        THROW_LAST_ERROR_IF(snapshot.get() == INVALID_HANDLE_VALUE);
+
+        PROCESSENTRY32W entry{};
+        entry.dwSize = sizeof(entry);
+        for (auto more = Process32FirstW(snapshot.get(), &entry); more; more = Process32NextW(snapshot.get(), &entry))
+        {
+            if (entry.th32ParentProcessID != parentPid)
+            {
+                continue;
+            }
+            for (const auto name : names)
+            {
+                if (CompareStringOrdinal(entry.szExeFile, -1, name.data(), static_cast<int>(name.size()), TRUE) == CSTR_EQUAL)
+                {
+                    return wil::unique_handle{ OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE, FALSE, entry.th32ProcessID) };
+                }
+            }
+        }
+        return {};
+    }
+
+    std::wstring _ClientCommandline(const std::wstring& self, const std::wstring_view workload, const size_t bytes, const std::wstring& events, const bool inject)
+    {
+        auto commandline = L"\"" + self + L"\" " + std::wstring{ ClientArg } + L" " + std::wstring{ workload } + L" " + std::to_wstring(bytes) + L" " + events;
+        if (inject)
+        {
+            commandline += L" " + std::wstring{ InjectArg };
+        }
+        return commandline;
+    }
+
+    // Routine Description:
+    // - Runs the workload once in a client of a ConPTY. The output of the pty
+    //   is read on a separate thread for the whole run, and the input
+    //   workload's key presses are written to its input pipe.
+    Result _RunConpty(const Options& options, const std::wstring& self, const std::wstring_view workload, const std::wstring& events, const HANDLE ready, const HANDLE go)
+    {
+        wil::unique_handle inRead, inWrite, outRead, outWrite;
+        THROW_IF_WIN32_BOOL_FALSE(CreatePipe(inRead.addressof(), inWrite.addressof(), nullptr, 0));
+        THROW_IF_WIN32_BOOL_FALSE(CreatePipe(outRead.addressof(), outWrite.addressof(), nullptr, 0));
+
+        HPCON hpc{};
+        THROW_IF_FAILED(ConptyCreatePseudoConsole({ options.width, options.height }, inRead.get(), outWrite.get(), 0, &hpc));
+        auto closePty = wil::scope_exit([&]() { ConptyClosePseudoConsole(hpc); });
+        inRead.reset();
+        outWrite.reset();
+
+        // Read everything the pty renders, and note when the marker went by.
+        std::atomic<size_t> outputBytes{ 0 };
+        wil::unique_event done{ wil::EventOptions::ManualReset };
+        std::chrono::steady_clock::time_point doneAt{};
+        std::thread reader([&]() {
+            std::string buffer(64 * 1024, '\0');
+            std::string tail;
+            DWORD read = 0;
+            while (ReadFile(outRead.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &read, nullptr) && read != 0)
+            {
+                outputBytes += read;
+                if (!done.is_signaled())
+                {
+                    // Keep the end of the last read, in case the marker is split between two.
+                    tail.append(buffer.data(), read);
+                    if (tail.find(DoneMarker) != std::string::npos)
+                    {
+                        doneAt = std::chrono::steady_clock::now();
+                        done.SetEvent();
+                    }
+                    tail.erase(0, tail.size() > DoneMarker.size() ? tail.size() - DoneMarker.size() : 0);
+                }
+            }
+        });
+        auto joinReader = wil::scope_exit([&]() {
+            // Closing the pty ends its output, which ends the reader.
+            closePty.reset();
+            reader.join();
+        });
+
+        SIZE_T attrListSize = 0;
+        InitializeProcThreadAttributeList(nullptr, 1, 0, &attrListSize);
+        std::vector<std::byte> attrList(attrListSize);
+        const auto pAttrList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attrList.data());
+        THROW_IF_WIN32_BOOL_FALSE(InitializeProcThreadAttributeList(pAttrList, 1, 0, &attrListSize));
+        auto deleteAttrList = wil::scope_exit([&]() { DeleteProcThreadAttributeList(pAttrList); });
+        THROW_IF_WIN32_BOOL_FALSE(UpdateProcThreadAttribute(pAttrList, 0, PROC_THREAD_ATTRIBUTE_PSEUDOCONSOLE, hpc, sizeof(hpc), nullptr, nullptr));
+
+        STARTUPINFOEXW siEx{};
+        siEx.StartupInfo.cb = sizeof(siEx);
+        siEx.lpAttributeList = pAttrList;
+        auto commandline = _ClientCommandline(self, workload, options.bytes, events, false);
+        wil::unique_process_information pi;
+        THROW_IF_WIN32_BOOL_FALSE(CreateProcessW(nullptr, commandline.data(), nullptr, nullptr, FALSE, EXTENDED_STARTUPINFO_PRESENT, nullptr, nullptr, &siEx.StartupInfo, &pi));
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), WaitForSingleObject(ready, ReadyTimeoutMs) != WAIT_OBJECT_0);
+        const auto host = _OpenChildProcess(GetCurrentProcessId(), { L"OpenConsole.exe"sv, L"conhost.exe"sv });
+        THROW_HR_IF_NULL(E_UNEXPECTED, host.get());
+
+        Result result;
+        const auto hostCpuBefore = _CpuSeconds(host.get());
+        const auto clientCpuBefore = _CpuSeconds(pi.hProcess);
+        const auto outputBefore = outputBytes.load();
+        const auto start = std::chrono::steady_clock::now();
+        THROW_IF_WIN32_BOOL_FALSE(SetEvent(go));
+
+        if (workload == L"input")
+        {
+            std::string keys(4096, '\0');
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                keys[i] = static_cast<char>('a' + i % 26);
+            }
+            for (size_t remaining = options.bytes; remaining != 0;)
+            {
+                const auto chunk = std::min(remaining, keys.size());
+                DWORD written = 0;
+                THROW_IF_WIN32_BOOL_FALSE(WriteFile(inWrite.get(), keys.data(), static_cast<DWORD>(chunk), &written, nullptr));
+                remaining -= written;
+            }
+        }
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), WaitForSingleObject(pi.hProcess, WorkloadTimeoutMs) != WAIT_OBJECT_0);
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), !done.wait(OutputTimeoutMs));
+
+        result.elapsed = doneAt - start;
+        result.hostCpuSeconds = _CpuSeconds(host.get()) - hostCpuBefore;
+        result.clientCpuSeconds = _CpuSeconds(pi.hProcess) - clientCpuBefore;
+        result.ptyOutputBytes = outputBytes.load() - outputBefore;
+
+        DWORD exitCode = 0;
+        THROW_IF_WIN32_BOOL_FALSE(GetExitCodeProcess(pi.hProcess, &exitCode));
+        THROW_HR_IF(E_FAIL, exitCode != 0);
+        return result;
+    }
+
+    // Routine Description:
+    // - Runs the workload once in a client of a classic console window. If
+    //   there's an OpenConsole.exe next to us, it's used as the host, so that
+    //   the console of this build is measured. Otherwise it's the inbox conhost.
+    Result _RunConhost(const Options& options, const std::wstring& self, const std::wstring_view workload, const std::wstring& events, const HANDLE ready, const HANDLE go)
+    {
+        const auto openConsole = std::filesystem::path{ self }.replace_filename(L"OpenConsole.exe");
+        const auto useOpenConsole = std::filesystem::exists(openConsole);
+        const auto client = _ClientCommandline(self, workload, options.bytes, events, true);
+
+        auto commandline = useOpenConsole ? L"\"" + openConsole.wstring() + L"\" -ForceNoHandoff -- " + client : client;
+        STARTUPINFOW si{};
+        si.cb = sizeof(si);
+        wil::unique_process_information pi;
+        THROW_IF_WIN32_BOOL_FALSE(CreateProcessW(nullptr, commandline.data(), nullptr, nullptr, FALSE, useOpenConsole ? 0 : CREATE_NEW_CONSOLE, nullptr, nullptr, &si, &pi));
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), WaitForSingleObject(ready, ReadyTimeoutMs) != WAIT_OBJECT_0);
+        wil::unique_handle host;
+        wil::unique_handle clientProcess;
+        if (useOpenConsole)
+        {
+            THROW_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), pi.hProcess, GetCurrentProcess(), host.addressof(), 0, FALSE, DUPLICATE_SAME_ACCESS));
+            clientProcess = _OpenChildProcess(pi.dwProcessId, { std::filesystem::path{ self }.filename().native() });
+        }
+        else
+        {
+            THROW_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), pi.hProcess, GetCurrentProcess(), clientProcess.addressof(), 0, FALSE, DUPLICATE_SAME_ACCESS));
+            host = _OpenChildProcess(pi.dwProcessId, { L"conhost.exe"sv });
+        }
+        THROW_HR_IF_NULL(E_UNEXPECTED, host.get());
+        THROW_HR_IF_NULL(E_UNEXPECTED, clientProcess.get());
+
+        Result result;
+        const auto hostCpuBefore = _CpuSeconds(host.get());
+        const auto clientCpuBefore = _CpuSeconds(clientProcess.get());
+        const auto start = std::chrono::steady_clock::now();
+        THROW_IF_WIN32_BOOL_FALSE(SetEvent(go));
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_TIMEOUT), WaitForSingleObject(clientProcess.get(), WorkloadTimeoutMs) != WAIT_OBJECT_0);
+        result.elapsed = std::chrono::steady_clock::now() - start;
+        result.hostCpuSeconds = _CpuSeconds(host.get()) - hostCpuBefore;
+        result.clientCpuSeconds = _CpuSeconds(clientProcess.get()) - clientCpuBefore;
+
+        DWORD exitCode = 0;
+        THROW_IF_WIN32_BOOL_FALSE(GetExitCodeProcess(clientProcess.get(), &exitCode));
+        THROW_HR_IF(E_FAIL, exitCode != 0);
+        return result;
+    }
+
+    void _PrintResult(FILE* const out, const std::wstring_view host, const std::wstring_view workload, const size_t run, const size_t bytes, const Result& result)
+    {
+        const auto seconds = result.elapsed.count();
+        const auto perByte = [&](const double cpuSeconds) { return cpuSeconds * 1e9 / bytes; };
+        fwprintf(out,
+                 L"{\"host\":\"%.*s\",\"workload\":\"%.*s\",\"run\":%zu,\"bytes\":%zu,\"seconds\":%.6f,"
+                 L"\"mibPerSecond\":%.3f,\"hostCpuSeconds\":%.6f,\"clientCpuSeconds\":%.6f,"
+                 L"\"hostCpuNsPerByte\":%.3f,\"clientCpuNsPerByte\":%.3f,\"ptyOutputBytes\":%zu}\n",
+                 static_cast<int>(host.size()),
+                 host.data(),
+                 static_cast<int>(workload.size()),
+                 workload.data(),
+                 run,
+                 bytes,
+                 seconds,
+                 seconds > 0 ? bytes / seconds / (1024 * 1024) : 0.0,
+                 result.hostCpuSeconds,
+                 result.clientCpuSeconds,
+                 perByte(result.hostCpuSeconds),
+                 perByte(result.clientCpuSeconds),
+                 result.ptyOutputBytes);
+        fflush(out);
+    }
+
+    void _PrintUsage()
+    {
+        fwprintf(stderr,
+                 L"usage: conbench [--host conpty|conhost|all] [--workload write|sgr|rect|scroll|input|all]\n"
+                 L"                [--bytes <n>] [--runs <n>] [--width <n>] [--height <n>] [--output <file>]\n");
+    }
+
+    std::optional<Options> _ParseOptions(const int argc, const wchar_t* const argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::wstring_view arg{ argv[i] };
+            if (i + 1 >= argc)
+            {
+                return std::nullopt;
+            }
+            const std::wstring_view value{ argv[++i] };
+
+            if (arg == L"--host")
+            {
+                if (value == L"all")
+                {
+                    options.hosts = { L"conpty"sv, L"conhost"sv };
+                }
+                else if (value == L"conpty" || value == L"conhost")
+                {
+                    options.hosts = { value };
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (arg == L"--workload")
+            {
+                if (value == L"all")
+                {
+                    options.workloads.assign(Workloads.begin(), Workloads.end());
+                }
+                else if (std::find(Workloads.begin(), Workloads.end(), value) != Workloads.end())
+                {
+                    options.workloads = { value };
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (arg == L"--bytes")
+            {
+                options.bytes = wcstoull(value.data(), nullptr, 0);
+            }
+            else if (arg == L"--runs")
+            {
+                options.runs = wcstoull(value.data(), nullptr, 0);
+            }
+            else if (arg == L"--width")
+            {
+                options.width = static_cast<SHORT>(_wtoi(value.data()));
+            }
+            else if (arg == L"--height")
+            {
+                options.height = static_cast<SHORT>(_wtoi(value.data()));
+            }
+            else if (arg == L"--output")
+            {
+                options.output = value;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (options.bytes == 0 || options.runs == 0 || options.width < 2 || options.height < 3)
+        {
+            return std::nullopt;
+        }
+        return options;
+    }
+
+    int _RunBenchmark(const Options& options)
+    {
+        FILE* out = stdout;
+        wil::unique_file file;
+        if (!options.output.empty())
+        {
+            THROW_HR_IF(E_ACCESSDENIED, _wfopen_s(file.addressof(), options.output.c_str(), L"w") != 0);
+            out = file.get();
+        }
+
+        const auto self = wil::GetModuleFileNameW<std::wstring>(nullptr);
+        size_t eventId = 0;
+        int exitCode = 0;
+        for (const auto host : options.hosts)
+        {
+            for (const auto workload : options.workloads)
+            {
+                for (size_t run = 1; run <= options.runs; ++run)
+                {
+                    const auto events = L"Local\\conbench-" + std::to_wstring(GetCurrentProcessId()) + L"-" + std::to_wstring(eventId++);
+                    const wil::unique_event ready{ CreateEventW(nullptr, TRUE, FALSE, (events + L"-ready").c_str()) };
+                    const wil::unique_event go{ CreateEventW(nullptr, TRUE, FALSE, (events + L"-go").c_str()) };
+                    THROW_LAST_ERROR_IF(!ready || !go);
+
+                    fwprintf(stderr, L"%.*s %.*s run %zu...\n", static_cast<int>(host.size()), host.data(), static_cast<int>(workload.size()), workload.data(), run);
+                    try
+                    {
+                        const auto result = host == L"conpty" ?
+                                                _RunConpty(options, self, workload, events, ready.get(), go.get()) :
+                                                _RunConhost(options, self, workload, events, ready.get(), go.get());
+                        _PrintResult(out, host, workload, run, options.bytes, result);
+                    }
+                    catch (...)
+                    {
+                        fwprintf(stderr, L"  failed: 0x%08x\n", static_cast<unsigned int>(wil::ResultFromCaughtException()));
+                        exitCode = 1;
+                    }
+                }
+            }
+        }
+        return exitCode;
+    }
+}
+
+// bin\x64\Release\conbench.exe --workload sgr --runs 5
+int __cdecl wmain(int argc, WCHAR* argv[])
+try
+{
+    if (argc >= 5 && argv[1] == ClientArg)
+    {
+        const auto inject = argc >= 6 && argv[5] == InjectArg;
+        return _RunClient(argv[2], wcstoull(argv[3], nullptr, 0), argv[4], inject);
+    }
+
+    const auto options = _ParseOptions(argc, argv);
+    if (!options)
+    {
+        _PrintUsage();
+        return 2;
+    }
+    return _RunBenchmark(*options);
+}
+catch (...)
+{
+    fwprintf(stderr, L"conbench failed: 0x%08x\n", static_cast<unsigned int>(wil::ResultFromCaughtException()));
+    return 1;
+}
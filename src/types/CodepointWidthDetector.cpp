@@ -6,321 +6,898 @@
 
 namespace
 {
-    // used to store range data in CodepointWidthDetector's internal map
-    struct UnicodeRange final
-    {
-        unsigned int lowerBound;
-        unsigned int upperBound;
-        CodepointWidth width;
-    };
-
-    static bool operator<(const UnicodeRange& range, const unsigned int searchTerm) noexcept
-    {
-        return range.upperBound < searchTerm;
-    }
+    // The widths of all codepoints are stored in a two-stage lookup table.
+    // Every block of 256 codepoints is stored once in s_widthBlocks, with its widths
+    // packed into 2 bits per codepoint, holding the value of its CodepointWidth.
+    // s_widthBlockIndices then maps the blocks of all codepoints to those, so that
+    // the many identical blocks (like the ones covering CJK ideographs) are shared.
+    static constexpr size_t WidthBlockShift = 8;
+    static constexpr size_t WidthBlockSize = 1 << WidthBlockShift;
+    static constexpr size_t WidthsPerWord = 32;
 
     // Generated by Generate-CodepointWidthsFromUCD.ps1 -Pack:True -Full:False -NoOverrides:False
     // on 10/25/2020 7:32:04 AM (UTC) from Unicode 13.0.0.
     // 321205 (0x4E6B5) codepoints covered.
     // 240 (0xF0) codepoints overridden.
     // Override path: .\src\types\unicode_width_overrides.xml
-    static constexpr std::array<UnicodeRange, 295> s_wideAndAmbiguousTable{
-        UnicodeRange{ 0xa1, 0xa1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xa4, 0xa4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xa7, 0xa8, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xaa, 0xaa, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xad, 0xae, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xb0, 0xb4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xb6, 0xba, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xbc, 0xbf, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xc6, 0xc6, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xd0, 0xd0, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xd7, 0xd8, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xde, 0xe1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xe6, 0xe6, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xe8, 0xea, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xec, 0xed, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xf0, 0xf0, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xf2, 0xf3, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xf7, 0xfa, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xfc, 0xfc, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xfe, 0xfe, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x101, 0x101, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x111, 0x111, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x113, 0x113, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x11b, 0x11b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x126, 0x127, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x12b, 0x12b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x131, 0x133, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x138, 0x138, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x13f, 0x142, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x144, 0x144, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x148, 0x14b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x14d, 0x14d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x152, 0x153, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x166, 0x167, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x16b, 0x16b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1ce, 0x1ce, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1d0, 0x1d0, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1d2, 0x1d2, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1d4, 0x1d4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1d6, 0x1d6, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1d8, 0x1d8, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1da, 0x1da, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1dc, 0x1dc, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x251, 0x251, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x261, 0x261, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2c4, 0x2c4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2c7, 0x2c7, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2c9, 0x2cb, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2cd, 0x2cd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2d0, 0x2d0, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2d8, 0x2db, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2dd, 0x2dd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2df, 0x2df, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x300, 0x36f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x391, 0x3a1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x3a3, 0x3a9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x3b1, 0x3c1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x3c3, 0x3c9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x401, 0x401, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x410, 0x44f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x451, 0x451, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1100, 0x115f, CodepointWidth::Wide },
-        UnicodeRange{ 0x2010, 0x2010, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2013, 0x2016, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2018, 0x2019, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x201c, 0x201d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2020, 0x2022, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2024, 0x2027, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2030, 0x2030, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2032, 0x2033, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2035, 0x2035, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x203b, 0x203b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x203e, 0x203e, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2074, 0x2074, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x207f, 0x207f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2081, 0x2084, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x20ac, 0x20ac, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2103, 0x2103, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2105, 0x2105, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2109, 0x2109, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2113, 0x2113, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2116, 0x2116, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2121, 0x2122, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2126, 0x2126, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x212b, 0x212b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2153, 0x2154, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x215b, 0x215e, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2160, 0x216b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2170, 0x2179, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2189, 0x2189, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2190, 0x2199, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x21b8, 0x21b9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x21d2, 0x21d2, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x21d4, 0x21d4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x21e7, 0x21e7, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2200, 0x2200, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2202, 0x2203, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2207, 0x2208, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x220b, 0x220b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x220f, 0x220f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2211, 0x2211, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2215, 0x2215, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x221a, 0x221a, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x221d, 0x2220, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2223, 0x2223, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2225, 0x2225, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2227, 0x222c, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x222e, 0x222e, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2234, 0x2237, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x223c, 0x223d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2248, 0x2248, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x224c, 0x224c, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2252, 0x2252, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2260, 0x2261, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2264, 0x2267, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x226a, 0x226b, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x226e, 0x226f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2282, 0x2283, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2286, 0x2287, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2295, 0x2295, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2299, 0x2299, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x22a5, 0x22a5, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x22bf, 0x22bf, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2312, 0x2312, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x231a, 0x231b, CodepointWidth::Wide },
-        UnicodeRange{ 0x2329, 0x232a, CodepointWidth::Wide },
-        UnicodeRange{ 0x23e9, 0x23ec, CodepointWidth::Wide },
-        UnicodeRange{ 0x23f0, 0x23f0, CodepointWidth::Wide },
-        UnicodeRange{ 0x23f3, 0x23f3, CodepointWidth::Wide },
-        UnicodeRange{ 0x2460, 0x24e9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x24eb, 0x24ff, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2500, 0x259f, CodepointWidth::Narrow }, // box-drawing and block elements require 1-cell alignment
-        UnicodeRange{ 0x25a0, 0x25a1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25a3, 0x25a9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25b2, 0x25b3, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25b6, 0x25b7, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25bc, 0x25bd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25c0, 0x25c1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25c6, 0x25c8, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25cb, 0x25cb, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25ce, 0x25d1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25e2, 0x25e5, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25ef, 0x25ef, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x25fd, 0x25fe, CodepointWidth::Wide },
-        UnicodeRange{ 0x2605, 0x2606, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2609, 0x2609, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x260e, 0x260f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2614, 0x2615, CodepointWidth::Wide },
-        UnicodeRange{ 0x261c, 0x261c, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x261e, 0x261e, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2640, 0x2640, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2642, 0x2642, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2648, 0x2653, CodepointWidth::Wide },
-        UnicodeRange{ 0x2660, 0x2661, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2663, 0x2665, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2667, 0x266a, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x266c, 0x266d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x266f, 0x266f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x267f, 0x267f, CodepointWidth::Wide },
-        UnicodeRange{ 0x2693, 0x2693, CodepointWidth::Wide },
-        UnicodeRange{ 0x269e, 0x269f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26a1, 0x26a1, CodepointWidth::Wide },
-        UnicodeRange{ 0x26aa, 0x26ab, CodepointWidth::Wide },
-        UnicodeRange{ 0x26bd, 0x26be, CodepointWidth::Wide },
-        UnicodeRange{ 0x26bf, 0x26bf, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26c4, 0x26c5, CodepointWidth::Wide },
-        UnicodeRange{ 0x26c6, 0x26cd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26ce, 0x26ce, CodepointWidth::Wide },
-        UnicodeRange{ 0x26cf, 0x26d3, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26d4, 0x26d4, CodepointWidth::Wide },
-        UnicodeRange{ 0x26d5, 0x26e1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26e3, 0x26e3, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26e8, 0x26e9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26ea, 0x26ea, CodepointWidth::Wide },
-        UnicodeRange{ 0x26eb, 0x26f1, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26f2, 0x26f3, CodepointWidth::Wide },
-        UnicodeRange{ 0x26f4, 0x26f4, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26f5, 0x26f5, CodepointWidth::Wide },
-        UnicodeRange{ 0x26f6, 0x26f9, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26fa, 0x26fa, CodepointWidth::Wide },
-        UnicodeRange{ 0x26fb, 0x26fc, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x26fd, 0x26fd, CodepointWidth::Wide },
-        UnicodeRange{ 0x26fe, 0x26ff, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2705, 0x2705, CodepointWidth::Wide },
-        UnicodeRange{ 0x270a, 0x270b, CodepointWidth::Wide },
-        UnicodeRange{ 0x2728, 0x2728, CodepointWidth::Wide },
-        UnicodeRange{ 0x273d, 0x273d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x274c, 0x274c, CodepointWidth::Wide },
-        UnicodeRange{ 0x274e, 0x274e, CodepointWidth::Wide },
-        UnicodeRange{ 0x2753, 0x2755, CodepointWidth::Wide },
-        UnicodeRange{ 0x2757, 0x2757, CodepointWidth::Wide },
-        UnicodeRange{ 0x2776, 0x277f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2795, 0x2797, CodepointWidth::Wide },
-        UnicodeRange{ 0x27b0, 0x27b0, CodepointWidth::Wide },
-        UnicodeRange{ 0x27bf, 0x27bf, CodepointWidth::Wide },
-        UnicodeRange{ 0x2b1b, 0x2b1c, CodepointWidth::Wide },
-        UnicodeRange{ 0x2b50, 0x2b50, CodepointWidth::Wide },
-        UnicodeRange{ 0x2b55, 0x2b55, CodepointWidth::Wide },
-        UnicodeRange{ 0x2b56, 0x2b59, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x2e80, 0x2e99, CodepointWidth::Wide },
-        UnicodeRange{ 0x2e9b, 0x2ef3, CodepointWidth::Wide },
-        UnicodeRange{ 0x2f00, 0x2fd5, CodepointWidth::Wide },
-        UnicodeRange{ 0x2ff0, 0x2ffb, CodepointWidth::Wide },
-        UnicodeRange{ 0x3000, 0x303e, CodepointWidth::Wide },
-        UnicodeRange{ 0x3041, 0x3096, CodepointWidth::Wide },
-        UnicodeRange{ 0x3099, 0x30ff, CodepointWidth::Wide },
-        UnicodeRange{ 0x3105, 0x312f, CodepointWidth::Wide },
-        UnicodeRange{ 0x3131, 0x318e, CodepointWidth::Wide },
-        UnicodeRange{ 0x3190, 0x31e3, CodepointWidth::Wide },
-        UnicodeRange{ 0x31f0, 0x321e, CodepointWidth::Wide },
-        UnicodeRange{ 0x3220, 0x3247, CodepointWidth::Wide },
-        UnicodeRange{ 0x3248, 0x324f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x3250, 0x4dbf, CodepointWidth::Wide },
-        UnicodeRange{ 0x4dc0, 0x4dff, CodepointWidth::Narrow }, // hexagrams are historically narrow
-        UnicodeRange{ 0x4e00, 0xa48c, CodepointWidth::Wide },
-        UnicodeRange{ 0xa490, 0xa4c6, CodepointWidth::Wide },
-        UnicodeRange{ 0xa960, 0xa97c, CodepointWidth::Wide },
-        UnicodeRange{ 0xac00, 0xd7a3, CodepointWidth::Wide },
-        UnicodeRange{ 0xe000, 0xf8ff, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xf900, 0xfaff, CodepointWidth::Wide },
-        UnicodeRange{ 0xfe00, 0xfe0f, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xfe10, 0xfe19, CodepointWidth::Wide },
-        UnicodeRange{ 0xfe20, 0xfe2f, CodepointWidth::Narrow }, // narrow combining ligatures (split into left/right halves, which take 2 columns together)
-        UnicodeRange{ 0xfe30, 0xfe52, CodepointWidth::Wide },
-        UnicodeRange{ 0xfe54, 0xfe66, CodepointWidth::Wide },
-        UnicodeRange{ 0xfe68, 0xfe6b, CodepointWidth::Wide },
-        UnicodeRange{ 0xff01, 0xff60, CodepointWidth::Wide },
-        UnicodeRange{ 0xffe0, 0xffe6, CodepointWidth::Wide },
-        UnicodeRange{ 0xfffd, 0xfffd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x16fe0, 0x16fe4, CodepointWidth::Wide },
-        UnicodeRange{ 0x16ff0, 0x16ff1, CodepointWidth::Wide },
-        UnicodeRange{ 0x17000, 0x187f7, CodepointWidth::Wide },
-        UnicodeRange{ 0x18800, 0x18cd5, CodepointWidth::Wide },
-        UnicodeRange{ 0x18d00, 0x18d08, CodepointWidth::Wide },
-        UnicodeRange{ 0x1b000, 0x1b11e, CodepointWidth::Wide },
-        UnicodeRange{ 0x1b150, 0x1b152, CodepointWidth::Wide },
-        UnicodeRange{ 0x1b164, 0x1b167, CodepointWidth::Wide },
-        UnicodeRange{ 0x1b170, 0x1b2fb, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f004, 0x1f004, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f0cf, 0x1f0cf, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f100, 0x1f10a, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f110, 0x1f12d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f130, 0x1f169, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f170, 0x1f18d, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f18e, 0x1f18e, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f18f, 0x1f190, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f191, 0x1f19a, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f19b, 0x1f1ac, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x1f1e6, 0x1f202, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f210, 0x1f23b, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f240, 0x1f248, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f250, 0x1f251, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f260, 0x1f265, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f300, 0x1f320, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f32d, 0x1f335, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f337, 0x1f37c, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f37e, 0x1f393, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f3a0, 0x1f3ca, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f3cf, 0x1f3d3, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f3e0, 0x1f3f0, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f3f4, 0x1f3f4, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f3f8, 0x1f43e, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f440, 0x1f440, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f442, 0x1f4fc, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f4ff, 0x1f53d, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f54b, 0x1f54e, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f550, 0x1f567, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f57a, 0x1f57a, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f595, 0x1f596, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f5a4, 0x1f5a4, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f5fb, 0x1f64f, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f680, 0x1f6c5, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f6cc, 0x1f6cc, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f6d0, 0x1f6d2, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f6d5, 0x1f6d7, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f6eb, 0x1f6ec, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f6f4, 0x1f6fc, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f7e0, 0x1f7eb, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f90c, 0x1f93a, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f93c, 0x1f945, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f947, 0x1f978, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f97a, 0x1f9cb, CodepointWidth::Wide },
-        UnicodeRange{ 0x1f9cd, 0x1f9ff, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fa70, 0x1fa74, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fa78, 0x1fa7a, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fa80, 0x1fa86, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fa90, 0x1faa8, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fab0, 0x1fab6, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fac0, 0x1fac2, CodepointWidth::Wide },
-        UnicodeRange{ 0x1fad0, 0x1fad6, CodepointWidth::Wide },
-        UnicodeRange{ 0x20000, 0x2fffd, CodepointWidth::Wide },
-        UnicodeRange{ 0x30000, 0x3fffd, CodepointWidth::Wide },
-        UnicodeRange{ 0xe0100, 0xe01ef, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0xf0000, 0xffffd, CodepointWidth::Ambiguous },
-        UnicodeRange{ 0x100000, 0x10fffd, CodepointWidth::Ambiguous },
+    static constexpr std::array<uint8_t, 4352> s_widthBlockIndices{
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x06, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x05, 0x05, 0x05, 0x0f, 0x05, 0x05, 0x10, 0x11,
+        0x12, 0x13, 0x14, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x16, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x17, 0x05, 0x05, 0x05, 0x05, 0x18, 0x05, 0x05, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x19, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x15, 0x15, 0x05, 0x05, 0x05, 0x1b, 0x1c,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x1d,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x1e, 0x15, 0x15, 0x15, 0x15, 0x1f, 0x20, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x15, 0x21, 0x22, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x05, 0x2b, 0x2c, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x2d,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+        0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x2d,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x2e, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x2f,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+        0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x2f,
+    };
+    static constexpr std::array<uint64_t, 384> s_widthBlocks{
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xaa2aa2aa28228208, 0xa002800200002000, 0x222a80a20a2a200a,
+        0x0080008800000008, 0x800200a80080a000, 0x000000a008aa022a, 0x000000000080a000, 0x0000000000000000, 0x0000000000000000, 0x0222222220000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000800000000, 0x0000000000000008, 0x0000000000000000, 0x0000000000000000, 0x88aa000208a88200, 0x0000000000000000,
+        0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0x00000000aaaaaaaa, 0xaaaaaaa800000000, 0xaaaaaaa8000aaa8a, 0x00000000000aaa8a, 0x0000000000000000,
+        0xaaaaaaaa00000008, 0xaaaaaaaaaaaaaaaa, 0x00000008aaaaaaaa, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0a0a2a8200000000, 0x208008a20000aa2a, 0x0000000000000000, 0x8000020000000000, 0x00000000000002a8, 0x0000000002000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000208000080880, 0x0000000000802028, 0x2a80028000000000, 0x000aaaaa00aaaaaa, 0x000aaaaa00080000, 0x000a000000000000, 0x0000022000000000, 0x0000000000008000,
+        0xa8200808808280a2, 0x0a00aa0022aa8882, 0x0000002002020000, 0x00000000a0a0aa0a, 0x000808000000a0a0, 0x8000000000000800, 0x0000000000000000, 0x0000000000000000,
+        0x0050002000000000, 0x0000000000140000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000004101540000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaa8aaaaa,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0a00a0a0000aaa8a, 0x0000000aa082a00a, 0x1400000080000aa0,
+        0x22000500a0082800, 0x0000000000000000, 0x0000005555550022, 0x400000008a2a8a8a, 0xa000004000000000, 0x9400000000500004, 0xaaaaa9aa9aaaa500, 0xa69aa65aaa9a008a,
+        0x0000000000500400, 0x0800000000010000, 0x0000454011000000, 0xaaaaa00000000000, 0x0000540000000000, 0x4000000100000000, 0x0000000000000000, 0x0000000000000000,
+        0x0140000000000000, 0x0000000000000000, 0x000aa40100000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x5545555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000005555555555,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000055555555555, 0x0055555500000000,
+        0x5555555555555555, 0x1555555555555555, 0x5555555555555554, 0x5555555555555555, 0x5554155555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+        0x5555555555555400, 0x5555555455555555, 0x5555555555555555, 0x5555555555555555, 0x5555555515555555, 0x5555555555555555, 0x5555555555555555, 0x5555555500000055,
+        0x1555555555555555, 0x5555555555555555, 0x55555555aaaa5555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000000000000000, 0x0000000000000000,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555501555555, 0x5555555555555555, 0x0000000000001555, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0155555555555555, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000000000000055, 0x0000000000000000, 0x0000000000000000,
+        0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa,
+        0x00055555aaaaaaaa, 0x5555555500000000, 0x5555551555555555, 0x0000000000551555, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x5555555555555554, 0x5555555555555555, 0x5555555555555555, 0x0000000000000001, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0800000000001555,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000500000155,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000555555555555,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0000055555555555, 0x0000000000000000,
+        0x0000000000015555, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x1555555555555555, 0x0000000000000000, 0x0000001500000000, 0x5555555500005500, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0055555555555555,
+        0x0000000000000100, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000040000000, 0x0000000000000000,
+        0xaaaaaaaa002aaaaa, 0xaaaaaaaa0aaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaa000aaaaa, 0xaa9555569aaaaaaa, 0x0000000002aaaaaa, 0x0000000000000000, 0x5555555555555000,
+        0x5555555500000015, 0x0055555555555555, 0x0000000500015555, 0x0000000000000555, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x5555555555555555, 0x5555455554000001, 0x5555555555555555, 0x5155555555555555, 0x0000005555555555, 0x5555555555555555, 0x0000005540155555, 0x5555010155555555,
+        0x5555555555555555, 0x1555555555555555, 0x5555555555555551, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x4155555555555555,
+        0x5555555555555555, 0x0555555555555555, 0x5555555515400000, 0x0010000000005555, 0x0000140000000000, 0x0000000000000100, 0x0000000000000000, 0x5540000000000000,
+        0x5555555555555555, 0x5555555555555555, 0x0000000055555555, 0x0000000000000000, 0x5555555555555555, 0x5555555555555555, 0x0000541501000555, 0x0155550001400000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000555555,
+        0x5555555555000000, 0x5515555555555555, 0x5555555555554555, 0x5551555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555554555555, 0x5555555555555555,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0015015500000000, 0x5555555500001555, 0x0000155500015555, 0x0000155500000015, 0x0000000000000000,
+        0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x0555555555555555,
+        0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0x00000000aaaaaaaa,
+        0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0x0aaaaaaaaaaaaaaa,
+    };
+
+    static_assert(s_widthBlockIndices.size() == 0x110000 / WidthBlockSize);
+    static_assert(s_widthBlocks.size() % (WidthBlockSize / WidthsPerWord) == 0);
+
+    // The Grapheme_Cluster_Break property of UAX #29, with Extended_Pictographic
+    // folded in as one more value, since the segmentation rules only ever ask
+    // for it on codepoints that would be "Other" otherwise.
+    enum class GraphemeBreak : uint8_t
+    {
+        Other,
+        Control,
+        Extend,
+        ZWJ,
+        RegionalIndicator,
+        Prepend,
+        SpacingMark,
+        L,
+        V,
+        T,
+        LV,
+        LVT,
+        ExtendedPictographic,
     };
+
+    // The grapheme breaks are stored just like the widths above, in blocks of 256
+    // codepoints, but with 4 bits per codepoint. The first stage ends after the
+    // tags in plane 14, since all codepoints past them are "Other".
+    static constexpr size_t GraphemeBreaksPerWord = 16;
+
+    // Grapheme_Cluster_Break and Extended_Pictographic of Unicode 14.0.0.
+    // Generate-CodepointWidthsFromUCD.ps1 -GraphemeBreaks regenerates it.
+    static constexpr std::array<uint8_t, 3600> s_graphemeBlockIndices{
+        0x00, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x10, 0x01, 0x11, 0x01, 0x01, 0x01, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x01, 0x01,
+        0x19, 0x1a, 0x01, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x01, 0x20, 0x01, 0x21, 0x22, 0x23, 0x01, 0x01,
+        0x24, 0x01, 0x25, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x26, 0x01, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e,
+        0x2f, 0x30, 0x31, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+        0x31, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x2b,
+        0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x2b, 0x32, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x33, 0x01, 0x01, 0x34, 0x35,
+        0x01, 0x36, 0x37, 0x38, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x39, 0x01, 0x01, 0x3a, 0x3b, 0x3c,
+        0x3d, 0x3e, 0x3f, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x01, 0x48, 0x49, 0x4a, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x4b, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x4c, 0x4d, 0x01, 0x01, 0x01, 0x4e,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x4f, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x50,
+        0x01, 0x51, 0x52, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x53, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x54, 0x4d, 0x55, 0x01, 0x01, 0x01, 0x01, 0x01, 0x56, 0x57, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x58, 0x59, 0x5a, 0x5b, 0x58, 0x5c, 0x5d, 0x5e, 0x5f, 0x60, 0x58, 0x01, 0x58, 0x58, 0x58, 0x61,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        0x62, 0x63, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64,
+    };
+    static constexpr std::array<uint64_t, 1616> s_graphemeBlocks{
+        0x1111111111111111, 0x1111111111111111, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x1000000000000000,
+        0x1111111111111111, 0x1111111111111111, 0x0c1000c000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000002222222000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x2222222222222220, 0x2222222222222222, 0x2022222222222222, 0x0000000020220220, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000555555, 0x0001022222222222, 0x0000000000000000, 0x0000000000000000, 0x2222200000000000, 0x2222222222222222, 0x0000000000000000, 0x0000000000000002,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2052222222000000, 0x0022220220022222, 0x0000000000000000,
+        0x5000000000000000, 0x0000000000000020, 0x0000000000000000, 0x2222222222222222, 0x0000022222222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x2222222222000000, 0x0000000000000002, 0x0000000000000000, 0x0000000000000000, 0x2222200000000000, 0x0020000000002222,
+        0x0000000000000000, 0x2222202222000000, 0x0022222022202222, 0x0000000000000000, 0x0000000000000000, 0x0000222000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x2222222200000055, 0x0000000000000000, 0x0000000000000000, 0x2222220000000000, 0x2222222222222222, 0x2222222222222522, 0x2222222222222222,
+        0x0000000000006222, 0x0000000000000000, 0x0000000000000000, 0x6602620000000000, 0x6626666222222226, 0x0000000022222220, 0x0000000000002200, 0x0000000000000000,
+        0x0000000000006620, 0x0000000000000000, 0x0000000000000000, 0x6202000000000000, 0x0026600660022226, 0x0000000020000000, 0x0000000000002200, 0x0200000000000000,
+        0x0000000000006220, 0x0000000000000000, 0x0000000000000000, 0x6602000000000000, 0x0022200220000226, 0x0000000000000020, 0x0000000000000000, 0x0000000000200022,
+        0x0000000000006220, 0x0000000000000000, 0x0000000000000000, 0x6602000000000000, 0x0026606220222226, 0x0000000000000000, 0x0000000000002200, 0x2222220000000000,
+        0x0000000000006620, 0x0000000000000000, 0x0000000000000000, 0x2202000000000000, 0x0026600660022226, 0x0000000022200000, 0x0000000000002200, 0x0000000000000000,
+        0x0000000000000200, 0x0000000000000000, 0x0000000000000000, 0x6200000000000000, 0x0026660666000662, 0x0000000020000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000026662, 0x0000000000000000, 0x0000000000000000, 0x2202000000000000, 0x0022220222066662, 0x0000000002200000, 0x0000000000002200, 0x0000000000000000,
+        0x0000000000006620, 0x0000000000000000, 0x0000000000000000, 0x2602000000000000, 0x0022660662066266, 0x0000000002200000, 0x0000000000002200, 0x0000000000000000,
+        0x0000000000006622, 0x0000000000000000, 0x0000000000000000, 0x6202200000000000, 0x0526660666022226, 0x0000000020000000, 0x0000000000002200, 0x0000000000000000,
+        0x0000000000006620, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000020000000000, 0x2666666602022266, 0x0000000000000000, 0x0000000000006600,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000022222226020, 0x0222222220000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0002222222226020, 0x0022222200000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000002200000000, 0x0000000000000000, 0x6600002020200000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x6222222222222220,
+        0x2220000022022222, 0x2222222022222222, 0x2222222222222222, 0x0002222222222222, 0x0000000002000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x2220000000000000, 0x0226622022222262, 0x0000000000000000, 0x2200002266000000, 0x0000000000000002, 0x0000000000022220,
+        0x0020000002260200, 0x0020000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x7777777777777777, 0x7777777777777777, 0x7777777777777777, 0x7777777777777777, 0x7777777777777777, 0x7777777777777777, 0x8888888888888888, 0x8888888888888888,
+        0x8888888888888888, 0x8888888888888888, 0x9999999988888888, 0x9999999999999999, 0x9999999999999999, 0x9999999999999999, 0x9999999999999999, 0x9999999999999999,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2220000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000622200, 0x0000000000000000, 0x0000000000062200, 0x0000000000000000, 0x0000000000002200, 0x0000000000000000, 0x0000000000002200,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x6622222226220000, 0x2222222662666666, 0x0020000000002222, 0x0000000000000000, 0x0000000000000000,
+        0x2122200000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000002200000, 0x0000000000000000, 0x0000002000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000666226666222, 0x0000222666666266, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000266220000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0222222262600000, 0x6662222222200202, 0x2002222222222666,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222222222, 0x0222222222222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000062222, 0x0000000000000000, 0x0000000000000000, 0x6662622222220000, 0x0000000000066266, 0x0000000000000000, 0x2222200000000000, 0x0000000000002222,
+        0x0000000000000622, 0x0000000000000000, 0x0022262266222260, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2626662262000000, 0x0000000000006622,
+        0x0000000000000000, 0x0000000000000000, 0x2222666666660000, 0x0000000022662222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222220222, 0x0020000222222262, 0x0000002260020000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222,
+        0x1132100000000000, 0x0000000000000000, 0x0111111100000000, 0x000c000000000000, 0x000000c000000000, 0x0000000000000000, 0x1111111111011111, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222222222, 0x2222222222222222, 0x0000000000000002,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000c00, 0x000000c000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x000000cccccc0000, 0x00000cc000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000cc0000000000, 0x0000000c00000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000c00000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xc000000000000000, 0x0000000000000000, 0xccccccc000000000, 0x00000ccc0000cccc,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000c00, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000cc0000000000, 0x000000000c000000, 0x000000000000000c, 0x0000000000000000, 0x0000000000000000, 0x0cccc00000000000,
+        0xccccccccc0cccccc, 0xcccccccccccc0ccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0x0000000000cccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccc00cccccc, 0x00c000000c0c0ccc, 0x0000000c000000c0, 0x00000000000cc000, 0x0c0c0000c00c0000, 0x00000000c0ccc000, 0x00000000ccccc000, 0x0000000000000000,
+        0x0000000000000000, 0x00000000ccc00000, 0x00000000000000c0, 0xc00000000000000c, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000cc0000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x00000000ccc00000, 0x000cc00000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000c0000c, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000, 0x0000000000000022,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222222222, 0x2222222222222222,
+        0x0000000000000000, 0x0000000000000000, 0x2222220000000000, 0x00c000000000000c, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000022000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x000000c0c0000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000, 0x0022222222220222,
+        0x0000000000000000, 0x2200000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000022,
+        0x0000200002000200, 0x0000000000000000, 0x0002000062266000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000066, 0x0000000000000000, 0x0000000000000000, 0x6666666666660000, 0x0000000000226666, 0x0000000000000000, 0x2222222222222222, 0x2000000000000022,
+        0x0000000000000000, 0x0000000000000000, 0x0022222222000000, 0x0000000000000000, 0x2222222220000000, 0x0000000000006622, 0x7777777777777777, 0x0007777777777777,
+        0x0000000000006222, 0x0000000000000000, 0x0000000000000000, 0x6622662222662000, 0x0000000000000006, 0x0000000000000000, 0x0000000000200000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x6222222000000000, 0x0000000002266226, 0x0062000000002000, 0x0000000000000000, 0x0000000000000000, 0x0002000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2200000220022202, 0x0000000000000020, 0x0000000000000000, 0x6622600000000000, 0x0000000002600000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0026066266266000, 0x0000000000000000,
+        0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba,
+        0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba,
+        0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbbbbbbbbbb, 0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbabbbb, 0xbbbbbbbbbbbbbbbb, 0xbbbbbbbbbbbbbbba, 0xbbbabbbbbbbbbbbb, 0xbbbbbbbbbbbbbbbb,
+        0xbbbbbbbabbbbbbbb, 0xbbbbbbbbbbbbbbbb, 0x000000000000bbbb, 0x8888888888888888, 0x9999900008888888, 0x9999999999999999, 0x9999999999999999, 0x0000999999999999,
+        0x0000000000000000, 0x0200000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222222222222222, 0x0000000000000000, 0x2222222222222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x1000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x2200000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000111000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0020000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000002, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000022222000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222000002202220, 0x0000000000000000, 0x0000000000000000, 0x2000022200000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000002200000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000022220000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0002200000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222222000000, 0x0000000000000002, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000222200, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000626, 0x0000000000000000, 0x0000000000000000, 0x2222222200000000, 0x0000000002222222, 0x0000000000000000, 0x0000000000000000, 0x2000000000022002,
+        0x0000000000000622, 0x0000000000000000, 0x0000000000000000, 0x0050022662222666, 0x0050000000000200, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000222, 0x0000000000000000, 0x2226222220000000, 0x0000000000022222, 0x0000000006600000, 0x0000000000000000, 0x0000000000000000, 0x0000000000002000,
+        0x0000000000000622, 0x0000000000000000, 0x0000000000000000, 0x6222222222666000, 0x2602222000005506, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x2666000000000000, 0x0200000022626622, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000, 0x0000022222222666, 0x0000000000000000,
+        0x0000000000006622, 0x0000000000000000, 0x0000000000000000, 0x6202200000000000, 0x0066600660066662, 0x0000000020000000, 0x0002222222006600, 0x0000000000022222,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222222266600000, 0x0000000002622266, 0x0200000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2626626222222662, 0x0000000000002262, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x2000000000000000, 0x2622666600222266, 0x0000000000000002, 0x0022000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2626622222222666, 0x0000000000000002, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x6626200000000000, 0x0000000026222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x2220000000000000, 0x0000222226222200, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x2666000000000000, 0x0000022622222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x5262200660666666, 0x0000000000002656, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x6666220022226660, 0x0000000000060002, 0x0000000000000000,
+        0x0000022222222220, 0x0000000000000000, 0x0000000000000000, 0x0222256222222000, 0x0000000020000000, 0x0000222662222220, 0x0000000000000000, 0x0000000000000000,
+        0x2222225555550000, 0x0000002262222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x6000000000000000, 0x2622222202222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x2222222222222200, 0x2222226022222222, 0x0000000002262262, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2022020002222220, 0x0000000025222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0666660000000000, 0x0000000026266022, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000006622000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000111111111, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000022222,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000002222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2000000000000000, 0x6666666666666660, 0x6666666666666666, 0x6666666666666666,
+        0x2000000066666666, 0x0000000000000222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000020000, 0x0000000000000066,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0220000000000000, 0x0000000000001111, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222222222222222, 0x2222222222222222, 0x0022222222222222, 0x2222222222222222, 0x0000000002222222, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2260002226200000, 0x2222211111111222,
+        0x0000222222200222, 0x0000000000000000, 0x0022220000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000022200, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222200002222222, 0x2222222222222222, 0x2222222222222222, 0x0002222222222222, 0x0000000000200000,
+        0x0000000000020000, 0x2222200000000000, 0x2222222222222220, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x2222222202222222, 0x2222200222222222, 0x0000022222022022, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0200000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x2222000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000002222222, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000022222220000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xccc0000000000000, 0x0000000000000000, 0xc000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xcccc000000000000, 0xcc000000000000cc,
+        0x0c00000000000000, 0x00000cccccccccc0, 0xccc0000000000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0x4444444444cccccc, 0x4444444444444444,
+        0xccccccccccccccc0, 0x00000c0000000000, 0xc000000000000000, 0xcccc0ccccccccc00, 0xccccccc000000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0x22222ccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0x00cccccccccccccc, 0xcccccccccc000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xcccccccccccc0000,
+        0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xccccccccccc00000, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccc000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0xcccccccc00000000, 0xcccccc0000000000, 0x0000000000000000, 0x0000000000000000,
+        0xcccccccc00000000, 0x0000000000000000, 0xcc00000000000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccc000000000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccc0ccccccccccc, 0xccccccccc0cccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc,
+        0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccc, 0x00cccccccccccccc,
+        0x1111111111111111, 0x1111111111111111, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222,
+        0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111,
+        0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222,
+        0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x2222222222222222, 0x1111111111111111,
+        0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111,
+        0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111, 0x1111111111111111,
+    };
+
+    static_assert(s_graphemeBlocks.size() % (WidthBlockSize / GraphemeBreaksPerWord) == 0);
+
+    // Routine Description:
+    // - Decodes the codepoint at the given position and moves past it.
+    //   An unpaired surrogate is returned as it is, as a codepoint of its own.
+    constexpr unsigned int decodeCodepoint(const std::wstring_view text, size_t& pos) noexcept
+    {
+        const unsigned int lead = til::at(text, pos++);
+        if ((lead & 0xFC00) == 0xD800 && pos < text.size())
+        {
+            const unsigned int trail = til::at(text, pos);
+            if ((trail & 0xFC00) == 0xDC00)
+            {
+                ++pos;
+                return (((lead & 0x3FF) << 10) | (trail & 0x3FF)) + 0x10000;
+            }
+        }
+        return lead;
+    }
+
+    constexpr GraphemeBreak lookupGraphemeBreak(const unsigned int codepoint) noexcept
+    {
+        if (codepoint >= s_graphemeBlockIndices.size() * WidthBlockSize)
+        {
+            return GraphemeBreak::Other;
+        }
+
+        const auto block = til::at(s_graphemeBlockIndices, codepoint >> WidthBlockShift);
+        const auto offset = codepoint & (WidthBlockSize - 1);
+        const auto word = til::at(s_graphemeBlocks, block * (WidthBlockSize / GraphemeBreaksPerWord) + offset / GraphemeBreaksPerWord);
+        return static_cast<GraphemeBreak>((word >> (offset % GraphemeBreaksPerWord * 4)) & 0b1111);
+    }
+
+    // Routine Description:
+    // - Returns true if there's no grapheme cluster boundary between the two
+    //   codepoints, following the rules GB4 to GB13 of UAX #29.
+    // - GB3 (CR x LF) is left out on purpose: every control character takes up a
+    //   cell of its own when it's written into the buffer.
+    // Arguments:
+    // - prev - the break property of the codepoint before the possible boundary
+    // - next - the break property of the codepoint after it
+    // - pictographicZwj - true if the cluster so far ends in ExtPict Extend* ZWJ
+    // - regionalIndicators - the number of regional indicators the cluster ends with
+    constexpr bool joinsCluster(const GraphemeBreak prev, const GraphemeBreak next, const bool pictographicZwj, const size_t regionalIndicators) noexcept
+    {
+        using GB = GraphemeBreak;
+        if (prev == GB::Control || next == GB::Control)
+        {
+            return false; // GB4, GB5
+        }
+        switch (prev)
+        {
+        case GB::L:
+            if (next == GB::L || next == GB::V || next == GB::LV || next == GB::LVT)
+            {
+                return true; // GB6
+            }
+            break;
+        case GB::LV:
+        case GB::V:
+            if (next == GB::V || next == GB::T)
+            {
+                return true; // GB7
+            }
+            break;
+        case GB::LVT:
+        case GB::T:
+            if (next == GB::T)
+            {
+                return true; // GB8
+            }
+            break;
+        case GB::Prepend:
+            return true; // GB9b
+        default:
+            break;
+        }
+        switch (next)
+        {
+        case GB::Extend:
+        case GB::ZWJ:
+        case GB::SpacingMark:
+            return true; // GB9, GB9a
+        case GB::ExtendedPictographic:
+            return pictographicZwj; // GB11
+        case GB::RegionalIndicator:
+            return regionalIndicators % 2 == 1; // GB12, GB13
+        default:
+            return false; // GB999
+        }
+    }
 }
 
 // Routine Description:
@@ -331,15 +908,95 @@ CodepointWidthDetector::CodepointWidthDetector() noexcept :
 {
 }
 
+// Routine Description:
+// - returns the width type of a grapheme cluster as fast as we can by using quick lookup table and fallback cache.
+// - A cluster is as wide as its first codepoint, unless the rest of it asks for
+//   the emoji presentation of it: a flag made of two regional indicators, or a
+//   pictograph followed by VS16 (U+FE0F). Those are always wide.
+// Arguments:
+// - glyph - the utf16 encoded grapheme cluster to search for, see GetNextCluster
+// Return Value:
+// - the width type of the cluster
+CodepointWidth CodepointWidthDetector::GetWidth(const std::wstring_view glyph) const
+{
+    THROW_HR_IF(E_INVALIDARG, glyph.empty());
+
+    size_t length = 0;
+    const auto first = decodeCodepoint(glyph, length);
+    const auto width = _getCodepointWidth(glyph.substr(0, length));
+    if (width == CodepointWidth::Wide || length == glyph.size())
+    {
+        return width;
+    }
+
+    const auto kind = lookupGraphemeBreak(first);
+    const auto next = decodeCodepoint(glyph, length);
+    if ((kind == GraphemeBreak::RegionalIndicator && lookupGraphemeBreak(next) == GraphemeBreak::RegionalIndicator) ||
+        (kind == GraphemeBreak::ExtendedPictographic && next == 0xFE0F))
+    {
+        return CodepointWidth::Wide;
+    }
+    return width;
+}
+
+// Routine Description:
+// - Returns the first grapheme cluster of the given text, following the
+//   extended grapheme cluster rules of UAX #29. Each cluster is stored in
+//   a single cell (or two, if it's wide) of the text buffer.
+// - Unpaired surrogates form a cluster of their own.
+// Arguments:
+// - text - the utf16 encoded text
+// Return Value:
+// - a view of the first cluster of the text, empty if the text is
+std::wstring_view CodepointWidthDetector::GetNextCluster(const std::wstring_view text) noexcept
+{
+    if (text.size() <= 1)
+    {
+        return text;
+    }
+
+    // Nothing below U+0300 ever joins a cluster, nor is anything joined to it
+    // (but for CR LF, see joinsCluster). This keeps plain text off the tables.
+    if (til::at(text, 0) < 0x300 && til::at(text, 1) < 0x300)
+    {
+        return text.substr(0, 1);
+    }
+
+    size_t end = 0;
+    auto prev = lookupGraphemeBreak(decodeCodepoint(text, end));
+    // The state GB11 and GB12/13 need: whether the cluster ends in
+    // ExtPict Extend* (ZWJ) and how many regional indicators it ends with.
+    auto pictographic = prev == GraphemeBreak::ExtendedPictographic;
+    auto pictographicZwj = false;
+    size_t regionalIndicators = prev == GraphemeBreak::RegionalIndicator ? 1 : 0;
+
+    while (end < text.size())
+    {
+        auto pos = end;
+        const auto next = lookupGraphemeBreak(decodeCodepoint(text, pos));
+        if (!joinsCluster(prev, next, pictographicZwj, regionalIndicators))
+        {
+            break;
+        }
+
+        pictographicZwj = pictographic && next == GraphemeBreak::ZWJ;
+        pictographic = next == GraphemeBreak::ExtendedPictographic || (pictographic && next == GraphemeBreak::Extend);
+        regionalIndicators = next == GraphemeBreak::RegionalIndicator ? regionalIndicators + 1 : 0;
+        prev = next;
+        end = pos;
+    }
+
+    return text.substr(0, end);
+}
+
 // Routine Description:
 // - returns the width type of codepoint as fast as we can by using quick lookup table and fallback cache.
 // Arguments:
 // - glyph - the utf16 encoded codepoint to search for
 // Return Value:
 // - the width type of the codepoint
-CodepointWidth CodepointWidthDetector::GetWidth(const std::wstring_view glyph) const
+CodepointWidth CodepointWidthDetector::_getCodepointWidth(const std::wstring_view glyph) const
 {
-    THROW_HR_IF(E_INVALIDARG, glyph.empty());
     if (glyph.size() == 1)
     {
         // We first attempt to look at our custom quick lookup table of char width preferences.
@@ -404,7 +1061,7 @@ bool CodepointWidthDetector::IsWide(const std::wstring_view glyph) const
 }
 
 // Routine Description:
-// - returns the width type of codepoint by searching the map generated from the unicode spec
+// - returns the width type of codepoint by looking it up in the table generated from the unicode spec
 // Arguments:
 // - glyph - the utf16 encoded codepoint to search for
 // Return Value:
@@ -417,16 +1074,15 @@ CodepointWidth CodepointWidthDetector::_lookupGlyphWidth(const std::wstring_view
     }
 
     const auto codepoint = _extractCodepoint(glyph);
-    const auto it = std::lower_bound(s_wideAndAmbiguousTable.begin(), s_wideAndAmbiguousTable.end(), codepoint);
-
-    // For characters that are not _in_ the table, lower_bound will return the nearest item that is.
-    // We must check its bounds to make sure that our hit was a true hit.
-    if (it != s_wideAndAmbiguousTable.end() && codepoint >= it->lowerBound && codepoint <= it->upperBound)
+    if (codepoint >= s_widthBlockIndices.size() * WidthBlockSize)
     {
-        return it->width;
+        return CodepointWidth::Narrow;
     }
 
-    return CodepointWidth::Narrow;
+    const auto block = til::at(s_widthBlockIndices, codepoint >> WidthBlockShift);
+    const auto offset = codepoint & (WidthBlockSize - 1);
+    const auto word = til::at(s_widthBlocks, block * (WidthBlockSize / WidthsPerWord) + offset / WidthsPerWord);
+    return static_cast<CodepointWidth>((word >> (offset % WidthsPerWord * 2)) & 0b11);
 }
 
 // Routine Description:
@@ -474,16 +1130,17 @@ CodepointWidth CodepointWidthDetector::_lookupGlyphWidthWithCache(const std::wst
 // Arguments:
 // - glyph - the utf16 encoded codepoint to check width of
 // - true if codepoint is wide or false if it is narrow
+// Note:
+// - Like the lookup table, the cache only looks at the first codepoint of the glyph.
 bool CodepointWidthDetector::_checkFallbackViaCache(const std::wstring_view glyph) const
 {
-    const std::wstring findMe{ glyph };
+    const auto codepoint = _extractCodepoint(glyph);
 
-    // TODO: Cache needs to be emptied when font changes.
-    const auto it = _fallbackCache.find(findMe);
+    const auto it = _fallbackCache.find(codepoint);
     if (it == _fallbackCache.end())
     {
         auto result = _pfnFallbackMethod(glyph);
-        _fallbackCache.insert_or_assign(findMe, result);
+        _fallbackCache.emplace(codepoint, result);
         return result;
     }
     else
@@ -25,6 +25,14 @@ bool IsGlyphFullWidth(const wchar_t wch) noexcept
     return widthDetector.IsWide(wch);
 }
 
+// Function Description:
+// - returns the grapheme cluster the given text starts with, which is what
+//      a single cell holds. See CodepointWidthDetector::GetNextCluster
+std::wstring_view GetNextGlyphCluster(const std::wstring_view text) noexcept
+{
+    return CodepointWidthDetector::GetNextCluster(text);
+}
+
 // Function Description:
 // - Sets a function that should be used by the global CodepointWidthDetector
 //      as the fallback mechanism for determining a particular glyph's width,
@@ -23,5 +23,9 @@ namespace Microsoft::Console::Types
         virtual void SignalSelectionChanged() = 0;
         virtual void SignalTextChanged() = 0;
         virtual void SignalCursorChanged() = 0;
+
+        // Returns false if no automation client could receive the signals,
+        // so that they don't need to be computed in the first place.
+        virtual bool IsListening() const noexcept = 0;
     };
 }
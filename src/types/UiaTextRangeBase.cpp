@@ -450,7 +450,19 @@ IFACEMETHODIMP UiaTextRangeBase::GetBoundingRectangles(_Outptr_result_maybenull_
         else
         {
             const auto textRects = buffer.GetTextRects(startAnchor, endAnchor, _blockRange, true);
-
+            coords.reserve(textRects.size() * 4);
+
+            // The font size and the offset of the client area on the screen
+            // are the same for every rect, and getting them can be costly
+            // (in Terminal, the offset comes from the bounding rectangle of
+            // the control). So they're only gotten once, and not per rect.
+            const til::size fontSize{ _getScreenFontSize() };
+            POINT screenOrigin{ 0, 0 };
+            _TranslatePointToScreen(&screenOrigin);
+
+            // Consecutive rows that are entirely in the range are all
+            // covered by a single rect.
+            std::optional<til::rectangle> fullRows;
             for (const auto& rect : textRects)
             {
                 // Convert the buffer coordinates to an equivalent range of
@@ -458,7 +470,35 @@ IFACEMETHODIMP UiaTextRangeBase::GetBoundingRectangles(_Outptr_result_maybenull_
                 const auto lineRendition = buffer.GetLineRendition(rect.Top);
                 til::rectangle r{ BufferToScreenLine(rect, lineRendition) };
                 r -= viewportOrigin;
-                _getBoundingRect(r, coords);
+
+                const auto isFullRow = lineRendition == LineRendition::SingleWidth &&
+                                       rect.Left == bufferSize.Left() &&
+                                       rect.Right == bufferSize.RightInclusive();
+                if (isFullRow && fullRows && fullRows->bottom() == r.top())
+                {
+                    fullRows = til::rectangle{ fullRows->origin(), til::point{ r.right(), r.bottom() } };
+                    continue;
+                }
+
+                if (fullRows)
+                {
+                    _getBoundingRect(*fullRows, fontSize, screenOrigin, coords);
+                    fullRows.reset();
+                }
+
+                if (isFullRow)
+                {
+                    fullRows = r;
+                }
+                else
+                {
+                    _getBoundingRect(r, fontSize, screenOrigin, coords);
+                }
+            }
+
+            if (fullRows)
+            {
+                _getBoundingRect(*fullRows, fontSize, screenOrigin, coords);
             }
         }
 
@@ -468,17 +508,18 @@ IFACEMETHODIMP UiaTextRangeBase::GetBoundingRectangles(_Outptr_result_maybenull_
         {
             return E_OUTOFMEMORY;
         }
-        HRESULT hr = E_UNEXPECTED;
-        for (LONG i = 0; i < gsl::narrow<LONG>(coords.size()); ++i)
+        // The coords are copied in one go, instead of locking the array
+        // for each of them with SafeArrayPutElement.
+        double* data = nullptr;
+        const auto hr = SafeArrayAccessData(*ppRetVal, reinterpret_cast<void**>(&data));
+        if (FAILED(hr))
         {
-            hr = SafeArrayPutElement(*ppRetVal, &i, &coords.at(i));
-            if (FAILED(hr))
-            {
-                SafeArrayDestroy(*ppRetVal);
-                *ppRetVal = nullptr;
-                return hr;
-            }
+            SafeArrayDestroy(*ppRetVal);
+            *ppRetVal = nullptr;
+            return hr;
         }
+        std::copy(coords.cbegin(), coords.cend(), data);
+        SafeArrayUnaccessData(*ppRetVal);
     }
     CATCH_RETURN();
 
@@ -555,20 +596,29 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         auto inclusiveEnd = _end;
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
+        // The text of each row is sliced out of the cache kept by the buffer,
+        // so repeated queries only extract the rows that changed in between.
         const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
-        const auto bufferData = buffer.GetText(true,
-                                               false,
-                                               textRects);
-
-        const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
-        textData.reserve(textDataSize);
-        for (const auto& text : bufferData.text)
+        for (size_t i = 0; i < textRects.size(); ++i)
         {
-            textData += text;
+            const auto& rect = textRects.at(i);
+            const auto rowIndex = gsl::narrow_cast<size_t>(rect.Top);
+            textData.append(buffer.GetCachedRowText(rowIndex, gsl::narrow_cast<size_t>(rect.Left), gsl::narrow_cast<size_t>(rect.Right) + 1));
+
+            // match GetPlainText: rows that were wrapped continue on the next row
+            if (i < textRects.size() - 1 && !buffer.GetRowByOffset(rowIndex).WasWrapForced())
+            {
+                textData.append(L"\r\n");
+            }
+
+            if (maxLength.has_value() && textData.size() >= *maxLength)
+            {
+                break;
+            }
         }
     }
 
-    if (maxLength.has_value())
+    if (maxLength.has_value() && textData.size() > *maxLength)
     {
         textData.resize(*maxLength);
     }
@@ -894,41 +944,29 @@ const Viewport UiaTextRangeBase::_getBufferSize() const noexcept
 }
 
 // Routine Description:
-// - adds the relevant coordinate points from the row to coords.
-// - it is assumed that startAnchor and endAnchor are within the same row
-//    and NOT DEGENERATE
+// - adds the relevant coordinate points from the rect to coords.
 // Arguments:
-// - startAnchor - the start anchor of interested data within the viewport. In text buffer coordinate space. Inclusive.
-// - endAnchor - the end anchor of interested data within the viewport. In text buffer coordinate space. Inclusive
+// - textRect - the cells of interest, relative to the viewport. Exclusive.
+// - fontSize - the size of a cell on the screen, see _getScreenFontSize.
+// - screenOrigin - the origin of the client area on the screen, see _TranslatePointToScreen.
 // - coords - vector to add the calculated coords to
 // Return Value:
 // - <none>
-void UiaTextRangeBase::_getBoundingRect(const til::rectangle textRect, _Inout_ std::vector<double>& coords) const
+void UiaTextRangeBase::_getBoundingRect(const til::rectangle textRect, const til::size fontSize, const POINT screenOrigin, _Inout_ std::vector<double>& coords) const
 {
-    const til::size currentFontSize = _getScreenFontSize();
-
-    POINT topLeft{ 0 };
-    POINT bottomRight{ 0 };
-
     // we want to clamp to a long (output type), not a short (input type)
     // so we need to explicitly say <long,long>
-    topLeft.x = base::ClampMul(textRect.left(), currentFontSize.width());
-    topLeft.y = base::ClampMul(textRect.top(), currentFontSize.height());
-
-    bottomRight.x = base::ClampMul(textRect.right(), currentFontSize.width());
-    bottomRight.y = base::ClampMul(textRect.bottom(), currentFontSize.height());
-
-    // convert the coords to be relative to the screen instead of
-    // the client window
-    _TranslatePointToScreen(&topLeft);
-    _TranslatePointToScreen(&bottomRight);
+    // and we convert the coords to be relative to the screen instead of
+    // the client window on the way.
+    const long left = base::ClampAdd(base::ClampMul(textRect.left(), fontSize.width()), screenOrigin.x);
+    const long top = base::ClampAdd(base::ClampMul(textRect.top(), fontSize.height()), screenOrigin.y);
 
-    const long width = base::ClampSub(bottomRight.x, topLeft.x);
-    const long height = base::ClampSub(bottomRight.y, topLeft.y);
+    const long width = base::ClampMul(textRect.width(), fontSize.width());
+    const long height = base::ClampMul(textRect.height(), fontSize.height());
 
     // insert the coords
-    coords.push_back(topLeft.x);
-    coords.push_back(topLeft.y);
+    coords.push_back(left);
+    coords.push_back(top);
     coords.push_back(width);
     coords.push_back(height);
 }
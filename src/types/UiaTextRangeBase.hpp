@@ -151,7 +151,7 @@ namespace Microsoft::Console::Types
         const unsigned int _getViewportHeight(const SMALL_RECT viewport) const noexcept;
         const Viewport _getBufferSize() const noexcept;
 
-        void _getBoundingRect(const til::rectangle textRect, _Inout_ std::vector<double>& coords) const;
+        void _getBoundingRect(const til::rectangle textRect, const til::size fontSize, const POINT screenOrigin, _Inout_ std::vector<double>& coords) const;
 
         void
         _moveEndpointByUnitCharacter(_In_ const int moveCount,
@@ -36,16 +36,20 @@ public:
     void SetFallbackMethod(std::function<bool(const std::wstring_view)> pfnFallback);
     void NotifyFontChanged() const noexcept;
 
+    static std::wstring_view GetNextCluster(const std::wstring_view text) noexcept;
+
 #ifdef UNIT_TESTING
     friend class CodepointWidthDetectorTests;
 #endif
 
 private:
+    CodepointWidth _getCodepointWidth(const std::wstring_view glyph) const;
     CodepointWidth _lookupGlyphWidth(const std::wstring_view glyph) const;
     CodepointWidth _lookupGlyphWidthWithCache(const std::wstring_view glyph) const noexcept;
     bool _checkFallbackViaCache(const std::wstring_view glyph) const;
     static unsigned int _extractCodepoint(const std::wstring_view glyph) noexcept;
 
-    mutable std::unordered_map<std::wstring, bool> _fallbackCache;
+    // keyed by codepoint, so that looking up a glyph doesn't need to allocate
+    mutable std::unordered_map<unsigned int, bool> _fallbackCache;
     std::function<bool(std::wstring_view)> _pfnFallbackMethod;
 };
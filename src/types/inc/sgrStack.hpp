@@ -47,6 +47,24 @@ namespace Microsoft::Console::VirtualTerminal
         //   combined with currentAttributes.
         const TextAttribute Pop(const TextAttribute& currentAttributes) noexcept;
 
+        // Method Description:
+        // - Determines whether there are any saved attributes left to pop.
+        // Arguments:
+        // - <none>
+        // Return Value:
+        // - True if a call to Pop would leave the attributes unchanged.
+        bool IsEmpty() const noexcept;
+
+        // Method Description:
+        // - Determines whether the entry at the top of the stack replaces every part
+        //   of the attributes, in which case the currentAttributes passed to Pop are
+        //   never consulted and the caller needn't bother retrieving them.
+        // Arguments:
+        // - <none>
+        // Return Value:
+        // - True if the stack is non-empty and its top entry saved the full attributes.
+        bool TopRestoresAllAttributes() const noexcept;
+
         // Xterm allows the save stack to go ten deep, so we'll follow suit.
         static constexpr int c_MaxStoredSgrPushes = 10;
 
@@ -43,6 +43,8 @@ namespace Microsoft::Console::Utils
     GUID GuidFromString(const std::wstring wstr);
     GUID CreateGuid();
 
+    std::chrono::duration<double> TimeSinceProcessStart() noexcept;
+
     std::string ColorToHexString(const til::color color);
     til::color ColorFromHexString(const std::string_view wstr);
     std::optional<til::color> ColorFromXTermColor(const std::wstring_view wstr) noexcept;
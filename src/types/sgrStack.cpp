@@ -65,6 +65,26 @@ namespace Microsoft::Console::VirtualTerminal
         _nextPushIndex = (_nextPushIndex + 1) % gsl::narrow<int>(_storedSgrAttributes.size());
     }
 
+    bool SgrStack::IsEmpty() const noexcept
+    {
+        return _numSavedAttrs == 0;
+    }
+
+    bool SgrStack::TopRestoresAllAttributes() const noexcept
+    {
+        if (_numSavedAttrs == 0)
+        {
+            return false;
+        }
+
+        const auto size = gsl::narrow_cast<int>(_storedSgrAttributes.size());
+        const auto topIndex = (_nextPushIndex + size - 1) % size;
+        const auto& top = til::at(_storedSgrAttributes, topIndex);
+        // Unlike test(), the subscript operator doesn't range check, and All is
+        // always within the bounds of the bitset.
+        return top.ValidParts[static_cast<size_t>(SgrSaveRestoreStackOptions::All)];
+    }
+
     const TextAttribute SgrStack::Pop(const TextAttribute& currentAttributes) noexcept
     {
         if (_numSavedAttrs > 0)
@@ -57,6 +57,30 @@ GUID Utils::CreateGuid()
     return result;
 }
 
+// Function Description:
+// - Measures how long ago the current process was created. Startup events
+//   are traced with this, so that the regions of different modules line up.
+// Return Value:
+// - The time since the process was created, or 0 if that's unknown.
+std::chrono::duration<double> Utils::TimeSinceProcessStart() noexcept
+{
+    FILETIME creation{}, exit{}, kernel{}, user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    {
+        return {};
+    }
+
+    FILETIME now{};
+    GetSystemTimePreciseAsFileTime(&now);
+
+    const auto toTicks = [](const FILETIME& time) noexcept {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    const auto ticks = toTicks(now) - toTicks(creation);
+    // FILETIMEs count in 100ns ticks.
+    return std::chrono::duration<double, std::ratio<1, 10'000'000>>{ static_cast<double>(ticks) };
+}
+
 // Function Description:
 // - Creates a String representation of a color, in the format "#RRGGBB"
 // Arguments:
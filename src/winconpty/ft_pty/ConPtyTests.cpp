@@ -28,7 +28,7 @@ HRESULT _CreatePseudoConsole(const COORD size,
                              const DWORD dwFlags,
                              _Inout_ PseudoConsole* pPty)
 {
-    return _CreatePseudoConsole(INVALID_HANDLE_VALUE, size, hInput, hOutput, dwFlags, pPty);
+    return _CreatePseudoConsole(INVALID_HANDLE_VALUE, size, hInput, hOutput, dwFlags, nullptr, pPty);
 }
 
 HRESULT AttachPseudoConsole(HPCON hPC, LPPROC_THREAD_ATTRIBUTE_LIST lpAttributeList)
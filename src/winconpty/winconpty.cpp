@@ -67,6 +67,7 @@ HRESULT _CreatePseudoConsole(const HANDLE hToken,
                              const HANDLE hInput,
                              const HANDLE hOutput,
                              const DWORD dwFlags,
+                             _In_opt_ const COORD* const pInitialCursor,
                              _Inout_ PseudoConsole* pPty)
 {
     if (pPty == nullptr)
@@ -94,19 +95,32 @@ HRESULT _CreatePseudoConsole(const HANDLE hToken,
     RETURN_IF_WIN32_BOOL_FALSE(SetHandleInformation(signalPipeConhostSide.get(), HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT));
 
     // GH4061: Ensure that the path to executable in the format is escaped so C:\Program.exe cannot collide with C:\Program Files
-    const wchar_t* pwszFormat = L"\"%s\" --headless %s%s%s--width %hu --height %hu --signal 0x%x --server 0x%x";
+    const wchar_t* pwszFormat = L"\"%s\" --headless %s%s%s%s%s%s%s--width %hu --height %hu --signal 0x%x --server 0x%x";
     // This is plenty of space to hold the formatted string
     wchar_t cmd[MAX_PATH]{};
-    const BOOL bInheritCursor = (dwFlags & PSEUDOCONSOLE_INHERIT_CURSOR) == PSEUDOCONSOLE_INHERIT_CURSOR;
+    const BOOL bInheritCursor = pInitialCursor || (dwFlags & PSEUDOCONSOLE_INHERIT_CURSOR) == PSEUDOCONSOLE_INHERIT_CURSOR;
+    // If we already know where the cursor is, conhost doesn't need to ask for it.
+    wchar_t cursorArgs[32]{};
+    if (pInitialCursor)
+    {
+        swprintf_s(cursorArgs, L"--cursorx %hd --cursory %hd ", pInitialCursor->X, pInitialCursor->Y);
+    }
     const BOOL bResizeQuirk = (dwFlags & PSEUDOCONSOLE_RESIZE_QUIRK) == PSEUDOCONSOLE_RESIZE_QUIRK;
     const BOOL bWin32InputMode = (dwFlags & PSEUDOCONSOLE_WIN32_INPUT_MODE) == PSEUDOCONSOLE_WIN32_INPUT_MODE;
+    const BOOL bDiffRendering = (dwFlags & PSEUDOCONSOLE_DIFF_RENDERING) == PSEUDOCONSOLE_DIFF_RENDERING;
+    const BOOL bPassthrough = (dwFlags & PSEUDOCONSOLE_PASSTHROUGH_MODE) == PSEUDOCONSOLE_PASSTHROUGH_MODE;
+    const BOOL bResizeNegotiated = (dwFlags & PSEUDOCONSOLE_RESIZE_NEGOTIATED) == PSEUDOCONSOLE_RESIZE_NEGOTIATED;
     swprintf_s(cmd,
                MAX_PATH,
                pwszFormat,
                _ConsoleHostPath(),
                bInheritCursor ? L"--inheritcursor " : L"",
+               cursorArgs,
                bWin32InputMode ? L"--win32input " : L"",
                bResizeQuirk ? L"--resizeQuirk " : L"",
+               bDiffRendering ? L"--diffRendering " : L"",
+               bPassthrough ? L"--passthrough " : L"",
+               bResizeNegotiated ? L"--resizeNegotiated " : L"",
                size.X,
                size.Y,
                signalPipeConhostSide.get(),
@@ -300,6 +314,51 @@ VOID _ClosePseudoConsole(_In_ PseudoConsole* pPty)
     }
 }
 
+// Function Description:
+// - Creates a pseudoconsole and packs it into a HPCON. Shared by the various
+//      CreatePseudoConsole functions below.
+// Arguments:
+// - See _CreatePseudoConsole.
+// - phPC: Receives the new pseudoconsole.
+// Return Value:
+// - S_OK if the call succeeded, else an appropriate HRESULT for failing
+static HRESULT _CreateAndPackPseudoConsole(const HANDLE hToken,
+                                           const COORD size,
+                                           const HANDLE hInput,
+                                           const HANDLE hOutput,
+                                           const DWORD dwFlags,
+                                           _In_opt_ const COORD* const pInitialCursor,
+                                           _Out_ HPCON* phPC)
+{
+    if (phPC == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+    *phPC = nullptr;
+    if ((!_HandleIsValid(hInput)) && (!_HandleIsValid(hOutput)))
+    {
+        return E_INVALIDARG;
+    }
+
+    PseudoConsole* pPty = (PseudoConsole*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(PseudoConsole));
+    RETURN_IF_NULL_ALLOC(pPty);
+    auto cleanupPty = wil::scope_exit([&]() noexcept {
+        _ClosePseudoConsole(pPty);
+    });
+
+    wil::unique_handle duplicatedInput;
+    wil::unique_handle duplicatedOutput;
+    RETURN_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), hInput, GetCurrentProcess(), duplicatedInput.addressof(), 0, TRUE, DUPLICATE_SAME_ACCESS));
+    RETURN_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), hOutput, GetCurrentProcess(), duplicatedOutput.addressof(), 0, TRUE, DUPLICATE_SAME_ACCESS));
+
+    RETURN_IF_FAILED(_CreatePseudoConsole(hToken, size, duplicatedInput.get(), duplicatedOutput.get(), dwFlags, pInitialCursor, pPty));
+
+    *phPC = (HPCON)pPty;
+    cleanupPty.release();
+
+    return S_OK;
+}
+
 // These functions are defined in the console l1 apiset, which is generated from
 //      the consoleapi.apx file in minkernel\apiset\libs\Console.
 
@@ -343,33 +402,27 @@ extern "C" HRESULT ConptyCreatePseudoConsoleAsUser(_In_ HANDLE hToken,
                                                    _In_ DWORD dwFlags,
                                                    _Out_ HPCON* phPC)
 {
-    if (phPC == nullptr)
-    {
-        return E_INVALIDARG;
-    }
-    *phPC = nullptr;
-    if ((!_HandleIsValid(hInput)) && (!_HandleIsValid(hOutput)))
-    {
-        return E_INVALIDARG;
-    }
-
-    PseudoConsole* pPty = (PseudoConsole*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(PseudoConsole));
-    RETURN_IF_NULL_ALLOC(pPty);
-    auto cleanupPty = wil::scope_exit([&]() noexcept {
-        _ClosePseudoConsole(pPty);
-    });
-
-    wil::unique_handle duplicatedInput;
-    wil::unique_handle duplicatedOutput;
-    RETURN_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), hInput, GetCurrentProcess(), duplicatedInput.addressof(), 0, TRUE, DUPLICATE_SAME_ACCESS));
-    RETURN_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(), hOutput, GetCurrentProcess(), duplicatedOutput.addressof(), 0, TRUE, DUPLICATE_SAME_ACCESS));
-
-    RETURN_IF_FAILED(_CreatePseudoConsole(hToken, size, duplicatedInput.get(), duplicatedOutput.get(), dwFlags, pPty));
+    return _CreateAndPackPseudoConsole(hToken, size, hInput, hOutput, dwFlags, nullptr, phPC);
+}
 
-    *phPC = (HPCON)pPty;
-    cleanupPty.release();
+// NOTE: This one is not defined in the Windows headers either.
 
-    return S_OK;
+// Function Description:
+// Creates a pseudoconsole like CreatePseudoConsole with INHERIT_CURSOR, but
+//      for callers that already know where their cursor is. The position is
+//      passed to the conpty up front, so it doesn't have to request it with
+//      a "Device Status Request" and wait for the reply before it starts.
+// `cursor` is the 0-based column and row of the cursor within the terminal's
+//      viewport, the same that'd be sent as "\x1b[<r+1>;<c+1>R".
+extern "C" HRESULT WINAPI ConptyCreatePseudoConsoleWithCursor(_In_ COORD size,
+                                                              _In_ HANDLE hInput,
+                                                              _In_ HANDLE hOutput,
+                                                              _In_ DWORD dwFlags,
+                                                              _In_ COORD cursor,
+                                                              _Out_ HPCON* phPC)
+{
+    RETURN_HR_IF(E_INVALIDARG, cursor.X < 0 || cursor.Y < 0);
+    return _CreateAndPackPseudoConsole(INVALID_HANDLE_VALUE, size, hInput, hOutput, dwFlags, &cursor, phPC);
 }
 
 // Function Description:
@@ -24,6 +24,9 @@ typedef struct _PseudoConsole
 // #define PSEUDOCONSOLE_INHERIT_CURSOR (0x1)
 #define PSEUDOCONSOLE_RESIZE_QUIRK (0x2)
 #define PSEUDOCONSOLE_WIN32_INPUT_MODE (0x4)
+#define PSEUDOCONSOLE_DIFF_RENDERING (0x8)
+#define PSEUDOCONSOLE_PASSTHROUGH_MODE (0x10)
+#define PSEUDOCONSOLE_RESIZE_NEGOTIATED (0x20)
 
 // Implementations of the various PseudoConsole functions.
 HRESULT _CreatePseudoConsole(const HANDLE hToken,
@@ -31,6 +34,7 @@ HRESULT _CreatePseudoConsole(const HANDLE hToken,
                              const HANDLE hInput,
                              const HANDLE hOutput,
                              const DWORD dwFlags,
+                             _In_opt_ const COORD* const pInitialCursor,
                              _Inout_ PseudoConsole* pPty);
 
 HRESULT _ResizePseudoConsole(_In_ const PseudoConsole* const pPty, _In_ const COORD size);
@@ -44,6 +48,13 @@ HRESULT ConptyCreatePseudoConsoleAsUser(_In_ HANDLE hToken,
                                         _In_ DWORD dwFlags,
                                         _Out_ HPCON* phPC);
 
+HRESULT WINAPI ConptyCreatePseudoConsoleWithCursor(_In_ COORD size,
+                                                   _In_ HANDLE hInput,
+                                                   _In_ HANDLE hOutput,
+                                                   _In_ DWORD dwFlags,
+                                                   _In_ COORD cursor,
+                                                   _Out_ HPCON* phPC);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,10 +5,14 @@
 # (we use the null coalescing operator)
 
 ################################################################################
-# This script generates the an array suitable for replacing the body of
+# This script generates the lookup tables suitable for replacing the body of
 # src/types/CodepointWidthDetector.cpp from a Unicode UCD XML document[1]
 # compliant with UAX#42[2].
 #
+# The tables form a two-stage lookup: every block of 256 codepoints has its
+# widths packed into 2 bits per codepoint, identical blocks are only stored
+# once, and a first stage maps every block of the codespace to one of them.
+#
 # This script supports a quasi-mandatory "overrides" file, overrides.xml.
 # If you do not have overrides, supply the -NoOverrides parameter. This was
 # developed for use with the CodepointWidthDetector, which has some override
@@ -23,8 +27,13 @@
 # Invoke as ./Generate-xxx ucd.nounihan.flat.xml -Pack | Out-File -Encoding
 #           UTF-8 Temporary.cpp
 #
+# With -GraphemeBreaks, it generates the grapheme break tables next to them
+# instead, from the Grapheme_Cluster_Break (UAX#29[3]) and Extended_Pictographic
+# properties. Those use the same two-stage layout, with 4 bits per codepoint.
+#
 # [1]: https://www.unicode.org/Public/UCD/latest/ucdxml/
 # [2]: https://www.unicode.org/reports/tr42/
+# [3]: https://www.unicode.org/reports/tr29/
 
 [Diagnostics.CodeAnalysis.SuppressMessageAttribute('PSAvoidUsingPositionalParameters', '')]
 [Diagnostics.CodeAnalysis.SuppressMessageAttribute('PSUseProcessBlockForPipelineCommand', '')]
@@ -44,7 +53,8 @@ Param(
 
     [switch]$Pack, # Pack tightly based on width
     [switch]$NoOverrides, # Do not include overrides
-    [switch]$Full = $False # Include Narrow codepoints
+    [switch]$Full = $False, # Include Narrow codepoints
+    [switch]$GraphemeBreaks # Generate the grapheme break tables instead
 )
 
 Enum CodepointWidth {
@@ -224,6 +234,73 @@ $UCDRepertoire = $InputObject.ucd.repertoire.ChildNodes | Sort-Object {
     }
 }
 
+If ($GraphemeBreaks) {
+    # The values of the GraphemeBreak enum in CodepointWidthDetector.cpp.
+    $breakValues = @{
+        "XX" = 0; "CN" = 1; "CR" = 1; "LF" = 1; "EX" = 2; "ZWJ" = 3; "RI" = 4; "PP" = 5;
+        "SM" = 6; "L" = 7; "V" = 8; "T" = 9; "LV" = 10; "LVT" = 11
+    }
+    $ExtendedPictographic = 12
+
+    $BlockSize = 256
+    $BreaksPerWord = 16
+    $breaks = [byte[]]::new(0x110000)
+    $last = 0
+    ForEach($v in $UCDRepertoire) {
+        $s, $e = Get-UCDEntryRange $v
+        $value = $breakValues[$v.GCB] ?? 0
+        If ($value -eq 0 -and $v.ExtPict -eq "Y") {
+            $value = $ExtendedPictographic
+        }
+        If ($value -ne 0) {
+            For($i = $s; $i -le $e; $i++) {
+                $breaks[$i] = [byte]$value
+            }
+            $last = [Math]::Max($last, $e)
+        }
+    }
+
+    "    // Generated by {0} -GraphemeBreaks" -f $MyInvocation.MyCommand.Name
+    "    // on {0} (UTC) from {1}." -f (Get-Date -AsUTC), $InputObject.ucd.description
+
+    # Everything past the last block with anything but "Other" in it is left out.
+    $blockIndices = [System.Collections.Generic.List[int]]::New()
+    $blocks = [System.Collections.Generic.List[string[]]]::New()
+    $blockLookup = @{}
+    For($base = 0; $base -le $last; $base += $BlockSize) {
+        $words = For($w = 0; $w -lt $BlockSize / $BreaksPerWord; $w++) {
+            [uint64]$word = 0
+            For($i = 0; $i -lt $BreaksPerWord; $i++) {
+                $word = $word -bor ([uint64]$breaks[$base + $w * $BreaksPerWord + $i] -shl ($i * 4))
+            }
+            "0x{0:x16}," -f $word
+        }
+        $key = $words -join " "
+        If (-not $blockLookup.ContainsKey($key)) {
+            $blockLookup[$key] = $blocks.Count
+            $blocks.Add($words)
+        }
+        $blockIndices.Add($blockLookup[$key])
+    }
+
+    If ($blocks.Count -gt 256) {
+        Throw "The first stage only holds 8-bit block indices, but {0} blocks are needed." -f $blocks.Count
+    }
+
+    "    static constexpr std::array<uint8_t, {0}> s_graphemeBlockIndices{{" -f $blockIndices.Count
+    For($i = 0; $i -lt $blockIndices.Count; $i += 16) {
+        "        " + (($blockIndices.GetRange($i, [Math]::Min(16, $blockIndices.Count - $i)) | ForEach-Object { "0x{0:x2}," -f $_ }) -join " ")
+    }
+    "    };"
+    "    static constexpr std::array<uint64_t, {0}> s_graphemeBlocks{{" -f ($blocks.Count * $BlockSize / $BreaksPerWord)
+    ForEach($_ in $blocks) {
+        "        " + ($_[0..7] -join " ")
+        "        " + ($_[8..15] -join " ")
+    }
+    "    };"
+    Return
+}
+
 If (-not $Full) {
     $UCDRepertoire = $UCDRepertoire | Where-Object {
         # Select everything Wide/Ambiguous/Full OR Emoji w/ Emoji Presentation
@@ -268,13 +345,48 @@ If (-not $NoOverrides) {
 "    // {0} (0x{0:X}) codepoints overridden." -f $overrideCount
 "    // Override path: {0}" -f $OverridePath
 }
-"    static constexpr std::array<UnicodeRange, {0}> s_wideAndAmbiguousTable{{" -f $ranges.Count
+
+# Expand the ranges into the width of every codepoint...
+$BlockSize = 256
+$WidthsPerWord = 32
+$widths = [byte[]]::new(0x110000)
 ForEach($_ in $ranges) {
-    $comment = ""
-    if ($null -ne $_.Comment) {
-        # We only vend comments when we aren't packing tightly
-        $comment = " // {0}" -f $_.Comment
+    For($i = $_.Start; $i -le $_.End; $i++) {
+        $widths[$i] = [byte]$_.Width
+    }
+}
+
+# ...and pack them into blocks, sharing identical ones.
+$blockIndices = [System.Collections.Generic.List[int]]::New(0x110000 / $BlockSize)
+$blocks = [System.Collections.Generic.List[string]]::New()
+$blockLookup = @{}
+For($base = 0; $base -lt $widths.Length; $base += $BlockSize) {
+    $words = For($w = 0; $w -lt $BlockSize / $WidthsPerWord; $w++) {
+        [uint64]$word = 0
+        For($i = 0; $i -lt $WidthsPerWord; $i++) {
+            $word = $word -bor ([uint64]$widths[$base + $w * $WidthsPerWord + $i] -shl ($i * 2))
+        }
+        "0x{0:x16}" -f $word
     }
-"        UnicodeRange{{ 0x{0:x}, 0x{1:x}, CodepointWidth::{2} }},{3}" -f $_.Start, $_.End, $_.Width, $comment
+    $key = $words -join ", "
+    If (-not $blockLookup.ContainsKey($key)) {
+        $blockLookup[$key] = $blocks.Count
+        $blocks.Add($key)
+    }
+    $blockIndices.Add($blockLookup[$key])
+}
+
+If ($blocks.Count -gt 256) {
+    Throw "The first stage only holds 8-bit block indices, but {0} blocks are needed." -f $blocks.Count
+}
+
+"    static constexpr std::array<uint8_t, {0}> s_widthBlockIndices{{" -f $blockIndices.Count
+For($i = 0; $i -lt $blockIndices.Count; $i += 16) {
+    "        " + (($blockIndices.GetRange($i, 16) | ForEach-Object { "0x{0:x2}," -f $_ }) -join " ")
+}
+"    };"
+"    static constexpr std::array<uint64_t, {0}> s_widthBlocks{{" -f ($blocks.Count * $BlockSize / $WidthsPerWord)
+ForEach($_ in $blocks) {
+"        {0}," -f $_
 }
 "    };"
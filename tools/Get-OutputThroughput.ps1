@@ -0,0 +1,83 @@
+# Copyright (c) Microsoft Corporation.
+# Licensed under the MIT license.
+
+################################
+# This script summarizes the OutputThroughput events of a trace recorded
+# with src\TerminalThroughput.wprp:
+#
+#   wpr -start src\TerminalThroughput.wprp -filemode
+#   ... reproduce the slow pane ...
+#   wpr -stop throughput.etl
+#   .\tools\Get-OutputThroughput.ps1 throughput.etl
+#
+# For each pane (connection session or control) it prints how much output
+# went through it and which share of the time was spent in each stage of
+# the output pipeline: reading the pipe, converting UTF-8 to UTF-16, waiting
+# for the output queue and the terminal's write lock, parsing and writing
+# into the text buffer.
+
+[CmdletBinding()]
+Param(
+    [Parameter(Mandatory=$true, Position=0)]
+    [string]$TracePath
+)
+
+$xmlPath = [System.IO.Path]::GetTempFileName() + ".xml"
+& tracerpt.exe $TracePath -o $xmlPath -of XML -y | Out-Null
+If ($LASTEXITCODE -ne 0) {
+    Throw "tracerpt failed to convert $TracePath"
+}
+
+Try {
+    [xml]$trace = Get-Content -LiteralPath $xmlPath -Raw
+}
+Finally {
+    Remove-Item -LiteralPath $xmlPath -ErrorAction SilentlyContinue
+}
+
+# Sums up the numeric fields of the events, per provider and pane.
+$panes = @{}
+ForEach ($event in $trace.Events.Event) {
+    If ($event.RenderingInfo.Task -ne "OutputThroughput" -and $event.System.Task -ne "OutputThroughput") {
+        Continue
+    }
+
+    $fields = @{}
+    ForEach ($data in $event.EventData.Data) {
+        $fields[$data.Name] = $data.'#text'
+    }
+
+    $pane = If ($fields.ContainsKey("SessionGuid")) { $fields["SessionGuid"] } Else { $fields["core"] }
+    $key = "$($event.System.Provider.Name) $pane"
+    If (-Not $panes.ContainsKey($key)) {
+        $panes[$key] = @{}
+    }
+
+    ForEach ($name in $fields.Keys) {
+        $value = 0
+        If ([double]::TryParse($fields[$name], [ref]$value)) {
+            $panes[$key][$name] += $value
+        }
+    }
+}
+
+If ($panes.Count -eq 0) {
+    Write-Warning "There are no OutputThroughput events in $TracePath."
+    Return
+}
+
+ForEach ($key in $panes.Keys | Sort-Object) {
+    $sums = $panes[$key]
+    $seconds = $sums["intervalNs"] / 1e9
+    Write-Output ""
+    Write-Output $key
+    If ($sums.ContainsKey("bytes")) {
+        Write-Output ("  {0:N1} MB in {1:N0} chunks over {2:N1} s: {3:N2} MB/s" -f ($sums["bytes"] / 1MB), $sums["chunks"], $seconds, ($sums["bytes"] / 1MB / [math]::Max($seconds, 1e-9)))
+    } Else {
+        Write-Output ("  {0:N1} M chars in {1:N0} chunks over {2:N1} s: {3:N2} M chars/s" -f ($sums["chars"] / 1e6), $sums["chunks"], $seconds, ($sums["chars"] / 1e6 / [math]::Max($seconds, 1e-9)))
+    }
+
+    ForEach ($name in $sums.Keys | Where-Object { $_ -like "*Ns" -and $_ -ne "intervalNs" } | Sort-Object) {
+        Write-Output ("  {0,-14} {1,10:N1} ms {2,6:P1}" -f $name.Substring(0, $name.Length - 2), ($sums[$name] / 1e6), ($sums[$name] / [math]::Max($sums["intervalNs"], 1)))
+    }
+}